@@ -0,0 +1,37 @@
+if(NOT WITH_ITT)
+  return()
+endif()
+
+# ittnotify is shipped with VTune, under sdk/ of its install directory, and
+# as the ittapi project.
+set(ITT_ROOT
+    "$ENV{VTUNE_PROFILER_DIR}/sdk"
+    CACHE PATH "ITT ROOT")
+find_path(
+  ITT_INCLUDE_DIR ittnotify.h
+  PATHS ${ITT_ROOT} ${ITT_ROOT}/include $ENV{ITT_ROOT} $ENV{ITT_ROOT}/include
+  NO_DEFAULT_PATH)
+
+find_library(
+  ITT_LIBRARY
+  NAMES libittnotify.a ittnotify
+  PATHS ${ITT_ROOT}
+        ${ITT_ROOT}/lib64
+        ${ITT_ROOT}/lib
+        $ENV{ITT_ROOT}
+        $ENV{ITT_ROOT}/lib64
+        $ENV{ITT_ROOT}/lib
+  NO_DEFAULT_PATH
+  DOC "Path to ittnotify library.")
+
+if(ITT_INCLUDE_DIR AND ITT_LIBRARY)
+  set(ITT_FOUND ON)
+  include_directories(${ITT_INCLUDE_DIR})
+  add_definitions(-DPADDLE_WITH_ITT)
+else()
+  set(ITT_FOUND OFF)
+  message(
+    WARNING
+      "ITT is disabled. You are compiling PaddlePaddle with option -DWITH_ITT=ON, but ittnotify is not found, please configure path to ittnotify with option -DITT_ROOT or install VTune."
+  )
+endif()
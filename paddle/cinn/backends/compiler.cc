@@ -251,11 +251,36 @@ void Compiler::AppendBroadcastSwitchModule(const ir::Module& module) {
   engine_->Link<CodeGenSwitchHost>(module);
 }
 
-void Compiler::EndCompile() {
-  RegisterDeviceModuleSymbol();
+void Compiler::EndCompile(CompiledArtifacts* artifacts) {
+  if (artifacts != nullptr) {
+    artifacts->host_bitcode = engine_->SerializeModule();
+    artifacts->device_fn_names = device_fn_name_;
+  }
+  RegisterDeviceModuleSymbol(artifacts);
   engine_->AddSelfModule();
 }
 
+std::unique_ptr<Compiler> Compiler::Load(const Target& target,
+                                         const CompiledArtifacts& artifacts) {
+  std::unique_ptr<Compiler> compiler(new Compiler(target));
+  compiler->device_fn_name_ = artifacts.device_fn_names;
+  target.arch.Match(
+      [&](common::UnknownArch) { CINN_NOT_IMPLEMENTED; },
+      [&](common::X86Arch) {},
+      [&](common::ARMArch) { CINN_NOT_IMPLEMENTED; },
+      [&](common::NVGPUArch) {
+        compiler->LoadCudaModule(artifacts.device_code,
+                                 artifacts.device_code_is_cubin);
+      },
+      [&](common::HygonDCUArchHIP) {
+        compiler->LoadHipModule(artifacts.device_code);
+      });
+  if (!compiler->engine_->AddSerializedModule(artifacts.host_bitcode)) {
+    return nullptr;
+  }
+  return compiler;
+}
+
 std::string Compiler::GetSourceCode(const ir::Module& module) {
   return target_.arch.Match(
       [&](common::UnknownArch) -> std::string { CINN_NOT_IMPLEMENTED; },
@@ -316,16 +341,16 @@ std::string GetFileContent(const std::string& path) {
 }
 }  // namespace
 
-void Compiler::RegisterDeviceModuleSymbol() {
+void Compiler::RegisterDeviceModuleSymbol(CompiledArtifacts* artifacts) {
   return target_.arch.Match(
       [&](common::UnknownArch) { CINN_NOT_IMPLEMENTED; },
       [&](common::X86Arch) { return; },
       [&](common::ARMArch) { return; },
-      [&](common::NVGPUArch) { RegisterCudaModuleSymbol(); },
-      [&](common::HygonDCUArchHIP) { RegisterHipModuleSymbol(); });
+      [&](common::NVGPUArch) { RegisterCudaModuleSymbol(artifacts); },
+      [&](common::HygonDCUArchHIP) { RegisterHipModuleSymbol(artifacts); });
 }
 
-void Compiler::RegisterCudaModuleSymbol() {
+void Compiler::RegisterCudaModuleSymbol(CompiledArtifacts* artifacts) {
 #ifdef CINN_WITH_CUDA
   nvrtc::Compiler compiler;
   std::string source_code = CodeGenCudaDev::GetSourceHeader() + device_fn_code_;
@@ -334,11 +359,21 @@ void Compiler::RegisterCudaModuleSymbol() {
                     true,
                     ::common::errors::InvalidArgument(
                         "Compile PTX failed from source code\n"));
+  LoadCudaModule(ptx, compiler.compile_to_cubin());
+  if (artifacts != nullptr) {
+    artifacts->device_code = std::move(ptx);
+    artifacts->device_code_is_cubin = compiler.compile_to_cubin();
+  }
+#else
+  CINN_NOT_IMPLEMENTED
+#endif
+}
+
+void Compiler::LoadCudaModule(const std::string& code, bool is_cubin) {
+#ifdef CINN_WITH_CUDA
   using runtime::cuda::CUDAModule;
-  cuda_module_.reset(new CUDAModule(ptx,
-                                    compiler.compile_to_cubin()
-                                        ? CUDAModule::Kind::CUBIN
-                                        : CUDAModule::Kind::PTX));
+  cuda_module_.reset(new CUDAModule(
+      code, is_cubin ? CUDAModule::Kind::CUBIN : CUDAModule::Kind::PTX));
 
   RuntimeSymbols symbols;
   for (const auto& kernel_fn_name : device_fn_name_) {
@@ -356,7 +391,7 @@ void Compiler::RegisterCudaModuleSymbol() {
 #endif
 }
 
-void Compiler::RegisterHipModuleSymbol() {
+void Compiler::RegisterHipModuleSymbol(CompiledArtifacts* artifacts) {
 #ifdef CINN_WITH_HIP
   hiprtc::Compiler compiler;
   std::string source_code =
@@ -367,8 +402,19 @@ void Compiler::RegisterHipModuleSymbol() {
       true,
       ::common::errors::Fatal("Compile hsaco failed from source code:\n%s",
                               source_code));
+  LoadHipModule(hsaco);
+  if (artifacts != nullptr) {
+    artifacts->device_code = std::move(hsaco);
+  }
+#else
+  CINN_NOT_IMPLEMENTED
+#endif
+}
+
+void Compiler::LoadHipModule(const std::string& code) {
+#ifdef CINN_WITH_HIP
   using runtime::hip::HIPModule;
-  hip_module_.reset(new HIPModule(hsaco));
+  hip_module_.reset(new HIPModule(code));
   // get device id
   using cinn::runtime::BackendAPI;
   int device_id = BackendAPI::get_backend(target_)->get_device();
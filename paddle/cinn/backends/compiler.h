@@ -20,6 +20,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "paddle/cinn/backends/llvm/codegen_llvm.h"
 #include "paddle/cinn/backends/llvm/execution_engine.h"
@@ -97,12 +98,33 @@ class SourceCodePrint {
   std::mutex mtx_;
 };
 
+/**
+ * The artifacts of a finished Compiler: the bitcode of the host module and
+ * the compiled device code. Compiler::Load links the same functions from
+ * them without generating and compiling the code again, e.g., in another
+ * process.
+ */
+struct CompiledArtifacts {
+  std::string host_bitcode;
+  std::vector<std::string> device_fn_names;
+  // ptx or cubin for CUDA, hsaco for HIP, empty for X86
+  std::string device_code;
+  bool device_code_is_cubin{false};
+};
+
 class Compiler final {
  public:
   static std::unique_ptr<Compiler> Create(const Target& target) {
     return std::unique_ptr<Compiler>(new Compiler(target));
   }
 
+  /**
+   * Link the functions of the artifacts exported by EndCompile.
+   * @return nullptr if the artifacts cannot be loaded.
+   */
+  static std::unique_ptr<Compiler> Load(const Target& target,
+                                        const CompiledArtifacts& artifacts);
+
   /**
    * Compile and link to a CINN module.
    */
@@ -112,7 +134,11 @@ class Compiler final {
 
   void AppendBroadcastSwitchModule(const ir::Module& module);
 
-  void EndCompile();
+  /**
+   * Compile the device code and finish linking. The artifacts are exported
+   * to \p artifacts when it is not null.
+   */
+  void EndCompile(CompiledArtifacts* artifacts = nullptr);
 
   void ExportObject(const std::string& path);
 
@@ -130,11 +156,16 @@ class Compiler final {
 
  private:
   // do not register device symbol until end=true for build fucntion
-  void RegisterDeviceModuleSymbol();
+  void RegisterDeviceModuleSymbol(CompiledArtifacts* artifacts);
+
+  void RegisterCudaModuleSymbol(CompiledArtifacts* artifacts);
+
+  void RegisterHipModuleSymbol(CompiledArtifacts* artifacts);
 
-  void RegisterCudaModuleSymbol();
+  // Registers the kernels of device_fn_name_ in the compiled device code.
+  void LoadCudaModule(const std::string& code, bool is_cubin);
 
-  void RegisterHipModuleSymbol();
+  void LoadHipModule(const std::string& code);
 
   void CompileCudaModule(const ir::Module& module,
                          const std::string& code = "");
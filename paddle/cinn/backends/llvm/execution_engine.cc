@@ -17,6 +17,8 @@
 #include <absl/strings/string_view.h>
 #include <llvm/ADT/Triple.h>
 #include <llvm/AsmParser/Parser.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/JITSymbol.h>
 #include <llvm/ExecutionEngine/Orc/Core.h>
@@ -247,6 +249,33 @@ bool ExecutionEngine::AddSelfModule() {
   return AddModule(std::move(m), std::move(ctx));
 }
 
+std::string ExecutionEngine::SerializeModule() const {
+  PADDLE_ENFORCE_NOT_NULL(
+      m,
+      ::common::errors::PreconditionNotMet(
+          "The module is already added to the JIT, it cannot be serialized."));
+  std::string bitcode;
+  llvm::raw_string_ostream os(bitcode);
+  llvm::WriteBitcodeToFile(*m, os);
+  os.flush();
+  return bitcode;
+}
+
+bool ExecutionEngine::AddSerializedModule(const std::string &bitcode) {
+  utils::RecordEvent("ExecutionEngine AddSerializedModule",
+                     utils::EventType::kOrdinary);
+  auto context = std::make_unique<llvm::LLVMContext>();
+  auto module = llvm::parseBitcodeFile(
+      llvm::MemoryBufferRef(AsStringRef(bitcode), "cinn_serialized_module"),
+      *context);
+  if (!module) {
+    LOG(WARNING) << "Fail to parse the serialized module: "
+                 << llvm::toString(module.takeError());
+    return false;
+  }
+  return AddModule(std::move(*module), std::move(context));
+}
+
 void ExecutionEngine::ExportObject(const std::string &path) {
   FILE *of = fopen(path.c_str(), "w");
   fwrite(buffer_.data(), 1, buffer_.size(), of);
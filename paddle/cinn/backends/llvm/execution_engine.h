@@ -87,6 +87,14 @@ class ExecutionEngine {
 
   bool AddSelfModule();
 
+  // Returns the bitcode of the module linked so far, call it before
+  // AddSelfModule moves the module into the JIT.
+  std::string SerializeModule() const;
+
+  // Adds a module serialized by SerializeModule, returns false when the
+  // bitcode cannot be parsed.
+  bool AddSerializedModule(const std::string &bitcode);
+
  protected:
   explicit ExecutionEngine(bool enable_object_cache)
       : cache_(std::make_unique<NaiveObjectCache>()),
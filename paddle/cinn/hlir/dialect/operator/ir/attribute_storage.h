@@ -130,11 +130,14 @@ struct CINNKernelInfoAttributeStorage : public pir::AttributeStorage {
   }
 
   static std::size_t HashValue(const ParamKey& key) {
+    if (key.async_kernel != nullptr) {
+      return std::hash<void*>()(key.async_kernel.get());
+    }
     return std::hash<int64_t>()(*(reinterpret_cast<int64_t*>(key.fn_ptr)));
   }
 
   bool operator==(const ParamKey& key) const {
-    return data_.fn_ptr == key.fn_ptr;
+    return data_.fn_ptr == key.fn_ptr && data_.async_kernel == key.async_kernel;
   }
 
   const ParamKey& GetAsKey() const { return data_; }
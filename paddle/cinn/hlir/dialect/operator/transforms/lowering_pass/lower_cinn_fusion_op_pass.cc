@@ -24,9 +24,12 @@
 #include "paddle/cinn/hlir/dialect/operator/transforms/refresh_combine_pattern.h"
 #include "paddle/cinn/hlir/dialect/runtime/ir/jit_kernel_op.h"
 #include "paddle/cinn/hlir/dialect/runtime/ir/runtime_dialect.h"
+#include "paddle/common/flags.h"
 #include "paddle/pir/include/core/builtin_type.h"
 #include "paddle/pir/include/pass/pass_registry.h"
 
+PD_DECLARE_bool(cinn_async_compile);
+
 namespace cinn::dialect::ir::details {
 class FusionOpPattern : public pir::OpRewritePattern<cinn::dialect::FusionOp> {
  public:
@@ -44,7 +47,10 @@ class FusionOpPattern : public pir::OpRewritePattern<cinn::dialect::FusionOp> {
 
     // TODO(zhangyuqin1998): Replace pir::Group with a new structure
     OpLoweringGroupPtr group = GetGroup(fusion_op);
-    pir::Operation* compiled_op = ProcessGroup(group, rewriter);
+    pir::Operation* compiled_op =
+        FLAGS_cinn_async_compile
+            ? ProcessGroupAsync(fusion_op.operation(), group, rewriter)
+            : ProcessGroup(group, rewriter);
 
     for (size_t i = 0; i < fusion_op.num_results(); ++i) {
       rewriter.ReplaceAllUsesWith(fusion_op.result(i), compiled_op->result(i));
@@ -76,6 +82,19 @@ class FusionOpPattern : public pir::OpRewritePattern<cinn::dialect::FusionOp> {
     return jit_kernel_op;
   }
 
+  pir::Operation* ProcessGroupAsync(
+      pir::Operation* fusion_op,
+      const OpLoweringGroupPtr& group,
+      pir::PatternRewriter& rewriter) const {  // NOLINT
+    auto group_inputs = GetBlockOutsideInput(group->ops());
+    std::vector<pir::Type> output_types;
+    for (const auto& value : group->output_values()) {
+      output_types.push_back(value.type());
+    }
+    return rewriter.Build<cinn::dialect::JitKernelOp>(
+        group_inputs, GetAsyncJitKernelAttr(fusion_op, group), output_types);
+  }
+
  private:
   const GroupInfoMap& group_infos_;  // not owned
 };
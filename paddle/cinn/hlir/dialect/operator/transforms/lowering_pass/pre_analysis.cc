@@ -19,6 +19,7 @@
 #include "paddle/common/flags.h"
 
 PD_DECLARE_bool(enable_cinn_compile_cache);
+PD_DECLARE_bool(cinn_async_compile);
 
 namespace cinn::dialect::ir::details {
 using cinn::hlir::framework::PirCompiler;
@@ -48,6 +49,8 @@ void FusionOpAnalysis::PreCompileGroup() {
   // Make compilation into lazy mode while
   // FLAGS_enable_cinn_compile_cache=false.
   if (!FLAGS_enable_cinn_compile_cache) return;
+  // The groups are compiled in background while lowering them.
+  if (FLAGS_cinn_async_compile) return;
 
   std::vector<OpLoweringGroupPtr> groups;
   for (auto& group_info : *group_infos_) {
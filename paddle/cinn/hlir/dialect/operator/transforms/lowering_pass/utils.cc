@@ -18,21 +18,28 @@
 #include "paddle/cinn/hlir/dialect/operator/ir/attribute_storage.h"
 #include "paddle/cinn/hlir/dialect/operator/ir/generate_shape_util.h"
 #include "paddle/cinn/hlir/dialect/operator/ir/op_attribute.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/fusion_fallback_pass.h"
 #include "paddle/cinn/hlir/dialect/operator/transforms/lowering_pass/collect_sym_expr.h"
 #include "paddle/cinn/hlir/dialect/runtime/ir/jit_kernel_op.h"
 #include "paddle/cinn/hlir/dialect/runtime/ir/runtime_dialect.h"
+#include "paddle/cinn/hlir/framework/async_compilation.h"
 #include "paddle/cinn/hlir/framework/pir/compilation_cache.h"
 #include "paddle/cinn/hlir/framework/pir/utils.h"
 #include "paddle/cinn/hlir/framework/pir_compiler.h"
 #include "paddle/cinn/runtime/flags.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/ir_mapping.h"
+#include "paddle/pir/include/pass/pass_manager.h"
 
 PD_DECLARE_bool(cinn_enable_map_expr);
 PD_DECLARE_bool(enable_cinn_compile_cache);
 
 namespace cinn::dialect::ir::details {
 
+using cinn::hlir::framework::AsyncCompilationService;
 using cinn::hlir::framework::CompilationCache;
 using cinn::hlir::framework::PirCompiler;
+using cinn::hlir::framework::pir::AsyncCompiledKernel;
 using cinn::hlir::framework::pir::CINNKernelInfo;
 using cinn::hlir::framework::pir::CompatibleInfo;
 
@@ -84,6 +91,87 @@ std::unordered_map<std::string, ::pir::Attribute> GetJitKernelAttr(
   return attrs;
 }
 
+namespace {
+
+// Copies the fusion op into a new program, with its inputs read from the
+// parameters named by AsyncCompiledKernel and its outputs written to the
+// shadow outputs, so that the program lives on after the fusion op is
+// lowered.
+std::shared_ptr<pir::Program> CopyFusionOpToProgram(
+    pir::Operation* fusion_op,
+    const std::vector<pir::Value>& inputs,
+    pir::IrMapping* ir_mapping) {
+  ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+  auto program = std::make_shared<pir::Program>(ctx);
+  pir::Builder builder(ctx, program->block());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto parameter = builder.Build<pir::ParameterOp>(
+        AsyncCompiledKernel::FallbackInputName(i), inputs[i].type());
+    ir_mapping->Add(inputs[i], parameter.result(0));
+  }
+  pir::Operation* new_fusion_op =
+      fusion_op->Clone(*ir_mapping, {true, true, true});
+  builder.Insert(new_fusion_op);
+  for (size_t i = 0; i < new_fusion_op->num_results(); ++i) {
+    builder.Build<pir::ShadowOutputOp>(
+        new_fusion_op->result(i), AsyncCompiledKernel::FallbackOutputName(i));
+  }
+  return program;
+}
+
+}  // namespace
+
+std::unordered_map<std::string, ::pir::Attribute> GetAsyncJitKernelAttr(
+    pir::Operation* fusion_op, const OpLoweringGroupPtr& group) {
+  const auto& inputs = GetBlockOutsideInput(group->ops());
+
+  // The fallback runs the ops of the group converted to phi ops.
+  pir::IrMapping fallback_mapping;
+  auto fallback_program =
+      CopyFusionOpToProgram(fusion_op, inputs, &fallback_mapping);
+  pir::PassManager pass_manager(::pir::IrContext::Instance());
+  pass_manager.AddPass(CreateFusionFallbackPass());
+  pass_manager.Run(fallback_program.get());
+
+  // The group is compiled from another copy together with its symbolic
+  // shapes, which the background thread analyses alone.
+  pir::IrMapping compile_mapping;
+  auto compile_program =
+      CopyFusionOpToProgram(fusion_op, inputs, &compile_mapping);
+  auto& shape_analysis =
+      pir::ShapeAnalysisManager::Instance().Get(fusion_op->GetParentProgram());
+  auto& compile_shape_analysis =
+      pir::ShapeAnalysisManager::Instance().Get(compile_program.get());
+  compile_shape_analysis.RegisterSymbolConstraintFromShapeAnalysis(
+      shape_analysis);
+  for (const auto& [value, new_value] :
+       compile_mapping.GetMap<pir::Value>()) {
+    compile_shape_analysis.SetShapeOrDataForValue(
+        new_value, shape_analysis.GetShapeOrDataForValue(value));
+  }
+  OpLoweringGroupPtr compile_group =
+      BuildOpLoweringGroup(compile_mapping.Lookup(fusion_op));
+
+  auto async_kernel = std::make_shared<AsyncCompiledKernel>(fallback_program);
+  AsyncCompilationService::Instance().Submit(
+      cinn::common::DefaultDeviceTarget(),
+      compile_program,
+      compile_group,
+      async_kernel);
+
+  CINNKernelInfo kernel_info;
+  kernel_info.fn_name = group->FuncName();
+  kernel_info.fn_ptr = nullptr;
+  kernel_info.infer_shape_fn_ptr = nullptr;
+  kernel_info.CX86_fn_ptr = nullptr;
+  kernel_info.async_kernel = async_kernel;
+  std::unordered_map<std::string, ::pir::Attribute> attrs{
+      {cinn::dialect::JitKernelOp::kAttrName,
+       cinn::dialect::CINNKernelInfoAttribute::get(pir::IrContext::Instance(),
+                                                   kernel_info)}};
+  return attrs;
+}
+
 OpLoweringGroupPtr BuildOpLoweringGroup(pir::Operation* fusion_op_ptr) {
   auto fusion_op = fusion_op_ptr->dyn_cast<cinn::dialect::FusionOp>();
   std::vector<::pir::Operation*> ops;
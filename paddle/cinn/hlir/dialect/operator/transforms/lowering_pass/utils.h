@@ -25,6 +25,11 @@ std::vector<pir::Value> GetBlockOutsideInput(
 std::unordered_map<std::string, ::pir::Attribute> GetJitKernelAttr(
     const OpLoweringGroupPtr& group);
 
+// Submits the group to compile in background, and returns the attributes of
+// a jit kernel running the ops of the group with phi kernels meanwhile.
+std::unordered_map<std::string, ::pir::Attribute> GetAsyncJitKernelAttr(
+    pir::Operation* fusion_op, const OpLoweringGroupPtr& group);
+
 OpLoweringGroupPtr BuildOpLoweringGroup(pir::Operation* fusion_op_ptr);
 
 void UpdateGroupShapeOrDataExprs(OpLoweringGroupPtr group);
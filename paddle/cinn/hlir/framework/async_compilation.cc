@@ -0,0 +1,135 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/cinn/hlir/framework/async_compilation.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include "paddle/cinn/hlir/framework/pir_compiler.h"
+#include "paddle/cinn/runtime/arch_device.h"
+#include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+
+PD_DECLARE_int64(cinn_compile_thread_num);
+
+namespace cinn::hlir::framework {
+
+AsyncCompilationService& AsyncCompilationService::Instance() {
+  static AsyncCompilationService service;
+  return service;
+}
+
+AsyncCompilationService::AsyncCompilationService() {
+  size_t thread_num = FLAGS_cinn_compile_thread_num > 0
+                          ? FLAGS_cinn_compile_thread_num
+                          : std::thread::hardware_concurrency();
+  thread_num = std::max<size_t>(thread_num, 1);
+  VLOG(4) << "Start " << thread_num << " threads to compile CINN groups";
+  for (size_t i = 0; i < thread_num; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+AsyncCompilationService::~AsyncCompilationService() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopped_ = true;
+    // The groups not started yet keep running the phi kernels.
+    tasks_.clear();
+  }
+  task_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void AsyncCompilationService::Submit(
+    const Target& target,
+    const std::shared_ptr<::pir::Program>& compile_program,
+    const std::shared_ptr<pir::OpLoweringGroup>& group,
+    const std::shared_ptr<pir::AsyncCompiledKernel>& kernel) {
+  VLOG(4) << "Submit " << group->FuncName() << " to compile in background";
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    tasks_.push_back(Task{target,
+                          compile_program,
+                          runtime::GetArchDevice(target),
+                          group,
+                          kernel});
+  }
+  task_cv_.notify_one();
+}
+
+void AsyncCompilationService::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return tasks_.empty() && running_num_ == 0; });
+}
+
+void AsyncCompilationService::Pause() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  paused_ = true;
+}
+
+void AsyncCompilationService::Resume() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    paused_ = false;
+  }
+  task_cv_.notify_all();
+}
+
+void AsyncCompilationService::WorkerLoop() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cv_.wait(lock, [this] {
+        return stopped_ || (!paused_ && !tasks_.empty());
+      });
+      if (stopped_) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+      ++running_num_;
+    }
+    Compile(task);
+    // Release the copy of the group before waking up the waiters.
+    task = Task();
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      --running_num_;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void AsyncCompilationService::Compile(const Task& task) {
+  runtime::SetArchDevice(task.target, task.device_id);
+  try {
+    PirCompiler pir_compiler(task.target);
+    task.kernel->SetKernelInfo(pir_compiler.Build({task.group})[0]);
+    VLOG(4) << "Finish compiling " << task.group->FuncName()
+            << " in background";
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Fail to compile " << task.group->FuncName()
+                 << " in background, it keeps running the phi kernels: "
+                 << e.what();
+    task.kernel->SetFailed();
+  }
+}
+
+}  // namespace cinn::hlir::framework
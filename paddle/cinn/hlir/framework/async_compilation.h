@@ -0,0 +1,137 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "paddle/cinn/common/macros.h"
+#include "paddle/cinn/common/target.h"
+#include "paddle/cinn/hlir/framework/pir/op_lowering_group.h"
+#include "paddle/cinn/hlir/framework/pir/utils.h"
+#include "paddle/pir/include/core/program.h"
+
+namespace cinn::hlir::framework {
+
+namespace pir {
+
+/**
+ * AsyncCompiledKernel is the kernel of a group compiled by
+ * AsyncCompilationService. Until IsReady(), the executor runs the fallback
+ * program, the ops of the group converted to phi ops, which reads the inputs
+ * from the parameters named FallbackInputName(i) and writes the outputs to
+ * FallbackOutputName(i). A group failing to compile keeps the fallback.
+ */
+class AsyncCompiledKernel {
+ public:
+  explicit AsyncCompiledKernel(
+      const std::shared_ptr<::pir::Program>& fallback_program)
+      : fallback_program_(fallback_program) {}
+
+  bool IsReady() const {
+    return state_.load(std::memory_order_acquire) == State::kReady;
+  }
+  bool IsFailed() const {
+    return state_.load(std::memory_order_acquire) == State::kFailed;
+  }
+
+  // Only valid when IsReady().
+  const CINNKernelInfo& GetKernelInfo() const { return kernel_info_; }
+
+  const std::shared_ptr<::pir::Program>& FallbackProgram() const {
+    return fallback_program_;
+  }
+
+  void SetKernelInfo(const CINNKernelInfo& kernel_info) {
+    kernel_info_ = kernel_info;
+    state_.store(State::kReady, std::memory_order_release);
+  }
+  void SetFailed() { state_.store(State::kFailed, std::memory_order_release); }
+
+  static std::string FallbackInputName(size_t index) {
+    return "cinn_fallback_in_" + std::to_string(index);
+  }
+  static std::string FallbackOutputName(size_t index) {
+    return "cinn_fallback_out_" + std::to_string(index);
+  }
+
+ private:
+  enum class State { kCompiling, kReady, kFailed };
+
+  std::atomic<State> state_{State::kCompiling};
+  CINNKernelInfo kernel_info_;
+  std::shared_ptr<::pir::Program> fallback_program_;
+};
+
+}  // namespace pir
+
+/**
+ * AsyncCompilationService compiles the groups on background threads under
+ * FLAGS_cinn_async_compile. Each group is submitted with the program of its
+ * own copy, which nothing else touches, so the lowering of other programs
+ * and the execution go on meanwhile.
+ */
+class AsyncCompilationService {
+ public:
+  static AsyncCompilationService& Instance();
+
+  ~AsyncCompilationService();
+
+  void Submit(const Target& target,
+              const std::shared_ptr<::pir::Program>& compile_program,
+              const std::shared_ptr<pir::OpLoweringGroup>& group,
+              const std::shared_ptr<pir::AsyncCompiledKernel>& kernel);
+
+  // Blocks until all the submitted groups are compiled.
+  void Wait();
+
+  // Holds the groups submitted from now on in the queue until Resume, so
+  // that they keep running their fallbacks, e.g., in tests.
+  void Pause();
+  void Resume();
+
+ private:
+  struct Task {
+    Target target;
+    std::shared_ptr<::pir::Program> compile_program;
+    std::optional<int> device_id;
+    std::shared_ptr<pir::OpLoweringGroup> group;
+    std::shared_ptr<pir::AsyncCompiledKernel> kernel;
+  };
+
+  AsyncCompilationService();
+  CINN_DISALLOW_COPY_AND_ASSIGN(AsyncCompilationService);
+
+  void WorkerLoop();
+  static void Compile(const Task& task);
+
+  std::mutex mutex_;
+  std::condition_variable task_cv_;
+  std::condition_variable done_cv_;
+  std::deque<Task> tasks_;
+  size_t running_num_{0};
+  bool stopped_{false};
+  bool paused_{false};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace cinn::hlir::framework
@@ -42,6 +42,20 @@ class BackendResource final {
     backend_compiler_ = backends::Compiler::Create(target);
   }
 
+  // Wraps a compiler that has linked the functions already, e.g. one loaded
+  // from PersistentCompilationCache.
+  BackendResource(
+      const std::string& host_fn_name,
+      const std::string& infer_fn_name,
+      const std::map<int, CINNKernelInfo::SymbolArgBindInfo>& symbol_args_map,
+      const std::vector<int64_t>& temp_space_sizes,
+      const std::shared_ptr<backends::Compiler>& backend_compiler)
+      : host_fn_name_(host_fn_name),
+        infer_fn_name_(infer_fn_name),
+        symbol_args_map_(symbol_args_map),
+        temp_space_sizes_(temp_space_sizes),
+        backend_compiler_(backend_compiler) {}
+
   void* GetHostFuncPtr() const;
   void* GetInferFuncPtr() const;
   void* GetCX86HostFuncPtr() const;
@@ -57,6 +71,7 @@ class BackendResource final {
   }
   pir::CINNKernelInfo GenerateKernelInfo() const;
   const std::string& GetHostFuncName() const { return host_fn_name_; }
+  const std::string& GetInferFuncName() const { return infer_fn_name_; }
 
  private:
   std::string host_fn_name_;
@@ -23,6 +23,7 @@
 #include "paddle/cinn/hlir/framework/pir/op_lowering_group.h"
 #include "paddle/cinn/hlir/framework/pir/utils.h"
 #include "paddle/common/enforce.h"
+#include "paddle/common/startup_trace.h"
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -148,6 +149,8 @@ void UnifyBroadcastGroupFuncArgs(
 }
 
 std::shared_ptr<pir::CompilationResult> CompilationTask::operator()() {
+  ::common::StartupTraceScope startup_trace("CinnCompile",
+                                            context_->group_->FuncName());
   Lowering();
   return CodegenAndJit();
 }
@@ -221,7 +224,7 @@ std::shared_ptr<pir::CompilationResult> CompilationTask::BuildPirCINNKernelInfo(
   VLOG(5) << "Start to compile module into cuda kernel...";
   backend_resource->GetBackendCompiler()->Build(module, "");
   backend_resource->GetBackendCompiler()->AppendCX86(CX86module);
-  backend_resource->GetBackendCompiler()->EndCompile();
+  backend_resource->GetBackendCompiler()->EndCompile(artifacts_);
   compilation_result->SetBackendResource(backend_resource);
   VLOG(5) << "End to compile module into cuda kernel.";
   return compilation_result;
@@ -260,7 +263,7 @@ CompilationTask::CompileBroadcastModules(
           symbolic_shape_var_index));
   backend_resource->GetBackendCompiler()->AppendBroadcastSwitchModule(
       wrapper_module);
-  backend_resource->GetBackendCompiler()->EndCompile();
+  backend_resource->GetBackendCompiler()->EndCompile(artifacts_);
   compilation_result->SetBackendResource(backend_resource);
   VLOG(5) << "End to compile module into cuda kernel.";
   return compilation_result;
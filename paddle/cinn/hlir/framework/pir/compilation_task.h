@@ -62,8 +62,10 @@ class GroupCompilationContext {
 
 class CompilationTask {
  public:
-  explicit CompilationTask(GroupCompilationContext* context)
-      : context_(context) {}
+  // The compiled code is exported to artifacts when it is not null.
+  explicit CompilationTask(GroupCompilationContext* context,
+                           backends::CompiledArtifacts* artifacts = nullptr)
+      : context_(context), artifacts_(artifacts) {}
 
   std::shared_ptr<pir::CompilationResult> operator()();
   void Lowering();
@@ -77,6 +79,7 @@ class CompilationTask {
       const ir::Module& module, const ir::Module& CX86module);
 
   GroupCompilationContext* context_;
+  backends::CompiledArtifacts* artifacts_;
 };
 
 }  // namespace framework
@@ -25,6 +25,7 @@ class AttributeInfo {
       : name_(name), attr_(attr) {}
 
   std::size_t hash() const;
+  void PrintStableKey(std::ostream &os) const;
   friend std::ostream &operator<<(std::ostream &os, const AttributeInfo &info);
 
  private:
@@ -37,6 +38,7 @@ class ValueInfo {
   explicit ValueInfo(const ::pir::Value &value) : type_(value.type()) {}
 
   std::size_t hash() const;
+  void PrintStableKey(std::ostream &os) const;
   friend std::ostream &operator<<(std::ostream &os, const ValueInfo &info);
 
  private:
@@ -49,6 +51,7 @@ class OperationInfo {
   explicit OperationInfo(const ::pir::Operation &op);
 
   std::size_t hash() const;
+  void PrintStableKey(std::ostream &os) const;
   friend std::ostream &operator<<(std::ostream &os, const OperationInfo &info);
 
  private:
@@ -68,6 +71,7 @@ class OpDepInfo {
   }
 
   std::size_t hash() const;
+  void PrintStableKey(std::ostream &os) const;
   friend std::ostream &operator<<(std::ostream &os, const OpDepInfo &info);
 
  private:
@@ -82,6 +86,7 @@ class FusionOpInfo {
       : op_info_(op), inner_deps_(deps) {}
 
   std::size_t hash() const;
+  void PrintStableKey(std::ostream &os) const;
   friend std::ostream &operator<<(std::ostream &os, const FusionOpInfo &info);
 
  private:
@@ -101,6 +106,12 @@ class FusionInfo {
 
   std::size_t hash() const;
 
+  // hash() depends on the addresses of the types and attributes, which change
+  // across processes. The stable key prints them instead, so that the same
+  // group gets the same key in every process, which is used to persist the
+  // compilation results.
+  std::string StableKey() const;
+
   bool operator==(const FusionInfo &other) const {
     return this->hash() == other.hash();
   }
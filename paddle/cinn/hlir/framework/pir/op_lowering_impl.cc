@@ -794,12 +794,13 @@ ir::Expr OpLowererImpl::LowerX86(const OpLoweringGroupPtr& group,
     return ir::Expr(-1);
   }
 
+  const Target device_target = this->target_;
   this->target_ = common::DefaultHostTarget();
   cinn::runtime::CurrentTarget::SetCurrentTarget(this->target_);
 
   std::vector<ir::Expr> func_bodies =
       LowerOps(group, ops, &group_func_arg_tensors, &tensor_map);
-  this->target_ = common::DefaultNVGPUTarget();
+  this->target_ = device_target;
   cinn::runtime::CurrentTarget::SetCurrentTarget(this->target_);
   ir::ModuleExpr mod_expr(func_bodies);
   ir::IRSchedule ir_sch(
@@ -0,0 +1,379 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/cinn/hlir/framework/pir/persistent_compilation_cache.h"
+
+#include <llvm/Config/llvm-config.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#ifdef CINN_WITH_CUDA
+#include <cuda.h>
+#include <cuda_runtime.h>
+#endif
+#ifdef CINN_WITH_HIP
+#include <hip/hip_runtime.h>
+#endif
+
+#include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/commit.h"
+
+PD_DECLARE_bool(enable_cinn_compile_cache);
+PD_DECLARE_string(cinn_compilation_cache_dir);
+PD_DECLARE_int64(cinn_compilation_cache_max_mb);
+
+namespace cinn::hlir::framework::pir {
+
+namespace fs = std::filesystem;
+
+static constexpr uint64_t kEntryMagic = 0x43494E4E43414348ULL;
+static constexpr uint64_t kEntryVersion = 1;
+static constexpr char kEntryExtension[] = ".cinn";
+// No part of a sane entry is larger, so a corrupted length fails the load
+// instead of allocating a huge string.
+static constexpr uint64_t kMaxEntryFieldSize = 1ULL << 31;
+
+namespace {
+
+class EntryWriter {
+ public:
+  explicit EntryWriter(std::ofstream* fout) : fout_(fout) {}
+
+  void Write(uint64_t value) {
+    fout_->write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void Write(const std::string& str) {
+    Write(static_cast<uint64_t>(str.size()));
+    fout_->write(str.data(), str.size());
+  }
+
+ private:
+  std::ofstream* fout_;
+};
+
+class EntryReader {
+ public:
+  explicit EntryReader(std::ifstream* fin) : fin_(fin) {}
+
+  bool Read(uint64_t* value) {
+    return static_cast<bool>(
+        fin_->read(reinterpret_cast<char*>(value), sizeof(*value)));
+  }
+
+  bool Read(int64_t* value) {
+    uint64_t raw = 0;
+    if (!Read(&raw)) {
+      return false;
+    }
+    *value = static_cast<int64_t>(raw);
+    return true;
+  }
+
+  bool Read(int* value) {
+    int64_t raw = 0;
+    if (!Read(&raw)) {
+      return false;
+    }
+    *value = static_cast<int>(raw);
+    return true;
+  }
+
+  bool Read(std::string* str) {
+    uint64_t size = 0;
+    if (!Read(&size) || size > kMaxEntryFieldSize) {
+      return false;
+    }
+    str->resize(size);
+    return static_cast<bool>(fin_->read(str->data(), size));
+  }
+
+ private:
+  std::ifstream* fin_;
+};
+
+uint64_t HashKey(const std::string& key) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void WriteSymbolArgsMap(
+    EntryWriter* writer,
+    const std::map<int, CINNKernelInfo::SymbolArgBindInfo>& symbol_args_map) {
+  writer->Write(symbol_args_map.size());
+  for (const auto& [arg_idx, bind_info] : symbol_args_map) {
+    writer->Write(static_cast<uint64_t>(arg_idx));
+    writer->Write(static_cast<uint64_t>(bind_info.index()));
+    std::visit(
+        [&](const auto& idx) {
+          using T = std::decay_t<decltype(idx)>;
+          writer->Write(static_cast<uint64_t>(idx.arg_idx));
+          if constexpr (std::is_same_v<T, CINNKernelInfo::ArgDimIdx>) {
+            writer->Write(static_cast<uint64_t>(idx.dim_idx));
+          } else {
+            writer->Write(static_cast<uint64_t>(idx.value_idx));
+          }
+        },
+        bind_info);
+  }
+}
+
+bool ReadSymbolArgsMap(
+    EntryReader* reader,
+    std::map<int, CINNKernelInfo::SymbolArgBindInfo>* symbol_args_map) {
+  uint64_t num = 0;
+  if (!reader->Read(&num) || num > kMaxEntryFieldSize) {
+    return false;
+  }
+  for (uint64_t i = 0; i < num; ++i) {
+    int arg_idx = 0, input_idx = 0, sub_idx = 0;
+    uint64_t kind = 0;
+    if (!reader->Read(&arg_idx) || !reader->Read(&kind) ||
+        !reader->Read(&input_idx) || !reader->Read(&sub_idx)) {
+      return false;
+    }
+    if (kind == 0) {
+      (*symbol_args_map)[arg_idx] =
+          CINNKernelInfo::ArgDimIdx{input_idx, sub_idx};
+    } else if (kind == 1) {
+      (*symbol_args_map)[arg_idx] =
+          CINNKernelInfo::ArgValueIdx{input_idx, sub_idx};
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+PersistentCompilationCache& PersistentCompilationCache::Instance() {
+  static PersistentCompilationCache instance;
+  return instance;
+}
+
+bool PersistentCompilationCache::IsEnabled() {
+  return FLAGS_enable_cinn_compile_cache &&
+         !FLAGS_cinn_compilation_cache_dir.empty();
+}
+
+std::string PersistentCompilationCache::Key(const FusionInfo& fusion_info,
+                                            const Target& target) {
+  std::ostringstream os;
+  os << "target " << target << "\nllvm " << LLVM_VERSION_STRING << "\npaddle "
+     << paddle::framework::paddle_commit();
+#ifdef CINN_WITH_CUDA
+  int device = 0, major = 0, minor = 0;
+  cudaGetDevice(&device);
+  cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device);
+  cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device);
+  os << "\ncuda " << CUDA_VERSION << " sm_" << major << minor;
+#endif
+#ifdef CINN_WITH_HIP
+  int device = 0;
+  hipDeviceProp_t prop;
+  hipGetDevice(&device);
+  hipGetDeviceProperties(&prop, device);
+  os << "\nhip " << HIP_VERSION << " " << prop.gcnArchName;
+#endif
+  os << "\n" << fusion_info.StableKey();
+  return os.str();
+}
+
+std::string PersistentCompilationCache::EntryPath(
+    const std::string& key) const {
+  std::stringstream ss;
+  ss << FLAGS_cinn_compilation_cache_dir << "/" << std::hex << HashKey(key)
+     << kEntryExtension;
+  return ss.str();
+}
+
+std::shared_ptr<CompilationResult> PersistentCompilationCache::Load(
+    const std::string& key, const Target& target) {
+  const std::string path = EntryPath(key);
+  std::ifstream fin(path, std::ios::binary);
+  if (!fin.is_open()) {
+    return nullptr;
+  }
+  EntryReader reader(&fin);
+  uint64_t magic = 0, version = 0;
+  std::string saved_key;
+  if (!reader.Read(&magic) || !reader.Read(&version) ||
+      !reader.Read(&saved_key) || magic != kEntryMagic ||
+      version != kEntryVersion || saved_key != key) {
+    VLOG(4) << path << " is not the compilation result of the group";
+    return nullptr;
+  }
+
+  std::string host_fn_name, infer_fn_name;
+  std::map<int, CINNKernelInfo::SymbolArgBindInfo> symbol_args_map;
+  std::vector<int64_t> temp_space_sizes;
+  backends::CompiledArtifacts artifacts;
+  uint64_t num = 0;
+  bool ok = reader.Read(&host_fn_name) && reader.Read(&infer_fn_name) &&
+            ReadSymbolArgsMap(&reader, &symbol_args_map) &&
+            reader.Read(&num) && num <= kMaxEntryFieldSize;
+  for (uint64_t i = 0; ok && i < num; ++i) {
+    ok = reader.Read(&temp_space_sizes.emplace_back());
+  }
+  ok = ok && reader.Read(&artifacts.host_bitcode) && reader.Read(&num) &&
+       num <= kMaxEntryFieldSize;
+  for (uint64_t i = 0; ok && i < num; ++i) {
+    ok = reader.Read(&artifacts.device_fn_names.emplace_back());
+  }
+  uint64_t is_cubin = 0;
+  ok = ok && reader.Read(&artifacts.device_code) && reader.Read(&is_cubin);
+  if (!ok) {
+    LOG(WARNING) << "The compilation cache entry " << path
+                 << " is corrupted, the group will be compiled again";
+    return nullptr;
+  }
+  artifacts.device_code_is_cubin = is_cubin != 0;
+
+  std::shared_ptr<backends::Compiler> compiler =
+      backends::Compiler::Load(target, artifacts);
+  if (compiler == nullptr) {
+    return nullptr;
+  }
+  auto compilation_result = std::make_shared<CompilationResult>(target);
+  compilation_result->SetBackendResource(
+      std::make_shared<BackendResource>(host_fn_name,
+                                        infer_fn_name,
+                                        symbol_args_map,
+                                        temp_space_sizes,
+                                        compiler));
+
+  std::error_code ec;
+  fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+  VLOG(4) << "Load the compilation result of " << host_fn_name << " from "
+          << path;
+  return compilation_result;
+}
+
+void PersistentCompilationCache::Save(
+    const std::string& key,
+    const BackendResource& resource,
+    const backends::CompiledArtifacts& artifacts) {
+  const std::string path = EntryPath(key);
+  std::error_code ec;
+  fs::create_directories(FLAGS_cinn_compilation_cache_dir, ec);
+  std::stringstream tmp_ss;
+  tmp_ss << path << ".tmp." << getpid() << "."
+         << std::hash<std::thread::id>()(std::this_thread::get_id());
+  const std::string tmp_path = tmp_ss.str();
+  {
+    std::ofstream fout(tmp_path, std::ios::binary);
+    if (!fout.is_open()) {
+      LOG(WARNING) << "Cannot open " << tmp_path
+                   << " to save the compilation result";
+      return;
+    }
+    EntryWriter writer(&fout);
+    writer.Write(kEntryMagic);
+    writer.Write(kEntryVersion);
+    writer.Write(key);
+    writer.Write(resource.GetHostFuncName());
+    writer.Write(resource.GetInferFuncName());
+    WriteSymbolArgsMap(&writer, resource.GetSymbolArgsMap());
+    writer.Write(resource.GetTempSpaceSizes().size());
+    for (int64_t size : resource.GetTempSpaceSizes()) {
+      writer.Write(static_cast<uint64_t>(size));
+    }
+    writer.Write(artifacts.host_bitcode);
+    writer.Write(artifacts.device_fn_names.size());
+    for (const std::string& name : artifacts.device_fn_names) {
+      writer.Write(name);
+    }
+    writer.Write(artifacts.device_code);
+    writer.Write(static_cast<uint64_t>(artifacts.device_code_is_cubin));
+    if (!fout.good()) {
+      LOG(WARNING) << "Fail to write the compilation result to " << tmp_path;
+      fout.close();
+      fs::remove(tmp_path, ec);
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Fail to rename " << tmp_path << " to " << path;
+    fs::remove(tmp_path, ec);
+    return;
+  }
+  VLOG(4) << "Save the compilation result of " << resource.GetHostFuncName()
+          << " to " << path;
+  Evict();
+}
+
+void PersistentCompilationCache::Evict() {
+  if (FLAGS_cinn_compilation_cache_max_mb <= 0) {
+    return;
+  }
+  const uintmax_t max_bytes =
+      static_cast<uintmax_t>(FLAGS_cinn_compilation_cache_max_mb) << 20;
+  std::lock_guard<std::mutex> guard(evict_mutex_);
+
+  std::error_code ec;
+  std::vector<std::tuple<fs::file_time_type, uintmax_t, fs::path>> entries;
+  uintmax_t total_bytes = 0;
+  for (fs::directory_iterator it(FLAGS_cinn_compilation_cache_dir, ec), end;
+       !ec && it != end;
+       it.increment(ec)) {
+    if (it->path().extension() != kEntryExtension) {
+      continue;
+    }
+    std::error_code entry_ec;
+    uintmax_t size = it->file_size(entry_ec);
+    fs::file_time_type time = it->last_write_time(entry_ec);
+    if (entry_ec) {
+      continue;
+    }
+    total_bytes += size;
+    entries.emplace_back(time, size, it->path());
+  }
+  if (total_bytes <= max_bytes) {
+    return;
+  }
+  std::sort(entries.begin(), entries.end());
+  for (const auto& [time, size, entry_path] : entries) {
+    if (total_bytes <= max_bytes) {
+      break;
+    }
+    // The entry may be removed by another process in the meantime.
+    fs::remove(entry_path, ec);
+    total_bytes -= size;
+    VLOG(4) << "Evict " << entry_path << " from the compilation cache";
+  }
+}
+
+}  // namespace cinn::hlir::framework::pir
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "paddle/cinn/backends/compiler.h"
+#include "paddle/cinn/common/macros.h"
+#include "paddle/cinn/common/target.h"
+#include "paddle/cinn/hlir/framework/pir/compilation_cache.h"
+#include "paddle/cinn/hlir/framework/pir/fusion_info.h"
+
+namespace cinn::hlir::framework {
+
+namespace pir {
+
+/**
+ * PersistentCompilationCache is the on-disk tier of CompilationCache, enabled
+ * by FLAGS_cinn_compilation_cache_dir. Each entry holds the compiled host
+ * module as LLVM bitcode and the device code of one group, so that another
+ * process, or a later run, only reloads them instead of lowering and
+ * compiling the group again.
+ *
+ * FusionInfo::hash() depends on the addresses of pir types, so entries are
+ * keyed by FusionInfo::StableKey() together with the target, the compute
+ * capability and the versions of CUDA, LLVM and Paddle. The whole key is
+ * saved in the entry and compared on load, a hash collision is a miss.
+ *
+ * Entries are written to a temporary file and renamed, so the processes
+ * sharing the directory never read a partial entry. They are evicted by the
+ * least recent use, which is tracked by the modification time of the files.
+ */
+class PersistentCompilationCache {
+ public:
+  static PersistentCompilationCache& Instance();
+
+  // Requires FLAGS_enable_cinn_compile_cache, or the group functions are
+  // named uniquely and never hit.
+  static bool IsEnabled();
+
+  static std::string Key(const FusionInfo& fusion_info, const Target& target);
+
+  // Returns nullptr when the entry of key is absent or unusable.
+  std::shared_ptr<CompilationResult> Load(const std::string& key,
+                                          const Target& target);
+
+  // Failures are only logged, the result is still used by this process.
+  void Save(const std::string& key,
+            const BackendResource& resource,
+            const backends::CompiledArtifacts& artifacts);
+
+  std::string EntryPath(const std::string& key) const;
+
+ private:
+  PersistentCompilationCache() = default;
+  CINN_DISALLOW_COPY_AND_ASSIGN(PersistentCompilationCache);
+
+  void Evict();
+
+  // Serializes the evictions of the threads of this process, other processes
+  // tolerate the files removed under them.
+  std::mutex evict_mutex_;
+};
+
+}  // namespace pir
+
+}  // namespace cinn::hlir::framework
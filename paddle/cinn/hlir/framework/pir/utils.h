@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -29,11 +30,16 @@ namespace hlir {
 namespace framework {
 
 namespace pir {
+class AsyncCompiledKernel;
+
 struct CINNKernelInfo {
   std::string fn_name;
   void* fn_ptr;
   void* infer_shape_fn_ptr;
   void* CX86_fn_ptr;
+  // Set instead of the function pointers while the group is compiled in
+  // background, see AsyncCompilationService.
+  std::shared_ptr<AsyncCompiledKernel> async_kernel{nullptr};
 
   struct ArgDimIdx {
     int arg_idx;
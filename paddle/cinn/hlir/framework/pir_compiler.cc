@@ -17,6 +17,7 @@
 
 #include "paddle/cinn/hlir/dialect/operator/transforms/lowering_pass/utils.h"
 #include "paddle/cinn/hlir/framework/pir/broadcast_with_cf.h"
+#include "paddle/cinn/hlir/framework/pir/persistent_compilation_cache.h"
 #include "paddle/cinn/hlir/framework/pir/utils.h"
 #include "paddle/cinn/runtime/arch_device.h"
 #include "paddle/cinn/utils/multi_threading.h"
@@ -40,6 +41,9 @@ class CompilationContextMapper {
   MutableCompilationResult() {
     return compilation_results_;
   }
+  const pir::FusionInfo& GetFusionInfo(size_t index) const {
+    return fusion_infos_[mapper_index_[index]];
+  }
 
   std::vector<pir::CINNKernelInfo> RecoverKernelInfos();
   void UpdateGlobalCache();
@@ -84,7 +88,8 @@ std::vector<pir::CINNKernelInfo> PirCompiler::Build(
     const auto device_id = runtime::GetArchDevice(target_);
     auto worker_fn = [&](int index) {
       runtime::SetArchDevice(target_, device_id);
-      compilation_results[index] = Compile(&group_compilation_contexts[index]);
+      compilation_results[index] = Compile(&group_compilation_contexts[index],
+                                           ctx_mapper.GetFusionInfo(index));
     };
     utils::parallel_run(worker_fn,
                         utils::SequenceDispatcher(0, task_size),
@@ -97,9 +102,22 @@ std::vector<pir::CINNKernelInfo> PirCompiler::Build(
 }
 
 std::shared_ptr<pir::CompilationResult> PirCompiler::Compile(
-    GroupCompilationContext* ctx) {
+    GroupCompilationContext* ctx, const pir::FusionInfo& fusion_info) {
+  auto& persistent_cache = pir::PersistentCompilationCache::Instance();
+  const bool use_persistent_cache =
+      pir::PersistentCompilationCache::IsEnabled();
+  std::string persistent_key;
+  if (use_persistent_cache) {
+    persistent_key = pir::PersistentCompilationCache::Key(fusion_info, target_);
+    auto loaded_result = persistent_cache.Load(persistent_key, target_);
+    if (loaded_result != nullptr) {
+      return loaded_result;
+    }
+  }
+
   std::shared_ptr<pir::CompilationResult> compile_result;
-  CompilationTask task(ctx);
+  backends::CompiledArtifacts artifacts;
+  CompilationTask task(ctx, use_persistent_cache ? &artifacts : nullptr);
 
   const auto& optional_broadcast_optimize_groups =
       pir::GetBroadcastGroupListForOptimize(ctx->GetGroup());
@@ -136,6 +154,10 @@ std::shared_ptr<pir::CompilationResult> PirCompiler::Compile(
 
   // Triggering llvm compilation in thread
   compile_result->GetKernelInfo();
+  if (use_persistent_cache) {
+    persistent_cache.Save(
+        persistent_key, *compile_result->GetBackendResource(), artifacts);
+  }
   return compile_result;
 }
 
@@ -30,7 +30,8 @@ class PirCompiler final {
  private:
   CINN_DISALLOW_COPY_AND_ASSIGN(PirCompiler);
 
-  std::shared_ptr<pir::CompilationResult> Compile(GroupCompilationContext* ctx);
+  std::shared_ptr<pir::CompilationResult> Compile(
+      GroupCompilationContext* ctx, const pir::FusionInfo& fusion_info);
 
   Target target_;
 };
@@ -62,6 +62,8 @@ bool TileConfigToProto(group_schedule::config::proto::TileData* tile_data,
     tc.set_warp_num(it.second.warp_num);
     tc.set_tree_reduce_num(it.second.tree_reduce_num);
     tc.set_spatial_inner_num(it.second.spatial_inner_num);
+    tc.set_reduce_method(ReduceMethodToIndex(it.second.reduce_method) + 1);
+    tc.set_grid_reduce_num(it.second.grid_reduce_num);
     *(tile_data->mutable_tile_config()) = tc;
     tile_data->set_priority(priority);
   }
@@ -244,6 +246,16 @@ TileConfigMap FileTileConfigDatabase::GetConfigs(
     tconfig.spatial_inner_num =
         piece_tileconfig.tile_config().spatial_inner_num();
     tconfig.warp_num = piece_tileconfig.tile_config().warp_num();
+    // The configs saved before the reduce method was recorded keep the
+    // default one.
+    if (piece_tileconfig.tile_config().reduce_method() > 0) {
+      tconfig.reduce_method = ReduceMethodFromIndex(
+          piece_tileconfig.tile_config().reduce_method() - 1);
+    }
+    if (piece_tileconfig.tile_config().grid_reduce_num() > 0) {
+      tconfig.grid_reduce_num =
+          piece_tileconfig.tile_config().grid_reduce_num();
+    }
     tile_config_map[bucket_info] = tconfig;
     // TODO(XiaZichao): Add function to cut one lattice into smaller ones
   }
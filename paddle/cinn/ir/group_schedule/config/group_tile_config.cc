@@ -82,6 +82,27 @@ std::string BucketInfo::ToString() const {
   return ss.str();
 }
 
+int64_t ReduceMethodToIndex(const ReduceMethod& reduce_method) {
+  return static_cast<int64_t>(reduce_method.index());
+}
+
+ReduceMethod ReduceMethodFromIndex(int64_t index) {
+  switch (index) {
+    case 0:
+      return NoneReduceMethod();
+    case 1:
+      return WarpReduceMethod();
+    case 2:
+      return BlockReduceMethod();
+    case 3:
+      return DiscreteReduceMethod();
+    default:
+      PADDLE_THROW(::common::errors::InvalidArgument(
+          "The index of reduce method should be in [0, 3], but got %d.",
+          index));
+  }
+}
+
 int64_t Next2Power(int64_t n) {
   if (n == 1) {
     return 1;
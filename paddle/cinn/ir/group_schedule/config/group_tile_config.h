@@ -115,6 +115,12 @@ struct BucketInfoHash {
   }
 };
 
+// The reduce method is stored in the tile config database and searched as
+// an element of a candidate by its index in ReduceMethod: 0 for none, 1 for
+// warp reduce, 2 for block reduce and 3 for discrete reduce.
+int64_t ReduceMethodToIndex(const ReduceMethod& reduce_method);
+ReduceMethod ReduceMethodFromIndex(int64_t index);
+
 std::shared_ptr<ScheduleConfig::BaseInfo> InitBasicInfo(
     const std::shared_ptr<FusionGroupInfo>& group_info);
 
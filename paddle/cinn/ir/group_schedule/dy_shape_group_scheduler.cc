@@ -14,14 +14,17 @@
 
 #include "paddle/cinn/ir/group_schedule/dy_shape_group_scheduler.h"
 #include "paddle/cinn/common/cas.h"
+#include "paddle/cinn/common/ir_util.h"
 #include "paddle/cinn/ir/group_schedule/config/schedule_config_manager.h"
 #include "paddle/cinn/ir/group_schedule/tactic/compute_inline_tactic.h"
 #include "paddle/cinn/ir/group_schedule/tactic/tile_first_general_tactic.h"
+#include "paddle/cinn/ir/group_schedule/tactic/x86_vectorize_tactic.h"
 #include "paddle/cinn/ir/ir_analyzer/ir_analyzer.h"
 #include "paddle/cinn/ir/op/ir_operators.h"
 #include "paddle/common/enforce.h"
 
 PD_DECLARE_bool(cinn_bucket_compile);
+PD_DECLARE_bool(cinn_bucket_compile_divisible);
 
 namespace cinn {
 namespace ir {
@@ -32,10 +35,23 @@ void DynamicShapeGroupScheduler::Init() {
   VLOG(4) << "original group func body: \n"
           << ir_sch_->GetModule().GetExprs()[0];
   InitBuckets();
-  tactics_.emplace_back(CreateTileFirstGeneralTactic());
-  VLOG(4) << "CreateTileFirstGeneralTactic End";
-  tactics_.emplace_back(CreateComputeInlineTactic());
-  VLOG(4) << "CreateTileCreateComputeInlineTactic End";
+  target_.arch.Match(
+      [&](common::X86Arch) {
+        // Inline first, so that the fused loops of the remaining blocks are
+        // parallelized once.
+        tactics_.emplace_back(CreateComputeInlineTactic());
+        tactics_.emplace_back(CreateX86VectorizeTactic());
+        VLOG(4) << "CreateX86VectorizeTactic End";
+      },
+      [&](std::variant<common::UnknownArch,
+                       common::ARMArch,
+                       common::NVGPUArch,
+                       common::HygonDCUArchHIP>) {
+        tactics_.emplace_back(CreateTileFirstGeneralTactic());
+        VLOG(4) << "CreateTileFirstGeneralTactic End";
+        tactics_.emplace_back(CreateComputeInlineTactic());
+        VLOG(4) << "CreateTileCreateComputeInlineTactic End";
+      });
 }
 
 void DynamicShapeGroupScheduler::InitBuckets() {
@@ -54,7 +70,9 @@ void DynamicShapeGroupScheduler::InitBuckets() {
     return false;
   };
 
-  auto InitBucket = [&](BucketInfo&& bucket_info, ScheduleConfig&& config) {
+  auto InitBucket = [&](BucketInfo&& bucket_info,
+                        ScheduleConfig&& config,
+                        int64_t sp_extent_divisor) {
     std::unique_ptr<ir::IRSchedule> ir_sch =
         std::make_unique<ir::IRSchedule>(*ir_sch_);
     std::unique_ptr<ir::ScheduleBlockGraph> schedule_block_graph =
@@ -109,13 +127,28 @@ void DynamicShapeGroupScheduler::InitBuckets() {
           ir::And::Make(lower_bound_predicate, upper_bound_predicate);
       predicate = ir::And::Make(predicate, curr_predicate);
     }
+    int priority = bucket_info.bucket_priority;
+    if (sp_extent_divisor > 1) {
+      // A static extent is known to be divisible or not at compile time.
+      ir::Expr sp_extent = iter_space_info.total_sp_extent;
+      if (sp_extent.is_constant()) return;
+      ir::Expr divisor =
+          common::make_const(sp_extent.type(), sp_extent_divisor);
+      SymbolicPredicate divisible_predicate =
+          ir::EQ::Make(ir::Mod::Make(sp_extent, divisor),
+                       common::make_const(sp_extent.type(), 0));
+      predicate = ir::And::Make(predicate, divisible_predicate);
+      // Checked before the bucket it specializes.
+      ++priority;
+    }
     ScheduleContext schedule_context{output_names,
                                      target_,
                                      std::move(iter_space_info),
                                      std::move(bucket_info),
-                                     std::move(config)};
+                                     std::move(config),
+                                     sp_extent_divisor};
     BucketContext bucket_context{std::move(predicate),
-                                 bucket_info.bucket_priority,
+                                 priority,
                                  std::move(ir_sch),
                                  std::move(schedule_block_graph),
                                  std::move(schedule_context)};
@@ -128,8 +161,26 @@ void DynamicShapeGroupScheduler::InitBuckets() {
   std::unordered_map<BucketInfo, ScheduleConfig, BucketInfoHash> configs =
       schedule_config_manager.ExtractConfigs(target_, group_info_);
   for (std::pair<BucketInfo, ScheduleConfig>&& config : configs) {
-    InitBucket(std::move(config.first), std::move(config.second));
+    if (FLAGS_cinn_bucket_compile_divisible) {
+      int64_t sp_extent_divisor = SpatialExtentDivisor(config.second);
+      if (sp_extent_divisor > 1) {
+        InitBucket(BucketInfo(config.first),
+                   ScheduleConfig(config.second),
+                   sp_extent_divisor);
+      }
+    }
+    InitBucket(std::move(config.first), std::move(config.second), 1);
+  }
+}
+
+int64_t DynamicShapeGroupScheduler::SpatialExtentDivisor(
+    const ScheduleConfig& config) const {
+  // The x86 module is linked without the host function that selects the
+  // kernels by their predicates.
+  if (std::holds_alternative<common::X86Arch>(target_.arch)) {
+    return 1;
   }
+  return GetSpatialTileSize(config);
 }
 
 void DynamicShapeGroupScheduler::Schedule() {
@@ -185,7 +236,7 @@ std::vector<std::pair<SymbolicPredicate, ir::Expr>>
 DynamicShapeGroupScheduler::GetCX86IRs() {
   std::vector<std::pair<SymbolicPredicate, ir::Expr>> irs(1);
   irs[0].first = ir::EQ::Make(ir::Expr(1), ir::Expr(1));
-  irs[1].second = ir_sch_->GetModule().GetExprs()[0];
+  irs[0].second = ir_sch_->GetModule().GetExprs()[0];
   return irs;
 }
 
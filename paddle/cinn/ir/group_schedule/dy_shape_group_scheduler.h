@@ -53,6 +53,10 @@ class DynamicShapeGroupScheduler : public GroupScheduler {
 
   void InitBuckets();
 
+  // The spatial extents that are multiples of it get a bucket of their own,
+  // see FLAGS_cinn_bucket_compile_divisible.
+  int64_t SpatialExtentDivisor(const ScheduleConfig& config) const;
+
   void ApplyTactics(BucketContext* bucket_context);
 
   ir::ScheduleBlockNode* FindGlobalMasterNode(
@@ -100,6 +100,14 @@ ScoreType WeightedSamplingTrailObjectiveFunc::operator()(
   if (candidate.size() != 0) {
     ScheduleConfig::TileConfig config{
         candidate[0], candidate[1], candidate[2], NoneReduceMethod()};
+    // The optional elements are the index of the reduce method and the
+    // grid reduce num.
+    if (candidate.size() > 3) {
+      config.reduce_method = ReduceMethodFromIndex(candidate[3]);
+    }
+    if (candidate.size() > 4) {
+      config.grid_reduce_num = candidate[4];
+    }
     tile_config_database->AddConfig(
         cinn::common::DefaultTarget(), bucket_info_, config);
     auto& schedule_config_manager = ScheduleConfigManager::Instance();
@@ -0,0 +1,176 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/cinn/ir/group_schedule/search/tile_config_tuner.h"
+
+#include "paddle/cinn/common/target.h"
+#include "paddle/cinn/utils/string.h"
+#include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+
+PD_DECLARE_bool(cinn_measure_kernel_time);
+PD_DECLARE_string(tile_config_policy);
+PD_DECLARE_bool(enable_cinn_compile_cache);
+
+namespace cinn {
+namespace ir {
+namespace search {
+
+namespace {
+
+constexpr int kThreadsPerWarp = 32;
+constexpr int kMaxThreadsPerBlock = 1024;
+
+bool IsPowerOfTwo(int64_t n) { return n > 0 && (n & (n - 1)) == 0; }
+
+// Every candidate is compiled with the config of the "search" database, its
+// kernels are timed, and the compile cache must not return the kernels of
+// the previous candidate.
+class SearchFlagsGuard {
+ public:
+  SearchFlagsGuard()
+      : measure_kernel_time_(FLAGS_cinn_measure_kernel_time),
+        tile_config_policy_(FLAGS_tile_config_policy),
+        enable_compile_cache_(FLAGS_enable_cinn_compile_cache) {
+    FLAGS_cinn_measure_kernel_time = true;
+    FLAGS_tile_config_policy = "search";
+    FLAGS_enable_cinn_compile_cache = false;
+  }
+
+  ~SearchFlagsGuard() {
+    FLAGS_cinn_measure_kernel_time = measure_kernel_time_;
+    FLAGS_tile_config_policy = tile_config_policy_;
+    FLAGS_enable_cinn_compile_cache = enable_compile_cache_;
+  }
+
+ private:
+  bool measure_kernel_time_;
+  std::string tile_config_policy_;
+  bool enable_compile_cache_;
+};
+
+}  // namespace
+
+std::vector<ConstraintFunc> DefaultTileConfigConstraints(
+    const BucketInfo& bucket_info) {
+  bool has_reduce = false;
+  for (const auto& dim : bucket_info.space) {
+    if (dim.iter_type == "R") {
+      has_reduce = true;
+    }
+  }
+  const int64_t kNone = ReduceMethodToIndex(NoneReduceMethod());
+  const int64_t kWarp = ReduceMethodToIndex(WarpReduceMethod());
+  const int64_t kBlock = ReduceMethodToIndex(BlockReduceMethod());
+
+  std::vector<ConstraintFunc> constraints;
+  constraints.emplace_back([](const CandidateType& candidate) -> bool {
+    return IsPowerOfTwo(candidate[0]) &&
+           candidate[0] * kThreadsPerWarp <= kMaxThreadsPerBlock;
+  });
+  constraints.emplace_back([](const CandidateType& candidate) -> bool {
+    return IsPowerOfTwo(candidate[1]) &&
+           candidate[0] * kThreadsPerWarp % candidate[1] == 0;
+  });
+  constraints.emplace_back([](const CandidateType& candidate) -> bool {
+    return IsPowerOfTwo(candidate[2]);
+  });
+  constraints.emplace_back([=](const CandidateType& candidate) -> bool {
+    if (candidate.size() < 4) {
+      return true;
+    }
+    if (!has_reduce || candidate[1] == 1) {
+      return candidate[3] == kNone && candidate[1] == 1;
+    }
+    if (candidate[3] == kWarp) {
+      return candidate[1] <= kThreadsPerWarp;
+    }
+    if (candidate[3] == kBlock) {
+      return candidate[1] >= kThreadsPerWarp;
+    }
+    return false;
+  });
+  return constraints;
+}
+
+TileConfigTuner::TileConfigTuner(::pir::Program* program,
+                                 const TileConfigTuneOptions& options)
+    : program_(program), options_(options) {
+  PADDLE_ENFORCE_GE(options_.candidate_range.size(),
+                    3UL,
+                    ::common::errors::InvalidArgument(
+                        "The candidate range should at least contain the "
+                        "ranges of warp_num, tree_reduce_num and "
+                        "spatial_inner_num."));
+}
+
+std::pair<ScoreType, ScheduleConfig::TileConfig> TileConfigTuner::Tune(
+    const BucketInfo& bucket_info) {
+  SearchFlagsGuard flags_guard;
+  std::vector<std::unique_ptr<BaseObjectiveFunc>> objective_funcs;
+  objective_funcs.emplace_back(
+      std::make_unique<WeightedSamplingTrailObjectiveFunc>(
+          program_,
+          bucket_info,
+          options_.sampling_prob,
+          options_.max_sampling_times,
+          options_.repeats));
+
+  std::vector<ConstraintFunc> constraints =
+      DefaultTileConfigConstraints(bucket_info);
+  constraints.insert(constraints.end(),
+                     options_.constraints.begin(),
+                     options_.constraints.end());
+
+  PADDLE_ENFORCE_EQ(
+      CandidateGenerator(options_.candidate_range, constraints)
+          .Candidates()
+          .empty(),
+      false,
+      ::common::errors::NotFound("No valid tile config candidate for %s.",
+                                 bucket_info.ToString()));
+  ScheduleConfigSearcher searcher(
+      std::move(objective_funcs), options_.candidate_range, constraints);
+  auto [score, candidate] = searcher.Search();
+
+  ScheduleConfig::TileConfig tile_config;
+  tile_config.warp_num = candidate[0];
+  tile_config.tree_reduce_num = candidate[1];
+  tile_config.spatial_inner_num = candidate[2];
+  if (candidate.size() > 3) {
+    tile_config.reduce_method = ReduceMethodFromIndex(candidate[3]);
+  }
+  if (candidate.size() > 4) {
+    tile_config.grid_reduce_num = candidate[4];
+  }
+  VLOG(3) << "Best candidate of " << bucket_info.ToString() << ": ["
+          << utils::Join<int64_t>(candidate, ", ") << "], score = " << score;
+  return {score, tile_config};
+}
+
+void TileConfigTuner::TuneAndSave(const std::vector<BucketInfo>& buckets,
+                                  TileConfigDatabase* database,
+                                  int priority) {
+  for (const auto& bucket_info : buckets) {
+    auto [score, tile_config] = Tune(bucket_info);
+    database->AddConfig(
+        cinn::common::DefaultTarget(), bucket_info, tile_config, priority);
+    LOG(INFO) << "Record the tile config of " << bucket_info.ToString()
+              << " with score " << score;
+  }
+}
+
+}  // namespace search
+}  // namespace ir
+}  // namespace cinn
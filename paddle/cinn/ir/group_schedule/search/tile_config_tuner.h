@@ -0,0 +1,83 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "paddle/cinn/ir/group_schedule/config/database.h"
+#include "paddle/cinn/ir/group_schedule/config/group_tile_config.h"
+#include "paddle/cinn/ir/group_schedule/search/config_searcher.h"
+#include "paddle/pir/include/core/program.h"
+
+namespace cinn {
+namespace ir {
+namespace search {
+
+struct TileConfigTuneOptions {
+  double sampling_prob = 1.0;
+  int max_sampling_times = 300;
+  int repeats = 3;
+  // The ranges of warp_num, tree_reduce_num, spatial_inner_num and the index
+  // of the reduce method, see ReduceMethodFromIndex.
+  std::vector<std::pair<int, int>> candidate_range{
+      {1, 32}, {1, 1024}, {1, 8}, {0, 2}};
+  // Appended to the constraints of DefaultTileConfigConstraints.
+  std::vector<ConstraintFunc> constraints;
+};
+
+/**
+ * The constraints that keep a candidate launchable on the bucket: the block
+ * has at most 1024 threads which are a multiple of tree_reduce_num, the
+ * buckets without reduce dimensions do not reduce, and the reduce method
+ * matches tree_reduce_num, i.e. warp reduce within a warp and block reduce
+ * across whole warps.
+ */
+std::vector<ConstraintFunc> DefaultTileConfigConstraints(
+    const BucketInfo& bucket_info);
+
+/**
+ * TileConfigTuner measures the tile config candidates of each bucket by
+ * compiling and running the program on the device, and records the fastest
+ * one in a tile config database. A FileTileConfigDatabase produced offline is
+ * read at compile time when FLAGS_tile_config_policy is "optimal" or
+ * "hybrid".
+ *
+ * The program has a single input named "x" whose dimensions are sampled
+ * from the bucket, as WeightedSamplingTrailObjectiveFunc does.
+ */
+class TileConfigTuner {
+ public:
+  TileConfigTuner(::pir::Program* program,
+                  const TileConfigTuneOptions& options = {});
+
+  // Returns the fastest tile config of the bucket with its average kernel
+  // execution time.
+  std::pair<ScoreType, ScheduleConfig::TileConfig> Tune(
+      const BucketInfo& bucket_info);
+
+  void TuneAndSave(const std::vector<BucketInfo>& buckets,
+                   TileConfigDatabase* database,
+                   int priority = 0);
+
+ private:
+  ::pir::Program* program_;
+  TileConfigTuneOptions options_;
+};
+
+}  // namespace search
+}  // namespace ir
+}  // namespace cinn
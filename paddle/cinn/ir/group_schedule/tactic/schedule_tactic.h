@@ -87,6 +87,9 @@ struct ScheduleContext {
   IterativeSpaceInfo iter_space_info;
   BucketInfo bucket_info;
   ScheduleConfig config;
+  // The bucket only holds the total spatial extents that are multiples of
+  // it, so that the tactics may split them without bound checks.
+  int64_t sp_extent_divisor{1};
 };
 
 class ScheduleTactic {
@@ -49,6 +49,17 @@ bool UseContinuousDataTile(const ScheduleConfig& config) {
   return last_axis == last_reduce_axis;
 }
 
+int64_t GetSpatialTileSize(const ScheduleConfig& config) {
+  const int64_t reduce_rank = config.base_info->reduce_axis.size();
+  if (!UseContinuousDataTile(config) ||
+      reduce_rank >= config.base_info->data_rank) {
+    return 1;
+  }
+  const auto& tile_config = config.tile_config;
+  return tile_config.spatial_inner_num *
+         (tile_config.warp_num * 32 / tile_config.tree_reduce_num);
+}
+
 class TileFirstGeneralTactic final : public ScheduleTactic {
  public:
   void Init(ScheduleContext* context) override;
@@ -193,18 +204,33 @@ void TileFirstGeneralTactic::ApplyContinuousDataTile(
   int current_reduce_axis = 0;
   if (vec_flatten_axis_.size() > 0) {
     auto loops = sch->GetLoops(block_id);
+    ir::Expr sp_extent = loops[0].As<ir::For>()->extent;
+    std::vector<ir::Expr> splited_loops;
     if (sp_loop > 1 && sp_thread > 1) {
       // [S, R] => [S(-1), S(inner_loop), S(thread), R]
-      sch->Split(loops[0], {-1, sp_loop, sp_thread});
+      splited_loops = sch->Split(loops[0], {-1, sp_loop, sp_thread});
       current_reduce_axis = 3;
     } else if (sp_loop > 1 || sp_thread > 1) {
       // [S, R] => [S(-1), S(thread), R]
-      sch->Split(loops[0], {-1, sp_loop > 1 ? sp_loop : sp_thread});
+      splited_loops =
+          sch->Split(loops[0], {-1, sp_loop > 1 ? sp_loop : sp_thread});
       current_reduce_axis = 2;
     } else {
       // [S, R] => [S, R]
       current_reduce_axis = 1;
     }
+    // The divisible buckets need no bound check on the spatial tile.
+    const int64_t sp_tile = sp_loop * sp_thread;
+    if (!splited_loops.empty() && !sp_extent.is_constant() &&
+        context_->sp_extent_divisor % sp_tile == 0) {
+      cinn::common::cas_intervals_t var_intervals = {};
+      cinn::common::SymbolicExprAnalyzer analyzer(var_intervals);
+      if (analyzer
+              .ProveEQ(sp_extent, context_->iter_space_info.total_sp_extent)
+              .value_or(false)) {
+        MakeSplitExact(splited_loops, sp_extent, sp_tile);
+      }
+    }
   }
   VLOG(4) << "After SplitSptial on block: [" << block_id << "], loop nest:\n"
           << sch->GetModule().GetExprs().front();
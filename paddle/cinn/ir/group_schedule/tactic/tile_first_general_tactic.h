@@ -22,5 +22,9 @@ namespace ir {
 
 std::unique_ptr<ScheduleTactic> CreateTileFirstGeneralTactic();
 
+// The product of the inner factors the tactic splits the fused spatial loop
+// by under the config, 1 if the loop is not split that way.
+int64_t GetSpatialTileSize(const ScheduleConfig& config);
+
 }  // namespace ir
 }  // namespace cinn
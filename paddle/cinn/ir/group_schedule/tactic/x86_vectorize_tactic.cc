@@ -0,0 +1,135 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/cinn/ir/group_schedule/tactic/x86_vectorize_tactic.h"
+
+#include <numeric>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/cinn/ir/ir.h"
+#include "paddle/cinn/ir/ir_analyzer/ir_analyzer.h"
+#include "paddle/cinn/ir/schedule/ir_schedule_util.h"
+#include "paddle/cinn/ir/utils/ir_nodes_collector.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+
+PD_DECLARE_int32(cinn_x86_vector_bits);
+
+namespace cinn {
+namespace ir {
+
+namespace {
+
+// The number of the outermost loops of the block that only iterate the
+// spatial axes, they can be fused and run in parallel.
+size_t CountLeadingSpatialLoops(const ir::Expr& block,
+                                const std::vector<ir::Expr>& loops) {
+  const auto* realize = block.As<ir::ScheduleBlockRealize>();
+  const std::vector<ir::Var>& iter_vars =
+      realize->schedule_block.As<ir::ScheduleBlock>()->iter_vars;
+  std::unordered_set<std::string> reduce_loop_vars;
+  for (size_t i = 0; i < iter_vars.size(); ++i) {
+    if (!iter_vars[i]->is_reduce_axis) continue;
+    ir::ir_utils::CollectIRNodesWithoutTensor(
+        realize->iter_values[i], [&](const ir::Expr* x) {
+          if (x->as_var()) {
+            reduce_loop_vars.insert(x->as_var()->name);
+          }
+          return false;
+        });
+  }
+  size_t count = 0;
+  for (const ir::Expr& loop : loops) {
+    if (reduce_loop_vars.count(loop.As<ir::For>()->loop_var->name) > 0) {
+      break;
+    }
+    ++count;
+  }
+  return count;
+}
+
+// The widest SIMD width in bits of the host CPU, the CINN kernels for x86
+// are compiled for the host.
+int HostVectorBits() {
+  using phi::backends::cpu::MayIUse;
+  if (MayIUse(phi::backends::cpu::avx512f)) return 512;
+  if (MayIUse(phi::backends::cpu::avx2)) return 256;
+  if (MayIUse(phi::backends::cpu::sse42)) return 128;
+  return 0;
+}
+
+}  // namespace
+
+class X86VectorizeTactic final : public ScheduleTactic {
+ public:
+  void Init(ScheduleContext* context) override;
+
+  void Apply(ir::IRSchedule* sch, const std::string& block_id) override;
+
+  std::string TacticName() const override { return "X86VectorizeTactic"; }
+
+ private:
+  int vector_bits_{0};
+};
+
+void X86VectorizeTactic::Init(ScheduleContext* context) {
+  static const int host_vector_bits = HostVectorBits();
+  vector_bits_ = FLAGS_cinn_x86_vector_bits < 0 ? host_vector_bits
+                                                : FLAGS_cinn_x86_vector_bits;
+}
+
+void X86VectorizeTactic::Apply(ir::IRSchedule* sch,
+                               const std::string& block_id) {
+  // The init block shares the spatial loops of its reduce block.
+  if (ir::IsReduceInitTensorName(block_id)) return;
+
+  std::vector<ir::Expr> loops = sch->GetLoops(block_id);
+  size_t spatial_num = CountLeadingSpatialLoops(sch->GetBlock(block_id), loops);
+  if (spatial_num == 0) {
+    VLOG(4) << "Block [" << block_id << "] has no spatial loop to parallel";
+    return;
+  }
+  if (spatial_num > 1) {
+    std::vector<int> loops_index(spatial_num);
+    std::iota(loops_index.begin(), loops_index.end(), 0);
+    sch->Fuse(block_id, loops_index);
+    loops = sch->GetLoops(block_id);
+  }
+
+  // Only the blocks without reduce loops are vectorized, a reduce loop would
+  // need a horizontal reduction of the vector lanes.
+  ir::Expr fused = loops[0];
+  ir::Expr extent = fused.As<ir::For>()->extent;
+  const int type_bits =
+      analyzer::GetStoreTensorOfSBlock(sch->GetBlock(block_id))->type().bits();
+  const int factor = type_bits > 0 ? vector_bits_ / type_bits : 0;
+  if (loops.size() == 1 && factor > 1 && extent.is_constant() &&
+      extent.get_constant() > factor &&
+      static_cast<int64_t>(extent.get_constant()) % factor == 0) {
+    std::vector<ir::Expr> splited = sch->Split(fused, {-1, factor});
+    sch->Parallel(splited[0]);
+    sch->Vectorize(splited[1], factor);
+    VLOG(4) << "Vectorize block [" << block_id << "] by " << factor;
+    return;
+  }
+  sch->Parallel(fused);
+}
+
+std::unique_ptr<ScheduleTactic> CreateX86VectorizeTactic() {
+  return std::make_unique<X86VectorizeTactic>();
+}
+
+}  // namespace ir
+}  // namespace cinn
@@ -0,0 +1,30 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include "paddle/cinn/ir/group_schedule/tactic/schedule_tactic.h"
+
+namespace cinn {
+namespace ir {
+
+// Schedules a group for x86: the spatial loops of each block are fused and
+// run by the thread pool of the CINN runtime, and the innermost spatial loop
+// of an elementwise block is vectorized by FLAGS_cinn_x86_vector_bits, by
+// default the SIMD width of the host CPU.
+std::unique_ptr<ScheduleTactic> CreateX86VectorizeTactic();
+
+}  // namespace ir
+}  // namespace cinn
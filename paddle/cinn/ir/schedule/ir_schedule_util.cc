@@ -1600,5 +1600,33 @@ std::vector<int> SampleTile(utils::LinearRandomEngine::StateType* rand_seed,
   tile.push_back(extent);
   return tile;
 }
+
+void MakeSplitExact(const std::vector<Expr>& splited_loops,
+                    const Expr& extent,
+                    int inner_size) {
+  PADDLE_ENFORCE_GE(splited_loops.size(),
+                    2UL,
+                    ::common::errors::InvalidArgument(
+                        "A split loop should have at least 2 loops, but "
+                        "received %d.",
+                        splited_loops.size()));
+  Expr outer = splited_loops.front();
+  outer.As<ir::For>()->extent =
+      cinn::common::AutoSimplify(extent / Expr(inner_size));
+  Expr inner = splited_loops.back();
+  auto* body = inner.As<ir::For>()->body.As<ir::Block>();
+  if (body == nullptr || body->stmts.size() != 1) return;
+  const auto* guard = body->stmts[0].As<ir::IfThenElse>();
+  if (guard == nullptr || guard->false_case.defined()) return;
+  // Only the bound check Split adds compares with the extent itself.
+  const auto* cond = guard->condition.As<ir::LT>();
+  if (cond == nullptr || !(cond->b() == extent)) return;
+  Expr true_case = guard->true_case;
+  if (true_case.As<ir::Block>()) {
+    body->stmts = true_case.As<ir::Block>()->stmts;
+  } else {
+    body->stmts = {true_case};
+  }
+}
 }  // namespace ir
 }  // namespace cinn
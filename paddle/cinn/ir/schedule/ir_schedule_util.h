@@ -358,6 +358,18 @@ std::vector<int> SampleTile(utils::LinearRandomEngine::StateType* rand_seed,
                             int n,
                             int dividend);
 
+/*!
+ * \brief Make the Split of a loop of dynamic extent exact, when the extent is
+ * known to be a multiple of the product of the inner factors. The extra
+ * iteration of the outer loop and the bound check of the body are dropped.
+ * \param splited_loops The loops returned by Split.
+ * \param extent The extent of the loop before Split.
+ * \param inner_size The product of the factors of the inner loops.
+ */
+void MakeSplitExact(const std::vector<Expr>& splited_loops,
+                    const Expr& extent,
+                    int inner_size);
+
 // a struct to present the min value and the extent of a iterable range,
 // where it is represented as a semi-closed interval, i.e [min, min + extent)
 struct IterRange {
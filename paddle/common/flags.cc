@@ -102,6 +102,24 @@ PHI_DEFINE_EXPORTED_int32(
     0,
     "Setting the check and print level when FLAGS_check_nan_inf is set.");
 
+/**
+ * Operator related FLAG
+ * Name: FLAGS_check_nan_inf_async
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Used with FLAGS_check_nan_inf. The outputs of the operators are
+ * checked without synchronizing with the devices: the numbers of NaN and Inf
+ * elements are added to counters in the memory of the devices, and fetched by
+ * paddle.amp.debugging.get_nan_inf_count, e.g. once per step. The
+ * FLAGS_check_nan_inf_level and the debug path are ignored.
+ */
+PHI_DEFINE_EXPORTED_bool(
+    check_nan_inf_async,
+    false,
+    "Checking NaN and Inf without synchronizing when FLAGS_check_nan_inf "
+    "is set, the numbers of them are counted on the devices.");
+
 /**
  * Operator related FLAG
  * Name: FLAGS_check_nan_inf
@@ -198,6 +216,24 @@ PHI_DEFINE_EXPORTED_int64(
     0,
     "The times of exhaustive search for cuBlasLt matmul with/without "
     " epilogue algorithms, default is 0, means disabling exhaustive search.");
+
+/**
+ * CUDA related FLAG
+ * Name: FLAGS_cublaslt_skinny_gemm_search
+ * Since Version: 3.0.0
+ * Value Range: bool, default=true
+ * Example:
+ * Note: Whether to search the cuBlasLt algorithm, split-K ones included, for
+ *       skinny matmul whose M or N is not larger than 16 and K is not less
+ *       than 1024, like the ones in decode-phase inference. The searched
+ *       algorithm is cached in the matmul autotune cache even if autotune
+ *       is not enabled.
+ */
+PHI_DEFINE_EXPORTED_bool(
+    cublaslt_skinny_gemm_search,
+    true,
+    "Whether to search the cuBlasLt algorithm with split-K candidates for "
+    "skinny matmul and cache it, default is true.");
 #endif
 
 /*
@@ -213,6 +249,22 @@ PHI_DEFINE_EXPORTED_bool(
     true,
     "Whether enable api kernel fallback to CPU one when not found");
 
+/**
+ * CPU random related FLAG
+ * Name: FLAGS_use_philox_cpu_random
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, the CPU uniform, gaussian and dropout kernels draw from a
+ * Philox counter-based engine with the seed and offset of the generator as
+ * the GPU kernels do, in parallel, instead of the sequential mt19937_64
+ * engine of the generator. The numbers don't depend on the number of threads.
+ */
+PHI_DEFINE_EXPORTED_bool(use_philox_cpu_random,
+                         false,
+                         "Whether the CPU random kernels use the Philox "
+                         "counter-based engine.");
+
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 /**
  * CUDNN related FLAG
@@ -458,6 +510,25 @@ PHI_DEFINE_EXPORTED_double(
     "only the FLAGS_memory_fraction_of_eager_deletion of the largest "
     "variables would be deleted.");
 
+/**
+ * Memory related FLAG
+ * Name: FLAGS_naive_executor_eager_deletion
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Whether the NaiveExecutor of inference releases the temporary
+ *       variables right after their last use. The ops after which each
+ *       variable is released are computed once when the executor is
+ *       prepared, so no reference is counted while running. Only works
+ *       when the memory optimization of inference is disabled and the
+ *       program has no control flow ops.
+ */
+PHI_DEFINE_EXPORTED_bool(
+    naive_executor_eager_deletion,
+    false,
+    "Whether the NaiveExecutor releases the temporary variables after "
+    "their last use, by a plan computed when it is prepared.");
+
 /**
  * Allocator related FLAG
  * Name: FLAGS_allocator_strategy
@@ -483,6 +554,87 @@ PHI_DEFINE_EXPORTED_string(
     "on the same GPU card but may lead to more memory fragmentation "
     "(i.e., maximum batch size of models may be smaller).");
 
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cpu_allocator_strategy
+ * Since Version: 3.1.0
+ * Value Range: string, {system, thread_local_cache}, default=system
+ * Example:
+ * Note: For selecting the allocator policy of CPUPlace. thread_local_cache
+ *       puts a per-thread cache in front of the system allocator, which
+ *       reduces malloc contention when many threads run CPU kernels.
+ */
+PHI_DEFINE_EXPORTED_string(
+    cpu_allocator_strategy,
+    "system",
+    "The CPU allocation strategy, enum in [system, thread_local_cache]. "
+    "system means allocating from the system allocator directly. "
+    "thread_local_cache means caching small freed blocks per thread and "
+    "exchanging them with a central pool in batches.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cpu_allocator_thread_cache_size_in_mb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=16 (MB)
+ * Example:
+ * Note: The max bytes cached by each thread when
+ *       FLAGS_cpu_allocator_strategy=thread_local_cache.
+ */
+PHI_DEFINE_EXPORTED_uint64(
+    cpu_allocator_thread_cache_size_in_mb,
+    16,
+    "The max bytes (in MB) cached by each thread when "
+    "FLAGS_cpu_allocator_strategy=thread_local_cache.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cpu_allocator_numa_policy
+ * Since Version: 3.1.0
+ * Value Range: string, {none, local, interleave}, default=none
+ * Example:
+ * Note: The NUMA placement of large CPU blocks, only works on Linux. local
+ *       prefers the node of the allocating thread, interleave spreads the
+ *       pages over all the nodes, which suits weights read by threads on
+ *       every socket.
+ */
+PHI_DEFINE_EXPORTED_string(
+    cpu_allocator_numa_policy,
+    "none",
+    "The NUMA policy of large CPU blocks, enum in [none, local, interleave].");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cpu_allocator_huge_page
+ * Since Version: 3.1.0
+ * Value Range: string, {none, transparent, explicit}, default=none
+ * Example:
+ * Note: Whether to back large CPU blocks with huge pages, only works on
+ *       Linux. transparent advises the kernel to use transparent huge pages,
+ *       explicit maps hugetlbfs pages and falls back to transparent ones
+ *       when none is reserved.
+ */
+PHI_DEFINE_EXPORTED_string(
+    cpu_allocator_huge_page,
+    "none",
+    "The huge page policy of large CPU blocks, enum in [none, transparent, "
+    "explicit].");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cpu_allocator_huge_page_threshold_in_mb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=2 (MB)
+ * Example:
+ * Note: CPU blocks not smaller than this use huge pages when
+ *       FLAGS_cpu_allocator_huge_page is not none.
+ */
+PHI_DEFINE_EXPORTED_uint64(
+    cpu_allocator_huge_page_threshold_in_mb,
+    2,
+    "CPU blocks not smaller than this (in MB) use huge pages when "
+    "FLAGS_cpu_allocator_huge_page is not none.");
+
 /**
  * Memory related FLAG
  * Name: FLAGS_fraction_of_cpu_memory_to_use
@@ -744,6 +896,70 @@ PHI_DEFINE_EXPORTED_int32(
     "less FLAGS_max_inplace_grad_add, than it will be use several grad_add"
     "instead of sum. Default is 0.");
 
+/**
+ * Performance related FLAG
+ * Name: eager_backward_thread_num
+ * Since Version: 3.2.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_eager_backward_thread_num=4 runs the ready grad nodes of a
+ * backward() on CPU with 4 threads.
+ * Note: Only backward() on CPU without create_graph runs in parallel, the
+ * leaf gradients are still accumulated by the calling thread. 0 or 1 keeps
+ * the sequential engine.
+ */
+PHI_DEFINE_EXPORTED_int32(
+    eager_backward_thread_num,
+    0,
+    "The number of threads running the grad nodes of an eager backward, "
+    "0 or 1 runs them one by one in the calling thread. Default is 0.");
+
+/**
+ * Performance related FLAG
+ * Name: eager_backward_deterministic
+ * Since Version: 3.2.0
+ * Value Range: bool, default=true
+ * Example:
+ * Note: If True, the parallel eager backward sums the gradients of a grad
+ * node in a fixed order of their producers instead of the order they are
+ * done, so that the result does not change from run to run.
+ */
+PHI_DEFINE_EXPORTED_bool(eager_backward_deterministic,
+                         true,
+                         "Sum the gradients in a fixed order in the "
+                         "parallel eager backward.");
+
+/**
+ * Performance related FLAG
+ * Name: eager_grad_add_n_max_inputs
+ * Since Version: 3.2.0
+ * Value Range: int32, default=8
+ * Example: FLAGS_eager_grad_add_n_max_inputs=16 keeps up to 15 gradients of
+ * a tensor before summing them into the first one with one add_n kernel.
+ * Note: The gradients kept wait in memory until they are summed, 0 or 1
+ * adds each gradient as it comes.
+ */
+PHI_DEFINE_EXPORTED_int32(
+    eager_grad_add_n_max_inputs,
+    8,
+    "The most gradients of a tensor summed at once with add_n in the eager "
+    "backward, 0 or 1 adds them one by one. Default is 8.");
+
+/**
+ * Performance related FLAG
+ * Name: eager_async_kernel_launch
+ * Since Version: 3.2.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_eager_async_kernel_launch=true leaves the GPU kernel calls
+ * of the C++ APIs to a launcher thread.
+ * Note: The shapes are still inferred and the outputs allocated on the
+ * calling thread, which waits for the queued kernels before reading the
+ * data of a tensor on the host or running a kernel itself.
+ */
+PHI_DEFINE_EXPORTED_bool(eager_async_kernel_launch,
+                         false,
+                         "Call the GPU kernels of the C++ APIs on a launcher "
+                         "thread, asynchronously to the calling thread.");
+
 /**
  * Tensor.numpy() has a hack, and this flag can close this hack
  * [true]: set 0D Tensor to 1D Numpy
@@ -891,6 +1107,96 @@ PHI_DEFINE_EXPORTED_bool(enable_neighbor_list_use_uva,
                          false,
                          "It controls whether store neighbor_list with UVA");
 
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_gpugraph_neighbor_hbm_ratio
+ * Since Version: 3.1.0
+ * Value Range: double, [0.0, 1.0], default=1.0
+ * Example:
+ * Note: With FLAGS_enable_neighbor_list_use_uva, the fraction of the
+ *       neighbor_list of each gpu kept in HBM, the neighbors of the highest
+ *       degree nodes first. The rest stays in host memory and is read by the
+ *       sampling kernels over UVA, so graphs larger than the HBM of the gpus
+ *       can be sampled.
+ */
+PHI_DEFINE_EXPORTED_double(
+    gpugraph_neighbor_hbm_ratio,
+    1.0,
+    "With enable_neighbor_list_use_uva, the fraction of the neighbor_list "
+    "kept in HBM, the neighbors of the highest degree nodes first");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_gpups_prebuild_pass_budget_mb
+ * Since Version: 3.1.0
+ * Value Range: int64, default=0
+ * Example:
+ * Note: The host memory, in MB, the key and value pointer lists of the next
+ *       pass may take to be split to the gpus by the build pull thread while
+ *       the current pass trains, instead of in BeginPass. 0 disables it.
+ */
+PHI_DEFINE_EXPORTED_int64(
+    gpups_prebuild_pass_budget_mb,
+    0,
+    "The host memory in MB the next pass may take to be split to the gpus "
+    "while the current pass trains, 0 to split it in BeginPass");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_webhdfs_endpoint
+ * Since Version: 3.1.0
+ * Value Range: string, host:port, default empty
+ * Example: FLAGS_webhdfs_endpoint=namenode:9870
+ * Note: The WebHDFS http server of the namenode. When set, the hdfs and afs
+ *       files are read and written over WebHDFS by the process itself,
+ *       instead of through a hadoop fs command per file.
+ */
+PHI_DEFINE_EXPORTED_string(
+    webhdfs_endpoint,
+    "",
+    "The host:port of the WebHDFS http server the hdfs and afs files are "
+    "read and written through, empty to use the hadoop fs command");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_webhdfs_user
+ * Since Version: 3.1.0
+ * Value Range: string, default empty
+ * Example:
+ * Note: The user.name of the WebHDFS requests, on clusters with simple
+ *       authentication.
+ */
+PHI_DEFINE_EXPORTED_string(webhdfs_user,
+                           "",
+                           "The user.name of the WebHDFS requests.");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_webhdfs_read_chunk_mb
+ * Since Version: 3.1.0
+ * Value Range: int32, default=8
+ * Example:
+ * Note: The size of the ranges a file read over WebHDFS is fetched by.
+ */
+PHI_DEFINE_EXPORTED_int32(webhdfs_read_chunk_mb,
+                          8,
+                          "The size in MB of the ranges a file read over "
+                          "WebHDFS is fetched by.");
+
+/**
+ * Distributed related FLAG
+ * Name: FLAGS_webhdfs_read_parallelism
+ * Since Version: 3.1.0
+ * Value Range: int32, default=4
+ * Example:
+ * Note: The number of ranges of a file read over WebHDFS fetched at once,
+ *       ahead of the reader.
+ */
+PHI_DEFINE_EXPORTED_int32(webhdfs_read_parallelism,
+                          4,
+                          "The number of ranges of a file read over WebHDFS "
+                          "fetched at once, ahead of the reader.");
+
 /**
  * Distributed related FLAG
  * Name: FLAGS_graph_neighbor_size_percent
@@ -1063,6 +1369,91 @@ PHI_DEFINE_EXPORTED_int64(
     cinn_compile_thread_num,
     -1,
     "It controls how many thread numbers applying compilation cache.");
+/**
+ * CINN related FLAG
+ * Name: FLAGS_cinn_compilation_cache_dir
+ * Since Version: 3.1.0
+ * Value Range: string, default=""
+ * Example: FLAGS_cinn_compilation_cache_dir=/tmp/cinn_cache
+ * Note: The directory where the compiled kernels of CINN groups are saved, so
+ * that other processes and later runs load them instead of compiling again.
+ * It is disabled when empty, and requires FLAGS_enable_cinn_compile_cache.
+ */
+PHI_DEFINE_EXPORTED_string(cinn_compilation_cache_dir,
+                           "",
+                           "The directory of the persistent CINN compilation "
+                           "cache, disabled when empty.");
+/**
+ * CINN related FLAG
+ * Name: FLAGS_cinn_compilation_cache_max_mb
+ * Since Version: 3.1.0
+ * Value Range: int64, default=4096
+ * Example: FLAGS_cinn_compilation_cache_max_mb=1024
+ * Note: The least recently used entries of the persistent CINN compilation
+ * cache are removed once it is larger than this size. 0 means unlimited.
+ */
+PHI_DEFINE_EXPORTED_int64(cinn_compilation_cache_max_mb,
+                          4096,
+                          "The max size in MB of the persistent CINN "
+                          "compilation cache, 0 means unlimited.");
+/**
+ * CINN related FLAG
+ * Name: FLAGS_cinn_async_compile
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_cinn_async_compile=true
+ * Note: Compile the CINN groups on background threads. A group runs its
+ * original ops with phi kernels until its kernel is compiled, so that the
+ * first steps do not wait for the whole compilation.
+ */
+PHI_DEFINE_EXPORTED_bool(cinn_async_compile,
+                         false,
+                         "Whether to compile the CINN groups in background "
+                         "and run phi kernels meanwhile.");
+/**
+ * CINN related FLAG
+ * Name: FLAGS_cinn_horizontal_merge_subgraph
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_cinn_horizontal_merge_subgraph=true
+ * Note: Merge the independent CINN subgraphs whose outputs have the same
+ * shapes into one group, so that the operator fusion fuses them horizontally
+ * and they run in one kernel launch.
+ */
+PHI_DEFINE_EXPORTED_bool(cinn_horizontal_merge_subgraph,
+                         false,
+                         "Whether to merge the independent CINN subgraphs "
+                         "of the same output shapes for horizontal fusion.");
+/**
+ * CINN related FLAG
+ * Name: FLAGS_cinn_x86_vector_bits
+ * Since Version: 3.1.0
+ * Value Range: int32, default=-1
+ * Example: FLAGS_cinn_x86_vector_bits=512
+ * Note: The SIMD width in bits the CINN groups compiled for x86 are
+ * vectorized by, 256 for AVX2 and 512 for AVX-512. The default -1 takes
+ * the widest one the host CPU supports. 0 disables the vectorization, the
+ * outer loops are still run by the thread pool.
+ */
+PHI_DEFINE_EXPORTED_int32(cinn_x86_vector_bits,
+                          -1,
+                          "The SIMD width in bits of the CINN kernels on x86, "
+                          "-1 for the widest one of the host CPU.");
+/**
+ * CINN related FLAG
+ * Name: FLAGS_cinn_bucket_compile_divisible
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_cinn_bucket_compile_divisible=true
+ * Note: Also compile each bucket of a dynamic shape group on the GPU for the
+ * spatial extents that are a multiple of its spatial tile. These kernels are
+ * tiled without bound checks, and the host function selects them at runtime
+ * by the symbolic dims.
+ */
+PHI_DEFINE_EXPORTED_bool(cinn_bucket_compile_divisible,
+                         false,
+                         "Whether to compile the divisible spatial extents "
+                         "of the dynamic shape buckets as separate kernels.");
 /*
  * CINN related FLAG
  * Name: FLAGS_enable_interpretercore_launch_cinn
@@ -1178,6 +1569,22 @@ PHI_DEFINE_EXPORTED_double(
     "memory capacity while also attempting to minimize performance degradation "
     "caused by frequent memory synchronization.");
 
+/*
+ * CUDAMallocAsyncAllocator related FLAG
+ * Name: FLAGS_cuda_malloc_async_per_stream_pool
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Note: If True, each CUDAMallocAsyncAllocator, that is each stream used by the
+ * executor, allocates from its own cudaMemPool with cudaMallocFromPoolAsync
+ * instead of the default pool of the device. Blocks freed on a stream stay
+ * cached in the pool of that stream and are reused in stream order without
+ * any event polling. Please see Note [cuda_malloc_async_per_stream_pool]
+ */
+PHI_DEFINE_EXPORTED_bool(cuda_malloc_async_per_stream_pool,
+                         false,
+                         "Create a cudaMemPool for each stream in "
+                         "CUDAMallocAsyncAllocator");
+
 /*
  * CUDA Graph / Allocator related FLAG
  * Name: FLAGS_auto_free_cudagraph_allocations_on_launch
@@ -1221,6 +1628,27 @@ PD_DEFINE_bool(enable_slotrecord_reset_shrink,  // NOLINT
 PD_DEFINE_bool(enable_ins_parser_file,  // NOLINT
                false,
                "enable parser ins file, default false");
+PHI_DEFINE_EXPORTED_bool(
+    localfs_direct_io,
+    false,
+    "read local dataset files and loaded tensors with O_DIRECT through "
+    "io_uring instead of buffered stdio, default false");
+PHI_DEFINE_EXPORTED_int32(
+    localfs_bgzf_thread_num,
+    0,
+    "inflate local bgzip files with this many threads instead of one zcat, "
+    "for the readers with no pipe command but cat, default 0");
+PHI_DEFINE_EXPORTED_int64(
+    dataset_sample_cache_mem_mb,
+    0,
+    "memory budget in MB of the cache keeping the records parsed from the "
+    "files of a SlotRecordDataset across loads, default 0");
+PHI_DEFINE_EXPORTED_string(
+    dataset_sample_cache_spill_dir,
+    "",
+    "local directory the sample cache spills the records over its memory "
+    "budget to, the cache is off with no budget and no spill dir, "
+    "default empty");
 PHI_DEFINE_EXPORTED_bool(
     gpugraph_enable_hbm_table_collision_stat,
     false,
@@ -1264,6 +1692,37 @@ PHI_DEFINE_EXPORTED_bool(enable_auto_detect_gpu_topo,
 PHI_DEFINE_EXPORTED_bool(enable_auto_rdma_trans,
                          true,
                          "enable auto gpu rdma trans, default true");
+PHI_DEFINE_EXPORTED_bool(
+    gpugraph_topo_routing,
+    false,
+    "route the copies between the gpus of a node by the bandwidth of "
+    "their links, relayed by other gpus when it is faster, default false");
+PHI_DEFINE_EXPORTED_int32(gpugraph_topo_routing_max_hops,
+                          2,
+                          "max hops of a route with gpugraph_topo_routing, "
+                          "default 2");
+PHI_DEFINE_EXPORTED_bool(
+    gpugraph_measure_link_bandwidth,
+    false,
+    "measure the bandwidth of the links between the gpus of a node for "
+    "gpugraph_topo_routing instead of taking it from nvidia-smi topo, "
+    "default false");
+PHI_DEFINE_EXPORTED_bool(
+    gpugraph_inner_shuffle_by_nccl,
+    false,
+    "shuffle the keys and values between the gpus of a node by nccl "
+    "send/recv instead of peer copies in multi node mode, default false");
+PHI_DEFINE_EXPORTED_bool(
+    gpugraph_report_link_utilization,
+    false,
+    "count the bytes of pull and push on each link between the gpus of a "
+    "node and report them at the end of each pass, default false");
+PHI_DEFINE_EXPORTED_int64(
+    gpugraph_hbm_value_mem_mb,
+    0,
+    "the hbm in MB the feature values of a pass may take on each gpu, the "
+    "values of the keys of the least show beyond it are kept in pinned host "
+    "memory, 0 for no limit, default 0");
 PHI_DEFINE_EXPORTED_bool(enable_tracker_all2all,
                          false,
                          "enable tracker all2all log, default false");
@@ -1323,6 +1782,28 @@ PHI_DEFINE_EXPORTED_bool(eager_communication_connection,
                          false,
                          "enable eager to create nccl comm");
 
+PHI_DEFINE_EXPORTED_bool(
+    nccl_comm_split,
+    false,
+    "Create the NCCL communicator of a new group by ncclCommSplit from the "
+    "one of the global group, instead of a fresh ncclCommInitRank. Needs "
+    "NCCL 2.18 or later and all the ranks to create the groups in the same "
+    "order.");
+
+PHI_DEFINE_EXPORTED_bool(
+    nccl_comm_lazy_init,
+    false,
+    "Only register the NCCL communicators of the comm context manager, and "
+    "create each on its first use.");
+
+PHI_DEFINE_EXPORTED_bool(
+    nccl_hierarchical_collectives,
+    false,
+    "Run the allreduce and the allgather of a NCCL process group spanning "
+    "several nodes in two levels, within the nodes and across them between "
+    "the ranks of the same local rank. The nodes are detected from the "
+    "host names, and should hold the same number of consecutive ranks.");
+
 /**
  * Autotune related FLAG
  * Name: FLAGS_use_autotune
@@ -1332,6 +1813,21 @@ PHI_DEFINE_EXPORTED_bool(eager_communication_connection,
  */
 PHI_DEFINE_EXPORTED_bool(use_autotune, false, "Whether enable autotune.");
 
+/**
+ * Autotune related FLAG
+ * Name: FLAGS_autotune_cache_file
+ * Since Version: 3.1.0
+ * Value Range: string, default=""
+ * Example: FLAGS_autotune_cache_file=/path/to/autotune.cache
+ * Note: If set, the autotune results are loaded from the file when autotune
+ * starts, and saved to it when the autotune range ends, so that the jobs
+ * running on the same device model, driver and libraries skip tuning. The
+ * results tuned on another environment are ignored.
+ */
+PHI_DEFINE_EXPORTED_string(autotune_cache_file,
+                           "",
+                           "The file the autotune results are shared by.");
+
 /**
  * CINN training related FLAG
  * Name: FLAGS_disable_dyshape_in_train
@@ -1443,6 +1939,36 @@ PHI_DEFINE_EXPORTED_bool(enable_auto_layout_pass,
                          false,
                          "Whether enable auto_layout_pass.");
 
+/**
+ * Performance related FLAG
+ * Name: enable_layout_cost_model
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_enable_layout_cost_model=true
+ * Note: If True, the inference predictor runs layout_cost_model_pass instead
+ * of transfer_layout_pass, choosing the layouts of each conv, norm and pool
+ * region by the cheapest total kernel and transpose cost.
+ */
+PHI_DEFINE_EXPORTED_bool(enable_layout_cost_model,
+                         false,
+                         "Whether to choose layouts by cost model.");
+
+/**
+ * Performance related FLAG
+ * Name: layout_cost_model_file
+ * Since Version: 3.1.0
+ * Value Range: string, default=""
+ * Example: FLAGS_layout_cost_model_file=/path/to/layout_costs.txt
+ * Note: The per kernel coefficients calibrating layout_cost_model_pass, one
+ * `<op name> <dtype> <layout> <time per unit of work>` per line, measured by
+ * autotuning the kernels of both layouts. Empty to use the built-in
+ * defaults.
+ */
+PHI_DEFINE_EXPORTED_string(layout_cost_model_file,
+                           "",
+                           "The file of the kernel coefficients used by "
+                           "layout_cost_model_pass.");
+
 /**
  * JitLayer related FLAG
  * Name: FLAGS_jit_engine_type
@@ -1458,6 +1984,21 @@ PHI_DEFINE_EXPORTED_string(jit_engine_type,
                            "Predictor",
                            "Choose default function type in JitLayer.");
 
+/**
+ * JitLayer related FLAG
+ * Name: FLAGS_jit_share_params
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If true, the parameters loaded by jit::Load are deduplicated by the
+ * hash of their content in a store of the process, so the layers loading the
+ * same weights alias the same immutable tensors instead of a copy each.
+ */
+PHI_DEFINE_EXPORTED_bool(jit_share_params,
+                         false,
+                         "Share the parameters of equal content among the "
+                         "layers loaded by jit::Load.");
+
 /**
  * Custom Device NPU related FLAG
  * Name: FLAGS_npu_storage_format
@@ -1506,6 +2047,79 @@ PHI_DEFINE_EXPORTED_bool(trt_ibuilder_cache,
                          false,
                          "Add a persistent ibuilder.");
 
+/**
+ * TensorRT related FLAG
+ * Name: trt_shape_bucket_engines
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, a TensorRT subgraph with dynamic shape also builds engines
+ * specialized to buckets of its input shapes, in which every dynamic dim is
+ * rounded up to a power of two. A bucket is built in a background thread on
+ * its first input, and the inputs run on the engine of the whole dynamic
+ * shape range until the bucket is ready.
+ */
+PHI_DEFINE_EXPORTED_bool(trt_shape_bucket_engines,
+                         false,
+                         "Build TensorRT engines for buckets of input shapes.");
+
+/**
+ * TensorRT related FLAG
+ * Name: trt_shape_bucket_cache_dir
+ * Since Version: 3.0.0
+ * Value Range: string, default empty
+ * Example:
+ * Note: The directory to save and load the serialized engines of the shape
+ * buckets. If empty, the model_opt_cache_dir of the static engine is used
+ * when there is one, otherwise the bucket engines are not saved.
+ */
+PHI_DEFINE_EXPORTED_string(trt_shape_bucket_cache_dir,
+                           "",
+                           "The directory to cache the shape bucket engines.");
+
+/**
+ * TensorRT related FLAG
+ * Name: trt_cost_based_partition
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, the ops converted by the generic plugin are kept out of a
+ * TensorRT subgraph when they are at its edge and running them outside costs
+ * less, weighing trt_plugin_overhead_cost against trt_boundary_copy_cost, and
+ * a subgraph of plugin ops only is not converted at all. The plugin ops which
+ * join the other ops of a subgraph are kept, so that a model runs in fewer
+ * and larger engines.
+ */
+PHI_DEFINE_EXPORTED_bool(trt_cost_based_partition,
+                         false,
+                         "Partition the TensorRT subgraphs by a cost model.");
+
+/**
+ * TensorRT related FLAG
+ * Name: trt_plugin_overhead_cost
+ * Since Version: 3.0.0
+ * Value Range: double, default=1.0
+ * Example:
+ * Note: The cost of running an op by the generic plugin of TensorRT instead
+ * of outside the engine, relative to trt_boundary_copy_cost.
+ */
+PHI_DEFINE_EXPORTED_double(trt_plugin_overhead_cost,
+                           1.0,
+                           "The cost of an op run by the generic plugin.");
+
+/**
+ * TensorRT related FLAG
+ * Name: trt_boundary_copy_cost
+ * Since Version: 3.0.0
+ * Value Range: double, default=2.0
+ * Example:
+ * Note: The cost of a tensor crossing the boundary of a TensorRT engine, i.e.
+ * its copy and the synchronization with the ops outside the engine.
+ */
+PHI_DEFINE_EXPORTED_double(trt_boundary_copy_cost,
+                           2.0,
+                           "The cost of a tensor crossing an engine boundary.");
+
 /**
  * mmap_allocator related FLAG
  * Name: use_shm_cache
@@ -1532,6 +2146,35 @@ PHI_DEFINE_EXPORTED_bool(dataloader_use_file_descriptor,
                          false,
                          "Use file descriptor in mmap_allocator.");
 
+/**
+ * Parameter loading related FLAG
+ * Name: load_params_with_mmap
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, load_combine reads the parameters from the memory mapped
+ *       file instead of a file stream, without a host copy of the whole file,
+ *       and GPU parameters are copied through pinned chunks overlapped with
+ *       the reading. Not supported on Windows.
+ */
+PHI_DEFINE_EXPORTED_bool(load_params_with_mmap,
+                         false,
+                         "Read the combined parameters by mmap.");
+
+/**
+ * Parameter loading related FLAG
+ * Name: mmap_params_zero_copy
+ * Since Version: 3.0.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True with FLAGS_load_params_with_mmap, the CPU parameters whose
+ *       data is aligned in the file are not copied but point to the mapped
+ *       file, and their pages are read when they are first used.
+ */
+PHI_DEFINE_EXPORTED_bool(mmap_params_zero_copy,
+                         false,
+                         "Let CPU parameters point to the mmaped file.");
+
 /**
  * Tensor operants related FLAG
  * Name: tensor_operants_mode
@@ -1574,6 +2217,21 @@ PHI_DEFINE_EXPORTED_bool(enable_pir_with_pt_in_dy2st,
                          true,
                          "Enable PIR in executor");
 
+/**
+ * Translating legacy program to pir program FLAG
+ * Name: program_translator_num_threads
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: The number of threads translating the attributes of the ops of a
+ * large legacy program before the ops are translated, 0 for the number of
+ * cores, 1 for none.
+ */
+PHI_DEFINE_EXPORTED_int32(program_translator_num_threads,
+                          0,
+                          "The number of threads translating the attributes "
+                          "of a legacy program.");
+
 PHI_DEFINE_EXPORTED_string(logging_pir_py_code_dir,
                            "",
                            "the logging directory to save pir py code");
@@ -1615,6 +2273,193 @@ PHI_DEFINE_EXPORTED_bool(enable_pir_in_executor_trace_run,
                          false,
                          "Enable PIR in executor");
 
+/**
+ * Using static memory plan in PIR executor FLAG
+ * Name: pir_interpreter_static_memory_plan
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, when the PIR executor runs in trace mode, the dense tensors
+ * whose shapes are fully known are assigned fixed offsets in one arena before
+ * the first run, instead of being allocated and garbage collected op by op.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_interpreter_static_memory_plan,
+                         false,
+                         "Plan the memory of static shape tensors ahead of "
+                         "time in PIR executor trace mode");
+
+/**
+ * Using compiled trace in PIR executor FLAG
+ * Name: pir_interpreter_compiled_trace
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, when the PIR executor runs in trace mode, the instructions
+ * are flattened into an array of steps in execution order before the first
+ * run. Phi kernels are then called directly with their prebuilt contexts, and
+ * the vars to garbage collect after each step are filtered ahead of time.
+ * Debug and profiling features fall back to the normal trace run.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_interpreter_compiled_trace,
+                         false,
+                         "Run the flattened instruction steps in PIR executor "
+                         "trace mode");
+
+/**
+ * Auto CUDA Graph in PIR executor FLAG
+ * Name: pir_interpreter_auto_cuda_graph
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, when the PIR executor runs in trace mode on GPU, the maximal
+ * ranges of consecutive capture-safe instructions are captured into CUDA
+ * Graphs keyed by their input shapes, and replayed on later runs. An
+ * instruction is capture-safe if it is an async GPU phi kernel on the default
+ * stream, with static shapes and without events, host sync or sub blocks.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_interpreter_auto_cuda_graph,
+                         false,
+                         "Capture static shape instruction ranges into CUDA "
+                         "Graphs in PIR executor trace mode");
+
+/**
+ * Auto CUDA Graph in PIR executor FLAG
+ * Name: pir_interpreter_auto_cuda_graph_min_ops
+ * Since Version: 3.1.0
+ * Value Range: int32, default=8
+ * Example:
+ * Note: The minimal number of instructions of a range captured by
+ * FLAGS_pir_interpreter_auto_cuda_graph, shorter ranges are not worth the
+ * cost of staging their inputs.
+ */
+PHI_DEFINE_EXPORTED_int32(pir_interpreter_auto_cuda_graph_min_ops,
+                          8,
+                          "The minimal number of instructions captured into "
+                          "one CUDA Graph");
+
+/**
+ * Elementwise chain fusion of PIR executor FLAG
+ * Name: pir_interpreter_fuse_elementwise_chain
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: When running in trace mode on GPU, consecutive elementwise
+ * instructions on the same stream, e.g. add, multiply, relu and exp, whose
+ * inputs have the same shape at runtime are launched as one kernel, and the
+ * intermediate results that die within the chain are never written to
+ * memory. Chains are found on the kernel program, so that programs with
+ * dynamic shapes benefit as well.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_interpreter_fuse_elementwise_chain,
+                         false,
+                         "Launch chains of elementwise instructions as one "
+                         "kernel in PIR executor");
+
+/**
+ * Scheduling policy of PIR executor FLAG
+ * Name: pir_interpreter_scheduling_policy
+ * Since Version: 3.1.0
+ * Value Range: string, {fifo, critical_path}, default=fifo
+ * Example:
+ * Note: With fifo, the ready instructions are dispatched in the order they
+ * become ready, unless a scheduling_priority attribute says otherwise. With
+ * critical_path, every instruction is prioritized by its upward rank, the
+ * estimated cost of the longest path from it to the end of the program, and
+ * communication instructions are dispatched before all the others so that
+ * collectives start as early as possible.
+ */
+PHI_DEFINE_EXPORTED_string(pir_interpreter_scheduling_policy,
+                           "fifo",
+                           "The policy to schedule the ready instructions in "
+                           "PIR executor, fifo or critical_path");
+
+/**
+ * Build result cache of PIR executor FLAG
+ * Name: pir_interpreter_build_cache_dir
+ * Since Version: 3.1.0
+ * Value Range: string, default=""
+ * Example: FLAGS_pir_interpreter_build_cache_dir=/path/to/cache
+ * Note: When it is not empty, the dependency, stream event and GC analysis of
+ * every program run by PIR executor is saved to this directory, named by the
+ * signature of the instructions of the program. A process running the same
+ * program later loads the saved results instead of analysing it again.
+ */
+PHI_DEFINE_EXPORTED_string(pir_interpreter_build_cache_dir,
+                           "",
+                           "The directory to save and load the build results "
+                           "of PIR executor");
+
+/**
+ * Garbage collection of new executor FLAG
+ * Name: new_executor_async_gc_batch_mb
+ * Since Version: 3.1.0
+ * Value Range: double, default=0.0
+ * Example: FLAGS_new_executor_async_gc_batch_mb=64
+ * Note: When it is positive, the garbages of the new executor are queued per
+ * stream and freed in batches by a background thread, once the garbages of
+ * a stream exceed this size in MB or its instruction records an event for
+ * other streams. When an allocation fails, the pending garbages are freed
+ * synchronously before the allocation is retried. It does not apply when
+ * FLAGS_new_executor_use_cuda_graph is set.
+ */
+PHI_DEFINE_EXPORTED_double(new_executor_async_gc_batch_mb,
+                           0.0,
+                           "The batch size in MB of the garbages freed by the "
+                           "background thread in new executor, 0 to disable");
+
+/**
+ * InferMeta cache of PIR executor FLAG
+ * Name: pir_interpreter_infer_meta_cache_size
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_pir_interpreter_infer_meta_cache_size=8
+ * Note: When it is positive, every phi kernel instruction keeps the output
+ * metas computed by InferMeta for up to this many input shape signatures,
+ * and skips InferMeta when its inputs match one of them. The instructions
+ * with attributes read from tensors at runtime are not cached.
+ */
+PHI_DEFINE_EXPORTED_int32(pir_interpreter_infer_meta_cache_size,
+                          0,
+                          "The number of input shape signatures whose "
+                          "InferMeta results are cached per instruction");
+
+/**
+ * Op latency monitor of PIR executor FLAG
+ * Name: pir_interpreter_op_latency_sample_interval
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_pir_interpreter_op_latency_sample_interval=100
+ * Note: When it is positive, PIR executor records the host time of every
+ * instruction it runs into a histogram of its op, and times one out of this
+ * many runs of each GPU instruction with events to record its device time.
+ * paddle.base.core.get_pir_op_latency returns the slowest ops with their
+ * p50 and p99 latencies.
+ */
+PHI_DEFINE_EXPORTED_int32(pir_interpreter_op_latency_sample_interval,
+                          0,
+                          "One out of this many runs of each GPU instruction "
+                          "is timed for the op latency histograms, 0 to "
+                          "disable them");
+
+/**
+ * Micro batch pipeline of standalone executor FLAG
+ * Name: new_executor_micro_batch_streams
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_new_executor_micro_batch_streams=2
+ * Note: When it is positive and a PIR plan runs the same job on every micro
+ * batch, micro batch i runs on the stream micro_batch_<i % N> and a host
+ * thread of the executor's persistent worker pool, so that the feed copy,
+ * the compute and the fetch copy of different micro batches overlap. The
+ * micro batches sharing a stream run one after another, which bounds the
+ * memory held by the in-flight ones.
+ */
+PHI_DEFINE_EXPORTED_int32(new_executor_micro_batch_streams,
+                          0,
+                          "The number of streams the micro batches of a "
+                          "standalone executor are pipelined on, 0 to "
+                          "run them one by one");
+
 /**
  * Apply inplace pass to PIR FLAG
  * Name: pir_apply_inplace_pass
@@ -1628,6 +2473,21 @@ PHI_DEFINE_EXPORTED_bool(pir_apply_inplace_pass,
                          "Whether to apply inplace pass on lowering "
                          "::pir::Program to Kernel Dialect");
 
+/**
+ * Apply symbolic memory reuse pass to PIR FLAG
+ * Name: pir_apply_symbolic_memory_reuse_pass
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example: FLAGS_pir_apply_symbolic_memory_reuse_pass=true
+ * Note: If True, the inference predictor marks the dynamic shape values that
+ * the shape analysis proves to fit in the buffer of a dead value, and the
+ * executor builds them on the variable of that value.
+ */
+PHI_DEFINE_EXPORTED_bool(pir_apply_symbolic_memory_reuse_pass,
+                         false,
+                         "Whether to share the buffers of the dynamic shape "
+                         "values that fit in one another");
+
 PHI_DEFINE_EXPORTED_string(
     ir_inplace_kernel_blacklist,
     "",
@@ -1671,6 +2531,14 @@ PHI_DEFINE_EXPORTED_bool(print_ir, false, "Whether print ir debug str.");
 PHI_DEFINE_EXPORTED_bool(pir_debug,
                          false,
                          "Whether print more pir debug info.");
+// PIR related FLAG
+// Example: FLAGS_pir_incremental_pattern_rewrite=true makes the
+// PatternRewritePass scan the program once and then only revisit the ops
+// changed by the rewrites.
+PHI_DEFINE_EXPORTED_bool(pir_incremental_pattern_rewrite,
+                         false,
+                         "Whether the pattern rewrite passes only revisit "
+                         "the changed ops after the first scan.");
 PHI_DEFINE_EXPORTED_bool(
     prim_skip_dynamic,
     true,
@@ -1692,6 +2560,17 @@ PHI_DEFINE_EXPORTED_string(
     "",
     "It controls the forward blacklist ops not to be decomposed.");
 
+// Example: FLAGS_prim_selective_decomp_ops="pd_op.layer_norm:1.3;pd_op.gelu"
+// decomposes `layer_norm` and `gelu` only where fusing them with their
+// neighbors saves more memory traffic than their decomposed kernels lose.
+// The optional ratio is the measured time of the op decomposed and fused
+// over the time of its phi kernel, 1 by default.
+PHI_DEFINE_EXPORTED_string(
+    prim_selective_decomp_ops,
+    "",
+    "The ops decomposed only when the cost model favours it, with the "
+    "measured cost ratio of their decomposed kernels.");
+
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL) || \
     defined(PADDLE_WITH_XPU_BKCL)
 /**
@@ -1724,11 +2603,53 @@ PHI_DEFINE_EXPORTED_bool(enable_async_trace,
 
 PHI_DEFINE_EXPORTED_int32(async_trace_count, 5, "collective async trace count");
 
+/**
+ * Communication related FLAG
+ * Name: comm_flight_recorder_size
+ * Since Version: 3.0.0
+ * Value Range: int32, default=0
+ * Example:
+ * Note: the number of the last collectives of every group kept with their
+ * sizes and timings by the comm flight recorder, 0 to disable it.
+ */
+PHI_DEFINE_EXPORTED_int32(comm_flight_recorder_size,
+                          0,
+                          "size of the comm flight recorder of every group");
+
+/**
+ * Communication related FLAG
+ * Name: comm_flight_recorder_dump_path
+ * Since Version: 3.0.0
+ * Value Range: string, default=""
+ * Example:
+ * Note: the file, suffixed by the global rank, the comm flight recorder is
+ * dumped to when the collectives hang. Logged if empty.
+ */
+PHI_DEFINE_EXPORTED_string(comm_flight_recorder_dump_path,
+                           "",
+                           "path to dump the comm flight recorder on hang");
+
 PHI_DEFINE_EXPORTED_bool(
     use_auto_growth_pinned_allocator,
     false,
     "Whether to use the auto_growth CUDA pinned allocator.");
 
+/**
+ * Allocator related FLAG
+ * Name: use_stream_safe_cuda_pinned_allocator
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, a freed CUDA pinned buffer is only reused after the
+ * asynchronous copies recorded on it have completed, so it can be freed
+ * without synchronizing the copy stream.
+ */
+PHI_DEFINE_EXPORTED_bool(
+    use_stream_safe_cuda_pinned_allocator,
+    false,
+    "Whether to delay the reuse of CUDA pinned memory until the "
+    "asynchronous copies using it have completed.");
+
 PHI_DEFINE_EXPORTED_bool(
     sync_after_alloc,
     false,
@@ -1893,6 +2814,25 @@ PHI_DEFINE_EXPORTED_bool(
     false,
     "Enable xqa optim in block_multihead_attention kernel (GQA).");
 
+/**
+ * The length of the splits of the timesteps in the decoding of
+ * block_multihead_attention
+ * Name: blha_split_kv_len
+ * Since Version: 3.1.0
+ * Value Range: int32, default=0
+ * Example: FLAGS_blha_split_kv_len=1024
+ * Note: If greater than 0, the timesteps of the sequences longer than it are
+ * split in chunks of this length, each computed by a thread block, and the
+ * chunks are combined by a reduction kernel. It suits long sequences in small
+ * batches, whose heads do not fill the device. It takes precedence over
+ * use_xqa_optim.
+ */
+PHI_DEFINE_EXPORTED_int32(
+    blha_split_kv_len,
+    0,
+    "The length of the splits of the timesteps in the decoding of "
+    "block_multihead_attention, 0 to not split them.");
+
 PHI_DEFINE_EXPORTED_string(
     mkl_dir,  // NOLINT
     "",
@@ -1986,6 +2926,74 @@ PHI_DEFINE_EXPORTED_bool(enable_auto_parallel_align_mode,
                          false,
                          "Enable align mode for auto parallel");
 
+/**
+ * Auto parallel related FLAG
+ * Name: infer_spmd_cache_capacity
+ * Since Version: 3.1.0
+ * Value Range: int32, default=4096
+ * Note: The number of the results of the SPMD rules which the eager auto
+ * parallel APIs cache by the dims and dist attrs of the inputs and by the
+ * attributes, and of the reshard functions cached by the pairs of dist
+ * attrs. A cache is cleared when it is full. The caches are disabled when
+ * it is not positive.
+ */
+PHI_DEFINE_EXPORTED_int32(infer_spmd_cache_capacity,
+                          4096,
+                          "The capacity of the caches of the SPMD rules.");
+
+/**
+ * Reshard related FLAG
+ * Name: reshard_cost_based_planning
+ * Since Version: 3.0.0
+ * Value Range: bool, default=true
+ * Note: Reshard a tensor on a nd mesh along the sequence of 1-D reshards
+ * estimated the cheapest by a cost model of the mesh, instead of
+ * replicating all the changed dims first.
+ */
+PHI_DEFINE_EXPORTED_bool(reshard_cost_based_planning,
+                         true,
+                         "Plan the reshard on a nd mesh by a cost model.");
+
+/**
+ * Reshard related FLAG
+ * Name: reshard_devices_per_node
+ * Since Version: 3.0.0
+ * Value Range: int32, default=8
+ * Note: The number of consecutive ranks of a node, which the reshard cost
+ * model uses to tell the mesh dims crossing the nodes. No mesh dim is taken
+ * to cross the nodes when it is not positive.
+ */
+PHI_DEFINE_EXPORTED_int32(reshard_devices_per_node,
+                          8,
+                          "The number of consecutive ranks of a node.");
+
+/**
+ * Distributed related FLAG
+ * Name: tcp_store_num_shards
+ * Since Version: 3.0.0
+ * Value Range: int32, default=1
+ * Note: The number of servers the keys of the global TCPStore are hashed
+ * over, on the consecutive ports from the master port. Should be the same on
+ * all the ranks.
+ */
+PHI_DEFINE_EXPORTED_int32(tcp_store_num_shards,
+                          1,
+                          "The number of shards of the global TCPStore.");
+
+/**
+ * Distributed related FLAG
+ * Name: gloo_allreduce_bcube_max_bytes
+ * Since Version: 3.1.0
+ * Value Range: int64, default=0
+ * Note: The allreduce of Gloo of at most this many bytes runs the bcube
+ * algorithm, whose log(n) steps suit the small messages bound by latency,
+ * instead of the ring, whose 2(n-1) steps suit the large messages bound by
+ * bandwidth. All the allreduces run the ring when it is 0.
+ */
+PHI_DEFINE_EXPORTED_int64(gloo_allreduce_bcube_max_bytes,
+                          0,
+                          "The max bytes of the bcube allreduce of Gloo.");
+
 /**
  * fused_multi_transformer_op related FLAG
  * Name: fused_multi_transformer_op_use_mbfmha
@@ -0,0 +1,162 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/common/startup_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace common {
+
+static uint64_t NowNs() {
+  // The clock of the host events of the profiler, see phi::PosixInNsec.
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// Numbers the threads from 0, shorter than their ids in the trace.
+static uint64_t ThreadIndex() {
+  static std::atomic<uint64_t> next_index{0};
+  thread_local uint64_t index = next_index++;
+  return index;
+}
+
+static std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+StartupTrace& StartupTrace::Instance() {
+  static StartupTrace trace;
+  return trace;
+}
+
+size_t StartupTrace::Begin() {
+  std::lock_guard<std::mutex> guard(mtx_);
+  sessions_.fetch_add(1);
+  return dropped_ + events_.size();
+}
+
+std::vector<StartupTraceEvent> StartupTrace::End(size_t begin) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  std::vector<StartupTraceEvent> events(
+      events_.begin() + static_cast<std::ptrdiff_t>(begin - dropped_),
+      events_.end());
+  if (sessions_.fetch_sub(1) == 1) {
+    dropped_ += events_.size();
+    events_.clear();
+  }
+  return events;
+}
+
+void StartupTrace::Record(StartupTraceEvent event) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  if (sessions_.load() > 0) {
+    events_.emplace_back(std::move(event));
+  }
+}
+
+std::string StartupTrace::ToChromeTrace(
+    const std::vector<StartupTraceEvent>& events) {
+  std::ostringstream os;
+  os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto& event = events[i];
+    os << (i ? ",\n" : "\n") << "{\"name\": \"" << EscapeJson(event.name)
+       << "\", \"pid\": 0, \"tid\": " << event.thread_id
+       << ", \"ts\": " << event.start_ns / 1000 << ", \"dur\": " << std::fixed
+       << std::setprecision(3)
+       << static_cast<double>(event.end_ns - event.start_ns) / 1000.0
+       << ", \"ph\": \"X\", \"cat\": \"" << EscapeJson(event.category)
+       << "\"}";
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
+std::string StartupTrace::Summary(const std::vector<StartupTraceEvent>& events,
+                                  size_t top_k) {
+  // The phases of a category do not nest, but for those of the predictor.
+  std::map<std::string, std::pair<uint64_t, size_t>> categories;
+  for (const auto& event : events) {
+    auto& total = categories[event.category];
+    total.first += event.end_ns - event.start_ns;
+    ++total.second;
+  }
+  std::vector<const StartupTraceEvent*> longest;
+  for (const auto& event : events) {
+    longest.push_back(&event);
+  }
+  std::sort(longest.begin(),
+            longest.end(),
+            [](const StartupTraceEvent* a, const StartupTraceEvent* b) {
+              return a->end_ns - a->start_ns > b->end_ns - b->start_ns;
+            });
+  longest.resize(std::min(longest.size(), top_k));
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "---------------------- Startup Summary ----------------------\n";
+  os << std::setw(14) << "Time(ms)" << std::setw(8) << "Count"
+     << "  Category\n";
+  for (const auto& item : categories) {
+    os << std::setw(14) << static_cast<double>(item.second.first) / 1e6
+       << std::setw(8) << item.second.second << "  " << item.first << "\n";
+  }
+  os << "\n" << std::setw(14) << "Time(ms)" << "  Category / Phase\n";
+  for (const auto* event : longest) {
+    os << std::setw(14)
+       << static_cast<double>(event->end_ns - event->start_ns) / 1e6 << "  "
+       << event->category << " / " << event->name << "\n";
+  }
+  return os.str();
+}
+
+StartupTraceScope::StartupTraceScope(const char* category,
+                                     const std::string& name)
+    : recording_(StartupTrace::IsRecording()), category_(category) {
+  if (recording_) {
+    name_ = name;
+    start_ns_ = NowNs();
+  }
+}
+
+StartupTraceScope::~StartupTraceScope() {
+  if (!recording_) {
+    return;
+  }
+  StartupTraceEvent event;
+  event.category = category_;
+  event.name = std::move(name_);
+  event.start_ns = start_ns_;
+  event.end_ns = NowNs();
+  event.thread_id = ThreadIndex();
+  StartupTrace::Instance().Record(std::move(event));
+}
+
+}  // namespace common
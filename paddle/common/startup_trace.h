@@ -0,0 +1,99 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "paddle/utils/test_macros.h"
+
+namespace common {
+
+// One phase of the startup, e.g. a pass, the compilation of a CINN group or
+// the build of a TensorRT engine. The times are from the same clock as the
+// host events of the profiler.
+struct StartupTraceEvent {
+  std::string category;
+  std::string name;
+  uint64_t start_ns{0};
+  uint64_t end_ns{0};
+  // The index of the thread, from 0.
+  uint64_t thread_id{0};
+};
+
+/**
+ * StartupTrace records the phases of the startup of a predictor, from the
+ * parameter loading and the analysis passes to the build of the executor,
+ * while a session is open. The sessions of the predictors starting at the
+ * same time overlap, and each of them gets all the phases recorded while it
+ * is open.
+ *
+ * The phases are recorded by StartupTraceScope, which costs an atomic load
+ * when no session is open, so it can be left in the passes and compilers.
+ */
+class TEST_API StartupTrace {
+ public:
+  static StartupTrace& Instance();
+
+  static bool IsRecording() {
+    return Instance().sessions_.load(std::memory_order_relaxed) > 0;
+  }
+
+  // Opens a session and returns its begin, to be passed to End.
+  size_t Begin();
+  // Closes the session of begin and returns the phases recorded since. The
+  // phases are dropped once the last session is closed.
+  std::vector<StartupTraceEvent> End(size_t begin);
+
+  void Record(StartupTraceEvent event);
+
+  // The phases as a trace of the chrome tracing format, as exported by the
+  // profiler.
+  static std::string ToChromeTrace(
+      const std::vector<StartupTraceEvent>& events);
+  // The total time of each category, and the phases taking the longest.
+  static std::string Summary(const std::vector<StartupTraceEvent>& events,
+                             size_t top_k = 20);
+
+ private:
+  StartupTrace() = default;
+
+  std::atomic<int> sessions_{0};
+  // The phases of the sessions closed before are dropped from the front.
+  size_t dropped_{0};
+  std::vector<StartupTraceEvent> events_;
+  std::mutex mtx_;
+};
+
+// Records its lifetime as a phase of the startup while a session is open.
+class TEST_API StartupTraceScope {
+ public:
+  StartupTraceScope(const char* category, const std::string& name);
+  ~StartupTraceScope();
+
+  StartupTraceScope(const StartupTraceScope&) = delete;
+  StartupTraceScope& operator=(const StartupTraceScope&) = delete;
+
+ private:
+  bool recording_;
+  const char* category_;
+  std::string name_;
+  uint64_t start_ns_{0};
+};
+
+}  // namespace common
@@ -0,0 +1,384 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/collective/gradient_compression.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "paddle/phi/api/include/api.h"
+#include "paddle/phi/common/data_type.h"
+
+namespace paddle {
+namespace distributed {
+
+using paddle::experimental::IntArray;
+
+namespace {
+
+phi::DenseTensor *Dense(const Tensor &tensor) {
+  return std::dynamic_pointer_cast<phi::DenseTensor>(tensor.impl()).get();
+}
+
+// The collectives take fp8 as its bytes.
+phi::DenseTensor CommView(const Tensor &tensor) {
+  phi::DenseTensor view;
+  view.ShareDataWith(*Dense(tensor));
+  if (tensor.dtype() == phi::DataType::FLOAT8_E4M3FN) {
+    view.set_type(phi::DataType::UINT8);
+  }
+  return view;
+}
+
+int64_t Bytes(const Tensor &tensor) {
+  return tensor.numel() * phi::SizeOf(tensor.dtype());
+}
+
+Tensor Pad(const Tensor &x, int64_t numel) {
+  if (x.numel() == numel) return x;
+  return paddle::experimental::pad(
+      x, {0, static_cast<int>(numel - x.numel())}, 0.0f);
+}
+
+Tensor Slice(const Tensor &x, int64_t numel) {
+  if (x.numel() == numel) return x;
+  return paddle::experimental::slice(
+      x, {0}, IntArray({0}), IntArray({numel}), {1}, {});
+}
+
+Tensor Norm(const Tensor &x) {
+  return paddle::experimental::p_norm(x, 2.0f, -1, 1e-12f, false, true);
+}
+
+}  // namespace
+
+GradientCompressionType GradientCompressionTypeFromString(
+    const std::string &type) {
+  static const std::map<std::string, GradientCompressionType> types = {
+      {"none", GradientCompressionType::kNone},
+      {"int8", GradientCompressionType::kInt8},
+      {"fp8", GradientCompressionType::kFp8},
+      {"powersgd", GradientCompressionType::kPowerSGD},
+      {"topk", GradientCompressionType::kTopK},
+  };
+  auto it = types.find(type);
+  PADDLE_ENFORCE_EQ(it != types.end(),
+                    true,
+                    common::errors::InvalidArgument(
+                        "The gradient compression should be one of none, "
+                        "int8, fp8, powersgd and topk, but received %s.",
+                        type));
+  return it->second;
+}
+
+GradientCompressor::GradientCompressor(
+    std::shared_ptr<ProcessGroup> process_group,
+    const GradientCompressionOptions &options)
+    : process_group_(process_group),
+      options_(options),
+      nranks_(process_group->GetSize()) {}
+
+std::vector<GradientCompressionStats> GradientCompressor::Stats() const {
+  std::vector<GradientCompressionStats> stats;
+  for (const auto &item : states_) {
+    const auto &state = item.second;
+    GradientCompressionStats group_stats;
+    group_stats.group_index = item.first;
+    group_stats.original_bytes = state.original_bytes;
+    group_stats.compressed_bytes = state.compressed_bytes;
+    group_stats.compression_ratio =
+        state.compressed_bytes > 0
+            ? static_cast<double>(state.original_bytes) /
+                  state.compressed_bytes
+            : 1.0;
+    group_stats.relative_error = 0.0f;
+    if (state.relative_error.initialized()) {
+      auto error = state.relative_error.copy_to(phi::CPUPlace(), true);
+      group_stats.relative_error = error.data<float>()[0];
+    }
+    stats.push_back(group_stats);
+  }
+  return stats;
+}
+
+Tensor GradientCompressor::Prepare(GroupState *state, const Tensor &contents) {
+  // A ring allreduce sends each byte twice, less the part of the rank.
+  state->original_bytes = 2 * (nranks_ - 1) * Bytes(contents) / nranks_;
+  state->compressed_bytes = 0;
+  sent_bytes_ = 0;
+  Tensor input = contents;
+  if (contents.dtype() != phi::DataType::FLOAT32) {
+    input = paddle::experimental::cast(contents, phi::DataType::FLOAT32);
+  }
+  if (options_.error_feedback && state->residual.initialized()) {
+    input = paddle::experimental::add(input, state->residual);
+  }
+  return input;
+}
+
+void GradientCompressor::Finish(GroupState *state,
+                                const Tensor &input,
+                                const Tensor &approximation,
+                                const Tensor &output,
+                                Tensor *contents) {
+  Tensor error = paddle::experimental::subtract(input, approximation);
+  state->relative_error = paddle::experimental::divide(
+      Norm(error),
+      paddle::experimental::scale(Norm(input), 1.0f, 1e-12f, true));
+  if (options_.error_feedback) {
+    state->residual = error;
+  }
+  *contents = output.dtype() == contents->dtype()
+                  ? output
+                  : paddle::experimental::cast(output, contents->dtype());
+}
+
+Tensor GradientCompressor::AllGather(const Tensor &in) {
+  Tensor out = paddle::experimental::empty(
+      IntArray({nranks_ * in.numel()}), in.dtype(), in.place());
+  phi::DenseTensor out_view = CommView(out);
+  task_ = process_group_->AllGather(&out_view, CommView(in), true);
+  sent_bytes_ += (nranks_ - 1) * Bytes(in);
+  return out;
+}
+
+Tensor GradientCompressor::AllToAll(const Tensor &in) {
+  Tensor out = paddle::experimental::empty(
+      IntArray(common::vectorize(in.dims())), in.dtype(), in.place());
+  phi::DenseTensor out_view = CommView(out);
+  std::vector<int64_t> size_each_rank(nranks_, in.dims()[0] / nranks_);
+  task_ = process_group_->AllToAll(
+      &out_view, CommView(in), size_each_rank, size_each_rank, true);
+  sent_bytes_ += (nranks_ - 1) * Bytes(in) / nranks_;
+  return out;
+}
+
+void GradientCompressor::AllReduceSum(Tensor *tensor) {
+  AllreduceOptions opts;
+  opts.reduce_op = ReduceOp::SUM;
+  auto *dense = Dense(*tensor);
+  task_ = process_group_->AllReduce(dense, *dense, opts, true);
+  sent_bytes_ += 2 * (nranks_ - 1) * Bytes(*tensor) / nranks_;
+}
+
+namespace {
+
+// Each rank quantizes the chunk it sends to every other one with a scale of
+// its own. The receiver sums the chunks, quantizes the sum again, and the
+// sums are gathered, so that each value is sent twice at a byte.
+class QuantizedCompressor : public GradientCompressor {
+ public:
+  QuantizedCompressor(std::shared_ptr<ProcessGroup> process_group,
+                      const GradientCompressionOptions &options,
+                      phi::DataType dtype,
+                      float qmax)
+      : GradientCompressor(process_group, options),
+        dtype_(dtype),
+        qmax_(qmax) {}
+
+  std::shared_ptr<ProcessGroup::Task> AllReduce(size_t group_index,
+                                                Tensor *contents) override {
+    auto &state = states_[group_index];
+    Tensor input = Prepare(&state, *contents);
+    const int64_t numel = input.numel();
+    const int64_t chunk = (numel + nranks_ - 1) / nranks_;
+
+    Tensor chunks = paddle::experimental::reshape(
+        Pad(input, nranks_ * chunk), IntArray({nranks_, chunk}));
+    Tensor scale;
+    Tensor quantized = Quantize(chunks, &scale);
+    Tensor approximation =
+        Slice(paddle::experimental::reshape(Dequantize(quantized, scale),
+                                            IntArray({nranks_ * chunk})),
+              numel);
+
+    Tensor received = AllToAll(quantized);
+    Tensor received_scale = AllToAll(scale);
+    Tensor reduced =
+        paddle::experimental::sum(Dequantize(received, received_scale),
+                                  IntArray({0}),
+                                  phi::DataType::FLOAT32,
+                                  true);
+    Tensor reduced_scale;
+    Tensor reduced_quantized = Quantize(reduced, &reduced_scale);
+
+    Tensor gathered = paddle::experimental::reshape(
+        AllGather(reduced_quantized), IntArray({nranks_, chunk}));
+    Tensor gathered_scale = paddle::experimental::reshape(
+        AllGather(reduced_scale), IntArray({nranks_, 1}));
+    Tensor output =
+        Slice(paddle::experimental::reshape(
+                  Dequantize(gathered, gathered_scale),
+                  IntArray({nranks_ * chunk})),
+              numel);
+
+    state.compressed_bytes = sent_bytes_;
+    Finish(&state, input, approximation, output, contents);
+    return task_;
+  }
+
+ private:
+  // Quantize the rows of x, each with the scale mapping its absolute
+  // maximum to qmax_.
+  Tensor Quantize(const Tensor &x, Tensor *scale) {
+    Tensor abs_max = paddle::experimental::max(
+        paddle::experimental::abs(x), IntArray({-1}), true);
+    *scale = paddle::experimental::scale(
+        paddle::experimental::clip(abs_max, FLT_MIN, FLT_MAX),
+        1.0f / qmax_,
+        0.0f,
+        true);
+    Tensor y = paddle::experimental::clip(
+        paddle::experimental::divide(x, *scale), -qmax_, qmax_);
+    if (dtype_ == phi::DataType::INT8) {
+      y = paddle::experimental::round(y, 0);
+    }
+    return paddle::experimental::cast(y, dtype_);
+  }
+
+  Tensor Dequantize(const Tensor &q, const Tensor &scale) {
+    return paddle::experimental::multiply(
+        paddle::experimental::cast(q, phi::DataType::FLOAT32), scale);
+  }
+
+  phi::DataType dtype_;
+  float qmax_;
+};
+
+// The bucket is viewed as a matrix M, approximated by P Q^T with P and Q of
+// powersgd_rank columns. P = M Q is reduced and orthogonalized, then
+// Q = M^T P is reduced, Q being kept to start the next step from.
+class PowerSGDCompressor : public GradientCompressor {
+ public:
+  using GradientCompressor::GradientCompressor;
+
+  std::shared_ptr<ProcessGroup::Task> AllReduce(size_t group_index,
+                                                Tensor *contents) override {
+    auto &state = states_[group_index];
+    Tensor input = Prepare(&state, *contents);
+    const int64_t numel = input.numel();
+    const int64_t rows =
+        static_cast<int64_t>(std::ceil(std::sqrt(static_cast<double>(numel))));
+    const int64_t cols = (numel + rows - 1) / rows;
+    const int64_t rank = std::min<int64_t>(options_.powersgd_rank,
+                                           std::min(rows, cols));
+
+    Tensor matrix = paddle::experimental::reshape(Pad(input, rows * cols),
+                                                  IntArray({rows, cols}));
+    if (!state.q.initialized()) {
+      // The seed is fixed so that Q starts the same on every rank.
+      state.q = paddle::experimental::gaussian(IntArray({cols, rank}),
+                                               0.0f,
+                                               1.0f,
+                                               kSeed,
+                                               phi::DataType::FLOAT32,
+                                               input.place());
+    }
+    Tensor p = paddle::experimental::matmul(matrix, state.q, false, false);
+    AllReduceSum(&p);
+    p = std::get<0>(paddle::experimental::qr(p, "reduced"));
+    Tensor q = paddle::experimental::matmul(matrix, p, true, false);
+    Tensor approximation = Slice(
+        paddle::experimental::reshape(
+            paddle::experimental::matmul(p, q, false, true),
+            IntArray({rows * cols})),
+        numel);
+    AllReduceSum(&q);
+    state.q = q;
+    Tensor output = Slice(
+        paddle::experimental::reshape(
+            paddle::experimental::matmul(p, q, false, true),
+            IntArray({rows * cols})),
+        numel);
+
+    state.compressed_bytes = sent_bytes_;
+    Finish(&state, input, approximation, output, contents);
+    return task_;
+  }
+
+ private:
+  static constexpr int kSeed = 2026;
+};
+
+// Each rank keeps the topk_ratio of its values of largest magnitude, which
+// are gathered with their indices and added up.
+class TopKCompressor : public GradientCompressor {
+ public:
+  using GradientCompressor::GradientCompressor;
+
+  std::shared_ptr<ProcessGroup::Task> AllReduce(size_t group_index,
+                                                Tensor *contents) override {
+    auto &state = states_[group_index];
+    Tensor input = Prepare(&state, *contents);
+    const int64_t numel = input.numel();
+    const int64_t k = std::min<int64_t>(
+        numel,
+        std::max<int64_t>(1, std::llround(numel * options_.topk_ratio)));
+
+    Tensor indices = std::get<1>(paddle::experimental::topk(
+        paddle::experimental::abs(input), k, -1, true, false));
+    Tensor values = paddle::experimental::gather(input, indices, 0);
+    Tensor zeros = paddle::experimental::full(
+        IntArray({numel}), 0.0, phi::DataType::FLOAT32, input.place());
+    Tensor approximation =
+        paddle::experimental::index_add(zeros, indices, values, 0);
+
+    Tensor gathered_values = AllGather(values);
+    Tensor gathered_indices =
+        AllGather(paddle::experimental::cast(indices, phi::DataType::INT32));
+    Tensor output = paddle::experimental::index_add(
+        zeros, gathered_indices, gathered_values, 0);
+
+    state.compressed_bytes = sent_bytes_;
+    Finish(&state, input, approximation, output, contents);
+    return task_;
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<GradientCompressor> CreateGradientCompressor(
+    std::shared_ptr<ProcessGroup> process_group,
+    const GradientCompressionOptions &options) {
+  switch (options.type) {
+    case GradientCompressionType::kInt8:
+      return std::make_unique<QuantizedCompressor>(
+          process_group, options, phi::DataType::INT8, 127.0f);
+    case GradientCompressionType::kFp8:
+      return std::make_unique<QuantizedCompressor>(
+          process_group, options, phi::DataType::FLOAT8_E4M3FN, 448.0f);
+    case GradientCompressionType::kPowerSGD:
+      PADDLE_ENFORCE_GT(options.powersgd_rank,
+                        0,
+                        common::errors::InvalidArgument(
+                            "The rank of PowerSGD should be positive, but "
+                            "received %d.",
+                            options.powersgd_rank));
+      return std::make_unique<PowerSGDCompressor>(process_group, options);
+    case GradientCompressionType::kTopK:
+      PADDLE_ENFORCE_EQ(
+          options.topk_ratio > 0 && options.topk_ratio <= 1,
+          true,
+          common::errors::InvalidArgument(
+              "The ratio of top-k should be in (0, 1], but received %f.",
+              options.topk_ratio));
+      return std::make_unique<TopKCompressor>(process_group, options);
+    default:
+      return nullptr;
+  }
+}
+
+}  //  namespace distributed
+}  //  namespace paddle
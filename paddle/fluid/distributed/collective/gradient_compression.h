@@ -0,0 +1,127 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/distributed/collective/process_group.h"
+#include "paddle/phi/api/include/tensor.h"
+
+namespace paddle {
+namespace distributed {
+
+enum class GradientCompressionType {
+  kNone = 0,
+  // Quantized to int8 or fp8 with a scale for each rank's chunk, reduced
+  // by an all-to-all and gathered back quantized again.
+  kInt8,
+  kFp8,
+  // The rank-r approximation of PowerSGD, with the bucket viewed as a
+  // matrix as square as possible.
+  kPowerSGD,
+  // The largest values of the bucket, gathered with their indices.
+  kTopK,
+};
+
+GradientCompressionType GradientCompressionTypeFromString(
+    const std::string &type);
+
+struct GradientCompressionOptions {
+  GradientCompressionType type{GradientCompressionType::kNone};
+  // Add the part of the gradients lost by the compression to the ones of
+  // the next step.
+  bool error_feedback{true};
+  int powersgd_rank{4};
+  // The fraction of the values kept by kTopK.
+  double topk_ratio{0.01};
+};
+
+struct GradientCompressionStats {
+  size_t group_index;
+  // The bytes the bucket takes, and the ones each rank sends for it.
+  int64_t original_bytes;
+  int64_t compressed_bytes;
+  double compression_ratio;
+  // The norm of what the compression loses of the gradients of this rank,
+  // relative to the norm of the gradients, at the last step.
+  float relative_error;
+};
+
+// Reduces the dense buckets of the EagerReducer in a compressed form. The
+// collectives are synchronous with the calculation stream, since the
+// compression and decompression run on it between them.
+class GradientCompressor {
+ public:
+  GradientCompressor(std::shared_ptr<ProcessGroup> process_group,
+                     const GradientCompressionOptions &options);
+  virtual ~GradientCompressor() = default;
+
+  // Replace contents, the bucket of group_index already divided by the
+  // number of ranks, by its sum over the ranks. Return the task of the last
+  // collective.
+  virtual std::shared_ptr<ProcessGroup::Task> AllReduce(size_t group_index,
+                                                        Tensor *contents) = 0;
+
+  // Drop the state of the groups, which are rebuilt.
+  void Reset() { states_.clear(); }
+
+  // Synchronizes with the device to read the errors.
+  std::vector<GradientCompressionStats> Stats() const;
+
+ protected:
+  struct GroupState {
+    // The error fed back to the next step.
+    Tensor residual;
+    // The PowerSGD right factor, warm started from the last step.
+    Tensor q;
+    Tensor relative_error;
+    int64_t original_bytes{0};
+    int64_t compressed_bytes{0};
+  };
+
+  // The bucket in float32 with the residual added, starting the count of
+  // the bytes sent.
+  Tensor Prepare(GroupState *state, const Tensor &contents);
+  // Keep the error of the approximation of input, and return output in the
+  // dtype of contents.
+  void Finish(GroupState *state,
+              const Tensor &input,
+              const Tensor &approximation,
+              const Tensor &output,
+              Tensor *contents);
+
+  Tensor AllGather(const Tensor &in);
+  Tensor AllToAll(const Tensor &in);
+  void AllReduceSum(Tensor *tensor);
+
+  std::shared_ptr<ProcessGroup> process_group_;
+  GradientCompressionOptions options_;
+  int nranks_;
+  std::map<size_t, GroupState> states_;
+  // The task of the last collective, and the bytes sent for the group being
+  // reduced, as a ring algorithm sends them.
+  std::shared_ptr<ProcessGroup::Task> task_;
+  int64_t sent_bytes_{0};
+};
+
+std::unique_ptr<GradientCompressor> CreateGradientCompressor(
+    std::shared_ptr<ProcessGroup> process_group,
+    const GradientCompressionOptions &options);
+
+}  //  namespace distributed
+}  //  namespace paddle
@@ -0,0 +1,390 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/collective/param_sharder.h"
+
+#include <algorithm>
+
+#include "paddle/fluid/eager/api/utils/hook_utils.h"
+#include "paddle/fluid/eager/utils.h"
+#include "paddle/phi/api/include/api.h"
+
+namespace paddle {
+namespace distributed {
+
+using paddle::experimental::IntArray;
+
+namespace {
+
+phi::DenseTensor *Dense(const Tensor &tensor) {
+  return std::dynamic_pointer_cast<phi::DenseTensor>(tensor.impl()).get();
+}
+
+Tensor Pad(const Tensor &x, int64_t numel) {
+  if (x.numel() == numel) return x;
+  return paddle::experimental::pad(
+      x, {0, static_cast<int>(numel - x.numel())}, 0.0f);
+}
+
+Tensor Slice(const Tensor &x, int64_t begin, int64_t end) {
+  return paddle::experimental::slice(
+      x, {0}, IntArray({begin}), IntArray({end}), {1}, {});
+}
+
+bool NeedsGrad(const Tensor &tensor) {
+  auto *meta = egr::EagerUtils::nullable_autograd_meta(tensor);
+  return meta != nullptr && !meta->StopGradient();
+}
+
+}  // namespace
+
+EagerParamSharder::EagerParamSharder(
+    const std::vector<Tensor> &params,
+    const std::vector<std::vector<size_t>> &layer_param_indices,
+    std::shared_ptr<ProcessGroup> process_group,
+    size_t prefetch_layers,
+    size_t bucket_size_limit)
+    : params_(params),
+      layer_param_indices_(layer_param_indices),
+      process_group_(process_group),
+      nranks_(process_group->GetSize()),
+      rank_(process_group->GetRank()),
+      prefetch_layers_(prefetch_layers) {
+  PADDLE_ENFORCE_GT(params_.size(),
+                    0,
+                    common::errors::InvalidArgument(
+                        "The parameters to shard should not be empty."));
+  place_ = params_.front().place();
+
+  const size_t num_params = params_.size();
+  states_.resize(num_params);
+  shards_.resize(num_params);
+  shard_grads_.resize(num_params);
+  param_layers_.resize(num_params);
+  layers_.resize(layer_param_indices_.size());
+  for (size_t layer = 0; layer < layer_param_indices_.size(); ++layer) {
+    for (auto index : layer_param_indices_[layer]) {
+      PADDLE_ENFORCE_LT(
+          index,
+          num_params,
+          common::errors::InvalidArgument(
+              "The parameter index %d of layer %d is out of range [0, %d).",
+              index,
+              layer,
+              num_params));
+      param_layers_[index].push_back(layer);
+      if (NeedsGrad(params_[index])) {
+        ++layers_[layer].num_trainable_params;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < num_params; ++i) {
+    auto &param = params_[i];
+    PADDLE_ENFORCE_EQ(param.initialized() && param.is_dense_tensor(),
+                      true,
+                      common::errors::InvalidArgument(
+                          "The parameter %s to shard should be an "
+                          "initialized DenseTensor.",
+                          param.name()));
+    auto &state = states_[i];
+    state.numel = param.numel();
+    state.shard_numel = (state.numel + nranks_ - 1) / nranks_;
+    Tensor flat = paddle::experimental::reshape(param, {state.numel});
+    Tensor padded = Pad(flat, nranks_ * state.shard_numel);
+    // Copied so that the full parameter is not kept alive by the view.
+    shards_[i] = paddle::experimental::assign(
+        Slice(padded,
+              rank_ * state.shard_numel,
+              (rank_ + 1) * state.shard_numel));
+    Dense(param)->clear();
+  }
+
+  InitializeBuckets(bucket_size_limit);
+
+  for (size_t i = 0; i < num_params; ++i) {
+    if (!NeedsGrad(params_[i])) continue;
+    egr::egr_utils_api::RegisterReduceHookForTensor(
+        params_[i], [this, i]() { this->OnGradReady(i); });
+  }
+}
+
+void EagerParamSharder::InitializeBuckets(size_t bucket_size_limit) {
+  // The gradients are ready roughly in the reverse order of the parameters,
+  // so are the buckets filled.
+  size_t bucket_bytes = 0;
+  for (size_t i = params_.size(); i-- > 0;) {
+    if (!NeedsGrad(params_[i])) continue;
+    auto &state = states_[i];
+    const auto dtype = params_[i].dtype();
+    const size_t bytes = nranks_ * state.shard_numel * phi::SizeOf(dtype);
+    if (buckets_.empty() || buckets_.back().dtype != dtype ||
+        bucket_bytes + bytes > bucket_size_limit) {
+      buckets_.emplace_back();
+      buckets_.back().dtype = dtype;
+      bucket_bytes = 0;
+    }
+    auto &bucket = buckets_.back();
+    state.bucket_index = buckets_.size() - 1;
+    state.index_in_bucket = bucket.param_indices.size();
+    bucket.param_indices.push_back(i);
+    bucket.shard_numel += state.shard_numel;
+    bucket_bytes += bytes;
+  }
+  for (auto &bucket : buckets_) {
+    bucket.grads.resize(bucket.param_indices.size());
+    bucket.pending = bucket.param_indices.size();
+  }
+  VLOG(3) << "EagerParamSharder: " << params_.size() << " parameters in "
+          << buckets_.size() << " gradient buckets.";
+}
+
+void EagerParamSharder::StartStep() {
+  in_step_ = true;
+  in_backward_ = false;
+}
+
+void EagerParamSharder::PreForward(size_t layer_index) {
+  PADDLE_ENFORCE_LT(
+      layer_index,
+      layers_.size(),
+      common::errors::InvalidArgument(
+          "The layer index %d is out of range [0, %d).",
+          layer_index,
+          layers_.size()));
+  if (!in_step_) StartStep();
+  if (recording_ && order_index_.count(layer_index) == 0) {
+    order_index_[layer_index] = order_.size();
+    order_.push_back(layer_index);
+  }
+
+  Acquire(layer_index);
+  Wait(layer_index);
+  if (recording_) return;
+  auto it = order_index_.find(layer_index);
+  if (it == order_index_.end()) return;
+  for (size_t k = 1; k <= prefetch_layers_; ++k) {
+    if (it->second + k >= order_.size()) break;
+    Acquire(order_[it->second + k]);
+  }
+}
+
+void EagerParamSharder::PostForward(size_t layer_index,
+                                    const std::vector<Tensor> &outputs) {
+  Release(layer_index);
+  for (auto &output : outputs) {
+    if (!output.defined() || !NeedsGrad(output)) continue;
+    egr::egr_utils_api::RegisterGradientHookForTensor(
+        output, [this, layer_index](const Tensor &grad) {
+          this->PreBackward(layer_index);
+          return grad;
+        });
+  }
+}
+
+void EagerParamSharder::PreBackward(size_t layer_index) {
+  auto &layer = layers_[layer_index];
+  if (layer.backward_started) return;
+  if (!in_backward_) {
+    // The final hooks are cleared after each backward.
+    in_backward_ = true;
+    recording_ = false;
+    egr::egr_utils_api::RegisterBackwardFinalHook(
+        [this]() { this->FinalizeBackward(); });
+  }
+  layer.backward_started = true;
+  layer.pending_grads = layer.num_trainable_params;
+
+  Acquire(layer_index);
+  Wait(layer_index);
+  auto it = order_index_.find(layer_index);
+  if (it == order_index_.end()) return;
+  for (size_t k = 1; k <= prefetch_layers_ && k <= it->second; ++k) {
+    Acquire(order_[it->second - k]);
+  }
+}
+
+void EagerParamSharder::OnGradReady(size_t param_index) {
+  auto &state = states_[param_index];
+  auto &bucket = buckets_[state.bucket_index];
+  auto *grad = egr::EagerUtils::unsafe_autograd_meta(params_[param_index])
+                   ->MutableGrad();
+  if (bucket.launched || bucket.grads[state.index_in_bucket].defined()) {
+    return;
+  }
+  // The full gradient is only kept until its bucket is reduce-scattered.
+  bucket.grads[state.index_in_bucket] = *grad;
+  grad->reset();
+  if (--bucket.pending == 0) LaunchReadyBuckets();
+
+  for (auto layer_index : param_layers_[param_index]) {
+    auto &layer = layers_[layer_index];
+    if (layer.backward_started && layer.pending_grads > 0 &&
+        --layer.pending_grads == 0) {
+      Release(layer_index);
+    }
+  }
+}
+
+void EagerParamSharder::LaunchReadyBuckets() {
+  // The buckets are launched in the same order on all the ranks.
+  while (next_bucket_ < buckets_.size() &&
+         buckets_[next_bucket_].pending == 0) {
+    ReduceScatterBucket(&buckets_[next_bucket_++]);
+  }
+}
+
+void EagerParamSharder::ReduceScatterBucket(Bucket *bucket) {
+  // Row r of the input holds the slices of rank r of all the gradients, so
+  // that rank r receives the sum of row r.
+  std::vector<Tensor> rows;
+  rows.reserve(bucket->param_indices.size());
+  for (size_t j = 0; j < bucket->param_indices.size(); ++j) {
+    const auto &state = states_[bucket->param_indices[j]];
+    Tensor grad = bucket->grads[j];
+    if (grad.defined() && grad.initialized()) {
+      grad = paddle::experimental::reshape(grad, {state.numel});
+    } else {
+      grad = paddle::experimental::full(
+          IntArray({state.numel}), 0.0, bucket->dtype, place_);
+    }
+    rows.push_back(paddle::experimental::reshape(
+        Pad(grad, nranks_ * state.shard_numel),
+        {nranks_, state.shard_numel}));
+  }
+  Tensor input = rows.size() == 1
+                     ? rows.front()
+                     : paddle::experimental::concat(rows, phi::Scalar(1));
+  bucket->output = paddle::experimental::empty(
+      {bucket->shard_numel}, bucket->dtype, place_);
+  ReduceScatterOptions opts;
+  opts.reduce_op = ReduceOp::SUM;
+  bucket->task = process_group_->ReduceScatter(
+      Dense(bucket->output), *Dense(input), opts, /*sync_op*/ false);
+  bucket->launched = true;
+  std::fill(bucket->grads.begin(), bucket->grads.end(), Tensor());
+}
+
+void EagerParamSharder::FinalizeBackward() {
+  if (!in_backward_) return;
+  while (next_bucket_ < buckets_.size()) {
+    ReduceScatterBucket(&buckets_[next_bucket_++]);
+  }
+  for (auto &bucket : buckets_) {
+    bucket.task->Wait();
+    int64_t offset = 0;
+    for (auto index : bucket.param_indices) {
+      const auto &state = states_[index];
+      Tensor grad = paddle::experimental::scale(
+          Slice(bucket.output, offset, offset + state.shard_numel),
+          1.0f / nranks_,
+          0.0f,
+          true);
+      auto &shard_grad = shard_grads_[index];
+      shard_grad = shard_grad.defined()
+                       ? paddle::experimental::add(shard_grad, grad)
+                       : grad;
+      offset += state.shard_numel;
+    }
+    bucket.output.reset();
+    bucket.task.reset();
+    bucket.launched = false;
+    bucket.pending = bucket.param_indices.size();
+  }
+  next_bucket_ = 0;
+
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    Release(i);
+    layers_[i].backward_started = false;
+    layers_[i].pending_grads = 0;
+  }
+  in_step_ = false;
+  in_backward_ = false;
+}
+
+void EagerParamSharder::ClearShardGrads() {
+  for (auto &grad : shard_grads_) {
+    grad.reset();
+  }
+}
+
+void EagerParamSharder::GatherAll() {
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    Acquire(i);
+  }
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    Wait(i);
+  }
+}
+
+void EagerParamSharder::ReleaseAll() {
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    Release(i);
+  }
+}
+
+void EagerParamSharder::Acquire(size_t layer_index) {
+  auto &layer = layers_[layer_index];
+  if (layer.gathered) return;
+  layer.gathered = true;
+  for (auto index : layer_param_indices_[layer_index]) {
+    if (states_[index].refs++ == 0) StartGather(index);
+  }
+}
+
+void EagerParamSharder::Wait(size_t layer_index) {
+  for (auto index : layer_param_indices_[layer_index]) {
+    auto &state = states_[index];
+    if (state.task) {
+      state.task->Wait();
+      state.task.reset();
+    }
+  }
+}
+
+void EagerParamSharder::Release(size_t layer_index) {
+  auto &layer = layers_[layer_index];
+  if (!layer.gathered) return;
+  layer.gathered = false;
+  for (auto index : layer_param_indices_[layer_index]) {
+    if (--states_[index].refs == 0) Free(index);
+  }
+}
+
+void EagerParamSharder::StartGather(size_t param_index) {
+  auto &state = states_[param_index];
+  state.full = paddle::experimental::empty(
+      {nranks_ * state.shard_numel}, shards_[param_index].dtype(), place_);
+  // Issued on the communication stream, the calculation stream only waits
+  // for it in Wait.
+  state.task = process_group_->AllGather(Dense(state.full),
+                                         *Dense(shards_[param_index]),
+                                         /*sync_op*/ false);
+  // The parameter keeps its dims, and the nodes of the backward that hold it
+  // see the gathered buffer too.
+  Dense(params_[param_index])->ShareBufferWith(*Dense(state.full));
+}
+
+void EagerParamSharder::Free(size_t param_index) {
+  auto &state = states_[param_index];
+  if (state.task) {
+    state.task->Wait();
+    state.task.reset();
+  }
+  Dense(params_[param_index])->clear();
+  state.full.reset();
+}
+
+}  //  namespace distributed
+}  //  namespace paddle
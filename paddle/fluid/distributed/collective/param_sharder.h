@@ -0,0 +1,145 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "paddle/fluid/distributed/collective/process_group.h"
+#include "paddle/phi/api/include/tensor.h"
+#include "paddle/phi/common/data_type.h"
+#include "paddle/phi/common/place.h"
+
+namespace paddle {
+namespace distributed {
+
+// Shards the parameters of a model over the ranks of a process group, in the
+// way of ZeRO stage 3. Each rank keeps 1 / nranks of every parameter, padded
+// to a multiple of nranks elements. The full parameters of a layer are
+// gathered before its forward and its backward and freed after them.
+//
+// The order the layers run in is recorded in the first step. From the second
+// one on, the gathers of the next layers in that order, or of the previous
+// ones in the backward, are issued ahead on the communication stream, and
+// only waited for by the calculation stream when the layer runs. The
+// gradients are reduce-scattered in buckets as they are ready, in the same
+// order on all the ranks, and their shards averaged over the ranks are
+// accumulated into ShardGrads.
+class EagerParamSharder {
+ public:
+  EagerParamSharder(const std::vector<Tensor> &params,
+                    const std::vector<std::vector<size_t>> &layer_param_indices,
+                    std::shared_ptr<ProcessGroup> process_group,
+                    size_t prefetch_layers,
+                    size_t bucket_size_limit);
+
+  virtual ~EagerParamSharder() {}
+
+  // The 1-D shards of the parameters kept by this rank, which the optimizer
+  // updates in place.
+  const std::vector<Tensor> &Shards() const { return shards_; }
+  // The averaged gradients of the shards, accumulated over the backwards
+  // since ClearShardGrads. Undefined for the parameters that stop gradient.
+  const std::vector<Tensor> &ShardGrads() const { return shard_grads_; }
+  void ClearShardGrads();
+
+  void PreForward(size_t layer_index);
+  // Free the full parameters of the layer, and gather them back when the
+  // gradients of outputs are computed.
+  void PostForward(size_t layer_index, const std::vector<Tensor> &outputs);
+  // Run at the end of the backward, and a no-op out of it. Reduce-scatter
+  // the buckets left, with the gradients not computed taken as zeros, and
+  // free the full parameters left.
+  void FinalizeBackward();
+
+  // Gather the full parameters of all the layers, e.g. to save them, until
+  // ReleaseAll.
+  void GatherAll();
+  void ReleaseAll();
+
+ private:
+  struct ParamState {
+    int64_t numel{0};
+    int64_t shard_numel{0};
+    // The gathered parameter, of nranks * shard_numel elements, and the
+    // gather in flight.
+    Tensor full;
+    std::shared_ptr<ProcessGroup::Task> task;
+    // The number of gathered layers using the parameter.
+    size_t refs{0};
+    size_t bucket_index{0};
+    size_t index_in_bucket{0};
+  };
+
+  struct LayerState {
+    bool gathered{false};
+    bool backward_started{false};
+    size_t num_trainable_params{0};
+    size_t pending_grads{0};
+  };
+
+  struct Bucket {
+    std::vector<size_t> param_indices;
+    phi::DataType dtype;
+    int64_t shard_numel{0};
+    std::vector<Tensor> grads;
+    size_t pending{0};
+    bool launched{false};
+    Tensor output;
+    std::shared_ptr<ProcessGroup::Task> task;
+  };
+
+  void StartStep();
+  void PreBackward(size_t layer_index);
+  void OnGradReady(size_t param_index);
+
+  void Acquire(size_t layer_index);
+  void Wait(size_t layer_index);
+  void Release(size_t layer_index);
+  void StartGather(size_t param_index);
+  void Free(size_t param_index);
+
+  void InitializeBuckets(size_t bucket_size_limit);
+  void LaunchReadyBuckets();
+  void ReduceScatterBucket(Bucket *bucket);
+
+  std::vector<Tensor> params_;
+  std::vector<std::vector<size_t>> layer_param_indices_;
+  std::shared_ptr<ProcessGroup> process_group_;
+  int64_t nranks_;
+  int64_t rank_;
+  size_t prefetch_layers_;
+  phi::Place place_;
+
+  std::vector<Tensor> shards_;
+  std::vector<Tensor> shard_grads_;
+  std::vector<ParamState> states_;
+  std::vector<std::vector<size_t>> param_layers_;
+  std::vector<LayerState> layers_;
+
+  // The layers in the order of their first forward in the first step.
+  bool recording_{true};
+  std::vector<size_t> order_;
+  std::map<size_t, size_t> order_index_;
+
+  std::vector<Bucket> buckets_;
+  size_t next_bucket_{0};
+  bool in_step_{false};
+  bool in_backward_{false};
+};
+
+}  //  namespace distributed
+}  //  namespace paddle
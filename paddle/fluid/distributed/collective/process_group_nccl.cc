@@ -13,14 +13,22 @@
 // limitations under the License.
 
 #include "paddle/fluid/distributed/collective/process_group_nccl.h"
+
+#include <limits.h>
+#include <unistd.h>
+
+#include <cstring>
+
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/collective/common.h"
 #include "paddle/phi/api/lib/utils/allocator.h"
+#include "paddle/phi/api/profiler/event_tracing.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/phi/common/memory_utils.h"
 #include "paddle/phi/core/distributed/check/nccl_dynamic_check.h"
 #include "paddle/phi/core/distributed/check/static_check.h"
 #include "paddle/phi/core/distributed/comm_context_manager.h"
+#include "paddle/phi/core/distributed/comm_flight_recorder.h"
 #include "paddle/phi/core/distributed/comm_task_manager.h"
 #include "paddle/phi/core/distributed/nccl_comm_task.h"
 #include "paddle/phi/core/distributed/nccl_tools.h"
@@ -37,6 +45,7 @@ COMMON_DECLARE_bool(use_stream_safe_cuda_allocator);
 COMMON_DECLARE_bool(use_cuda_malloc_async_allocator);
 COMMON_DECLARE_bool(enable_async_trace);
 COMMON_DECLARE_bool(eager_communication_connection);
+COMMON_DECLARE_bool(nccl_hierarchical_collectives);
 
 // set this flag to `true` and recompile to enable dynamic checks
 constexpr bool FLAGS_enable_nccl_dynamic_check = false;
@@ -45,6 +54,7 @@ constexpr int64_t kWaitBlockTImeout = 10;
 namespace paddle::distributed {
 
 using phi::distributed::CheckSizeOnEachRank;
+using phi::distributed::CommTypeToString;
 using phi::distributed::IsP2POP;
 using phi::distributed::NCCLDTypeToString;
 using phi::distributed::NCCLRedTypeToString;
@@ -53,6 +63,40 @@ using phi::distributed::ToNCCLRedType;
 
 uint64_t ProcessGroupNCCL::s_group_call_counter = 0;
 
+namespace {
+
+// Copies height rows of width bytes between device buffers whose rows start
+// dpitch and spitch bytes apart.
+void Memcpy2DAsync(void* dst,
+                   size_t dpitch,
+                   const void* src,
+                   size_t spitch,
+                   size_t width,
+                   size_t height,
+                   gpuStream_t stream) {
+#ifdef PADDLE_WITH_HIP
+  PADDLE_ENFORCE_GPU_SUCCESS(hipMemcpy2DAsync(dst,
+                                              dpitch,
+                                              src,
+                                              spitch,
+                                              width,
+                                              height,
+                                              hipMemcpyDeviceToDevice,
+                                              stream));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpy2DAsync(dst,
+                                               dpitch,
+                                               src,
+                                               spitch,
+                                               width,
+                                               height,
+                                               cudaMemcpyDeviceToDevice,
+                                               stream));
+#endif
+}
+
+}  // namespace
+
 ProcessGroupNCCL::NCCLTask::NCCLTask(const Place& place,
                                      int rank,
                                      CommType comm_type,
@@ -230,6 +274,7 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllGather(
   // numel > 0 indicates the tensor need to be sliced
   const phi::DenseTensor& in_tensor_maybe_partial =
       numel > 0 ? GetPartialTensor(in_tensor, offset, numel) : in_tensor;
+  const bool hierarchical = UseHierarchy(in_tensor.place());
   return Collective(
       [&](phi::distributed::NCCLCommContext* comm_context, gpuStream_t stream) {
         VLOG(3) << "[ncclAllGather] "
@@ -243,9 +288,14 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllGather(
                 << ", stream: " << stream << ", rank_in_group: " << rank_
                 << ", nranks: " << size_ << ", offset: " << offset
                 << ", sync_op: " << sync_op
-                << ", use_calc_stream: " << use_calc_stream << ", "
+                << ", use_calc_stream: " << use_calc_stream
+                << ", hierarchical: " << hierarchical << ", "
                 << GetGroupMessage();
-        comm_context->AllGather(out_tensor, in_tensor_maybe_partial, stream);
+        if (hierarchical) {
+          HierarchicalAllGather(out_tensor, in_tensor_maybe_partial, stream);
+        } else {
+          comm_context->AllGather(out_tensor, in_tensor_maybe_partial, stream);
+        }
       },
       in_tensor_maybe_partial,
       CommType::ALLGATHER,
@@ -262,6 +312,9 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllReduce(
   CheckTensorContiguous(in_tensor);
   CheckTensorContiguous(*out_tensor);
 
+  // The chunks reduced across the nodes are even.
+  const bool hierarchical = UseHierarchy(in_tensor.place()) &&
+                            in_tensor.numel() % local_size_ == 0;
   return Collective(
       [&](phi::distributed::NCCLCommContext* comm_context, gpuStream_t stream) {
         VLOG(3) << "[ncclAllReduce] "
@@ -274,11 +327,17 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllReduce(
                 << ", ncclcomm: " << comm_context->GetNcclComm()
                 << ", stream: " << stream << ", rank_in_group: " << rank_
                 << ", nranks: " << size_ << ", sync_op: " << sync_op
-                << ", use_calc_stream: " << use_calc_stream << ", "
+                << ", use_calc_stream: " << use_calc_stream
+                << ", hierarchical: " << hierarchical << ", "
                 << GetGroupMessage();
 
-        comm_context->AllReduce(
-            out_tensor, in_tensor, ToNCCLRedType(opts.reduce_op), stream);
+        if (hierarchical) {
+          HierarchicalAllReduce(
+              out_tensor, in_tensor, ToNCCLRedType(opts.reduce_op), stream);
+        } else {
+          comm_context->AllReduce(
+              out_tensor, in_tensor, ToNCCLRedType(opts.reduce_op), stream);
+        }
       },
       in_tensor,
       CommType::ALLREDUCE,
@@ -286,6 +345,130 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllReduce(
       use_calc_stream);
 }
 
+phi::DenseTensor ProcessGroupNCCL::FlattenCoalescedTensors(
+    const std::vector<phi::DenseTensor*>& out_tensors,
+    const std::vector<phi::DenseTensor>& in_tensors,
+    int64_t numel_factor) {
+  PADDLE_ENFORCE_EQ(is_coalescing_,
+                    false,
+                    common::errors::PreconditionNotMet(
+                        "A coalesced collective is a single collective, it "
+                        "cannot run between StartCoalescing and "
+                        "EndCoalescing."));
+  PADDLE_ENFORCE_EQ(
+      !in_tensors.empty() && out_tensors.size() == in_tensors.size(),
+      true,
+      common::errors::InvalidArgument(
+          "A coalesced collective needs as many outputs as inputs, and at "
+          "least one, but received %d outputs and %d inputs.",
+          out_tensors.size(),
+          in_tensors.size()));
+  const auto dtype = in_tensors[0].dtype();
+  const auto& place = in_tensors[0].place();
+  auto* calc_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(place));
+  int64_t numel = 0;
+  for (size_t i = 0; i < in_tensors.size(); ++i) {
+    CheckTensorContiguous(in_tensors[i]);
+    PADDLE_ENFORCE_EQ(
+        in_tensors[i].dtype() == dtype && in_tensors[i].place() == place,
+        true,
+        common::errors::InvalidArgument(
+            "The tensors of a coalesced collective should have the same "
+            "dtype and place, but the tensor %d is %s on %s, and the first "
+            "one %s on %s.",
+            i,
+            in_tensors[i].dtype(),
+            in_tensors[i].place(),
+            dtype,
+            place));
+    PADDLE_ENFORCE_EQ(
+        out_tensors[i]->numel(),
+        in_tensors[i].numel() * numel_factor,
+        common::errors::InvalidArgument(
+            "The output %d of the coalesced collective should have %d "
+            "elements, but it has %d.",
+            i,
+            in_tensors[i].numel() * numel_factor,
+            out_tensors[i]->numel()));
+    calc_ctx->Alloc(out_tensors[i], dtype);
+    CheckTensorContiguous(*out_tensors[i]);
+    numel += in_tensors[i].numel();
+  }
+
+  phi::DenseTensor flat;
+  flat.Resize({numel});
+  calc_ctx->Alloc(&flat, dtype);
+  auto* dst = static_cast<uint8_t*>(flat.data());
+  for (const auto& in_tensor : in_tensors) {
+    const size_t bytes = in_tensor.numel() * phi::SizeOf(dtype);
+    phi::memory_utils::Copy(
+        place, dst, place, in_tensor.data(), bytes, calc_ctx->stream());
+    dst += bytes;
+  }
+  return flat;
+}
+
+std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllReduceCoalesced(
+    const std::vector<phi::DenseTensor*>& out_tensors,
+    const std::vector<phi::DenseTensor>& in_tensors,
+    const AllreduceOptions& opts,
+    bool use_calc_stream) {
+  phi::DenseTensor flat = FlattenCoalescedTensors(out_tensors, in_tensors, 1);
+  auto task = AllReduce(&flat, flat, opts, /*sync_op*/ true, use_calc_stream);
+
+  auto* calc_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(flat.place()));
+  const auto* src = static_cast<const uint8_t*>(flat.data());
+  for (auto* out_tensor : out_tensors) {
+    const size_t bytes = out_tensor->numel() * phi::SizeOf(flat.dtype());
+    phi::memory_utils::Copy(out_tensor->place(),
+                            out_tensor->data(),
+                            flat.place(),
+                            src,
+                            bytes,
+                            calc_ctx->stream());
+    src += bytes;
+  }
+  return task;
+}
+
+std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllGatherCoalesced(
+    const std::vector<phi::DenseTensor*>& out_tensors,
+    const std::vector<phi::DenseTensor>& in_tensors,
+    bool use_calc_stream) {
+  phi::DenseTensor flat_in =
+      FlattenCoalescedTensors(out_tensors, in_tensors, size_);
+  auto* calc_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(flat_in.place()));
+  phi::DenseTensor flat_out;
+  flat_out.Resize({size_ * flat_in.numel()});
+  calc_ctx->Alloc(&flat_out, flat_in.dtype());
+  auto task = AllGather(&flat_out,
+                        flat_in,
+                        /*offset*/ 0,
+                        /*numel*/ -1,
+                        /*sync_op*/ true,
+                        use_calc_stream);
+
+  // The flattened inputs of a rank follow each other in flat_out, an
+  // output gathers the same part of all of them.
+  const size_t flat_bytes = flat_in.numel() * phi::SizeOf(flat_in.dtype());
+  const auto* src = static_cast<const uint8_t*>(flat_out.data());
+  for (size_t i = 0; i < in_tensors.size(); ++i) {
+    const size_t bytes = in_tensors[i].numel() * phi::SizeOf(flat_in.dtype());
+    Memcpy2DAsync(out_tensors[i]->data(),
+                  bytes,
+                  src,
+                  flat_bytes,
+                  bytes,
+                  size_,
+                  calc_ctx->stream());
+    src += bytes;
+  }
+  return task;
+}
+
 std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::AllToAll(
     phi::DenseTensor* out_tensor,
     const phi::DenseTensor& in_tensor,
@@ -850,6 +1033,17 @@ void ProcessGroupNCCL::EagerConnect() {
   }
 }
 
+void ProcessGroupNCCL::SplitComm(int gid, int rank_in_group) {
+  EagerConnect();
+  const auto& place = phi::GPUPlace(phi::backends::gpu::GetCurrentDeviceId());
+  platform::CUDADeviceGuard cuda_guard(place);
+  // The keys GetStoreKey gives to the collectives of the groups.
+  std::string parent_key = "nccl_ids/" + std::to_string(gid_) + "/0";
+  std::string store_key = "nccl_ids/" + std::to_string(gid) + "/0";
+  phi::distributed::CommContextManager::SplitNCCLCommContext(
+      parent_key, store_key, rank_in_group < 0 ? -1 : 0, rank_in_group);
+}
+
 void ProcessGroupNCCL::EagerConnectRingExchange() {
   std::vector<std::pair<int, int>> peers;
   const auto& place = phi::GPUPlace(phi::backends::gpu::GetCurrentDeviceId());
@@ -888,6 +1082,135 @@ void ProcessGroupNCCL::EagerConnectRingExchange() {
   }
 }
 
+bool ProcessGroupNCCL::UseHierarchy(const Place& place) {
+  // The collectives of a group are single NCCL calls.
+  if (!FLAGS_nccl_hierarchical_collectives || is_coalescing_ ||
+      s_group_call_counter > 0) {
+    return false;
+  }
+  if (!hierarchy_initialized_) {
+    InitHierarchy(place);
+  }
+  return local_size_ > 0;
+}
+
+void ProcessGroupNCCL::InitHierarchy(const Place& place) {
+  hierarchy_initialized_ = true;
+
+  std::string hostname(HOST_NAME_MAX + 1, '\0');
+  PADDLE_ENFORCE_EQ(
+      ::gethostname(hostname.data(), HOST_NAME_MAX),
+      0,
+      common::errors::Unavailable("Failed to get the host name of rank %d.",
+                                  rank_));
+  hostname.resize(std::strlen(hostname.c_str()));
+  const std::string prefix = "hierarchy/" + std::to_string(gid_) + "/";
+  store_->set(prefix + std::to_string(rank_),
+              std::vector<uint8_t>(hostname.begin(), hostname.end()));
+  std::vector<std::string> hosts(size_);
+  for (int i = 0; i < size_; ++i) {
+    auto host = store_->get(prefix + std::to_string(i));
+    hosts[i].assign(host.begin(), host.end());
+  }
+
+  // The ranks of a node should be consecutive, and the nodes hold as many
+  // of them.
+  int local_size = 1;
+  while (local_size < size_ && hosts[local_size] == hosts[0]) {
+    ++local_size;
+  }
+  bool regular = local_size > 1 && local_size < size_ &&
+                 size_ % local_size == 0;
+  for (int i = 1; regular && i < size_; ++i) {
+    regular = (hosts[i] == hosts[i - 1]) == (i % local_size != 0);
+  }
+  if (!regular) {
+    LOG(WARNING) << "The ranks of group " << gid_
+                 << " are not laid out as nodes of the same number of "
+                    "consecutive ranks, its collectives are not hierarchical.";
+    return;
+  }
+
+  const int node = rank_ / local_size;
+  const int local_rank = rank_ % local_size;
+  intra_comm_key_ = "nccl_ids/" + std::to_string(gid_) + "/intra/" +
+                    std::to_string(node);
+  inter_comm_key_ = "nccl_ids/" + std::to_string(gid_) + "/inter/" +
+                    std::to_string(local_rank);
+  platform::CUDADeviceGuard cuda_guard(place);
+  phi::distributed::CommContextManager::CreateNCCLCommContext(
+      store_,
+      intra_comm_key_,
+      local_rank,
+      local_size,
+      "",
+      nullptr,
+      nccl_comm_init_option_);
+  phi::distributed::CommContextManager::CreateNCCLCommContext(
+      store_,
+      inter_comm_key_,
+      node,
+      size_ / local_size,
+      "",
+      nullptr,
+      nccl_comm_init_option_);
+  local_size_ = local_size;
+  VLOG(3) << "Hierarchical collectives of group " << gid_ << " on "
+          << size_ / local_size << " nodes of " << local_size << " ranks";
+}
+
+void ProcessGroupNCCL::HierarchicalAllReduce(phi::DenseTensor* out_tensor,
+                                             const phi::DenseTensor& in_tensor,
+                                             ncclRedOp_t reduce_type,
+                                             gpuStream_t stream) {
+  auto* intra_comm = GetCommContext(&intra_comm_key_);
+  auto* inter_comm = GetCommContext(&inter_comm_key_);
+  // The chunk of the local rank is reduced in place in out_tensor, where
+  // the allgather within the node takes it from.
+  const int64_t chunk = in_tensor.numel() / local_size_;
+  phi::DenseTensor out_chunk =
+      GetPartialTensor(*out_tensor, (rank_ % local_size_) * chunk, chunk);
+  intra_comm->ReduceScatter(&out_chunk, in_tensor, reduce_type, stream);
+  inter_comm->AllReduce(&out_chunk, out_chunk, reduce_type, stream);
+  intra_comm->AllGather(out_tensor, out_chunk, stream);
+}
+
+void ProcessGroupNCCL::HierarchicalAllGather(phi::DenseTensor* out_tensor,
+                                             const phi::DenseTensor& in_tensor,
+                                             gpuStream_t stream) {
+  auto* intra_comm = GetCommContext(&intra_comm_key_);
+  auto* inter_comm = GetCommContext(&inter_comm_key_);
+  const int num_nodes = size_ / local_size_;
+  const int64_t numel = in_tensor.numel();
+  const size_t bytes = numel * phi::SizeOf(in_tensor.dtype());
+
+  // Each block crosses the nodes once. The gathered blocks are ordered by
+  // local rank first, and by node in out_tensor.
+  phi::DenseTensor gathered(
+      phi::memory_utils::AllocShared(
+          out_tensor->place(),
+          bytes * size_,
+          phi::Stream(reinterpret_cast<phi::StreamId>(stream))),
+      phi::DenseTensorMeta(in_tensor.dtype(),
+                           common::make_ddim({size_ * numel})));
+  phi::DenseTensor node_blocks = GetPartialTensor(
+      gathered, (rank_ % local_size_) * num_nodes * numel, num_nodes * numel);
+  inter_comm->AllGather(&node_blocks, in_tensor, stream);
+  intra_comm->AllGather(&gathered, node_blocks, stream);
+
+  auto* dst = static_cast<uint8_t*>(out_tensor->data());
+  const auto* src = static_cast<const uint8_t*>(gathered.data());
+  for (int local_rank = 0; local_rank < local_size_; ++local_rank) {
+    Memcpy2DAsync(dst + local_rank * bytes,
+                  local_size_ * bytes,
+                  src + local_rank * num_nodes * bytes,
+                  bytes,
+                  bytes,
+                  num_nodes,
+                  stream);
+  }
+}
+
 std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::Collective(
     std::function<void(phi::distributed::NCCLCommContext*, gpuStream_t)> fn,
     const phi::DenseTensor& tensor,
@@ -923,6 +1246,30 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::Collective(
 
   auto nccl_comm_ctx = this->GetCommContext(&store_key);
 
+  // The group and the sequence number name the same collective on every
+  // rank, the traces of the ranks are lined up by them.
+  std::unique_ptr<phi::RecordEvent> collective_event;
+  if (phi::RecordEvent::IsEnabled()) {
+    collective_event = std::make_unique<phi::RecordEvent>(
+        "ProcessGroupNCCL::" + CommTypeToString(comm_type) +
+            "#gid=" + std::to_string(gid_) +
+            "#seq=" + std::to_string(comm_seq_),
+        phi::TracerEventType::Communication,
+        1);
+  }
+
+  auto& flight_recorder = phi::distributed::CommFlightRecorder::GetInstance();
+  auto flight_record =
+      flight_recorder.RecordStart(place_to_group_key_.at(key),
+                                  place,
+                                  size_,
+                                  comm_seq_,
+                                  comm_type,
+                                  tensor.numel(),
+                                  tensor.dtype(),
+                                  nccl_stream,
+                                  /*grouped*/ s_group_call_counter > 0);
+
   if (!FLAGS_enable_async_trace) {
     fn(nccl_comm_ctx, nccl_stream);
   } else {
@@ -949,6 +1296,10 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::Collective(
     auto& comm_task_manager = phi::distributed::CommTaskManager::GetInstance();
     comm_task_manager.CommTaskEnqueue(std::move(comm_task));
   }
+  flight_recorder.RecordEnd(flight_record);
+  if (collective_event) {
+    collective_event->End();
+  }
 
   if (!use_calc_stream) {
     if (!is_coalescing_) {
@@ -1060,6 +1411,28 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::Point2Point(
 
   auto nccl_comm_ctx = this->GetCommContext(&store_key);
 
+  // The batched p2p are keyed by the place, which differs on the peers.
+  std::unique_ptr<phi::RecordEvent> p2p_event;
+  if (!is_batch_p2p && phi::RecordEvent::IsEnabled()) {
+    p2p_event = std::make_unique<phi::RecordEvent>(
+        "ProcessGroupNCCL::" + CommTypeToString(comm_type) +
+            "#gid=" + std::to_string(gid_) + "#pair=" + key +
+            "#seq=" + std::to_string(p2p_comm_seq_[key]),
+        phi::TracerEventType::Communication,
+        1);
+  }
+
+  auto& flight_recorder = phi::distributed::CommFlightRecorder::GetInstance();
+  auto flight_record = flight_recorder.RecordStart(group_key,
+                                                   place,
+                                                   p2p_nrank,
+                                                   p2p_comm_seq_[key],
+                                                   comm_type,
+                                                   tensor.numel(),
+                                                   tensor.dtype(),
+                                                   nccl_stream,
+                                                   is_batch_p2p);
+
   if (!FLAGS_enable_async_trace) {
     fn(nccl_comm_ctx, nccl_stream, p2p_target_rank);
   } else {
@@ -1071,6 +1444,10 @@ std::shared_ptr<ProcessGroup::Task> ProcessGroupNCCL::Point2Point(
     auto& comm_task_manager = phi::distributed::CommTaskManager::GetInstance();
     comm_task_manager.CommTaskEnqueue(std::move(comm_task));
   }
+  flight_recorder.RecordEnd(flight_record);
+  if (p2p_event) {
+    p2p_event->End();
+  }
 
   if (!use_calc_stream) {
     if (!is_coalescing_) {
@@ -109,6 +109,17 @@ class ProcessGroupNCCL final : public ProcessGroupWithStream {
       bool sync_op,
       bool use_calc_stream) override;
 
+  std::shared_ptr<ProcessGroup::Task> AllReduceCoalesced(
+      const std::vector<phi::DenseTensor*>& out_tensors,
+      const std::vector<phi::DenseTensor>& in_tensors,
+      const AllreduceOptions& opts,
+      bool use_calc_stream) override;
+
+  std::shared_ptr<ProcessGroup::Task> AllGatherCoalesced(
+      const std::vector<phi::DenseTensor*>& out_tensors,
+      const std::vector<phi::DenseTensor>& in_tensors,
+      bool use_calc_stream) override;
+
   std::shared_ptr<ProcessGroup::Task> AllToAll(
       phi::DenseTensor* out_tensor,
       const phi::DenseTensor& in_tensor,
@@ -241,8 +252,42 @@ class ProcessGroupNCCL final : public ProcessGroupWithStream {
 
   void EagerConnect();
 
+  // Creates the communicator of the group gid by splitting the one of this
+  // group, which the process group gid then picks up on its first use
+  // instead of initializing its own. Collective over all the ranks of this
+  // group, those out of the group gid passing a negative rank.
+  void SplitComm(int gid, int rank_in_group);
+
   void EagerConnectRingExchange();
 
+  // Whether the collectives run in two levels, see
+  // FLAGS_nccl_hierarchical_collectives. The topology is detected by the
+  // first call.
+  bool UseHierarchy(const Place& place);
+
+  void InitHierarchy(const Place& place);
+
+  // Reduce-scatter within the node, allreduce of the chunk across the nodes
+  // and allgather within the node.
+  void HierarchicalAllReduce(phi::DenseTensor* out_tensor,
+                             const phi::DenseTensor& in_tensor,
+                             ncclRedOp_t reduce_type,
+                             gpuStream_t stream);
+
+  // Allgather across the nodes and within the node, the blocks being
+  // reordered by rank then.
+  void HierarchicalAllGather(phi::DenseTensor* out_tensor,
+                             const phi::DenseTensor& in_tensor,
+                             gpuStream_t stream);
+
+  // Check the tensors of a coalesced collective, whose outputs have
+  // numel_factor times the elements of their inputs, and copy the inputs
+  // into one buffer on the calculation stream.
+  phi::DenseTensor FlattenCoalescedTensors(
+      const std::vector<phi::DenseTensor*>& out_tensors,
+      const std::vector<phi::DenseTensor>& in_tensors,
+      int64_t numel_factor);
+
  private:
   std::shared_ptr<phi::distributed::Store> store_;
 
@@ -271,6 +316,13 @@ class ProcessGroupNCCL final : public ProcessGroupWithStream {
   bool is_coalescing_{false};
   std::vector<std::shared_ptr<phi::DenseTensor>> colaescing_tensors_;
   std::vector<std::string> colaescing_place_keys_;
+
+  // For hierarchical collectives, local_size_ is 0 when the topology does
+  // not allow them.
+  bool hierarchy_initialized_{false};
+  int local_size_{0};
+  std::string intra_comm_key_;
+  std::string inter_comm_key_;
 };
 
 }  //  namespace distributed
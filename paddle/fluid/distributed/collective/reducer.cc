@@ -17,6 +17,7 @@
 #include "paddle/phi/api/lib/data_transform.h"
 #include "paddle/phi/backends/device_guard.h"
 #include "paddle/phi/backends/device_manager.h"
+#include "paddle/phi/core/tensor_utils.h"
 
 PD_DECLARE_bool(use_stream_safe_cuda_allocator);
 COMMON_DECLARE_string(allocator_strategy);
@@ -482,7 +483,10 @@ EagerReducer::EagerReducer(
     const std::vector<bool> &is_sparse_gradient,
     std::shared_ptr<distributed::ProcessGroup> process_group,
     const std::vector<size_t> &group_size_limits,
-    bool find_unused_parameters)
+    bool find_unused_parameters,
+    bool rebuild_groups,
+    size_t first_group_size_limit,
+    bool grad_as_bucket_view)
     : tensors_(tensors),
       group_indices_(group_indices),
       is_sparse_gradient_(is_sparse_gradient),
@@ -494,7 +498,10 @@ EagerReducer::EagerReducer(
       local_used_vars_(),
       unused_vars_(),
       gradnode_index_map_(),
-      find_unused_vars_each_step_(find_unused_parameters) {
+      find_unused_vars_each_step_(find_unused_parameters),
+      rebuild_groups_(rebuild_groups),
+      first_group_size_limit_(first_group_size_limit),
+      grad_as_bucket_view_(grad_as_bucket_view) {
   VLOG(3) << "Start construct the Reducer ...";
 
   nranks_ = process_group_->GetSize();
@@ -637,6 +644,23 @@ void EagerReducer::InitializeDenseGroups(
     }
   }
   p_group->all_length_ = all_length;
+
+  if (grad_as_bucket_view_) {
+    p_group->dense_contents_ = paddle::experimental::empty(
+        IntArray({all_length}), p_group->dtype_, inner_place_);
+    const auto &contents =
+        *std::dynamic_pointer_cast<phi::DenseTensor>(
+            p_group->dense_contents_.impl());
+    int64_t offset = 0;
+    for (size_t index = 0; index < tensor_indices_.size(); ++index) {
+      const int64_t length = p_group->length_[index];
+      p_group->grad_views_.push_back(
+          contents.Slice(offset, offset + length));
+      p_group->grad_views_.back().Resize(
+          tensors_[tensor_indices_[index]].dims());
+      offset += length;
+    }
+  }
 }
 
 void EagerReducer::TraverseBackwardGraph(const std::vector<Tensor> &outputs) {
@@ -830,6 +854,10 @@ void EagerReducer::MarkVarReady(const size_t var_index,
                       common::errors::PreconditionNotMet(error_info));
   } else {
     vars_marked_ready_[var_index] = true;
+    // rebuild group when find_unused_vars_each_step_ is false
+    if (NeedRebuildGroup()) {
+      rebuild_var_indices_.push_back(static_cast<int64_t>(var_index));
+    }
   }
   groups_need_finalize_ = true;
 
@@ -839,7 +867,9 @@ void EagerReducer::MarkVarReady(const size_t var_index,
 
   auto &group = groups_[group_index];
 
-  if (!group.is_sparse_) {
+  if (!group.is_sparse_ && grad_as_bucket_view_) {
+    MarkGradAsBucketView(var_index, is_used_var);
+  } else if (!group.is_sparse_) {
     auto &group_tensor = group.dense_tensors_[inside_group_index];
     const auto length = group.length_[inside_group_index];
     if (is_used_var) {
@@ -949,6 +979,41 @@ void EagerReducer::MarkVarReady(const size_t var_index,
   }
 }
 
+void EagerReducer::MarkGradAsBucketView(size_t var_index, bool is_used_var) {
+  const auto &var_locator = variable_locators_[var_index];
+  auto &group = groups_[var_locator.group_index];
+  const auto inside_group_index = var_locator.inside_group_index;
+  auto &view = group.grad_views_[inside_group_index];
+  auto *dev_ctx = phi::DeviceContextPool::Instance().Get(inner_place_);
+
+  if (HasGrad(var_index)) {
+    auto grad_tensor = egr::EagerUtils::mutable_grad(tensors_[var_index]);
+    auto dense_tensor =
+        std::dynamic_pointer_cast<phi::DenseTensor>(grad_tensor->impl());
+    PADDLE_ENFORCE_NOT_NULL(
+        dense_tensor,
+        common::errors::PreconditionNotMet(
+            "Tensor %s's GRAD must be Tensor to be a view of its bucket.",
+            tensors_[var_index].name()));
+    // After the first step the grad is accumulated in the view already,
+    // unless it was replaced, such as by clear_grad(set_to_zero=False)
+    if (dense_tensor->Holder() != view.Holder() ||
+        dense_tensor->meta().offset != view.meta().offset) {
+      VLOG(3) << "Copy the grad of Tensor[" << tensors_[var_index].name()
+              << "] to its bucket view";
+      phi::DenseTensor dst = view;
+      phi::Copy(*dev_ctx, *dense_tensor, inner_place_, false, &dst);
+      grad_tensor->set_impl(std::make_shared<phi::DenseTensor>(view));
+    }
+  } else {
+    VLOG(3) << "Tensor[" << tensors_[var_index].name()
+            << "] doesn't have grad, is used: " << is_used_var;
+    phi::funcs::set_constant(*dev_ctx, &view, 0.0f);
+  }
+  group.dense_tensors_[inside_group_index].ShareDataWith(view).Resize(
+      {group.length_[inside_group_index]});
+}
+
 void EagerReducer::MarkGroupReady(size_t group_index) {
   VLOG(3) << "Group[" << group_index << "] is ready";
 
@@ -1065,7 +1130,7 @@ void EagerReducer::FinalizeBackward() {
   for (auto &group : groups_) {
     if (!group.is_sparse_) {
       group.task->Synchronize();
-      if (!IsStreamSafeAllocator()) {
+      if (!IsStreamSafeAllocator() && !grad_as_bucket_view_) {
         auto *default_ctx =
             phi::DeviceContextPool::Instance().Get(inner_place_);
         group.SplitTensors(*default_ctx);
@@ -1073,6 +1138,15 @@ void EagerReducer::FinalizeBackward() {
     }
   }
 
+  if (NeedRebuildGroup()) {
+    VLOG(3) << "Start rebuilding the groups";
+    group_indices_ = RebuildGroups();
+    InitializeGroups(group_indices_);
+    if (gradient_compressor_) {
+      gradient_compressor_->Reset();
+    }
+  }
+
   if (find_unused_vars_each_step_) {
     ProcessUnusedDenseVars();
     local_used_vars_.clear();
@@ -1083,6 +1157,72 @@ void EagerReducer::FinalizeBackward() {
   VLOG(3) << "In the batch, Reducer is finished.";
 }
 
+std::vector<std::vector<size_t>> EagerReducer::RebuildGroups() {
+  VLOG(3) << "The order of parameter arrival: "
+          << string::join_strings(rebuild_var_indices_, ',');
+
+  PADDLE_ENFORCE_EQ(
+      rebuild_var_indices_.size(),
+      tensors_.size(),
+      common::errors::PreconditionNotMet(
+          "Rebuild vars's number should be equal to original vars'number, "
+          "expect it to be %d, but got %d.",
+          tensors_.size(),
+          rebuild_var_indices_.size()));
+
+  // The order may differ between the ranks, all of them take the one of
+  // rank 0 so that their groups are reduced in the same order.
+  const auto *dev_ctx = phi::DeviceContextPool::Instance().Get(inner_place_);
+  std::vector<int> order(rebuild_var_indices_.begin(),
+                         rebuild_var_indices_.end());
+  phi::DenseTensor order_tensor;
+  framework::TensorFromVector<int>(order, *dev_ctx, &order_tensor);
+  std::vector<phi::DenseTensor> in_out = {order_tensor};
+  process_group_->Broadcast(in_out, in_out)->Synchronize();
+  framework::TensorToVector<int>(in_out.front(), *dev_ctx, &order);
+  dev_ctx->Wait();
+  rebuild_var_indices_.assign(order.begin(), order.end());
+
+  // Without first_group_size_limit_, the groups are assigned from the last
+  // ready gradient, so that the first limit of group_size_limits_ is the one
+  // of the last group. Otherwise they are assigned from the first ready
+  // gradient, and the first group is limited to first_group_size_limit_ so
+  // that its allreduce starts while the next ones are still accumulating.
+  const bool from_last = first_group_size_limit_ == 0;
+  if (from_last) {
+    std::reverse(rebuild_var_indices_.begin(), rebuild_var_indices_.end());
+  }
+  std::vector<Tensor> rebuild_tensors;
+  rebuild_tensors.reserve(tensors_.size());
+  for (const auto var_index : rebuild_var_indices_) {
+    rebuild_tensors.push_back(tensors_[var_index]);
+  }
+  auto rebuild_group_indices = Eager_AssignGroupBySize(
+      rebuild_tensors,
+      is_sparse_gradient_,
+      from_last ? group_size_limits_
+                : std::vector<size_t>{first_group_size_limit_,
+                                      group_size_limits_.back()},
+      rebuild_var_indices_);
+  if (from_last) {
+    std::reverse(rebuild_group_indices.begin(), rebuild_group_indices.end());
+  }
+  has_rebuilt_group_ = true;
+  rebuild_var_indices_.clear();
+  return rebuild_group_indices;
+}
+
+void EagerReducer::SetGradientCompression(
+    const GradientCompressionOptions &options) {
+  gradient_compressor_ = CreateGradientCompressor(process_group_, options);
+}
+
+std::vector<GradientCompressionStats>
+EagerReducer::GetGradientCompressionStats() const {
+  if (!gradient_compressor_) return {};
+  return gradient_compressor_->Stats();
+}
+
 void EagerReducer::FusedAllReduceSchedule(EagerGroup *group,
                                           const int curr_group_index) {
   // The overall timeline: concat > div_nranks > allreduce > split
@@ -1091,13 +1231,39 @@ void EagerReducer::FusedAllReduceSchedule(EagerGroup *group,
 
   VLOG(3) << "group [" << curr_group_index << "] start fused_allreduce.";
 
-  // concat tensors
-  group->ConcatTensors(inner_place_);
+  // concat tensors, the grads are in the contents already as their views
+  if (!grad_as_bucket_view_) {
+    group->ConcatTensors(inner_place_);
+  }
 
   // div nranks
   paddle::experimental::scale_(
       group->dense_contents_, 1.0 / nranks_, 0.0, false);  // NOLINT
 
+  if (gradient_compressor_) {
+    Tensor bucket = group->dense_contents_;
+    group->task = gradient_compressor_->AllReduce(
+        static_cast<size_t>(curr_group_index), &group->dense_contents_);
+    if (grad_as_bucket_view_) {
+      // the reduced contents are a new tensor, the grads view the bucket
+      auto *default_ctx = phi::DeviceContextPool::Instance().Get(inner_place_);
+      phi::Copy(*default_ctx,
+                *std::dynamic_pointer_cast<phi::DenseTensor>(
+                    group->dense_contents_.impl()),
+                inner_place_,
+                false,
+                std::dynamic_pointer_cast<phi::DenseTensor>(bucket.impl())
+                    .get());
+      group->dense_contents_ = bucket;
+    }
+    if (IsStreamSafeAllocator() && !grad_as_bucket_view_) {
+      // The reduced contents are computed on the calculation stream.
+      auto *default_ctx = phi::DeviceContextPool::Instance().Get(inner_place_);
+      group->SplitTensors(*default_ctx);
+    }
+    return;
+  }
+
   // all_reduce
   std::vector<Tensor> reduce_tensors = {group->dense_contents_};
   std::vector<phi::DenseTensor> in_out;
@@ -1114,7 +1280,9 @@ void EagerReducer::FusedAllReduceSchedule(EagerGroup *group,
     // insecure. In the Split operator, additional memory will be applied for
     // calculation, and if it is asynchronous, an illegal memory access may be
     // encountered.
-    group->SplitTensors(*context);
+    if (!grad_as_bucket_view_) {
+      group->SplitTensors(*context);
+    }
     group->task->UpdateWaitChain(*context);
   }
 }
@@ -17,6 +17,7 @@
 #include <map>
 #include <vector>
 
+#include "paddle/fluid/distributed/collective/gradient_compression.h"
 #include "paddle/fluid/distributed/collective/process_group.h"
 #include "paddle/fluid/eager/accumulation/accumulation_node.h"
 #include "paddle/fluid/eager/api/utils/hook_utils.h"
@@ -56,6 +57,10 @@ class EagerGroup {
   int64_t all_length_{0};
   std::vector<IntArray> origin_shapes_;
 
+  // With grad_as_bucket_view, the parts of the persistent dense_contents_
+  // shaped as the parameters, which the parameters take as their grads.
+  std::vector<phi::DenseTensor> grad_views_;
+
   // Global indices of participating tensors in the group
   std::vector<size_t> tensor_indices_;
 
@@ -93,7 +98,10 @@ class EagerReducer {
       const std::vector<bool> &is_sparse_gradient,
       std::shared_ptr<distributed::ProcessGroup> process_group,
       const std::vector<size_t> &group_size_limits,
-      bool find_unused_parameters);
+      bool find_unused_parameters,
+      bool rebuild_groups = true,
+      size_t first_group_size_limit = 0,
+      bool grad_as_bucket_view = false);
 
   virtual ~EagerReducer() {}
 
@@ -109,9 +117,23 @@ class EagerReducer {
   void FusedAllReduceSchedule(EagerGroup *group, const int curr_group_index);
   void AllReduceSparse(EagerGroup *group, const int curr_group_index);
   void FinalizeBackward();
+  std::vector<std::vector<size_t>> RebuildGroups();
   void TraverseBackwardGraph(const std::vector<Tensor> &outputs);
   void ProcessUnusedDenseVars();
   bool HasGrad(size_t var_index);
+  // Makes the grad of the tensor the view of it in its group, copying the
+  // grad there first when it is not the view yet.
+  void MarkGradAsBucketView(size_t var_index, bool is_used_var);
+
+  // Reduce the dense groups in a compressed form, kNone restoring the
+  // allreduce.
+  void SetGradientCompression(const GradientCompressionOptions &options);
+  std::vector<GradientCompressionStats> GetGradientCompressionStats() const;
+
+  inline bool NeedRebuildGroup() {
+    return rebuild_groups_ && !has_rebuilt_group_ &&
+           !find_unused_vars_each_step_;
+  }
 
  private:
   std::vector<Tensor> tensors_;
@@ -139,6 +161,19 @@ class EagerReducer {
   bool find_unused_vars_once_{true};
   bool groups_need_finalize_{false};
   Tensor global_used_vars_;
+
+  // Following variables are to help rebuild group. The groups are rebuilt
+  // once, after the first backward, in the order the gradients were ready.
+  bool rebuild_groups_{true};
+  bool has_rebuilt_group_{false};
+  size_t first_group_size_limit_{0};
+  std::vector<int64_t> rebuild_var_indices_;
+
+  std::unique_ptr<GradientCompressor> gradient_compressor_;
+
+  // The dense groups keep their contents across steps and the gradients
+  // are accumulated in them, so they are reduced without concat and split.
+  bool grad_as_bucket_view_{false};
 };
 
 }  //  namespace distributed
@@ -15,9 +15,11 @@
 #include "paddle/fluid/distributed/fleet_executor/carrier.h"
 
 #include <algorithm>
+#include <chrono>
 #include <vector>
 
 #include "paddle/common/flags.h"
+#include "paddle/fluid/distributed/fleet_executor/compute_interceptor.h"
 #include "paddle/fluid/distributed/fleet_executor/global.h"
 #include "paddle/fluid/distributed/fleet_executor/interceptor.h"
 #include "paddle/fluid/distributed/fleet_executor/message_bus.h"
@@ -34,6 +36,23 @@ PHI_DEFINE_EXPORTED_bool(
     "Use standalone executor to run ops. Temporary FLAGS, will be removed "
     "after all fleet executor cases are modified to run ops with standalone "
     "executor.");
+PHI_DEFINE_EXPORTED_bool(
+    fleet_executor_report_bubble,
+    false,
+    "Log the time each compute interceptor runs and idles in each run of "
+    "the carrier, and the bubble ratio of the stage. The device is waited "
+    "for after each task to time it.");
+PHI_DEFINE_EXPORTED_int32(
+    fleet_executor_thread_num,
+    1,
+    "The number of threads of the carrier to handle the messages of the "
+    "interceptors, each interceptor is assigned to one of them.");
+PHI_DEFINE_EXPORTED_bool(
+    fleet_executor_work_stealing,
+    false,
+    "Let an idle thread of the carrier handle the messages of an interceptor "
+    "assigned to a busy one. The messages of an interceptor are still "
+    "handled in order, by one thread at a time.");
 COMMON_DECLARE_bool(cache_inference_while_scope);
 
 namespace paddle {
@@ -52,9 +71,9 @@ void Carrier::Init(
   rank_ = rank;
   interceptor_id_to_rank_ = interceptor_id_to_rank;
 
-  // TODO(fleet_exe dev): thread pool
-  thread_num_ = 1;
+  thread_num_ = FLAGS_fleet_executor_thread_num;
   thread_pool_.SetThreadNum(thread_num_);
+  thread_pool_.SetWorkStealing(FLAGS_fleet_executor_work_stealing);
   thread_pool_.Start();
 }
 
@@ -98,9 +117,9 @@ void Carrier::Init(
   interceptor_id_to_rank_.emplace(SOURCE_ID, rank);
   interceptor_id_to_rank_.emplace(SINK_ID, rank);
 
-  // TODO(fleet_exe dev): thread pool
-  thread_num_ = 1;
+  thread_num_ = FLAGS_fleet_executor_thread_num;
   thread_pool_.SetThreadNum(thread_num_);
+  thread_pool_.SetWorkStealing(FLAGS_fleet_executor_work_stealing);
   thread_pool_.Start();
 
   CreateInterceptors(inference_root_scope_vars);
@@ -190,10 +209,21 @@ void Carrier::Start() {
   start_msg.set_dst_id(SOURCE_ID);
   start_msg.set_src_id(SOURCE_ID);
   start_msg.set_message_type(START);
+  if (FLAGS_fleet_executor_report_bubble) {
+    for (auto& iter : interceptor_idx_to_interceptor_) {
+      auto* compute = dynamic_cast<ComputeInterceptor*>(iter.second.get());
+      if (compute != nullptr) {
+        compute->ResetRunTiming();
+      }
+    }
+  }
   Send(start_msg);
   // TODO(wangxi): async step
   Wait();
   dev_ctx_->Wait();
+  if (FLAGS_fleet_executor_report_bubble) {
+    ReportBubble();
+  }
   if (!FLAGS_cache_inference_while_scope) {
     // don't drop_kids when cache_inference_while_scope
     for (auto* micro_scope : microbatch_scopes_) {
@@ -208,6 +238,41 @@ void Carrier::Start() {
   }
 }
 
+void Carrier::ReportBubble() const {
+  using Clock = std::chrono::steady_clock;
+  using Ms = std::chrono::duration<double, std::milli>;
+  // A task idles from its first run to its last whenever it does not run,
+  // and the stage, which runs its tasks on one thread, whenever none does.
+  Clock::duration stage_busy{0};
+  Clock::time_point stage_begin = Clock::time_point::max();
+  Clock::time_point stage_end = Clock::time_point::min();
+  for (auto& iter : interceptor_idx_to_interceptor_) {
+    auto* compute = dynamic_cast<ComputeInterceptor*>(iter.second.get());
+    if (compute == nullptr || compute->run_timing().num_runs == 0) {
+      continue;
+    }
+    const auto& timing = compute->run_timing();
+    double busy = Ms(timing.busy).count();
+    double span = Ms(timing.end - timing.begin).count();
+    LOG(INFO) << "Carrier " << carrier_id_ << " rank " << rank_
+              << " interceptor " << iter.first << " with role "
+              << compute->GetTaskNode()->role() << " runs "
+              << timing.num_runs << " times, busy " << busy << " ms in "
+              << span << " ms, bubble ratio "
+              << (span > 0 ? 1.0 - busy / span : 0.0);
+    stage_busy += timing.busy;
+    stage_begin = std::min(stage_begin, timing.begin);
+    stage_end = std::max(stage_end, timing.end);
+  }
+  if (stage_begin < stage_end) {
+    double busy = Ms(stage_busy).count();
+    double span = Ms(stage_end - stage_begin).count();
+    LOG(INFO) << "Carrier " << carrier_id_ << " rank " << rank_ << " busy "
+              << busy << " ms in " << span << " ms, bubble ratio "
+              << 1.0 - busy / span;
+  }
+}
+
 bool Carrier::IsInit() const { return is_init_; }
 
 int64_t Carrier::GetRank(int64_t interceptor_id) const {
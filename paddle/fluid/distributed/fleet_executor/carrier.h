@@ -99,6 +99,9 @@ class Carrier final {
 
   int64_t GetRank(int64_t interceptor_id) const;
 
+  // log the bubble ratio of each compute interceptor and of the stage
+  void ReportBubble() const;
+
   // interceptor logic id to actually interceptor
   std::unordered_map<int64_t, std::unique_ptr<Interceptor>>
       interceptor_idx_to_interceptor_;
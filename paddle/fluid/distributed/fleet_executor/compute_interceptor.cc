@@ -14,16 +14,80 @@
 
 #include "paddle/fluid/distributed/fleet_executor/compute_interceptor.h"
 
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
 #include "paddle/common/errors.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/fleet_executor/carrier.h"
 #include "paddle/fluid/distributed/fleet_executor/task_node.h"
 #include "paddle/fluid/framework/executor_gc_helper.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/jit/serializer.h"
 
+COMMON_DECLARE_bool(fleet_executor_report_bubble);
+
 namespace paddle {
 namespace distributed {
 
+namespace {
+
+// Appends what is written to a string, so that the tensors are serialized
+// into the message without going through a std::ostringstream and its copy.
+class StringAppendBuf : public std::streambuf {
+ public:
+  explicit StringAppendBuf(std::string* str) : str_(str) {}
+
+ protected:
+  std::streamsize xsputn(const char* s, std::streamsize n) override {
+    str_->append(s, n);
+    return n;
+  }
+
+  int_type overflow(int_type ch) override {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      str_->push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+  }
+
+ private:
+  std::string* str_;
+};
+
+// Reads a string in place, so that the tensors are deserialized from the
+// message without copying it to a std::istringstream.
+class StringViewBuf : public std::streambuf {
+ public:
+  explicit StringViewBuf(const std::string& str) {
+    char* begin = const_cast<char*>(str.data());
+    setg(begin, begin, begin + str.size());
+  }
+
+ protected:
+  pos_type seekoff(off_type off,
+                   std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override {
+    char* base = dir == std::ios_base::beg   ? eback()
+                 : dir == std::ios_base::cur ? gptr()
+                                             : egptr();
+    if (!(which & std::ios_base::in) || off < eback() - base ||
+        off > egptr() - base) {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), base + off, egptr());
+    return pos_type(gptr() - eback());
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+}  // namespace
+
 ComputeInterceptor::ComputeInterceptor(int64_t interceptor_id, TaskNode* node)
     : Interceptor(interceptor_id, node),
       gen_step_to_scope_id_to_finish_flag_() {
@@ -61,10 +125,11 @@ void ComputeInterceptor::DecodeMsgVars(const InterceptorMessage& msg) {
   for (const auto& var_iter : msg.vars_list()) {
     const std::string& name = var_iter.name();
     auto& dev_ctx = *pool.Get(place_);
-    std::istringstream ss(var_iter.stensor());
+    StringViewBuf buf(var_iter.stensor());
+    std::istream is(&buf);
     auto* var = scope->Var(name);
     auto* tensor = var->GetMutable<phi::DenseTensor>();
-    framework::DeserializeFromStream(ss, tensor, dev_ctx);
+    framework::DeserializeFromStream(is, tensor, dev_ctx);
 
     VLOG(3) << "Set vars " << name << " with value in scope " << scope_id
             << " with dims " << tensor->dims() << " with dtype "
@@ -90,7 +155,6 @@ InterceptorMessage ComputeInterceptor::PrepareVarsMsg() {
     VarList* vars = ready_msg.add_vars_list();
     const auto& var_name = iter.first;
     vars->set_name(var_name);
-    std::ostringstream ss;
     auto& dev_ctx = *pool.Get(place_);
     auto* var = scope->FindVar(var_name);
     PADDLE_ENFORCE(
@@ -98,8 +162,11 @@ InterceptorMessage ComputeInterceptor::PrepareVarsMsg() {
         common::errors::NotFound(
             "Variable %s not exists in scope %ld", var_name, cur_scope_id_));
     const auto& tensor = var->Get<phi::DenseTensor>();
-    framework::SerializeToStream(ss, tensor, dev_ctx);
-    vars->set_stensor(ss.str());
+    std::string* stensor = vars->mutable_stensor();
+    stensor->reserve(tensor.memory_size() + 1024);
+    StringAppendBuf buf(stensor);
+    std::ostream os(&buf);
+    framework::SerializeToStream(os, tensor, dev_ctx);
     VLOG(3) << "Prepare vars msg " << var_name << " with dimension "
             << tensor.dims() << " dtype " << tensor.dtype();
   }
@@ -324,7 +391,20 @@ void ComputeInterceptor::Run() {
     VLOG(3) << "id=" << GetInterceptorId()
             << " ComputeInterceptor running in scope " << cur_scope_id_;
 
-    RunOps();
+    if (FLAGS_fleet_executor_report_bubble) {
+      auto begin = std::chrono::steady_clock::now();
+      RunOps();
+      phi::DeviceContextPool::Instance().Get(place_)->Wait();
+      auto end = std::chrono::steady_clock::now();
+      if (run_timing_.num_runs == 0) {
+        run_timing_.begin = begin;
+      }
+      ++run_timing_.num_runs;
+      run_timing_.busy += end - begin;
+      run_timing_.end = end;
+    } else {
+      RunOps();
+    }
 
     if (!gen_step_to_scope_id_to_finish_flag_.empty()) {
       auto iter = gen_step_to_scope_id_to_finish_flag_.begin();
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <queue>
 #include <utility>
 
@@ -28,6 +29,17 @@ class ComputeInterceptor : public Interceptor {
  public:
   ComputeInterceptor(int64_t interceptor_id, TaskNode* node);
 
+  // The runs of the task in the current run of the carrier, timed with
+  // FLAGS_fleet_executor_report_bubble.
+  struct RunTiming {
+    int64_t num_runs{0};
+    std::chrono::steady_clock::duration busy{0};
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::time_point end;
+  };
+  const RunTiming& run_timing() const { return run_timing_; }
+  void ResetRunTiming() { run_timing_ = RunTiming(); }
+
  protected:
   virtual void RunOps();
   virtual void SendDataReadyToDownStream();
@@ -56,6 +68,7 @@ class ComputeInterceptor : public Interceptor {
       gen_step_to_scope_id_to_finish_flag_;
   int64_t start_micro_step_{-1};
   int64_t num_micro_step_{-1};
+  RunTiming run_timing_;
 };
 
 }  // namespace distributed
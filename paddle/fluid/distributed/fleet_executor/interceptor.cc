@@ -63,6 +63,16 @@ void Interceptor::LoopOnce() {
 
     Handle(msg);
   }
+
+  bool more = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    more = !messages_.empty();
+    scheduled_ = more;
+  }
+  if (more) {
+    loop_->QueueStealableInLoop([this]() { LoopOnce(); });
+  }
 }
 
 void Interceptor::StopCarrier() {
@@ -78,14 +88,15 @@ void Interceptor::EnqueueRemoteInterceptorMessage(
   VLOG(3) << "Enqueue message: " << message.message_type() << " into "
           << interceptor_id_ << "'s remote mailbox.";
 
-  bool empty = false;
+  bool schedule = false;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    empty = messages_.empty();
     messages_.emplace_back(message);
+    schedule = !scheduled_;
+    scheduled_ = true;
   }
-  if (empty) {
-    loop_->QueueInLoop([this]() { LoopOnce(); });
+  if (schedule) {
+    loop_->QueueStealableInLoop([this]() { LoopOnce(); });
   }
 }
 
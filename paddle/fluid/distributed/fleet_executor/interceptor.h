@@ -123,6 +123,9 @@ class Interceptor {
 
   std::mutex mutex_;
   std::deque<InterceptorMessage> messages_;
+  // whether LoopOnce is queued or running, so that the messages are handled
+  // in order by one thread at a time even when the task is stolen
+  bool scheduled_{false};
 };
 
 class InterceptorFactory {
@@ -207,22 +207,34 @@ void MessageBus::ListenPort() {
 }
 
 #if defined(PADDLE_WITH_DISTRIBUTE) && !defined(PADDLE_WITH_PSLIB)
-bool MessageBus::SendInterRank(int64_t dst_rank,
-                               const InterceptorMessage& interceptor_message) {
+brpc::Channel* MessageBus::GetChannel(int64_t dst_rank) {
+  std::lock_guard<std::mutex> lock(channels_mutex_);
+  auto iter = channels_.find(dst_rank);
+  if (iter != channels_.end()) {
+    return iter->second.get();
+  }
   const auto& dst_addr = GetAddr(dst_rank);
-  VLOG(3) << "Message bus sending to addr: " << dst_addr;
+  VLOG(3) << "Message bus inits the channel to addr: " << dst_addr;
   const char* dst_addr_for_brpc = dst_addr.c_str();
-  brpc::Channel channel;
+  auto channel = std::make_unique<brpc::Channel>();
   brpc::ChannelOptions options;
   options.protocol = "baidu_std";
   options.connect_timeout_ms = 100000;
   options.timeout_ms = 100000;
   options.max_retry = 5;
   PADDLE_ENFORCE_EQ(
-      channel.Init(dst_addr_for_brpc, &options),
+      channel->Init(dst_addr_for_brpc, &options),
       0,
       common::errors::Unavailable("Message bus: init brpc channel error."));
-  MessageService_Stub stub(&channel);
+  return channels_.emplace(dst_rank, std::move(channel)).first->second.get();
+}
+
+bool MessageBus::SendInterRank(int64_t dst_rank,
+                               const InterceptorMessage& interceptor_message) {
+  VLOG(3) << "Message bus sending to rank: " << dst_rank;
+  // brpc channels are thread safe, so the messages to a rank share one
+  // instead of connecting again each time.
+  MessageService_Stub stub(GetChannel(dst_rank));
   InterceptorResponse response;
   brpc::Controller ctrl;
   ctrl.set_log_id(0);
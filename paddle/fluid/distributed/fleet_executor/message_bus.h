@@ -15,6 +15,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -67,6 +68,9 @@ class MessageBus final {
   // send the message inter rank (dst is different rank with src)
   bool SendInterRank(int64_t dst_rank,
                      const InterceptorMessage& interceptor_message);
+
+  // the channel to dst rank, inited by the first message sent to it
+  brpc::Channel* GetChannel(int64_t dst_rank);
 #endif
 
   bool is_init_{false};
@@ -83,6 +87,9 @@ class MessageBus final {
   MessageServiceImpl message_service_;
   // brpc server
   brpc::Server server_;
+  // brpc channels reused by the messages to each rank
+  std::unordered_map<int64_t, std::unique_ptr<brpc::Channel>> channels_;
+  std::mutex channels_mutex_;
 #endif
 
   // for barrier
@@ -15,6 +15,7 @@
 #include "paddle/fluid/distributed/fleet_executor/task_loop.h"
 
 #include "paddle/common/errors.h"
+#include "paddle/fluid/distributed/fleet_executor/task_loop_scheduler.h"
 #include "paddle/fluid/platform/enforce.h"
 
 namespace paddle::distributed {
@@ -23,8 +24,12 @@ thread_local TaskLoop* TaskLoop::thread_local_loop_ = nullptr;
 
 TaskLoop* TaskLoop::GetTaskLoopOfCurrentThread() { return thread_local_loop_; }
 
-TaskLoop::TaskLoop()
-    : looping_(false), quit_(false), thread_id_(std::this_thread::get_id()) {
+TaskLoop::TaskLoop(TaskLoopScheduler* scheduler, int tid)
+    : looping_(false),
+      quit_(false),
+      thread_id_(std::this_thread::get_id()),
+      scheduler_(scheduler),
+      tid_(tid) {
   PADDLE_ENFORCE_EQ(
       thread_local_loop_,
       nullptr,
@@ -44,10 +49,16 @@ void TaskLoop::Loop() {
   looping_ = true;
   quit_ = false;
 
-  while (!quit_) {
-    auto tasks = tasks_.PopAll();
-    for (auto& task : tasks) {
-      task();
+  if (scheduler_ != nullptr) {
+    while (!quit_) {
+      scheduler_->Pop(tid_)();
+    }
+  } else {
+    while (!quit_) {
+      auto tasks = tasks_.PopAll();
+      for (auto& task : tasks) {
+        task();
+      }
     }
   }
   looping_ = false;
@@ -66,7 +77,21 @@ void TaskLoop::RunInLoop(Functor cb) {
   }
 }
 
-void TaskLoop::QueueInLoop(Functor cb) { tasks_.Push(cb); }
+void TaskLoop::QueueInLoop(Functor cb) {
+  if (scheduler_ != nullptr) {
+    scheduler_->Push(tid_, std::move(cb), /*stealable=*/false);
+  } else {
+    tasks_.Push(cb);
+  }
+}
+
+void TaskLoop::QueueStealableInLoop(Functor cb) {
+  if (scheduler_ != nullptr) {
+    scheduler_->Push(tid_, std::move(cb), /*stealable=*/true);
+  } else {
+    tasks_.Push(cb);
+  }
+}
 
 void TaskLoop::WakeUp() {
   Functor task([] {});
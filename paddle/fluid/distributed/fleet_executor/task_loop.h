@@ -26,13 +26,16 @@
 namespace paddle {
 namespace distributed {
 
+class TaskLoopScheduler;
+
 class TaskLoop {
  public:
   static TaskLoop* GetTaskLoopOfCurrentThread();
 
   using Functor = std::function<void()>;
 
-  TaskLoop();
+  // With a scheduler, the loop is the tid-th of a work stealing pool.
+  explicit TaskLoop(TaskLoopScheduler* scheduler = nullptr, int tid = 0);
   ~TaskLoop();
 
   void Loop();
@@ -40,6 +43,8 @@ class TaskLoop {
 
   void RunInLoop(Functor cb);
   void QueueInLoop(Functor cb);
+  // Queue a task that an idle loop of the pool may steal and run instead.
+  void QueueStealableInLoop(Functor cb);
 
   template <class F, class... Args>
   auto Enqueue(F&& f, Args&&... args)
@@ -50,7 +55,7 @@ class TaskLoop {
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
     std::future<return_type> task_future = task->get_future();
 
-    tasks_.Push([task]() { (*task)(); });
+    QueueInLoop([task]() { (*task)(); });
     return task_future;
   }
 
@@ -76,6 +81,8 @@ class TaskLoop {
   bool looping_;
   std::atomic<bool> quit_;
   std::thread::id thread_id_;
+  TaskLoopScheduler* scheduler_;
+  int tid_;
 
   framework::BlockingQueue<Functor> tasks_;
 };
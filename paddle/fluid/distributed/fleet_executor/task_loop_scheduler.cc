@@ -0,0 +1,58 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/fleet_executor/task_loop_scheduler.h"
+
+namespace paddle::distributed {
+
+TaskLoopScheduler::TaskLoopScheduler(int thread_num) : queues_(thread_num) {}
+
+void TaskLoopScheduler::Push(int tid, Functor task, bool stealable) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queues_[tid].push_back({std::move(task), stealable});
+  }
+  // Not only loop tid may take the task.
+  cv_.notify_all();
+}
+
+TaskLoopScheduler::Functor TaskLoopScheduler::Pop(int tid) {
+  Functor task;
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [&] { return TryPop(tid, &task); });
+  return task;
+}
+
+bool TaskLoopScheduler::TryPop(int tid, Functor* task) {
+  auto& own = queues_[tid];
+  if (!own.empty()) {
+    *task = std::move(own.front().func);
+    own.pop_front();
+    return true;
+  }
+  int thread_num = static_cast<int>(queues_.size());
+  for (int i = 1; i < thread_num; ++i) {
+    auto& victim = queues_[(tid + i) % thread_num];
+    for (auto it = victim.begin(); it != victim.end(); ++it) {
+      if (it->stealable) {
+        *task = std::move(it->func);
+        victim.erase(it);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace paddle::distributed
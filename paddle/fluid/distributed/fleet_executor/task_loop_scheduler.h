@@ -0,0 +1,59 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "paddle/common/macros.h"
+
+namespace paddle {
+namespace distributed {
+
+// Schedules the tasks of the loops of a TaskLoopThreadPool with work
+// stealing. A loop runs the tasks queued to it first; when it has none, it
+// steals the oldest stealable task queued to another loop, so that a slow
+// task does not hold up the ready tasks queued behind it.
+class TaskLoopScheduler {
+ public:
+  using Functor = std::function<void()>;
+
+  explicit TaskLoopScheduler(int thread_num);
+
+  void Push(int tid, Functor task, bool stealable);
+  // Blocks until there is a task for loop tid, its own or stolen.
+  Functor Pop(int tid);
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(TaskLoopScheduler);
+
+  struct Task {
+    Functor func;
+    bool stealable;
+  };
+
+  // Called with mutex_ held.
+  bool TryPop(int tid, Functor* task);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::deque<Task>> queues_;
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -20,7 +20,8 @@
 
 namespace paddle::distributed {
 
-TaskLoopThread::TaskLoopThread() : start_(false), loop_(nullptr) {}
+TaskLoopThread::TaskLoopThread(TaskLoopScheduler* scheduler, int tid)
+    : start_(false), scheduler_(scheduler), tid_(tid), loop_(nullptr) {}
 
 TaskLoopThread::~TaskLoopThread() {
   if (loop_ != nullptr) {
@@ -43,7 +44,7 @@ TaskLoop* TaskLoopThread::StartLoop() {
 }
 
 void TaskLoopThread::Loop() {
-  TaskLoop loop;
+  TaskLoop loop(scheduler_, tid_);
   {
     std::unique_lock<std::mutex> lock(mutex_);
     loop_ = &loop;
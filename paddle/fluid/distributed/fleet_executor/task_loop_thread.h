@@ -24,10 +24,11 @@ namespace paddle {
 namespace distributed {
 
 class TaskLoop;
+class TaskLoopScheduler;
 
 class TaskLoopThread {
  public:
-  TaskLoopThread();
+  explicit TaskLoopThread(TaskLoopScheduler* scheduler = nullptr, int tid = 0);
   ~TaskLoopThread();
 
   TaskLoop* StartLoop();
@@ -38,6 +39,8 @@ class TaskLoopThread {
   void Loop();
 
   bool start_;
+  TaskLoopScheduler* scheduler_;
+  int tid_;
   TaskLoop* loop_;
   std::thread thread_;
   std::mutex mutex_;
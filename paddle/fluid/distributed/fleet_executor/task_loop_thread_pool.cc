@@ -16,6 +16,7 @@
 
 #include "paddle/common/errors.h"
 #include "paddle/fluid/distributed/fleet_executor/task_loop.h"
+#include "paddle/fluid/distributed/fleet_executor/task_loop_scheduler.h"
 #include "paddle/fluid/distributed/fleet_executor/task_loop_thread.h"
 #include "paddle/fluid/platform/enforce.h"
 
@@ -24,7 +25,7 @@ namespace paddle::distributed {
 TaskLoopThreadPool::TaskLoopThreadPool() : TaskLoopThreadPool(1) {}
 
 TaskLoopThreadPool::TaskLoopThreadPool(int thread_num)
-    : start_(false), thread_num_(thread_num) {}
+    : start_(false), thread_num_(thread_num), work_stealing_(false) {}
 
 TaskLoopThreadPool::~TaskLoopThreadPool() = default;
 
@@ -40,8 +41,11 @@ void TaskLoopThreadPool::Start() {
           "thread num must greater than 0, but now is %d", thread_num_));
 
   start_ = true;
+  if (work_stealing_) {
+    scheduler_ = std::make_unique<TaskLoopScheduler>(thread_num_);
+  }
   for (int i = 0; i < thread_num_; ++i) {
-    threads_.emplace_back(new TaskLoopThread());
+    threads_.emplace_back(new TaskLoopThread(scheduler_.get(), i));
     loops_.push_back(threads_[i]->StartLoop());
   }
 }
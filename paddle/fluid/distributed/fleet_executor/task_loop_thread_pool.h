@@ -23,6 +23,7 @@ namespace paddle {
 namespace distributed {
 
 class TaskLoop;
+class TaskLoopScheduler;
 class TaskLoopThread;
 
 class TaskLoopThreadPool {
@@ -32,6 +33,8 @@ class TaskLoopThreadPool {
   ~TaskLoopThreadPool();
 
   void SetThreadNum(int thread_num) { thread_num_ = thread_num; }
+  // Let idle loops steal the stealable tasks of busy ones.
+  void SetWorkStealing(bool work_stealing) { work_stealing_ = work_stealing; }
 
   void Start();
 
@@ -43,6 +46,9 @@ class TaskLoopThreadPool {
 
   bool start_;
   int thread_num_;
+  bool work_stealing_;
+  // outlives the threads
+  std::unique_ptr<TaskLoopScheduler> scheduler_;
   std::vector<std::unique_ptr<TaskLoopThread>> threads_;
   std::vector<TaskLoop*> loops_;
 };
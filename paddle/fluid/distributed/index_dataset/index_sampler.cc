@@ -14,11 +14,138 @@
 
 #include "paddle/fluid/distributed/index_dataset/index_sampler.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+
 #include "paddle/fluid/framework/data_feed.h"
 
 namespace paddle {
 namespace distributed {
 
+namespace {
+
+// The inputs are split into chunks of kSampleChunkSize, each sampled by one
+// thread with a random engine seeded by the seed and the index of the chunk,
+// so that the samples do not depend on the number of threads.
+constexpr size_t kSampleChunkSize = 256;
+
+template <typename Func>
+void ParallelForChunks(size_t num, Func func) {
+  size_t chunk_num = (num + kSampleChunkSize - 1) / kSampleChunkSize;
+  size_t thread_num = std::min<size_t>(
+      chunk_num, std::max<unsigned>(std::thread::hardware_concurrency(), 1));
+  if (thread_num <= 1) {
+    for (size_t c = 0; c < chunk_num; c++) {
+      func(c, c * kSampleChunkSize, std::min(num, (c + 1) * kSampleChunkSize));
+    }
+    return;
+  }
+  std::atomic<size_t> next_chunk{0};
+  // the errors of the threads are rethrown by the caller
+  std::vector<std::exception_ptr> errors(thread_num);
+  std::vector<std::thread> threads;
+  threads.reserve(thread_num);
+  for (size_t t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      try {
+        for (size_t c = next_chunk++; c < chunk_num; c = next_chunk++) {
+          func(c,
+               c * kSampleChunkSize,
+               std::min(num, (c + 1) * kSampleChunkSize));
+        }
+      } catch (...) {
+        errors[t] = std::current_exception();
+        next_chunk = chunk_num;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+int TreeLevel(uint64_t code, int branch) {
+  int level = 0;
+  uint64_t level_end = 1;
+  uint64_t level_num = 1;
+  while (code >= level_end) {
+    level_num *= branch;
+    level_end += level_num;
+    level++;
+  }
+  return level;
+}
+
+}  // namespace
+
+FlatTree::FlatTree(TreeIndex* tree) {
+  int height = tree->Height();
+  int branch = tree->Branch();
+  layers_.resize(height);
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> layer_nodes(height);
+  for (auto& item : tree->data_) {
+    int level = TreeLevel(item.first, branch);
+    PADDLE_ENFORCE_LT(level,
+                      height,
+                      common::errors::InvalidArgument(
+                          "The code [%d] is beyond the height [%d] of tree.",
+                          item.first,
+                          height));
+    layer_nodes[level].emplace_back(item.first, item.second.id());
+  }
+  for (int level = 0; level < height; level++) {
+    auto& nodes = layer_nodes[level];
+    std::sort(nodes.begin(), nodes.end());
+    auto& layer = layers_[level];
+    layer.codes.reserve(nodes.size());
+    layer.ids.reserve(nodes.size());
+    for (auto& node : nodes) {
+      layer.codes.push_back(node.first);
+      layer.ids.push_back(node.second);
+    }
+    layer.child_offsets.assign(nodes.size() + 1, 0);
+    if (level == 0) {
+      continue;
+    }
+    auto& upper = layers_[level - 1];
+    layer.parents.reserve(nodes.size());
+    for (auto code : layer.codes) {
+      uint64_t parent_code = (code - 1) / branch;
+      auto it = std::lower_bound(
+          upper.codes.begin(), upper.codes.end(), parent_code);
+      PADDLE_ENFORCE_EQ(
+          it != upper.codes.end() && *it == parent_code,
+          true,
+          common::errors::InvalidArgument(
+              "The parent [%d] of the node [%d] doesn't exist in tree.",
+              parent_code,
+              code));
+      uint32_t parent = static_cast<uint32_t>(it - upper.codes.begin());
+      layer.parents.push_back(parent);
+      upper.child_offsets[parent + 1]++;
+    }
+    for (size_t k = 1; k < upper.child_offsets.size(); k++) {
+      upper.child_offsets[k] += upper.child_offsets[k - 1];
+    }
+  }
+  auto& leafs = layers_[height - 1];
+  leaf_index_.reserve(leafs.ids.size());
+  for (size_t k = 0; k < leafs.ids.size(); k++) {
+    leaf_index_[leafs.ids[k]] = static_cast<uint32_t>(k);
+  }
+}
+
 std::vector<std::vector<uint64_t>> LayerWiseSampler::sample(
     const std::vector<std::vector<uint64_t>>& user_inputs,
     const std::vector<uint64_t>& target_ids,
@@ -29,103 +156,247 @@ std::vector<std::vector<uint64_t>> LayerWiseSampler::sample(
       input_num * layer_counts_sum_,
       std::vector<uint64_t>(user_feature_num + 2));
 
-  auto max_layer = tree_->Height();
-  size_t idx = 0;
-  for (size_t i = 0; i < input_num; i++) {
-    auto travel_codes =
-        tree_->GetTravelCodes(target_ids[i], start_sample_layer_);
-    auto travel_path = tree_->GetNodes(travel_codes);
-    for (size_t j = 0; j < travel_path.size(); j++) {
-      // user
-      if (j > 0 && with_hierarchy) {
-        auto ancestor_codes =
-            tree_->GetAncestorCodes(user_inputs[i], max_layer - j - 1);
-        auto hierarchical_user = tree_->GetNodes(ancestor_codes);
+  int max_layer = flat_tree_->Height();
+  ParallelForChunks(input_num, [&](size_t chunk, size_t begin, size_t end) {
+    std::mt19937_64 engine(seed_ + chunk);
+    std::vector<int64_t> user_index(user_feature_num);
+    for (size_t i = begin; i < end; i++) {
+      int64_t index = flat_tree_->LeafIndex(target_ids[i]);
+      PADDLE_ENFORCE_GE(index,
+                        0,
+                        common::errors::InvalidArgument(
+                            "id = %d doesn't exist in Tree.", target_ids[i]));
+      for (size_t k = 0; k < user_feature_num; k++) {
+        user_index[k] = flat_tree_->LeafIndex(user_inputs[i][k]);
+      }
+      size_t idx = i * layer_counts_sum_;
+      for (int j = 0; j < max_layer - start_sample_layer_; j++) {
+        const auto& layer = flat_tree_->Layer(max_layer - 1 - j);
+        uint64_t positive = layer.ids[index];
+        // user
         for (int idx_offset = 0; idx_offset <= layer_counts_[j]; idx_offset++) {
           for (size_t k = 0; k < user_feature_num; k++) {
-            outputs[idx + idx_offset][k] = hierarchical_user[k].id();
+            // the ancestors of the user items not in tree are the fake node
+            outputs[idx + idx_offset][k] =
+                j > 0 && with_hierarchy
+                    ? (user_index[k] < 0 ? 0 : layer.ids[user_index[k]])
+                    : user_inputs[i][k];
           }
         }
-      } else {
-        for (int idx_offset = 0; idx_offset <= layer_counts_[j]; idx_offset++) {
+
+        // sampler ++
+        outputs[idx][user_feature_num] = positive;
+        outputs[idx][user_feature_num + 1] = 1.0;
+        idx += 1;
+        std::uniform_int_distribution<size_t> dist(0, layer.ids.size() - 1);
+        for (int idx_offset = 0; idx_offset < layer_counts_[j]; idx_offset++) {
+          size_t sample_res = 0;
+          do {
+            sample_res = dist(engine);
+          } while (layer.ids[sample_res] == positive);
+          outputs[idx + idx_offset][user_feature_num] = layer.ids[sample_res];
+          outputs[idx + idx_offset][user_feature_num + 1] = 0;
+        }
+        idx += layer_counts_[j];
+
+        // move to the parents
+        if (j + 1 < max_layer - start_sample_layer_) {
+          index = layer.parents[index];
           for (size_t k = 0; k < user_feature_num; k++) {
-            outputs[idx + idx_offset][k] = user_inputs[i][k];
+            if (user_index[k] >= 0) {
+              user_index[k] = layer.parents[user_index[k]];
+            }
           }
         }
       }
-
-      // sampler ++
-      outputs[idx][user_feature_num] = travel_path[j].id();
-      outputs[idx][user_feature_num + 1] = 1.0;
-      idx += 1;
-      for (int idx_offset = 0; idx_offset < layer_counts_[j]; idx_offset++) {
-        int sample_res = 0;
-        do {
-          sample_res = sampler_vec_[j]->Sample();
-        } while (layer_ids_[j][sample_res].id() == travel_path[j].id());
-        outputs[idx + idx_offset][user_feature_num] =
-            layer_ids_[j][sample_res].id();
-        outputs[idx + idx_offset][user_feature_num + 1] = 0;
-      }
-      idx += layer_counts_[j];
     }
-  }
+  });
   return outputs;
 }
+
 void LayerWiseSampler::sample_from_dataset(
     const uint16_t sample_slot,
     std::vector<paddle::framework::Record>* src_datas,
     std::vector<paddle::framework::Record>* sample_results) {
   sample_results->clear();
-  for (auto& data : *src_datas) {
-    VLOG(1) << "src data size = " << src_datas->size();
-    VLOG(1) << "float data size = " << data.float_feasigns_.size();
-    // data.Print();
-    uint64_t start_idx = sample_results->size();
-    VLOG(1) << "before sample, sample_results.size = " << start_idx;
-    uint64_t sample_feasign_idx = -1;
-    bool sample_sign = false;
-    for (unsigned int i = 0; i < data.uint64_feasigns_.size(); i++) {
-      VLOG(1) << "slot" << i << " = " << data.uint64_feasigns_[i].slot();
-      if (data.uint64_feasigns_[i].slot() == sample_slot) {
-        sample_sign = true;
-        sample_feasign_idx = i;
-      }
-      if (sample_sign) break;
-    }
+  VLOG(1) << "src data size = " << src_datas->size();
+  int max_layer = flat_tree_->Height();
+  // the samples of each record, gathered in the order of the records
+  std::vector<std::vector<paddle::framework::Record>> record_results(
+      src_datas->size());
+  ParallelForChunks(
+      src_datas->size(), [&](size_t chunk, size_t begin, size_t end) {
+        std::mt19937_64 engine(seed_ + chunk);
+        for (size_t r = begin; r < end; r++) {
+          auto& data = (*src_datas)[r];
+          auto& results = record_results[r];
+          int64_t sample_feasign_idx = -1;
+          for (unsigned int i = 0; i < data.uint64_feasigns_.size(); i++) {
+            if (data.uint64_feasigns_[i].slot() == sample_slot) {
+              sample_feasign_idx = i;
+              break;
+            }
+          }
+          if (sample_feasign_idx < 0) {
+            continue;
+          }
 
-    VLOG(1) << "sample_feasign_idx: " << sample_feasign_idx;
-    if (sample_sign) {
-      auto target_id =
-          data.uint64_feasigns_[sample_feasign_idx].sign().uint64_feasign_;
-      auto travel_codes = tree_->GetTravelCodes(target_id, start_sample_layer_);
-      auto travel_path = tree_->GetNodes(travel_codes);
-      for (unsigned int j = 0; j < travel_path.size(); j++) {
-        paddle::framework::Record instance(data);
-        instance.uint64_feasigns_[sample_feasign_idx].sign().uint64_feasign_ =
-            travel_path[j].id();
-        sample_results->push_back(instance);
-        for (int idx_offset = 0; idx_offset < layer_counts_[j]; idx_offset++) {
-          int sample_res = 0;
-          do {
-            sample_res = sampler_vec_[j]->Sample();
-          } while (layer_ids_[j][sample_res].id() == travel_path[j].id());
-          paddle::framework::Record instance(data);
-          instance.uint64_feasigns_[sample_feasign_idx].sign().uint64_feasign_ =
-              layer_ids_[j][sample_res].id();
-          VLOG(1) << "layer id :" << layer_ids_[j][sample_res].id();
-          // sample_feasign_idx + 1 == label's id
-          instance.uint64_feasigns_[sample_feasign_idx + 1]
-              .sign()
-              .uint64_feasign_ = 0;
-          sample_results->push_back(instance);
+          auto target_id =
+              data.uint64_feasigns_[sample_feasign_idx].sign().uint64_feasign_;
+          int64_t index = flat_tree_->LeafIndex(target_id);
+          PADDLE_ENFORCE_GE(index,
+                            0,
+                            common::errors::InvalidArgument(
+                                "id = %d doesn't exist in Tree.", target_id));
+          results.reserve(layer_counts_sum_);
+          for (int j = 0; j < max_layer - start_sample_layer_; j++) {
+            const auto& layer = flat_tree_->Layer(max_layer - 1 - j);
+            uint64_t positive = layer.ids[index];
+            results.emplace_back(data);
+            results.back()
+                .uint64_feasigns_[sample_feasign_idx]
+                .sign()
+                .uint64_feasign_ = positive;
+            std::uniform_int_distribution<size_t> dist(0,
+                                                       layer.ids.size() - 1);
+            for (int idx_offset = 0; idx_offset < layer_counts_[j];
+                 idx_offset++) {
+              size_t sample_res = 0;
+              do {
+                sample_res = dist(engine);
+              } while (layer.ids[sample_res] == positive);
+              results.emplace_back(data);
+              auto& instance = results.back();
+              instance.uint64_feasigns_[sample_feasign_idx]
+                  .sign()
+                  .uint64_feasign_ = layer.ids[sample_res];
+              // sample_feasign_idx + 1 == label's id
+              instance.uint64_feasigns_[sample_feasign_idx + 1]
+                  .sign()
+                  .uint64_feasign_ = 0;
+            }
+            if (j + 1 < max_layer - start_sample_layer_) {
+              index = layer.parents[index];
+            }
+          }
         }
-        VLOG(1) << "layer end!!!!!!!!!!!!!!!!!!";
-      }
-    }
+      });
+  size_t total = 0;
+  for (auto& results : record_results) {
+    total += results.size();
+  }
+  sample_results->reserve(total);
+  for (auto& results : record_results) {
+    std::move(
+        results.begin(), results.end(), std::back_inserter(*sample_results));
   }
   VLOG(1) << "after sample, sample_results.size = " << sample_results->size();
-  return;
+}
+
+void LayerWiseSampler::set_beamsearch_embedding(
+    const std::vector<float>& node_embs, int64_t emb_dim) {
+  PADDLE_ENFORCE_GT(
+      emb_dim,
+      0,
+      common::errors::InvalidArgument(
+          "The emb_dim = [%d], it should be greater than 0.", emb_dim));
+  PADDLE_ENFORCE_EQ(
+      node_embs.size(),
+      tree_->EmbSize() * emb_dim,
+      common::errors::InvalidArgument(
+          "The node embeddings should have emb_size [%d] * emb_dim [%d] "
+          "floats, but got [%d].",
+          tree_->EmbSize(),
+          emb_dim,
+          node_embs.size()));
+  node_embs_ = node_embs;
+  emb_dim_ = emb_dim;
+}
+
+std::vector<std::vector<uint64_t>> LayerWiseSampler::beam_search(
+    const std::vector<std::vector<float>>& user_embs) {
+  PADDLE_ENFORCE_GT(beam_size_,
+                    0,
+                    common::errors::PreconditionNotMet(
+                        "Please init the beam size by init_beamsearch_conf "
+                        "first."));
+  PADDLE_ENFORCE_GT(emb_dim_,
+                    0,
+                    common::errors::PreconditionNotMet(
+                        "Please set the node embeddings by "
+                        "set_beamsearch_embedding first."));
+  int max_layer = flat_tree_->Height();
+  size_t beam_size = static_cast<size_t>(beam_size_);
+  int start_layer = 0;
+  while (start_layer < max_layer - 1 &&
+         flat_tree_->Layer(start_layer).ids.size() <= beam_size) {
+    start_layer++;
+  }
+
+  std::vector<std::vector<uint64_t>> outputs(user_embs.size());
+  ParallelForChunks(
+      user_embs.size(), [&](size_t chunk UNUSED, size_t begin, size_t end) {
+        // the indexes of the candidates in their layer and their scores
+        std::vector<uint32_t> candidates;
+        std::vector<std::pair<float, uint32_t>> scored;
+        std::vector<uint32_t> beam;
+        for (size_t u = begin; u < end; u++) {
+          PADDLE_ENFORCE_EQ(
+              user_embs[u].size(),
+              static_cast<size_t>(emb_dim_),
+              common::errors::InvalidArgument(
+                  "The user embedding should have [%d] floats, but got [%d].",
+                  emb_dim_,
+                  user_embs[u].size()));
+          const float* user_emb = user_embs[u].data();
+          candidates.resize(flat_tree_->Layer(start_layer).ids.size());
+          std::iota(candidates.begin(), candidates.end(), 0);
+          for (int level = start_layer; level < max_layer; level++) {
+            const auto& layer = flat_tree_->Layer(level);
+            scored.clear();
+            scored.reserve(candidates.size());
+            for (auto k : candidates) {
+              const float* node_emb =
+                  node_embs_.data() + layer.ids[k] * emb_dim_;
+              float score = 0;
+              for (int64_t d = 0; d < emb_dim_; d++) {
+                score += user_emb[d] * node_emb[d];
+              }
+              scored.emplace_back(score, k);
+            }
+            size_t keep = std::min(beam_size, scored.size());
+            std::partial_sort(scored.begin(),
+                              scored.begin() + keep,
+                              scored.end(),
+                              [](const std::pair<float, uint32_t>& a,
+                                 const std::pair<float, uint32_t>& b) {
+                                return a.first > b.first;
+                              });
+            beam.clear();
+            for (size_t k = 0; k < keep; k++) {
+              beam.push_back(scored[k].second);
+            }
+            if (level == max_layer - 1) {
+              break;
+            }
+            // the children of the beam, contiguous for each node
+            candidates.clear();
+            for (auto k : beam) {
+              for (uint32_t c = layer.child_offsets[k];
+                   c < layer.child_offsets[k + 1];
+                   c++) {
+                candidates.push_back(c);
+              }
+            }
+          }
+          const auto& leafs = flat_tree_->Layer(max_layer - 1);
+          outputs[u].reserve(beam.size());
+          for (auto k : beam) {
+            outputs[u].push_back(leafs.ids[k]);
+          }
+        }
+      });
+  return outputs;
 }
 
 std::vector<uint64_t> float2int(std::vector<double> tmp) {
@@ -13,17 +13,51 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "paddle/fluid/distributed/index_dataset/index_wrapper.h"
 #include "paddle/fluid/framework/data_feed.h"
 #include "paddle/fluid/framework/program_desc.h"
 #include "paddle/fluid/platform/enforce.h"
-#include "paddle/phi/kernels/funcs/math/sampler.h"
 
 namespace paddle {
 namespace distributed {
 
+// The nodes of a layer of a tree index in arrays, in the order of their
+// codes, so that the children of a node are contiguous in the next layer.
+struct FlatTreeLayer {
+  std::vector<uint64_t> codes;
+  std::vector<uint64_t> ids;
+  // the index of the parent of each node in the upper layer
+  std::vector<uint32_t> parents;
+  // the children of the node k are [child_offsets[k], child_offsets[k + 1])
+  // in the next layer
+  std::vector<uint32_t> child_offsets;
+};
+
+// A tree index flattened into arrays per layer, which the samplers walk by
+// index instead of looking up the proto of each node by code. The leafs are
+// in the last layer.
+class FlatTree {
+ public:
+  explicit FlatTree(TreeIndex* tree);
+
+  int Height() const { return static_cast<int>(layers_.size()); }
+  const FlatTreeLayer& Layer(int level) const { return layers_[level]; }
+  // the index of the leaf of id in the last layer, -1 if id is not a leaf
+  int64_t LeafIndex(uint64_t id) const {
+    auto it = leaf_index_.find(id);
+    return it == leaf_index_.end() ? -1 : it->second;
+  }
+
+ private:
+  std::vector<FlatTreeLayer> layers_;
+  std::unordered_map<uint64_t, uint32_t> leaf_index_;
+};
+
 class IndexSampler {
  public:
   virtual ~IndexSampler() {}
@@ -50,6 +84,15 @@ class IndexSampler {
       const uint16_t sample_slot,
       std::vector<paddle::framework::Record>* src_datas,
       std::vector<paddle::framework::Record>* sample_results) = 0;
+
+  // The embeddings of the nodes, emb_dim floats per node id, which the beam
+  // search scores by their inner product with the user embedding.
+  virtual void set_beamsearch_embedding(
+      const std::vector<float>& node_embs UNUSED, int64_t emb_dim UNUSED) {}
+  virtual std::vector<std::vector<uint64_t>> beam_search(
+      const std::vector<std::vector<float>>& user_embs UNUSED) {
+    return {};
+  }
 };
 
 class LayerWiseSampler : public IndexSampler {
@@ -57,6 +100,7 @@ class LayerWiseSampler : public IndexSampler {
   virtual ~LayerWiseSampler() {}
   explicit LayerWiseSampler(const std::string& name) {
     tree_ = IndexWrapper::GetInstance()->get_tree_index(name);
+    flat_tree_ = std::make_shared<FlatTree>(tree_.get());
   }
 
   void init_layerwise_conf(const std::vector<uint16_t>& layer_sample_counts,
@@ -98,22 +142,25 @@ class LayerWiseSampler : public IndexSampler {
     reverse(layer_counts_.begin(), layer_counts_.end());
     VLOG(3) << "sample counts sum: " << layer_counts_sum_;
 
-    auto max_layer = tree_->Height();
-    sampler_vec_.clear();
-    layer_ids_.clear();
-
-    auto layer_index = max_layer - 1;
-    size_t idx = 0;
-    while (layer_index >= start_sample_layer_) {
-      auto layer_codes = tree_->GetLayerCodes(layer_index);
-      layer_ids_.push_back(tree_->GetNodes(layer_codes));
-      auto sampler_temp = std::make_shared<phi::math::UniformSampler>(
-          layer_ids_[idx].size() - 1, seed_);
-      sampler_vec_.push_back(sampler_temp);
-      layer_index--;
-      idx++;
+    for (int level = start_sample_layer_; level < tree_->Height(); level++) {
+      int j = tree_->Height() - 1 - level;
+      PADDLE_ENFORCE_EQ(
+          layer_counts_[j] == 0 || flat_tree_->Layer(level).ids.size() > 1,
+          true,
+          common::errors::InvalidArgument(
+              "The layer [%d] has only one node, no negative can be sampled "
+              "from it.",
+              level));
     }
   }
+  void init_beamsearch_conf(const int64_t k) override {
+    PADDLE_ENFORCE_GT(
+        k,
+        0,
+        common::errors::InvalidArgument(
+            "The beam size = [%d], it should be greater than 0.", k));
+    beam_size_ = k;
+  }
   std::vector<std::vector<uint64_t>> sample(
       const std::vector<std::vector<uint64_t>>& user_inputs,
       const std::vector<uint64_t>& target_ids,
@@ -124,14 +171,24 @@ class LayerWiseSampler : public IndexSampler {
       std::vector<paddle::framework::Record>* src_datas,
       std::vector<paddle::framework::Record>* sample_results) override;
 
+  void set_beamsearch_embedding(const std::vector<float>& node_embs,
+                                int64_t emb_dim) override;
+  // The beam_size leafs of the highest scores for each user embedding, in
+  // the order of their scores, searched layer by layer from the first layer
+  // of more than beam_size nodes.
+  std::vector<std::vector<uint64_t>> beam_search(
+      const std::vector<std::vector<float>>& user_embs) override;
+
  private:
   std::vector<int> layer_counts_;
   int64_t layer_counts_sum_{0};
   std::shared_ptr<TreeIndex> tree_{nullptr};
+  std::shared_ptr<FlatTree> flat_tree_{nullptr};
   int seed_{0};
   int start_sample_layer_{1};
-  std::vector<std::shared_ptr<phi::math::Sampler>> sampler_vec_;
-  std::vector<std::vector<IndexNode>> layer_ids_;
+  int64_t beam_size_{0};
+  std::vector<float> node_embs_;
+  int64_t emb_dim_{0};
 };
 
 }  // end namespace distributed
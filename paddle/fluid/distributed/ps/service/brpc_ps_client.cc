@@ -14,6 +14,8 @@
 
 #include "paddle/fluid/distributed/ps/service/brpc_ps_client.h"
 
+#include <algorithm>
+#include <chrono>  // NOLINT
 #include <memory>
 #include <sstream>
 #include <string>
@@ -82,6 +84,33 @@ PD_DEFINE_int32(pserver_sparse_table_shard_num,
                 1000,
                 "sparse table shard for save & load");
 
+PD_DEFINE_int32(pserver_pull_sparse_coalesce_window_us,
+                0,
+                "window in us within which the sparse pulls of a table issued "
+                "by different threads are merged into one request per "
+                "server, 0 to send each pull on its own");
+
+PD_DEFINE_int32(pserver_pull_sparse_coalesce_max_keys,
+                65536,
+                "the merged sparse pull of a table is sent before the end of "
+                "the coalesce window once it has this many keys");
+
+PD_DEFINE_int32(pserver_hot_key_rebalance_interval_s,
+                0,
+                "interval in seconds between two hot key rebalancings of the "
+                "sparse tables by the client, 0 not to rebalance them");
+
+PD_DEFINE_double(pserver_hot_key_imbalance_ratio,
+                 1.5,
+                 "the hot keys of a server are rebalanced when it serves more "
+                 "than this ratio of the average pulls of a sparse table");
+
+PD_DEFINE_int32(pserver_hot_replica_ttl_ms,
+                60000,
+                "time in ms a server keeps the replica of the hot keys of "
+                "other servers, the clients route their pulls there for half "
+                "of it after each rebalancing");
+
 inline size_t get_sparse_shard(uint32_t shard_num,
                                uint32_t server_num,
                                uint64_t key) {
@@ -299,6 +328,13 @@ int32_t BrpcPsClient::Initialize() {
   options.connection_type = "pooled";
   options.connect_timeout_ms = FLAGS_pserver_connect_timeout_ms;
   options.max_retry = 3;
+  // The sparse and dense channels carry the data, the command one the
+  // control messages.
+  brpc::ChannelOptions data_options = options;
+  _use_rdma = UseRdmaTransport();
+#ifdef PADDLE_WITH_BRPC_RDMA
+  data_options.use_rdma = _use_rdma;
+#endif
 
   std::ostringstream os;
   std::string server_ip_port;
@@ -312,15 +348,16 @@ int32_t BrpcPsClient::Initialize() {
     server_ip_port.append(":");
     server_ip_port.append(std::to_string(server_list[i].port));
     for (size_t j = 0; j < _server_channels[i].size(); ++j) {
+      auto *channel_options = j < 2 ? &data_options : &options;
       _server_channels[i][j].reset(new brpc::Channel());
-      if (_server_channels[i][j]->Init(server_ip_port.c_str(), "", &options) !=
-          0) {
+      if (_server_channels[i][j]->Init(
+              server_ip_port.c_str(), "", channel_options) != 0) {
         VLOG(0) << "BrpcPSclient connect to Server:" << server_ip_port
                 << " Failed! Try again.";
         std::string int_ip_port =
             GetIntTypeEndpoint(server_list[i].ip, server_list[i].port);
-        if (_server_channels[i][j]->Init(int_ip_port.c_str(), "", &options) !=
-            0) {
+        if (_server_channels[i][j]->Init(
+                int_ip_port.c_str(), "", channel_options) != 0) {
           LOG(ERROR) << "BrpcPSclient connect to Server:" << int_ip_port
                      << " Failed!";
           return -1;
@@ -374,6 +411,10 @@ int32_t BrpcPsClient::Initialize() {
   // _async_push_sparse_thread.detach();
   _async_push_dense_thread =
       std::thread(std::bind(&BrpcPsClient::PushDenseTaskConsume, this));
+  if (FLAGS_pserver_hot_key_rebalance_interval_s > 0) {
+    _hot_key_rebalance_thread =
+        std::thread(std::bind(&BrpcPsClient::RebalanceHotKeysThread, this));
+  }
   // for debug
   // _print_thread =
   //    std::thread(std::bind(&BrpcPsClient::PrintQueueSizeThread, this));
@@ -683,6 +724,13 @@ std::future<int32_t> BrpcPsClient::CheckSavePrePatchDone() {
 std::future<int32_t> BrpcPsClient::Flush() {
   VLOG(0) << "BrpcPsClient::flush begin";
   _flushing = true;
+  {
+    std::lock_guard<std::mutex> lock(_pending_pull_mutex);
+    for (auto &pending : _pending_pulls) {
+      pending.second.release = true;
+    }
+    _pending_pull_cv.notify_all();
+  }
   std::promise<int> promise;
   std::future<int32_t> fut = promise.get_future();
   do {
@@ -726,6 +774,9 @@ void BrpcPsClient::FinalizeWorker() {
   _running = false;
   _async_push_dense_thread.join();
   _async_push_sparse_thread.join();
+  if (_hot_key_rebalance_thread.joinable()) {
+    _hot_key_rebalance_thread.join();
+  }
   // _print_thread.join();
   VLOG(0) << "BrpcPsClient::FinalizeWorker begin join server";
   _server.Stop(1000);
@@ -1141,6 +1192,73 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
                                               const uint64_t *keys,
                                               size_t num,
                                               bool is_training) {
+  if (FLAGS_pserver_pull_sparse_coalesce_window_us > 0) {
+    return CoalescePullSparse(select_values, table_id, keys, num, is_training);
+  }
+  auto promise = std::make_shared<std::promise<int32_t>>();
+  std::future<int> fut = promise->get_future();
+  SendPullSparse(select_values, table_id, keys, num, is_training, {promise});
+  return fut;
+}
+
+std::future<int32_t> BrpcPsClient::CoalescePullSparse(float **select_values,
+                                                      size_t table_id,
+                                                      const uint64_t *keys,
+                                                      size_t num,
+                                                      bool is_training) {
+  auto promise = std::make_shared<std::promise<int32_t>>();
+  std::future<int> fut = promise->get_future();
+  auto pending_key = std::make_pair(table_id, is_training);
+  bool first = false;
+  {
+    std::lock_guard<std::mutex> lock(_pending_pull_mutex);
+    auto &pending = _pending_pulls[pending_key];
+    first = pending.promises.empty();
+    pending.keys.insert(pending.keys.end(), keys, keys + num);
+    pending.select_values.insert(
+        pending.select_values.end(), select_values, select_values + num);
+    pending.promises.push_back(promise);
+    if (pending.keys.size() >=
+        static_cast<size_t>(FLAGS_pserver_pull_sparse_coalesce_max_keys)) {
+      pending.release = true;
+      _pending_pull_cv.notify_all();
+    }
+  }
+  if (!first) {
+    return fut;
+  }
+
+  PendingSparsePull merged;
+  {
+    std::unique_lock<std::mutex> lock(_pending_pull_mutex);
+    // The entry stays in the map until this, its first caller, takes it.
+    auto iter = _pending_pulls.find(pending_key);
+    _pending_pull_cv.wait_for(
+        lock,
+        std::chrono::microseconds(FLAGS_pserver_pull_sparse_coalesce_window_us),
+        [&iter] { return iter->second.release; });
+    merged = std::move(iter->second);
+    _pending_pulls.erase(iter);
+  }
+  VLOG(3) << "merged " << merged.promises.size() << " pulls of table "
+          << table_id << ", " << merged.keys.size() << " keys";
+  SendPullSparse(merged.select_values.data(),
+                 table_id,
+                 merged.keys.data(),
+                 merged.keys.size(),
+                 is_training,
+                 merged.promises);
+  return fut;
+}
+
+void BrpcPsClient::SendPullSparse(
+    float **select_values,
+    size_t table_id,
+    const uint64_t *keys,
+    size_t num,
+    bool is_training,
+    const std::vector<std::shared_ptr<std::promise<int32_t>>> &promises,
+    bool use_hot_key_routes) {
   auto timer = std::make_shared<CostTimer>("pserver_client_pull_sparse");
   auto local_timer =
       std::make_shared<CostTimer>("pserver_client_pull_sparse_local");
@@ -1160,8 +1278,16 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
     }
   }
 
+  auto hot_key_routes =
+      use_hot_key_routes ? GetHotKeyRoutes(table_id) : nullptr;
   for (size_t i = 0; i < num; ++i) {
     size_t shard_id = get_sparse_shard(shard_num, request_call_num, keys[i]);
+    if (hot_key_routes != nullptr) {
+      auto iter = hot_key_routes->servers.find(keys[i]);
+      if (iter != hot_key_routes->servers.end()) {
+        shard_id = iter->second;
+      }
+    }
     shard_sorted_kvs->at(shard_id).push_back({keys[i], select_values[i]});
   }
 
@@ -1206,9 +1332,9 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
         closure->set_promise_value(ret);
       });
   closure->add_timer(timer);
-  auto promise = std::make_shared<std::promise<int32_t>>();
-  closure->add_promise(promise);
-  std::future<int> fut = promise->get_future();
+  for (auto promise : promises) {
+    closure->add_promise(promise);
+  }
 
   for (size_t i = 0; i < request_call_num; ++i) {
     auto &sorted_kvs = shard_sorted_kvs->at(i);
@@ -1253,13 +1379,213 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
       closure->request(i)->set_client_id(_client_id);
       closure->request(i)->add_params((char *)&kv_request_count,  // NOLINT
                                       sizeof(uint32_t));
-      PsService_Stub rpc_stub(GetCmdChannel(i));
+      PsService_Stub rpc_stub(GetSparsePullChannel(i));
       closure->cntl(i)->set_log_id(butil::gettimeofday_ms());
       rpc_stub.service(
           closure->cntl(i), closure->request(i), closure->response(i), closure);
     }
   }
-  return fut;
+}
+
+std::shared_ptr<const BrpcPsClient::HotKeyRoutes>
+BrpcPsClient::GetHotKeyRoutes(size_t table_id) {
+  std::lock_guard<std::mutex> lock(_hot_key_routes_mutex);
+  auto iter = _hot_key_routes.find(table_id);
+  if (iter == _hot_key_routes.end() ||
+      iter->second->expire_ms <= butil::gettimeofday_ms()) {
+    return nullptr;
+  }
+  return iter->second;
+}
+
+int32_t BrpcPsClient::RebalanceHotKeys(size_t table_id) {
+  size_t server_num = _server_channels.size();
+  if (server_num < 2) {
+    return 0;
+  }
+  // The pulls each server served and its hottest keys since the last call.
+  std::vector<uint64_t> loads(server_num, 0);
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> hot(server_num);
+  DownpourBrpcClosure *closure = new DownpourBrpcClosure(
+      server_num, [server_num, &loads, &hot](void *done) {
+        int ret = 0;
+        ::paddle::framework::BinaryArchive ar;
+        auto *closure = reinterpret_cast<DownpourBrpcClosure *>(done);
+        for (size_t i = 0; i < server_num; ++i) {
+          if (closure->check_response(i, PS_GET_HOT_KEYS) != 0) {
+            ret = -1;
+            break;
+          }
+          std::string resp = closure->get_response(i, PS_GET_HOT_KEYS);
+          ar.SetReadBuffer(
+              const_cast<char *>(resp.c_str()), resp.length(), nullptr);
+          loads[i] = ar.Get<uint64_t>();
+          uint64_t hot_num = ar.Get<uint64_t>();
+          hot[i].resize(hot_num);
+          for (auto &item : hot[i]) {
+            item.first = ar.Get<uint64_t>();
+            item.second = ar.Get<uint64_t>();
+          }
+        }
+        closure->set_promise_value(ret);
+      });
+  auto promise = std::make_shared<std::promise<int32_t>>();
+  closure->add_promise(promise);
+  std::future<int> fut = promise->get_future();
+  for (size_t i = 0; i < server_num; ++i) {
+    closure->request(i)->set_cmd_id(PS_GET_HOT_KEYS);
+    closure->request(i)->set_table_id(table_id);
+    closure->request(i)->set_client_id(_client_id);
+    PsService_Stub rpc_stub(GetCmdChannel(i));
+    rpc_stub.service(
+        closure->cntl(i), closure->request(i), closure->response(i), closure);
+  }
+  if (fut.get() != 0) {
+    LOG(WARNING) << "get hot keys of table " << table_id << " failed";
+    return -1;
+  }
+
+  uint64_t total = 0;
+  for (auto load : loads) {
+    total += load;
+  }
+  double bound = static_cast<double>(total) / server_num *
+                 FLAGS_pserver_hot_key_imbalance_ratio;
+  std::unordered_map<uint64_t, uint32_t> servers;
+  auto old_routes = GetHotKeyRoutes(table_id);
+  if (old_routes != nullptr) {
+    // The keys routed to servers now overloaded go back to their owners.
+    for (auto &item : old_routes->servers) {
+      if (loads[item.second] <= bound) {
+        servers.insert(item);
+      }
+    }
+  }
+  // Routes the hottest keys of the overloaded servers, one by one, to the
+  // least loaded server, as long as it stays less loaded.
+  for (size_t s = 0; s < server_num; ++s) {
+    if (loads[s] <= bound) {
+      continue;
+    }
+    for (auto &item : hot[s]) {
+      if (loads[s] <= total / server_num) {
+        break;
+      }
+      if (servers.count(item.first) > 0) {
+        continue;
+      }
+      size_t target = std::min_element(loads.begin(), loads.end()) -
+                      loads.begin();
+      if (loads[target] + item.second >= loads[s] - item.second) {
+        break;
+      }
+      servers[item.first] = target;
+      loads[s] -= item.second;
+      loads[target] += item.second;
+    }
+  }
+  VLOG(1) << "table " << table_id << ": " << servers.size()
+          << " hot keys routed out of their servers";
+
+  auto routes = std::make_shared<HotKeyRoutes>();
+  routes->expire_ms =
+      butil::gettimeofday_ms() + FLAGS_pserver_hot_replica_ttl_ms / 2;
+  if (!servers.empty()) {
+    // Pulls the values of the keys from their owners and sends them to the
+    // servers the keys are routed to, before routing the pulls there.
+    std::vector<uint64_t> keys;
+    keys.reserve(servers.size());
+    for (auto &item : servers) {
+      keys.push_back(item.first);
+    }
+    auto *accessor = GetTableAccessor(table_id);
+    size_t select_size = accessor->GetAccessorInfo().select_size;
+    size_t select_dim = select_size / sizeof(float);
+    std::vector<float> values(keys.size() * select_dim);
+    std::vector<float *> value_ptrs(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      value_ptrs[i] = values.data() + i * select_dim;
+    }
+    auto pull_promise = std::make_shared<std::promise<int32_t>>();
+    std::future<int> pull_fut = pull_promise->get_future();
+    SendPullSparse(value_ptrs.data(),
+                   table_id,
+                   keys.data(),
+                   keys.size(),
+                   false,
+                   {pull_promise},
+                   false);
+    if (pull_fut.get() != 0) {
+      LOG(WARNING) << "pull hot keys of table " << table_id << " failed";
+      return -1;
+    }
+
+    std::vector<std::string> replica_data(server_num);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      replica_data[servers[keys[i]]].append(
+          reinterpret_cast<const char *>(&keys[i]), sizeof(uint64_t));
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      replica_data[servers[keys[i]]].append(
+          reinterpret_cast<const char *>(value_ptrs[i]), select_size);
+    }
+    int64_t ttl_ms = FLAGS_pserver_hot_replica_ttl_ms;
+    DownpourBrpcClosure *replica_closure =
+        new DownpourBrpcClosure(server_num, [server_num](void *done) {
+          int ret = 0;
+          auto *closure = reinterpret_cast<DownpourBrpcClosure *>(done);
+          for (size_t i = 0; i < server_num; ++i) {
+            if (closure->check_response(i, PS_UPDATE_HOT_REPLICA) != 0) {
+              ret = -1;
+              break;
+            }
+          }
+          closure->set_promise_value(ret);
+        });
+    auto replica_promise = std::make_shared<std::promise<int32_t>>();
+    replica_closure->add_promise(replica_promise);
+    std::future<int> replica_fut = replica_promise->get_future();
+    for (size_t i = 0; i < server_num; ++i) {
+      auto *request = replica_closure->request(i);
+      request->set_cmd_id(PS_UPDATE_HOT_REPLICA);
+      request->set_table_id(table_id);
+      request->set_client_id(_client_id);
+      request->add_params(reinterpret_cast<char *>(&ttl_ms), sizeof(int64_t));
+      request->set_data(replica_data[i]);
+      PsService_Stub rpc_stub(GetCmdChannel(i));
+      rpc_stub.service(replica_closure->cntl(i),
+                       request,
+                       replica_closure->response(i),
+                       replica_closure);
+    }
+    if (replica_fut.get() != 0) {
+      LOG(WARNING) << "update hot replica of table " << table_id
+                   << " failed";
+      return -1;
+    }
+    routes->servers = std::move(servers);
+  }
+  std::lock_guard<std::mutex> lock(_hot_key_routes_mutex);
+  _hot_key_routes[table_id] = routes;
+  return 0;
+}
+
+void BrpcPsClient::RebalanceHotKeysThread() {
+  const auto &worker_param = _config.worker_param().downpour_worker_param();
+  int64_t next_ms = butil::gettimeofday_ms() +
+                    FLAGS_pserver_hot_key_rebalance_interval_s * 1000;
+  while (_running) {
+    if (butil::gettimeofday_ms() < next_ms) {
+      usleep(100000);
+      continue;
+    }
+    next_ms += FLAGS_pserver_hot_key_rebalance_interval_s * 1000;
+    for (int i = 0; i < worker_param.downpour_table_param_size(); ++i) {
+      if (worker_param.downpour_table_param(i).type() == PS_SPARSE_TABLE) {
+        RebalanceHotKeys(worker_param.downpour_table_param(i).table_id());
+      }
+    }
+  }
 }
 
 // for GEO
@@ -1368,7 +1694,7 @@ std::future<int32_t> BrpcPsClient::PullSparseParam(float **select_values,
       closure->request(i)->set_client_id(_client_id);
       closure->request(i)->add_params((char *)&kv_request_count,  // NOLINT
                                       sizeof(uint32_t));
-      PsService_Stub rpc_stub(GetCmdChannel(i));
+      PsService_Stub rpc_stub(GetSparsePullChannel(i));
       closure->cntl(i)->set_log_id(butil::gettimeofday_ms());
       rpc_stub.service(
           closure->cntl(i), closure->request(i), closure->response(i), closure);
@@ -1440,6 +1766,45 @@ std::future<int32_t> BrpcPsClient::PushSparseRawGradientPartial(
   return fut;
 }
 
+std::future<int32_t> BrpcPsClient::PushSparseEncodedGradientPartial(
+    size_t table_id,
+    const uint64_t *keys,
+    const char *encoded_values,
+    uint32_t num,
+    GeoDeltaCompress compress,
+    void *done,
+    int pserver_idx) {
+  auto *accessor = GetTableAccessor(table_id);
+  size_t dim = accessor->GetAccessorInfo().update_size / sizeof(float);
+  size_t row_bytes = GeoDeltaRowBytes(compress, dim);
+  DownpourBrpcClosure *closure = reinterpret_cast<DownpourBrpcClosure *>(done);
+  auto promise = std::make_shared<std::promise<int32_t>>();
+  closure->add_promise(promise);
+  std::future<int> fut = promise->get_future();
+
+  auto *push_request = closure->request(0);
+  push_request->set_cmd_id(PS_PUSH_SPARSE_TABLE);
+  push_request->set_table_id(table_id);
+  push_request->set_client_id(_client_id);
+  push_request->add_params((char *)&num, sizeof(uint32_t));  // NOLINT
+  uint32_t compress_type = static_cast<uint32_t>(compress);
+  push_request->add_params((char *)&compress_type,  // NOLINT
+                           sizeof(uint32_t));
+  auto *push_data = push_request->mutable_data();
+  push_data->resize(num * (sizeof(uint64_t) + row_bytes));
+  char *push_data_ptr = const_cast<char *>(push_data->data());
+  memcpy(push_data_ptr, keys, num * sizeof(uint64_t));
+  memcpy(push_data_ptr + num * sizeof(uint64_t),
+         encoded_values,
+         num * row_bytes);
+  PsService_Stub rpc_stub(GetSparseChannel(pserver_idx));
+  closure->cntl(0)->set_request_compress_type(
+      (brpc::CompressType)FLAGS_pserver_communicate_compress_type);
+  rpc_stub.service(
+      closure->cntl(0), closure->request(0), closure->response(0), closure);
+  return fut;
+}
+
 int32_t BrpcPsClient::RecvAndSaveTable(const uint64_t table_id,
                                        const std::string &path) {
   // get var information
@@ -16,8 +16,13 @@
 
 #include <ThreadPool.h>
 
+#include <condition_variable>  // NOLINT
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "brpc/channel.h"
@@ -212,6 +217,9 @@ class BrpcPsClient : public PSClient {
     if (_async_push_sparse_thread.joinable()) {
       _async_push_sparse_thread.join();
     }
+    if (_hot_key_rebalance_thread.joinable()) {
+      _hot_key_rebalance_thread.join();
+    }
     if (_server_started) {
       _server.Stop(1000);
       _server.Join();
@@ -316,6 +324,17 @@ class BrpcPsClient : public PSClient {
   void PrintQueueSize();
   void PrintQueueSizeThread();
 
+  // Routes the pulls of the hottest keys of the servers that serve many more
+  // pulls of the table than the average to the least loaded servers, which
+  // serve them from a replica of their values refreshed at each call. The
+  // pushes still go to the servers owning the keys, so the values pulled
+  // from a replica are up to a call old. Returns 0, or -1 when a request
+  // failed, the previous routes being kept then.
+  int32_t RebalanceHotKeys(size_t table_id);
+  // Calls RebalanceHotKeys for the sparse tables every
+  // FLAGS_pserver_hot_key_rebalance_interval_s seconds.
+  void RebalanceHotKeysThread();
+
  protected:
   virtual size_t GetServerNums() { return _server_channels.size(); }
   inline brpc::Channel *GetSparseChannel(size_t server_id) {
@@ -327,6 +346,11 @@ class BrpcPsClient : public PSClient {
   inline brpc::Channel *GetCmdChannel(size_t server_id) {
     return _server_channels[server_id][2].get();
   }
+  // The sparse pulls go with the other commands over tcp, or with the data
+  // over rdma.
+  inline brpc::Channel *GetSparsePullChannel(size_t server_id) {
+    return _use_rdma ? GetSparseChannel(server_id) : GetCmdChannel(server_id);
+  }
   int32_t Initialize() override;
 
   // for fl
@@ -351,8 +375,45 @@ class BrpcPsClient : public PSClient {
                                    int cmd_id,
                                    const std::vector<std::string> &param);
 
+  // Sends one pull per server for the keys, duplicated ones being pulled
+  // once, and fulfills the promises once all the values are copied.
+  // The pulls of the hot keys go to the servers RebalanceHotKeys routed
+  // them to, unless use_hot_key_routes is false.
+  void SendPullSparse(
+      float **select_values,
+      size_t table_id,
+      const uint64_t *keys,
+      size_t num,
+      bool is_training,
+      const std::vector<std::shared_ptr<std::promise<int32_t>>> &promises,
+      bool use_hot_key_routes = true);
+
+  // Queues the pull to be merged with the ones other threads issue on the
+  // same table within FLAGS_pserver_pull_sparse_coalesce_window_us, the
+  // first of them sending the merged pull at the end of the window, or
+  // earlier once it has FLAGS_pserver_pull_sparse_coalesce_max_keys keys or
+  // the client is flushed.
+  std::future<int32_t> CoalescePullSparse(float **select_values,
+                                          size_t table_id,
+                                          const uint64_t *keys,
+                                          size_t num,
+                                          bool is_training);
+
+  struct PendingSparsePull {
+    std::vector<uint64_t> keys;
+    std::vector<float *> select_values;
+    std::vector<std::shared_ptr<std::promise<int32_t>>> promises;
+    // Whether to send it before the end of the window.
+    bool release = false;
+  };
+  std::mutex _pending_pull_mutex;
+  std::condition_variable _pending_pull_cv;
+  // By table id and is_training.
+  std::map<std::pair<size_t, bool>, PendingSparsePull> _pending_pulls;
+
   bool _running = false;
   bool _flushing = false;
+  bool _use_rdma = false;
   std::atomic<uint32_t> _async_call_num;  // 异步请求计数
 
   // 异步push dense task
@@ -369,6 +430,18 @@ class BrpcPsClient : public PSClient {
 
   std::thread _print_thread;
 
+  // The servers the pulls of the hot keys of a table go to, until
+  // expire_ms, half the time the servers keep their replica.
+  struct HotKeyRoutes {
+    std::unordered_map<uint64_t, uint32_t> servers;
+    int64_t expire_ms;
+  };
+  std::shared_ptr<const HotKeyRoutes> GetHotKeyRoutes(size_t table_id);
+  std::mutex _hot_key_routes_mutex;
+  std::unordered_map<size_t, std::shared_ptr<const HotKeyRoutes>>
+      _hot_key_routes;
+  std::thread _hot_key_rebalance_thread;
+
   int PushSparseAsyncShardMerge(
       std::vector<std::shared_ptr<SparseAsyncTask>> &task_list,  // NOLINT
       std::vector<int> &request_kv_num,                          // NOLINT
@@ -410,6 +483,15 @@ class BrpcPsClient : public PSClient {
                                                     void *done,
                                                     int pserver_idx) override;
 
+  std::future<int32_t> PushSparseEncodedGradientPartial(
+      size_t table_id,
+      const uint64_t *keys,
+      const char *encoded_values,
+      uint32_t num,
+      GeoDeltaCompress compress,
+      void *done,
+      int pserver_idx) override;
+
   std::future<int32_t> PushSparseParam(size_t table_id,
                                        const uint64_t *keys,
                                        const float **update_values,
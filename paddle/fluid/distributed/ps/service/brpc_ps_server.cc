@@ -18,6 +18,7 @@
 
 #include "butil/object_pool.h"
 #include "paddle/fluid/distributed/common/cost_timer.h"
+#include "paddle/fluid/distributed/ps/service/geo_delta_codec.h"
 #include "paddle/fluid/distributed/ps/table/depends/sparse_utils.h"
 #include "paddle/fluid/distributed/ps/table/table.h"
 #include "paddle/fluid/framework/archive.h"
@@ -79,6 +80,12 @@ uint64_t BrpcPsServer::Start(const std::string &ip, uint32_t port) {
   int num_threads = std::thread::hardware_concurrency();
   auto trainers = _environment->GetTrainers();
   options.num_threads = trainers > num_threads ? trainers : num_threads;
+#ifdef PADDLE_WITH_BRPC_RDMA
+  // Still accepts the tcp connections of the command channels.
+  options.use_rdma = UseRdmaTransport();
+#else
+  UseRdmaTransport();
+#endif
 
   if (_server.Start(ip_port.c_str(), &options) != 0) {
     VLOG(0) << "BrpcPsServer start failed, ip_port= " << ip_port
@@ -222,6 +229,10 @@ int32_t BrpcPsService::Initialize() {
   _service_handler_map[PS_CHECK_SAVE_PRE_PATCH_DONE] =
       &BrpcPsService::CheckSavePrePatchDone;
 
+  _service_handler_map[PS_GET_HOT_KEYS] = &BrpcPsService::GetHotKeys;
+  _service_handler_map[PS_UPDATE_HOT_REPLICA] =
+      &BrpcPsService::UpdateHotReplica;
+
   auto &profiler = CostProfiler::instance();
   profiler.register_profiler("pserver_server_pull_dense");
   profiler.register_profiler("pserver_server_push_dense");
@@ -578,12 +589,36 @@ int32_t BrpcPsService::PushSparse(Table *table,
   Push Content:
   |---keysData---|---valuesData---|
   |---8*{num}B---|----------------|
+  The values are encoded by the GeoDeltaCompress of params(1) if any.
   */
+  const float *values =
+      (const float *)(push_data.data() + sizeof(uint64_t) * num);
+  std::vector<float> decoded_values;
+  if (request.params_size() > 1) {
+    auto compress = static_cast<GeoDeltaCompress>(
+        *(reinterpret_cast<const uint32_t *>(request.params(1).c_str())));
+    size_t dim = table->GetValueAccessor()->GetAccessorInfo().update_size /
+                 sizeof(float);
+    size_t row_bytes = GeoDeltaRowBytes(compress, dim);
+    if (push_data.size() != num * (sizeof(uint64_t) + row_bytes)) {
+      set_response_code(
+          response, -1, "PushSparse encoded data size doesn't match");
+      return 0;
+    }
+    decoded_values.resize(num * dim);
+    const char *encoded = push_data.data() + sizeof(uint64_t) * num;
+    for (uint32_t i = 0; i < num; ++i) {
+      DecodeGeoDeltaRow(compress,
+                        encoded + i * row_bytes,
+                        dim,
+                        decoded_values.data() + i * dim);
+    }
+    values = decoded_values.data();
+  }
   TableContext table_context;
   table_context.value_type = Sparse;
   table_context.push_context.keys = (const uint64_t *)push_data.data();
-  table_context.push_context.values =
-      (const float *)(push_data.data() + sizeof(uint64_t) * num);
+  table_context.push_context.values = values;
   table_context.num = num;
   // const uint64_t *keys = (const uint64_t *)push_data.data();
   // const float *values = (const float *)(push_data.data() + sizeof(uint64_t) *
@@ -609,6 +644,53 @@ int32_t BrpcPsService::PrintTableStat(Table *table,
   return 0;
 }
 
+int32_t BrpcPsService::GetHotKeys(Table *table,
+                                  const PsRequestMessage &request,
+                                  PsResponseMessage &response,
+                                  brpc::Controller *cntl) {
+  CHECK_TABLE_EXIST(table, request, response)
+  std::vector<std::pair<uint64_t, uint64_t>> hot;
+  uint64_t accesses = table->GetHotKeys(&hot);
+  ::paddle::framework::BinaryArchive ar;
+  ar << accesses << static_cast<uint64_t>(hot.size());
+  for (auto &item : hot) {
+    ar << item.first << item.second;
+  }
+  response.set_data(std::string(ar.Buffer(), ar.Length()));
+  return 0;
+}
+
+int32_t BrpcPsService::UpdateHotReplica(Table *table,
+                                        const PsRequestMessage &request,
+                                        PsResponseMessage &response,
+                                        brpc::Controller *cntl) {
+  CHECK_TABLE_EXIST(table, request, response)
+  if (request.params_size() < 1) {
+    set_response_code(response,
+                      -1,
+                      "PsRequestMessage.params is required at "
+                      "least 1 for the ttl of the replica");
+    return 0;
+  }
+  const int64_t ttl_ms =
+      *(reinterpret_cast<const int64_t *>(request.params(0).c_str()));
+  auto &data = request.data();
+  size_t select_size =
+      table->GetValueAccessor()->GetAccessorInfo().select_size;
+  size_t num = data.size() / (sizeof(uint64_t) + select_size);
+  if (num * (sizeof(uint64_t) + select_size) != data.size()) {
+    set_response_code(response, -1, "hot replica data is not in format");
+    return 0;
+  }
+  const uint64_t *keys = reinterpret_cast<const uint64_t *>(data.data());
+  const float *values =
+      reinterpret_cast<const float *>(data.data() + num * sizeof(uint64_t));
+  if (table->UpdateHotReplica(keys, values, num, ttl_ms) != 0) {
+    set_response_code(response, -1, "table has no hot replica");
+  }
+  return 0;
+}
+
 int32_t BrpcPsService::LoadOneTable(Table *table,
                                     const PsRequestMessage &request,
                                     PsResponseMessage &response,
@@ -17,8 +17,19 @@ limitations under the License. */
 #include <arpa/inet.h>
 #include <netdb.h>
 
+#include <mutex>
+
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/platform/enforce.h"
+#ifdef PADDLE_WITH_BRPC_RDMA
+#include "brpc/rdma/rdma_helper.h"
+#endif
+
+PD_DEFINE_bool(pserver_use_rdma,
+               false,
+               "send the sparse and dense data between workers and servers "
+               "over rdma, needs a build with WITH_BRPC_RDMA");
 
 namespace paddle::framework {
 class Variable;
@@ -340,4 +351,25 @@ std::string GetIntTypeEndpoint(const std::string& ip, const uint32_t& port) {
   return int_ip_port;
 }
 
+bool UseRdmaTransport() {
+  if (!FLAGS_pserver_use_rdma) {
+    return false;
+  }
+#ifdef PADDLE_WITH_BRPC_RDMA
+  static std::once_flag init_flag;
+  std::call_once(init_flag, [] {
+    brpc::rdma::GlobalRdmaInitializeOrDie();
+    VLOG(0) << "pserver data channels use rdma";
+  });
+  return true;
+#else
+  static std::once_flag warn_flag;
+  std::call_once(warn_flag, [] {
+    LOG(WARNING) << "FLAGS_pserver_use_rdma is ignored, paddle is not built "
+                    "WITH_BRPC_RDMA";
+  });
+  return false;
+#endif
+}
+
 }  // namespace paddle::distributed
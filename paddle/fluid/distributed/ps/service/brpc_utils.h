@@ -94,5 +94,11 @@ void DeserializeSelectedRows(framework::Variable* var,
 
 std::string GetIntTypeEndpoint(const std::string& ip, const uint32_t& port);
 
+// Whether the sparse and dense data channels between the workers and the
+// servers go over the rdma transport of brpc, as FLAGS_pserver_use_rdma asks,
+// which needs a build WITH_BRPC_RDMA. The command channels stay on tcp.
+// Initializes rdma the first time it returns true.
+bool UseRdmaTransport();
+
 }  // namespace distributed
 }  // namespace paddle
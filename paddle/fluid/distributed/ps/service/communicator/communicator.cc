@@ -26,6 +26,22 @@ limitations under the License. */
 #define LEARNING_RATE_DECAY_COUNTER "@LR_DECAY_COUNTER@"
 #define STEP_COUNTER "@PS_STEP_COUNTER@"
 
+PD_DEFINE_int64(pserver_worker_cache_capacity,
+                0,
+                "keys of each sparse table whose embeddings a worker caches, "
+                "0 to pull every key from the servers");
+PD_DEFINE_int64(pserver_worker_cache_max_stale_steps,
+                10,
+                "pulls of a table for which a cached embedding is served, "
+                "<= 0 for no bound");
+PD_DEFINE_int64(pserver_worker_cache_max_stale_ms,
+                0,
+                "ms for which a cached embedding is served, <= 0 for no bound");
+PD_DEFINE_int32(pserver_worker_cache_stat_interval,
+                1000,
+                "pulls of a table between two logs of its cache stats, 0 for "
+                "none");
+
 namespace paddle {
 namespace distributed {
 
@@ -651,6 +667,19 @@ void AsyncCommunicator::PullSparseToTensorSync(
       pull_result_ptr.push_back(output_data + output_len);
     }
   }
+  auto *cache = GetSparseCache(table_id, fea_dim);
+  if (cache != nullptr) {
+    // Only pulls the keys missing from the cache or too stale.
+    std::vector<size_t> missed;
+    cache->Lookup(
+        fea_keys.data(), fea_keys.size(), pull_result_ptr.data(), &missed);
+    for (size_t i = 0; i < missed.size(); ++i) {
+      fea_keys[i] = fea_keys[missed[i]];
+      pull_result_ptr[i] = pull_result_ptr[missed[i]];
+    }
+    fea_keys.resize(missed.size());
+    pull_result_ptr.resize(missed.size());
+  }
   auto status = _worker_ptr->PullSparse(pull_result_ptr.data(),
                                         table_id,
                                         fea_keys.data(),
@@ -661,9 +690,35 @@ void AsyncCommunicator::PullSparseToTensorSync(
   if (ret != 0) {
     LOG(ERROR) << "fleet pull sparse failed, status[" << ret << "]";
     sleep(sleep_seconds_before_fail_exit_);
+  } else if (cache != nullptr) {
+    cache->Insert(fea_keys.data(), fea_keys.size(), pull_result_ptr.data());
   }
 }
 
+SparseEmbeddingCache *AsyncCommunicator::GetSparseCache(uint64_t table_id,
+                                                        int fea_dim) {
+  if (FLAGS_pserver_worker_cache_capacity <= 0) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(sparse_caches_mutex_);
+  auto &cache = sparse_caches_[table_id];
+  if (!cache) {
+    cache = std::make_unique<SparseEmbeddingCache>(
+        FLAGS_pserver_worker_cache_capacity,
+        fea_dim,
+        FLAGS_pserver_worker_cache_max_stale_steps,
+        FLAGS_pserver_worker_cache_max_stale_ms);
+  }
+  if (FLAGS_pserver_worker_cache_stat_interval > 0) {
+    auto &pulls = sparse_cache_pulls_[table_id];
+    if (++pulls % FLAGS_pserver_worker_cache_stat_interval == 0) {
+      VLOG(0) << "worker cache of sparse table " << table_id << " "
+              << cache->StatString();
+    }
+  }
+  return cache.get();
+}
+
 void AsyncCommunicator::PushSparseFromTensorAsync(
     const uint64_t table_id,
     int fea_dim,
@@ -1410,6 +1465,14 @@ void GeoCommunicator::SendSparse(const std::string &varname,
   auto blas = phi::funcs::GetBlas<phi::CPUContext, float>(cpu_ctx);
   float coefficient = 1.0 / static_cast<float>(trainers_);
 
+  // The encoded rows when the deltas are compressed.
+  size_t row_bytes = GeoDeltaRowBytes(geo_delta_compress_, dims1);
+  std::vector<char> encoded_values;
+  if (geo_delta_compress_ != GeoDeltaCompress::kNone) {
+    encoded_values.resize(sparse_ids.size() * row_bytes);
+  }
+
+  std::vector<uint64_t> push_ids;
   std::vector<float *> push_g_vec;
   for (auto j = 0; j < static_cast<int>(sparse_ids.size()); ++j) {
     blas.VSUB(dims1,
@@ -1417,15 +1480,37 @@ void GeoCommunicator::SendSparse(const std::string &varname,
               t_old->data<float>() + sparse_ids[j] * dims1,
               t_value + j * dims1);
     blas.SCAL(dims1, coefficient, t_value + j * dims1);
+    if (geo_delta_threshold_ > 0.0f) {
+      float norm = 0.0f;
+      for (auto k = 0; k < dims1; ++k) {
+        norm += t_value[j * dims1 + k] * t_value[j * dims1 + k];
+      }
+      // old is not moved, so the delta accumulates until it is large enough
+      if (std::sqrt(norm) < geo_delta_threshold_) {
+        continue;
+      }
+    }
+    if (geo_delta_compress_ != GeoDeltaCompress::kNone) {
+      // old only moves by the decoded delta, the error is sent later
+      EncodeGeoDeltaRow(geo_delta_compress_,
+                        t_value + j * dims1,
+                        dims1,
+                        encoded_values.data() + push_ids.size() * row_bytes,
+                        t_value + j * dims1);
+    }
     blas.VADD(dims1,
               t_old->data<float>() + sparse_ids[j] * dims1,
               t_value + j * dims1,
               t_old->data<float>() + sparse_ids[j] * dims1);
+    push_ids.push_back(static_cast<uint64_t>(sparse_ids[j]));
     push_g_vec.push_back(t_value + j * dims1);
 
     VLOG(5) << "DEBUG GeoCommunicator::SendSparse send sparse key "
-            << sparse_ids[j] << " value[0] " << push_g_vec[j][0]
-            << " value[-1] " << push_g_vec[j][dims1 - 1];
+            << sparse_ids[j] << " value[0] " << push_g_vec.back()[0]
+            << " value[-1] " << push_g_vec.back()[dims1 - 1];
+  }
+  if (push_ids.empty()) {
+    return;
   }
 
   ++_async_call_num;
@@ -1438,17 +1523,29 @@ void GeoCommunicator::SendSparse(const std::string &varname,
     closure->set_promise_value(ret);
     --_async_call_num;
   });
-  auto status = _worker_ptr->PushSparseRawGradientPartial(
-      table_id,
-      (const uint64_t *)sparse_ids.data(),
-      (const float **)push_g_vec.data(),
-      sparse_ids.size(),
-      closure,
-      ep_idx);
+  std::future<int32_t> status;
+  if (geo_delta_compress_ != GeoDeltaCompress::kNone) {
+    status = _worker_ptr->PushSparseEncodedGradientPartial(
+        table_id,
+        push_ids.data(),
+        encoded_values.data(),
+        push_ids.size(),
+        geo_delta_compress_,
+        closure,
+        ep_idx);
+  } else {
+    status = _worker_ptr->PushSparseRawGradientPartial(
+        table_id,
+        push_ids.data(),
+        (const float **)push_g_vec.data(),
+        push_ids.size(),
+        closure,
+        ep_idx);
+  }
   status.wait();
 
   VLOG(1) << "Finish Send Sparse " << varname
-          << ", ids.size = " << sparse_ids.size() << ", table_id: " << table_id;
+          << ", ids.size = " << push_ids.size() << ", table_id: " << table_id;
   return;
 }
 
@@ -31,6 +31,7 @@ limitations under the License. */
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/ps/service/communicator/communicator_common.h"
+#include "paddle/fluid/distributed/ps/service/communicator/sparse_embedding_cache.h"
 #include "paddle/fluid/distributed/ps/service/coordinator_client.h"
 #include "paddle/fluid/distributed/ps/service/ps_client.h"
 #include "paddle/fluid/framework/channel.h"
@@ -496,6 +497,15 @@ class AsyncCommunicator : public Communicator {
                                  std::vector<phi::DenseTensor *> *outputs);
 
  protected:
+  // The worker side cache of the table, nullptr when
+  // FLAGS_pserver_worker_cache_capacity is 0.
+  SparseEmbeddingCache *GetSparseCache(uint64_t table_id, int fea_dim);
+
+  std::mutex sparse_caches_mutex_;
+  std::unordered_map<uint64_t, std::unique_ptr<SparseEmbeddingCache>>
+      sparse_caches_;
+  std::unordered_map<uint64_t, uint64_t> sparse_cache_pulls_;
+
   std::unordered_map<std::string,
                      std::shared_ptr<BlockingQueue<std::shared_ptr<Variable>>>>
       send_varname_to_queue_;
@@ -623,6 +633,14 @@ class GeoCommunicator : public AsyncCommunicator {
     // id_queue's size
     max_merge_var_num_ = std::stoi(envs.at("communicator_max_merge_var_num"));
     send_queue_size_ = max_merge_var_num_;
+    if (envs.count("communicator_geo_delta_compress") > 0) {
+      geo_delta_compress_ =
+          ParseGeoDeltaCompress(envs.at("communicator_geo_delta_compress"));
+    }
+    if (envs.count("communicator_geo_delta_threshold") > 0) {
+      geo_delta_threshold_ =
+          std::stof(envs.at("communicator_geo_delta_threshold"));
+    }
     VLOG(1) << "GeoCommunicator Initialized";
   }
 
@@ -661,6 +679,11 @@ class GeoCommunicator : public AsyncCommunicator {
       std::string,
       ::paddle::framework::Channel<std::shared_ptr<std::vector<int64_t>>>>
       sparse_id_queues_;
+
+  // The encoding of the sparse deltas, and the L2 norm below which the delta
+  // of a row is kept for a later push instead of sent.
+  GeoDeltaCompress geo_delta_compress_ = GeoDeltaCompress::kNone;
+  float geo_delta_threshold_ = 0.0f;
 };
 
 class FLCommunicator : public GeoCommunicator {
@@ -0,0 +1,138 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/service/communicator/sparse_embedding_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+
+namespace paddle {
+namespace distributed {
+
+namespace {
+
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+SparseEmbeddingCache::SparseEmbeddingCache(size_t capacity,
+                                           int dim,
+                                           int64_t max_stale_steps,
+                                           int64_t max_stale_ms)
+    : _capacity(capacity),
+      _dim(dim),
+      _max_stale_steps(max_stale_steps),
+      _max_stale_ms(max_stale_ms) {}
+
+bool SparseEmbeddingCache::IsFresh(const Entry& entry, int64_t now_ms) const {
+  if (_max_stale_steps > 0 && _step - entry.step > _max_stale_steps) {
+    return false;
+  }
+  if (_max_stale_ms > 0 && now_ms - entry.time_ms > _max_stale_ms) {
+    return false;
+  }
+  return true;
+}
+
+void SparseEmbeddingCache::Lookup(const uint64_t* keys,
+                                  size_t num,
+                                  float** values,
+                                  std::vector<size_t>* missed) {
+  int64_t now_ms = NowMs();
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++_step;
+  for (size_t i = 0; i < num; ++i) {
+    auto iter = _index.find(keys[i]);
+    if (iter == _index.end()) {
+      ++_stat.misses;
+      missed->push_back(i);
+      continue;
+    }
+    auto entry = iter->second;
+    if (!IsFresh(*entry, now_ms)) {
+      ++_stat.misses;
+      ++_stat.expired;
+      _lru.erase(entry);
+      _index.erase(iter);
+      missed->push_back(i);
+      continue;
+    }
+    ++_stat.hits;
+    _stat.hit_stale_steps += _step - entry->step;
+    _stat.hit_stale_ms += now_ms - entry->time_ms;
+    memcpy(values[i], entry->value.data(), sizeof(float) * _dim);
+    _lru.splice(_lru.begin(), _lru, entry);
+  }
+}
+
+void SparseEmbeddingCache::Insert(const uint64_t* keys,
+                                  size_t num,
+                                  float* const* values) {
+  if (_capacity == 0) {
+    return;
+  }
+  int64_t now_ms = NowMs();
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (size_t i = 0; i < num; ++i) {
+    auto iter = _index.find(keys[i]);
+    if (iter != _index.end()) {
+      _lru.splice(_lru.begin(), _lru, iter->second);
+    } else {
+      if (_index.size() >= _capacity) {
+        _index.erase(_lru.back().key);
+        // Reuses the value buffer of the evicted entry.
+        _lru.splice(_lru.begin(), _lru, std::prev(_lru.end()));
+        ++_stat.evicted;
+      } else {
+        _lru.emplace_front();
+        _lru.front().value.resize(_dim);
+      }
+      _lru.front().key = keys[i];
+      _index[keys[i]] = _lru.begin();
+    }
+    Entry& entry = _lru.front();
+    entry.step = _step;
+    entry.time_ms = now_ms;
+    memcpy(entry.value.data(), values[i], sizeof(float) * _dim);
+  }
+}
+
+SparseEmbeddingCache::Stat SparseEmbeddingCache::GetStat() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stat;
+}
+
+std::string SparseEmbeddingCache::StatString() {
+  Stat stat = GetStat();
+  uint64_t lookups = std::max<uint64_t>(stat.hits + stat.misses, 1);
+  uint64_t hits = std::max<uint64_t>(stat.hits, 1);
+  std::ostringstream out;
+  out << "hit_rate: " << static_cast<double>(stat.hits) / lookups
+      << " hits: " << stat.hits << " misses: " << stat.misses
+      << " expired: " << stat.expired << " evicted: " << stat.evicted
+      << " avg_hit_stale_steps: "
+      << static_cast<double>(stat.hit_stale_steps) / hits
+      << " avg_hit_stale_ms: " << static_cast<double>(stat.hit_stale_ms) / hits;
+  return out.str();
+}
+
+}  // namespace distributed
+}  // namespace paddle
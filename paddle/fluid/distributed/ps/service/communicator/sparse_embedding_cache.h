@@ -0,0 +1,91 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle {
+namespace distributed {
+
+// A worker side cache of the embeddings pulled from a sparse table, so that
+// the hot keys are not pulled from the servers at every step. A value is
+// served from the cache until max_stale_steps pulls of the table or
+// max_stale_ms milliseconds have passed since it was pulled, a bound <= 0
+// being no bound, and the least recently used values are dropped beyond
+// capacity keys.
+//
+// The gradients of the cached keys are all pushed as before, the cache only
+// bounds how stale the values the worker trains with are.
+class SparseEmbeddingCache {
+ public:
+  struct Stat {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    // Misses of keys cached for too long.
+    uint64_t expired{0};
+    // Values dropped beyond the capacity.
+    uint64_t evicted{0};
+    // Summed over the hits.
+    uint64_t hit_stale_steps{0};
+    uint64_t hit_stale_ms{0};
+  };
+
+  SparseEmbeddingCache(size_t capacity,
+                       int dim,
+                       int64_t max_stale_steps,
+                       int64_t max_stale_ms);
+
+  // Starts a pull of the table: copies the fresh cached values of the keys
+  // to values and appends the indices of the other keys to missed.
+  void Lookup(const uint64_t* keys,
+              size_t num,
+              float** values,
+              std::vector<size_t>* missed);
+  // Caches the values of the keys pulled from the servers.
+  void Insert(const uint64_t* keys, size_t num, float* const* values);
+
+  Stat GetStat();
+  std::string StatString();
+
+ private:
+  struct Entry {
+    uint64_t key;
+    int64_t step;
+    int64_t time_ms;
+    std::vector<float> value;
+  };
+
+  bool IsFresh(const Entry& entry, int64_t now_ms) const;
+
+  const size_t _capacity;
+  const int _dim;
+  const int64_t _max_stale_steps;
+  const int64_t _max_stale_ms;
+
+  std::mutex _mutex;
+  int64_t _step{0};
+  // From the most recently used.
+  std::list<Entry> _lru;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> _index;
+  Stat _stat;
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,138 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "paddle/common/enforce.h"
+#include "paddle/phi/common/float16.h"
+
+namespace paddle {
+namespace distributed {
+
+// The encoding of the sparse deltas the geo communicator pushes, sent with
+// the push so that the server decodes them before the table sees them.
+enum class GeoDeltaCompress : uint32_t {
+  kNone = 0,
+  // The values as float16.
+  kFp16 = 1,
+  // The scale of the row as float, then the values divided by the scale as
+  // int8.
+  kInt8 = 2,
+};
+
+inline GeoDeltaCompress ParseGeoDeltaCompress(const std::string &name) {
+  if (name.empty() || name == "none") {
+    return GeoDeltaCompress::kNone;
+  } else if (name == "fp16") {
+    return GeoDeltaCompress::kFp16;
+  } else if (name == "int8") {
+    return GeoDeltaCompress::kInt8;
+  }
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "The geo delta compression must be none, fp16 or int8, but received %s.",
+      name));
+}
+
+// The bytes of an encoded row of dim values.
+inline size_t GeoDeltaRowBytes(GeoDeltaCompress compress, size_t dim) {
+  switch (compress) {
+    case GeoDeltaCompress::kFp16:
+      return dim * sizeof(uint16_t);
+    case GeoDeltaCompress::kInt8:
+      return sizeof(float) + dim * sizeof(int8_t);
+    default:
+      return dim * sizeof(float);
+  }
+}
+
+// Encodes the row into out, and writes the values the server will decode
+// into decoded, so that the caller keeps the error of the encoding as a
+// residual for the next push. decoded may be values.
+inline void EncodeGeoDeltaRow(GeoDeltaCompress compress,
+                              const float *values,
+                              size_t dim,
+                              char *out,
+                              float *decoded) {
+  switch (compress) {
+    case GeoDeltaCompress::kFp16: {
+      for (size_t i = 0; i < dim; ++i) {
+        phi::dtype::float16 value(values[i]);
+        std::memcpy(out + i * sizeof(uint16_t), &value.x, sizeof(uint16_t));
+        decoded[i] = static_cast<float>(value);
+      }
+      break;
+    }
+    case GeoDeltaCompress::kInt8: {
+      float max_abs = 0.0f;
+      for (size_t i = 0; i < dim; ++i) {
+        max_abs = std::max(max_abs, std::fabs(values[i]));
+      }
+      float scale = max_abs / 127.0f;
+      std::memcpy(out, &scale, sizeof(float));
+      auto *quantized = reinterpret_cast<int8_t *>(out + sizeof(float));
+      for (size_t i = 0; i < dim; ++i) {
+        int8_t q = scale == 0.0f
+                       ? 0
+                       : static_cast<int8_t>(std::max(
+                             -127.0f,
+                             std::min(127.0f, std::round(values[i] / scale))));
+        quantized[i] = q;
+        decoded[i] = q * scale;
+      }
+      break;
+    }
+    default:
+      std::memcpy(out, values, dim * sizeof(float));
+      if (decoded != values) {
+        std::memcpy(decoded, values, dim * sizeof(float));
+      }
+  }
+}
+
+inline void DecodeGeoDeltaRow(GeoDeltaCompress compress,
+                              const char *in,
+                              size_t dim,
+                              float *values) {
+  switch (compress) {
+    case GeoDeltaCompress::kFp16: {
+      for (size_t i = 0; i < dim; ++i) {
+        phi::dtype::float16 value;
+        std::memcpy(&value.x, in + i * sizeof(uint16_t), sizeof(uint16_t));
+        values[i] = static_cast<float>(value);
+      }
+      break;
+    }
+    case GeoDeltaCompress::kInt8: {
+      float scale = 0.0f;
+      std::memcpy(&scale, in, sizeof(float));
+      const auto *quantized =
+          reinterpret_cast<const int8_t *>(in + sizeof(float));
+      for (size_t i = 0; i < dim; ++i) {
+        values[i] = quantized[i] * scale;
+      }
+      break;
+    }
+    default:
+      std::memcpy(values, in, dim * sizeof(float));
+  }
+}
+
+}  // namespace distributed
+}  // namespace paddle
@@ -23,6 +23,7 @@
 
 #include "paddle/fluid/distributed/common/cost_timer.h"
 #include "paddle/fluid/distributed/ps/service/env.h"
+#include "paddle/fluid/distributed/ps/service/geo_delta_codec.h"
 #include "paddle/fluid/distributed/ps/service/sendrecv.pb.h"
 #include "paddle/fluid/distributed/ps/service/sparse_shard_value.h"
 #include "paddle/fluid/distributed/ps/table/accessor.h"
@@ -280,6 +281,22 @@ class PSClient {
       void *done,
       int pserver_idx) = 0;
 
+  // Pushes num rows of deltas encoded by compress, GeoDeltaRowBytes each.
+  virtual std::future<int32_t> PushSparseEncodedGradientPartial(
+      size_t table_id UNUSED,
+      const uint64_t *keys UNUSED,
+      const char *encoded_values UNUSED,
+      uint32_t num UNUSED,
+      GeoDeltaCompress compress UNUSED,
+      void *done UNUSED,
+      int pserver_idx UNUSED) {
+    VLOG(0) << "Did not implement";
+    std::promise<int32_t> promise;
+    std::future<int> fut = promise.get_future();
+    promise.set_value(-1);
+    return fut;
+  }
+
   virtual std::future<int32_t> PushSparseParam(size_t table_id,
                                                const uint64_t *keys,
                                                const float **update_values,
@@ -2493,11 +2493,19 @@ int32_t GraphTable::load_nodes(const std::string &path,
 }
 
 int32_t GraphTable::build_sampler(int idx, std::string sample_type) {
-  for (auto &shard : edge_shards[idx]) {
-    auto bucket = shard->get_bucket();
-    for (auto item : bucket) {
-      item->build_sampler(sample_type);
-    }
+  std::vector<std::future<int>> tasks;
+  auto &shards = edge_shards[idx];
+  for (size_t i = 0; i < shards.size(); ++i) {
+    tasks.push_back(
+        _shards_task_pool[i % task_pool_size_]->enqueue([&, i]() -> int {
+          for (auto item : shards[i]->get_bucket()) {
+            item->build_sampler(sample_type);
+          }
+          return 0;
+        }));
+  }
+  for (auto &t : tasks) {
+    t.get();
   }
   return 0;
 }
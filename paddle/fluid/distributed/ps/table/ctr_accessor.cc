@@ -246,6 +246,9 @@ int32_t CtrCommonAccessor::Merge(float** update_values,
 int32_t CtrCommonAccessor::Update(float** update_values,
                                   const float** push_values,
                                   size_t num) {
+  // Read once rather than through the config of every value.
+  const float nonclk_coeff = _config.ctr_accessor_param().nonclk_coeff();
+  const float click_coeff = _config.ctr_accessor_param().click_coeff();
   for (size_t value_item = 0; value_item < num; ++value_item) {
     float* update_value = update_values[value_item];
     const float* push_value = push_values[value_item];
@@ -256,8 +259,7 @@ int32_t CtrCommonAccessor::Update(float** update_values,
     update_value[common_feature_value.ClickIndex()] += push_click;
     update_value[common_feature_value.SlotIndex()] = slot;
     update_value[common_feature_value.DeltaScoreIndex()] +=
-        (push_show - push_click) * _config.ctr_accessor_param().nonclk_coeff() +
-        push_click * _config.ctr_accessor_param().click_coeff();
+        (push_show - push_click) * nonclk_coeff + push_click * click_coeff;
     update_value[common_feature_value.UnseenDaysIndex()] = 0;
     // TODO(zhaocaibei123): add configure show_scale
     if (!_show_scale) {
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace distributed {
+
+// Estimates how often the keys of a shard were accessed recently, in a fixed
+// amount of memory, as the admission filter of TinyLFU does: kDepth rows of
+// saturating 8 bit counters, incremented conservatively, that is only the
+// smallest counters of the key, and all halved every width * 8 increments so
+// that the old accesses fade out. An estimate is never below the number of
+// accesses since the last halving.
+//
+// Not thread safe, a sketch is only touched by the thread owning its shard.
+class CountMinSketch {
+ public:
+  static constexpr size_t kDepth = 4;
+
+  explicit CountMinSketch(size_t width) {
+    _width = 64;
+    while (_width < width) {
+      _width <<= 1;
+    }
+    _counters.assign(_width * kDepth, 0);
+    _reset_period = _width * 8;
+  }
+
+  void Increment(uint64_t key) {
+    size_t index[kDepth];
+    uint8_t min_count = UINT8_MAX;
+    for (size_t row = 0; row < kDepth; ++row) {
+      index[row] = Index(key, row);
+      min_count = std::min(min_count, _counters[index[row]]);
+    }
+    if (min_count == UINT8_MAX) {
+      return;
+    }
+    for (size_t row = 0; row < kDepth; ++row) {
+      if (_counters[index[row]] == min_count) {
+        ++_counters[index[row]];
+      }
+    }
+    if (++_increments >= _reset_period) {
+      Halve();
+    }
+  }
+
+  uint32_t Estimate(uint64_t key) const {
+    uint8_t min_count = UINT8_MAX;
+    for (size_t row = 0; row < kDepth; ++row) {
+      min_count = std::min(min_count, _counters[Index(key, row)]);
+    }
+    return min_count;
+  }
+
+  void Clear() {
+    std::fill(_counters.begin(), _counters.end(), 0);
+    _increments = 0;
+  }
+
+  size_t width() const { return _width; }
+
+ private:
+  void Halve() {
+    for (auto& counter : _counters) {
+      counter >>= 1;
+    }
+    _increments /= 2;
+  }
+
+  size_t Index(uint64_t key, size_t row) const {
+    // The finalizer of murmur3, seeded per row.
+    uint64_t h = key + (row + 1) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return row * _width + (h & (_width - 1));
+  }
+
+  size_t _width;
+  size_t _reset_period;
+  size_t _increments{0};
+  std::vector<uint8_t> _counters;
+};
+
+}  // namespace distributed
+}  // namespace paddle
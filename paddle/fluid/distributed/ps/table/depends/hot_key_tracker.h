@@ -0,0 +1,93 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/distributed/ps/table/depends/count_min_sketch.h"
+
+namespace paddle {
+namespace distributed {
+
+// Finds the most accessed keys of a shard since the last report, as the
+// count-min sketch plus candidates heavy hitters do: the accesses of the
+// keys that are not candidates are counted in a CountMinSketch, and a key
+// whose estimate beats the coldest of the capacity candidates replaces it.
+// The accesses of a candidate are counted exactly from then on, so a cold
+// key only costs the update of the sketch.
+//
+// Not thread safe, a tracker is only touched by the thread owning its shard.
+class HotKeyTracker {
+ public:
+  explicit HotKeyTracker(size_t capacity)
+      : _capacity(std::max<size_t>(capacity, 1)), _sketch(_capacity * 64) {}
+
+  void Add(uint64_t key) {
+    ++_accesses;
+    auto iter = _candidates.find(key);
+    if (iter != _candidates.end()) {
+      ++iter->second;
+      return;
+    }
+    _sketch.Increment(key);
+    uint64_t count = _sketch.Estimate(key);
+    if (_candidates.size() < _capacity) {
+      _candidates.emplace(key, count);
+      return;
+    }
+    // _min_count is a lower bound of the accesses of the coldest candidate.
+    if (count <= _min_count) {
+      return;
+    }
+    auto coldest = _candidates.begin();
+    for (auto it = _candidates.begin(); it != _candidates.end(); ++it) {
+      if (it->second < coldest->second) {
+        coldest = it;
+      }
+    }
+    _min_count = coldest->second;
+    if (coldest->second < count) {
+      _candidates.erase(coldest);
+      _candidates.emplace(key, count);
+      _min_count = std::min(_min_count, count);
+    }
+  }
+
+  // Appends the candidates and their accesses to hot, and returns the
+  // accesses of the shard, both since the last report.
+  uint64_t Report(std::vector<std::pair<uint64_t, uint64_t>>* hot) {
+    hot->insert(hot->end(), _candidates.begin(), _candidates.end());
+    uint64_t accesses = _accesses;
+    _candidates.clear();
+    _sketch.Clear();
+    _min_count = 0;
+    _accesses = 0;
+    return accesses;
+  }
+
+ private:
+  size_t _capacity;
+  CountMinSketch _sketch;
+  std::unordered_map<uint64_t, uint64_t> _candidates;
+  uint64_t _min_count{0};
+  uint64_t _accesses{0};
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,525 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace distributed {
+
+// A sparse table shard with the values stored inline, and lock-free reads.
+//
+// The keys live in an open-addressed table of cache line sized buckets, each
+// holding a version and kBucketSlots keys with the indices of their values.
+// The values, of at most value_dim floats, live in slabs of geometrically
+// growing sizes, prefixed by their current size, and never move. Writes are
+// serialized by a mutex, and bump the version of the bucket of the key around
+// any change to it or to its value, so readers copy the value out and retry
+// if the version changed, without any lock.
+//
+// Growing the table rehashes the keys into a new one, leaving the values in
+// place. The buckets of the old table are left with odd versions, which sends
+// the readers still on it to the new one, and it is freed once they are done.
+template <class KEY>
+class InlineSparseTableShard {
+ public:
+  static constexpr size_t kBucketSlots = 5;
+
+  explicit InlineSparseTableShard(size_t value_dim)
+      : _value_dim(value_dim), _stride(value_dim + 1) {
+    for (auto& slab : _slabs) {
+      slab.store(nullptr, std::memory_order_relaxed);
+    }
+    _tables.emplace_back(new Table(kInitialBuckets));
+    _table.store(_tables.back().get(), std::memory_order_release);
+  }
+  InlineSparseTableShard(const InlineSparseTableShard&) = delete;
+  InlineSparseTableShard& operator=(const InlineSparseTableShard&) = delete;
+
+  size_t value_dim() const { return _value_dim; }
+  size_t size() const { return _size.load(std::memory_order_relaxed); }
+  bool empty() const { return size() == 0; }
+
+  // Copies the value of key into out, of at least value_dim floats, and
+  // returns its size, or -1 if key is missing. Lock-free.
+  int read(const KEY& key, float* out) const {
+    ReadGuard guard(this);
+    size_t hash = mix(key);
+    int ret = -1;
+    // Loaded after the guard is taken, see rehash.
+    while (!read_from(
+        _table.load(std::memory_order_seq_cst), key, hash, out, &ret)) {
+    }
+    return ret;
+  }
+
+  // Inserts key with the first size floats of data, unless it is present.
+  bool insert(const KEY& key, const float* data, size_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t hash = mix(key);
+    Bucket* bucket = nullptr;
+    size_t slot = 0;
+    if (locate(key, hash, &bucket, &slot)) {
+      return false;
+    }
+    uint32_t index = acquire_value();
+    store_value(index, data, size);
+    publish(key, hash, index);
+    return true;
+  }
+
+  // Inserts key or overwrites its value.
+  void assign(const KEY& key, const float* data, size_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t hash = mix(key);
+    Bucket* bucket = nullptr;
+    size_t slot = 0;
+    if (locate(key, hash, &bucket, &slot)) {
+      begin_write(bucket);
+      store_value(bucket->slots[slot].load(std::memory_order_relaxed),
+                  data,
+                  size);
+      end_write(bucket);
+      return;
+    }
+    uint32_t index = acquire_value();
+    store_value(index, data, size);
+    publish(key, hash, index);
+  }
+
+  // Calls fn(float* value, size_t* size) to update the value of key in place,
+  // fn may grow size up to value_dim. Returns false if key is missing.
+  template <class FN>
+  bool update(const KEY& key, FN&& fn) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Bucket* bucket = nullptr;
+    size_t slot = 0;
+    if (!locate(key, mix(key), &bucket, &slot)) {
+      return false;
+    }
+    begin_write(bucket);
+    update_value(bucket->slots[slot].load(std::memory_order_relaxed), fn);
+    end_write(bucket);
+    return true;
+  }
+
+  size_t erase(const KEY& key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Bucket* bucket = nullptr;
+    size_t slot = 0;
+    if (!locate(key, mix(key), &bucket, &slot)) {
+      return 0;
+    }
+    erase_slot(bucket, slot);
+    return 1;
+  }
+
+  // Calls fn(const KEY& key, float* value, size_t* size) on every key, which
+  // may update the value in place like update does.
+  template <class FN>
+  void for_each(FN&& fn) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Table* table = _table.load(std::memory_order_relaxed);
+    for (size_t i = 0; i <= table->mask; ++i) {
+      Bucket* bucket = &table->buckets[i];
+      for (size_t slot = 0; slot < kBucketSlots; ++slot) {
+        uint32_t index = bucket->slots[slot].load(std::memory_order_relaxed);
+        if (index >= kErased) {
+          continue;
+        }
+        KEY key = bucket->keys[slot].load(std::memory_order_relaxed);
+        begin_write(bucket);
+        update_value(index, [&](float* value, size_t* size) {
+          fn(key, value, size);
+        });
+        end_write(bucket);
+      }
+    }
+  }
+
+  // Erases the keys for which pred(float* value, size_t size) holds, and
+  // returns their number. pred may update the value in place.
+  template <class PRED>
+  size_t erase_if(PRED&& pred) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Table* table = _table.load(std::memory_order_relaxed);
+    size_t erased = 0;
+    for (size_t i = 0; i <= table->mask; ++i) {
+      Bucket* bucket = &table->buckets[i];
+      for (size_t slot = 0; slot < kBucketSlots; ++slot) {
+        uint32_t index = bucket->slots[slot].load(std::memory_order_relaxed);
+        if (index >= kErased) {
+          continue;
+        }
+        begin_write(bucket);
+        bool erase = pred(value_data(index), value_size(index));
+        end_write(bucket);
+        if (erase) {
+          erase_slot(bucket, slot);
+          ++erased;
+        }
+      }
+    }
+    return erased;
+  }
+
+  // Not to be called concurrently with any other method.
+  void clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tables.clear();
+    _tables.emplace_back(new Table(kInitialBuckets));
+    _table.store(_tables.back().get(), std::memory_order_release);
+    for (auto& slab : _slabs) {
+      slab.store(nullptr, std::memory_order_relaxed);
+    }
+    _slab_owners.clear();
+    _free_values.clear();
+    _next_value = 0;
+    _tombstones = 0;
+    _size.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr uint32_t kEmpty = 0xFFFFFFFF;
+  static constexpr uint32_t kErased = 0xFFFFFFFE;
+  static constexpr size_t kInitialBuckets = 64;
+  static constexpr size_t kFirstSlabBits = 8;
+  static constexpr size_t kMaxSlabs = 32;
+  static constexpr size_t kReaderStripes = 16;
+
+  struct alignas(64) Bucket {
+    Bucket() {
+      version.store(0, std::memory_order_relaxed);
+      for (auto& slot : slots) {
+        slot.store(kEmpty, std::memory_order_relaxed);
+      }
+    }
+    std::atomic<uint32_t> version;
+    std::atomic<uint32_t> slots[kBucketSlots];
+    std::atomic<KEY> keys[kBucketSlots];
+  };
+  static_assert(sizeof(Bucket) == 64, "Bucket must fill one cache line.");
+
+  struct Table {
+    explicit Table(size_t bucket_num)
+        : mask(bucket_num - 1), buckets(new Bucket[bucket_num]) {}
+    size_t mask;
+    std::unique_ptr<Bucket[]> buckets;
+  };
+
+  struct alignas(64) ReaderCount {
+    std::atomic<int64_t> value{0};
+  };
+
+  // Counts the readers by the parity of the epoch they started in, so that a
+  // writer replacing the table can wait for those who may still be on it.
+  class ReadGuard {
+   public:
+    explicit ReadGuard(const InlineSparseTableShard* shard) {
+      uint64_t epoch = shard->_epoch.load(std::memory_order_seq_cst);
+      _count = &shard->_readers[epoch & 1][stripe()].value;
+      _count->fetch_add(1, std::memory_order_seq_cst);
+    }
+    ~ReadGuard() { _count->fetch_sub(1, std::memory_order_release); }
+
+   private:
+    static size_t stripe() {
+      static thread_local size_t stripe =
+          std::hash<std::thread::id>()(std::this_thread::get_id()) %
+          kReaderStripes;
+      return stripe;
+    }
+    std::atomic<int64_t>* _count;
+  };
+
+  static size_t mix(const KEY& key) {
+    // The keys of a shard share their residue modulo the shard number, so
+    // they are mixed before being masked.
+    uint64_t x = static_cast<uint64_t>(key);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+  }
+
+  // Returns false if the table was replaced while reading it.
+  bool read_from(const Table* table,
+                 const KEY& key,
+                 size_t hash,
+                 float* out,
+                 int* ret) const {
+    for (size_t probe = 0, i = hash & table->mask; probe <= table->mask;
+         ++probe, i = (i + 1) & table->mask) {
+      const Bucket& bucket = table->buckets[i];
+      while (true) {
+        uint32_t version = bucket.version.load(std::memory_order_acquire);
+        if (version & 1) {
+          if (_table.load(std::memory_order_acquire) != table) {
+            return false;
+          }
+          std::this_thread::yield();
+          continue;
+        }
+        bool has_empty = false;
+        bool found = false;
+        uint32_t size = 0;
+        for (size_t slot = 0; slot < kBucketSlots; ++slot) {
+          uint32_t index = bucket.slots[slot].load(std::memory_order_relaxed);
+          if (index == kEmpty) {
+            has_empty = true;
+          } else if (index != kErased &&
+                     bucket.keys[slot].load(std::memory_order_relaxed) ==
+                         key) {
+            // May be torn by a concurrent write, in which case the version
+            // check below fails and the value is read again.
+            const float* value = value_data(index);
+            std::memcpy(&size, value - 1, sizeof(size));
+            size = std::min(size, static_cast<uint32_t>(_value_dim));
+            std::memcpy(out, value, size * sizeof(float));
+            found = true;
+            break;
+          }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (bucket.version.load(std::memory_order_relaxed) != version) {
+          continue;
+        }
+        if (found) {
+          *ret = static_cast<int>(size);
+          return true;
+        }
+        if (has_empty) {
+          return true;
+        }
+        break;
+      }
+    }
+    return true;
+  }
+
+  bool locate(const KEY& key, size_t hash, Bucket** bucket, size_t* slot) {
+    Table* table = _table.load(std::memory_order_relaxed);
+    for (size_t probe = 0, i = hash & table->mask; probe <= table->mask;
+         ++probe, i = (i + 1) & table->mask) {
+      Bucket* candidate = &table->buckets[i];
+      bool has_empty = false;
+      for (size_t s = 0; s < kBucketSlots; ++s) {
+        uint32_t index = candidate->slots[s].load(std::memory_order_relaxed);
+        if (index == kEmpty) {
+          has_empty = true;
+        } else if (index != kErased &&
+                   candidate->keys[s].load(std::memory_order_relaxed) == key) {
+          *bucket = candidate;
+          *slot = s;
+          return true;
+        }
+      }
+      if (has_empty) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  static void begin_write(Bucket* bucket) {
+    uint32_t version = bucket->version.load(std::memory_order_relaxed);
+    bucket->version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  static void end_write(Bucket* bucket) {
+    uint32_t version = bucket->version.load(std::memory_order_relaxed);
+    bucket->version.store(version + 1, std::memory_order_release);
+  }
+
+  // Places key in the first free slot of its probe sequence in table, which
+  // must not contain it.
+  static bool place(Table* table,
+                    const KEY& key,
+                    size_t hash,
+                    uint32_t index,
+                    bool versioned) {
+    for (size_t probe = 0, i = hash & table->mask; probe <= table->mask;
+         ++probe, i = (i + 1) & table->mask) {
+      Bucket* bucket = &table->buckets[i];
+      for (size_t slot = 0; slot < kBucketSlots; ++slot) {
+        uint32_t old = bucket->slots[slot].load(std::memory_order_relaxed);
+        if (old != kEmpty && old != kErased) {
+          continue;
+        }
+        if (versioned) {
+          begin_write(bucket);
+        }
+        bucket->keys[slot].store(key, std::memory_order_relaxed);
+        bucket->slots[slot].store(index, std::memory_order_relaxed);
+        if (versioned) {
+          end_write(bucket);
+        }
+        return old == kErased;
+      }
+    }
+    PADDLE_THROW(common::errors::Fatal("The inline sparse shard is full."));
+  }
+
+  void publish(const KEY& key, size_t hash, uint32_t index) {
+    Table* table = _table.load(std::memory_order_relaxed);
+    size_t capacity = (table->mask + 1) * kBucketSlots;
+    if ((size() + _tombstones + 1) * 10 > capacity * 7) {
+      // Only grow if the live keys would fill more than a third of the new
+      // table, otherwise the rehash just drops the tombstones.
+      size_t bucket_num = table->mask + 1;
+      if ((size() + 1) * 3 > capacity) {
+        bucket_num *= 2;
+      }
+      rehash(bucket_num);
+      table = _table.load(std::memory_order_relaxed);
+    }
+    if (place(table, key, hash, index, /*versioned=*/true)) {
+      --_tombstones;
+    }
+    _size.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void rehash(size_t bucket_num) {
+    Table* old_table = _table.load(std::memory_order_relaxed);
+    std::unique_ptr<Table> table(new Table(bucket_num));
+    for (size_t i = 0; i <= old_table->mask; ++i) {
+      Bucket* bucket = &old_table->buckets[i];
+      for (size_t slot = 0; slot < kBucketSlots; ++slot) {
+        uint32_t index = bucket->slots[slot].load(std::memory_order_relaxed);
+        if (index >= kErased) {
+          continue;
+        }
+        KEY key = bucket->keys[slot].load(std::memory_order_relaxed);
+        place(table.get(), key, mix(key), index, /*versioned=*/false);
+      }
+    }
+    _table.store(table.get(), std::memory_order_seq_cst);
+    for (size_t i = 0; i <= old_table->mask; ++i) {
+      old_table->buckets[i].version.fetch_add(1, std::memory_order_release);
+    }
+    _tombstones = 0;
+
+    // The readers of the previous epoch may still be on the old table, the
+    // ones of the next one load the new table.
+    uint64_t epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+    for (auto& count : _readers[epoch & 1]) {
+      while (count.value.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+      }
+    }
+    _tables.clear();
+    _tables.push_back(std::move(table));
+  }
+
+  void erase_slot(Bucket* bucket, size_t slot) {
+    uint32_t index = bucket->slots[slot].load(std::memory_order_relaxed);
+    begin_write(bucket);
+    bucket->slots[slot].store(kErased, std::memory_order_relaxed);
+    end_write(bucket);
+    _free_values.push_back(index);
+    ++_tombstones;
+    _size.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // The size of a value is stored in the float before it.
+  float* value_data(uint32_t index) const {
+    size_t position = static_cast<size_t>(index) + (1UL << kFirstSlabBits);
+    size_t bits = 63 - __builtin_clzll(position);
+    float* slab = _slabs[bits - kFirstSlabBits].load(std::memory_order_acquire);
+    return slab + (position - (1UL << bits)) * _stride + 1;
+  }
+
+  size_t value_size(uint32_t index) const {
+    uint32_t size = 0;
+    std::memcpy(&size, value_data(index) - 1, sizeof(size));
+    return size;
+  }
+
+  template <class FN>
+  void update_value(uint32_t index, FN&& fn) {
+    float* value = value_data(index);
+    size_t size = value_size(index);
+    fn(value, &size);
+    uint32_t new_size = static_cast<uint32_t>(std::min(size, _value_dim));
+    std::memcpy(value - 1, &new_size, sizeof(new_size));
+  }
+
+  void store_value(uint32_t index, const float* data, size_t size) {
+    size = std::min(size, _value_dim);
+    float* value = value_data(index);
+    std::memcpy(value, data, size * sizeof(float));
+    uint32_t stored_size = static_cast<uint32_t>(size);
+    std::memcpy(value - 1, &stored_size, sizeof(stored_size));
+  }
+
+  uint32_t acquire_value() {
+    if (!_free_values.empty()) {
+      uint32_t index = _free_values.back();
+      _free_values.pop_back();
+      return index;
+    }
+    PADDLE_ENFORCE_LT(
+        _next_value,
+        kErased,
+        common::errors::ResourceExhausted(
+            "The inline sparse shard holds at most %u values.", kErased));
+    uint32_t index = _next_value++;
+    size_t position = static_cast<size_t>(index) + (1UL << kFirstSlabBits);
+    size_t bits = 63 - __builtin_clzll(position);
+    if (position == (1UL << bits)) {
+      // The first value of a new slab of 2^bits values.
+      std::unique_ptr<float[]> slab(new float[(1UL << bits) * _stride]);
+      _slabs[bits - kFirstSlabBits].store(slab.get(),
+                                          std::memory_order_release);
+      _slab_owners.push_back(std::move(slab));
+    }
+    return index;
+  }
+
+  const size_t _value_dim;
+  // The floats of a value and of its size.
+  const size_t _stride;
+
+  std::atomic<Table*> _table;
+  std::atomic<size_t> _size{0};
+  std::atomic<float*> _slabs[kMaxSlabs];
+
+  mutable std::atomic<uint64_t> _epoch{0};
+  mutable ReaderCount _readers[2][kReaderStripes];
+
+  // The members below are only used by the writers.
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<Table>> _tables;
+  std::vector<std::unique_ptr<float[]>> _slab_owners;
+  std::vector<uint32_t> _free_values;
+  uint32_t _next_value{0};
+  size_t _tombstones{0};
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,285 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace distributed {
+
+// The values of a sparse table shard copied out of the table to be saved,
+// column by column: the keys, the number of floats of each value and the
+// values one after the other. A delta snapshot also lists the keys deleted
+// since the previous snapshot.
+struct SparseShardSnapshot {
+  std::vector<uint64_t> keys;
+  std::vector<uint32_t> sizes;
+  std::vector<float> values;
+  std::vector<uint64_t> deleted_keys;
+
+  void Append(uint64_t key, const float* value, size_t size) {
+    keys.push_back(key);
+    sizes.push_back(static_cast<uint32_t>(size));
+    values.insert(values.end(), value, value + size);
+  }
+
+  void Clear() {
+    keys.clear();
+    sizes.clear();
+    values.clear();
+    deleted_keys.clear();
+  }
+};
+
+// The binary file of a shard snapshot is
+//
+//   header | block * | deleted keys column
+//
+// each block holding the keys, sizes and values columns of up to
+// kSnapshotBlockRows rows, so that a block is compressed and parsed without
+// the whole file in memory. A column is its raw size, its stored size, its
+// codec and its bytes, zlib compressed at its fastest level when the
+// snapshot is compressed.
+constexpr uint32_t kSnapshotMagic = 0x4e535350;  // "PSSN"
+constexpr uint32_t kSnapshotVersion = 1;
+constexpr size_t kSnapshotBlockRows = 1 << 16;
+
+enum SnapshotKind : uint32_t { kSnapshotFull = 0, kSnapshotDelta = 1 };
+
+struct SnapshotFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t kind;
+  uint32_t compress;
+  uint64_t num_rows;
+  uint64_t num_blocks;
+  uint64_t num_deleted;
+};
+
+namespace snapshot_internal {
+
+enum ColumnCodec : uint32_t { kCodecRaw = 0, kCodecZlib = 1 };
+
+struct ColumnHeader {
+  uint64_t raw_size;
+  uint64_t stored_size;
+  uint32_t codec;
+  uint32_t reserved;
+};
+
+inline int WriteColumn(const void* data,
+                       size_t size,
+                       bool compress,
+                       std::string* buffer,
+                       const std::function<int(const char*, size_t)>& write) {
+  ColumnHeader header = {size, size, kCodecRaw, 0};
+  const char* stored = reinterpret_cast<const char*>(data);
+  if (compress && size > 0) {
+    uLongf bound = compressBound(size);
+    buffer->resize(bound);
+    if (compress2(reinterpret_cast<Bytef*>(&(*buffer)[0]),
+                  &bound,
+                  reinterpret_cast<const Bytef*>(data),
+                  size,
+                  Z_BEST_SPEED) == Z_OK &&
+        bound < size) {
+      header.stored_size = bound;
+      header.codec = kCodecZlib;
+      stored = buffer->data();
+    }
+  }
+  if (write(reinterpret_cast<const char*>(&header), sizeof(header)) != 0) {
+    return -1;
+  }
+  if (header.stored_size > 0 && write(stored, header.stored_size) != 0) {
+    return -1;
+  }
+  return 0;
+}
+
+// Reads a column of exactly raw_size bytes into out.
+inline int ReadColumn(const std::function<size_t(char*, size_t)>& read,
+                      size_t raw_size,
+                      std::string* buffer,
+                      void* out) {
+  ColumnHeader header;
+  if (read(reinterpret_cast<char*>(&header), sizeof(header)) !=
+          sizeof(header) ||
+      header.raw_size != raw_size) {
+    return -1;
+  }
+  if (header.codec == kCodecRaw) {
+    if (header.stored_size != raw_size ||
+        (raw_size > 0 &&
+         read(reinterpret_cast<char*>(out), raw_size) != raw_size)) {
+      return -1;
+    }
+    return 0;
+  }
+  if (header.codec != kCodecZlib ||
+      header.stored_size > compressBound(raw_size)) {
+    return -1;
+  }
+  buffer->resize(header.stored_size);
+  if (read(&(*buffer)[0], header.stored_size) != header.stored_size) {
+    return -1;
+  }
+  uLongf out_size = raw_size;
+  if (uncompress(reinterpret_cast<Bytef*>(out),
+                 &out_size,
+                 reinterpret_cast<const Bytef*>(buffer->data()),
+                 header.stored_size) != Z_OK ||
+      out_size != raw_size) {
+    return -1;
+  }
+  return 0;
+}
+
+}  // namespace snapshot_internal
+
+// Writes the snapshot through write, which returns 0 on success. Returns 0,
+// or -1 as soon as a write fails.
+inline int WriteSparseSnapshot(
+    const SparseShardSnapshot& snapshot,
+    SnapshotKind kind,
+    bool compress,
+    const std::function<int(const char*, size_t)>& write) {
+  using snapshot_internal::WriteColumn;
+  size_t num_rows = snapshot.keys.size();
+  SnapshotFileHeader header = {
+      kSnapshotMagic,
+      kSnapshotVersion,
+      kind,
+      compress ? 1u : 0u,
+      num_rows,
+      (num_rows + kSnapshotBlockRows - 1) / kSnapshotBlockRows,
+      snapshot.deleted_keys.size()};
+  if (write(reinterpret_cast<const char*>(&header), sizeof(header)) != 0) {
+    return -1;
+  }
+  std::string buffer;
+  size_t value_offset = 0;
+  for (size_t begin = 0; begin < num_rows; begin += kSnapshotBlockRows) {
+    uint64_t rows = std::min(kSnapshotBlockRows, num_rows - begin);
+    uint64_t floats = 0;
+    for (size_t i = begin; i < begin + rows; ++i) {
+      floats += snapshot.sizes[i];
+    }
+    uint64_t block_header[2] = {rows, floats};
+    if (write(reinterpret_cast<const char*>(block_header),
+              sizeof(block_header)) != 0 ||
+        WriteColumn(snapshot.keys.data() + begin,
+                    rows * sizeof(uint64_t),
+                    compress,
+                    &buffer,
+                    write) != 0 ||
+        WriteColumn(snapshot.sizes.data() + begin,
+                    rows * sizeof(uint32_t),
+                    compress,
+                    &buffer,
+                    write) != 0 ||
+        WriteColumn(snapshot.values.data() + value_offset,
+                    floats * sizeof(float),
+                    compress,
+                    &buffer,
+                    write) != 0) {
+      return -1;
+    }
+    value_offset += floats;
+  }
+  return WriteColumn(snapshot.deleted_keys.data(),
+                     snapshot.deleted_keys.size() * sizeof(uint64_t),
+                     compress,
+                     &buffer,
+                     write);
+}
+
+// Reads a snapshot written by WriteSparseSnapshot through read, which
+// returns the number of bytes read, calling on_row for each row and
+// on_deleted for each deleted key. Returns 0, or -1 on a truncated or
+// corrupted file.
+inline int ReadSparseSnapshot(
+    const std::function<size_t(char*, size_t)>& read,
+    const std::function<void(uint64_t, const float*, size_t)>& on_row,
+    const std::function<void(uint64_t)>& on_deleted,
+    SnapshotFileHeader* file_header = nullptr) {
+  using snapshot_internal::ReadColumn;
+  SnapshotFileHeader header;
+  if (read(reinterpret_cast<char*>(&header), sizeof(header)) !=
+          sizeof(header) ||
+      header.magic != kSnapshotMagic || header.version != kSnapshotVersion) {
+    return -1;
+  }
+  if (file_header != nullptr) {
+    *file_header = header;
+  }
+  std::string buffer;
+  SparseShardSnapshot block;
+  uint64_t num_rows = 0;
+  for (uint64_t b = 0; b < header.num_blocks; ++b) {
+    uint64_t block_header[2];
+    if (read(reinterpret_cast<char*>(block_header), sizeof(block_header)) !=
+            sizeof(block_header) ||
+        block_header[0] > kSnapshotBlockRows) {
+      return -1;
+    }
+    uint64_t rows = block_header[0];
+    uint64_t floats = block_header[1];
+    block.keys.resize(rows);
+    block.sizes.resize(rows);
+    block.values.resize(floats);
+    if (ReadColumn(read, rows * sizeof(uint64_t), &buffer, block.keys.data()) !=
+            0 ||
+        ReadColumn(
+            read, rows * sizeof(uint32_t), &buffer, block.sizes.data()) != 0 ||
+        ReadColumn(
+            read, floats * sizeof(float), &buffer, block.values.data()) != 0) {
+      return -1;
+    }
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < rows; ++i) {
+      if (offset + block.sizes[i] > floats) {
+        return -1;
+      }
+      on_row(block.keys[i], block.values.data() + offset, block.sizes[i]);
+      offset += block.sizes[i];
+    }
+    num_rows += rows;
+  }
+  if (num_rows != header.num_rows) {
+    return -1;
+  }
+  block.deleted_keys.resize(header.num_deleted);
+  if (ReadColumn(read,
+                 header.num_deleted * sizeof(uint64_t),
+                 &buffer,
+                 block.deleted_keys.data()) != 0) {
+    return -1;
+  }
+  for (auto key : block.deleted_keys) {
+    on_deleted(key);
+  }
+  return 0;
+}
+
+}  // namespace distributed
+}  // namespace paddle
@@ -71,6 +71,8 @@ void GraphNode::build_sampler(std::string sample_type) {
   if (sample_type == "random") {
     sampler = new RandomSampler();
   } else if (sample_type == "weighted") {
+    sampler = new AliasSampler();
+  } else if (sample_type == "weighted_tree") {
     sampler = new WeightedSampler();
   }
   if (sampler != nullptr) {
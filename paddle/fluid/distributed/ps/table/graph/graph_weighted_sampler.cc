@@ -14,9 +14,14 @@
 
 #include "paddle/fluid/distributed/ps/table/graph/graph_weighted_sampler.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "paddle/phi/core/generator.h"
 namespace paddle::distributed {
@@ -165,4 +170,111 @@ int WeightedSampler::sample(
   subtract_count_map[this]++;
   return return_idx;
 }
+
+void AliasSampler::build(GraphEdgeBlob *edges) {
+  this->edges = edges;
+  int n = edges->size();
+  prob.assign(n, 1.0);
+  alias.resize(n);
+  double total = 0;
+  for (int i = 0; i < n; i++) {
+    float weight = edges->get_weight(i);
+    prob[i] = std::max(weight, 0.0f);
+    total += prob[i];
+    alias[i] = i;
+  }
+  if (total <= 0) {
+    std::fill(prob.begin(), prob.end(), 1.0);
+    return;
+  }
+  std::vector<int> small, large;
+  for (int i = 0; i < n; i++) {
+    prob[i] = static_cast<float>(prob[i] * n / total);
+    if (prob[i] < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+  while (!small.empty() && !large.empty()) {
+    int s = small.back(), l = large.back();
+    small.pop_back();
+    large.pop_back();
+    alias[s] = l;
+    prob[l] = prob[l] + prob[s] - 1.0f;
+    if (prob[l] < 1.0) {
+      small.push_back(l);
+    } else {
+      large.push_back(l);
+    }
+  }
+  // The columns left are full up to the rounding errors.
+  for (int i : small) prob[i] = 1.0;
+  for (int i : large) prob[i] = 1.0;
+}
+
+std::vector<int> AliasSampler::sample_k(
+    int k, const std::shared_ptr<std::mt19937_64> rng) {
+  int n = prob.size();
+  if (k >= n) {
+    k = n;
+    std::vector<int> sample_result;
+    sample_result.reserve(k);
+    for (int i = 0; i < k; i++) {
+      sample_result.push_back(i);
+    }
+    return sample_result;
+  }
+  std::vector<int> sample_result;
+  sample_result.reserve(k);
+  std::unordered_set<int> selected;
+  selected.reserve(k);
+  // The rejections are cheap while the sample holds a small part of the
+  // weights, so they are only tried for k up to half of the edges.
+  if (k * 2 <= n) {
+    std::uniform_int_distribution<int> column(0, n - 1);
+    std::uniform_real_distribution<float> coin(0, 1.0);
+    int max_draws = 4 * k + 16;
+    for (int draw = 0; draw < max_draws &&
+                       static_cast<int>(sample_result.size()) < k;
+         draw++) {
+      int i = column(*rng);
+      int edge = coin(*rng) < prob[i] ? i : alias[i];
+      if (selected.insert(edge).second) {
+        sample_result.push_back(edge);
+      }
+    }
+  }
+  if (static_cast<int>(sample_result.size()) < k) {
+    sample_rest(k, rng.get(), &sample_result, &selected);
+  }
+  return sample_result;
+}
+
+void AliasSampler::sample_rest(int k,
+                               std::mt19937_64 *rng,
+                               std::vector<int> *sample_result,
+                               std::unordered_set<int> *selected) {
+  // The edges sorted by exponential keys of rate their weights come in the
+  // order of the weighted sampling without replacement.
+  std::vector<std::pair<double, int>> keys;
+  int n = prob.size();
+  keys.reserve(n - selected->size());
+  std::uniform_real_distribution<double> distrib(0, 1.0);
+  for (int i = 0; i < n; i++) {
+    if (selected->count(i)) continue;
+    float weight = edges->get_weight(i);
+    double u = distrib(*rng);
+    // The edges without weight come last, in a random order.
+    keys.emplace_back(weight > 0 ? -std::log(u) / weight
+                                 : std::numeric_limits<double>::max() * u,
+                      i);
+  }
+  size_t rest = k - sample_result->size();
+  std::partial_sort(keys.begin(), keys.begin() + rest, keys.end());
+  for (size_t i = 0; i < rest; i++) {
+    sample_result->push_back(keys[i].second);
+    selected->insert(keys[i].second);
+  }
+}
 }  // namespace paddle::distributed
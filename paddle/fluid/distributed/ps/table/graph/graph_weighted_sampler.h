@@ -17,6 +17,7 @@
 #include <memory>
 #include <random>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "paddle/fluid/distributed/ps/table/graph/graph_edge.h"
@@ -62,5 +63,30 @@ class WeightedSampler : public Sampler {
       std::unordered_map<WeightedSampler *, int> &subtract_count_map,  // NOLINT
       float &subtract);                                                // NOLINT
 };
+
+// Samples the edges in proportion to their weights by Vose's alias method, in
+// O(1) per draw with 8 bytes per edge. The draws that hit an edge already in
+// the sample are rejected, which keeps the distribution of the weighted
+// sampling without replacement of WeightedSampler. When k is large relative
+// to the edges or the rejections pile up, the rest of the sample is drawn by
+// exponential keys over the edges left.
+class AliasSampler : public Sampler {
+ public:
+  virtual ~AliasSampler() {}
+  virtual void build(GraphEdgeBlob *edges);
+  virtual std::vector<int> sample_k(int k,
+                                    const std::shared_ptr<std::mt19937_64> rng);
+
+ private:
+  void sample_rest(int k,
+                   std::mt19937_64 *rng,
+                   std::vector<int> *sample_result,
+                   std::unordered_set<int> *selected);
+
+  GraphEdgeBlob *edges = nullptr;
+  // The probability of keeping the drawn column, and the edge taken instead.
+  std::vector<float> prob;
+  std::vector<int> alias;
+};
 }  // namespace distributed
 }  // namespace paddle
@@ -0,0 +1,493 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/memory_inline_sparse_table.h"
+
+#include <omp.h>
+
+#include <algorithm>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/distributed/common/cost_timer.h"
+#include "paddle/fluid/platform/enforce.h"
+#include "paddle/utils/string/string_helper.h"
+
+PD_DECLARE_bool(pserver_create_value_when_push);
+PD_DECLARE_bool(pserver_enable_create_feasign_randomly);
+PD_DECLARE_int32(pserver_table_save_max_retry);
+
+namespace paddle::distributed {
+
+int32_t MemoryInlineSparseTable::Initialize() {
+  PADDLE_ENFORCE_EQ(
+      _config.enable_revert(),
+      false,
+      common::errors::Unimplemented(
+          "MemoryInlineSparseTable does not support enable_revert."));
+  MemorySparseTable::Initialize();
+  size_t value_col = _value_accessor->GetAccessorInfo().size / sizeof(float);
+  _inline_shards.clear();
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    _inline_shards.emplace_back(
+        std::make_unique<inline_shard_type>(value_col));
+  }
+  VLOG(0) << "initialize MemoryInlineSparseTable succ";
+  return 0;
+}
+
+int32_t MemoryInlineSparseTable::Pull(TableContext &context) {
+  PADDLE_ENFORCE_EQ(
+      context.value_type,
+      Sparse,
+      common::errors::InvalidArgument(
+          "The 'value_type' in context must be 'Sparse', but received %d.",
+          context.value_type));
+  PADDLE_ENFORCE_EQ(context.use_ptr,
+                    false,
+                    common::errors::Unimplemented(
+                        "MemoryInlineSparseTable does not pull pointers."));
+  return PullSparse(context.pull_context.values,
+                    context.pull_context.pull_value);
+}
+
+int32_t MemoryInlineSparseTable::Push(TableContext &context) {
+  PADDLE_ENFORCE_EQ(
+      context.value_type,
+      Sparse,
+      common::errors::InvalidArgument(
+          "The 'value_type' in context must be 'Sparse', but received %d.",
+          context.value_type));
+  if (!context.use_ptr) {
+    return PushSparse(
+        context.push_context.keys, context.push_context.values, context.num);
+  } else {
+    return PushSparse(context.push_context.keys,
+                      context.push_context.ptr_values,
+                      context.num);
+  }
+}
+
+int32_t MemoryInlineSparseTable::PullSparse(float *pull_values,
+                                            const PullSparseValue &pull_value) {
+  CostTimer timer("pserver_sparse_select_all");
+  const size_t value_size =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t mf_value_size =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+  size_t select_value_size =
+      _value_accessor->GetAccessorInfo().select_size / sizeof(float);
+
+  // The shards are read lock-free, so the keys are looked up in order on the
+  // calling thread.
+  float data_buffer[value_size];  // NOLINT
+  float *data_buffer_ptr = data_buffer;
+  for (size_t i = 0; i < pull_value.numel_; ++i) {
+    uint64_t key = pull_value.feasigns_[i];
+    int shard_id = (key % _sparse_table_shard_num) % _avg_local_shard_num;
+    auto &local_shard = _inline_shards[shard_id];
+    int data_size = local_shard->read(key, data_buffer);
+    if (data_size < 0) {
+      data_size = static_cast<int>(value_size - mf_value_size);
+      if (FLAGS_pserver_create_value_when_push) {
+        memset(data_buffer, 0, sizeof(float) * data_size);
+      } else {
+        _value_accessor->Create(&data_buffer_ptr, 1);
+        if (!local_shard->insert(key, data_buffer, data_size)) {
+          // Created by a concurrent pull or push.
+          data_size = local_shard->read(key, data_buffer);
+        }
+      }
+    }
+    for (size_t mf_idx = data_size; mf_idx < value_size; ++mf_idx) {
+      data_buffer[mf_idx] = 0.0;
+    }
+    float *select_data = pull_values + select_value_size * i;
+    _value_accessor->Select(&select_data, (const float **)&data_buffer_ptr, 1);
+  }
+  return 0;
+}
+
+void MemoryInlineSparseTable::PushValue(inline_shard_type *shard,
+                                        uint64_t key,
+                                        const float *update_data,
+                                        float *data_buffer) {
+  const size_t value_col =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t mf_value_col =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+  float *data_buffer_ptr = data_buffer;
+  auto update = [&](float *value_data, size_t *value_size) {
+    if (*value_size == value_col) {  // 已拓展到最大size, 则就地update
+      _value_accessor->Update(&value_data, &update_data, 1);
+      return;
+    }
+    // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
+    size_t old_size = *value_size;
+    memcpy(data_buffer_ptr, value_data, old_size * sizeof(float));
+    _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
+    if (_value_accessor->NeedExtendMF(data_buffer)) {
+      *value_size = value_col;
+      _value_accessor->Create(&value_data, 1);
+    }
+    memcpy(value_data, data_buffer_ptr, old_size * sizeof(float));
+  };
+  if (shard->update(key, update)) {
+    return;
+  }
+  if (FLAGS_pserver_enable_create_feasign_randomly &&
+      !_value_accessor->CreateValue(1, update_data)) {
+    return;
+  }
+  _value_accessor->Create(&data_buffer_ptr, 1);
+  shard->insert(key, data_buffer, value_col - mf_value_col);
+  shard->update(key, update);
+}
+
+int32_t MemoryInlineSparseTable::PushSparse(const uint64_t *keys,
+                                            const float *values,
+                                            size_t num) {
+  CostTimer timer("pserver_sparse_update_all");
+  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
+      _real_local_shard_num);
+  for (size_t i = 0; i < num; ++i) {
+    int shard_id = (keys[i] % _sparse_table_shard_num) % _avg_local_shard_num;
+    task_keys[shard_id].push_back({keys[i], i});
+  }
+
+  const size_t value_col =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t update_value_col =
+      _value_accessor->GetAccessorInfo().update_size / sizeof(float);
+
+  for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+    tasks[shard_id] = _shards_task_pool[shard_id % _task_pool_size]->enqueue(
+        [this, shard_id, value_col, update_value_col, values, &task_keys]()
+            -> int {
+          auto &local_shard = _inline_shards[shard_id];
+          float data_buffer[value_col];  // NOLINT
+          for (auto &item : task_keys[shard_id]) {
+            const float *update_data = values + item.second * update_value_col;
+            PushValue(local_shard.get(), item.first, update_data, data_buffer);
+          }
+          return 0;
+        });
+  }
+
+  for (auto &task : tasks) {
+    task.wait();
+  }
+  return 0;
+}
+
+int32_t MemoryInlineSparseTable::PushSparse(const uint64_t *keys,
+                                            const float **values,
+                                            size_t num) {
+  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
+      _real_local_shard_num);
+  for (size_t i = 0; i < num; ++i) {
+    int shard_id = (keys[i] % _sparse_table_shard_num) % _avg_local_shard_num;
+    task_keys[shard_id].push_back({keys[i], i});
+  }
+
+  size_t value_col = _value_accessor->GetAccessorInfo().size / sizeof(float);
+
+  for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+    tasks[shard_id] = _shards_task_pool[shard_id % _task_pool_size]->enqueue(
+        [this, shard_id, value_col, values, &task_keys]() -> int {
+          auto &local_shard = _inline_shards[shard_id];
+          float data_buffer[value_col];  // NOLINT
+          for (auto &item : task_keys[shard_id]) {
+            const float *update_data = values[item.second];
+            PushValue(local_shard.get(), item.first, update_data, data_buffer);
+          }
+          return 0;
+        });
+  }
+
+  for (auto &task : tasks) {
+    task.wait();
+  }
+  return 0;
+}
+
+int32_t MemoryInlineSparseTable::Load(const std::string &path,
+                                      const std::string &param) {
+  std::string table_path = TableDir(path);
+  auto file_list = _afs_client.list(table_path);
+  std::sort(file_list.begin(), file_list.end());
+
+  int load_param = atoi(param.c_str());
+  size_t expect_shard_num = _sparse_table_shard_num;
+  if (file_list.size() != expect_shard_num) {
+    LOG(WARNING) << "MemoryInlineSparseTable file_size:" << file_list.size()
+                 << " not equal to expect_shard_num:" << expect_shard_num;
+    return -1;
+  }
+  if (file_list.empty()) {
+    LOG(WARNING) << "MemoryInlineSparseTable load file is empty, path:"
+                 << path;
+    return -1;
+  }
+  PADDLE_ENFORCE_NE(load_param,
+                    5,
+                    common::errors::Unimplemented(
+                        "MemoryInlineSparseTable does not support the patch "
+                        "model."));
+
+  size_t file_start_idx = _shard_idx * _avg_local_shard_num;
+  if (file_start_idx >= file_list.size()) {
+    return 0;
+  }
+
+  size_t feature_value_size =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  int thread_num = _real_local_shard_num < 15 ? _real_local_shard_num : 15;
+  omp_set_num_threads(thread_num);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    FsChannelConfig channel_config = {};
+    channel_config.path = file_list[file_start_idx + i];
+    channel_config.converter = _value_accessor->Converter(load_param).converter;
+    channel_config.deconverter =
+        _value_accessor->Converter(load_param).deconverter;
+
+    std::vector<float> value(feature_value_size);
+    bool is_read_failed = false;
+    int retry_num = 0;
+    int err_no = 0;
+    do {
+      is_read_failed = false;
+      err_no = 0;
+      std::string line_data;
+      auto read_channel = _afs_client.open_r(channel_config, 0, &err_no);
+      char *end = nullptr;
+      auto &shard = _inline_shards[i];
+      try {
+        while (read_channel->read_line(line_data) == 0 &&
+               line_data.size() > 1) {
+          uint64_t key = std::strtoul(line_data.data(), &end, 10);
+          int parse_size =
+              _value_accessor->ParseFromString(++end, value.data());
+          shard->assign(key, value.data(), parse_size);
+        }
+        read_channel->close();
+        if (err_no == -1) {
+          ++retry_num;
+          is_read_failed = true;
+          LOG(ERROR) << "MemoryInlineSparseTable load failed after read, "
+                        "retry it! path:"
+                     << channel_config.path << " , retry_num=" << retry_num;
+        }
+      } catch (...) {
+        ++retry_num;
+        is_read_failed = true;
+        LOG(ERROR) << "MemoryInlineSparseTable load failed, retry it! path:"
+                   << channel_config.path << " , retry_num=" << retry_num;
+      }
+      if (retry_num > FLAGS_pserver_table_save_max_retry) {
+        LOG(ERROR) << "MemoryInlineSparseTable load failed reach max limit!";
+        exit(-1);
+      }
+    } while (is_read_failed);
+  }
+  LOG(INFO) << "MemoryInlineSparseTable load success, path from "
+            << file_list[file_start_idx] << " to "
+            << file_list[file_start_idx + _real_local_shard_num - 1];
+  return 0;
+}
+
+int32_t MemoryInlineSparseTable::Save(const std::string &dirname,
+                                      const std::string &param) {
+  if (_real_local_shard_num == 0) {
+    return 0;
+  }
+
+  VLOG(0) << "MemoryInlineSparseTable::save dirname: " << dirname;
+  int save_param =
+      atoi(param.c_str());  // checkpoint:0  xbox delta:1  xbox base:2
+  PADDLE_ENFORCE_NE(save_param,
+                    5,
+                    common::errors::Unimplemented(
+                        "MemoryInlineSparseTable does not support the patch "
+                        "model."));
+
+  std::string table_path = TableDir(dirname);
+  _afs_client.remove(::paddle::string::format_string(
+      "%s/part-%03d-*", table_path.c_str(), _shard_idx));
+  size_t file_start_idx = _avg_local_shard_num * _shard_idx;
+
+  int thread_num = _real_local_shard_num < 20 ? _real_local_shard_num : 20;
+  omp_set_num_threads(thread_num);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    FsChannelConfig channel_config = {};
+    if (_config.compress_in_save() && (save_param == 0 || save_param == 3)) {
+      channel_config.path =
+          ::paddle::string::format_string("%s/part-%03d-%05d.gz",
+                                          table_path.c_str(),
+                                          _shard_idx,
+                                          file_start_idx + i);
+    } else {
+      channel_config.path = ::paddle::string::format_string("%s/part-%03d-%05d",
+                                                            table_path.c_str(),
+                                                            _shard_idx,
+                                                            file_start_idx + i);
+    }
+    channel_config.converter = _value_accessor->Converter(save_param).converter;
+    channel_config.deconverter =
+        _value_accessor->Converter(save_param).deconverter;
+    bool is_write_failed = false;
+    int feasign_size = 0;
+    int retry_num = 0;
+    int err_no = 0;
+    auto &shard = _inline_shards[i];
+    do {
+      err_no = 0;
+      feasign_size = 0;
+      is_write_failed = false;
+      auto write_channel =
+          _afs_client.open_w(channel_config, 1024 * 1024 * 40, &err_no);
+      shard->for_each([&](uint64_t key, float *value, size_t *size) {
+        if (is_write_failed || !_value_accessor->Save(value, save_param)) {
+          return;
+        }
+        std::string format_value =
+            _value_accessor->ParseToString(value, *size);
+        if (0 != write_channel->write_line(::paddle::string::format_string(
+                     "%lu %s", key, format_value.c_str()))) {
+          ++retry_num;
+          is_write_failed = true;
+          LOG(ERROR)
+              << "MemoryInlineSparseTable save prefix failed, retry it! path:"
+              << channel_config.path << " , retry_num=" << retry_num;
+          return;
+        }
+        ++feasign_size;
+      });
+      write_channel->close();
+      if (err_no == -1) {
+        ++retry_num;
+        is_write_failed = true;
+        LOG(ERROR) << "MemoryInlineSparseTable save prefix failed after "
+                      "write, retry it! path:"
+                   << channel_config.path << " , retry_num=" << retry_num;
+      }
+      if (is_write_failed) {
+        _afs_client.remove(channel_config.path);
+      }
+      if (retry_num > FLAGS_pserver_table_save_max_retry) {
+        LOG(ERROR)
+            << "MemoryInlineSparseTable save prefix failed reach max limit!";
+        exit(-1);
+      }
+    } while (is_write_failed);
+    shard->for_each([&](uint64_t, float *value, size_t *) {
+      _value_accessor->UpdateStatAfterSave(value, save_param);
+    });
+    LOG(INFO) << "MemoryInlineSparseTable save prefix success, path: "
+              << channel_config.path << " feasign_size: " << feasign_size;
+  }
+  return 0;
+}
+
+int32_t MemoryInlineSparseTable::SaveCache(
+    const std::string &path UNUSED,
+    const std::string &param UNUSED,
+    paddle::framework::Channel<std::pair<uint64_t, std::string>>
+        &shuffled_channel UNUSED) {
+  PADDLE_THROW(common::errors::Unimplemented(
+      "MemoryInlineSparseTable does not support the cache model."));
+  return -1;
+}
+
+int64_t MemoryInlineSparseTable::CacheShuffle(
+    const std::string &path UNUSED,
+    const std::string &param UNUSED,
+    double cache_threshold UNUSED,
+    std::function<std::future<int32_t>(
+        int msg_type, int to_pserver_id, std::string &msg)>  // NOLINT
+        send_msg_func UNUSED,
+    paddle::framework::Channel<std::pair<uint64_t, std::string>>
+        &shuffled_channel UNUSED,
+    const std::vector<Table *> &table_ptrs UNUSED) {
+  PADDLE_THROW(common::errors::Unimplemented(
+      "MemoryInlineSparseTable does not support the cache model."));
+  return -1;
+}
+
+int64_t MemoryInlineSparseTable::LocalSize() {
+  int64_t local_size = 0;
+  for (auto &shard : _inline_shards) {
+    local_size += shard->size();
+  }
+  return local_size;
+}
+
+int64_t MemoryInlineSparseTable::LocalMFSize() {
+  std::vector<int64_t> size_arr(_real_local_shard_num, 0);
+  std::vector<std::future<int>> tasks(_real_local_shard_num);
+  int64_t ret_size = 0;
+  for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+    tasks[shard_id] =
+        _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
+            [this, shard_id, &size_arr]() -> int {
+              _inline_shards[shard_id]->for_each(
+                  [&](uint64_t, float *, size_t *size) {
+                    if (_value_accessor->HasMF(*size)) {
+                      size_arr[shard_id] += 1;
+                    }
+                  });
+              return 0;
+            });
+  }
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    tasks[i].wait();
+  }
+  for (auto x : size_arr) {
+    ret_size += x;
+  }
+  return ret_size;
+}
+
+std::pair<int64_t, int64_t> MemoryInlineSparseTable::PrintTableStat() {
+  int64_t feasign_size = LocalSize();
+  int64_t mf_size = LocalMFSize();
+  return {feasign_size, mf_size};
+}
+
+int32_t MemoryInlineSparseTable::Shrink(const std::string &param) {
+  VLOG(0) << "MemoryInlineSparseTable::Shrink";
+  std::atomic<uint32_t> shrink_size_all{0};
+  int thread_num = _real_local_shard_num;
+  omp_set_num_threads(thread_num);
+#pragma omp parallel for schedule(dynamic)
+  for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+    shrink_size_all += _inline_shards[shard_id]->erase_if(
+        [&](float *value, size_t) { return _value_accessor->Shrink(value); });
+  }
+  VLOG(0) << "MemoryInlineSparseTable::Shrink success, shrink size:"
+          << shrink_size_all;
+  return 0;
+}
+
+void MemoryInlineSparseTable::Clear() {
+  for (auto &shard : _inline_shards) {
+    shard->clear();
+  }
+}
+
+}  // namespace paddle::distributed
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/distributed/ps/table/depends/inline_sparse_shard.h"
+#include "paddle/fluid/distributed/ps/table/memory_sparse_table.h"
+
+namespace paddle {
+namespace distributed {
+
+// A MemorySparseTable keeping its values inline in InlineSparseTableShard, so
+// that pulls read the shards directly on the calling thread, without hopping
+// through the shard task pools. Pushes still go through the task pools, one
+// writer per shard. The save and load formats are the ones of
+// MemorySparseTable, the patch model, the cache and the pointer pulls of the
+// gpu ps are not supported.
+class MemoryInlineSparseTable : public MemorySparseTable {
+ public:
+  typedef InlineSparseTableShard<uint64_t> inline_shard_type;
+  MemoryInlineSparseTable() {}
+  virtual ~MemoryInlineSparseTable() {}
+
+  int32_t Initialize() override;
+
+  int32_t Pull(TableContext& context) override;
+  int32_t Push(TableContext& context) override;
+
+  int32_t PullSparse(float* pull_values, const PullSparseValue& pull_value);
+  // Only the pulls of MemorySparseTable are served from a hot replica.
+  int32_t UpdateHotReplica(const uint64_t* keys UNUSED,
+                           const float* select_values UNUSED,
+                           size_t num UNUSED,
+                           int64_t ttl_ms UNUSED) override {
+    return -1;
+  }
+  int32_t PushSparse(const uint64_t* keys, const float* values, size_t num);
+  int32_t PushSparse(const uint64_t* keys, const float** values, size_t num);
+
+  int32_t Load(const std::string& path, const std::string& param) override;
+  int32_t Save(const std::string& path, const std::string& param) override;
+  int32_t SaveCache(
+      const std::string& path,
+      const std::string& param,
+      paddle::framework::Channel<std::pair<uint64_t, std::string>>&
+          shuffled_channel) override;
+  int64_t CacheShuffle(
+      const std::string& path,
+      const std::string& param,
+      double cache_threshold,
+      std::function<std::future<int32_t>(
+          int msg_type, int to_pserver_id, std::string& msg)> send_msg_func,
+      paddle::framework::Channel<std::pair<uint64_t, std::string>>&
+          shuffled_channel,
+      const std::vector<Table*>& table_ptrs) override;
+
+  int64_t LocalSize();
+  int64_t LocalMFSize();
+  std::pair<int64_t, int64_t> PrintTableStat() override;
+
+  int32_t Shrink(const std::string& param) override;
+  void Clear() override;
+
+  void* GetShard(size_t shard_idx) override {
+    return _inline_shards[shard_idx].get();
+  }
+
+ private:
+  // Updates the value of key by the gradients in update_data, creating it
+  // first if it is missing, as MemorySparseTable::PushSparse does.
+  void PushValue(inline_shard_type* shard,
+                 uint64_t key,
+                 const float* update_data,
+                 float* data_buffer);
+
+  std::vector<std::unique_ptr<inline_shard_type>> _inline_shards;
+};
+
+}  // namespace distributed
+}  // namespace paddle
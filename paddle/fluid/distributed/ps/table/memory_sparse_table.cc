@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <omp.h>
+#include <chrono>
 #include <sstream>
 
 #include "glog/logging.h"
@@ -38,9 +39,27 @@ PD_DEFINE_bool(pserver_enable_create_feasign_randomly,
 PD_DEFINE_int32(pserver_table_save_max_retry,
                 3,
                 "pserver_table_save_max_retry");
+PD_DEFINE_bool(pserver_sparse_snapshot_track_delta,
+               false,
+               "record the keys updated since the last binary snapshot of a "
+               "MemorySparseTable, which delta snapshots (save_param 7) need");
+PD_DEFINE_int32(pserver_hot_key_num,
+                0,
+                "the number of most pulled keys of each MemorySparseTable a "
+                "server reports for hot key rebalancing, 0 not to track them");
 
 namespace paddle::distributed {
 
+namespace {
+
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
 int32_t MemorySparseTable::Initialize() {
   auto &profiler = CostProfiler::instance();
   profiler.register_profiler("pserver_sparse_update_all");
@@ -77,6 +96,15 @@ int32_t MemorySparseTable::InitializeValue() {
           << " _use_gpu_graph:" << _use_gpu_graph;
 
   _local_shards.reset(new shard_type[_real_local_shard_num]);
+  _shard_deltas.reset(new ShardDelta[_real_local_shard_num]);  // NOLINT
+  _hot_key_trackers.clear();
+  if (FLAGS_pserver_hot_key_num > 0 && _real_local_shard_num > 0) {
+    // The hot keys are spread over the shards, with some slack.
+    size_t capacity = 2 * FLAGS_pserver_hot_key_num / _real_local_shard_num;
+    for (int i = 0; i < _real_local_shard_num; ++i) {
+      _hot_key_trackers.emplace_back(new HotKeyTracker(capacity + 1));
+    }
+  }
 
   if (_config.enable_revert()) {
     // calculate merged shard number based on config param;
@@ -151,6 +179,10 @@ int32_t MemorySparseTable::Load(const std::string &path,
   if (file_start_idx >= file_list.size()) {
     return 0;
   }
+  ClearDirty();
+  if (::paddle::string::ends_with(file_list[0], ".snap")) {
+    return LoadSnapshot(file_list, file_start_idx);
+  }
 
   size_t feature_value_size =
       _value_accessor->GetAccessorInfo().size / sizeof(float);
@@ -348,6 +380,11 @@ int32_t MemorySparseTable::Save(const std::string &dirname,
   int save_param =
       atoi(param.c_str());  // checkpoint:0  xbox delta:1  xbox base:2
 
+  // binary snapshot:6  binary delta snapshot:7
+  if (save_param == 6 || save_param == 7) {
+    return SaveSnapshot(dirname, save_param);
+  }
+
   // patch model
   if (save_param == 5) {
     _local_shards_patch_model.reset(_local_shards_new.release());
@@ -480,6 +517,11 @@ int32_t MemorySparseTable::Save_v2(const std::string &dirname,
   int save_param =
       atoi(param.c_str());  // checkpoint:0  xbox delta:1  xbox base:2
 
+  // binary snapshot:6  binary delta snapshot:7
+  if (save_param == 6 || save_param == 7) {
+    return SaveSnapshot(dirname, save_param);
+  }
+
   // patch model
   if (save_param == 5) {
     _local_shards_patch_model.reset(_local_shards_new.release());
@@ -759,6 +801,204 @@ int32_t MemorySparseTable::SavePatch(const std::string &path, int save_param) {
   return 0;
 }
 
+void MemorySparseTable::SnapshotShard(int shard_id,
+                                      bool delta,
+                                      SparseShardSnapshot *snapshot) {
+  auto &shard = _local_shards[shard_id];
+  auto &shard_delta = _shard_deltas[shard_id];
+  std::lock_guard<std::mutex> lock(shard_delta.mutex);
+  if (delta) {
+    for (auto key : shard_delta.dirty_keys) {
+      auto itr = shard.find(key);
+      if (itr != shard.end()) {
+        snapshot->Append(key, itr.value().data(), itr.value().size());
+      }
+    }
+    snapshot->deleted_keys.assign(shard_delta.deleted_keys.begin(),
+                                  shard_delta.deleted_keys.end());
+  } else {
+    snapshot->keys.reserve(shard.size());
+    snapshot->sizes.reserve(shard.size());
+    for (auto it = shard.begin(); it != shard.end(); ++it) {
+      snapshot->Append(it.key(), it.value().data(), it.value().size());
+    }
+  }
+  shard_delta.dirty_keys.clear();
+  shard_delta.deleted_keys.clear();
+}
+
+void MemorySparseTable::MarkDirty(
+    int shard_id, const std::vector<std::pair<uint64_t, int>> &keys) {
+  if (!FLAGS_pserver_sparse_snapshot_track_delta || keys.empty()) {
+    return;
+  }
+  auto &shard_delta = _shard_deltas[shard_id];
+  std::lock_guard<std::mutex> lock(shard_delta.mutex);
+  for (auto &item : keys) {
+    shard_delta.dirty_keys.insert(item.first);
+    if (!shard_delta.deleted_keys.empty()) {
+      shard_delta.deleted_keys.erase(item.first);
+    }
+  }
+}
+
+void MemorySparseTable::ClearDirty() {
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    std::lock_guard<std::mutex> lock(_shard_deltas[i].mutex);
+    _shard_deltas[i].dirty_keys.clear();
+    _shard_deltas[i].deleted_keys.clear();
+  }
+}
+
+// Writes a binary file per local shard, see sparse_snapshot.h, in parallel.
+// A shard is copied out on its task thread, so between two pulls or pushes
+// of the shard, and only blocked for the copy: the copy is then compressed
+// and written while the training goes on, at the cost of the memory of the
+// shards being written. A delta snapshot, save_param 7, only has the values
+// updated and the keys deleted since the previous snapshot of the shard, and
+// is loaded over the snapshots before it.
+int32_t MemorySparseTable::SaveSnapshot(const std::string &path,
+                                        int save_param) {
+  bool delta = save_param == 7;
+  if (delta && !FLAGS_pserver_sparse_snapshot_track_delta) {
+    LOG(WARNING) << "MemorySparseTable delta snapshot needs "
+                 << "pserver_sparse_snapshot_track_delta, path:" << path;
+    return -1;
+  }
+  size_t file_start_idx = _avg_local_shard_num * _shard_idx;
+  std::string table_path = TableDir(path);
+  _afs_client.remove(::paddle::string::format_string(
+      "%s/part-%03d-*", table_path.c_str(), _shard_idx));
+  std::atomic<uint64_t> feasign_size_all{0};
+  std::atomic<uint64_t> deleted_size_all{0};
+
+#ifdef PADDLE_WITH_HETERPS
+  int thread_num = _real_local_shard_num;
+#else
+  int thread_num = _real_local_shard_num < 20 ? _real_local_shard_num : 20;
+#endif
+  omp_set_num_threads(thread_num);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    SparseShardSnapshot snapshot;
+    _shards_task_pool[i % _task_pool_size]
+        ->enqueue([this, i, delta, &snapshot]() {
+          SnapshotShard(i, delta, &snapshot);
+        })
+        .wait();
+
+    FsChannelConfig channel_config = {};
+    channel_config.path =
+        ::paddle::string::format_string("%s/part-%03d-%05d.snap",
+                                        table_path.c_str(),
+                                        _shard_idx,
+                                        file_start_idx + i);
+    bool is_write_failed = false;
+    int retry_num = 0;
+    int err_no = 0;
+    do {
+      err_no = 0;
+      is_write_failed = false;
+      auto write_channel =
+          _afs_client.open_w(channel_config, 1024 * 1024 * 40, &err_no);
+      auto write = [&write_channel](const char *data, size_t size) -> int {
+        return write_channel->write(data, size) == 0 ? 0 : -1;
+      };
+      if (WriteSparseSnapshot(snapshot,
+                              delta ? kSnapshotDelta : kSnapshotFull,
+                              _config.compress_in_save(),
+                              write) != 0) {
+        ++retry_num;
+        is_write_failed = true;
+        LOG(ERROR) << "MemorySparseTable save snapshot failed, retry it! "
+                   << "path:" << channel_config.path
+                   << " , retry_num=" << retry_num;
+      }
+      write_channel->close();
+      if (err_no == -1) {
+        ++retry_num;
+        is_write_failed = true;
+        LOG(ERROR)
+            << "MemorySparseTable save snapshot failed after write, retry it! "
+            << "path:" << channel_config.path << " , retry_num=" << retry_num;
+      }
+      if (is_write_failed) {
+        _afs_client.remove(channel_config.path);
+      }
+      if (retry_num > FLAGS_pserver_table_save_max_retry) {
+        LOG(ERROR) << "MemorySparseTable save snapshot failed reach max limit!";
+        exit(-1);
+      }
+    } while (is_write_failed);
+    feasign_size_all += snapshot.keys.size();
+    deleted_size_all += snapshot.deleted_keys.size();
+  }
+  LOG(INFO) << "MemorySparseTable save " << (delta ? "delta " : "")
+            << "snapshot success, path:" << table_path
+            << " feasign_size: " << feasign_size_all
+            << " deleted_size: " << deleted_size_all;
+  return 0;
+}
+
+int32_t MemorySparseTable::LoadSnapshot(
+    const std::vector<std::string> &file_list, size_t file_start_idx) {
+#ifdef PADDLE_WITH_HETERPS
+  int thread_num = _real_local_shard_num;
+#else
+  int thread_num = _real_local_shard_num < 15 ? _real_local_shard_num : 15;
+#endif
+  std::atomic<uint64_t> feasign_size_all{0};
+
+  omp_set_num_threads(thread_num);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    FsChannelConfig channel_config = {};
+    channel_config.path = file_list[file_start_idx + i];
+    auto &shard = _local_shards[i];
+    bool is_read_failed = false;
+    int retry_num = 0;
+    int err_no = 0;
+    uint64_t feasign_size = 0;
+    do {
+      is_read_failed = false;
+      err_no = 0;
+      feasign_size = 0;
+      auto read_channel = _afs_client.open_r(channel_config, 0, &err_no);
+      int ret = ReadSparseSnapshot(
+          [&read_channel](char *data, size_t size) -> size_t {
+            int read_size = read_channel->read(data, size);
+            return read_size < 0 ? 0 : read_size;
+          },
+          [&shard, &feasign_size](
+              uint64_t key, const float *value, size_t size) {
+            auto &feature_value = shard[key];
+            feature_value.resize(size);
+            memcpy(feature_value.data(), value, size * sizeof(float));
+            ++feasign_size;
+          },
+          [&shard](uint64_t key) { shard.erase(key); });
+      read_channel->close();
+      // Loading a snapshot again over the values it partly loaded is fine.
+      if (ret != 0 || err_no == -1) {
+        ++retry_num;
+        is_read_failed = true;
+        LOG(ERROR) << "MemorySparseTable load snapshot failed, retry it! path:"
+                   << channel_config.path << " , retry_num=" << retry_num;
+      }
+      if (retry_num > FLAGS_pserver_table_save_max_retry) {
+        LOG(ERROR) << "MemorySparseTable load snapshot failed reach max limit!";
+        exit(-1);
+      }
+    } while (is_read_failed);
+    feasign_size_all += feasign_size;
+  }
+  LOG(INFO) << "MemorySparseTable load snapshot success, path from "
+            << file_list[file_start_idx] << " to "
+            << file_list[file_start_idx + _real_local_shard_num - 1]
+            << " feasign_size: " << feasign_size_all;
+  return 0;
+}
+
 int64_t MemorySparseTable::CacheShuffle(
     const std::string &path,
     const std::string &param,
@@ -962,6 +1202,119 @@ std::pair<int64_t, int64_t> MemorySparseTable::PrintTableStat() {
   return {feasign_size, mf_size};
 }
 
+uint64_t MemorySparseTable::GetHotKeys(
+    std::vector<std::pair<uint64_t, uint64_t>> *hot) {
+  // The pulls served from the hot replica load this server too.
+  uint64_t accesses = _hot_replica_accesses.exchange(0);
+  if (_hot_key_trackers.empty()) {
+    return accesses;
+  }
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> shard_hot(
+      _real_local_shard_num);
+  std::vector<std::future<uint64_t>> tasks(_real_local_shard_num);
+  for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+    tasks[shard_id] =
+        _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
+            [this, shard_id, &shard_hot]() -> uint64_t {
+              return _hot_key_trackers[shard_id]->Report(&shard_hot[shard_id]);
+            });
+  }
+  size_t begin = hot->size();
+  for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
+    accesses += tasks[shard_id].get();
+    hot->insert(
+        hot->end(), shard_hot[shard_id].begin(), shard_hot[shard_id].end());
+  }
+  std::sort(hot->begin() + begin,
+            hot->end(),
+            [](const std::pair<uint64_t, uint64_t> &a,
+               const std::pair<uint64_t, uint64_t> &b) {
+              return a.second > b.second;
+            });
+  if (hot->size() - begin > static_cast<size_t>(FLAGS_pserver_hot_key_num)) {
+    hot->resize(begin + FLAGS_pserver_hot_key_num);
+  }
+  return accesses;
+}
+
+int32_t MemorySparseTable::UpdateHotReplica(const uint64_t *keys,
+                                            const float *select_values,
+                                            size_t num,
+                                            int64_t ttl_ms) {
+  size_t select_value_size =
+      _value_accessor->GetAccessorInfo().select_size / sizeof(float);
+  int64_t now_ms = NowMs();
+  // Other clients may have routed their pulls of the keys of the current
+  // replica here, which is merged into the new one rather than replaced.
+  std::lock_guard<std::mutex> lock(_hot_replica_mutex);
+  auto replica = std::make_shared<HotReplica>();
+  if (_hot_replica != nullptr) {
+    for (auto &item : *_hot_replica) {
+      if (item.second.expire_ms > now_ms) {
+        replica->emplace(item);
+      }
+    }
+  }
+  for (size_t i = 0; i < num; ++i) {
+    if (IsLocalKey(keys[i])) {
+      continue;
+    }
+    auto &value = (*replica)[keys[i]];
+    value.expire_ms = now_ms + ttl_ms;
+    value.select_value.assign(select_values + i * select_value_size,
+                              select_values + (i + 1) * select_value_size);
+  }
+  VLOG(1) << "hot replica of table " << _config.table_id() << ": "
+          << replica->size() << " keys";
+  _hot_replica = replica;
+  return 0;
+}
+
+void MemorySparseTable::PullHotReplica(
+    float *pull_values, const std::vector<std::pair<uint64_t, int>> &keys) {
+  std::shared_ptr<const HotReplica> replica;
+  {
+    std::lock_guard<std::mutex> lock(_hot_replica_mutex);
+    replica = _hot_replica;
+  }
+  const size_t value_size =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t mf_value_size =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+  size_t select_value_size =
+      _value_accessor->GetAccessorInfo().select_size / sizeof(float);
+  int64_t now_ms = NowMs();
+  size_t missed = 0;
+  for (auto &item : keys) {
+    float *select_data = pull_values + select_value_size * item.second;
+    if (replica != nullptr) {
+      auto itr = replica->find(item.first);
+      if (itr != replica->end() && itr->second.expire_ms > now_ms) {
+        memcpy(select_data,
+               itr->second.select_value.data(),
+               select_value_size * sizeof(float));
+        continue;
+      }
+    }
+    // Only a client routing its pulls after the replica expired gets here,
+    // it is answered with a new value which is not stored.
+    ++missed;
+    float data_buffer[value_size];  // NOLINT
+    float *data_buffer_ptr = data_buffer;
+    _value_accessor->Create(&data_buffer_ptr, 1);
+    for (size_t mf_idx = value_size - mf_value_size; mf_idx < value_size;
+         ++mf_idx) {
+      data_buffer[mf_idx] = 0.0;
+    }
+    _value_accessor->Select(&select_data, (const float **)&data_buffer_ptr, 1);
+  }
+  _hot_replica_accesses += keys.size();
+  if (missed > 0) {
+    LOG(WARNING) << "table " << _config.table_id() << ": " << missed
+                 << " pulled keys of other servers are not in the hot replica";
+  }
+}
+
 int32_t MemorySparseTable::Pull(TableContext &context) {
   PADDLE_ENFORCE_EQ(
       context.value_type,
@@ -1013,8 +1366,14 @@ int32_t MemorySparseTable::PullSparse(float *pull_values,
 
   std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
       _real_local_shard_num);
+  // The hot keys of other servers routed here by the clients.
+  std::vector<std::pair<uint64_t, int>> replica_keys;
   size_t num = pull_value.numel_;
   for (size_t i = 0; i < num; ++i) {
+    if (!IsLocalKey(pull_value.feasigns_[i])) {
+      replica_keys.push_back({pull_value.feasigns_[i], i});
+      continue;
+    }
     int shard_id = (pull_value.feasigns_[i] % _sparse_table_shard_num) %
                    _avg_local_shard_num;
     task_keys[shard_id].push_back({pull_value.feasigns_[i], i});
@@ -1034,8 +1393,16 @@ int32_t MemorySparseTable::PullSparse(float *pull_values,
               float *data_buffer_ptr = data_buffer;
 
               auto &keys = task_keys[shard_id];
+              std::vector<std::pair<uint64_t, int>> created_keys;
+              HotKeyTracker *hot_key_tracker =
+                  _hot_key_trackers.empty()
+                      ? nullptr
+                      : _hot_key_trackers[shard_id].get();
               for (auto &item : keys) {
                 uint64_t key = item.first;
+                if (hot_key_tracker != nullptr) {
+                  hot_key_tracker->Add(key);
+                }
                 auto itr = local_shard.find(key);
                 size_t data_size = value_size - mf_value_size;
                 if (itr == local_shard.end()) {
@@ -1043,6 +1410,7 @@ int32_t MemorySparseTable::PullSparse(float *pull_values,
                   if (FLAGS_pserver_create_value_when_push) {
                     memset(data_buffer, 0, sizeof(float) * data_size);
                   } else {
+                    created_keys.push_back(item);
                     auto &feature_value = local_shard[key];
                     feature_value.resize(data_size);
                     float *data_ptr = feature_value.data();
@@ -1064,10 +1432,14 @@ int32_t MemorySparseTable::PullSparse(float *pull_values,
                 _value_accessor->Select(
                     &select_data, (const float **)&data_buffer_ptr, 1);
               }
+              MarkDirty(shard_id, created_keys);
 
               return 0;
             });
   }
+  if (!replica_keys.empty()) {
+    PullHotReplica(pull_values, replica_keys);
+  }
 
   for (auto &task : tasks) {
     task.wait();
@@ -1125,6 +1497,7 @@ int32_t MemorySparseTable::PullSparsePtr(int shard_id,  // fake num
                 int pull_data_idx = item.second;
                 pull_values[pull_data_idx] = reinterpret_cast<char *>(ret);
               }
+              MarkDirty(shard_id, keys);
               return 0;
             });
   }
@@ -1215,6 +1588,7 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
                      new_size * sizeof(float));
             }
           }
+          MarkDirty(shard_id, keys);
           return 0;
         });
   }
@@ -1283,6 +1657,7 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
               memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
             }
           }
+          MarkDirty(shard_id, keys);
           return 0;
         });
   }
@@ -1305,14 +1680,26 @@ int32_t MemorySparseTable::Shrink(const std::string &param) {
     // Shrink
     int feasign_size = 0;
     auto &shard = _local_shards[shard_id];
+    std::vector<uint64_t> shrunk_keys;
     for (auto it = shard.begin(); it != shard.end();) {
       if (_value_accessor->Shrink(it.value().data())) {
+        if (FLAGS_pserver_sparse_snapshot_track_delta) {
+          shrunk_keys.push_back(it.key());
+        }
         it = shard.erase(it);
         ++feasign_size;
       } else {
         ++it;
       }
     }
+    if (!shrunk_keys.empty()) {
+      auto &shard_delta = _shard_deltas[shard_id];
+      std::lock_guard<std::mutex> lock(shard_delta.mutex);
+      for (auto key : shrunk_keys) {
+        shard_delta.dirty_keys.erase(key);
+        shard_delta.deleted_keys.insert(key);
+      }
+    }
     shrink_size_all += feasign_size;
   }
   VLOG(0) << "MemorySparseTable::Shrink success, shrink size:"
@@ -18,10 +18,12 @@
 #include <assert.h>
 #include <pthread.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -29,6 +31,8 @@
 #include "paddle/fluid/distributed/ps/table/accessor.h"
 #include "paddle/fluid/distributed/ps/table/common_table.h"
 #include "paddle/fluid/distributed/ps/table/depends/feature_value.h"
+#include "paddle/fluid/distributed/ps/table/depends/hot_key_tracker.h"
+#include "paddle/fluid/distributed/ps/table/depends/sparse_snapshot.h"
 #include "paddle/utils/string/string_helper.h"
 
 #define PSERVER_SAVE_SUFFIX ".shard"
@@ -91,6 +95,12 @@ class MemorySparseTable : public Table {
   int64_t LocalMFSize();
 
   std::pair<int64_t, int64_t> PrintTableStat() override;
+  uint64_t GetHotKeys(
+      std::vector<std::pair<uint64_t, uint64_t>>* hot) override;
+  int32_t UpdateHotReplica(const uint64_t* keys,
+                           const float* select_values,
+                           size_t num,
+                           int64_t ttl_ms) override;
   int32_t PullSparse(float* values, const PullSparseValue& pull_value);
 
   int32_t PullSparsePtr(int shard_id,
@@ -119,6 +129,26 @@ class MemorySparseTable : public Table {
   virtual int32_t LoadPatch(const std::vector<std::string>& file_list,
                             int save_param);
 
+  // Binary snapshots, save_param 6 saves all the values and 7 only those
+  // updated or deleted since the previous snapshot, see SaveSnapshot.
+  int32_t SaveSnapshot(const std::string& path, int save_param);
+  int32_t LoadSnapshot(const std::vector<std::string>& file_list,
+                       size_t file_start_idx);
+  // Copies the values to save out of the shard, on its task thread.
+  void SnapshotShard(int shard_id, bool delta, SparseShardSnapshot* snapshot);
+  // Records the keys the shard has updated since the last snapshot.
+  void MarkDirty(int shard_id,
+                 const std::vector<std::pair<uint64_t, int>>& keys);
+  void ClearDirty();
+  bool IsLocalKey(uint64_t key) const {
+    return (key % _sparse_table_shard_num) / _avg_local_shard_num ==
+           static_cast<int>(_shard_idx);
+  }
+  // Copies the select values of the keys owned by other servers from the
+  // hot replica, or those of a new value when they are not there.
+  void PullHotReplica(float* pull_values,
+                      const std::vector<std::pair<uint64_t, int>>& keys);
+
   int _task_pool_size = 24;
   int _avg_local_shard_num;
   int _real_local_shard_num;
@@ -137,6 +167,30 @@ class MemorySparseTable : public Table {
   std::unique_ptr<shard_type[]> _local_shards_patch_model;
   std::thread _save_patch_model_thread;
   bool _use_gpu_graph = false;
+
+  // The keys updated and deleted since the last snapshot of each shard, when
+  // FLAGS_pserver_sparse_snapshot_track_delta is set.
+  struct ShardDelta {
+    std::mutex mutex;
+    std::unordered_set<uint64_t> dirty_keys;
+    std::unordered_set<uint64_t> deleted_keys;
+  };
+  std::unique_ptr<ShardDelta[]> _shard_deltas;
+
+  // The accesses of the keys of each shard, when FLAGS_pserver_hot_key_num
+  // is set.
+  std::vector<std::unique_ptr<HotKeyTracker>> _hot_key_trackers;
+  // The select values of the hot keys of other servers this server serves
+  // the pulls of, each until its expire_ms. Replaced as a whole, so that a
+  // pull reads it without lock.
+  struct HotReplicaValue {
+    int64_t expire_ms;
+    std::vector<float> select_value;
+  };
+  typedef std::unordered_map<uint64_t, HotReplicaValue> HotReplica;
+  std::mutex _hot_replica_mutex;
+  std::shared_ptr<const HotReplica> _hot_replica;
+  std::atomic<uint64_t> _hot_replica_accesses{0};
 };
 
 }  // namespace distributed
@@ -14,6 +14,12 @@
 
 #include "paddle/fluid/distributed/ps/table/sparse_sgd_rule.h"
 
+#include <cmath>
+
+#ifdef PADDLE_WITH_AVX
+#include <immintrin.h>
+#endif
+
 #include "glog/logging.h"
 
 #include "paddle/common/flags.h"
@@ -24,6 +30,33 @@ PD_DEFINE_bool(enable_show_scale_gradient, true, "enable show scale gradient");
 
 namespace paddle::distributed {
 
+#ifdef PADDLE_WITH_AVX
+namespace {
+
+constexpr size_t kAvxFloatNum = 8;
+
+// Clamps as BoundValue does: max_ps returns its second operand when the
+// first is NaN, so that a NaN weight goes to the min bound too.
+inline __m256 BoundValue8(__m256 w, __m256 min_bound, __m256 max_bound) {
+  return _mm256_min_ps(_mm256_max_ps(w, min_bound), max_bound);
+}
+
+inline __m256d LowToDouble(__m256 x) {
+  return _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+}
+
+inline __m256d HighToDouble(__m256 x) {
+  return _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1));
+}
+
+inline __m256 ToFloat(__m256d low, __m256d high) {
+  return _mm256_insertf128_ps(
+      _mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1);
+}
+
+}  // namespace
+#endif
+
 void SparseNaiveSGDRule::LoadConfig(const SparseCommonSGDRuleParameter &param,
                                     size_t emb_dim) {
   _embedding_dim = emb_dim;
@@ -99,11 +132,42 @@ void SparseAdaGradSGDRule::UpdateValueWork(float *w,
                                            float scale) {
   float &g2sum = sgd[G2SumIndex()];
   double add_g2sum = 0;
-
-  for (size_t i = 0; i < _embedding_dim; i++) {
+  // Hoisted by hand, w may alias g2sum as far as the compiler knows.
+  double g2sum_ratio = sqrt(_initial_g2sum / (_initial_g2sum + g2sum));
+
+  size_t i = 0;
+#ifdef PADDLE_WITH_AVX
+  // In double as the scalar loop, 8 dims at a time. The squares are added
+  // to add_g2sum one by one, in the order of the scalar loop.
+  const __m256 scale8 = _mm256_set1_ps(scale);
+  const __m256 min_bound8 = _mm256_set1_ps(_min_bound);
+  const __m256 max_bound8 = _mm256_set1_ps(_max_bound);
+  const __m256d lr4 = _mm256_set1_pd(learning_rate_);
+  const __m256d ratio4 = _mm256_set1_pd(g2sum_ratio);
+  double squares[kAvxFloatNum];
+  for (; i + kAvxFloatNum <= _embedding_dim; i += kAvxFloatNum) {
+    __m256 scaled_grad = _mm256_div_ps(_mm256_loadu_ps(grad + i), scale8);
+    __m256 w8 = _mm256_loadu_ps(w + i);
+    __m256d grad_low = LowToDouble(scaled_grad);
+    __m256d grad_high = HighToDouble(scaled_grad);
+    __m256d w_low = _mm256_sub_pd(
+        LowToDouble(w8),
+        _mm256_mul_pd(_mm256_mul_pd(lr4, grad_low), ratio4));
+    __m256d w_high = _mm256_sub_pd(
+        HighToDouble(w8),
+        _mm256_mul_pd(_mm256_mul_pd(lr4, grad_high), ratio4));
+    _mm256_storeu_ps(
+        w + i, BoundValue8(ToFloat(w_low, w_high), min_bound8, max_bound8));
+    _mm256_storeu_pd(squares, _mm256_mul_pd(grad_low, grad_low));
+    _mm256_storeu_pd(squares + 4, _mm256_mul_pd(grad_high, grad_high));
+    for (double square : squares) {
+      add_g2sum += square;
+    }
+  }
+#endif
+  for (; i < _embedding_dim; i++) {
     double scaled_grad = grad[i] / scale;
-    w[i] -= learning_rate_ * scaled_grad *
-            sqrt(_initial_g2sum / (_initial_g2sum + g2sum));
+    w[i] -= learning_rate_ * scaled_grad * g2sum_ratio;
     BoundValue(w[i]);
     add_g2sum += scaled_grad * scaled_grad;
   }
@@ -223,12 +287,43 @@ void SparseAdamSGDRule::UpdateValueWork(float *w,
   float beta2_pow_ = *beta2_pow;
 
   lr *= sqrt(1 - beta2_pow_) / (1 - beta1_pow_);
-  for (size_t i = 0; i < _embedding_dim; i++) {
+  size_t i = 0;
+#ifdef PADDLE_WITH_AVX
+  // The same float operations as the scalar loop, which takes the float
+  // std::sqrt, 8 dims at a time.
+  const __m256 beta1 = _mm256_set1_ps(_beta1_decay_rate);
+  const __m256 beta1_rest = _mm256_set1_ps(1 - _beta1_decay_rate);
+  const __m256 beta2 = _mm256_set1_ps(_beta2_decay_rate);
+  const __m256 beta2_rest = _mm256_set1_ps(1 - _beta2_decay_rate);
+  const __m256 lr8 = _mm256_set1_ps(lr);
+  const __m256 epsilon8 = _mm256_set1_ps(_ada_epsilon);
+  const __m256 min_bound8 = _mm256_set1_ps(_min_bound);
+  const __m256 max_bound8 = _mm256_set1_ps(_max_bound);
+  for (; i + kAvxFloatNum <= _embedding_dim; i += kAvxFloatNum) {
+    __m256 g8 = _mm256_loadu_ps(g + i);
+    __m256 gsum8 =
+        _mm256_add_ps(_mm256_mul_ps(beta1, _mm256_loadu_ps(gsum + i)),
+                      _mm256_mul_ps(beta1_rest, g8));
+    __m256 g2sum8 =
+        _mm256_add_ps(_mm256_mul_ps(beta2, _mm256_loadu_ps(g2sum + i)),
+                      _mm256_mul_ps(_mm256_mul_ps(beta2_rest, g8), g8));
+    __m256 w8 = _mm256_sub_ps(
+        _mm256_loadu_ps(w + i),
+        _mm256_mul_ps(
+            lr8,
+            _mm256_div_ps(gsum8,
+                          _mm256_add_ps(_mm256_sqrt_ps(g2sum8), epsilon8))));
+    _mm256_storeu_ps(gsum + i, gsum8);
+    _mm256_storeu_ps(g2sum + i, g2sum8);
+    _mm256_storeu_ps(w + i, BoundValue8(w8, min_bound8, max_bound8));
+  }
+#endif
+  for (; i < _embedding_dim; i++) {
     // Calculation
     gsum[i] = _beta1_decay_rate * gsum[i] + (1 - _beta1_decay_rate) * g[i];
     g2sum[i] =
         _beta2_decay_rate * g2sum[i] + (1 - _beta2_decay_rate) * g[i] * g[i];
-    w[i] = w[i] - lr * (gsum[i] / (sqrt(g2sum[i]) + _ada_epsilon));
+    w[i] = w[i] - lr * (gsum[i] / (std::sqrt(g2sum[i]) + _ada_epsilon));
     BoundValue(w[i]);
   }
   // update beta_pow_decay
@@ -25,6 +25,21 @@ PD_DECLARE_bool(pserver_create_value_when_push);
 PD_DECLARE_bool(pserver_enable_create_feasign_randomly);
 PD_DEFINE_bool(pserver_open_strict_check, false, "pserver_open_strict_check");
 PD_DEFINE_int32(pserver_load_batch_size, 5000, "load batch size for ssd");
+PD_DEFINE_int64(pserver_ssd_mem_budget_mb,
+                0,
+                "memory budget in MB of the values kept in memory by a ssd "
+                "sparse table, enforced by CacheTable, 0 for no budget");
+PD_DEFINE_int32(pserver_ssd_admission_threshold,
+                0,
+                "accesses a value read from ssd by PullSparse needs, counting "
+                "this one, to be moved to memory, 0 to always move it");
+PD_DEFINE_int32(pserver_ssd_sketch_width,
+                1 << 18,
+                "counters per row of the access sketch of a ssd sparse table "
+                "shard");
+PD_DEFINE_int32(pserver_ssd_multi_get_batch_size,
+                1024,
+                "keys per rocksdb multi get of PullSparsePtr");
 PHI_DEFINE_EXPORTED_string(rocksdb_path,
                            "database",
                            "path of sparse table rocksdb file");
@@ -36,6 +51,14 @@ int32_t SSDSparseTable::Initialize() {
   MemorySparseTable::Initialize();
   _db = ::paddle::distributed::RocksDBHandler::GetInstance();
   _db->initialize(FLAGS_rocksdb_path, _real_local_shard_num);
+  _tier_stats = std::vector<TierStat>(_real_local_shard_num);
+  if (FLAGS_pserver_ssd_mem_budget_mb > 0 ||
+      FLAGS_pserver_ssd_admission_threshold > 0) {
+    for (int i = 0; i < _real_local_shard_num; ++i) {
+      _sketches.emplace_back(
+          std::make_unique<CountMinSketch>(FLAGS_pserver_ssd_sketch_width));
+    }
+  }
   VLOG(0) << "initialize SSDSparseTable succ";
   VLOG(0) << "SSD FLAGS_pserver_print_missed_key_num_every_push:"
           << FLAGS_pserver_print_missed_key_num_every_push;
@@ -125,8 +148,10 @@ int32_t SSDSparseTable::PullSparse(float* pull_values,
                 auto& local_shard = _local_shards[shard_id];
                 float data_buffer[value_size];  // NOLINT
                 float* data_buffer_ptr = data_buffer;
+                auto& stat = _tier_stats[shard_id];
                 for (size_t i = 0; i < keys.size(); ++i) {
                   uint64_t key = keys[i].first;
+                  RecordAccess(shard_id, key);
                   auto itr = local_shard.find(key);
                   size_t data_size = value_size - mf_value_size;
                   if (itr == local_shard.end()) {
@@ -137,6 +162,7 @@ int32_t SSDSparseTable::PullSparse(float* pull_values,
                                  sizeof(uint64_t),
                                  tmp_string) > 0) {
                       ++missed_keys;
+                      stat.misses.fetch_add(1, std::memory_order_relaxed);
                       if (FLAGS_pserver_create_value_when_push) {
                         memset(data_buffer, 0, sizeof(float) * data_size);
                       } else {
@@ -150,21 +176,28 @@ int32_t SSDSparseTable::PullSparse(float* pull_values,
                                data_size * sizeof(float));
                       }
                     } else {
+                      stat.ssd_hits.fetch_add(1, std::memory_order_relaxed);
                       data_size = tmp_string.size() / sizeof(float);
                       memcpy(data_buffer_ptr,
                              ::paddle::string::str_to_float(tmp_string),
                              data_size * sizeof(float));
-                      // from rocksdb to mem
-                      auto& feature_value = local_shard[key];
-                      feature_value.resize(data_size);
-                      memcpy(const_cast<float*>(feature_value.data()),
-                             data_buffer_ptr,
-                             data_size * sizeof(float));
-                      _db->del_data(shard_id,
-                                    reinterpret_cast<char*>(&key),
-                                    sizeof(uint64_t));
+                      if (Admit(shard_id, key)) {
+                        // from rocksdb to mem
+                        auto& feature_value = local_shard[key];
+                        feature_value.resize(data_size);
+                        memcpy(const_cast<float*>(feature_value.data()),
+                               data_buffer_ptr,
+                               data_size * sizeof(float));
+                        _db->del_data(shard_id,
+                                      reinterpret_cast<char*>(&key),
+                                      sizeof(uint64_t));
+                      } else {
+                        stat.ssd_bypasses.fetch_add(1,
+                                                    std::memory_order_relaxed);
+                      }
                     }
                   } else {
+                    stat.mem_hits.fetch_add(1, std::memory_order_relaxed);
                     data_size = itr.value().size();
                     memcpy(data_buffer_ptr,
                            itr.value().data(),
@@ -201,145 +234,91 @@ int32_t SSDSparseTable::PullSparsePtr(int shard_id,
                                       uint16_t pass_id) {
   CostTimer timer("pserver_ssd_sparse_select_all");
   size_t value_size = _value_accessor->GetAccessorInfo().size / sizeof(float);
-  size_t mf_value_size =
-      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+  size_t batch_size =
+      std::max(FLAGS_pserver_ssd_multi_get_batch_size, static_cast<int32_t>(1));
 
   {  // 从table取值 or create
+    // The keys missing from memory are read from rocksdb by batches on the
+    // shard task pool, the next batch being filled while one is read.
     RocksDBCtx context;
-    std::vector<std::future<int>> tasks;
+    std::future<int> reading;
     RocksDBItem* cur_ctx = context.switch_item();
     cur_ctx->reset();
-    FixedFeatureValue* ret = nullptr;
     auto& local_shard = _local_shards[shard_id];
+    auto& stat = _tier_stats[shard_id];
     float data_buffer[value_size];  // NOLINT
-    float* data_buffer_ptr = data_buffer;
+
+    auto set_value = [&](size_t pull_data_idx, FixedFeatureValue* ret) {
+      _value_accessor->UpdateTimeDecay(ret->data(), true);
+#ifdef PADDLE_WITH_PSLIB
+      _value_accessor->UpdatePassId(ret->data(), pass_id);
+#endif
+      pull_values[pull_data_idx] = reinterpret_cast<char*>(ret);
+    };
+    auto promote_batch = [&](RocksDBItem* item) {
+      for (size_t idx = 0; idx < item->status.size(); idx++) {
+        uint64_t cur_key =
+            *(reinterpret_cast<const uint64_t*>(item->batch_keys[idx].data()));
+        set_value(item->batch_index[idx],
+                  PromoteValue(shard_id,
+                               cur_key,
+                               item->status[idx],
+                               item->batch_values[idx],
+                               data_buffer));
+      }
+      item->reset();
+    };
+    auto read_batch = [this, shard_id](RocksDBItem* item) {
+      item->batch_values.resize(item->batch_keys.size());
+      item->status.resize(item->batch_keys.size());
+      return _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
+          [this, shard_id, item]() -> int {
+            // The keys are in pull order, not sorted.
+            _db->multi_get(shard_id,
+                           item->batch_keys.size(),
+                           item->batch_keys.data(),
+                           item->batch_values.data(),
+                           item->status.data(),
+                           false);
+            return 0;
+          });
+    };
 
     for (size_t i = 0; i < num; ++i) {
       uint64_t key = pull_keys[i];
+      RecordAccess(shard_id, key);
       auto itr = local_shard.find(key);
-      if (itr == local_shard.end()) {
-        cur_ctx->batch_index.push_back(i);
-        cur_ctx->batch_keys.emplace_back(
-            reinterpret_cast<const char*>(&(pull_keys[i])), sizeof(uint64_t));
-        if (cur_ctx->batch_keys.size() == 1024) {
-          cur_ctx->batch_values.resize(cur_ctx->batch_keys.size());
-          cur_ctx->status.resize(cur_ctx->batch_keys.size());
-          auto fut =
-              _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
-                  [this, shard_id, cur_ctx]() -> int {
-                    _db->multi_get(shard_id,
-                                   cur_ctx->batch_keys.size(),
-                                   cur_ctx->batch_keys.data(),
-                                   cur_ctx->batch_values.data(),
-                                   cur_ctx->status.data());
-                    return 0;
-                  });
-          cur_ctx = context.switch_item();
-          for (size_t x = 0; x < tasks.size(); ++x) {
-            tasks[x].wait();
-            for (size_t idx = 0; idx < cur_ctx->status.size(); idx++) {
-              uint64_t cur_key = *(reinterpret_cast<uint64_t*>(
-                  const_cast<char*>(cur_ctx->batch_keys[idx].data())));
-              if (cur_ctx->status[idx].IsNotFound()) {
-                auto& feature_value = local_shard[cur_key];
-                int init_size = value_size - mf_value_size;
-                feature_value.resize(init_size);
-                _value_accessor->Create(&data_buffer_ptr, 1);
-                memcpy(const_cast<float*>(feature_value.data()),
-                       data_buffer_ptr,
-                       init_size * sizeof(float));
-                ret = &feature_value;
-              } else {
-                int data_size =
-                    cur_ctx->batch_values[idx].size() / sizeof(float);
-                // from rocksdb to mem
-                auto& feature_value = local_shard[cur_key];
-                feature_value.resize(data_size);
-                memcpy(const_cast<float*>(feature_value.data()),
-                       ::paddle::string::str_to_float(
-                           cur_ctx->batch_values[idx].data()),
-                       data_size * sizeof(float));
-                _db->del_data(shard_id,
-                              reinterpret_cast<char*>(&cur_key),
-                              sizeof(uint64_t));
-                ret = &feature_value;
-              }
-
-              _value_accessor->UpdateTimeDecay(ret->data(), true);
-#ifdef PADDLE_WITH_PSLIB
-              _value_accessor->UpdatePassId(ret->data(), pass_id);
-#endif
-              int pull_data_idx = cur_ctx->batch_index[idx];
-              pull_values[pull_data_idx] = reinterpret_cast<char*>(ret);
-            }
-          }
-          cur_ctx->reset();
-          tasks.clear();
-          tasks.push_back(std::move(fut));
+      if (itr != local_shard.end()) {
+        stat.mem_hits.fetch_add(1, std::memory_order_relaxed);
+        set_value(i, itr.value_ptr());
+        continue;
+      }
+      cur_ctx->batch_index.push_back(i);
+      cur_ctx->batch_keys.emplace_back(
+          reinterpret_cast<const char*>(&(pull_keys[i])), sizeof(uint64_t));
+      if (cur_ctx->batch_keys.size() == batch_size) {
+        auto fut = read_batch(cur_ctx);
+        // Promotes the previous batch while this one is read.
+        cur_ctx = context.switch_item();
+        if (reading.valid()) {
+          reading.wait();
         }
-      } else {
-        ret = itr.value_ptr();
-        // int pull_data_idx = keys[i].second;
-        _value_accessor->UpdateTimeDecay(ret->data(), true);
-#ifdef PADDLE_WITH_PSLIB
-        _value_accessor->UpdatePassId(ret->data(), pass_id);
-#endif
-        pull_values[i] = reinterpret_cast<char*>(ret);
+        promote_batch(cur_ctx);
+        reading = std::move(fut);
       }
     }
+    std::future<int> last;
     if (!cur_ctx->batch_keys.empty()) {
-      cur_ctx->batch_values.resize(cur_ctx->batch_keys.size());
-      cur_ctx->status.resize(cur_ctx->batch_keys.size());
-      auto fut =
-          _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
-              [this, shard_id, cur_ctx]() -> int {
-                _db->multi_get(shard_id,
-                               cur_ctx->batch_keys.size(),
-                               cur_ctx->batch_keys.data(),
-                               cur_ctx->batch_values.data(),
-                               cur_ctx->status.data());
-                return 0;
-              });
-      tasks.push_back(std::move(fut));
+      last = read_batch(cur_ctx);
     }
-    for (size_t x = 0; x < tasks.size(); ++x) {
-      tasks[x].wait();
+    if (reading.valid()) {
+      reading.wait();
+    }
+    if (last.valid()) {
+      last.wait();
     }
     for (size_t x = 0; x < 2; x++) {
-      cur_ctx = context.switch_item();
-      for (size_t idx = 0; idx < cur_ctx->status.size(); idx++) {
-        uint64_t cur_key = *(reinterpret_cast<uint64_t*>(
-            const_cast<char*>(cur_ctx->batch_keys[idx].data())));
-        if (cur_ctx->status[idx].IsNotFound()) {
-          auto& feature_value = local_shard[cur_key];
-          int init_size = value_size - mf_value_size;
-          feature_value.resize(init_size);
-          _value_accessor->Create(&data_buffer_ptr, 1);
-          memcpy(const_cast<float*>(feature_value.data()),
-                 data_buffer_ptr,
-                 init_size * sizeof(float));
-          ret = &feature_value;
-        } else {
-          int data_size = cur_ctx->batch_values[idx].size() / sizeof(float);
-          // from rocksdb to mem
-          auto& feature_value = local_shard[cur_key];
-          feature_value.resize(data_size);
-          memcpy(
-              const_cast<float*>(feature_value.data()),
-              ::paddle::string::str_to_float(cur_ctx->batch_values[idx].data()),
-              data_size * sizeof(float));
-          _db->del_data(
-              shard_id, reinterpret_cast<char*>(&cur_key), sizeof(uint64_t));
-          ret = &feature_value;
-        }
-        _value_accessor->UpdateTimeDecay(ret->data(), true);
-#ifdef PADDLE_WITH_PSLIB
-        _value_accessor->UpdatePassId(ret->data(), pass_id);
-#endif
-        int pull_data_idx = cur_ctx->batch_index[idx];
-        pull_values[pull_data_idx] = reinterpret_cast<char*>(ret);
-      }
-      cur_ctx->reset();
+      promote_batch(context.switch_item());
     }
   }
   return 0;
@@ -383,6 +362,13 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
                   const float* update_data =
                       values + push_data_idx * update_value_col;
                   auto itr = local_shard.find(key);
+                  // The values PullSparse did not admit to memory are still
+                  // on ssd.
+                  if (itr == local_shard.end() &&
+                      FLAGS_pserver_ssd_admission_threshold > 0 &&
+                      LoadFromSSD(shard_id, key) != nullptr) {
+                    itr = local_shard.find(key);
+                  }
                   if (itr == local_shard.end()) {
                     if (FLAGS_pserver_enable_create_feasign_randomly &&
                         !_value_accessor->CreateValue(1, update_data)) {
@@ -483,6 +469,13 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
                   uint64_t push_data_idx = keys[i].second;
                   const float* update_data = values[push_data_idx];
                   auto itr = local_shard.find(key);
+                  // The values PullSparse did not admit to memory are still
+                  // on ssd.
+                  if (itr == local_shard.end() &&
+                      FLAGS_pserver_ssd_admission_threshold > 0 &&
+                      LoadFromSSD(shard_id, key) != nullptr) {
+                    itr = local_shard.find(key);
+                  }
                   if (itr == local_shard.end()) {
                     if (FLAGS_pserver_enable_create_feasign_randomly &&
                         !_value_accessor->CreateValue(1, update_data)) {
@@ -530,6 +523,105 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
   return 0;
 }
 
+bool SSDSparseTable::Admit(int shard_id, uint64_t key) {
+  if (FLAGS_pserver_ssd_admission_threshold <= 0) {
+    return true;
+  }
+  return _sketches[shard_id]->Estimate(key) >=
+         static_cast<uint32_t>(FLAGS_pserver_ssd_admission_threshold);
+}
+
+FixedFeatureValue* SSDSparseTable::LoadFromSSD(int shard_id, uint64_t key) {
+  std::string tmp_string("");
+  if (_db->get(shard_id,
+               reinterpret_cast<char*>(&key),
+               sizeof(uint64_t),
+               tmp_string) > 0) {
+    return nullptr;
+  }
+  size_t data_size = tmp_string.size() / sizeof(float);
+  auto& feature_value = _local_shards[shard_id][key];
+  feature_value.resize(data_size);
+  memcpy(feature_value.data(),
+         ::paddle::string::str_to_float(tmp_string),
+         data_size * sizeof(float));
+  _db->del_data(shard_id, reinterpret_cast<char*>(&key), sizeof(uint64_t));
+  return &feature_value;
+}
+
+FixedFeatureValue* SSDSparseTable::PromoteValue(
+    int shard_id,
+    uint64_t key,
+    const rocksdb::Status& status,
+    const rocksdb::PinnableSlice& value,
+    float* data_buffer) {
+  auto& local_shard = _local_shards[shard_id];
+  // A key pulled twice is promoted by its first occurrence.
+  auto itr = local_shard.find(key);
+  if (itr != local_shard.end()) {
+    return itr.value_ptr();
+  }
+  auto& stat = _tier_stats[shard_id];
+  auto& feature_value = local_shard[key];
+  if (status.IsNotFound()) {
+    stat.misses.fetch_add(1, std::memory_order_relaxed);
+    size_t init_size = (_value_accessor->GetAccessorInfo().size -
+                        _value_accessor->GetAccessorInfo().mf_size) /
+                       sizeof(float);
+    feature_value.resize(init_size);
+    _value_accessor->Create(&data_buffer, 1);
+    memcpy(feature_value.data(), data_buffer, init_size * sizeof(float));
+  } else {
+    stat.ssd_hits.fetch_add(1, std::memory_order_relaxed);
+    // from rocksdb to mem
+    size_t data_size = value.size() / sizeof(float);
+    feature_value.resize(data_size);
+    memcpy(feature_value.data(),
+           ::paddle::string::str_to_float(value.data()),
+           data_size * sizeof(float));
+    _db->del_data(shard_id, reinterpret_cast<char*>(&key), sizeof(uint64_t));
+  }
+  return &feature_value;
+}
+
+void SSDSparseTable::SelectBudgetEvictions(
+    int shard_id,
+    const std::vector<shard_type::map_type::iterator>& kept,
+    std::vector<shard_type::map_type::iterator>* demoted) {
+  // The bytes of a value in memory, with its key and slot in the shard.
+  auto value_bytes = [](const shard_type::map_type::iterator& it) {
+    auto* value = (FixedFeatureValue*)(void*)(it->second);  // NOLINT
+    return value->size() * sizeof(float) + sizeof(FixedFeatureValue) +
+           sizeof(*it);
+  };
+  size_t budget = static_cast<size_t>(FLAGS_pserver_ssd_mem_budget_mb) *
+                  1024 * 1024 / std::max(_real_local_shard_num, 1);
+  size_t bytes = 0;
+  for (auto& it : kept) {
+    bytes += value_bytes(it);
+  }
+  if (bytes <= budget) {
+    return;
+  }
+  // Evicts the least frequently accessed first, the sketch halving its
+  // counters regularly so that the recent accesses weigh the most.
+  std::vector<std::pair<uint32_t, size_t>> order;
+  order.reserve(kept.size());
+  for (size_t i = 0; i < kept.size(); ++i) {
+    order.emplace_back(_sketches[shard_id]->Estimate(kept[i]->first), i);
+  }
+  std::sort(order.begin(), order.end());
+  size_t evicted = 0;
+  for (size_t i = 0; i < order.size() && bytes > budget; ++i) {
+    auto& it = kept[order[i].second];
+    bytes -= value_bytes(it);
+    demoted->push_back(it);
+    ++evicted;
+  }
+  _tier_stats[shard_id].budget_evictions.fetch_add(evicted,
+                                                   std::memory_order_relaxed);
+}
+
 int32_t SSDSparseTable::Shrink(const std::string& param) {
   int thread_num = _real_local_shard_num < 20 ? _real_local_shard_num : 20;
   omp_set_num_threads(thread_num);
@@ -3047,6 +3139,29 @@ int32_t SSDSparseTable::LoadWithBinary(const std::string& path, int param) {
 
 std::pair<int64_t, int64_t> SSDSparseTable::PrintTableStat() {
   int64_t feasign_size = LocalSize();
+  uint64_t ssd_key_num = 0;
+  _db->get_estimate_key_num(ssd_key_num);
+  uint64_t mem_hits = 0;
+  uint64_t ssd_hits = 0;
+  uint64_t misses = 0;
+  uint64_t ssd_bypasses = 0;
+  uint64_t budget_evictions = 0;
+  for (auto& stat : _tier_stats) {
+    mem_hits += stat.mem_hits.load(std::memory_order_relaxed);
+    ssd_hits += stat.ssd_hits.load(std::memory_order_relaxed);
+    misses += stat.misses.load(std::memory_order_relaxed);
+    ssd_bypasses += stat.ssd_bypasses.load(std::memory_order_relaxed);
+    budget_evictions += stat.budget_evictions.load(std::memory_order_relaxed);
+  }
+  uint64_t pulls = std::max<uint64_t>(mem_hits + ssd_hits + misses, 1);
+  VLOG(0) << "SSDSparseTable " << _config.table_id()
+          << " mem feasign: " << feasign_size
+          << " ssd feasign(estimate): " << ssd_key_num
+          << " mem_hit_rate: " << static_cast<double>(mem_hits) / pulls
+          << " ssd_hit_rate: " << static_cast<double>(ssd_hits) / pulls
+          << " miss_rate: " << static_cast<double>(misses) / pulls
+          << " ssd_bypasses: " << ssd_bypasses
+          << " budget_evictions: " << budget_evictions;
   return {feasign_size, -1};
 }
 
@@ -3112,12 +3227,18 @@ int32_t SSDSparseTable::CacheTable(uint16_t pass_id) {
             using DataType = shard_type::map_type::iterator;
             std::vector<DataType> datas;
             datas.reserve(shard.size() * 0.8);
+            std::vector<DataType> kept;
             for (auto it = shard.begin(); it != shard.end(); ++it) {
               if (!_value_accessor->SaveMemCache(
                       it.value().data(), 0, show_threshold, pass_id)) {
                 datas.emplace_back(it.it);
+              } else if (FLAGS_pserver_ssd_mem_budget_mb > 0) {
+                kept.emplace_back(it.it);
               }
             }
+            if (FLAGS_pserver_ssd_mem_budget_mb > 0) {
+              SelectBudgetEvictions(shard_id, kept, &datas);
+            }
             count.fetch_add(datas.size(), std::memory_order_relaxed);
             VLOG(0) << "datas size:  " << datas.size();
             {
@@ -3181,12 +3302,25 @@ int32_t SSDSparseTable::CacheTable(uint16_t pass_id) {
               }
             }
 
-            for (auto it = shard.begin(); it != shard.end();) {
-              if (!_value_accessor->SaveMemCache(
-                      it.value().data(), 0, show_threshold, pass_id)) {
-                it = shard.erase(it);
-              } else {
-                ++it;
+            if (FLAGS_pserver_ssd_mem_budget_mb > 0) {
+              // Erasing moves the values of the shard, the keys are copied
+              // first.
+              std::vector<uint64_t> demoted_keys;
+              demoted_keys.reserve(datas.size());
+              for (auto& data : datas) {
+                demoted_keys.push_back(data->first);
+              }
+              for (auto key : demoted_keys) {
+                shard.erase(key);
+              }
+            } else {
+              for (auto it = shard.begin(); it != shard.end();) {
+                if (!_value_accessor->SaveMemCache(
+                        it.value().data(), 0, show_threshold, pass_id)) {
+                  it = shard.erase(it);
+                } else {
+                  ++it;
+                }
               }
             }
           }
@@ -14,7 +14,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include "paddle/common/flags.h"
+#include "paddle/fluid/distributed/ps/table/depends/count_min_sketch.h"
 #include "paddle/fluid/distributed/ps/table/depends/rocksdb_warpper.h"
 #include "paddle/fluid/distributed/ps/table/memory_sparse_table.h"
 
@@ -77,6 +81,13 @@ class SSDSparseTable : public MemorySparseTable {
   int32_t Push(TableContext& context) override;
 
   int32_t PullSparse(float* pull_values, const uint64_t* keys, size_t num);
+  // Only the pulls of MemorySparseTable are served from a hot replica.
+  int32_t UpdateHotReplica(const uint64_t* keys UNUSED,
+                           const float* select_values UNUSED,
+                           size_t num UNUSED,
+                           int64_t ttl_ms UNUSED) override {
+    return -1;
+  }
   int32_t PullSparsePtr(int shard_id,
                         char** pull_values,
                         const uint64_t* keys,
@@ -134,7 +145,48 @@ class SSDSparseTable : public MemorySparseTable {
 
   void SetDayId(int day_id) override;
 
+  // Where the pulls of the table were served from since it was initialized,
+  // summed over the local shards.
+  struct TierStat {
+    std::atomic<uint64_t> mem_hits{0};
+    std::atomic<uint64_t> ssd_hits{0};
+    // Keys found in neither tier.
+    std::atomic<uint64_t> misses{0};
+    // Ssd hits served without being moved to memory, as not accessed often
+    // enough to be admitted.
+    std::atomic<uint64_t> ssd_bypasses{0};
+    // Values moved to ssd by CacheTable to fit the memory budget.
+    std::atomic<uint64_t> budget_evictions{0};
+  };
+
  private:
+  bool UseSketch() const { return !_sketches.empty(); }
+  void RecordAccess(int shard_id, uint64_t key) {
+    if (UseSketch()) {
+      _sketches[shard_id]->Increment(key);
+    }
+  }
+  // Whether a value read from ssd is accessed often enough to be moved to
+  // memory.
+  bool Admit(int shard_id, uint64_t key);
+  // Moves the value of key from ssd to memory, returns nullptr if ssd does
+  // not have it.
+  FixedFeatureValue* LoadFromSSD(int shard_id, uint64_t key);
+  // Moves the value of key read by a multi get to memory, or creates it when
+  // ssd does not have it either.
+  FixedFeatureValue* PromoteValue(int shard_id,
+                                  uint64_t key,
+                                  const rocksdb::Status& status,
+                                  const rocksdb::PinnableSlice& value,
+                                  float* data_buffer);
+  // Appends to demoted the values of the shard kept in memory by
+  // SaveMemCache with the lowest access estimates, until the others fit the
+  // memory budget of the shard.
+  void SelectBudgetEvictions(
+      int shard_id,
+      const std::vector<shard_type::map_type::iterator>& kept,
+      std::vector<shard_type::map_type::iterator>* demoted);
+
   RocksDBHandler* _db;
   int64_t _cache_tk_size;
   double _local_show_threshold{0.0};
@@ -145,6 +197,11 @@ class SSDSparseTable : public MemorySparseTable {
   paddle::framework::AfsWrapper _afs_wrapper;  // afs api wrapper
 #endif
   bool _use_afs_api = false;
+
+  // One per local shard, empty when neither the memory budget nor the
+  // admission threshold is set.
+  std::vector<std::unique_ptr<CountMinSketch>> _sketches;
+  std::vector<TierStat> _tier_stats;
 };
 
 }  // namespace distributed
@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "paddle/common/macros.h"
 #include "paddle/fluid/distributed/common/afs_warpper.h"
@@ -159,6 +160,22 @@ class Table {
   virtual std::pair<int64_t, int64_t> PrintTableStat() { return {0, 0}; }
   virtual int32_t CacheTable(uint16_t pass_id UNUSED) { return 0; }
 
+  // for hot key rebalancing
+  // Appends the hot keys of the table on this server and their accesses
+  // since the last call to hot, and returns the accesses of all the keys.
+  virtual uint64_t GetHotKeys(
+      std::vector<std::pair<uint64_t, uint64_t>> *hot UNUSED) {
+    return 0;
+  }
+  // Serves the pulls of the keys, owned by other servers, with the select
+  // values for ttl_ms milliseconds.
+  virtual int32_t UpdateHotReplica(const uint64_t *keys UNUSED,
+                                   const float *select_values UNUSED,
+                                   size_t num UNUSED,
+                                   int64_t ttl_ms UNUSED) {
+    return -1;
+  }
+
   // for patch model
   virtual void Revert() {}
   virtual void CheckSavePrePatchDone() {}
@@ -30,7 +30,10 @@ namespace distributed {
 class FutureWrapper {
  public:
   FutureWrapper() {}
-  explicit FutureWrapper(std::future<std::string> fut) : fut_(std::move(fut)) {}
+  // a raw future returns the bytes of the response, e.g. of a C++ function
+  // of RpcFunctionRegistry, instead of unpickling them
+  explicit FutureWrapper(std::future<std::string> fut, bool raw = false)
+      : fut_(std::move(fut)), raw_(raw) {}
   py::object wait() {
     // GIL must be released, otherwise fut_.get() blocking will cause the
     // service to fail to process RPC requests, leading to deadlock
@@ -43,6 +46,9 @@ class FutureWrapper {
             "process RPC requests, leading to deadlock"));
     auto s = fut_.get();
     py::gil_scoped_acquire ag;
+    if (raw_) {
+      return py::bytes(s);
+    }
     std::shared_ptr<PythonRpcHandler> python_handler =
         PythonRpcHandler::GetInstance();
     py::object obj = python_handler->Deserialize(py::bytes(s));
@@ -52,6 +58,7 @@ class FutureWrapper {
  private:
   DISABLE_COPY_AND_ASSIGN(FutureWrapper);
   std::future<std::string> fut_;
+  bool raw_{false};
 };
 }  // namespace distributed
 }  // namespace paddle
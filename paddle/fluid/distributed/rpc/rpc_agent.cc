@@ -14,6 +14,7 @@
 
 #include "paddle/fluid/distributed/rpc/rpc_agent.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -29,7 +30,10 @@ const int kMaxRetry = 5;
 const int kCloseWaitMs = 1000;
 std::shared_ptr<RpcAgent> RpcAgent::rpc_agent_instance_ = nullptr;
 
-RpcAgent::RpcAgent(std::string name, std::vector<WorkerInfo> infos) {
+RpcAgent::RpcAgent(std::string name,
+                   std::vector<WorkerInfo> infos,
+                   size_t max_batch_size)
+    : max_batch_size_(max_batch_size) {
   name_ = std::move(name);
   for (const auto &info : infos) {
     name_to_infos_.insert({info.name_, info});
@@ -79,6 +83,13 @@ int RpcAgent::StartClient() {
             info.ip_,
             info.port_));
   }
+  if (max_batch_size_ > 1) {
+    batchers_.clear();
+    for (const auto &channel : channels_) {
+      batchers_.push_back(
+          std::make_shared<RpcBatcher>(channel, max_batch_size_));
+    }
+  }
   VLOG(0) << "Init Channels: " << name_;
   return 0;
 }
@@ -103,20 +114,123 @@ void OnRpcDone::Run() {
           << " latency=" << cntl_.latency_us() << "us";
 }
 
+void OnRpcBatchDone::Run() {
+  // delete this after Run
+  std::unique_ptr<OnRpcBatchDone> self_guard(this);
+  PADDLE_ENFORCE_EQ(
+      cntl_.Failed(), false, common::errors::Fatal(cntl_.ErrorText()));
+  PADDLE_ENFORCE_EQ(
+      response_.responses_size(),
+      static_cast<int>(promises_.size()),
+      common::errors::Fatal("Expected %d responses of the batch, but got %d.",
+                            promises_.size(),
+                            response_.responses_size()));
+  for (size_t i = 0; i < promises_.size(); ++i) {
+    promises_[i]->set_value(response_.responses(static_cast<int>(i)).message());
+  }
+  VLOG(2) << "Received " << promises_.size() << " responses from "
+          << cntl_.remote_side() << " to " << cntl_.local_side()
+          << " latency=" << cntl_.latency_us() << "us";
+  batcher_->OnBatchDone();
+}
+
+std::future<std::string> RpcBatcher::Call(RpcRequest request, int timeout_ms) {
+  auto promise = std::make_shared<std::promise<std::string>>();
+  std::future<std::string> fut = promise->get_future();
+  std::vector<PendingRpc> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back({std::move(request), timeout_ms, promise});
+    if (in_flight_) {
+      return fut;
+    }
+    in_flight_ = true;
+    batch = TakeBatch();
+  }
+  Send(std::move(batch));
+  return fut;
+}
+
+void RpcBatcher::OnBatchDone() {
+  std::vector<PendingRpc> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.empty()) {
+      in_flight_ = false;
+      return;
+    }
+    batch = TakeBatch();
+  }
+  Send(std::move(batch));
+}
+
+std::vector<PendingRpc> RpcBatcher::TakeBatch() {
+  size_t size = std::min(pending_.size(), max_batch_size_);
+  std::vector<PendingRpc> batch;
+  batch.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    batch.push_back(std::move(pending_.front()));
+    pending_.pop_front();
+  }
+  return batch;
+}
+
+void RpcBatcher::Send(std::vector<PendingRpc> batch) {
+  std::vector<std::shared_ptr<std::promise<std::string>>> promises;
+  promises.reserve(batch.size());
+  for (const auto &call : batch) {
+    promises.push_back(call.promise);
+  }
+  // `done` must be allocated on the heap because its life cycle is after
+  // calling done.Run().
+  auto *done = new OnRpcBatchDone(shared_from_this(), std::move(promises));
+  // the batch waits as long as the most patient of its calls
+  int timeout_ms = 0;
+  for (auto &call : batch) {
+    timeout_ms = std::max(timeout_ms, call.timeout_ms);
+    done->request_.add_requests()->Swap(&call.request);
+  }
+  done->cntl_.set_timeout_ms(timeout_ms);
+  RpcBaseService_Stub stub(channel_.get());
+  stub.InvokeRpcBatch(&done->cntl_, &done->request_, &done->response_, done);
+}
+
 std::future<std::string> RpcAgent::InvokeRpc(const std::string &py_func,
                                              const std::string &to,
                                              int timeout_ms = kTimeoutMs) {
+  RpcRequest request;
+  request.set_message(py_func);
+  return Call(to, std::move(request), timeout_ms);
+}
+
+std::future<std::string> RpcAgent::InvokeRpcFunction(
+    const std::string &function,
+    const std::string &msg,
+    const std::string &to,
+    int timeout_ms) {
+  RpcRequest request;
+  request.set_message(msg);
+  request.set_function(function);
+  return Call(to, std::move(request), timeout_ms);
+}
+
+std::future<std::string> RpcAgent::Call(const std::string &to,
+                                        RpcRequest request,
+                                        int timeout_ms) {
   auto it = name_to_infos_.find(to);
   PADDLE_ENFORCE_NE(it,
                     name_to_infos_.end(),
                     common::errors::OutOfRange("Worker %s doesn't exist!", to));
   uint32_t id = it->second.id_;
+  if (!batchers_.empty()) {
+    return batchers_[id]->Call(std::move(request), timeout_ms);
+  }
   auto channel = channels_[id];
   // `done` must be allocated on the heap because its life cycle is after
   // calling done.Run().
   OnRpcDone *done = new OnRpcDone;
   done->cntl_.set_timeout_ms(timeout_ms);
-  done->request_.set_message(py_func);
+  done->request_.Swap(&request);
   std::future<std::string> fut = done->GetFuture();
   RpcBaseService_Stub stub(channel.get());
   stub.InvokeRpc(&done->cntl_, &done->request_, &done->response_, done);
@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <deque>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -59,12 +61,65 @@ class OnRpcDone : public google::protobuf::Closure {
   std::shared_ptr<std::promise<std::string>> promise_;
 };
 
+// A call waiting in RpcBatcher for the batch in flight to return.
+struct PendingRpc {
+  RpcRequest request;
+  int timeout_ms;
+  std::shared_ptr<std::promise<std::string>> promise;
+};
+
+// Batches the calls to one worker: the calls made while a batch is in
+// flight to it wait for the batch to return, then up to max_batch_size of
+// them are sent in one InvokeRpcBatch. A single call is sent at once, so
+// batching only adds latency to the calls that would queue anyway.
+class RpcBatcher : public std::enable_shared_from_this<RpcBatcher> {
+ public:
+  RpcBatcher(std::shared_ptr<brpc::Channel> channel, size_t max_batch_size)
+      : channel_(std::move(channel)), max_batch_size_(max_batch_size) {}
+
+  std::future<std::string> Call(RpcRequest request, int timeout_ms);
+  // Sends the next batch, if any, once the one in flight has returned.
+  void OnBatchDone();
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(RpcBatcher);
+  // Called with mutex_ held and pending_ not empty.
+  std::vector<PendingRpc> TakeBatch();
+  void Send(std::vector<PendingRpc> batch);
+
+  std::shared_ptr<brpc::Channel> channel_;
+  size_t max_batch_size_;
+  std::mutex mutex_;
+  bool in_flight_{false};
+  std::deque<PendingRpc> pending_;
+};
+
+class OnRpcBatchDone : public google::protobuf::Closure {
+ public:
+  OnRpcBatchDone(
+      std::shared_ptr<RpcBatcher> batcher,
+      std::vector<std::shared_ptr<std::promise<std::string>>> promises)
+      : batcher_(std::move(batcher)), promises_(std::move(promises)) {}
+  // set the promise of each call, then send the next batch
+  void Run();
+  RpcBatchResponse response_;
+  RpcBatchRequest request_;
+  brpc::Controller cntl_;
+
+ private:
+  std::shared_ptr<RpcBatcher> batcher_;
+  std::vector<std::shared_ptr<std::promise<std::string>>> promises_;
+};
+
 class RpcAgent {
  public:
   static std::shared_ptr<RpcAgent> RpcAgentInstance();
   static void SetAgentInstance(std::shared_ptr<RpcAgent> agent);
-  // init RpcAgent instance and get information of all services
-  RpcAgent(std::string name, std::vector<WorkerInfo> infos);
+  // init RpcAgent instance and get information of all services, the calls
+  // to a worker are batched by up to max_batch_size
+  RpcAgent(std::string name,
+           std::vector<WorkerInfo> infos,
+           size_t max_batch_size = 1);
   ~RpcAgent() {}
 
   const WorkerInfo &GetWorkerInfo(const std::string &name) const {
@@ -94,13 +149,24 @@ class RpcAgent {
   std::future<std::string> InvokeRpc(const std::string &msg,
                                      const std::string &to,
                                      int timeout_ms);
+  // call the function of RpcFunctionRegistry on msg
+  std::future<std::string> InvokeRpcFunction(const std::string &function,
+                                             const std::string &msg,
+                                             const std::string &to,
+                                             int timeout_ms);
 
  private:
+  std::future<std::string> Call(const std::string &to,
+                                RpcRequest request,
+                                int timeout_ms);
+
   DISABLE_COPY_AND_ASSIGN(RpcAgent);
   static std::shared_ptr<RpcAgent> rpc_agent_instance_;
   brpc::Server server_;
   std::shared_ptr<RpcService> rpc_service_;
   std::vector<std::shared_ptr<brpc::Channel>> channels_;
+  size_t max_batch_size_;
+  std::vector<std::shared_ptr<RpcBatcher>> batchers_;
   std::string name_;
   uint32_t rank_;
   std::unordered_map<std::string, WorkerInfo> name_to_infos_;
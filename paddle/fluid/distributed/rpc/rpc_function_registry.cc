@@ -0,0 +1,54 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/rpc/rpc_function_registry.h"
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle::distributed {
+
+RpcFunctionRegistry &RpcFunctionRegistry::Instance() {
+  static RpcFunctionRegistry registry;
+  return registry;
+}
+
+void RpcFunctionRegistry::Register(const std::string &name,
+                                   RpcFunction func) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  PADDLE_ENFORCE_EQ(
+      functions_.count(name),
+      0,
+      common::errors::AlreadyExists(
+          "RPC function %s has been registered, please don't register it "
+          "repeatedly.",
+          name));
+  functions_.emplace(name, std::move(func));
+}
+
+RpcFunction RpcFunctionRegistry::Get(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = functions_.find(name);
+  PADDLE_ENFORCE_NE(
+      it,
+      functions_.end(),
+      common::errors::NotFound("RPC function %s is not registered.", name));
+  return it->second;
+}
+
+// Returns the request, to measure the cost of a call.
+REGISTER_RPC_FUNCTION(echo, [](const std::string &message) {
+  return message;
+});
+
+}  // namespace paddle::distributed
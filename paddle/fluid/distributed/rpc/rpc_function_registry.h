@@ -0,0 +1,55 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "paddle/common/macros.h"
+
+namespace paddle {
+namespace distributed {
+
+// A C++ target of RPC, called on the bytes of the request and returning the
+// bytes of the response. Unlike a Python function, it is run without the
+// GIL and without pickling.
+using RpcFunction = std::function<std::string(const std::string &)>;
+
+class RpcFunctionRegistry {
+ public:
+  static RpcFunctionRegistry &Instance();
+
+  void Register(const std::string &name, RpcFunction func);
+  RpcFunction Get(const std::string &name) const;
+
+ private:
+  RpcFunctionRegistry() = default;
+  DISABLE_COPY_AND_ASSIGN(RpcFunctionRegistry);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, RpcFunction> functions_;
+};
+
+}  // namespace distributed
+}  // namespace paddle
+
+// Registers func, callable by RPC as rpc_sync(to, "name", args=(bytes,)).
+#define REGISTER_RPC_FUNCTION(name, func)                        \
+  static int __rpc_function_##name##__ UNUSED =                  \
+      (::paddle::distributed::RpcFunctionRegistry::Instance()    \
+           .Register(#name, func),                               \
+       0)
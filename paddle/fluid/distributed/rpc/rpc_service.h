@@ -20,6 +20,7 @@
 
 #include "paddle/fluid/distributed/rpc/python_rpc_handler.h"
 #include "paddle/fluid/distributed/rpc/rpc.pb.h"
+#include "paddle/fluid/distributed/rpc/rpc_function_registry.h"
 
 namespace paddle {
 namespace distributed {
@@ -41,7 +42,35 @@ class RpcService : public RpcBaseService {
             << "] from " << cntl->remote_side() << " to " << cntl->local_side()
             << ": "
             << " (attached=" << cntl->request_attachment() << ")";
-    std::string py_func_str = request->message();
+    Invoke(*request, response);
+  }
+
+  // Runs the requests of a batch in order, see RpcBatcher.
+  virtual void InvokeRpcBatch(google::protobuf::RpcController *cntl_base,
+                              const RpcBatchRequest *request,
+                              RpcBatchResponse *response,
+                              google::protobuf::Closure *done) {
+    brpc::ClosureGuard done_guard(done);
+
+    brpc::Controller *cntl = static_cast<brpc::Controller *>(cntl_base);
+    VLOG(2) << "InvokeRpcBatch API: Received " << request->requests_size()
+            << " requests[log_id=" << cntl->log_id() << "] from "
+            << cntl->remote_side() << " to " << cntl->local_side();
+    for (const auto &req : request->requests()) {
+      Invoke(req, response->add_responses());
+    }
+  }
+
+ private:
+  void Invoke(const RpcRequest &request, RpcResponse *response) {
+    if (request.has_function()) {
+      // A C++ function runs without the GIL.
+      RpcFunction func = RpcFunctionRegistry::Instance().Get(
+          request.function());
+      response->set_message(func(request.message()));
+      return;
+    }
+    std::string py_func_str = request.message();
     std::shared_ptr<PythonRpcHandler> python_handler =
         PythonRpcHandler::GetInstance();
     // acquire gil, because native Python objects are used
@@ -14,6 +14,7 @@ limitations under the License. */
 
 #include <unistd.h>
 
+#include <chrono>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
 
@@ -41,6 +42,9 @@ namespace phi {
 class DenseTensor;
 }  // namespace phi
 
+PD_DECLARE_int32(pserver_pull_sparse_coalesce_window_us);
+PD_DECLARE_int32(pserver_pull_sparse_coalesce_max_keys);
+
 namespace framework = paddle::framework;
 namespace platform = paddle::platform;
 
@@ -301,6 +305,41 @@ void RunBrpcPushSparse() {
     EXPECT_FLOAT_EQ(fea_temp_values[idx], fea_values[idx] - 1.0);
   }
 
+  /*-----------------------Test Coalesced Pull-------------------------------*/
+  // Two threads pull half of the keys each into their own values. The second
+  // pull fills the merged one, which is then sent long before the window
+  // ends.
+  LOG(INFO) << "Run coalesced pull_sparse";
+  FLAGS_pserver_pull_sparse_coalesce_window_us = 10000000;
+  FLAGS_pserver_pull_sparse_coalesce_max_keys = fea_keys.size();
+  std::vector<float> coalesced_values(100);
+  std::vector<float*> coalesced_value_ptr(10);
+  for (size_t idx = 0; idx < fea_keys.size(); ++idx) {
+    coalesced_value_ptr[idx] = coalesced_values.data() + idx * 10;
+  }
+  size_t half = fea_keys.size() / 2;
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> pull_threads;
+  for (size_t t = 0; t < 2; ++t) {
+    pull_threads.emplace_back([&, t] {
+      auto status =
+          worker_ptr_->PullSparse(coalesced_value_ptr.data() + t * half,
+                                  0,
+                                  fea_keys.data() + t * half,
+                                  half,
+                                  true);
+      EXPECT_EQ(status.get(), 0);
+    });
+  }
+  for (auto& pull_thread : pull_threads) {
+    pull_thread.join();
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  for (int64_t idx = 0; idx < tensor->numel(); ++idx) {
+    EXPECT_FLOAT_EQ(coalesced_values[idx], fea_temp_values[idx]);
+  }
+  FLAGS_pserver_pull_sparse_coalesce_window_us = 0;
+
   LOG(INFO) << "Run stop_server";
   worker_ptr_->StopServer();
   LOG(INFO) << "Run finalize_worker";
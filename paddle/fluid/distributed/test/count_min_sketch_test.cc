@@ -0,0 +1,59 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/depends/count_min_sketch.h"
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(CountMinSketch, Estimate) {
+  CountMinSketch sketch(1 << 12);
+  ASSERT_EQ(sketch.width(), 1u << 12);
+  ASSERT_EQ(sketch.Estimate(7), 0u);
+
+  // Few enough increments not to halve the counters.
+  for (uint64_t key = 0; key < 1000; ++key) {
+    for (uint64_t i = 0; i <= key % 10; ++i) {
+      sketch.Increment(key);
+    }
+  }
+  uint64_t exact = 0;
+  for (uint64_t key = 0; key < 1000; ++key) {
+    uint32_t estimate = sketch.Estimate(key);
+    ASSERT_GE(estimate, key % 10 + 1);
+    exact += estimate == key % 10 + 1;
+  }
+  ASSERT_GT(exact, 950u);
+
+  sketch.Clear();
+  ASSERT_EQ(sketch.Estimate(9), 0u);
+}
+
+TEST(CountMinSketch, Aging) {
+  CountMinSketch sketch(64);
+  for (int i = 0; i < 300; ++i) {
+    sketch.Increment(1);
+  }
+  // Saturated.
+  ASSERT_EQ(sketch.Estimate(1), 255u);
+
+  // The other keys eventually halve the counters of the old one.
+  for (uint64_t key = 2; key < 2 + 64 * 8; ++key) {
+    sketch.Increment(key);
+  }
+  ASSERT_LT(sketch.Estimate(1), 255u);
+}
+
+}  // namespace paddle::distributed
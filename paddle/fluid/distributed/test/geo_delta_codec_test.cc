@@ -0,0 +1,71 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/service/geo_delta_codec.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(GeoDeltaCodec, RoundTrip) {
+  const size_t dim = 64;
+  std::vector<float> values(dim);
+  for (size_t i = 0; i < dim; ++i) {
+    values[i] = (static_cast<float>(i) - 32.0f) * 0.01f;
+  }
+  for (auto compress : {GeoDeltaCompress::kNone,
+                        GeoDeltaCompress::kFp16,
+                        GeoDeltaCompress::kInt8}) {
+    std::vector<char> encoded(GeoDeltaRowBytes(compress, dim));
+    std::vector<float> decoded(dim);
+    std::vector<float> received(dim);
+    EncodeGeoDeltaRow(
+        compress, values.data(), dim, encoded.data(), decoded.data());
+    DecodeGeoDeltaRow(compress, encoded.data(), dim, received.data());
+    for (size_t i = 0; i < dim; ++i) {
+      // The encoder knows exactly what the server receives.
+      ASSERT_EQ(decoded[i], received[i]);
+      ASSERT_NEAR(values[i], received[i], 0.32f / 127.0f);
+    }
+  }
+  EXPECT_EQ(GeoDeltaRowBytes(GeoDeltaCompress::kInt8, dim), 4 + dim);
+}
+
+TEST(GeoDeltaCodec, ZeroRow) {
+  const size_t dim = 8;
+  std::vector<float> values(dim, 0.0f);
+  std::vector<char> encoded(GeoDeltaRowBytes(GeoDeltaCompress::kInt8, dim));
+  EncodeGeoDeltaRow(GeoDeltaCompress::kInt8,
+                    values.data(),
+                    dim,
+                    encoded.data(),
+                    values.data());
+  std::vector<float> received(dim, 1.0f);
+  DecodeGeoDeltaRow(
+      GeoDeltaCompress::kInt8, encoded.data(), dim, received.data());
+  for (float value : received) {
+    ASSERT_EQ(value, 0.0f);
+  }
+}
+
+TEST(GeoDeltaCodec, Parse) {
+  EXPECT_EQ(ParseGeoDeltaCompress("none"), GeoDeltaCompress::kNone);
+  EXPECT_EQ(ParseGeoDeltaCompress("fp16"), GeoDeltaCompress::kFp16);
+  EXPECT_EQ(ParseGeoDeltaCompress("int8"), GeoDeltaCompress::kInt8);
+  EXPECT_ANY_THROW(ParseGeoDeltaCompress("int4"));
+}
+
+}  // namespace paddle::distributed
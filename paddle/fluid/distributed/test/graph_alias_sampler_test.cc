@@ -0,0 +1,74 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_weighted_sampler.h"
+
+namespace paddle::distributed {
+
+TEST(AliasSampler, Frequencies) {
+  std::vector<float> weights = {1.0, 2.0, 3.0, 4.0, 0.0};
+  WeightedGraphEdgeBlob edges;
+  for (size_t i = 0; i < weights.size(); ++i) {
+    edges.add_edge(i, weights[i]);
+  }
+  AliasSampler sampler;
+  sampler.build(&edges);
+  auto rng = std::make_shared<std::mt19937_64>(2026);
+  const int num_samples = 100000;
+  std::vector<int> counts(weights.size(), 0);
+  for (int i = 0; i < num_samples; ++i) {
+    auto res = sampler.sample_k(1, rng);
+    ASSERT_EQ(res.size(), 1UL);
+    counts[res[0]]++;
+  }
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_NEAR(counts[i] / static_cast<double>(num_samples),
+                weights[i] / 10.0,
+                0.01);
+  }
+}
+
+TEST(AliasSampler, SampleWithoutReplacement) {
+  WeightedGraphEdgeBlob edges;
+  for (int i = 0; i < 10; ++i) {
+    edges.add_edge(i, i < 2 ? 0.0 : 1.0 + i);
+  }
+  AliasSampler sampler;
+  sampler.build(&edges);
+  auto rng = std::make_shared<std::mt19937_64>(2026);
+  // Up to half of the edges by the alias tables, then by the keys.
+  for (int k : {3, 5, 8}) {
+    for (int t = 0; t < 100; ++t) {
+      auto res = sampler.sample_k(k, rng);
+      ASSERT_EQ(res.size(), static_cast<size_t>(k));
+      std::set<int> unique(res.begin(), res.end());
+      ASSERT_EQ(unique.size(), res.size());
+      // The edges without weight only fill the sample.
+      EXPECT_EQ(unique.count(0) + unique.count(1), 0UL);
+    }
+  }
+  auto res = sampler.sample_k(20, rng);
+  ASSERT_EQ(res.size(), 10UL);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(res[i], i);
+  }
+}
+
+}  // namespace paddle::distributed
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/depends/hot_key_tracker.h"
+
+#include <random>
+#include <set>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(HotKeyTracker, FindsHeavyHitters) {
+  HotKeyTracker tracker(16);
+  std::mt19937_64 rng(0);
+  const int num = 1000000;
+  for (int i = 0; i < num; ++i) {
+    // One access in ten goes to one of 8 hot keys.
+    tracker.Add(rng() % 10 == 0 ? rng() % 8 : rng());
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> hot;
+  ASSERT_EQ(tracker.Report(&hot), static_cast<uint64_t>(num));
+  ASSERT_LE(hot.size(), 16u);
+  std::set<uint64_t> hot_keys;
+  for (auto& item : hot) {
+    if (item.second > num / 200) {
+      hot_keys.insert(item.first);
+    }
+  }
+  EXPECT_EQ(hot_keys, std::set<uint64_t>({0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST(HotKeyTracker, ReportResets) {
+  HotKeyTracker tracker(4);
+  for (int i = 0; i < 100; ++i) {
+    tracker.Add(1);
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> hot;
+  EXPECT_EQ(tracker.Report(&hot), 100u);
+  ASSERT_EQ(hot.size(), 1u);
+  EXPECT_EQ(hot[0].first, 1u);
+  EXPECT_EQ(hot[0].second, 100u);
+
+  hot.clear();
+  tracker.Add(2);
+  EXPECT_EQ(tracker.Report(&hot), 1u);
+  ASSERT_EQ(hot.size(), 1u);
+  EXPECT_EQ(hot[0].first, 2u);
+}
+
+}  // namespace paddle::distributed
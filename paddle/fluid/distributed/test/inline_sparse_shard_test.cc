@@ -0,0 +1,130 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/depends/inline_sparse_shard.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(InlineSparseTableShard, InsertUpdateErase) {
+  InlineSparseTableShard<uint64_t> shard(4);
+  std::vector<float> value(4);
+  ASSERT_EQ(shard.read(1, value.data()), -1);
+
+  // Enough keys to rehash a few times.
+  const uint64_t key_num = 10000;
+  for (uint64_t key = 0; key < key_num; ++key) {
+    float data[2] = {static_cast<float>(key), 0.5};
+    ASSERT_TRUE(shard.insert(key, data, 2));
+  }
+  ASSERT_FALSE(shard.insert(0, value.data(), 2));
+  ASSERT_EQ(shard.size(), key_num);
+  for (uint64_t key = 0; key < key_num; ++key) {
+    ASSERT_EQ(shard.read(key, value.data()), 2);
+    ASSERT_FLOAT_EQ(value[0], static_cast<float>(key));
+    ASSERT_FLOAT_EQ(value[1], 0.5);
+  }
+
+  ASSERT_TRUE(shard.update(3, [](float* data, size_t* size) {
+    data[2] = 2.0;
+    data[3] = 3.0;
+    *size = 4;
+  }));
+  ASSERT_EQ(shard.read(3, value.data()), 4);
+  ASSERT_FLOAT_EQ(value[3], 3.0);
+
+  for (uint64_t key = 1; key < key_num; key += 2) {
+    ASSERT_EQ(shard.erase(key), 1UL);
+  }
+  ASSERT_EQ(shard.erase(1), 0UL);
+  ASSERT_EQ(shard.size(), key_num / 2);
+  ASSERT_EQ(shard.read(3, value.data()), -1);
+  ASSERT_EQ(shard.read(4, value.data()), 2);
+
+  size_t erased = shard.erase_if(
+      [](float* data, size_t) { return static_cast<int>(data[0]) % 4 == 0; });
+  ASSERT_EQ(erased, key_num / 4);
+  size_t count = 0;
+  shard.for_each([&](uint64_t key, float* data, size_t* size) {
+    ASSERT_EQ(key % 4, 2UL);
+    ASSERT_EQ(*size, 2UL);
+    ++count;
+  });
+  ASSERT_EQ(count, shard.size());
+
+  shard.clear();
+  ASSERT_TRUE(shard.empty());
+  ASSERT_EQ(shard.read(2, value.data()), -1);
+}
+
+TEST(InlineSparseTableShard, ConcurrentReads) {
+  const size_t dim = 16;
+  const uint64_t key_num = 1000;
+  InlineSparseTableShard<uint64_t> shard(dim);
+  std::vector<float> init(dim, 0.0);
+  for (uint64_t key = 0; key < key_num; ++key) {
+    shard.insert(key, init.data(), dim);
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&, i] {
+      std::vector<float> value(dim);
+      uint64_t key = i;
+      while (!done.load()) {
+        key = (key * 31 + 7) % key_num;
+        if (shard.read(key, value.data()) != static_cast<int>(dim)) {
+          ++torn;
+          continue;
+        }
+        for (size_t j = 1; j < dim; ++j) {
+          if (value[j] != value[0]) {
+            ++torn;
+            break;
+          }
+        }
+      }
+    });
+  }
+
+  // Every value is written as dim equal floats, while new keys grow the
+  // table under the readers.
+  for (int round = 1; round <= 50; ++round) {
+    for (uint64_t key = 0; key < key_num; ++key) {
+      shard.update(key, [&](float* data, size_t*) {
+        for (size_t j = 0; j < dim; ++j) {
+          data[j] = static_cast<float>(round);
+        }
+      });
+    }
+    for (uint64_t key = 0; key < 200; ++key) {
+      shard.insert(key_num * round + key, init.data(), dim);
+    }
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(torn.load(), 0);
+  ASSERT_EQ(shard.size(), key_num + 50 * 200);
+}
+
+}  // namespace paddle::distributed
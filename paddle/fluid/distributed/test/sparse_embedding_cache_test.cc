@@ -0,0 +1,85 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/service/communicator/sparse_embedding_cache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(SparseEmbeddingCache, StaleSteps) {
+  const int dim = 2;
+  SparseEmbeddingCache cache(16, dim, 2, 0);
+  std::vector<uint64_t> keys = {1, 2};
+  std::vector<float> data(keys.size() * dim, 0);
+  std::vector<float *> values = {data.data(), data.data() + dim};
+
+  std::vector<size_t> missed;
+  cache.Lookup(keys.data(), keys.size(), values.data(), &missed);
+  ASSERT_EQ(missed.size(), 2u);
+  data = {1, 1, 2, 2};
+  cache.Insert(keys.data(), keys.size(), values.data());
+
+  // Served for the 2 next pulls.
+  for (int step = 0; step < 2; ++step) {
+    data.assign(data.size(), 0);
+    missed.clear();
+    cache.Lookup(keys.data(), keys.size(), values.data(), &missed);
+    ASSERT_TRUE(missed.empty());
+    ASSERT_FLOAT_EQ(data[0], 1);
+    ASSERT_FLOAT_EQ(data[3], 2);
+  }
+  missed.clear();
+  cache.Lookup(keys.data(), keys.size(), values.data(), &missed);
+  ASSERT_EQ(missed.size(), 2u);
+
+  auto stat = cache.GetStat();
+  ASSERT_EQ(stat.hits, 4u);
+  ASSERT_EQ(stat.misses, 4u);
+  ASSERT_EQ(stat.expired, 2u);
+  ASSERT_EQ(stat.hit_stale_steps, 6u);
+}
+
+TEST(SparseEmbeddingCache, EvictsLeastRecentlyUsed) {
+  const int dim = 1;
+  SparseEmbeddingCache cache(2, dim, 0, 0);
+  float value = 0;
+  float *value_ptr = &value;
+  std::vector<size_t> missed;
+  for (uint64_t key = 0; key < 2; ++key) {
+    value = key;
+    cache.Insert(&key, 1, &value_ptr);
+  }
+  // Uses 0 so that 1 is evicted by 2.
+  uint64_t key = 0;
+  cache.Lookup(&key, 1, &value_ptr, &missed);
+  ASSERT_TRUE(missed.empty());
+  key = 2;
+  value = 2;
+  cache.Insert(&key, 1, &value_ptr);
+
+  for (uint64_t kept : {0, 2}) {
+    cache.Lookup(&kept, 1, &value_ptr, &missed);
+    ASSERT_TRUE(missed.empty());
+    ASSERT_FLOAT_EQ(value, kept);
+  }
+  key = 1;
+  cache.Lookup(&key, 1, &value_ptr, &missed);
+  ASSERT_EQ(missed.size(), 1u);
+  ASSERT_EQ(cache.GetStat().evicted, 1u);
+}
+
+}  // namespace paddle::distributed
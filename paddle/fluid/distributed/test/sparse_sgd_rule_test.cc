@@ -16,6 +16,7 @@ limitations under the License. */
 
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "paddle/fluid/distributed/the_one_ps.pb.h"
@@ -205,5 +206,111 @@ TEST(downpour_sparse_adam_test, test_init_and_update) {
     ASSERT_FLOAT_EQ(value[i], label[i]) << "i is " << i;
   }
 }
+
+// Under PADDLE_WITH_AVX the rules update 8 dims at a time and the rest in a
+// scalar tail. A dim that is not a multiple of 8 runs both, and they must
+// agree with the scalar loops below.
+TEST(downpour_sparse_adagrad_test, test_avx_matches_scalar) {
+  const int embed_dim = 13;
+  SparseCommonSGDRuleParameter param;
+  param.set_name("adagrad");
+  auto* adagrad_param = param.mutable_adagrad();
+  adagrad_param->set_learning_rate(0.05);
+  adagrad_param->set_initial_g2sum(3.0);
+  adagrad_param->set_initial_range(0.3);
+  adagrad_param->add_weight_bounds(-0.5);
+  adagrad_param->add_weight_bounds(0.5);
+
+  SparseAdaGradSGDRule rule;
+  rule.LoadConfig(param, embed_dim);
+
+  float w[embed_dim + 1];    // NOLINT
+  float ref[embed_dim + 1];  // NOLINT
+  float grad[embed_dim];     // NOLINT
+  for (int i = 0; i < embed_dim; ++i) {
+    w[i] = ref[i] = 0.1f * static_cast<float>(i % 7) - 0.3f;
+    grad[i] = 1.7f * static_cast<float>(i % 5) - 3.1f;
+  }
+  w[embed_dim] = ref[embed_dim] = 0.7f;
+  const float scale = 3.0f;
+  // The rule keeps its config in float.
+  const float lr = adagrad_param->learning_rate();
+  const float initial_g2sum = adagrad_param->initial_g2sum();
+
+  for (int step = 0; step < 3; ++step) {
+    rule.UpdateValue(w, w + embed_dim, grad, scale);
+
+    float& g2sum = ref[embed_dim];
+    double add_g2sum = 0;
+    double g2sum_ratio = sqrt(initial_g2sum / (initial_g2sum + g2sum));
+    for (int i = 0; i < embed_dim; ++i) {
+      double scaled_grad = grad[i] / scale;
+      ref[i] -= lr * scaled_grad * g2sum_ratio;
+      rule.BoundValue(ref[i]);
+      add_g2sum += scaled_grad * scaled_grad;
+    }
+    g2sum += add_g2sum / embed_dim;
+
+    for (int i = 0; i <= embed_dim; ++i) {
+      ASSERT_FLOAT_EQ(w[i], ref[i]) << "step " << step << ", i is " << i;
+    }
+  }
+}
+
+TEST(downpour_sparse_adam_test, test_avx_matches_scalar) {
+  const int embed_dim = 13;
+  SparseCommonSGDRuleParameter param;
+  param.set_name("adam");
+  auto* adam_param = param.mutable_adam();
+  adam_param->set_learning_rate(0.1);
+  adam_param->set_initial_range(0.3);
+  adam_param->set_beta1_decay_rate(0.9);
+  adam_param->set_beta2_decay_rate(0.999);
+  adam_param->set_ada_epsilon(1e-08);
+  adam_param->add_weight_bounds(-1.0);
+  adam_param->add_weight_bounds(1.0);
+
+  SparseAdamSGDRule rule;
+  rule.LoadConfig(param, embed_dim);
+  const int value_dim = embed_dim + static_cast<int>(rule.Dim());
+  std::vector<float> value(value_dim);
+  std::vector<float> ref(value_dim);
+  rule.InitValue(value.data(), value.data() + embed_dim, true);
+  for (int i = 0; i < embed_dim; ++i) {
+    value[i] = 0.1f * static_cast<float>(i % 7) - 0.3f;
+  }
+  ref = value;
+  float grad[embed_dim];  // NOLINT
+  for (int i = 0; i < embed_dim; ++i) {
+    grad[i] = 0.9f * static_cast<float>(i % 5) - 1.9f;
+  }
+
+  const float beta1 = adam_param->beta1_decay_rate();
+  const float beta2 = adam_param->beta2_decay_rate();
+  const float epsilon = adam_param->ada_epsilon();
+  for (int step = 0; step < 3; ++step) {
+    rule.UpdateValue(value.data(), value.data() + embed_dim, grad);
+
+    float* w = ref.data();
+    float* gsum = w + embed_dim + rule.GSumIndex();
+    float* g2sum = w + embed_dim + rule.G2SumIndex();
+    float* beta1_pow = w + embed_dim + rule.Beta1PowIndex();
+    float* beta2_pow = w + embed_dim + rule.Beta2PowIndex();
+    float lr = adam_param->learning_rate();
+    lr *= sqrt(1 - *beta2_pow) / (1 - *beta1_pow);
+    for (int i = 0; i < embed_dim; ++i) {
+      gsum[i] = beta1 * gsum[i] + (1 - beta1) * grad[i];
+      g2sum[i] = beta2 * g2sum[i] + (1 - beta2) * grad[i] * grad[i];
+      w[i] = w[i] - lr * (gsum[i] / (std::sqrt(g2sum[i]) + epsilon));
+      rule.BoundValue(w[i]);
+    }
+    *beta1_pow *= beta1;
+    *beta2_pow *= beta2;
+
+    for (int i = 0; i < value_dim; ++i) {
+      ASSERT_FLOAT_EQ(value[i], ref[i]) << "step " << step << ", i is " << i;
+    }
+  }
+}
 }  // namespace distributed
 }  // namespace paddle
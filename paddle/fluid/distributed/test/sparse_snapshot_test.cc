@@ -0,0 +1,123 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/depends/sparse_snapshot.h"
+
+#include <map>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+namespace {
+
+std::string Write(const SparseShardSnapshot& snapshot,
+                  SnapshotKind kind,
+                  bool compress) {
+  std::string file;
+  EXPECT_EQ(WriteSparseSnapshot(snapshot,
+                                kind,
+                                compress,
+                                [&file](const char* data, size_t size) {
+                                  file.append(data, size);
+                                  return 0;
+                                }),
+            0);
+  return file;
+}
+
+int Read(const std::string& file,
+         std::map<uint64_t, std::vector<float>>* rows,
+         SnapshotFileHeader* header = nullptr) {
+  size_t offset = 0;
+  return ReadSparseSnapshot(
+      [&file, &offset](char* data, size_t size) {
+        size = std::min(size, file.size() - offset);
+        memcpy(data, file.data() + offset, size);
+        offset += size;
+        return size;
+      },
+      [rows](uint64_t key, const float* value, size_t size) {
+        (*rows)[key].assign(value, value + size);
+      },
+      [rows](uint64_t key) { rows->erase(key); },
+      header);
+}
+
+}  // namespace
+
+TEST(SparseSnapshot, RoundTrip) {
+  // More rows than a block, of two value sizes as with and without mf.
+  SparseShardSnapshot snapshot;
+  std::map<uint64_t, std::vector<float>> expected;
+  for (uint64_t key = 0; key < kSnapshotBlockRows * 2 + 10; ++key) {
+    std::vector<float> value(key % 3 == 0 ? 8 : 3);
+    for (size_t i = 0; i < value.size(); ++i) {
+      value[i] = static_cast<float>(key % 100) + i;
+    }
+    snapshot.Append(key * 7, value.data(), value.size());
+    expected[key * 7] = value;
+  }
+  for (bool compress : {false, true}) {
+    std::string file = Write(snapshot, kSnapshotFull, compress);
+    std::map<uint64_t, std::vector<float>> rows;
+    SnapshotFileHeader header;
+    ASSERT_EQ(Read(file, &rows, &header), 0);
+    ASSERT_EQ(header.kind, kSnapshotFull);
+    ASSERT_EQ(header.num_blocks, 3u);
+    ASSERT_EQ(rows, expected);
+    if (compress) {
+      ASSERT_LT(file.size(), snapshot.values.size() * sizeof(float));
+    }
+  }
+}
+
+TEST(SparseSnapshot, Delta) {
+  std::map<uint64_t, std::vector<float>> rows;
+  SparseShardSnapshot base;
+  float value[2] = {1, 2};
+  base.Append(1, value, 2);
+  base.Append(2, value, 2);
+  base.Append(3, value, 2);
+  ASSERT_EQ(Read(Write(base, kSnapshotFull, true), &rows), 0);
+
+  SparseShardSnapshot delta;
+  float updated[4] = {5, 6, 7, 8};
+  delta.Append(2, updated, 4);
+  delta.Append(4, updated, 1);
+  delta.deleted_keys = {3};
+  SnapshotFileHeader header;
+  ASSERT_EQ(Read(Write(delta, kSnapshotDelta, true), &rows, &header), 0);
+  ASSERT_EQ(header.kind, kSnapshotDelta);
+  ASSERT_EQ(header.num_deleted, 1u);
+  std::map<uint64_t, std::vector<float>> expected = {
+      {1, {1, 2}}, {2, {5, 6, 7, 8}}, {4, {5}}};
+  ASSERT_EQ(rows, expected);
+}
+
+TEST(SparseSnapshot, Truncated) {
+  SparseShardSnapshot snapshot;
+  float value[4] = {1, 2, 3, 4};
+  for (uint64_t key = 0; key < 100; ++key) {
+    snapshot.Append(key, value, 4);
+  }
+  std::string file = Write(snapshot, kSnapshotFull, true);
+  std::map<uint64_t, std::vector<float>> rows;
+  ASSERT_EQ(Read(file.substr(0, file.size() - 1), &rows), -1);
+  ASSERT_EQ(Read(std::string(), &rows), -1);
+  file[0] = 'x';
+  ASSERT_EQ(Read(file, &rows), -1);
+}
+
+}  // namespace paddle::distributed
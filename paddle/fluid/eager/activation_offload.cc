@@ -0,0 +1,221 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/eager/activation_offload.h"
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/malloc.h"
+#include "paddle/phi/core/memory/memcpy.h"
+#if defined(PADDLE_WITH_CUDA)
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#endif
+
+namespace egr {
+
+class OffloadedTensor {
+ public:
+  OffloadedTensor(uint64_t seq, const phi::Place& place, size_t size)
+      : seq(seq), place(place), size(size) {}
+  ~OffloadedTensor();
+
+  uint64_t seq;
+  phi::Place place;
+  size_t size;
+  paddle::memory::AllocationPtr host;
+#if defined(PADDLE_WITH_CUDA)
+  // recorded after the last copy queued on the side stream
+  cudaEvent_t event = nullptr;
+#endif
+  // the buffer copied back by a prefetch, not handed out yet
+  std::shared_ptr<phi::Allocation> prefetched;
+};
+
+OffloadedTensor::~OffloadedTensor() {
+#if defined(PADDLE_WITH_CUDA)
+  if (event != nullptr) {
+    // the side stream may still copy from or to the buffers
+    phi::backends::gpu::GPUDeviceGuard guard(place.GetDeviceId());
+    cudaEventSynchronize(event);
+    cudaEventDestroy(event);
+  }
+#endif
+}
+
+ActivationOffloader& ActivationOffloader::Instance() {
+  static ActivationOffloader instance;
+  return instance;
+}
+
+void ActivationOffloader::Enable(size_t min_bytes, int prefetch_num) {
+#if defined(PADDLE_WITH_CUDA)
+  std::lock_guard<std::mutex> lock(mutex_);
+  min_bytes_ = min_bytes;
+  prefetch_num_ = prefetch_num;
+  enabled_ = true;
+#else
+  PADDLE_THROW(common::errors::Unavailable(
+      "Activation offload is only supported when Paddle is built with "
+      "CUDA."));
+#endif
+}
+
+void ActivationOffloader::Disable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_ = false;
+}
+
+#if defined(PADDLE_WITH_CUDA)
+static gpuStream_t ComputeStream(const phi::Place& place) {
+  return static_cast<phi::GPUContext*>(
+             phi::DeviceContextPool::Instance().Get(place))
+      ->stream();
+}
+
+// Makes the work queued on waiter from now on wait for the work queued on
+// stream so far, through the event of offloaded.
+static void RecordAndWait(OffloadedTensor* offloaded,
+                          gpuStream_t stream,
+                          gpuStream_t waiter) {
+  if (offloaded->event == nullptr) {
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreateWithFlags(
+        &offloaded->event, cudaEventDisableTiming));
+  }
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(offloaded->event, stream));
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      cudaStreamWaitEvent(waiter, offloaded->event, 0));
+}
+#endif
+
+std::shared_ptr<OffloadedTensor> ActivationOffloader::Offload(
+    const phi::DenseTensor& tensor) {
+#if defined(PADDLE_WITH_CUDA)
+  if (!enabled_ || !tensor.initialized() ||
+      !phi::is_gpu_place(tensor.place())) {
+    return nullptr;
+  }
+  const auto& holder = tensor.Holder();
+  size_t bytes = tensor.memory_size();
+  // a view of a larger buffer would copy more than it saves
+  if (bytes < min_bytes_ || tensor.meta().offset != 0 ||
+      holder->size() >= 2 * bytes) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const phi::Place& place = tensor.place();
+  phi::backends::gpu::GPUDeviceGuard guard(place.GetDeviceId());
+  void*& side_stream = streams_[place.GetDeviceId()];
+  if (side_stream == nullptr) {
+    gpuStream_t stream;
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+    side_stream = stream;
+  }
+  auto stream = static_cast<gpuStream_t>(side_stream);
+
+  auto offloaded =
+      std::make_shared<OffloadedTensor>(next_seq_++, place, holder->size());
+  offloaded->host =
+      paddle::memory::Alloc(phi::GPUPinnedPlace(), offloaded->size);
+  // copy once the kernels writing the tensor are done
+  RecordAndWait(offloaded.get(), ComputeStream(place), stream);
+  paddle::memory::Copy(phi::GPUPinnedPlace(),
+                       offloaded->host->ptr(),
+                       place,
+                       holder->ptr(),
+                       offloaded->size,
+                       stream);
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(offloaded->event, stream));
+  // the GPU buffer is freed with the tensor, not before the copy is done
+  paddle::memory::RecordStream(holder, stream);
+
+  saved_.emplace(offloaded->seq, offloaded);
+  if (saved_.size() % 1024 == 0) {
+    for (auto iter = saved_.begin(); iter != saved_.end();) {
+      iter = iter->second.expired() ? saved_.erase(iter) : std::next(iter);
+    }
+  }
+  VLOG(6) << "Offload " << offloaded->size << " bytes of a saved tensor as "
+          << offloaded->seq;
+  return offloaded;
+#else
+  return nullptr;
+#endif
+}
+
+void ActivationOffloader::Prefetch(OffloadedTensor* offloaded) {
+#if defined(PADDLE_WITH_CUDA)
+  const phi::Place& place = offloaded->place;
+  auto stream = static_cast<gpuStream_t>(streams_.at(place.GetDeviceId()));
+  offloaded->prefetched = paddle::memory::AllocShared(place, offloaded->size);
+  // the buffer may be one just freed by kernels still queued
+  RecordAndWait(offloaded, ComputeStream(place), stream);
+  paddle::memory::Copy(place,
+                       offloaded->prefetched->ptr(),
+                       phi::GPUPinnedPlace(),
+                       offloaded->host->ptr(),
+                       offloaded->size,
+                       stream);
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(offloaded->event, stream));
+#endif
+}
+
+std::shared_ptr<phi::Allocation> ActivationOffloader::Reload(
+    OffloadedTensor* offloaded) {
+#if defined(PADDLE_WITH_CUDA)
+  std::lock_guard<std::mutex> lock(mutex_);
+  const phi::Place& place = offloaded->place;
+  phi::backends::gpu::GPUDeviceGuard guard(place.GetDeviceId());
+  gpuStream_t compute_stream = ComputeStream(place);
+  // the copies on the side stream are done before the kernels go on
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      cudaStreamWaitEvent(compute_stream, offloaded->event, 0));
+  std::shared_ptr<phi::Allocation> buffer = std::move(offloaded->prefetched);
+  if (buffer == nullptr) {
+    VLOG(6) << "Reload saved tensor " << offloaded->seq << " not prefetched";
+    buffer = paddle::memory::AllocShared(place, offloaded->size);
+    paddle::memory::Copy(place,
+                         buffer->ptr(),
+                         phi::GPUPinnedPlace(),
+                         offloaded->host->ptr(),
+                         offloaded->size,
+                         compute_stream);
+  }
+
+  // the tensors saved before this one are the next to be needed
+  auto iter = saved_.lower_bound(offloaded->seq);
+  for (int num = 0; num < prefetch_num_ && iter != saved_.begin();) {
+    --iter;
+    auto previous = iter->second.lock();
+    if (previous == nullptr) {
+      iter = saved_.erase(iter);
+      continue;
+    }
+    if (previous->prefetched == nullptr) {
+      Prefetch(previous.get());
+    }
+    ++num;
+  }
+  return buffer;
+#else
+  PADDLE_THROW(common::errors::Unavailable(
+      "Activation offload is only supported when Paddle is built with "
+      "CUDA."));
+#endif
+}
+
+}  // namespace egr
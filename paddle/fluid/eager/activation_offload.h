@@ -0,0 +1,74 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace egr {
+
+// The host copy of a tensor saved by a TensorWrapper, defined in the .cc.
+class OffloadedTensor;
+
+// Moves the tensors saved for backward out of GPU memory while forward runs
+// and brings them back just ahead of the grad nodes that need them.
+//
+// Once enabled, TensorWrapper hands the buffer of each saved GPU tensor
+// that is not persistable and has at least min_bytes to Offload(), which
+// copies it to pinned host memory on a side stream of the device and drops
+// the GPU buffer, the stream safe allocator keeping it until the copy is
+// done. Reload() gives the buffer back on the GPU for the grad node and
+// copies the prefetch_num tensors saved before it on the side stream, as
+// backward runs the nodes about in the reverse order of forward. Only built
+// with CUDA.
+class ActivationOffloader {
+ public:
+  static ActivationOffloader& Instance();
+
+  void Enable(size_t min_bytes, int prefetch_num);
+  void Disable();
+  bool IsEnable() const { return enabled_; }
+
+  // Starts copying the buffer of tensor to host, returns nullptr when the
+  // tensor is left on the device.
+  std::shared_ptr<OffloadedTensor> Offload(const phi::DenseTensor& tensor);
+
+  // Returns the buffer of the tensor on its device again, ready for the
+  // kernels on the stream of the device context.
+  std::shared_ptr<phi::Allocation> Reload(OffloadedTensor* offloaded);
+
+ private:
+  ActivationOffloader() = default;
+
+  void Prefetch(OffloadedTensor* offloaded);
+
+  bool enabled_ = false;
+  size_t min_bytes_ = 0;
+  int prefetch_num_ = 0;
+
+  std::mutex mutex_;
+  // the tensors offloaded in forward, by the order they were saved
+  std::map<uint64_t, std::weak_ptr<OffloadedTensor>> saved_;
+  uint64_t next_seq_ = 0;
+  // the side stream of each device, as a void* for the builds without CUDA
+  std::unordered_map<int, void*> streams_;
+};
+
+}  // namespace egr
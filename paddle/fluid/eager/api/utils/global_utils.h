@@ -75,6 +75,12 @@ class Controller {
 
   void SetHasGrad(bool has_grad) { tracer_->SetHasGrad(has_grad); }
 
+  bool IsInferenceMode() const { return tracer_->IsInferenceMode(); }
+
+  void SetInferenceMode(bool inference_mode) {
+    tracer_->SetInferenceMode(inference_mode);
+  }
+
   std::string GenerateUniqueName(std::string key = "eager_in_tmp") {
     return tracer_->GenerateUniqueName(key);
   }
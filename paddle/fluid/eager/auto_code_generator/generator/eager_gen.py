@@ -155,6 +155,13 @@ strided_op_list = {
     "view_dtype",
 }
 
+# Ops drawing random numbers, whose output can not be recomputed in backward
+recompute_blacklist = {
+    "dropout",
+    "gumbel_softmax",
+    "rrelu",
+}
+
 strided_op_need_flags_check_list = {
     "as_complex_",
     "as_real_",
@@ -335,6 +342,9 @@ TEST_API {} {}({}) {{
 
   bool trace_backward = egr::Controller::Instance().HasGrad();
   bool require_any_grad = egr::EagerUtils::ComputeRequireGrad({});
+  // Outputs in inference mode never take part in autograd
+  bool skip_autograd_meta =
+      !require_any_grad && egr::Controller::Instance().IsInferenceMode();
 
   // Node Declaration
   std::shared_ptr<{}> grad_node;
@@ -455,6 +465,15 @@ FORWARD_BODY_AFTER_API_CALL_TEMPLATE = """  if (require_any_grad) {{
   }}
 """
 
+RECOMPUTE_REGISTER_TEMPLATE = """
+  // Register the kernel to recompute {} from the saved inputs in backward
+  if (require_any_grad && egr::Recomputer::Instance().IsEnable()) {{
+    egr::Recomputer::Instance().Register("{}", {}, {{{}}}, [=](const std::vector<paddle::Tensor>& inputs) {{
+      return paddle::experimental::{}({});
+    }});
+  }}
+"""
+
 HIGHER_ORDER_DERIVATIVE_VALUE_TEMPLATE = """  if (trace_backward) {{
 {}
     // Node Construction
@@ -527,6 +546,7 @@ FORWARD_CC_FILE_TEMPLATE = """
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/fluid/eager/nan_inf_utils.h"
+#include "paddle/fluid/eager/recompute.h"
 #include "paddle/fluid/eager/api/manual/eager_manual/dygraph_forward_api.h"
 #include "paddle/common/flags.h"
 #include "paddle/phi/api/lib/data_transform.h"
@@ -1854,18 +1874,18 @@ class DygraphForwardFunctionGenerator(DygraphFunctionGeneratorBase):
                 output_autograd_meta_vec_name = GetAutoGradMetaVectorName(name)
                 if num_fwd_outputs == 1:
                     if IsPlainTensorType(rtype):
-                        output_autograd_meta = f"{indent}egr::AutogradMeta* {output_autograd_meta_name} = egr::EagerUtils::autograd_meta(&{name});"
+                        output_autograd_meta = f"{indent}egr::AutogradMeta* {output_autograd_meta_name} = skip_autograd_meta ? nullptr : egr::EagerUtils::autograd_meta(&{name});"
                     else:
                         assert IsVectorTensorType(rtype)
-                        output_autograd_meta = f"{indent}std::vector<egr::AutogradMeta*> {output_autograd_meta_vec_name} = egr::EagerUtils::autograd_meta(&{name});\n"
+                        output_autograd_meta = f"{indent}std::vector<egr::AutogradMeta*> {output_autograd_meta_vec_name} = skip_autograd_meta ? std::vector<egr::AutogradMeta*>() : egr::EagerUtils::autograd_meta(&{name});\n"
                         output_autograd_meta += f"{indent}std::vector<egr::AutogradMeta*>* {output_autograd_meta_name} = &{output_autograd_meta_vec_name};"
                 else:
                     # Tuple api_result
                     if IsPlainTensorType(rtype):
-                        output_autograd_meta = f"{indent}egr::AutogradMeta* {output_autograd_meta_name} = egr::EagerUtils::autograd_meta(&{name});"
+                        output_autograd_meta = f"{indent}egr::AutogradMeta* {output_autograd_meta_name} = skip_autograd_meta ? nullptr : egr::EagerUtils::autograd_meta(&{name});"
                     else:
                         assert IsVectorTensorType(rtype)
-                        output_autograd_meta = f"{indent}std::vector<egr::AutogradMeta*> {output_autograd_meta_vec_name} = egr::EagerUtils::autograd_meta(&{name});\n"
+                        output_autograd_meta = f"{indent}std::vector<egr::AutogradMeta*> {output_autograd_meta_vec_name} = skip_autograd_meta ? std::vector<egr::AutogradMeta*>() : egr::EagerUtils::autograd_meta(&{name});\n"
                         output_autograd_meta += f"{indent}std::vector<egr::AutogradMeta*>* {output_autograd_meta_name} = &{output_autograd_meta_vec_name};"
 
                 outputs_autograd_meta_list.append(output_autograd_meta)
@@ -1882,6 +1902,9 @@ class DygraphForwardFunctionGenerator(DygraphFunctionGeneratorBase):
             if self.inputs_call_list_tmp is not None:
                 inputs_call_args_str_tmp = ", ".join(self.inputs_call_list_tmp)
                 forward_call_str = f"{indent}{api_out_type} api_result = paddle::experimental::{namespace}{function_name}({inputs_call_args_str_tmp});"
+            node_creation_after_call_str += self.GenerateRecomputeRegister(
+                is_inplaced, function_name
+            )
 
         dygraph_event_str = f'{indent}phi::RecordEvent dygraph_entrance_record_event("{forward_api_name} dygraph", phi::TracerEventType::Operator, 1);\n'
         log_memory_info_str = f'{indent}paddle::memory::LogDeviceMemoryStats(egr::Controller::Instance().GetExpectedPlace(), "{forward_api_name}");'
@@ -2063,6 +2086,56 @@ class DygraphForwardFunctionGenerator(DygraphFunctionGeneratorBase):
 
         self.forward_declaration_str += f"TEST_API {returns_type_str} {forward_ad_function_name}({inputs_args_declaration_str});\n"
 
+    def GenerateRecomputeRegister(self, is_inplaced, function_name):
+        # The output of an op can be recomputed when it is a plain tensor and
+        # all the inputs are plain tensors saved for its own backward anyway
+        forward_inputs_position_map = self.forward_inputs_position_map
+        forward_outputs_position_map = self.forward_outputs_position_map
+        backward_forward_inputs_map = self.backward_forward_inputs_map
+        if (
+            is_inplaced
+            or self.namespace != ""
+            or self.forward_api_name in strided_op_list
+            or self.forward_api_name in recompute_blacklist
+            or len(self.intermediate_outputs) > 0
+            or len(forward_outputs_position_map) != 1
+            or len(forward_inputs_position_map) == 0
+        ):
+            return ""
+        out_name, (out_type, _) = next(
+            iter(forward_outputs_position_map.items())
+        )
+        if not IsPlainTensorType(out_type):
+            return ""
+        for name, (ttype, _) in forward_inputs_position_map.items():
+            if (
+                not IsPlainTensorType(ttype)
+                or name in self.optional_inputs
+                or name not in backward_forward_inputs_map
+                or not backward_forward_inputs_map[name][1]
+                or name in self.no_need_buffers
+            ):
+                return ""
+
+        inputs_call_list = (
+            self.inputs_call_list_tmp
+            if self.inputs_call_list_tmp is not None
+            else self.inputs_call_list
+        )
+        saved_inputs_list = []
+        recompute_call_list = list(self.inputs_call_list)
+        for name, (_, pos) in forward_inputs_position_map.items():
+            recompute_call_list[pos] = f"inputs[{len(saved_inputs_list)}]"
+            saved_inputs_list.append(inputs_call_list[pos])
+        return RECOMPUTE_REGISTER_TEMPLATE.format(
+            out_name,
+            self.forward_api_name,
+            out_name,
+            ", ".join(saved_inputs_list),
+            function_name,
+            ", ".join(recompute_call_list),
+        )
+
     def GenerateInplacedForwardDygraphFunctions(self):
         # Inplaced Version Dygraph Function Generation
         forward_api_name = self.forward_api_name
@@ -15,6 +15,9 @@
 #include "paddle/fluid/eager/backward.h"
 
 #include "paddle/fluid/eager/general_grad.h"
+#include "paddle/fluid/eager/parallel_backward.h"
+#include "paddle/fluid/eager/recompute.h"
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/core/memory/stats.h"
 #include "paddle/phi/kernels/autotune/switch_autotune.h"
 
@@ -113,6 +116,8 @@ std::vector<paddle::Tensor> RunBackward(
   VLOG(3) << "Start Backward";
 
   egr::EagerBackwardStateGuard guard;
+  // The grads are also summed by kernels called outside of the API layer.
+  paddle::experimental::AsyncKernelLaunchSuspendGuard async_launch_guard;
   auto place = egr::Controller::Instance().GetExpectedPlace();
 
   // *Gradient Hook should happen at node-level
@@ -243,6 +248,17 @@ std::vector<paddle::Tensor> RunBackward(
 
   VLOG(5) << "Startup_ops's size is " << queue.size();
 
+  // GeneralGrad, create_graph and the force sequential nodes keep the
+  // sequential engine below.
+  if (!is_general_grad && !create_graph && force_sequential_nodes_set.empty() &&
+      ParallelBackwardRunner::Enabled(place)) {
+    ParallelBackwardRunner runner(
+        &node_input_buffers_dict, retain_graph, place);
+    if (runner.Run(queue, node_in_degree_map)) {
+      queue.clear();
+    }
+  }
+
   /* --- Topological Visit --- */
   // 1. Pop queue
   // 2. Run node
@@ -431,6 +447,8 @@ std::vector<paddle::Tensor> RunBackward(
     (*hook)();
   }
   egr::Controller::Instance().ClearFinalBackwardHooks();
+  // the saved tensors of the next forward start again from the budget
+  egr::Recomputer::Instance().Clear();
   if (!is_general_grad) return {};
   VLOG(3) << "Finish Backward";
   return GeneralGrad::Instance().GetResults(inputs, allow_unused, create_graph);
@@ -803,7 +803,7 @@ void GradNodeBase::HandleComplexGradToRealGrad(
               "However, no TensorMeta is detected in bwd_out_meta_."));
 
       auto fwd_data_type = paddle::framework::TransToProtoVarType(
-          slot_meta.GetTensorMeta().dtype);
+          slot_meta.GetTensorMeta().dtype());
       const paddle::Tensor& grad = slot_out_grads[rank_id];
 
       if (paddle::framework::IsComplexType(fwd_data_type)) continue;
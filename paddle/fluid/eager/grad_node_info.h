@@ -135,17 +135,18 @@ class GradSlotMeta {
   }
 
   void SetTensorMeta(const phi::DenseTensorMeta& meta) {
-    meta_ = std::make_shared<phi::DenseTensorMeta>(meta);
+    meta_ = phi::CompactDenseTensorMeta(meta);
+    has_meta_ = true;
   }
-  bool HasTensorMeta() const { return meta_ && meta_.get(); }
-  const phi::DenseTensorMeta& GetTensorMeta() const {
+  bool HasTensorMeta() const { return has_meta_; }
+  const phi::CompactDenseTensorMeta& GetTensorMeta() const {
     if (!HasTensorMeta()) {
       PADDLE_THROW(common::errors::Fatal(
           "meta_ of GradSlotMeta has not been initialized yet."
           "You're expected to check Edge availability with HasTensorMeta()"
           "before calling GetTensorMeta() interface."));
     }
-    return *meta_.get();
+    return meta_;
   }
 
   void SetPlace(const phi::Place& place) { place_ = place; }
@@ -184,7 +185,10 @@ class GradSlotMeta {
  private:
   bool stop_gradient_{false};
   phi::Place place_;
-  std::shared_ptr<phi::DenseTensorMeta> meta_ = nullptr;
+  // Only the dims, dtype and layout, held inline rather than in a shared
+  // DenseTensorMeta, as there is a GradSlotMeta for each forward tensor.
+  bool has_meta_{false};
+  phi::CompactDenseTensorMeta meta_;
   Edge adj_edge_;
   // For dygraph semi-auto parallel
   // Save the dist attr of the forward input Tensor for proper resharding
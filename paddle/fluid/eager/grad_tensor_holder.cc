@@ -14,18 +14,76 @@
 
 #include "paddle/fluid/eager/grad_tensor_holder.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/eager/api/generated/eager_generated/forwards/dygraph_functions.h"
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/framework/var_type.h"
 #include "paddle/fluid/imperative/gradient_accumulator.h"
+#include "paddle/phi/backends/context_pool.h"
 #include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
 #include "paddle/phi/core/distributed/auto_parallel/dist_tensor.h"
+#include "paddle/phi/core/kernel_factory.h"
 #include "paddle/phi/core/sparse_coo_tensor.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 
+COMMON_DECLARE_int32(eager_grad_add_n_max_inputs);
+
 namespace egr {
 
+static phi::KernelKey AddNKernelKey(const phi::DenseTensor& tensor) {
+  return phi::KernelKey(phi::TransToPhiBackend(tensor.place()),
+                        phi::DataLayout::ALL_LAYOUT,
+                        tensor.dtype());
+}
+
+// Whether t can wait to be summed into buffer with the other grads, the
+// cases TensorAdd converts, such as dtypes or places apart, are left to it.
+static bool CanDeferAdd(const paddle::Tensor& t,
+                        const paddle::Tensor& buffer) {
+  if (FLAGS_eager_grad_add_n_max_inputs <= 1 || !t.is_dense_tensor() ||
+      !buffer.is_dense_tensor() || !t.initialized() ||
+      !buffer.initialized()) {
+    return false;
+  }
+  auto* src = static_cast<phi::DenseTensor*>(t.impl().get());
+  auto* dst = static_cast<phi::DenseTensor*>(buffer.impl().get());
+  return (phi::is_cpu_place(dst->place()) || phi::is_gpu_place(dst->place())) &&
+         src->place() == dst->place() && src->dtype() == dst->dtype() &&
+         src->numel() == dst->numel() && dst->numel() > 0 &&
+         src->meta().is_contiguous() && dst->meta().is_contiguous() &&
+         phi::KernelFactory::Instance().HasKernel("add_n",
+                                                  AddNKernelKey(*dst));
+}
+
+void GradTensorHolder::SumPendingGrads(size_t slot_id, size_t rank) {
+  auto iter = pending_grads_.find({slot_id, rank});
+  if (iter == pending_grads_.end()) {
+    return;
+  }
+  std::vector<paddle::Tensor> grads = std::move(iter->second);
+  pending_grads_.erase(iter);
+
+  auto* out =
+      static_cast<phi::DenseTensor*>(buffer_[slot_id][rank].impl().get());
+  // the buffer first, so that the kernel adds the others to it in place
+  std::vector<const phi::TensorBase*> inputs{out};
+  for (const auto& grad : grads) {
+    inputs.push_back(grad.impl().get());
+  }
+  VLOG(6) << "Sum " << inputs.size() << " grads for buffer_ slot: " << slot_id
+          << ", rank: " << rank;
+  const auto& kernel =
+      phi::KernelFactory::Instance().SelectKernel("add_n", AddNKernelKey(*out));
+  using kernel_signature = void (*)(const phi::DeviceContext&,
+                                    const std::vector<const phi::TensorBase*>&,
+                                    phi::DenseTensor*);
+  auto* kernel_fn = kernel.GetVariadicKernelFn<kernel_signature>();
+  (*kernel_fn)(
+      *phi::DeviceContextPool::Instance().Get(out->place()), inputs, out);
+}
+
 void GradTensorHolder::SetBufferSlotRankZeros(size_t slot_id, size_t rank) {
+  pending_grads_.erase({slot_id, rank});
   // Set not grad var to zero and set stop gradient as default value: true
   buffer_[slot_id][rank] =
       paddle::experimental::zeros_like(buffer_[slot_id][rank]);
@@ -35,6 +93,7 @@ void GradTensorHolder::CopyValueFromTensor(size_t slot_id,
                                            size_t rank,
                                            const paddle::Tensor& t,
                                            bool fill_one) {
+  pending_grads_.erase({slot_id, rank});
   // TODO(jiabin): We need to deal with empty input_buffer with slot size not
   // empty;
   PADDLE_ENFORCE(
@@ -169,6 +228,18 @@ void GradTensorHolder::add(size_t slot_id,
                           "and make sure it creates grads.",
                           t.name()));
 
+    if (!create_graph && CanDeferAdd(t, buffer_tensor)) {
+      auto& pending = pending_grads_[{slot_id, rank}];
+      pending.push_back(t);
+      if (static_cast<int>(pending.size()) + 1 >=
+          FLAGS_eager_grad_add_n_max_inputs) {
+        SumPendingGrads(slot_id, rank);
+      }
+      return;
+    }
+    // the grads kept are added first, as they came before t
+    SumPendingGrads(slot_id, rank);
+
     if (t.is_dense_tensor()) {
       if (buffer_tensor.is_dense_tensor()) {
         if (create_graph || t.is_custom_device()) {
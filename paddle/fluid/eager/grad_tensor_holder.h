@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "paddle/fluid/eager/grad_node_info.h"
 
 namespace egr {
@@ -23,7 +27,11 @@ namespace egr {
  * Since we will have one output used by multi preceding ops in forward pass,
  * we will meet a problem that we need to accumulate multiple grads into one.
  *
- * GradTensorHolder should have as same format as forward output **/
+ * GradTensorHolder should have as same format as forward output
+ *
+ * The dense grads of a slot are not added one by one, they are kept until
+ * the buffer is read and summed into the first one with one add_n kernel,
+ * FLAGS_eager_grad_add_n_max_inputs at most at once. **/
 class GradTensorHolder {
  public:
   explicit GradTensorHolder(
@@ -56,19 +64,33 @@ class GradTensorHolder {
                            bool fill_one = false);
 
   const std::vector<paddle::Tensor>& operator[](const size_t& pos) {
+    SumPendingGrads();
     return buffer_[pos];
   }
 
   paddle::small_vector<std::vector<paddle::Tensor>, kSlotSmallVectorSize>&
   Buffers() {
+    SumPendingGrads();
     return buffer_;
   }
 
   void SetBufferSlotRankZeros(size_t slot_id, size_t rank);
 
  private:
+  void SumPendingGrads() {
+    while (!pending_grads_.empty()) {
+      auto iter = pending_grads_.begin();
+      SumPendingGrads(iter->first.first, iter->first.second);
+    }
+  }
+  // Adds the grads kept for slot_id and rank to the buffer.
+  void SumPendingGrads(size_t slot_id, size_t rank);
+
   paddle::small_vector<std::vector<paddle::Tensor>, kSlotSmallVectorSize>
       buffer_;
+  // the grads of each slot and rank not added to buffer_ yet
+  std::map<std::pair<size_t, size_t>, std::vector<paddle::Tensor>>
+      pending_grads_;
 };
 
 }  // namespace egr
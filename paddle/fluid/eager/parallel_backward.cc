@@ -0,0 +1,292 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/eager/parallel_backward.h"
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_set>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/eager/accumulation/accumulation_node.h"
+#include "paddle/fluid/eager/api/utils/global_utils.h"
+#include "paddle/phi/core/memory/stats.h"
+#include "paddle/phi/core/platform/profiler/event_tracing.h"
+
+COMMON_DECLARE_int32(eager_backward_thread_num);
+COMMON_DECLARE_bool(eager_backward_deterministic);
+
+namespace egr {
+
+// The pool is kept across backward calls and built again once the flag
+// changes, a runner still on the old one holds it until it is done.
+static std::shared_ptr<phi::ThreadPool> GetBackwardThreadPool(int num) {
+  static std::mutex mutex;
+  static std::shared_ptr<phi::ThreadPool> pool;
+  static int pool_size = 0;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (pool == nullptr || pool_size != num) {
+    pool = std::make_shared<phi::ThreadPool>(num);
+    pool_size = num;
+  }
+  return pool;
+}
+
+bool ParallelBackwardRunner::Enabled(const phi::Place& place) {
+  // the kernels of a device share one context, whose stream and library
+  // handles are not meant to be used by several threads at once
+  return FLAGS_eager_backward_thread_num > 1 && phi::is_cpu_place(place);
+}
+
+ParallelBackwardRunner::ParallelBackwardRunner(BufferMap* buffers,
+                                               bool retain_graph,
+                                               const phi::Place& place)
+    : buffers_(buffers),
+      retain_graph_(retain_graph),
+      place_(place),
+      deterministic_(FLAGS_eager_backward_deterministic),
+      tracer_(Controller::Instance().GetCurrentTracer()),
+      has_grad_(Controller::Instance().HasGrad()) {}
+
+bool ParallelBackwardRunner::Run(
+    const std::deque<GradNodeBase*>& start_nodes,
+    const std::unordered_map<GradNodeBase*, int>& in_degree_map) {
+  if (std::none_of(start_nodes.begin(),
+                   start_nodes.end(),
+                   [&in_degree_map](GradNodeBase* node) {
+                     auto iter = in_degree_map.find(node);
+                     return iter == in_degree_map.end() || iter->second == 0;
+                   })) {
+    return false;
+  }
+
+  // Number the nodes in a breadth first walk, which only depends on the
+  // graph, to order the grads summed into a node.
+  std::deque<GradNodeBase*> queue(start_nodes.begin(), start_nodes.end());
+  std::unordered_set<GradNodeBase*> visited;
+  size_t order = 0;
+  while (!queue.empty()) {
+    GradNodeBase* node = queue.front();
+    queue.pop_front();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    NodeState& state = states_[node];
+    state.order = order++;
+    auto degree_iter = in_degree_map.find(node);
+    if (degree_iter != in_degree_map.end()) {
+      state.in_degree = degree_iter->second;
+    }
+    auto buffer_iter = buffers_->find(node);
+    if (buffer_iter != buffers_->end()) {
+      state.buffer = std::move(buffer_iter->second);
+      buffers_->erase(buffer_iter);
+    }
+    for (const auto& meta_list : node->OutputMeta()) {
+      for (const GradSlotMeta& meta : meta_list) {
+        GradNodeBase* next_node = meta.GetEdge().GetMutableGradNode().get();
+        if (next_node) {
+          queue.push_back(next_node);
+        }
+      }
+    }
+  }
+
+  pool_ = GetBackwardThreadPool(FLAGS_eager_backward_thread_num);
+  VLOG(3) << "Run backward of " << states_.size() << " grad nodes with "
+          << FLAGS_eager_backward_thread_num << " threads";
+  for (GradNodeBase* node : start_nodes) {
+    if (states_.at(node).in_degree == 0) {
+      Schedule(node);
+    }
+  }
+
+  while (true) {
+    GradNodeBase* node = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock,
+               [this] { return !caller_queue_.empty() || running_ == 0; });
+      if (caller_queue_.empty()) {
+        break;
+      }
+      node = caller_queue_.front();
+      caller_queue_.pop_front();
+    }
+    if (failed_) {
+      continue;
+    }
+    try {
+      RunNode(node);
+    } catch (...) {
+      SetError(std::current_exception());
+    }
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  return true;
+}
+
+void ParallelBackwardRunner::Schedule(GradNodeBase* node) {
+  if (dynamic_cast<egr::GradNodeAccumulation*>(node)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    caller_queue_.push_back(node);
+    cv_.notify_all();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++running_;
+  }
+  pool_->Run([this, node] {
+    auto& controller = Controller::Instance();
+    auto tracer = controller.GetCurrentTracer();
+    controller.SetCurrentTracer(tracer_);
+    bool has_grad = controller.HasGrad();
+    controller.SetHasGrad(has_grad_);
+    if (!failed_) {
+      try {
+        RunNode(node);
+      } catch (...) {
+        SetError(std::current_exception());
+      }
+    }
+    controller.SetHasGrad(has_grad);
+    controller.SetCurrentTracer(tracer);
+    // notify under the lock, the runner is gone once it sees running_ 0
+    std::lock_guard<std::mutex> lock(mutex_);
+    --running_;
+    cv_.notify_all();
+  });
+}
+
+void ParallelBackwardRunner::RunNode(GradNodeBase* node) {
+  VLOG(3) << "Preparing GradNode:" << node->name() << " addr:" << node;
+  NodeState& state = states_.at(node);
+  // all the producers are done, no other thread touches the state now
+  if (!state.pending.empty()) {
+    std::sort(state.pending.begin(),
+              state.pending.end(),
+              [](const PendingGrad& a, const PendingGrad& b) {
+                return std::tie(a.producer_order, a.slot, a.rank) <
+                       std::tie(b.producer_order, b.slot, b.rank);
+              });
+    if (!state.buffer) {
+      state.buffer = std::make_unique<GradTensorHolder>(node->InputMeta());
+    }
+    for (const auto& pending : state.pending) {
+      state.buffer->add(
+          pending.edge_slot, pending.edge_rank, pending.grad, false);
+    }
+    state.pending.clear();
+  }
+  PADDLE_ENFORCE_NOT_NULL(
+      state.buffer,
+      common::errors::Fatal(
+          "Unable to find next node in the GradTensorHolder \n"
+          "Trying to run Node without configuring its GradTensorHolder."));
+
+  EnforceGradNodeHasInput(node);
+
+  phi::RecordEvent grad_node_record_event(
+      "Global_" + std::string((*node).name()),
+      phi::TracerEventType::Operator,
+      1);
+
+  paddle::small_vector<std::vector<paddle::Tensor>, kSlotSmallVectorSize>
+      grad_output_tensors = (*node)(state.buffer->Buffers(), false, false);
+
+  if (!retain_graph_) {
+    node->ClearTensorWrappers();
+  }
+  state.buffer.reset();
+
+  const paddle::small_vector<std::vector<GradSlotMeta>, kSlotSmallVectorSize>&
+      metas = node->OutputMeta();
+  PADDLE_ENFORCE(metas.size() == grad_output_tensors.size() || metas.empty(),
+                 common::errors::Fatal(
+                     "Number of edges should be either empty ( for leaf node "
+                     ") or the same as number of output grad tensors, but we "
+                     "got edges size is: %d, grad_output size is: %d",
+                     metas.size(),
+                     grad_output_tensors.size()));
+
+  for (size_t i = 0; i < metas.size(); i++) {
+    for (size_t j = 0; j < metas[i].size(); j++) {
+      const Edge& edge = metas[i][j].GetEdge();
+      if (!edge.IsInitialized()) {
+        continue;
+      }
+      auto edge_rank = edge.GetEdgeRankInfo();
+      auto next_node_shared = edge.GetMutableGradNode();
+      if (!next_node_shared || !next_node_shared.get() ||
+          grad_output_tensors[i].empty()) {
+        continue;
+      }
+      PADDLE_ENFORCE_LT(
+          j,
+          grad_output_tensors[i].size(),
+          common::errors::Fatal(
+              "Rank of grad_output_tensors should be less than "
+              "grad_output_tensors[i].size(), which is: %d. This error may "
+              "indicate autoprune or autograd api error. ",
+              grad_output_tensors.size()));
+      paddle::Tensor& grad_output_tensor = grad_output_tensors[i][j];
+
+      auto* next_node = next_node_shared.get();
+      NodeState& next_state = states_.at(next_node);
+      bool ready = false;
+      {
+        std::lock_guard<std::mutex> lock(next_state.mutex);
+        if (deterministic_) {
+          next_state.pending.push_back({state.order,
+                                        i,
+                                        j,
+                                        edge_rank.first,
+                                        edge_rank.second,
+                                        grad_output_tensor});
+        } else {
+          if (!next_state.buffer) {
+            next_state.buffer =
+                std::make_unique<GradTensorHolder>(next_node->InputMeta());
+          }
+          next_state.buffer->add(
+              edge_rank.first, edge_rank.second, grad_output_tensor, false);
+        }
+        ready = --next_state.in_degree == 0;
+        PADDLE_ENFORCE(
+            next_state.in_degree >= 0,
+            common::errors::Fatal(
+                "Detected in-degree value smaller than zero. For Node: %s"
+                "Node's in-degree cannot be negative.",
+                next_node->name()));
+      }
+      if (ready) {
+        Schedule(next_node);
+      }
+    }
+  }
+  paddle::memory::LogDeviceMemoryStats(place_, std::string((*node).name()));
+}
+
+void ParallelBackwardRunner::SetError(std::exception_ptr error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!error_) {
+    error_ = error;
+  }
+  failed_ = true;
+}
+
+}  // namespace egr
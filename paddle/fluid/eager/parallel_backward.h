@@ -0,0 +1,105 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/fluid/eager/grad_node_info.h"
+#include "paddle/fluid/eager/grad_tensor_holder.h"
+#include "paddle/fluid/imperative/tracer.h"
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/threadpool.h"
+
+namespace egr {
+
+// Defined in backward.cc.
+void EnforceGradNodeHasInput(GradNodeBase* node);
+
+// Runs the grad nodes of a backward graph on FLAGS_eager_backward_thread_num
+// threads, each node once all the nodes feeding it are done.
+//
+// GradNodeAccumulation nodes, which write the grads of the leaf tensors and
+// run their reduce hooks, are left to the calling thread, so these stay
+// single threaded as in the sequential engine. With
+// FLAGS_eager_backward_deterministic the grads of a node are kept until it
+// is ready and summed in the order of their producers in a breadth first
+// walk of the graph, so the sum does not depend on which thread ends first.
+class ParallelBackwardRunner {
+ public:
+  using BufferMap =
+      std::unordered_map<GradNodeBase*, std::unique_ptr<GradTensorHolder>>;
+
+  // Returns whether a backward on place may run in parallel.
+  static bool Enabled(const phi::Place& place);
+
+  ParallelBackwardRunner(BufferMap* buffers,
+                         bool retain_graph,
+                         const phi::Place& place);
+
+  // Runs the graph from start_nodes, returns false without running any
+  // node when none of them is ready.
+  bool Run(const std::deque<GradNodeBase*>& start_nodes,
+           const std::unordered_map<GradNodeBase*, int>& in_degree_map);
+
+ private:
+  struct PendingGrad {
+    size_t producer_order;
+    size_t slot;
+    size_t rank;
+    size_t edge_slot;
+    size_t edge_rank;
+    paddle::Tensor grad;
+  };
+
+  struct NodeState {
+    std::mutex mutex;
+    std::unique_ptr<GradTensorHolder> buffer;
+    int in_degree = 0;
+    size_t order = 0;
+    std::vector<PendingGrad> pending;
+  };
+
+  void Schedule(GradNodeBase* node);
+  void RunNode(GradNodeBase* node);
+  void SetError(std::exception_ptr error);
+
+  BufferMap* buffers_;
+  bool retain_graph_;
+  phi::Place place_;
+  bool deterministic_;
+  std::shared_ptr<phi::ThreadPool> pool_;
+  // the thread local eager state of the calling thread, for the pool
+  std::shared_ptr<paddle::imperative::Tracer> tracer_;
+  bool has_grad_;
+  std::unordered_map<GradNodeBase*, NodeState> states_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // the ready accumulation nodes, run by the calling thread
+  std::deque<GradNodeBase*> caller_queue_;
+  // the nodes handed to the pool and not done yet
+  int running_ = 0;
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+};
+
+}  // namespace egr
@@ -0,0 +1,203 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/eager/recompute.h"
+
+#include "glog/logging.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace egr {
+
+class RecomputeEntry {
+ public:
+  enum class State { kUndecided, kKept, kDropped };
+
+  struct Input {
+    // the tensor itself, or only its meta when it is recomputed too
+    paddle::Tensor tensor;
+    std::shared_ptr<RecomputeEntry> entry;
+    uint32_t inplace_version;
+  };
+
+  std::string op_name;
+  Recomputer::RecomputeFunction function;
+  std::vector<Input> inputs;
+  std::weak_ptr<phi::TensorBase> out;
+  phi::DDim out_dims;
+  uint32_t out_inplace_version = 0;
+  State state = State::kUndecided;
+};
+
+static uint32_t InplaceVersion(const paddle::Tensor& tensor) {
+  return static_cast<phi::DenseTensor*>(tensor.impl().get())
+      ->InplaceVersionCounter()
+      .CurrentVersion();
+}
+
+Recomputer& Recomputer::Instance() {
+  static Recomputer instance;
+  return instance;
+}
+
+void Recomputer::Enable(int64_t budget_bytes,
+                        const std::vector<std::string>& ops) {
+  PADDLE_ENFORCE_GE(budget_bytes,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The budget of the saved tensors kept with "
+                        "recompute should not be negative, but got %d.",
+                        budget_bytes));
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_bytes_ = budget_bytes;
+  ops_ = std::unordered_set<std::string>(ops.begin(), ops.end());
+  enabled_ = true;
+}
+
+void Recomputer::Disable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_ = false;
+  outputs_.clear();
+  kept_bytes_ = 0;
+}
+
+void Recomputer::Register(const char* op_name,
+                          const paddle::Tensor& out,
+                          const std::vector<paddle::Tensor>& inputs,
+                          RecomputeFunction function) {
+  if (!out.initialized() || !out.is_dense_tensor()) {
+    return;
+  }
+  for (const auto& input : inputs) {
+    if (!input.initialized() || !input.is_dense_tensor()) {
+      return;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!enabled_ || (!ops_.empty() && ops_.count(op_name) == 0)) {
+    return;
+  }
+  auto entry = std::make_shared<RecomputeEntry>();
+  entry->op_name = op_name;
+  entry->function = std::move(function);
+  for (const auto& input : inputs) {
+    RecomputeEntry::Input saved{input, nullptr, InplaceVersion(input)};
+    // The grad node of the op saved its inputs just before, an input it
+    // dropped is rebuilt from its own entry rather than kept alive here
+    auto iter = outputs_.find(input.impl().get());
+    if (iter != outputs_.end() &&
+        iter->second->state == RecomputeEntry::State::kDropped &&
+        iter->second->out.lock() == input.impl()) {
+      auto* dense_tensor = static_cast<phi::DenseTensor*>(input.impl().get());
+      auto meta_tensor = std::make_shared<phi::DenseTensor>(
+          std::make_shared<phi::Allocation>(nullptr, 0, input.place()),
+          dense_tensor->meta());
+      meta_tensor->ShareInplaceVersionCounterWith(*dense_tensor);
+      saved.tensor = paddle::Tensor(meta_tensor);
+      saved.entry = iter->second;
+    }
+    entry->inputs.push_back(std::move(saved));
+  }
+  entry->out = out.impl();
+  entry->out_dims = out.dims();
+  entry->out_inplace_version = InplaceVersion(out);
+  outputs_[out.impl().get()] = std::move(entry);
+
+  if (outputs_.size() % 1024 == 0) {
+    for (auto iter = outputs_.begin(); iter != outputs_.end();) {
+      iter = iter->second->out.expired() ? outputs_.erase(iter)
+                                         : std::next(iter);
+    }
+  }
+}
+
+std::shared_ptr<RecomputeEntry> Recomputer::Drop(
+    const paddle::Tensor& tensor) {
+  if (!enabled_ || !tensor.initialized() || !tensor.is_dense_tensor()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = outputs_.find(tensor.impl().get());
+  if (iter == outputs_.end()) {
+    return nullptr;
+  }
+  auto entry = iter->second;
+  // the address may be reused by a tensor the op did not produce, and the
+  // output changed in place is no longer what the kernel gives
+  if (entry->out.lock() != tensor.impl() ||
+      entry->out_inplace_version != InplaceVersion(tensor)) {
+    outputs_.erase(iter);
+    return nullptr;
+  }
+  if (entry->state == RecomputeEntry::State::kUndecided) {
+    int64_t bytes = static_cast<int64_t>(
+        static_cast<phi::DenseTensor*>(tensor.impl().get())->memory_size());
+    if (kept_bytes_ + bytes <= budget_bytes_) {
+      kept_bytes_ += bytes;
+      entry->state = RecomputeEntry::State::kKept;
+    } else {
+      entry->state = RecomputeEntry::State::kDropped;
+      VLOG(6) << "Drop " << bytes << " bytes saved from " << entry->op_name
+              << " to recompute them in backward";
+    }
+  }
+  return entry->state == RecomputeEntry::State::kDropped ? entry : nullptr;
+}
+
+std::shared_ptr<phi::Allocation> Recomputer::Recompute(
+    RecomputeEntry* entry) {
+  std::vector<paddle::Tensor> inputs;
+  inputs.reserve(entry->inputs.size());
+  for (const auto& input : entry->inputs) {
+    PADDLE_ENFORCE_EQ(
+        InplaceVersion(input.tensor),
+        input.inplace_version,
+        common::errors::PermissionDenied(
+            "Tensor '%s' used to recompute the output of %s in backward has "
+            "been modified by an inplace operation. Its version is %d but "
+            "the expected version is %d.",
+            input.tensor.name(),
+            entry->op_name,
+            InplaceVersion(input.tensor),
+            input.inplace_version));
+    if (input.entry) {
+      auto* dense_tensor =
+          static_cast<phi::DenseTensor*>(input.tensor.impl().get());
+      inputs.emplace_back(std::make_shared<phi::DenseTensor>(
+          Recompute(input.entry.get()), dense_tensor->meta()));
+    } else {
+      inputs.push_back(input.tensor);
+    }
+  }
+  VLOG(6) << "Recompute the output of " << entry->op_name << " in backward";
+  paddle::Tensor out = entry->function(inputs);
+  PADDLE_ENFORCE_EQ(out.dims(),
+                    entry->out_dims,
+                    common::errors::PreconditionNotMet(
+                        "The output of %s recomputed in backward has the "
+                        "shape [%s], but [%s] in forward.",
+                        entry->op_name,
+                        out.dims(),
+                        entry->out_dims));
+  return static_cast<phi::DenseTensor*>(out.impl().get())->Holder();
+}
+
+void Recomputer::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  outputs_.clear();
+  kept_bytes_ = 0;
+}
+
+}  // namespace egr
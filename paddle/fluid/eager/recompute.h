@@ -0,0 +1,83 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/phi/api/include/tensor.h"
+#include "paddle/phi/core/allocator.h"
+
+namespace egr {
+
+// The kernel and inputs an output is recomputed from, defined in the .cc.
+class RecomputeEntry;
+
+// Recomputes the tensors saved for backward from the inputs of the ops that
+// produced them, instead of keeping them through forward.
+//
+// Once enabled, the generated forward of an op whose inputs are all saved
+// for its own backward registers its output with a function re-running the
+// kernel. A later TensorWrapper saving that output asks Drop() whether to
+// keep only its meta: the first budget_bytes of recomputable tensors saved
+// in a backward are kept, the rest are dropped, so the memory of the saved
+// activations is capped at about the budget and what the ops save anyway.
+// Recompute() runs the kernel again when the grad node needs the tensor.
+class Recomputer {
+ public:
+  using RecomputeFunction =
+      std::function<paddle::Tensor(const std::vector<paddle::Tensor>&)>;
+
+  static Recomputer& Instance();
+
+  // ops limits the recompute to the outputs of these ops, all when empty.
+  void Enable(int64_t budget_bytes, const std::vector<std::string>& ops);
+  void Disable();
+  bool IsEnable() const { return enabled_; }
+
+  void Register(const char* op_name,
+                const paddle::Tensor& out,
+                const std::vector<paddle::Tensor>& inputs,
+                RecomputeFunction function);
+
+  // Returns how to recompute tensor when it is not kept, nullptr otherwise.
+  std::shared_ptr<RecomputeEntry> Drop(const paddle::Tensor& tensor);
+
+  std::shared_ptr<phi::Allocation> Recompute(RecomputeEntry* entry);
+
+  // Forgets the registered outputs and the bytes kept, once a backward is
+  // done with the graph they were saved for.
+  void Clear();
+
+ private:
+  Recomputer() = default;
+
+  bool enabled_ = false;
+  int64_t budget_bytes_ = 0;
+  int64_t kept_bytes_ = 0;
+  std::unordered_set<std::string> ops_;
+
+  std::mutex mutex_;
+  std::unordered_map<const phi::TensorBase*, std::shared_ptr<RecomputeEntry>>
+      outputs_;
+};
+
+}  // namespace egr
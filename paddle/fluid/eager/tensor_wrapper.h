@@ -25,8 +25,10 @@
  * with no grad **/
 
 #pragma once
+#include "paddle/fluid/eager/activation_offload.h"
 #include "paddle/fluid/eager/autograd_meta.h"
 #include "paddle/fluid/eager/grad_node_info.h"
+#include "paddle/fluid/eager/recompute.h"
 #include "paddle/fluid/eager/utils.h"
 #include "paddle/phi/api/lib/utils/allocator.h"
 #ifndef PADDLE_NO_PYTHON
@@ -122,7 +124,27 @@ class TensorWrapper {
         packed_value_ = (*pack_hook)(tensor);
       } else {
 #endif
-        intermidiate_tensor_.set_impl(tensor.impl());
+        if (Recomputer::Instance().IsEnable()) {
+          recompute_entry_ = Recomputer::Instance().Drop(tensor);
+        }
+        if (!recompute_entry_ && ActivationOffloader::Instance().IsEnable() &&
+            tensor.is_dense_tensor() && tensor_autograd_meta &&
+            !tensor_autograd_meta->Persistable()) {
+          offloaded_ = ActivationOffloader::Instance().Offload(
+              *static_cast<phi::DenseTensor*>(tensor.impl().get()));
+        }
+        if (recompute_entry_ || offloaded_) {
+          // Only keep Meta, the buffer is recomputed or copied to host
+          phi::DenseTensor* dense_tensor =
+              static_cast<phi::DenseTensor*>(tensor.impl().get());
+          auto meta_tensor = std::make_shared<phi::DenseTensor>(
+              std::make_shared<phi::Allocation>(nullptr, 0, tensor.place()),
+              dense_tensor->meta());
+          meta_tensor->ShareInplaceVersionCounterWith(*dense_tensor);
+          intermidiate_tensor_.set_impl(meta_tensor);
+        } else {
+          intermidiate_tensor_.set_impl(tensor.impl());
+        }
 #ifndef PADDLE_NO_PYTHON
       }
 #endif
@@ -191,6 +213,17 @@ class TensorWrapper {
 #endif
 
     paddle::Tensor recovered_tensor = intermidiate_tensor_;
+    if (recompute_entry_ || offloaded_) {
+      phi::DenseTensor* dense_tensor =
+          static_cast<phi::DenseTensor*>(intermidiate_tensor_.impl().get());
+      auto reloaded_tensor = std::make_shared<phi::DenseTensor>(
+          recompute_entry_
+              ? Recomputer::Instance().Recompute(recompute_entry_.get())
+              : ActivationOffloader::Instance().Reload(offloaded_.get()),
+          dense_tensor->meta());
+      reloaded_tensor->ShareInplaceVersionCounterWith(*dense_tensor);
+      recovered_tensor.set_impl(reloaded_tensor);
+    }
 
     std::shared_ptr<GradNodeBase> new_grad_node = weak_grad_node_.lock();
     if (new_grad_node) {
@@ -216,7 +249,11 @@ class TensorWrapper {
 
   paddle::Tensor get_intermidiate_tensor() { return intermidiate_tensor_; }
 
-  void clear() { intermidiate_tensor_.reset(); }
+  void clear() {
+    intermidiate_tensor_.reset();
+    recompute_entry_.reset();
+    offloaded_.reset();
+  }
 
  private:
   void check_inplace_version() {
@@ -270,6 +307,8 @@ class TensorWrapper {
   paddle::Tensor intermidiate_tensor_;
   std::weak_ptr<egr::GradNodeBase> weak_grad_node_;
   uint32_t inplace_version_snapshot_ = 0;
+  std::shared_ptr<RecomputeEntry> recompute_entry_;
+  std::shared_ptr<OffloadedTensor> offloaded_;
 #ifndef PADDLE_NO_PYTHON
   std::shared_ptr<egr::PyObjectHolderBase> packed_value_;
   std::shared_ptr<egr::UnPackHookBase> unpack_hook_;
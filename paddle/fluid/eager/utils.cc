@@ -546,11 +546,11 @@ void EagerUtils::FillZeroForEmptyOptionalGradInput(
         grad.set_impl(std::make_shared<phi::distributed::DistTensor>(
             grad_in_metas[i].DistTensorGlobalDims(),
             grad_in_metas[i].DistAttr()));
-        if (grad_in_metas[i].GetTensorMeta().dims.size() != -1) {
+        if (grad_in_metas[i].GetTensorMeta().rank() != -1) {
           auto tensor_with_zero = paddle::experimental::full(
-              common::vectorize(grad_in_metas[i].GetTensorMeta().dims),
+              common::vectorize(grad_in_metas[i].GetTensorMeta().dims()),
               0.0,
-              grad_in_metas[i].GetTensorMeta().dtype,
+              grad_in_metas[i].GetTensorMeta().dtype(),
               grad_in_metas[i].GetPlace());
           *(static_cast<phi::distributed::DistTensor*>(grad.impl().get())
                 ->unsafe_mutable_value()) =
@@ -558,9 +558,9 @@ void EagerUtils::FillZeroForEmptyOptionalGradInput(
         }
       } else {
         auto tensor_with_zero = paddle::experimental::full(
-            common::vectorize(grad_in_metas[i].GetTensorMeta().dims),
+            common::vectorize(grad_in_metas[i].GetTensorMeta().dims()),
             0.0,
-            grad_in_metas[i].GetTensorMeta().dtype,
+            grad_in_metas[i].GetTensorMeta().dtype(),
             grad_in_metas[i].GetPlace());
         grad.set_impl(tensor_with_zero.impl());
       }
@@ -584,11 +584,11 @@ void EagerUtils::FillZeroForEmptyOptionalGradOutput(
         grad.set_impl(std::make_shared<phi::distributed::DistTensor>(
             grad_output_metas[i].DistTensorGlobalDims(),
             grad_output_metas[i].DistAttr()));
-        if (grad_output_metas[i].GetTensorMeta().dims.size() != -1) {
+        if (grad_output_metas[i].GetTensorMeta().rank() != -1) {
           auto tensor_with_zero = paddle::experimental::full(
-              common::vectorize(grad_output_metas[i].GetTensorMeta().dims),
+              common::vectorize(grad_output_metas[i].GetTensorMeta().dims()),
               0.0,
-              grad_output_metas[i].GetTensorMeta().dtype,
+              grad_output_metas[i].GetTensorMeta().dtype(),
               grad_output_metas[i].GetPlace());
           *(static_cast<phi::distributed::DistTensor*>(grad.impl().get())
                 ->unsafe_mutable_value()) =
@@ -597,9 +597,9 @@ void EagerUtils::FillZeroForEmptyOptionalGradOutput(
       } else {
         auto tensor_with_zero =
             paddle::experimental::full(  // only create dense tensor.
-                common::vectorize(grad_output_metas[i].GetTensorMeta().dims),
+                common::vectorize(grad_output_metas[i].GetTensorMeta().dims()),
                 0.0,
-                grad_output_metas[i].GetTensorMeta().dtype,
+                grad_output_metas[i].GetTensorMeta().dtype(),
                 grad_output_metas[i].GetPlace());
         grad.set_impl(tensor_with_zero.impl());
       }
@@ -618,11 +618,11 @@ void EagerUtils::FillZeroForEmptyGradInput(paddle::Tensor* in_grad,
     if (grad_in_meta.IsDistMeta()) {
       in_grad->set_impl(std::make_shared<phi::distributed::DistTensor>(
           grad_in_meta.DistTensorGlobalDims(), grad_in_meta.DistAttr()));
-      if (tensor_meta.dims.size() != -1) {
+      if (tensor_meta.rank() != -1) {
         auto tensor_with_zero =
-            paddle::experimental::full(common::vectorize(tensor_meta.dims),
+            paddle::experimental::full(common::vectorize(tensor_meta.dims()),
                                        0.0,
-                                       tensor_meta.dtype,
+                                       tensor_meta.dtype(),
                                        grad_in_meta.GetPlace());
         *(static_cast<phi::distributed::DistTensor*>(in_grad->impl().get())
               ->unsafe_mutable_value()) =
@@ -637,9 +637,9 @@ void EagerUtils::FillZeroForEmptyGradInput(paddle::Tensor* in_grad,
       }
     } else {
       auto tensor_with_zero =
-          paddle::experimental::full(common::vectorize(tensor_meta.dims),
+          paddle::experimental::full(common::vectorize(tensor_meta.dims()),
                                      0.0,
-                                     tensor_meta.dtype,
+                                     tensor_meta.dtype(),
                                      grad_in_meta.GetPlace());
       in_grad->set_impl(tensor_with_zero.impl());
     }
@@ -653,11 +653,11 @@ void EagerUtils::FillZeroForEmptyOptionalGradInput(
     if (grad_in_meta.IsDistMeta()) {
       in_grad->set_impl(std::make_shared<phi::distributed::DistTensor>(
           grad_in_meta.DistTensorGlobalDims(), grad_in_meta.DistAttr()));
-      if (tensor_meta.dims.size() != -1) {
+      if (tensor_meta.rank() != -1) {
         auto tensor_with_zero =
-            paddle::experimental::full(common::vectorize(tensor_meta.dims),
+            paddle::experimental::full(common::vectorize(tensor_meta.dims()),
                                        0.0,
-                                       tensor_meta.dtype,
+                                       tensor_meta.dtype(),
                                        grad_in_meta.GetPlace());
         *(static_cast<phi::distributed::DistTensor*>(in_grad->impl().get())
               ->unsafe_mutable_value()) =
@@ -665,9 +665,9 @@ void EagerUtils::FillZeroForEmptyOptionalGradInput(
       }
     } else {
       auto tensor_with_zero =
-          paddle::experimental::full(common::vectorize(tensor_meta.dims),
+          paddle::experimental::full(common::vectorize(tensor_meta.dims()),
                                      0.0,
-                                     tensor_meta.dtype,
+                                     tensor_meta.dtype(),
                                      grad_in_meta.GetPlace());
       in_grad->set_impl(tensor_with_zero.impl());
     }
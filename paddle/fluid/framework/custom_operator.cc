@@ -61,16 +61,17 @@ namespace framework {
 static void RunKernelFunc(
     const framework::ExecutionContext& ctx,
     const paddle::KernelFunc& func,
-    const std::vector<std::string>& inputs,
-    const std::vector<std::string>& outputs,
-    const std::vector<std::string>& attrs,
+    const detail::CustomOpSignature& signature,
     const std::unordered_map<std::string, std::string>& inplace_map) {
   VLOG(3) << "Custom Operator: Start run KernelFunc.";
+  const auto& inputs = signature.inputs;
+  const auto& outputs = signature.outputs;
   // prepare CustomOpKernelContext
   paddle::CustomOpKernelContext kernel_ctx;
-  for (auto& in_name : inputs) {
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const auto& in_name = inputs[i];
     VLOG(3) << "Custom Operator: input name - " << in_name;
-    if (detail::IsDuplicableVar(in_name)) {  // inputs vector<Tensor>
+    if (signature.duplicable_inputs[i]) {  // inputs vector<Tensor>
       std::vector<paddle::Tensor> custom_vec_in;
       if (ctx.HasInputs(in_name)) {  // general vector<Tensor> inputs
         // return const std::vector<const phi::DenseTensor*>
@@ -79,20 +80,20 @@ static void RunKernelFunc(
                           true,
                           common::errors::NotFound(
                               "Input vector<tensor> (%s) is empty.", in_name));
-        for (size_t i = 0; i < vec_x.size(); ++i) {
-          auto* x = vec_x[i];
+        for (size_t j = 0; j < vec_x.size(); ++j) {
+          auto* x = vec_x[j];
           PADDLE_ENFORCE_NOT_NULL(
               x,
               common::errors::NotFound(
                   "The %d-th tensor in input vector<tensor> (%s) is nullptr.",
-                  i,
+                  j,
                   in_name));
           PADDLE_ENFORCE_EQ(x->IsInitialized(),
                             true,
                             common::errors::InvalidArgument(
                                 "The %d-th tensor in input vector<tensor> (%s) "
                                 "is not initialized.",
-                                i,
+                                j,
                                 in_name));
           paddle::Tensor custom_t;
           custom_t.set_impl(std::make_shared<phi::DenseTensor>(*x));
@@ -100,7 +101,7 @@ static void RunKernelFunc(
         }
       } else {  // optional vector<Tensor> inputs.
         PADDLE_ENFORCE(
-            detail::IsOptionalVar(in_name),
+            signature.optional_inputs[i],
             common::errors::NotFound("Your custom operator's KernelFunc cannot "
                                      "find input parameter `%s`",
                                      in_name));
@@ -141,7 +142,7 @@ static void RunKernelFunc(
 #endif
       } else {  // optional Tensor inputs
         PADDLE_ENFORCE(
-            detail::IsOptionalVar(in_name),
+            signature.optional_inputs[i],
             common::errors::NotFound("Your custom operator's KernelFunc cannot "
                                      "find input parameter `%s`",
                                      in_name));
@@ -152,37 +153,39 @@ static void RunKernelFunc(
     }
   }
 
-  for (auto& attr_str : attrs) {
-    auto attr_name_and_type = paddle::ParseAttrStr(attr_str);
-    auto attr_name = attr_name_and_type[0];
-    auto attr_type_str = attr_name_and_type[1];
-    if (attr_type_str == "bool") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<bool>(attr_name));
-    } else if (attr_type_str == "int") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<int>(attr_name));
-    } else if (attr_type_str == "float") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<float>(attr_name));
-    } else if (attr_type_str == "int64_t") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<int64_t>(attr_name));
-    } else if (attr_type_str == "std::string") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::string>(attr_name));
-    } else if (attr_type_str == "std::vector<int>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int>>(attr_name));
-    } else if (attr_type_str == "std::vector<float>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<float>>(attr_name));
-    } else if (attr_type_str == "std::vector<int64_t>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int64_t>>(attr_name));
-    } else if (attr_type_str == "std::vector<std::string>") {
-      kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<std::string>>(attr_name));
-    } else {
-      PADDLE_THROW(common::errors::Unimplemented(
-          "Unsupported `%s` type value as custom attribute now. "
-          "Supported data types include `bool`, `int`, `float`, "
-          "`int64_t`, `std::string`, `std::vector<int>`, "
-          "`std::vector<float>`, `std::vector<int64_t>`, "
-          "`std::vector<std::string>`, Please check whether "
-          "the attribute data type and data type string are matched.",
-          attr_type_str));
+  for (const auto& attr : signature.attrs) {
+    const auto& attr_name = attr.name;
+    switch (attr.type) {
+      case detail::CustomAttrType::kBool:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<bool>(attr_name));
+        break;
+      case detail::CustomAttrType::kInt:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<int>(attr_name));
+        break;
+      case detail::CustomAttrType::kFloat:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<float>(attr_name));
+        break;
+      case detail::CustomAttrType::kInt64:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<int64_t>(attr_name));
+        break;
+      case detail::CustomAttrType::kString:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::string>(attr_name));
+        break;
+      case detail::CustomAttrType::kInts:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int>>(attr_name));
+        break;
+      case detail::CustomAttrType::kFloats:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<float>>(attr_name));
+        break;
+      case detail::CustomAttrType::kInt64s:
+        kernel_ctx.EmplaceBackAttr(ctx.Attr<std::vector<int64_t>>(attr_name));
+        break;
+      case detail::CustomAttrType::kStrings:
+        kernel_ctx.EmplaceBackAttr(
+            ctx.Attr<std::vector<std::string>>(attr_name));
+        break;
+      default:
+        detail::ThrowUnsupportedCustomAttr(attr.type_str);
     }
   }
 
@@ -190,9 +193,8 @@ static void RunKernelFunc(
   // cache the target tensor pointers
   std::vector<phi::DenseTensor*> true_out_ptrs;
   for (size_t i = 0; i < outputs.size(); ++i) {
-    auto out_name = outputs[i];
-    if (detail::IsDuplicableVar(
-            out_name)) {  // general/inplace vector<Tensor> outputs
+    const auto& out_name = outputs[i];
+    if (signature.duplicable_outputs[i]) {  // general/inplace vector<Tensor>
       PADDLE_ENFORCE(
           !inplace_map.empty() || (i == 0UL && outputs.size() == 1UL),
           common::errors::PreconditionNotMet(
@@ -202,7 +204,7 @@ static void RunKernelFunc(
       // handle inplace optional outputs = None case
       if (vec_out.empty()) {
         PADDLE_ENFORCE(
-            detail::IsOptionalVar(out_name) && !inplace_map.empty(),
+            signature.optional_outputs[i] && !inplace_map.empty(),
             common::errors::InvalidArgument(
                 "Custom operator couldn't find custom output for name %s. If "
                 "you "
@@ -239,7 +241,7 @@ static void RunKernelFunc(
       // handle inplace optional outputs = None case
       if (!ctx.HasOutput(out_name)) {
         PADDLE_ENFORCE(
-            detail::IsOptionalVar(out_name) && !inplace_map.empty(),
+            signature.optional_outputs[i] && !inplace_map.empty(),
             common::errors::InvalidArgument(
                 "Custom operator couldn't find custom output for name %s. If "
                 "you "
@@ -919,12 +921,13 @@ static void RegisterOperatorKernel(
   OperatorWithKernel::OpKernelFunc op_kernel_func;
   if (kernel_func) {
     VLOG(3) << "Register custom operator " << name << " with kernel func";
-    op_kernel_func =
-        [kernel_func, inputs, outputs, attrs, inplace_map](  // NOLINT
-            const framework::ExecutionContext& ctx) {
-          VLOG(3) << "Custom Operator: run custom kernel func in lambda.";
-          RunKernelFunc(ctx, kernel_func, inputs, outputs, attrs, inplace_map);
-        };
+    auto signature =
+        std::make_shared<detail::CustomOpSignature>(inputs, outputs, attrs);
+    op_kernel_func = [kernel_func, signature, inplace_map](  // NOLINT
+                         const framework::ExecutionContext& ctx) {
+      VLOG(3) << "Custom Operator: run custom kernel func in lambda.";
+      RunKernelFunc(ctx, kernel_func, *signature, inplace_map);
+    };
   } else {
     VLOG(3) << "Register custom operator " << name
             << " with raw op kernel func";
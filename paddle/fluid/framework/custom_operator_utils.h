@@ -14,7 +14,11 @@ limitations under the License. */
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/pir/dialect/distributed/ir/dist_tools.h"
@@ -59,6 +63,104 @@ inline static bool IsOptionalVar(const std::string& var_name) {
   return var_name.rfind(suffix) != std::string::npos;
 }
 
+enum class CustomAttrType {
+  kBool,
+  kInt,
+  kFloat,
+  kInt64,
+  kString,
+  kInts,
+  kFloats,
+  kInt64s,
+  kStrings,
+  kUnsupported,
+};
+
+struct CustomAttrSignature {
+  std::string name;
+  std::string type_str;
+  CustomAttrType type;
+};
+
+inline static CustomAttrType GetCustomAttrType(const std::string& type_str) {
+  static const std::unordered_map<std::string, CustomAttrType> attr_types = {
+      {"bool", CustomAttrType::kBool},
+      {"int", CustomAttrType::kInt},
+      {"float", CustomAttrType::kFloat},
+      {"int64_t", CustomAttrType::kInt64},
+      {"std::string", CustomAttrType::kString},
+      {"std::vector<int>", CustomAttrType::kInts},
+      {"std::vector<float>", CustomAttrType::kFloats},
+      {"std::vector<int64_t>", CustomAttrType::kInt64s},
+      {"std::vector<std::string>", CustomAttrType::kStrings}};
+  auto iter = attr_types.find(type_str);
+  return iter == attr_types.end() ? CustomAttrType::kUnsupported
+                                  : iter->second;
+}
+
+inline static void ThrowUnsupportedCustomAttr(const std::string& type_str) {
+  PADDLE_THROW(common::errors::Unimplemented(
+      "Unsupported `%s` type value as custom attribute now. "
+      "Supported data types include `bool`, `int`, `float`, "
+      "`int64_t`, `std::string`, `std::vector<int>`, "
+      "`std::vector<float>`, `std::vector<int64_t>`, "
+      "`std::vector<std::string>`, Please check whether "
+      "the attribute data type and data type string are matched.",
+      type_str));
+}
+
+// The inputs, outputs and attributes of a custom operator parsed once, so
+// that running it doesn't parse the attribute strings and match the suffixes
+// of the names every time. An unsupported attribute type is kept and
+// reported when the operator runs, as before.
+struct CustomOpSignature {
+  CustomOpSignature(const std::vector<std::string>& inputs,
+                    const std::vector<std::string>& outputs,
+                    const std::vector<std::string>& attrs)
+      : inputs(inputs), outputs(outputs) {
+    for (const auto& input : inputs) {
+      duplicable_inputs.push_back(IsDuplicableVar(input));
+      optional_inputs.push_back(IsOptionalVar(input));
+    }
+    for (const auto& output : outputs) {
+      duplicable_outputs.push_back(IsDuplicableVar(output));
+      optional_outputs.push_back(IsOptionalVar(output));
+    }
+    for (const auto& attr : attrs) {
+      auto attr_name_and_type = paddle::ParseAttrStr(attr);
+      this->attrs.push_back({attr_name_and_type[0],
+                             attr_name_and_type[1],
+                             GetCustomAttrType(attr_name_and_type[1])});
+    }
+  }
+
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+  std::vector<bool> duplicable_inputs;
+  std::vector<bool> optional_inputs;
+  std::vector<bool> duplicable_outputs;
+  std::vector<bool> optional_outputs;
+  std::vector<CustomAttrSignature> attrs;
+};
+
+// The signature of the registered custom operator, parsed on first use.
+inline static const CustomOpSignature& GetCustomOpSignature(
+    const paddle::OpMetaInfo& op_meta) {
+  static std::mutex mutex;
+  static std::unordered_map<const paddle::OpMetaInfo*,
+                            std::unique_ptr<CustomOpSignature>>
+      signatures;
+  std::lock_guard<std::mutex> guard(mutex);
+  auto& signature = signatures[&op_meta];
+  if (signature == nullptr) {
+    signature = std::make_unique<CustomOpSignature>(
+        paddle::OpMetaInfoHelper::GetInputs(op_meta),
+        paddle::OpMetaInfoHelper::GetOutputs(op_meta),
+        paddle::OpMetaInfoHelper::GetAttrs(op_meta));
+  }
+  return *signature;
+}
+
 inline static std::string NoGrad(const std::string& var_name,
                                  bool is_double_grad = false) {
   std::string suffix = kGradVarSuffix;
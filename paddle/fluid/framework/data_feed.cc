@@ -24,14 +24,26 @@ limitations under the License. */
 #include <stdio_ext.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #endif
 #include "io/fs.h"
 #include "paddle/common/enforce.h"
+#include "paddle/fluid/framework/slot_record_file.h"
 #include "paddle/phi/core/platform/monitor.h"
 #include "paddle/phi/core/platform/timer.h"
 
 USE_INT_STAT(STAT_total_feasign_num_in_mem);
+USE_INT_STAT(STAT_dataset_reader_queue_size);
+USE_INT_STAT(STAT_dataset_reader_queue_capacity);
+USE_INT_STAT(STAT_dataset_active_reader_num);
+USE_INT_STAT(STAT_dataset_sample_cache_hit_num);
+USE_INT_STAT(STAT_dataset_sample_cache_miss_num);
+USE_INT_STAT(STAT_dataset_sample_cache_saved_ms);
+USE_INT_STAT(STAT_dataset_sample_cache_mem_bytes);
+USE_INT_STAT(STAT_dataset_sample_cache_spill_bytes);
 COMMON_DECLARE_bool(enable_ins_parser_file);
+COMMON_DECLARE_int64(dataset_sample_cache_mem_mb);
+COMMON_DECLARE_string(dataset_sample_cache_spill_dir);
 namespace paddle::framework {
 
 DLManager& global_dlmanager_pool() {
@@ -291,6 +303,118 @@ void DataFeed::CopyToFeedTensor(void* dst, const void* src, size_t size) {
   }
 }
 
+ReaderAutoscaler::ReaderAutoscaler(int min_active_num,
+                                   int max_active_num,
+                                   int interval_ms)
+    : min_active_num_(min_active_num),
+      max_active_num_(max_active_num),
+      interval_ms_(interval_ms),
+      active_num_(max_active_num) {
+  PADDLE_ENFORCE_GT(min_active_num,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The min number of active readers should be greater "
+                        "than 0, but received %d.",
+                        min_active_num));
+  PADDLE_ENFORCE_GE(max_active_num,
+                    min_active_num,
+                    common::errors::InvalidArgument(
+                        "The max number of active readers %d should not be "
+                        "less than the min number %d.",
+                        max_active_num,
+                        min_active_num));
+  PADDLE_ENFORCE_GT(interval_ms,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The autoscale interval should be greater than 0 ms, "
+                        "but received %d.",
+                        interval_ms));
+  STAT_RESET(STAT_dataset_reader_queue_size, 0);
+  STAT_RESET(STAT_dataset_reader_queue_capacity, 0);
+  STAT_RESET(STAT_dataset_active_reader_num, active_num_);
+  monitor_thread_ = std::thread(&ReaderAutoscaler::MonitorThread, this);
+}
+
+ReaderAutoscaler::~ReaderAutoscaler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  monitor_cv_.notify_all();
+  monitor_thread_.join();
+}
+
+void ReaderAutoscaler::AddQueue(std::function<size_t()> size,
+                                size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queues_.emplace_back(std::move(size), capacity);
+}
+
+void ReaderAutoscaler::Acquire() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  uint64_t ticket = next_ticket_++;
+  waiting_.push_back(ticket);
+  cv_.wait(lock, [this, ticket] {
+    return waiting_.front() == ticket && in_use_ < active_num_;
+  });
+  waiting_.pop_front();
+  ++in_use_;
+  lock.unlock();
+  // the next reader in line may fit as well
+  cv_.notify_all();
+}
+
+void ReaderAutoscaler::Release() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --in_use_;
+  }
+  cv_.notify_all();
+}
+
+bool ReaderAutoscaler::ShouldYield() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return in_use_ > active_num_ || !waiting_.empty();
+}
+
+int ReaderAutoscaler::ActiveNum() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return active_num_;
+}
+
+void ReaderAutoscaler::MonitorThread() {
+  // the fill of the queues below which a reader is added and above which
+  // one is removed
+  constexpr double kLowWatermark = 0.25;
+  constexpr double kHighWatermark = 0.75;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!monitor_cv_.wait_for(lock,
+                               std::chrono::milliseconds(interval_ms_),
+                               [this] { return stop_; })) {
+    size_t size = 0;
+    size_t capacity = 0;
+    for (auto& queue : queues_) {
+      size += queue.first();
+      capacity += queue.second;
+    }
+    STAT_RESET(STAT_dataset_reader_queue_size, size);
+    STAT_RESET(STAT_dataset_reader_queue_capacity, capacity);
+    if (capacity == 0) {
+      continue;
+    }
+    double fill = static_cast<double>(size) / static_cast<double>(capacity);
+    if (fill < kLowWatermark && active_num_ < max_active_num_) {
+      ++active_num_;
+      cv_.notify_all();
+    } else if (fill > kHighWatermark && active_num_ > min_active_num_) {
+      --active_num_;
+    }
+    VLOG(3) << "reader queues fill " << size << "/" << capacity
+            << ", active readers " << active_num_;
+    STAT_RESET(STAT_dataset_active_reader_num, active_num_);
+  }
+}
+
 template <typename T>
 void PrivateQueueDataFeed<T>::SetQueueSize(int queue_size) {
   PADDLE_ENFORCE_GT(
@@ -314,18 +438,56 @@ bool PrivateQueueDataFeed<T>::Start() {
   return true;
 }
 
+template <typename T>
+void PrivateQueueDataFeed<T>::SetReaderAutoscaler(
+    std::shared_ptr<ReaderAutoscaler> autoscaler) {
+  reader_autoscaler_ = autoscaler;
+  if (autoscaler != nullptr) {
+    auto queue = queue_;
+    autoscaler->AddQueue([queue] { return queue->Size(); }, queue_size_);
+  }
+}
+
+template <typename T>
+void PrivateQueueDataFeed<T>::PutInstance(const T& instance, int ins_num) {
+  if (reader_autoscaler_ == nullptr) {
+    queue_->Put(instance);
+    return;
+  }
+  if (queue_->Size() >= queue_size_) {
+    // do not hold a permit while the DeviceWorker catches up
+    reader_autoscaler_->Release();
+    queue_->Put(instance);
+    reader_autoscaler_->Acquire();
+  } else {
+    queue_->Put(instance);
+  }
+  if (ins_num % ReaderAutoscaler::kYieldInsNum == 0 &&
+      reader_autoscaler_->ShouldYield()) {
+    reader_autoscaler_->Release();
+    reader_autoscaler_->Acquire();
+  }
+}
+
 template <typename T>
 void PrivateQueueDataFeed<T>::ReadThread() {
 #ifdef _LINUX
   VLOG(4) << "entering PrivateQueueDataFeed<T>::ReadThread()";
   std::string filename;
   while (PickOneFile(&filename)) {
+    if (reader_autoscaler_ != nullptr) {
+      reader_autoscaler_->Acquire();
+    }
     int err_no = 0;
     fp_ = fs_open_read(filename, &err_no, pipe_command_, true);
     __fsetlocking(&*fp_, FSETLOCKING_BYCALLER);
     T instance;
+    int ins_num = 0;
     while (ParseOneInstanceFromPipe(&instance)) {
-      queue_->Put(instance);
+      PutInstance(instance, ++ins_num);
+    }
+    if (reader_autoscaler_ != nullptr) {
+      reader_autoscaler_->Release();
     }
   }
   queue_->Close();
@@ -721,6 +883,9 @@ void MultiSlotDataFeed::ReadThread() {
   VLOG(4) << "entering MultiSlotDataFeed::ReadThread()";
   std::string filename;
   while (PickOneFile(&filename)) {
+    if (reader_autoscaler_ != nullptr) {
+      reader_autoscaler_->Acquire();
+    }
     int err_no = 0;
     fp_ = fs_open_read(filename, &err_no, pipe_command_, true);
     PADDLE_ENFORCE_EQ(fp_ != nullptr,
@@ -732,9 +897,12 @@ void MultiSlotDataFeed::ReadThread() {
     int ins_num = 0;
     while (ParseOneInstanceFromPipe(&instance)) {
       ins_num++;
-      queue_->Put(instance);
+      PutInstance(instance, ins_num);
     }
     VLOG(3) << "filename: " << filename << " inst num: " << ins_num;
+    if (reader_autoscaler_ != nullptr) {
+      reader_autoscaler_->Release();
+    }
   }
   queue_->Close();
 #endif
@@ -2240,6 +2408,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByFile() {
                                  int max_fetch_num,
                                  int offset) {
     if (offset > 0) {
+      CacheSlotRecords(&record_vec[0], offset);
       input_channel_->WriteMove(offset, &record_vec[0]);
       if (max_fetch_num > 0) {
         SlotRecordPool().get(&record_vec[0], offset);
@@ -2260,6 +2429,13 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByFile() {
   while (this->PickOneFile(&filename)) {
     VLOG(3) << "PickOneFile, filename=" << filename
             << ", thread_id=" << thread_id_;
+    if (IsSlotRecordFile(filename)) {
+      LoadIntoMemoryFromSlotRecordFile(filename);
+      continue;
+    }
+    if (LoadIntoMemoryFromSampleCache(filename)) {
+      continue;
+    }
     platform::Timer timeline;
     timeline.Start();
 
@@ -2267,6 +2443,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByFile() {
     bool is_ok = true;
     auto ps_gpu_ptr = PSGPUWrapper::GetInstance();
     do {
+      BeginSampleCache();
       if (ps_gpu_ptr->UseAfsApi()) {
 #ifdef PADDLE_WITH_PSLIB
         auto afs_reader = ps_gpu_ptr->OpenReader(filename);
@@ -2309,6 +2486,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByFile() {
       }
     } while (!is_ok);
     timeline.Pause();
+    EndSampleCache(filename, timeline.ElapsedSec());
     VLOG(3) << "LoadIntoMemoryByLib() read all file, file=" << filename
             << ", cost time=" << timeline.ElapsedSec()
             << " seconds, thread_id=" << thread_id_ << ", lines=" << lines;
@@ -2328,6 +2506,13 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByLine() {
   while (this->PickOneFile(&filename)) {
     VLOG(3) << "PickOneFile, filename=" << filename
             << ", thread_id=" << thread_id_;
+    if (IsSlotRecordFile(filename)) {
+      LoadIntoMemoryFromSlotRecordFile(filename);
+      continue;
+    }
+    if (LoadIntoMemoryFromSampleCache(filename)) {
+      continue;
+    }
     std::vector<SlotRecord> record_vec;
     platform::Timer timeline;
     timeline.Start();
@@ -2340,6 +2525,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByLine() {
                            std::vector<SlotRecord>& vec, int num) {
       vec.resize(num);
       if (offset + num > OBJPOOL_BLOCK_SIZE) {
+        CacheSlotRecords(&record_vec[0], offset);
         input_channel_->WriteMove(offset, &record_vec[0]);
         SlotRecordPool().get(&record_vec[0], offset);
         record_vec.resize(OBJPOOL_BLOCK_SIZE);
@@ -2369,6 +2555,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByLine() {
         return false;
       }
       if (offset >= OBJPOOL_BLOCK_SIZE) {
+        CacheSlotRecords(&record_vec[0], offset);
         input_channel_->Write(std::move(record_vec));
         record_vec.clear();
         SlotRecordPool().get(&record_vec, OBJPOOL_BLOCK_SIZE);
@@ -2380,6 +2567,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByLine() {
     int lines = 0;
 
     do {
+      BeginSampleCache();
       int err_no = 0;
       this->fp_ = fs_open_read(filename, &err_no, this->pipe_command_, true);
       PADDLE_ENFORCE_EQ(this->fp_ != nullptr,
@@ -2391,6 +2579,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByLine() {
     } while (line_reader.is_error());
 
     if (offset > 0) {
+      CacheSlotRecords(&record_vec[0], offset);
       input_channel_->WriteMove(offset, &record_vec[0]);
       if (offset < OBJPOOL_BLOCK_SIZE) {
         SlotRecordPool().put(&record_vec[offset],
@@ -2402,6 +2591,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByLine() {
     record_vec.clear();
     record_vec.shrink_to_fit();
     timeline.Pause();
+    EndSampleCache(filename, timeline.ElapsedSec());
     VLOG(3) << "LoadIntoMemoryByLib() read all lines, file=" << filename
             << ", cost time=" << timeline.ElapsedSec()
             << " seconds, thread_id=" << thread_id_ << ", lines=" << lines
@@ -2424,6 +2614,13 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
   while (this->PickOneFile(&filename)) {
     VLOG(3) << "PickOneFile, filename=" << filename
             << ", thread_id=" << thread_id_;
+    if (IsSlotRecordFile(filename)) {
+      LoadIntoMemoryFromSlotRecordFile(filename);
+      continue;
+    }
+    if (LoadIntoMemoryFromSampleCache(filename)) {
+      continue;
+    }
     int lines = 0;
     std::vector<SlotRecord> record_vec;
     platform::Timer timeline;
@@ -2432,6 +2629,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
     int offset = 0;
 
     do {
+      BeginSampleCache();
       int err_no = 0;
       this->fp_ = fs_open_read(filename, &err_no, this->pipe_command_, true);
       PADDLE_ENFORCE_EQ(this->fp_ != nullptr,
@@ -2451,6 +2649,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
               return false;
             }
             if (offset >= OBJPOOL_BLOCK_SIZE) {
+              CacheSlotRecords(&record_vec[0], offset);
               input_channel_->Write(std::move(record_vec));
               record_vec.clear();
               SlotRecordPool().get(&record_vec, OBJPOOL_BLOCK_SIZE);
@@ -2461,6 +2660,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
           lines);
     } while (line_reader.is_error());
     if (offset > 0) {
+      CacheSlotRecords(&record_vec[0], offset);
       input_channel_->WriteMove(offset, &record_vec[0]);
       if (offset < OBJPOOL_BLOCK_SIZE) {
         SlotRecordPool().put(&record_vec[offset],
@@ -2472,6 +2672,7 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
     record_vec.clear();
     record_vec.shrink_to_fit();
     timeline.Pause();
+    EndSampleCache(filename, timeline.ElapsedSec());
     VLOG(3) << "LoadIntoMemory() read all lines, file=" << filename
             << ", lines=" << lines
             << ", sample lines=" << line_reader.get_sample_line()
@@ -2483,6 +2684,422 @@ void SlotRecordInMemoryDataFeed::LoadIntoMemoryByCommand() {
 #endif
 }
 
+SlotRecordSampleCache& SlotRecordSampleCache::Instance() {
+  static SlotRecordSampleCache cache;
+  return cache;
+}
+
+SlotRecordSampleCache::~SlotRecordSampleCache() { Clear(); }
+
+bool SlotRecordSampleCache::Enabled() const {
+  return FLAGS_dataset_sample_cache_mem_mb > 0 ||
+         !FLAGS_dataset_sample_cache_spill_dir.empty();
+}
+
+bool SlotRecordSampleCache::Find(const std::string& key, Entry* entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    return false;
+  }
+  *entry = iter->second;
+  return true;
+}
+
+void SlotRecordSampleCache::Insert(const std::string& key,
+                                   std::string data,
+                                   double parse_sec) {
+  Entry entry;
+  entry.parse_sec = parse_sec;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // another reader may have parsed the same file
+    if (entries_.count(key) > 0 || spilling_.count(key) > 0) {
+      return;
+    }
+    size_t budget = static_cast<size_t>(
+        std::max<int64_t>(FLAGS_dataset_sample_cache_mem_mb, 0) << 20);
+    if (mem_bytes_ + data.size() <= budget) {
+      mem_bytes_ += data.size();
+      STAT_RESET(STAT_dataset_sample_cache_mem_bytes, mem_bytes_);
+      entry.data = std::make_shared<const std::string>(std::move(data));
+      entries_.emplace(key, std::move(entry));
+      return;
+    }
+    if (FLAGS_dataset_sample_cache_spill_dir.empty()) {
+      return;
+    }
+    if (spill_num_ == 0) {
+      localfs_mkdir(FLAGS_dataset_sample_cache_spill_dir);
+    }
+    entry.spill_path = string::format_string(
+        "%s/sample_cache_%d_%05d%s",
+        FLAGS_dataset_sample_cache_spill_dir.c_str(),
+        static_cast<int>(getpid()),
+        static_cast<int>(spill_num_++),
+        kSlotRecordFileSuffix);
+    spilling_.insert(key);
+  }
+
+  int err_no = 0;
+  bool ok = false;
+  {
+    auto fp = fs_open_write(entry.spill_path, &err_no, "");
+    ok = fp != nullptr &&
+         fwrite(data.data(), sizeof(char), data.size(), fp.get()) ==
+             data.size();
+  }
+  ok = ok && err_no == 0;
+  if (!ok) {
+    LOG(WARNING) << "Fail to spill the sample cache to "
+                 << entry.spill_path;
+    std::remove(entry.spill_path.c_str());
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  spilling_.erase(key);
+  if (ok) {
+    spill_bytes_ += data.size();
+    STAT_RESET(STAT_dataset_sample_cache_spill_bytes, spill_bytes_);
+    entries_.emplace(key, std::move(entry));
+  }
+}
+
+void SlotRecordSampleCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& iter : entries_) {
+    if (!iter.second.spill_path.empty()) {
+      std::remove(iter.second.spill_path.c_str());
+    }
+  }
+  entries_.clear();
+  mem_bytes_ = 0;
+  spill_bytes_ = 0;
+  STAT_RESET(STAT_dataset_sample_cache_mem_bytes, 0);
+  STAT_RESET(STAT_dataset_sample_cache_spill_bytes, 0);
+}
+
+std::string SlotRecordInMemoryDataFeed::SampleCacheKey(
+    const std::string& filename) const {
+  // the records of a file depend on how it is parsed and which slots
+  // are used
+  std::string key = filename + "\n" + pipe_command_ + "\n" + so_parser_name_ +
+                    "\n" + std::to_string(SlotRecordFileFlags(false));
+  for (auto& info : used_slots_info_) {
+    key += "\n" + info.slot + info.type;
+  }
+  return key;
+}
+
+bool SlotRecordInMemoryDataFeed::LoadIntoMemoryFromSampleCache(
+    const std::string& filename) {
+  auto& cache = SlotRecordSampleCache::Instance();
+  // a sampled load is to take other instances every time
+  if (!cache.Enabled() || std::abs(sample_rate_ - 1.0f) >= 1e-5f) {
+    return false;
+  }
+  SlotRecordSampleCache::Entry entry;
+  if (!cache.Find(SampleCacheKey(filename), &entry)) {
+    STAT_ADD(STAT_dataset_sample_cache_miss_num, 1);
+    return false;
+  }
+  platform::Timer timeline;
+  timeline.Start();
+  size_t num_ins = 0;
+  if (entry.data != nullptr) {
+    SlotRecordFileReader reader(entry.data->data(), entry.data->size());
+    num_ins = LoadIntoMemoryFromSlotRecordReader(&reader, filename);
+  } else {
+    LoadIntoMemoryFromSlotRecordFile(entry.spill_path);
+  }
+  timeline.Pause();
+  STAT_ADD(STAT_dataset_sample_cache_hit_num, 1);
+  double saved_sec = entry.parse_sec - timeline.ElapsedSec();
+  if (saved_sec > 0) {
+    STAT_ADD(STAT_dataset_sample_cache_saved_ms,
+             static_cast<int64_t>(saved_sec * 1000));
+  }
+  VLOG(3) << "LoadIntoMemoryFromSampleCache() file=" << filename
+          << ", ins num=" << num_ins << ", cost time=" << timeline.ElapsedSec()
+          << " seconds, parse time=" << entry.parse_sec
+          << " seconds, thread_id=" << thread_id_;
+  return true;
+}
+
+void SlotRecordInMemoryDataFeed::BeginSampleCache() {
+  cache_writer_ = nullptr;
+  cache_data_.clear();
+  if (!SlotRecordSampleCache::Instance().Enabled() ||
+      std::abs(sample_rate_ - 1.0f) >= 1e-5f) {
+    return;
+  }
+  cache_writer_ = std::make_shared<SlotRecordFileWriter>(
+      SlotRecordFileSlots(),
+      SlotRecordFileFlags(false),
+      [this](const char* data, size_t size) {
+        cache_data_.append(data, size);
+        return 0;
+      });
+  cache_writer_->WriteHeader();
+}
+
+void SlotRecordInMemoryDataFeed::CacheSlotRecords(const SlotRecord* records,
+                                                  size_t num) {
+  if (cache_writer_ != nullptr &&
+      WriteSlotRecords(cache_writer_.get(), records, num) != 0) {
+    cache_writer_ = nullptr;
+  }
+}
+
+void SlotRecordInMemoryDataFeed::EndSampleCache(const std::string& filename,
+                                                double parse_sec) {
+  if (cache_writer_ != nullptr && cache_writer_->Flush() == 0) {
+    SlotRecordSampleCache::Instance().Insert(
+        SampleCacheKey(filename), std::move(cache_data_), parse_sec);
+  }
+  cache_writer_ = nullptr;
+  cache_data_ = std::string();
+}
+
+void SlotRecordInMemoryDataFeed::LoadIntoMemoryFromSlotRecordFile(
+    const std::string& filename) {
+#ifdef _LINUX
+  platform::Timer timeline;
+  timeline.Start();
+  // A local file is mapped and read in place, a remote one is streamed.
+  std::unique_ptr<SlotRecordFileReader> reader;
+  std::shared_ptr<FILE> fp;
+  std::shared_ptr<char> mapped;
+  if (fs_select_internal(filename) == 0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    PADDLE_ENFORCE_NE(
+        fd,
+        -1,
+        common::errors::Unavailable("Fail to open file: %s.", filename));
+    struct stat sb = {};
+    fstat(fd, &sb);
+    size_t size = static_cast<size_t>(sb.st_size);
+    void* data = size == 0
+                     ? nullptr
+                     : mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    PADDLE_ENFORCE_NE(
+        data,
+        MAP_FAILED,
+        common::errors::Unavailable("Fail to map file: %s, error: %s.",
+                                    filename,
+                                    strerror(errno)));
+    mapped.reset(static_cast<char*>(data), [size](char* data) {
+      if (data != nullptr) {
+        munmap(data, size);
+      }
+    });
+    if (data != nullptr) {
+      madvise(data, size, MADV_SEQUENTIAL);
+    }
+    reader = std::make_unique<SlotRecordFileReader>(mapped.get(), size);
+  } else {
+    int err_no = 0;
+    fp = fs_open_read(filename, &err_no, "", true);
+    PADDLE_ENFORCE_NOT_NULL(
+        fp,
+        common::errors::Unavailable("Fail to open file: %s.", filename));
+    __fsetlocking(fp.get(), FSETLOCKING_BYCALLER);
+    reader =
+        std::make_unique<SlotRecordFileReader>([&fp](char* buf, size_t len) {
+          return fread(buf, sizeof(char), len, fp.get());
+        });
+  }
+  size_t num_ins = LoadIntoMemoryFromSlotRecordReader(reader.get(), filename);
+  timeline.Pause();
+  VLOG(3) << "LoadIntoMemoryFromSlotRecordFile() read all file, file="
+          << filename << ", ins num=" << num_ins
+          << ", cost time=" << timeline.ElapsedSec()
+          << " seconds, thread_id=" << thread_id_;
+#endif
+}
+
+size_t SlotRecordInMemoryDataFeed::LoadIntoMemoryFromSlotRecordReader(
+    SlotRecordFileReader* reader, const std::string& filename) {
+  PADDLE_ENFORCE_EQ(reader->ReadHeader(),
+                    0,
+                    common::errors::InvalidArgument(
+                        "File %s is not a slot record file.", filename));
+  uint32_t flags = reader->flags();
+  PADDLE_ENFORCE_EQ(
+      !parse_ins_id_ || (flags & kSlotRecordFileInsId),
+      true,
+      common::errors::InvalidArgument(
+          "Slot record file %s has no ins id to parse.", filename));
+  PADDLE_ENFORCE_EQ(
+      !parse_logkey_ || (flags & kSlotRecordFileLogKey),
+      true,
+      common::errors::InvalidArgument(
+          "Slot record file %s has no log key to parse.", filename));
+
+  // The slot of the file each used slot is read from.
+  const auto& file_slots = reader->slots();
+  std::vector<int> uint64_slots(uint64_use_slot_size_, -1);
+  std::vector<int> float_slots(float_use_slot_size_, -1);
+  for (auto& info : used_slots_info_) {
+    auto& slots = info.type[0] == 'u' ? uint64_slots : float_slots;
+    for (size_t i = 0; i < file_slots.size(); ++i) {
+      if (file_slots[i].name == info.slot &&
+          file_slots[i].type == info.type[0]) {
+        slots[info.slot_value_idx] = static_cast<int>(i);
+      }
+    }
+    PADDLE_ENFORCE_GE(
+        slots[info.slot_value_idx],
+        0,
+        common::errors::InvalidArgument(
+            "Slot %s of type %s is not in slot record file %s.",
+            info.slot,
+            info.type,
+            filename));
+  }
+
+  std::default_random_engine random_engine(std::random_device{}());
+  std::uniform_real_distribution<float> uniform_distribution(0.0f, 1.0f);
+  bool sample = std::abs(sample_rate_ - 1.0f) >= 1e-5f;
+  std::vector<uint32_t> sampled;
+  std::vector<SlotRecord> record_vec;
+  SlotRecordFileBlock block;
+  size_t num_ins = 0;
+  int ret = 0;
+  while ((ret = reader->ReadBlock(&block)) == 1) {
+    sampled.clear();
+    for (size_t i = 0; i < block.num_ins; ++i) {
+      if (!sample || uniform_distribution(random_engine) < sample_rate_) {
+        sampled.push_back(i);
+      }
+    }
+    if (sampled.empty()) {
+      continue;
+    }
+    SlotRecordPool().get(&record_vec, static_cast<int>(sampled.size()));
+    for (size_t k = 0; k < sampled.size(); ++k) {
+      uint32_t i = sampled[k];
+      SlotRecord rec = record_vec[k];
+      if (flags & kSlotRecordFileInsId) {
+        rec->ins_id_.assign(block.ins_ids + block.ins_id_offsets[i],
+                            block.ins_id_offsets[i + 1] -
+                                block.ins_id_offsets[i]);
+      }
+      if (flags & kSlotRecordFileLogKey) {
+        rec->search_id = block.search_ids[i];
+        rec->cmatch = block.cmatches[i];
+        rec->rank = block.ranks[i];
+      }
+      auto fill = [&block, i](const std::vector<int>& slots, auto* values) {
+        using T = typename std::remove_reference_t<
+            decltype(values->slot_values)>::value_type;
+        values->slot_values.clear();
+        values->slot_offsets.resize(slots.size() + 1);
+        for (size_t j = 0; j < slots.size(); ++j) {
+          const uint32_t* offsets = block.offsets[slots[j]];
+          const T* data = static_cast<const T*>(block.values[slots[j]]);
+          values->slot_offsets[j] =
+              static_cast<uint32_t>(values->slot_values.size());
+          values->slot_values.insert(values->slot_values.end(),
+                                     data + offsets[i],
+                                     data + offsets[i + 1]);
+        }
+        values->slot_offsets[slots.size()] =
+            static_cast<uint32_t>(values->slot_values.size());
+      };
+      fill(uint64_slots, &rec->slot_uint64_feasigns_);
+      fill(float_slots, &rec->slot_float_feasigns_);
+    }
+    num_ins += sampled.size();
+    input_channel_->Write(std::move(record_vec));
+    record_vec.clear();
+  }
+  PADDLE_ENFORCE_EQ(ret,
+                    0,
+                    common::errors::InvalidArgument(
+                        "Slot record file %s is truncated or corrupted.",
+                        filename));
+  return num_ins;
+}
+
+std::vector<SlotRecordFileSlot>
+SlotRecordInMemoryDataFeed::SlotRecordFileSlots() const {
+  std::vector<SlotRecordFileSlot> slots;
+  for (auto& info : used_slots_info_) {
+    slots.push_back({info.slot, info.type[0]});
+  }
+  return slots;
+}
+
+uint32_t SlotRecordInMemoryDataFeed::SlotRecordFileFlags(bool compress) const {
+  uint32_t flags = compress ? kSlotRecordFileCompress : 0;
+  if (parse_ins_id_ || parse_logkey_) {
+    flags |= kSlotRecordFileInsId;
+  }
+  if (parse_logkey_) {
+    flags |= kSlotRecordFileLogKey;
+  }
+  return flags;
+}
+
+int SlotRecordInMemoryDataFeed::WriteSlotRecords(SlotRecordFileWriter* writer,
+                                                 const SlotRecord* records,
+                                                 size_t num) {
+  int ret = 0;
+  for (size_t k = 0; k < num && ret == 0; ++k) {
+    SlotRecord rec = records[k];
+    writer->BeginInstance(rec->ins_id_, rec->search_id, rec->cmatch, rec->rank);
+    for (size_t i = 0; i < used_slots_info_.size(); ++i) {
+      auto& info = used_slots_info_[i];
+      int idx = info.slot_value_idx;
+      if (info.type[0] == 'u') {
+        auto& values = rec->slot_uint64_feasigns_;
+        writer->AddValues(i,
+                          values.slot_values.data() + values.slot_offsets[idx],
+                          values.slot_offsets[idx + 1] -
+                              values.slot_offsets[idx]);
+      } else {
+        auto& values = rec->slot_float_feasigns_;
+        writer->AddValues(i,
+                          values.slot_values.data() + values.slot_offsets[idx],
+                          values.slot_offsets[idx + 1] -
+                              values.slot_offsets[idx]);
+      }
+    }
+    ret = writer->EndInstance();
+  }
+  return ret;
+}
+
+void SlotRecordInMemoryDataFeed::DumpSlotRecords(const SlotRecord* records,
+                                                 size_t num,
+                                                 const std::string& path,
+                                                 bool compress) {
+  int err_no = 0;
+  auto fp = fs_open_write(path, &err_no, "");
+  PADDLE_ENFORCE_NOT_NULL(
+      fp, common::errors::Unavailable("Fail to open file: %s.", path));
+  SlotRecordFileWriter writer(
+      SlotRecordFileSlots(),
+      SlotRecordFileFlags(compress),
+      [&fp](const char* data, size_t size) {
+        return fwrite(data, sizeof(char), size, fp.get()) == size ? 0 : -1;
+      });
+  int ret = writer.WriteHeader();
+  if (ret == 0) {
+    ret = WriteSlotRecords(&writer, records, num);
+  }
+  if (ret == 0) {
+    ret = writer.Flush();
+  }
+  fp = nullptr;
+  PADDLE_ENFORCE_EQ(
+      ret == 0 && err_no == 0,
+      true,
+      common::errors::Unavailable("Fail to write file: %s.", path));
+  VLOG(3) << "DumpSlotRecords() write " << num << " ins to " << path;
+}
+
 static void parser_log_key(const std::string& log_key,
                            uint64_t* search_id,
                            uint32_t* cmatch,
@@ -2940,25 +3557,13 @@ void SlotRecordInMemoryDataFeed::DumpSampleNeighbors(std::string dump_path) {
 void SlotRecordInMemoryDataFeed::BuildSlotBatchGPU(const int ins_num,
                                                    MiniBatchGpuPack* pack) {
   int offset_cols_size = (ins_num + 1);
-  size_t slot_total_num = (use_slot_size_ * offset_cols_size);
-  pack->resize_gpu_slot_offsets(slot_total_num * sizeof(size_t));
 
   auto& value = pack->value();
   const UsedSlotGpuType* used_slot_gpu_types =
       static_cast<const UsedSlotGpuType*>(pack->get_gpu_slots());
-  FillSlotValueOffset(ins_num,
-                      use_slot_size_,
-                      reinterpret_cast<size_t*>(pack->gpu_slot_offsets()),
-                      value.d_uint64_offset.data(),
-                      uint64_use_slot_size_,
-                      value.d_float_offset.data(),
-                      float_use_slot_size_,
-                      used_slot_gpu_types,
-                      pack->get_stream());
-  size_t* d_slot_offsets = reinterpret_cast<size_t*>(pack->gpu_slot_offsets());
 
+  // filled by pack_instance, on host and on its way to the gpu
   HostBuffer<size_t>& offsets = pack->offsets();
-  offsets.resize(slot_total_num);
   HostBuffer<void*>& h_tensor_ptrs = pack->h_tensor_ptrs();
   h_tensor_ptrs.resize(use_slot_size_);
   // alloc gpu memory
@@ -2972,11 +3577,6 @@ void SlotRecordInMemoryDataFeed::BuildSlotBatchGPU(const int ins_num,
   size_t float_zero_slot_index = 0;
   size_t uint64_zero_slot_index = 0;
 
-  // copy index
-  CUDA_CHECK(cudaMemcpy(offsets.data(),
-                        d_slot_offsets,
-                        slot_total_num * sizeof(size_t),
-                        cudaMemcpyDeviceToHost));
   auto* dev_ctx = static_cast<phi::GPUContext*>(
       phi::DeviceContextPool::Instance().Get(this->place_));
   for (int j = 0; j < use_slot_size_; ++j) {
@@ -3362,10 +3962,39 @@ void MiniBatchGpuPack::pack_instance(const SlotRecord* ins_vec, int num) {
   } else {  // only float
     pack_float_data(ins_vec, num);
   }
+  pack_slot_offsets(num);
   // to gpu
   transfer_to_gpu();
 }
 
+void MiniBatchGpuPack::pack_slot_offsets(int num) {
+  int col_num = num + 1;
+  size_t slot_total_num = static_cast<size_t>(used_slot_size_) * col_num;
+  offsets_.resize(slot_total_num);
+
+  int uint64_cols = used_uint64_num_ + 1;
+  int float_cols = used_float_num_ + 1;
+  for (int j = 0; j < used_slot_size_; ++j) {
+    auto& info = gpu_used_slots_[j];
+    const int* ins_offsets = info.is_uint64_value
+                                 ? buf_.h_uint64_offset.data()
+                                 : buf_.h_float_offset.data();
+    int cols = info.is_uint64_value ? uint64_cols : float_cols;
+    size_t* slot_offsets = &offsets_[j * col_num];
+    slot_offsets[0] = 0;
+    for (int k = 0; k < num; ++k) {
+      int pos = k * cols + info.slot_value_idx;
+      int len = ins_offsets[pos + 1] - ins_offsets[pos];
+      PADDLE_ENFORCE_GE(len,
+                        0,
+                        common::errors::InvalidArgument(
+                            "The number of slot size must be ge 0."));
+      slot_offsets[k + 1] = slot_offsets[k] + len;
+    }
+  }
+  resize_gpu_slot_offsets(slot_total_num * sizeof(size_t));
+}
+
 void MiniBatchGpuPack::transfer_to_gpu() {
   copy_host2device(&value_.d_uint64_lens, buf_.h_uint64_lens);
   copy_host2device(&value_.d_uint64_keys, buf_.h_uint64_keys);
@@ -3374,7 +4003,15 @@ void MiniBatchGpuPack::transfer_to_gpu() {
   copy_host2device(&value_.d_float_lens, buf_.h_float_lens);
   copy_host2device(&value_.d_float_keys, buf_.h_float_keys);
   copy_host2device(&value_.d_float_offset, buf_.h_float_offset);
-  CUDA_CHECK(cudaStreamSynchronize(stream_));
+
+  CUDA_CHECK(cudaMemcpyAsync(gpu_slot_offsets_->ptr(),
+                             offsets_.data(),
+                             offsets_.size() * sizeof(size_t),
+                             cudaMemcpyHostToDevice,
+                             stream_));
+  // No wait here: the kernels building the batch tensors follow the copies
+  // on the same stream, and the pinned host buffers are not written again
+  // until the batch is built, which waits on the stream once at its end.
 }
 #endif
 
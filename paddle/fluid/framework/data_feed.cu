@@ -315,44 +315,6 @@ int dedup_keys_and_fillidx(const int gpu_id,
   return merged_size;
 }
 
-// fill slot values
-__global__ void FillSlotValueOffsetKernel(const int ins_num,
-                                          const int used_slot_num,
-                                          size_t *slot_value_offsets,
-                                          const int *uint64_offsets,
-                                          const int uint64_slot_size,
-                                          const int *float_offsets,
-                                          const int float_slot_size,
-                                          const UsedSlotGpuType *used_slots) {
-  int col_num = ins_num + 1;
-  int uint64_cols = uint64_slot_size + 1;
-  int float_cols = float_slot_size + 1;
-
-  CUDA_KERNEL_LOOP(slot_idx, used_slot_num) {
-    int value_off = slot_idx * col_num;
-    slot_value_offsets[value_off] = 0;
-
-    auto &info = used_slots[slot_idx];
-    if (info.is_uint64_value) {
-      for (int k = 0; k < ins_num; ++k) {
-        int pos = k * uint64_cols + info.slot_value_idx;
-        int num = uint64_offsets[pos + 1] - uint64_offsets[pos];
-        PADDLE_ENFORCE(num >= 0, "The number of slot size must be ge 0.");
-        slot_value_offsets[value_off + k + 1] =
-            slot_value_offsets[value_off + k] + num;
-      }
-    } else {
-      for (int k = 0; k < ins_num; ++k) {
-        int pos = k * float_cols + info.slot_value_idx;
-        int num = float_offsets[pos + 1] - float_offsets[pos];
-        PADDLE_ENFORCE(num >= 0, "The number of slot size must be ge 0.");
-        slot_value_offsets[value_off + k + 1] =
-            slot_value_offsets[value_off + k] + num;
-      }
-    }
-  }
-}
-
 struct RandInt {
   int low, high;
 
@@ -367,30 +329,6 @@ struct RandInt {
   }
 };
 
-void SlotRecordInMemoryDataFeed::FillSlotValueOffset(
-    const int ins_num,
-    const int used_slot_num,
-    size_t *slot_value_offsets,
-    const int *uint64_offsets,
-    const int uint64_slot_size,
-    const int *float_offsets,
-    const int float_slot_size,
-    const UsedSlotGpuType *used_slots,
-    cudaStream_t stream) {
-  FillSlotValueOffsetKernel<<<GET_BLOCKS(used_slot_num),
-                              CUDA_NUM_THREADS,
-                              0,
-                              stream>>>(ins_num,
-                                        used_slot_num,
-                                        slot_value_offsets,
-                                        uint64_offsets,
-                                        uint64_slot_size,
-                                        float_offsets,
-                                        float_slot_size,
-                                        used_slots);
-  cudaStreamSynchronize(stream);
-}
-
 __global__ void CopyForTensorKernel(const int used_slot_num,
                                     const int ins_num,
                                     void **dest,
@@ -19,7 +19,10 @@ limitations under the License. */
 #define _LINUX
 #endif
 
+#include <condition_variable>  // NOLINT
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <future>  // NOLINT
 #include <memory>
 #include <mutex>  // NOLINT
@@ -460,12 +463,15 @@ struct CudaBuffer {
     }
     buf_size = 0;
   }
+  // Grows by half again the asked size, so that the batches of a pass,
+  // slightly bigger one after another, do not cudaFree and cudaMalloc, both
+  // of them synchronizing the device, at every batch.
   void resize(uint64_t size) {
     if (size <= buf_size) {
       return;
     }
     free();
-    malloc(size);
+    malloc(size + size / 2);
   }
 };
 template <typename T>
@@ -484,7 +490,10 @@ struct HostBuffer {
   T* data() { return host_buffer; }
   const T* data() const { return host_buffer; }
   size_t size() const { return data_len; }
-  void clear() { free(); }
+  void clear() {
+    free();
+    data_len = 0;
+  }
   T& back() { return host_buffer[data_len - 1]; }
 
   T& operator[](size_t i) { return host_buffer[i]; }
@@ -505,6 +514,8 @@ struct HostBuffer {
     }
     buf_size = 0;
   }
+  // Grows with headroom as CudaBuffer does, cudaHostAlloc and cudaFreeHost
+  // synchronizing the device as well.
   void resize(size_t size) {
     if (size <= buf_size) {
       data_len = size;
@@ -512,7 +523,7 @@ struct HostBuffer {
     }
     data_len = size;
     free();
-    malloc(size);
+    malloc(size + size / 2);
   }
 };
 
@@ -615,6 +626,11 @@ class MiniBatchGpuPack {
 
  private:
   void transfer_to_gpu(void);
+  // The offsets of every used slot value in the batch, prefix summed per
+  // slot over the instances, are computed on host from the packed instance
+  // offsets and copied to gpu_slot_offsets() with the batch, so that
+  // neither a kernel nor a device to host copy waits between pack and copy.
+  void pack_slot_offsets(int num);
   void pack_all_data(const SlotRecord* ins_vec, int num);
   void pack_uint64_data(const SlotRecord* ins_vec, int num);
   void pack_float_data(const SlotRecord* ins_vec, int num);
@@ -1141,6 +1157,52 @@ class GraphDataGenerator {
   phi::DenseTensor multi_node_sync_stat_;
 };
 
+// Bounds how many of the readers of a QueueDataset parse at the same time.
+//
+// Every reader holds a permit while it parses, and there are active_num
+// permits. A monitor thread samples the fill of the queues between the
+// readers and the DeviceWorkers every interval_ms: when they run low the
+// trainer threads are starved, so one more reader gets a permit; when they
+// run high the readers only compete with the trainer threads for cpu, so
+// one permit is taken back. A reader gives its permit up while it waits on
+// a full queue, and hands it on every kYieldInsNum instances when some
+// reader waits, so that no DeviceWorker is left without data.
+class ReaderAutoscaler {
+ public:
+  static constexpr int kYieldInsNum = 1024;
+
+  ReaderAutoscaler(int min_active_num, int max_active_num, int interval_ms);
+  ~ReaderAutoscaler();
+
+  // Registers a queue the readers fill, size returning its current depth.
+  void AddQueue(std::function<size_t()> size, size_t capacity);
+  // Blocks until a permit is free, in the order the readers asked.
+  void Acquire();
+  void Release();
+  // Returns whether the holder of a permit should hand it on.
+  bool ShouldYield();
+  int ActiveNum();
+
+ private:
+  void MonitorThread();
+
+  int min_active_num_;
+  int max_active_num_;
+  int interval_ms_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable monitor_cv_;
+  std::vector<std::pair<std::function<size_t()>, size_t>> queues_;
+  int active_num_;
+  int in_use_ = 0;
+  // tickets of the readers waiting for a permit
+  std::deque<uint64_t> waiting_;
+  uint64_t next_ticket_ = 0;
+  bool stop_ = false;
+  std::thread monitor_thread_;
+};
+
 class DataFeed {
  public:
   DataFeed() {
@@ -1224,6 +1286,11 @@ class DataFeed {
   virtual void SetFeaNumMutex(std::mutex* mutex) { mutex_for_fea_num_ = mutex; }
   virtual void SetFileListIndex(size_t* file_index) { file_idx_ = file_index; }
   virtual void SetFeaNum(uint64_t* fea_num) { total_fea_num_ = fea_num; }
+  // The readers of a Dataset share one autoscaler, see ReaderAutoscaler.
+  virtual void SetReaderAutoscaler(
+      std::shared_ptr<ReaderAutoscaler> autoscaler) {
+    reader_autoscaler_ = autoscaler;
+  }
   virtual const std::vector<std::string>& GetInsIdVec() const {
     return ins_id_vec_;
   }
@@ -1440,6 +1507,7 @@ class DataFeed {
   std::mutex* mutex_for_fea_num_ = nullptr;
   uint64_t* total_fea_num_ = nullptr;
   uint64_t fea_num_ = 0;
+  std::shared_ptr<ReaderAutoscaler> reader_autoscaler_ = nullptr;
 
   // the alias of used slots, and its order is determined by
   // data_feed_desc(proto object)
@@ -1497,10 +1565,14 @@ class PrivateQueueDataFeed : public DataFeed {
   virtual ~PrivateQueueDataFeed() {}
   virtual bool Start();
   virtual int Next();
+  virtual void SetReaderAutoscaler(
+      std::shared_ptr<ReaderAutoscaler> autoscaler);
 
  protected:
   // The thread implementation function for reading file and parse.
   virtual void ReadThread();
+  // Puts an instance parsed under a permit of reader_autoscaler_, if any.
+  void PutInstance(const T& instance, int ins_num);
   // This function is used to set private-queue size, and the most
   // efficient when the queue size is close to the batch size.
   virtual void SetQueueSize(int queue_size);
@@ -1965,6 +2037,48 @@ class MultiSlotInMemoryDataFeed : public InMemoryDataFeed<Record> {
   virtual void PutToFeedVec(const Record* ins_vec, int num);
 };
 
+class SlotRecordFileReader;
+class SlotRecordFileWriter;
+struct SlotRecordFileSlot;
+
+// Keeps the slot records parsed from the files of a SlotRecordDataset
+// across loads, so that a job loading the same files every epoch parses
+// each of them once. The records of a file are kept as a slot record file,
+// see slot_record_file.h, in memory up to FLAGS_dataset_sample_cache_mem_mb
+// and spilled to FLAGS_dataset_sample_cache_spill_dir past that. The files
+// are taken not to change while the job runs.
+class SlotRecordSampleCache {
+ public:
+  struct Entry {
+    // null for a spilled entry
+    std::shared_ptr<const std::string> data;
+    std::string spill_path;
+    double parse_sec = 0;
+  };
+
+  static SlotRecordSampleCache& Instance();
+  ~SlotRecordSampleCache();
+
+  bool Enabled() const;
+  bool Find(const std::string& key, Entry* entry);
+  // Keeps data, the records of key parsed in parse_sec, in memory or on
+  // disk as the budget allows.
+  void Insert(const std::string& key, std::string data, double parse_sec);
+  // Drops every entry and removes the spilled files.
+  void Clear();
+
+ private:
+  SlotRecordSampleCache() = default;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  // the keys being spilled, not in entries_ yet
+  std::unordered_set<std::string> spilling_;
+  size_t mem_bytes_ = 0;
+  size_t spill_bytes_ = 0;
+  size_t spill_num_ = 0;
+};
+
 class SlotRecordInMemoryDataFeed : public InMemoryDataFeed<SlotRecord> {
  public:
   SlotRecordInMemoryDataFeed() = default;
@@ -1972,6 +2086,12 @@ class SlotRecordInMemoryDataFeed : public InMemoryDataFeed<SlotRecord> {
   void Init(const DataFeedDesc& data_feed_desc) override;
   void LoadIntoMemory() override;
   void ExpandSlotRecord(SlotRecord* ins);
+  // Writes the used slots of the records to a slot record file, the binary
+  // columnar file loaded without parsing text, see slot_record_file.h.
+  void DumpSlotRecords(const SlotRecord* records,
+                       size_t num,
+                       const std::string& path,
+                       bool compress);
 
  protected:
   bool Start() override;
@@ -1988,6 +2108,24 @@ class SlotRecordInMemoryDataFeed : public InMemoryDataFeed<SlotRecord> {
   virtual void LoadIntoMemoryByLib(void);
   virtual void LoadIntoMemoryByLine(void);
   virtual void LoadIntoMemoryByFile(void);
+  void LoadIntoMemoryFromSlotRecordFile(const std::string& filename);
+  // Returns the number of instances loaded from the reader, filename only
+  // naming it in errors.
+  size_t LoadIntoMemoryFromSlotRecordReader(SlotRecordFileReader* reader,
+                                            const std::string& filename);
+  std::vector<SlotRecordFileSlot> SlotRecordFileSlots() const;
+  uint32_t SlotRecordFileFlags(bool compress) const;
+  int WriteSlotRecords(SlotRecordFileWriter* writer,
+                       const SlotRecord* records,
+                       size_t num);
+  // The SlotRecordSampleCache hooks of the LoadIntoMemory paths: a file
+  // found in the cache is loaded from it, and the records of a file that
+  // is not are collected from BeginSampleCache() to EndSampleCache().
+  std::string SampleCacheKey(const std::string& filename) const;
+  bool LoadIntoMemoryFromSampleCache(const std::string& filename);
+  void BeginSampleCache();
+  void CacheSlotRecords(const SlotRecord* records, size_t num);
+  void EndSampleCache(const std::string& filename, double parse_sec);
   void SetInputChannel(void* channel) override {
     input_channel_ = static_cast<ChannelObject<SlotRecord>*>(channel);
   }
@@ -2009,15 +2147,6 @@ class SlotRecordInMemoryDataFeed : public InMemoryDataFeed<SlotRecord> {
   virtual void PackToScope(MiniBatchGpuPack* pack,
                            const Scope* scope = nullptr);
 
-  void FillSlotValueOffset(const int ins_num,
-                           const int used_slot_num,
-                           size_t* slot_value_offsets,
-                           const int* uint64_offsets,
-                           const int uint64_slot_size,
-                           const int* float_offsets,
-                           const int float_slot_size,
-                           const UsedSlotGpuType* used_slots,
-                           cudaStream_t stream);
   void CopyForTensor(const int ins_num,
                      const int used_slot_num,
                      void** dest,
@@ -2060,6 +2189,9 @@ class SlotRecordInMemoryDataFeed : public InMemoryDataFeed<SlotRecord> {
   std::vector<UsedSlotInfo> used_slots_info_;
   size_t float_total_dims_size_ = 0;
   std::vector<int> float_total_dims_without_inductives_;
+  // the records of the file being parsed, for SlotRecordSampleCache
+  std::shared_ptr<SlotRecordFileWriter> cache_writer_ = nullptr;
+  std::string cache_data_;
 
 #if defined(PADDLE_WITH_CUDA) && defined(PADDLE_WITH_HETERPS)
   int pack_thread_num_{5};
@@ -14,6 +14,8 @@
 
 #include "paddle/fluid/framework/data_set.h"
 
+#include <limits>
+
 #include "google/protobuf/text_format.h"
 #if (defined PADDLE_WITH_DISTRIBUTE) && (defined PADDLE_WITH_PSCORE)
 #include "paddle/fluid/distributed/index_dataset/index_sampler.h"
@@ -22,6 +24,7 @@
 #include "paddle/fluid/framework/data_feed_factory.h"
 #include "paddle/fluid/framework/fleet/fleet_wrapper.h"
 #include "paddle/fluid/framework/io/fs.h"
+#include "paddle/fluid/framework/slot_record_file.h"
 #include "paddle/fluid/framework/threadpool.h"
 #include "paddle/phi/core/platform/monitor.h"
 #include "paddle/phi/core/platform/timer.h"
@@ -107,6 +110,18 @@ void DatasetImpl<T>::SetThreadNum(int thread_num) {
   thread_num_ = thread_num;
 }
 
+template <typename T>
+void DatasetImpl<T>::SetReaderAutoscale(int min_reader_num,
+                                        int max_reader_num,
+                                        int interval_ms) {
+  VLOG(3) << "SetReaderAutoscale min_reader_num=" << min_reader_num
+          << " max_reader_num=" << max_reader_num
+          << " interval_ms=" << interval_ms;
+  min_reader_num_ = min_reader_num;
+  max_reader_num_ = max_reader_num;
+  reader_autoscale_interval_ms_ = interval_ms;
+}
+
 // if you run distributed, and want to do global shuffle,
 // set this before global shuffle.
 // be sure you call CreateReaders before SetTrainerNum
@@ -779,6 +794,20 @@ void DatasetImpl<T>::DumpSampleNeighbors(std::string dump_path) {
 #endif
 }
 
+template <typename T>
+void DatasetImpl<T>::StreamingGlobalShuffle(int thread_num UNUSED,
+                                            int64_t buffer_size UNUSED) {
+  PADDLE_THROW(common::errors::Unimplemented(
+      "StreamingGlobalShuffle is only supported by MultiSlotDataset."));
+}
+
+template <typename T>
+void DatasetImpl<T>::DumpSlotRecords(const std::string& path_prefix UNUSED,
+                                     bool compress UNUSED) {
+  PADDLE_THROW(common::errors::Unimplemented(
+      "DumpSlotRecords is only supported by SlotRecordDataset."));
+}
+
 // do tdm sample
 void MultiSlotDataset::TDMSample(const std::string tree_name,
                                  const std::string tree_path,
@@ -857,6 +886,52 @@ void MultiSlotDataset::TDMSample(const std::string tree_name,
   return;
 }
 
+void MultiSlotDataset::SendToClients(std::vector<Record>* data) {
+#ifdef PADDLE_WITH_PSCORE
+  auto fleet_ptr = distributed::FleetWrapper::GetInstance();
+#else
+  auto fleet_ptr = framework::FleetWrapper::GetInstance();
+#endif
+  std::vector<paddle::framework::BinaryArchive> ars(this->trainer_num_);
+  for (auto& t : *data) {
+    size_t client_id = 0;
+    if (this->merge_by_insid_) {
+      client_id =
+          XXH64(t.ins_id_.data(), t.ins_id_.length(), 0) % this->trainer_num_;
+    } else if (this->shuffle_by_uid_) {
+      client_id = XXH64(t.uid_.data(), t.uid_.length(), 0) % this->trainer_num_;
+    } else {
+      client_id = fleet_ptr->LocalRandomEngine()() % this->trainer_num_;
+    }
+    ars[client_id] << t;
+  }
+  std::vector<std::future<int32_t>> total_status;
+  std::vector<int> send_index(this->trainer_num_);
+  for (int i = 0; i < this->trainer_num_; ++i) {
+    send_index[i] = i;
+  }
+  std::shuffle(
+      send_index.begin(), send_index.end(), fleet_ptr->LocalRandomEngine());
+  for (int index = 0; index < this->trainer_num_; ++index) {
+    int i = send_index[index];
+    if (ars[i].Length() == 0) {
+      continue;
+    }
+    std::string msg(ars[i].Buffer(), ars[i].Length());
+    auto ret = fleet_ptr->SendClientToClientMsg(0, i, msg);
+    total_status.push_back(std::move(ret));
+  }
+  for (auto& t : total_status) {
+    t.wait();
+  }
+  // currently we find bottleneck is server not able to handle large data
+  // in time, so we can remove this sleep and set fleet_send_batch_size to
+  // 1024, and set server thread to 24.
+  if (fleet_send_sleep_seconds_ != 0) {
+    sleep(this->fleet_send_sleep_seconds_);
+  }
+}
+
 void MultiSlotDataset::GlobalShuffle(int thread_num) {
   VLOG(3) << "MultiSlotDataset::GlobalShuffle() begin";
   platform::Timer timeline;
@@ -887,61 +962,12 @@ void MultiSlotDataset::GlobalShuffle(int thread_num) {
   VLOG(3) << "MultiSlotDataset::GlobalShuffle() input_channel_ size "
           << input_channel_->Size();
 
-  auto get_client_id = [this, fleet_ptr](const Record& data) -> size_t {
-    if (this->merge_by_insid_) {
-      return XXH64(data.ins_id_.data(), data.ins_id_.length(), 0) %
-             this->trainer_num_;
-    } else if (this->shuffle_by_uid_) {
-      return XXH64(data.uid_.data(), data.uid_.length(), 0) %
-             this->trainer_num_;
-    } else {
-      return fleet_ptr->LocalRandomEngine()() % this->trainer_num_;
-    }
-  };
-
-  auto global_shuffle_func = [this, get_client_id]() {
-#ifdef PADDLE_WITH_PSCORE
-    auto fleet_ptr = distributed::FleetWrapper::GetInstance();
-#else
-    auto fleet_ptr = framework::FleetWrapper::GetInstance();
-#endif
-    // auto fleet_ptr = framework::FleetWrapper::GetInstance();
+  auto global_shuffle_func = [this]() {
     std::vector<Record> data;
     while (this->input_channel_->Read(data)) {
-      std::vector<paddle::framework::BinaryArchive> ars(this->trainer_num_);
-      for (auto& t : data) {
-        auto client_id = get_client_id(t);
-        ars[client_id] << t;
-      }
-      std::vector<std::future<int32_t>> total_status;
-      std::vector<int> send_index(this->trainer_num_);
-      for (int i = 0; i < this->trainer_num_; ++i) {
-        send_index[i] = i;
-      }
-      std::shuffle(
-          send_index.begin(), send_index.end(), fleet_ptr->LocalRandomEngine());
-      for (int index = 0; index < this->trainer_num_; ++index) {
-        int i = send_index[index];
-        if (ars[i].Length() == 0) {
-          continue;
-        }
-        std::string msg(ars[i].Buffer(), ars[i].Length());
-        auto ret = fleet_ptr->SendClientToClientMsg(0, i, msg);
-        total_status.push_back(std::move(ret));
-      }
-      for (auto& t : total_status) {
-        t.wait();
-      }
-      ars.clear();
-      ars.shrink_to_fit();
+      SendToClients(&data);
       data.clear();
       data.shrink_to_fit();
-      // currently we find bottleneck is server not able to handle large data
-      // in time, so we can remove this sleep and set fleet_send_batch_size to
-      // 1024, and set server thread to 24.
-      if (fleet_send_sleep_seconds_ != 0) {
-        sleep(this->fleet_send_sleep_seconds_);
-      }
     }
   };
 
@@ -964,6 +990,92 @@ void MultiSlotDataset::GlobalShuffle(int thread_num) {
           << timeline.ElapsedSec() << " seconds";
 }
 
+// Unlike GlobalShuffle, the records are shuffled while they are read, so the
+// pass is never held twice: the readers write to an input channel of
+// bounded capacity, and each shuffle thread keeps a buffer of
+// buffer_size / thread_num records, a random one of which is sent away for
+// each record read, by windows of fleet_send_batch_size_ records.
+void MultiSlotDataset::StreamingGlobalShuffle(int thread_num,
+                                              int64_t buffer_size) {
+  VLOG(3) << "MultiSlotDataset::StreamingGlobalShuffle() begin";
+  platform::Timer timeline;
+  timeline.Start();
+  if (thread_num == -1) {
+    thread_num = thread_num_;
+  }
+  PADDLE_ENFORCE_GT(thread_num,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The shuffle thread num must be positive, but got %d.",
+                        thread_num));
+  size_t window_size = std::max<int64_t>(fleet_send_batch_size_, 1);
+  size_t thread_buffer_size = std::max<int64_t>(buffer_size / thread_num, 1);
+  input_channel_->Open();
+  input_channel_->SetCapacity(window_size * thread_num);
+  input_channel_->SetBlockSize(window_size);
+
+  std::vector<std::thread> load_threads;
+  for (int64_t i = 0; i < thread_num_; ++i) {
+    load_threads.emplace_back(&paddle::framework::DataFeed::LoadIntoMemory,
+                              readers_[i].get());
+  }
+  auto shuffle_func = [this, window_size, thread_buffer_size]() {
+#ifdef PADDLE_WITH_PSCORE
+    auto fleet_ptr = distributed::FleetWrapper::GetInstance();
+#else
+    auto fleet_ptr = framework::FleetWrapper::GetInstance();
+#endif
+    auto& engine = fleet_ptr->LocalRandomEngine();
+    std::vector<Record> buffer;
+    std::vector<Record> window;
+    std::vector<Record> data;
+    buffer.reserve(thread_buffer_size);
+    window.reserve(window_size);
+    auto add_to_window = [this, &window, window_size](Record* rec) {
+      window.push_back(std::move(*rec));
+      if (window.size() >= window_size) {
+        SendToClients(&window);
+        window.clear();
+      }
+    };
+    while (this->input_channel_->Read(data)) {
+      for (auto& rec : data) {
+        if (buffer.size() < thread_buffer_size) {
+          buffer.push_back(std::move(rec));
+          continue;
+        }
+        auto& evicted = buffer[engine() % buffer.size()];
+        add_to_window(&evicted);
+        evicted = std::move(rec);
+      }
+      data.clear();
+    }
+    std::shuffle(buffer.begin(), buffer.end(), engine);
+    for (auto& rec : buffer) {
+      add_to_window(&rec);
+    }
+    if (!window.empty()) {
+      SendToClients(&window);
+    }
+  };
+  std::vector<std::thread> shuffle_threads;
+  for (int i = 0; i < thread_num; ++i) {
+    shuffle_threads.emplace_back(shuffle_func);
+  }
+  for (std::thread& t : load_threads) {
+    t.join();
+  }
+  input_channel_->Close();
+  for (std::thread& t : shuffle_threads) {
+    t.join();
+  }
+  input_channel_->Clear();
+  input_channel_->SetCapacity(std::numeric_limits<size_t>::max());
+  timeline.Pause();
+  VLOG(3) << "MultiSlotDataset::StreamingGlobalShuffle() end, cost time="
+          << timeline.ElapsedSec() << " seconds";
+}
+
 template <typename T>
 void DatasetImpl<T>::DynamicAdjustChannelNum(int channel_num,
                                              bool discard_remaining_ins) {
@@ -1212,6 +1324,16 @@ void DatasetImpl<T>::CreateReaders() {
       channel_idx = 0;
     }
   }
+  if (max_reader_num_ > 0) {
+    int max_reader_num = std::min(max_reader_num_, thread_num_);
+    reader_autoscaler_ = std::make_shared<ReaderAutoscaler>(
+        std::min(min_reader_num_, max_reader_num),
+        max_reader_num,
+        reader_autoscale_interval_ms_);
+    for (auto& reader : readers_) {
+      reader->SetReaderAutoscaler(reader_autoscaler_);
+    }
+  }
   VLOG(3) << "readers size: " << readers_.size();
 }
 
@@ -1220,6 +1342,7 @@ void DatasetImpl<T>::DestroyReaders() {
   VLOG(3) << "Calling DestroyReaders()";
   VLOG(3) << "readers size1: " << readers_.size();
   std::vector<std::shared_ptr<paddle::framework::DataFeed>>().swap(readers_);
+  reader_autoscaler_ = nullptr;
   VLOG(3) << "readers size: " << readers_.size();
   file_idx_ = 0;
   cur_channel_ = 1 - cur_channel_;
@@ -2143,6 +2266,48 @@ void SlotRecordDataset::PrepareTrain() {
   return;
 }
 
+void SlotRecordDataset::DumpSlotRecords(const std::string& path_prefix,
+                                        bool compress) {
+  platform::Timer timeline;
+  timeline.Start();
+  // The records are in input_records_ once prepared for training, and in
+  // the input channel before.
+  std::vector<SlotRecord> data;
+  bool from_channel = input_records_.empty();
+  if (from_channel && input_channel_ != nullptr) {
+    input_channel_->Close();
+    input_channel_->ReadAll(data);
+  }
+  const std::vector<SlotRecord>& records =
+      from_channel ? data : input_records_;
+  size_t total = records.size();
+  std::vector<std::thread> dump_threads;
+  for (int i = 0; i < thread_num_; ++i) {
+    size_t begin = total * i / thread_num_;
+    size_t end = total * (i + 1) / thread_num_;
+    std::string path = string::format_string(
+        "%s-%05d%s", path_prefix.c_str(), i, kSlotRecordFileSuffix);
+    dump_threads.push_back(std::thread(
+        [this, &records, begin, end, path, compress, i]() {
+          reinterpret_cast<SlotRecordInMemoryDataFeed*>(readers_[i].get())
+              ->DumpSlotRecords(
+                  records.data() + begin, end - begin, path, compress);
+        }));
+  }
+  for (std::thread& t : dump_threads) {
+    t.join();
+  }
+  if (from_channel && input_channel_ != nullptr) {
+    input_channel_->Open();
+    input_channel_->Write(std::move(data));
+    input_channel_->Close();
+  }
+  timeline.Pause();
+  VLOG(1) << "SlotRecordDataset::DumpSlotRecords() dump " << total
+          << " ins to " << path_prefix << ", cost time="
+          << timeline.ElapsedSec() << " seconds";
+}
+
 void SlotRecordDataset::DynamicAdjustBatchNum() {
   VLOG(3) << "dynamic adjust batch num of graph in multi node";
 #if defined(PADDLE_WITH_PSCORE) && defined(PADDLE_WITH_HETERPS)
@@ -64,6 +64,11 @@ class Dataset {
   virtual void SetFileList(const std::vector<std::string>& filelist) = 0;
   // set readers' num
   virtual void SetThreadNum(int thread_num) = 0;
+  // let only min to max of the readers parse at once, as many as keep
+  // their queues to the DeviceWorkers filled. 0 for max disables it
+  virtual void SetReaderAutoscale(int min_reader_num,
+                                  int max_reader_num,
+                                  int interval_ms) = 0;
   // set workers' num
   virtual void SetTrainerNum(int trainer_num) = 0;
   // set fleet send batch size
@@ -127,6 +132,9 @@ class Dataset {
   virtual void LocalShuffle() = 0;
   // global shuffle data
   virtual void GlobalShuffle(int thread_num = -1) = 0;
+  // load all data into memory and global shuffle it at the same time,
+  // through shuffle buffers of buffer_size records in all
+  virtual void StreamingGlobalShuffle(int thread_num, int64_t buffer_size) = 0;
   virtual void SlotsShuffle(const std::set<std::string>& slots_to_replace) = 0;
   // create readers
   virtual void CreateReaders() = 0;
@@ -177,6 +185,10 @@ class Dataset {
 
   virtual void DumpWalkPath(std::string dump_path, size_t dump_rate) = 0;
   virtual void DumpSampleNeighbors(std::string dump_path) = 0;
+  // Writes the records in memory to slot record files, one per reader
+  // thread, named path_prefix-<thread>.slotbin.
+  virtual void DumpSlotRecords(const std::string& path_prefix,
+                               bool compress) = 0;
   virtual const std::vector<uint64_t>& GetGpuGraphTotalKeys() = 0;
   virtual const std::vector<std::vector<uint64_t>*>& GetPassKeysVec() = 0;
   virtual const std::vector<std::vector<uint32_t>*>& GetPassRanksVec() = 0;
@@ -203,6 +215,9 @@ class DatasetImpl : public Dataset {
   virtual void SetFileList(const std::vector<std::string>& filelist);
   virtual void ReleaseMemoryFun();
   virtual void SetThreadNum(int thread_num);
+  virtual void SetReaderAutoscale(int min_reader_num,
+                                  int max_reader_num,
+                                  int interval_ms);
   virtual void SetTrainerNum(int trainer_num);
   virtual void SetFleetSendBatchSize(int64_t size);
   virtual void SetHdfsConfig(const std::string& fs_name,
@@ -248,6 +263,7 @@ class DatasetImpl : public Dataset {
   virtual void ReleaseMemory();
   virtual void LocalShuffle();
   virtual void GlobalShuffle(int thread_num UNUSED = -1) {}
+  virtual void StreamingGlobalShuffle(int thread_num, int64_t buffer_size);
   virtual void SlotsShuffle(
       const std::set<std::string>& slots_to_replace UNUSED) {}
   virtual const std::vector<T>& GetSlotsOriginalData() {
@@ -280,6 +296,7 @@ class DatasetImpl : public Dataset {
   virtual void ClearSampleState();
   virtual void DumpWalkPath(std::string dump_path, size_t dump_rate);
   virtual void DumpSampleNeighbors(std::string dump_path);
+  virtual void DumpSlotRecords(const std::string& path_prefix, bool compress);
 
   std::vector<paddle::framework::Channel<T>>& GetMultiOutputChannel() {
     return multi_output_channel_;
@@ -361,6 +378,10 @@ class DatasetImpl : public Dataset {
   bool slots_shuffle_fea_eval_ = false;
   bool gen_uni_feasigns_ = false;
   int preload_thread_num_;
+  int min_reader_num_ = 0;
+  int max_reader_num_ = 0;
+  int reader_autoscale_interval_ms_ = 0;
+  std::shared_ptr<ReaderAutoscaler> reader_autoscaler_ = nullptr;
   std::mutex global_index_mutex_;
   int64_t global_index_ = 0;
   std::vector<std::shared_ptr<ThreadPool>> consume_task_pool_;
@@ -416,6 +437,7 @@ class MultiSlotDataset : public DatasetImpl<Record> {
       std::vector<Record>* result);
   virtual ~MultiSlotDataset() {}
   virtual void GlobalShuffle(int thread_num = -1);
+  virtual void StreamingGlobalShuffle(int thread_num, int64_t buffer_size);
   virtual void DynamicAdjustReadersNum(int thread_num);
   virtual void PrepareTrain();
 
@@ -423,6 +445,8 @@ class MultiSlotDataset : public DatasetImpl<Record> {
   virtual int ReceiveFromClient(int msg_type,
                                 int client_id,
                                 const std::string& msg);
+  // sends the records to the trainers they are shuffled to
+  void SendToClients(std::vector<Record>* data);
 };
 class SlotRecordDataset : public DatasetImpl<SlotRecord> {
  public:
@@ -440,6 +464,7 @@ class SlotRecordDataset : public DatasetImpl<SlotRecord> {
   virtual void PrepareTrain();
   virtual void DynamicAdjustReadersNum(int thread_num);
   void DynamicAdjustBatchNum();
+  virtual void DumpSlotRecords(const std::string& path_prefix, bool compress);
 
  protected:
   bool enable_heterps_ = true;
@@ -22,8 +22,10 @@
 #include "paddle/phi/core/platform/device_context.h"
 #include "paddle/phi/kernels/check_numerics_kernel.h"
 #include "paddle/phi/kernels/funcs/eigen/extensions.h"
+#include "paddle/phi/kernels/funcs/nan_inf_count.h"
 
 COMMON_DECLARE_int32(check_nan_inf_level);
+COMMON_DECLARE_bool(check_nan_inf_async);
 
 namespace paddle {
 namespace framework {
@@ -59,6 +61,10 @@ struct TensorCheckerVisitor {
                  0) const {
     auto* dev_ctx = reinterpret_cast<Context*>(
         phi::DeviceContextPool::Instance().Get(tensor.place()));
+    if (FLAGS_check_nan_inf_async) {
+      phi::funcs::AccumulateNanInfCount<T>(*dev_ctx, tensor);
+      return;
+    }
 
     phi::DenseTensor stats;
     phi::DenseTensor values;
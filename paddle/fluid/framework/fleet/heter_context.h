@@ -106,6 +106,8 @@ class HeterContext {
   void* sub_graph_float_feas = NULL;
   uint32_t shard_num_ = 37;
   uint16_t pass_id_ = 0;
+  // The keys are already split to the devices, by the build pull thread.
+  bool prepared_ = false;
   uint64_t size() {
     uint64_t total_size = 0;
     for (auto& keys : feature_keys_) {
@@ -152,6 +154,7 @@ class HeterContext {
   }
 
   void Reset() {
+    prepared_ = false;
     if (!multi_mf_dim_) {
       for (size_t i = 0; i < feature_keys_.size(); ++i) {
         feature_keys_[i].clear();
@@ -389,6 +389,215 @@ void AccessorWrapper<GPUAccessor>::CopyForPushImpl(
   cudaStreamSynchronize(stream);
 }
 
+template <typename TAccess>
+__device__ __forceinline__ float PullValue(const float* src_ptr,
+                                           int off,
+                                           const TAccess& accessor) {
+  switch (off) {
+    case 0:
+      return src_ptr[accessor.ShowIndex()];
+    case 1:
+      return src_ptr[accessor.ClickIndex()];
+    case 2:
+      return src_ptr[accessor.EmbedWIndex()];
+    default:
+      int embedx_id = off - 3;
+      if (embedx_id >= static_cast<int>(src_ptr[accessor.MfSizeIndex()])) {
+        return 0;
+      }
+      return src_ptr[accessor.EmbedxWIndex() + embedx_id];
+  }
+}
+
+// one thread per slot, instance and offset: sums the pulled values of the
+// keys of the instance and applies the cvm, as fused_seqpool_cvm does on the
+// output of PullDedupCopy, without writing the values of each key
+template <typename TAccess>
+__global__ void PullDedupSeqpoolCVM(const size_t N,
+                                    const uint64_t* total_keys,
+                                    float** dest,
+                                    const float* src,
+                                    uint64_t max_val_size,
+                                    const int* slot_dims,
+                                    const int hidden,
+                                    const uint32_t* restore_idx,
+                                    SeqpoolCVMParam param,
+                                    TAccess accessor) {
+  CUDA_KERNEL_LOOP_TYPE(idx, N, size_t) {
+    int x = idx / (param.batch_size * hidden);
+    int ins = idx / hidden % param.batch_size;
+    int off = idx % hidden;
+    int dim = slot_dims[x];
+    if (off >= dim) {
+      continue;
+    }
+    const size_t* lod = param.ins_offsets + x * (param.batch_size + 1);
+    float val = param.pad_value;
+    float show = param.pad_value;
+    for (size_t k = lod[ins]; k < lod[ins + 1]; ++k) {
+      // 0 key pulls zero
+      if (total_keys[k] == 0) {
+        continue;
+      }
+      const float* src_ptr = reinterpret_cast<const float*>(
+          reinterpret_cast<const char*>(src) +
+          uint64_t(restore_idx[k]) * max_val_size);
+      val += PullValue(src_ptr, off, accessor);
+      if (param.use_cvm && off == 1) {
+        show += PullValue(src_ptr, 0, accessor);
+      }
+    }
+    if (param.use_cvm) {
+      if (off == 0) {
+        val = log(val + 1);
+      } else if (off == 1) {
+        val = log(val + 1) - log(show + 1);
+      }
+      dest[x][ins * dim + off] = val;
+    } else if (off >= param.cvm_offset) {
+      int out_dim = dim - param.cvm_offset;
+      dest[x][ins * out_dim + off - param.cvm_offset] = val;
+    }
+  }
+}
+
+// the gradient of the key pos of slot x at off, the gradient of the pooled
+// output of its instance, with the show and click of the instance in the
+// first cvm_offset offsets
+__device__ __forceinline__ float SeqpoolCVMGrad(float** src,
+                                                const int* slot_dims,
+                                                int x,
+                                                size_t pos,
+                                                int off,
+                                                const SeqpoolCVMParam& param) {
+  const size_t* lod = param.ins_offsets + x * (param.batch_size + 1);
+  // the last instance whose first key is not after pos
+  int low = 0;
+  int high = param.batch_size - 1;
+  while (low < high) {
+    int mid = (low + high + 1) / 2;
+    if (lod[mid] <= pos) {
+      low = mid;
+    } else {
+      high = mid - 1;
+    }
+  }
+  if (off < param.cvm_offset) {
+    return param.cvm[low * param.cvm_offset + off];
+  }
+  if (param.use_cvm) {
+    return src[x][low * slot_dims[x] + off];
+  }
+  int out_dim = slot_dims[x] - param.cvm_offset;
+  return src[x][low * out_dim + off - param.cvm_offset];
+}
+
+template <typename TAccess>
+__global__ void PushMergeSeqpoolCVMAtomic(const size_t N,
+                                          const uint64_t* total_keys,
+                                          float* dest,
+                                          float** src,
+                                          const int hidden,
+                                          const int* slot_vector,
+                                          const int* slot_dims,
+                                          const int* key2slot,
+                                          const uint32_t* d_restore_idx,
+                                          size_t grad_value_size,
+                                          SeqpoolCVMParam param,
+                                          TAccess accessor) {
+  CUDA_KERNEL_LOOP_TYPE(idx, N, size_t) {
+    size_t i = idx / hidden;
+    int off = idx % hidden;
+    // filter 0 keys
+    if (total_keys[i] == 0) {
+      continue;
+    }
+
+    int x = key2slot[i];
+    int mf_dim = slot_dims[x] - 3;
+    if (off - 3 >= mf_dim) {
+      continue;
+    }
+    float grad = SeqpoolCVMGrad(src, slot_dims, x, i, off, param);
+    float* cur =
+        (float*)((char*)dest + d_restore_idx[i] * grad_value_size);  // NOLINT
+    int bs = param.batch_size;
+    switch (off) {
+      case 0:
+        cur[accessor.SlotIndex()] = static_cast<float>(slot_vector[x]);
+        cur[accessor.MfDimIndex()] = static_cast<float>(mf_dim);
+        phi::CudaAtomicAdd(&cur[accessor.ShowIndex()], grad);
+        break;
+      case 1:
+        phi::CudaAtomicAdd(&cur[accessor.ClickIndex()], grad);
+        break;
+      case 2:
+        phi::CudaAtomicAdd(&cur[accessor.EmbedGIndex()], grad * -1. * bs);
+        break;
+      default:
+        phi::CudaAtomicAdd(&cur[accessor.EmbedxGIndex() + off - 3],
+                           grad * -1. * bs);
+        break;
+    }
+  }
+}
+
+template <typename TAccess>
+__global__ void PushMergeSeqpoolCVM(const size_t N,
+                                    const uint64_t* total_keys,
+                                    float* dest,
+                                    float** src,
+                                    const int hidden,
+                                    const int* slot_vector,
+                                    const int* slot_dims,
+                                    const int* key2slot,
+                                    const uint32_t* d_sort_idx,
+                                    const uint32_t* d_sort_offset,
+                                    const uint32_t* d_sort_cnt,
+                                    size_t grad_value_size,
+                                    SeqpoolCVMParam param,
+                                    TAccess accessor) {
+  CUDA_KERNEL_LOOP_TYPE(idx, N, size_t) {
+    int i = idx / hidden;
+    int off = idx % hidden;
+    float* cur = (float*)((char*)dest + i * grad_value_size);  // NOLINT
+    bool valid = total_keys[i] != 0;
+    int x = 0;
+    int mf_dim = 0;
+    double val = 0.0;
+    // filter 0 keys
+    if (valid) {
+      const uint32_t& start = d_sort_offset[i];
+      x = key2slot[d_sort_idx[start]];
+      mf_dim = slot_dims[x] - 3;
+      if (off - 3 < mf_dim) {
+        for (uint32_t j = 0; j < d_sort_cnt[i]; ++j) {
+          const uint32_t& pos = d_sort_idx[start + j];
+          val += SeqpoolCVMGrad(src, slot_dims, key2slot[pos], pos, off, param);
+        }
+      }
+    }
+    int bs = param.batch_size;
+    switch (off) {
+      case 0:
+        cur[accessor.SlotIndex()] =
+            static_cast<float>(valid ? slot_vector[x] : 0);
+        cur[accessor.MfDimIndex()] = static_cast<float>(mf_dim);
+        cur[accessor.ShowIndex()] = val;
+        break;
+      case 1:
+        cur[accessor.ClickIndex()] = val;
+        break;
+      case 2:
+        cur[accessor.EmbedGIndex()] = val * -1. * bs;
+        break;
+      default:
+        cur[accessor.EmbedxGIndex() + off - 3] = val * -1. * bs;
+        break;
+    }
+  }
+}
+
 template <typename GPUAccessor>
 void AccessorWrapper<GPUAccessor>::CopyForPullDedupImpl(
     const phi::Place& place,
@@ -507,6 +716,120 @@ void AccessorWrapper<GPUAccessor>::CopyForPushDedupImpl(
   cudaStreamSynchronize(stream);
 }
 
+template <typename GPUAccessor>
+void AccessorWrapper<GPUAccessor>::CopyForPullSeqpoolCVMImpl(
+    const phi::Place& place,
+    const uint64_t* total_keys,
+    float** pooled_values,
+    const float* total_values_gpu,
+    const int slot_num,
+    const int hidden_size,
+    const int* slot_dims,
+    const uint32_t* gpu_restore_idx,
+    int pull_value_size,
+    const SeqpoolCVMParam& param) {
+  int device_id = place.GetDeviceId();
+  platform::CUDADeviceGuard guard(device_id);
+  auto stream = dynamic_cast<phi::GPUContext*>(
+                    phi::DeviceContextPool::Instance().Get(place))
+                    ->stream();
+  size_t N = static_cast<size_t>(slot_num) * param.batch_size * hidden_size;
+  PullDedupSeqpoolCVM<<<CUDA_BLOCK(N), stream>>>(
+      N,
+      total_keys,
+      pooled_values,
+      total_values_gpu,
+      pull_value_size,
+      slot_dims,
+      hidden_size,
+      gpu_restore_idx,
+      param,
+      gpu_accessor_.common_pull_value);
+  cudaStreamSynchronize(stream);
+}
+
+template <typename GPUAccessor>
+void AccessorWrapper<GPUAccessor>::CopyForPushSeqpoolCVMImpl(
+    const phi::Place& place,
+    const uint64_t* total_keys,
+    float** pooled_grads,
+    float* total_grad_values_gpu,
+    const int* slots,
+    const int64_t* slot_lens,
+    const int hidden_size,
+    const int64_t total_length,
+    const int64_t dedup_length,
+    const int* slot_dims,
+    const int* key2slot,
+    const uint32_t* d_restore_idx,
+    const size_t grad_value_size,
+    const SeqpoolCVMParam& param) {
+  int device_id = place.GetDeviceId();
+  platform::CUDADeviceGuard guard(device_id);
+  auto stream = dynamic_cast<phi::GPUContext*>(
+                    phi::DeviceContextPool::Instance().Get(place))
+                    ->stream();
+  cudaMemsetAsync(
+      total_grad_values_gpu, 0, dedup_length * grad_value_size, stream);
+  size_t N = total_length * hidden_size;
+  PushMergeSeqpoolCVMAtomic<<<CUDA_BLOCK(N), stream>>>(
+      N,
+      total_keys,
+      total_grad_values_gpu,
+      pooled_grads,
+      hidden_size,
+      slots,
+      slot_dims,
+      key2slot,
+      d_restore_idx,
+      grad_value_size,
+      param,
+      gpu_accessor_.common_push_value);
+  cudaStreamSynchronize(stream);
+}
+
+template <typename GPUAccessor>
+void AccessorWrapper<GPUAccessor>::CopyForPushSeqpoolCVMImpl(
+    const phi::Place& place,
+    const uint64_t* total_keys,
+    float** pooled_grads,
+    float* total_grad_values_gpu,
+    const int* slots,
+    const int64_t* slot_lens,
+    const int hidden_size,
+    const int64_t dedup_length,
+    const int* slot_dims,
+    const int* key2slot,
+    const uint32_t* gpu_sort_idx,
+    const uint32_t* gpu_sort_offset,
+    const uint32_t* gpu_sort_lens,
+    const size_t grad_value_size,
+    const SeqpoolCVMParam& param) {
+  int device_id = place.GetDeviceId();
+  platform::CUDADeviceGuard guard(device_id);
+  auto stream = dynamic_cast<phi::GPUContext*>(
+                    phi::DeviceContextPool::Instance().Get(place))
+                    ->stream();
+  // expand the pooled grads to the keys and merge them to one in a pass
+  size_t N = dedup_length * hidden_size;
+  PushMergeSeqpoolCVM<<<CUDA_BLOCK(N), stream>>>(
+      N,
+      total_keys,
+      total_grad_values_gpu,
+      pooled_grads,
+      hidden_size,
+      slots,
+      slot_dims,
+      key2slot,
+      gpu_sort_idx,
+      gpu_sort_offset,
+      gpu_sort_lens,
+      grad_value_size,
+      param,
+      gpu_accessor_.common_push_value);
+  cudaStreamSynchronize(stream);
+}
+
 #ifdef PADDLE_WITH_PSCORE
 template class AccessorWrapper<CommonFeatureValueAccessor>;
 #endif
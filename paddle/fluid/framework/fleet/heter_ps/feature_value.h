@@ -791,6 +791,20 @@ struct FeaturePushValue {
   }
 };
 
+// The sum pooling of the keys of each instance and the cvm of
+// fused_seqpool_cvm, fused into the copies of the dedup pull and push.
+// ins_offsets[slot * (batch_size + 1) + ins] is the index of the first key
+// of the instance ins of slot in the total keys.
+struct SeqpoolCVMParam {
+  const size_t* ins_offsets = nullptr;
+  int batch_size = 0;
+  float pad_value = 0;
+  bool use_cvm = true;
+  int cvm_offset = 2;
+  // the show and click of each instance, batch_size x cvm_offset, for push
+  const float* cvm = nullptr;
+};
+
 class VirtualAccessor {
  public:
   virtual int Configure(std::unordered_map<std::string, float> config) = 0;
@@ -893,6 +907,51 @@ class VirtualAccessor {
                            const uint32_t* gpu_sort_lens,
                            const size_t grad_value_size) = 0;
 
+  // dedup pull into the pooled outputs of fused_seqpool_cvm, one row of
+  // slot_dims[slot] or slot_dims[slot] - cvm_offset floats per instance
+  virtual void CopyForPullSeqpoolCVM(const phi::Place& place,
+                                     const uint64_t* total_keys,
+                                     float** pooled_values,
+                                     const float* total_values_gpu,
+                                     const int slot_num,
+                                     const int hidden_size,
+                                     const int* slot_dims,
+                                     const uint32_t* gpu_restore_idx,
+                                     int pull_value_size,
+                                     const SeqpoolCVMParam& param) = 0;
+
+  // dedup push from the gradients of the pooled outputs
+  virtual void CopyForPushSeqpoolCVM(const phi::Place& place,
+                                     const uint64_t* total_keys,
+                                     float** pooled_grads,
+                                     float* total_grad_values_gpu,
+                                     const int* slots,
+                                     const int64_t* slot_lens,
+                                     const int hidden_size,
+                                     const int64_t total_length,
+                                     const int64_t dedup_length,
+                                     const int* slot_dims,
+                                     const int* key2slot,
+                                     const uint32_t* d_restore_idx,
+                                     const size_t grad_value_size,
+                                     const SeqpoolCVMParam& param) = 0;
+
+  virtual void CopyForPushSeqpoolCVM(const phi::Place& place,
+                                     const uint64_t* total_keys,
+                                     float** pooled_grads,
+                                     float* total_grad_values_gpu,
+                                     const int* slots,
+                                     const int64_t* slot_lens,
+                                     const int hidden_size,
+                                     const int64_t dedup_length,
+                                     const int* slot_dims,
+                                     const int* key2slot,
+                                     const uint32_t* gpu_sort_idx,
+                                     const uint32_t* gpu_sort_offset,
+                                     const uint32_t* gpu_sort_lens,
+                                     const size_t grad_value_size,
+                                     const SeqpoolCVMParam& param) = 0;
+
   virtual std::string ParseToString(const float* v, int param_size) = 0;
 };
 
@@ -1097,6 +1156,90 @@ class AccessorWrapper : public VirtualAccessor {
                          grad_value_size);
   }
 
+  virtual void CopyForPullSeqpoolCVM(const phi::Place& place,
+                                     const uint64_t* total_keys,
+                                     float** pooled_values,
+                                     const float* total_values_gpu,
+                                     const int slot_num,
+                                     const int hidden_size,
+                                     const int* slot_dims,
+                                     const uint32_t* gpu_restore_idx,
+                                     int pull_value_size,
+                                     const SeqpoolCVMParam& param) {
+    CopyForPullSeqpoolCVMImpl(place,
+                              total_keys,
+                              pooled_values,
+                              total_values_gpu,
+                              slot_num,
+                              hidden_size,
+                              slot_dims,
+                              gpu_restore_idx,
+                              pull_value_size,
+                              param);
+  }
+
+  virtual void CopyForPushSeqpoolCVM(const phi::Place& place,
+                                     const uint64_t* total_keys,
+                                     float** pooled_grads,
+                                     float* total_grad_values_gpu,
+                                     const int* slots,
+                                     const int64_t* slot_lens,
+                                     const int hidden_size,
+                                     const int64_t total_length,
+                                     const int64_t dedup_length,
+                                     const int* slot_dims,
+                                     const int* key2slot,
+                                     const uint32_t* d_restore_idx,
+                                     const size_t grad_value_size,
+                                     const SeqpoolCVMParam& param) {
+    CopyForPushSeqpoolCVMImpl(place,
+                              total_keys,
+                              pooled_grads,
+                              total_grad_values_gpu,
+                              slots,
+                              slot_lens,
+                              hidden_size,
+                              total_length,
+                              dedup_length,
+                              slot_dims,
+                              key2slot,
+                              d_restore_idx,
+                              grad_value_size,
+                              param);
+  }
+
+  virtual void CopyForPushSeqpoolCVM(const phi::Place& place,
+                                     const uint64_t* total_keys,
+                                     float** pooled_grads,
+                                     float* total_grad_values_gpu,
+                                     const int* slots,
+                                     const int64_t* slot_lens,
+                                     const int hidden_size,
+                                     const int64_t dedup_length,
+                                     const int* slot_dims,
+                                     const int* key2slot,
+                                     const uint32_t* gpu_sort_idx,
+                                     const uint32_t* gpu_sort_offset,
+                                     const uint32_t* gpu_sort_lens,
+                                     const size_t grad_value_size,
+                                     const SeqpoolCVMParam& param) {
+    CopyForPushSeqpoolCVMImpl(place,
+                              total_keys,
+                              pooled_grads,
+                              total_grad_values_gpu,
+                              slots,
+                              slot_lens,
+                              hidden_size,
+                              dedup_length,
+                              slot_dims,
+                              key2slot,
+                              gpu_sort_idx,
+                              gpu_sort_offset,
+                              gpu_sort_lens,
+                              grad_value_size,
+                              param);
+  }
+
   void CopyForPullImpl(const phi::Place& place,
                        uint64_t** gpu_keys,
                        const std::vector<float*>& values,
@@ -1161,6 +1304,48 @@ class AccessorWrapper : public VirtualAccessor {
                             const uint32_t* gpu_sort_offset,
                             const uint32_t* gpu_sort_lens,
                             const size_t grad_value_size);
+
+  void CopyForPullSeqpoolCVMImpl(const phi::Place& place,
+                                 const uint64_t* total_keys,
+                                 float** pooled_values,
+                                 const float* total_values_gpu,
+                                 const int slot_num,
+                                 const int hidden_size,
+                                 const int* slot_dims,
+                                 const uint32_t* gpu_restore_idx,
+                                 int pull_value_size,
+                                 const SeqpoolCVMParam& param);
+
+  void CopyForPushSeqpoolCVMImpl(const phi::Place& place,
+                                 const uint64_t* total_keys,
+                                 float** pooled_grads,
+                                 float* total_grad_values_gpu,
+                                 const int* slots,
+                                 const int64_t* slot_lens,
+                                 const int hidden_size,
+                                 const int64_t total_length,
+                                 const int64_t dedup_length,
+                                 const int* slot_dims,
+                                 const int* key2slot,
+                                 const uint32_t* d_restore_idx,
+                                 const size_t grad_value_size,
+                                 const SeqpoolCVMParam& param);
+
+  void CopyForPushSeqpoolCVMImpl(const phi::Place& place,
+                                 const uint64_t* total_keys,
+                                 float** pooled_grads,
+                                 float* total_grad_values_gpu,
+                                 const int* slots,
+                                 const int64_t* slot_lens,
+                                 const int hidden_size,
+                                 const int64_t dedup_length,
+                                 const int* slot_dims,
+                                 const int* key2slot,
+                                 const uint32_t* gpu_sort_idx,
+                                 const uint32_t* gpu_sort_offset,
+                                 const uint32_t* gpu_sort_lens,
+                                 const size_t grad_value_size,
+                                 const SeqpoolCVMParam& param);
   virtual std::string ParseToString(const float* v, int param_size) {
     return gpu_accessor_.ParseToString(v, param_size);
   }
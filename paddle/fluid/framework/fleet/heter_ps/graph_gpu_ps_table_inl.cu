@@ -16,7 +16,9 @@
 #include <thrust/device_vector.h>
 #include <thrust/reduce.h>
 #include <thrust/scan.h>
+#include <algorithm>
 #include <functional>
+#include <numeric>
 #include "cub/cub.cuh"
 #pragma once
 #ifdef PADDLE_WITH_HETERPS
@@ -31,6 +33,7 @@
 #define SAMPLE_SIZE_THRESHOLD 1024
 
 COMMON_DECLARE_bool(enable_neighbor_list_use_uva);
+COMMON_DECLARE_double(gpugraph_neighbor_hbm_ratio);
 COMMON_DECLARE_bool(enable_graph_multi_node_sampling);
 
 namespace paddle {
@@ -1601,6 +1604,10 @@ void GpuPsGraphTable::clear_graph_info(int gpu_id, int idx) {
     cudaFree(graph.neighbor_list);
     graph.neighbor_list = nullptr;
   }
+  if (graph.weight_list != NULL) {
+    cudaFree(graph.weight_list);
+    graph.weight_list = nullptr;
+  }
   if (graph.node_list != NULL) {
     cudaFree(graph.node_list);
     graph.node_list = nullptr;
@@ -1832,6 +1839,77 @@ void GpuPsGraphTable::build_rank_fea_on_single_gpu(const GpuPsCommRankFea& g,
           << " finish, size:" << g.feature_size;
 }
 
+namespace {
+
+// The granularity of the placement of managed memory.
+constexpr size_t kUvaPageSize = 64 * 1024;
+
+// Lays the adjacency of g out again from the highest degree node down, so
+// that a prefix of the neighbor list holds the neighbors of the nodes
+// sampled the most.
+void ReorderNeighborsByDegree(const GpuPsCommGraph& g,
+                              std::vector<GpuPsNodeInfo>* node_info_list,
+                              std::vector<uint64_t>* neighbor_list,
+                              std::vector<half>* weight_list) {
+  std::vector<int64_t> order(g.node_size);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&g](int64_t a, int64_t b) {
+    return g.node_info_list[a].neighbor_size >
+           g.node_info_list[b].neighbor_size;
+  });
+  node_info_list->assign(g.node_info_list, g.node_info_list + g.node_size);
+  neighbor_list->assign(g.neighbor_size, 0);
+  if (g.is_weighted) {
+    weight_list->resize(g.neighbor_size);
+  }
+  uint32_t offset = 0;
+  for (auto i : order) {
+    auto& info = (*node_info_list)[i];
+    std::copy(g.neighbor_list + info.neighbor_offset,
+              g.neighbor_list + info.neighbor_offset + info.neighbor_size,
+              neighbor_list->data() + offset);
+    if (g.is_weighted) {
+      std::copy(g.weight_list + info.neighbor_offset,
+                g.weight_list + info.neighbor_offset + info.neighbor_size,
+                weight_list->data() + offset);
+    }
+    info.neighbor_offset = offset;
+    offset += info.neighbor_size;
+  }
+}
+
+// Allocates bytes of managed memory of which the first hbm_bytes live in
+// the HBM of dev_id, and the rest in host memory mapped for the gpu, which
+// reads it over UVA instead of migrating it page by page.
+void* MallocHybrid(size_t bytes, size_t hbm_bytes, int dev_id) {
+  void* ptr = nullptr;
+  CUDA_CHECK(cudaMallocManaged(&ptr, bytes));
+  if (hbm_bytes > 0) {
+    CUDA_CHECK(cudaMemAdvise(
+        ptr, hbm_bytes, cudaMemAdviseSetPreferredLocation, dev_id));
+  }
+  if (bytes > hbm_bytes) {
+    char* host_part = reinterpret_cast<char*>(ptr) + hbm_bytes;
+    CUDA_CHECK(cudaMemAdvise(host_part,
+                             bytes - hbm_bytes,
+                             cudaMemAdviseSetPreferredLocation,
+                             cudaCpuDeviceId));
+    CUDA_CHECK(cudaMemAdvise(
+        host_part, bytes - hbm_bytes, cudaMemAdviseSetAccessedBy, dev_id));
+  }
+  return ptr;
+}
+
+// The bytes of an array of size elements kept in HBM.
+size_t HybridHbmBytes(size_t size, size_t element_size) {
+  double ratio =
+      std::min(std::max(FLAGS_gpugraph_neighbor_hbm_ratio, 0.0), 1.0);
+  size_t bytes = static_cast<size_t>(size * ratio) * element_size;
+  return bytes / kUvaPageSize * kUvaPageSize;
+}
+
+}  // namespace
+
 /*
 the parameter std::vector<GpuPsCommGraph> cpu_graph_list is generated by cpu.
 it saves the graph to be saved on each gpu.
@@ -1840,13 +1918,30 @@ for the ith GpuPsCommGraph, any the node's key satisfies that key % gpu_number
 In this function, memory is allocated on each gpu to save the graphs,
 gpu i saves the ith graph from cpu_graph_list
 */
-void GpuPsGraphTable::build_graph_on_single_gpu(const GpuPsCommGraph& g,
+void GpuPsGraphTable::build_graph_on_single_gpu(const GpuPsCommGraph& cpu_g,
                                                 int gpu_id,
                                                 int edge_idx) {
   clear_graph_info(gpu_id, edge_idx);
   platform::CUDADeviceGuard guard(resource_->dev_id(gpu_id));
   int offset = get_graph_list_offset(gpu_id, edge_idx);
   gpu_graph_list_[offset] = GpuPsCommGraph();
+  // The hybrid mode keeps only a part of the neighbor list in HBM, that of
+  // the highest degree nodes, and the rest in host memory.
+  bool hybrid = FLAGS_enable_neighbor_list_use_uva &&
+                FLAGS_gpugraph_neighbor_hbm_ratio < 1.0 &&
+                cpu_g.neighbor_size > 0;
+  GpuPsCommGraph reordered_g = cpu_g;
+  std::vector<GpuPsNodeInfo> node_info_list;
+  std::vector<uint64_t> neighbor_list;
+  std::vector<half> weight_list;
+  if (hybrid) {
+    ReorderNeighborsByDegree(
+        cpu_g, &node_info_list, &neighbor_list, &weight_list);
+    reordered_g.node_info_list = node_info_list.data();
+    reordered_g.neighbor_list = neighbor_list.data();
+    reordered_g.weight_list = cpu_g.is_weighted ? weight_list.data() : nullptr;
+  }
+  const GpuPsCommGraph& g = hybrid ? reordered_g : cpu_g;
   int table_offset =
       get_table_offset(gpu_id, GraphTableType::EDGE_TABLE, edge_idx);
   size_t capacity = std::max((uint64_t)1, (uint64_t)g.node_size) / load_factor_;
@@ -1878,8 +1973,14 @@ void GpuPsGraphTable::build_graph_on_single_gpu(const GpuPsCommGraph& g,
     gpu_graph_list_[offset].node_size = 0;
   }
   if (g.neighbor_size) {
-    cudaError_t cudaStatus;
-    if (!FLAGS_enable_neighbor_list_use_uva) {
+    cudaError_t cudaStatus = cudaSuccess;
+    if (hybrid) {
+      gpu_graph_list_[offset].neighbor_list =
+          reinterpret_cast<uint64_t*>(MallocHybrid(
+              g.neighbor_size * sizeof(uint64_t),
+              HybridHbmBytes(g.neighbor_size, sizeof(uint64_t)),
+              resource_->dev_id(gpu_id)));
+    } else if (!FLAGS_enable_neighbor_list_use_uva) {
       cudaStatus = cudaMalloc(&gpu_graph_list_[offset].neighbor_list,
                               g.neighbor_size * sizeof(uint64_t));
     } else {
@@ -1902,8 +2003,17 @@ void GpuPsGraphTable::build_graph_on_single_gpu(const GpuPsCommGraph& g,
     gpu_graph_list_[offset].neighbor_size = g.neighbor_size;
 
     if (g.is_weighted) {
-      cudaError_t cudaStatus = cudaMalloc(&gpu_graph_list_[offset].weight_list,
-                                          g.neighbor_size * sizeof(half));
+      cudaError_t cudaStatus = cudaSuccess;
+      if (hybrid) {
+        gpu_graph_list_[offset].weight_list =
+            reinterpret_cast<half*>(MallocHybrid(
+                g.neighbor_size * sizeof(half),
+                HybridHbmBytes(g.neighbor_size, sizeof(half)),
+                resource_->dev_id(gpu_id)));
+      } else {
+        cudaStatus = cudaMalloc(&gpu_graph_list_[offset].weight_list,
+                                g.neighbor_size * sizeof(half));
+      }
       PADDLE_ENFORCE_EQ(
           cudaStatus,
           cudaSuccess,
@@ -1925,6 +2035,27 @@ void GpuPsGraphTable::build_graph_on_single_gpu(const GpuPsCommGraph& g,
     gpu_graph_list_[offset].neighbor_size = 0;
     gpu_graph_list_[offset].weight_list = NULL;
   }
+  if (hybrid) {
+    // Moves the HBM part in now rather than on the first samples.
+    size_t hbm_bytes = HybridHbmBytes(g.neighbor_size, sizeof(uint64_t));
+    if (hbm_bytes > 0) {
+      CUDA_CHECK(cudaMemPrefetchAsync(gpu_graph_list_[offset].neighbor_list,
+                                      hbm_bytes,
+                                      resource_->dev_id(gpu_id),
+                                      stream));
+    }
+    hbm_bytes = HybridHbmBytes(g.neighbor_size, sizeof(half));
+    if (g.is_weighted && hbm_bytes > 0) {
+      CUDA_CHECK(cudaMemPrefetchAsync(gpu_graph_list_[offset].weight_list,
+                                      hbm_bytes,
+                                      resource_->dev_id(gpu_id),
+                                      stream));
+    }
+    VLOG(0) << "gpu " << resource_->dev_id(gpu_id) << " keeps "
+            << HybridHbmBytes(g.neighbor_size, sizeof(uint64_t)) << " of "
+            << g.neighbor_size * sizeof(uint64_t)
+            << " bytes of graph-edges in hbm, the rest in host memory";
+  }
   cudaStreamSynchronize(stream);
   VLOG(0) << " gpu node_neighbor info card: " << gpu_id << " ,node_size is "
           << gpu_graph_list_[offset].node_size << ", neighbor_size is "
@@ -18,6 +18,7 @@ limitations under the License. */
 
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #ifdef PADDLE_WITH_PSLIB
@@ -236,6 +237,15 @@ class HashTable {
   void show_collision(int id) { return container_->print_collision(id); }
   // infer mode
   void set_mode(bool infer_mode) { infer_mode_ = infer_mode; }
+#if defined(PADDLE_WITH_CUDA)
+  // The values in ranges are read over the bus, so their pulls are
+  // gathered and fetched by a warp per value, max_value_size the largest
+  // feature value size of the ranges.
+  void set_spill_ranges(const SpillRanges& ranges, size_t max_value_size) {
+    spill_ranges_ = ranges;
+    max_spill_value_size_ = max_value_size;
+  }
+#endif
 
   std::unique_ptr<phi::RWLock> rwlock_{nullptr};
 
@@ -243,6 +253,13 @@ class HashTable {
 #if defined(PADDLE_WITH_CUDA)
   TableContainer<KeyType, ValType>* container_;
   cudaStream_t stream_ = 0;
+  SpillRanges spill_ranges_;
+  size_t max_spill_value_size_ = 0;
+  // the index and value of the pulled keys in the spill ranges, used by a
+  // pull at a time
+  char* spill_buf_ = nullptr;
+  size_t spill_buf_size_ = 0;
+  std::mutex spill_mutex_;
 #elif defined(PADDLE_WITH_XPU_KP)
   XPUCacheArray<KeyType, ValType>* container_;
 #endif
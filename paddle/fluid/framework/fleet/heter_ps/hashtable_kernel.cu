@@ -199,6 +199,78 @@ __global__ void dy_mf_search_kernel(Table* table,
   }
 }
 
+// As dy_mf_search_kernel(_fill), but the values in the spill ranges are
+// gathered for dy_mf_fetch_spill_kernel instead of read by the thread.
+template <typename Table, typename GPUAccessor>
+__global__ void dy_mf_search_kernel_spill(
+    Table* table,
+    const typename Table::key_type* const keys,
+    char* vals,
+    size_t len,
+    size_t pull_feature_value_size,
+    SpillRanges spill_ranges,
+    bool fill_zero,
+    uint32_t* spill_num,
+    uint32_t* spill_idx,
+    float** spill_vals,
+    GPUAccessor gpu_accessor) {
+  const size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < len) {
+    auto it = table->find(keys[i]);
+    float* cur = reinterpret_cast<float*>(vals + i * pull_feature_value_size);
+    if (it != table->end()) {
+      float* input = it->second;
+      if (spill_ranges.contains(input)) {
+        uint32_t pos = atomicAdd(spill_num, 1);
+        spill_idx[pos] = i;
+        spill_vals[pos] = input;
+      } else {
+        gpu_accessor.PullValueFill(cur, input);
+      }
+    } else if (fill_zero) {
+      gpu_accessor.PullZeroValue(cur);
+    } else {
+      PADDLE_ENFORCE(false, "warning: pull miss key: %lu", keys[i]);
+    }
+  }
+}
+
+// A warp per spilled value: the lanes copy it over the bus to shared memory
+// in coalesced reads, instead of a thread reading a word at a time, then
+// the first lane fills the pull value from there.
+template <typename GPUAccessor>
+__global__ void dy_mf_fetch_spill_kernel(const uint32_t* spill_num,
+                                         const uint32_t* spill_idx,
+                                         float* const* spill_vals,
+                                         char* vals,
+                                         size_t pull_feature_value_size,
+                                         size_t max_value_size,
+                                         GPUAccessor gpu_accessor) {
+  extern __shared__ float spill_rows[];
+  const int lane = threadIdx.x % 32;
+  const int warp = threadIdx.x / 32;
+  const int warp_num = blockDim.x / 32;
+  float* row = spill_rows + warp * (max_value_size / sizeof(float));
+  const uint32_t num = *spill_num;
+  for (uint32_t k = blockIdx.x * warp_num + warp; k < num;
+       k += gridDim.x * warp_num) {
+    const float* src = spill_vals[k];
+    int mf_dim = static_cast<int>(
+        src[gpu_accessor.common_feature_value.MfDimIndex()]);
+    int dim = gpu_accessor.common_feature_value.Dim(mf_dim);
+    for (int j = lane; j < dim; j += 32) {
+      row[j] = src[j];
+    }
+    __syncwarp();
+    if (lane == 0) {
+      float* cur = reinterpret_cast<float*>(
+          vals + uint64_t(spill_idx[k]) * pull_feature_value_size);
+      gpu_accessor.PullValueFill(cur, row);
+    }
+    __syncwarp();
+  }
+}
+
 template <typename Table, typename GradType, typename Sgd>
 __global__ void update_kernel(Table* table,
                               const OptimizerConfig& optimizer_config,
@@ -330,6 +402,9 @@ template <typename KeyType, typename ValType>
 HashTable<KeyType, ValType>::~HashTable() {
   delete container_;
   cudaFree(device_optimizer_config_);
+  if (spill_buf_ != nullptr) {
+    cudaFree(spill_buf_);
+  }
 }
 
 template <typename KeyType, typename ValType>
@@ -386,6 +461,50 @@ void HashTable<KeyType, ValType>::get(const KeyType* d_keys,
     return;
   }
   const int grid_size = (len - 1) / BLOCK_SIZE_ + 1;
+  if (spill_ranges_.num > 0) {
+    std::lock_guard<std::mutex> lock(spill_mutex_);
+    size_t buf_size = len * (sizeof(float*) + sizeof(uint32_t)) + 8;
+    if (spill_buf_size_ < buf_size) {
+      if (spill_buf_ != nullptr) {
+        CUDA_RT_CALL(cudaFree(spill_buf_));
+      }
+      CUDA_RT_CALL(cudaMalloc(reinterpret_cast<void**>(&spill_buf_), buf_size));
+      spill_buf_size_ = buf_size;
+    }
+    float** spill_vals = reinterpret_cast<float**>(spill_buf_);
+    uint32_t* spill_idx = reinterpret_cast<uint32_t*>(spill_vals + len);
+    uint32_t* spill_num = spill_idx + len;
+    CUDA_RT_CALL(cudaMemsetAsync(spill_num, 0, sizeof(uint32_t), stream));
+    dy_mf_search_kernel_spill<<<grid_size, BLOCK_SIZE_, 0, stream>>>(
+        container_,
+        d_keys,
+        d_vals,
+        len,
+        pull_feature_value_size_,
+        spill_ranges_,
+        infer_mode_,
+        spill_num,
+        spill_idx,
+        spill_vals,
+        fv_accessor);
+    const int fetch_block = 128;
+    const int warp_num = fetch_block / 32;
+    const int fetch_grid =
+        std::min<size_t>((len + warp_num - 1) / warp_num, 4096);
+    dy_mf_fetch_spill_kernel<<<fetch_grid,
+                               fetch_block,
+                               warp_num * max_spill_value_size_,
+                               stream>>>(spill_num,
+                                         spill_idx,
+                                         spill_vals,
+                                         d_vals,
+                                         pull_feature_value_size_,
+                                         max_spill_value_size_,
+                                         fv_accessor);
+    // the buffer is reused by the next pull
+    CUDA_RT_CALL(cudaStreamSynchronize(stream));
+    return;
+  }
   // infer need zero fill
   if (infer_mode_) {
     dy_mf_search_kernel_fill<<<grid_size, BLOCK_SIZE_, 0, stream>>>(
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #pragma once
+#include <atomic>
 #include <memory>
 #include <vector>
 #include "cub/cub.cuh"
@@ -70,6 +71,12 @@ class HeterComm {
                    const OptimizerConfig& embedx_config,
                    bool infer_mode);
   void set_mode(bool infer_mode);
+#if defined(PADDLE_WITH_CUDA)
+  // the values of the table of num in ranges are in host memory
+  void set_spill_ranges(int num,
+                        const SpillRanges& ranges,
+                        size_t max_value_size);
+#endif
   template <typename StreamType>
   size_t merge_keys(const int gpu_num,
                     const KeyType* d_keys,
@@ -454,6 +461,15 @@ class HeterComm {
   };
 
   void init_path();
+#if defined(PADDLE_WITH_CUDA)
+  // the routes of init_path by the bandwidth of the links between the gpus
+  void init_topo_routing_path();
+  // the bandwidth in GB/s between each pair of gpus by timed peer copies
+  std::vector<double> measure_link_bandwidth();
+#endif
+  // the bytes of pull or push copied from the gpu src to the gpu dst
+  void record_link_bytes(int src, int dst, size_t bytes);
+  void report_link_utilization();
 
   template <typename StreamType>
   void sync_stream(const StreamType& stream) {
@@ -562,6 +578,25 @@ class HeterComm {
                                    const size_t& fea_size,
                                    const KeyType* d_keys,
                                    const cudaStream_t& stream);
+  // the sizes of the parts the gpus send to gpu_id in the inner shuffle
+  std::vector<size_t> inner_recv_sizes(const int& gpu_id) {
+    std::vector<size_t> sizes(device_num_);
+    for (int i = 0; i < device_num_; ++i) {
+      sizes[i] = storage_[i].h_fea_sizes[gpu_id];
+    }
+    return sizes;
+  }
+  // the shuffle of the inner p2p copies by nccl send/recv on the inner comm,
+  // the sizes and offsets count the elements of elem_bytes bytes
+  void inner_shuffle_by_nccl(const int& gpu_id,
+                             const size_t* h_send_sizes,
+                             const size_t* h_send_offsets,
+                             const size_t* h_recv_sizes,
+                             const size_t* h_recv_offsets,
+                             const size_t& elem_bytes,
+                             const char* d_send_buff,
+                             char* d_recv_buff,
+                             const cudaStream_t& stream);
   void partition_shard_keys(const int& gpu_id,
                             const size_t& total_fea_num,
                             const KeyType* d_keys,
@@ -812,6 +847,11 @@ class HeterComm {
 #endif
   int64_t start_time_ = 0;
   bool is_infer_mode_ = false;
+  // the bandwidth in GB/s of the links and the bytes of pull and push on
+  // them in the pass, device_num_ x device_num_
+  std::vector<double> link_bandwidth_;
+  std::unique_ptr<std::atomic<uint64_t>[]> pull_link_bytes_;
+  std::unique_ptr<std::atomic<uint64_t>[]> push_link_bytes_;
 };
 
 }  // end namespace framework
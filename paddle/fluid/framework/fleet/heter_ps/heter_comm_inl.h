@@ -16,6 +16,7 @@ limitations under the License. */
 #include <algorithm>
 #include <memory>
 #include <queue>
+#include <sstream>
 #include <utility>
 #include <vector>
 #include "paddle/fluid/framework/fleet/heter_ps/feature_value.h"
@@ -36,6 +37,11 @@ COMMON_DECLARE_bool(enable_tracker_all2all);
 COMMON_DECLARE_bool(enable_all2all_use_fp16);
 COMMON_DECLARE_bool(enable_sparse_inner_gather);
 COMMON_DECLARE_bool(graph_embedding_split_infer_mode);
+COMMON_DECLARE_bool(gpugraph_topo_routing);
+COMMON_DECLARE_int32(gpugraph_topo_routing_max_hops);
+COMMON_DECLARE_bool(gpugraph_measure_link_bandwidth);
+COMMON_DECLARE_bool(gpugraph_inner_shuffle_by_nccl);
+COMMON_DECLARE_bool(gpugraph_report_link_utilization);
 
 namespace paddle {
 namespace framework {
@@ -44,6 +50,11 @@ inline int64_t tick_usec() {
   gettimeofday(&tm, NULL);
   return tm.tv_sec * 1000 * 1000L + tm.tv_usec;
 }
+// whether the copies of the calling thread are of push sparse
+inline bool &link_traffic_in_push() {
+  static thread_local bool in_push = false;
+  return in_push;
+}
 template <typename KeyType,
           typename ValType,
           typename GradType,
@@ -211,6 +222,28 @@ template <typename KeyType,
 void HeterComm<KeyType, ValType, GradType, GPUAccessor>::init_path() {
   int total_device = resource_->total_device();
   path_.resize(total_device);
+  pull_link_bytes_.reset(
+      new std::atomic<uint64_t>[total_device * total_device]());
+  push_link_bytes_.reset(
+      new std::atomic<uint64_t>[total_device * total_device]());
+#if defined(PADDLE_WITH_CUDA)
+  if (FLAGS_gpugraph_topo_routing && FLAGS_gpugraph_measure_link_bandwidth) {
+    link_bandwidth_ = measure_link_bandwidth();
+  } else {
+    link_bandwidth_.resize(total_device * total_device);
+    for (int i = 0; i < total_device; ++i) {
+      for (int j = 0; j < total_device; ++j) {
+        link_bandwidth_[i * total_device + j] = rdma_checker_->link_bandwidth(
+            resource_->dev_id(i), resource_->dev_id(j));
+      }
+    }
+  }
+  if (FLAGS_gpugraph_topo_routing) {
+    init_topo_routing_path();
+    start_time_ = tick_usec();
+    return;
+  }
+#endif
   if (!topo_aware_) {
     VLOG(0) << "init path without topo aware";
     for (int i = 0; i < total_device; ++i) {
@@ -260,6 +293,156 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::init_path() {
   }
   start_time_ = tick_usec();
 }
+#if defined(PADDLE_WITH_CUDA)
+template <typename KeyType,
+          typename ValType,
+          typename GradType,
+          typename GPUAccessor>
+void HeterComm<KeyType, ValType, GradType, GPUAccessor>::
+    init_topo_routing_path() {
+  int total_device = resource_->total_device();
+  DeviceRoutingPlan plan(
+      total_device, link_bandwidth_, FLAGS_gpugraph_topo_routing_max_hops);
+  bool multi_hop = false;
+  for (int i = 0; i < total_device; ++i) {
+    path_[i].resize(total_device);
+    for (int j = 0; j < total_device; ++j) {
+      auto &nodes = path_[i][j].nodes_;
+      nodes.clear();
+      std::vector<int> route =
+          (i == j) ? std::vector<int>{j} : plan.route(i, j);
+      // a relayed copy waits for each hop before the next one
+      int sync = route.size() > 1 ? 1 : 0;
+      int prev = i;
+      for (int dev : route) {
+        nodes.push_back(Node());
+        Node &node = nodes.back();
+        node.in_stream = resource_->remote_stream(prev, dev);
+        node.out_stream = resource_->remote_stream(dev, prev);
+        node.key_storage = NULL;
+        node.val_storage = NULL;
+        node.sync = sync;
+        node.dev_num = dev;
+        prev = dev;
+      }
+      if (route.size() > 1) {
+        multi_hop = true;
+        VLOG(1) << "route " << i << "->" << j << " relayed by "
+                << route.size() - 1 << " gpus, first " << route[0];
+      }
+    }
+  }
+  // the direct access of a remote table would bypass the relayed routes
+  if (multi_hop) {
+    enable_gpu_direct_access_ = false;
+  }
+  VLOG(0) << "init path with topo routing, max hops = "
+          << FLAGS_gpugraph_topo_routing_max_hops
+          << ", multi hop = " << multi_hop
+          << ", enable_gpu_direct_access = " << enable_gpu_direct_access_;
+}
+template <typename KeyType,
+          typename ValType,
+          typename GradType,
+          typename GPUAccessor>
+std::vector<double>
+HeterComm<KeyType, ValType, GradType, GPUAccessor>::measure_link_bandwidth() {
+  int total_device = resource_->total_device();
+  constexpr size_t kBytes = 64UL << 20;
+  constexpr int kRepeats = 5;
+  std::vector<std::shared_ptr<phi::Allocation>> buffers;
+  for (int i = 0; i < total_device; ++i) {
+    DevPlace place = DevPlace(resource_->dev_id(i));
+    buffers.push_back(MemoryAlloc(place, kBytes));
+  }
+  std::vector<double> bandwidth(total_device * total_device, 0);
+  for (int i = 0; i < total_device; ++i) {
+    AnyDeviceGuard guard(resource_->dev_id(i));
+    for (int j = 0; j < total_device; ++j) {
+      if (i == j) {
+        continue;
+      }
+      auto stream = resource_->remote_stream(i, j);
+      cudaEvent_t start, stop;
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreate(&start));
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreate(&stop));
+      // the first copy warms up the link
+      for (int r = 0; r <= kRepeats; ++r) {
+        if (r == 1) {
+          PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(start, stream));
+        }
+        PADDLE_ENFORCE_GPU_SUCCESS(
+            cudaMemcpyPeerAsync(buffers[j]->ptr(),
+                                resource_->dev_id(j),
+                                buffers[i]->ptr(),
+                                resource_->dev_id(i),
+                                kBytes,
+                                stream));
+      }
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(stop, stream));
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventSynchronize(stop));
+      float ms = 0;
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventElapsedTime(&ms, start, stop));
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(start));
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(stop));
+      if (ms > 0) {
+        bandwidth[i * total_device + j] = kRepeats * kBytes / (ms * 1e6);
+      }
+      VLOG(0) << "measured link " << i << "->" << j << " bandwidth "
+              << bandwidth[i * total_device + j] << " GB/s";
+    }
+  }
+  return bandwidth;
+}
+#endif
+template <typename KeyType,
+          typename ValType,
+          typename GradType,
+          typename GPUAccessor>
+void HeterComm<KeyType, ValType, GradType, GPUAccessor>::record_link_bytes(
+    int src, int dst, size_t bytes) {
+  if (!FLAGS_gpugraph_report_link_utilization || src == dst || src < 0 ||
+      dst < 0 || src >= device_num_ || dst >= device_num_) {
+    return;
+  }
+  auto &link_bytes =
+      link_traffic_in_push() ? push_link_bytes_ : pull_link_bytes_;
+  link_bytes[src * device_num_ + dst].fetch_add(bytes,
+                                                std::memory_order_relaxed);
+}
+template <typename KeyType,
+          typename ValType,
+          typename GradType,
+          typename GPUAccessor>
+void HeterComm<KeyType, ValType, GradType, GPUAccessor>::
+    report_link_utilization() {
+  int64_t now = tick_usec();
+  if (!FLAGS_gpugraph_report_link_utilization) {
+    start_time_ = now;
+    return;
+  }
+  double seconds = std::max(now - start_time_, int64_t(1)) / 1e6;
+  for (int i = 0; i < device_num_; ++i) {
+    for (int j = 0; j < device_num_; ++j) {
+      int k = i * device_num_ + j;
+      uint64_t pull_bytes = pull_link_bytes_[k].exchange(0);
+      uint64_t push_bytes = push_link_bytes_[k].exchange(0);
+      if (pull_bytes + push_bytes == 0) {
+        continue;
+      }
+      // the average over the pass, which includes the time out of copies
+      double gbps = (pull_bytes + push_bytes) / seconds / 1e9;
+      std::stringstream ss;
+      ss << "pass link " << i << "->" << j << " pull bytes: " << pull_bytes
+         << ", push bytes: " << push_bytes << ", " << gbps << " GB/s";
+      if (!link_bandwidth_.empty() && link_bandwidth_[k] > 0) {
+        ss << ", utilization: " << gbps / link_bandwidth_[k] * 100 << "%";
+      }
+      VLOG(0) << ss.str();
+    }
+  }
+  start_time_ = now;
+}
 template <typename KeyType,
           typename ValType,
           typename GradType,
@@ -333,6 +516,21 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::set_mode(
   }
   is_infer_mode_ = infer_mode;
 }
+#if defined(PADDLE_WITH_CUDA)
+template <typename KeyType,
+          typename ValType,
+          typename GradType,
+          typename GPUAccessor>
+void HeterComm<KeyType, ValType, GradType, GPUAccessor>::set_spill_ranges(
+    int num, const SpillRanges &ranges, size_t max_value_size) {
+  PADDLE_ENFORCE_EQ(
+      multi_mf_dim_ > 0,
+      true,
+      common::errors::PreconditionNotMet(
+          "The values are spilled to host memory only with multi_mf_dim."));
+  ptr_tables_[num]->set_spill_ranges(ranges, max_value_size);
+}
+#endif
 // debug time
 template <typename KeyType,
           typename ValType,
@@ -427,6 +625,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::MemcpyPeerAsync(
   } else {
     CUDA_CHECK(
         cudaMemcpyPeerAsync(dst, dst_device, src, src_device, count, stream));
+    record_link_bytes(src_device, dst_device, count);
   }
 #endif
 }
@@ -1845,11 +2044,13 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::push_sparse(
     float *d_grads,
     size_t len,
     Sgd &sgd) {  // NOLINT
+  link_traffic_in_push() = true;
   if (multi_node_) {
     push_sparse_all2all(dev_num, d_keys, d_grads, len, sgd);
   } else {
     push_normal_sparse(dev_num, d_keys, d_grads, len, sgd);
   }
+  link_traffic_in_push() = false;
   print_debug_time(dev_num);
 }
 template <typename KeyType,
@@ -2231,6 +2432,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::end_pass() {
       t.join();
     }
   }
+  report_link_utilization();
 }
 template <typename KeyType,
           typename ValType,
@@ -2607,6 +2809,21 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_keys_p2p(
   // gather all datas
   heter_comm_kernel_->gather_keys(
       res.d_keys_parted, d_keys, res.d_idx, total_fea_num, stream, gpu_id);
+  if (FLAGS_gpugraph_inner_shuffle_by_nccl) {
+    auto &my_cache = storage_[gpu_id];
+    std::vector<size_t> h_recv_sizes = inner_recv_sizes(gpu_id);
+    inner_shuffle_by_nccl(gpu_id,
+                          res.h_part_sizes,
+                          res.h_offsets.data(),
+                          h_recv_sizes.data(),
+                          my_cache.h_recv_offsets.data(),
+                          sizeof(KeyType),
+                          reinterpret_cast<const char *>(res.d_keys_parted),
+                          reinterpret_cast<char *>(my_cache.d_merged_keys),
+                          stream);
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
+    return;
+  }
   if (trans_id < 0) {
     // not need transfer
     for (int i = 0; i < gpu_num; ++i) {
@@ -2621,6 +2838,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_keys_p2p(
                                                      gpu_id,
                                                      data_len * sizeof(KeyType),
                                                      stream));
+      record_link_bytes(gpu_id, i, data_len * sizeof(KeyType));
     }
     PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
     return;
@@ -2641,6 +2859,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_keys_p2p(
                                                      gpu_id,
                                                      data_len * sizeof(KeyType),
                                                      stream));
+      record_link_bytes(gpu_id, i, data_len * sizeof(KeyType));
       continue;
     }
     PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyPeerAsync(res.d_trans_keys,
@@ -2649,15 +2868,77 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_keys_p2p(
                                                    gpu_id,
                                                    data_len * sizeof(KeyType),
                                                    stream));
+    record_link_bytes(gpu_id, trans_id, data_len * sizeof(KeyType));
     PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyPeerAsync(res.d_remote_keys[i],
                                                    i,
                                                    res.d_trans_keys,
                                                    trans_id,
                                                    data_len * sizeof(KeyType),
                                                    stream));
+    record_link_bytes(trans_id, i, data_len * sizeof(KeyType));
   }
   PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
 }
+template <typename KeyType,
+          typename ValType,
+          typename GradType,
+          typename GPUAccessor>
+void HeterComm<KeyType, ValType, GradType, GPUAccessor>::inner_shuffle_by_nccl(
+    const int &gpu_id,
+    const size_t *h_send_sizes,
+    const size_t *h_send_offsets,
+    const size_t *h_recv_sizes,
+    const size_t *h_recv_offsets,
+    const size_t &elem_bytes,
+    const char *d_send_buff,
+    char *d_recv_buff,
+    const cudaStream_t &stream) {
+  PADDLE_ENFORCE_EQ(
+      nccl_inner_comms_.size(),
+      static_cast<size_t>(device_num_),
+      common::errors::PreconditionNotMet(
+          "The inner shuffle by nccl needs %d inner comms, but got %d.",
+          device_num_,
+          nccl_inner_comms_.size()));
+  auto &comm = nccl_inner_comms_[gpu_id];
+  PADDLE_ENFORCE_GPU_SUCCESS(phi::dynload::ncclGroupStart());
+  for (int i = 0; i < device_num_; ++i) {
+    if (i == gpu_id) {
+      continue;
+    }
+    const size_t &send_size = h_send_sizes[i];
+    if (send_size > 0) {
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          phi::dynload::ncclSend(&d_send_buff[h_send_offsets[i] * elem_bytes],
+                                 send_size * elem_bytes,
+                                 ncclInt8,
+                                 i,
+                                 comm,
+                                 stream));
+      record_link_bytes(gpu_id, i, send_size * elem_bytes);
+    }
+    const size_t &recv_size = h_recv_sizes[i];
+    if (recv_size > 0) {
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          phi::dynload::ncclRecv(&d_recv_buff[h_recv_offsets[i] * elem_bytes],
+                                 recv_size * elem_bytes,
+                                 ncclInt8,
+                                 i,
+                                 comm,
+                                 stream));
+    }
+  }
+  PADDLE_ENFORCE_GPU_SUCCESS(phi::dynload::ncclGroupEnd());
+  // the part of gpu_id itself
+  if (h_send_sizes[gpu_id] > 0) {
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaMemcpyAsync(&d_recv_buff[h_recv_offsets[gpu_id] * elem_bytes],
+                        &d_send_buff[h_send_offsets[gpu_id] * elem_bytes],
+                        h_send_sizes[gpu_id] * elem_bytes,
+                        cudaMemcpyDeviceToDevice,
+                        stream));
+  }
+}
 template <typename KeyType,
           typename ValType,
           typename GradType,
@@ -3193,7 +3474,20 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::scatter_inner_vals_p2p(
     const size_t &value_bytes,
     const cudaStream_t &stream) {
   AnyDeviceGuard guard(resource_->dev_id(gpu_id));
-  if (trans_id < 0) {
+  if (FLAGS_gpugraph_inner_shuffle_by_nccl) {
+    // send back the vals of the keys received in gather_inner_keys_p2p
+    auto &my_cache = storage_[gpu_id];
+    std::vector<size_t> h_send_sizes = inner_recv_sizes(gpu_id);
+    inner_shuffle_by_nccl(gpu_id,
+                          h_send_sizes.data(),
+                          my_cache.h_recv_offsets.data(),
+                          res.h_part_sizes,
+                          res.h_offsets.data(),
+                          value_bytes,
+                          my_cache.d_merged_push_vals,
+                          res.d_vals_parted,
+                          stream);
+  } else if (trans_id < 0) {
     // not need transfer
     for (int i = 0; i < gpu_num; ++i) {
       size_t &data_len = res.h_part_sizes[i];
@@ -3208,6 +3502,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::scatter_inner_vals_p2p(
                               i,
                               data_len * value_bytes,
                               stream));
+      record_link_bytes(i, gpu_id, data_len * value_bytes);
     }
   } else {
     // need transfer
@@ -3227,6 +3522,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::scatter_inner_vals_p2p(
                                 i,
                                 data_len * value_bytes,
                                 stream));
+        record_link_bytes(i, gpu_id, data_len * value_bytes);
         continue;
       }
       PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyPeerAsync(res.d_trans_vals,
@@ -3235,6 +3531,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::scatter_inner_vals_p2p(
                                                      i,
                                                      data_len * value_bytes,
                                                      stream));
+      record_link_bytes(i, trans_id, data_len * value_bytes);
       PADDLE_ENFORCE_GPU_SUCCESS(
           cudaMemcpyPeerAsync(&res.d_vals_parted[offset * value_bytes],
                               gpu_id,
@@ -3242,6 +3539,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::scatter_inner_vals_p2p(
                               trans_id,
                               data_len * value_bytes,
                               stream));
+      record_link_bytes(trans_id, gpu_id, data_len * value_bytes);
     }
   }
   // restore vals
@@ -3338,6 +3636,30 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_data_p2p(
                                   total_fea_num,
                                   value_bytes,
                                   stream);
+  if (FLAGS_gpugraph_inner_shuffle_by_nccl) {
+    auto &my_cache = storage_[gpu_id];
+    std::vector<size_t> h_recv_sizes = inner_recv_sizes(gpu_id);
+    inner_shuffle_by_nccl(gpu_id,
+                          res.h_part_sizes,
+                          res.h_offsets.data(),
+                          h_recv_sizes.data(),
+                          my_cache.h_recv_offsets.data(),
+                          sizeof(KeyType),
+                          reinterpret_cast<const char *>(res.d_keys_parted),
+                          reinterpret_cast<char *>(my_cache.d_merged_keys),
+                          stream);
+    inner_shuffle_by_nccl(gpu_id,
+                          res.h_part_sizes,
+                          res.h_offsets.data(),
+                          h_recv_sizes.data(),
+                          my_cache.h_recv_offsets.data(),
+                          value_bytes,
+                          res.d_vals_parted,
+                          my_cache.d_merged_vals,
+                          stream);
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
+    return;
+  }
   // p2p copy key and values
   if (trans_id < 0) {
     // not need transfer
@@ -3353,6 +3675,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_data_p2p(
                                                      gpu_id,
                                                      data_len * sizeof(KeyType),
                                                      stream));
+      record_link_bytes(gpu_id, i, data_len * sizeof(KeyType));
       PADDLE_ENFORCE_GPU_SUCCESS(
           cudaMemcpyPeerAsync(res.d_remote_vals[i],
                               i,
@@ -3360,6 +3683,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_data_p2p(
                               gpu_id,
                               data_len * value_bytes,
                               stream));
+      record_link_bytes(gpu_id, i, data_len * value_bytes);
     }
     PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
     return;
@@ -3378,6 +3702,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_data_p2p(
                                                      gpu_id,
                                                      data_len * sizeof(KeyType),
                                                      stream));
+      record_link_bytes(gpu_id, i, data_len * sizeof(KeyType));
       PADDLE_ENFORCE_GPU_SUCCESS(
           cudaMemcpyPeerAsync(res.d_remote_vals[i],
                               i,
@@ -3385,6 +3710,7 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_data_p2p(
                               gpu_id,
                               data_len * value_bytes,
                               stream));
+      record_link_bytes(gpu_id, i, data_len * value_bytes);
       continue;
     }
     PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyPeerAsync(res.d_trans_keys,
@@ -3393,12 +3719,14 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_data_p2p(
                                                    gpu_id,
                                                    data_len * sizeof(KeyType),
                                                    stream));
+    record_link_bytes(gpu_id, trans_id, data_len * sizeof(KeyType));
     PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyPeerAsync(res.d_remote_keys[i],
                                                    i,
                                                    res.d_trans_keys,
                                                    trans_id,
                                                    data_len * sizeof(KeyType),
                                                    stream));
+    record_link_bytes(trans_id, i, data_len * sizeof(KeyType));
     PADDLE_ENFORCE_GPU_SUCCESS(
         cudaMemcpyPeerAsync(res.d_trans_vals,
                             trans_id,
@@ -3406,12 +3734,14 @@ void HeterComm<KeyType, ValType, GradType, GPUAccessor>::gather_inner_data_p2p(
                             gpu_id,
                             data_len * value_bytes,
                             stream));
+    record_link_bytes(gpu_id, trans_id, data_len * value_bytes);
     PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyPeerAsync(res.d_remote_vals[i],
                                                    i,
                                                    res.d_trans_vals,
                                                    trans_id,
                                                    data_len * value_bytes,
                                                    stream));
+    record_link_bytes(trans_id, i, data_len * value_bytes);
   }
   PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
 }
@@ -87,6 +87,13 @@ class HeterPs : public HeterPsBase {
     comm_->reset_table(dev_id, capacity, sgd_config, embedx_config, infer_mode);
   }
   void set_mode(bool infer_mode) { comm_->set_mode(infer_mode); }
+#if defined(PADDLE_WITH_CUDA)
+  void set_spill_ranges(int num,
+                        const SpillRanges& ranges,
+                        size_t max_value_size) override {
+    comm_->set_spill_ranges(num, ranges, max_value_size);
+  }
+#endif
 
  private:
   std::shared_ptr<HeterComm<FeatureKey, float*, float*, GPUAccessor>> comm_;
@@ -17,6 +17,7 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/fleet/heter_ps/feature_value.h"
 #include "paddle/fluid/framework/fleet/heter_ps/heter_resource.h"
+#include "paddle/fluid/framework/fleet/heter_ps/mem_pool.h"
 #include "paddle/fluid/framework/fleet/heter_ps/optimizer_conf.h"
 
 #ifdef PADDLE_WITH_HETERPS
@@ -51,6 +52,9 @@ class HeterPsBase {
       int comm_size,
       int rank_id) = 0;
   virtual void set_multi_mf_dim(int multi_mf_dim, int max_mf_dim) = 0;
+  virtual void set_spill_ranges(int num,
+                                const SpillRanges& ranges,
+                                size_t max_value_size) = 0;
 
 #endif
   virtual void end_pass() = 0;
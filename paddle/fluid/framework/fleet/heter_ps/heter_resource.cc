@@ -15,6 +15,8 @@ limitations under the License. */
 #ifdef PADDLE_WITH_HETERPS
 #include "paddle/fluid/framework/fleet/heter_ps/heter_resource.h"
 
+#include <algorithm>
+
 #ifdef PADDLE_WITH_CUDA
 #include "paddle/phi/core/platform/cuda_device_guard.h"
 #endif
@@ -198,6 +200,9 @@ bool GpuRDMAChecker::check_device_status(const int &device_count,
       continue;
     }
     std::string &card_name = tags[0];
+    if (strncmp(card_name.c_str(), "GPU", 3) == 0 && isdigit(card_name[3])) {
+      parse_link_bandwidth(atoi(card_name.c_str() + 3), tags);
+    }
     if (strncmp(card_name.c_str(), "GPU0", 4) == 0) {
       // check topo_aware
       topo_aware_ = false;
@@ -247,8 +252,112 @@ bool GpuRDMAChecker::check_device_status(const int &device_count,
   // need trans device all connect to other device
   return (need_trans_cnt > 0 && not_trans_cnt == 0);
 }
+// GPU1  NV12  X  NV12  PIX  SYS ...
+void GpuRDMAChecker::parse_link_bandwidth(
+    int gpu, const std::vector<std::string> &tags) {
+  if (gpu < 0 || gpu >= device_num_) {
+    return;
+  }
+  if (link_bandwidth_.empty()) {
+    link_bandwidth_.resize(device_num_ * device_num_, 0);
+  }
+  for (int j = 0; j < device_num_; ++j) {
+    const std::string &tag = tags[j + 1];
+    double bandwidth = 0;
+    if (strncmp(tag.c_str(), "NV", 2) == 0) {
+      // NV# is the number of the bonded nvlinks, about 25GB/s each
+      bandwidth = 25.0 * std::max(atoi(tag.c_str() + 2), 1);
+    } else if (tag == "PIX") {
+      bandwidth = 24.0;
+    } else if (tag == "PXB") {
+      bandwidth = 20.0;
+    } else if (tag == "PHB") {
+      bandwidth = 16.0;
+    } else if (tag == "NODE") {
+      bandwidth = 12.0;
+    } else if (tag == "SYS") {
+      bandwidth = 8.0;
+    }
+    link_bandwidth_[gpu * device_num_ + j] = bandwidth;
+  }
+}
+double GpuRDMAChecker::link_bandwidth(int i, int j) {
+  if (link_bandwidth_.empty() || i < 0 || j < 0 || i >= device_num_ ||
+      j >= device_num_) {
+    return 0;
+  }
+  return link_bandwidth_[i * device_num_ + j];
+}
 #endif
 
+DeviceRoutingPlan::DeviceRoutingPlan(int device_num,
+                                     const std::vector<double> &bandwidth,
+                                     int max_hops)
+    : device_num_(device_num), bandwidth_(bandwidth) {
+  PADDLE_ENFORCE_EQ(
+      bandwidth_.size(),
+      static_cast<size_t>(device_num * device_num),
+      common::errors::InvalidArgument(
+          "The bandwidth matrix should have %d elements, but got %d.",
+          device_num * device_num,
+          bandwidth_.size()));
+  // the time in seconds of a copy of 4MB, and the latency of a hop
+  constexpr double kReferenceBytes = 4.0 * 1024 * 1024;
+  constexpr double kHopLatency = 1e-5;
+  double min_bandwidth = 0;
+  for (double bw : bandwidth_) {
+    if (bw > 0 && (min_bandwidth == 0 || bw < min_bandwidth)) {
+      min_bandwidth = bw;
+    }
+  }
+  if (min_bandwidth == 0) {
+    min_bandwidth = 1.0;
+  }
+  auto link_cost = [&](int i, int j) {
+    double bw = bandwidth_[i * device_num + j];
+    if (bw <= 0) {
+      bw = min_bandwidth;
+    }
+    return kReferenceBytes / (bw * 1e9) + kHopLatency;
+  };
+
+  routes_.resize(device_num * device_num);
+  std::vector<double> cost(device_num);
+  // the cheapest routes of at most max_hops hops from each device, by
+  // relaxing all the links once per hop
+  for (int src = 0; src < device_num; ++src) {
+    std::vector<int> *routes = &routes_[src * device_num];
+    for (int j = 0; j < device_num; ++j) {
+      cost[j] = j == src ? 0 : link_cost(src, j);
+      if (j != src) {
+        routes[j] = {j};
+      }
+    }
+    for (int hop = 1; hop < max_hops; ++hop) {
+      std::vector<double> next_cost = cost;
+      std::vector<std::vector<int>> next_routes(routes, routes + device_num);
+      for (int k = 0; k < device_num; ++k) {
+        if (k == src) {
+          continue;
+        }
+        for (int j = 0; j < device_num; ++j) {
+          if (j == src || j == k) {
+            continue;
+          }
+          double c = cost[k] + link_cost(k, j);
+          if (c < next_cost[j]) {
+            next_cost[j] = c;
+            next_routes[j] = routes[k];
+            next_routes[j].push_back(j);
+          }
+        }
+      }
+      cost.swap(next_cost);
+      std::move(next_routes.begin(), next_routes.end(), routes);
+    }
+  }
+}
+
 HeterPsResource::HeterPsResource(const std::vector<int> &dev_ids) {
   dev_ids_ = dev_ids;
   for (size_t i = 0; i < dev_ids_.size(); ++i) {
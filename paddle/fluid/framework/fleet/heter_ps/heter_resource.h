@@ -16,6 +16,7 @@ limitations under the License. */
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #ifdef PADDLE_WITH_CUDA
@@ -111,20 +112,54 @@ class GpuRDMAChecker {
   int device_num(void) { return device_num_; }
   // topo_aware
   bool topo_aware(void) { return topo_aware_; }
+  // The nominal bandwidth in GB/s from GPU i to GPU j by the type of their
+  // link in nvidia-smi topo -m, 0 if it is not known.
+  double link_bandwidth(int i, int j);
 
  private:
   bool check_device_status(const int& device_count,
                            std::vector<int>* gpu_status);
+  void parse_link_bandwidth(int gpu, const std::vector<std::string>& tags);
 
  private:
   int device_num_ = 0;
   bool topo_aware_ = false;
+  // device_num_ x device_num_, empty if the topo is not detected
+  std::vector<double> link_bandwidth_;
   // rdma
   bool rdma_trans_ = false;
   std::vector<int> rdma_status_;
 };
 #endif
 
+/*
+ * The routes of the copies between the devices of a node, chosen by the
+ * bandwidth of the links between them. A copy relayed by a device is
+ * synchronized at each hop, so a route costs the sum of the times of a
+ * reference copy on its links, plus a latency per hop.
+ */
+class DeviceRoutingPlan {
+ public:
+  // bandwidth[i * device_num + j] is the bandwidth in GB/s from i to j, 0 if
+  // it is not known, which is taken as the lowest known bandwidth.
+  DeviceRoutingPlan(int device_num,
+                    const std::vector<double>& bandwidth,
+                    int max_hops);
+
+  // The devices after i on the route from i to j, ending with j.
+  const std::vector<int>& route(int i, int j) const {
+    return routes_[i * device_num_ + j];
+  }
+  double bandwidth(int i, int j) const {
+    return bandwidth_[i * device_num_ + j];
+  }
+
+ private:
+  int device_num_;
+  std::vector<double> bandwidth_;
+  std::vector<std::vector<int>> routes_;
+};
+
 template <typename KeyType, typename ValType>
 class HashTable;
 
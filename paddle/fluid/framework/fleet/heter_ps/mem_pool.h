@@ -15,7 +15,10 @@ limitations under the License. */
 #pragma once
 
 #ifdef PADDLE_WITH_HETERPS
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #ifdef PADDLE_WITH_CUDA
 #include "paddle/fluid/framework/fleet/heter_ps/cudf/managed.cuh"
 #include "paddle/fluid/framework/fleet/heter_ps/gpu_graph_utils.h"
@@ -93,51 +96,145 @@ class HBMMemoryPool : public managed {
   size_t block_size_;
 };
 
+// The values [0, hbm_size) are in hbm, and the values [hbm_size, size) of a
+// pool larger than the hbm budget of reset are spilled to pinned host memory
+// mapped to the device, which the kernels read and write through the same
+// pointers as the hbm ones.
 class HBMMemoryPoolFix : public managed {
  public:
   HBMMemoryPoolFix() {
     capacity_ = 0;
     size_ = 0;
+    hbm_size_ = 0;
     block_size_ = 0;
     max_byte_capacity_ = 0;
+    max_host_byte_capacity_ = 0;
   }
 
   ~HBMMemoryPoolFix() {
     VLOG(3) << "delete hbm memory pool";
     cudaFree(mem_);
+    if (host_mem_ != NULL) {
+      cudaFreeHost(host_mem_);
+    }
   }
 
   size_t block_size() { return block_size_; }
 
   void clear(void) { cudaMemset(mem_, 0, block_size_ * capacity_); }
 
-  void reset(size_t capacity, size_t block_size) {
-    if (max_byte_capacity_ < capacity * block_size) {
+  void reset(size_t capacity,
+             size_t block_size,
+             size_t max_hbm_size = std::numeric_limits<size_t>::max()) {
+    hbm_size_ = std::min(capacity, max_hbm_size);
+    if (max_byte_capacity_ < hbm_size_ * block_size) {
       if (mem_ != NULL) {
         cudaFree(mem_);
       }
-      max_byte_capacity_ = (block_size * capacity / 8 + 1) * 8;
+      max_byte_capacity_ = (block_size * hbm_size_ / 8 + 1) * 8;
       CUDA_CHECK(cudaMalloc(&mem_, max_byte_capacity_));
     }
+    size_t host_bytes = (capacity - hbm_size_) * block_size;
+    if (max_host_byte_capacity_ < host_bytes) {
+      if (host_mem_ != NULL) {
+        cudaFreeHost(host_mem_);
+      }
+      max_host_byte_capacity_ = (host_bytes / 8 + 1) * 8;
+      CUDA_CHECK(cudaHostAlloc(reinterpret_cast<void**>(&host_mem_),
+                               max_host_byte_capacity_,
+                               cudaHostAllocPortable | cudaHostAllocMapped));
+    }
     size_ = capacity;
     block_size_ = block_size;
     capacity_ = max_byte_capacity_ / block_size;
   }
 
   char* mem() { return mem_; }
+  // the spilled values, addressed by the device as the host with uva
+  char* host_mem() { return host_mem_; }
 
   size_t capacity() { return capacity_; }
   size_t size() { return size_; }
+  size_t hbm_size() { return hbm_size_; }
+  size_t host_size() { return size_ - hbm_size_; }
+
+  char* value_address(size_t idx) {
+    return idx < hbm_size_ ? mem_ + idx * block_size_
+                           : host_mem_ + (idx - hbm_size_) * block_size_;
+  }
+
+  // Copies the values [idx, idx + len) from or to the host buffer buf,
+  // split at the end of the hbm values.
+  void copy_from_host(size_t idx,
+                      const char* buf,
+                      size_t len,
+                      cudaStream_t stream) {
+    size_t hbm_len = idx < hbm_size_ ? std::min(len, hbm_size_ - idx) : 0;
+    if (hbm_len > 0) {
+      CUDA_CHECK(cudaMemcpyAsync(value_address(idx),
+                                 buf,
+                                 hbm_len * block_size_,
+                                 cudaMemcpyHostToDevice,
+                                 stream));
+    }
+    if (hbm_len < len) {
+      memcpy(value_address(idx + hbm_len),
+             buf + hbm_len * block_size_,
+             (len - hbm_len) * block_size_);
+    }
+  }
+
+  void copy_to_host(size_t idx, char* buf, size_t len, cudaStream_t stream) {
+    size_t hbm_len = idx < hbm_size_ ? std::min(len, hbm_size_ - idx) : 0;
+    if (hbm_len > 0) {
+      CUDA_CHECK(cudaMemcpyAsync(buf,
+                                 value_address(idx),
+                                 hbm_len * block_size_,
+                                 cudaMemcpyDeviceToHost,
+                                 stream));
+    }
+    if (hbm_len < len) {
+      // the kernels on the stream may still write the spilled values
+      CUDA_CHECK(cudaStreamSynchronize(stream));
+      memcpy(buf + hbm_len * block_size_,
+             value_address(idx + hbm_len),
+             (len - hbm_len) * block_size_);
+    }
+  }
+
   __forceinline__ __device__ void* mem_address(const uint32_t& idx) {
-    return &mem_[(idx)*block_size_];
+    return idx < hbm_size_ ? &mem_[(idx)*block_size_]
+                           : &host_mem_[(idx - hbm_size_) * block_size_];
   }
 
  private:
   char* mem_ = NULL;
+  char* host_mem_ = NULL;
   size_t capacity_;
   size_t size_;
+  size_t hbm_size_;
   size_t block_size_;
   size_t max_byte_capacity_;
+  size_t max_host_byte_capacity_;
+};
+
+// The address ranges of the values spilled to host memory, one per memory
+// pool of the table.
+struct SpillRanges {
+  static constexpr int kMaxRanges = 8;
+  int num = 0;
+  const char* begin[kMaxRanges];
+  const char* end[kMaxRanges];
+
+  __host__ __device__ bool contains(const void* ptr) const {
+    const char* p = reinterpret_cast<const char*>(ptr);
+    for (int i = 0; i < num; ++i) {
+      if (p >= begin[i] && p < end[i]) {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
 }  // end namespace framework
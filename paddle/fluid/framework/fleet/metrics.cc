@@ -19,6 +19,11 @@
 #include <numeric>
 
 #include "paddle/fluid/framework/lod_tensor.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/memory_utils.h"
+#include "paddle/phi/core/platform/device_context.h"
+#endif
 
 #if defined(PADDLE_WITH_PSLIB) || defined(PADDLE_WITH_PSCORE)
 namespace paddle {
@@ -26,6 +31,91 @@ namespace framework {
 
 std::shared_ptr<Metric> Metric::s_instance_ = nullptr;
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// copy the data of the GPU to the host after the kernels writing it
+template <typename T>
+static void CopyToHost(const T* d_data,
+                       int size,
+                       const phi::Place& place,
+                       T* h_data) {
+  auto* dev_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(place));
+  phi::memory_utils::Copy(phi::CPUPlace(),
+                          h_data,
+                          place,
+                          d_data,
+                          sizeof(T) * size,
+                          dev_ctx->stream());
+  dev_ctx->Wait();
+}
+
+double* BasicAucCalculator::device_table(const phi::Place& place) {
+  std::lock_guard<std::mutex> lock(_table_mutex);
+  auto& table = _device_tables[place.GetDeviceId()];
+  if (table == nullptr) {
+    size_t size = sizeof(double) * (2 * _table_size + 4);
+    table = phi::memory_utils::Alloc(place, size);
+    auto* dev_ctx = static_cast<phi::GPUContext*>(
+        phi::DeviceContextPool::Instance().Get(place));
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        hipMemsetAsync(table->ptr(), 0, size, dev_ctx->stream()));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaMemsetAsync(table->ptr(), 0, size, dev_ctx->stream()));
+#endif
+  }
+  return reinterpret_cast<double*>(table->ptr());
+}
+#endif
+
+void BasicAucCalculator::merge_device_tables() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  std::vector<double> h_table(2 * _table_size + 4);
+  for (auto& item : _device_tables) {
+    phi::GPUPlace place(item.first);
+    CopyToHost(reinterpret_cast<const double*>(item.second->ptr()),
+               static_cast<int>(h_table.size()),
+               place,
+               h_table.data());
+    const double* stats = h_table.data() + 2 * _table_size;
+    PADDLE_ENFORCE_EQ(
+        stats[3],
+        0.0,
+        common::errors::PreconditionNotMet(
+            "pred should be in [0, 1] and label must be equal to 0 or 1, but "
+            "%d invalid data are added on %s.",
+            static_cast<int64_t>(stats[3]),
+            place));
+    for (int i = 0; i < _table_size; ++i) {
+      _table[0][i] += h_table[i];
+      _table[1][i] += h_table[_table_size + i];
+    }
+    _local_abserr += stats[0];
+    _local_sqrerr += stats[1];
+    _local_pred += stats[2];
+  }
+  reset_device_tables();
+#endif
+}
+
+void BasicAucCalculator::reset_device_tables() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  for (auto& item : _device_tables) {
+    phi::GPUPlace place(item.first);
+    auto* dev_ctx = static_cast<phi::GPUContext*>(
+        phi::DeviceContextPool::Instance().Get(place));
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(hipMemsetAsync(
+        item.second->ptr(), 0, item.second->size(), dev_ctx->stream()));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaMemsetAsync(
+        item.second->ptr(), 0, item.second->size(), dev_ctx->stream()));
+#endif
+  }
+#endif
+}
+
 void BasicAucCalculator::init(int table_size) {
   set_table_size(table_size);
 
@@ -46,12 +136,19 @@ void BasicAucCalculator::reset() {
   _local_abserr = 0;
   _local_sqrerr = 0;
   _local_pred = 0;
+  reset_device_tables();
 }
 
 void BasicAucCalculator::add_data(const float* d_pred,
                                   const int64_t* d_label,
                                   int batch_size,
                                   const phi::Place& place) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::is_gpu_place(place)) {
+    add_device_data(d_pred, d_label, nullptr, batch_size, place);
+    return;
+  }
+#endif
   thread_local std::vector<float> h_pred;
   thread_local std::vector<int64_t> h_label;
   h_pred.resize(batch_size);
@@ -101,6 +198,12 @@ void BasicAucCalculator::add_mask_data(const float* d_pred,
                                        const int64_t* d_mask,
                                        int batch_size,
                                        const phi::Place& place) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::is_gpu_place(place)) {
+    add_device_data(d_pred, d_label, d_mask, batch_size, place);
+    return;
+  }
+#endif
   thread_local std::vector<float> h_pred;
   thread_local std::vector<int64_t> h_label;
   thread_local std::vector<int64_t> h_mask;
@@ -121,6 +224,7 @@ void BasicAucCalculator::add_mask_data(const float* d_pred,
 }
 
 void BasicAucCalculator::compute() {
+  merge_device_tables();
 #if defined(PADDLE_WITH_GLOO)
   double area = 0;
   double fp = 0;
@@ -271,9 +375,23 @@ void BasicAucCalculator::add_uid_data(const float* d_pred,
   h_label.resize(batch_size);
   h_uid.resize(batch_size);
 
-  memcpy(h_pred.data(), d_pred, sizeof(float) * batch_size);
-  memcpy(h_label.data(), d_label, sizeof(int64_t) * batch_size);
-  memcpy(h_uid.data(), d_uid, sizeof(uint64_t) * batch_size);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::is_gpu_place(place)) {
+    // the records are sorted by uid on the host
+    CopyToHost(d_pred, batch_size, place, h_pred.data());
+    CopyToHost(d_label, batch_size, place, h_label.data());
+    CopyToHost(reinterpret_cast<const uint64_t*>(d_uid),
+               batch_size,
+               place,
+               h_uid.data());
+  } else {
+#endif
+    memcpy(h_pred.data(), d_pred, sizeof(float) * batch_size);
+    memcpy(h_label.data(), d_label, sizeof(int64_t) * batch_size);
+    memcpy(h_uid.data(), d_uid, sizeof(uint64_t) * batch_size);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  }
+#endif
 
   std::lock_guard<std::mutex> lock(_table_mutex);
   for (int i = 0; i < batch_size; ++i) {
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(PADDLE_WITH_PSLIB) || defined(PADDLE_WITH_PSCORE)
+#include <algorithm>
+
+#include "paddle/fluid/framework/fleet/metrics.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_primitives.h"
+#include "paddle/phi/core/platform/device_context.h"
+#include "paddle/phi/kernels/funcs/math_cuda_utils.h"
+
+namespace paddle {
+namespace framework {
+
+// table: the negative and positive buckets, then the sums of abserr, sqrerr
+// and pred, and the number of invalid data
+__global__ void AddAucData(const float* pred,
+                           const int64_t* label,
+                           const int64_t* mask,
+                           int batch_size,
+                           int table_size,
+                           double* table) {
+  double abserr = 0;
+  double sqrerr = 0;
+  double pred_sum = 0;
+  double invalid = 0;
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < batch_size;
+       i += blockDim.x * gridDim.x) {
+    if (mask != nullptr && mask[i] == 0) continue;
+    double p = pred[i];
+    int64_t l = label[i];
+    if (!(p >= 0.0 && p <= 1.0) || (l != 0 && l != 1)) {
+      invalid += 1;
+      continue;
+    }
+    int pos = min(static_cast<int>(p * table_size), table_size - 1);
+    phi::CudaAtomicAdd(table + l * table_size + pos, 1.0);
+    abserr += fabs(p - l);
+    sqrerr += (p - l) * (p - l);
+    pred_sum += p;
+  }
+  // one atomic add per block for the sums
+  abserr = phi::funcs::BlockReduceSum<double>(abserr, FINAL_MASK);
+  sqrerr = phi::funcs::BlockReduceSum<double>(sqrerr, FINAL_MASK);
+  pred_sum = phi::funcs::BlockReduceSum<double>(pred_sum, FINAL_MASK);
+  invalid = phi::funcs::BlockReduceSum<double>(invalid, FINAL_MASK);
+  if (threadIdx.x == 0) {
+    double* stats = table + 2 * table_size;
+    phi::CudaAtomicAdd(stats, abserr);
+    phi::CudaAtomicAdd(stats + 1, sqrerr);
+    phi::CudaAtomicAdd(stats + 2, pred_sum);
+    phi::CudaAtomicAdd(stats + 3, invalid);
+  }
+}
+
+void BasicAucCalculator::add_device_data(const float* d_pred,
+                                         const int64_t* d_label,
+                                         const int64_t* d_mask,
+                                         int batch_size,
+                                         const phi::Place& place) {
+  if (batch_size <= 0) return;
+  double* table = device_table(place);
+  auto* dev_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(place));
+  const int threads = 256;
+  const int blocks = std::min(dev_ctx->GetSMCount() * 4,
+                              (batch_size + threads - 1) / threads);
+  AddAucData<<<blocks, threads, 0, dev_ctx->stream()>>>(
+      d_pred, d_label, d_mask, batch_size, _table_size, table);
+}
+
+}  // namespace framework
+}  // namespace paddle
+#endif
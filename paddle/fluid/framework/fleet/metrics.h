@@ -31,6 +31,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/framework/tensor.h"
 #include "paddle/fluid/framework/variable_helper.h"
+#include "paddle/phi/core/allocator.h"
 #include "paddle/phi/core/platform/timer.h"
 #include "paddle/utils/string/string_helper.h"
 
@@ -83,6 +84,16 @@ class BasicAucCalculator {
                     const int64_t* d_uid,
                     int batch_size,
                     const phi::Place& place);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // add batch data on GPU to the table of the GPU by atomic adds, without
+  // copying it to the host, the data whose d_mask is 0 are skipped if d_mask
+  // is not null
+  void add_device_data(const float* d_pred,
+                       const int64_t* d_label,
+                       const int64_t* d_mask,
+                       int batch_size,
+                       const phi::Place& place);
+#endif
 
   void compute();
   void computeWuAuc();
@@ -104,6 +115,9 @@ class BasicAucCalculator {
 
  private:
   void calculate_bucket_error();
+  // add the tables of the GPUs to the CPU table and reset them
+  void merge_device_tables();
+  void reset_device_tables();
 
  protected:
   double _local_abserr = 0;
@@ -125,6 +139,12 @@ class BasicAucCalculator {
   void set_table_size(int table_size) { _table_size = table_size; }
   int _table_size;
   std::vector<double> _table[2];
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // the table of each GPU by device id: the negative and positive buckets,
+  // then the sums of abserr, sqrerr and pred, and the number of invalid data
+  double* device_table(const phi::Place& place);
+  std::map<int, phi::Allocator::AllocationPtr> _device_tables;
+#endif
   std::vector<WuaucRecord> wuauc_records_;
   static constexpr double kRelativeErrorBound = 0.05;
   static constexpr double kMaxSpan = 0.01;
@@ -31,6 +31,7 @@ limitations under the License. */
 
 #include <algorithm>
 #include <deque>
+#include <numeric>
 #include <unordered_set>
 
 #include "paddle/fluid/framework/data_set.h"
@@ -48,6 +49,8 @@ COMMON_DECLARE_int32(gpugraph_dedup_pull_push_mode);
 COMMON_DECLARE_int32(gpugraph_storage_mode);
 COMMON_DECLARE_bool(query_dest_rank_by_multi_node);
 COMMON_DECLARE_string(graph_edges_split_mode);
+COMMON_DECLARE_int64(gpups_prebuild_pass_budget_mb);
+COMMON_DECLARE_int64(gpugraph_hbm_value_mem_mb);
 
 namespace paddle {
 namespace framework {
@@ -1773,6 +1776,92 @@ void PSGPUWrapper::PrepareGPUTask(std::shared_ptr<HeterContext> gpu_task) {
           << " seconds.";
 }
 
+// Takes the number of values of each device and dim kept in hbm in the budget
+// of FLAGS_gpugraph_hbm_value_mem_mb, the same share of the values of each
+// dim, and moves the keys of the most show, which decays each pass, to the
+// front of the keys of the dim, so that the cold values are spilled to host.
+void PSGPUWrapper::RankHbmValues(
+    std::shared_ptr<HeterContext> gpu_task,
+    std::vector<std::vector<size_t>>* hbm_value_nums) {
+  int device_num = heter_devices_.size();
+  hbm_value_nums->assign(
+      device_num,
+      std::vector<size_t>(multi_mf_dim_, std::numeric_limits<size_t>::max()));
+  if (FLAGS_gpugraph_hbm_value_mem_mb <= 0) {
+    return;
+  }
+  PADDLE_ENFORCE_LE(multi_mf_dim_,
+                    SpillRanges::kMaxRanges,
+                    common::errors::InvalidArgument(
+                        "The values are spilled to host memory with at most "
+                        "%d mf dims, but got %d.",
+                        SpillRanges::kMaxRanges,
+                        multi_mf_dim_));
+  auto accessor_wrapper_ptr =
+      GlobalAccessorFactory::GetInstance().GetAccessorWrapper();
+  size_t budget = static_cast<size_t>(FLAGS_gpugraph_hbm_value_mem_mb) << 20;
+
+  auto rank_func = [this, &gpu_task, &accessor_wrapper_ptr, budget](
+                       int i, std::vector<size_t>* nums) {
+    size_t total_bytes = 0;
+    for (int j = 0; j < multi_mf_dim_; j++) {
+      total_bytes += gpu_task->device_dim_keys_[i][j].size() *
+                     accessor_wrapper_ptr->GetFeatureValueSize(
+                         this->index_dim_vec_[j]);
+    }
+    if (total_bytes <= budget) {
+      return;
+    }
+    double ratio = static_cast<double>(budget) / total_bytes;
+    for (int j = 0; j < multi_mf_dim_; j++) {
+      auto& keys = gpu_task->device_dim_keys_[i][j];
+      auto& ptrs = gpu_task->device_dim_ptr_[i][j];
+      size_t len = keys.size();
+      size_t hbm_num = static_cast<size_t>(len * ratio);
+      (*nums)[j] = hbm_num;
+      VLOG(1) << "card: " << i << " dim: " << this->index_dim_vec_[j]
+              << " keeps " << hbm_num << " of " << len << " values in hbm";
+#ifdef PADDLE_WITH_PSCORE
+      if (hbm_num == 0 || hbm_num == len) {
+        continue;
+      }
+      auto* cpu_accessor = dynamic_cast<paddle::distributed::CtrDymfAccessor*>(
+          cpu_table_accessor_);
+      int show_index = cpu_accessor->common_feature_value.ShowIndex();
+      std::vector<float> shows(len);
+      for (size_t k = 0; k < len; k++) {
+        shows[k] = ptrs[k]->data()[show_index];
+      }
+      std::vector<size_t> order(len);
+      std::iota(order.begin(), order.end(), 0);
+      std::nth_element(order.begin(),
+                       order.begin() + hbm_num,
+                       order.end(),
+                       [&shows](size_t a, size_t b) {
+                         return shows[a] > shows[b];
+                       });
+      std::vector<FeatureKey> ranked_keys(len);
+      std::vector<paddle::distributed::FixedFeatureValue*> ranked_ptrs(len);
+      for (size_t k = 0; k < len; k++) {
+        ranked_keys[k] = keys[order[k]];
+        ranked_ptrs[k] = ptrs[order[k]];
+      }
+      keys.swap(ranked_keys);
+      ptrs.swap(ranked_ptrs);
+#endif
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < device_num; i++) {
+    futures.emplace_back(
+        hbm_thread_pool_[i]->enqueue(rank_func, i, &(*hbm_value_nums)[i]));
+  }
+  for (auto& f : futures) {
+    f.wait();
+  }
+}
+
 void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
   int device_num = heter_devices_.size();
   platform::Timer stagetime;
@@ -1818,6 +1907,8 @@ void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
           << " BuildGPUTask create HeterPs_ costs: " << stagetime.ElapsedSec()
           << " s.";
   stagetime.Start();
+  std::vector<std::vector<size_t>> hbm_value_nums;
+  RankHbmValues(gpu_task, &hbm_value_nums);
 
   auto build_dynamic_mf_func =
       [this, &gpu_task, &accessor_wrapper_ptr](
@@ -1874,7 +1965,8 @@ void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
   auto build_dymf_hbm_pool = [this,
                               &gpu_task,
                               &accessor_wrapper_ptr,
-                              &feature_keys_count](int i) {
+                              &feature_keys_count,
+                              &hbm_value_nums](int i) {
     platform::CUDADeviceGuard guard(resource_->dev_id(i));
 
     platform::Timer stagetime;
@@ -1888,22 +1980,39 @@ void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
                                 infer_mode_);
     // insert hbm table
     stagetime.Start();
+    SpillRanges spill_ranges;
+    size_t max_spill_value_size = 0;
     for (int j = 0; j < multi_mf_dim_; j++) {
       auto& device_dim_keys = gpu_task->device_dim_keys_[i][j];
       size_t len = device_dim_keys.size();
       int mf_dim = this->index_dim_vec_[j];
       size_t feature_value_size =
           accessor_wrapper_ptr->GetFeatureValueSize(mf_dim);
-      this->hbm_pools_[i * this->multi_mf_dim_ + j]->reset(len,
-                                                           feature_value_size);
-      this->HeterPs_->build_ps(
-          i,
-          device_dim_keys.data(),
-          this->hbm_pools_[i * this->multi_mf_dim_ + j]->mem(),
-          len,
-          feature_value_size,
-          4 * 1024 * 1024,
-          2);
+      auto& hbm_pool = this->hbm_pools_[i * this->multi_mf_dim_ + j];
+      hbm_pool->reset(len, feature_value_size, hbm_value_nums[i][j]);
+      size_t hbm_len = hbm_pool->hbm_size();
+      this->HeterPs_->build_ps(i,
+                               device_dim_keys.data(),
+                               hbm_pool->mem(),
+                               hbm_len,
+                               feature_value_size,
+                               4 * 1024 * 1024,
+                               2);
+      if (hbm_len < len) {
+        this->HeterPs_->build_ps(i,
+                                 device_dim_keys.data() + hbm_len,
+                                 hbm_pool->host_mem(),
+                                 len - hbm_len,
+                                 feature_value_size,
+                                 4 * 1024 * 1024,
+                                 2);
+        int num = spill_ranges.num++;
+        spill_ranges.begin[num] = hbm_pool->host_mem();
+        spill_ranges.end[num] =
+            hbm_pool->host_mem() + (len - hbm_len) * feature_value_size;
+        max_spill_value_size =
+            std::max(max_spill_value_size, feature_value_size);
+      }
       if (device_dim_keys.size() > 0) {
         VLOG(3) << "show table: " << i
                 << " table kv size: " << device_dim_keys.size()
@@ -1912,6 +2021,10 @@ void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
       }
     }
 
+    if (FLAGS_gpugraph_hbm_value_mem_mb > 0) {
+      this->HeterPs_->set_spill_ranges(i, spill_ranges, max_spill_value_size);
+    }
+
     stagetime.Pause();
     auto build_span = stagetime.ElapsedSec();
 
@@ -1950,19 +2063,16 @@ void PSGPUWrapper::BuildGPUTask(std::shared_ptr<HeterContext> gpu_task) {
     struct task_info task;
     auto stream = resource_->local_stream(i, 0);
     while (cpu_reday_channels_[i]->Get(task)) {
-      auto hbm = this->hbm_pools_[task.device_id * this->multi_mf_dim_ +
-                                  task.multi_mf_dim]
-                     ->mem();
+      auto& hbm_pool = this->hbm_pools_[task.device_id * this->multi_mf_dim_ +
+                                        task.multi_mf_dim];
       int mf_dim = this->index_dim_vec_[task.multi_mf_dim];
       size_t feature_value_size =
           accessor_wrapper_ptr->GetFeatureValueSize(mf_dim);
-      auto hbm_start = hbm + task.offset * feature_value_size;
-      CUDA_CHECK(cudaMemcpyAsync(
-          hbm_start,
+      hbm_pool->copy_from_host(
+          task.offset,
           task.build_values.get() + task.start * feature_value_size,
-          (task.end - task.start) * feature_value_size,
-          cudaMemcpyHostToDevice,
-          stream));
+          task.end - task.start,
+          stream);
       total_len += (task.end - task.start);
     }
     PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
@@ -2106,11 +2216,66 @@ void PSGPUWrapper::build_pull_thread() {
     VLOG(0) << "passid=" << gpu_task->pass_id_
             << ", thread BuildPull end, cost time: " << timer.ElapsedSec()
             << "s";
+    // Splits the keys of the next pass to the gpus while the current pass
+    // trains, so that BeginPass only has to fill the HBM tables.
+    PrepareTask(gpu_task, true);
     buildpull_ready_channel_->Put(gpu_task);
   }
   VLOG(3) << "build cpu thread end";
 }
 
+bool PSGPUWrapper::PrepareTask(std::shared_ptr<HeterContext> gpu_task,
+                               bool ahead) {
+  if (gpu_task->prepared_) {
+    return true;
+  }
+  if (ahead) {
+    if (FLAGS_gpups_prebuild_pass_budget_mb <= 0) {
+      return false;
+    }
+    // MergePull takes the values the other nodes pulled for the pass, which
+    // are only all there once every node reached BeginPass.
+    if (multi_node_ && gpu_graph_mode_) {
+      return false;
+    }
+    // The device lists are a second copy of the keys and value pointers.
+    size_t key_num = 0;
+    if (multi_mf_dim_) {
+      for (auto& shard_keys : gpu_task->feature_dim_keys_) {
+        for (auto& dim_keys : shard_keys) {
+          key_num += dim_keys.size();
+        }
+      }
+    } else {
+      key_num = gpu_task->size();
+    }
+    size_t bytes = key_num * (sizeof(FeatureKey) + sizeof(void*));
+    size_t budget =
+        static_cast<size_t>(FLAGS_gpups_prebuild_pass_budget_mb) << 20;
+    if (bytes > budget) {
+      VLOG(0) << "passid=" << gpu_task->pass_id_ << ", skip prebuild of "
+              << key_num << " keys over the budget of "
+              << FLAGS_gpups_prebuild_pass_budget_mb << "MB";
+      return false;
+    }
+  }
+  platform::Timer timer;
+  timer.Start();
+  // merge pull
+  MergePull(gpu_task);
+  if (multi_mf_dim_) {
+    divide_to_device(gpu_task);
+  } else {
+    PrepareGPUTask(gpu_task);
+  }
+  gpu_task->prepared_ = true;
+  timer.Pause();
+  VLOG(1) << "passid=" << gpu_task->pass_id_ << ", PrepareTask "
+          << (ahead ? "ahead of BeginPass" : "in BeginPass")
+          << " cost time: " << timer.ElapsedSec() << "s";
+  return true;
+}
+
 void PSGPUWrapper::build_task() {
   // build_task: build_pull + build_gputask
   std::shared_ptr<HeterContext> gpu_task = nullptr;
@@ -2122,13 +2287,7 @@ void PSGPUWrapper::build_task() {
   VLOG(1) << "passid=" << gpu_task->pass_id_ << ", PrepareGPUTask start.";
   platform::Timer timer;
   timer.Start();
-  // merge pull
-  MergePull(gpu_task);
-  if (multi_mf_dim_) {
-    divide_to_device(gpu_task);
-  } else {
-    PrepareGPUTask(gpu_task);
-  }
+  PrepareTask(gpu_task, false);
   BuildGPUTask(gpu_task);
   timer.Pause();
   VLOG(1) << "passid=" << gpu_task->pass_id_
@@ -2288,14 +2447,9 @@ void PSGPUWrapper::HbmToSparseTable() {
         std::shared_ptr<char> build_values(
             new char[feature_value_size * real_len],
             [](char* p) { delete[] p; });
-        uint64_t offset = start * feature_value_size;
         char* test_build_values = build_values.get();
 
-        cudaMemcpyAsync(test_build_values,
-                        hbm_pool->mem() + offset,
-                        feature_value_size * real_len,
-                        cudaMemcpyDeviceToHost,
-                        stream);
+        hbm_pool->copy_to_host(start, test_build_values, real_len, stream);
         for (size_t k = 0; k < real_len; k = k + once_cpu_num) {
           struct task_info task;
           task.build_values = build_values;
@@ -2403,6 +2557,129 @@ void PSGPUWrapper::PullSparse(const phi::Place& place,
              "PullSparse is not used.";
 }
 
+#ifdef PADDLE_WITH_CUDA
+// Copies the keys of all the slots to the device cache, and dedups them into
+// d_merged_keys, with the index of each key in them.
+void PSGPUWrapper::DedupKeys(const phi::Place& place,
+                             const int devid_2_index,
+                             const std::vector<const uint64_t*>& keys,
+                             const std::vector<float*>& values,
+                             const std::vector<int64_t>& slot_lengths,
+                             const std::vector<int>& slot_dim) {
+  int device_id = place.GetDeviceId();
+  auto& dev = device_caches_[devid_2_index];
+  int slot_num = static_cast<int>(slot_lengths.size());
+  std::vector<int64_t> slot_lengths_lod;
+  slot_lengths_lod.reserve(slot_num + 1);
+  slot_lengths_lod.push_back(0);
+
+  int64_t total_length = 0;
+  for (int i = 0; i < slot_num; ++i) {
+    total_length += slot_lengths[i];
+    slot_lengths_lod.push_back(total_length);
+  }
+  dev.total_key_length = total_length;
+  VLOG(3) << "[" << device_id << "]Begin copy keys, key_num[" << total_length
+          << "] dedup mode";
+
+  auto stream = dynamic_cast<phi::GPUContext*>(
+                    phi::DeviceContextPool::Instance().Get(place))
+                    ->stream();
+
+  uint64_t* total_keys = dev.keys_tensor.mutable_data<uint64_t>(
+      (total_length * 3) * sizeof(uint64_t), place);
+
+  int* gpu_slot_dims = dev.dims_tensor.mutable_data<int>(
+      slot_dim.size() * sizeof(int), place);
+  uint64_t** gpu_keys = dev.keys_ptr_tensor.mutable_data<uint64_t*>(
+      keys.size() * sizeof(uint64_t*), place);
+
+  int64_t* slot_lens = dev.slot_lens.mutable_data<int64_t>(
+      (slot_num + 1) * sizeof(int64_t), place);
+  cudaMemcpyAsync(gpu_keys,
+                  keys.data(),
+                  keys.size() * sizeof(uint64_t*),
+                  cudaMemcpyHostToDevice,
+                  stream);
+  cudaMemcpyAsync(slot_lens,
+                  slot_lengths_lod.data(),
+                  slot_lengths_lod.size() * sizeof(int64_t),
+                  cudaMemcpyHostToDevice,
+                  stream);
+
+  cudaMemcpyAsync(gpu_slot_dims,
+                  slot_dim.data(),
+                  slot_dim.size() * sizeof(int),
+                  cudaMemcpyHostToDevice,
+                  stream);
+  float** gpu_values = dev.values_ptr_tensor.mutable_data<float*>(
+      values.size() * sizeof(float*), place);
+  cudaMemcpyAsync(gpu_values,
+                  values.data(),
+                  values.size() * sizeof(float*),
+                  cudaMemcpyHostToDevice,
+                  stream);
+
+  int* key2slot = dev.keys2slot.mutable_data<int>(
+      (total_length * 5) * sizeof(int), place);
+
+  this->CopyKeys(place,
+                 gpu_keys,
+                 total_keys,
+                 slot_lens,
+                 slot_num,
+                 static_cast<int>(total_length),
+                 key2slot);
+
+  uint32_t* d_restore_idx =
+      reinterpret_cast<uint32_t*>(&key2slot[total_length]);
+  uint32_t* d_sorted_idx =
+      reinterpret_cast<uint32_t*>(&d_restore_idx[total_length]);
+  uint32_t* d_offset = reinterpret_cast<uint32_t*>(&d_sorted_idx[total_length]);
+  uint32_t* d_merged_cnts =
+      reinterpret_cast<uint32_t*>(&d_offset[total_length]);
+  uint64_t* d_merged_keys =
+      reinterpret_cast<uint64_t*>(&total_keys[total_length]);
+  uint64_t* d_sorted_keys =
+      reinterpret_cast<uint64_t*>(&d_merged_keys[total_length]);
+
+  int dedup_size = HeterPs_->dedup_keys_and_fillidx(
+      devid_2_index,
+      static_cast<int>(total_length),
+      total_keys,     // input
+      d_merged_keys,  // output
+      d_sorted_keys,  // sort keys
+      d_restore_idx,  // pull fill idx
+      d_sorted_idx,   // sort old idx
+      d_offset,       // offset
+      d_merged_cnts,
+      FLAGS_gpugraph_dedup_pull_push_mode & 0x02);
+  //      printf("device %d, end dedup_keys_and_fillidx total %d, "
+  //              "dedup_size %d, slot num: %d, value size: %d\n",
+  //             device_id, int(total_length), dedup_size, slot_num,
+  //             int(feature_value_size));
+
+  // uint64_t h_merged_keys[total_length];
+  // cudaMemcpyAsync(h_merged_keys,
+  //                 total_keys,
+  //                 total_length * sizeof(uint64_t),
+  //                 cudaMemcpyDeviceToHost,
+  //                 stream);
+  // cudaStreamSynchronize(stream);
+  // std::stringstream ss;
+  // for (int i = 0; i < total_length; ++i) {
+  //   ss << h_merged_keys[i] << " ";
+  // }
+  // VLOG(1) << "h_merged_keys:" << ss.str();
+
+  PADDLE_ENFORCE_GT(dedup_size,
+                    0,
+                    common::errors::PreconditionNotMet(
+                        "dedup keys need more than zero failed in BoxPS."));
+  dev.dedup_key_length = dedup_size;
+}
+#endif
+
 void PSGPUWrapper::PullSparse(const phi::Place& place,
                               const int table_id,
                               const std::vector<const uint64_t*>& keys,
@@ -2432,116 +2709,17 @@ void PSGPUWrapper::PullSparse(const phi::Place& place,
     int devid_2_index = HeterPs_->get_index_by_devid(device_id);
     if (FLAGS_gpugraph_dedup_pull_push_mode > 0) {
       auto& dev = device_caches_[devid_2_index];
-      int slot_num = static_cast<int>(slot_lengths.size());
-      std::vector<int64_t> slot_lengths_lod;
-      slot_lengths_lod.reserve(slot_num + 1);
-      slot_lengths_lod.push_back(0);
-
-      int64_t total_length = 0;
-      for (int i = 0; i < slot_num; ++i) {
-        total_length += slot_lengths[i];
-        slot_lengths_lod.push_back(total_length);
-      }
-      dev.total_key_length = total_length;
-      VLOG(3) << "[" << device_id << "]Begin copy keys, key_num["
-              << total_length << "] dedup mode";
-
-      auto stream = dynamic_cast<phi::GPUContext*>(
-                        phi::DeviceContextPool::Instance().Get(place))
-                        ->stream();
-
-      uint64_t* total_keys = dev.keys_tensor.mutable_data<uint64_t>(
-          (total_length * 3) * sizeof(uint64_t), place);
-
-      int* gpu_slot_dims = dev.dims_tensor.mutable_data<int>(
-          slot_dim.size() * sizeof(int), place);
-      uint64_t** gpu_keys = dev.keys_ptr_tensor.mutable_data<uint64_t*>(
-          keys.size() * sizeof(uint64_t*), place);
-
-      int64_t* slot_lens = dev.slot_lens.mutable_data<int64_t>(
-          (slot_num + 1) * sizeof(int64_t), place);
-      cudaMemcpyAsync(gpu_keys,
-                      keys.data(),
-                      keys.size() * sizeof(uint64_t*),
-                      cudaMemcpyHostToDevice,
-                      stream);
-      cudaMemcpyAsync(slot_lens,
-                      slot_lengths_lod.data(),
-                      slot_lengths_lod.size() * sizeof(int64_t),
-                      cudaMemcpyHostToDevice,
-                      stream);
-
-      cudaMemcpyAsync(gpu_slot_dims,
-                      slot_dim.data(),
-                      slot_dim.size() * sizeof(int),
-                      cudaMemcpyHostToDevice,
-                      stream);
-      float** gpu_values = dev.values_ptr_tensor.mutable_data<float*>(
-          values.size() * sizeof(float*), place);
-      cudaMemcpyAsync(gpu_values,
-                      values.data(),
-                      values.size() * sizeof(float*),
-                      cudaMemcpyHostToDevice,
-                      stream);
-
-      int* key2slot = dev.keys2slot.mutable_data<int>(
-          (total_length * 5) * sizeof(int), place);
-
-      this->CopyKeys(place,
-                     gpu_keys,
-                     total_keys,
-                     slot_lens,
-                     slot_num,
-                     static_cast<int>(total_length),
-                     key2slot);
-
+      DedupKeys(place, devid_2_index, keys, values, slot_lengths, slot_dim);
+      int64_t total_length = dev.total_key_length;
+      int dedup_size = static_cast<int>(dev.dedup_key_length);
+      uint64_t* total_keys = dev.keys_tensor.data<uint64_t>();
+      uint64_t* d_merged_keys = &total_keys[total_length];
+      int* gpu_slot_dims = dev.dims_tensor.data<int>();
+      int64_t* slot_lens = dev.slot_lens.data<int64_t>();
+      float** gpu_values = dev.values_ptr_tensor.data<float*>();
+      int* key2slot = dev.keys2slot.data<int>();
       uint32_t* d_restore_idx =
           reinterpret_cast<uint32_t*>(&key2slot[total_length]);
-      uint32_t* d_sorted_idx =
-          reinterpret_cast<uint32_t*>(&d_restore_idx[total_length]);
-      uint32_t* d_offset =
-          reinterpret_cast<uint32_t*>(&d_sorted_idx[total_length]);
-      uint32_t* d_merged_cnts =
-          reinterpret_cast<uint32_t*>(&d_offset[total_length]);
-      uint64_t* d_merged_keys =
-          reinterpret_cast<uint64_t*>(&total_keys[total_length]);
-      uint64_t* d_sorted_keys =
-          reinterpret_cast<uint64_t*>(&d_merged_keys[total_length]);
-
-      int dedup_size = HeterPs_->dedup_keys_and_fillidx(
-          devid_2_index,
-          static_cast<int>(total_length),
-          total_keys,     // input
-          d_merged_keys,  // output
-          d_sorted_keys,  // sort keys
-          d_restore_idx,  // pull fill idx
-          d_sorted_idx,   // sort old idx
-          d_offset,       // offset
-          d_merged_cnts,
-          FLAGS_gpugraph_dedup_pull_push_mode & 0x02);
-      //      printf("device %d, end dedup_keys_and_fillidx total %d, "
-      //              "dedup_size %d, slot num: %d, value size: %d\n",
-      //             device_id, int(total_length), dedup_size, slot_num,
-      //             int(feature_value_size));
-
-      // uint64_t h_merged_keys[total_length];
-      // cudaMemcpyAsync(h_merged_keys,
-      //                 total_keys,
-      //                 total_length * sizeof(uint64_t),
-      //                 cudaMemcpyDeviceToHost,
-      //                 stream);
-      // cudaStreamSynchronize(stream);
-      // std::stringstream ss;
-      // for (int i = 0; i < total_length; ++i) {
-      //   ss << h_merged_keys[i] << " ";
-      // }
-      // VLOG(1) << "h_merged_keys:" << ss.str();
-
-      PADDLE_ENFORCE_GT(dedup_size,
-                        0,
-                        common::errors::PreconditionNotMet(
-                            "dedup keys need more than zero failed in BoxPS."));
-      dev.dedup_key_length = dedup_size;
 
       int64_t total_bytes = dedup_size * feature_value_size;
       float* total_values_gpu =
@@ -2915,6 +3093,218 @@ void PSGPUWrapper::PushSparseGrad(const phi::Place& place,
   VLOG(3) << "End PushSparseGrad";
 }
 
+void PSGPUWrapper::PullSparseSeqpoolCVM(
+    const phi::Place& place,
+    const std::vector<const uint64_t*>& keys,
+    const std::vector<float*>& pooled_values,
+    const std::vector<int64_t>& slot_lengths,
+    const std::vector<int>& slot_dim,
+    const std::vector<size_t>& ins_offsets,
+    const int batch_size,
+    const float pad_value,
+    const bool use_cvm,
+    const int cvm_offset) {
+  VLOG(3) << "Begin Gpu Ps PullSparseSeqpoolCVM";
+  platform::Timer all_timer;
+  platform::Timer pull_gpups_timer;
+  all_timer.Start();
+  int slot_num = static_cast<int>(slot_lengths.size());
+  PADDLE_ENFORCE_EQ(
+      ins_offsets.size(),
+      static_cast<size_t>(slot_num) * (batch_size + 1),
+      common::errors::InvalidArgument(
+          "The ins_offsets of PullSparseSeqpoolCVM should have %d entries "
+          "for %d slots of %d instances, but got %d.",
+          slot_num * (batch_size + 1),
+          slot_num,
+          batch_size,
+          ins_offsets.size()));
+  if (!phi::is_gpu_place(place)) {
+    PADDLE_THROW(common::errors::Unimplemented(
+        "GpuPs: PullSparseSeqpoolCVM Only Support CUDAPlace Now."));
+  }
+#ifdef PADDLE_WITH_CUDA
+  auto accessor_wrapper_ptr =
+      GlobalAccessorFactory::GetInstance().GetAccessorWrapper();
+  size_t feature_value_size =
+      accessor_wrapper_ptr->GetPullValueSize(max_mf_dim_);
+  int device_id = place.GetDeviceId();
+  platform::CUDADeviceGuard guard(device_id);
+  int devid_2_index = HeterPs_->get_index_by_devid(device_id);
+  auto& dev = device_caches_[devid_2_index];
+  DedupKeys(place, devid_2_index, keys, pooled_values, slot_lengths, slot_dim);
+  int64_t total_length = dev.total_key_length;
+  int dedup_size = static_cast<int>(dev.dedup_key_length);
+  uint64_t* total_keys = dev.keys_tensor.data<uint64_t>();
+  uint64_t* d_merged_keys = &total_keys[total_length];
+  const int* key2slot = dev.keys2slot.data<int>();
+  const uint32_t* d_restore_idx =
+      reinterpret_cast<const uint32_t*>(&key2slot[total_length]);
+  auto stream = dynamic_cast<phi::GPUContext*>(
+                    phi::DeviceContextPool::Instance().Get(place))
+                    ->stream();
+  // kept in the device cache for the push
+  size_t* d_ins_offsets = dev.ins_offsets.mutable_data<size_t>(
+      ins_offsets.size() * sizeof(size_t), place);
+  cudaMemcpyAsync(d_ins_offsets,
+                  ins_offsets.data(),
+                  ins_offsets.size() * sizeof(size_t),
+                  cudaMemcpyHostToDevice,
+                  stream);
+  SeqpoolCVMParam param;
+  param.ins_offsets = d_ins_offsets;
+  param.batch_size = batch_size;
+  param.pad_value = pad_value;
+  param.use_cvm = use_cvm;
+  param.cvm_offset = cvm_offset;
+
+  float* total_values_gpu = dev.pull_push_tensor.mutable_data<float>(
+      dedup_size * feature_value_size, place);
+  pull_gpups_timer.Start();
+  HeterPs_->pull_sparse(
+      devid_2_index, d_merged_keys, total_values_gpu, dedup_size);
+  pull_gpups_timer.Pause();
+
+  // the values of the keys are pooled right into the outputs
+  accessor_wrapper_ptr->CopyForPullSeqpoolCVM(
+      place,
+      total_keys,
+      dev.values_ptr_tensor.data<float*>(),
+      total_values_gpu,
+      slot_num,
+      max_mf_dim_ + 3,
+      dev.dims_tensor.data<int>(),
+      d_restore_idx,
+      feature_value_size,
+      param);
+#endif
+  all_timer.Pause();
+  VLOG(3) << "GpuPs PullSparseSeqpoolCVM total costs: "
+          << all_timer.ElapsedSec()
+          << " s, of which GPUPS costs: " << pull_gpups_timer.ElapsedSec()
+          << " s";
+}
+
+void PSGPUWrapper::PushSparseGradSeqpoolCVM(
+    const phi::Place& place,
+    const std::vector<const float*>& pooled_grads,
+    const float* cvm,
+    const std::vector<int64_t>& slot_lengths,
+    const int batch_size,
+    const bool use_cvm,
+    const int cvm_offset) {
+  ++grad_push_count_;
+  platform::Timer all_timer;
+  platform::Timer push_gpups_timer;
+  all_timer.Start();
+  if (!phi::is_gpu_place(place)) {
+    PADDLE_THROW(common::errors::Unimplemented(
+        "GpuPs: PushSparseGradSeqpoolCVM Only Support CUDAPlace Now."));
+  }
+#ifdef PADDLE_WITH_CUDA
+  auto accessor_wrapper_ptr =
+      GlobalAccessorFactory::GetInstance().GetAccessorWrapper();
+  size_t grad_value_size = accessor_wrapper_ptr->GetPushValueSize(max_mf_dim_);
+  int device_id = place.GetDeviceId();
+  platform::CUDADeviceGuard guard(device_id);
+  int devid_2_index = HeterPs_->get_index_by_devid(device_id);
+  // the keys, their dedup and the ins_offsets are cached by the pull
+  auto& dev = device_caches_[devid_2_index];
+  int64_t total_length = dev.total_key_length;
+  VLOG(3) << "Begin push sparse seqpool cvm, key_num[" << total_length
+          << "], device:" << device_id;
+  auto stream = dynamic_cast<phi::GPUContext*>(
+                    phi::DeviceContextPool::Instance().Get(place))
+                    ->stream();
+  uint64_t* total_keys = dev.keys_tensor.data<uint64_t>();
+  int* slot_dims = dev.dims_tensor.data<int>();
+  int slot_num = static_cast<int>(slot_lengths.size());
+  if (!dev.d_slot_vector.IsInitialized()) {
+    int* buf_slot_vector =
+        dev.d_slot_vector.mutable_data<int>(slot_num * sizeof(int), place);
+    cudaMemcpyAsync(buf_slot_vector,
+                    slot_vector_.data(),
+                    slot_num * sizeof(int),
+                    cudaMemcpyHostToDevice,
+                    stream);
+  }
+  const int64_t* slot_lens = dev.slot_lens.data<int64_t>();
+  const int* d_slot_vector = dev.d_slot_vector.data<int>();
+  const int* key2slot = dev.keys2slot.data<int>();
+  float** gpu_grads = dev.values_ptr_tensor.data<float*>();
+  cudaMemcpyAsync(gpu_grads,
+                  pooled_grads.data(),
+                  pooled_grads.size() * sizeof(float*),
+                  cudaMemcpyHostToDevice,
+                  stream);
+  SeqpoolCVMParam param;
+  param.ins_offsets = dev.ins_offsets.data<size_t>();
+  param.batch_size = batch_size;
+  param.use_cvm = use_cvm;
+  param.cvm_offset = cvm_offset;
+  param.cvm = cvm;
+
+  uint64_t* d_merged_keys = &total_keys[total_length];
+  int64_t dedup_size = dev.dedup_key_length;
+  float* total_grad_values_gpu = dev.pull_push_tensor.mutable_data<float>(
+      dedup_size * grad_value_size, place);
+  // dedup rate more than 3
+  if (total_length > dedup_size * 3) {
+    const uint32_t* d_restore_idx =
+        reinterpret_cast<const uint32_t*>(&key2slot[total_length]);
+    accessor_wrapper_ptr->CopyForPushSeqpoolCVM(place,
+                                                total_keys,
+                                                gpu_grads,
+                                                total_grad_values_gpu,
+                                                d_slot_vector,
+                                                slot_lens,
+                                                max_mf_dim_ + 3,
+                                                total_length,
+                                                dedup_size,
+                                                slot_dims,
+                                                key2slot,
+                                                d_restore_idx,
+                                                grad_value_size,
+                                                param);
+  } else {
+    const uint32_t* d_sorted_idx =
+        reinterpret_cast<const uint32_t*>(&key2slot[total_length * 2]);
+    const uint32_t* d_offset =
+        reinterpret_cast<const uint32_t*>(&d_sorted_idx[total_length]);
+    const uint32_t* d_merged_cnts =
+        reinterpret_cast<const uint32_t*>(&d_offset[total_length]);
+    accessor_wrapper_ptr->CopyForPushSeqpoolCVM(place,
+                                                d_merged_keys,
+                                                gpu_grads,
+                                                total_grad_values_gpu,
+                                                d_slot_vector,
+                                                slot_lens,
+                                                max_mf_dim_ + 3,
+                                                dedup_size,
+                                                slot_dims,
+                                                key2slot,
+                                                d_sorted_idx,
+                                                d_offset,
+                                                d_merged_cnts,
+                                                grad_value_size,
+                                                param);
+  }
+
+  push_gpups_timer.Start();
+  HeterPs_->push_sparse(devid_2_index,
+                        d_merged_keys,
+                        total_grad_values_gpu,
+                        static_cast<int>(dedup_size));
+  push_gpups_timer.Pause();
+#endif
+  all_timer.Pause();
+  time_3 += all_timer.ElapsedSec();
+  time_4 += push_gpups_timer.ElapsedSec();
+  VLOG(3) << "PushSparseGradSeqpoolCVM total cost: " << all_timer.ElapsedSec()
+          << " s, of which GPUPS cost: " << push_gpups_timer.ElapsedSec()
+          << " s";
+}
+
 }  // namespace framework
 }  // end namespace paddle
 #endif
@@ -261,6 +261,8 @@ class PSGPUWrapper {
     DCacheBuffer slot_lens;
     DCacheBuffer d_slot_vector;
     DCacheBuffer keys2slot;
+    // the key offsets of the instances of the fused seqpool cvm pull
+    DCacheBuffer ins_offsets;
 
     int64_t total_key_length = 0;
     int64_t dedup_key_length = 0;
@@ -295,6 +297,29 @@ class PSGPUWrapper {
                       const std::vector<int64_t>& slot_lengths,
                       const int hidden_size,
                       const int batch_size);
+  // Pulls the keys deduped and writes their sum pooling and cvm per
+  // instance right into pooled_values, as fused_seqpool_cvm would on the
+  // output of PullSparse. ins_offsets[slot * (batch_size + 1) + ins] is the
+  // offset of the first key of the instance in all the keys.
+  void PullSparseSeqpoolCVM(const phi::Place& place,
+                            const std::vector<const uint64_t*>& keys,
+                            const std::vector<float*>& pooled_values,
+                            const std::vector<int64_t>& slot_lengths,
+                            const std::vector<int>& slot_dim,
+                            const std::vector<size_t>& ins_offsets,
+                            const int batch_size,
+                            const float pad_value,
+                            const bool use_cvm,
+                            const int cvm_offset);
+  // Pushes the grads of the outputs of the last PullSparseSeqpoolCVM, with
+  // the show and click of the instances in cvm, to the deduped keys.
+  void PushSparseGradSeqpoolCVM(const phi::Place& place,
+                                const std::vector<const float*>& pooled_grads,
+                                const float* cvm,
+                                const std::vector<int64_t>& slot_lengths,
+                                const int batch_size,
+                                const bool use_cvm,
+                                const int cvm_offset);
   void CopyKeys(const phi::Place& place,
                 uint64_t** origin_keys,
                 uint64_t* total_keys,
@@ -308,10 +333,20 @@ class PSGPUWrapper {
                 int slot_num,
                 int total_len,
                 int* key2slot);
+#ifdef PADDLE_WITH_CUDA
+  void DedupKeys(const phi::Place& place,
+                 const int devid_2_index,
+                 const std::vector<const uint64_t*>& keys,
+                 const std::vector<float*>& values,
+                 const std::vector<int64_t>& slot_lengths,
+                 const std::vector<int>& slot_dim);
+#endif
 
   void divide_to_device(std::shared_ptr<HeterContext> gpu_task);
   void add_slot_feature(std::shared_ptr<HeterContext> gpu_task);
   void BuildGPUTask(std::shared_ptr<HeterContext> gpu_task);
+  void RankHbmValues(std::shared_ptr<HeterContext> gpu_task,
+                     std::vector<std::vector<size_t>>* hbm_value_nums);
   void PreBuildTask(std::shared_ptr<HeterContext> gpu_task,
                     Dataset* dataset_for_pull);
   void BuildPull(std::shared_ptr<HeterContext> gpu_task);
@@ -328,6 +363,9 @@ class PSGPUWrapper {
   void start_build_thread();
   void AddSparseKeys();
   void build_pull_thread();
+  // Splits the keys of the task to the gpus, ahead of BeginPass when
+  // ahead is set and it fits FLAGS_gpups_prebuild_pass_budget_mb.
+  bool PrepareTask(std::shared_ptr<HeterContext> gpu_task, bool ahead);
   void build_task();
   void DumpToMem();
   void MergePull(std::shared_ptr<HeterContext> gpu_task);
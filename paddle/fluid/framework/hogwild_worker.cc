@@ -26,6 +26,7 @@ limitations under the License. */
 #include "paddle/fluid/platform/lodtensor_printer.h"
 #include "paddle/phi/core/distributed/comm_context_manager.h"
 #include "paddle/phi/core/platform/cpu_helper.h"
+#include "paddle/phi/core/platform/profiler/event_tracing.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
@@ -1582,7 +1583,11 @@ void HogwildWorker::TrainFiles() {
 #endif
   bool infer_out_of_ins = false;
   while (true) {
-    cur_batch = device_reader_->Next();
+    {
+      platform::RecordEvent record_event(
+          "HogwildWorker::ReadBatch", phi::TracerEventType::Dataloader, 1);
+      cur_batch = device_reader_->Next();
+    }
 #if defined(PADDLE_WITH_HETERPS) && defined(PADDLE_WITH_PSCORE)
     if (use_gpu_graph_ && use_ps_gpu_) {
       if (FLAGS_gpugraph_force_device_batch_num_equal) {
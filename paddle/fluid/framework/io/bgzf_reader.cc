@@ -0,0 +1,315 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/io/bgzf_reader.h"
+
+#ifdef __linux__
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "glog/logging.h"
+#include "paddle/common/enforce.h"
+
+namespace paddle::framework {
+
+// the gzip header of a block up to the block size in its "BC" field
+static constexpr size_t kBgzfHeaderSize = 18;
+// the crc32 and the inflated size after the deflated data of a block
+static constexpr size_t kBgzfFooterSize = 8;
+// the compressed bytes of the blocks read and inflated as one chunk
+static constexpr size_t kBgzfChunkSize = 1 << 20;
+
+static bool IsBgzfHeader(const unsigned char* h) {
+  return h[0] == 31 && h[1] == 139 && h[2] == 8 && (h[3] & 4) != 0 &&
+         (h[10] | h[11] << 8) == 6 && h[12] == 'B' && h[13] == 'C' &&
+         (h[14] | h[15] << 8) == 2;
+}
+
+static size_t BgzfBlockSize(const unsigned char* h) {
+  return (h[16] | h[17] << 8) + 1;
+}
+
+static uint32_t LoadLE32(const unsigned char* p) {
+  return p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+bool BgzfReader::IsBgzf(const std::string& path) {
+  FILE* fp = fopen(path.c_str(), "rb");
+  if (fp == nullptr) {
+    return false;
+  }
+  unsigned char header[kBgzfHeaderSize];
+  bool ret = fread(header, 1, kBgzfHeaderSize, fp) == kBgzfHeaderSize &&
+             IsBgzfHeader(header);
+  fclose(fp);
+  return ret;
+}
+
+BgzfReader::BgzfReader(const std::string& path,
+                       int thread_num,
+                       int prefetch_num)
+    : path_(path) {
+  PADDLE_ENFORCE_GT(thread_num,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The thread number of BgzfReader should be greater "
+                        "than 0, but received %d.",
+                        thread_num));
+  FILE* fp = fopen(path.c_str(), "rb");
+  PADDLE_ENFORCE_NOT_NULL(
+      fp,
+      common::errors::Unavailable(
+          "Failed to open file, path[%s], mode[rb].", path));
+  fp_.reset(fp, [](FILE* fp) { fclose(fp); });
+  if (prefetch_num <= 0) {
+    prefetch_num = 2 * thread_num + 2;
+  }
+  chunks_.resize(prefetch_num);
+  read_thread_ = std::thread(&BgzfReader::ReadThread, this);
+  for (int i = 0; i < thread_num; ++i) {
+    inflate_threads_.emplace_back(&BgzfReader::InflateThread, this);
+  }
+}
+
+BgzfReader::~BgzfReader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  read_cv_.notify_all();
+  inflate_cv_.notify_all();
+  out_cv_.notify_all();
+  read_thread_.join();
+  for (auto& thread : inflate_threads_) {
+    thread.join();
+  }
+}
+
+bool BgzfReader::ReadChunk(Chunk* chunk) {
+  chunk->in.clear();
+  while (chunk->in.size() < kBgzfChunkSize) {
+    unsigned char header[kBgzfHeaderSize];
+    size_t n = fread(header, 1, kBgzfHeaderSize, fp_.get());
+    if (n == 0) {
+      PADDLE_ENFORCE_EQ(ferror(fp_.get()),
+                        0,
+                        common::errors::Unavailable(
+                            "Failed to read file %s.", path_));
+      break;
+    }
+    PADDLE_ENFORCE_EQ(
+        n == kBgzfHeaderSize && IsBgzfHeader(header),
+        true,
+        common::errors::InvalidArgument(
+            "File %s is not a bgzip file or is truncated.", path_));
+    size_t block_size = BgzfBlockSize(header);
+    PADDLE_ENFORCE_GE(block_size,
+                      kBgzfHeaderSize + kBgzfFooterSize,
+                      common::errors::InvalidArgument(
+                          "File %s has a bgzip block of %d bytes.",
+                          path_,
+                          block_size));
+    size_t offset = chunk->in.size();
+    chunk->in.resize(offset + block_size);
+    memcpy(&chunk->in[offset], header, kBgzfHeaderSize);
+    size_t rest = block_size - kBgzfHeaderSize;
+    PADDLE_ENFORCE_EQ(
+        fread(&chunk->in[offset + kBgzfHeaderSize], 1, rest, fp_.get()),
+        rest,
+        common::errors::InvalidArgument(
+            "File %s ends in the middle of a bgzip block.", path_));
+  }
+  return !chunk->in.empty();
+}
+
+void BgzfReader::InflateChunk(Chunk* chunk) {
+  chunk->out.clear();
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+    chunk->error = "Failed to init zlib inflate.";
+    return;
+  }
+  const auto* in = reinterpret_cast<const unsigned char*>(chunk->in.data());
+  size_t pos = 0;
+  while (pos < chunk->in.size()) {
+    size_t block_size = BgzfBlockSize(in + pos);
+    const unsigned char* footer = in + pos + block_size - kBgzfFooterSize;
+    uint32_t crc = LoadLE32(footer);
+    uint32_t raw_size = LoadLE32(footer + 4);
+    size_t offset = chunk->out.size();
+    chunk->out.resize(offset + raw_size);
+    inflateReset(&stream);
+    stream.next_in = const_cast<Bytef*>(in + pos + kBgzfHeaderSize);
+    stream.avail_in = block_size - kBgzfHeaderSize - kBgzfFooterSize;
+    stream.next_out = reinterpret_cast<Bytef*>(&chunk->out[offset]);
+    stream.avail_out = raw_size;
+    int ret = inflate(&stream, Z_FINISH);
+    if (ret != Z_STREAM_END || stream.avail_out != 0) {
+      chunk->error = "Failed to inflate a bgzip block of " + path_ + ".";
+      break;
+    }
+    if (crc32(0, reinterpret_cast<const Bytef*>(&chunk->out[offset]),
+              raw_size) != crc) {
+      chunk->error = "Bgzip block of " + path_ + " fails its crc check.";
+      break;
+    }
+    pos += block_size;
+  }
+  inflateEnd(&stream);
+}
+
+void BgzfReader::ReadThread() {
+  for (uint64_t seq = 0;; ++seq) {
+    Chunk* chunk = &chunks_[seq % chunks_.size()];
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      read_cv_.wait(lock, [this, chunk] {
+        return stop_ || chunk->state == Chunk::kFree;
+      });
+      if (stop_) {
+        return;
+      }
+    }
+    // the chunk is free, no other thread touches it
+    bool more = false;
+    std::string error;
+    try {
+      more = ReadChunk(chunk);
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (more) {
+        chunk->state = Chunk::kRead;
+        read_seq_ = seq + 1;
+      } else {
+        read_done_ = true;
+        read_error_ = error;
+      }
+    }
+    inflate_cv_.notify_all();
+    out_cv_.notify_all();
+    if (!more) {
+      return;
+    }
+  }
+}
+
+void BgzfReader::InflateThread() {
+  while (true) {
+    Chunk* chunk = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      inflate_cv_.wait(lock, [this] {
+        return stop_ || inflate_seq_ < read_seq_ || read_done_;
+      });
+      if (stop_ || inflate_seq_ >= read_seq_) {
+        if (stop_ || read_done_) {
+          return;
+        }
+        continue;
+      }
+      chunk = &chunks_[inflate_seq_++ % chunks_.size()];
+      chunk->state = Chunk::kInflating;
+    }
+    InflateChunk(chunk);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      chunk->state = Chunk::kDone;
+    }
+    out_cv_.notify_all();
+  }
+}
+
+size_t BgzfReader::Read(void* dst, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Chunk* chunk = &chunks_[out_seq_ % chunks_.size()];
+    if (has_out_ && out_pos_ == chunk->out.size()) {
+      chunk->state = Chunk::kFree;
+      chunk->out.clear();
+      has_out_ = false;
+      out_pos_ = 0;
+      ++out_seq_;
+      read_cv_.notify_all();
+      chunk = &chunks_[out_seq_ % chunks_.size()];
+    }
+    if (!has_out_) {
+      out_cv_.wait(lock, [this, chunk] {
+        return chunk->state == Chunk::kDone ||
+               (read_done_ && out_seq_ >= read_seq_);
+      });
+      if (chunk->state != Chunk::kDone) {
+        PADDLE_ENFORCE_EQ(read_error_.empty(),
+                          true,
+                          common::errors::Unavailable("%s", read_error_));
+        break;
+      }
+      PADDLE_ENFORCE_EQ(chunk->error.empty(),
+                        true,
+                        common::errors::InvalidArgument("%s", chunk->error));
+      has_out_ = true;
+    }
+    lock.unlock();
+    // a done chunk is only changed once it is handed out
+    size_t n = std::min(size - done, chunk->out.size() - out_pos_);
+    memcpy(static_cast<char*>(dst) + done, chunk->out.data() + out_pos_, n);
+    out_pos_ += n;
+    done += n;
+  }
+  return done;
+}
+
+std::shared_ptr<FILE> BgzfReader::OpenFile(const std::string& path,
+                                           int thread_num) {
+  cookie_io_functions_t funcs;
+  memset(&funcs, 0, sizeof(funcs));
+  funcs.read = [](void* cookie, char* buf, size_t size) -> ssize_t {
+    // stdio can not pass an exception on
+    try {
+      return static_cast<ssize_t>(
+          static_cast<BgzfReader*>(cookie)->Read(buf, size));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << e.what();
+      errno = EIO;
+      return -1;
+    }
+  };
+  funcs.close = [](void* cookie) -> int {
+    delete static_cast<BgzfReader*>(cookie);
+    return 0;
+  };
+  auto* reader = new BgzfReader(path, thread_num);
+  FILE* fp = fopencookie(reader, "r", funcs);
+  if (!fp) {
+    delete reader;
+    PADDLE_THROW(common::errors::Unavailable(
+        "Failed to open file, path[%s], mode[r].", path));
+  }
+  return {fp, [path](FILE* fp) {
+            if (0 != fclose(fp)) {
+              PADDLE_THROW(common::errors::Unavailable(
+                  "Failed to close file, path[%s].", path));
+            }
+          }};
+}
+
+}  // namespace paddle::framework
+#endif
@@ -0,0 +1,93 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdio.h>
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace framework {
+
+// Decompresses a bgzip file with several threads, in the order of the file.
+//
+// A bgzip (BGZF) file is a series of gzip members of at most 64KB, each
+// giving its compressed size in a "BC" extra field, so it is still a valid
+// .gz file but its blocks are found without inflating the ones before. A
+// thread reads the file chunk by chunk of whole blocks, thread_num threads
+// inflate the chunks, and Read() hands out the result in order, at most
+// prefetch_num chunks ahead of it.
+class BgzfReader {
+ public:
+  // Returns whether path starts with a bgzip block.
+  static bool IsBgzf(const std::string& path);
+
+  BgzfReader(const std::string& path, int thread_num, int prefetch_num = 0);
+  ~BgzfReader();
+
+  // Copies up to size bytes to dst, returns less only at the end of file.
+  size_t Read(void* dst, size_t size);
+
+  // A FILE* that reads the decompressed path, for the readers that take
+  // the FILE* of localfs_open_read().
+  static std::shared_ptr<FILE> OpenFile(const std::string& path,
+                                        int thread_num);
+
+ private:
+  struct Chunk {
+    enum State { kFree, kRead, kInflating, kDone };
+    State state = kFree;
+    std::string in;
+    std::string out;
+    std::string error;
+  };
+
+  void ReadThread();
+  void InflateThread();
+  // Reads whole blocks to chunk->in, returns false at the end of file.
+  bool ReadChunk(Chunk* chunk);
+  void InflateChunk(Chunk* chunk);
+
+  std::string path_;
+  std::shared_ptr<FILE> fp_;
+  std::vector<Chunk> chunks_;
+
+  std::mutex mutex_;
+  std::condition_variable read_cv_;
+  std::condition_variable inflate_cv_;
+  std::condition_variable out_cv_;
+  // the sequence numbers of the next chunk to read, inflate and hand out
+  uint64_t read_seq_ = 0;
+  uint64_t inflate_seq_ = 0;
+  uint64_t out_seq_ = 0;
+  bool read_done_ = false;
+  bool stop_ = false;
+  std::string read_error_;
+  // the part of the current chunk not handed out yet
+  size_t out_pos_ = 0;
+  bool has_out_ = false;
+
+  std::thread read_thread_;
+  std::vector<std::thread> inflate_threads_;
+};
+
+}  // namespace framework
+}  // namespace paddle
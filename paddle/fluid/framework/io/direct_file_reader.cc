@@ -0,0 +1,391 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/io/direct_file_reader.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "glog/logging.h"
+#include "paddle/common/enforce.h"
+
+namespace paddle::framework {
+
+static constexpr int64_t kInFlight = std::numeric_limits<int64_t>::min();
+
+DirectFileReader::DirectFileReader(const std::string& path,
+                                   size_t block_size,
+                                   int queue_depth)
+    : path_(path) {
+  PADDLE_ENFORCE_GT(queue_depth,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The queue depth of DirectFileReader should be "
+                        "greater than 0, but received %d.",
+                        queue_depth));
+  fd_ = open(path.c_str(), O_RDONLY | O_DIRECT);
+  if (fd_ < 0 && errno == EINVAL) {
+    VLOG(3) << "O_DIRECT is not supported for " << path;
+    fd_ = open(path.c_str(), O_RDONLY);
+  }
+  PADDLE_ENFORCE_GE(fd_,
+                    0,
+                    common::errors::Unavailable("Failed to open file %s: %s.",
+                                                path,
+                                                strerror(errno)));
+  struct stat st;
+  PADDLE_ENFORCE_EQ(fstat(fd_, &st),
+                    0,
+                    common::errors::Unavailable("Failed to stat file %s: %s.",
+                                                path,
+                                                strerror(errno)));
+  file_size_ = st.st_size;
+
+  block_size_ = std::max<size_t>(
+      (block_size + kAlignment - 1) / kAlignment * kAlignment, kAlignment);
+  buffers_.resize(queue_depth, nullptr);
+  for (auto& buffer : buffers_) {
+    void* ptr = nullptr;
+    PADDLE_ENFORCE_EQ(
+        posix_memalign(&ptr, kAlignment, block_size_),
+        0,
+        common::errors::ResourceExhausted(
+            "Failed to allocate %d bytes for DirectFileReader.", block_size_));
+    buffer = static_cast<char*>(ptr);
+  }
+  offsets_.assign(queue_depth, -1);
+  results_.assign(queue_depth, 0);
+
+  SetupRing();
+  for (int i = 0; i < queue_depth && next_submit_ < file_size_; ++i) {
+    Submit(i, next_submit_);
+    next_submit_ += static_cast<int64_t>(block_size_);
+  }
+}
+
+DirectFileReader::~DirectFileReader() {
+  if (ring_fd_ >= 0) {
+    // the kernel writes into the buffers until their reads complete
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+      while (offsets_[i] >= 0 && results_[i] == kInFlight && ReapOne()) {
+      }
+    }
+    ReleaseRing();
+  }
+  for (auto* buffer : buffers_) {
+    free(buffer);
+  }
+  close(fd_);
+}
+
+void DirectFileReader::SetupRing() {
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(__NR_io_uring_register)
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int ring_fd = static_cast<int>(
+      syscall(__NR_io_uring_setup, buffers_.size(), &params));
+  if (ring_fd < 0) {
+    VLOG(3) << "io_uring is not available: " << strerror(errno);
+    return;
+  }
+  ring_fd_ = ring_fd;
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  sq_ring_ = mmap(nullptr,
+                  sq_ring_size_,
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE,
+                  ring_fd,
+                  IORING_OFF_SQ_RING);
+  cq_ring_ = mmap(nullptr,
+                  cq_ring_size_,
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE,
+                  ring_fd,
+                  IORING_OFF_CQ_RING);
+  sqes_ = mmap(nullptr,
+               sqes_size_,
+               PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE,
+               ring_fd,
+               IORING_OFF_SQES);
+  if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+    VLOG(3) << "Failed to map the io_uring: " << strerror(errno);
+    ReleaseRing();
+    return;
+  }
+
+  // registering pins the buffers, which fails past RLIMIT_MEMLOCK
+  std::vector<struct iovec> iovecs(buffers_.size());
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    iovecs[i].iov_base = buffers_[i];
+    iovecs[i].iov_len = block_size_;
+  }
+  if (syscall(__NR_io_uring_register,
+              ring_fd,
+              IORING_REGISTER_BUFFERS,
+              iovecs.data(),
+              iovecs.size()) < 0) {
+    VLOG(3) << "Failed to register the buffers to io_uring: "
+            << strerror(errno);
+    ReleaseRing();
+    return;
+  }
+
+  auto* sq = static_cast<char*>(sq_ring_);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  auto* cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+#endif
+}
+
+void DirectFileReader::ReleaseRing() {
+  if (sqes_ != nullptr && sqes_ != MAP_FAILED) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != MAP_FAILED) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr && sq_ring_ != MAP_FAILED) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  sqes_ = cq_ring_ = sq_ring_ = nullptr;
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+}
+
+void DirectFileReader::Submit(int buf_idx, int64_t offset) {
+  offsets_[buf_idx] = offset;
+  results_[buf_idx] = kInFlight;
+  if (ring_fd_ < 0) {
+    // read in Wait()
+    return;
+  }
+#ifdef __NR_io_uring_enter
+  unsigned tail = *sq_tail_;
+  unsigned index = tail & *sq_mask_;
+  auto* sqe = static_cast<struct io_uring_sqe*>(sqes_) + index;
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = IORING_OP_READ_FIXED;
+  sqe->fd = fd_;
+  sqe->off = offset;
+  sqe->addr = reinterpret_cast<uint64_t>(buffers_[buf_idx]);
+  sqe->len = block_size_;
+  sqe->buf_index = buf_idx;
+  sqe->user_data = buf_idx;
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  int ret = 0;
+  do {
+    ret = static_cast<int>(
+        syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0));
+  } while (ret < 0 && errno == EINTR);
+  PADDLE_ENFORCE_GE(
+      ret,
+      0,
+      common::errors::Unavailable("Failed to submit a read of file %s: %s.",
+                                  path_,
+                                  strerror(errno)));
+#endif
+}
+
+bool DirectFileReader::ReapOne() {
+#ifdef __NR_io_uring_enter
+  while (true) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head != tail) {
+      auto* cqe =
+          static_cast<struct io_uring_cqe*>(cqes_) + (head & *cq_mask_);
+      results_[cqe->user_data] = cqe->res;
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+      return true;
+    }
+    if (syscall(__NR_io_uring_enter,
+                ring_fd_,
+                0,
+                1,
+                IORING_ENTER_GETEVENTS,
+                nullptr,
+                0) < 0 &&
+        errno != EINTR) {
+      return false;
+    }
+  }
+#else
+  return false;
+#endif
+}
+
+size_t DirectFileReader::ReadSync(char* dst, size_t size, int64_t offset) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = pread(fd_, dst + done, size - done, offset + done);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    PADDLE_ENFORCE_GE(
+        n,
+        0,
+        common::errors::Unavailable(
+            "Failed to read file %s: %s.", path_, strerror(errno)));
+    if (n == 0) {
+      break;
+    }
+    done += n;
+  }
+  return done;
+}
+
+size_t DirectFileReader::Wait(int buf_idx) {
+  if (ring_fd_ < 0) {
+    results_[buf_idx] = static_cast<int64_t>(
+        ReadSync(buffers_[buf_idx], block_size_, offsets_[buf_idx]));
+  }
+  while (results_[buf_idx] == kInFlight) {
+    PADDLE_ENFORCE_EQ(ReapOne(),
+                      true,
+                      common::errors::Unavailable(
+                          "Failed to wait for a read of file %s: %s.",
+                          path_,
+                          strerror(errno)));
+  }
+  int64_t result = results_[buf_idx];
+  PADDLE_ENFORCE_GE(result,
+                    0,
+                    common::errors::Unavailable("Failed to read file %s: %s.",
+                                                path_,
+                                                strerror(-result)));
+  size_t done = static_cast<size_t>(result);
+  if (done < block_size_ && offsets_[buf_idx] + result < file_size_) {
+    // a short read before the end of the file
+    done += ReadSync(buffers_[buf_idx] + done,
+                     block_size_ - done,
+                     offsets_[buf_idx] + result);
+  }
+  return done;
+}
+
+bool DirectFileReader::NextBlock(const char** data, size_t* size) {
+  if (handed_buf_ >= 0) {
+    if (next_submit_ < file_size_) {
+      Submit(handed_buf_, next_submit_);
+      next_submit_ += static_cast<int64_t>(block_size_);
+    } else {
+      offsets_[handed_buf_] = -1;
+    }
+    handed_buf_ = -1;
+  }
+  int buf_idx = next_buf_;
+  if (offsets_[buf_idx] < 0) {
+    return false;
+  }
+  size_t n = Wait(buf_idx);
+  next_buf_ = (next_buf_ + 1) % static_cast<int>(buffers_.size());
+  handed_buf_ = buf_idx;
+  if (n == 0) {
+    return false;
+  }
+  *data = buffers_[buf_idx];
+  *size = n;
+  return true;
+}
+
+size_t DirectFileReader::Read(void* dst, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    if (pending_size_ == 0 && !NextBlock(&pending_, &pending_size_)) {
+      break;
+    }
+    size_t n = std::min(size - done, pending_size_);
+    memcpy(static_cast<char*>(dst) + done, pending_, n);
+    pending_ += n;
+    pending_size_ -= n;
+    done += n;
+  }
+  return done;
+}
+
+std::shared_ptr<FILE> DirectFileReader::OpenFile(const std::string& path) {
+  cookie_io_functions_t funcs;
+  memset(&funcs, 0, sizeof(funcs));
+  funcs.read = [](void* cookie, char* buf, size_t size) -> ssize_t {
+    // stdio can not pass an exception on
+    try {
+      return static_cast<ssize_t>(
+          static_cast<DirectFileReader*>(cookie)->Read(buf, size));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << e.what();
+      errno = EIO;
+      return -1;
+    }
+  };
+  funcs.close = [](void* cookie) -> int {
+    delete static_cast<DirectFileReader*>(cookie);
+    return 0;
+  };
+  auto* reader = new DirectFileReader(path);
+  FILE* fp = fopencookie(reader, "r", funcs);
+  if (!fp) {
+    delete reader;
+    PADDLE_THROW(common::errors::Unavailable(
+        "Failed to open file, path[%s], mode[r].", path));
+  }
+  return {fp, [path](FILE* fp) {
+            if (0 != fclose(fp)) {
+              PADDLE_THROW(common::errors::Unavailable(
+                  "Failed to close file, path[%s].", path));
+            }
+          }};
+}
+
+DirectFileStreamBuf::int_type DirectFileStreamBuf::underflow() {
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+  const char* data = nullptr;
+  size_t size = 0;
+  if (!reader_.NextBlock(&data, &size)) {
+    return traits_type::eof();
+  }
+  // the get area is never written through
+  char* begin = const_cast<char*>(data);
+  setg(begin, begin, begin + size);
+  return traits_type::to_int_type(*gptr());
+}
+
+}  // namespace paddle::framework
+#endif
@@ -0,0 +1,114 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdio.h>
+
+#include <cstdint>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace framework {
+
+// Reads a local file front to back with O_DIRECT, so that the data does
+// not go through the page cache and is not copied by the kernel once more.
+//
+// queue_depth aligned buffers of block_size bytes are registered to an
+// io_uring, which pins them, and are kept in flight ahead of the reader
+// with fixed buffer reads. The reads fall back to pread() where io_uring
+// is not available, and to a file opened without O_DIRECT where the file
+// system does not support it.
+class DirectFileReader {
+ public:
+  static constexpr size_t kAlignment = 4096;
+
+  explicit DirectFileReader(const std::string& path,
+                            size_t block_size = 1 << 20,
+                            int queue_depth = 8);
+  ~DirectFileReader();
+
+  // Hands out the next block of the file, valid until the next call.
+  // Returns false at the end of the file.
+  bool NextBlock(const char** data, size_t* size);
+  // Copies up to size bytes to dst, returns less only at the end of file.
+  size_t Read(void* dst, size_t size);
+
+  int64_t file_size() const { return file_size_; }
+  bool use_io_uring() const { return ring_fd_ >= 0; }
+
+  // A FILE* that reads path through a DirectFileReader, for the readers
+  // that take the FILE* of localfs_open_read().
+  static std::shared_ptr<FILE> OpenFile(const std::string& path);
+
+ private:
+  void SetupRing();
+  void ReleaseRing();
+  void Submit(int buf_idx, int64_t offset);
+  // Takes one completion off the ring, blocking until there is one.
+  bool ReapOne();
+  // Waits until the read into buf_idx is done and returns its length.
+  size_t Wait(int buf_idx);
+  size_t ReadSync(char* dst, size_t size, int64_t offset);
+
+  std::string path_;
+  int fd_ = -1;
+  int64_t file_size_ = 0;
+  size_t block_size_;
+  std::vector<char*> buffers_;
+  // the file offset each buffer reads, -1 for a free buffer
+  std::vector<int64_t> offsets_;
+  // the bytes read into each buffer or -errno, once the read is done
+  std::vector<int64_t> results_;
+  int64_t next_submit_ = 0;
+  int next_buf_ = 0;
+  // the block handed out last, resubmitted on the next call
+  int handed_buf_ = -1;
+  const char* pending_ = nullptr;
+  size_t pending_size_ = 0;
+
+  int ring_fd_ = -1;
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_mask_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned* cq_mask_ = nullptr;
+  void* cqes_ = nullptr;
+};
+
+// A std::streambuf over a DirectFileReader that points the get area at
+// its blocks, so an istream reads them with no copy in between.
+class DirectFileStreamBuf : public std::streambuf {
+ public:
+  explicit DirectFileStreamBuf(const std::string& path) : reader_(path) {}
+
+ protected:
+  int_type underflow() override;
+
+ private:
+  DirectFileReader reader_;
+};
+
+}  // namespace framework
+}  // namespace paddle
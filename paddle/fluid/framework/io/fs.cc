@@ -19,8 +19,15 @@ limitations under the License. */
 #include <memory>
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/io/bgzf_reader.h"
+#include "paddle/fluid/framework/io/direct_file_reader.h"
+#include "paddle/fluid/framework/io/webhdfs.h"
 #include "paddle/fluid/platform/enforce.h"
 
+COMMON_DECLARE_bool(localfs_direct_io);
+COMMON_DECLARE_int32(localfs_bgzf_thread_num);
+
 namespace paddle {
 namespace framework {
 
@@ -115,10 +122,24 @@ std::shared_ptr<FILE> localfs_open_read(std::string path,
   bool is_pipe = false;
 
   if (fs_end_with_internal(path, ".gz")) {
+#ifdef __linux__
+    // a bgzip file is inflated by several threads rather than one zcat,
+    // when no other command is to read the data
+    if (FLAGS_localfs_bgzf_thread_num > 0 &&
+        (converter.empty() || converter == "cat") &&
+        BgzfReader::IsBgzf(path)) {
+      return BgzfReader::OpenFile(path, FLAGS_localfs_bgzf_thread_num);
+    }
+#endif
     fs_add_read_converter_internal(path, is_pipe, "zcat");
   }
 
   fs_add_read_converter_internal(path, is_pipe, converter);
+#ifdef __linux__
+  if (!is_pipe && FLAGS_localfs_direct_io) {
+    return DirectFileReader::OpenFile(path);
+  }
+#endif
   return fs_open_internal(path, is_pipe, "r", localfs_buffer_size());
 }
 
@@ -280,6 +301,15 @@ std::shared_ptr<FILE> hdfs_open_read(std::string path,
                                      int* err_no,
                                      const std::string& converter,
                                      bool read_data) {
+  if (webhdfs_enabled() && download_cmd().empty() &&
+      (converter.empty() || converter == "cat")) {
+    auto fp = webhdfs_open_read(path, err_no);
+    if (fp != nullptr) {
+      return fp;
+    }
+    LOG(WARNING) << "open " << path
+                 << " over WebHDFS failed, fall back to hadoop fs";
+  }
   if (!download_cmd().empty()) {  // use customized download command
     path = string::format_string(
         "%s \"%s\"", download_cmd().c_str(), path.c_str());
@@ -311,6 +341,14 @@ std::shared_ptr<FILE> hdfs_open_read(std::string path,
 std::shared_ptr<FILE> hdfs_open_write(std::string path,
                                       int* err_no,
                                       const std::string& converter) {
+  if (webhdfs_enabled() && converter.empty()) {
+    auto fp = webhdfs_open_write(path, err_no);
+    if (fp != nullptr) {
+      return fp;
+    }
+    LOG(WARNING) << "create " << path
+                 << " over WebHDFS failed, fall back to hadoop fs";
+  }
   path = string::format_string(
       "%s -put - \"%s\"", hdfs_command().c_str(), path.c_str());
   bool is_pipe = true;
@@ -494,6 +532,14 @@ int64_t fs_file_size(const std::string& path) {
     case 0:
       return localfs_file_size(path);
 
+    case 1:
+      if (webhdfs_enabled()) {
+        return webhdfs_file_size(path);
+      }
+      PADDLE_THROW(common::errors::Unimplemented(
+          "The size of a hdfs file is only supported over WebHDFS, set "
+          "FLAGS_webhdfs_endpoint."));
+
     default:
       PADDLE_THROW(common::errors::Unimplemented(
           "Unsupport file system. Now only supports local file system."));
@@ -16,9 +16,13 @@ limitations under the License. */
 #include <numeric>
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/io/direct_file_reader.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/phi/common/port.h"
 
+COMMON_DECLARE_bool(localfs_direct_io);
+
 namespace paddle::framework {
 
 void SaveTensor(const phi::DenseTensor& x,
@@ -40,6 +44,17 @@ void SaveTensor(const phi::DenseTensor& x,
 }
 
 void LoadTensor(const std::string& file_path, phi::DenseTensor* out) {
+#ifdef __linux__
+  if (FLAGS_localfs_direct_io) {
+    PADDLE_ENFORCE_NOT_NULL(out,
+                            common::errors::InvalidArgument(
+                                "The variable to be loaded cannot be found."));
+    DirectFileStreamBuf buf(file_path);
+    std::istream fin(&buf);
+    framework::DeserializeFromStream(fin, out);
+    return;
+  }
+#endif
   std::ifstream fin(file_path, std::ios::binary);
   PADDLE_ENFORCE_EQ(static_cast<bool>(fin),
                     true,
@@ -0,0 +1,782 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/io/webhdfs.h"
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+
+COMMON_DECLARE_string(webhdfs_endpoint);
+COMMON_DECLARE_string(webhdfs_user);
+COMMON_DECLARE_int32(webhdfs_read_chunk_mb);
+COMMON_DECLARE_int32(webhdfs_read_parallelism);
+
+namespace paddle {
+namespace framework {
+
+#if defined(_WIN32) || defined(__APPLE__)
+
+bool webhdfs_enabled() { return false; }
+
+std::shared_ptr<FILE> webhdfs_open_read(const std::string& path,
+                                        int* err_no) {
+  return nullptr;
+}
+
+std::shared_ptr<FILE> webhdfs_open_write(const std::string& path,
+                                         int* err_no) {
+  return nullptr;
+}
+
+int64_t webhdfs_file_size(const std::string& path) { return -1; }
+
+#else
+
+namespace {
+
+constexpr int kMaxRedirects = 3;
+constexpr int kMaxRetries = 3;
+constexpr size_t kMaxIdleConnections = 16;
+constexpr size_t kWriteChunkSize = 1 << 20;
+constexpr size_t kGzipBufferSize = 1 << 16;
+constexpr int kSocketTimeoutSec = 120;
+
+struct Url {
+  std::string host;
+  int port = 80;
+  // The path and the query.
+  std::string target;
+};
+
+bool ParseUrl(const std::string& url, Url* out) {
+  const std::string scheme = "http://";
+  if (url.compare(0, scheme.size(), scheme) != 0) {
+    return false;
+  }
+  size_t slash = url.find('/', scheme.size());
+  std::string authority = url.substr(scheme.size(),
+                                     slash == std::string::npos
+                                         ? std::string::npos
+                                         : slash - scheme.size());
+  out->target = slash == std::string::npos ? "/" : url.substr(slash);
+  size_t colon = authority.rfind(':');
+  if (colon == std::string::npos) {
+    out->host = authority;
+    out->port = 80;
+  } else {
+    out->host = authority.substr(0, colon);
+    out->port = atoi(authority.c_str() + colon + 1);
+  }
+  return !out->host.empty() && out->port > 0;
+}
+
+std::string ToLower(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
+    return std::tolower(c);
+  });
+  return str;
+}
+
+class HttpConnection {
+ public:
+  HttpConnection(const std::string& host, int port)
+      : _host(host), _port(port) {}
+  ~HttpConnection() {
+    if (_fd >= 0) {
+      close(_fd);
+    }
+  }
+
+  bool Connect() {
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(
+            _host.c_str(), std::to_string(_port).c_str(), &hints, &result) !=
+        0) {
+      return false;
+    }
+    for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+      _fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+      if (_fd < 0) {
+        continue;
+      }
+      if (connect(_fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+        break;
+      }
+      close(_fd);
+      _fd = -1;
+    }
+    freeaddrinfo(result);
+    if (_fd < 0) {
+      return false;
+    }
+    int one = 1;
+    setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    timeval timeout = {kSocketTimeoutSec, 0};
+    setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    return true;
+  }
+
+  bool Send(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t n = send(_fd, data, size, MSG_NOSIGNAL);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      data += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  bool Send(const std::string& data) { return Send(data.data(), data.size()); }
+
+  // Reads a line without its \r\n.
+  bool ReadLine(std::string* line) {
+    size_t end = 0;
+    while ((end = _buffer.find("\r\n", _pos)) == std::string::npos) {
+      if (!Fill()) {
+        return false;
+      }
+    }
+    line->assign(_buffer, _pos, end - _pos);
+    _pos = end + 2;
+    return true;
+  }
+
+  bool Read(char* out, size_t size) {
+    while (size > 0) {
+      if (_pos == _buffer.size() && !Fill()) {
+        return false;
+      }
+      size_t n = std::min(size, _buffer.size() - _pos);
+      memcpy(out, _buffer.data() + _pos, n);
+      _pos += n;
+      out += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  void ReadToEnd(std::string* out) {
+    do {
+      out->append(_buffer, _pos, std::string::npos);
+      _pos = _buffer.size();
+    } while (Fill());
+  }
+
+  std::string key() const { return _host + ":" + std::to_string(_port); }
+
+ private:
+  bool Fill() {
+    if (_pos > 0) {
+      _buffer.erase(0, _pos);
+      _pos = 0;
+    }
+    char data[1 << 16];
+    ssize_t n = 0;
+    do {
+      n = recv(_fd, data, sizeof(data), 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+      return false;
+    }
+    _buffer.append(data, n);
+    return true;
+  }
+
+  std::string _host;
+  int _port;
+  int _fd = -1;
+  std::string _buffer;
+  size_t _pos = 0;
+};
+
+// The idle keep-alive connections, by host and port.
+class ConnectionPool {
+ public:
+  static ConnectionPool& Instance() {
+    static ConnectionPool pool;
+    return pool;
+  }
+
+  std::unique_ptr<HttpConnection> Get(const Url& url, bool* reused) {
+    auto conn = std::make_unique<HttpConnection>(url.host, url.port);
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto& idle = _idle[conn->key()];
+      if (!idle.empty()) {
+        conn = std::move(idle.back());
+        idle.pop_back();
+        *reused = true;
+        return conn;
+      }
+    }
+    *reused = false;
+    return conn->Connect() ? std::move(conn) : nullptr;
+  }
+
+  void Put(std::unique_ptr<HttpConnection> conn) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& idle = _idle[conn->key()];
+    if (idle.size() < kMaxIdleConnections) {
+      idle.push_back(std::move(conn));
+    }
+  }
+
+ private:
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::vector<std::unique_ptr<HttpConnection>>>
+      _idle;
+};
+
+struct HttpResponse {
+  int status = 0;
+  // By lower case name.
+  std::map<std::string, std::string> headers;
+  std::string body;
+};
+
+bool ReadResponseHead(HttpConnection* conn, HttpResponse* response) {
+  std::string line;
+  do {
+    if (!conn->ReadLine(&line)) {
+      return false;
+    }
+    size_t space = line.find(' ');
+    if (space == std::string::npos) {
+      return false;
+    }
+    response->status = atoi(line.c_str() + space + 1);
+    response->headers.clear();
+    while (true) {
+      if (!conn->ReadLine(&line)) {
+        return false;
+      }
+      if (line.empty()) {
+        break;
+      }
+      size_t colon = line.find(':');
+      if (colon == std::string::npos) {
+        continue;
+      }
+      size_t begin = line.find_first_not_of(' ', colon + 1);
+      response->headers[ToLower(line.substr(0, colon))] =
+          begin == std::string::npos ? "" : line.substr(begin);
+    }
+  } while (response->status == 100);
+  return true;
+}
+
+bool ReadResponseBody(HttpConnection* conn,
+                      HttpResponse* response,
+                      bool* keep_alive) {
+  auto& headers = response->headers;
+  auto connection = headers.find("connection");
+  *keep_alive = connection == headers.end() ||
+                ToLower(connection->second) != "close";
+  response->body.clear();
+  auto encoding = headers.find("transfer-encoding");
+  if (encoding != headers.end() &&
+      ToLower(encoding->second).find("chunked") != std::string::npos) {
+    std::string line;
+    while (true) {
+      if (!conn->ReadLine(&line)) {
+        return false;
+      }
+      size_t size = strtoull(line.c_str(), nullptr, 16);
+      if (size == 0) {
+        break;
+      }
+      size_t offset = response->body.size();
+      response->body.resize(offset + size);
+      if (!conn->Read(&response->body[offset], size) ||
+          !conn->ReadLine(&line)) {
+        return false;
+      }
+    }
+    // The trailers.
+    do {
+      if (!conn->ReadLine(&line)) {
+        return false;
+      }
+    } while (!line.empty());
+    return true;
+  }
+  auto length = headers.find("content-length");
+  if (length != headers.end()) {
+    response->body.resize(strtoull(length->second.c_str(), nullptr, 10));
+    return response->body.empty() ||
+           conn->Read(&response->body[0], response->body.size());
+  }
+  *keep_alive = false;
+  conn->ReadToEnd(&response->body);
+  return true;
+}
+
+std::string RequestHead(const std::string& method, const Url& url) {
+  return method + " " + url.target + " HTTP/1.1\r\nHost: " + url.host + ":" +
+         std::to_string(url.port) + "\r\n";
+}
+
+// Sends the request on a connection of the pool, retried once on a new
+// connection when the server had closed the pooled one.
+bool HttpRequest(const std::string& method,
+                 const Url& url,
+                 HttpResponse* response) {
+  std::string request = RequestHead(method, url) + "Content-Length: 0\r\n\r\n";
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    bool reused = false;
+    auto conn = ConnectionPool::Instance().Get(url, &reused);
+    if (conn == nullptr) {
+      return false;
+    }
+    bool keep_alive = false;
+    if (conn->Send(request) && ReadResponseHead(conn.get(), response) &&
+        ReadResponseBody(conn.get(), response, &keep_alive)) {
+      if (keep_alive) {
+        ConnectionPool::Instance().Put(std::move(conn));
+      }
+      return true;
+    }
+    if (!reused) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool IsRedirect(int status) {
+  return status == 301 || status == 302 || status == 303 || status == 307;
+}
+
+// Sends the request to the namenode and follows its redirects to a datanode.
+bool WebHdfsRequest(const std::string& method,
+                    std::string url,
+                    HttpResponse* response) {
+  for (int i = 0; i <= kMaxRedirects; ++i) {
+    Url parsed;
+    if (!ParseUrl(url, &parsed) || !HttpRequest(method, parsed, response)) {
+      return false;
+    }
+    if (!IsRedirect(response->status)) {
+      return true;
+    }
+    url = response->headers["location"];
+  }
+  return false;
+}
+
+// The path of an hdfs:/path, hdfs://authority/path or afs:/path file.
+std::string HdfsPath(const std::string& path) {
+  std::string rest = path.substr(path.find(':') + 1);
+  if (rest.compare(0, 2, "//") == 0) {
+    size_t slash = rest.find('/', 2);
+    rest = slash == std::string::npos ? "/" : rest.substr(slash);
+  }
+  return rest;
+}
+
+std::string WebHdfsUrl(const std::string& path, const std::string& op) {
+  static const char* kHex = "0123456789ABCDEF";
+  std::string url = "http://" + FLAGS_webhdfs_endpoint + "/webhdfs/v1";
+  for (unsigned char c : HdfsPath(path)) {
+    if (std::isalnum(c) || strchr("-_.~/", c) != nullptr) {
+      url.push_back(c);
+    } else {
+      url.push_back('%');
+      url.push_back(kHex[c >> 4]);
+      url.push_back(kHex[c & 15]);
+    }
+  }
+  url += "?op=" + op;
+  if (!FLAGS_webhdfs_user.empty()) {
+    url += "&user.name=" + FLAGS_webhdfs_user;
+  }
+  return url;
+}
+
+bool IsGzip(const std::string& path) {
+  return path.size() >= 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+}
+
+// Returns the length bytes of the file from offset, or less on failure.
+std::string FetchRange(const std::string& path,
+                       int64_t offset,
+                       size_t length) {
+  std::string url = WebHdfsUrl(path,
+                               "OPEN&offset=" + std::to_string(offset) +
+                                   "&length=" + std::to_string(length));
+  HttpResponse response;
+  for (int retry = 0; retry < kMaxRetries; ++retry) {
+    if (WebHdfsRequest("GET", url, &response) && response.status == 200 &&
+        response.body.size() == length) {
+      return std::move(response.body);
+    }
+    LOG(WARNING) << "read " << path << " at " << offset << " over WebHDFS "
+                 << "failed, status " << response.status << ", retry "
+                 << retry;
+  }
+  return "";
+}
+
+// Reads a file by ranges, fetching FLAGS_webhdfs_read_parallelism of them
+// at once ahead of the reader, and inflates it when it is a .gz file.
+class WebHdfsReadFile {
+ public:
+  WebHdfsReadFile(const std::string& path, int64_t size, int* err_no)
+      : _path(path), _size(size), _err_no(err_no) {
+    _chunk_size = static_cast<size_t>(std::max(FLAGS_webhdfs_read_chunk_mb, 1))
+                  << 20;
+    _parallelism = std::max(FLAGS_webhdfs_read_parallelism, 1);
+    if (IsGzip(path)) {
+      _gzip = true;
+      memset(&_zstream, 0, sizeof(_zstream));
+      inflateInit2(&_zstream, 16 + MAX_WBITS);
+      _gzip_in.resize(kGzipBufferSize);
+    }
+    while (Schedule()) {
+    }
+  }
+
+  ~WebHdfsReadFile() {
+    if (_gzip) {
+      inflateEnd(&_zstream);
+    }
+    if (_failed && _err_no != nullptr) {
+      *_err_no = -1;
+    }
+  }
+
+  ssize_t Read(char* out, size_t size) {
+    if (!_gzip) {
+      return ReadRaw(out, size);
+    }
+    _zstream.next_out = reinterpret_cast<Bytef*>(out);
+    _zstream.avail_out = size;
+    while (_zstream.avail_out > 0) {
+      if (_zstream.avail_in == 0) {
+        ssize_t n = ReadRaw(_gzip_in.data(), _gzip_in.size());
+        if (n < 0) {
+          return -1;
+        }
+        if (n == 0) {
+          break;
+        }
+        _zstream.next_in = reinterpret_cast<Bytef*>(_gzip_in.data());
+        _zstream.avail_in = n;
+      }
+      int ret = inflate(&_zstream, Z_NO_FLUSH);
+      if (ret == Z_STREAM_END) {
+        // The next member of a concatenated gzip file, if any.
+        inflateReset(&_zstream);
+      } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        LOG(WARNING) << "inflate " << _path << " failed: " << ret;
+        _failed = true;
+        errno = EIO;
+        return -1;
+      }
+    }
+    return size - _zstream.avail_out;
+  }
+
+ private:
+  bool Schedule() {
+    if (_fetches.size() >= _parallelism || _next_offset >= _size) {
+      return false;
+    }
+    size_t length = std::min<int64_t>(_chunk_size, _size - _next_offset);
+    _fetches.emplace_back(
+        length,
+        std::async(std::launch::async, FetchRange, _path, _next_offset, length));
+    _next_offset += length;
+    return true;
+  }
+
+  ssize_t ReadRaw(char* out, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+      if (_chunk_pos == _chunk.size()) {
+        if (_fetches.empty()) {
+          break;
+        }
+        size_t length = _fetches.front().first;
+        _chunk = _fetches.front().second.get();
+        _chunk_pos = 0;
+        _fetches.pop_front();
+        Schedule();
+        if (_chunk.size() != length) {
+          _failed = true;
+          _fetches.clear();
+          _chunk.clear();
+          errno = EIO;
+          return -1;
+        }
+      }
+      size_t n = std::min(size - done, _chunk.size() - _chunk_pos);
+      memcpy(out + done, _chunk.data() + _chunk_pos, n);
+      _chunk_pos += n;
+      done += n;
+    }
+    return done;
+  }
+
+  std::string _path;
+  int64_t _size;
+  int* _err_no;
+  size_t _chunk_size;
+  size_t _parallelism;
+  int64_t _next_offset = 0;
+  // The fetches in flight, with the length of their range, in order.
+  std::deque<std::pair<size_t, std::future<std::string>>> _fetches;
+  std::string _chunk;
+  size_t _chunk_pos = 0;
+  bool _failed = false;
+
+  bool _gzip = false;
+  z_stream _zstream;
+  std::vector<char> _gzip_in;
+};
+
+// Streams a file to a datanode in one chunked request, deflating it when it
+// is a .gz file.
+class WebHdfsWriteFile {
+ public:
+  WebHdfsWriteFile(const std::string& path, int* err_no)
+      : _path(path), _err_no(err_no) {
+    if (IsGzip(path)) {
+      _gzip = true;
+      memset(&_zstream, 0, sizeof(_zstream));
+      deflateInit2(&_zstream,
+                   Z_BEST_SPEED,
+                   Z_DEFLATED,
+                   16 + MAX_WBITS,
+                   8,
+                   Z_DEFAULT_STRATEGY);
+    }
+  }
+
+  ~WebHdfsWriteFile() {
+    if (_gzip) {
+      deflateEnd(&_zstream);
+    }
+    if (_failed && _err_no != nullptr) {
+      *_err_no = -1;
+    }
+  }
+
+  bool Open() {
+    // The namenode redirects the creation to the datanode to send the data.
+    HttpResponse response;
+    Url url;
+    if (!ParseUrl(WebHdfsUrl(_path, "CREATE&overwrite=true"), &url) ||
+        !HttpRequest("PUT", url, &response) || !IsRedirect(response.status) ||
+        !ParseUrl(response.headers["location"], &_url)) {
+      LOG(WARNING) << "create " << _path << " over WebHDFS failed, status "
+                   << response.status;
+      return false;
+    }
+    _conn = std::make_unique<HttpConnection>(_url.host, _url.port);
+    return _conn->Connect() &&
+           _conn->Send(RequestHead("PUT", _url) +
+                       "Content-Type: application/octet-stream\r\n"
+                       "Transfer-Encoding: chunked\r\n\r\n");
+  }
+
+  ssize_t Write(const char* data, size_t size) {
+    if (_failed) {
+      return -1;
+    }
+    if (!_gzip) {
+      _buffer.append(data, size);
+    } else if (!Deflate(data, size, Z_NO_FLUSH)) {
+      return Fail();
+    }
+    if (_buffer.size() >= kWriteChunkSize && !SendChunk()) {
+      return Fail();
+    }
+    return size;
+  }
+
+  int Close() {
+    HttpResponse response;
+    bool keep_alive = false;
+    if (!_failed && (!_gzip || Deflate(nullptr, 0, Z_FINISH)) && SendChunk() &&
+        _conn->Send("0\r\n\r\n", 5) &&
+        ReadResponseHead(_conn.get(), &response) &&
+        ReadResponseBody(_conn.get(), &response, &keep_alive) &&
+        response.status == 201) {
+      if (keep_alive) {
+        ConnectionPool::Instance().Put(std::move(_conn));
+      }
+      return 0;
+    }
+    LOG(WARNING) << "write " << _path << " over WebHDFS failed, status "
+                 << response.status << ": " << response.body;
+    _failed = true;
+    return EOF;
+  }
+
+ private:
+  ssize_t Fail() {
+    _failed = true;
+    errno = EIO;
+    return -1;
+  }
+
+  bool Deflate(const char* data, size_t size, int flush) {
+    _zstream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    _zstream.avail_in = size;
+    char out[kGzipBufferSize];
+    int ret = Z_OK;
+    do {
+      _zstream.next_out = reinterpret_cast<Bytef*>(out);
+      _zstream.avail_out = sizeof(out);
+      ret = deflate(&_zstream, flush);
+      if (ret == Z_STREAM_ERROR) {
+        return false;
+      }
+      _buffer.append(out, sizeof(out) - _zstream.avail_out);
+    } while (_zstream.avail_out == 0 ||
+             (flush == Z_FINISH && ret != Z_STREAM_END));
+    return true;
+  }
+
+  bool SendChunk() {
+    if (_buffer.empty()) {
+      return true;
+    }
+    char size[32];
+    snprintf(size, sizeof(size), "%zx\r\n", _buffer.size());
+    _buffer.append("\r\n");
+    bool ok = _conn->Send(size, strlen(size)) && _conn->Send(_buffer);
+    _buffer.clear();
+    return ok;
+  }
+
+  std::string _path;
+  int* _err_no;
+  Url _url;
+  std::unique_ptr<HttpConnection> _conn;
+  std::string _buffer;
+  bool _failed = false;
+
+  bool _gzip = false;
+  z_stream _zstream;
+};
+
+ssize_t ReadFileRead(void* cookie, char* buf, size_t size) {
+  return static_cast<WebHdfsReadFile*>(cookie)->Read(buf, size);
+}
+
+int ReadFileClose(void* cookie) {
+  delete static_cast<WebHdfsReadFile*>(cookie);
+  return 0;
+}
+
+ssize_t WriteFileWrite(void* cookie, const char* buf, size_t size) {
+  return static_cast<WebHdfsWriteFile*>(cookie)->Write(buf, size);
+}
+
+int WriteFileClose(void* cookie) {
+  auto* file = static_cast<WebHdfsWriteFile*>(cookie);
+  int ret = file->Close();
+  delete file;
+  return ret;
+}
+
+}  // namespace
+
+bool webhdfs_enabled() { return !FLAGS_webhdfs_endpoint.empty(); }
+
+std::shared_ptr<FILE> webhdfs_open_read(const std::string& path,
+                                        int* err_no) {
+  int64_t size = webhdfs_file_size(path);
+  if (size < 0) {
+    return nullptr;
+  }
+  auto* file = new WebHdfsReadFile(path, size, err_no);
+  FILE* fp = fopencookie(
+      file, "r", cookie_io_functions_t{ReadFileRead, nullptr, nullptr,
+                                       ReadFileClose});
+  if (fp == nullptr) {
+    delete file;
+    return nullptr;
+  }
+  return {fp, [](FILE* fp) { fclose(fp); }};
+}
+
+std::shared_ptr<FILE> webhdfs_open_write(const std::string& path,
+                                         int* err_no) {
+  auto* file = new WebHdfsWriteFile(path, err_no);
+  if (!file->Open()) {
+    delete file;
+    return nullptr;
+  }
+  FILE* fp = fopencookie(
+      file, "w", cookie_io_functions_t{nullptr, WriteFileWrite, nullptr,
+                                       WriteFileClose});
+  if (fp == nullptr) {
+    delete file;
+    return nullptr;
+  }
+  return {fp, [](FILE* fp) { fclose(fp); }};
+}
+
+int64_t webhdfs_file_size(const std::string& path) {
+  HttpResponse response;
+  if (!WebHdfsRequest("GET", WebHdfsUrl(path, "GETFILESTATUS"), &response) ||
+      response.status != 200) {
+    return -1;
+  }
+  size_t pos = response.body.find("\"length\"");
+  if (pos == std::string::npos ||
+      (pos = response.body.find(':', pos)) == std::string::npos) {
+    return -1;
+  }
+  return strtoll(response.body.c_str() + pos + 1, nullptr, 10);
+}
+
+#endif
+
+}  // namespace framework
+}  // namespace paddle
@@ -0,0 +1,48 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+
+namespace paddle {
+namespace framework {
+
+// The hdfs and afs files read and written over WebHDFS, the http interface
+// of hdfs, by the process itself rather than by a hadoop fs command forked
+// per file. A file is read by FLAGS_webhdfs_read_chunk_mb ranges, up to
+// FLAGS_webhdfs_read_parallelism of them fetched at once ahead of the
+// reader, over http connections kept alive across the files. The .gz files
+// are inflated and deflated in process.
+
+// Whether FLAGS_webhdfs_endpoint is set.
+extern bool webhdfs_enabled();
+
+// Return nullptr when the file cannot be opened. *err_no is set to -1 when
+// a read or a write fails later, once the file is closed.
+extern std::shared_ptr<FILE> webhdfs_open_read(const std::string& path,
+                                               int* err_no);
+
+extern std::shared_ptr<FILE> webhdfs_open_write(const std::string& path,
+                                                int* err_no);
+
+// Returns -1 when the file does not exist.
+extern int64_t webhdfs_file_size(const std::string& path);
+
+}  // namespace framework
+}  // namespace paddle
@@ -14,10 +14,27 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/lod_tensor.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/framework/version.h"
+#include "paddle/phi/core/memory/malloc.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef PADDLE_WITH_CUDA
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#endif
+
+COMMON_DECLARE_bool(load_params_with_mmap);
 
 namespace paddle::framework {
 
@@ -319,6 +336,249 @@ void DeserializeFromStream(std::istream &is,
       is, static_cast<phi::DenseTensor *>(tensor), dev_ctx);
 }
 
+#ifndef _WIN32
+namespace {
+
+// The CPU tensor data pointing to the mapped file, which keeps the file
+// mapped while it is alive.
+class MappedFileAllocation : public phi::Allocation {
+ public:
+  MappedFileAllocation(void *ptr, size_t size, std::shared_ptr<void> mapping)
+      : phi::Allocation(ptr, size, phi::CPUPlace()),
+        mapping_(std::move(mapping)) {}
+
+ private:
+  std::shared_ptr<void> mapping_;
+};
+
+// The alignment of the data for the CPU tensors to point to the mapping,
+// the same as the CPU allocator.
+constexpr uintptr_t kMappedTensorAlignment = 64;
+
+#ifdef PADDLE_WITH_CUDA
+// The size of each pinned chunk to copy the GPU tensors.
+constexpr size_t kMappedTensorChunkBytes = 16 << 20;
+#endif
+
+}  // namespace
+#endif
+
+struct MappedTensorFile::Impl {
+  std::string file_path;
+  bool zero_copy_cpu = false;
+  std::shared_ptr<void> mapping;
+  const char *data = nullptr;
+  size_t size = 0;
+  size_t offset = 0;
+#ifdef PADDLE_WITH_CUDA
+  std::vector<memory::AllocationPtr> chunks;
+  std::vector<cudaEvent_t> chunk_events;
+  size_t next_chunk = 0;
+#endif
+
+  const char *Take(size_t bytes) {
+    PADDLE_ENFORCE_LE(
+        bytes,
+        size - offset,
+        common::errors::Unavailable(
+            "The file %s ends unexpectedly, please check whether the model "
+            "file is complete or damaged.",
+            file_path));
+    const char *ptr = data + offset;
+    offset += bytes;
+    return ptr;
+  }
+
+  template <typename T>
+  T TakeValue() {
+    T value;
+    std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+#ifdef PADDLE_WITH_CUDA
+  // Copy through the pinned chunks in turn. A chunk is refilled once its
+  // last copy is done, while the copy of the other one goes on.
+  void CopyToGPU(const char *src,
+                 char *dst,
+                 size_t bytes,
+                 const phi::GPUContext &dev_ctx) {
+    if (chunks.empty()) {
+      for (int i = 0; i < 2; ++i) {
+        chunks.emplace_back(
+            memory::Alloc(phi::GPUPinnedPlace(), kMappedTensorChunkBytes));
+        cudaEvent_t event;
+        PADDLE_ENFORCE_GPU_SUCCESS(
+            cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+        chunk_events.push_back(event);
+      }
+    }
+    for (size_t done = 0; done < bytes; done += kMappedTensorChunkBytes) {
+      const size_t chunk_bytes =
+          std::min(kMappedTensorChunkBytes, bytes - done);
+      const size_t i = next_chunk;
+      next_chunk = 1 - next_chunk;
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaEventSynchronize(chunk_events[i]));
+      std::memcpy(chunks[i]->ptr(), src + done, chunk_bytes);
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyAsync(dst + done,
+                                                 chunks[i]->ptr(),
+                                                 chunk_bytes,
+                                                 cudaMemcpyHostToDevice,
+                                                 dev_ctx.stream()));
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaEventRecord(chunk_events[i], dev_ctx.stream()));
+    }
+  }
+#endif
+};
+
+MappedTensorFile::MappedTensorFile(const std::string &file_path,
+                                   bool zero_copy_cpu)
+    : impl_(std::make_unique<Impl>()) {
+#ifndef _WIN32
+  impl_->file_path = file_path;
+  impl_->zero_copy_cpu = zero_copy_cpu;
+  int fd = open(file_path.c_str(), O_RDONLY);
+  PADDLE_ENFORCE_NE(fd,
+                    -1,
+                    common::errors::Unavailable(
+                        "Failed to open %s, please check whether the model "
+                        "file is complete or damaged.",
+                        file_path));
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    PADDLE_THROW(common::errors::Unavailable("Failed to get the size of %s.",
+                                             file_path));
+  }
+  impl_->size = static_cast<size_t>(file_stat.st_size);
+  if (impl_->size > 0) {
+    // Private and writable, so that the tensors pointing to the mapping may
+    // be modified in place without writing to the file.
+    void *ptr = mmap(nullptr,
+                     impl_->size,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE,
+                     fd,
+                     0);
+    close(fd);
+    PADDLE_ENFORCE_NE(
+        ptr,
+        MAP_FAILED,
+        common::errors::Unavailable("Failed to mmap %s.", file_path));
+    madvise(ptr, impl_->size, MADV_SEQUENTIAL);
+    size_t size = impl_->size;
+    impl_->mapping =
+        std::shared_ptr<void>(ptr, [size](void *p) { munmap(p, size); });
+    impl_->data = static_cast<const char *>(ptr);
+  } else {
+    close(fd);
+  }
+#else
+  PADDLE_THROW(common::errors::Unimplemented(
+      "MappedTensorFile is not supported on Windows."));
+#endif
+}
+
+MappedTensorFile::~MappedTensorFile() {
+#ifdef PADDLE_WITH_CUDA
+  for (auto event : impl_->chunk_events) {
+    PADDLE_WARN_GPU_SUCCESS(cudaEventSynchronize(event));
+    PADDLE_WARN_GPU_SUCCESS(cudaEventDestroy(event));
+  }
+#endif
+}
+
+bool MappedTensorFile::AtEnd() const {
+  return impl_->offset == impl_->size;
+}
+
+void MappedTensorFile::Next(phi::DenseTensor *tensor,
+                            const phi::DeviceContext &dev_ctx) {
+  {
+    // the 1st field, unit32_t version for DenseTensor
+    auto version = impl_->TakeValue<uint32_t>();
+    PADDLE_ENFORCE_EQ(
+        version,
+        0U,
+        common::errors::InvalidArgument(
+            "Deserialize to tensor failed, maybe the loaded file is "
+            "not a paddle model(expected file format: 0, but %u found).",
+            version));
+  }
+  {
+    // the 2st field, LoD information
+    auto lod_level = impl_->TakeValue<uint64_t>();
+    auto &lod = *tensor->mutable_lod();
+    lod.resize(lod_level);
+    for (uint64_t i = 0; i < lod_level; ++i) {
+      auto size = impl_->TakeValue<uint64_t>();
+      std::vector<size_t> tmp(size / sizeof(size_t));
+      std::memcpy(tmp.data(), impl_->Take(size), size);
+      lod[i] = tmp;
+    }
+  }
+  // the 3st field, Tensor
+  auto version = impl_->TakeValue<uint32_t>();
+  PADDLE_ENFORCE_EQ(
+      version,
+      0U,
+      common::errors::InvalidArgument(
+          "tensor version %u is not supported, Only version 0 is supported",
+          version));
+  proto::VarType::TensorDesc desc;
+  auto desc_size = impl_->TakeValue<int32_t>();
+  PADDLE_ENFORCE_GE(desc_size,
+                    0,
+                    common::errors::InvalidArgument(
+                        "phi::DenseTensor desc size should >= 0"));
+  PADDLE_ENFORCE_EQ(
+      desc.ParseFromArray(impl_->Take(desc_size), desc_size),
+      true,
+      common::errors::InvalidArgument("Cannot parse tensor desc"));
+
+  std::vector<int64_t> dims(desc.dims().begin(), desc.dims().end());
+  auto dtype = TransToPhiDataType(desc.data_type());
+  tensor->Resize(common::make_ddim(dims));
+  const size_t bytes = tensor->numel() * SizeOfType(desc.data_type());
+  const char *src = impl_->Take(bytes);
+
+  const auto &place = dev_ctx.GetPlace();
+  if (phi::is_cpu_place(place)) {
+#ifndef _WIN32
+    if (impl_->zero_copy_cpu && bytes > 0 &&
+        reinterpret_cast<uintptr_t>(src) % kMappedTensorAlignment == 0) {
+      auto holder = std::make_shared<MappedFileAllocation>(
+          const_cast<char *>(src), bytes, impl_->mapping);
+      tensor->ResetHolderWithType(holder, dtype);
+      return;
+    }
+#endif
+    void *dst = dev_ctx.Alloc(tensor, dtype);
+    std::memcpy(dst, src, bytes);
+#ifdef PADDLE_WITH_CUDA
+  } else if (phi::is_gpu_place(place)) {
+    auto *dst = static_cast<char *>(dev_ctx.Alloc(tensor, dtype));
+    impl_->CopyToGPU(
+        src, dst, bytes, static_cast<const phi::GPUContext &>(dev_ctx));
+#endif
+  } else {
+    phi::DenseTensor cpu_tensor;
+    cpu_tensor.Resize(common::make_ddim(dims));
+    void *buf = cpu_tensor.mutable_data(phi::CPUPlace(), dtype);
+    std::memcpy(buf, src, bytes);
+    TensorCopySync(cpu_tensor, place, tensor);
+  }
+}
+
+bool UseMappedTensorFile() {
+#ifndef _WIN32
+  return FLAGS_load_params_with_mmap;
+#else
+  return false;
+#endif
+}
+
 LoD ConvertToOffsetBasedLoD(const LoD &length_lod) {
   LoD offset_lod;
   offset_lod.reserve(length_lod.size());
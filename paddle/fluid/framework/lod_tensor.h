@@ -190,5 +190,38 @@ void SerializeToStream(std::ostream& os, const phi::DenseTensor& tensor);
 
 void DeserializeFromStream(std::istream& os, phi::DenseTensor* tensor);
 
+/*
+ * Read the tensors saved one after another by SerializeToStream, such as
+ * the combined parameters of a model, from the memory mapped file instead
+ * of a stream. The tensor data is copied from the mapping to its place
+ * without a host copy of the whole file. GPU tensors are copied through
+ * two pinned chunks in turn, so that reading one chunk from the file
+ * overlaps with the copy of the other one to the device.
+ *
+ * With zero_copy_cpu, the CPU tensors whose data is aligned in the file
+ * point to the mapping, whose pages are read when they are first used.
+ * Not supported on Windows.
+ */
+class TEST_API MappedTensorFile {
+ public:
+  explicit MappedTensorFile(const std::string& file_path,
+                            bool zero_copy_cpu = false);
+  ~MappedTensorFile();
+
+  // Whether all the tensors in the file are read.
+  bool AtEnd() const;
+
+  // Read the next tensor to the place of dev_ctx.
+  void Next(phi::DenseTensor* tensor, const phi::DeviceContext& dev_ctx);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+// Whether the combined parameters are read by MappedTensorFile, as set by
+// FLAGS_load_params_with_mmap.
+TEST_API bool UseMappedTensorFile();
+
 }  // namespace framework
 }  // namespace paddle
@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "paddle/fluid/framework/executor_gc_helper.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/framework/variable_helper.h"
@@ -98,7 +99,8 @@ void NaiveExecutor::Run() {
 #ifdef PADDLE_WITH_NVTX
   platform::CudaNvtxRangePush("model", platform::NvtxRangeColor::Yellow);
 #endif
-  for (auto &op : ops_) {
+  for (size_t op_idx = 0; op_idx < ops_.size(); ++op_idx) {
+    auto &op = ops_[op_idx];
     VLOG(4) << std::this_thread::get_id() << " run "
             << op->DebugStringEx(scope_) << " on scope " << scope_;
     op->SetIsCalledByExecutor(false);
@@ -150,6 +152,16 @@ void NaiveExecutor::Run() {
     for (auto &func : output_hookfuncs_) {
       func(op.get(), scope_);
     }
+
+    if (!gc_plan_.empty()) {
+      for (auto *var : gc_plan_[op_idx]) {
+        if (var->IsType<phi::DenseTensor>()) {
+          var->GetMutable<phi::DenseTensor>()->MoveMemoryHolder();
+        } else if (var->IsType<phi::TensorArray>()) {
+          var->GetMutable<phi::TensorArray>()->clear();
+        }
+      }
+    }
   }
 #ifdef PADDLE_WITH_NVTX
   platform::CudaNvtxRangePop();
@@ -291,6 +303,36 @@ void NaiveExecutor::MakeReusePlan(
   }
 }
 
+void NaiveExecutor::MakeGarbageCollectPlan(
+    const BlockDesc &block, const std::vector<std::string> &skip_vars) {
+  gc_plan_.clear();
+  for (auto &op : ops_) {
+    if (op->HasAttr("sub_block")) {
+      VLOG(3) << "Skip the garbage collect plan for the " << op->Type()
+              << " op with a sub-block.";
+      return;
+    }
+  }
+  auto unused_vars = GetUnusedVars(block, ops_, skip_vars);
+  gc_plan_.resize(ops_.size());
+  size_t num_vars = 0;
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    auto iter = unused_vars.find(ops_[i].get());
+    if (iter == unused_vars.end()) {
+      continue;
+    }
+    for (auto &name : iter->second) {
+      auto *var = scope_->FindVar(name);
+      if (var != nullptr) {
+        gc_plan_[i].push_back(var);
+        ++num_vars;
+      }
+    }
+  }
+  VLOG(3) << "NaiveExecutor releases " << num_vars << " vars after "
+          << ops_.size() << " ops.";
+}
+
 NaiveExecutor::~NaiveExecutor() {
 #ifdef PADDLE_WITH_DNNL
   // Clear mkl-dnn cache,
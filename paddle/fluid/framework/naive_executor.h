@@ -93,6 +93,12 @@ class NaiveExecutor {
   void MakeReusePlan(
       const std::unordered_map<std::string, std::string>& reuse_table);
 
+  // Plan the release of the temporary variables of the block right after the
+  // ops which use them last, except for skip_vars, e.g. the feeds and the
+  // fetches. Not planned if an op of the block has a sub-block.
+  void MakeGarbageCollectPlan(const BlockDesc& block,
+                              const std::vector<std::string>& skip_vars);
+
   void ResetTrtOps(int num);
 
   void RegisterOutputHook(const HookFunc& hookfunc);
@@ -120,6 +126,9 @@ class NaiveExecutor {
       reuse_cache_;
   std::vector<phi::DenseTensor*> cluster_buffer_;
 
+  // The variables released after each op, in the order of ops_.
+  std::vector<std::vector<Variable*>> gc_plan_;
+
   std::unique_ptr<framework::InterpreterCore> interpreter_core_;
 };
 
@@ -0,0 +1,231 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "paddle/fluid/framework/new_executor/garbage_collector/async_garbage_collector.h"
+
+#if !defined(_WIN32)
+#include <sched.h>
+#else
+#define NOMINMAX
+#include <windows.h>
+#endif  // !_WIN32
+
+#include "paddle/phi/core/memory/allocation/memory_pressure.h"
+
+namespace paddle::framework {
+
+using memory::allocation::MemoryPressureNotifier;
+
+InterpreterCoreAsyncGarbageCollector::InterpreterCoreAsyncGarbageCollector(
+    const std::vector<Instruction>& vec_instruction)
+    : queue_(nullptr), gc_event_(), streams_() {
+  for (auto& instruct : vec_instruction) {
+    gc_event_.emplace_back(instruct.DeviceContext().GetPlace(),
+                           platform::GenerateDeviceEventFlag());
+  }
+  Init();
+}
+
+InterpreterCoreAsyncGarbageCollector::InterpreterCoreAsyncGarbageCollector(
+    const std::vector<std::unique_ptr<InstructionBase>>& vec_instruction)
+    : queue_(nullptr), gc_event_(), streams_() {
+  for (auto& instruct : vec_instruction) {
+    gc_event_.emplace_back(instruct->DeviceContext().GetPlace(),
+                           platform::GenerateDeviceEventFlag());
+  }
+  Init();
+}
+
+void InterpreterCoreAsyncGarbageCollector::Init() {
+  WorkQueueOptions options(/*name*/ "AsyncGarbageCollector",
+                           /*num_threads*/ 1,
+                           /*allow_spinning*/ true,
+                           /*track_task*/ false);
+  queue_ = CreateSingleThreadedWorkQueue(options);
+  batch_size_ =
+      static_cast<int64_t>(FLAGS_new_executor_async_gc_batch_mb * (1 << 20));
+  pressure_callback_id_ =
+      MemoryPressureNotifier::Instance().Register([this]() { Flush(); });
+}
+
+InterpreterCoreAsyncGarbageCollector::
+    ~InterpreterCoreAsyncGarbageCollector() {  // NOLINT
+  MemoryPressureNotifier::Instance().Unregister(pressure_callback_id_);
+  {  // lock guard
+    std::lock_guard<memory::SpinLock> guard(spinlock_);
+    FreeAllGarbages();
+  }
+  // The queue runs out of its tasks before its threads exit.
+  queue_.reset(nullptr);
+}
+
+void InterpreterCoreAsyncGarbageCollector::Add(Variable* var,
+                                               const Instruction& instr) {
+  PADDLE_ENFORCE_LT(instr.Id(),
+                    gc_event_.size(),
+                    common::errors::OutOfRange(
+                        "The index should be less than the size of gc event "
+                        ", but got index is %d and size is %d",
+                        instr.Id(),
+                        gc_event_.size()));
+  Add(var, &gc_event_.at(instr.Id()), &instr.DeviceContext());
+  if (instr.EventToRecord()) {
+    std::lock_guard<memory::SpinLock> guard(spinlock_);
+    FreeStreamGarbages(&instr.DeviceContext(),
+                       &streams_[&instr.DeviceContext()]);
+  }
+}
+
+void InterpreterCoreAsyncGarbageCollector::Add(Variable* var,
+                                               const InstructionBase* instr) {
+  PADDLE_ENFORCE_LT(instr->Id(),
+                    gc_event_.size(),
+                    common::errors::OutOfRange(
+                        "The index should be less than the size of gc event "
+                        ", but got index is %d and size is %d",
+                        instr->Id(),
+                        gc_event_.size()));
+  Add(var, &gc_event_.at(instr->Id()), &instr->DeviceContext());
+  // The stream synchronizes with other streams here, free its garbages
+  // together with the event.
+  if (instr->EventToRecord()) {
+    std::lock_guard<memory::SpinLock> guard(spinlock_);
+    FreeStreamGarbages(&instr->DeviceContext(),
+                       &streams_[&instr->DeviceContext()]);
+  }
+}
+
+void InterpreterCoreAsyncGarbageCollector::Add(Variable* var,
+                                               platform::DeviceEvent* event,
+                                               const phi::DeviceContext* ctx) {
+  if (UNLIKELY(max_memory_size_ < 0) || var == nullptr) {
+    return;
+  }
+
+  if (var->IsType<phi::DenseTensor>()) {
+    Add(var->GetMutable<phi::DenseTensor>()->MoveMemoryHolder(), event, ctx);
+  } else if (
+      var->IsType<
+          operators::reader::
+              OrderedMultiDeviceLoDTensorBlockingQueueHolder>()) {  // NOLINT
+    // TODO(xiongkun03) in old executor, this type of variable is not support
+    // eager deletion. so we just leave it here ?
+  } else if (var->IsType<LoDRankTable>()) {
+    // TODO(xiongkun03) in old executor, this type of variable is not support
+    // eager deletion. so we just leave it here ?
+  } else if (var->IsType<phi::SelectedRows>()) {
+    Add(var->GetMutable<phi::SelectedRows>()
+            ->mutable_value()
+            ->MoveMemoryHolder(),
+        event,
+        ctx);
+    var->GetMutable<phi::SelectedRows>()->mutable_rows()->clear();
+  } else if (var->IsType<phi::SparseCooTensor>()) {
+    Add(var->GetMutable<phi::SparseCooTensor>()
+            ->mutable_values()
+            ->MoveMemoryHolder(),
+        event,
+        ctx);
+    Add(var->GetMutable<phi::SparseCooTensor>()
+            ->mutable_indices()
+            ->MoveMemoryHolder(),
+        event,
+        ctx);
+  } else if (var->IsType<phi::SparseCsrTensor>()) {
+    Add(var->GetMutable<phi::SparseCsrTensor>()
+            ->mutable_crows()
+            ->MoveMemoryHolder(),
+        event,
+        ctx);
+    Add(var->GetMutable<phi::SparseCsrTensor>()
+            ->mutable_cols()
+            ->MoveMemoryHolder(),
+        event,
+        ctx);
+    Add(var->GetMutable<phi::SparseCsrTensor>()
+            ->mutable_values()
+            ->MoveMemoryHolder(),
+        event,
+        ctx);
+  } else if (var->IsType<phi::TensorArray>()) {
+    auto* tensor_arr = var->GetMutable<phi::TensorArray>();
+    for (auto& t : *tensor_arr) {
+      Add(t.MoveMemoryHolder(), event, ctx);
+    }
+  } else if (var->IsType<std::vector<Scope*>>()) {
+    // NOTE(@xiongkun03) conditional_op / while_op will create a STEP_SCOPE
+    // refer to executor.cc to see what old garbage collector does.
+    // do nothing, because the sub scope will be deleted by sub-executor.
+  } else {
+    PADDLE_THROW(common::errors::Unimplemented(
+        "The variable(%s) is not supported in eager deletion.",
+        framework::ToTypeName(var->Type())));
+  }
+}
+
+void InterpreterCoreAsyncGarbageCollector::Add(Garbage garbage,
+                                               platform::DeviceEvent* event,
+                                               const phi::DeviceContext* ctx) {
+  if (!garbage) {
+    return;
+  }
+
+  std::lock_guard<memory::SpinLock> guard(spinlock_);
+  auto& stream = streams_[ctx];
+  stream.size += static_cast<int64_t>(garbage->size());
+  stream.garbages.push_back(std::move(garbage));
+  stream.event = event;
+  if (stream.size >= batch_size_) {
+    FreeStreamGarbages(ctx, &stream);
+  }
+}
+
+void InterpreterCoreAsyncGarbageCollector::FreeStreamGarbages(
+    const phi::DeviceContext* ctx, StreamGarbages* stream) {
+  if (stream->garbages.empty()) {
+    return;
+  }
+  stream->event->Record(ctx);
+  stream->event->SetFinished();  // Only for CPU Event
+  queue_->AddTask(
+      [container = std::move(stream->garbages), event = stream->event]() {
+        while (!event->Query()) {
+#if defined(_WIN32)
+          SleepEx(50, FALSE);
+#else
+          sched_yield();
+#endif
+          continue;
+        }
+      });
+  stream->garbages.clear();
+  stream->size = 0;
+}
+
+void InterpreterCoreAsyncGarbageCollector::FreeAllGarbages() {
+  for (auto& pair : streams_) {
+    FreeStreamGarbages(pair.first, &pair.second);
+  }
+}
+
+void InterpreterCoreAsyncGarbageCollector::Flush() {
+  {  // lock guard
+    std::lock_guard<memory::SpinLock> guard(spinlock_);
+    FreeAllGarbages();
+  }
+  // The queue runs its tasks in order, once this one runs all the garbages
+  // handed to it before are freed.
+  queue_->AddAwaitableTask([]() { return true; }).get();
+}
+
+}  // namespace paddle::framework
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <unordered_map>
+
+#include "paddle/fluid/framework/new_executor/garbage_collector/garbage_collector.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
+
+namespace paddle {
+namespace framework {
+
+/**
+ * InterpreterCoreAsyncGarbageCollector keeps the instruction that runs out
+ * of a var away from the allocator. The garbages are queued per stream, and
+ * a stream's queue is handed to a background thread, which waits for the
+ * stream and drops them, when its size exceeds the batch size or its
+ * instruction records an event for other streams. An allocation failing
+ * flushes all the queues and waits for them to be freed.
+ */
+class InterpreterCoreAsyncGarbageCollector
+    : public InterpreterCoreGarbageCollector {
+ public:
+  InterpreterCoreAsyncGarbageCollector(
+      const std::vector<Instruction>& vec_instruction);
+
+  InterpreterCoreAsyncGarbageCollector(
+      const std::vector<std::unique_ptr<InstructionBase>>& vec_instruction);
+
+  ~InterpreterCoreAsyncGarbageCollector();
+
+  void Add(Variable* var, const Instruction& instruction) override;
+
+  void Add(Variable* var, const InstructionBase* instruction) override;
+
+  // Hands all the queued garbages to the background thread and waits until
+  // they are freed.
+  void Flush();
+
+ private:
+  struct StreamGarbages {
+    GarbageQueue garbages;
+    int64_t size{0};
+    // the event of the last instruction adding garbages on the stream
+    platform::DeviceEvent* event{nullptr};
+  };
+
+  void Init();
+
+  void Add(Variable* var,
+           platform::DeviceEvent* event,
+           const phi::DeviceContext* ctx);
+  void Add(Garbage garbage,
+           platform::DeviceEvent* event,
+           const phi::DeviceContext* ctx);
+
+  // Must be called with spinlock_ held.
+  void FreeStreamGarbages(const phi::DeviceContext* ctx,
+                          StreamGarbages* stream);
+
+  void FreeAllGarbages();
+
+  std::unique_ptr<WorkQueue> queue_;
+  std::vector<paddle::platform::DeviceEvent> gc_event_;
+  std::unordered_map<const phi::DeviceContext*, StreamGarbages> streams_;
+  int64_t batch_size_{0};
+  int64_t pressure_callback_id_{-1};
+};
+
+}  // namespace framework
+}  // namespace paddle
@@ -14,6 +14,7 @@
 
 #include "paddle/fluid/framework/new_executor/garbage_collector/garbage_collector.h"
 #include "paddle/fluid/framework/garbage_collector.h"
+#include "paddle/fluid/framework/new_executor/garbage_collector/async_garbage_collector.h"
 #include "paddle/fluid/framework/new_executor/garbage_collector/event_garbage_collector.h"
 #include "paddle/fluid/framework/new_executor/garbage_collector/fast_garbage_collector.h"
 #include "paddle/fluid/framework/new_executor/garbage_collector/no_event_garbage_collector.h"
@@ -31,6 +32,11 @@ std::unique_ptr<InterpreterCoreGarbageCollector>
 CreateInterpreterCoreGarbageCollector(
     const phi::Place& place,
     const std::vector<std::unique_ptr<InstructionBase>>& vec_instruction) {
+  if (IsInterpretercoreAsyncGCEnabled() && !phi::is_xpu_place(place) &&
+      !phi::is_ipu_place(place)) {
+    return std::unique_ptr<InterpreterCoreGarbageCollector>(
+        new InterpreterCoreAsyncGarbageCollector(vec_instruction));
+  }
   if (phi::is_gpu_place(place)) {
     if (IsInterpretercoreFastGCEnabled()) {  // NOLINT
       return std::unique_ptr<InterpreterCoreGarbageCollector>(
@@ -60,6 +66,11 @@ CreateInterpreterCoreGarbageCollector(
 std::unique_ptr<InterpreterCoreGarbageCollector>
 CreateInterpreterCoreGarbageCollector(
     const phi::Place& place, const std::vector<Instruction>& vec_instruction) {
+  if (IsInterpretercoreAsyncGCEnabled() && !phi::is_xpu_place(place) &&
+      !phi::is_ipu_place(place)) {
+    return std::unique_ptr<InterpreterCoreGarbageCollector>(
+        new InterpreterCoreAsyncGarbageCollector(vec_instruction));
+  }
   if (phi::is_gpu_place(place)) {
     if (IsInterpretercoreFastGCEnabled()) {  // NOLINT
       return std::unique_ptr<InterpreterCoreGarbageCollector>(
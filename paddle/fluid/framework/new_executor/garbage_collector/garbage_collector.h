@@ -24,6 +24,7 @@
 
 COMMON_DECLARE_bool(fast_eager_deletion_mode);
 COMMON_DECLARE_bool(new_executor_use_cuda_graph);
+COMMON_DECLARE_double(new_executor_async_gc_batch_mb);
 
 namespace paddle {
 namespace framework {
@@ -78,6 +79,13 @@ inline bool IsInterpretercoreFastGCEnabled() {
          FLAGS_new_executor_use_cuda_graph;
 }
 
+inline bool IsInterpretercoreAsyncGCEnabled() {
+  // The background thread queries the events, which cannot be used in cuda
+  // graph either.
+  return FLAGS_new_executor_async_gc_batch_mb > 0 &&
+         !FLAGS_new_executor_use_cuda_graph;
+}
+
 std::unique_ptr<InterpreterCoreGarbageCollector>
 CreateInterpreterCoreGarbageCollector(
     const phi::Place& place, const std::vector<Instruction>& vec_instruction);
@@ -16,10 +16,17 @@
 
 #include "paddle/cinn/hlir/dialect/runtime/ir/jit_kernel_op.h"
 #include "paddle/cinn/hlir/dialect/runtime/ir/runtime_dialect.h"
+#include "paddle/cinn/hlir/framework/async_compilation.h"
 #include "paddle/cinn/hlir/framework/pir_compiler.h"
 #include "paddle/common/errors.h"
 #include "paddle/common/performance_statistician.h"
+#include "paddle/fluid/framework/new_executor/instruction/temp_space_scratch.h"
+#include "paddle/fluid/framework/new_executor/interpreter/stream_analyzer.h"
 #include "paddle/fluid/framework/new_executor/pir_adaptor/pir_adaptor_util.h"
+#include "paddle/fluid/framework/new_executor/pir_interpreter.h"
+#include "paddle/fluid/framework/scope.h"
+#include "paddle/fluid/pir/transforms/pd_op_to_kernel_pass.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
 #if defined(PADDLE_WITH_CUDA)
 #include "paddle/cinn/runtime/cinn_runtime.h"
 #endif
@@ -200,7 +207,7 @@ CinnJitInstruction::CinnJitInstruction(
     const ValueExecutionInfo* value_exec_info)
     : InstructionBase(id, place) {
   auto jit_kernel_op = op->dyn_cast<cinn::dialect::JitKernelOp>();
-  fn_ptr_impl_ = std::make_shared<FnPtrImpl>(jit_kernel_op.cinn_kernel_info());
+  async_kernel_ = jit_kernel_op.cinn_kernel_info().async_kernel;
   op_ = op;
   input_tensor_size = op->num_operands();
   output_tensor_size = op->num_results();
@@ -226,7 +233,26 @@ CinnJitInstruction::CinnJitInstruction(
                  .dyn_cast<paddle::dialect::PlaceAttribute>()
                  .data();
   }
+  if (op->HasAttribute("execution_stream")) {
+    SetExecutionStream(op->attribute("execution_stream")
+                           .dyn_cast<pir::StrAttribute>()
+                           .AsString());
+  }
+  if (op->HasAttribute("stream_priority")) {
+    SetStreamPriority(op->attribute("stream_priority")
+                          .dyn_cast<pir::Int32Attribute>()
+                          .data());
+  }
   dev_ctx_ = phi::DeviceContextPool::Instance().Get(place_);
+  if (phi::is_gpu_place(place_) && GetExecutionStream() != kDefaultStream) {
+    dev_ctx_ = interpreter::ContextManager::Instance()
+                   .Get(std::string(kCustomStream) + "-" + GetExecutionStream(),
+                        place_,
+                        GetStreamPriority())
+                   .get()
+                   .get();
+  }
+  SetDeviceContext(dev_ctx_);
 
   // prepare output tensors
   for (size_t i = 0; i < op->num_results(); ++i) {
@@ -251,8 +277,21 @@ CinnJitInstruction::CinnJitInstruction(
     tensor->Resize(alloc_tensor_type.dims());
   }
 
+  if (async_kernel_ == nullptr) {
+    PrepareKernel(jit_kernel_op.cinn_kernel_info());
+  } else if (async_kernel_->IsReady()) {
+    PrepareKernel(async_kernel_->GetKernelInfo());
+  }
+}
+
+CinnJitInstruction::~CinnJitInstruction() = default;
+
+void CinnJitInstruction::PrepareKernel(
+    const cinn::hlir::framework::pir::CINNKernelInfo& kernel_info) {
+  fn_ptr_impl_ = std::make_shared<FnPtrImpl>(kernel_info);
+
   // prepare temp_space tensors
-  for (int64_t size : jit_kernel_op.cinn_kernel_info().temp_space_sizes) {
+  for (int64_t size : kernel_info.temp_space_sizes) {
     auto& tensor = temp_space_tensors_.emplace_back();
     tensor.set_type(phi::DataType::UINT8);
     tensor.Resize({size});
@@ -266,7 +305,98 @@ CinnJitInstruction::CinnJitInstruction(
   output_tensor_size += temp_space_tensors_.size();
 }
 
+std::unique_lock<std::mutex> CinnJitInstruction::BindTempSpaces(void* stream) {
+  if (temp_space_scratch_ == nullptr || temp_space_stream_ != stream) {
+    temp_space_scratch_ = TempSpaceScratch::Get(place_, stream);
+    temp_space_stream_ = stream;
+  }
+  std::unique_lock<std::mutex> guard(temp_space_scratch_->mutex());
+  constexpr int64_t kAlignment = 256;
+  std::vector<int64_t> offsets;
+  int64_t total_size = 0;
+  for (auto& tensor : temp_space_tensors_) {
+    offsets.push_back(total_size);
+    total_size += (tensor.numel() + kAlignment - 1) / kAlignment * kAlignment;
+  }
+  uint8_t* base = temp_space_scratch_->Reserve(total_size);
+  for (size_t i = 0; i < temp_space_tensors_.size(); ++i) {
+    auto& tensor = temp_space_tensors_[i];
+    tensor.ResetHolder(std::make_shared<phi::Allocation>(
+        base + offsets[i], static_cast<size_t>(tensor.numel()), place_));
+  }
+  return guard;
+}
+
+void CinnJitInstruction::RunFallback() {
+  using cinn::hlir::framework::pir::AsyncCompiledKernel;
+  if (fallback_interpreter_ == nullptr) {
+    VLOG(4) << "Run the phi kernels of " << op_->id()
+            << " until its kernel is compiled";
+    fallback_program_ = paddle::dialect::PdOpLowerToKernelPass(
+        async_kernel_->FallbackProgram().get(), place_);
+    // The phi kernels run on the stream of the instruction, in order with the
+    // kernels before and after it, like the compiled kernel.
+    if (GetExecutionStream() != kDefaultStream) {
+      pir::IrContext* ctx = pir::IrContext::Instance();
+      for (auto& op : *fallback_program_->block()) {
+        op.set_attribute("execution_stream",
+                         pir::StrAttribute::get(ctx, GetExecutionStream()));
+        op.set_attribute("stream_priority",
+                         pir::Int32Attribute::get(ctx, GetStreamPriority()));
+      }
+    }
+    fallback_scope_ = std::make_unique<Scope>();
+    for (int32_t i = 0; i < input_tensor_size; ++i) {
+      fallback_scope_->Var(AsyncCompiledKernel::FallbackInputName(i))
+          ->GetMutable<phi::DenseTensor>();
+    }
+    interpreter::ExecutionConfig execution_config;
+    execution_config.create_local_scope = false;
+    for (size_t i = 0; i < op_->num_results(); ++i) {
+      execution_config.skip_gc_vars.insert(
+          AsyncCompiledKernel::FallbackOutputName(i));
+    }
+    fallback_interpreter_ =
+        std::make_unique<PirInterpreter>(place_,
+                                         std::vector<std::string>{},
+                                         fallback_program_->block(),
+                                         fallback_scope_.get(),
+                                         execution_config);
+  }
+
+  for (int32_t i = 0; i < input_tensor_size; ++i) {
+    fallback_scope_->FindVar(AsyncCompiledKernel::FallbackInputName(i))
+        ->GetMutable<phi::DenseTensor>()
+        ->ShareDataWith(*tensor_args_[i]);
+  }
+  fallback_interpreter_->Run({}, /*need_fetch=*/false);
+  for (size_t i = 0; i < op_->num_results(); ++i) {
+    auto* var =
+        fallback_scope_->FindVar(AsyncCompiledKernel::FallbackOutputName(i));
+    PADDLE_ENFORCE_NOT_NULL(
+        var,
+        common::errors::NotFound("The fallback of %s does not output %s.",
+                                 Name(),
+                                 AsyncCompiledKernel::FallbackOutputName(i)));
+    tensor_args_[input_tensor_size + i]->ShareDataWith(
+        var->Get<phi::DenseTensor>());
+  }
+}
+
 void CinnJitInstruction::Run() {
+  if (fn_ptr_impl_ == nullptr) {
+    // The compiled kernel is swapped in by the first run after it is ready.
+    if (async_kernel_->IsReady()) {
+      VLOG(4) << "Swap in the compiled kernel of " << op_->id();
+      PrepareKernel(async_kernel_->GetKernelInfo());
+      fallback_interpreter_.reset();
+      fallback_scope_.reset();
+      fallback_program_.reset();
+    } else {
+      RunFallback();
+      return;
+    }
+  }
 #if defined(PADDLE_WITH_CUDA)
   void* running_stream = nullptr;
   bool is_gpu = false;
@@ -284,7 +414,14 @@ void CinnJitInstruction::Run() {
     fn_ptr_impl_->InferShape(
         tensor_args_, input_tensor_size, output_tensor_size);
   }
-  for (size_t i = 0; i < tensor_args_.size(); ++i) {
+  // the temporary spaces are the last arguments
+  size_t num_allocated_args = tensor_args_.size();
+  std::unique_lock<std::mutex> temp_space_guard;
+  if (is_gpu && !temp_space_tensors_.empty()) {
+    temp_space_guard = BindTempSpaces(running_stream);
+    num_allocated_args -= temp_space_tensors_.size();
+  }
+  for (size_t i = 0; i < num_allocated_args; ++i) {
     dev_ctx_->Alloc(tensor_args_[i], tensor_args_[i]->dtype());
   }
 
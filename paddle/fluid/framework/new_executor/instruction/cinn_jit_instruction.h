@@ -15,15 +15,24 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
 
 namespace pir {
 class Operation;
+class Program;
 }
 
+namespace cinn::hlir::framework::pir {
+class AsyncCompiledKernel;
+struct CINNKernelInfo;
+}  // namespace cinn::hlir::framework::pir
+
 namespace paddle {
 namespace framework {
+class PirInterpreter;
 class Scope;
+class TempSpaceScratch;
 
 class CinnJitInstruction : public InstructionBase {
  public:
@@ -34,6 +43,8 @@ class CinnJitInstruction : public InstructionBase {
 
   // TODO(Aurelius84): Only implement core interface and need implement GC and
   // Event logic.
+  ~CinnJitInstruction();
+
   void Run() override;
 
   const std::string& Name() const override;
@@ -43,8 +54,25 @@ class CinnJitInstruction : public InstructionBase {
  private:
   class FnPtrImpl;
 
+  void PrepareKernel(
+      const cinn::hlir::framework::pir::CINNKernelInfo& kernel_info);
+
+  // Runs the ops of the group with phi kernels while the kernel is compiled
+  // in background.
+  void RunFallback();
+
+  // Points the temporary space tensors into the scratch of the stream, which
+  // is held until the kernel is launched.
+  std::unique_lock<std::mutex> BindTempSpaces(void* stream);
+
   std::shared_ptr<FnPtrImpl> fn_ptr_impl_{nullptr};
 
+  std::shared_ptr<cinn::hlir::framework::pir::AsyncCompiledKernel>
+      async_kernel_{nullptr};
+  std::unique_ptr<::pir::Program> fallback_program_{nullptr};
+  std::unique_ptr<Scope> fallback_scope_{nullptr};
+  std::unique_ptr<PirInterpreter> fallback_interpreter_{nullptr};
+
   phi::Place place_;
 
   phi::DeviceContext* dev_ctx_;
@@ -58,6 +86,8 @@ class CinnJitInstruction : public InstructionBase {
   // Tensors that hold the temporary spaces used by the kernel. These tensors
   // are managed by CinnJitInstruction, and not exposed to phi executor.
   std::vector<phi::DenseTensor> temp_space_tensors_;
+  std::shared_ptr<TempSpaceScratch> temp_space_scratch_{nullptr};
+  void* temp_space_stream_{nullptr};
 
   ::pir::Operation* op_{nullptr};  // not owned
 };
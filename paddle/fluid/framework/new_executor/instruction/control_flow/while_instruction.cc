@@ -170,11 +170,21 @@ void WhileInstruction::ShareInputsToOutputs() {
   }
 }
 
-void WhileInstruction::ShareOutputsToBlockArgs() {
+void WhileInstruction::PrepareBodyVars() {
+  if (inner_cond_var_ != nullptr) {
+    return;
+  }
+  // The vars of the body are looked up by name once, not in each iteration.
   for (size_t i = 0; i < body_block_->args_size(); ++i) {
-    auto block_arg = body_block_->arg(i);
-    auto var_name = body_inter_->GetNameByValue(block_arg);
-    auto* inner_var = body_inter_->local_scope()->GetVar(var_name);
+    auto var_name = body_inter_->GetNameByValue(body_block_->arg(i));
+    block_arg_vars_.push_back(body_inter_->local_scope()->GetVar(var_name));
+  }
+  inner_cond_var_ = body_inter_->local_scope()->GetVar(inner_cond_);
+}
+
+void WhileInstruction::ShareOutputsToBlockArgs() {
+  for (size_t i = 0; i < block_arg_vars_.size(); ++i) {
+    auto* inner_var = block_arg_vars_[i];
 
     if (outputs_[i]->IsType<phi::DenseTensor>()) {
       inner_var->GetMutable<phi::DenseTensor>()->ShareDataWith(
@@ -193,9 +203,8 @@ void WhileInstruction::ShareOutputsToBlockArgs() {
 }
 
 void WhileInstruction::ShareConditionData() {
-  auto inner_cond_var = body_inter_->local_scope()->GetVar(inner_cond_);
   cond_var_->GetMutable<phi::DenseTensor>()->ShareDataWith(
-      inner_cond_var->Get<phi::DenseTensor>());
+      inner_cond_var_->Get<phi::DenseTensor>());
 }
 
 void WhileInstruction::SetOutputHooks(
@@ -220,6 +229,7 @@ void WhileInstruction::Run() {
   paddle::platform::DontClearMKLDNNCache(body_inter_->GetPlace());
 #endif
   ShareInputsToOutputs();
+  PrepareBodyVars();
 
   if (check_gc_early_) {
     check_gc_early_(this);
@@ -67,6 +67,9 @@ class WhileInstruction : public InstructionBase {
   // 'output' = 'input'
   void ShareInputsToOutputs();
 
+  // Find the vars of the block args and of the condition in the body scope.
+  void PrepareBodyVars();
+
   // Pass argument to body_block for execution.
   void ShareOutputsToBlockArgs();
 
@@ -77,6 +80,8 @@ class WhileInstruction : public InstructionBase {
 
   Variable* cond_var_;
   std::string inner_cond_;
+  Variable* inner_cond_var_{nullptr};
+  std::vector<Variable*> block_arg_vars_;
 
   std::vector<Variable*> inputs_;
   std::vector<Variable*> outputs_;
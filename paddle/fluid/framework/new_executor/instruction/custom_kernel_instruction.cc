@@ -469,31 +469,42 @@ void CustomKernelInstruction::UpdateOutputMeta(
   }
 }
 
+// Overwrites the shapes and dtypes of the last run in place, so that the
+// vectors keep their capacity and a run on inputs of the same ranks does not
+// allocate them again.
 void CustomKernelInstruction::BuildShapeDtype() {
-  input_shapes_.clear();
-  input_dtypes_.clear();
-  vec_input_shapes_.clear();
-  vec_input_dtypes_.clear();
-  for (auto in_tensor : input_ptrs_) {
+  // as phi::vectorize
+  auto assign_shape = [](const phi::DDim& dims, std::vector<int64_t>* shape) {
+    if (dims.size() == -1) {
+      shape->assign(1, 0);
+    } else {
+      shape->assign(dims.Get(), dims.Get() + dims.size());
+    }
+  };
+  input_shapes_.resize(input_ptrs_.size());
+  input_dtypes_.resize(input_ptrs_.size());
+  for (size_t i = 0; i < input_ptrs_.size(); ++i) {
+    auto in_tensor = input_ptrs_[i];
     if (in_tensor) {
-      input_shapes_.push_back(phi::vectorize(in_tensor->dims()));
-      input_dtypes_.push_back(in_tensor->dtype());
+      assign_shape(in_tensor->dims(), &input_shapes_[i]);
+      input_dtypes_[i] = in_tensor->dtype();
     } else {
-      input_shapes_.emplace_back();
-      input_dtypes_.emplace_back();
+      input_shapes_[i].clear();
+      input_dtypes_[i] = phi::DataType();
     }
   }
-  for (auto in_tensors : vec_input_ptrs_) {
-    std::vector<std::vector<int64_t>> input_shapes;
-    std::vector<phi::DataType> input_dtypes;
-    if (in_tensors.size() > 0) {
-      for (auto in_tensor : in_tensors) {
-        input_shapes.push_back(phi::vectorize(in_tensor->dims()));
-        input_dtypes.push_back(in_tensor->dtype());
-      }
+  vec_input_shapes_.resize(vec_input_ptrs_.size());
+  vec_input_dtypes_.resize(vec_input_ptrs_.size());
+  for (size_t i = 0; i < vec_input_ptrs_.size(); ++i) {
+    const auto& in_tensors = vec_input_ptrs_[i];
+    auto& input_shapes = vec_input_shapes_[i];
+    auto& input_dtypes = vec_input_dtypes_[i];
+    input_shapes.resize(in_tensors.size());
+    input_dtypes.resize(in_tensors.size());
+    for (size_t j = 0; j < in_tensors.size(); ++j) {
+      assign_shape(in_tensors[j]->dims(), &input_shapes[j]);
+      input_dtypes[j] = in_tensors[j]->dtype();
     }
-    vec_input_shapes_.push_back(input_shapes);
-    vec_input_dtypes_.push_back(input_dtypes);
   }
 }
 
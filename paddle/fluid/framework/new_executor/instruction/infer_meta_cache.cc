@@ -0,0 +1,129 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "paddle/fluid/framework/new_executor/instruction/infer_meta_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace paddle::framework {
+
+std::atomic<uint64_t> InferMetaCache::global_hits_{0};
+std::atomic<uint64_t> InferMetaCache::global_misses_{0};
+
+bool InferMetaCache::IsCacheable(const phi::InferMetaContext& ctx) {
+  for (size_t i = 0; i < ctx.AttrsSize(); ++i) {
+    const phi::Attribute& attr = ctx.AttrAt(i);
+    if (paddle::holds_alternative<phi::TensorRef>(attr) ||
+        paddle::holds_alternative<std::vector<phi::TensorRef>>(attr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool InferMetaCache::BuildKey(phi::InferMetaContext* ctx) {
+  key_.clear();
+  for (size_t i = 0; i < ctx->InputsSize(); ++i) {
+    const phi::MetaTensor& input = ctx->InputAt(i);
+    if (!input.initialized()) {
+      // an optional input not given
+      key_.push_back(-1);
+      continue;
+    }
+    // InferMeta may share the LoD of an input with the outputs, which a hit
+    // would skip, so the inputs with a LoD bypass the cache.
+    if (!input.is_dense() || input.has_lod()) {
+      return false;
+    }
+    phi::DDim dims = input.dims();
+    key_.push_back(static_cast<int64_t>(input.dtype()));
+    key_.push_back(static_cast<int64_t>(input.layout()));
+    key_.push_back(dims.size());
+    for (int d = 0; d < dims.size(); ++d) {
+      key_.push_back(dims[d]);
+    }
+  }
+  for (size_t i = 0; i < ctx->OutputsSize(); ++i) {
+    phi::MetaTensor* output = ctx->MutableOutputAt(i);
+    if (output != nullptr && !output->is_dense()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool InferMetaCache::Lookup(phi::InferMetaContext* ctx) {
+  key_valid_ = BuildKey(ctx);
+  if (!key_valid_) {
+    return false;
+  }
+  auto it = std::find_if(entries_.begin(),
+                         entries_.end(),
+                         [this](const Entry& e) { return e.key == key_; });
+  if (it == entries_.end()) {
+    ++stats_.misses;
+    global_misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  for (size_t i = 0; i < it->outputs.size(); ++i) {
+    const OutputMeta& meta = it->outputs[i];
+    phi::MetaTensor* output = ctx->MutableOutputAt(i);
+    if (!meta.present || output == nullptr) {
+      continue;
+    }
+    output->set_dims(meta.dims);
+    output->set_strides(meta.strides);
+    output->set_dtype(meta.dtype);
+    output->set_layout(meta.layout);
+  }
+  std::rotate(entries_.begin(), it, it + 1);
+  ++stats_.hits;
+  global_hits_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void InferMetaCache::Insert(phi::InferMetaContext* ctx) {
+  if (!key_valid_ || capacity_ == 0) {
+    return;
+  }
+  Entry entry;
+  entry.key = std::move(key_);
+  entry.outputs.resize(ctx->OutputsSize());
+  for (size_t i = 0; i < ctx->OutputsSize(); ++i) {
+    phi::MetaTensor* output = ctx->MutableOutputAt(i);
+    if (output == nullptr) {
+      continue;
+    }
+    OutputMeta& meta = entry.outputs[i];
+    meta.present = true;
+    meta.dims = output->dims();
+    meta.strides = output->strides();
+    meta.dtype = output->dtype();
+    meta.layout = output->layout();
+  }
+  if (entries_.size() >= capacity_) {
+    entries_.pop_back();
+  }
+  entries_.insert(entries_.begin(), std::move(entry));
+  key_valid_ = false;
+}
+
+InferMetaCacheStats InferMetaCache::GlobalStats() {
+  InferMetaCacheStats stats;
+  stats.hits = global_hits_.load(std::memory_order_relaxed);
+  stats.misses = global_misses_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace paddle::framework
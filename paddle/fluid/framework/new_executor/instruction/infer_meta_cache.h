@@ -0,0 +1,91 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "paddle/phi/core/infermeta_utils.h"
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+namespace framework {
+
+struct InferMetaCacheStats {
+  uint64_t hits{0};
+  uint64_t misses{0};
+};
+
+/**
+ * InferMetaCache remembers the output metas InferMeta computed for the
+ * metas of the inputs of an instruction, so that an instruction running
+ * again on inputs of the same dims, dtypes and layouts sets its outputs
+ * without calling InferMeta.
+ *
+ * Only the contexts whose InferMeta depends on the metas alone are cached:
+ * all the inputs and outputs are dense tensors, and no attribute is read
+ * from a tensor at runtime. A run with an input that has a LoD neither
+ * looks up nor inserts, since InferMeta may share that LoD with the outputs.
+ * The most recently used entries are kept, up to the capacity.
+ */
+class TEST_API InferMetaCache {
+ public:
+  explicit InferMetaCache(size_t capacity) : capacity_(capacity) {}
+
+  // Whether the attributes of ctx are known before running.
+  static bool IsCacheable(const phi::InferMetaContext& ctx);
+
+  // Sets the output metas of ctx and returns true if the input metas hit.
+  bool Lookup(phi::InferMetaContext* ctx);
+
+  // Saves the output metas of ctx for the input metas of the last Lookup.
+  void Insert(phi::InferMetaContext* ctx);
+
+  const InferMetaCacheStats& Stats() const { return stats_; }
+
+  // The hits and misses of all the caches.
+  static InferMetaCacheStats GlobalStats();
+
+ private:
+  struct OutputMeta {
+    bool present{false};
+    phi::DDim dims;
+    phi::DDim strides;
+    phi::DataType dtype{phi::DataType::UNDEFINED};
+    phi::DataLayout layout{phi::DataLayout::UNDEFINED};
+  };
+
+  struct Entry {
+    std::vector<int64_t> key;
+    std::vector<OutputMeta> outputs;
+  };
+
+  // Returns false if some input or output is not a dense tensor, or some
+  // input has a LoD.
+  bool BuildKey(phi::InferMetaContext* ctx);
+
+  size_t capacity_;
+  std::vector<int64_t> key_;
+  bool key_valid_{false};
+  // the most recently used first
+  std::vector<Entry> entries_;
+  InferMetaCacheStats stats_;
+
+  static std::atomic<uint64_t> global_hits_;
+  static std::atomic<uint64_t> global_misses_;
+};
+
+}  // namespace framework
+}  // namespace paddle
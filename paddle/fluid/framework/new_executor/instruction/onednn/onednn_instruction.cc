@@ -404,85 +404,101 @@ OneDNNPhiKernelInstruction::~OneDNNPhiKernelInstruction() {
   delete phi_kernel_;
 }
 
+bool OneDNNPhiKernelInstruction::NeedTransLayout(
+    const phi::DenseTensor* input, size_t i) const {
+  return input != nullptr && input->initialized() &&
+         !skip_format_tensors_.count(i) &&
+         input->layout() != phi::DataLayout::ONEDNN;
+}
+
 void OneDNNPhiKernelInstruction::Run() {
+  // The inputs are usually in the oneDNN layout already, then the prepared
+  // contexts are run as they are. Otherwise copies of them are patched with
+  // the transformed inputs, so that the prepared ones keep the tensors of
+  // the scope.
+  bool need_trans = false;
+  for (size_t i = 0; i < kernel_context_.InputsSize() && !need_trans; ++i) {
+    need_trans = NeedTransLayout(static_cast<const phi::DenseTensor*>(
+                                     kernel_context_.MutableIutputAt(i)),
+                                 i);
+  }
   std::vector<std::shared_ptr<phi::DenseTensor>> tmp_holders;
-  auto tmp_kernel_context = kernel_context_;
-  auto tmp_infer_meta_context_ = infer_meta_context_;
+  phi::KernelContext tmp_kernel_context;
+  phi::InferMetaContext tmp_infer_meta_context;
+  phi::KernelContext* kernel_context = &kernel_context_;
+  phi::InferMetaContext* infer_meta_context = &infer_meta_context_;
+  if (need_trans) {
+    tmp_kernel_context = kernel_context_;
+    tmp_infer_meta_context = infer_meta_context_;
+    kernel_context = &tmp_kernel_context;
+    infer_meta_context = &tmp_infer_meta_context;
+  }
   // Step1. TransLayout
-  auto inputs = tmp_kernel_context.InputsBetween<phi::DenseTensor>(
-      size_t(0), tmp_kernel_context.InputsSize());
-  for (size_t i = 0; i < inputs.size(); ++i) {
-    auto input = inputs[i];
-    if (input == nullptr) {
-      continue;
-    }
-    if (!input->initialized()) {
-      continue;
-    }
-    if (skip_format_tensors_.count(i)) {
+  for (size_t i = 0; i < kernel_context->InputsSize(); ++i) {
+    auto* input = static_cast<const phi::DenseTensor*>(
+        kernel_context->MutableIutputAt(i));
+    if (!NeedTransLayout(input, i)) {
       continue;
     }
     VLOG(6) << "input[" << i << "].layout() = " << input->layout()
             << ", shape = " << input->dims();
-    if (input->layout() != phi::DataLayout::ONEDNN) {
-      phi::DataLayout from_layout = input->layout();
-      tmp_holders.emplace_back(std::make_shared<phi::DenseTensor>(*input));
-      auto transed_tensor = tmp_holders.back().get();
-
-      std::set<std::string> elementwise_kernels = {"onednn_op.add",
-                                                   "onednn_op.subtract",
-                                                   "onednn_op.multiply",
-                                                   "onednn_op.divide"};
-
-      if (elementwise_kernels.count(phi_op_name_)) {
-        if (phi::OneDNNContext::tls().get_cur_paddle_data_layout() ==
-                phi::DataLayout::kNHWC &&
-            !(kernel_key_.dtype() == phi::DataType::COMPLEX64 ||
-              kernel_key_.dtype() == phi::DataType::COMPLEX128)) {
-          from_layout = phi::DataLayout::kNHWC;
-          phi::funcs::MatchShapeToLayout(
-              transed_tensor, from_layout, phi::DataLayout::ONEDNN);
-        }
-      } else {
-        //  Handle 'layout_transform' in
-        //  ops_onednn_extra.yaml(GetKernelTypeForVar)
-        if (data_format_tensors_.count(i) &&
-            input_layout_ != phi::DataLayout::kAnyLayout) {
-          from_layout = input_layout_;
-        }
-        VLOG(6) << "from_layout = " << from_layout;
-
-        if (from_layout == DataLayout::kNHWC ||
-            from_layout == DataLayout::kNDHWC) {
-          phi::funcs::MatchShapeToLayout(
-              transed_tensor, from_layout, phi::DataLayout::ONEDNN);
-          // We register only NHWC assuming that model is consistent e.g. either
-          // NHWC or NCHW
-          phi::OneDNNContext::tls().set_cur_paddle_data_layout(from_layout);
-        }
+    phi::DataLayout from_layout = input->layout();
+    tmp_holders.emplace_back(std::make_shared<phi::DenseTensor>(*input));
+    auto transed_tensor = tmp_holders.back().get();
+
+    static const std::set<std::string> elementwise_kernels = {
+        "onednn_op.add",
+        "onednn_op.subtract",
+        "onednn_op.multiply",
+        "onednn_op.divide"};
+
+    if (elementwise_kernels.count(phi_op_name_)) {
+      if (phi::OneDNNContext::tls().get_cur_paddle_data_layout() ==
+              phi::DataLayout::kNHWC &&
+          !(kernel_key_.dtype() == phi::DataType::COMPLEX64 ||
+            kernel_key_.dtype() == phi::DataType::COMPLEX128)) {
+        from_layout = phi::DataLayout::kNHWC;
+        phi::funcs::MatchShapeToLayout(
+            transed_tensor, from_layout, phi::DataLayout::ONEDNN);
+      }
+    } else {
+      //  Handle 'layout_transform' in
+      //  ops_onednn_extra.yaml(GetKernelTypeForVar)
+      if (data_format_tensors_.count(i) &&
+          input_layout_ != phi::DataLayout::kAnyLayout) {
+        from_layout = input_layout_;
+      }
+      VLOG(6) << "from_layout = " << from_layout;
+
+      if (from_layout == DataLayout::kNHWC ||
+          from_layout == DataLayout::kNDHWC) {
+        phi::funcs::MatchShapeToLayout(
+            transed_tensor, from_layout, phi::DataLayout::ONEDNN);
+        // We register only NHWC assuming that model is consistent e.g. either
+        // NHWC or NCHW
+        phi::OneDNNContext::tls().set_cur_paddle_data_layout(from_layout);
+      }
 
-        if (from_layout == DataLayout::kAnyLayout) {
-          from_layout = phi::OneDNNContext::tls().get_cur_paddle_data_layout();
-        }
+      if (from_layout == DataLayout::kAnyLayout) {
+        from_layout = phi::OneDNNContext::tls().get_cur_paddle_data_layout();
       }
+    }
 
-      dnnl::memory::desc out_mem_desc =
-          phi::funcs::make_memory_desc(*transed_tensor, from_layout);
-      transed_tensor->set_mem_desc(out_mem_desc);
-      tmp_kernel_context.UpdataInput(i, transed_tensor);
-      auto meta_tensor = phi::MetaTensor(transed_tensor);
-      auto input_meta_tensor = phi::MetaTensor(input);
-      if (tmp_infer_meta_context_.InputsSize() > i &&
-          tmp_infer_meta_context_.InputAt(i).is_same_tensor(
-              input_meta_tensor)) {
-        tmp_infer_meta_context_.UpdataInput(i, meta_tensor);
-      } else {
-        for (size_t j = 0; j < tmp_infer_meta_context_.InputsSize(); ++j) {
-          if (tmp_infer_meta_context_.InputAt(j).is_same_tensor(
-                  input_meta_tensor)) {
-            tmp_infer_meta_context_.UpdataInput(j, meta_tensor);
-            break;
-          }
+    dnnl::memory::desc out_mem_desc =
+        phi::funcs::make_memory_desc(*transed_tensor, from_layout);
+    transed_tensor->set_mem_desc(out_mem_desc);
+    kernel_context->UpdataInput(i, transed_tensor);
+    auto meta_tensor = phi::MetaTensor(transed_tensor);
+    auto input_meta_tensor = phi::MetaTensor(input);
+    if (infer_meta_context->InputsSize() > i &&
+        infer_meta_context->InputAt(i).is_same_tensor(input_meta_tensor)) {
+      infer_meta_context->UpdataInput(i, meta_tensor);
+    } else {
+      for (size_t j = 0; j < infer_meta_context->InputsSize(); ++j) {
+        if (infer_meta_context->InputAt(j).is_same_tensor(
+                input_meta_tensor)) {
+          infer_meta_context->UpdataInput(j, meta_tensor);
+          break;
         }
       }
     }
@@ -492,7 +508,7 @@ void OneDNNPhiKernelInstruction::Run() {
   // SetDnnAttrIntoDeviceContext
   // SetInputsName SetOutputsName
   auto one_dnn_ctx = const_cast<phi::OneDNNContext*>(
-      &tmp_kernel_context.GetDeviceContext<phi::OneDNNContext>());
+      &kernel_context->GetDeviceContext<phi::OneDNNContext>());
   for (auto& attr : extra_attr_) {
     one_dnn_ctx->SetDnnAttr(attr.first, attr.second);
   }
@@ -504,12 +520,12 @@ void OneDNNPhiKernelInstruction::Run() {
 
   // Step3. InferMeta
   if (infer_meta_interface_) {
-    infer_meta_interface_->infer_meta_(&(tmp_infer_meta_context_));
+    infer_meta_interface_->infer_meta_(infer_meta_context);
   }
 
   // Step4. Run kernel
   VLOG(6) << "Run op " << phi_op_name_ << " infer meta.";
-  (*(phi_kernel_))(&(tmp_kernel_context));
+  (*(phi_kernel_))(kernel_context);
   VLOG(6) << "Run op " << phi_op_name_ << " kernel.";
 
   // Step5. ClearDnnAttr
@@ -53,6 +53,9 @@ class OneDNNPhiKernelInstruction : public InstructionBase {
   const std::string& Name() const override { return phi_op_name_; }
 
  protected:
+  // Whether the i-th input is to be transformed to the oneDNN layout.
+  bool NeedTransLayout(const phi::DenseTensor* input, size_t i) const;
+
   paddle::dialect::InferMetaInterface::Concept* infer_meta_interface_{
       nullptr};  // not owned
 
@@ -38,6 +38,8 @@ PHI_DEFINE_EXPORTED_bool(print_kernel_run_info,
                          false,
                          "Whether print kernel run info.");
 
+COMMON_DECLARE_int32(pir_interpreter_infer_meta_cache_size);
+
 namespace paddle {
 namespace framework {
 
@@ -130,6 +132,11 @@ PhiKernelInstruction::PhiKernelInstruction(
         paddle::small_vector<phi::MetaTensor, phi::kInputSmallVectorSize>,
         paddle::small_vector<phi::MetaTensor, phi::kInputSmallVectorSize>,
         false>(op, *value_exec_info_, yaml_info_parser, &infer_meta_context_);
+    if (FLAGS_pir_interpreter_infer_meta_cache_size > 0 &&
+        InferMetaCache::IsCacheable(infer_meta_context_)) {
+      infer_meta_cache_ = std::make_unique<InferMetaCache>(
+          FLAGS_pir_interpreter_infer_meta_cache_size);
+    }
   }
   VLOG(6) << "finish process infer meta context";
 
@@ -141,6 +148,7 @@ PhiKernelInstruction::PhiKernelInstruction(
   auto kernel_result = phi::KernelFactory::Instance().SelectKernelOrThrowError(
       kernel_name, kernel_key);
   kernel_name_ = kernel_name;
+  kernel_launch_event_name_ = kernel_name + " kernel launch";
   phi_kernel_ = new phi::Kernel(kernel_result.kernel);
   PADDLE_ENFORCE_EQ(
       phi_kernel_->IsValid(), true, "not found kernel for [%s]", kernel_name);
@@ -216,7 +224,7 @@ void PhiKernelInstruction::Run() {
     phi::RecordEvent record_event("PhiKernelInstruction::infermeta",
                                   phi::TracerEventType::UserDefined,
                                   1);
-    infer_meta_interface_->infer_meta_(&(infer_meta_context_));
+    InferMeta();
   }
   VLOG(6) << "End run op " << phi_op_name_ << " infer meta.";
   for (auto& pair : this->InplaceInfo()) {
@@ -224,7 +232,7 @@ void PhiKernelInstruction::Run() {
   }
   VLOG(6) << "Begin run op " << phi_op_name_ << " kernel.";
   {
-    phi::RecordEvent record_event(kernel_name_ + " kernel launch",
+    phi::RecordEvent record_event(kernel_launch_event_name_,
                                   phi::TracerEventType::StaticKernelLaunch,
                                   1);
     (*(phi_kernel_))(&(kernel_context_));
@@ -233,5 +241,18 @@ void PhiKernelInstruction::Run() {
   VLOG(6) << "End run op " << phi_op_name_ << " kernel.";
 }
 
+void PhiKernelInstruction::InferMeta() {
+  if (infer_meta_interface_ == nullptr) {
+    return;
+  }
+  if (infer_meta_cache_ == nullptr ||
+      !infer_meta_cache_->Lookup(&infer_meta_context_)) {
+    infer_meta_interface_->infer_meta_(&(infer_meta_context_));
+    if (infer_meta_cache_) {
+      infer_meta_cache_->Insert(&infer_meta_context_);
+    }
+  }
+}
+
 }  // namespace framework
 }  // namespace paddle
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "paddle/fluid/framework/new_executor/instruction/infer_meta_cache.h"
 #include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
 
 namespace pir {
@@ -38,10 +39,16 @@ class PhiKernelInstruction : public InstructionBase {
 
   const phi::KernelContext& KernelContext() const { return kernel_context_; }
 
+  phi::KernelContext* MutableKernelContext() { return &kernel_context_; }
+
   const phi::InferMetaContext& InferMetaContext() const {
     return infer_meta_context_;
   }
 
+  phi::InferMetaContext* MutableInferMetaContext() {
+    return &infer_meta_context_;
+  }
+
   paddle::dialect::InferMetaInterface::Concept* InferMetaInterface() const {
     return infer_meta_interface_;
   }
@@ -50,14 +57,26 @@ class PhiKernelInstruction : public InstructionBase {
 
   void Run() override;
 
+  // Runs the InferMeta of the instruction, through the InferMeta cache when
+  // it has one. Run calls it before the kernel.
+  void InferMeta();
+
   const std::string& Name() const override { return phi_op_name_; }
 
+  // nullptr if FLAGS_pir_interpreter_infer_meta_cache_size is 0 or the
+  // InferMeta of the instruction is not cacheable
+  const InferMetaCache* GetInferMetaCache() const {
+    return infer_meta_cache_.get();
+  }
+
  private:
   paddle::dialect::InferMetaInterface::Concept* infer_meta_interface_{
       nullptr};  // not owned
 
   phi::InferMetaContext infer_meta_context_;
 
+  std::unique_ptr<InferMetaCache> infer_meta_cache_;
+
   phi::KernelContext kernel_context_;
 
   phi::Kernel* phi_kernel_{nullptr};  // not owned
@@ -66,6 +85,11 @@ class PhiKernelInstruction : public InstructionBase {
 
   std::string kernel_name_;
 
+  // Built once to avoid the allocation of a temporary string on each Run.
+  // RecordEvent interns it, a const char* would be kept past this
+  // instruction.
+  std::string kernel_launch_event_name_;
+
   ::pir::Operation* op_{nullptr};  // not owned
 
   const ValueExecutionInfo* value_exec_info_;  // not owned
@@ -0,0 +1,78 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "paddle/fluid/framework/new_executor/instruction/temp_space_scratch.h"
+
+#include <unordered_map>
+
+#include "paddle/common/errors.h"
+#include "paddle/phi/common/memory_utils.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/platform/cuda_graph_with_memory_pool.h"
+
+namespace paddle {
+namespace framework {
+
+std::shared_ptr<TempSpaceScratch> TempSpaceScratch::Get(
+    const phi::Place& place, void* stream) {
+  static std::mutex mutex;
+  // Only the instructions own the scratches, the registry is never destroyed
+  // so that it outlives them.
+  static auto* scratches =
+      new std::unordered_map<void*, std::weak_ptr<TempSpaceScratch>>();
+  std::lock_guard<std::mutex> guard(mutex);
+  for (auto it = scratches->begin(); it != scratches->end();) {
+    it = it->second.expired() ? scratches->erase(it) : std::next(it);
+  }
+  auto& entry = (*scratches)[stream];
+  std::shared_ptr<TempSpaceScratch> scratch = entry.lock();
+  if (scratch == nullptr) {
+    scratch = std::make_shared<TempSpaceScratch>(place, stream);
+    entry = scratch;
+  }
+  return scratch;
+}
+
+TempSpaceScratch::TempSpaceScratch(const phi::Place& place, void* stream)
+    : place_(place), stream_(stream) {}
+
+uint8_t* TempSpaceScratch::Reserve(size_t size) {
+  bool capturing = platform::IsCUDAGraphCapturing();
+  if (buffer_ == nullptr || buffer_->size() < size) {
+    PADDLE_ENFORCE_EQ(
+        capturing && buffer_ != nullptr,
+        false,
+        common::errors::PreconditionNotMet(
+            "The temporary spaces of %d bytes outgrow the scratch of %d "
+            "bytes while capturing a CUDA Graph, which replays the kernels "
+            "on the scratch. Run the program once before capturing it.",
+            size,
+            capacity()));
+    if (buffer_captured_) {
+      captured_buffers_.push_back(std::move(buffer_));
+      buffer_captured_ = false;
+    }
+    buffer_.reset();
+    if (phi::is_gpu_place(place_)) {
+      buffer_ = phi::memory_utils::Alloc(
+          place_, size, phi::Stream(reinterpret_cast<phi::StreamId>(stream_)));
+    } else {
+      buffer_ = phi::memory_utils::Alloc(place_, size);
+    }
+  }
+  buffer_captured_ = buffer_captured_ || capturing;
+  return static_cast<uint8_t*>(buffer_->ptr());
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -0,0 +1,66 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/allocator.h"
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+namespace framework {
+
+/**
+ * TempSpaceScratch holds the temporary spaces of the kernels launched on a
+ * stream. The kernels run in the order of the stream, so they all reuse one
+ * buffer instead of allocating and freeing their temporary spaces on each
+ * launch.
+ *
+ * The instructions launching on a stream share its scratch, which is freed
+ * with the last of them, i.e., with their interpreters. A stream whose
+ * instructions are all gone gets a new scratch.
+ */
+class TEST_API TempSpaceScratch {
+ public:
+  static std::shared_ptr<TempSpaceScratch> Get(const phi::Place& place,
+                                               void* stream);
+
+  TempSpaceScratch(const phi::Place& place, void* stream);
+
+  // Held from binding the temporary spaces until the kernel is launched.
+  std::mutex& mutex() { return mutex_; }
+
+  // A buffer of at least size bytes. The smaller buffer is freed in the
+  // order of the stream, after the kernels which use it. A buffer that a CUDA
+  // Graph captured is kept with the scratch since the graph replays on it,
+  // and the buffer is not grown while capturing.
+  uint8_t* Reserve(size_t size);
+
+  size_t capacity() const { return buffer_ == nullptr ? 0 : buffer_->size(); }
+
+ private:
+  phi::Place place_;
+  void* stream_;
+  std::mutex mutex_;
+  phi::Allocator::AllocationPtr buffer_{nullptr};
+  bool buffer_captured_{false};
+  std::vector<phi::Allocator::AllocationPtr> captured_buffers_;
+};
+
+}  // namespace framework
+}  // namespace paddle
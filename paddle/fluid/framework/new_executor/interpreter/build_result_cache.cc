@@ -0,0 +1,256 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/build_result_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle::framework::interpreter {
+
+static constexpr uint64_t kBuildResultMagic = 0x5049524255494C44ULL;
+static constexpr uint64_t kBuildResultVersion = 1;
+
+void BuildSignatureHasher::Update(const std::string& str) {
+  Update(static_cast<uint64_t>(str.size()));
+  for (unsigned char c : str) {
+    hash_ ^= c;
+    hash_ *= 1099511628211ULL;
+  }
+}
+
+void BuildSignatureHasher::Update(uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    hash_ ^= (value >> (8 * i)) & 0xFF;
+    hash_ *= 1099511628211ULL;
+  }
+}
+
+std::string PirBuildResultPath(const std::string& cache_dir,
+                               uint64_t signature) {
+  std::stringstream ss;
+  ss << cache_dir << "/pir_build_" << std::hex << signature << ".cache";
+  return ss.str();
+}
+
+namespace {
+
+class BuildResultWriter {
+ public:
+  explicit BuildResultWriter(std::ofstream* fout) : fout_(fout) {}
+
+  void Write(uint64_t value) {
+    fout_->write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void Write(const std::set<size_t>& ids) {
+    Write(ids.size());
+    for (size_t id : ids) {
+      Write(id);
+    }
+  }
+
+  void Write(const std::map<size_t, std::set<size_t>>& id_map) {
+    Write(id_map.size());
+    for (auto& pair : id_map) {
+      Write(pair.first);
+      Write(pair.second);
+    }
+  }
+
+ private:
+  std::ofstream* fout_;
+};
+
+// Every id read is checked against its bound, so that a corrupted file fails
+// the load instead of indexing out of range later.
+class BuildResultReader {
+ public:
+  explicit BuildResultReader(std::ifstream* fin) : fin_(fin) {}
+
+  bool Read(uint64_t* value) {
+    return static_cast<bool>(
+        fin_->read(reinterpret_cast<char*>(value), sizeof(*value)));
+  }
+
+  bool Read(size_t bound, size_t* id) {
+    uint64_t value = 0;
+    if (!Read(&value) || value >= bound) {
+      return false;
+    }
+    *id = static_cast<size_t>(value);
+    return true;
+  }
+
+  bool Read(size_t bound, std::set<size_t>* ids) {
+    uint64_t num = 0;
+    if (!Read(&num) || num > bound) {
+      return false;
+    }
+    for (uint64_t i = 0; i < num; ++i) {
+      size_t id = 0;
+      if (!Read(bound, &id)) {
+        return false;
+      }
+      ids->insert(id);
+    }
+    return true;
+  }
+
+  bool Read(size_t key_bound,
+            size_t id_bound,
+            std::map<size_t, std::set<size_t>>* id_map) {
+    uint64_t num = 0;
+    if (!Read(&num)) {
+      return false;
+    }
+    for (uint64_t i = 0; i < num; ++i) {
+      size_t key = 0;
+      if (!Read(key_bound, &key) || !Read(id_bound, &(*id_map)[key])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::ifstream* fin_;
+};
+
+}  // namespace
+
+void SavePirBuildResult(const std::string& path,
+                        const PirBuildResult& result) {
+  std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream fout(tmp_path, std::ios::binary);
+    PADDLE_ENFORCE_EQ(
+        fout.is_open(),
+        true,
+        common::errors::Unavailable(
+            "Cannot open %s to save the build result.", tmp_path));
+    BuildResultWriter writer(&fout);
+    writer.Write(kBuildResultMagic);
+    writer.Write(kBuildResultVersion);
+    writer.Write(result.signature);
+    writer.Write(result.instr_num);
+    writer.Write(result.downstream_map);
+
+    // The happens before matrix is the largest part, pack it into bits.
+    std::vector<uint64_t> bits((result.instr_num * result.instr_num + 63) /
+                               64);
+    for (size_t i = 0; i < result.happens_before.size(); ++i) {
+      for (size_t j = 0; j < result.happens_before[i].size(); ++j) {
+        if (result.happens_before[i][j]) {
+          size_t pos = i * result.instr_num + j;
+          bits[pos / 64] |= 1ULL << (pos % 64);
+        }
+      }
+    }
+    for (uint64_t word : bits) {
+      writer.Write(word);
+    }
+
+    writer.Write(result.event_info.size());
+    for (auto& pair : result.event_info) {
+      writer.Write(pair.first);
+      writer.Write(pair.second);
+    }
+    writer.Write(result.last_live_ops);
+    PADDLE_ENFORCE_EQ(fout.good(),
+                      true,
+                      common::errors::Unavailable(
+                          "Fail to write the build result to %s.", tmp_path));
+  }
+  PADDLE_ENFORCE_EQ(
+      std::rename(tmp_path.c_str(), path.c_str()),
+      0,
+      common::errors::Unavailable("Fail to rename %s to %s.", tmp_path, path));
+  VLOG(3) << "Save the build result of " << result.instr_num
+          << " instructions to " << path;
+}
+
+bool LoadPirBuildResult(const std::string& path,
+                        uint64_t signature,
+                        size_t instr_num,
+                        PirBuildResult* result) {
+  std::ifstream fin(path, std::ios::binary);
+  if (!fin.is_open()) {
+    return false;
+  }
+  BuildResultReader reader(&fin);
+  uint64_t magic = 0, version = 0, saved_signature = 0, saved_instr_num = 0;
+  if (!reader.Read(&magic) || !reader.Read(&version) ||
+      !reader.Read(&saved_signature) || !reader.Read(&saved_instr_num) ||
+      magic != kBuildResultMagic || version != kBuildResultVersion ||
+      saved_signature != signature || saved_instr_num != instr_num) {
+    VLOG(3) << path << " is not the build result of the program, ignore it";
+    return false;
+  }
+
+  PirBuildResult loaded;
+  loaded.signature = signature;
+  loaded.instr_num = instr_num;
+  bool ok = reader.Read(instr_num, instr_num, &loaded.downstream_map);
+
+  std::vector<uint64_t> bits((instr_num * instr_num + 63) / 64);
+  for (size_t i = 0; ok && i < bits.size(); ++i) {
+    ok = reader.Read(&bits[i]);
+  }
+  if (ok) {
+    loaded.happens_before.assign(instr_num, std::vector<bool>(instr_num));
+    for (size_t i = 0; i < instr_num; ++i) {
+      for (size_t j = 0; j < instr_num; ++j) {
+        size_t pos = i * instr_num + j;
+        loaded.happens_before[i][j] = (bits[pos / 64] >> (pos % 64)) & 1ULL;
+      }
+    }
+  }
+
+  // The stream analysis runs on the instructions of two steps, so the ids
+  // of its waiters and recorders are less than 2 * instr_num.
+  uint64_t stream_num = 0;
+  ok = ok && reader.Read(&stream_num) && stream_num <= instr_num;
+  for (uint64_t i = 0; ok && i < stream_num; ++i) {
+    size_t stream = 0;
+    ok = reader.Read(instr_num, &stream) &&
+         reader.Read(
+             2 * instr_num, 2 * instr_num, &loaded.event_info[stream]);
+  }
+  ok = ok && reader.Read(SIZE_MAX, instr_num, &loaded.last_live_ops);
+
+  if (!ok) {
+    LOG(WARNING) << "The build result " << path
+                 << " is corrupted, the program will be analysed again";
+    return false;
+  }
+  *result = std::move(loaded);
+  VLOG(3) << "Load the build result of " << instr_num << " instructions from "
+          << path;
+  return true;
+}
+
+}  // namespace paddle::framework::interpreter
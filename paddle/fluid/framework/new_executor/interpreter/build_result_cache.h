@@ -0,0 +1,77 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+/**
+ * PirBuildResult holds the analysis results of PirInterpreter that only
+ * depend on the instructions of the program: the dependency DAG, the events
+ * between streams and the GC schedule. They are saved to a file named by the
+ * signature of the instructions, so that a restarted process running the
+ * same program loads them instead of analysing it again.
+ *
+ * Streams are not stable across processes, so each stream is recorded as the
+ * id of the first instruction running on it.
+ */
+struct PirBuildResult {
+  uint64_t signature{0};
+  size_t instr_num{0};
+  std::map<size_t, std::set<size_t>> downstream_map;
+  std::vector<std::vector<bool>> happens_before;
+  // stream -> waiter instr id -> recorder instr ids
+  std::map<size_t, std::map<size_t, std::set<size_t>>> event_info;
+  // var id -> ids of the instructions that check the var for GC
+  std::map<size_t, std::set<size_t>> last_live_ops;
+};
+
+// A FNV-1a hash, stable across processes unlike std::hash.
+class BuildSignatureHasher {
+ public:
+  void Update(const std::string& str);
+  void Update(uint64_t value);
+  uint64_t Digest() const { return hash_; }
+
+ private:
+  uint64_t hash_{14695981039346656037ULL};
+};
+
+TEST_API std::string PirBuildResultPath(const std::string& cache_dir,
+                                        uint64_t signature);
+
+// Writes to a temporary file and renames it, so that the processes
+// starting together never read a partially written file.
+TEST_API void SavePirBuildResult(const std::string& path,
+                                 const PirBuildResult& result);
+
+// Returns false when the file does not exist, is corrupted or is not built
+// for the signature and number of instructions of the expected result.
+TEST_API bool LoadPirBuildResult(const std::string& path,
+                                 uint64_t signature,
+                                 size_t instr_num,
+                                 PirBuildResult* result);
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
@@ -124,6 +124,10 @@ class PirDependencyBuilder : public DependencyBuilder {
 
   void ShareDependencyFrom(const PirDependencyBuilder& src);
 
+  // Use the dependency loaded from a saved build result instead of building.
+  void LoadDependency(std::map<size_t, std::set<size_t>> downstream_map,
+                      std::vector<std::vector<bool>> happens_before);
+
   bool IsSameDeviceContext(size_t op1, size_t op2) const {
     return &((instructions_)[op1]->DeviceContext()) ==
            &((instructions_)[op2]->DeviceContext());
@@ -0,0 +1,135 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/static_memory_planner.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "paddle/common/enforce.h"
+
+namespace paddle::framework::interpreter {
+
+StaticMemoryPlanner::StaticMemoryPlanner(size_t alignment)
+    : alignment_(alignment) {
+  PADDLE_ENFORCE_GT(
+      alignment_,
+      0,
+      common::errors::InvalidArgument("The alignment must be positive."));
+}
+
+void StaticMemoryPlanner::AddBuffer(int id,
+                                    size_t size,
+                                    size_t first_use,
+                                    size_t last_use) {
+  PADDLE_ENFORCE_LE(
+      first_use,
+      last_use,
+      common::errors::InvalidArgument(
+          "The first use (%d) of buffer %d is after its last use (%d).",
+          first_use,
+          id,
+          last_use));
+  PADDLE_ENFORCE_EQ(
+      index_.count(id),
+      0,
+      common::errors::AlreadyExists(
+          "Buffer %d is added to StaticMemoryPlanner twice.", id));
+  size_t aligned_size = (size + alignment_ - 1) / alignment_ * alignment_;
+  index_[id] = buffers_.size();
+  buffers_.push_back({id, aligned_size, first_use, last_use, 0});
+}
+
+size_t StaticMemoryPlanner::Plan() {
+  std::vector<size_t> order(buffers_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  // Large buffers first, they are the hardest to fit into gaps.
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    if (buffers_[a].size != buffers_[b].size) {
+      return buffers_[a].size > buffers_[b].size;
+    }
+    return buffers_[a].first_use < buffers_[b].first_use;
+  });
+
+  arena_size_ = 0;
+  std::vector<size_t> placed;
+  // (offset, end) of the placed buffers alive at the same time as the current
+  // one.
+  std::vector<std::pair<size_t, size_t>> occupied;
+  for (size_t idx : order) {
+    Buffer& buffer = buffers_[idx];
+    occupied.clear();
+    for (size_t other_idx : placed) {
+      const Buffer& other = buffers_[other_idx];
+      if (other.first_use <= buffer.last_use &&
+          buffer.first_use <= other.last_use) {
+        occupied.emplace_back(other.offset, other.offset + other.size);
+      }
+    }
+    std::sort(occupied.begin(), occupied.end());
+
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    bool found = false;
+    size_t cursor = 0;
+    for (auto& range : occupied) {
+      if (range.first > cursor) {
+        size_t gap = range.first - cursor;
+        if (gap >= buffer.size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = cursor;
+          found = true;
+        }
+      }
+      cursor = std::max(cursor, range.second);
+    }
+    if (!found) {
+      best_offset = cursor;
+    }
+
+    buffer.offset = best_offset;
+    arena_size_ = std::max(arena_size_, best_offset + buffer.size);
+    placed.push_back(idx);
+  }
+  return arena_size_;
+}
+
+const StaticMemoryPlanner::Buffer& StaticMemoryPlanner::GetBuffer(
+    int id) const {
+  auto it = index_.find(id);
+  PADDLE_ENFORCE_EQ(
+      it != index_.end(),
+      true,
+      common::errors::NotFound(
+          "Buffer %d is not planned by StaticMemoryPlanner.", id));
+  return buffers_[it->second];
+}
+
+size_t StaticMemoryPlanner::Offset(int id) const {
+  return GetBuffer(id).offset;
+}
+
+size_t StaticMemoryPlanner::Size(int id) const { return GetBuffer(id).size; }
+
+size_t StaticMemoryPlanner::TotalBufferSize() const {
+  size_t total = 0;
+  for (auto& buffer : buffers_) {
+    total += buffer.size;
+  }
+  return total;
+}
+
+}  // namespace paddle::framework::interpreter
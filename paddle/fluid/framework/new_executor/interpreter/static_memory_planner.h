@@ -0,0 +1,77 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+/**
+ * StaticMemoryPlanner assigns every buffer of a program a fixed offset in one
+ * arena, so that a program whose tensor shapes are all known ahead of time
+ * can run without touching the allocator.
+ *
+ * A buffer lives from the position of its producer to the position of its
+ * last consumer in the execution order, both inclusive. Two buffers may share
+ * bytes only when their lifetimes are disjoint. Offsets are assigned greedily
+ * from the largest buffer to the smallest, each buffer taking the smallest gap
+ * left between the already placed buffers it overlaps in time.
+ */
+class StaticMemoryPlanner {
+ public:
+  static constexpr size_t kDefaultAlignment = 256;
+
+  explicit StaticMemoryPlanner(size_t alignment = kDefaultAlignment);
+
+  void AddBuffer(int id, size_t size, size_t first_use, size_t last_use);
+
+  // Returns the size of the arena needed by all buffers.
+  size_t Plan();
+
+  bool Has(int id) const { return index_.count(id) != 0; }
+  size_t Offset(int id) const;
+  // The size of the buffer rounded up to the alignment.
+  size_t Size(int id) const;
+  size_t ArenaSize() const { return arena_size_; }
+  size_t BufferNum() const { return buffers_.size(); }
+
+  // Sum of the sizes of all buffers, that is the memory needed when no buffer
+  // is reused.
+  size_t TotalBufferSize() const;
+
+ private:
+  struct Buffer {
+    int id;
+    size_t size;
+    size_t first_use;
+    size_t last_use;
+    size_t offset;
+  };
+
+  const Buffer& GetBuffer(int id) const;
+
+  size_t alignment_;
+  std::vector<Buffer> buffers_;
+  // id -> index in buffers_
+  std::unordered_map<int, size_t> index_;
+  size_t arena_size_{0};
+};
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
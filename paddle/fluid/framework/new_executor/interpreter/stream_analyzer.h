@@ -144,6 +144,11 @@ class PirStreamAnalyzer {
 
   void ShareEventInfoFrom(const PirStreamAnalyzer& src);
 
+  // Use the event info loaded from a saved build result instead of building.
+  void LoadEventInfo(
+      std::map<const DeviceContext*, std::map<size_t, std::set<size_t>>>
+          event_info);
+
   void SetForceEventsToWaitInfo(
       std::unordered_map<std::string, std::shared_ptr<EventInter>>*
           program_force_events_to_wait) {
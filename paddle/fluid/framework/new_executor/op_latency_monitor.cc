@@ -0,0 +1,225 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/op_latency_monitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/kernels/autotune/gpu_timer.h"
+#endif
+
+COMMON_DECLARE_int32(pir_interpreter_op_latency_sample_interval);
+
+namespace paddle::framework {
+
+static uint64_t NowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t nanoseconds) {
+  if (nanoseconds < 4) {
+    return static_cast<size_t>(nanoseconds);
+  }
+  size_t exponent = 0;
+  for (uint64_t value = nanoseconds; value >>= 1;) {
+    ++exponent;
+  }
+  size_t index = 4 * (exponent - 1) + ((nanoseconds >> (exponent - 2)) & 3);
+  return std::min(index, kBucketNum - 1);
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(size_t index) {
+  if (index < 4) {
+    return index;
+  }
+  size_t exponent = index / 4 + 1;
+  return static_cast<uint64_t>(4 + index % 4) << (exponent - 2);
+}
+
+void LatencyHistogram::Record(uint64_t nanoseconds) {
+  static std::atomic<size_t> next_shard{0};
+  thread_local size_t shard = next_shard.fetch_add(1) % kShardNum;
+  shards_[shard].buckets[BucketIndex(nanoseconds)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Count() const {
+  uint64_t count = 0;
+  for (auto& shard : shards_) {
+    for (auto& bucket : shard.buckets) {
+      count += bucket.load(std::memory_order_relaxed);
+    }
+  }
+  return count;
+}
+
+double LatencyHistogram::Percentile(double ratio) const {
+  std::array<uint64_t, kBucketNum> merged{};
+  uint64_t count = 0;
+  for (auto& shard : shards_) {
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      uint64_t num = shard.buckets[i].load(std::memory_order_relaxed);
+      merged[i] += num;
+      count += num;
+    }
+  }
+  if (count == 0) {
+    return 0;
+  }
+  uint64_t target = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(ratio * static_cast<double>(count))));
+  uint64_t accumulated = 0;
+  for (size_t i = 0; i < kBucketNum; ++i) {
+    accumulated += merged[i];
+    if (accumulated >= target) {
+      return (static_cast<double>(BucketLowerBound(i)) +
+              static_cast<double>(BucketLowerBound(i + 1))) /
+             2;
+    }
+  }
+  return static_cast<double>(BucketLowerBound(kBucketNum));
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& shard : shards_) {
+    for (auto& bucket : shard.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+OpLatencyMonitor& OpLatencyMonitor::Instance() {
+  static OpLatencyMonitor monitor;
+  return monitor;
+}
+
+bool OpLatencyMonitor::IsEnabled() {
+  return FLAGS_pir_interpreter_op_latency_sample_interval > 0;
+}
+
+OpLatencyHistograms* OpLatencyMonitor::GetHistograms(
+    const std::string& op_name) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto& histograms = histograms_[op_name];
+  if (!histograms) {
+    histograms = std::make_unique<OpLatencyHistograms>();
+  }
+  return histograms.get();
+}
+
+std::vector<OpLatencySummary> OpLatencyMonitor::GetSlowOps(
+    size_t top_n, bool by_device) const {
+  std::vector<OpLatencySummary> summaries;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto& pair : histograms_) {
+      OpLatencySummary summary;
+      summary.op_name = pair.first;
+      summary.host_count = pair.second->host.Count();
+      summary.host_p50_us = pair.second->host.Percentile(0.5) / 1000;
+      summary.host_p99_us = pair.second->host.Percentile(0.99) / 1000;
+      summary.device_count = pair.second->device.Count();
+      summary.device_p50_us = pair.second->device.Percentile(0.5) / 1000;
+      summary.device_p99_us = pair.second->device.Percentile(0.99) / 1000;
+      if ((by_device ? summary.device_count : summary.host_count) > 0) {
+        summaries.emplace_back(std::move(summary));
+      }
+    }
+  }
+  auto p99 = [by_device](const OpLatencySummary& summary) {
+    return by_device ? summary.device_p99_us : summary.host_p99_us;
+  };
+  std::sort(summaries.begin(),
+            summaries.end(),
+            [&p99](const OpLatencySummary& lhs, const OpLatencySummary& rhs) {
+              return p99(lhs) > p99(rhs);
+            });
+  if (summaries.size() > top_n) {
+    summaries.resize(top_n);
+  }
+  return summaries;
+}
+
+void OpLatencyMonitor::Reset() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (auto& pair : histograms_) {
+    pair.second->host.Reset();
+    pair.second->device.Reset();
+  }
+}
+
+OpLatencyRecorder::OpLatencyRecorder(
+    const std::vector<std::unique_ptr<InstructionBase>>& instructions,
+    int sample_interval)
+    : sample_interval_(static_cast<uint64_t>(std::max(sample_interval, 1))),
+      states_(instructions.size()) {
+  auto& monitor = OpLatencyMonitor::Instance();
+  for (auto& instr : instructions) {
+    states_.at(instr->Id()).histograms = monitor.GetHistograms(instr->Name());
+  }
+}
+
+OpLatencyRecorder::~OpLatencyRecorder() = default;
+
+uint64_t OpLatencyRecorder::BeforeRun(InstructionBase* instr) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  auto& state = states_[instr->Id()];
+  state.sampling = false;
+  if (phi::is_gpu_place(instr->DeviceContext().GetPlace()) &&
+      instr->KernelType() != OpFuncType::kCpuSync &&
+      ++state.run_count % sample_interval_ == 0) {
+    // The previous sample is dropped when it is still running, so that a
+    // stream keeps at most one pair of events per instruction.
+    if (state.pending && state.timer->IsStopped()) {
+      state.histograms->device.Record(
+          static_cast<uint64_t>(state.timer->ElapsedTime() * 1e6));
+      state.pending = false;
+    }
+    if (!state.pending) {
+      if (!state.timer) {
+        state.timer = std::make_unique<phi::GpuTimer>();
+      }
+      state.timer->Start(
+          static_cast<const phi::GPUContext&>(instr->DeviceContext())
+              .stream());
+      state.sampling = true;
+    }
+  }
+#endif
+  return NowNanoseconds();
+}
+
+void OpLatencyRecorder::AfterRun(InstructionBase* instr, uint64_t start_ns) {
+  auto& state = states_[instr->Id()];
+  state.histograms->host.Record(NowNanoseconds() - start_ns);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (state.sampling) {
+    state.timer->Stop(
+        static_cast<const phi::GPUContext&>(instr->DeviceContext()).stream());
+    state.sampling = false;
+    state.pending = true;
+  }
+#endif
+}
+
+}  // namespace paddle::framework
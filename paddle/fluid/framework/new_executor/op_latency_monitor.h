@@ -0,0 +1,152 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/utils/test_macros.h"
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+namespace phi {
+class GpuTimer;
+}  // namespace phi
+#endif
+
+namespace paddle {
+namespace framework {
+
+class InstructionBase;
+
+/**
+ * LatencyHistogram counts latencies in nanoseconds into log scaled buckets,
+ * four buckets per power of two, so that a percentile is within 12.5% of the
+ * exact one. The counters are sharded by thread and only updated by relaxed
+ * atomic adds, recording never takes a lock.
+ */
+class TEST_API LatencyHistogram {
+ public:
+  static constexpr size_t kBucketNum = 160;
+
+  void Record(uint64_t nanoseconds);
+
+  uint64_t Count() const;
+
+  // Returns the latency in nanoseconds below which the ratio of the records
+  // is, e.g., 0.99 for p99, or 0 when there is no record.
+  double Percentile(double ratio) const;
+
+  void Reset();
+
+  static size_t BucketIndex(uint64_t nanoseconds);
+  static uint64_t BucketLowerBound(size_t index);
+
+ private:
+  static constexpr size_t kShardNum = 4;
+
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, kBucketNum> buckets{};
+  };
+
+  std::array<Shard, kShardNum> shards_;
+};
+
+struct OpLatencyHistograms {
+  // the host time to launch the instruction, the kernel time on CPU
+  LatencyHistogram host;
+  // the sampled time the instruction takes on its stream
+  LatencyHistogram device;
+};
+
+struct OpLatencySummary {
+  std::string op_name;
+  uint64_t host_count{0};
+  double host_p50_us{0};
+  double host_p99_us{0};
+  uint64_t device_count{0};
+  double device_p50_us{0};
+  double device_p99_us{0};
+};
+
+// OpLatencyMonitor keeps the latency histograms of every op run by the PIR
+// interpreters of the process, when
+// FLAGS_pir_interpreter_op_latency_sample_interval is positive.
+class TEST_API OpLatencyMonitor {
+ public:
+  static OpLatencyMonitor& Instance();
+
+  static bool IsEnabled();
+
+  OpLatencyMonitor(const OpLatencyMonitor&) = delete;
+  OpLatencyMonitor& operator=(const OpLatencyMonitor&) = delete;
+
+  // The histograms live as long as the process, so the interpreters keep
+  // the returned pointer.
+  OpLatencyHistograms* GetHistograms(const std::string& op_name);
+
+  // Returns at most top_n ops, sorted by the p99 of their device time when
+  // by_device is true, else of their host time.
+  std::vector<OpLatencySummary> GetSlowOps(size_t top_n, bool by_device) const;
+
+  void Reset();
+
+ private:
+  OpLatencyMonitor() = default;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<OpLatencyHistograms>>
+      histograms_;
+};
+
+// OpLatencyRecorder records the instructions of one interpreter into the
+// histograms of their ops. An instruction of a GPU stream is timed by a pair
+// of events every sample_interval runs, and its device time is read at a
+// later sample once the events are done, so the host never waits for them.
+class OpLatencyRecorder {
+ public:
+  OpLatencyRecorder(
+      const std::vector<std::unique_ptr<InstructionBase>>& instructions,
+      int sample_interval);
+
+  ~OpLatencyRecorder();
+
+  // Returns the start time passed to AfterRun.
+  uint64_t BeforeRun(InstructionBase* instr);
+
+  void AfterRun(InstructionBase* instr, uint64_t start_ns);
+
+ private:
+  struct InstructionState {
+    OpLatencyHistograms* histograms{nullptr};
+    uint64_t run_count{0};
+    bool sampling{false};
+    bool pending{false};
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    std::unique_ptr<phi::GpuTimer> timer;
+#endif
+  };
+
+  uint64_t sample_interval_;
+  std::vector<InstructionState> states_;
+};
+
+}  // namespace framework
+}  // namespace paddle
@@ -36,6 +36,7 @@
 #include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
 #include "paddle/fluid/pir/dialect/operator/utils/op_yaml_info_parser.h"
 #include "paddle/fluid/pir/dialect/operator/utils/utils.h"
+#include "paddle/fluid/pir/transforms/general/symbolic_memory_reuse_pass.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/kernel_context.h"
 #include "paddle/phi/core/meta_tensor.h"
@@ -760,6 +761,77 @@ void HandleForInplaceVarOp(pir::Operation* op,
   }
 }
 
+// The output of an inplace or view op shares the holder of its input, the
+// buffer of the input is still alive after its last use in that case.
+bool IsBufferAliasedByUser(pir::Value value) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  for (auto it = value.use_begin(); it != value.use_end(); ++it) {
+    pir::Operation* user = it->owner();
+    if (user->isa<pir::CombineOp>()) {
+      if (IsBufferAliasedByUser(user->result(0))) return true;
+      continue;
+    }
+    auto inplace_attr = user->attribute<pir::BoolAttribute>("is_inplace");
+    if (inplace_attr && inplace_attr.data()) return true;
+    auto op_name_attr = user->attribute<pir::StrAttribute>("op_name");
+    if (!op_name_attr) continue;
+    std::string op_name = op_name_attr.AsString();
+    pir::OpInfo op_info = ctx->GetRegisteredOpInfo(op_name);
+    if (!op_info) continue;
+    auto* yaml_interface =
+        op_info.GetInterfaceImpl<paddle::dialect::OpYamlInfoInterface>();
+    if (yaml_interface == nullptr) continue;
+    paddle::dialect::OpYamlInfoParser yaml_parser(
+        yaml_interface->get_op_info_(op_name),
+        paddle::dialect::IsLegacyOp(op_name));
+    for (auto& name : yaml_parser.OutputNames()) {
+      if (yaml_parser.HasView(name)) return true;
+    }
+  }
+  return false;
+}
+
+// The results marked by symbolic_memory_reuse_pass with the same share id
+// use the var of the previous value of the group, so that the holder of a
+// dead value is reused instead of freed and allocated again.
+void BuildValueWithSharedBuffer(
+    pir::Operation* op,
+    size_t index,
+    const std::string& var_name_prefix,
+    ValueExecutionInfo* value_exe_info,
+    std::unordered_map<int64_t, pir::Value>* shared_buffers) {
+  pir::Value value = op->result(index);
+  auto share_ids = op->attribute<pir::ArrayAttribute>(kAttrBufferShareIds);
+  int64_t share_id = -1;
+  if (share_ids && index < share_ids.size() &&
+      share_ids.at(index).isa<pir::Int64Attribute>()) {
+    share_id = share_ids.at(index).dyn_cast<pir::Int64Attribute>().data();
+  }
+  if (share_id < 0 || !IsInvalid(value)) {
+    BuildValue(value, var_name_prefix, value_exe_info);
+    return;
+  }
+  auto it = shared_buffers->find(share_id);
+  if (it != shared_buffers->end()) {
+    pir::Value prev = it->second;
+    auto prev_type =
+        prev.type().dyn_cast<paddle::dialect::AllocatedDenseTensorType>();
+    auto type =
+        value.type().dyn_cast<paddle::dialect::AllocatedDenseTensorType>();
+    std::string var_name = value_exe_info->GetVarName(prev);
+    if (prev_type && type && prev_type.place() == type.place() &&
+        !var_name.empty() && !IsBufferAliasedByUser(prev)) {
+      VLOG(4) << "share buffer: " << var_name << " (share id " << share_id
+              << ")";
+      value_exe_info->AddValue2VarName(value, var_name);
+      it->second = value;
+      return;
+    }
+  }
+  BuildValue(value, var_name_prefix, value_exe_info);
+  (*shared_buffers)[share_id] = value;
+}
+
 // NOTE(zhiqiu): the persistable is created in inner_scope's root, and other
 // is created in inner_scope.
 void BuildScope(const pir::Block& block,
@@ -784,6 +856,7 @@ void BuildScope(const pir::Block& block,
   }
   VLOG(6) << "Finished handle keyword blockargument!";
 
+  std::unordered_map<int64_t, pir::Value> shared_buffers;
   for (auto& op : block) {
     std::string op_name = op.name();
     if (op.attributes().count("op_name")) {
@@ -811,7 +884,11 @@ void BuildScope(const pir::Block& block,
       continue;
     } else {
       for (size_t i = 0; i < op.num_results(); ++i) {
-        BuildValue(op.result(i), var_name_prefix, value_exe_info);
+        BuildValueWithSharedBuffer(const_cast<pir::Operation*>(&op),
+                                   i,
+                                   var_name_prefix,
+                                   value_exe_info,
+                                   &shared_buffers);
       }
     }
   }
@@ -14,10 +14,14 @@
 
 #include "paddle/fluid/framework/new_executor/pir_interpreter.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <tuple>
 #include <unordered_set>
 
 #include "paddle/common/flags.h"
+#include "paddle/common/startup_trace.h"
 
 #include "paddle/fluid/framework/details/nan_inf_utils.h"
 #include "paddle/fluid/framework/new_executor/interpreter/interpreter_util.h"
@@ -26,11 +30,15 @@
 #include "paddle/fluid/platform/profiler/supplement_tracing.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/kernel_context.h"
+#include "paddle/phi/core/memory/allocation/memory_timeline.h"
+#include "paddle/phi/core/memory/malloc.h"
+#include "paddle/phi/core/memory/memcpy.h"
 #include "paddle/phi/core/os_info.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
 #include "paddle/phi/core/sparse_coo_tensor.h"
 #include "paddle/phi/core/sparse_csr_tensor.h"
+#include "paddle/phi/core/tensor_utils.h"
 
 #ifdef PADDLE_WITH_DNNL
 #include "paddle/fluid/framework/new_executor/instruction/onednn/onednn_instruction.h"
@@ -86,8 +94,19 @@ COMMON_DECLARE_bool(dynamic_static_unified_comm);
 
 COMMON_DECLARE_bool(enable_pir_in_executor);
 COMMON_DECLARE_bool(enable_pir_in_executor_trace_run);
+COMMON_DECLARE_bool(pir_interpreter_static_memory_plan);
+COMMON_DECLARE_bool(pir_interpreter_compiled_trace);
+COMMON_DECLARE_bool(pir_interpreter_auto_cuda_graph);
+COMMON_DECLARE_int32(pir_interpreter_auto_cuda_graph_min_ops);
+COMMON_DECLARE_bool(pir_interpreter_fuse_elementwise_chain);
+COMMON_DECLARE_string(pir_interpreter_scheduling_policy);
+COMMON_DECLARE_string(pir_interpreter_build_cache_dir);
+COMMON_DECLARE_bool(add_dependency_for_communication_op);
+COMMON_DECLARE_bool(print_kernel_run_info);
+COMMON_DECLARE_bool(log_memory_stats);
 COMMON_DECLARE_bool(enable_collect_shape);
 COMMON_DECLARE_int32(low_precision_op_list);
+COMMON_DECLARE_int32(pir_interpreter_op_latency_sample_interval);
 
 #define CREATE_INSTR(instr_name)                                   \
   vec_instruction_base_.emplace_back(std::make_unique<instr_name>( \
@@ -477,6 +496,503 @@ void PirInterpreter::CheckCUDAGraphBeforeRun(
 #endif
 }
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// Different input shapes of a range seldom exceed it in decoding.
+static constexpr size_t kMaxCUDAGraphsPerRange = 8;
+
+void PirInterpreter::BuildCUDAGraphRanges() {
+  cuda_graph_range_at_.assign(trace_execute_order_.size(), -1);
+  const phi::DeviceContext* default_ctx =
+      phi::DeviceContextPool::Instance().Get(place_);
+
+  auto is_static_dense_tensor = [](::pir::Value value) {
+    if (!value || !value.type()) {
+      return true;
+    }
+    if (!value.type().isa<paddle::dialect::AllocatedDenseTensorType>()) {
+      return false;
+    }
+    auto type =
+        value.type().dyn_cast<paddle::dialect::AllocatedDenseTensorType>();
+    return !common::contain_unknown_dim(type.dims());
+  };
+  auto is_capture_safe = [&](InstructionBase* instr) {
+    ::pir::Operation* op = instr->Operation();
+    if (dynamic_cast<PhiKernelInstruction*>(instr) == nullptr ||
+        instr->IsArtificial() || instr->IsSyncAfterLaunch() ||
+        instr->KernelType() != OpFuncType::kGpuAsync ||
+        &instr->DeviceContext() != default_ctx ||
+        !instr->EventsToWait().empty() || instr->EventToRecord() != nullptr ||
+        op->num_regions() > 0) {
+      return false;
+    }
+    for (uint32_t i = 0; i < op->num_operands(); ++i) {
+      if (!is_static_dense_tensor(op->operand_source(i))) {
+        return false;
+      }
+    }
+    for (uint32_t i = 0; i < op->num_results(); ++i) {
+      if (!is_static_dense_tensor(op->result(i))) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const auto& var_list = value_exe_info_->GetVarList();
+  size_t min_ops = static_cast<size_t>(
+      std::max(FLAGS_pir_interpreter_auto_cuda_graph_min_ops, 1));
+  size_t begin = 0;
+  while (begin < trace_execute_order_.size()) {
+    size_t end = begin;
+    while (end < trace_execute_order_.size() &&
+           is_capture_safe(
+               vec_instruction_base_[trace_execute_order_[end]].get())) {
+      ++end;
+    }
+    if (end - begin >= min_ops) {
+      CUDAGraphRange range;
+      range.begin = begin;
+      range.end = end;
+      std::unordered_set<Variable*> inputs, written;
+      for (size_t pos = begin; pos < end; ++pos) {
+        InstructionBase* instr =
+            vec_instruction_base_[trace_execute_order_[pos]].get();
+        for (auto& pair : instr->Inputs()) {
+          for (int id : pair.second) {
+            Variable* var = var_list[id];
+            if (written.count(var) == 0 && inputs.insert(var).second) {
+              range.inputs.push_back(var);
+              range.is_persistable.push_back(
+                  parameter_var_names_.count(
+                      value_exe_info_->GetNameById(id)) > 0);
+            }
+          }
+        }
+        for (auto& pair : instr->Outputs()) {
+          for (int id : pair.second) {
+            Variable* var = var_list[id];
+            if (written.insert(var).second) {
+              range.written.push_back(var);
+            }
+          }
+        }
+      }
+      VLOG(4) << "CUDA Graph range [" << begin << ", " << end << ") has "
+              << range.inputs.size() << " inputs";
+      cuda_graph_range_at_[begin] = static_cast<int>(cuda_graph_ranges_.size());
+      cuda_graph_ranges_.emplace_back(std::move(range));
+    }
+    begin = std::max(end, begin + 1);
+  }
+  if (cuda_graph_ranges_.empty()) {
+    cuda_graph_range_at_.clear();
+  }
+}
+
+bool PirInterpreter::RunCUDAGraphRange(CUDAGraphRange* range) {
+  if (range->disabled || platform::IsCUDAGraphCapturing() ||
+      FLAGS_check_nan_inf || FLAGS_enable_collect_shape ||
+      enable_job_schedule_profiler_ || !pir_input_hookfuncs_.empty() ||
+      !pir_output_hookfuncs_.empty()) {
+    return false;
+  }
+
+  // The graph is keyed by the dtype and dims of every input.
+  std::vector<int64_t> key;
+  for (auto* var : range->inputs) {
+    if (!var->IsType<phi::DenseTensor>()) {
+      return false;
+    }
+    const auto& tensor = var->Get<phi::DenseTensor>();
+    if (!tensor.initialized() || !tensor.meta().is_contiguous() ||
+        tensor.place() != place_) {
+      return false;
+    }
+    key.push_back(static_cast<int64_t>(tensor.dtype()));
+    key.push_back(tensor.dims().size());
+    for (int i = 0; i < tensor.dims().size(); ++i) {
+      key.push_back(tensor.dims()[i]);
+    }
+  }
+
+  auto graph_it = range->graphs.find(key);
+  if (graph_it == range->graphs.end()) {
+    // Run once before capturing, so that the lazy initialization of the
+    // kernels, e.g. handles and autotune, is done out of the capture.
+    if (range->warmup_keys.insert(key).second ||
+        range->graphs.size() >= kMaxCUDAGraphsPerRange) {
+      return false;
+    }
+    return CaptureCUDAGraphRange(range, key);
+  }
+
+  auto& graph = graph_it->second;
+  for (size_t i = 0; i < range->inputs.size(); ++i) {
+    if (range->is_persistable[i] &&
+        range->inputs[i]->Get<phi::DenseTensor>().data() !=
+            graph.persistable_data[i]) {
+      VLOG(4) << "A persistable input of CUDA Graph range [" << range->begin
+              << ", " << range->end << ") is moved, capture it again";
+      range->graphs.erase(graph_it);
+      return false;
+    }
+  }
+
+  auto* dev_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(place_));
+  for (size_t i = 0; i < range->inputs.size(); ++i) {
+    if (range->is_persistable[i]) {
+      continue;
+    }
+    auto* tensor = range->inputs[i]->GetMutable<phi::DenseTensor>();
+    auto& staging = graph.staging[i];
+    if (tensor->data() != staging.data()) {
+      memory::Copy(place_,
+                   staging.data(),
+                   place_,
+                   tensor->data(),
+                   tensor->numel() * phi::SizeOf(tensor->dtype()),
+                   dev_ctx->stream());
+      tensor->ShareDataWith(staging);
+    }
+  }
+  graph.graph->Replay();
+  for (auto& pair : graph.outputs) {
+    pair.first->GetMutable<phi::DenseTensor>()->ShareDataWith(pair.second);
+  }
+  for (size_t pos = range->begin; pos < range->end; ++pos) {
+    CheckGC(vec_instruction_base_[trace_execute_order_[pos]].get());
+  }
+  return true;
+}
+
+void PirInterpreter::StageCUDAGraphInputs(
+    CUDAGraphRange* range, std::vector<phi::DenseTensor>* staging) {
+  // The graph reads the non-persistable inputs from buffers it owns, the
+  // inputs are copied into them before each replay.
+  auto* dev_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(place_));
+  staging->resize(range->inputs.size());
+  for (size_t i = 0; i < range->inputs.size(); ++i) {
+    if (range->is_persistable[i]) {
+      continue;
+    }
+    auto* tensor = range->inputs[i]->GetMutable<phi::DenseTensor>();
+    phi::Copy(*dev_ctx, *tensor, place_, false, &(*staging)[i]);
+    tensor->ShareDataWith((*staging)[i]);
+  }
+}
+
+bool PirInterpreter::CaptureCUDAGraphRange(CUDAGraphRange* range,
+                                           const std::vector<int64_t>& key) {
+  CUDAGraphRange::Graph graph;
+  StageCUDAGraphInputs(range, &graph.staging);
+  graph.persistable_data.resize(range->inputs.size(), nullptr);
+  for (size_t i = 0; i < range->inputs.size(); ++i) {
+    if (range->is_persistable[i]) {
+      graph.persistable_data[i] =
+          range->inputs[i]->Get<phi::DenseTensor>().data();
+    }
+  }
+
+  // The gc of the range is done after the capture, so that the range can
+  // still run instruction by instruction when the capture fails.
+  bool captured = true;
+  platform::BeginCUDAGraphCapture(place_,
+                                 phi::gpuStreamCaptureModeThreadLocal);
+  try {
+    for (size_t pos = range->begin; pos < range->end; ++pos) {
+      vec_instruction_base_[trace_execute_order_[pos]]->Run();
+    }
+  } catch (std::exception& ex) {
+    VLOG(1) << "Fail to capture CUDA Graph range [" << range->begin << ", "
+            << range->end << "): " << ex.what();
+    captured = false;
+  }
+  try {
+    graph.graph = platform::EndCUDAGraphCapture();
+  } catch (std::exception& ex) {
+    VLOG(1) << "Fail to end the capture of CUDA Graph range ["
+            << range->begin << ", " << range->end << "): " << ex.what();
+    captured = false;
+  }
+
+  if (!captured) {
+    // Drop the buffers allocated from the memory pool of the graph.
+    std::unordered_set<Variable*> inputs(range->inputs.begin(),
+                                         range->inputs.end());
+    for (auto* var : range->written) {
+      if (inputs.count(var) == 0 && var->IsType<phi::DenseTensor>()) {
+        var->GetMutable<phi::DenseTensor>()->clear();
+      }
+    }
+    graph.graph.reset();
+    // Clear the sticky error of the failed capture.
+    platform::GpuGetLastError();
+    LOG(WARNING) << "CUDA Graph range [" << range->begin << ", "
+                 << range->end << ") can not be captured, it runs "
+                 << "instruction by instruction from now on";
+    range->disabled = true;
+    return false;
+  }
+
+  graph.graph->Replay();
+  for (size_t pos = range->begin; pos < range->end; ++pos) {
+    CheckGC(vec_instruction_base_[trace_execute_order_[pos]].get());
+  }
+  // Only the written vars kept by gc are seen after the range.
+  for (auto* var : range->written) {
+    if (var->IsType<phi::DenseTensor>() &&
+        var->Get<phi::DenseTensor>().initialized()) {
+      graph.outputs.emplace_back(var, var->Get<phi::DenseTensor>());
+    }
+  }
+  VLOG(4) << "Capture CUDA Graph range [" << range->begin << ", "
+          << range->end << ") with " << graph.outputs.size() << " outputs";
+  range->graphs.emplace(key, std::move(graph));
+  return true;
+}
+
+using phi::funcs::ElementwiseChainOpCode;
+
+static bool GetElementwiseChainOpCode(const std::string& name,
+                                      ElementwiseChainOpCode* code) {
+  static const std::unordered_map<std::string, ElementwiseChainOpCode> kOps = {
+      {"pd_op.add", ElementwiseChainOpCode::kAdd},
+      {"pd_op.subtract", ElementwiseChainOpCode::kSubtract},
+      {"pd_op.multiply", ElementwiseChainOpCode::kMultiply},
+      {"pd_op.divide", ElementwiseChainOpCode::kDivide},
+      {"pd_op.maximum", ElementwiseChainOpCode::kMaximum},
+      {"pd_op.minimum", ElementwiseChainOpCode::kMinimum},
+      {"pd_op.relu", ElementwiseChainOpCode::kRelu},
+      {"pd_op.exp", ElementwiseChainOpCode::kExp},
+      {"pd_op.sqrt", ElementwiseChainOpCode::kSqrt},
+      {"pd_op.tanh", ElementwiseChainOpCode::kTanh},
+      {"pd_op.sigmoid", ElementwiseChainOpCode::kSigmoid},
+      {"pd_op.abs", ElementwiseChainOpCode::kAbs},
+      {"pd_op.square", ElementwiseChainOpCode::kSquare},
+  };
+  auto it = kOps.find(name);
+  if (it == kOps.end()) {
+    return false;
+  }
+  *code = it->second;
+  return true;
+}
+
+void PirInterpreter::BuildElementwiseChains() {
+  elementwise_chain_at_.assign(trace_execute_order_.size(), -1);
+  const phi::DeviceContext* default_ctx =
+      phi::DeviceContextPool::Instance().Get(place_);
+  const auto& var_list = value_exe_info_->GetVarList();
+
+  // The positions run by CUDA Graph are left to it.
+  std::vector<bool> in_cuda_graph(trace_execute_order_.size(), false);
+  for (auto& range : cuda_graph_ranges_) {
+    for (size_t pos = range.begin; pos < range.end; ++pos) {
+      in_cuda_graph[pos] = true;
+    }
+  }
+
+  auto is_dense_tensor = [this](::pir::Value value) {
+    return value && value.type() &&
+           value.type().isa<paddle::dialect::AllocatedDenseTensorType>() &&
+           value_exe_info_->HasValue(value);
+  };
+  // Inplace ops are not fused, so every result is a new var.
+  auto is_fusible = [&](InstructionBase* instr, ElementwiseChainOpCode* code) {
+    if (dynamic_cast<PhiKernelInstruction*>(instr) == nullptr ||
+        instr->IsArtificial() || instr->IsSyncAfterLaunch() ||
+        instr->KernelType() != OpFuncType::kGpuAsync ||
+        &instr->DeviceContext() != default_ctx ||
+        !instr->EventsToWait().empty() || instr->EventToRecord() != nullptr ||
+        !GetElementwiseChainOpCode(instr->Name(), code)) {
+      return false;
+    }
+    ::pir::Operation* op = instr->Operation();
+    uint32_t operand_num =
+        phi::funcs::IsBinaryElementwiseChainOp(*code) ? 2 : 1;
+    if (op->num_operands() != operand_num || op->num_results() != 1 ||
+        !is_dense_tensor(op->result(0))) {
+      return false;
+    }
+    for (uint32_t i = 0; i < operand_num; ++i) {
+      if (!is_dense_tensor(op->operand_source(i))) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Builds the program of [begin, end), a result is an output unless all the
+  // instructions checking it for gc are in the chain.
+  auto make_chain = [&](size_t begin,
+                        size_t end,
+                        const std::vector<ElementwiseChainOpCode>& codes,
+                        ElementwiseChain* chain) {
+    std::unordered_set<size_t> chain_instrs;
+    for (size_t pos = begin; pos < end; ++pos) {
+      chain_instrs.insert(trace_execute_order_[pos]);
+    }
+    chain->begin = begin;
+    chain->end = end;
+    chain->program = phi::funcs::ElementwiseChainProgram();
+    chain->inputs.clear();
+    chain->outputs.clear();
+
+    std::unordered_map<int, uint8_t> reg_of;
+    for (size_t pos = begin; pos < end; ++pos) {
+      ::pir::Operation* op =
+          vec_instruction_base_[trace_execute_order_[pos]]->Operation();
+      for (uint32_t i = 0; i < op->num_operands(); ++i) {
+        int id = value_exe_info_->GetVarId(op->operand_source(i));
+        if (reg_of.count(id) == 0) {
+          if (chain->inputs.size() >=
+              static_cast<size_t>(phi::funcs::kMaxElementwiseChainInputs)) {
+            return false;
+          }
+          reg_of[id] = static_cast<uint8_t>(chain->inputs.size());
+          chain->inputs.push_back(var_list[id]);
+        }
+      }
+      // Set a placeholder, so that a later use is not taken as an input.
+      reg_of[value_exe_info_->GetVarId(op->result(0))] = 0;
+    }
+
+    auto& program = chain->program;
+    program.input_num = static_cast<int>(chain->inputs.size());
+    for (size_t pos = begin; pos < end; ++pos) {
+      ::pir::Operation* op =
+          vec_instruction_base_[trace_execute_order_[pos]]->Operation();
+      auto& chain_op = program.ops[program.op_num];
+      chain_op.code = codes[pos - begin];
+      chain_op.x = reg_of.at(value_exe_info_->GetVarId(op->operand_source(0)));
+      chain_op.y =
+          op->num_operands() > 1
+              ? reg_of.at(value_exe_info_->GetVarId(op->operand_source(1)))
+              : 0;
+      int out_id = value_exe_info_->GetVarId(op->result(0));
+      uint8_t out_reg =
+          static_cast<uint8_t>(program.input_num + program.op_num);
+      reg_of[out_id] = out_reg;
+      ++program.op_num;
+
+      auto live_it = last_live_ops_.find(out_id);
+      bool dies_in_chain = live_it != last_live_ops_.end() &&
+                           !live_it->second.empty() &&
+                           std::all_of(live_it->second.begin(),
+                                       live_it->second.end(),
+                                       [&](size_t instr_id) {
+                                         return chain_instrs.count(instr_id);
+                                       });
+      if (!dies_in_chain) {
+        if (program.output_num >= phi::funcs::kMaxElementwiseChainOutputs) {
+          return false;
+        }
+        program.outputs[program.output_num++] = out_reg;
+        chain->outputs.push_back(var_list[out_id]);
+      }
+    }
+    return program.output_num > 0;
+  };
+
+  const size_t max_ops =
+      static_cast<size_t>(phi::funcs::kMaxElementwiseChainOps);
+  size_t begin = 0;
+  while (begin < trace_execute_order_.size()) {
+    ElementwiseChain chain, best;
+    bool found = false;
+    std::vector<ElementwiseChainOpCode> codes;
+    std::unordered_set<int> written;
+    for (size_t end = begin;
+         end < trace_execute_order_.size() && !in_cuda_graph[end] &&
+         codes.size() < max_ops;
+         ++end) {
+      InstructionBase* instr =
+          vec_instruction_base_[trace_execute_order_[end]].get();
+      ElementwiseChainOpCode code;
+      if (!is_fusible(instr, &code)) {
+        break;
+      }
+      // Only the instructions reading the results of the chain join it.
+      ::pir::Operation* op = instr->Operation();
+      bool connected = codes.empty();
+      for (uint32_t i = 0; i < op->num_operands(); ++i) {
+        connected = connected || written.count(value_exe_info_->GetVarId(
+                                     op->operand_source(i))) > 0;
+      }
+      if (!connected) {
+        break;
+      }
+      codes.push_back(code);
+      written.insert(value_exe_info_->GetVarId(op->result(0)));
+      if (codes.size() >= 2 && make_chain(begin, end + 1, codes, &chain)) {
+        best = chain;
+        found = true;
+      }
+    }
+    if (!found) {
+      ++begin;
+      continue;
+    }
+    VLOG(4) << "Elementwise chain [" << best.begin << ", " << best.end
+            << ") has " << best.inputs.size() << " inputs and "
+            << best.outputs.size() << " outputs";
+    elementwise_chain_at_[best.begin] =
+        static_cast<int>(elementwise_chains_.size());
+    begin = best.end;
+    elementwise_chains_.emplace_back(std::move(best));
+  }
+  if (elementwise_chains_.empty()) {
+    elementwise_chain_at_.clear();
+  }
+}
+
+bool PirInterpreter::RunElementwiseChain(const ElementwiseChain& chain) {
+  if (FLAGS_check_nan_inf || FLAGS_enable_collect_shape ||
+      enable_job_schedule_profiler_ || !pir_input_hookfuncs_.empty() ||
+      !pir_output_hookfuncs_.empty()) {
+    return false;
+  }
+
+  // Shapes may be dynamic, the chain runs only when all its inputs have the
+  // same dtype and dims this time.
+  std::vector<const phi::DenseTensor*> inputs;
+  for (auto* var : chain.inputs) {
+    if (!var->IsType<phi::DenseTensor>()) {
+      return false;
+    }
+    const auto& tensor = var->Get<phi::DenseTensor>();
+    if (!tensor.initialized() || !tensor.meta().is_contiguous() ||
+        tensor.place() != place_ ||
+        !phi::funcs::IsElementwiseChainSupported(tensor.dtype())) {
+      return false;
+    }
+    if (!inputs.empty() && (tensor.dtype() != inputs[0]->dtype() ||
+                            tensor.dims() != inputs[0]->dims())) {
+      return false;
+    }
+    inputs.push_back(&tensor);
+  }
+  std::vector<phi::DenseTensor*> outputs;
+  for (auto* var : chain.outputs) {
+    outputs.push_back(var->GetMutable<phi::DenseTensor>());
+  }
+
+  auto* dev_ctx = static_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(place_));
+  phi::funcs::LaunchElementwiseChain(*dev_ctx, chain.program, inputs, outputs);
+  for (size_t pos = chain.begin; pos < chain.end; ++pos) {
+    InstructionBase* instr =
+        vec_instruction_base_[trace_execute_order_[pos]].get();
+    RecordStreamForGC(instr);
+    CheckGC(instr);
+  }
+  return true;
+}
+#endif
+
 void PirInterpreter::ClearLoDTensorArrayInLocalScope() {
   auto vars = local_scope_->LocalVars();
   for (auto var : vars) {
@@ -774,6 +1290,105 @@ void PirInterpreter::AnalyseExecuteOrderForTrace(
   }
 }
 
+// The cost of an instruction is estimated by the number of elements it
+// writes, which is known ahead of time for static shapes.
+static int64_t EstimateInstructionCost(const InstructionBase* instr) {
+  int64_t cost = 1;
+  ::pir::Operation* op = instr->Operation();
+  if (op == nullptr || instr->IsArtificial()) {
+    return cost;
+  }
+  for (uint32_t i = 0; i < op->num_results(); ++i) {
+    auto value = op->result(i);
+    if (!value || !value.type() ||
+        !value.type().isa<paddle::dialect::AllocatedDenseTensorType>()) {
+      continue;
+    }
+    auto dims =
+        value.type().dyn_cast<paddle::dialect::AllocatedDenseTensorType>()
+            .dims();
+    int64_t numel = 1;
+    for (int d = 0; d < dims.size(); ++d) {
+      numel *= std::max<int64_t>(dims[d], 1);
+    }
+    cost += numel;
+  }
+  return cost;
+}
+
+void PirInterpreter::AnalyzeCriticalPathPriority() {
+  size_t instr_num = vec_instruction_base_.size();
+  const std::map<size_t, std::set<size_t>>& downstream_map =
+      ir_dependency_builder_.OpDownstreamMap();
+
+  // topological order by Kahn's algorithm
+  std::vector<size_t> in_degree(instr_num, 0);
+  for (auto& pair : downstream_map) {
+    for (size_t next_id : pair.second) {
+      ++in_degree[next_id];
+    }
+  }
+  std::vector<size_t> order;
+  order.reserve(instr_num);
+  for (size_t id = 0; id < instr_num; ++id) {
+    if (in_degree[id] == 0) {
+      order.push_back(id);
+    }
+  }
+  for (size_t i = 0; i < order.size(); ++i) {
+    auto it = downstream_map.find(order[i]);
+    if (it == downstream_map.end()) {
+      continue;
+    }
+    for (size_t next_id : it->second) {
+      if (--in_degree[next_id] == 0) {
+        order.push_back(next_id);
+      }
+    }
+  }
+  PADDLE_ENFORCE_EQ(order.size(),
+                    instr_num,
+                    common::errors::PreconditionNotMet(
+                        "The dependency graph of instructions has a cycle, "
+                        "only %d of %d instructions are sorted.",
+                        order.size(),
+                        instr_num));
+
+  // upward rank: the cost of the longest path from an instruction to a sink
+  std::vector<int64_t> rank(instr_num, 0);
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    int64_t max_next_rank = 0;
+    auto next_it = downstream_map.find(*it);
+    if (next_it != downstream_map.end()) {
+      for (size_t next_id : next_it->second) {
+        max_next_rank = std::max(max_next_rank, rank[next_id]);
+      }
+    }
+    rank[*it] =
+        EstimateInstructionCost(vec_instruction_base_[*it].get()) +
+        max_next_rank;
+  }
+
+  // Lower value, higher priority. The priority set by users is kept, and the
+  // communication instructions are put ahead of all the others.
+  constexpr int64_t kCommunicationPriority =
+      std::numeric_limits<int64_t>::min() / 2;
+  for (size_t id = 0; id < instr_num; ++id) {
+    InstructionBase* instr = vec_instruction_base_[id].get();
+    ::pir::Operation* op = instr->Operation();
+    if (op != nullptr && op->HasAttribute("scheduling_priority")) {
+      continue;
+    }
+    if (op != nullptr && interpreter::IsCommunicationOp(op)) {
+      instr->SetSchedulingPriority(kCommunicationPriority - rank[id]);
+    } else {
+      instr->SetSchedulingPriority(-rank[id]);
+    }
+    VLOG(6) << "Instruction " << instr->Name() << "[" << id
+            << "] has upward rank " << rank[id];
+  }
+}
+
 void PirInterpreter::AnalyzeForceSyncOps() {
   for (auto& ins : vec_instruction_base_) {
     ins->SetSyncAfterLaunch(FLAGS_benchmark);
@@ -802,7 +1417,10 @@ void PirInterpreter::AnalyzeForceSyncOps() {
 }
 
 void PirInterpreter::BuildInstruction() {
+  common::StartupTraceScope startup_trace("ExecutorBuild",
+                                          "PirInterpreter::BuildInstruction");
   VLOG(6) << "Build Instructions for pir ... ";
+  op_latency_recorder_.reset();
   vec_instruction_base_.clear();
   size_t op_idx = 0;
   for (auto& op : *ir_block_) {
@@ -1300,6 +1918,11 @@ void PirInterpreter::CheckGC(InstructionBase* instr) {
               << " is a parameter, skip gc";
       continue;
     }
+    // the holder of a planned var is a view of the static memory arena
+    if (static_memory_planner_ &&
+        static_memory_planner_->Has(static_cast<int>(var_id))) {
+      continue;
+    }
 
     if (is_ready) {
       VLOG(6) << "Async delete variable with name : "
@@ -1316,6 +1939,20 @@ void PirInterpreter::CheckGC(InstructionBase* instr) {
 
 void PirInterpreter::CalculateLastLiveOps() {
   VLOG(4) << "PirInterpreter(): " << this << " start CalculateLastLiveOps";
+  if (build_result_loaded_) {
+    // last_live_ops_ is loaded from the build result cache.
+    var_ref_count_.resize(value_exe_info_->GetVarList().size());
+    for (auto& pair : last_live_ops_) {
+      for (size_t op_idx : pair.second) {
+        vec_instruction_base_[op_idx]->AddGCCheckVar(pair.first);
+      }
+      var_ref_count_[pair.first] = static_cast<int>(pair.second.size());
+    }
+    InitDepsAndRefs();
+    VLOG(4) << "done CalculateLastLiveOps with the loaded GC schedule";
+    return;
+  }
+
   // calculate last_live_ops_
   for (size_t op_idx = 0; op_idx < vec_instruction_base_.size(); ++op_idx) {
     InstructionBase* instr = vec_instruction_base_[op_idx].get();
@@ -1422,6 +2059,11 @@ void PirInterpreter::CalculateLastLiveOps() {
   }
   VLOG(4) << "shrink the last_live_ops list for all vars in skip_gc_vars";
 
+  InitDepsAndRefs();
+  VLOG(4) << "done CalculateLastLiveOps";
+}
+
+void PirInterpreter::InitDepsAndRefs() {
   for (auto& dep : *dependency_count_) {
     deps_.emplace_back(std::make_shared<interpreter::OpDepInfo>(dep));
   }
@@ -1429,7 +2071,323 @@ void PirInterpreter::CalculateLastLiveOps() {
     refs_.emplace_back(std::make_shared<interpreter::VarRefInfo>(
         var_ref_count_[i], value_exe_info_->GetVarList()[i]));
   }
-  VLOG(4) << "done CalculateLastLiveOps";
+}
+
+uint64_t PirInterpreter::BuildResultSignature() const {
+  // Everything the dependency, event and GC analysis read from the
+  // instructions, so that a loaded result is always the one that would be
+  // built.
+  interpreter::BuildSignatureHasher hasher;
+  hasher.Update(place_.DebugString());
+  hasher.Update(static_cast<uint64_t>(FLAGS_new_executor_sequential_run));
+  hasher.Update(
+      static_cast<uint64_t>(FLAGS_add_dependency_for_communication_op));
+  for (auto& skip_gc_var : execution_config_.skip_gc_vars) {
+    hasher.Update(skip_gc_var);
+  }
+  const auto& var_list = value_exe_info_->GetVarList();
+  hasher.Update(static_cast<uint64_t>(var_list.size()));
+  for (auto* var : var_list) {
+    hasher.Update(var->IsInitialized() ? static_cast<uint64_t>(var->Type())
+                                       : UINT64_MAX);
+  }
+
+  // Streams are numbered by the order they first appear.
+  std::unordered_map<const phi::DeviceContext*, size_t> streams;
+  auto hash_values =
+      [&hasher](const std::unordered_map<::pir::Value, std::vector<int>>& vars,
+                const std::unordered_set<::pir::Value>* no_need_buffer) {
+        std::vector<std::pair<std::vector<int>, bool>> ids;
+        for (auto& pair : vars) {
+          ids.emplace_back(pair.second,
+                           no_need_buffer && no_need_buffer->count(pair.first));
+        }
+        // The order of an unordered_map differs between processes.
+        std::sort(ids.begin(), ids.end());
+        hasher.Update(static_cast<uint64_t>(ids.size()));
+        for (auto& item : ids) {
+          hasher.Update(static_cast<uint64_t>(item.second));
+          hasher.Update(static_cast<uint64_t>(item.first.size()));
+          for (int id : item.first) {
+            hasher.Update(static_cast<uint64_t>(id));
+          }
+        }
+      };
+  hasher.Update(static_cast<uint64_t>(vec_instruction_base_.size()));
+  for (auto& instr : vec_instruction_base_) {
+    hasher.Update(instr->Name());
+    hasher.Update(static_cast<uint64_t>(instr->KernelType()));
+    auto stream = streams.emplace(&instr->DeviceContext(), streams.size());
+    hasher.Update(static_cast<uint64_t>(stream.first->second));
+    hash_values(instr->Inputs(), &instr->NoNeedBuffer());
+    hash_values(instr->Outputs(), nullptr);
+  }
+  return hasher.Digest();
+}
+
+bool PirInterpreter::LoadBuildResult(uint64_t signature) {
+  interpreter::PirBuildResult result;
+  if (!interpreter::LoadPirBuildResult(
+          interpreter::PirBuildResultPath(FLAGS_pir_interpreter_build_cache_dir,
+                                          signature),
+          signature,
+          vec_instruction_base_.size(),
+          &result)) {
+    return false;
+  }
+  if (!result.last_live_ops.empty() &&
+      result.last_live_ops.rbegin()->first >=
+          value_exe_info_->GetVarList().size()) {
+    LOG(WARNING) << "The loaded build result does not match the variables, "
+                    "the program will be analysed again";
+    return false;
+  }
+
+  std::map<const phi::DeviceContext*, std::map<size_t, std::set<size_t>>>
+      event_info;
+  for (auto& pair : result.event_info) {
+    event_info[&vec_instruction_base_[pair.first]->DeviceContext()] =
+        std::move(pair.second);
+  }
+  ir_dependency_builder_.LoadDependency(std::move(result.downstream_map),
+                                        std::move(result.happens_before));
+  ir_stream_analyzer_.LoadEventInfo(std::move(event_info));
+  last_live_ops_ = std::move(result.last_live_ops);
+  VLOG(4) << "PirInterpreter(): " << this
+          << " loads the build result of signature " << signature;
+  return true;
+}
+
+void PirInterpreter::SaveBuildResult(uint64_t signature) const {
+  interpreter::PirBuildResult result;
+  result.signature = signature;
+  result.instr_num = vec_instruction_base_.size();
+  auto dependency = ir_dependency_builder_.GetDependency();
+  result.downstream_map = *std::get<0>(dependency);
+  result.happens_before = *std::get<1>(dependency);
+
+  std::unordered_map<const phi::DeviceContext*, size_t> streams;
+  for (size_t i = 0; i < vec_instruction_base_.size(); ++i) {
+    streams.emplace(&vec_instruction_base_[i]->DeviceContext(), i);
+  }
+  for (auto& pair : *ir_stream_analyzer_.GetEventInfo()) {
+    auto stream = streams.find(pair.first);
+    if (stream == streams.end()) {
+      VLOG(4) << "Skip saving the build result, since an event is recorded "
+                 "on a stream without instructions";
+      return;
+    }
+    result.event_info[stream->second] = pair.second;
+  }
+  result.last_live_ops = last_live_ops_;
+
+  try {
+    interpreter::SavePirBuildResult(
+        interpreter::PirBuildResultPath(FLAGS_pir_interpreter_build_cache_dir,
+                                        signature),
+        result);
+  } catch (std::exception& ex) {
+    // The cache is only an optimization of the next start.
+    LOG(WARNING) << "Fail to save the build result: " << ex.what();
+  }
+}
+
+void PirInterpreter::BuildStaticMemoryPlan() {
+  static_memory_planner_.reset();
+  static_memory_arena_.reset();
+  static_memory_views_.clear();
+
+  // Ops with sub blocks may access any var of this block through the scope,
+  // the lifetime of a var is unknown from the block alone in that case.
+  std::unordered_map<::pir::Operation*, size_t> op_to_position;
+  for (size_t pos = 0; pos < trace_execute_order_.size(); ++pos) {
+    InstructionBase* instr =
+        vec_instruction_base_[trace_execute_order_[pos]].get();
+    if (instr->Operation()->num_regions() > 0) {
+      VLOG(4) << "Skip static memory plan since " << instr->Name()
+              << " has sub blocks";
+      return;
+    }
+    if (dynamic_cast<PhiKernelInstruction*>(instr) != nullptr) {
+      op_to_position[instr->Operation()] = pos;
+    }
+  }
+
+  // Vars that share the holder with another var, or are read from the scope
+  // by name, can not live in the arena.
+  std::unordered_set<const Variable*> aliased_vars;
+  for (auto& instr : vec_instruction_base_) {
+    for (auto& pair : instr->InplaceInfo()) {
+      aliased_vars.insert(pair.first);
+      aliased_vars.insert(pair.second);
+    }
+  }
+  std::unordered_set<std::string> pinned_names(fetch_var_names_.begin(),
+                                               fetch_var_names_.end());
+  pinned_names.insert(parameter_var_names_.begin(),
+                      parameter_var_names_.end());
+  pinned_names.insert(execution_config_.skip_gc_vars.begin(),
+                      execution_config_.skip_gc_vars.end());
+  pinned_names.insert(execution_config_.jit_input_vars.begin(),
+                      execution_config_.jit_input_vars.end());
+
+  // All planned vars must be produced and consumed on one stream, since the
+  // arena is reused without any event between ops.
+  const phi::DeviceContext* plan_ctx = nullptr;
+  std::unordered_map<int, size_t> var_value_count;
+  std::vector<std::tuple<int, size_t, size_t, size_t>> candidates;
+  for (size_t pos = 0; pos < trace_execute_order_.size(); ++pos) {
+    InstructionBase* instr =
+        vec_instruction_base_[trace_execute_order_[pos]].get();
+    for (auto& item : instr->Outputs()) {
+      ::pir::Value value = item.first;
+      for (auto var_id : item.second) {
+        ++var_value_count[var_id];
+      }
+      if (!op_to_position.count(instr->Operation()) ||
+          item.second.size() != 1 ||
+          !value.type().isa<paddle::dialect::AllocatedDenseTensorType>()) {
+        continue;
+      }
+      auto type =
+          value.type().dyn_cast<paddle::dialect::AllocatedDenseTensorType>();
+      if (type.place() != place_ || common::contain_unknown_dim(type.dims()) ||
+          common::product(type.dims()) <= 0) {
+        continue;
+      }
+      int var_id = item.second[0];
+      Variable* var = value_exe_info_->GetVarList()[var_id];
+      if (aliased_vars.count(var) || !var->IsType<phi::DenseTensor>() ||
+          pinned_names.count(value_exe_info_->GetNameById(var_id))) {
+        continue;
+      }
+      const phi::DeviceContext* ctx = &instr->DeviceContext();
+      if (plan_ctx == nullptr) {
+        plan_ctx = ctx;
+      }
+      if (ctx != plan_ctx) {
+        continue;
+      }
+      size_t last_use = pos;
+      bool plannable = true;
+      for (auto it = value.use_begin(); it != value.use_end(); ++it) {
+        auto user = op_to_position.find(it->owner());
+        if (user == op_to_position.end() ||
+            &vec_instruction_base_[trace_execute_order_[user->second]]
+                     ->DeviceContext() != plan_ctx) {
+          plannable = false;
+          break;
+        }
+        last_use = std::max(last_use, user->second);
+      }
+      if (!plannable) {
+        continue;
+      }
+      size_t size =
+          static_cast<size_t>(common::product(type.dims())) *
+          phi::SizeOf(paddle::dialect::TransToPhiDataType(type.dtype()));
+      candidates.emplace_back(var_id, size, pos, last_use);
+    }
+  }
+
+  auto planner = std::make_unique<interpreter::StaticMemoryPlanner>();
+  for (auto& [var_id, size, first_use, last_use] : candidates) {
+    // a var written by several ops is not a single buffer
+    if (var_value_count[var_id] == 1) {
+      planner->AddBuffer(var_id, size, first_use, last_use);
+    }
+  }
+  if (planner->BufferNum() == 0) {
+    return;
+  }
+  planner->Plan();
+  VLOG(1) << "PirInterpreter(): " << this << " plans "
+          << planner->BufferNum() << " tensors into an arena of "
+          << planner->ArenaSize() << " bytes, "
+          << planner->TotalBufferSize() << " bytes without reuse";
+  static_memory_planner_ = std::move(planner);
+}
+
+void PirInterpreter::BuildCompiledTrace() {
+  compiled_trace_.reserve(trace_execute_order_.size());
+  size_t direct_num = 0;
+  for (auto instr_id : trace_execute_order_) {
+    InstructionBase* instr = vec_instruction_base_[instr_id].get();
+    CompiledTraceStep step;
+    step.instr = instr;
+
+    auto* phi_instr = dynamic_cast<PhiKernelInstruction*>(instr);
+    // Inplace ops share the buffer in Run, and ops on another device need
+    // to switch the device, they keep running through RunInstructionBase.
+    if (phi_instr != nullptr && !instr->IsArtificial() &&
+        instr->InplaceInfo().empty() &&
+        instr->DeviceContext().GetPlace() == place_) {
+      step.kernel = phi_instr->PhiKernel();
+      step.kernel_context = phi_instr->MutableKernelContext();
+      if (phi_instr->InferMetaInterface() != nullptr) {
+        step.infer_meta_instr = phi_instr;
+      }
+      step.wait_event = !instr->EventsToWait().empty();
+      step.record_event = instr->EventToRecord() != nullptr;
+      step.sync_after_launch = instr->IsSyncAfterLaunch();
+
+      step.gc_begin = compiled_gc_vars_.size();
+      for (auto var_id : instr->GCCheckVars()) {
+        int id = static_cast<int>(var_id);
+        if (parameter_var_names_.count(value_exe_info_->GetNameById(id)) ||
+            (static_memory_planner_ && static_memory_planner_->Has(id))) {
+          continue;
+        }
+        compiled_gc_vars_.push_back(var_id);
+      }
+      step.gc_end = compiled_gc_vars_.size();
+      ++direct_num;
+    }
+    compiled_trace_.push_back(step);
+  }
+  VLOG(4) << "Compiled trace has " << compiled_trace_.size() << " steps, "
+          << direct_num << " of them call the phi kernel directly";
+}
+
+bool PirInterpreter::CanRunCompiledTrace() const {
+  // The compiled steps skip the per op debug and profiling hooks.
+  return !enable_job_schedule_profiler_ && !FLAGS_check_nan_inf &&
+         !FLAGS_enable_collect_shape && !FLAGS_low_precision_op_list &&
+         !FLAGS_print_kernel_run_info && !FLAGS_log_memory_stats &&
+         pir_input_hookfuncs_.empty() && pir_output_hookfuncs_.empty() &&
+         !phi::RecordEvent::IsEnabled() && !VLOG_IS_ON(2);
+}
+
+void PirInterpreter::BindStaticMemoryPlan() {
+  if (!static_memory_arena_) {
+    static_memory_arena_ =
+        memory::AllocShared(place_, static_memory_planner_->ArenaSize());
+    auto arena = static_memory_arena_;
+    auto* base = reinterpret_cast<uint8_t*>(arena->ptr());
+    for (size_t i = 0; i < value_exe_info_->GetVarList().size(); ++i) {
+      int var_id = static_cast<int>(i);
+      if (!static_memory_planner_->Has(var_id)) {
+        continue;
+      }
+      std::shared_ptr<phi::Allocation> view(
+          new phi::Allocation(
+              base + static_memory_planner_->Offset(var_id),
+              static_memory_planner_->Size(var_id),
+              place_),
+          [arena](phi::Allocation* allocation) { delete allocation; });
+      static_memory_views_.emplace_back(value_exe_info_->GetVarList()[i],
+                                        std::move(view));
+    }
+  }
+  // Kernels reuse the holder when it is large enough, rebind the view only
+  // when a kernel has replaced it.
+  for (auto& [var, view] : static_memory_views_) {
+    auto* tensor = var->GetMutable<phi::DenseTensor>();
+    if (tensor->Holder() != view) {
+      tensor->clear();
+      tensor->ResetHolder(view);
+    }
+  }
 }
 
 void PirInterpreter::ConstructEventForJitInput() {
@@ -1631,12 +2589,26 @@ void PirInterpreter::TraceRunImpl() {
   if (!gc_) {
     gc_ = CreateInterpreterCoreGarbageCollector(place_, vec_instruction_base_);
   }
+  if (!op_latency_recorder_ && OpLatencyMonitor::IsEnabled()) {
+    op_latency_recorder_ = std::make_unique<OpLatencyRecorder>(
+        vec_instruction_base_,
+        FLAGS_pir_interpreter_op_latency_sample_interval);
+  }
+
+  if (static_memory_planner_) {
+    BindStaticMemoryPlan();
+  }
 
   interpreter::ResetAtomicGuard guard(&deps_, &refs_);
   VLOG(4) << "Tracing Instruction List";
 
-  TraceRunInstructionList(vec_instruction_base_);
-  VLOG(4) << "Done TraceRunInstructionList";
+  if (!compiled_trace_.empty() && CanRunCompiledTrace()) {
+    CompiledTraceRunInstructionList();
+    VLOG(4) << "Done CompiledTraceRunInstructionList";
+  } else {
+    TraceRunInstructionList(vec_instruction_base_);
+    VLOG(4) << "Done TraceRunInstructionList";
+  }
 #ifdef PADDLE_WITH_CUSTOM_DEVICE
   if (phi::is_custom_place(place_)) {
     phi::DeviceContextPool::Instance().Get(place_)->Wait();
@@ -1649,6 +2621,11 @@ void PirInterpreter::MultiThreadRunImpl() {
   if (!gc_) {
     gc_ = CreateInterpreterCoreGarbageCollector(place_, vec_instruction_base_);
   }
+  if (!op_latency_recorder_ && OpLatencyMonitor::IsEnabled()) {
+    op_latency_recorder_ = std::make_unique<OpLatencyRecorder>(
+        vec_instruction_base_,
+        FLAGS_pir_interpreter_op_latency_sample_interval);
+  }
 
   interpreter::ResetAtomicGuard guard(&deps_, &refs_);
   VLOG(4) << "Multi Thread Run Instruction List";
@@ -1695,6 +2672,22 @@ void PirInterpreter::TraceRunInstructionList(
   }
 
   for (size_t idx = 0; idx < trace_execute_order_.size(); idx++) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (!cuda_graph_range_at_.empty() && cuda_graph_range_at_[idx] >= 0) {
+      auto& range = cuda_graph_ranges_[cuda_graph_range_at_[idx]];
+      if (RunCUDAGraphRange(&range)) {
+        idx = range.end - 1;
+        continue;
+      }
+    }
+    if (!elementwise_chain_at_.empty() && elementwise_chain_at_[idx] >= 0) {
+      auto& chain = elementwise_chains_[elementwise_chain_at_[idx]];
+      if (RunElementwiseChain(chain)) {
+        idx = chain.end - 1;
+        continue;
+      }
+    }
+#endif
     auto instr_id = trace_execute_order_[idx];
     InstructionBase* instr_node = vec_instruction_base_.at(instr_id).get();
 
@@ -1721,6 +2714,107 @@ void PirInterpreter::TraceRunInstructionList(
   VLOG(4) << "Done TraceRunInstructionList";
 }
 
+void PirInterpreter::CompiledTraceRunInstructionList() {
+  unfinished_op_number_ = compiled_trace_.size();
+  exception_holder_.Clear();
+
+  for (size_t i = 0; i < dependency_count_->size(); ++i) {
+    if ((*dependency_count_)[i] == 0) {
+      // NOTE(zhiqiu): hot fix for jit input var
+      RecordMemcpyD2H(vec_instruction_base_.at(i).get());
+    }
+  }
+
+  for (size_t pos = 0; pos < compiled_trace_.size(); ++pos) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (!cuda_graph_range_at_.empty() && cuda_graph_range_at_[pos] >= 0) {
+      auto& range = cuda_graph_ranges_[cuda_graph_range_at_[pos]];
+      if (RunCUDAGraphRange(&range)) {
+        pos = range.end - 1;
+        continue;
+      }
+    }
+    if (!elementwise_chain_at_.empty() && elementwise_chain_at_[pos] >= 0) {
+      auto& chain = elementwise_chains_[elementwise_chain_at_[pos]];
+      if (RunElementwiseChain(chain)) {
+        pos = chain.end - 1;
+        continue;
+      }
+    }
+#endif
+    const CompiledTraceStep& step = compiled_trace_[pos];
+    if (step.kernel == nullptr) {
+      RunInstructionBase(step.instr);
+      if (UNLIKELY(exception_holder_.IsCaught())) {
+        VLOG(1) << "Exception caught " << exception_holder_.Type();
+        exception_holder_.ReThrow();
+      }
+      // The instruction may run on another device.
+      SetDeviceId(place_);
+      continue;
+    }
+    try {
+      RunCompiledTraceStep(step);
+    } catch (platform::EnforceNotMet& ex) {
+      auto* op = step.instr->Operation();
+      const std::vector<std::string> op_callstack_attr =
+          interpreter::GetInstructionCallStack(op->name(), op->attributes());
+      framework::InsertCallStackInfo(op->name(), op_callstack_attr, &ex);
+      LOG(WARNING) << "Instruction OP id: " << step.instr->Id() << ", "
+                   << step.instr->Name()
+                   << " raises an EnforceNotMet exception "
+                   << common::demangle(typeid(ex).name());
+      throw;
+    }
+  }
+}
+
+void PirInterpreter::RunCompiledTraceStep(const CompiledTraceStep& step) {
+  InstructionBase* instr = step.instr;
+  if (step.wait_event) {
+    instr->WaitEvent(place_);
+  }
+  // The recorder times the same span as PhiKernelInstruction::Run.
+  uint64_t start_ns = 0;
+  if (op_latency_recorder_) {
+    start_ns = op_latency_recorder_->BeforeRun(instr);
+  }
+  if (step.infer_meta_instr != nullptr) {
+    step.infer_meta_instr->InferMeta();
+  }
+  (*step.kernel)(step.kernel_context);
+  if (op_latency_recorder_) {
+    op_latency_recorder_->AfterRun(instr, start_ns);
+  }
+
+  if (step.sync_after_launch) {
+    instr->DeviceContext().Wait();
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    PADDLE_ENFORCE_GPU_SUCCESS(platform::GpuGetLastError());
+#endif
+  }
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  RecordStreamForGC(instr);
+#endif
+  for (size_t i = step.gc_begin; i < step.gc_end; ++i) {
+    auto& ref = refs_[compiled_gc_vars_[i]];
+    if (ref->CheckAndDecrease()) {
+      gc_->Add(ref->Var(), instr);
+    }
+  }
+  if (!instr->EagerGCVars().empty()) {
+    for (auto var : instr->EagerGCVars()) {
+      gc_->Add(var, instr);
+    }
+    instr->ClearEagerGCVars();
+  }
+
+  if (step.record_event) {
+    instr->RecordEvent(place_);
+  }
+}
+
 void PirInterpreter::MultiThreadRunInstructionList(
     const std::vector<std::unique_ptr<InstructionBase>>& vec_instr) {
   unfinished_op_number_ = vec_instr.size();
@@ -1744,16 +2838,28 @@ void PirInterpreter::MultiThreadRunInstructionList(
     }
   }
 
+  std::vector<size_t> ready_ids;
   for (size_t i = 0; i < dependency_count_->size(); ++i) {
     if ((*dependency_count_)[i] == 0) {
-      // NOTE(zhiqiu): hot fix for jit input var
-      RecordMemcpyD2H(vec_instr.at(i).get());
-      if (FLAGS_new_executor_serial_run) {
-        RunInstructionBaseAsync(i);
-      } else {
-        async_work_queue_->AddTask(vec_instr.at(i)->KernelType(),
-                                   [this, i] { RunInstructionBaseAsync(i); });
-      }
+      ready_ids.push_back(i);
+    }
+  }
+  if (critical_path_scheduling_) {
+    // Dispatch the instruction with the highest priority first.
+    std::stable_sort(ready_ids.begin(),
+                     ready_ids.end(),
+                     [this](size_t lhs, size_t rhs) {
+                       return ir_instruction_scheduling_priority_less(rhs, lhs);
+                     });
+  }
+  for (size_t i : ready_ids) {
+    // NOTE(zhiqiu): hot fix for jit input var
+    RecordMemcpyD2H(vec_instr.at(i).get());
+    if (FLAGS_new_executor_serial_run) {
+      RunInstructionBaseAsync(i);
+    } else {
+      async_work_queue_->AddTask(vec_instr.at(i)->KernelType(),
+                                 [this, i] { RunInstructionBaseAsync(i); });
     }
   }
 
@@ -1860,12 +2966,33 @@ void PirInterpreter::RunNextInstructions(InstructionBase* instr,
     return deps_[next_id]->CheckAndDecrease();
   };
 
-  for (size_t next_instr_id : instr->NextInstrsInDifferenceThread()) {
-    if (IsReady(next_instr_id)) {
+  if (critical_path_scheduling_) {
+    std::vector<size_t> ready_ids;
+    for (size_t next_instr_id : instr->NextInstrsInDifferenceThread()) {
+      if (IsReady(next_instr_id)) {
+        ready_ids.push_back(next_instr_id);
+      }
+    }
+    std::stable_sort(ready_ids.begin(),
+                     ready_ids.end(),
+                     [this](size_t lhs, size_t rhs) {
+                       return ir_instruction_scheduling_priority_less(rhs, lhs);
+                     });
+    for (size_t next_instr_id : ready_ids) {
       async_work_queue_->AddTask(
           vec_instruction_base_[next_instr_id]->KernelType(),
           [this, next_instr_id]() { RunInstructionBaseAsync(next_instr_id); });
     }
+  } else {
+    for (size_t next_instr_id : instr->NextInstrsInDifferenceThread()) {
+      if (IsReady(next_instr_id)) {
+        async_work_queue_->AddTask(
+            vec_instruction_base_[next_instr_id]->KernelType(),
+            [this, next_instr_id]() {
+              RunInstructionBaseAsync(next_instr_id);
+            });
+      }
+    }
   }
 
   for (size_t next_instr_id : instr->NextInstrsInSameThread()) {
@@ -1878,6 +3005,8 @@ void PirInterpreter::RunNextInstructions(InstructionBase* instr,
 void PirInterpreter::RunInstructionBase(InstructionBase* instr_node) {
   phi::RecordEvent instruction_event(
       instr_node->Name(), phi::TracerEventType::Operator, 1);
+  memory::allocation::MemoryTimelineOpScope memory_timeline_op(
+      instr_node->Name().c_str());
 
   auto cur_place = instr_node->DeviceContext().GetPlace();
   SetDeviceId(cur_place);
@@ -1924,7 +3053,13 @@ void PirInterpreter::RunInstructionBase(InstructionBase* instr_node) {
       {
         phi::RecordEvent record(
             "InstrRun", phi::TracerEventType::UserDefined, 10);
-        instr_node->Run();
+        if (op_latency_recorder_) {
+          uint64_t start_ns = op_latency_recorder_->BeforeRun(instr_node);
+          instr_node->Run();
+          op_latency_recorder_->AfterRun(instr_node, start_ns);
+        } else {
+          instr_node->Run();
+        }
       }
 
       if (instr_node->IsSyncAfterLaunch()) {
@@ -2004,6 +3139,16 @@ void PirInterpreter::RunInstructionBase(InstructionBase* instr_node) {
 }
 
 void PirInterpreter::PreAnalysis() {
+  common::StartupTraceScope startup_trace("ExecutorBuild",
+                                          "PirInterpreter::PreAnalysis");
+  bool use_build_cache = !FLAGS_pir_interpreter_build_cache_dir.empty() &&
+                         !is_shared_results_build_;
+  uint64_t build_result_signature = 0;
+  if (use_build_cache) {
+    build_result_signature = BuildResultSignature();
+    build_result_loaded_ = LoadBuildResult(build_result_signature);
+  }
+
   BuildInstructionDependences();
   VLOG(4) << "Done BuildInstructionDependences";
 
@@ -2019,6 +3164,11 @@ void PirInterpreter::PreAnalysis() {
   CalculateLastLiveOps();
   VLOG(4) << "Done CalculateLastLiveOps";
 
+  if (use_build_cache && !build_result_loaded_) {
+    SaveBuildResult(build_result_signature);
+    VLOG(4) << "Done SaveBuildResult";
+  }
+
   if (VLOG_IS_ON(2)) {
     std::vector<std::string> instr_debug_info = DebugInfo();
     for (auto& item : instr_debug_info) {
@@ -2026,6 +3176,21 @@ void PirInterpreter::PreAnalysis() {
     }
   }
 
+  critical_path_scheduling_ =
+      FLAGS_pir_interpreter_scheduling_policy == "critical_path";
+  if (critical_path_scheduling_) {
+    AnalyzeCriticalPathPriority();
+    VLOG(4) << "Done AnalyzeCriticalPathPriority";
+  } else {
+    PADDLE_ENFORCE_EQ(
+        FLAGS_pir_interpreter_scheduling_policy == "fifo",
+        true,
+        common::errors::InvalidArgument(
+            "Unsupported FLAGS_pir_interpreter_scheduling_policy %s, it "
+            "should be fifo or critical_path.",
+            FLAGS_pir_interpreter_scheduling_policy));
+  }
+
   AnalyseExecuteOrderForTrace(ir_dependency_builder_.OpDownstreamMap(),
                               ir_instruction_scheduling_priority_less);
   VLOG(4) << "Done AnalyseExecuteOrderForTrace";
@@ -2041,6 +3206,41 @@ void PirInterpreter::PreAnalysis() {
 
   UpdateOneDNNOpNum();
   VLOG(4) << "Done UpdateOneDNNOpNum";
+
+  if (FLAGS_pir_interpreter_static_memory_plan &&
+      UseTraceRun(execution_config_, onednn_op_num_, sync_op_num_)) {
+    BuildStaticMemoryPlan();
+    VLOG(4) << "Done BuildStaticMemoryPlan";
+  }
+
+  compiled_trace_.clear();
+  compiled_gc_vars_.clear();
+  if (FLAGS_pir_interpreter_compiled_trace &&
+      UseTraceRun(execution_config_, onednn_op_num_, sync_op_num_)) {
+    BuildCompiledTrace();
+    VLOG(4) << "Done BuildCompiledTrace";
+  }
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  cuda_graph_ranges_.clear();
+  cuda_graph_range_at_.clear();
+  if (FLAGS_pir_interpreter_auto_cuda_graph &&
+      !FLAGS_new_executor_use_cuda_graph && phi::is_gpu_place(place_) &&
+      IsInterpretercoreFastGCEnabled() &&
+      UseTraceRun(execution_config_, onednn_op_num_, sync_op_num_)) {
+    BuildCUDAGraphRanges();
+    VLOG(4) << "Done BuildCUDAGraphRanges";
+  }
+
+  elementwise_chains_.clear();
+  elementwise_chain_at_.clear();
+  if (FLAGS_pir_interpreter_fuse_elementwise_chain &&
+      phi::is_gpu_place(place_) &&
+      UseTraceRun(execution_config_, onednn_op_num_, sync_op_num_)) {
+    BuildElementwiseChains();
+    VLOG(4) << "Done BuildElementwiseChains";
+  }
+#endif
 }
 
 ::pir::Value PirInterpreter::GetValueByName(const std::string& var_name) {
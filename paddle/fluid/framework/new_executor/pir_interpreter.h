@@ -15,11 +15,16 @@
 #pragma once
 #include <memory>
 #include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
+#include "paddle/fluid/framework/new_executor/interpreter/build_result_cache.h"
+#include "paddle/fluid/framework/new_executor/interpreter/static_memory_planner.h"
 #include "paddle/fluid/framework/new_executor/interpreter_base_impl.h"
+#include "paddle/fluid/framework/new_executor/op_latency_monitor.h"
 #include "paddle/pir/include/core/value.h"
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/core/platform/cuda_graph_with_memory_pool.h"
 #include "paddle/phi/kernels/autotune/gpu_timer.h"
+#include "paddle/phi/kernels/funcs/elementwise_chain.h"
 #endif
 
 namespace ir {
@@ -28,6 +33,7 @@ class Block;
 
 namespace paddle {
 namespace framework {
+class PhiKernelInstruction;
 class ValueExecutionInfo;
 class PirInterpreter : public InterpreterBaseImpl {
   using ExecutionConfig = interpreter::ExecutionConfig;
@@ -134,8 +140,23 @@ class PirInterpreter : public InterpreterBaseImpl {
       std::map<size_t, std::set<size_t>> op_downstream_map,
       InstructionSchedulingPriorityLess compare);
   void AnalyzeForceSyncOps();
+  void AnalyzeCriticalPathPriority();
   void ConstructEventForJitInput();
   void CalculateLastLiveOps();
+  void InitDepsAndRefs();
+
+  // build result cache
+  uint64_t BuildResultSignature() const;
+  bool LoadBuildResult(uint64_t signature);
+  void SaveBuildResult(uint64_t signature) const;
+
+  // static memory plan
+  void BuildStaticMemoryPlan();
+  void BindStaticMemoryPlan();
+
+  // compiled trace
+  void BuildCompiledTrace();
+  bool CanRunCompiledTrace() const;
 
   // gc
   void ClearLoDTensorArrayInLocalScope();
@@ -144,6 +165,24 @@ class PirInterpreter : public InterpreterBaseImpl {
   void CheckCUDAGraphBeforeRun(const std::vector<std::string>& feed_names);
   void PrepareForCUDAGraphCapture();
 
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // auto cuda graph
+  struct CUDAGraphRange;
+  void BuildCUDAGraphRanges();
+  // Returns false when the range should run instruction by instruction.
+  bool RunCUDAGraphRange(CUDAGraphRange* range);
+  bool CaptureCUDAGraphRange(CUDAGraphRange* range,
+                             const std::vector<int64_t>& key);
+  void StageCUDAGraphInputs(CUDAGraphRange* range,
+                            std::vector<phi::DenseTensor>* staging);
+
+  // elementwise chain fusion
+  struct ElementwiseChain;
+  void BuildElementwiseChains();
+  // Returns false when the chain should run instruction by instruction.
+  bool RunElementwiseChain(const ElementwiseChain& chain);
+#endif
+
   void Build(const std::vector<std::string>& feed_names,
              std::vector<paddle::framework::OpFuncNode>* op_func_nodes,
              bool switch_stream = false) override;
@@ -189,6 +228,10 @@ class PirInterpreter : public InterpreterBaseImpl {
 
   std::unique_ptr<InterpreterCoreGarbageCollector> gc_;
 
+  // created with gc_ when FLAGS_pir_interpreter_op_latency_sample_interval
+  // is positive
+  std::unique_ptr<OpLatencyRecorder> op_latency_recorder_;
+
   // last_live_ops_[i] contains the id of operators that last access the i-th
   // var
   std::map<size_t, std::set<size_t>> last_live_ops_;
@@ -206,6 +249,90 @@ class PirInterpreter : public InterpreterBaseImpl {
   int64_t onednn_op_num_{-1};
   std::vector<size_t> trace_execute_order_;
 
+  // used for critical path scheduling
+  bool critical_path_scheduling_{false};
+
+  // whether the dependency, events and GC schedule are loaded from the
+  // build result cache
+  bool build_result_loaded_{false};
+
+  // used for static memory plan, only built in trace mode
+  std::unique_ptr<interpreter::StaticMemoryPlanner> static_memory_planner_;
+  std::shared_ptr<phi::Allocation> static_memory_arena_;
+  // (var, view of the arena bound to the var)
+  std::vector<std::pair<Variable*, std::shared_ptr<phi::Allocation>>>
+      static_memory_views_;
+
+  // used for compiled trace, one step per instruction in trace execution
+  // order, only built in trace mode
+  struct CompiledTraceStep {
+    InstructionBase* instr;
+    // Set when the phi kernel is called directly, otherwise the step runs
+    // through RunInstructionBase.
+    const phi::Kernel* kernel{nullptr};
+    phi::KernelContext* kernel_context{nullptr};
+    // Set when the instruction has an InferMeta, which runs through its
+    // InferMeta cache like in PhiKernelInstruction::Run.
+    PhiKernelInstruction* infer_meta_instr{nullptr};
+    // [gc_begin, gc_end) of compiled_gc_vars_
+    size_t gc_begin{0};
+    size_t gc_end{0};
+    bool wait_event{false};
+    bool record_event{false};
+    bool sync_after_launch{false};
+  };
+  std::vector<CompiledTraceStep> compiled_trace_;
+  // ids of the vars checked by gc after each step, parameters and vars of
+  // the static memory plan are filtered out
+  std::vector<size_t> compiled_gc_vars_;
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // used for auto cuda graph, a range of capture-safe instructions in trace
+  // execution order, captured once per distinct input shapes
+  struct CUDAGraphRange {
+    struct Graph {
+      std::unique_ptr<platform::CUDAGraph> graph;
+      // the buffers the graph reads its non-persistable inputs from
+      std::vector<phi::DenseTensor> staging;
+      // the data of the persistable inputs when captured
+      std::vector<const void*> persistable_data;
+      // the written vars still alive after the range, restored after replay
+      std::vector<std::pair<Variable*, phi::DenseTensor>> outputs;
+    };
+
+    // [begin, end) of trace_execute_order_
+    size_t begin;
+    size_t end;
+    std::vector<Variable*> inputs;
+    std::vector<bool> is_persistable;
+    std::vector<Variable*> written;
+    // the shapes seen once, captured when seen again
+    std::set<std::vector<int64_t>> warmup_keys;
+    std::map<std::vector<int64_t>, Graph> graphs;
+    bool disabled{false};
+  };
+  std::vector<CUDAGraphRange> cuda_graph_ranges_;
+  // the index of the range beginning at each position of the trace order,
+  // -1 for the others
+  std::vector<int> cuda_graph_range_at_;
+
+  // used for elementwise chain fusion, a range of elementwise instructions
+  // in trace execution order launched as one kernel
+  struct ElementwiseChain {
+    // [begin, end) of trace_execute_order_
+    size_t begin;
+    size_t end;
+    phi::funcs::ElementwiseChainProgram program;
+    std::vector<Variable*> inputs;
+    // the results still alive after the chain
+    std::vector<Variable*> outputs;
+  };
+  std::vector<ElementwiseChain> elementwise_chains_;
+  // the index of the chain beginning at each position of the trace order,
+  // -1 for the others
+  std::vector<int> elementwise_chain_at_;
+#endif
+
   std::vector<PirHookFunc> pir_output_hookfuncs_;
   std::vector<PirHookFunc> pir_input_hookfuncs_;
 
@@ -231,6 +358,10 @@ class PirInterpreter : public InterpreterBaseImpl {
   void TraceRunInstructionList(
       const std::vector<std::unique_ptr<InstructionBase>>& vec_instr);
 
+  void CompiledTraceRunInstructionList();
+
+  void RunCompiledTraceStep(const CompiledTraceStep& step);
+
   void MultiThreadRunImpl();
 
   void MultiThreadRunInstructionList(
@@ -14,6 +14,7 @@
 
 #include "paddle/fluid/framework/new_executor/program_interpreter.h"
 
+#include "paddle/common/startup_trace.h"
 #include "paddle/fluid/framework/details/nan_inf_utils.h"
 #include "paddle/fluid/framework/io/save_load_tensor.h"
 #include "paddle/fluid/framework/new_executor/interpreter/interpreter_util.h"
@@ -22,6 +23,7 @@
 #include "paddle/fluid/platform/profiler/supplement_tracing.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/kernel_context.h"
+#include "paddle/phi/core/memory/allocation/memory_timeline.h"
 #include "paddle/phi/core/os_info.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
@@ -239,6 +241,8 @@ void ProgramInterpreter::Build(
 #endif
 
   if (!is_build_ || switch_stream) {
+    common::StartupTraceScope startup_trace("ExecutorBuild",
+                                            "ProgramInterpreter::Build");
     LOG_FIRST_N(INFO, 1) << "New Executor is Running.";
     paddle::framework::interpreter::BuildVariableScope(
         block_, execution_config_, &var_scope_);
@@ -1160,6 +1164,8 @@ void ProgramInterpreter::RunInstruction(const Instruction& instr_node) {
   auto* op = instr_node.OpBase();
   phi::RecordEvent instruction_event(
       op->Type(), phi::TracerEventType::Operator, 1);
+  memory::allocation::MemoryTimelineOpScope memory_timeline_op(
+      op->Type().c_str());
 
   SetDeviceId(instr_node.DeviceContext().GetPlace());
 
@@ -12,6 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "paddle/fluid/framework/new_executor/standalone_executor.h"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+
 #include "paddle/common/flags.h"
 #include "paddle/fluid/framework/feed_hook.h"
 #include "paddle/fluid/framework/new_executor/feed_fetch_utils.h"
@@ -31,8 +36,52 @@
 COMMON_DECLARE_bool(enable_pir_in_executor);
 COMMON_DECLARE_bool(enable_pir_api);
 COMMON_DECLARE_bool(pir_apply_inplace_pass);
+COMMON_DECLARE_int32(new_executor_micro_batch_streams);
 
 namespace paddle::framework {
+
+// The micro batches are pipelined only when every job runs the same program
+// on its own micro batch, so that they do not depend on each other.
+static size_t MicroBatchStreamNum(const interpreter::Plan& plan) {
+  const auto& jobs = plan.JobList();
+  int64_t micro_batch_num = plan.MicroBatchNum();
+  if (!FLAGS_enable_pir_in_executor ||
+      FLAGS_new_executor_micro_batch_streams <= 0 || micro_batch_num <= 1 ||
+      jobs.size() != static_cast<size_t>(micro_batch_num)) {
+    return 0;
+  }
+  std::vector<bool> visited(micro_batch_num, false);
+  for (const auto& job : jobs) {
+    int64_t micro_batch_id = job->MicroBatchId();
+    if (job->Type() != jobs[0]->Type() || micro_batch_id < 0 ||
+        micro_batch_id >= micro_batch_num || visited[micro_batch_id]) {
+      return 0;
+    }
+    visited[micro_batch_id] = true;
+  }
+  return std::min(
+      static_cast<size_t>(FLAGS_new_executor_micro_batch_streams),
+      static_cast<size_t>(micro_batch_num));
+}
+
+// Moves the ops left on the default stream to the stream of the micro batch,
+// including the memcpy ops that would otherwise be serialized on the shared
+// H2D and D2H streams. Only the ops of the top block are moved, the sub
+// blocks of control flow ops keep their own streams.
+static void SetMicroBatchStream(pir::Block* block, const std::string& stream) {
+  auto stream_attr =
+      pir::StrAttribute::get(pir::IrContext::Instance(), stream);
+  for (auto& op : *block) {
+    auto it = op.attributes().find("execution_stream");
+    if (it != op.attributes().end() &&
+        it->second.dyn_cast<pir::StrAttribute>().AsString() !=
+            kDefaultStream) {
+      continue;
+    }
+    op.set_attribute("execution_stream", stream_attr);
+  }
+}
+
 StandaloneExecutor::StandaloneExecutor(const phi::Place& place,
                                        const interpreter::Plan& plan,
                                        Scope* scope)
@@ -57,6 +106,18 @@ StandaloneExecutor::StandaloneExecutor(const phi::Place& place,
   }
   VLOG(6) << ss.str();
 
+  micro_batch_stream_num_ = MicroBatchStreamNum(plan_);
+  VLOG_IF(3, micro_batch_stream_num_ > 0)
+      << "Pipeline " << micro_batch_num << " micro batches on "
+      << micro_batch_stream_num_ << " streams";
+  if (micro_batch_stream_num_ > 0) {
+    micro_batch_workers_ = CreateMultiThreadedWorkQueue(
+        WorkQueueOptions("MicroBatchPipeline",
+                         micro_batch_stream_num_,
+                         /*allow_spinning=*/false,
+                         /*track_task=*/false));
+  }
+
   const auto& jobs = plan_.JobList();
   for (size_t job_idx = 0; job_idx < jobs.size(); ++job_idx) {
     const auto& job = jobs[job_idx];
@@ -122,6 +183,13 @@ StandaloneExecutor::StandaloneExecutor(const phi::Place& place,
         pm.Run(shared_program.get());
       }
 
+      if (micro_batch_stream_num_ > 0) {
+        SetMicroBatchStream(
+            shared_program->block(),
+            "micro_batch_" +
+                std::to_string(micro_batch_id % micro_batch_stream_num_));
+      }
+
       interpretercores_.emplace_back(
           std::make_shared<InterpreterCore>(place_,
                                             job->FetchVarNames(),
@@ -180,7 +248,11 @@ paddle::framework::FetchList StandaloneExecutor::Run(
   if (!is_interpretercore_build_result_shared_) {
     type_to_first_id[jobs[0]->Type()] = 0;
     for (size_t job_idx = 1; job_idx < jobs.size(); ++job_idx) {
-      interpretercores_[job_idx]->ShareWorkQueueFrom(interpretercores_[0]);
+      // The pipelined jobs run at the same time, each waits for its own
+      // work queue to drain.
+      if (micro_batch_stream_num_ == 0) {
+        interpretercores_[job_idx]->ShareWorkQueueFrom(interpretercores_[0]);
+      }
       // TODO(Ruibiao): Share other build result, e.g., kernel choosing, data
       // transfer, op dependency, thread scheduling, GC, event analyzer, and so
       // on.
@@ -197,48 +269,53 @@ paddle::framework::FetchList StandaloneExecutor::Run(
   }
 
   fetch_list_.resize(plan_.MicroBatchNum());
-  for (size_t job_idx = 0; job_idx < jobs.size(); ++job_idx) {
-    const auto& job = jobs[job_idx];
-    const std::string& job_type = job->Type();
-    phi::RecordEvent record_event(
-        job_type + "-" + std::to_string(job->MicroBatchId()),
-        phi::TracerEventType::UserDefined,
-        1);
-
-    VLOG(6) << "Run job (" << job_idx << "), type = " << job_type
-            << ", micro_batch_id =" << job->MicroBatchId();
-
-    // NOTE(sonder): Share build results don't work for new IR now.
-    if (type_to_first_id.count(job_type) != 0 &&
-        !FLAGS_enable_pir_in_executor) {
-      interpretercores_[job_idx]->ShareBuildResultsFrom(
-          interpretercores_[type_to_first_id[job_type]]);
-    }
+  if (micro_batch_stream_num_ > 0) {
+    RunMicroBatchPipeline(
+        feed_names, splited_feeds, enable_job_schedule_profiler);
+  } else {
+    for (size_t job_idx = 0; job_idx < jobs.size(); ++job_idx) {
+      const auto& job = jobs[job_idx];
+      const std::string& job_type = job->Type();
+      phi::RecordEvent record_event(
+          job_type + "-" + std::to_string(job->MicroBatchId()),
+          phi::TracerEventType::UserDefined,
+          1);
 
-    if (FLAGS_enable_pir_in_executor) {
-      interpretercores_[job_idx]->Run(feed_names,
-                                      splited_feeds[job->MicroBatchId()],
-                                      /*need_fetch = */ false,
-                                      /*enable_job_schedule_profiler = */
-                                      enable_job_schedule_profiler);
-
-      FetchTensors(job->FetchVarNames(),
-                   fetch_var_names_,
-                   job->MicroBatchId(),
-                   micro_batch_scopes_[job->MicroBatchId()],
-                   &fetch_list_);
-    } else {
-      if (jobs.size() > 1 && job_type != "forward") {
-        const std::vector<std::string> tmp_feed_names = {};
-        interpretercores_[job_idx]->Run(tmp_feed_names,
-                                        /*need_fetch = */ false,
-                                        /*enable_job_schedule_profiler = */
-                                        enable_job_schedule_profiler);
-      } else {
+      VLOG(6) << "Run job (" << job_idx << "), type = " << job_type
+              << ", micro_batch_id =" << job->MicroBatchId();
+
+      // NOTE(sonder): Share build results don't work for new IR now.
+      if (type_to_first_id.count(job_type) != 0 &&
+          !FLAGS_enable_pir_in_executor) {
+        interpretercores_[job_idx]->ShareBuildResultsFrom(
+            interpretercores_[type_to_first_id[job_type]]);
+      }
+
+      if (FLAGS_enable_pir_in_executor) {
         interpretercores_[job_idx]->Run(feed_names,
+                                        splited_feeds[job->MicroBatchId()],
                                         /*need_fetch = */ false,
                                         /*enable_job_schedule_profiler = */
                                         enable_job_schedule_profiler);
+
+        FetchTensors(job->FetchVarNames(),
+                     fetch_var_names_,
+                     job->MicroBatchId(),
+                     micro_batch_scopes_[job->MicroBatchId()],
+                     &fetch_list_);
+      } else {
+        if (jobs.size() > 1 && job_type != "forward") {
+          const std::vector<std::string> tmp_feed_names = {};
+          interpretercores_[job_idx]->Run(tmp_feed_names,
+                                          /*need_fetch = */ false,
+                                          /*enable_job_schedule_profiler = */
+                                          enable_job_schedule_profiler);
+        } else {
+          interpretercores_[job_idx]->Run(feed_names,
+                                          /*need_fetch = */ false,
+                                          /*enable_job_schedule_profiler = */
+                                          enable_job_schedule_profiler);
+        }
       }
     }
   }
@@ -282,6 +359,68 @@ paddle::framework::FetchList StandaloneExecutor::Run(
   }
 }
 
+void StandaloneExecutor::RunMicroBatchPipeline(
+    const std::vector<std::string>& feed_names,
+    const std::vector<std::vector<phi::DenseTensor>>& splited_feeds,
+    const bool enable_job_schedule_profiler) {
+  const auto& jobs = plan_.JobList();
+  // The micro batches of a stream run in the order of their jobs, the host
+  // waits for each of them inside its InterpreterCore, e.g., for the fetch
+  // copy, while the other workers keep launching on their streams.
+  auto run_stream = [&](size_t stream_idx) -> std::exception_ptr {
+    try {
+      for (size_t job_idx = 0; job_idx < jobs.size(); ++job_idx) {
+        const auto& job = jobs[job_idx];
+        int64_t micro_batch_id = job->MicroBatchId();
+        if (static_cast<size_t>(micro_batch_id) % micro_batch_stream_num_ !=
+            stream_idx) {
+          continue;
+        }
+        phi::RecordEvent record_event(
+            job->Type() + "-" + std::to_string(micro_batch_id),
+            phi::TracerEventType::UserDefined,
+            1);
+        VLOG(6) << "Run job (" << job_idx << "), type = " << job->Type()
+                << ", micro_batch_id =" << micro_batch_id
+                << " on stream micro_batch_" << stream_idx;
+
+        interpretercores_[job_idx]->Run(feed_names,
+                                        splited_feeds[micro_batch_id],
+                                        /*need_fetch = */ false,
+                                        /*enable_job_schedule_profiler = */
+                                        enable_job_schedule_profiler);
+        FetchTensors(job->FetchVarNames(),
+                     fetch_var_names_,
+                     micro_batch_id,
+                     micro_batch_scopes_[micro_batch_id],
+                     &fetch_list_);
+      }
+    } catch (...) {
+      return std::current_exception();
+    }
+    return nullptr;
+  };
+  std::vector<std::future<std::exception_ptr>> results;
+  results.reserve(micro_batch_stream_num_);
+  for (size_t stream_idx = 0; stream_idx < micro_batch_stream_num_;
+       ++stream_idx) {
+    results.emplace_back(
+        micro_batch_workers_->AddAwaitableTask(run_stream, stream_idx));
+  }
+  // Wait for every stream before rethrowing, the workers still use the
+  // feeds of this run.
+  std::exception_ptr first_exception = nullptr;
+  for (auto& result : results) {
+    std::exception_ptr exception = result.get();
+    if (exception && !first_exception) {
+      first_exception = exception;
+    }
+  }
+  if (first_exception) {
+    std::rethrow_exception(first_exception);
+  }
+}
+
 std::shared_ptr<framework::ProgramDesc> StandaloneExecutor::RunProfile(
     const std::vector<std::string>& feed_names) {
   phi::RecordEvent record_event(
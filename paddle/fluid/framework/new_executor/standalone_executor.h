@@ -22,6 +22,7 @@
 #include "paddle/fluid/framework/new_executor/interpreter/plan.h"
 #include "paddle/fluid/framework/new_executor/interpretercore.h"
 #include "paddle/fluid/framework/new_executor/new_executor_defs.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 #include "paddle/fluid/framework/program_desc.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/pir/include/core/program.h"
@@ -47,7 +48,19 @@ class StandaloneExecutor {
       const std::vector<std::string>& feed_names);
 
  private:
+  // Runs the jobs of every pipelined stream on its own worker thread.
+  void RunMicroBatchPipeline(
+      const std::vector<std::string>& feed_names,
+      const std::vector<std::vector<phi::DenseTensor>>& splited_feeds,
+      const bool enable_job_schedule_profiler);
+
   bool is_interpretercore_build_result_shared_{false};
+  // The number of streams the micro batches are pipelined on, 0 when they
+  // run one by one.
+  size_t micro_batch_stream_num_{0};
+  // One persistent host thread per pipelined stream, created with the
+  // executor so that a run does not spawn threads.
+  std::unique_ptr<WorkQueue> micro_batch_workers_;
   const phi::Place place_;
   interpreter::Plan plan_;
   std::vector<std::shared_ptr<InterpreterCore>> interpretercores_;
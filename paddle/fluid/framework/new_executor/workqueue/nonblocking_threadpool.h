@@ -17,6 +17,8 @@
 #include "paddle/fluid/framework/new_executor/workqueue/event_count.h"
 #include "paddle/fluid/framework/new_executor/workqueue/run_queue.h"
 #include "paddle/fluid/framework/new_executor/workqueue/thread_environment.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
 #include "paddle/phi/core/os_info.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
 
@@ -39,6 +41,8 @@ class ThreadPoolTempl {
         always_spinning_(always_spinning),
         global_steal_partition_(EncodePartition(0, num_threads)),
         blocked_(0),
+        first_domain_(-1),
+        multi_domain_(false),
         done_(false),
         cancelled_(false),
         ec_(num_threads),
@@ -156,6 +160,22 @@ class ThreadPoolTempl {
 
   size_t NumThreads() const { return num_threads_; }
 
+  std::vector<WorkQueueThreadStats> ThreadStats() const {
+    std::vector<WorkQueueThreadStats> stats(thread_data_.size());
+    for (size_t i = 0; i < thread_data_.size(); ++i) {
+      const ThreadData& td = thread_data_[i];
+      stats[i].executed_tasks =
+          td.executed_tasks.load(std::memory_order_relaxed);
+      stats[i].stolen_tasks = td.stolen_tasks.load(std::memory_order_relaxed);
+      stats[i].local_stolen_tasks =
+          td.local_stolen_tasks.load(std::memory_order_relaxed);
+      stats[i].idle_waits = td.idle_waits.load(std::memory_order_relaxed);
+      stats[i].locality_domain =
+          td.locality_domain.load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
   int CurrentThreadId() const {
     const PerThread* pt = const_cast<ThreadPoolTempl*>(this)->GetPerThread();
     if (pt->pool == this) {
@@ -226,9 +246,23 @@ class ThreadPoolTempl {
   };
 
   struct ThreadData {
-    constexpr ThreadData() : thread(), steal_partition(0), queue() {}
+    constexpr ThreadData()
+        : thread(),
+          steal_partition(0),
+          locality_domain(0),
+          executed_tasks(0),
+          stolen_tasks(0),
+          local_stolen_tasks(0),
+          idle_waits(0),
+          queue() {}
     std::unique_ptr<Thread> thread;
     std::atomic<unsigned> steal_partition;
+    std::atomic<int> locality_domain;
+    // See WorkQueueThreadStats, only written by the thread itself.
+    std::atomic<uint64_t> executed_tasks;
+    std::atomic<uint64_t> stolen_tasks;
+    std::atomic<uint64_t> local_stolen_tasks;
+    std::atomic<uint64_t> idle_waits;
     Queue queue;
   };
 
@@ -238,6 +272,10 @@ class ThreadPoolTempl {
   std::vector<std::vector<unsigned>> all_coprimes_;
   unsigned global_steal_partition_;
   std::atomic<unsigned> blocked_;
+  // The domain of the first thread started, and whether the threads are
+  // found in more than one locality domain.
+  std::atomic<int> first_domain_;
+  std::atomic<bool> multi_domain_;
   std::atomic<bool> done_;
   std::atomic<bool> cancelled_;
   EventCount ec_;
@@ -254,6 +292,7 @@ class ThreadPoolTempl {
     pt->pool = this;
     pt->rand = GlobalThreadIdHash();
     pt->thread_id = thread_id;
+    UpdateLocalityDomain(thread_id);
     Queue& q = thread_data_[thread_id].queue;
     EventCount::Waiter* waiter = ec_.GetWaiter(thread_id);
     // TODO(dvyukov,rmlarsen): The time spent in NonEmptyQueueIndex() is
@@ -282,6 +321,7 @@ class ThreadPoolTempl {
           }
         }
         if (t.f) {
+          Increase(&thread_data_[thread_id].executed_tasks);
           env_.ExecuteTask(t);
         }
       }
@@ -311,6 +351,7 @@ class ThreadPoolTempl {
           }
         }
         if (t.f) {
+          Increase(&thread_data_[thread_id].executed_tasks);
           env_.ExecuteTask(t);
         }
       }
@@ -331,20 +372,65 @@ class ThreadPoolTempl {
         ((uint64_t)all_coprimes_[size - 1].size() * (uint64_t)r) >> 32;
     unsigned inc = all_coprimes_[size - 1][index];
 
-    for (unsigned i = 0; i < size; i++) {
-      assert(start + victim < limit);
-      Task t = thread_data_[start + victim].queue.PopBack();
-      if (t.f) {
-        return t;
-      }
-      victim += inc;
-      if (victim >= size) {
-        victim -= size;
+    // When the threads run in several locality domains, the victims sharing
+    // the cache with this thread are tried first, then all of them.
+    int domain = thread_data_[pt->thread_id].locality_domain.load(
+        std::memory_order_relaxed);
+    bool multi_domain = multi_domain_.load(std::memory_order_relaxed);
+    for (int pass = multi_domain ? 0 : 1; pass < 2; ++pass) {
+      unsigned first_victim = victim;
+      for (unsigned i = 0; i < size; i++) {
+        assert(start + victim < limit);
+        ThreadData& td = thread_data_[start + victim];
+        bool local =
+            td.locality_domain.load(std::memory_order_relaxed) == domain;
+        if (pass == 1 || local) {
+          Task t = td.queue.PopBack();
+          if (t.f) {
+            CountSteal(pt->thread_id, start + victim, local);
+            return t;
+          }
+        }
+        victim += inc;
+        if (victim >= size) {
+          victim -= size;
+        }
       }
+      victim = first_victim;
     }
     return Task();
   }
 
+  void CountSteal(int thief, int victim, bool local) {
+    if (thief == victim) {
+      return;
+    }
+    Increase(&thread_data_[thief].stolen_tasks);
+    if (local) {
+      Increase(&thread_data_[thief].local_stolen_tasks);
+    }
+  }
+
+  // Threads may be migrated while sleeping, so the domain is updated when
+  // the thread starts and every time it wakes up.
+  void UpdateLocalityDomain(int thread_id) {
+    int domain = CurrentLocalityDomain();
+    thread_data_[thread_id].locality_domain.store(domain,
+                                                  std::memory_order_relaxed);
+    int first = -1;
+    if (!first_domain_.compare_exchange_strong(
+            first, domain, std::memory_order_relaxed) &&
+        first != domain) {
+      multi_domain_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // The counters are written by their thread only, so no RMW is needed.
+  static inline void Increase(std::atomic<uint64_t>* counter) {
+    counter->store(counter->load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+  }
+
   // Steals work within threads belonging to the partition.
   Task LocalSteal() {
     PerThread* pt = GetPerThread();
@@ -384,6 +470,15 @@ class ThreadPoolTempl {
     if (victim != -1) {
       ec_.CancelWait();
       *t = thread_data_[victim].queue.PopBack();
+      if (t->f) {
+        int thread_id = GetPerThread()->thread_id;
+        CountSteal(thread_id,
+                   victim,
+                   thread_data_[victim].locality_domain.load(
+                       std::memory_order_relaxed) ==
+                       thread_data_[thread_id].locality_domain.load(
+                           std::memory_order_relaxed));
+      }
       blocked_--;
       return true;
     }
@@ -423,7 +518,10 @@ class ThreadPoolTempl {
     // Wait for work
     phi::RecordEvent record(
         "WaitForWork", phi::TracerEventType::UserDefined, 10);
+    int thread_id = GetPerThread()->thread_id;
+    Increase(&thread_data_[thread_id].idle_waits);
     ec_.CommitWait(waiter);
+    UpdateLocalityDomain(thread_id);
     blocked_--;
     return true;
   }
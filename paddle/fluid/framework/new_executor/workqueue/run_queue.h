@@ -7,23 +7,24 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
-// RunQueue is a fixed-size, partially non-blocking deque or Work items.
+// RunQueue is a fixed-size, non-blocking deque or Work items.
 // Operations on front of the queue must be done by a single thread (owner),
 // operations on back of the queue can be done by multiple threads concurrently.
 //
 // Algorithm outline:
-// All remote threads operating on the queue back are serialized by a mutex.
-// This ensures that at most two threads access state: owner and one remote
-// thread (Size aside). The algorithm ensures that the occupied region of the
-// underlying array is logically continuous (can wraparound, but no stray
-// occupied elements). Owner operates on one end of this region, remote thread
-// operates on the other end. Synchronization between these threads
-// (potential consumption of the last element and take up of the last empty
-// element) happens by means of state variable in each element. States are:
-// empty, busy (in process of insertion of removal) and ready. Threads claim
-// elements (empty->busy and ready->busy transitions) by means of a CAS
-// operation. The finishing transition (busy->empty and busy->ready) are done
-// with plain store as the element is exclusively owned by the current thread.
+// The queue is made of two lock-free parts. The items pushed by the owner are
+// kept in a Chase-Lev deque: the owner pushes and pops at the bottom of it,
+// remote threads steal from the top of it by a CAS on top_. The items pushed
+// by remote threads are kept in a bounded MPMC queue (Vyukov), where a cell is
+// claimed by a CAS on the enqueue or dequeue position and published by its
+// sequence number. The owner pops its own items first, so that the most
+// recently pushed (and cache hot) work runs first, remote threads pop the
+// items pushed by remote threads first, then the oldest items of the owner.
+//
+// The Chase-Lev deque keeps a state in each element too. A thief moves the
+// element out after winning the CAS on top_, so the owner must not reuse the
+// element until the thief marks it empty, a push hitting such an element fails
+// as if the queue was full.
 //
 // Note: we could permit only pointers as elements, then we would not need
 // separate state variable as null/non-null pointer value would serve as state,
@@ -34,17 +35,18 @@
 //   1. Use paddle::memory::SpinLock instead of std::mutex to protect back_.
 //   2. Make front_/back_ aligned to get better performance.
 //   3. Replace Eigen utils with std utils.
+//   4. Replace the SpinLock protected back with a Chase-Lev deque for the
+//      owner and an MPMC queue for the remote threads, so that neither
+//      pushing nor stealing takes a lock.
 
 #pragma once
 
 #include <atomic>
 #include <cassert>
 #include <cstdint>
-#include <mutex>
 #include <vector>
 
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
-#include "paddle/phi/core/memory/allocation/spin_lock.h"
 
 namespace paddle {
 namespace framework {
@@ -52,18 +54,16 @@ namespace framework {
 template <typename Work, unsigned kSize>
 class RunQueue {
  public:
-  RunQueue() : front_(0), back_(0) {
+  RunQueue() : top_(0), bottom_(0), enqueue_pos_(0), dequeue_pos_(0) {
     // require power-of-two for fast masking
     static_assert((kSize & (kSize - 1)) == 0,
                   "need to be a power of two for fast masking");
-    static_assert(
-        kSize > 2,
-        "need to be in [4, 65536] range to leave enough space for counter");
-    static_assert(
-        kSize <= (64 << 10),
-        "need to be in [4, 65536] range to leave enough space for counter");
-    for (unsigned i = 0; i < kSize; i++)
+    static_assert(kSize > 2, "need to be in [4, 65536] range");
+    static_assert(kSize <= (64 << 10), "need to be in [4, 65536] range");
+    for (unsigned i = 0; i < kSize; i++) {
       array_[i].state.store(kEmpty, std::memory_order_relaxed);
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
   }
 
   RunQueue(const RunQueue&) = delete;
@@ -74,195 +74,203 @@ class RunQueue {
   // PushFront inserts w at the beginning of the queue.
   // If queue is full returns w, otherwise returns default-constructed Work.
   Work PushFront(Work w) {
-    unsigned front = front_.load(std::memory_order_relaxed);
-    Elem* e = &array_[front & kMask];
-    uint8_t s = e->state.load(std::memory_order_relaxed);
-    if (s != kEmpty || !e->state.compare_exchange_strong(
-                           s, kBusy, std::memory_order_acquire)) {
+    uint64_t bottom = bottom_.load(std::memory_order_relaxed);
+    uint64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top >= kSize) {
+      return w;
+    }
+    Elem* e = &array_[bottom & kMask];
+    // A thief may still be moving out the element stolen kSize pushes ago.
+    if (e->state.load(std::memory_order_acquire) != kEmpty) {
       return w;
     }
-    front_.store(front + 1 + (kSize << 1), std::memory_order_relaxed);
     e->w = std::move(w);
-    e->state.store(kReady, std::memory_order_release);
+    e->state.store(kReady, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
     return Work();
   }
 
   // PopFront removes and returns the first element in the queue.
   // If the queue was empty returns default-constructed Work.
   Work PopFront() {
-    unsigned front = front_.load(std::memory_order_relaxed);
-    Elem* e = &array_[(front - 1) & kMask];
-    uint8_t s = e->state.load(std::memory_order_relaxed);
-    if (s != kReady || !e->state.compare_exchange_strong(
-                           s, kBusy, std::memory_order_acquire)) {
-      return Work();
+    Work w;
+    if (!PopOwned(&w)) {
+      Dequeue(&w);
     }
-    Work w = std::move(e->w);
-    e->state.store(kEmpty, std::memory_order_release);
-    front = ((front - 1) & kMask2) | (front & ~kMask2);
-    front_.store(front, std::memory_order_relaxed);
     return w;
   }
 
   // PushBack adds w at the end of the queue.
   // If queue is full returns w, otherwise returns default-constructed Work.
   Work PushBack(Work w) {
-    std::unique_lock<paddle::memory::SpinLock> lock(mutex_);
-    unsigned back = back_.load(std::memory_order_relaxed);
-    Elem* e = &array_[(back - 1) & kMask];
-    uint8_t s = e->state.load(std::memory_order_relaxed);
-    if (s != kEmpty || !e->state.compare_exchange_strong(
-                           s, kBusy, std::memory_order_acquire)) {
-      return w;
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+      cell = &cells_[pos & kMask];
+      uint64_t seq = cell->seq.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq - pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return w;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
     }
-    back = ((back - 1) & kMask2) | (back & ~kMask2);
-    back_.store(back, std::memory_order_relaxed);
-    e->w = std::move(w);
-    e->state.store(kReady, std::memory_order_release);
+    cell->w = std::move(w);
+    cell->seq.store(pos + 1, std::memory_order_release);
     return Work();
   }
 
   // PopBack removes and returns the last elements in the queue.
   Work PopBack() {
-    if (Empty()) {
-      return Work();
-    }
-
-    std::unique_lock<paddle::memory::SpinLock> lock(mutex_);
-    unsigned back = back_.load(std::memory_order_relaxed);
-    Elem* e = &array_[back & kMask];
-    uint8_t s = e->state.load(std::memory_order_relaxed);
-    if (s != kReady || !e->state.compare_exchange_strong(
-                           s, kBusy, std::memory_order_acquire)) {
-      return Work();
+    Work w;
+    if (!Dequeue(&w)) {
+      Steal(&w);
     }
-    Work w = std::move(e->w);
-    e->state.store(kEmpty, std::memory_order_release);
-    back_.store(back + 1 + (kSize << 1), std::memory_order_relaxed);
     return w;
   }
 
   // PopBackHalf removes and returns half last elements in the queue.
   // Returns number of elements removed.
   unsigned PopBackHalf(std::vector<Work>* result) {
-    if (Empty()) {
-      return 0;
-    }
-
-    std::unique_lock<paddle::memory::SpinLock> lock(mutex_);
-    unsigned back = back_.load(std::memory_order_relaxed);
     unsigned size = Size();
-    unsigned mid = back;
-    if (size > 1) mid = back + (size - 1) / 2;
     unsigned n = 0;
-    unsigned start = 0;
-    for (; static_cast<int>(mid - back) >= 0; mid--) {
-      Elem* e = &array_[mid & kMask];
-      uint8_t s = e->state.load(std::memory_order_relaxed);
-      if (n == 0) {
-        if (s != kReady || !e->state.compare_exchange_strong(
-                               s, kBusy, std::memory_order_acquire))
-          continue;
-        start = mid;
-      } else {
-        // Note: no need to store temporal kBusy, we exclusively own these
-        // elements.
-        assert(s == kReady);
+    for (unsigned i = 0; i < (size + 1) / 2; ++i) {
+      Work w;
+      if (!Dequeue(&w) && !Steal(&w)) {
+        break;
       }
-      result->push_back(std::move(e->w));
-      e->state.store(kEmpty, std::memory_order_release);
+      result->push_back(std::move(w));
       n++;
     }
-    if (n != 0) {
-      back_.store(start + 1 + (kSize << 1), std::memory_order_relaxed);
-    }
     return n;
   }
 
   // Size returns current queue size.
   // Can be called by any thread at any time.
-  unsigned Size() const { return SizeOrNotEmpty<true>(); }
+  unsigned Size() const {
+    // Emptiness plays critical role in thread pool blocking. So the positions
+    // are read in the order that makes the queue look larger than it is
+    // during concurrent modifications, never smaller.
+    uint64_t top = top_.load(std::memory_order_acquire);
+    uint64_t bottom = bottom_.load(std::memory_order_acquire);
+    uint64_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    uint64_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+    int64_t owned = static_cast<int64_t>(bottom - top);
+    int64_t pushed = static_cast<int64_t>(enqueue_pos - dequeue_pos);
+    int64_t size = (owned > 0 ? owned : 0) + (pushed > 0 ? pushed : 0);
+    return static_cast<unsigned>(size > 2 * kSize ? 2 * kSize : size);
+  }
 
   // Empty tests whether container is empty.
   // Can be called by any thread at any time.
-  bool Empty() const { return SizeOrNotEmpty<false>() == 0; }
+  bool Empty() const { return Size() == 0; }
 
   // Delete all the elements from the queue.
   void Flush() {
     while (!Empty()) {
-      PopFront();
+      PopBack();
     }
   }
 
  private:
   static const unsigned kMask = kSize - 1;
-  static const unsigned kMask2 = (kSize << 1) - 1;
   struct alignas(64) Elem {
     std::atomic<uint8_t> state;
     Work w;
   };
+  struct alignas(64) Cell {
+    std::atomic<uint64_t> seq;
+    Work w;
+  };
   enum {
     kEmpty,
-    kBusy,
     kReady,
   };
 
-  // Low log(kSize) + 1 bits in front_ and back_ contain rolling index of
-  // front/back, respectively. The remaining bits contain modification counters
-  // that are incremented on Push operations. This allows us to (1) distinguish
-  // between empty and full conditions (if we would use log(kSize) bits for
-  // position, these conditions would be indistinguishable); (2) obtain
-  // consistent snapshot of front_/back_ for Size operation using the
-  // modification counters.
-  alignas(64) std::atomic<unsigned> front_;
-  alignas(64) std::atomic<unsigned> back_;
-  paddle::memory::SpinLock mutex_;
+  // The positions only grow, 64 bits never wrap around in practice, so the
+  // size is their difference and full and empty are distinguishable.
+  alignas(64) std::atomic<uint64_t> top_;
+  alignas(64) std::atomic<uint64_t> bottom_;
+  alignas(64) std::atomic<uint64_t> enqueue_pos_;
+  alignas(64) std::atomic<uint64_t> dequeue_pos_;
   Elem array_[kSize];
+  Cell cells_[kSize];
 
-  // SizeOrNotEmpty returns current queue size; if NeedSizeEstimate is false,
-  // only whether the size is 0 is guaranteed to be correct.
-  // Can be called by any thread at any time.
-  template <bool NeedSizeEstimate>
-  unsigned SizeOrNotEmpty() const {
-    // Emptiness plays critical role in thread pool blocking. So we go to great
-    // effort to not produce false positives (claim non-empty queue as empty).
-    unsigned front = front_.load(std::memory_order_acquire);
-    for (;;) {
-      // Capture a consistent snapshot of front/tail.
-      unsigned back = back_.load(std::memory_order_acquire);
-      unsigned front1 = front_.load(std::memory_order_relaxed);
-      if (front != front1) {
-        front = front1;
-        std::atomic_thread_fence(std::memory_order_acquire);
-        continue;
-      }
-      if (NeedSizeEstimate) {
-        return CalculateSize(front, back);
-      } else {
-        // This value will be 0 if the queue is empty, and undefined otherwise.
-        unsigned maybe_zero = ((front ^ back) & kMask2);
-        // Queue size estimate must agree with maybe zero check on the queue
-        // empty/non-empty state.
-        assert((CalculateSize(front, back) == 0) == (maybe_zero == 0));
-        return maybe_zero;
+  // Pops the bottom of the deque, only called by the owner.
+  bool PopOwned(Work* w) {
+    uint64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t top = top_.load(std::memory_order_relaxed);
+    int64_t size = static_cast<int64_t>(bottom - top);
+    if (size < 0) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    if (size == 0) {
+      // The last element, race with the thieves for it.
+      bool won = top_.compare_exchange_strong(top,
+                                              top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      if (!won) {
+        return false;
       }
     }
+    Elem* e = &array_[bottom & kMask];
+    *w = std::move(e->w);
+    e->state.store(kEmpty, std::memory_order_release);
+    return true;
   }
 
-  inline unsigned CalculateSize(unsigned front, unsigned back) const {
-    int size = (front & kMask2) - (back & kMask2);
-    // Fix overflow.
-    if (size < 0) {
-      size += 2 * kSize;
+  // Steals the top of the deque, called by any thread.
+  bool Steal(Work* w) {
+    uint64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (static_cast<int64_t>(bottom - top) <= 0) {
+      return false;
+    }
+    if (!top_.compare_exchange_strong(top,
+                                      top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
     }
-    // Order of modification in push/pop is crafted to make the queue look
-    // larger than it is during concurrent modifications. E.g. push can
-    // increment size before the corresponding pop has decremented it.
-    // So the computed size can be up to kSize + 1, fix it.
-    if (size > static_cast<int>(kSize)) {
-      size = kSize;
+    Elem* e = &array_[top & kMask];
+    *w = std::move(e->w);
+    e->state.store(kEmpty, std::memory_order_release);
+    return true;
+  }
+
+  // Pops the MPMC queue, called by any thread.
+  bool Dequeue(Work* w) {
+    uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+      cell = &cells_[pos & kMask];
+      uint64_t seq = cell->seq.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq - (pos + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
     }
-    return static_cast<unsigned>(size);
+    *w = std::move(cell->w);
+    cell->seq.store(pos + kSize, std::memory_order_release);
+    return true;
   }
 };
 
@@ -81,6 +81,10 @@ class WorkQueueImpl : public WorkQueue {
 
   size_t NumThreads() const override { return queue_->NumThreads(); }
 
+  std::vector<WorkQueueThreadStats> ThreadStats() const override {
+    return queue_->ThreadStats();
+  }
+
  private:
   NonblockingThreadPool* queue_{nullptr};
   TaskTracker* tracker_{nullptr};
@@ -101,6 +105,9 @@ class WorkQueueGroupImpl : public WorkQueueGroup {
 
   size_t QueueGroupNumThreads() const override;
 
+  std::vector<WorkQueueThreadStats> QueueThreadStats(
+      size_t queue_idx) const override;
+
   void Cancel() override;
 
  private:
@@ -193,6 +200,15 @@ size_t WorkQueueGroupImpl::QueueGroupNumThreads() const {
   return total_num;
 }
 
+std::vector<WorkQueueThreadStats> WorkQueueGroupImpl::QueueThreadStats(
+    size_t queue_idx) const {
+  assert(queue_idx < queues_.size());
+  if (!queues_.at(queue_idx)) {
+    return {};
+  }
+  return queues_.at(queue_idx)->ThreadStats();
+}
+
 void WorkQueueGroupImpl::Cancel() {
   for (auto queue : queues_) {
     if (queue) {
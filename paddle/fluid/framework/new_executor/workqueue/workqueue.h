@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
@@ -104,6 +105,21 @@ struct WorkQueueOptions {
   EventsWaiter* events_waiter{nullptr};  // not owned
 };
 
+// The counters of a worker thread, they are updated by the thread only and
+// read without synchronization, so they are estimates while the thread runs.
+struct WorkQueueThreadStats {
+  uint64_t executed_tasks{0};
+  // tasks taken from the queues of other threads
+  uint64_t stolen_tasks{0};
+  // the part of stolen_tasks taken from threads in the same locality domain
+  uint64_t local_stolen_tasks{0};
+  // times the thread found no work and went to sleep
+  uint64_t idle_waits{0};
+  // the locality domain (L3 cache or NUMA node) the thread last woke up on,
+  // see CurrentLocalityDomain
+  int locality_domain{0};
+};
+
 class WorkQueue {
  public:
   explicit WorkQueue(const WorkQueueOptions& options) : options_(options) {}
@@ -136,6 +152,9 @@ class WorkQueue {
 
   virtual size_t NumThreads() const = 0;
 
+  // One entry per worker thread
+  virtual std::vector<WorkQueueThreadStats> ThreadStats() const = 0;
+
   virtual void Cancel() = 0;
 
  protected:
@@ -178,6 +197,10 @@ class WorkQueueGroup {
 
   virtual size_t QueueGroupNumThreads() const = 0;
 
+  // One entry per worker thread of the queue
+  virtual std::vector<WorkQueueThreadStats> QueueThreadStats(
+      size_t queue_idx) const = 0;
+
   virtual void Cancel() = 0;
 
  protected:
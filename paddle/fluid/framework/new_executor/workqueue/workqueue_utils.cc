@@ -16,9 +16,63 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace paddle::framework {
 
+#if defined(__linux__)
+static int ReadL3CacheId(int cpu) {
+  std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                    "/cache/index3/";
+  std::ifstream level_file(dir + "level");
+  int level = 0;
+  if (!(level_file >> level) || level != 3) {
+    return -1;
+  }
+  std::ifstream id_file(dir + "id");
+  int id = -1;
+  if (!(id_file >> id)) {
+    return -1;
+  }
+  return id;
+}
+#endif
+
+int CurrentLocalityDomain() {
+#if defined(__linux__)
+  // The L3 ids of all the CPUs are read once, the sysfs is too slow to read
+  // every time a thread wakes up.
+  static const std::vector<int> l3_ids = []() {
+    long num_cpus = sysconf(_SC_NPROCESSORS_CONF);  // NOLINT
+    std::vector<int> ids(num_cpus > 0 ? num_cpus : 0);
+    for (size_t cpu = 0; cpu < ids.size(); ++cpu) {
+      ids[cpu] = ReadL3CacheId(static_cast<int>(cpu));
+    }
+    return ids;
+  }();
+  int cpu = sched_getcpu();
+  if (cpu >= 0 && static_cast<size_t>(cpu) < l3_ids.size() &&
+      l3_ids[cpu] >= 0) {
+    return l3_ids[cpu];
+  }
+  unsigned node_cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &node_cpu, &node, nullptr) != 0) {
+    return 0;
+  }
+  return static_cast<int>(node);
+#else
+  return 0;
+#endif
+}
+
 void* AlignedMalloc(size_t size, size_t alignment) {
   assert(alignment >= sizeof(void*) && (alignment & (alignment - 1)) == 0);
   size = (size + alignment - 1) / alignment * alignment;
@@ -65,6 +65,12 @@ class CounterGuard {
   Holder* counter_holder_{nullptr};
 };
 
+// Returns the locality domain of the CPU the calling thread runs on, that is
+// the id of its L3 cache, or its NUMA node if the cache topology is unknown.
+// Threads in the same domain share a cache, so the work stolen among them
+// stays cache hot. Returns 0 if the platform does not tell.
+int CurrentLocalityDomain();
+
 void* AlignedMalloc(size_t size, size_t alignment);
 
 void AlignedFree(void* memory_ptr);
@@ -0,0 +1,403 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace paddle {
+namespace framework {
+
+// The binary columnar file of slot records, loaded by
+// SlotRecordInMemoryDataFeed without parsing any text. The file is
+//
+//   header | slot * | block *
+//
+// the header and the slots giving the name and the type of the slots
+// stored, and each block holding up to kSlotRecordFileBlockIns instances
+// column by column: the ins ids, the log key fields, and then per slot the
+// offsets of the values of each instance and the values. The columns of a
+// block are 8 bytes aligned, and the block is zlib compressed as a whole at
+// its fastest level when the file is compressed, so an uncompressed file
+// mapped in memory is read in place.
+constexpr char kSlotRecordFileSuffix[] = ".slotbin";
+constexpr uint32_t kSlotRecordFileMagic = 0x4e42534c;  // "LSBN"
+constexpr uint32_t kSlotRecordFileVersion = 1;
+constexpr size_t kSlotRecordFileBlockIns = 4096;
+
+enum SlotRecordFileFlag : uint32_t {
+  kSlotRecordFileInsId = 1,
+  kSlotRecordFileLogKey = 2,
+  kSlotRecordFileCompress = 4,
+};
+
+struct SlotRecordFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t flags;
+  uint32_t num_slots;
+};
+
+struct SlotRecordFileBlockHeader {
+  uint64_t num_ins;
+  uint64_t raw_size;
+  uint64_t stored_size;
+};
+
+// A slot stored in the file, type is 'u' for uint64 and 'f' for float.
+struct SlotRecordFileSlot {
+  std::string name;
+  char type;
+};
+
+inline bool IsSlotRecordFile(const std::string& path) {
+  size_t len = strlen(kSlotRecordFileSuffix);
+  return path.size() >= len &&
+         path.compare(path.size() - len, len, kSlotRecordFileSuffix) == 0;
+}
+
+// Writes the instances added one after the other through write, which
+// returns 0 on success. Every function returns 0, or -1 as soon as a write
+// fails.
+class SlotRecordFileWriter {
+ public:
+  SlotRecordFileWriter(const std::vector<SlotRecordFileSlot>& slots,
+                       uint32_t flags,
+                       std::function<int(const char*, size_t)> write)
+      : _slots(slots),
+        _flags(flags),
+        _write(std::move(write)),
+        _offsets(slots.size()),
+        _values(slots.size()) {}
+
+  int WriteHeader() {
+    SlotRecordFileHeader header = {kSlotRecordFileMagic,
+                                   kSlotRecordFileVersion,
+                                   _flags,
+                                   static_cast<uint32_t>(_slots.size())};
+    if (_write(reinterpret_cast<const char*>(&header), sizeof(header)) != 0) {
+      return -1;
+    }
+    for (auto& slot : _slots) {
+      uint32_t len = slot.name.size();
+      if (_write(&slot.type, 1) != 0 ||
+          _write(reinterpret_cast<const char*>(&len), sizeof(len)) != 0 ||
+          _write(slot.name.data(), len) != 0) {
+        return -1;
+      }
+    }
+    return 0;
+  }
+
+  // Starts an instance, whose values are then added by slot. A slot no
+  // value is added to is empty for the instance.
+  void BeginInstance(const std::string& ins_id,
+                     uint64_t search_id,
+                     uint32_t cmatch,
+                     uint32_t rank) {
+    _ins_id_offsets.push_back(_ins_ids.size());
+    _ins_ids.append(ins_id);
+    _search_ids.push_back(search_id);
+    _cmatches.push_back(cmatch);
+    _ranks.push_back(rank);
+  }
+
+  void AddValues(size_t slot, const void* values, size_t num) {
+    size_t width = _slots[slot].type == 'u' ? sizeof(uint64_t) : sizeof(float);
+    auto& column = _values[slot];
+    _offsets[slot].push_back(column.size() / width);
+    column.append(reinterpret_cast<const char*>(values), num * width);
+  }
+
+  int EndInstance() {
+    ++_num_ins;
+    for (size_t i = 0; i < _slots.size(); ++i) {
+      size_t width = _slots[i].type == 'u' ? sizeof(uint64_t) : sizeof(float);
+      if (_offsets[i].size() < _num_ins) {
+        _offsets[i].push_back(_values[i].size() / width);
+      }
+    }
+    return _num_ins >= kSlotRecordFileBlockIns ? Flush() : 0;
+  }
+
+  // Writes the instances not written yet, to be called once all are added.
+  int Flush() {
+    if (_num_ins == 0) {
+      return 0;
+    }
+    std::string& raw = _raw;
+    raw.clear();
+    if (_flags & kSlotRecordFileInsId) {
+      _ins_id_offsets.push_back(_ins_ids.size());
+      AppendColumn(_ins_id_offsets.data(), _ins_id_offsets.size());
+      AppendColumn(_ins_ids.data(), _ins_ids.size());
+    }
+    if (_flags & kSlotRecordFileLogKey) {
+      AppendColumn(_search_ids.data(), _search_ids.size());
+      AppendColumn(_cmatches.data(), _cmatches.size());
+      AppendColumn(_ranks.data(), _ranks.size());
+    }
+    for (size_t i = 0; i < _slots.size(); ++i) {
+      size_t width = _slots[i].type == 'u' ? sizeof(uint64_t) : sizeof(float);
+      auto& offsets = _offsets[i];
+      offsets.push_back(_values[i].size() / width);
+      AppendColumn(offsets.data(), offsets.size());
+      AppendColumn(_values[i].data(), _values[i].size());
+    }
+    SlotRecordFileBlockHeader header = {_num_ins, raw.size(), raw.size()};
+    const char* stored = raw.data();
+    if (_flags & kSlotRecordFileCompress) {
+      uLongf bound = compressBound(raw.size());
+      _compressed.resize(bound);
+      if (compress2(reinterpret_cast<Bytef*>(&_compressed[0]),
+                    &bound,
+                    reinterpret_cast<const Bytef*>(raw.data()),
+                    raw.size(),
+                    Z_BEST_SPEED) != Z_OK) {
+        return -1;
+      }
+      header.stored_size = bound;
+      stored = _compressed.data();
+    }
+    Clear();
+    if (_write(reinterpret_cast<const char*>(&header), sizeof(header)) != 0 ||
+        _write(stored, header.stored_size) != 0) {
+      return -1;
+    }
+    return 0;
+  }
+
+ private:
+  template <typename T>
+  void AppendColumn(const T* data, size_t num) {
+    _raw.append(reinterpret_cast<const char*>(data), num * sizeof(T));
+    _raw.resize((_raw.size() + 7) & ~static_cast<size_t>(7), '\0');
+  }
+
+  void Clear() {
+    _num_ins = 0;
+    _ins_id_offsets.clear();
+    _ins_ids.clear();
+    _search_ids.clear();
+    _cmatches.clear();
+    _ranks.clear();
+    for (size_t i = 0; i < _slots.size(); ++i) {
+      _offsets[i].clear();
+      _values[i].clear();
+    }
+  }
+
+  std::vector<SlotRecordFileSlot> _slots;
+  uint32_t _flags;
+  std::function<int(const char*, size_t)> _write;
+
+  uint64_t _num_ins = 0;
+  std::vector<uint32_t> _ins_id_offsets;
+  std::string _ins_ids;
+  std::vector<uint64_t> _search_ids;
+  std::vector<uint32_t> _cmatches;
+  std::vector<uint32_t> _ranks;
+  std::vector<std::vector<uint32_t>> _offsets;
+  std::vector<std::string> _values;
+  std::string _raw;
+  std::string _compressed;
+};
+
+// A block of instances read from a file, pointing into the file when it is
+// mapped and uncompressed, or into the buffer of the reader otherwise, until
+// the next block is read.
+struct SlotRecordFileBlock {
+  size_t num_ins = 0;
+  const uint32_t* ins_id_offsets = nullptr;
+  const char* ins_ids = nullptr;
+  const uint64_t* search_ids = nullptr;
+  const uint32_t* cmatches = nullptr;
+  const uint32_t* ranks = nullptr;
+  // By slot of the file, num_ins + 1 offsets into the values of the slot.
+  std::vector<const uint32_t*> offsets;
+  std::vector<const void*> values;
+};
+
+// Reads a file written by SlotRecordFileWriter, either mapped in memory or
+// streamed through read, which returns the number of bytes read.
+class SlotRecordFileReader {
+ public:
+  SlotRecordFileReader(const char* data, size_t size)
+      : _mapped(true), _data(data), _size(size) {}
+  explicit SlotRecordFileReader(std::function<size_t(char*, size_t)> read)
+      : _read(std::move(read)) {}
+
+  // Returns 0, or -1 when the file is not a slot record file.
+  int ReadHeader() {
+    const char* data = Fetch(sizeof(_header), &_buffer);
+    if (data == nullptr) {
+      return -1;
+    }
+    memcpy(&_header, data, sizeof(_header));
+    if (_header.magic != kSlotRecordFileMagic ||
+        _header.version != kSlotRecordFileVersion) {
+      return -1;
+    }
+    _slots.resize(_header.num_slots);
+    for (auto& slot : _slots) {
+      uint32_t len = 0;
+      if ((data = Fetch(1 + sizeof(len), &_buffer)) == nullptr) {
+        return -1;
+      }
+      slot.type = data[0];
+      memcpy(&len, data + 1, sizeof(len));
+      if ((slot.type != 'u' && slot.type != 'f') ||
+          (data = Fetch(len, &_buffer)) == nullptr) {
+        return -1;
+      }
+      slot.name.assign(data, len);
+    }
+    return 0;
+  }
+
+  uint32_t flags() const { return _header.flags; }
+  const std::vector<SlotRecordFileSlot>& slots() const { return _slots; }
+
+  // Returns 1 and the next block, 0 at the end of the file, or -1 on a
+  // truncated or corrupted file.
+  int ReadBlock(SlotRecordFileBlock* block) {
+    SlotRecordFileBlockHeader header;
+    const char* data = Fetch(sizeof(header), &_buffer);
+    if (data == nullptr) {
+      return _eof ? 0 : -1;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.num_ins == 0 || header.num_ins > kSlotRecordFileBlockIns ||
+        (data = Fetch(header.stored_size, &_buffer)) == nullptr) {
+      return -1;
+    }
+    if (_header.flags & kSlotRecordFileCompress) {
+      _raw.resize(header.raw_size);
+      uLongf raw_size = header.raw_size;
+      if (uncompress(reinterpret_cast<Bytef*>(&_raw[0]),
+                     &raw_size,
+                     reinterpret_cast<const Bytef*>(data),
+                     header.stored_size) != Z_OK ||
+          raw_size != header.raw_size) {
+        return -1;
+      }
+      data = _raw.data();
+    } else if (header.stored_size != header.raw_size) {
+      return -1;
+    } else if (reinterpret_cast<uintptr_t>(data) % 8 != 0) {
+      // The columns of a mapped block are read in place when aligned.
+      _raw.assign(data, header.raw_size);
+      data = _raw.data();
+    }
+    return ParseBlock(data, header, block) ? 1 : -1;
+  }
+
+ private:
+  // Returns size bytes of the file, or nullptr at its end.
+  const char* Fetch(size_t size, std::string* buffer) {
+    if (_mapped) {
+      if (_size - _pos < size) {
+        _eof = _pos == _size;
+        return nullptr;
+      }
+      _pos += size;
+      return _data + _pos - size;
+    }
+    buffer->resize(size);
+    size_t n = size == 0 ? 0 : _read(&(*buffer)[0], size);
+    if (n != size) {
+      _eof = n == 0;
+      return nullptr;
+    }
+    return buffer->data();
+  }
+
+  template <typename T>
+  static const T* Column(const char** data,
+                         const char* end,
+                         size_t num,
+                         bool* ok) {
+    size_t size = (num * sizeof(T) + 7) & ~static_cast<size_t>(7);
+    if (!*ok || static_cast<size_t>(end - *data) < size) {
+      *ok = false;
+      return nullptr;
+    }
+    const T* column = reinterpret_cast<const T*>(*data);
+    *data += size;
+    return column;
+  }
+
+  bool ParseBlock(const char* data,
+                  const SlotRecordFileBlockHeader& header,
+                  SlotRecordFileBlock* block) {
+    const char* end = data + header.raw_size;
+    size_t num = header.num_ins;
+    bool ok = true;
+    block->num_ins = num;
+    if (_header.flags & kSlotRecordFileInsId) {
+      block->ins_id_offsets = Column<uint32_t>(&data, end, num + 1, &ok);
+      size_t len = ok ? block->ins_id_offsets[num] : 0;
+      block->ins_ids = Column<char>(&data, end, len, &ok);
+    }
+    if (_header.flags & kSlotRecordFileLogKey) {
+      block->search_ids = Column<uint64_t>(&data, end, num, &ok);
+      block->cmatches = Column<uint32_t>(&data, end, num, &ok);
+      block->ranks = Column<uint32_t>(&data, end, num, &ok);
+    }
+    block->offsets.resize(_slots.size());
+    block->values.resize(_slots.size());
+    for (size_t i = 0; i < _slots.size(); ++i) {
+      const uint32_t* offsets = Column<uint32_t>(&data, end, num + 1, &ok);
+      size_t len = ok ? offsets[num] : 0;
+      block->offsets[i] = offsets;
+      block->values[i] =
+          _slots[i].type == 'u'
+              ? static_cast<const void*>(Column<uint64_t>(&data, end, len, &ok))
+              : static_cast<const void*>(Column<float>(&data, end, len, &ok));
+      // The offsets index the values, so they only grow up to len.
+      for (size_t j = 0; ok && j < num; ++j) {
+        ok = offsets[j] <= offsets[j + 1];
+      }
+    }
+    if (ok && block->ins_id_offsets != nullptr) {
+      for (size_t j = 0; ok && j < num; ++j) {
+        ok = block->ins_id_offsets[j] <= block->ins_id_offsets[j + 1];
+      }
+    }
+    return ok;
+  }
+
+  bool _mapped = false;
+  const char* _data = nullptr;
+  size_t _size = 0;
+  size_t _pos = 0;
+  std::function<size_t(char*, size_t)> _read;
+  bool _eof = false;
+
+  SlotRecordFileHeader _header;
+  std::vector<SlotRecordFileSlot> _slots;
+  std::string _buffer;
+  std::string _raw;
+};
+
+}  // namespace framework
+}  // namespace paddle
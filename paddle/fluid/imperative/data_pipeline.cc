@@ -0,0 +1,217 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/imperative/data_pipeline.h"
+
+#include <cstring>
+#include <utility>
+
+#include "glog/logging.h"
+#include "paddle/common/enforce.h"
+
+namespace paddle::imperative {
+
+DataPipeline::DataPipeline(FetchFn fetch_fn,
+                           int num_threads,
+                           int prefetch_num,
+                           bool pin_memory)
+    : fetch_fn_(std::move(fetch_fn)),
+      prefetch_num_(prefetch_num),
+      pin_memory_(pin_memory) {
+  PADDLE_ENFORCE_GT(num_threads,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The thread number of the DataLoader pipeline should "
+                        "be greater than 0, but received %d.",
+                        num_threads));
+  PADDLE_ENFORCE_GT(prefetch_num,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The prefetch number of the DataLoader pipeline "
+                        "should be greater than 0, but received %d.",
+                        prefetch_num));
+#if !defined(PADDLE_WITH_CUDA) && !defined(PADDLE_WITH_HIP)
+  pin_memory_ = false;
+#endif
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+DataPipeline::~DataPipeline() { Shutdown(); }
+
+void DataPipeline::Reset(std::vector<std::vector<int64_t>> batches) {
+  std::map<size_t, Result> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++epoch_;
+    batches_ = std::move(batches);
+    next_batch_ = 0;
+    next_output_ = 0;
+    dropped.swap(done_);
+  }
+  worker_cv_.notify_all();
+  output_cv_.notify_all();
+}
+
+bool DataPipeline::Next(std::vector<phi::DenseTensor>* batch) {
+  Result result;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    output_cv_.wait(lock, [this] {
+      return stop_ || next_output_ >= batches_.size() ||
+             done_.count(next_output_) > 0;
+    });
+    if (stop_ || next_output_ >= batches_.size()) {
+      return false;
+    }
+    auto iter = done_.find(next_output_);
+    result = std::move(iter->second);
+    done_.erase(iter);
+    ++next_output_;
+  }
+  worker_cv_.notify_all();
+  if (result.error) {
+    std::rethrow_exception(result.error);
+  }
+  *batch = std::move(result.batch);
+  return true;
+}
+
+void DataPipeline::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) {
+      return;
+    }
+    stop_ = true;
+  }
+  worker_cv_.notify_all();
+  output_cv_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  std::map<size_t, Result> dropped;
+  std::lock_guard<std::mutex> lock(mutex_);
+  dropped.swap(done_);
+}
+
+void DataPipeline::WorkerLoop() {
+  while (true) {
+    std::vector<int64_t> indices;
+    size_t batch_id = 0;
+    uint64_t epoch = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      worker_cv_.wait(lock, [this] {
+        return stop_ || (next_batch_ < batches_.size() &&
+                         next_batch_ < next_output_ + prefetch_num_);
+      });
+      if (stop_) {
+        return;
+      }
+      batch_id = next_batch_++;
+      epoch = epoch_;
+      indices = batches_[batch_id];
+    }
+
+    Result result;
+    try {
+      BuildBatch(indices, &result.batch);
+    } catch (...) {
+      result.error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (epoch != epoch_ || stop_) {
+        continue;
+      }
+      done_.emplace(batch_id, std::move(result));
+    }
+    output_cv_.notify_all();
+  }
+}
+
+void DataPipeline::BuildBatch(const std::vector<int64_t>& indices,
+                              std::vector<phi::DenseTensor>* batch) {
+  PADDLE_ENFORCE_GT(
+      indices.size(),
+      0,
+      common::errors::InvalidArgument(
+          "The batch of the DataLoader pipeline should not be empty."));
+  std::vector<Sample> samples;
+  samples.reserve(indices.size());
+  for (int64_t index : indices) {
+    samples.emplace_back(fetch_fn_(index));
+  }
+
+  size_t field_num = samples[0].size();
+  batch->resize(field_num);
+  for (size_t i = 0; i < field_num; ++i) {
+    const phi::DenseTensor& first = samples[0][i];
+    size_t bytes = first.numel() * phi::SizeOf(first.dtype());
+    for (size_t k = 1; k < samples.size(); ++k) {
+      PADDLE_ENFORCE_EQ(samples[k].size(),
+                        field_num,
+                        common::errors::InvalidArgument(
+                            "The samples of a batch should have the same "
+                            "fields, but sample %d has %d fields and sample "
+                            "%d has %d.",
+                            indices[0],
+                            field_num,
+                            indices[k],
+                            samples[k].size()));
+      const phi::DenseTensor& field = samples[k][i];
+      PADDLE_ENFORCE_EQ(
+          field.dims() == first.dims() && field.dtype() == first.dtype(),
+          true,
+          common::errors::InvalidArgument(
+              "Field %d of the samples of a batch should have the same "
+              "shape and dtype to be stacked, but sample %d is [%s] %s and "
+              "sample %d is [%s] %s.",
+              i,
+              indices[0],
+              first.dims(),
+              first.dtype(),
+              indices[k],
+              field.dims(),
+              field.dtype()));
+    }
+
+    std::vector<int64_t> dims = {static_cast<int64_t>(samples.size())};
+    for (int d = 0; d < first.dims().size(); ++d) {
+      dims.push_back(first.dims()[d]);
+    }
+    auto& out = (*batch)[i];
+    out.Resize(common::make_ddim(dims));
+    phi::Place place = phi::CPUPlace();
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    if (pin_memory_) {
+      place = phi::GPUPinnedPlace();
+    }
+#endif
+    auto* dst = static_cast<char*>(out.mutable_data(place, first.dtype()));
+    for (size_t k = 0; k < samples.size(); ++k) {
+      if (bytes > 0) {
+        std::memcpy(dst + k * bytes, samples[k][i].data(), bytes);
+      }
+    }
+  }
+}
+
+}  // namespace paddle::imperative
@@ -0,0 +1,91 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace paddle {
+namespace imperative {
+
+// The data pipeline of the dygraph DataLoader run on threads of the trainer
+// process rather than in worker processes, so that the batches reach the
+// reader with no pickling and no shared memory file per tensor.
+//
+// num_threads threads take the batches of indices in turn, map every index
+// to a sample with fetch_fn and stack each field of the samples into one
+// tensor with a new leading batch dim, in pinned memory when pin_memory is
+// set so that the reader copies it to the device as it is. Next() returns
+// the batches in their order, at most prefetch_num of them built ahead.
+class DataPipeline {
+ public:
+  // A sample is one tensor per field, the same fields with the same dims
+  // and dtype for every sample of a batch.
+  using Sample = std::vector<phi::DenseTensor>;
+  using FetchFn = std::function<Sample(int64_t index)>;
+
+  DataPipeline(FetchFn fetch_fn,
+               int num_threads,
+               int prefetch_num,
+               bool pin_memory);
+  virtual ~DataPipeline();
+
+  // Starts an epoch over batches, dropping what is left of the last one.
+  void Reset(std::vector<std::vector<int64_t>> batches);
+
+  // Returns false once every batch of the epoch was returned, or after
+  // Shutdown(). Rethrows the error fetch_fn raised for the batch.
+  bool Next(std::vector<phi::DenseTensor>* batch);
+
+  void Shutdown();
+
+ private:
+  struct Result {
+    std::vector<phi::DenseTensor> batch;
+    std::exception_ptr error;
+  };
+
+  void WorkerLoop();
+  void BuildBatch(const std::vector<int64_t>& indices,
+                  std::vector<phi::DenseTensor>* batch);
+
+  FetchFn fetch_fn_;
+  int prefetch_num_;
+  bool pin_memory_;
+
+  std::mutex mutex_;
+  std::condition_variable worker_cv_;
+  std::condition_variable output_cv_;
+  std::vector<std::vector<int64_t>> batches_;
+  // batches built by a worker of the epoch that is no longer current are
+  // dropped
+  uint64_t epoch_ = 0;
+  size_t next_batch_ = 0;
+  size_t next_output_ = 0;
+  std::map<size_t, Result> done_;
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace imperative
+}  // namespace paddle
@@ -52,6 +52,7 @@ static thread_local std::shared_ptr<AmpAttrs> g_current_amp_attrs =
     std::make_shared<AmpAttrs>();
 
 static thread_local bool g_has_grad = true;
+static thread_local bool g_inference_mode = false;
 
 TEST_API void Tracer::DisableLayoutAutoTune() { use_layout_autotune_ = false; }
 TEST_API void Tracer::EnableLayoutAutoTune() {
@@ -550,6 +551,12 @@ TEST_API bool Tracer::HasGrad() const { return g_has_grad; }
 
 TEST_API void Tracer::SetHasGrad(bool has_grad) { g_has_grad = has_grad; }
 
+TEST_API bool Tracer::IsInferenceMode() const { return g_inference_mode; }
+
+TEST_API void Tracer::SetInferenceMode(bool inference_mode) {
+  g_inference_mode = inference_mode;
+}
+
 TEST_API void Tracer::SetUsePromote(bool use_promote) {
   VLOG(4) << "set use_promote to " << use_promote;
   g_current_amp_attrs->SetUsePromote(use_promote);
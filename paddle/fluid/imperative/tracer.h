@@ -144,6 +144,10 @@ class Tracer {
 
   TEST_API void SetHasGrad(bool has_grad);
 
+  TEST_API bool IsInferenceMode() const;
+
+  TEST_API void SetInferenceMode(bool inference_mode);
+
   TEST_API void SetUsePromote(bool use_promote);
 
   TEST_API bool GetUsePromote() const;
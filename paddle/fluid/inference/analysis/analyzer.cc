@@ -16,6 +16,7 @@
 
 #include <string>
 
+#include "paddle/common/startup_trace.h"
 #include "paddle/fluid/inference/analysis/passes/passes.h"
 #include "paddle/utils/string/pretty_log.h"
 
@@ -43,6 +44,7 @@ void Analyzer::RunAnalysis(Argument *argument) {
     PADDLE_ENFORCE_NOT_NULL(
         ptr,
         common::errors::PreconditionNotMet("no analysis pass called %s", pass));
+    common::StartupTraceScope startup_trace("AnalysisPass", pass);
     ptr->Run(argument);
   }
 }
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "paddle/common/errors.h"
+#include "paddle/common/startup_trace.h"
 #include "paddle/fluid/framework/ir/fuse_pass_base.h"
 #include "paddle/fluid/framework/ir/graph.h"
 #include "paddle/fluid/framework/scope.h"
@@ -315,6 +316,7 @@ std::unique_ptr<Graph> IRPassManager::Apply(std::unique_ptr<Graph> graph) {
     if (pass->Type() != "graph_viz_pass" && !disable_logs_) {
       PrettyLogEndl(Style::H2(), "--- Running IR pass [%s]", pass->Type());
     }
+    common::StartupTraceScope startup_trace("IrPass", pass->Type());
     graph.reset(pass->Apply(graph.release()));
   }
   return graph;
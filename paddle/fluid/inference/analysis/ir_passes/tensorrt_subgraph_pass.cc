@@ -15,11 +15,14 @@
 
 #include "paddle/fluid/inference/analysis/ir_passes/tensorrt_subgraph_pass.h"
 #include <fcntl.h>
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_set>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/block_desc.h"
 #include "paddle/fluid/framework/ir/graph_helper.h"
 #include "paddle/fluid/framework/ir/graph_pattern_detector.h"
@@ -38,6 +41,10 @@
 #include "paddle/phi/common/backend.h"
 #include "paddle/phi/common/data_type.h"
 
+COMMON_DECLARE_bool(trt_cost_based_partition);
+COMMON_DECLARE_double(trt_plugin_overhead_cost);
+COMMON_DECLARE_double(trt_boundary_copy_cost);
+
 namespace paddle {
 namespace inference {
 namespace analysis {
@@ -120,6 +127,103 @@ bool AllNodesLowerToTrtPostProcess(framework::ir::Graph *graph) {
   }
   return all_nodes_offload_to_trt;
 }
+
+// Whether moving the plugin op out of the subgraph ops costs less. The
+// tensors between op and the other ops would cross the boundary, and the
+// ones crossing it only for op would not. The op is moved only if none of
+// its inputs or none of its outputs is from the ops, so that the subgraph is
+// not split.
+bool PeelPluginOp(const framework::ir::Node *op,
+                  const std::unordered_set<const framework::ir::Node *> &ops) {
+  auto inside = [&](const framework::ir::Node *node) {
+    return node != op && ops.count(node) > 0;
+  };
+  int inner = 0;
+  int outer = 0;
+  bool from_ops = false;
+  bool to_ops = false;
+  for (auto *var : op->inputs) {
+    if (!var->IsVar() || !var->Var() || var->Var()->Persistable()) continue;
+    if (std::any_of(var->inputs.begin(), var->inputs.end(), inside)) {
+      from_ops = true;
+      ++inner;
+    } else if (std::none_of(
+                   var->outputs.begin(), var->outputs.end(), inside)) {
+      ++outer;
+    }
+  }
+  for (auto *var : op->outputs) {
+    if (!var->IsVar()) continue;
+    if (std::any_of(var->outputs.begin(), var->outputs.end(), inside)) {
+      to_ops = true;
+      ++inner;
+    }
+    if (std::any_of(var->outputs.begin(),
+                    var->outputs.end(),
+                    [&](const framework::ir::Node *node) {
+                      return !ops.count(node);
+                    })) {
+      ++outer;
+    }
+  }
+  if (from_ops && to_ops) return false;
+  return FLAGS_trt_plugin_overhead_cost >
+         FLAGS_trt_boundary_copy_cost * (inner - outer);
+}
+
+// The ops told by teller, less the ops converted by the generic plugin which
+// are peeled off the edges of the subgraphs by PeelPluginOp, and less the
+// subgraphs left with plugin ops only, whose engines would save nothing.
+std::unordered_set<const framework::ir::Node *> PartitionByCost(
+    framework::ir::Graph *graph,
+    const std::function<bool(const framework::ir::Node *)> &teller) {
+  std::unordered_set<const framework::ir::Node *> candidates;
+  std::unordered_set<const framework::ir::Node *> plugin_ops;
+  for (auto *node : graph->Nodes()) {
+    if (!teller(node)) continue;
+    candidates.insert(node);
+    auto converter_type = static_cast<tensorrt::OpConverterType>(
+        PADDLE_GET_CONST(int, node->Op()->GetAttr("converter_type")));
+    if (converter_type == tensorrt::OpConverterType::GenericPluginCreater) {
+      plugin_ops.insert(node);
+    }
+  }
+  if (plugin_ops.empty()) return candidates;
+
+  auto subgraphs = framework::ir::SubgraphDetector(
+      graph, [&](const framework::ir::Node *node) {
+        return candidates.count(node) > 0;
+      })();
+  for (auto &subgraph : subgraphs) {
+    std::unordered_set<const framework::ir::Node *> ops(subgraph.begin(),
+                                                        subgraph.end());
+    bool peeled = true;
+    while (peeled) {
+      peeled = false;
+      for (auto *op : subgraph) {
+        if (ops.count(op) && plugin_ops.count(op) && PeelPluginOp(op, ops)) {
+          VLOG(3) << op->Op()->Type() << " is run outside TensorRT, as it "
+                  << "costs less than its generic plugin.";
+          ops.erase(op);
+          candidates.erase(op);
+          peeled = true;
+        }
+      }
+    }
+    if (std::all_of(ops.begin(), ops.end(), [&](const auto *op) {
+          return plugin_ops.count(op) > 0;
+        })) {
+      for (auto *op : ops) {
+        candidates.erase(op);
+      }
+    }
+  }
+  // The detector marks the nodes, which SubGraphFuser detects again.
+  for (auto *node : graph->Nodes()) {
+    framework::ir::Agent(node).set_marked(false);
+  }
+  return candidates;
+}
 }  // namespace
 
 using framework::ir::Node;
@@ -183,9 +287,18 @@ void analysis::TensorRtSubgraphPass::ApplyImpl(
     return is_ok;
   };
 
+  std::function<bool(const framework::ir::Node *)> subgraph_teller = teller;
+  std::unordered_set<const framework::ir::Node *> candidates;
+  if (with_dynamic_shape && FLAGS_trt_cost_based_partition) {
+    candidates = PartitionByCost(graph, teller);
+    subgraph_teller = [&](const framework::ir::Node *node) {
+      return candidates.count(node) > 0;
+    };
+  }
+
   framework::ir::SubGraphFuser fuser(
       graph,
-      teller,
+      subgraph_teller,
       Get<int>("min_subgraph_size") /*min subgraph size*/,
       Get<std::vector<std::string>>("trt_exclude_var_names"),
       "tensorrt_engine");
@@ -521,6 +521,19 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(trt_allow_build_at_runtime_);
   CP_MEMBER(collect_shape_range_info_);
   CP_MEMBER(shape_range_info_path_);
+  CP_MEMBER(collect_allocation_profile_);
+  CP_MEMBER(replay_allocation_profile_);
+  CP_MEMBER(allocation_profile_path_);
+  CP_MEMBER(collect_int8_calibration_);
+  CP_MEMBER(enable_int8_calibration_);
+  CP_MEMBER(int8_calibration_table_path_);
+  CP_MEMBER(int8_calibration_algo_);
+  CP_MEMBER(int8_calibration_percentile_);
+  CP_MEMBER(share_parameters_);
+  CP_MEMBER(shared_parameters_ipc_dir_);
+  CP_MEMBER(gpu_tenant_);
+  CP_MEMBER(gpu_tenant_stream_priority_);
+  CP_MEMBER(gpu_tenant_memory_limit_mb_);
   CP_MEMBER(trt_use_inspector_);
   CP_MEMBER(trt_inspector_serialize_);
   CP_MEMBER(trt_use_explicit_quantization_);
@@ -551,6 +564,8 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
 
   // profile related.
   CP_MEMBER(with_profile_);
+  CP_MEMBER(with_run_trace_);
+  CP_MEMBER(with_startup_trace_);
 
   // cinn compiler related.
   CP_MEMBER(use_cinn_);
@@ -566,6 +581,7 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(use_optimized_model_);
 
   CP_MEMBER(cpu_math_library_num_threads_);
+  CP_MEMBER(cpu_thread_affinity_);
 
   CP_MEMBER(serialized_info_cache_);
 
@@ -1130,6 +1146,7 @@ std::string AnalysisConfig::SerializeInfoCache() {
 
   ss << specify_input_name_;
   ss << cpu_math_library_num_threads_;
+  for (int core : cpu_thread_affinity_) ss << core;
 
   ss << use_xpu_;
   ss << xpu_config_.device_id;
@@ -1183,6 +1200,12 @@ void AnalysisConfig::SetCpuMathLibraryNumThreads(
   Update();
 }
 
+void AnalysisConfig::SetCpuThreadAffinity(const std::vector<int> &cpu_cores) {
+  cpu_thread_affinity_ = cpu_cores;
+
+  Update();
+}
+
 float AnalysisConfig::fraction_of_gpu_memory_for_pool() const {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   // Get the GPU memory details and calculate the fraction of memory for the
@@ -1278,6 +1301,13 @@ std::string AnalysisConfig::Summary() {
   // cpu info
   os.InsertRow(
       {"cpu_math_thread", std::to_string(cpu_math_library_num_threads_)});
+  if (!cpu_thread_affinity_.empty()) {
+    std::string cores;
+    for (int core : cpu_thread_affinity_) {
+      cores += (cores.empty() ? "" : ",") + std::to_string(core);
+    }
+    os.InsertRow({"cpu_thread_affinity", cores});
+  }
   os.InsertRow({"enable_mkldnn", use_mkldnn_ ? "true" : "false"});
   os.InsertRow(
       {"mkldnn_cache_capacity", std::to_string(mkldnn_cache_capacity_)});
@@ -1425,9 +1455,32 @@ std::string AnalysisConfig::Summary() {
       {"use_optimized_model", use_optimized_model_ ? "true" : "false"});
   os.InsertRow({"memory_optim", enable_memory_optim_ ? "true" : "false"});
   os.InsertRow({"enable_profile", with_profile_ ? "true" : "false"});
+  os.InsertRow({"enable_run_trace", with_run_trace_ ? "true" : "false"});
+  os.InsertRow(
+      {"enable_startup_trace", with_startup_trace_ ? "true" : "false"});
   os.InsertRow({"enable_log", with_glog_info_ ? "true" : "false"});
   os.InsertRow({"collect_shape_range_info",
                 collect_shape_range_info_ ? shape_range_info_path_ : "false"});
+  os.InsertRow(
+      {"collect_allocation_profile",
+       collect_allocation_profile_ ? allocation_profile_path_ : "false"});
+  os.InsertRow(
+      {"replay_allocation_profile",
+       replay_allocation_profile_ ? allocation_profile_path_ : "false"});
+  os.InsertRow(
+      {"collect_int8_calibration",
+       collect_int8_calibration_ ? int8_calibration_table_path_ : "false"});
+  os.InsertRow(
+      {"enable_int8_calibration",
+       enable_int8_calibration_ ? int8_calibration_table_path_ : "false"});
+  os.InsertRow({"share_parameters", share_parameters_ ? "true" : "false"});
+  if (!gpu_tenant_.empty()) {
+    os.InsertRow({"gpu_tenant", gpu_tenant_});
+    os.InsertRow({"gpu_tenant_stream_priority",
+                  std::to_string(gpu_tenant_stream_priority_)});
+    os.InsertRow({"gpu_tenant_memory_limit_mb",
+                  std::to_string(gpu_tenant_memory_limit_mb_)});
+  }
 
   return os.PrintTable();
 }
@@ -1455,6 +1508,100 @@ bool AnalysisConfig::shape_range_info_collected() const {
   return collect_shape_range_info_;
 }
 
+void AnalysisConfig::CollectAllocationProfile(
+    const std::string &allocation_profile_path) {
+  PADDLE_ENFORCE_EQ(allocation_profile_path.empty(),
+                    false,
+                    common::errors::InvalidArgument(
+                        "The allocation_profile_path should not be empty, "
+                        "please re-check the argument."));
+  collect_allocation_profile_ = true;
+  replay_allocation_profile_ = false;
+  allocation_profile_path_ = allocation_profile_path;
+}
+
+void AnalysisConfig::EnableAllocationProfileReplay(
+    const std::string &allocation_profile_path) {
+  PADDLE_ENFORCE_EQ(allocation_profile_path.empty(),
+                    false,
+                    common::errors::InvalidArgument(
+                        "The allocation_profile_path should not be empty, "
+                        "please re-check the argument."));
+  replay_allocation_profile_ = true;
+  collect_allocation_profile_ = false;
+  allocation_profile_path_ = allocation_profile_path;
+}
+
+const std::string &AnalysisConfig::allocation_profile_path() const {
+  return allocation_profile_path_;
+}
+
+bool AnalysisConfig::allocation_profile_collected() const {
+  return collect_allocation_profile_;
+}
+
+bool AnalysisConfig::allocation_profile_replay_enabled() const {
+  return replay_allocation_profile_;
+}
+
+void AnalysisConfig::CollectInt8Calibration(const std::string &table_path,
+                                            Int8CalibrationAlgo algo,
+                                            float percentile) {
+  PADDLE_ENFORCE_EQ(table_path.empty(),
+                    false,
+                    common::errors::InvalidArgument(
+                        "The table_path should not be empty, please re-check "
+                        "the argument."));
+  PADDLE_ENFORCE_EQ(percentile > 0.f && percentile <= 100.f,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The percentile should be in (0, 100], but received "
+                        "%f.",
+                        percentile));
+  collect_int8_calibration_ = true;
+  enable_int8_calibration_ = false;
+  int8_calibration_table_path_ = table_path;
+  int8_calibration_algo_ = algo;
+  int8_calibration_percentile_ = percentile;
+}
+
+void AnalysisConfig::EnableInt8Calibration(const std::string &table_path) {
+  PADDLE_ENFORCE_EQ(table_path.empty(),
+                    false,
+                    common::errors::InvalidArgument(
+                        "The table_path should not be empty, please re-check "
+                        "the argument."));
+  enable_int8_calibration_ = true;
+  collect_int8_calibration_ = false;
+  int8_calibration_table_path_ = table_path;
+}
+
+const std::string &AnalysisConfig::int8_calibration_table_path() const {
+  return int8_calibration_table_path_;
+}
+
+bool AnalysisConfig::int8_calibration_collected() const {
+  return collect_int8_calibration_;
+}
+
+bool AnalysisConfig::int8_calibration_enabled() const {
+  return enable_int8_calibration_;
+}
+
+void AnalysisConfig::EnableSharedParameters(bool x,
+                                            const std::string &ipc_dir) {
+  share_parameters_ = x;
+  shared_parameters_ipc_dir_ = x ? ipc_dir : "";
+}
+
+void AnalysisConfig::SetGpuTenant(const std::string &name,
+                                  int stream_priority,
+                                  uint64_t memory_limit_mb) {
+  gpu_tenant_ = name;
+  gpu_tenant_stream_priority_ = stream_priority;
+  gpu_tenant_memory_limit_mb_ = memory_limit_mb;
+}
+
 void AnalysisConfig::EnableTunedTensorRtDynamicShape(
     const std::string &shape_range_info_path, bool allow_build_at_runtime) {
   shape_range_info_path_ = shape_range_info_path;
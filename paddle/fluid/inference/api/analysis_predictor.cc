@@ -19,9 +19,11 @@
 #include <algorithm>
 #include <cstdlib>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -36,6 +38,7 @@
 #include "paddle/fluid/framework/op_proto_maker.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/framework/scope.h"
+#include "paddle/fluid/framework/tensor_util.h"
 #include "paddle/fluid/framework/transfer_scope_cache.h"
 #include "paddle/fluid/framework/var_type_traits.h"
 #include "paddle/fluid/framework/version.h"
@@ -49,6 +52,7 @@
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/api/paddle_inference_pass.h"
 #include "paddle/fluid/inference/api/resource_manager.h"
+#include "paddle/fluid/inference/api/shared_parameter_store.h"
 #include "paddle/fluid/inference/utils/io_utils.h"
 #include "paddle/fluid/inference/utils/model_utils.h"
 #include "paddle/fluid/inference/utils/singleton.h"
@@ -60,14 +64,18 @@
 #include "paddle/phi/common/backend.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/common/place.h"
+#include "paddle/phi/core/memory/allocation/allocation_profiler.h"
+#include "paddle/phi/core/memory/malloc.h"
 #include "paddle/phi/core/memory/memcpy.h"
 #include "paddle/phi/core/platform/cpu_helper.h"
+#include "paddle/phi/core/platform/cuda_device_guard.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_types.h"
 #include "paddle/phi/core/platform/device_context.h"
 #include "paddle/phi/core/platform/profiler.h"
 
 #include "paddle/phi/core/generator.h"
+#include "paddle/phi/core/intra_op_parallel.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
 #include "paddle/utils/string/split.h"
 
@@ -123,6 +131,8 @@
 #include "paddle/fluid/pir/transforms/general/params_sync_among_devices_pass.h"
 #include "paddle/fluid/pir/transforms/general/remove_shadow_feed_pass.h"
 #include "paddle/fluid/pir/transforms/general/replace_fetch_with_shadow_output_pass.h"
+#include "paddle/fluid/pir/transforms/general/symbolic_memory_reuse_pass.h"
+#include "paddle/fluid/pir/transforms/general/while_loop_invariant_hoist_pass.h"
 #include "paddle/fluid/pir/transforms/passes.h"
 #include "paddle/fluid/pir/transforms/pd_op_to_kernel_pass.h"
 #include "paddle/fluid/pir/utils/general_functions.h"
@@ -135,7 +145,10 @@
 #include "paddle/pir/include/pass/pass_registry.h"
 
 COMMON_DECLARE_bool(pir_apply_inplace_pass);
+COMMON_DECLARE_bool(pir_apply_symbolic_memory_reuse_pass);
 COMMON_DECLARE_bool(enable_pir_api);
+COMMON_DECLARE_bool(enable_layout_cost_model);
+COMMON_DECLARE_bool(naive_executor_eager_deletion);
 
 namespace paddle {
 namespace {
@@ -143,9 +156,10 @@ namespace {
 void UpdatePrivateDeviceContext(InferGPUContext *gpu_context,
                                 GPUContextResource *gpu_resource,
                                 Place place_) {
-  gpu_context->SetAllocator(memory::allocation::AllocatorFacade::Instance()
-                                .GetAllocator(place_, gpu_resource->GetStream())
-                                .get());
+  gpu_context->SetAllocator(gpu_resource->GetAllocator(
+      memory::allocation::AllocatorFacade::Instance()
+          .GetAllocator(place_, gpu_resource->GetStream())
+          .get()));
   gpu_context->SetPinnedAllocator(
       memory::allocation::AllocatorFacade::Instance()
           .GetAllocator(phi::GPUPinnedPlace())
@@ -428,6 +442,11 @@ bool AnalysisPredictor::Init(
     const std::shared_ptr<framework::Scope> &parent_scope,
     const std::shared_ptr<framework::ProgramDesc> &program) {
   VLOG(3) << "Predictor::init()";
+  if (config_.startup_trace_enabled()) {
+    startup_trace_begin_ = common::StartupTrace::Instance().Begin();
+    startup_tracing_ = true;
+  }
+  common::StartupTraceScope startup_trace("Predictor", "Init");
 #ifdef PADDLE_WITH_NVTX
   if (config_.with_profile_) {
     LOG(WARNING) << "Profiler is activated, which might affect the performance";
@@ -441,7 +460,12 @@ bool AnalysisPredictor::Init(
   }
 
   // no matter with or without OneDNN
-  paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  if (!config_.cpu_thread_affinity().empty()) {
+    intra_op_thread_pool_ =
+        phi::IntraOpThreadPool::GetOrCreate(config_.cpu_thread_affinity());
+  } else {
+    paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  }
 
   std::string model_path = config_.prog_file();
   load_pir_model_ =
@@ -516,7 +540,9 @@ bool AnalysisPredictor::Init(
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   // TODO(inference): Now only gpu with external stream support private
   // device_context.
-  if (config_.use_gpu_ && config_.use_external_stream_) {
+  // The tenants of the GPU run on their own streams.
+  if (config_.use_gpu_ &&
+      (config_.use_external_stream_ || !config_.gpu_tenant().empty())) {
     private_context_ = true;
   }
   if (private_context_) {
@@ -549,12 +575,279 @@ bool AnalysisPredictor::Init(
   }
 #endif
 
+  // The clones share the scope of their parent already.
+  if (config_.shared_parameters_enabled() && !status_is_cloned_) {
+    ShareParameters();
+  }
+
+  if (config_.run_trace_enabled()) {
+    run_tracer_ = std::make_unique<RunTracer>(place_);
+    RegisterRunTraceHooks();
+  }
+  if (config_.int8_calibration_collected()) {
+    RegisterInt8CalibrationHook();
+  }
+
   TryShrinkMemory();
 
+  if (!status_is_cloned_) {
+    if (config_.allocation_profile_replay_enabled()) {
+      ReplayAllocationProfile();
+    } else if (config_.allocation_profile_collected()) {
+      memory::allocation::AllocationProfiler::Instance().Start();
+    }
+  }
+
   inference::DisplayMemoryInfo(place_, "Init predictor");
   return true;
 }
 
+void AnalysisPredictor::PrepareInt8Calibration() {
+  // The operators taking the activations the int8 kernels quantize, and the
+  // operands of the activations.
+  static const std::map<std::string, std::vector<int>> kCalibratedOps{
+      {paddle::dialect::Conv2dOp::name(), {0}},
+      {paddle::dialect::DepthwiseConv2dOp::name(), {0}},
+      {paddle::dialect::Conv2dTransposeOp::name(), {0}},
+      {paddle::dialect::MatmulOp::name(), {0, 1}}};
+  auto *ctx = pir::IrContext::Instance();
+  std::map<int, pir::Operation *> calibrated_ops;
+  int op_id = 0;
+  for (auto *op : pir_program_->block()->ops()) {
+    auto it = kCalibratedOps.find(op->name());
+    if (it == kCalibratedOps.end()) continue;
+    std::vector<pir::Attribute> operands;
+    for (int operand : it->second) {
+      auto value = op->operand_source(operand);
+      // The weights are quantized by the kernels from the parameters.
+      if (!value || pir::ValueIsPersistable(value) ||
+          !pir::GetDataTypeFromValue(value).isa<pir::Float32Type>()) {
+        continue;
+      }
+      operands.push_back(pir::Int32Attribute::get(ctx, operand));
+    }
+    if (operands.empty()) continue;
+    op->set_attribute(inference::kInt8CalibrationId,
+                      pir::Int32Attribute::get(ctx, op_id));
+    op->set_attribute(inference::kInt8CalibrationOperands,
+                      pir::ArrayAttribute::get(ctx, operands));
+    int8_calibration_op_names_[op_id] = op->name();
+    calibrated_ops[op_id++] = op;
+  }
+  if (config_.int8_calibration_enabled()) {
+    InsertInt8QuantDequantOps(calibrated_ops);
+    for (auto &item : calibrated_ops) {
+      item.second->erase_attribute(inference::kInt8CalibrationId);
+      item.second->erase_attribute(inference::kInt8CalibrationOperands);
+    }
+  }
+}
+
+void AnalysisPredictor::InsertInt8QuantDequantOps(
+    const std::map<int, pir::Operation *> &calibrated_ops) {
+  const std::string &path = config_.int8_calibration_table_path();
+  auto *ctx = pir::IrContext::Instance();
+  pir::Builder builder(ctx, pir_program_->block());
+  auto scale_type =
+      paddle::dialect::DenseTensorType::get(ctx,
+                                            pir::Float32Type::get(ctx),
+                                            common::make_ddim({1}),
+                                            common::DataLayout::NCHW,
+                                            {},
+                                            0);
+  // The scales and the zero points are parameters in the scope, where the
+  // passes consuming the pairs read them.
+  auto create_parameter = [&](const std::string &name, float value) {
+    auto *tensor = sub_scope_->Var(name)->GetMutable<phi::DenseTensor>();
+    tensor->Resize(common::make_ddim({1}));
+    *tensor->mutable_data<float>(phi::CPUPlace()) = value;
+    builder.SetInsertionPointToStart(pir_program_->block());
+    auto parameter = builder.Build<pir::ParameterOp>(name, scale_type);
+    parameter->set_attribute(
+        pir::kAttrIsPersistable,
+        builder.array_attr({builder.bool_attr(true)}));
+    return parameter.result(0);
+  };
+
+  int num_pairs = 0;
+  for (const auto &entry : inference::DeserializeInt8CalibrationTable(path)) {
+    auto it = calibrated_ops.find(entry.op_id);
+    PADDLE_ENFORCE_EQ(
+        it != calibrated_ops.end() && it->second->name() == entry.op_name &&
+            entry.operand >= 0 &&
+            entry.operand < static_cast<int>(it->second->num_operands()),
+        true,
+        common::errors::PreconditionNotMet(
+            "The int8 calibration table %s does not match the model, the "
+            "operator %d is not a %s. Please collect it again with "
+            "CollectInt8Calibration.",
+            path,
+            entry.op_id,
+            entry.op_name));
+    if (entry.threshold <= 0.f) continue;
+    auto *op = it->second;
+    const std::string prefix = "int8_calibration_" +
+                               std::to_string(entry.op_id) + "_" +
+                               std::to_string(entry.operand);
+    auto scale = create_parameter(prefix + ".scale", entry.threshold);
+    auto zero_point = create_parameter(prefix + ".zero_point", 0.f);
+    builder.set_insertion_point(op);
+    auto quantize = builder.Build<paddle::dialect::QuantizeLinearOp>(
+        op->operand_source(entry.operand),
+        scale,
+        zero_point,
+        pir::Value(),
+        pir::Value(),
+        /*quant_axis=*/-1,
+        /*bit_length=*/8,
+        /*qmin=*/-128,
+        /*qmax=*/127,
+        /*round_type=*/0,
+        /*is_test=*/true,
+        /*only_observer=*/false);
+    auto dequantize = builder.Build<paddle::dialect::DequantizeLinearOp>(
+        quantize.result(0),
+        scale,
+        zero_point,
+        pir::Value(),
+        pir::Value(),
+        /*quant_axis=*/-1,
+        /*bit_length=*/8,
+        /*qmin=*/-128,
+        /*qmax=*/127,
+        /*round_type=*/0,
+        /*is_test=*/true,
+        /*only_observer=*/false);
+    op->operand(entry.operand).set_source(dequantize.result(0));
+    ++num_pairs;
+  }
+  LOG(INFO) << "Insert " << num_pairs
+            << " int8 quantize and dequantize pairs from the calibration "
+               "table "
+            << path;
+}
+
+void AnalysisPredictor::RegisterInt8CalibrationHook() {
+  if (!config_.new_ir_enabled()) {
+    LOG(WARNING) << "The int8 calibration only works on PIR programs, please "
+                    "enable PIR by config.EnableNewIR(true).";
+    return;
+  }
+  auto hook = [this](framework::InstructionBase *instr,
+                     framework::ValueExecutionInfo *value_exe_info,
+                     framework::Scope *scope) {
+    auto *op = instr->Operation();
+    if (op == nullptr || !op->HasAttribute(inference::kInt8CalibrationId)) {
+      return;
+    }
+    int op_id =
+        op->attribute<pir::Int32Attribute>(inference::kInt8CalibrationId)
+            .data();
+    auto operands =
+        op->attribute<pir::ArrayAttribute>(inference::kInt8CalibrationOperands);
+    auto *cpu_ctx = static_cast<phi::CPUContext *>(
+        phi::DeviceContextPool::Instance().Get(phi::CPUPlace()));
+    for (size_t i = 0; i < operands.size(); ++i) {
+      int operand = operands.at(i).dyn_cast<pir::Int32Attribute>().data();
+      auto name = value_exe_info->GetVarName(op->operand_source(operand));
+      auto *var = scope->FindVar(name);
+      if (var == nullptr || !var->IsType<phi::DenseTensor>()) continue;
+      const auto &tensor = var->Get<phi::DenseTensor>();
+      if (!tensor.initialized() || tensor.numel() == 0) continue;
+      phi::DenseTensor cpu_tensor;
+      framework::TensorCopySync(tensor, phi::CPUPlace(), &cpu_tensor);
+      if (cpu_tensor.dtype() != phi::DataType::FLOAT32) {
+        cpu_tensor =
+            phi::funcs::TransDataType(*cpu_ctx, cpu_tensor, DataType::FLOAT32);
+      }
+      int8_calibration_histograms_[{op_id, operand}].Collect(
+          cpu_tensor.data<float>(), cpu_tensor.numel());
+    }
+  };
+  executor_->RegisterInputHook(hook);
+}
+
+void AnalysisPredictor::SaveInt8CalibrationTable() {
+  std::vector<inference::Int8CalibrationEntry> table;
+  for (const auto &item : int8_calibration_histograms_) {
+    const auto &histogram = item.second;
+    float threshold = 0.f;
+    switch (config_.int8_calibration_algo()) {
+      case AnalysisConfig::Int8CalibrationAlgo::kAbsMax:
+        threshold = histogram.AbsMaxThreshold();
+        break;
+      case AnalysisConfig::Int8CalibrationAlgo::kKL:
+        threshold = histogram.KLThreshold();
+        break;
+      case AnalysisConfig::Int8CalibrationAlgo::kPercentile:
+        threshold = histogram.PercentileThreshold(
+            config_.int8_calibration_percentile());
+        break;
+    }
+    table.push_back({item.first.first,
+                     int8_calibration_op_names_[item.first.first],
+                     item.first.second,
+                     threshold});
+  }
+  if (table.empty()) {
+    LOG(WARNING) << "No activation is collected by the int8 calibration, "
+                    "please run the predictor with representative inputs.";
+    return;
+  }
+  inference::SerializeInt8CalibrationTable(
+      config_.int8_calibration_table_path(), table);
+  LOG(INFO) << "Save the int8 calibration table of " << table.size()
+            << " activations to " << config_.int8_calibration_table_path();
+}
+
+void AnalysisPredictor::ReplayAllocationProfile() {
+  const std::string &path = config_.allocation_profile_path();
+  if (!FileExists(path)) {
+    LOG(WARNING) << "The allocation profile " << path
+                 << " is not found, skip the replay.";
+    return;
+  }
+  uint64_t bytes = 0;
+  for (auto &profile : memory::allocation::LoadAllocationProfiles(path)) {
+    bytes += memory::ReplayAllocationProfile(profile);
+  }
+  LOG(INFO) << "Replay the allocation profile " << path << ", " << bytes
+            << " bytes are reserved in advance.";
+}
+
+void AnalysisPredictor::ShareParameters() {
+  std::vector<std::string> param_names;
+  if (pir_program_) {
+    for (auto op : pir_program_->block()->ops()) {
+      if (op->isa<::pir::ParameterOp>()) {
+        param_names.emplace_back(
+            op->attribute<pir::StrAttribute>("parameter_name").AsString());
+      }
+    }
+  } else if (inference_program_) {
+    for (auto *var_desc : inference_program_->Block(0).AllVars()) {
+      if (var_desc->Persistable()) {
+        param_names.emplace_back(var_desc->Name());
+      }
+    }
+  }
+
+  auto &store = SharedParameterStore::Instance();
+  const size_t shared_bytes = store.SharedBytes();
+  int shared_num = 0;
+  for (const auto &name : param_names) {
+    auto *var = sub_scope_->FindVar(name);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>()) continue;
+    if (store.Share(var->GetMutable<phi::DenseTensor>(),
+                    config_.shared_parameters_ipc_dir())) {
+      ++shared_num;
+    }
+  }
+  LOG(INFO) << "Share " << shared_num << " of " << param_names.size()
+            << " parameters with other predictors, saving "
+            << (store.SharedBytes() - shared_bytes) / 1024 / 1024 << " MB.";
+}
+
 void AnalysisPredictor::InitPlace() {
   if (config_.use_gpu()) {
     PADDLE_ENFORCE_EQ(config_.use_xpu(),
@@ -675,8 +968,15 @@ void AnalysisPredictor::ClearExtraParams() {
 
 void AnalysisPredictor::InitResourceManager(void *stream) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  GPUTenant *tenant = nullptr;
+  if (!config_.gpu_tenant().empty()) {
+    tenant = ResourceManager::Instance().GetGPUTenant(
+        config_.gpu_tenant(),
+        config_.gpu_tenant_stream_priority(),
+        static_cast<size_t>(config_.gpu_tenant_memory_limit_mb()) << 20);
+  }
   predictor_stream_ =
-      ResourceManager::Instance().InitGPUResource(place_, stream);
+      ResourceManager::Instance().InitGPUResource(place_, stream, tenant);
 #endif
 }
 
@@ -806,6 +1106,8 @@ bool AnalysisPredictor::PrepareScope(
 }
 
 void AnalysisPredictor::OptimizeInferencePirProgram() {
+  common::StartupTraceScope startup_trace("Predictor",
+                                          "OptimizeInferencePirProgram");
   auto ir_printing_conditions = [this](::pir::Pass *pass,
                                        ::pir::Operation *op) {
     if (this->config_.ir_debug_passes_.empty()) {
@@ -816,7 +1118,14 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
                      pass->name()) != this->config_.ir_debug_passes_.end();
   };
 
-  if (!config_.use_optimized_model_) {
+  if (!config_.use_optimized_model_ &&
+      (config_.int8_calibration_collected() ||
+       config_.int8_calibration_enabled())) {
+    PrepareInt8Calibration();
+  }
+
+  // The calibration collects the activations of the operators as loaded.
+  if (!config_.use_optimized_model_ && !config_.int8_calibration_collected()) {
 #ifdef PADDLE_WITH_CINN
     auto CreatePassMgr = [&] {
       pir::IrContext *ctx = pir::IrContext::Instance();
@@ -883,7 +1192,12 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
           if (std::find(config_.deleted_passes_.begin(),
                         config_.deleted_passes_.end(),
                         gpu_pass) == config_.deleted_passes_.end()) {
-            pass_pm.AddPass(pir::PassRegistry::Instance().Get(gpu_pass));
+            const std::string pass_name =
+                FLAGS_enable_layout_cost_model &&
+                        gpu_pass == "transfer_layout_pass"
+                    ? "layout_cost_model_pass"
+                    : gpu_pass;
+            pass_pm.AddPass(pir::PassRegistry::Instance().Get(pass_name));
           }
         }
       }
@@ -980,6 +1294,14 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
       config_.deleted_passes_.end()) {
     basic_pass_pm.AddPass(std::move(common_subexpression_elimination_pass));
   }
+  auto while_loop_invariant_hoist_pass =
+      ::pir::CreateWhileLoopInvariantHoistPass();
+  if (std::find(config_.deleted_passes_.begin(),
+                config_.deleted_passes_.end(),
+                while_loop_invariant_hoist_pass->name()) ==
+      config_.deleted_passes_.end()) {
+    basic_pass_pm.AddPass(std::move(while_loop_invariant_hoist_pass));
+  }
   if (config_.enable_gpu_mixed_) {
     auto auto_mixed_precision_pass = ::pir::CreateAutoMixedPrecisionPass();
     if (std::find(config_.deleted_passes_.begin(),
@@ -1022,6 +1344,22 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
     constant_folding_pass->SetNotOwned(pir::Pass::kParamScopeAttr, sub_scope_);
     basic_pass_pm.AddPass(std::move(constant_folding_pass));
   }
+#ifdef PADDLE_WITH_DNNL
+  // After the optimized model is saved, which keeps the plain weights, and
+  // after the constant folding, which may produce weights.
+  if (config_.mkldnn_enabled()) {
+    auto onednn_weight_prepack_pass =
+        pir::PassRegistry::Instance().Get("onednn_weight_prepack_pass");
+    if (std::find(config_.deleted_passes_.begin(),
+                  config_.deleted_passes_.end(),
+                  onednn_weight_prepack_pass->name()) ==
+        config_.deleted_passes_.end()) {
+      onednn_weight_prepack_pass->SetNotOwned(pir::Pass::kParamScopeAttr,
+                                              sub_scope_);
+      basic_pass_pm.AddPass(std::move(onednn_weight_prepack_pass));
+    }
+  }
+#endif
   auto dead_code_elimination_pass = ::pir::CreateDeadCodeEliminationPass();
   if (std::find(config_.deleted_passes_.begin(),
                 config_.deleted_passes_.end(),
@@ -1039,6 +1377,15 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
       config_.deleted_passes_.end()) {
     basic_pass_pm.AddPass(std::move(replace_fetch_with_shadow_output_pass));
   }
+  if (FLAGS_pir_apply_symbolic_memory_reuse_pass) {
+    auto symbolic_memory_reuse_pass = ::pir::CreateSymbolicMemoryReusePass();
+    if (std::find(config_.deleted_passes_.begin(),
+                  config_.deleted_passes_.end(),
+                  symbolic_memory_reuse_pass->name()) ==
+        config_.deleted_passes_.end()) {
+      basic_pass_pm.AddPass(std::move(symbolic_memory_reuse_pass));
+    }
+  }
   if (!config_.glog_info_disabled()) {
     basic_pass_pm.EnablePrintStatistics();
   }
@@ -1084,6 +1431,8 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
 }
 
 bool AnalysisPredictor::SaveOrLoadPirParameters(bool for_save) {
+  common::StartupTraceScope startup_trace(
+      "Predictor", for_save ? "SavePirParameters" : "LoadPirParameters");
   std::vector<std::pair<std::string, pir::Value>> param_name_var_pairs;
   int feed_idx = 0;
   pir_feeds_.clear();
@@ -1173,11 +1522,14 @@ bool AnalysisPredictor::SaveOrLoadPirParameters(bool for_save) {
   } else {
     pir::LoadCombineFunction(
         config_.params_file(), param_names, &tensor_out, false, place_);
+    param_scope_ = sub_scope_;
+    param_names_ = param_names;
   }
   return true;
 }
 
 bool AnalysisPredictor::PreparePirProgram() {
+  common::StartupTraceScope startup_trace("Predictor", "PreparePirProgram");
   pir::IrContext *ctx = pir::IrContext::Instance();
   ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
 
@@ -1197,6 +1549,7 @@ bool AnalysisPredictor::PreparePirProgram() {
 
 bool AnalysisPredictor::PrepareProgram(
     const std::shared_ptr<framework::ProgramDesc> &program) {
+  common::StartupTraceScope startup_trace("Predictor", "PrepareProgram");
   if (!program) {
     if (!LoadProgramDesc()) return false;
     // If not cloned, the parameters should be loaded.
@@ -1301,6 +1654,7 @@ static void DisablePrepareDataOpt(
 }
 
 bool AnalysisPredictor::PrepareExecutor() {
+  common::StartupTraceScope startup_trace("Predictor", "PrepareExecutor");
   PADDLE_ENFORCE_NOT_NULL(sub_scope_,
                           common::errors::PreconditionNotMet(
                               "The sub_scope should not be nullptr."));
@@ -1353,6 +1707,13 @@ bool AnalysisPredictor::PrepareExecutor() {
         pass_res_info->Get<std::unordered_map<std::string, std::string>>(
             root_predictor_id_, "memory_optimize_pass");
     executor_->MakeReusePlan(reuse_table);
+  } else if (FLAGS_naive_executor_eager_deletion &&
+             !config_.new_executor_enabled() && !config_.new_ir_enabled()) {
+    std::vector<std::string> skip_vars = GetInputNames();
+    auto output_names = GetOutputNames();
+    skip_vars.insert(
+        skip_vars.end(), output_names.begin(), output_names.end());
+    executor_->MakeGarbageCollectPlan(inference_program_->Block(0), skip_vars);
   }
   return true;
 }
@@ -1719,7 +2080,14 @@ void AnalysisPredictor::MkldnnPostReset() {
 bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
                             std::vector<PaddleTensor> *output_data,
                             int batch_size) {
-  paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  // The outputs of the pending async run are kept until its callback.
+  WaitAsyncRun();
+  std::shared_lock<std::shared_mutex> params_lock(*params_mutex_);
+  FirstRunTrace first_run_trace(this);
+  phi::IntraOpThreadPoolGuard intra_op_guard(intra_op_thread_pool_.get());
+  if (!intra_op_thread_pool_) {
+    paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  }
 #ifdef PADDLE_WITH_DNNL
   if (config_.use_mkldnn_) MkldnnPreSet(inputs);
 #endif
@@ -1729,6 +2097,8 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
   PADDLE_ENFORCE_NOT_NULL(
       scope,
       common::errors::PreconditionNotMet("The scope should not be nullptr."));
+  BeginRunTrace();
+  TraceRunPhase("feed");
   if (!SetFeed(inputs, scope)) {
     LOG(ERROR) << "fail to set feed";
     return false;
@@ -1749,6 +2119,7 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
     HookCollectShapeRangeInfo();
   }
 
+  TraceRunPhase("execute");
   if (config_.new_executor_enabled()) {  // NOLINT
     executor_->RunInterpreterCore();
   } else {
@@ -1758,10 +2129,12 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
   }
 
   // get fetch variable
+  TraceRunPhase("fetch");
   if (!GetFetch(output_data, scope)) {
     LOG(ERROR) << "fail to get fetches";
     return false;
   }
+  TraceRunPhase("");
 
   // All the containers in the scope will be hold in inference, but the
   // operators assume that the container will be reset after each batch.
@@ -1775,7 +2148,9 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
 
   // recover the cpu_math_library_num_threads to 1, in order to avoid thread
   // conflict when integrating it into deployment service.
-  paddle::platform::SetNumThreads(1);
+  if (!intra_op_thread_pool_) {
+    paddle::platform::SetNumThreads(1);
+  }
 #ifdef PADDLE_WITH_DNNL
   if (config_.use_mkldnn_) MkldnnPostReset();
 #endif
@@ -1790,13 +2165,20 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
 
 bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
                             std::vector<paddle::Tensor> *outputs) {
+  // The outputs of the pending async run are kept until its callback.
+  WaitAsyncRun();
+  std::shared_lock<std::shared_mutex> params_lock(*params_mutex_);
+  FirstRunTrace first_run_trace(this);
   inference::DisplayMemoryInfo(place_, "before run");
   if (private_context_) {
     phi::DeviceContextPool::SetDeviceContexts(&device_contexts_);
     auto &pool = paddle::experimental::DeviceContextPool::Instance();
     pool.SyncDeviceContext(place_);
   }
-  paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  phi::IntraOpThreadPoolGuard intra_op_guard(intra_op_thread_pool_.get());
+  if (!intra_op_thread_pool_) {
+    paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  }
 #ifdef PADDLE_WITH_DNNL
   if (config_.use_mkldnn_) MkldnnPreSet(inputs);
 #endif
@@ -1815,6 +2197,8 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
   PADDLE_ENFORCE_NOT_NULL(
       scope,
       common::errors::PreconditionNotMet("The scope should not be nullptr."));
+  BeginRunTrace();
+  TraceRunPhase("feed");
   if (!SetFeed(inputs, scope)) {
     LOG(ERROR) << "fail to set feed";
     return false;
@@ -1856,9 +2240,15 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
                              config_.xpu_config_.l3_ptr,
                              config_.xpu_config_.l3_autotune_size,
                              place_);
+    if (config_.xpu_config_.l3_autotune_size > 0) {
+      std::call_once(register_l3_hook_flag_, [this, infer_xpu_ctx] {
+        HookRecordL3Uses(infer_xpu_ctx);
+      });
+    }
   }
 #endif
 
+  TraceRunPhase("execute");
 #if defined(PADDLE_WITH_DISTRIBUTE) && defined(PADDLE_WITH_PSCORE)
   if (config_.dist_config().use_dist_model()) {  // NOLINT
     VLOG(3) << "ZeroCopyRun will use the fleet executor.";
@@ -1887,10 +2277,12 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
   }
 #endif
   // get fetch variable
+  TraceRunPhase("fetch");
   if (!GetFetch(outputs, scope)) {
     LOG(ERROR) << "fail to get fetches";
     return false;
   }
+  TraceRunPhase("");
 
   // Fix TensorArray reuse not cleaned bug.
   tensor_array_batch_cleaner_.CollectTensorArrays(sub_scope_);
@@ -1898,7 +2290,9 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
 
   // recover the cpu_math_library_num_threads to 1, in order to avoid thread
   // conflict when integrating it into deployment service.
-  paddle::platform::SetNumThreads(1);
+  if (!intra_op_thread_pool_) {
+    paddle::platform::SetNumThreads(1);
+  }
   if (private_context_) {
     phi::DeviceContextPool::SetDeviceContexts(nullptr);
   }
@@ -1917,6 +2311,8 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
 bool AnalysisPredictor::SetFeed(const std::vector<PaddleTensor> &inputs,
                                 framework::Scope *scope) {
   VLOG(3) << "Predictor::set_feed";
+  platform::RecordEvent record_event(
+      "AnalysisPredictor::SetFeed", phi::TracerEventType::Dataloader, 1);
   if (inputs.size() != feeds_.size()) {
     LOG(ERROR) << "wrong feed input size, need " << feeds_.size() << " but get "
                << inputs.size();
@@ -1952,6 +2348,8 @@ bool AnalysisPredictor::SetFeed(const std::vector<PaddleTensor> &inputs,
 bool AnalysisPredictor::SetFeed(const std::vector<paddle::Tensor> &inputs,
                                 framework::Scope *scope) {
   VLOG(3) << "Predictor::set_feed";
+  platform::RecordEvent record_event(
+      "AnalysisPredictor::SetFeed", phi::TracerEventType::Dataloader, 1);
   if (load_pir_model_) {
     PADDLE_ENFORCE_EQ(inputs.size(),
                       pir_feeds_.size(),
@@ -2334,6 +2732,8 @@ void AnalysisPredictor::PrepareArgument() {
 
 // NOTE All the members in AnalysisConfig should be copied to Argument.
 void AnalysisPredictor::OptimizeInferenceProgram() {
+  common::StartupTraceScope startup_trace("Predictor",
+                                          "OptimizeInferenceProgram");
   PrepareArgument();
   Analyzer().Run(argument_.get());
   PADDLE_ENFORCE_EQ(
@@ -2750,6 +3150,10 @@ std::unique_ptr<ZeroCopyTensor> AnalysisPredictor::GetOutputTensor(
 }
 
 bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
+  // The outputs of the pending async run are kept until its callback.
+  WaitAsyncRun();
+  std::shared_lock<std::shared_mutex> params_lock(*params_mutex_);
+  FirstRunTrace first_run_trace(this);
   inference::DisplayMemoryInfo(place_, "before run");
 #if defined(PADDLE_WITH_DISTRIBUTE) && defined(PADDLE_WITH_PSCORE)
   if (config_.dist_config().use_dist_model()) {  // NOLINT
@@ -2763,7 +3167,10 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
     auto &pool = paddle::experimental::DeviceContextPool::Instance();
     pool.SyncDeviceContext(place_);
   }
-  paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  phi::IntraOpThreadPoolGuard intra_op_guard(intra_op_thread_pool_.get());
+  if (!intra_op_thread_pool_) {
+    paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
+  }
 #ifdef PADDLE_WITH_DNNL
   if (config_.use_mkldnn_) {
     std::vector<std::vector<int>> shape_vector;
@@ -2816,14 +3223,25 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
                              config_.xpu_config_.l3_ptr,
                              config_.xpu_config_.l3_autotune_size,
                              place_);
+    if (config_.xpu_config_.l3_autotune_size > 0) {
+      std::call_once(register_l3_hook_flag_, [this, infer_xpu_ctx] {
+        HookRecordL3Uses(infer_xpu_ctx);
+      });
+    }
   }
 #endif
 
+  const auto output_buffers = CollectOutputBuffers();
+  BeginRunTrace();
+  TraceRunPhase("execute");
   if (config_.new_executor_enabled()) {  // NOLINT
     executor_->RunInterpreterCore({}, false, switch_stream);
   } else {
     executor_->Run();
   }
+  TraceRunPhase("fetch");
+  WriteOutputBuffers(output_buffers);
+  TraceRunPhase("");
   inference::DisplayMemoryInfo(place_, "after run");
 
 #ifdef PADDLE_WITH_XPU
@@ -2851,7 +3269,9 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
 
   // recover the cpu_math_library_num_threads to 1, in order to avoid thread
   // conflict when integrating it into deployment service.
-  paddle::platform::SetNumThreads(1);
+  if (!intra_op_thread_pool_) {
+    paddle::platform::SetNumThreads(1);
+  }
   if (private_context_) {
     phi::DeviceContextPool::SetDeviceContexts(nullptr);
   }
@@ -2867,6 +3287,143 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
   return true;
 }
 
+AnalysisPredictor::OutputBuffers AnalysisPredictor::CollectOutputBuffers()
+    const {
+  OutputBuffers buffers;
+  auto *scope = executor_->GetScope();
+  for (auto &item : idx2fetches_) {
+    auto *var = scope->FindVar(item.second);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>()) continue;
+    auto buffer = std::dynamic_pointer_cast<details::OutputBufferAllocation>(
+        var->Get<phi::DenseTensor>().Holder());
+    if (buffer) {
+      buffers.emplace_back(item.second, std::move(buffer));
+    }
+  }
+  return buffers;
+}
+
+void AnalysisPredictor::WriteOutputBuffers(const OutputBuffers &buffers) {
+  auto *scope = executor_->GetScope();
+  for (const auto &item : buffers) {
+    const auto &buffer = item.second;
+    auto *output = scope->FindVar(item.first)->GetMutable<phi::DenseTensor>();
+    PADDLE_ENFORCE_EQ(output->dtype(),
+                      buffer->dtype(),
+                      common::errors::InvalidArgument(
+                          "The output %s is %s, but the buffer bound to it is "
+                          "%s.",
+                          item.first,
+                          phi::DataTypeToString(output->dtype()),
+                          phi::DataTypeToString(buffer->dtype())));
+    const size_t bytes = output->numel() * phi::SizeOf(output->dtype());
+    PADDLE_ENFORCE_LE(bytes,
+                      buffer->size(),
+                      common::errors::InvalidArgument(
+                          "The output %s of %d bytes does not fit in the %d "
+                          "bytes of the buffer bound to it.",
+                          item.first,
+                          bytes,
+                          buffer->size()));
+    if (output->Holder() == buffer) {
+      if (output->meta().offset == 0) continue;
+      // The output is a view into the buffer, copied aside first.
+      phi::DenseTensor view = *output;
+      *output = phi::DenseTensor();
+      framework::TensorCopySync(view, view.place(), output);
+    }
+    VLOG(4) << "Copy the output " << item.first << " into its buffer";
+    phi::DenseTensorMeta meta = output->meta();
+    meta.offset = 0;
+    phi::DenseTensor bound(buffer, meta);
+    if (phi::is_cpu_place(buffer->place()) &&
+        !phi::is_cpu_place(output->place())) {
+      // The caller reads the host buffer right after the run.
+      framework::TensorCopySync(*output, buffer->place(), &bound);
+    } else {
+      framework::TensorCopy(*output,
+                            buffer->place(),
+                            *phi::DeviceContextPool::Instance().Get(place_),
+                            &bound);
+    }
+    *output = std::move(bound);
+  }
+}
+
+bool AnalysisPredictor::ZeroCopyRunAsync(std::function<void(bool)> callback) {
+  if (!ZeroCopyRun()) {
+    if (callback) callback(false);
+    return false;
+  }
+
+  std::function<bool()> wait_device = [] { return true; };
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (place_.GetType() == phi::AllocationType::GPU) {
+    auto stream = static_cast<gpuStream_t>(GetExecStream());
+#ifdef PADDLE_WITH_HIP
+    if (async_run_event_ == nullptr) {
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          hipEventCreateWithFlags(&async_run_event_, hipEventDisableTiming));
+    }
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventRecord(async_run_event_, stream));
+    wait_device = [event = async_run_event_] {
+      return hipEventSynchronize(event) == hipSuccess;
+    };
+#else
+    if (async_run_event_ == nullptr) {
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaEventCreateWithFlags(&async_run_event_, cudaEventDisableTiming));
+    }
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(async_run_event_, stream));
+    wait_device = [event = async_run_event_] {
+      return cudaEventSynchronize(event) == cudaSuccess;
+    };
+#endif
+  }
+#endif
+
+  std::lock_guard<std::mutex> lock(async_run_mutex_);
+  if (!async_run_thread_.joinable()) {
+    async_run_thread_ = std::thread(&AnalysisPredictor::AsyncRunLoop, this);
+  }
+  async_run_task_ = [wait_device, callback] {
+    bool success = wait_device();
+    if (callback) callback(success);
+  };
+  async_run_cv_.notify_all();
+  return true;
+}
+
+void AnalysisPredictor::AsyncRunLoop() {
+  std::unique_lock<std::mutex> lock(async_run_mutex_);
+  while (true) {
+    async_run_cv_.wait(lock,
+                       [this] { return async_run_task_ || async_run_exit_; });
+    if (!async_run_task_) break;
+    // The task is not changed until it is reset below.
+    lock.unlock();
+    try {
+      async_run_task_();
+    } catch (const std::exception &e) {
+      LOG(ERROR) << "The callback of ZeroCopyRunAsync throws: " << e.what();
+    }
+    lock.lock();
+    async_run_task_ = nullptr;
+    async_run_cv_.notify_all();
+  }
+}
+
+void AnalysisPredictor::WaitAsyncRun() {
+  std::unique_lock<std::mutex> lock(async_run_mutex_);
+  PADDLE_ENFORCE_EQ(
+      std::this_thread::get_id() != async_run_thread_.get_id(),
+      true,
+      common::errors::PreconditionNotMet(
+          "The predictor can not be run in the callback of ZeroCopyRunAsync, "
+          "since the run waits for the callback."));
+  async_run_cv_.wait(lock, [this] { return !async_run_task_; });
+}
+
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 bool AnalysisPredictor::ExpRunWithExternalStream(const gpuStream_t stream) {
   if (!private_context_) {
@@ -3000,6 +3557,19 @@ void AnalysisPredictor::HookCollectShapeRangeInfo() {
   RegisterInputHook(hook);
 }
 
+#ifdef PADDLE_WITH_XPU
+void AnalysisPredictor::HookRecordL3Uses(InferXPUContext *infer_xpu_ctx) {
+  auto hook = [infer_xpu_ctx](const std::string &op_type,
+                              const std::string &input_name,
+                              const paddle::Tensor &input_tensor) -> void {
+    if (!input_tensor.is_dense_tensor()) return;
+    auto *tensor = static_cast<phi::DenseTensor *>(input_tensor.impl().get());
+    infer_xpu_ctx->RecordL3Use(tensor->Holder().get());
+  };
+  RegisterInputHook(hook);
+}
+#endif
+
 bool AnalysisPredictor::ExpRunWithRuntimeConfig(void *config) {
 #ifdef PADDLE_WITH_XPU
   auto xpu_runtime_config =
@@ -3093,6 +3663,7 @@ void AnalysisPredictor::StatisticShapeRangeInfo() {
 }
 
 bool AnalysisPredictor::LoadProgramDesc() {
+  common::StartupTraceScope startup_trace("Predictor", "LoadProgramDesc");
   // Initialize the inference program
   std::string filename;
   if (!config_.model_dir().empty()) {  // NOLINT
@@ -3142,6 +3713,7 @@ bool AnalysisPredictor::LoadProgramDesc() {
 }
 
 bool AnalysisPredictor::LoadParameters() {
+  common::StartupTraceScope startup_trace("Predictor", "LoadParameters");
   PADDLE_ENFORCE_NOT_NULL(inference_program_.get(),
                           common::errors::PreconditionNotMet(
                               "The inference program should be loaded first."));
@@ -3195,7 +3767,112 @@ bool AnalysisPredictor::LoadParameters() {
   e.Prepare(scope_.get(), *load_program, 0);
   e.Run();
   VLOG(3) << "get " << scope_->LocalVarNames().size() << " vars after load";
+  if (!params.empty()) {
+    param_scope_ = scope_.get();
+    param_names_ = params;
+  }
+
+  return true;
+}
+
+bool AnalysisPredictor::UpdateParameters(const std::string &params_file) {
+  if (param_scope_ == nullptr || param_names_.empty()) {
+    LOG(ERROR) << "Only the parameters loaded from a params file can be "
+                  "updated.";
+    return false;
+  }
+#ifdef PADDLE_WITH_DNNL
+  if (config_.use_mkldnn_) {
+    LOG(ERROR) << "The parameters can not be updated with oneDNN, which "
+                  "caches the reordered weights.";
+    return false;
+  }
+#endif
+
+  // The parameters read by the optimized program. The ones fused or folded
+  // into other parameters by the passes, or built into the TensorRT engines
+  // or the CINN kernels, are not read any more, and the derived weights can
+  // not be rebuilt from the new values.
+  std::unordered_set<std::string> used_params;
+  if (pir_program_ != nullptr) {
+    for (auto op : pir_program_->block()->ops()) {
+      if (op->isa<::pir::ParameterOp>()) {
+        used_params.insert(
+            op->attribute<pir::StrAttribute>("parameter_name").AsString());
+      }
+    }
+  } else {
+    for (size_t i = 0; i < inference_program_->Size(); ++i) {
+      for (auto *op : inference_program_->Block(i).AllOps()) {
+        for (auto &name : op->InputArgumentNames()) {
+          used_params.insert(name);
+        }
+      }
+    }
+  }
+
+  // Load the new parameters aside while the runs go on.
+  std::vector<phi::DenseTensor> staged(param_names_.size());
+  std::vector<phi::DenseTensor *> staged_out;
+  for (auto &tensor : staged) {
+    staged_out.push_back(&tensor);
+  }
+  try {
+    pir::LoadCombineFunction(
+        params_file, param_names_, &staged_out, false, place_);
+  } catch (const std::exception &e) {
+    LOG(ERROR) << "Failed to load the parameters from " << params_file << ": "
+               << e.what();
+    return false;
+  }
 
+  std::vector<phi::DenseTensor *> targets;
+  for (size_t i = 0; i < param_names_.size(); ++i) {
+    const std::string &name = param_names_[i];
+    auto *var = param_scope_->FindVar(name);
+    if (!used_params.count(name) || var == nullptr ||
+        !var->IsType<phi::DenseTensor>()) {
+      LOG(ERROR) << "The parameter " << name
+                 << " is transformed by the optimization, and can not be "
+                    "updated without rebuilding the predictor.";
+      return false;
+    }
+    auto *target = var->GetMutable<phi::DenseTensor>();
+    if (target->dims() != staged[i].dims() ||
+        target->dtype() != staged[i].dtype()) {
+      LOG(ERROR) << "The parameter " << name << " of dims " << target->dims()
+                 << " and dtype " << target->dtype()
+                 << " can not be updated by the one of dims "
+                 << staged[i].dims() << " and dtype " << staged[i].dtype()
+                 << ".";
+      return false;
+    }
+    if (target->place() != staged[i].place()) {
+      phi::DenseTensor copied;
+      framework::TensorCopySync(staged[i], target->place(), &copied);
+      staged[i] = copied;
+    }
+    targets.push_back(target);
+  }
+
+  // Swap between two runs. The executors read the tensors of the scope at
+  // each run, so that they run with the new parameters from the next run.
+  std::unique_lock<std::shared_mutex> params_lock(*params_mutex_);
+  // The kernels launched by the earlier runs, of this predictor or of its
+  // clones on their own streams, may still read the old parameters on the
+  // device, which are freed by the swap.
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::is_gpu_place(place_)) {
+    platform::CUDADeviceGuard guard(place_.GetDeviceId());
+    platform::GpuDeviceSync();
+  }
+#endif
+  phi::DeviceContextPool::Instance().Get(place_)->Wait();
+  for (size_t i = 0; i < targets.size(); ++i) {
+    targets[i]->ShareDataWith(staged[i]);
+  }
+  LOG(INFO) << "Updated " << targets.size() << " parameters from "
+            << params_file;
   return true;
 }
 
@@ -3284,6 +3961,24 @@ bool AnalysisPredictor::SaveTrtCalibToDisk() {
 #endif
 
 AnalysisPredictor::~AnalysisPredictor() {  // NOLINT
+  EndStartupTrace();
+  if (async_run_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(async_run_mutex_);
+      async_run_exit_ = true;
+    }
+    async_run_cv_.notify_all();
+    async_run_thread_.join();
+  }
+#if defined(PADDLE_WITH_HIP)
+  if (async_run_event_ != nullptr) {
+    hipEventDestroy(async_run_event_);
+  }
+#elif defined(PADDLE_WITH_CUDA)
+  if (async_run_event_ != nullptr) {
+    cudaEventDestroy(async_run_event_);
+  }
+#endif
 #ifdef PADDLE_WITH_TENSORRT
   if (config_.tensorrt_engine_enabled() &&
       config_.tensorrt_precision_mode_ == AnalysisConfig::Precision::kInt8 &&
@@ -3312,6 +4007,15 @@ AnalysisPredictor::~AnalysisPredictor() {  // NOLINT
   if (config_.shape_range_info_collected()) {
     StatisticShapeRangeInfo();
   }
+  if (config_.allocation_profile_collected() && !status_is_cloned_) {
+    auto &profiler = memory::allocation::AllocationProfiler::Instance();
+    profiler.Stop();
+    memory::allocation::SaveAllocationProfiles(
+        config_.allocation_profile_path(), profiler.GetProfiles());
+  }
+  if (config_.int8_calibration_collected() && !status_is_cloned_) {
+    SaveInt8CalibrationTable();
+  }
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   if (predictor_stream_ != nullptr) {
     ResourceManager::Instance().DestroyGPUResource(predictor_stream_);
@@ -3348,6 +4052,9 @@ std::unique_ptr<PaddlePredictor> AnalysisPredictor::Clone(void *stream) {
         "function has received a stream parameter."));
   }
   x->predictor_stream_ = stream;
+  x->params_mutex_ = params_mutex_;
+  x->param_scope_ = param_scope_;
+  x->param_names_ = param_names_;
   x->Init(scope_, inference_program_);
 #ifdef PADDLE_WITH_TENSORRT
   x->executor_->ResetTrtOps(++AnalysisPredictor::clone_num_);
@@ -3454,6 +4161,129 @@ void AnalysisPredictor::RegisterInputHook(const InputTensorHookFunc &hookfunc) {
   }
 }
 
+namespace {
+
+// The kind of the span of an operator, so that the TensorRT engines and the
+// CINN groups can be told from the phi operators.
+std::string RunTraceOpKind(const std::string &op_type) {
+  if (op_type == "tensorrt_engine" || op_type == "pd_op.tensorrt_engine") {
+    return "tensorrt_engine";
+  }
+  if (op_type == "cinn_launch" || op_type == "cinn_instruction_run" ||
+      op_type == "cinn_jit") {
+    return "cinn_group";
+  }
+  return "op";
+}
+
+}  // namespace
+
+void AnalysisPredictor::RegisterRunTraceHooks() {
+  auto *tracer = run_tracer_.get();
+  if (config_.new_ir_enabled()) {
+    executor_->RegisterInputHook([tracer](framework::InstructionBase *instr,
+                                          framework::ValueExecutionInfo *,
+                                          framework::Scope *) {
+      tracer->BeginOp(instr,
+                      instr->Name(),
+                      {{"paddle.op.kind", RunTraceOpKind(instr->Name())},
+                       {"paddle.op.id", std::to_string(instr->Id())}});
+    });
+    executor_->RegisterOutputHook([tracer](framework::InstructionBase *instr,
+                                           framework::ValueExecutionInfo *,
+                                           framework::Scope *) {
+      tracer->EndOp(instr);
+    });
+  } else {
+    executor_->RegisterInputHook(
+        [tracer](framework::OperatorBase *op, framework::Scope *) {
+          std::map<std::string, std::string> attributes{
+              {"paddle.op.kind", RunTraceOpKind(op->Type())}};
+          if (op->HasAttr("engine_key")) {
+            attributes["paddle.trt.engine_key"] =
+                op->Attr<std::string>("engine_key");
+          }
+          tracer->BeginOp(op, op->Type(), std::move(attributes));
+        });
+    executor_->RegisterOutputHook(
+        [tracer](framework::OperatorBase *op, framework::Scope *) {
+          tracer->EndOp(op);
+        });
+  }
+}
+
+void AnalysisPredictor::BeginRunTrace() {
+  if (run_tracer_ == nullptr) return;
+  run_tracer_->BeginRun("paddle_inference.run", GetExecStream());
+  run_trace_phase_ = -1;
+}
+
+void AnalysisPredictor::TraceRunPhase(const std::string &phase) {
+  if (run_tracer_ == nullptr) return;
+  if (run_trace_phase_ >= 0) {
+    run_tracer_->EndSpan(run_trace_phase_);
+    run_trace_phase_ = -1;
+  }
+  if (phase.empty()) {
+    run_tracer_->EndRun();
+    return;
+  }
+  run_trace_phase_ =
+      run_tracer_->BeginSpan("paddle_inference." + phase, RunTracer::kRunSpan);
+  run_tracer_->SetOpParent(run_trace_phase_);
+}
+
+void AnalysisPredictor::SetTraceParent(const std::string &trace_id,
+                                       const std::string &parent_span_id) {
+  if (run_tracer_ == nullptr) {
+    LOG(WARNING) << "The run trace is not enabled, SetTraceParent is ignored.";
+    return;
+  }
+  run_tracer_->SetParent(trace_id, parent_span_id);
+}
+
+std::vector<TraceSpan> AnalysisPredictor::GetLastRunTrace() {
+  if (run_tracer_ == nullptr) return {};
+  return run_tracer_->Spans();
+}
+
+AnalysisPredictor::FirstRunTrace::FirstRunTrace(AnalysisPredictor *predictor)
+    : predictor_(predictor) {
+  if (predictor_->startup_tracing_) {
+    scope_ =
+        std::make_unique<common::StartupTraceScope>("Predictor", "FirstRun");
+  }
+}
+
+AnalysisPredictor::FirstRunTrace::~FirstRunTrace() {
+  if (scope_) {
+    scope_.reset();
+    predictor_->EndStartupTrace();
+  }
+}
+
+void AnalysisPredictor::EndStartupTrace() {
+  if (!startup_tracing_) return;
+  startup_trace_ = common::StartupTrace::Instance().End(startup_trace_begin_);
+  startup_tracing_ = false;
+}
+
+std::string AnalysisPredictor::GetStartupSummary() {
+  EndStartupTrace();
+  return common::StartupTrace::Summary(startup_trace_);
+}
+
+void AnalysisPredictor::ExportStartupTrace(const std::string &path) {
+  EndStartupTrace();
+  std::ofstream os(path);
+  PADDLE_ENFORCE_EQ(
+      os.is_open(),
+      true,
+      common::errors::Unavailable("Cannot open %s to write the startup trace.",
+                                  path));
+  os << common::StartupTrace::ToChromeTrace(startup_trace_);
+}
+
 template <>
 std::unique_ptr<PaddlePredictor> CreatePaddlePredictor<AnalysisConfig>(
     const AnalysisConfig &config) {
@@ -3736,6 +4566,10 @@ std::map<std::string, DataType> Predictor::GetOutputTypes() {
 
 bool Predictor::Run() { return predictor_->ZeroCopyRun(); }
 
+bool Predictor::RunAsync(std::function<void(bool)> callback) {
+  return predictor_->ZeroCopyRunAsync(std::move(callback));
+}
+
 bool Predictor::Run(const std::vector<paddle::Tensor> &inputs,
                     std::vector<paddle::Tensor> *outputs) {
   return predictor_->Run(inputs, outputs);
@@ -3762,6 +4596,27 @@ void Predictor::RegisterInputHook(const InputTensorHookFunc &hookfunc) {
 
 void *Predictor::GetExecStream() const { return predictor_->GetExecStream(); }
 
+void Predictor::SetTraceParent(const std::string &trace_id,
+                               const std::string &parent_span_id) {
+  predictor_->SetTraceParent(trace_id, parent_span_id);
+}
+
+std::vector<TraceSpan> Predictor::GetLastRunTrace() {
+  return predictor_->GetLastRunTrace();
+}
+
+bool Predictor::UpdateParameters(const std::string &params_file) {
+  return predictor_->UpdateParameters(params_file);
+}
+
+std::string Predictor::GetStartupSummary() {
+  return predictor_->GetStartupSummary();
+}
+
+void Predictor::ExportStartupTrace(const std::string &path) {
+  predictor_->ExportStartupTrace(path);
+}
+
 int GetNumBytesOfDataType(DataType dtype) {
   switch (dtype) {
     case DataType::FLOAT32:
@@ -3778,6 +4633,10 @@ int GetNumBytesOfDataType(DataType dtype) {
   }
 }
 
+std::string TraceSpansToOtlpJson(const std::vector<TraceSpan> &spans) {
+  return paddle::TraceSpansToOtlpJson(spans);
+}
+
 std::string GetVersion() { return paddle::get_version(); }
 
 std::tuple<int, int, int> GetTrtCompileVersion() {
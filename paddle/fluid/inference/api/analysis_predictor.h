@@ -15,21 +15,31 @@
 #pragma once
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "paddle/common/startup_trace.h"
 #include "paddle/fluid/framework/naive_executor.h"
 #include "paddle/fluid/framework/op_compatible_info.h"
 #include "paddle/fluid/inference/analysis/analyzer.h"
 #include "paddle/fluid/inference/api/api_impl.h"
+#include "paddle/fluid/inference/api/details/output_buffer.h"
 #include "paddle/fluid/inference/api/details/reset_tensor_array.h"
 #include "paddle/fluid/inference/api/helper.h"
+#include "paddle/fluid/inference/api/int8_calibration.h"
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/api/resource_manager.h"
+#include "paddle/fluid/inference/api/run_tracer.h"
 #include "paddle/phi/common/bfloat16.h"
 #include "paddle/phi/common/float16.h"
+#include "paddle/phi/core/intra_op_parallel.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_types.h"
 #include "paddle/utils/string/printf.h"
 
@@ -72,6 +82,10 @@ using framework::proto::ProgramDesc;
 using inference::analysis::Analyzer;
 using inference::analysis::Argument;
 
+#ifdef PADDLE_WITH_XPU
+class InferXPUContext;
+#endif
+
 ///
 /// \class AnalysisPredictor
 ///
@@ -214,6 +228,15 @@ class AnalysisPredictor : public PaddlePredictor {
   ///
   bool ZeroCopyRun(bool switch_stream = false) override;
 
+  ///
+  /// \brief Run the prediction engine without waiting for the device, the
+  /// callback is invoked in another thread when the outputs are ready.
+  ///
+  /// \param callback The function invoked with whether the run is successful
+  /// \return Whether the work is enqueued successfully
+  ///
+  bool ZeroCopyRunAsync(std::function<void(bool)> callback) override;
+
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   // Note: Can only be used under thread_local semantics.
   bool ExpRunWithExternalStream(const gpuStream_t stream);
@@ -329,6 +352,54 @@ class AnalysisPredictor : public PaddlePredictor {
   /// \brief Same as RegisterOutputHook
   void RegisterInputHook(const InputTensorHookFunc &hookfunc) override;
 
+  ///
+  /// \brief Make the trace of the next run a child of the span of the caller.
+  ///
+  /// \param trace_id The trace id of the caller, as 32 hex digits.
+  /// \param parent_span_id The span id of the caller, as 16 hex digits.
+  ///
+  void SetTraceParent(const std::string &trace_id,
+                      const std::string &parent_span_id) override;
+
+  ///
+  /// \brief Get the trace of the last run, see AnalysisConfig::EnableRunTrace.
+  ///
+  /// \return The spans of the last run, the span of the run first.
+  ///
+  std::vector<TraceSpan> GetLastRunTrace() override;
+
+  ///
+  /// \brief Replace the parameters by the ones of params_file, of the same
+  /// names, dims and dtypes, without rebuilding the predictor. The new
+  /// parameters are loaded while the runs go on, and swapped in between two
+  /// runs, for this predictor and its clones. The parameters transformed by
+  /// the optimization, e.g. fused, folded or built into the TensorRT
+  /// engines, can not be updated, and the predictor should be rebuilt.
+  ///
+  /// \param params_file The combined params file, as the one of the config.
+  /// \return Whether the parameters are updated. If not, they are unchanged.
+  ///
+  bool UpdateParameters(const std::string &params_file) override;
+
+  ///
+  /// \brief Get the summary of the startup, see
+  /// AnalysisConfig::EnableStartupTrace. Called before the first run ends,
+  /// it ends the trace.
+  ///
+  /// \return The time of each category of the phases, and the longest
+  /// phases.
+  ///
+  std::string GetStartupSummary() override;
+
+  ///
+  /// \brief Write the trace of the startup in the chrome tracing format, see
+  /// AnalysisConfig::EnableStartupTrace. Called before the first run ends,
+  /// it ends the trace.
+  ///
+  /// \param path The file to write.
+  ///
+  void ExportStartupTrace(const std::string &path) override;
+
   ///
   /// \brief Initialize onednn quantizer and execute onednn quantization pass
   ///
@@ -507,6 +578,14 @@ class AnalysisPredictor : public PaddlePredictor {
  private:
   void StatisticShapeRangeInfo();
   void HookCollectShapeRangeInfo();
+#ifdef PADDLE_WITH_XPU
+  // Records the reads of the ops in the tuning run of the XPU L3 autotune,
+  // so that the L3 blocks of the allocations not live at the same time may
+  // share a range.
+  void HookRecordL3Uses(InferXPUContext *infer_xpu_ctx);
+#endif
+  void ReplayAllocationProfile();
+  void ShareParameters();
   void InitPlace();
   void InitDeviceContexts();
   void InitResourceManager(void *stream);
@@ -592,6 +671,14 @@ class AnalysisPredictor : public PaddlePredictor {
   details::TensorArrayBatchCleaner tensor_array_batch_cleaner_;
   // A mutex help to make Clone thread safe.
   std::mutex clone_mutex_;
+  // Held shared by the runs and exclusively by UpdateParameters, shared with
+  // the clones.
+  std::shared_ptr<std::shared_mutex> params_mutex_{
+      std::make_shared<std::shared_mutex>()};
+  // The scope and the sorted names of the parameters loaded from the params
+  // file, for UpdateParameters.
+  framework::Scope *param_scope_{nullptr};
+  std::vector<std::string> param_names_;
   static int clone_num_;
 
   int predictor_id_;
@@ -600,6 +687,7 @@ class AnalysisPredictor : public PaddlePredictor {
  private:
   std::once_flag register_input_hook_flag_;
   std::once_flag register_output_hook_flag_;
+  std::once_flag register_l3_hook_flag_;
   std::vector<OutputTensorHookFunc> output_hookfuncs_;
   std::vector<InputTensorHookFunc> input_hookfuncs_;
   // Some status here that help to determine the status inside the predictor.
@@ -610,9 +698,77 @@ class AnalysisPredictor : public PaddlePredictor {
 
   bool private_context_{false};
   void *predictor_stream_{nullptr};
+
+  // The threads running the CPU kernels, on the cores of
+  // cpu_thread_affinity, and shared with the predictors on the same cores.
+  std::shared_ptr<phi::IntraOpThreadPool> intra_op_thread_pool_;
+
+  using OutputBuffers = std::vector<
+      std::pair<std::string,
+                std::shared_ptr<details::OutputBufferAllocation>>>;
+  // The buffers the outputs are bound to by ShareExternalData, taken before
+  // a run, since the kernels may replace them.
+  OutputBuffers CollectOutputBuffers() const;
+  // Copy the outputs the kernels did not write in place into their buffers,
+  // and bind the outputs to them again.
+  void WriteOutputBuffers(const OutputBuffers &buffers);
+
+  // The thread waiting for the device to complete the run of
+  // ZeroCopyRunAsync and invoking its callback. At most one run is pending.
+  void AsyncRunLoop();
+  // Waits for the pending run, and throws if called from its callback.
+  void WaitAsyncRun();
+  std::thread async_run_thread_;
+  std::mutex async_run_mutex_;
+  std::condition_variable async_run_cv_;
+  std::function<void()> async_run_task_;
+  bool async_run_exit_{false};
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  gpuEvent_t async_run_event_{nullptr};
+#endif
   std::map<phi::Place, std::shared_future<std::unique_ptr<phi::DeviceContext>>>
       device_contexts_;
 
+  // The trace of the last run when AnalysisConfig::EnableRunTrace is set,
+  // the operators of which are traced by the hooks of the executor.
+  void RegisterRunTraceHooks();
+  void BeginRunTrace();
+  // End the span of the phase of the run, the feed, the execution or the
+  // fetch, and begin the one of phase; an empty phase ends the run.
+  void TraceRunPhase(const std::string &phase);
+  std::unique_ptr<RunTracer> run_tracer_;
+  RunTracer::SpanId run_trace_phase_{-1};
+
+  // The startup trace when AnalysisConfig::EnableStartupTrace is set, open
+  // from Init to the end of the first run, which FirstRunTrace records.
+  class FirstRunTrace {
+   public:
+    explicit FirstRunTrace(AnalysisPredictor *predictor);
+    ~FirstRunTrace();
+
+   private:
+    AnalysisPredictor *predictor_;
+    std::unique_ptr<common::StartupTraceScope> scope_;
+  };
+  void EndStartupTrace();
+  bool startup_tracing_{false};
+  size_t startup_trace_begin_{0};
+  std::vector<common::StartupTraceEvent> startup_trace_;
+
+  // The int8 calibration of the PIR program, see
+  // AnalysisConfig::CollectInt8Calibration. The operators are numbered
+  // before the passes, and either their activations are collected into
+  // histograms by a hook of the executor, or the calibrated scales are
+  // inserted as quantize and dequantize pairs.
+  void PrepareInt8Calibration();
+  void InsertInt8QuantDequantOps(
+      const std::map<int, pir::Operation *> &calibrated_ops);
+  void RegisterInt8CalibrationHook();
+  void SaveInt8CalibrationTable();
+  std::map<std::pair<int, int>, inference::ActivationHistogram>
+      int8_calibration_histograms_;
+  std::map<int, std::string> int8_calibration_op_names_;
+
 #if defined(PADDLE_WITH_DISTRIBUTE) && defined(PADDLE_WITH_PSCORE)
   // fleet executor related
   distributed::FleetExecutorDesc executor_desc_;
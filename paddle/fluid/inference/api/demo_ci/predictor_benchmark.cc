@@ -0,0 +1,692 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+/*
+ * predictor_benchmark loads a model with the Config given by its flags and
+ * runs it from several predictors cloned from the first one, each on its
+ * own thread, to measure the latency and the throughput of the config.
+ *
+ * In a closed loop (--qps=0) each predictor runs again as soon as it is
+ * done. With --qps the requests are sent at that rate, whatever the
+ * predictors keep up with, to the first predictor free, and the latency of a
+ * request counts from when it is sent, including its time in the queue.
+ *
+ * The shapes of the inputs are given by --shapes as
+ *   name:dims[,dims...][;name:dims...]
+ * where dims are split by 'x' and a dim is a number or a range a-b sampled
+ * for each request. The alternatives split by ',' are chosen at random for
+ * each request, the same one for all the inputs when they list as many, and
+ * the ranges written the same way take the same value in a request, e.g.
+ *   --shapes="input_ids:1x16-512;attention_mask:1x16-512"
+ * The inputs not given take the shape of the model, with 1 for the unknown
+ * dims. Under TensorRT, the ranges of the shapes are its dynamic shapes.
+ *
+ * Usage:
+ *   predictor_benchmark --model_dir=resnet50 --threads=4 --duration=10
+ *     [--qps=200] [--shapes=...] [--use_trt --precision=fp16]
+ *     [--stage_breakdown] [--output=report.json]
+ */
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef PADDLE_WITH_CUDA
+#include <cuda_runtime.h>
+#endif
+
+#include "paddle_inference_api.h"  // NOLINT
+
+DEFINE_string(model_dir,
+              "",
+              "The directory of inference.json or inference.pdmodel, and "
+              "inference.pdiparams.");
+DEFINE_string(model_file, "", "The model file, instead of --model_dir.");
+DEFINE_string(params_file, "", "The params file, instead of --model_dir.");
+DEFINE_string(device, "gpu", "cpu or gpu.");
+DEFINE_int32(gpu_id, 0, "The GPU to run on.");
+DEFINE_int32(cpu_threads, 1, "The math library threads of each predictor.");
+DEFINE_bool(use_mkldnn, false, "Use oneDNN on CPU.");
+DEFINE_string(precision,
+              "fp32",
+              "fp32, fp16, bf16 or int8. On GPU, the mixed precision of the "
+              "model or the precision of TensorRT, which takes int8 for a "
+              "quantized model.");
+DEFINE_bool(use_trt, false, "Run the subgraphs TensorRT supports with it.");
+DEFINE_int32(trt_min_subgraph_size, 3, "The min ops of a TensorRT subgraph.");
+DEFINE_int32(trt_workspace_mb, 1024, "The workspace of TensorRT in MB.");
+DEFINE_bool(use_cinn, false, "Compile the model with CINN.");
+DEFINE_bool(use_pir, true, "Run the model as a PIR program.");
+DEFINE_bool(ir_optim, true, "Optimize the model with the passes.");
+DEFINE_bool(memory_optim, true, "Reuse the memory of the tensors.");
+DEFINE_string(shapes, "", "The shapes of the inputs, see above.");
+DEFINE_int32(int_range, 100, "The integer inputs are in [0, int_range).");
+DEFINE_int32(input_pool, 16, "The requests made ahead, taken at random.");
+DEFINE_int32(threads, 1, "The predictors running at the same time.");
+DEFINE_double(qps,
+              0,
+              "The requests per second sent to the predictors, 0 for a "
+              "closed loop.");
+DEFINE_bool(poisson,
+            true,
+            "Send the requests of --qps at exponential intervals, as "
+            "independent clients would, rather than at even ones.");
+DEFINE_int32(warmup, 10, "The runs of each predictor before measuring.");
+DEFINE_double(duration, 10, "The seconds to measure.");
+DEFINE_bool(copy_outputs, true, "Copy the outputs to the host in a request.");
+DEFINE_bool(stage_breakdown,
+            false,
+            "Trace the runs, see Config::EnableRunTrace, to report the time "
+            "of their stages and operators on the device. It costs some "
+            "time on each run.");
+DEFINE_string(output, "", "The JSON file of the report.");
+
+namespace paddle {
+namespace demo {
+
+using paddle_infer::Config;
+using paddle_infer::DataType;
+using paddle_infer::Predictor;
+using Clock = std::chrono::steady_clock;
+
+struct InputData {
+  std::string name;
+  DataType dtype;
+  std::vector<int> shape;
+  std::vector<char> data;
+};
+
+using Request = std::vector<InputData>;
+
+// The dims of an input shape, a range [low, high] for each.
+using ShapeSpec = std::vector<std::pair<int, int>>;
+
+struct InputSpec {
+  std::vector<ShapeSpec> alternatives;
+  // The text of each dim, the ranges written the same way share a value.
+  std::vector<std::vector<std::string>> keys;
+};
+
+// The times of a request in ms.
+struct Sample {
+  double latency = 0;
+  double queue = 0;
+  double feed = 0;
+  double run = 0;
+  double fetch = 0;
+};
+
+struct ThreadStats {
+  std::vector<Sample> samples;
+  // The total ms of the traced stages and kinds of operators.
+  std::map<std::string, double> trace_ms;
+  int traced_runs = 0;
+};
+
+double Ms(Clock::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+std::vector<std::string> Split(const std::string &str, char sep) {
+  std::vector<std::string> items;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, sep)) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+std::map<std::string, InputSpec> ParseShapes(const std::string &shapes) {
+  std::map<std::string, InputSpec> specs;
+  for (const auto &input : Split(shapes, ';')) {
+    size_t colon = input.rfind(':');
+    CHECK(colon != std::string::npos) << "The shape `" << input
+                                      << "` should be written as name:dims.";
+    InputSpec spec;
+    for (const auto &dims : Split(input.substr(colon + 1), ',')) {
+      ShapeSpec shape;
+      std::vector<std::string> keys;
+      for (const auto &dim : Split(dims, 'x')) {
+        size_t dash = dim.find('-');
+        if (dash == std::string::npos) {
+          shape.emplace_back(std::stoi(dim), std::stoi(dim));
+        } else {
+          shape.emplace_back(std::stoi(dim.substr(0, dash)),
+                             std::stoi(dim.substr(dash + 1)));
+          CHECK_LE(shape.back().first, shape.back().second)
+              << "The range `" << dim << "` is empty.";
+        }
+        keys.push_back(dim);
+      }
+      spec.alternatives.push_back(shape);
+      spec.keys.push_back(keys);
+    }
+    specs[input.substr(0, colon)] = spec;
+  }
+  return specs;
+}
+
+Config MakeConfig(const std::map<std::string, InputSpec> &specs) {
+  Config config;
+  if (!FLAGS_model_dir.empty()) {
+    std::string prefix = FLAGS_model_dir + "/inference";
+    bool is_pir = std::ifstream(prefix + ".json").good();
+    config.SetModel(prefix + (is_pir ? ".json" : ".pdmodel"),
+                    prefix + ".pdiparams");
+  } else {
+    CHECK(!FLAGS_model_file.empty())
+        << "Please give the model by --model_dir or --model_file.";
+    config.SetModel(FLAGS_model_file, FLAGS_params_file);
+  }
+  std::map<std::string, Config::Precision> precisions = {
+      {"fp32", Config::Precision::kFloat32},
+      {"fp16", Config::Precision::kHalf},
+      {"bf16", Config::Precision::kBf16},
+      {"int8", Config::Precision::kInt8}};
+  CHECK(precisions.count(FLAGS_precision))
+      << "Unknown precision `" << FLAGS_precision << "`.";
+  auto precision = precisions.at(FLAGS_precision);
+
+  if (FLAGS_device == "gpu") {
+    config.EnableUseGpu(
+        256,
+        FLAGS_gpu_id,
+        FLAGS_use_trt || precision == Config::Precision::kInt8
+            ? Config::Precision::kFloat32
+            : precision);
+    if (FLAGS_use_trt) {
+      config.EnableTensorRtEngine(
+          static_cast<int64_t>(FLAGS_trt_workspace_mb) << 20,
+          1,
+          FLAGS_trt_min_subgraph_size,
+          precision,
+          /*use_static=*/false,
+          /*use_calib_mode=*/false);
+      std::map<std::string, std::vector<int>> min_shapes, max_shapes,
+          opt_shapes;
+      for (const auto &item : specs) {
+        std::vector<int> &min_shape = min_shapes[item.first];
+        std::vector<int> &max_shape = max_shapes[item.first];
+        for (const auto &shape : item.second.alternatives) {
+          min_shape.resize(shape.size(), std::numeric_limits<int>::max());
+          max_shape.resize(shape.size(), 0);
+          for (size_t i = 0; i < shape.size(); ++i) {
+            min_shape[i] = std::min(min_shape[i], shape[i].first);
+            max_shape[i] = std::max(max_shape[i], shape[i].second);
+          }
+        }
+        opt_shapes[item.first] = max_shape;
+      }
+      if (!specs.empty()) {
+        config.SetTRTDynamicShapeInfo(min_shapes, max_shapes, opt_shapes);
+      }
+    }
+  } else {
+    CHECK_EQ(FLAGS_device, "cpu") << "Unknown device `" << FLAGS_device << "`.";
+    config.DisableGpu();
+    config.SetCpuMathLibraryNumThreads(FLAGS_cpu_threads);
+    if (FLAGS_use_mkldnn) config.EnableMKLDNN();
+  }
+  if (FLAGS_use_cinn) config.EnableCINN();
+  config.EnableNewIR(FLAGS_use_pir);
+  config.SwitchIrOptim(FLAGS_ir_optim);
+  config.EnableMemoryOptim(FLAGS_memory_optim);
+  if (FLAGS_stage_breakdown) config.EnableRunTrace();
+  return config;
+}
+
+template <typename Visitor>
+void VisitDataType(DataType dtype, Visitor visitor) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      visitor(float());
+      break;
+    case DataType::FLOAT64:
+      visitor(double());
+      break;
+    case DataType::INT64:
+      visitor(int64_t());
+      break;
+    case DataType::INT32:
+      visitor(int32_t());
+      break;
+    case DataType::UINT8:
+      visitor(uint8_t());
+      break;
+    case DataType::INT8:
+      visitor(int8_t());
+      break;
+    case DataType::BOOL:
+      visitor(bool());
+      break;
+    default:
+      LOG(FATAL) << "The data type " << static_cast<int>(dtype)
+                 << " is not supported, the float16 and bfloat16 inputs and "
+                    "outputs can be float32 without low precision IO.";
+  }
+}
+
+// Makes the requests of the pool, with the shapes of the specs.
+std::vector<Request> MakeRequests(
+    Predictor *predictor, const std::map<std::string, InputSpec> &specs) {
+  auto names = predictor->GetInputNames();
+  auto model_shapes = predictor->GetInputTensorShape();
+  auto types = predictor->GetInputTypes();
+  for (const auto &item : specs) {
+    CHECK(model_shapes.count(item.first))
+        << "The model has no input `" << item.first << "`.";
+  }
+  size_t num_alternatives = 0;
+  bool shared_alternative = true;
+  for (const auto &item : specs) {
+    size_t n = item.second.alternatives.size();
+    shared_alternative &= num_alternatives == 0 || num_alternatives == n;
+    num_alternatives = n;
+  }
+
+  std::mt19937 gen(2026);
+  std::vector<Request> requests(std::max(FLAGS_input_pool, 1));
+  for (auto &request : requests) {
+    size_t alternative = num_alternatives > 0 ? gen() % num_alternatives : 0;
+    std::map<std::string, int> ranges;
+    for (const auto &name : names) {
+      InputData input{name, types.at(name), {}, {}};
+      auto iter = specs.find(name);
+      if (iter == specs.end()) {
+        for (int64_t dim : model_shapes.at(name)) {
+          input.shape.push_back(dim < 0 ? 1 : static_cast<int>(dim));
+        }
+      } else {
+        const auto &spec = iter->second;
+        size_t k = shared_alternative ? alternative
+                                      : gen() % spec.alternatives.size();
+        const auto &shape = spec.alternatives[k];
+        for (size_t i = 0; i < shape.size(); ++i) {
+          const auto &key = spec.keys[k][i];
+          if (!ranges.count(key)) {
+            std::uniform_int_distribution<int> dist(shape[i].first,
+                                                    shape[i].second);
+            ranges[key] = dist(gen);
+          }
+          input.shape.push_back(ranges[key]);
+        }
+      }
+      int64_t numel = std::accumulate(input.shape.begin(),
+                                      input.shape.end(),
+                                      int64_t{1},
+                                      std::multiplies<int64_t>());
+      VisitDataType(input.dtype, [&](auto zero) {
+        using T = decltype(zero);
+        input.data.resize(numel * sizeof(T));
+        auto *data = reinterpret_cast<T *>(input.data.data());
+        std::uniform_real_distribution<double> dist(0, 1);
+        for (int64_t i = 0; i < numel; ++i) {
+          double value = dist(gen);
+          if (std::is_same<T, bool>::value) {
+            data[i] = static_cast<T>(value < 0.5);
+          } else if (std::is_floating_point<T>::value) {
+            data[i] = static_cast<T>(value);
+          } else {
+            data[i] = static_cast<T>(value * FLAGS_int_range);
+          }
+        }
+      });
+      request.push_back(std::move(input));
+    }
+  }
+  return requests;
+}
+
+class Worker {
+ public:
+  Worker(Predictor *predictor, const std::vector<Request> *requests, int id)
+      : predictor_(predictor), requests_(requests), gen_(id) {}
+
+  // Runs a request, returning its sample but for the latency and the queue.
+  Sample Run() {
+    const auto &request = (*requests_)[gen_() % requests_->size()];
+    Sample sample;
+    auto start = Clock::now();
+    for (const auto &input : request) {
+      auto handle = predictor_->GetInputHandle(input.name);
+      handle->Reshape(input.shape);
+      VisitDataType(input.dtype, [&](auto zero) {
+        using T = decltype(zero);
+        handle->CopyFromCpu(reinterpret_cast<const T *>(input.data.data()));
+      });
+    }
+    auto fed = Clock::now();
+    CHECK(predictor_->Run()) << "The predictor failed to run.";
+    auto ran = Clock::now();
+    if (FLAGS_copy_outputs) {
+      for (const auto &name : predictor_->GetOutputNames()) {
+        auto handle = predictor_->GetOutputHandle(name);
+        auto shape = handle->shape();
+        int64_t numel = std::accumulate(
+            shape.begin(), shape.end(), int64_t{1}, std::multiplies<int64_t>());
+        VisitDataType(handle->type(), [&](auto zero) {
+          using T = decltype(zero);
+          output_.resize(std::max<size_t>(output_.size(), numel * sizeof(T)));
+          handle->CopyToCpu(reinterpret_cast<T *>(output_.data()));
+        });
+      }
+    }
+    auto fetched = Clock::now();
+    sample.feed = Ms(fed - start);
+    sample.run = Ms(ran - fed);
+    sample.fetch = Ms(fetched - ran);
+    if (FLAGS_stage_breakdown) Trace();
+    return sample;
+  }
+
+  ThreadStats stats;
+
+ private:
+  void Trace() {
+    auto spans = predictor_->GetLastRunTrace();
+    if (spans.empty()) return;
+    const std::string &run_id = spans[0].span_id;
+    for (size_t i = 1; i < spans.size(); ++i) {
+      const auto &span = spans[i];
+      double ms = (span.end_time_unix_nano - span.start_time_unix_nano) / 1e6;
+      if (span.parent_span_id == run_id) {
+        stats.trace_ms[span.name] += ms;
+      } else {
+        auto kind = span.attributes.find("paddle.op.kind");
+        stats.trace_ms["op." + (kind == span.attributes.end()
+                                    ? std::string("unknown")
+                                    : kind->second)] += ms;
+      }
+    }
+    ++stats.traced_runs;
+  }
+
+  Predictor *predictor_;
+  const std::vector<Request> *requests_;
+  std::mt19937 gen_;
+  std::vector<char> output_;
+};
+
+// The requests sent at --qps and not yet taken by a worker.
+class RequestQueue {
+ public:
+  void Push(Clock::time_point sent) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(sent);
+    cv_.notify_one();
+  }
+
+  // Returns false once closed.
+  bool Pop(Clock::time_point *sent) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+    if (closed_) return false;
+    *sent = queue_.front();
+    queue_.pop_front();
+    return true;
+  }
+
+  // Returns the requests left.
+  size_t Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+    return queue_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Clock::time_point> queue_;
+  bool closed_ = false;
+};
+
+// Samples the memory used on the GPU, to report its peak.
+class GpuMemoryMonitor {
+ public:
+  GpuMemoryMonitor() {
+#ifdef PADDLE_WITH_CUDA
+    if (FLAGS_device != "gpu") return;
+    thread_ = std::thread([this] {
+      cudaSetDevice(FLAGS_gpu_id);
+      while (!stop_) {
+        size_t used = UsedBytes();
+        size_t peak = peak_;
+        while (used > peak && !peak_.compare_exchange_weak(peak, used)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    });
+#endif
+  }
+
+  ~GpuMemoryMonitor() {
+    stop_ = true;
+    if (thread_.joinable()) thread_.join();
+  }
+
+  static size_t UsedBytes() {
+#ifdef PADDLE_WITH_CUDA
+    size_t free_bytes = 0;
+    size_t total_bytes = 0;
+    if (cudaMemGetInfo(&free_bytes, &total_bytes) == cudaSuccess) {
+      return total_bytes - free_bytes;
+    }
+#endif
+    return 0;
+  }
+
+  size_t PeakBytes() const { return peak_; }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::atomic<size_t> peak_{0};
+  std::thread thread_;
+};
+
+std::string JsonString(const std::string &str) {
+  std::string out = "\"";
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out.push_back(c);
+    }
+  }
+  return out + "\"";
+}
+
+double Percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t index = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void Main() {
+  auto specs = ParseShapes(FLAGS_shapes);
+  size_t memory_before = GpuMemoryMonitor::UsedBytes();
+  auto start_load = Clock::now();
+  auto predictor = paddle_infer::CreatePredictor(MakeConfig(specs));
+  double load_ms = Ms(Clock::now() - start_load);
+  auto requests = MakeRequests(predictor.get(), specs);
+
+  int num_threads = std::max(FLAGS_threads, 1);
+  std::vector<std::unique_ptr<Predictor>> clones;
+  std::vector<Predictor *> predictors = {predictor.get()};
+  for (int i = 1; i < num_threads; ++i) {
+    clones.push_back(predictor->Clone());
+    predictors.push_back(clones.back().get());
+  }
+  std::vector<std::unique_ptr<Worker>> workers;
+  for (int i = 0; i < num_threads; ++i) {
+    workers.push_back(std::make_unique<Worker>(predictors[i], &requests, i));
+  }
+
+  std::vector<std::thread> threads;
+  for (auto &worker : workers) {
+    threads.emplace_back([&worker] {
+      for (int i = 0; i < FLAGS_warmup; ++i) worker->Run();
+      worker->stats = ThreadStats();
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  threads.clear();
+  size_t memory_after_warmup = GpuMemoryMonitor::UsedBytes();
+
+  GpuMemoryMonitor monitor;
+  RequestQueue queue;
+  auto start = Clock::now();
+  auto deadline =
+      start + std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(FLAGS_duration));
+  for (auto &worker : workers) {
+    threads.emplace_back([&worker, &queue, deadline] {
+      while (true) {
+        Clock::time_point sent;
+        if (FLAGS_qps > 0) {
+          if (!queue.Pop(&sent)) break;
+        } else {
+          sent = Clock::now();
+          if (sent >= deadline) break;
+        }
+        auto begin = Clock::now();
+        Sample sample = worker->Run();
+        sample.queue = Ms(begin - sent);
+        sample.latency = Ms(Clock::now() - sent);
+        worker->stats.samples.push_back(sample);
+      }
+    });
+  }
+  size_t unfinished = 0;
+  if (FLAGS_qps > 0) {
+    std::mt19937 gen(2026);
+    std::exponential_distribution<double> exponential(FLAGS_qps);
+    auto next = start;
+    while (next < deadline) {
+      std::this_thread::sleep_until(next);
+      queue.Push(next);
+      double interval = FLAGS_poisson ? exponential(gen) : 1.0 / FLAGS_qps;
+      next += std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(interval));
+    }
+    std::this_thread::sleep_until(deadline);
+    // The requests not taken by the deadline are not waited for, the
+    // predictors could not keep up with them.
+    unfinished = queue.Close();
+  }
+  for (auto &thread : threads) thread.join();
+  double elapsed_s = Ms(Clock::now() - start) / 1e3;
+
+  std::vector<double> latencies;
+  Sample mean;
+  std::map<std::string, double> trace_ms;
+  int traced_runs = 0;
+  for (const auto &worker : workers) {
+    for (const auto &sample : worker->stats.samples) {
+      latencies.push_back(sample.latency);
+      mean.queue += sample.queue;
+      mean.feed += sample.feed;
+      mean.run += sample.run;
+      mean.fetch += sample.fetch;
+    }
+    for (const auto &item : worker->stats.trace_ms) {
+      trace_ms[item.first] += item.second;
+    }
+    traced_runs += worker->stats.traced_runs;
+  }
+  CHECK(!latencies.empty()) << "No request completed, please run longer.";
+  std::sort(latencies.begin(), latencies.end());
+  double count = static_cast<double>(latencies.size());
+  mean.latency =
+      std::accumulate(latencies.begin(), latencies.end(), 0.0) / count;
+
+  std::ostringstream json;
+  json << std::fixed << std::setprecision(3) << std::boolalpha;
+  json << "{\n  \"version\": " << JsonString(paddle_infer::GetVersion())
+       << ",\n  \"config\": {\"device\": " << JsonString(FLAGS_device)
+       << ", \"precision\": " << JsonString(FLAGS_precision)
+       << ", \"use_trt\": " << FLAGS_use_trt
+       << ", \"use_cinn\": " << FLAGS_use_cinn
+       << ", \"use_pir\": " << FLAGS_use_pir
+       << ", \"memory_optim\": " << FLAGS_memory_optim
+       << ", \"threads\": " << num_threads << ", \"qps\": " << FLAGS_qps
+       << ", \"shapes\": " << JsonString(FLAGS_shapes) << "},\n";
+  json << "  \"load_ms\": " << load_ms << ",\n";
+  json << "  \"requests\": " << latencies.size()
+       << ",\n  \"unfinished\": " << unfinished
+       << ",\n  \"throughput_qps\": " << count / elapsed_s << ",\n";
+  json << "  \"latency_ms\": {\"mean\": " << mean.latency
+       << ", \"p50\": " << Percentile(latencies, 50)
+       << ", \"p90\": " << Percentile(latencies, 90)
+       << ", \"p95\": " << Percentile(latencies, 95)
+       << ", \"p99\": " << Percentile(latencies, 99)
+       << ", \"p99.9\": " << Percentile(latencies, 99.9)
+       << ", \"max\": " << latencies.back() << "},\n";
+  json << "  \"stage_ms\": {\"queue\": " << mean.queue / count
+       << ", \"feed\": " << mean.feed / count
+       << ", \"run\": " << mean.run / count
+       << ", \"fetch\": " << mean.fetch / count << "},\n";
+  json << "  \"trace_ms\": {";
+  for (auto iter = trace_ms.begin(); iter != trace_ms.end(); ++iter) {
+    json << (iter == trace_ms.begin() ? "" : ", ") << JsonString(iter->first)
+         << ": " << iter->second / std::max(traced_runs, 1);
+  }
+  json << "},\n";
+  json << "  \"gpu_memory_mb\": {\"model\": "
+       << (memory_after_warmup - std::min(memory_before, memory_after_warmup)) /
+              1048576.0
+       << ", \"used\": " << memory_after_warmup / 1048576.0
+       << ", \"peak\": "
+       << std::max(monitor.PeakBytes(), memory_after_warmup) / 1048576.0
+       << "}\n}\n";
+
+  std::cout << json.str();
+  if (!FLAGS_output.empty()) {
+    std::ofstream fout(FLAGS_output);
+    fout << json.str();
+  }
+}
+
+}  // namespace demo
+}  // namespace paddle
+
+int main(int argc, char **argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  paddle::demo::Main();
+  return 0;
+}
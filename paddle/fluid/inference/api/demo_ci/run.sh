@@ -252,6 +252,29 @@ for WITH_STATIC_LIB in ON OFF; do
         EXIT_CODE=1
       fi
     fi
+
+    # --------predictor benchmark on linux/mac------
+    if [ $TEST_GPU_CPU == ON -a $WITH_STATIC_LIB == OFF ]; then
+      rm -rf *
+      cmake .. -DPADDLE_LIB=${inference_install_dir} \
+        -DWITH_MKL=$TURN_ON_MKL \
+        -DDEMO_NAME=predictor_benchmark \
+        -DWITH_GPU=$TEST_GPU_CPU \
+        -DWITH_STATIC_LIB=OFF \
+        -DUSE_TENSORRT=$USE_TENSORRT \
+        -DTENSORRT_ROOT=$TENSORRT_ROOT_DIR \
+        -DWITH_ONNXRUNTIME=$WITH_ONNXRUNTIME
+      make -j$(nproc)
+      for qps in 0 50; do
+        ./predictor_benchmark \
+          --model_dir=$DATA_DIR/custom_pass/resnet50 \
+          --threads=2 --warmup=2 --duration=2 --qps=$qps
+        if [ $? -ne 0 ]; then
+          echo "predictor_benchmark qps:${qps} runs failed " >> ${current_dir}/test_summary.txt
+          EXIT_CODE=1
+        fi
+      done
+    fi
   fi
 done
 
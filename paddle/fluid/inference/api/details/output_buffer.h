@@ -0,0 +1,43 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "paddle/phi/common/data_type.h"
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/allocator.h"
+
+namespace paddle {
+namespace details {
+
+// The buffer of the caller an output tensor shares by ShareExternalData.
+// The kernel writing the output reuses it when the output fits and is on
+// its place; otherwise the predictor copies the output into it after the
+// run. It stays bound to the output until another buffer is shared.
+class OutputBufferAllocation : public phi::Allocation {
+ public:
+  OutputBufferAllocation(void* ptr,
+                         size_t size,
+                         const phi::Place& place,
+                         phi::DataType dtype)
+      : phi::Allocation(ptr, size, place), dtype_(dtype) {}
+
+  phi::DataType dtype() const { return dtype_; }
+
+ private:
+  phi::DataType dtype_;
+};
+
+}  // namespace details
+}  // namespace paddle
@@ -16,6 +16,7 @@
 #include "paddle/fluid/framework/data_layout_transform.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/scope.h"
+#include "paddle/fluid/inference/api/details/output_buffer.h"
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/api/paddle_tensor.h"
 #include "paddle/fluid/platform/enforce.h"
@@ -335,35 +336,30 @@ void Tensor::ShareExternalData(const T *data,
       sizeof(T);
   phi::DenseTensorMeta meta(
       DataTypeInfo<T>().TYPE, common::make_ddim(shape), LayoutConvert(layout));
+  phi::Place data_place;
   if (place == PlaceType::kCPU) {
-    phi::DenseTensor dtensor(std::make_shared<phi::Allocation>(
-                                 const_cast<T *>(data), size, phi::CPUPlace()),
-                             meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::CPUPlace();
   } else if (place == PlaceType::kGPU) {
-    phi::DenseTensor dtensor(
-        std::make_shared<phi::Allocation>(
-            const_cast<T *>(data), size, phi::GPUPlace(device_)),
-        meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::GPUPlace(device_);
   } else if (place == PlaceType::kXPU) {
-    phi::DenseTensor dtensor(
-        std::make_shared<phi::Allocation>(
-            const_cast<T *>(data), size, phi::XPUPlace(device_)),
-        meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::XPUPlace(device_);
   } else if (place == PlaceType::kCUSTOM) {
-    phi::DenseTensor dtensor(std::make_shared<phi::Allocation>(
-                                 const_cast<T *>(data),
-                                 size,
-                                 phi::CustomPlace(device_type_, device_)),
-                             meta);
-    *tensor = std::move(dtensor);
+    data_place = phi::CustomPlace(device_type_, device_);
   } else {
     PADDLE_THROW(common::errors::InvalidArgument(
         "PlaceType must be one of [PlaceType::kCPU, PlaceType::kGPU, "
         "PlaceType::kXPU]."));
   }
+  std::shared_ptr<phi::Allocation> allocation;
+  if (input_or_output_) {
+    allocation = std::make_shared<phi::Allocation>(
+        const_cast<T *>(data), size, data_place);
+  } else {
+    // The predictor writes the output into the buffer at each run.
+    allocation = std::make_shared<paddle::details::OutputBufferAllocation>(
+        const_cast<T *>(data), size, data_place, meta.dtype);
+  }
+  *tensor = phi::DenseTensor(allocation, meta);
 }
 
 void Tensor::CopyStringsFromCpu(const paddle_infer::Strings *data) {
@@ -806,10 +802,24 @@ void Tensor::ORTCopyToCpu(T *data) const {
 
   if (place_ == PlaceType::kCPU) {
     std::memcpy(static_cast<void *>(data), value.GetTensorData<void *>(), size);
+  } else if (place_ == PlaceType::kGPU) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    // The run of the CUDA execution provider has finished its stream.
+    paddle::memory::Copy(phi::CPUPlace(),
+                         static_cast<void *>(data),
+                         phi::GPUPlace(device_),
+                         value.GetTensorData<void>(),
+                         size,
+                         nullptr);
+#else
+    PADDLE_THROW(common::errors::Unavailable(
+        "Can not copy tensor from CUDA place because paddle is not compiled "
+        "with CUDA."));
+#endif
   } else {
     PADDLE_THROW(common::errors::Unavailable(
-        "CopyToCpu error.The current ONNXRuntime backend doesn't support "
-        "GPU."));
+        "CopyToCpu error.The current ONNXRuntime backend only supports CPU "
+        "and GPU."));
   }
 }
 
@@ -58,6 +58,7 @@ void* InferXPUContext::Alloc(phi::TensorBase* tensor,
       l3_block = holder_l3_blocks_[holder];
     }
     l3_block->Record(size);
+    l3_block->Touch(l3_step_++);
     return data_ptr;
   } else if (l3_autotune_size_ > 0 && !holder_map_.empty()) {
     phi::Allocation* holder =
@@ -237,17 +238,24 @@ void InferXPUContext::SetFcAutotuneInfo(std::string fc_autotune_file,
 void InferXPUContext::L3CacheAutotune() {
   if (l3_autotune_size_ == 0) return;
   if (holder_map_.empty()) {
+    // The outputs are read after the run.
+    for (auto* holder : output_holder_set_) {
+      auto iter = holder_l3_blocks_.find(holder);
+      if (iter != holder_l3_blocks_.end()) {
+        iter->second->Touch(l3_step_);
+      }
+    }
     bool ret = l3_plan_.RunAutotune(l3_blocks_, l3_size_);
     if (!ret) {
       return;
     }
     auto* plan = l3_plan_.plan();
-    int8_t* cur_l3_ptr = reinterpret_cast<int8_t*>(l3_ptr_);
+    auto* offsets = l3_plan_.offsets();
+    int8_t* l3_base = reinterpret_cast<int8_t*>(l3_ptr_);
     for (size_t i = 0; i < l3_blocks_.size(); i++) {
       size_t block_size = plan->at(i);
       if (block_size > 0) {
-        l3_blocks_[i]->Set(cur_l3_ptr, block_size);
-        cur_l3_ptr += block_size;
+        l3_blocks_[i]->Set(l3_base + offsets->at(i), block_size);
       }
     }
     x_context()->_l3_mgr.set(
@@ -282,6 +290,14 @@ void InferXPUContext::L3CacheAutotune() {
   }
 }
 
+void InferXPUContext::RecordL3Use(phi::Allocation* holder) {
+  if (l3_autotune_size_ == 0 || !holder_map_.empty()) return;
+  auto iter = holder_l3_blocks_.find(holder);
+  if (iter != holder_l3_blocks_.end()) {
+    iter->second->Touch(l3_step_);
+  }
+}
+
 void InferXPUContext::SetOutHolder(phi::Allocation* holder) {
   output_holder_set_.insert(holder);
 }
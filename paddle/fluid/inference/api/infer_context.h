@@ -70,6 +70,10 @@ class InferXPUContext : public phi::XPUContext {
 
   void L3CacheAutotune();
 
+  // Records a read of the allocation by an op of the tuning run, which
+  // extends the lifetime of its L3 block.
+  void RecordL3Use(phi::Allocation* holder);
+
   void SetConvAutotuneInfo(std::string conv_autotune_file,
                            int conv_autotune_level,
                            bool conv_autotune_file_writeback,
@@ -88,6 +92,8 @@ class InferXPUContext : public phi::XPUContext {
   void* l3_ptr_{nullptr};
   bool l3_owned_{false};
   size_t l3_autotune_size_{0};
+  // The step of the tuning run, advanced at each allocation.
+  mutable int64_t l3_step_{0};
   mutable std::vector<phi::XPUL3CacheBlock*> l3_blocks_;
   mutable std::unordered_map<phi::Allocation*, phi::XPUL3CacheBlock*>
       holder_l3_blocks_;
@@ -0,0 +1,180 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/api/int8_calibration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+
+#include "paddle/common/enforce.h"
+
+namespace paddle {
+namespace inference {
+
+ActivationHistogram::ActivationHistogram(int num_bins) : hist_(num_bins, 0) {
+  PADDLE_ENFORCE_GT(num_bins,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The number of bins should be positive, but "
+                        "received %d.",
+                        num_bins));
+}
+
+void ActivationHistogram::Collect(const float* data, int64_t size) {
+  float batch_max = 0.f;
+  for (int64_t i = 0; i < size; ++i) {
+    batch_max = std::max(batch_max, std::abs(data[i]));
+  }
+  abs_max_ = std::max(abs_max_, batch_max);
+  const int num_bins = static_cast<int>(hist_.size());
+  if (range_ == 0.f) {
+    // Only zeros so far, which stay in the first bin.
+    range_ = batch_max;
+  }
+  while (range_ < batch_max) {
+    std::vector<double> merged(num_bins, 0);
+    for (int i = 0; i < num_bins; ++i) {
+      merged[i / 2] += hist_[i];
+    }
+    hist_.swap(merged);
+    range_ *= 2;
+  }
+  if (range_ == 0.f) {
+    hist_[0] += static_cast<double>(size);
+    return;
+  }
+  const float scale = num_bins / range_;
+  for (int64_t i = 0; i < size; ++i) {
+    int bin = static_cast<int>(std::abs(data[i]) * scale);
+    hist_[std::min(bin, num_bins - 1)] += 1;
+  }
+}
+
+float ActivationHistogram::KLThreshold(int num_quantized_bins) const {
+  const int num_bins = static_cast<int>(hist_.size());
+  if (range_ == 0.f || num_bins <= num_quantized_bins) return abs_max_;
+  // The histogram is clipped at each candidate bin, the values above it
+  // folded into the last bin kept, and compared with its quantization.
+  int best_bin = num_bins;
+  double best_kl = std::numeric_limits<double>::max();
+  double outliers = std::accumulate(hist_.begin(), hist_.end(), 0.0);
+  std::vector<double> reference;
+  std::vector<double> quantized;
+  for (int i = 0; i < num_quantized_bins; ++i) outliers -= hist_[i];
+  for (int i = num_quantized_bins; i <= num_bins; ++i) {
+    reference.assign(hist_.begin(), hist_.begin() + i);
+    reference[i - 1] += outliers;
+    if (i < num_bins) outliers -= hist_[i];
+
+    quantized.assign(i, 0);
+    const double bins_per_level = static_cast<double>(i) / num_quantized_bins;
+    for (int j = 0; j < num_quantized_bins; ++j) {
+      const int start = static_cast<int>(j * bins_per_level);
+      const int end = j == num_quantized_bins - 1
+                          ? i
+                          : static_cast<int>((j + 1) * bins_per_level);
+      double sum = 0;
+      int nonzero = 0;
+      for (int k = start; k < end; ++k) {
+        sum += hist_[k];
+        nonzero += hist_[k] != 0;
+      }
+      if (nonzero == 0) continue;
+      for (int k = start; k < end; ++k) {
+        if (hist_[k] != 0) quantized[k] = sum / nonzero;
+      }
+    }
+
+    const double reference_sum =
+        std::accumulate(reference.begin(), reference.end(), 0.0);
+    const double quantized_sum =
+        std::accumulate(quantized.begin(), quantized.end(), 0.0);
+    if (reference_sum == 0 || quantized_sum == 0) continue;
+    double kl = 0;
+    for (int k = 0; k < i; ++k) {
+      if (reference[k] == 0) continue;
+      const double p = reference[k] / reference_sum;
+      // The folded outliers may land in a bin the quantization left empty.
+      const double q = std::max(quantized[k] / quantized_sum, 1e-12);
+      kl += p * std::log(p / q);
+    }
+    if (kl < best_kl) {
+      best_kl = kl;
+      best_bin = i;
+    }
+  }
+  return std::min(best_bin * BinWidth(), abs_max_);
+}
+
+float ActivationHistogram::PercentileThreshold(float percentile) const {
+  PADDLE_ENFORCE_EQ(
+      percentile > 0.f && percentile <= 100.f,
+      true,
+      common::errors::InvalidArgument(
+          "The percentile should be in (0, 100], but received %f.",
+          percentile));
+  if (range_ == 0.f) return abs_max_;
+  const double total = std::accumulate(hist_.begin(), hist_.end(), 0.0);
+  const double target = total * percentile / 100.0;
+  double count = 0;
+  for (size_t i = 0; i < hist_.size(); ++i) {
+    count += hist_[i];
+    if (count >= target) {
+      return std::min((i + 1) * BinWidth(), abs_max_);
+    }
+  }
+  return abs_max_;
+}
+
+void SerializeInt8CalibrationTable(
+    const std::string& path, const std::vector<Int8CalibrationEntry>& table) {
+  std::ofstream os(path);
+  PADDLE_ENFORCE_EQ(
+      os.is_open(),
+      true,
+      common::errors::Unavailable(
+          "Cannot open %s to save the int8 calibration table.", path));
+  os << std::setprecision(std::numeric_limits<float>::max_digits10);
+  for (const auto& entry : table) {
+    os << entry.op_id << " " << entry.op_name << " " << entry.operand << " "
+       << entry.threshold << "\n";
+  }
+}
+
+std::vector<Int8CalibrationEntry> DeserializeInt8CalibrationTable(
+    const std::string& path) {
+  std::ifstream is(path);
+  PADDLE_ENFORCE_EQ(is.is_open(),
+                    true,
+                    common::errors::NotFound(
+                        "The int8 calibration table %s is not found.", path));
+  std::vector<Int8CalibrationEntry> table;
+  Int8CalibrationEntry entry;
+  while (is >> entry.op_id >> entry.op_name >> entry.operand >>
+         entry.threshold) {
+    table.push_back(entry);
+  }
+  PADDLE_ENFORCE_EQ(is.eof(),
+                    true,
+                    common::errors::InvalidArgument(
+                        "The int8 calibration table %s is malformed.", path));
+  return table;
+}
+
+}  // namespace inference
+}  // namespace paddle
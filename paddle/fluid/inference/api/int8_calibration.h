@@ -0,0 +1,75 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+namespace inference {
+
+// The attributes marking the operators of a PIR program whose inputs are
+// calibrated, see AnalysisConfig::CollectInt8Calibration. The operators are
+// numbered in the order of the program as it is loaded, before the passes,
+// so that the calibration table matches the same model on another run.
+constexpr char kInt8CalibrationId[] = "int8_calibration_id";
+constexpr char kInt8CalibrationOperands[] = "int8_calibration_operands";
+
+// The histogram of the absolute values an activation takes over the
+// calibration batches. Its range grows by doubling as larger values come,
+// merging the bins in pairs, so that a single pass over the batches is
+// enough.
+class TEST_API ActivationHistogram {
+ public:
+  explicit ActivationHistogram(int num_bins = 2048);
+
+  void Collect(const float* data, int64_t size);
+
+  // The thresholds the activation is clipped to, the largest value it is
+  // quantized to.
+  float AbsMaxThreshold() const { return abs_max_; }
+  // The threshold minimizing the KL divergence between the distribution and
+  // its quantization to num_quantized_bins levels, as TensorRT does.
+  float KLThreshold(int num_quantized_bins = 128) const;
+  // The threshold below which percentile percent of the values are.
+  float PercentileThreshold(float percentile) const;
+
+ private:
+  float BinWidth() const { return range_ / hist_.size(); }
+
+  std::vector<double> hist_;
+  float range_{0.f};
+  float abs_max_{0.f};
+};
+
+// An entry of the calibration table: the threshold of an operand of a
+// numbered operator.
+struct Int8CalibrationEntry {
+  int op_id;
+  std::string op_name;
+  int operand;
+  float threshold;
+};
+
+TEST_API void SerializeInt8CalibrationTable(
+    const std::string& path, const std::vector<Int8CalibrationEntry>& table);
+TEST_API std::vector<Int8CalibrationEntry> DeserializeInt8CalibrationTable(
+    const std::string& path);
+
+}  // namespace inference
+}  // namespace paddle
@@ -87,9 +87,8 @@ bool CheckConvertToONNX(const AnalysisConfig &config) {
 }
 
 bool ONNXRuntimePredictor::InitBinding() {
-  // Now ONNXRuntime only support CPU
-  const char *device_name = config_.use_gpu() ? "Cuda" : "Cpu";
-  if (config_.use_gpu()) {
+  const char *device_name = use_cuda_ ? "Cuda" : "Cpu";
+  if (use_cuda_) {
     place_ = phi::GPUPlace(config_.gpu_device_id());
   } else {
     place_ = phi::CPUPlace();
@@ -97,6 +96,9 @@ bool ONNXRuntimePredictor::InitBinding() {
   scope_.reset(new paddle::framework::Scope());
 
   binding_ = std::make_shared<Ort::IoBinding>(*session_);
+  input_values_.clear();
+  bound_inputs_.clear();
+  outputs_bound_ = false;
   Ort::MemoryInfo memory_info(
       device_name, OrtDeviceAllocator, place_.GetDeviceId(), OrtMemTypeDefault);
   Ort::Allocator allocator(*session_, memory_info);
@@ -112,6 +114,8 @@ bool ONNXRuntimePredictor::InitBinding() {
     ONNXTensorElementDataType data_type =
         type_info.GetTensorTypeAndShapeInfo().GetElementType();
     input_desc_.emplace_back(ONNXDesc{input_name, shape, data_type});
+    input_values_.emplace_back(nullptr);
+    bound_inputs_.emplace_back(nullptr, std::vector<int64_t>());
 
     auto *ptr = scope_->Var(input_name);
     framework::InitializeVariable(ptr, proto_type);
@@ -171,6 +175,23 @@ bool ONNXRuntimePredictor::Init() {
   // session_options.SetInterOpNumThreads(config_.cpu_math_library_num_threads());
   session_options.SetIntraOpNumThreads(config_.cpu_math_library_num_threads());
   VLOG(2) << "ONNXRuntime threads " << config_.cpu_math_library_num_threads();
+  if (config_.use_gpu()) {
+    OrtCUDAProviderOptions cuda_options;
+    cuda_options.device_id = config_.gpu_device_id();
+    if (config_.external_stream_enabled()) {
+      // ONNXRuntime launches its kernels on the stream of SetExecStream.
+      cuda_options.has_user_compute_stream = 1;
+      cuda_options.user_compute_stream = config_.GetExecStream();
+    }
+    try {
+      session_options.AppendExecutionProvider_CUDA(cuda_options);
+      use_cuda_ = true;
+    } catch (const Ort::Exception &e) {
+      LOG(WARNING) << "ONNXRuntime CUDA execution provider is unavailable, "
+                      "fall back to CPU: "
+                   << e.what();
+    }
+  }
   if (config_.profile_enabled()) {
     LOG(WARNING) << "ONNXRuntime Profiler is activated, which might affect the "
                     "performance";
@@ -333,23 +354,64 @@ bool ONNXRuntimePredictor::Run(const std::vector<PaddleTensor> &inputs,
   return false;
 }
 
+bool ONNXRuntimePredictor::BindInputs(const char *device_name) {
+  bool dims_changed = false;
+  for (size_t i = 0; i < input_desc_.size(); ++i) {
+    auto *tensor =
+        scope_->FindVar(input_desc_[i].name)->GetMutable<phi::DenseTensor>();
+    void *data = tensor->data();
+    std::vector<int64_t> dims = common::vectorize<int64_t>(tensor->dims());
+    auto &bound = bound_inputs_[i];
+    if (bound.first == data && bound.second == dims) {
+      continue;
+    }
+    dims_changed = dims_changed || bound.second != dims;
+    input_values_[i] = GetOrtValue(input_desc_[i], device_name);
+    binding_->BindInput(input_desc_[i].name.c_str(), input_values_[i]);
+    bound = std::make_pair(data, std::move(dims));
+  }
+  return dims_changed;
+}
+
+void ONNXRuntimePredictor::BindOutputsToDevice(const char *device_name) {
+  for (auto output : output_desc_) {
+    Ort::MemoryInfo out_memory_info(device_name,
+                                    OrtDeviceAllocator,
+                                    place_.GetDeviceId(),
+                                    OrtMemTypeDefault);
+    binding_->BindOutput(output.name.c_str(), out_memory_info);
+  }
+  outputs_bound_ = false;
+}
+
 bool ONNXRuntimePredictor::ZeroCopyRun(bool switch_stream) {
   try {
     const char *device_name = phi::is_cpu_place(place_) ? "Cpu" : "Cuda";
-    std::vector<Ort::Value> inputs;
-    inputs.reserve(input_desc_.size());
-    for (auto desc : input_desc_) {
-      inputs.push_back(GetOrtValue(desc, device_name));
-      binding_->BindInput(desc.name.c_str(), inputs.back());
+    if (BindInputs(device_name) || !outputs_bound_) {
+      BindOutputsToDevice(device_name);
+    }
+    try {
+      session_->Run({}, *(binding_.get()));
+    } catch (const Ort::Exception &e) {
+      if (!outputs_bound_) {
+        throw;
+      }
+      // The dims of the outputs depend on the data of the inputs, so they are
+      // allocated by every run from now on.
+      VLOG(3) << "ONNXRuntime can not reuse the outputs: " << e.what();
+      reuse_outputs_ = false;
+      BindOutputsToDevice(device_name);
+      session_->Run({}, *(binding_.get()));
     }
-    for (auto output : output_desc_) {
-      Ort::MemoryInfo out_memory_info(device_name,
-                                      OrtDeviceAllocator,
-                                      place_.GetDeviceId(),
-                                      OrtMemTypeDefault);
-      binding_->BindOutput(output.name.c_str(), out_memory_info);
+    if (reuse_outputs_ && !outputs_bound_) {
+      // The outputs stay bound, so that the next run of the same input dims
+      // writes them in place instead of allocating them.
+      output_values_ = binding_->GetOutputValues();
+      for (size_t i = 0; i < output_desc_.size(); ++i) {
+        binding_->BindOutput(output_desc_[i].name.c_str(), output_values_[i]);
+      }
+      outputs_bound_ = true;
     }
-    session_->Run({}, *(binding_.get()));
   } catch (const std::exception &e) {
     LOG(ERROR) << e.what();
     return false;
@@ -361,6 +423,7 @@ bool ONNXRuntimePredictor::ZeroCopyRun(bool switch_stream) {
 std::unique_ptr<PaddlePredictor> ONNXRuntimePredictor::Clone(void *stream) {
   std::lock_guard<std::mutex> lk(clone_mutex_);
   auto *x = new ONNXRuntimePredictor(config_, env_, session_);
+  x->use_cuda_ = use_cuda_;
   x->InitBinding();
   return std::unique_ptr<PaddlePredictor>(x);
 }
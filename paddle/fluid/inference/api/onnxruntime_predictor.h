@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "onnxruntime_c_api.h"    // NOLINT
@@ -224,11 +225,33 @@ class ONNXRuntimePredictor : public PaddlePredictor {
   ///
   Ort::Value GetOrtValue(const ONNXDesc &desc, const char *device_name);
 
+  ///
+  /// \brief Bind the inputs whose tensors moved or were reshaped since the
+  /// last run.
+  ///
+  /// \return Whether the dims of an input changed.
+  ///
+  bool BindInputs(const char *device_name);
+
+  ///
+  /// \brief Bind the outputs to be allocated by the next run on the device.
+  ///
+  void BindOutputsToDevice(const char *device_name);
+
  private:
   // ONNXRuntime
   std::shared_ptr<Ort::Env> env_;
   std::shared_ptr<Ort::Session> session_{nullptr};
   std::shared_ptr<Ort::IoBinding> binding_;
+  // Whether the session runs on the CUDA execution provider.
+  bool use_cuda_{false};
+  // The values bound to the inputs, with the data and dims they view.
+  std::vector<Ort::Value> input_values_;
+  std::vector<std::pair<void *, std::vector<int64_t>>> bound_inputs_;
+  // The outputs of the last run, bound again while the input dims stay.
+  std::vector<Ort::Value> output_values_;
+  bool outputs_bound_{false};
+  bool reuse_outputs_{true};
 
   AnalysisConfig config_;
   std::mutex clone_mutex_;
@@ -771,6 +771,193 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   bool shape_range_info_collected() const;
 
+  ///
+  /// \brief Record the allocations of every place while the predictor runs,
+  /// and save the blocks alive at the peak usage when it is destroyed.
+  ///
+  /// \param allocation_profile_path the path to save the allocation profile.
+  ///
+  void CollectAllocationProfile(const std::string& allocation_profile_path);
+
+  ///
+  /// \brief Replay an allocation profile saved by CollectAllocationProfile
+  /// when the predictor is created, so that the allocators have grown to the
+  /// recorded peak before the first run.
+  ///
+  /// \param allocation_profile_path the path of the allocation profile.
+  ///
+  void EnableAllocationProfileReplay(
+      const std::string& allocation_profile_path);
+
+  ///
+  /// \brief the path of the allocation profile to save or to replay.
+  ///
+  /// \return the allocation profile path.
+  ///
+  const std::string& allocation_profile_path() const;
+
+  ///
+  /// \brief A boolean state telling whether to collect the allocation
+  /// profile.
+  ///
+  /// \return bool Whether to collect the allocation profile.
+  ///
+  bool allocation_profile_collected() const;
+
+  ///
+  /// \brief A boolean state telling whether to replay the allocation profile.
+  ///
+  /// \return bool Whether to replay the allocation profile.
+  ///
+  bool allocation_profile_replay_enabled() const;
+
+  ///
+  /// \brief The algorithm choosing the threshold an activation is clipped to
+  /// in the int8 calibration.
+  ///
+  enum class Int8CalibrationAlgo {
+    kAbsMax = 0,  ///< the largest absolute value
+    kKL,          ///< the least KL divergence from the quantized values
+    kPercentile,  ///< a percentile of the absolute values
+  };
+
+  ///
+  /// \brief Calibrate the PIR program for int8 without TensorRT. The runs
+  /// collect the statistics of the activations the convolutions and the
+  /// matmuls take, on the operators of the model as it is loaded, and the
+  /// thresholds are saved to a calibration table when the predictor is
+  /// destroyed. Run it with representative batches.
+  ///
+  /// \param table_path the path to save the calibration table.
+  /// \param algo the algorithm choosing the thresholds.
+  /// \param percentile the percentile of Int8CalibrationAlgo::kPercentile.
+  ///
+  void CollectInt8Calibration(
+      const std::string& table_path,
+      Int8CalibrationAlgo algo = Int8CalibrationAlgo::kKL,
+      float percentile = 99.99f);
+
+  ///
+  /// \brief Quantize the PIR program with a calibration table saved by
+  /// CollectInt8Calibration from the same model. A quantize_linear and
+  /// dequantize_linear pair with the calibrated scale is inserted before each
+  /// calibrated activation, the form of a quantization aware trained model,
+  /// which the int8 passes of the backends take.
+  ///
+  /// \param table_path the path of the calibration table.
+  ///
+  void EnableInt8Calibration(const std::string& table_path);
+
+  ///
+  /// \brief the path of the int8 calibration table to save or to apply.
+  ///
+  /// \return the int8 calibration table path.
+  ///
+  const std::string& int8_calibration_table_path() const;
+
+  ///
+  /// \brief the algorithm choosing the thresholds of the calibration.
+  ///
+  /// \return the int8 calibration algorithm.
+  ///
+  Int8CalibrationAlgo int8_calibration_algo() const {
+    return int8_calibration_algo_;
+  }
+
+  ///
+  /// \brief the percentile taken by Int8CalibrationAlgo::kPercentile.
+  ///
+  /// \return the int8 calibration percentile.
+  ///
+  float int8_calibration_percentile() const {
+    return int8_calibration_percentile_;
+  }
+
+  ///
+  /// \brief A boolean state telling whether to collect the int8 calibration.
+  ///
+  /// \return bool Whether to collect the int8 calibration.
+  ///
+  bool int8_calibration_collected() const;
+
+  ///
+  /// \brief A boolean state telling whether to quantize with the int8
+  /// calibration table.
+  ///
+  /// \return bool Whether to quantize with the int8 calibration table.
+  ///
+  bool int8_calibration_enabled() const;
+
+  ///
+  /// \brief Share the parameters identical in content with the other
+  /// predictors of this process on the same device, so that weights such as
+  /// a common backbone are held once.
+  ///
+  /// \param x Whether to share the parameters.
+  /// \param ipc_dir A directory to also share the GPU parameters with the
+  /// other processes using it through CUDA IPC. The process which loads a
+  /// parameter first must keep it while the others use it.
+  ///
+  void EnableSharedParameters(bool x = true, const std::string& ipc_dir = "");
+
+  ///
+  /// \brief A boolean state telling whether to share the parameters.
+  ///
+  /// \return bool Whether to share the parameters.
+  ///
+  bool shared_parameters_enabled() const { return share_parameters_; }
+
+  ///
+  /// \brief The directory to share the parameters across processes.
+  ///
+  /// \return the directory, empty when not shared across processes.
+  ///
+  const std::string& shared_parameters_ipc_dir() const {
+    return shared_parameters_ipc_dir_;
+  }
+
+  ///
+  /// \brief Run the predictor as a tenant of the GPU shared with the other
+  /// predictors of this process. The predictor runs on its own stream
+  /// created with the priority of the tenant, and the memory allocated by
+  /// the predictors of the tenant is capped.
+  ///
+  /// \param name The name of the tenant, the predictors with the same name
+  /// share the memory limit. The priority and the limit of a tenant are
+  /// taken from the first predictor created for it.
+  /// \param stream_priority The priority of the streams, where a lower
+  /// number is a higher priority as in CUDA. It is clamped to the range of
+  /// the device.
+  /// \param memory_limit_mb The cap of the memory allocated by the tenant on
+  /// each device in MB, 0 for no limit.
+  ///
+  void SetGpuTenant(const std::string& name,
+                    int stream_priority = 0,
+                    uint64_t memory_limit_mb = 0);
+
+  ///
+  /// \brief The name of the tenant of the GPU.
+  ///
+  /// \return the name, empty when the predictor is not a tenant.
+  ///
+  const std::string& gpu_tenant() const { return gpu_tenant_; }
+
+  ///
+  /// \brief The stream priority of the tenant of the GPU.
+  ///
+  /// \return int The stream priority.
+  ///
+  int gpu_tenant_stream_priority() const { return gpu_tenant_stream_priority_; }
+
+  ///
+  /// \brief The memory limit of the tenant of the GPU.
+  ///
+  /// \return uint64_t The memory limit in MB, 0 for no limit.
+  ///
+  uint64_t gpu_tenant_memory_limit_mb() const {
+    return gpu_tenant_memory_limit_mb_;
+  }
+
   ///
   /// \brief Prevent ops running in Paddle-TRT
   /// NOTE: just experimental, not an official stable API, easy to be broken.
@@ -942,6 +1129,26 @@ struct PD_INFER_DECL AnalysisConfig {
   int cpu_math_library_num_threads() const {
     return cpu_math_library_num_threads_;
   }
+  ///
+  /// \brief Run the CPU kernels of the predictor on a pool of threads
+  /// pinned to the given cores, one per core, the thread calling Run being
+  /// pinned to them too. The predictors on the same cores, e.g. the clones
+  /// of a predictor, share the pool. The OpenMP and MKL threads of oneDNN
+  /// and BLAS are then limited to the number of cores for the thread
+  /// calling Run, in place of cpu_math_library_num_threads for the process,
+  /// so that predictors on other cores do not oversubscribe them.
+  ///
+  /// \param cpu_cores The ids of the cores.
+  ///
+  void SetCpuThreadAffinity(const std::vector<int> &cpu_cores);
+  ///
+  /// \brief The cores the CPU kernels run on, empty when not set.
+  ///
+  /// \return const std::vector<int>& The ids of the cores.
+  ///
+  const std::vector<int> &cpu_thread_affinity() const {
+    return cpu_thread_affinity_;
+  }
 
   ///
   /// \brief Transform the AnalysisConfig to NativeConfig.
@@ -1061,6 +1268,39 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   bool profile_enabled() const { return with_profile_; }
 
+  ///
+  /// \brief Trace each run of the predictor without the global profiler.
+  /// The time of the run, of every operator, TensorRT engine and CINN group
+  /// in it, and of the feed and fetch copies of Run, is kept as the spans
+  /// of a trace which Predictor::GetLastRunTrace returns.
+  ///
+  /// \param x Whether to trace the runs.
+  ///
+  void EnableRunTrace(bool x = true) { with_run_trace_ = x; }
+  ///
+  /// \brief A boolean state telling whether the runs are traced.
+  ///
+  /// \return bool Whether the runs are traced.
+  ///
+  bool run_trace_enabled() const { return with_run_trace_; }
+
+  ///
+  /// \brief Trace the startup of the predictor, from its creation to the end
+  /// of its first run: the loading of the program and the parameters, every
+  /// analysis, IR and PIR pass, CINN group compilation, TensorRT engine build
+  /// and the build of the executor. Predictor::GetStartupSummary and
+  /// Predictor::ExportStartupTrace tell where the time goes.
+  ///
+  /// \param x Whether to trace the startup.
+  ///
+  void EnableStartupTrace(bool x = true) { with_startup_trace_ = x; }
+  ///
+  /// \brief A boolean state telling whether the startup is traced.
+  ///
+  /// \return bool Whether the startup is traced.
+  ///
+  bool startup_trace_enabled() const { return with_startup_trace_; }
+
   ///
   /// \brief Mute all logs in Paddle inference.
   ///
@@ -1272,6 +1512,29 @@ struct PD_INFER_DECL AnalysisConfig {
   bool collect_shape_range_info_{false};
   std::string shape_range_info_path_;
 
+  // The allocation profile is recorded from a warmup run and replayed at
+  // startup to grow the allocators in advance.
+  bool collect_allocation_profile_{false};
+  bool replay_allocation_profile_{false};
+  std::string allocation_profile_path_;
+
+  // The int8 calibration table is collected from representative runs and
+  // applied at startup as quantize and dequantize pairs.
+  bool collect_int8_calibration_{false};
+  bool enable_int8_calibration_{false};
+  std::string int8_calibration_table_path_;
+  Int8CalibrationAlgo int8_calibration_algo_{Int8CalibrationAlgo::kKL};
+  float int8_calibration_percentile_{99.99f};
+
+  // The parameters are shared by content with the other predictors.
+  bool share_parameters_{false};
+  std::string shared_parameters_ipc_dir_;
+
+  // The tenant of the GPU, see SetGpuTenant.
+  std::string gpu_tenant_;
+  int gpu_tenant_stream_priority_{0};
+  uint64_t gpu_tenant_memory_limit_mb_{0};
+
   // memory reuse related.
   bool enable_memory_optim_{false};
   bool trt_engine_memory_sharing_{true};
@@ -1298,8 +1561,11 @@ struct PD_INFER_DECL AnalysisConfig {
   bool specify_input_name_{false};
 
   int cpu_math_library_num_threads_{1};
+  std::vector<int> cpu_thread_affinity_;
 
   bool with_profile_{false};
+  bool with_run_trace_{false};
+  bool with_startup_trace_{false};
 
   bool with_glog_info_{true};
 
@@ -23,6 +23,7 @@
  */
 
 #include <cassert>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -202,6 +203,19 @@ class PD_INFER_DECL ZeroCopyTensor : public paddle_infer::Tensor {
       : paddle_infer::Tensor{scope, device_contexts} {}
 };
 
+/// \brief A span of the trace of a run, see AnalysisConfig::EnableRunTrace.
+/// The fields follow the span of OpenTelemetry, so that the trace can be
+/// exported to a collector with TraceSpansToOtlpJson.
+struct PD_INFER_DECL TraceSpan {
+  std::string name;
+  std::string trace_id;        ///< 32 hex digits.
+  std::string span_id;         ///< 16 hex digits.
+  std::string parent_span_id;  ///< Empty for the root span.
+  int64_t start_time_unix_nano{0};
+  int64_t end_time_unix_nano{0};
+  std::map<std::string, std::string> attributes;
+};
+
 /// \brief A Predictor for executing inference on a model.
 /// Base class for AnalysisPredictor and NativePaddlePredictor.
 class PD_INFER_DECL PaddlePredictor {
@@ -298,6 +312,19 @@ class PD_INFER_DECL PaddlePredictor {
   /// \return Whether the run is successful
   virtual bool ZeroCopyRun(bool switch_stream = false) { return false; }
 
+  /// \brief Run the network like ZeroCopyRun, but return once the work is
+  /// enqueued on the execution stream instead of waiting for the device. The
+  /// callback is invoked with whether the run is successful in another thread
+  /// when the outputs are ready. The next run of the predictor waits for the
+  /// callback, so the inputs of the next run can be prepared meanwhile.
+  /// \param callback The function invoked when the run is completed.
+  /// \return Whether the work is enqueued successfully
+  virtual bool ZeroCopyRunAsync(std::function<void(bool)> callback) {
+    bool success = ZeroCopyRun();
+    if (callback) callback(success);
+    return success;
+  }
+
   ///
   /// \brief Clear the intermediate tensors of the predictor
   ///
@@ -328,6 +355,37 @@ class PD_INFER_DECL PaddlePredictor {
   /// \brief Same as RegisterOutputHook
   virtual void RegisterInputHook(const InputTensorHookFunc& hookfunc) {}
 
+  /// \brief Make the trace of the next run a child of the span of the
+  /// caller, so that it joins the trace of the request. Only used when
+  /// AnalysisConfig::EnableRunTrace is set.
+  /// \param trace_id The trace id of the caller, as 32 hex digits.
+  /// \param parent_span_id The span id of the caller, as 16 hex digits.
+  virtual void SetTraceParent(const std::string& trace_id,
+                              const std::string& parent_span_id) {}
+
+  /// \brief Get the trace of the last run, the span of the run first, when
+  /// AnalysisConfig::EnableRunTrace is set.
+  /// \return The spans of the last run.
+  virtual std::vector<TraceSpan> GetLastRunTrace() { return {}; }
+
+  /// \brief Replace the parameters by the ones of a combined params file,
+  /// without rebuilding the predictor.
+  /// \param params_file The params file.
+  /// \return Whether the parameters are updated.
+  virtual bool UpdateParameters(const std::string& params_file) {
+    return false;
+  }
+
+  /// \brief Get the summary of the startup, when
+  /// AnalysisConfig::EnableStartupTrace is set.
+  /// \return The time of each category of the phases, and the longest ones.
+  virtual std::string GetStartupSummary() { return ""; }
+
+  /// \brief Write the trace of the startup in the chrome tracing format,
+  /// when AnalysisConfig::EnableStartupTrace is set.
+  /// \param path The file to write.
+  virtual void ExportStartupTrace(const std::string& path) {}
+
   /// \brief Clone an existing predictor
   /// When using clone, the same network will be created,
   /// and the parameters between them are shared.
@@ -14,9 +14,28 @@
 
 #include "paddle/fluid/inference/api/paddle_infer_contrib.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/platform/enforce.h"
+#include "paddle/phi/common/bfloat16.h"
 #include "paddle/phi/common/float16.h"
+#include "paddle/phi/core/memory/allocation/mmap_allocator.h"
 #include "paddle/phi/core/memory/memcpy.h"
 #include "paddle/phi/core/platform/device_context.h"
 
@@ -288,4 +307,1727 @@ bool Status::operator!=(const Status& x) const noexcept {
   return !(*this == x);
 }
 
+namespace {
+
+constexpr uint64_t kTensorRingMagic = 0x50445f52494e4701ULL;
+constexpr size_t kTensorRingAlignment = 64;
+
+enum TensorRingSlotState : int32_t {
+  kSlotFree = 0,
+  kSlotWriting = 1,
+  kSlotReady = 2,
+  kSlotReading = 3
+};
+
+// The layout of the shared memory is one RingHeader, slot_num SlotHeaders,
+// then the data buffers of the slots.
+struct alignas(kTensorRingAlignment) RingHeader {
+  uint64_t magic;
+  uint64_t slot_num;
+  uint64_t slot_bytes;
+  std::atomic<uint64_t> next_seq;
+};
+
+struct alignas(kTensorRingAlignment) SlotHeader {
+  std::atomic<int32_t> state;
+  int32_t dtype;
+  int32_t rank;
+  int32_t shape[SharedMemoryTensorRing::kMaxRank];
+  // The order in which the slots were committed.
+  uint64_t seq;
+};
+
+static_assert(std::atomic<int32_t>::is_always_lock_free &&
+                  std::atomic<uint64_t>::is_always_lock_free,
+              "The tensor ring requires address-free atomics.");
+
+size_t AlignedSlotBytes(size_t slot_bytes) {
+  return (slot_bytes + kTensorRingAlignment - 1) / kTensorRingAlignment *
+         kTensorRingAlignment;
+}
+
+size_t TensorRingBytes(size_t slot_num, size_t slot_bytes) {
+  return sizeof(RingHeader) + slot_num * sizeof(SlotHeader) +
+         slot_num * AlignedSlotBytes(slot_bytes);
+}
+
+size_t DataTypeBytes(DataType dtype) {
+  switch (dtype) {
+    case DataType::FLOAT64:
+    case DataType::INT64:
+      return 8;
+    case DataType::FLOAT32:
+    case DataType::INT32:
+      return 4;
+    case DataType::FLOAT16:
+    case DataType::BFLOAT16:
+      return 2;
+    case DataType::UINT8:
+    case DataType::INT8:
+    case DataType::BOOL:
+      return 1;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "Unsupported data type %d in paddle_infer contrib.",
+          static_cast<int>(dtype)));
+  }
+}
+
+// Call func with a null pointer of the C++ type of dtype.
+template <typename Func>
+void VisitDataType(DataType dtype, Func&& func) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      func(static_cast<float*>(nullptr));
+      break;
+    case DataType::INT64:
+      func(static_cast<int64_t*>(nullptr));
+      break;
+    case DataType::INT32:
+      func(static_cast<int32_t*>(nullptr));
+      break;
+    case DataType::UINT8:
+      func(static_cast<uint8_t*>(nullptr));
+      break;
+    case DataType::INT8:
+      func(static_cast<int8_t*>(nullptr));
+      break;
+    case DataType::FLOAT16:
+      func(static_cast<phi::dtype::float16*>(nullptr));
+      break;
+    case DataType::BOOL:
+      func(static_cast<bool*>(nullptr));
+      break;
+    case DataType::FLOAT64:
+      func(static_cast<double*>(nullptr));
+      break;
+    case DataType::BFLOAT16:
+      func(static_cast<phi::dtype::bfloat16*>(nullptr));
+      break;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "Unsupported data type %d in paddle_infer contrib.",
+          static_cast<int>(dtype)));
+  }
+}
+
+}  // namespace
+
+struct SharedMemoryTensorRing::Impl {
+  std::shared_ptr<phi::Allocation> allocation;
+  std::string name;
+  size_t slot_num{0};
+  size_t slot_bytes{0};
+  RingHeader* header{nullptr};
+  SlotHeader* slots{nullptr};
+  char* data{nullptr};
+
+  Impl(std::shared_ptr<phi::Allocation> allocation,
+       const std::string& name,
+       size_t slot_num,
+       size_t slot_bytes)
+      : allocation(std::move(allocation)),
+        name(name),
+        slot_num(slot_num),
+        slot_bytes(slot_bytes) {
+    char* base = static_cast<char*>(this->allocation->ptr());
+    header = reinterpret_cast<RingHeader*>(base);
+    slots = reinterpret_cast<SlotHeader*>(base + sizeof(RingHeader));
+    data = base + sizeof(RingHeader) + slot_num * sizeof(SlotHeader);
+  }
+
+  SlotHeader& Slot(int slot) const {
+    PADDLE_ENFORCE_EQ(
+        slot >= 0 && static_cast<size_t>(slot) < slot_num,
+        true,
+        common::errors::OutOfRange(
+            "The slot index %d is out of range [0, %d).", slot, slot_num));
+    return slots[slot];
+  }
+
+  void CheckState(int slot, int32_t state, const char* action) const {
+    PADDLE_ENFORCE_EQ(Slot(slot).state.load(std::memory_order_acquire),
+                      state,
+                      common::errors::PreconditionNotMet(
+                          "The slot %d of the tensor ring %s is in the wrong "
+                          "state to %s.",
+                          slot,
+                          name,
+                          action));
+  }
+};
+
+SharedMemoryTensorRing::SharedMemoryTensorRing(std::shared_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+SharedMemoryTensorRing SharedMemoryTensorRing::Create(size_t slot_num,
+                                                      size_t slot_bytes) {
+#ifndef _WIN32
+  PADDLE_ENFORCE_GT(slot_num,
+                    0UL,
+                    common::errors::InvalidArgument(
+                        "The tensor ring should have at least one slot."));
+  auto allocation =
+      paddle::memory::allocation::AllocateMemoryMapWriterAllocation(
+          TensorRingBytes(slot_num, slot_bytes));
+  // The name is unlinked at exit in case no consumer ever opens the ring.
+  paddle::memory::allocation::MemoryMapFdSet::Instance().Insert(
+      allocation->ipc_name());
+  auto impl = std::make_shared<Impl>(
+      allocation, allocation->ipc_name(), slot_num, slot_bytes);
+  new (impl->header) RingHeader();
+  for (size_t i = 0; i < slot_num; ++i) {
+    new (&impl->slots[i]) SlotHeader();
+  }
+  impl->header->slot_num = slot_num;
+  impl->header->slot_bytes = slot_bytes;
+  impl->header->magic = kTensorRingMagic;
+  VLOG(3) << "Create tensor ring " << impl->name << " of " << slot_num
+          << " slots";
+  return SharedMemoryTensorRing(impl);
+#else
+  PADDLE_THROW(common::errors::Unimplemented(
+      "SharedMemoryTensorRing is not supported on Windows."));
+#endif
+}
+
+SharedMemoryTensorRing SharedMemoryTensorRing::Open(const std::string& name,
+                                                    size_t slot_num,
+                                                    size_t slot_bytes) {
+#ifndef _WIN32
+  auto allocation =
+      paddle::memory::allocation::RebuildMemoryMapReaderAllocation(
+          name, TensorRingBytes(slot_num, slot_bytes));
+  auto impl = std::make_shared<Impl>(allocation, name, slot_num, slot_bytes);
+  PADDLE_ENFORCE_EQ(impl->header->magic == kTensorRingMagic &&
+                        impl->header->slot_num == slot_num &&
+                        impl->header->slot_bytes == slot_bytes,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The shared memory %s is not a tensor ring of %d "
+                        "slots of %d bytes.",
+                        name,
+                        slot_num,
+                        slot_bytes));
+  return SharedMemoryTensorRing(impl);
+#else
+  PADDLE_THROW(common::errors::Unimplemented(
+      "SharedMemoryTensorRing is not supported on Windows."));
+#endif
+}
+
+const std::string& SharedMemoryTensorRing::name() const { return impl_->name; }
+size_t SharedMemoryTensorRing::slot_num() const { return impl_->slot_num; }
+size_t SharedMemoryTensorRing::slot_bytes() const { return impl_->slot_bytes; }
+
+int SharedMemoryTensorRing::AcquireWriteSlot() {
+  for (size_t i = 0; i < impl_->slot_num; ++i) {
+    int32_t expected = kSlotFree;
+    if (impl_->slots[i].state.compare_exchange_strong(
+            expected, kSlotWriting, std::memory_order_acquire)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void SharedMemoryTensorRing::CommitWriteSlot(int slot,
+                                             const std::vector<int>& shape,
+                                             DataType dtype) {
+  impl_->CheckState(slot, kSlotWriting, "commit");
+  PADDLE_ENFORCE_LE(shape.size(),
+                    static_cast<size_t>(kMaxRank),
+                    common::errors::InvalidArgument(
+                        "The rank of the tensor in the tensor ring should be "
+                        "at most %d, but got %d.",
+                        kMaxRank,
+                        shape.size()));
+  size_t numel = 1;
+  for (int dim : shape) {
+    PADDLE_ENFORCE_GE(dim,
+                      0,
+                      common::errors::InvalidArgument(
+                          "The shape of the tensor should not be negative."));
+    numel *= dim;
+  }
+  PADDLE_ENFORCE_LE(numel * DataTypeBytes(dtype),
+                    impl_->slot_bytes,
+                    common::errors::InvalidArgument(
+                        "The tensor of %d bytes does not fit in the slot of "
+                        "%d bytes.",
+                        numel * DataTypeBytes(dtype),
+                        impl_->slot_bytes));
+
+  SlotHeader& header = impl_->Slot(slot);
+  header.dtype = static_cast<int32_t>(dtype);
+  header.rank = static_cast<int32_t>(shape.size());
+  for (size_t i = 0; i < shape.size(); ++i) {
+    header.shape[i] = shape[i];
+  }
+  header.seq = impl_->header->next_seq.fetch_add(1);
+  header.state.store(kSlotReady, std::memory_order_release);
+}
+
+int SharedMemoryTensorRing::AcquireReadSlot() {
+  while (true) {
+    int oldest = -1;
+    uint64_t oldest_seq = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < impl_->slot_num; ++i) {
+      const SlotHeader& header = impl_->slots[i];
+      if (header.state.load(std::memory_order_acquire) == kSlotReady &&
+          header.seq < oldest_seq) {
+        oldest = static_cast<int>(i);
+        oldest_seq = header.seq;
+      }
+    }
+    if (oldest == -1) {
+      return -1;
+    }
+    int32_t expected = kSlotReady;
+    if (impl_->slots[oldest].state.compare_exchange_strong(
+            expected, kSlotReading, std::memory_order_acquire)) {
+      return oldest;
+    }
+    // Taken by another consumer, look for the next one.
+  }
+}
+
+void SharedMemoryTensorRing::ReleaseReadSlot(int slot) {
+  impl_->CheckState(slot, kSlotReading, "release");
+  impl_->Slot(slot).state.store(kSlotFree, std::memory_order_release);
+}
+
+void* SharedMemoryTensorRing::SlotData(int slot) const {
+  impl_->Slot(slot);
+  return impl_->data + slot * AlignedSlotBytes(impl_->slot_bytes);
+}
+
+std::vector<int> SharedMemoryTensorRing::SlotShape(int slot) const {
+  const SlotHeader& header = impl_->Slot(slot);
+  return std::vector<int>(header.shape, header.shape + header.rank);
+}
+
+DataType SharedMemoryTensorRing::SlotType(int slot) const {
+  return static_cast<DataType>(impl_->Slot(slot).dtype);
+}
+
+void SharedMemoryTensorRing::BindTensor(int slot, Tensor* tensor) const {
+  impl_->CheckState(slot, kSlotReading, "bind");
+  auto shape = SlotShape(slot);
+  void* data = SlotData(slot);
+  switch (SlotType(slot)) {
+    case DataType::FLOAT32:
+      tensor->ShareExternalData(
+          static_cast<const float*>(data), shape, PlaceType::kCPU);
+      break;
+    case DataType::INT64:
+      tensor->ShareExternalData(
+          static_cast<const int64_t*>(data), shape, PlaceType::kCPU);
+      break;
+    case DataType::INT32:
+      tensor->ShareExternalData(
+          static_cast<const int32_t*>(data), shape, PlaceType::kCPU);
+      break;
+    case DataType::UINT8:
+      tensor->ShareExternalData(
+          static_cast<const uint8_t*>(data), shape, PlaceType::kCPU);
+      break;
+    case DataType::INT8:
+      tensor->ShareExternalData(
+          static_cast<const int8_t*>(data), shape, PlaceType::kCPU);
+      break;
+    case DataType::FLOAT16:
+      tensor->ShareExternalData(static_cast<const phi::dtype::float16*>(data),
+                                shape,
+                                PlaceType::kCPU);
+      break;
+    case DataType::BOOL:
+      tensor->ShareExternalData(
+          static_cast<const bool*>(data), shape, PlaceType::kCPU);
+      break;
+    case DataType::FLOAT64:
+      tensor->ShareExternalData(
+          static_cast<const double*>(data), shape, PlaceType::kCPU);
+      break;
+    case DataType::BFLOAT16:
+      tensor->ShareExternalData(static_cast<const phi::dtype::bfloat16*>(data),
+                                shape,
+                                PlaceType::kCPU);
+      break;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "Unsupported data type %d in SharedMemoryTensorRing.",
+          static_cast<int>(SlotType(slot))));
+  }
+}
+
+struct PagedKVCacheManager::Impl {
+  struct Block {
+    int ref_count = 0;
+    // Whether the block is in the prefix cache under hash.
+    bool cached = false;
+    uint64_t hash = 0;
+    std::list<int>::iterator evictable_it;
+  };
+
+  struct Sequence {
+    std::vector<int> blocks;
+    std::vector<int64_t> tokens;
+    // The hash of the full blocks, chained from the first one.
+    uint64_t hash = 0;
+    int64_t length = 0;
+  };
+
+  Impl(int num_blocks, int block_size, int max_blocks_per_seq)
+      : num_blocks(num_blocks),
+        block_size(block_size),
+        max_blocks_per_seq(max_blocks_per_seq),
+        blocks(num_blocks) {
+    for (int i = num_blocks - 1; i >= 0; --i) {
+      free_blocks.push_back(i);
+    }
+  }
+
+  static uint64_t HashBlock(uint64_t prev_hash,
+                            const std::vector<int64_t>& tokens) {
+    // FNV-1a over the hash of the preceding blocks and the tokens.
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value) {
+      for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 1099511628211ULL;
+      }
+    };
+    mix(prev_hash);
+    for (auto token : tokens) {
+      mix(static_cast<uint64_t>(token));
+    }
+    return hash;
+  }
+
+  int NumAvailable() const {
+    return static_cast<int>(free_blocks.size() + evictable_blocks.size());
+  }
+
+  Sequence& Find(int64_t seq_id) {
+    auto it = sequences.find(seq_id);
+    PADDLE_ENFORCE_NE(
+        it,
+        sequences.end(),
+        common::errors::NotFound("The sequence %d is not found.", seq_id));
+    return it->second;
+  }
+
+  // Takes a free block, or evicts the cached one freed the earliest.
+  int Allocate() {
+    int id;
+    if (!free_blocks.empty()) {
+      id = free_blocks.back();
+      free_blocks.pop_back();
+    } else {
+      PADDLE_ENFORCE_EQ(evictable_blocks.empty(),
+                        false,
+                        common::errors::ResourceExhausted(
+                            "The paged kv cache has no block left."));
+      id = evictable_blocks.front();
+      evictable_blocks.pop_front();
+      cached_blocks.erase(blocks[id].hash);
+      blocks[id].cached = false;
+    }
+    blocks[id].ref_count = 1;
+    return id;
+  }
+
+  void AddRef(int id) {
+    if (blocks[id].ref_count++ == 0 && blocks[id].cached) {
+      evictable_blocks.erase(blocks[id].evictable_it);
+    }
+  }
+
+  void Release(int id) {
+    if (--blocks[id].ref_count > 0) return;
+    if (blocks[id].cached) {
+      blocks[id].evictable_it =
+          evictable_blocks.insert(evictable_blocks.end(), id);
+    } else {
+      free_blocks.push_back(id);
+    }
+  }
+
+  // Puts the last block of the sequence, just filled, in the prefix cache.
+  void SealLastBlock(Sequence* seq) {
+    std::vector<int64_t> block_tokens(seq->tokens.end() - block_size,
+                                      seq->tokens.end());
+    seq->hash = HashBlock(seq->hash, block_tokens);
+    int id = seq->blocks.back();
+    if (!blocks[id].cached && !cached_blocks.count(seq->hash)) {
+      blocks[id].cached = true;
+      blocks[id].hash = seq->hash;
+      cached_blocks[seq->hash] = id;
+    }
+  }
+
+  void CheckBlockNum(int64_t length) const {
+    int64_t block_num = (length + block_size - 1) / block_size;
+    PADDLE_ENFORCE_LE(block_num,
+                      max_blocks_per_seq,
+                      common::errors::OutOfRange(
+                          "A sequence of %d tokens takes %d blocks, more than "
+                          "the %d of a block table.",
+                          length,
+                          block_num,
+                          max_blocks_per_seq));
+  }
+
+  const int num_blocks;
+  const int block_size;
+  const int max_blocks_per_seq;
+  std::vector<Block> blocks;
+  std::vector<int> free_blocks;
+  // Cached blocks no sequence uses, the least recently freed first.
+  std::list<int> evictable_blocks;
+  std::unordered_map<uint64_t, int> cached_blocks;
+  std::unordered_map<int64_t, Sequence> sequences;
+  std::vector<std::pair<int, int>> block_copies;
+  mutable std::mutex mutex;
+};
+
+PagedKVCacheManager::PagedKVCacheManager(int num_blocks,
+                                         int block_size,
+                                         int max_blocks_per_seq) {
+  PADDLE_ENFORCE_EQ(num_blocks > 0 && block_size > 0 && max_blocks_per_seq > 0,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The paged kv cache needs positive num_blocks, "
+                        "block_size and max_blocks_per_seq, but received %d, "
+                        "%d and %d.",
+                        num_blocks,
+                        block_size,
+                        max_blocks_per_seq));
+  impl_ = std::make_shared<Impl>(num_blocks, block_size, max_blocks_per_seq);
+}
+
+int PagedKVCacheManager::num_blocks() const { return impl_->num_blocks; }
+int PagedKVCacheManager::block_size() const { return impl_->block_size; }
+int PagedKVCacheManager::max_blocks_per_seq() const {
+  return impl_->max_blocks_per_seq;
+}
+
+int PagedKVCacheManager::NumAvailableBlocks() const {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  return impl_->NumAvailable();
+}
+
+int PagedKVCacheManager::AddSequence(
+    int64_t seq_id, const std::vector<int64_t>& prompt_tokens) {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  PADDLE_ENFORCE_EQ(
+      impl_->sequences.count(seq_id),
+      0UL,
+      common::errors::AlreadyExists("The sequence %d already exists.", seq_id));
+  const int64_t length = static_cast<int64_t>(prompt_tokens.size());
+  impl_->CheckBlockNum(length);
+  const int block_size = impl_->block_size;
+
+  // Look up the full blocks of the prompt until the first miss.
+  std::vector<int> hits;
+  uint64_t hash = 0;
+  for (int64_t start = 0; start + block_size <= length; start += block_size) {
+    std::vector<int64_t> tokens(prompt_tokens.begin() + start,
+                                prompt_tokens.begin() + start + block_size);
+    uint64_t block_hash = Impl::HashBlock(hash, tokens);
+    auto it = impl_->cached_blocks.find(block_hash);
+    if (it == impl_->cached_blocks.end()) break;
+    hits.push_back(it->second);
+    hash = block_hash;
+  }
+  int64_t block_num = (length + block_size - 1) / block_size;
+  int needed = static_cast<int>(block_num) - static_cast<int>(hits.size());
+  int evictable_hits = 0;
+  for (int id : hits) {
+    evictable_hits += impl_->blocks[id].ref_count == 0;
+  }
+  if (needed > impl_->NumAvailable() - evictable_hits) return -1;
+
+  Impl::Sequence seq;
+  for (int id : hits) {
+    impl_->AddRef(id);
+    seq.blocks.push_back(id);
+  }
+  seq.hash = hash;
+  seq.length = static_cast<int64_t>(hits.size()) * block_size;
+  seq.tokens.assign(prompt_tokens.begin(), prompt_tokens.begin() + seq.length);
+  for (int64_t i = seq.length; i < length; ++i) {
+    if (seq.length % block_size == 0) {
+      seq.blocks.push_back(impl_->Allocate());
+    }
+    seq.tokens.push_back(prompt_tokens[i]);
+    if (++seq.length % block_size == 0) {
+      impl_->SealLastBlock(&seq);
+    }
+  }
+  impl_->sequences.emplace(seq_id, std::move(seq));
+  VLOG(4) << "Add sequence " << seq_id << " of " << length << " tokens, "
+          << hits.size() << " blocks from the prefix cache";
+  return static_cast<int>(hits.size()) * block_size;
+}
+
+bool PagedKVCacheManager::AppendTokens(int64_t seq_id,
+                                       const std::vector<int64_t>& tokens) {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  auto& seq = impl_->Find(seq_id);
+  const int block_size = impl_->block_size;
+  const int64_t length = seq.length + static_cast<int64_t>(tokens.size());
+  impl_->CheckBlockNum(length);
+
+  // A shared last block with room left is copied before being written.
+  bool copy_last = seq.length % block_size != 0 &&
+                   impl_->blocks[seq.blocks.back()].ref_count > 1;
+  int needed = static_cast<int>((length + block_size - 1) / block_size -
+                                static_cast<int64_t>(seq.blocks.size())) +
+               (copy_last && !tokens.empty());
+  if (needed > impl_->NumAvailable()) return false;
+
+  if (copy_last && !tokens.empty()) {
+    int shared = seq.blocks.back();
+    int copy = impl_->Allocate();
+    impl_->Release(shared);
+    seq.blocks.back() = copy;
+    impl_->block_copies.emplace_back(shared, copy);
+  }
+  for (auto token : tokens) {
+    if (seq.length % block_size == 0) {
+      seq.blocks.push_back(impl_->Allocate());
+    }
+    seq.tokens.push_back(token);
+    if (++seq.length % block_size == 0) {
+      impl_->SealLastBlock(&seq);
+    }
+  }
+  return true;
+}
+
+void PagedKVCacheManager::TruncateSequence(int64_t seq_id, int64_t length) {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  auto& seq = impl_->Find(seq_id);
+  PADDLE_ENFORCE_EQ(length >= 0 && length <= seq.length,
+                    true,
+                    common::errors::OutOfRange(
+                        "The sequence %d of %d tokens cannot be truncated to "
+                        "%d tokens.",
+                        seq_id,
+                        seq.length,
+                        length));
+  const int block_size = impl_->block_size;
+  const size_t block_num = (length + block_size - 1) / block_size;
+  while (seq.blocks.size() > block_num) {
+    impl_->Release(seq.blocks.back());
+    seq.blocks.pop_back();
+  }
+  const int64_t full_blocks = length / block_size;
+  if (full_blocks < seq.length / block_size) {
+    seq.hash = 0;
+    for (int64_t i = 0; i < full_blocks; ++i) {
+      seq.hash = Impl::HashBlock(
+          seq.hash,
+          std::vector<int64_t>(seq.tokens.begin() + i * block_size,
+                               seq.tokens.begin() + (i + 1) * block_size));
+    }
+  }
+  seq.tokens.resize(length);
+  seq.length = length;
+
+  // The last block is written again from the new length. A shared one is
+  // copied by the next append, one used by this sequence alone leaves the
+  // prefix cache.
+  if (length % block_size != 0) {
+    auto& block = impl_->blocks[seq.blocks.back()];
+    if (block.cached && block.ref_count == 1) {
+      impl_->cached_blocks.erase(block.hash);
+      block.cached = false;
+    }
+  }
+}
+
+void PagedKVCacheManager::ForkSequence(int64_t parent_seq_id,
+                                       int64_t child_seq_id) {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  PADDLE_ENFORCE_EQ(impl_->sequences.count(child_seq_id),
+                    0UL,
+                    common::errors::AlreadyExists(
+                        "The sequence %d already exists.", child_seq_id));
+  Impl::Sequence child = impl_->Find(parent_seq_id);
+  for (int id : child.blocks) {
+    impl_->AddRef(id);
+  }
+  impl_->sequences.emplace(child_seq_id, std::move(child));
+}
+
+void PagedKVCacheManager::FreeSequence(int64_t seq_id) {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  auto& seq = impl_->Find(seq_id);
+  // Release the later blocks first, so that the prefix cache evicts them
+  // before the earlier blocks they depend on.
+  for (auto it = seq.blocks.rbegin(); it != seq.blocks.rend(); ++it) {
+    impl_->Release(*it);
+  }
+  impl_->sequences.erase(seq_id);
+}
+
+int64_t PagedKVCacheManager::SequenceLength(int64_t seq_id) const {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  return impl_->Find(seq_id).length;
+}
+
+std::vector<int> PagedKVCacheManager::BlockTable(int64_t seq_id) const {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  return impl_->Find(seq_id).blocks;
+}
+
+void PagedKVCacheManager::FillBlockTables(const std::vector<int64_t>& seq_ids,
+                                          Tensor* block_tables) const {
+  std::vector<int32_t> tables(seq_ids.size() * impl_->max_blocks_per_seq, -1);
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    for (size_t i = 0; i < seq_ids.size(); ++i) {
+      const auto& blocks = impl_->Find(seq_ids[i]).blocks;
+      std::copy(blocks.begin(),
+                blocks.end(),
+                tables.begin() + i * impl_->max_blocks_per_seq);
+    }
+  }
+  block_tables->Reshape({static_cast<int>(seq_ids.size()),
+                         impl_->max_blocks_per_seq});
+  block_tables->CopyFromCpu(tables.data());
+}
+
+std::vector<std::pair<int, int>> PagedKVCacheManager::TakeBlockCopies() {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  std::vector<std::pair<int, int>> copies;
+  copies.swap(impl_->block_copies);
+  return copies;
+}
+
+void PagedKVCacheManager::CopyBlocks(
+    const std::vector<std::pair<int, int>>& copies,
+    Tensor* cache,
+    void* exec_stream) {
+  if (copies.empty()) return;
+  auto shape = cache->shape();
+  PADDLE_ENFORCE_GE(shape.size(),
+                    1UL,
+                    common::errors::InvalidArgument(
+                        "The kv cache should have a block dimension."));
+  PlaceType place;
+  int numel = 0;
+  char* data = nullptr;
+  size_t elem_bytes = 0;
+  switch (cache->type()) {
+    case DataType::FLOAT32:
+      data = reinterpret_cast<char*>(cache->data<float>(&place, &numel));
+      elem_bytes = sizeof(float);
+      break;
+    case DataType::FLOAT16:
+      data = reinterpret_cast<char*>(
+          cache->data<phi::dtype::float16>(&place, &numel));
+      elem_bytes = sizeof(phi::dtype::float16);
+      break;
+    case DataType::BFLOAT16:
+      data = reinterpret_cast<char*>(
+          cache->data<phi::dtype::bfloat16>(&place, &numel));
+      elem_bytes = sizeof(phi::dtype::bfloat16);
+      break;
+    case DataType::INT8:
+      data = reinterpret_cast<char*>(cache->data<int8_t>(&place, &numel));
+      elem_bytes = sizeof(int8_t);
+      break;
+    case DataType::UINT8:
+      data = reinterpret_cast<char*>(cache->data<uint8_t>(&place, &numel));
+      elem_bytes = sizeof(uint8_t);
+      break;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "Unsupported kv cache data type %d.",
+          static_cast<int>(cache->type())));
+  }
+  const size_t block_bytes = static_cast<size_t>(numel) / shape[0] * elem_bytes;
+  for (const auto& copy : copies) {
+    PADDLE_ENFORCE_EQ(
+        copy.first >= 0 && copy.first < shape[0] && copy.second >= 0 &&
+            copy.second < shape[0],
+        true,
+        common::errors::OutOfRange("The block copy %d -> %d is out of the %d "
+                                   "blocks of the kv cache.",
+                                   copy.first,
+                                   copy.second,
+                                   shape[0]));
+    char* src = data + copy.first * block_bytes;
+    char* dst = data + copy.second * block_bytes;
+    if (place == PlaceType::kCPU) {
+      std::memcpy(dst, src, block_bytes);
+    } else if (place == PlaceType::kGPU) {
+#if defined(PADDLE_WITH_CUDA)
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaMemcpyAsync(dst,
+                          src,
+                          block_bytes,
+                          cudaMemcpyDeviceToDevice,
+                          static_cast<cudaStream_t>(exec_stream)));
+#else
+      PADDLE_THROW(common::errors::Unavailable(
+          "Paddle is not compiled with CUDA, the GPU kv cache cannot be "
+          "copied."));
+#endif
+    } else {
+      PADDLE_THROW(common::errors::Unimplemented(
+          "CopyBlocks only support PlaceType kCPU/kGPU now."));
+    }
+  }
+}
+
+struct DynamicBatcher::Impl {
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr int kQueueTimeBuckets = 32;
+
+  struct Request {
+    // Sorted by name.
+    std::vector<paddle::PaddleTensor> inputs;
+    int64_t rows;
+    Clock::time_point enqueue_time;
+    std::promise<std::vector<paddle::PaddleTensor>> promise;
+  };
+
+  // The requests which can be batched together.
+  struct Queue {
+    std::deque<Request> requests;
+    int64_t rows = 0;
+  };
+
+  explicit Impl(const Options& options) : options(options) { ResetStats(); }
+
+  void ResetStats() {
+    stats = Stats();
+    stats.queue_time_us_histogram.assign(kQueueTimeBuckets, 0);
+    stats.batch_size_histogram.assign(options.max_batch_size + 1, 0);
+  }
+
+  int SeqLenBucket(int seq_len) const {
+    const auto& buckets = options.seq_len_buckets;
+    return static_cast<int>(
+        std::lower_bound(buckets.begin(), buckets.end(), seq_len) -
+        buckets.begin());
+  }
+
+  // The requests with the same key can be concatenated along dimension 0.
+  std::string BatchKey(const std::vector<paddle::PaddleTensor>& inputs) const {
+    std::ostringstream key;
+    if (options.pad_seq_dim && inputs[0].shape.size() >= 2) {
+      key << "bucket" << SeqLenBucket(inputs[0].shape[1]) << ";";
+    }
+    for (const auto& input : inputs) {
+      key << input.name << ":" << static_cast<int>(input.dtype);
+      const size_t padded_dim = options.pad_seq_dim ? 1 : 0;
+      for (size_t i = 1; i < input.shape.size(); ++i) {
+        key << "," << (i == padded_dim ? -1 : input.shape[i]);
+      }
+      key << ";";
+    }
+    return key.str();
+  }
+
+  // Wait for a batch and take it, or return false when the batcher stops
+  // and all the requests are taken.
+  bool TakeBatch(std::unique_lock<std::mutex>* lock,
+                 std::vector<Request>* batch) {
+    while (true) {
+      const auto now = Clock::now();
+      const auto max_delay = std::chrono::microseconds(options.max_delay_us);
+      auto ready = queues.end();
+      auto next_deadline = Clock::time_point::max();
+      for (auto it = queues.begin(); it != queues.end(); ++it) {
+        const auto& head = it->second.requests.front();
+        if (stop || it->second.rows >= options.max_batch_size ||
+            head.enqueue_time + max_delay <= now) {
+          if (ready == queues.end() ||
+              head.enqueue_time <
+                  ready->second.requests.front().enqueue_time) {
+            ready = it;
+          }
+        } else {
+          next_deadline =
+              std::min(next_deadline, head.enqueue_time + max_delay);
+        }
+      }
+
+      if (ready != queues.end()) {
+        auto& queue = ready->second;
+        int64_t rows = 0;
+        while (!queue.requests.empty() &&
+               (batch->empty() || rows + queue.requests.front().rows <=
+                                      options.max_batch_size)) {
+          rows += queue.requests.front().rows;
+          queue.rows -= queue.requests.front().rows;
+          batch->push_back(std::move(queue.requests.front()));
+          queue.requests.pop_front();
+        }
+        if (queue.requests.empty()) {
+          queues.erase(ready);
+        }
+        RecordBatch(*batch, rows, now);
+        // Another batch may be ready for the other predictors.
+        if (!queues.empty()) {
+          cv.notify_one();
+        }
+        return true;
+      }
+      if (stop) {
+        return false;
+      }
+      if (next_deadline == Clock::time_point::max()) {
+        cv.wait(*lock);
+      } else {
+        cv.wait_until(*lock, next_deadline);
+      }
+    }
+  }
+
+  void RecordBatch(const std::vector<Request>& batch,
+                   int64_t rows,
+                   Clock::time_point now) {
+    for (const auto& request : batch) {
+      auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    now - request.enqueue_time)
+                    .count();
+      int bucket = 0;
+      while (us > 0 && bucket < kQueueTimeBuckets - 1) {
+        us >>= 1;
+        ++bucket;
+      }
+      ++stats.queue_time_us_histogram[bucket];
+    }
+    const int64_t size_bucket =
+        std::min<int64_t>(rows, options.max_batch_size + 1) - 1;
+    ++stats.batch_size_histogram[size_bucket];
+    stats.num_requests += static_cast<int64_t>(batch.size());
+    ++stats.num_batches;
+  }
+
+  // Concatenate the i-th input of the requests into a host buffer, padding
+  // dimension 1 if needed.
+  std::vector<int> ConcatInput(const std::vector<Request>& batch,
+                               size_t i,
+                               std::vector<char>* buffer) const {
+    const auto& first = batch[0].inputs[i];
+    std::vector<int> shape = first.shape;
+    shape[0] = 0;
+    for (const auto& request : batch) {
+      shape[0] += request.inputs[i].shape[0];
+      if (shape.size() >= 2) {
+        shape[1] = std::max(shape[1], request.inputs[i].shape[1]);
+      }
+    }
+    int64_t inner = 1;
+    for (size_t d = 2; d < shape.size(); ++d) {
+      inner *= shape[d];
+    }
+    const size_t elem_bytes = DataTypeBytes(first.dtype);
+    const int64_t seq_len = shape.size() >= 2 ? shape[1] : 1;
+    const int64_t numel = shape[0] * seq_len * inner;
+    buffer->resize(numel * elem_bytes);
+
+    bool padded = false;
+    for (const auto& request : batch) {
+      padded |= shape.size() >= 2 && request.inputs[i].shape[1] != shape[1];
+    }
+    if (padded) {
+      VisitDataType(first.dtype, [&](auto* type_ptr) {
+        using T = std::remove_pointer_t<decltype(type_ptr)>;
+        std::fill_n(reinterpret_cast<T*>(buffer->data()),
+                    numel,
+                    static_cast<T>(options.pad_value));
+      });
+    }
+
+    const size_t dst_row_bytes = seq_len * inner * elem_bytes;
+    char* dst = buffer->data();
+    for (const auto& request : batch) {
+      const auto& input = request.inputs[i];
+      const char* src = static_cast<const char*>(input.data.data());
+      const size_t src_row_bytes =
+          (input.shape.size() >= 2 ? input.shape[1] : 1) * inner * elem_bytes;
+      for (int r = 0; r < input.shape[0]; ++r) {
+        std::memcpy(dst, src, src_row_bytes);
+        dst += dst_row_bytes;
+        src += src_row_bytes;
+      }
+    }
+    return shape;
+  }
+
+  void RunBatch(Predictor* predictor, std::vector<Request>* batch) {
+    try {
+      std::vector<char> buffer;
+      for (size_t i = 0; i < (*batch)[0].inputs.size(); ++i) {
+        auto shape = ConcatInput(*batch, i, &buffer);
+        auto tensor = predictor->GetInputHandle((*batch)[0].inputs[i].name);
+        tensor->Reshape(shape);
+        VisitDataType((*batch)[0].inputs[i].dtype, [&](auto* type_ptr) {
+          using T = std::remove_pointer_t<decltype(type_ptr)>;
+          tensor->CopyFromCpu(reinterpret_cast<const T*>(buffer.data()));
+        });
+      }
+      PADDLE_ENFORCE_EQ(predictor->Run(),
+                        true,
+                        common::errors::Fatal(
+                            "The predictor failed to run the batch of %d "
+                            "requests.",
+                            batch->size()));
+
+      int64_t rows = 0;
+      for (const auto& request : *batch) {
+        rows += request.rows;
+      }
+      std::vector<std::vector<paddle::PaddleTensor>> outputs(batch->size());
+      for (const auto& name : predictor->GetOutputNames()) {
+        auto tensor = predictor->GetOutputHandle(name);
+        auto shape = tensor->shape();
+        PADDLE_ENFORCE_EQ(
+            !shape.empty() && shape[0] == rows,
+            true,
+            common::errors::PreconditionNotMet(
+                "The output %s of a batch of %d rows should have %d rows "
+                "in dimension 0 to be split to the requests.",
+                name,
+                rows,
+                rows));
+        const DataType dtype = tensor->type();
+        int64_t numel = 1;
+        for (auto dim : shape) {
+          numel *= dim;
+        }
+        buffer.resize(numel * DataTypeBytes(dtype));
+        VisitDataType(dtype, [&](auto* type_ptr) {
+          using T = std::remove_pointer_t<decltype(type_ptr)>;
+          tensor->CopyToCpu(reinterpret_cast<T*>(buffer.data()));
+        });
+
+        const size_t row_bytes = buffer.size() / rows;
+        size_t offset = 0;
+        for (size_t j = 0; j < batch->size(); ++j) {
+          paddle::PaddleTensor output;
+          output.name = name;
+          output.shape = shape;
+          output.shape[0] = static_cast<int>((*batch)[j].rows);
+          output.dtype = dtype;
+          output.data.Resize((*batch)[j].rows * row_bytes);
+          std::memcpy(output.data.data(),
+                      buffer.data() + offset,
+                      output.data.length());
+          offset += output.data.length();
+          outputs[j].push_back(std::move(output));
+        }
+      }
+      for (size_t j = 0; j < batch->size(); ++j) {
+        (*batch)[j].promise.set_value(std::move(outputs[j]));
+      }
+    } catch (...) {
+      for (auto& request : *batch) {
+        request.promise.set_exception(std::current_exception());
+      }
+    }
+  }
+
+  void WorkerLoop(Predictor* predictor) {
+    while (true) {
+      std::vector<Request> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!TakeBatch(&lock, &batch)) {
+          return;
+        }
+      }
+      RunBatch(predictor, &batch);
+    }
+  }
+
+  Options options;
+  std::map<std::string, Queue> queues;
+  Stats stats;
+  bool stop = false;
+  std::vector<std::thread> workers;
+  mutable std::mutex mutex;
+  std::condition_variable cv;
+};
+
+DynamicBatcher::DynamicBatcher(services::PredictorPool* pool,
+                               size_t num_predictors,
+                               const Options& options) {
+  PADDLE_ENFORCE_NOT_NULL(
+      pool,
+      common::errors::InvalidArgument(
+          "The predictor pool of the dynamic batcher should not be null."));
+  PADDLE_ENFORCE_EQ(num_predictors > 0 && options.max_batch_size > 0 &&
+                        options.max_delay_us >= 0,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The dynamic batcher needs positive num_predictors "
+                        "and max_batch_size and non-negative max_delay_us, "
+                        "but received %d, %d and %d.",
+                        num_predictors,
+                        options.max_batch_size,
+                        options.max_delay_us));
+  PADDLE_ENFORCE_EQ(std::is_sorted(options.seq_len_buckets.begin(),
+                                   options.seq_len_buckets.end()),
+                    true,
+                    common::errors::InvalidArgument(
+                        "The seq_len_buckets should be in ascending order."));
+  impl_ = std::make_unique<Impl>(options);
+  for (size_t i = 0; i < num_predictors; ++i) {
+    impl_->workers.emplace_back(
+        &Impl::WorkerLoop, impl_.get(), pool->Retrieve(i));
+  }
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    impl_->stop = true;
+  }
+  impl_->cv.notify_all();
+  for (auto& worker : impl_->workers) {
+    worker.join();
+  }
+}
+
+std::future<std::vector<paddle::PaddleTensor>> DynamicBatcher::Submit(
+    std::vector<paddle::PaddleTensor> inputs) {
+  PADDLE_ENFORCE_EQ(
+      inputs.empty(),
+      false,
+      common::errors::InvalidArgument("The request has no input tensor."));
+  std::sort(inputs.begin(),
+            inputs.end(),
+            [](const paddle::PaddleTensor& a, const paddle::PaddleTensor& b) {
+              return a.name < b.name;
+            });
+  const int rows = inputs[0].shape.empty() ? 0 : inputs[0].shape[0];
+  for (const auto& input : inputs) {
+    PADDLE_ENFORCE_EQ(!input.shape.empty() && input.shape[0] == rows &&
+                          rows > 0,
+                      true,
+                      common::errors::InvalidArgument(
+                          "All the inputs of a request should have the same "
+                          "positive batch size in dimension 0, but the input "
+                          "%s does not.",
+                          input.name));
+    int64_t numel = 1;
+    for (auto dim : input.shape) {
+      numel *= dim;
+    }
+    PADDLE_ENFORCE_EQ(
+        input.data.length(),
+        numel * DataTypeBytes(input.dtype),
+        common::errors::InvalidArgument(
+            "The data of the input %s does not match its shape.", input.name));
+  }
+
+  Impl::Request request;
+  request.rows = rows;
+  auto future = request.promise.get_future();
+  const std::string key = impl_->BatchKey(inputs);
+  request.inputs = std::move(inputs);
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    PADDLE_ENFORCE_EQ(impl_->stop,
+                      false,
+                      common::errors::PreconditionNotMet(
+                          "The dynamic batcher has been stopped."));
+    request.enqueue_time = Impl::Clock::now();
+    auto& queue = impl_->queues[key];
+    queue.rows += rows;
+    queue.requests.push_back(std::move(request));
+  }
+  impl_->cv.notify_one();
+  return future;
+}
+
+DynamicBatcher::Stats DynamicBatcher::GetStats() const {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  return impl_->stats;
+}
+
+void DynamicBatcher::ResetStats() {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  impl_->ResetStats();
+}
+
+
+struct GenerationEngine::Impl {
+  struct Sequence {
+    int64_t id;
+    // The prompt and the generated tokens. While the sequence runs, the
+    // keys and values of all of them but the last are in the target cache.
+    std::vector<int64_t> tokens;
+    size_t prompt_len;
+    int max_new_tokens;
+    bool running = false;
+    // The number of tokens in the draft cache, -1 when not added to it.
+    int64_t draft_len = -1;
+    std::promise<std::vector<int64_t>> promise;
+  };
+  using SequencePtr = std::shared_ptr<Sequence>;
+
+  Impl(StepRunner target,
+       PagedKVCacheManager* target_cache,
+       const Options& options,
+       StepRunner draft,
+       PagedKVCacheManager* draft_cache)
+      : target(std::move(target)),
+        target_cache(target_cache),
+        options(options),
+        draft(std::move(draft)),
+        draft_cache(draft_cache) {}
+
+  static int64_t MaxLen(const PagedKVCacheManager* cache) {
+    return static_cast<int64_t>(cache->max_blocks_per_seq()) *
+           cache->block_size();
+  }
+
+  static void AddInput(const Sequence& seq,
+                       const std::vector<int64_t>& tokens,
+                       int64_t cached_len,
+                       bool prefill,
+                       int output_len,
+                       StepInputs* inputs) {
+    inputs->seq_ids.push_back(seq.id);
+    inputs->token_ids.insert(
+        inputs->token_ids.end(), tokens.begin(), tokens.end());
+    inputs->seq_lens_this_time.push_back(static_cast<int>(tokens.size()));
+    inputs->seq_lens_encoder.push_back(
+        prefill ? static_cast<int>(tokens.size()) : 0);
+    inputs->seq_lens_decoder.push_back(static_cast<int>(cached_len));
+    inputs->output_lens.push_back(output_len);
+  }
+
+  // Adds all the tokens of the sequence to cache, and returns the number of
+  // leading ones whose keys and values are cached, or -1 when there are not
+  // enough blocks. The last token is always left to run for its next token.
+  static int64_t AddSequence(PagedKVCacheManager* cache, const Sequence& seq) {
+    const int64_t len = static_cast<int64_t>(seq.tokens.size());
+    const int64_t cached = cache->AddSequence(seq.id, seq.tokens);
+    if (cached < len) return cached;
+    cache->TruncateSequence(seq.id, len - 1);
+    if (!cache->AppendTokens(seq.id, {seq.tokens.back()})) {
+      cache->FreeSequence(seq.id);
+      return -1;
+    }
+    return len - 1;
+  }
+
+  static std::exception_ptr NoBlocksError(const Sequence& seq) {
+    return std::make_exception_ptr(common::enforce::EnforceNotMet(
+        common::errors::ResourceExhausted(
+            "The paged kv cache cannot hold the sequence %d of %d tokens.",
+            seq.id,
+            seq.tokens.size()),
+        __FILE__,
+        __LINE__));
+  }
+
+  void Finish(Sequence* seq, std::exception_ptr error = nullptr) {
+    target_cache->FreeSequence(seq->id);
+    if (seq->draft_len >= 0) {
+      draft_cache->FreeSequence(seq->id);
+    }
+    seq->running = false;
+    running.erase(std::find_if(
+        running.begin(), running.end(), [seq](const SequencePtr& other) {
+          return other.get() == seq;
+        }));
+    if (error) {
+      seq->promise.set_exception(error);
+    } else {
+      seq->promise.set_value(std::vector<int64_t>(
+          seq->tokens.begin() + seq->prompt_len, seq->tokens.end()));
+    }
+  }
+
+  // Frees the blocks of the sequence admitted last and queues it to be
+  // prefilled again, or fails it when it runs alone and still does not fit.
+  void PreemptLast() {
+    auto seq = running.back();
+    if (running.size() == 1) {
+      Finish(seq.get(), NoBlocksError(*seq));
+      return;
+    }
+    target_cache->FreeSequence(seq->id);
+    if (seq->draft_len >= 0) {
+      draft_cache->FreeSequence(seq->id);
+      seq->draft_len = -1;
+    }
+    seq->running = false;
+    running.pop_back();
+    std::lock_guard<std::mutex> guard(mutex);
+    waiting.push_front(seq);
+    ++stats.num_preemptions;
+    VLOG(4) << "Preempt the sequence " << seq->id << " of "
+            << seq->tokens.size() << " tokens";
+  }
+
+  // Calls reserve until it succeeds, preempting a sequence after each
+  // failure. Returns false when seq itself is preempted.
+  bool Reserve(const Sequence& seq, const std::function<bool()>& reserve) {
+    while (!reserve()) {
+      bool self = running.back().get() == &seq;
+      PreemptLast();
+      if (self) return false;
+    }
+    return true;
+  }
+
+  // Runs a step and checks the number of its outputs. On error, the
+  // sequences of the step fail.
+  bool Run(const StepRunner& runner,
+           PagedKVCacheManager* cache,
+           const StepInputs& inputs,
+           const std::vector<SequencePtr>& batch,
+           std::vector<int64_t>* outputs) {
+    try {
+      *outputs = runner(inputs, cache);
+      size_t num_outputs = 0;
+      for (int len : inputs.output_lens) {
+        num_outputs += len;
+      }
+      PADDLE_ENFORCE_EQ(outputs->size(),
+                        num_outputs,
+                        common::errors::PreconditionNotMet(
+                            "The step runner returned %d tokens, but %d are "
+                            "expected.",
+                            outputs->size(),
+                            num_outputs));
+    } catch (...) {
+      auto error = std::current_exception();
+      for (const auto& seq : batch) {
+        if (seq->running) Finish(seq.get(), error);
+      }
+      return false;
+    }
+    return true;
+  }
+
+  // Appends the new tokens to the sequence, and finishes it when it ends.
+  void Accept(Sequence* seq, const std::vector<int64_t>& tokens) {
+    for (auto token : tokens) {
+      seq->tokens.push_back(token);
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        ++stats.num_generated_tokens;
+      }
+      const int64_t generated =
+          static_cast<int64_t>(seq->tokens.size() - seq->prompt_len);
+      if ((options.eos_token_id >= 0 && token == options.eos_token_id) ||
+          generated >= seq->max_new_tokens ||
+          static_cast<int64_t>(seq->tokens.size()) > MaxLen(target_cache)) {
+        Finish(seq);
+        return;
+      }
+    }
+  }
+
+  // The number of tokens the draft proposes for the sequence, within the
+  // block tables of both caches.
+  int SpeculativeLen(const Sequence& seq) const {
+    if (!draft) return 0;
+    const int64_t len = static_cast<int64_t>(seq.tokens.size());
+    int64_t spec_len = std::min<int64_t>(options.num_speculative_tokens,
+                                         MaxLen(target_cache) - len);
+    spec_len = std::min(spec_len, MaxLen(draft_cache) - len + 1);
+    return static_cast<int>(std::max<int64_t>(spec_len, 0));
+  }
+
+  // Admits the waiting sequences and runs their prompts. Returns false when
+  // no sequence is admitted.
+  bool Prefill() {
+    StepInputs inputs;
+    std::vector<SequencePtr> batch;
+    int64_t num_tokens = 0;
+    while (running.size() < static_cast<size_t>(options.max_batch_size)) {
+      SequencePtr seq;
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (waiting.empty()) break;
+        const int64_t len =
+            static_cast<int64_t>(waiting.front()->tokens.size());
+        if (!batch.empty() && num_tokens + len > options.max_prefill_tokens) {
+          break;
+        }
+        // Leave a block for the next token of every running sequence.
+        const int64_t block_num =
+            (len + target_cache->block_size() - 1) / target_cache->block_size();
+        if (!running.empty() && target_cache->NumAvailableBlocks() - block_num <
+                                    static_cast<int64_t>(running.size())) {
+          break;
+        }
+        seq = waiting.front();
+        waiting.pop_front();
+      }
+      const int64_t cached_len = AddSequence(target_cache, *seq);
+      if (cached_len < 0) {
+        if (running.empty()) {
+          seq->promise.set_exception(NoBlocksError(*seq));
+          continue;
+        }
+        std::lock_guard<std::mutex> guard(mutex);
+        waiting.push_front(seq);
+        break;
+      }
+      std::vector<int64_t> tokens(seq->tokens.begin() + cached_len,
+                                  seq->tokens.end());
+      AddInput(*seq, tokens, cached_len, true, 1, &inputs);
+      num_tokens += static_cast<int64_t>(tokens.size());
+      seq->running = true;
+      running.push_back(seq);
+      batch.push_back(seq);
+    }
+    if (batch.empty()) return false;
+
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      ++stats.num_prefill_steps;
+    }
+    std::vector<int64_t> outputs;
+    if (!Run(target, target_cache, inputs, batch, &outputs)) return true;
+    for (size_t i = 0; i < batch.size(); ++i) {
+      Accept(batch[i].get(), {outputs[i]});
+    }
+    return true;
+  }
+
+  // Lets the draft propose the tokens of the running sequences.
+  std::unordered_map<int64_t, std::vector<int64_t>> Propose() {
+    std::unordered_map<int64_t, std::vector<int64_t>> proposals;
+    for (int step = 0; step < options.num_speculative_tokens; ++step) {
+      StepInputs inputs;
+      std::vector<SequencePtr> batch;
+      const auto sequences = running;
+      for (const auto& seq : sequences) {
+        if (!seq->running || step >= SpeculativeLen(*seq)) continue;
+        auto& proposal = proposals[seq->id];
+        if (step > 0) {
+          if (!Reserve(*seq, [&] {
+                return draft_cache->AppendTokens(seq->id, {proposal.back()});
+              })) {
+            continue;
+          }
+          AddInput(*seq, {proposal.back()}, seq->draft_len, false, 1, &inputs);
+          ++seq->draft_len;
+        } else if (seq->draft_len < 0) {
+          // The draft starts with the prompt and the tokens so far.
+          int64_t cached_len = -1;
+          if (!Reserve(*seq, [&] {
+                cached_len = AddSequence(draft_cache, *seq);
+                return cached_len >= 0;
+              })) {
+            continue;
+          }
+          AddInput(*seq,
+                   std::vector<int64_t>(seq->tokens.begin() + cached_len,
+                                        seq->tokens.end()),
+                   cached_len,
+                   true,
+                   1,
+                   &inputs);
+          seq->draft_len = static_cast<int64_t>(seq->tokens.size());
+        } else {
+          // The draft catches up with the tokens the target accepted.
+          std::vector<int64_t> tokens(seq->tokens.begin() + seq->draft_len,
+                                      seq->tokens.end());
+          if (!Reserve(*seq, [&] {
+                return draft_cache->AppendTokens(seq->id, tokens);
+              })) {
+            continue;
+          }
+          AddInput(*seq, tokens, seq->draft_len, false, 1, &inputs);
+          seq->draft_len = static_cast<int64_t>(seq->tokens.size());
+        }
+        batch.push_back(seq);
+      }
+      if (batch.empty()) break;
+
+      std::vector<int64_t> outputs;
+      if (!Run(draft, draft_cache, inputs, batch, &outputs)) continue;
+      for (size_t i = 0; i < batch.size(); ++i) {
+        if (batch[i]->running) {
+          proposals[batch[i]->id].push_back(outputs[i]);
+        }
+      }
+    }
+    return proposals;
+  }
+
+  // Decodes the running sequences, verifying the proposals of the draft.
+  void Decode() {
+    auto proposals = Propose();
+    StepInputs inputs;
+    std::vector<SequencePtr> batch;
+    const auto sequences = running;
+    for (const auto& seq : sequences) {
+      if (!seq->running) continue;
+      std::vector<int64_t> tokens = {seq->tokens.back()};
+      auto it = proposals.find(seq->id);
+      if (it != proposals.end()) {
+        tokens.insert(tokens.end(), it->second.begin(), it->second.end());
+      }
+      if (!Reserve(*seq, [&] {
+            return target_cache->AppendTokens(seq->id, tokens);
+          })) {
+        continue;
+      }
+      AddInput(*seq,
+               tokens,
+               static_cast<int64_t>(seq->tokens.size()) - 1,
+               false,
+               static_cast<int>(tokens.size()),
+               &inputs);
+      batch.push_back(seq);
+    }
+    if (batch.empty()) return;
+
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      ++stats.num_decode_steps;
+    }
+    std::vector<int64_t> outputs;
+    if (!Run(target, target_cache, inputs, batch, &outputs)) return;
+    size_t offset = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+      auto* seq = batch[i].get();
+      const int output_len = inputs.output_lens[i];
+      const int64_t* next = outputs.data() + offset;
+      offset += output_len;
+      // The target accepts the proposals up to the first one it disagrees
+      // with, then gives its own token.
+      int accepted = 0;
+      const auto it = proposals.find(seq->id);
+      while (it != proposals.end() && accepted < output_len - 1 &&
+             it->second[accepted] == next[accepted]) {
+        ++accepted;
+      }
+      const int64_t len = static_cast<int64_t>(seq->tokens.size());
+      if (accepted < output_len - 1) {
+        target_cache->TruncateSequence(seq->id, len + accepted);
+      }
+      if (seq->draft_len > len + accepted) {
+        draft_cache->TruncateSequence(seq->id, len + accepted);
+        seq->draft_len = len + accepted;
+      }
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        stats.num_draft_tokens += output_len - 1;
+        stats.num_accepted_draft_tokens += accepted;
+      }
+      std::vector<int64_t> tokens(next, next + accepted + 1);
+      Accept(seq, tokens);
+    }
+  }
+
+  void Loop() {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] {
+          return stop || !waiting.empty() || !running.empty();
+        });
+        if (stop && waiting.empty() && running.empty()) return;
+      }
+      if (!Prefill()) {
+        Decode();
+      }
+    }
+  }
+
+  StepRunner target;
+  PagedKVCacheManager* target_cache;
+  Options options;
+  StepRunner draft;
+  PagedKVCacheManager* draft_cache;
+  // The sequences in the caches, in the order they are admitted. Only used
+  // by the thread.
+  std::vector<SequencePtr> running;
+  std::deque<SequencePtr> waiting;
+  int64_t next_seq_id = 0;
+  Stats stats;
+  bool stop = false;
+  std::thread thread;
+  mutable std::mutex mutex;
+  std::condition_variable cv;
+};
+
+GenerationEngine::StepRunner GenerationEngine::PredictorRunner(
+    Predictor* predictor, const PredictorRunnerOptions& options) {
+  PADDLE_ENFORCE_NOT_NULL(
+      predictor,
+      common::errors::InvalidArgument(
+          "The predictor of the step runner should not be null."));
+  return [predictor, options](const StepInputs& inputs,
+                              PagedKVCacheManager* cache) {
+    const int batch = static_cast<int>(inputs.seq_ids.size());
+    int max_len = 0;
+    for (int len : inputs.seq_lens_this_time) {
+      max_len = std::max(max_len, len);
+    }
+    std::vector<int64_t> input_ids(static_cast<size_t>(batch) * max_len,
+                                   options.pad_token_id);
+    size_t offset = 0;
+    for (int i = 0; i < batch; ++i) {
+      std::copy_n(inputs.token_ids.begin() + offset,
+                  inputs.seq_lens_this_time[i],
+                  input_ids.begin() + static_cast<size_t>(i) * max_len);
+      offset += inputs.seq_lens_this_time[i];
+    }
+    auto input_ids_tensor = predictor->GetInputHandle(options.input_ids_name);
+    input_ids_tensor->Reshape({batch, max_len});
+    input_ids_tensor->CopyFromCpu(input_ids.data());
+    auto set_lens = [&](const std::string& name, const std::vector<int>& lens) {
+      auto tensor = predictor->GetInputHandle(name);
+      tensor->Reshape({batch, 1});
+      tensor->CopyFromCpu(lens.data());
+    };
+    set_lens(options.seq_lens_this_time_name, inputs.seq_lens_this_time);
+    set_lens(options.seq_lens_encoder_name, inputs.seq_lens_encoder);
+    set_lens(options.seq_lens_decoder_name, inputs.seq_lens_decoder);
+    auto block_tables = predictor->GetInputHandle(options.block_tables_name);
+    cache->FillBlockTables(inputs.seq_ids, block_tables.get());
+    const auto copies = cache->TakeBlockCopies();
+    for (const auto& name : options.cache_names) {
+      auto tensor = predictor->GetInputHandle(name);
+      PagedKVCacheManager::CopyBlocks(
+          copies, tensor.get(), predictor->GetExecStream());
+    }
+    PADDLE_ENFORCE_EQ(predictor->Run(),
+                      true,
+                      common::errors::Fatal(
+                          "The predictor failed to run a generation step of "
+                          "%d sequences.",
+                          batch));
+
+    auto next_tokens_tensor =
+        predictor->GetOutputHandle(options.next_tokens_name);
+    int64_t numel = 1;
+    for (auto dim : next_tokens_tensor->shape()) {
+      numel *= dim;
+    }
+    std::vector<int64_t> next_tokens(numel);
+    next_tokens_tensor->CopyToCpu(next_tokens.data());
+    if (numel == static_cast<int64_t>(batch) * max_len) {
+      std::vector<int64_t> outputs;
+      for (int i = 0; i < batch; ++i) {
+        for (int pos = inputs.seq_lens_this_time[i] - inputs.output_lens[i];
+             pos < inputs.seq_lens_this_time[i];
+             ++pos) {
+          outputs.push_back(
+              next_tokens[static_cast<size_t>(i) * max_len + pos]);
+        }
+      }
+      return outputs;
+    }
+    PADDLE_ENFORCE_EQ(
+        numel == batch &&
+            std::all_of(inputs.output_lens.begin(),
+                        inputs.output_lens.end(),
+                        [](int len) { return len == 1; }),
+        true,
+        common::errors::PreconditionNotMet(
+            "The output %s should hold the next token after every input "
+            "position, [%d, %d], or after the last ones, [%d], but it has %d "
+            "tokens.",
+            options.next_tokens_name,
+            batch,
+            max_len,
+            batch,
+            numel));
+    return next_tokens;
+  };
+}
+
+GenerationEngine::GenerationEngine(StepRunner target,
+                                   PagedKVCacheManager* target_cache,
+                                   const Options& options,
+                                   StepRunner draft,
+                                   PagedKVCacheManager* draft_cache) {
+  PADDLE_ENFORCE_EQ(target && target_cache != nullptr,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The generation engine needs the target model and "
+                        "its kv cache."));
+  PADDLE_ENFORCE_EQ(!draft || draft_cache != nullptr,
+                    true,
+                    common::errors::InvalidArgument(
+                        "The draft model of the generation engine needs its "
+                        "kv cache."));
+  PADDLE_ENFORCE_EQ(options.max_batch_size > 0 &&
+                        options.max_prefill_tokens > 0 &&
+                        (!draft || options.num_speculative_tokens > 0),
+                    true,
+                    common::errors::InvalidArgument(
+                        "The generation engine needs positive "
+                        "max_batch_size, max_prefill_tokens and, with a draft "
+                        "model, num_speculative_tokens, but received %d, %d "
+                        "and %d.",
+                        options.max_batch_size,
+                        options.max_prefill_tokens,
+                        options.num_speculative_tokens));
+  impl_ = std::make_unique<Impl>(
+      std::move(target), target_cache, options, std::move(draft), draft_cache);
+  impl_->thread = std::thread(&Impl::Loop, impl_.get());
+}
+
+GenerationEngine::~GenerationEngine() {
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    impl_->stop = true;
+  }
+  impl_->cv.notify_all();
+  impl_->thread.join();
+}
+
+std::future<std::vector<int64_t>> GenerationEngine::Submit(
+    std::vector<int64_t> prompt, int max_new_tokens) {
+  const int64_t max_len = Impl::MaxLen(impl_->target_cache);
+  PADDLE_ENFORCE_EQ(
+      !prompt.empty() && static_cast<int64_t>(prompt.size()) <= max_len,
+      true,
+      common::errors::InvalidArgument(
+          "The prompt should have 1 to %d tokens, but received %d.",
+          max_len,
+          prompt.size()));
+  PADDLE_ENFORCE_GT(max_new_tokens,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The max_new_tokens should be positive, but received "
+                        "%d.",
+                        max_new_tokens));
+  auto seq = std::make_shared<Impl::Sequence>();
+  seq->prompt_len = prompt.size();
+  seq->tokens = std::move(prompt);
+  seq->max_new_tokens = max_new_tokens;
+  auto future = seq->promise.get_future();
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    PADDLE_ENFORCE_EQ(impl_->stop,
+                      false,
+                      common::errors::PreconditionNotMet(
+                          "The generation engine has been stopped."));
+    seq->id = impl_->next_seq_id++;
+    impl_->waiting.push_back(std::move(seq));
+  }
+  impl_->cv.notify_one();
+  return future;
+}
+
+GenerationEngine::Stats GenerationEngine::GetStats() const {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  return impl_->stats;
+}
 }  // namespace paddle_infer::contrib
@@ -14,6 +14,12 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "paddle_inference_api.h"  // NOLINT
 
 namespace paddle_infer {
@@ -127,5 +133,397 @@ Status get_status(Func func, Args&&... args) noexcept(
   return Status::OK();
 }
 
+///
+/// \brief A ring of tensor slots in POSIX shared memory, used to pass the
+/// inputs and outputs between a front-end process and the predictor worker
+/// processes without serializing them.
+///
+/// The producer process creates the ring and sends its name to the consumer
+/// process, which opens it with the same slot configuration. The producer
+/// writes a tensor into a free slot and commits it, then the consumer takes
+/// the committed slots in order, binds them to the input tensors of a
+/// predictor with BindTensor, and releases each slot after the run. Outputs
+/// flow back the same way through a second ring.
+///
+/// Slots are handed out with atomic operations in the shared memory, so any
+/// number of producers and consumers may use one ring. Not supported on
+/// Windows.
+///
+class PD_INFER_DECL SharedMemoryTensorRing {
+ public:
+  struct Impl;
+  static constexpr int kMaxRank = 8;
+
+  ///
+  /// \brief Create a ring of slot_num slots, each holding at most slot_bytes
+  /// bytes of tensor data.
+  ///
+  static SharedMemoryTensorRing Create(size_t slot_num, size_t slot_bytes);
+
+  ///
+  /// \brief Open the ring created by another process under its name. The
+  /// name is unlinked when the opener closes the ring, so each ring is
+  /// expected to be opened by one process.
+  ///
+  static SharedMemoryTensorRing Open(const std::string& name,
+                                     size_t slot_num,
+                                     size_t slot_bytes);
+
+  const std::string& name() const;
+  size_t slot_num() const;
+  size_t slot_bytes() const;
+
+  ///
+  /// \brief Take a free slot to write.
+  ///
+  /// \return The index of the slot, or -1 when all the slots are in use.
+  ///
+  int AcquireWriteSlot();
+
+  ///
+  /// \brief Publish the data written to the slot with its shape and type.
+  ///
+  void CommitWriteSlot(int slot,
+                       const std::vector<int>& shape,
+                       DataType dtype);
+
+  ///
+  /// \brief Take the committed slot written earliest.
+  ///
+  /// \return The index of the slot, or -1 when no slot is committed.
+  ///
+  int AcquireReadSlot();
+
+  ///
+  /// \brief Give the slot back to the producers.
+  ///
+  void ReleaseReadSlot(int slot);
+
+  /// \brief The data buffer of the slot, of slot_bytes() bytes.
+  void* SlotData(int slot) const;
+  std::vector<int> SlotShape(int slot) const;
+  DataType SlotType(int slot) const;
+
+  ///
+  /// \brief Share the committed data of the slot with the tensor, without
+  /// copying. The slot must not be released while the tensor uses it.
+  ///
+  void BindTensor(int slot, Tensor* tensor) const;
+
+ private:
+  explicit SharedMemoryTensorRing(std::shared_ptr<Impl> impl);
+
+  std::shared_ptr<Impl> impl_;
+};
+
+///
+/// \brief Manages the paged key/value cache of block_multihead_attention on
+/// the host: a pool of cache blocks, the block table of every sequence,
+/// copy-on-write sharing of blocks between sequences and a prefix cache of
+/// the full blocks.
+///
+/// The key and value caches are [num_blocks, num_heads, block_size,
+/// head_dim] tensors owned by the predictor. Before each run the caller
+/// appends the tokens of the step to their sequences, applies the block
+/// copies the manager asks for with CopyBlocks, and fills the block_tables
+/// input with FillBlockTables.
+///
+/// Sequences forked for beam search share all the blocks of their parent.
+/// The shared last block is copied before a sequence writes to it. The full
+/// blocks of a prompt are looked up by the tokens they and their preceding
+/// blocks hold, so prompts with a common prefix share its blocks. Blocks no
+/// sequence uses stay in the prefix cache until the pool runs out, the least
+/// recently freed being evicted first.
+///
+/// The methods are thread safe.
+///
+class PD_INFER_DECL PagedKVCacheManager {
+ public:
+  struct Impl;
+
+  PagedKVCacheManager(int num_blocks, int block_size, int max_blocks_per_seq);
+
+  int num_blocks() const;
+  int block_size() const;
+  int max_blocks_per_seq() const;
+
+  ///
+  /// \brief The blocks a new sequence can take, free or evictable.
+  ///
+  int NumAvailableBlocks() const;
+
+  ///
+  /// \brief Start a sequence with its prompt, reusing the cached blocks of
+  /// the longest cached prefix of whole blocks.
+  ///
+  /// \return The number of leading prompt tokens whose keys and values are
+  /// already cached, or -1 when there are not enough blocks, in which case
+  /// nothing changes.
+  ///
+  int AddSequence(int64_t seq_id, const std::vector<int64_t>& prompt_tokens);
+
+  ///
+  /// \brief Append the tokens the next run writes for the sequence, taking
+  /// new blocks as needed.
+  ///
+  /// \return False when there are not enough blocks, in which case nothing
+  /// changes and the caller should preempt a sequence.
+  ///
+  bool AppendTokens(int64_t seq_id, const std::vector<int64_t>& tokens);
+
+  ///
+  /// \brief Drop the tokens of the sequence from position length on, such
+  /// as the rejected ones of speculative decoding, giving back the blocks
+  /// they alone took.
+  ///
+  void TruncateSequence(int64_t seq_id, int64_t length);
+
+  ///
+  /// \brief Start child as a copy of parent sharing all its blocks.
+  ///
+  void ForkSequence(int64_t parent_seq_id, int64_t child_seq_id);
+
+  ///
+  /// \brief End the sequence and give its blocks back.
+  ///
+  void FreeSequence(int64_t seq_id);
+
+  int64_t SequenceLength(int64_t seq_id) const;
+  std::vector<int> BlockTable(int64_t seq_id) const;
+
+  ///
+  /// \brief Write the block tables of the sequences into a [seq_ids.size(),
+  /// max_blocks_per_seq] int32 tensor, padded with -1.
+  ///
+  void FillBlockTables(const std::vector<int64_t>& seq_ids,
+                       Tensor* block_tables) const;
+
+  ///
+  /// \brief Take the (source, destination) block copies the copy-on-write
+  /// of the appends asked for since the last call.
+  ///
+  std::vector<std::pair<int, int>> TakeBlockCopies();
+
+  ///
+  /// \brief Copy whole blocks of a [num_blocks, ...] cache tensor on its
+  /// place, on exec_stream when it is on GPU.
+  ///
+  static void CopyBlocks(const std::vector<std::pair<int, int>>& copies,
+                         Tensor* cache,
+                         void* exec_stream = nullptr);
+
+ private:
+  std::shared_ptr<Impl> impl_;
+};
+
+///
+/// \brief Batches the requests of a serving process dynamically and runs
+/// them on the predictors of a PredictorPool.
+///
+/// Each request is a set of host tensors named after the inputs of the
+/// model whose dimension 0 is the batch. Requests are queued and coalesced
+/// until max_batch_size rows are gathered or the oldest of them has waited
+/// max_delay_us, then concatenated along dimension 0 and run once by a free
+/// predictor. The rows of each output go back to the future of its request.
+///
+/// Only the requests whose inputs agree on everything but dimension 0 are
+/// batched together. With pad_seq_dim, dimension 1 of the inputs of rank
+/// >= 2 is padded with pad_value to the longest one in the batch instead,
+/// and the outputs keep the padded length. The requests are then grouped
+/// by their length in dimension 1 of the first input, split at
+/// seq_len_buckets, so that short requests are not padded to long ones.
+///
+/// A request larger than max_batch_size is run alone. Each predictor is
+/// driven by its own thread, and the methods are thread safe.
+///
+class PD_INFER_DECL DynamicBatcher {
+ public:
+  struct Impl;
+
+  struct Options {
+    int max_batch_size = 8;
+    int64_t max_delay_us = 1000;
+    bool pad_seq_dim = false;
+    double pad_value = 0;
+    /// The ascending upper bounds of the sequence length buckets.
+    std::vector<int> seq_len_buckets;
+  };
+
+  ///
+  /// \brief The counts of the requests whose queue time falls in [2^(i-1),
+  /// 2^i) microseconds, bucket 0 for less than 1, and of the batches run
+  /// with i + 1 rows, the last bucket holding the larger ones.
+  ///
+  struct Stats {
+    std::vector<int64_t> queue_time_us_histogram;
+    std::vector<int64_t> batch_size_histogram;
+    int64_t num_requests = 0;
+    int64_t num_batches = 0;
+  };
+
+  ///
+  /// \brief Run the batches on the first num_predictors predictors of pool,
+  /// which must outlive the batcher.
+  ///
+  DynamicBatcher(services::PredictorPool* pool,
+                 size_t num_predictors,
+                 const Options& options);
+  ///
+  /// \brief Run the queued requests, then stop the threads.
+  ///
+  ~DynamicBatcher();
+
+  DynamicBatcher(const DynamicBatcher&) = delete;
+  DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+
+  ///
+  /// \brief Queue a request.
+  ///
+  /// \return The future of the outputs of the request, in the order of
+  /// the output names of the predictor, or of the error of its batch.
+  ///
+  std::future<std::vector<paddle::PaddleTensor>> Submit(
+      std::vector<paddle::PaddleTensor> inputs);
+
+  Stats GetStats() const;
+  void ResetStats();
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+///
+/// \brief Generates the tokens of many prompts with continuous batching on
+/// models keeping their keys and values in the paged cache of a
+/// PagedKVCacheManager, such as the ones built on block_multihead_attention.
+///
+/// The sequences join the batch when there are blocks for them and leave it
+/// as soon as they end, at every step. A step either prefills the waiting
+/// prompts, up to max_prefill_tokens tokens, or decodes the running
+/// sequences, the prefill taking precedence. When the blocks run out, the
+/// sequence admitted last is preempted: its blocks are freed and it waits
+/// to be prefilled again with the tokens it has generated.
+///
+/// With a draft model, a decode step lets the draft propose
+/// num_speculative_tokens tokens one at a time, then verifies them with one
+/// run of the target model over all the sequences. The proposals are
+/// accepted up to the first one the target would not have chosen greedily,
+/// and the target gives one more token, so the output is the greedy
+/// decoding of the target alone.
+///
+/// The models are run by StepRunner callbacks, see PredictorRunner. The
+/// steps are run by a thread of the engine, and the methods are thread
+/// safe. The sequences end with eos_token_id, after max_new_tokens tokens,
+/// or when their block table is full.
+///
+class PD_INFER_DECL GenerationEngine {
+ public:
+  struct Impl;
+
+  struct Options {
+    int max_batch_size = 8;
+    int max_prefill_tokens = 2048;
+    /// Negative for no end token.
+    int64_t eos_token_id = -1;
+    int num_speculative_tokens = 4;
+  };
+
+  ///
+  /// \brief The sequences of one run of a model. seq_lens_this_time[i] new
+  /// tokens of sequence i follow its seq_lens_decoder[i] tokens already in
+  /// the cache, seq_lens_encoder[i] being seq_lens_this_time[i] for a
+  /// prefill and 0 otherwise. token_ids holds the new tokens of all the
+  /// sequences one after another.
+  ///
+  struct StepInputs {
+    std::vector<int64_t> seq_ids;
+    std::vector<int64_t> token_ids;
+    std::vector<int> seq_lens_this_time;
+    std::vector<int> seq_lens_encoder;
+    std::vector<int> seq_lens_decoder;
+    /// The number of last new tokens of each sequence whose next token is
+    /// wanted.
+    std::vector<int> output_lens;
+  };
+
+  ///
+  /// \brief Runs a model over the inputs, whose new tokens have been
+  /// appended to cache, after applying the block copies of cache.
+  ///
+  /// \return The greedy next token after each of the last output_lens[i]
+  /// new tokens of every sequence, one sequence after another.
+  ///
+  using StepRunner = std::function<std::vector<int64_t>(
+      const StepInputs& inputs, PagedKVCacheManager* cache)>;
+
+  struct Stats {
+    int64_t num_prefill_steps = 0;
+    int64_t num_decode_steps = 0;
+    int64_t num_generated_tokens = 0;
+    int64_t num_draft_tokens = 0;
+    int64_t num_accepted_draft_tokens = 0;
+    int64_t num_preemptions = 0;
+  };
+
+  ///
+  /// \brief The names of the tensors of a predictor taking the inputs of a
+  /// step as [batch, max_len] input ids padded with pad_token_id, [batch,
+  /// 1] int32 sequence lengths and the int32 block tables. Its int64 next
+  /// tokens output is [batch, max_len], the greedy next token after every
+  /// input position, or [batch] when only the next token after the last one
+  /// is wanted. The blocks of the cache_names inputs are copied before the
+  /// run.
+  ///
+  struct PredictorRunnerOptions {
+    std::string input_ids_name = "input_ids";
+    std::string seq_lens_this_time_name = "seq_lens_this_time";
+    std::string seq_lens_encoder_name = "seq_lens_encoder";
+    std::string seq_lens_decoder_name = "seq_lens_decoder";
+    std::string block_tables_name = "block_tables";
+    std::vector<std::string> cache_names;
+    std::string next_tokens_name = "next_tokens";
+    int64_t pad_token_id = 0;
+  };
+
+  ///
+  /// \brief Run the steps of the model on predictor, which must outlive
+  /// the runner.
+  ///
+  static StepRunner PredictorRunner(Predictor* predictor,
+                                    const PredictorRunnerOptions& options);
+
+  ///
+  /// \brief Generate with the target model alone, or verify the tokens of
+  /// the draft model when draft is set. The caches must outlive the engine
+  /// and hold no other sequence.
+  ///
+  GenerationEngine(StepRunner target,
+                   PagedKVCacheManager* target_cache,
+                   const Options& options,
+                   StepRunner draft = nullptr,
+                   PagedKVCacheManager* draft_cache = nullptr);
+  ///
+  /// \brief Finish the submitted sequences, then stop the thread.
+  ///
+  ~GenerationEngine();
+
+  GenerationEngine(const GenerationEngine&) = delete;
+  GenerationEngine& operator=(const GenerationEngine&) = delete;
+
+  ///
+  /// \brief Queue a prompt.
+  ///
+  /// \return The future of the generated tokens, or of the error of a run
+  /// of the sequence.
+  ///
+  std::future<std::vector<int64_t>> Submit(std::vector<int64_t> prompt,
+                                           int max_new_tokens);
+
+  Stats GetStats() const;
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
 }  // namespace contrib
 }  // namespace paddle_infer
@@ -22,6 +22,7 @@ limitations under the License. */
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -48,6 +49,7 @@ using PrecisionType = paddle::AnalysisConfig::Precision;
 using Config = paddle::AnalysisConfig;
 using DistConfig = paddle::DistConfig;
 using XpuConfig = paddle::XpuConfig;
+using TraceSpan = paddle::TraceSpan;
 
 ///
 /// \class Predictor
@@ -140,6 +142,18 @@ class PD_INFER_DECL Predictor {
   bool Run(const std::vector<paddle::Tensor>& inputs,
            std::vector<paddle::Tensor>* outputs);
 
+  ///
+  /// \brief Run the prediction engine without waiting for the device. The
+  /// callback is invoked with whether the run is successful in another
+  /// thread when the outputs are ready, and can read them by
+  /// GetOutputHandle. The next run waits for the callback, so the predictor
+  /// must not be run in the callback.
+  ///
+  /// \param[in] callback The function invoked when the run is completed.
+  /// \return Whether the work is enqueued successfully
+  ///
+  bool RunAsync(std::function<void(bool)> callback);
+
   ///
   /// \brief Get the output names
   ///
@@ -203,6 +217,58 @@ class PD_INFER_DECL Predictor {
   /// The same as RegisterOutputHook.
   void RegisterInputHook(const InputTensorHookFunc& hookfunc);
 
+  ///
+  /// \brief Make the trace of the next run a child of the span of the caller.
+  /// Only used when Config::EnableRunTrace is set.
+  ///
+  /// \param trace_id The trace id of the caller, as 32 hex digits.
+  /// \param parent_span_id The span id of the caller, as 16 hex digits.
+  ///
+  void SetTraceParent(const std::string& trace_id,
+                      const std::string& parent_span_id);
+
+  ///
+  /// \brief Get the trace of the last run when Config::EnableRunTrace is set:
+  /// the run, the feed, the execution and the fetch, and every operator,
+  /// TensorRT engine and CINN group of the execution. On GPU it waits for the
+  /// last run to complete on the device.
+  ///
+  /// \return The spans of the last run, the span of the run first.
+  ///
+  std::vector<TraceSpan> GetLastRunTrace();
+
+  ///
+  /// \brief Replace the parameters by the ones of a combined params file, of
+  /// the same names, dims and dtypes, without rebuilding the predictor. The
+  /// runs go on while the file is loaded, the parameters are swapped between
+  /// two runs, for the predictor and its clones. It fails when a parameter
+  /// was transformed by the optimization, e.g. fused, folded or built into a
+  /// TensorRT engine, and the predictor should be rebuilt then.
+  ///
+  /// \param params_file The params file.
+  /// \return Whether the parameters are updated. If not, they are unchanged.
+  ///
+  bool UpdateParameters(const std::string& params_file);
+
+  ///
+  /// \brief Get the summary of the startup when Config::EnableStartupTrace
+  /// is set: the time of the loading, of the analysis, IR and PIR passes,
+  /// of the CINN compilation, of the TensorRT engine build and of the
+  /// executor build, and the longest phases. The startup ends with the
+  /// first run, or with the first call of this or ExportStartupTrace.
+  ///
+  /// \return The summary as a table.
+  ///
+  std::string GetStartupSummary();
+
+  ///
+  /// \brief Write the trace of the startup in the chrome tracing format of
+  /// the profiler when Config::EnableStartupTrace is set.
+  ///
+  /// \param path The file to write.
+  ///
+  void ExportStartupTrace(const std::string& path);
+
   ///
   /// \brief Get the execution stream on devices with a concept of stream,
   /// otherwise returns nullptr.
@@ -232,6 +298,14 @@ PD_INFER_DECL std::shared_ptr<Predictor> CreatePredictor(
 
 PD_INFER_DECL int GetNumBytesOfDataType(DataType dtype);
 
+///
+/// \brief Serialize the spans as the OTLP/JSON body an OpenTelemetry collector
+/// takes at /v1/traces.
+///
+PD_INFER_DECL std::string TraceSpansToOtlpJson(
+    const std::vector<TraceSpan>& spans);
+
+
 PD_INFER_DECL std::string GetVersion();
 PD_INFER_DECL std::tuple<int, int, int> GetTrtCompileVersion();
 PD_INFER_DECL std::tuple<int, int, int> GetTrtRuntimeVersion();
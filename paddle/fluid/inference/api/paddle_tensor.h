@@ -118,7 +118,10 @@ class PD_INFER_DECL Tensor {
   void CopyFromCpu(const T* data);
 
   /// \brief Share the data with tensor data.
-  /// It's usually used to set the tensor data.
+  /// It's usually used to set the tensor data. On an output tensor, it binds
+  /// a pre-allocated buffer, on the device or in pinned host memory, which
+  /// each run writes the output into until another buffer is shared. The
+  /// output must fit in the buffer and have its data type.
   /// \param data The pointer of the data, from which the tensor will share.
   /// \param shape The shape of data.
   /// \param place The place of data.
@@ -14,9 +14,11 @@
 
 #include "paddle/fluid/inference/api/resource_manager.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <utility>
 
@@ -140,7 +142,80 @@ CPUContextResource::CPUContextResource() : cpu_eigen_device_(nullptr) {
 }
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-GPUContextResource::GPUContextResource(const phi::Place& place, void* stream)
+namespace {
+// Counts the memory allocated on a device by a tenant, the allocations are
+// passed through with a deleter returning the bytes to the tenant.
+class TenantAllocator : public phi::Allocator {
+ public:
+  TenantAllocator(phi::Allocator* allocator, GPUTenant* tenant, int device)
+      : allocator_(allocator), tenant_(tenant), device_(device) {}
+
+  AllocationPtr Allocate(size_t bytes_size) override {
+    tenant_->Acquire(device_, bytes_size);
+    AllocationPtr allocation;
+    try {
+      allocation = allocator_->Allocate(bytes_size);
+    } catch (...) {
+      tenant_->Release(device_, bytes_size);
+      throw;
+    }
+    DeleterType deleter = allocation.get_deleter();
+    GPUTenant* tenant = tenant_;
+    int device = device_;
+    return AllocationPtr(
+        allocation.release(),
+        [deleter, tenant, device, bytes_size](phi::Allocation* allocation) {
+          deleter(allocation);
+          tenant->Release(device, bytes_size);
+        });
+  }
+
+  bool IsAllocThreadSafe() const override {
+    return allocator_->IsAllocThreadSafe();
+  }
+
+ private:
+  phi::Allocator* allocator_;
+  GPUTenant* tenant_;
+  int device_;
+};
+}  // namespace
+
+GPUTenant::GPUTenant(const std::string& name,
+                     int stream_priority,
+                     size_t memory_limit)
+    : name_(name),
+      stream_priority_(stream_priority),
+      memory_limit_(memory_limit),
+      memory_used_(phi::backends::gpu::GetGPUDeviceCount()) {}
+
+size_t GPUTenant::MemoryUsed(int device) const {
+  return memory_used_.at(device).load();
+}
+
+void GPUTenant::Acquire(int device, size_t bytes) {
+  auto& memory_used = memory_used_.at(device);
+  size_t used = memory_used.fetch_add(bytes) + bytes;
+  if (memory_limit_ > 0 && used > memory_limit_) {
+    memory_used.fetch_sub(bytes);
+    PADDLE_THROW(common::errors::ResourceExhausted(
+        "The GPU tenant %s runs out of its memory limit on GPU %d, %d bytes "
+        "are requested while %d of %d bytes are in use.",
+        name_,
+        device,
+        bytes,
+        used - bytes,
+        memory_limit_));
+  }
+}
+
+void GPUTenant::Release(int device, size_t bytes) {
+  memory_used_.at(device).fetch_sub(bytes);
+}
+
+GPUContextResource::GPUContextResource(const phi::Place& place,
+                                       void* stream,
+                                       GPUTenant* tenant)
     : place_(place),
       compute_capability_(0),
       runtime_version_(0),
@@ -149,6 +224,7 @@ GPUContextResource::GPUContextResource(const phi::Place& place, void* stream)
       max_threads_per_mp_(0),
       max_threads_per_block_(0),
       stream_(nullptr),
+      tenant_(tenant),
       gpu_eigen_device_(nullptr),
       eigen_stream_(nullptr) {
   InitGPUResource(stream);
@@ -158,7 +234,28 @@ GPUContextResource::~GPUContextResource() { DestroyGPUResource(); }  // NOLINT
 
 void GPUContextResource::InitGPUResource(void* stream) {
   phi::backends::gpu::GPUDeviceGuard guard(place_.device);
-  if (stream == nullptr) {
+  if (stream == nullptr && tenant_ != nullptr) {
+    owned_stream_ = true;
+    int least_priority = 0;
+    int greatest_priority = 0;
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        hipDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+#endif
+    // A lower number is a higher priority.
+    int priority = std::min(
+        std::max(tenant_->StreamPriority(), greatest_priority), least_priority);
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        hipStreamCreateWithPriority(&stream_, hipStreamDefault, priority));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaStreamCreateWithPriority(&stream_, cudaStreamDefault, priority));
+#endif
+  } else if (stream == nullptr) {
     owned_stream_ = true;
     phi::InitStream(&stream_);
   } else {
@@ -251,6 +348,21 @@ void GPUContextResource::DestroySparseHandle() {
 
 phi::Place GPUContextResource::Place() const { return place_; }
 
+GPUTenant* GPUContextResource::Tenant() const { return tenant_; }
+
+phi::Allocator* GPUContextResource::GetAllocator(
+    phi::Allocator* stream_allocator) {
+  if (tenant_ == nullptr) {
+    return stream_allocator;
+  }
+  // The predictors on one stream share the allocator of the facade.
+  if (tenant_allocator_ == nullptr) {
+    tenant_allocator_ = std::make_unique<TenantAllocator>(
+        stream_allocator, tenant_, place_.GetDeviceId());
+  }
+  return tenant_allocator_.get();
+}
+
 gpuStream_t GPUContextResource::GetStream() const { return stream_; }
 
 dnnHandle_t GPUContextResource::GetDnnHandle() const { return dnn_handle_; }
@@ -401,14 +513,16 @@ CPUContextResource* ResourceManager::GetCPUResource() const {
 }
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
-void* ResourceManager::InitGPUResource(const phi::Place& place, void* stream) {
+void* ResourceManager::InitGPUResource(const phi::Place& place,
+                                       void* stream,
+                                       GPUTenant* tenant) {
   std::lock_guard<std::mutex> lock_guard(gpu_mutex_);
   if (gpu_resources_.count(stream)) {
     Increase(stream);
     return stream;
   } else {
     std::unique_ptr<GPUContextResource> resource{
-        new GPUContextResource(place, stream)};
+        new GPUContextResource(place, stream, tenant)};
     gpuStream_t s = resource->GetStream();
     ref_count_[s] = 1;
     gpu_resources_.emplace(s, std::move(resource));
@@ -416,6 +530,17 @@ void* ResourceManager::InitGPUResource(const phi::Place& place, void* stream) {
   }
 }
 
+GPUTenant* ResourceManager::GetGPUTenant(const std::string& name,
+                                         int stream_priority,
+                                         size_t memory_limit) {
+  std::lock_guard<std::mutex> lock_guard(gpu_mutex_);
+  auto& tenant = gpu_tenants_[name];
+  if (tenant == nullptr) {
+    tenant = std::make_unique<GPUTenant>(name, stream_priority, memory_limit);
+  }
+  return tenant.get();
+}
+
 void ResourceManager::DestroyGPUResource(void* stream) {
   PADDLE_ENFORCE_EQ(gpu_resources_.count(stream),
                     true,
@@ -460,8 +585,9 @@ void ResourceManager::GpuResourceSwitchStream(void* old_stream,
   bool new_stream_existed = gpu_resources_.count(new_stream) > 0;
   if (!new_stream_existed) {
     auto place = gpu_resources_.at(old_stream)->Place();
+    auto* tenant = gpu_resources_.at(old_stream)->Tenant();
     std::unique_ptr<GPUContextResource> resource{
-        new GPUContextResource(place, new_stream)};
+        new GPUContextResource(place, new_stream, tenant)};
     gpu_resources_.emplace(new_stream, std::move(resource));
   }
 
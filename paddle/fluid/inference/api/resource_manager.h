@@ -18,11 +18,14 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "paddle/common/macros.h"
 #include "paddle/phi/api/include/tensor.h"
 #include "paddle/phi/backends/cpu/forwards.h"
 #include "paddle/phi/common/place.h"
+#include "paddle/phi/core/allocator.h"
 #include "paddle/utils/test_macros.h"
 #include "unsupported/Eigen/CXX11/Tensor"
 
@@ -51,11 +54,43 @@ class CPUContextResource {
 };
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// A tenant of the GPUs shared by the predictors of this process. The streams
+// created for its predictors take its priority, and the memory allocated
+// through their device contexts is capped on each device.
+class GPUTenant {
+ public:
+  GPUTenant(const std::string& name, int stream_priority, size_t memory_limit);
+
+  const std::string& Name() const { return name_; }
+  int StreamPriority() const { return stream_priority_; }
+  // In bytes, 0 for no limit.
+  size_t MemoryLimit() const { return memory_limit_; }
+  TEST_API size_t MemoryUsed(int device) const;
+
+  // Throws ResourceExhausted if the bytes exceed the limit on the device.
+  TEST_API void Acquire(int device, size_t bytes);
+  TEST_API void Release(int device, size_t bytes);
+
+ private:
+  std::string name_;
+  int stream_priority_;
+  size_t memory_limit_;
+  std::vector<std::atomic<size_t>> memory_used_;
+
+  DISABLE_COPY_AND_ASSIGN(GPUTenant);
+};
+
 class GPUContextResource {
  public:
-  explicit GPUContextResource(const phi::Place& place, void* stream);
+  explicit GPUContextResource(const phi::Place& place,
+                              void* stream,
+                              GPUTenant* tenant = nullptr);
   TEST_API ~GPUContextResource();
   phi::Place Place() const;
+  TEST_API GPUTenant* Tenant() const;
+  // The allocator of the device context on the stream, which counts the
+  // memory of the tenant if there is one.
+  phi::Allocator* GetAllocator(phi::Allocator* stream_allocator);
 
   std::function<phi::dnnHandle_t()> GetDnnHandleCreator();
   std::function<phi::blasHandle_t()> GetBlasHandleCreator();
@@ -111,6 +146,8 @@ class GPUContextResource {
 
   bool owned_stream_{true};
   gpuStream_t stream_;
+  GPUTenant* tenant_{nullptr};
+  std::unique_ptr<phi::Allocator> tenant_allocator_;
   std::unique_ptr<Eigen::GpuDevice> gpu_eigen_device_;
   std::unique_ptr<internal::EigenGpuStreamDevice> eigen_stream_;
 
@@ -142,7 +179,14 @@ class ResourceManager {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   // GPU Resource
  public:
-  void* InitGPUResource(const phi::Place& place, void* stream);
+  void* InitGPUResource(const phi::Place& place,
+                        void* stream,
+                        GPUTenant* tenant = nullptr);
+  // Get the tenant of the name, which is created with the priority and the
+  // memory limit in bytes if it does not exist.
+  TEST_API GPUTenant* GetGPUTenant(const std::string& name,
+                                   int stream_priority,
+                                   size_t memory_limit);
   void DestroyGPUResource(void* stream);
   TEST_API GPUContextResource* GetGPUResource(void* stream) const;
   TEST_API int RefCount(void* stream) const;
@@ -158,6 +202,7 @@ class ResourceManager {
   std::map<void* /*stream*/, std::atomic<int>> ref_count_;
   std::map<void* /*stream*/, std::unique_ptr<GPUContextResource>>
       gpu_resources_;
+  std::map<std::string, std::unique_ptr<GPUTenant>> gpu_tenants_;
 #endif
 
  private:
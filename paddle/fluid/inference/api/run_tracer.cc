@@ -0,0 +1,303 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/api/run_tracer.h"
+
+#include <cstdio>
+#include <sstream>
+#include <utility>
+
+#include "paddle/common/enforce.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle {
+
+RunTracer::RunTracer(const phi::Place& place)
+    : place_(place),
+      steady_origin_(std::chrono::steady_clock::now()),
+      random_(std::random_device()()) {
+  unix_origin_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+}
+
+RunTracer::~RunTracer() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  for (auto event : events_) {
+    gpuEventDestroy(event);
+  }
+#endif
+}
+
+void RunTracer::SetParent(const std::string& trace_id,
+                          const std::string& parent_span_id) {
+  PADDLE_ENFORCE_EQ(
+      trace_id.size(),
+      32,
+      common::errors::InvalidArgument(
+          "The trace id should be 32 hex digits, but received %s.", trace_id));
+  PADDLE_ENFORCE_EQ(parent_span_id.size(),
+                    16,
+                    common::errors::InvalidArgument(
+                        "The parent span id should be 16 hex digits, but "
+                        "received %s.",
+                        parent_span_id));
+  std::lock_guard<std::mutex> lock(mutex_);
+  trace_id_ = trace_id;
+  parent_span_id_ = parent_span_id;
+}
+
+void RunTracer::BeginRun(const std::string& name, void* stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_.clear();
+  open_ops_.clear();
+  op_parent_ = kRunSpan;
+  num_events_ = 0;
+  stream_ = phi::is_gpu_place(place_) ? stream : nullptr;
+
+  Span run;
+  run.span.name = name;
+  // The parent is the one of this run only, a run without one starts a
+  // trace of its own.
+  if (trace_id_.empty()) {
+    run.span.trace_id = NewId(16);
+  } else {
+    run.span.trace_id = std::move(trace_id_);
+    run.span.parent_span_id = std::move(parent_span_id_);
+    trace_id_.clear();
+    parent_span_id_.clear();
+  }
+  run.span.span_id = NewId(8);
+  Stamp(&run, false);
+  spans_.push_back(std::move(run));
+}
+
+void RunTracer::EndRun() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (spans_.empty()) return;
+  Stamp(&spans_[kRunSpan], true);
+}
+
+RunTracer::SpanId RunTracer::BeginSpan(
+    const std::string& name,
+    SpanId parent,
+    std::map<std::string, std::string> attributes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (spans_.empty()) return -1;
+  if (parent < 0 || parent >= static_cast<SpanId>(spans_.size())) {
+    parent = kRunSpan;
+  }
+  Span span;
+  span.span.name = name;
+  span.span.trace_id = spans_[kRunSpan].span.trace_id;
+  span.span.span_id = NewId(8);
+  span.span.parent_span_id = spans_[parent].span.span_id;
+  span.span.attributes = std::move(attributes);
+  Stamp(&span, false);
+  spans_.push_back(std::move(span));
+  return static_cast<SpanId>(spans_.size() - 1);
+}
+
+void RunTracer::EndSpan(SpanId span) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (span < 0 || span >= static_cast<SpanId>(spans_.size())) return;
+  Stamp(&spans_[span], true);
+}
+
+void RunTracer::SetOpParent(SpanId parent) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  op_parent_ = parent < 0 ? kRunSpan : parent;
+}
+
+void RunTracer::BeginOp(const void* key,
+                        const std::string& name,
+                        std::map<std::string, std::string> attributes) {
+  SpanId parent = kRunSpan;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    parent = op_parent_;
+  }
+  SpanId span = BeginSpan(name, parent, std::move(attributes));
+  if (span < 0) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  open_ops_[key] = span;
+}
+
+void RunTracer::EndOp(const void* key) {
+  SpanId span = -1;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = open_ops_.find(key);
+    if (it == open_ops_.end()) return;
+    span = it->second;
+    open_ops_.erase(it);
+  }
+  EndSpan(span);
+}
+
+std::vector<TraceSpan> RunTracer::Spans() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<TraceSpan> spans;
+  spans.reserve(spans_.size());
+  for (auto& span : spans_) {
+    span.span.start_time_unix_nano = ToUnixNano(span.host_start);
+    span.span.end_time_unix_nano = ToUnixNano(span.host_end);
+    spans.push_back(span.span);
+  }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (spans_.empty() || spans_[kRunSpan].start_event < 0) return spans;
+  // The device times are taken relative to the start of the run, which is
+  // placed at the host time it was enqueued.
+  PADDLE_ENFORCE_GPU_SUCCESS(gpuEventSynchronize(events_[num_events_ - 1]));
+  gpuEvent_t origin = events_[spans_[kRunSpan].start_event];
+  int64_t origin_ns = spans[kRunSpan].start_time_unix_nano;
+  auto device_time = [&](int event, int64_t host_time) {
+    if (event < 0) return host_time;
+    float ms = 0;
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        hipEventElapsedTime(&ms, origin, events_[event]));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaEventElapsedTime(&ms, origin, events_[event]));
+#endif
+    return origin_ns + static_cast<int64_t>(ms * 1e6);
+  };
+  for (size_t i = 0; i < spans.size(); ++i) {
+    spans[i].start_time_unix_nano =
+        device_time(spans_[i].start_event, spans[i].start_time_unix_nano);
+    spans[i].end_time_unix_nano =
+        device_time(spans_[i].end_event, spans[i].end_time_unix_nano);
+  }
+#endif
+  return spans;
+}
+
+std::string RunTracer::NewId(int bytes) {
+  std::string id;
+  char hex[17];
+  for (int i = 0; i < bytes; i += 8) {
+    std::snprintf(hex,
+                  sizeof(hex),
+                  "%016llx",
+                  static_cast<unsigned long long>(random_()));  // NOLINT
+    id += hex;
+  }
+  return id;
+}
+
+int RunTracer::RecordEvent() {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (stream_ == nullptr) return -1;
+  // The events are kept across the runs, a run records at most two for
+  // each of its spans.
+  if (num_events_ == static_cast<int>(events_.size())) {
+    gpuEvent_t event;
+    PADDLE_ENFORCE_GPU_SUCCESS(gpuEventCreateWithFlags(&event, 0));
+    events_.push_back(event);
+  }
+  PADDLE_ENFORCE_GPU_SUCCESS(gpuEventRecord(
+      events_[num_events_], static_cast<gpuStream_t>(stream_)));
+  return num_events_++;
+#else
+  return -1;
+#endif
+}
+
+void RunTracer::Stamp(Span* span, bool end) {
+  if (end) {
+    span->host_end = std::chrono::steady_clock::now();
+    span->end_event = RecordEvent();
+  } else {
+    // A span left open ends where it starts.
+    span->host_start = span->host_end = std::chrono::steady_clock::now();
+    span->start_event = RecordEvent();
+  }
+}
+
+int64_t RunTracer::ToUnixNano(
+    std::chrono::steady_clock::time_point time) const {
+  return unix_origin_ns_ + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               time - steady_origin_)
+                               .count();
+}
+
+namespace {
+
+std::string JsonString(const std::string& value) {
+  std::string out = "\"";
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out += escaped;
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out + "\"";
+}
+
+}  // namespace
+
+std::string TraceSpansToOtlpJson(const std::vector<TraceSpan>& spans) {
+  std::ostringstream os;
+  os << "{\"resourceSpans\":[{\"resource\":{\"attributes\":[{\"key\":"
+        "\"service.name\",\"value\":{\"stringValue\":\"paddle_inference\"}}]},"
+        "\"scopeSpans\":[{\"scope\":{\"name\":\"paddle_inference\"},"
+        "\"spans\":[";
+  for (size_t i = 0; i < spans.size(); ++i) {
+    const auto& span = spans[i];
+    if (i > 0) os << ",";
+    // The 64-bit integers are strings in OTLP/JSON, and 1 is the internal
+    // span kind.
+    os << "{\"traceId\":" << JsonString(span.trace_id)
+       << ",\"spanId\":" << JsonString(span.span_id);
+    if (!span.parent_span_id.empty()) {
+      os << ",\"parentSpanId\":" << JsonString(span.parent_span_id);
+    }
+    os << ",\"name\":" << JsonString(span.name) << ",\"kind\":1"
+       << ",\"startTimeUnixNano\":\"" << span.start_time_unix_nano << "\""
+       << ",\"endTimeUnixNano\":\"" << span.end_time_unix_nano << "\""
+       << ",\"attributes\":[";
+    bool first = true;
+    for (const auto& attribute : span.attributes) {
+      if (!first) os << ",";
+      first = false;
+      os << "{\"key\":" << JsonString(attribute.first)
+         << ",\"value\":{\"stringValue\":" << JsonString(attribute.second)
+         << "}}";
+    }
+    os << "]}";
+  }
+  os << "]}]}]}";
+  return os.str();
+}
+
+}  // namespace paddle
@@ -0,0 +1,114 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/common/macros.h"
+#include "paddle/fluid/inference/api/paddle_api.h"
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/platform/device/gpu/gpu_types.h"
+
+namespace paddle {
+
+// Records the spans of the runs of a predictor, see
+// AnalysisConfig::EnableRunTrace. A run is the root span, with the feed,
+// the execution and the fetch as its children and the operators as the
+// children of the execution.
+//
+// On a GPU place, the spans are timed by events recorded on the stream of
+// the run, so that they take the time on the device without synchronizing
+// it, and are resolved when the trace is read. Elsewhere the host time is
+// taken.
+class RunTracer {
+ public:
+  using SpanId = int;
+
+  explicit RunTracer(const phi::Place& place);
+  ~RunTracer();
+
+  // The trace and the span of the caller the next run is a child of, as
+  // 32 and 16 hex digits.
+  void SetParent(const std::string& trace_id,
+                 const std::string& parent_span_id);
+
+  // Start the trace of a run on stream, dropping the last one.
+  void BeginRun(const std::string& name, void* stream);
+  void EndRun();
+
+  SpanId BeginSpan(const std::string& name,
+                   SpanId parent,
+                   std::map<std::string, std::string> attributes = {});
+  void EndSpan(SpanId span);
+
+  // The operators are matched by key, the operator or the instruction, and
+  // are the children of the span set by SetOpParent.
+  void SetOpParent(SpanId parent);
+  void BeginOp(const void* key,
+               const std::string& name,
+               std::map<std::string, std::string> attributes);
+  void EndOp(const void* key);
+
+  // The spans of the last run, the run itself first.
+  std::vector<TraceSpan> Spans();
+
+  static constexpr SpanId kRunSpan = 0;
+
+ private:
+  struct Span {
+    TraceSpan span;
+    std::chrono::steady_clock::time_point host_start;
+    std::chrono::steady_clock::time_point host_end;
+    int start_event{-1};
+    int end_event{-1};
+  };
+
+  std::string NewId(int bytes);
+  int RecordEvent();
+  void Stamp(Span* span, bool end);
+  int64_t ToUnixNano(std::chrono::steady_clock::time_point time) const;
+
+  phi::Place place_;
+  void* stream_{nullptr};
+  std::string trace_id_;
+  std::string parent_span_id_;
+  std::vector<Span> spans_;
+  std::unordered_map<const void*, SpanId> open_ops_;
+  SpanId op_parent_{kRunSpan};
+  // The unix time matching the steady clock, taken at construction.
+  std::chrono::steady_clock::time_point steady_origin_;
+  int64_t unix_origin_ns_{0};
+  std::mt19937_64 random_;
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  std::vector<gpuEvent_t> events_;
+#endif
+  int num_events_{0};
+  std::mutex mutex_;
+
+  DISABLE_COPY_AND_ASSIGN(RunTracer);
+};
+
+// Serialize the spans as an OTLP/JSON ExportTraceServiceRequest, which an
+// OpenTelemetry collector takes at /v1/traces.
+std::string TraceSpansToOtlpJson(const std::vector<TraceSpan>& spans);
+
+}  // namespace paddle
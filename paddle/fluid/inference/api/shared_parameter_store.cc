@@ -0,0 +1,243 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/api/shared_parameter_store.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+#include "paddle/fluid/framework/tensor_util.h"
+#include "paddle/fluid/platform/enforce.h"
+#include "paddle/phi/common/data_type.h"
+
+#if defined(PADDLE_WITH_CUDA) && !defined(_WIN32)
+#include <unistd.h>
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+#include "paddle/phi/core/memory/allocation/cuda_ipc_allocator.h"
+#endif
+
+namespace paddle {
+
+namespace {
+
+// The place, dtype, shape and two 64-bit hashes of the content of the
+// tensor, taken as the identity of a parameter.
+std::string ParameterKey(const phi::DenseTensor& tensor) {
+  phi::DenseTensor cpu_tensor;
+  const phi::DenseTensor* host_tensor = &tensor;
+  if (tensor.place().GetType() != phi::AllocationType::CPU) {
+    framework::TensorCopySync(tensor, phi::CPUPlace(), &cpu_tensor);
+    host_tensor = &cpu_tensor;
+  }
+  const auto* data = static_cast<const uint8_t*>(host_tensor->data());
+  const size_t bytes = tensor.numel() * phi::SizeOf(tensor.dtype());
+
+  // FNV-1a and a shift-add-xor hash, over 64-bit words for the speed.
+  uint64_t fnv_hash = 14695981039346656037ULL;
+  uint64_t sax_hash = 0x9e3779b97f4a7c15ULL;
+  auto mix = [&](uint64_t word) {
+    fnv_hash = (fnv_hash ^ word) * 1099511628211ULL;
+    sax_hash ^=
+        word + 0x9e3779b97f4a7c15ULL + (sax_hash << 6) + (sax_hash >> 2);
+  };
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    std::memcpy(&word, data + i, sizeof(uint64_t));
+    mix(word);
+  }
+  for (; i < bytes; ++i) {
+    mix(data[i]);
+  }
+
+  std::ostringstream key;
+  key << tensor.place() << ";" << phi::DataTypeToString(tensor.dtype()) << ";"
+      << tensor.dims() << ";" << std::hex << fnv_hash << "_" << sax_hash;
+  return key.str();
+}
+
+#if defined(PADDLE_WITH_CUDA) && !defined(_WIN32)
+// The parameter registered by this process for the other processes. Its
+// handle file is removed with it, so that the memory is not mapped by the
+// other processes after it is freed.
+class ExportedParameterAllocation : public phi::Allocation {
+ public:
+  ExportedParameterAllocation(std::shared_ptr<phi::Allocation> allocation,
+                              std::string handle_path)
+      : phi::Allocation(
+            allocation->ptr(), allocation->size(), allocation->place()),
+        allocation_(std::move(allocation)),
+        handle_path_(std::move(handle_path)) {}
+
+  ~ExportedParameterAllocation() override { unlink(handle_path_.c_str()); }
+
+ private:
+  std::shared_ptr<phi::Allocation> allocation_;
+  std::string handle_path_;
+};
+
+// The handle file holds the key, the IPC handle of the memory block and the
+// offset of the parameter in it.
+std::string HandlePath(const std::string& ipc_dir, const std::string& key) {
+  std::ostringstream path;
+  path << ipc_dir << "/param_" << std::hex << std::hash<std::string>()(key);
+  return path.str();
+}
+
+bool ReadHandleFile(const std::string& path,
+                    const std::string& key,
+                    std::string* handle,
+                    int64_t* offset) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return false;
+  uint64_t key_size = 0;
+  file.read(reinterpret_cast<char*>(&key_size), sizeof(key_size));
+  if (!file || key_size != key.size()) return false;
+  std::string file_key(key_size, '\0');
+  handle->resize(CUDA_IPC_HANDLE_SIZE);
+  file.read(&file_key[0], static_cast<std::streamsize>(key_size));
+  file.read(&(*handle)[0], CUDA_IPC_HANDLE_SIZE);
+  file.read(reinterpret_cast<char*>(offset), sizeof(*offset));
+  return file && file_key == key;
+}
+
+void WriteHandleFile(const std::string& path,
+                     const std::string& key,
+                     const std::string& handle,
+                     int64_t offset) {
+  // Written aside and renamed, so that the readers see a whole file.
+  const std::string tmp_path = path + "." + std::to_string(getpid());
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    PADDLE_ENFORCE_EQ(file.is_open(),
+                      true,
+                      common::errors::Unavailable(
+                          "Failed to open %s to share the parameter.",
+                          tmp_path));
+    uint64_t key_size = key.size();
+    file.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    file.write(key.data(), static_cast<std::streamsize>(key.size()));
+    file.write(handle.data(), static_cast<std::streamsize>(handle.size()));
+    file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+  }
+  PADDLE_ENFORCE_EQ(std::rename(tmp_path.c_str(), path.c_str()),
+                    0,
+                    common::errors::Unavailable(
+                        "Failed to write the parameter handle file %s.", path));
+}
+#endif
+
+}  // namespace
+
+SharedParameterStore& SharedParameterStore::Instance() {
+  static SharedParameterStore* store = new SharedParameterStore;
+  return *store;
+}
+
+bool SharedParameterStore::Share(phi::DenseTensor* tensor,
+                                 const std::string& ipc_dir) {
+  if (tensor == nullptr || !tensor->IsInitialized() || tensor->numel() == 0 ||
+      tensor->meta().offset != 0) {
+    return false;
+  }
+  const std::string key = ParameterKey(*tensor);
+  const size_t bytes = tensor->numel() * phi::SizeOf(tensor->dtype());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = params_.find(key);
+  if (iter != params_.end()) {
+    auto allocation = iter->second.lock();
+    if (allocation) {
+      tensor->ResetHolder(allocation);
+      shared_bytes_ += bytes;
+      return true;
+    }
+    params_.erase(iter);
+  }
+
+  if (!ipc_dir.empty() &&
+      tensor->place().GetType() == phi::AllocationType::GPU &&
+      ShareWithOtherProcesses(key, ipc_dir, tensor)) {
+    shared_bytes_ += bytes;
+    return true;
+  }
+  params_[key] = tensor->Holder();
+  return false;
+}
+
+bool SharedParameterStore::ShareWithOtherProcesses(const std::string& key,
+                                                   const std::string& ipc_dir,
+                                                   phi::DenseTensor* tensor) {
+#if defined(PADDLE_WITH_CUDA) && !defined(_WIN32)
+  platform::CUDADeviceGuard guard(tensor->place().GetDeviceId());
+  const std::string path = HandlePath(ipc_dir, key);
+  std::string handle;
+  int64_t offset = 0;
+  if (ReadHandleFile(path, key, &handle, &offset)) {
+    try {
+      auto base_ptr = memory::allocation::GetIpcBasePtr(handle);
+      void* ptr = static_cast<char*>(base_ptr.get()) + offset;
+      std::shared_ptr<phi::Allocation> allocation =
+          std::make_shared<memory::allocation::CudaIpcAllocation>(
+              ptr,
+              tensor->Holder()->size(),
+              tensor->place().GetDeviceId(),
+              std::move(base_ptr));
+      tensor->ResetHolder(allocation);
+      params_[key] = allocation;
+      VLOG(3) << "Share the parameter " << key << " from " << path;
+      return true;
+    } catch (const std::exception& e) {
+      // The process which wrote the handle has exited.
+      VLOG(3) << "Failed to open the parameter handle " << path << ": "
+              << e.what();
+    }
+  }
+
+  auto* holder =
+      dynamic_cast<memory::allocation::Allocation*>(tensor->Holder().get());
+  if (holder == nullptr) return false;
+  cudaIpcMemHandle_t ipc_handle;
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      cudaIpcGetMemHandle(&ipc_handle, holder->base_ptr()));
+  offset = static_cast<char*>(holder->ptr()) -
+           static_cast<char*>(holder->base_ptr());
+  WriteHandleFile(path,
+                  key,
+                  std::string(reinterpret_cast<const char*>(&ipc_handle),
+                              CUDA_IPC_HANDLE_SIZE),
+                  offset);
+  std::shared_ptr<phi::Allocation> allocation =
+      std::make_shared<ExportedParameterAllocation>(tensor->Holder(), path);
+  tensor->ResetHolder(allocation);
+  params_[key] = allocation;
+  return false;
+#else
+  VLOG(3) << "Sharing the parameters across processes needs CUDA on Linux.";
+  return false;
+#endif
+}
+
+size_t SharedParameterStore::SharedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return shared_bytes_;
+}
+
+}  // namespace paddle
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "paddle/common/macros.h"
+#include "paddle/phi/core/allocator.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+
+// Holds the parameters of the predictors in this process by their content,
+// so that identical parameters of different predictors on one device, such
+// as the weights of a shared backbone, take the memory once. A parameter is
+// released when no predictor holds it any more.
+//
+// With an ipc_dir, the GPU parameters are also shared with the other
+// processes using the same directory on the same machine through CUDA IPC.
+// The first process to register a parameter writes its IPC handle to a file
+// in ipc_dir, and the others map its memory, so the first process must
+// outlive the others. The handles of exited processes are replaced when
+// they can no longer be opened.
+//
+// The shared parameters must not be written after they are shared.
+class SharedParameterStore {
+ public:
+  SharedParameterStore() = default;
+  TEST_API static SharedParameterStore& Instance();
+
+  // Let tensor share the memory of an identical parameter on its place if
+  // there is one, or register it.
+  //
+  // Returns whether the memory of tensor is shared from another parameter.
+  TEST_API bool Share(phi::DenseTensor* tensor,
+                      const std::string& ipc_dir = "");
+
+  // The bytes of the parameters taken from the store instead of holding
+  // their own memory.
+  TEST_API size_t SharedBytes() const;
+
+ private:
+  bool ShareWithOtherProcesses(const std::string& key,
+                               const std::string& ipc_dir,
+                               phi::DenseTensor* tensor);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<phi::Allocation>> params_;
+  size_t shared_bytes_{0};
+
+  DISABLE_COPY_AND_ASSIGN(SharedParameterStore);
+};
+
+}  // namespace paddle
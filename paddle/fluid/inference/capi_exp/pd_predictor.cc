@@ -29,6 +29,161 @@
           "The pointer of paddle predictor shouldn't be nullptr")); \
   auto& predictor = pd_predictor->predictor
 
+#define CHECK_AND_CONVERT_PD_BINDING                              \
+  PADDLE_ENFORCE_NOT_NULL(                                        \
+      pd_binding,                                                 \
+      common::errors::InvalidArgument(                            \
+          "The pointer of paddle binding shouldn't be nullptr")); \
+  auto& binding = *pd_binding
+
+namespace {
+
+PD_BindingSlot MakeBindingSlot(std::unique_ptr<paddle_infer::Tensor> tensor,
+                               PD_DataType dtype,
+                               size_t rank,
+                               const int64_t* max_shape,
+                               PD_PlaceType place,
+                               void* buffer) {
+  PADDLE_ENFORCE_EQ(
+      rank == 0 || max_shape != nullptr,
+      true,
+      common::errors::InvalidArgument(
+          "The max_shape of %s shouldn't be nullptr.", tensor->name()));
+  PD_BindingSlot slot;
+  slot.dtype = dtype;
+  slot.place = place;
+  slot.max_shape.assign(max_shape, max_shape + rank);
+  slot.buffer = buffer;
+  slot.copy = place == PD_PLACE_CPU &&
+              tensor->place() != paddle_infer::PlaceType::kCPU;
+  slot.shape.assign(rank, 0);
+  slot.shared_buffer = nullptr;
+  slot.tensor = std::move(tensor);
+  return slot;
+}
+
+#define PD_BINDING_VISIT_DTYPE(dtype, func)                       \
+  switch (dtype) {                                                \
+    case PD_DATA_FLOAT32:                                         \
+      func(float);                                                \
+      break;                                                      \
+    case PD_DATA_INT32:                                           \
+      func(int32_t);                                              \
+      break;                                                      \
+    case PD_DATA_INT64:                                           \
+      func(int64_t);                                              \
+      break;                                                      \
+    case PD_DATA_UINT8:                                           \
+      func(uint8_t);                                              \
+      break;                                                      \
+    case PD_DATA_INT8:                                            \
+      func(int8_t);                                               \
+      break;                                                      \
+    default:                                                      \
+      PADDLE_THROW(common::errors::Unimplemented(                 \
+          "Unsupported data type of %s.", slot->tensor->name())); \
+  }
+
+void BindInput(PD_BindingSlot* slot, void* buffer, const int64_t* shape) {
+  for (size_t d = 0; d < slot->shape.size(); ++d) {
+    PADDLE_ENFORCE_EQ(
+        shape[d] >= 0 && shape[d] <= slot->max_shape[d],
+        true,
+        common::errors::InvalidArgument(
+            "The dim %d of input %s is %d, it should be in [0, %d].",
+            d,
+            slot->tensor->name(),
+            shape[d],
+            slot->max_shape[d]));
+    slot->shape[d] = static_cast<int>(shape[d]);
+  }
+  auto place = paddle_infer::CvtToCxxPlaceType(slot->place);
+  if (slot->copy) {
+    slot->tensor->Reshape(slot->shape);
+  }
+#define PD_BINDING_BIND_INPUT(type)                              \
+  if (slot->copy) {                                              \
+    slot->tensor->CopyFromCpu(static_cast<const type*>(buffer)); \
+  } else {                                                       \
+    slot->tensor->ShareExternalData(                             \
+        static_cast<const type*>(buffer), slot->shape, place);   \
+  }
+  PD_BINDING_VISIT_DTYPE(slot->dtype, PD_BINDING_BIND_INPUT)
+#undef PD_BINDING_BIND_INPUT
+}
+
+// Shares the buffer of an output with the predictor before the run, if it
+// is not shared already.
+void BindOutput(PD_BindingSlot* slot, void* buffer) {
+  if (slot->copy || slot->shared_buffer == buffer) {
+    return;
+  }
+  for (size_t d = 0; d < slot->shape.size(); ++d) {
+    slot->shape[d] = static_cast<int>(slot->max_shape[d]);
+  }
+  auto place = paddle_infer::CvtToCxxPlaceType(slot->place);
+#define PD_BINDING_BIND_OUTPUT(type)                         \
+  slot->tensor->ShareExternalData(                           \
+      static_cast<const type*>(buffer), slot->shape, place);
+  PD_BINDING_VISIT_DTYPE(slot->dtype, PD_BINDING_BIND_OUTPUT)
+#undef PD_BINDING_BIND_OUTPUT
+  slot->shared_buffer = buffer;
+}
+
+// Writes the shape of an output after the run, and copies it to a buffer
+// not shared with the predictor.
+void FetchOutput(PD_BindingSlot* slot, void* buffer, int64_t* shape) {
+  std::vector<int> out_shape = slot->tensor->shape();
+  PADDLE_ENFORCE_EQ(out_shape.size(),
+                    slot->max_shape.size(),
+                    common::errors::InvalidArgument(
+                        "The rank of output %s is %d, but %d is added.",
+                        slot->tensor->name(),
+                        out_shape.size(),
+                        slot->max_shape.size()));
+  int64_t numel = 1;
+  int64_t max_numel = 1;
+  for (size_t d = 0; d < out_shape.size(); ++d) {
+    numel *= out_shape[d];
+    max_numel *= slot->max_shape[d];
+    if (shape != nullptr) {
+      shape[d] = out_shape[d];
+    }
+  }
+  PADDLE_ENFORCE_LE(
+      numel,
+      max_numel,
+      common::errors::InvalidArgument(
+          "The output %s of %d elements doesn't fit in its buffer of %d.",
+          slot->tensor->name(),
+          numel,
+          max_numel));
+  if (!slot->copy) {
+    return;
+  }
+#define PD_BINDING_FETCH_OUTPUT(type)                  \
+  slot->tensor->CopyToCpu(static_cast<type*>(buffer));
+  PD_BINDING_VISIT_DTYPE(slot->dtype, PD_BINDING_FETCH_OUTPUT)
+#undef PD_BINDING_FETCH_OUTPUT
+}
+
+#undef PD_BINDING_VISIT_DTYPE
+
+void* SlotBuffer(const PD_BindingSlot& slot,
+                 void* const* buffers,
+                 size_t index) {
+  void* buffer = buffers != nullptr && buffers[index] != nullptr
+                     ? buffers[index]
+                     : slot.buffer;
+  PADDLE_ENFORCE_NOT_NULL(
+      buffer,
+      common::errors::InvalidArgument("The buffer of %s shouldn't be nullptr.",
+                                      slot.tensor->name()));
+  return buffer;
+}
+
+}  // namespace
+
 extern "C" {
 __pd_give PD_Predictor* PD_PredictorCreate(__pd_take PD_Config* pd_config) {
   PADDLE_ENFORCE_NOT_NULL(
@@ -143,6 +298,18 @@ PD_Bool PD_PredictorRun(__pd_keep PD_Predictor* pd_predictor) {
   return predictor->Run();  // NOLINT
 }
 
+PD_Bool PD_PredictorRunAsync(__pd_keep PD_Predictor* pd_predictor,
+                             PD_PredictorRunCallback callback,
+                             void* user_data) {
+  CHECK_AND_CONVERT_PD_PREDICTOR;
+  return predictor->RunAsync(  // NOLINT
+      [pd_predictor, callback, user_data](bool success) {
+        if (callback != nullptr) {
+          callback(pd_predictor, success, user_data);
+        }
+      });
+}
+
 void PD_PredictorClearIntermediateTensor(__pd_keep PD_Predictor* pd_predictor) {
   CHECK_AND_CONVERT_PD_PREDICTOR;
   predictor->ClearIntermediateTensor();
@@ -153,6 +320,88 @@ uint64_t PD_PredictorTryShrinkMemory(__pd_keep PD_Predictor* pd_predictor) {
   return predictor->TryShrinkMemory();
 }
 
+__pd_give PD_Binding* PD_BindingCreate(__pd_keep PD_Predictor* pd_predictor) {
+  CHECK_AND_CONVERT_PD_PREDICTOR;
+  PD_Binding* pd_binding = new PD_Binding();
+  pd_binding->predictor = predictor;
+  return pd_binding;
+}
+
+int32_t PD_BindingAddInput(__pd_keep PD_Binding* pd_binding,
+                           const char* name,
+                           PD_DataType dtype,
+                           size_t rank,
+                           const int64_t* max_shape,
+                           PD_PlaceType place,
+                           void* buffer) {
+  CHECK_AND_CONVERT_PD_BINDING;
+  binding.inputs.push_back(
+      MakeBindingSlot(binding.predictor->GetInputHandle(name),
+                      dtype,
+                      rank,
+                      max_shape,
+                      place,
+                      buffer));
+  return static_cast<int32_t>(binding.inputs.size() - 1);
+}
+
+int32_t PD_BindingAddOutput(__pd_keep PD_Binding* pd_binding,
+                            const char* name,
+                            PD_DataType dtype,
+                            size_t rank,
+                            const int64_t* max_shape,
+                            PD_PlaceType place,
+                            void* buffer) {
+  CHECK_AND_CONVERT_PD_BINDING;
+  binding.outputs.push_back(
+      MakeBindingSlot(binding.predictor->GetOutputHandle(name),
+                      dtype,
+                      rank,
+                      max_shape,
+                      place,
+                      buffer));
+  return static_cast<int32_t>(binding.outputs.size() - 1);
+}
+
+PD_Bool PD_BindingRun(__pd_keep PD_Binding* pd_binding,
+                      void* const* input_buffers,
+                      const int64_t* input_shapes,
+                      void* const* output_buffers,
+                      int64_t* output_shapes) {
+  CHECK_AND_CONVERT_PD_BINDING;
+  size_t offset = 0;
+  for (size_t i = 0; i < binding.inputs.size(); ++i) {
+    auto& slot = binding.inputs[i];
+    PADDLE_ENFORCE_EQ(
+        slot.shape.empty() || input_shapes != nullptr,
+        true,
+        common::errors::InvalidArgument(
+            "The input_shapes shouldn't be nullptr."));
+    BindInput(&slot,
+              SlotBuffer(slot, input_buffers, i),
+              slot.shape.empty() ? nullptr : input_shapes + offset);
+    offset += slot.shape.size();
+  }
+  for (size_t i = 0; i < binding.outputs.size(); ++i) {
+    auto& slot = binding.outputs[i];
+    BindOutput(&slot, SlotBuffer(slot, output_buffers, i));
+  }
+  if (!binding.predictor->Run()) {
+    return false;
+  }
+  offset = 0;
+  for (size_t i = 0; i < binding.outputs.size(); ++i) {
+    auto& slot = binding.outputs[i];
+    FetchOutput(&slot,
+                SlotBuffer(slot, output_buffers, i),
+                output_shapes == nullptr ? nullptr : output_shapes + offset);
+    offset += slot.max_shape.size();
+  }
+  return true;
+}
+
+void PD_BindingDestroy(__pd_take PD_Binding* pd_binding) { delete pd_binding; }
+
 void PD_PredictorDestroy(__pd_take PD_Predictor* pd_predictor) {
   delete pd_predictor;
 }
@@ -31,6 +31,15 @@ typedef struct PD_Config PD_Config;
 typedef struct PD_Tensor PD_Tensor;
 typedef struct PD_OneDimArrayCstr PD_OneDimArrayCstr;
 typedef struct PD_IOInfos PD_IOInfos;
+typedef struct PD_Binding PD_Binding;
+
+///
+/// \brief The callback of PD_PredictorRunAsync, invoked with the predictor,
+/// whether the run is successful and the user data.
+///
+typedef void (*PD_PredictorRunCallback)(PD_Predictor* pd_predictor,
+                                        PD_Bool success,
+                                        void* user_data);
 
 #ifdef __cplusplus
 extern "C" {
@@ -131,6 +140,22 @@ PADDLE_CAPI_EXPORT extern __pd_give PD_Tensor* PD_PredictorGetOutputHandle(
 PADDLE_CAPI_EXPORT extern PD_Bool PD_PredictorRun(
     __pd_keep PD_Predictor* pd_predictor);
 
+///
+/// \brief Run the prediction engine without waiting for the device. The
+/// callback is invoked in another thread when the outputs are ready, and can
+/// get them by PD_PredictorGetOutputHandle. The next run waits for the
+/// callback, so the predictor must not be run in the callback.
+///
+/// \param[in] pd_predictor predictor
+/// \param[in] callback The function invoked when the run is completed
+/// \param[in] user_data The data passed to the callback
+/// \return Whether the work is enqueued successfully
+///
+PADDLE_CAPI_EXPORT extern PD_Bool PD_PredictorRunAsync(
+    __pd_keep PD_Predictor* pd_predictor,
+    PD_PredictorRunCallback callback,
+    void* user_data);
+
 /// \brief Clear the intermediate tensors of the predictor
 ///
 /// \param[in] pd_predictor predictor
@@ -159,6 +184,97 @@ PADDLE_CAPI_EXPORT extern uint64_t PD_PredictorTryShrinkMemory(
 PADDLE_CAPI_EXPORT extern void PD_PredictorDestroy(
     __pd_take PD_Predictor* pd_predictor);
 
+///
+/// \brief Create a binding of the inputs and outputs of a predictor to user
+/// buffers. The inputs and outputs are added once, then each request runs
+/// the predictor with PD_BindingRun, which passes the buffers and shapes
+/// without looking up names or allocating tensors. The predictor must
+/// outlive the binding.
+///
+/// \param[in] pd_predictor predictor
+/// \return new binding.
+///
+PADDLE_CAPI_EXPORT extern __pd_give PD_Binding* PD_BindingCreate(
+    __pd_keep PD_Predictor* pd_predictor);
+
+///
+/// \brief Add an input to the binding. The buffer on a device or in host
+/// memory for a predictor on CPU is shared with the predictor, the buffer
+/// in host memory for a predictor on a device is copied at each run.
+///
+/// \param[in] pd_binding binding
+/// \param[in] name input name
+/// \param[in] dtype data type of the buffer
+/// \param[in] rank rank of the input
+/// \param[in] max_shape the largest size of each dim, rank values
+/// \param[in] place place of the buffer
+/// \param[in] buffer the default buffer, may be nullptr if each run passes
+/// one
+/// \return the index of the input in the binding.
+///
+PADDLE_CAPI_EXPORT extern int32_t PD_BindingAddInput(
+    __pd_keep PD_Binding* pd_binding,
+    const char* name,
+    PD_DataType dtype,
+    size_t rank,
+    const int64_t* max_shape,
+    PD_PlaceType place,
+    void* buffer);
+
+///
+/// \brief Add an output to the binding. A buffer shared with the predictor
+/// is written by each run in place, a buffer in host memory for a predictor
+/// on a device is copied to after each run. It holds the output of
+/// max_shape.
+///
+/// \param[in] pd_binding binding
+/// \param[in] name output name
+/// \param[in] dtype data type of the buffer
+/// \param[in] rank rank of the output
+/// \param[in] max_shape the largest size of each dim, rank values
+/// \param[in] place place of the buffer
+/// \param[in] buffer the default buffer, may be nullptr if each run passes
+/// one
+/// \return the index of the output in the binding.
+///
+PADDLE_CAPI_EXPORT extern int32_t PD_BindingAddOutput(
+    __pd_keep PD_Binding* pd_binding,
+    const char* name,
+    PD_DataType dtype,
+    size_t rank,
+    const int64_t* max_shape,
+    PD_PlaceType place,
+    void* buffer);
+
+///
+/// \brief Run the predictor of the binding on one request.
+///
+/// \param[in] pd_binding binding
+/// \param[in] input_buffers the buffer of each input in the order they are
+/// added, nullptr or a nullptr entry for the default buffer
+/// \param[in] input_shapes the shapes of the inputs in the order they are
+/// added, concatenated, rank values each
+/// \param[in] output_buffers the buffer of each output in the order they
+/// are added, nullptr or a nullptr entry for the default buffer
+/// \param[out] output_shapes the shapes of the outputs in the order they are
+/// added, concatenated, rank values each, may be nullptr
+/// \return Whether the function executed successfully
+///
+PADDLE_CAPI_EXPORT extern PD_Bool PD_BindingRun(
+    __pd_keep PD_Binding* pd_binding,
+    void* const* input_buffers,
+    const int64_t* input_shapes,
+    void* const* output_buffers,
+    int64_t* output_shapes);
+
+///
+/// \brief Destroy a binding object
+///
+/// \param[in] pd_binding binding
+///
+PADDLE_CAPI_EXPORT extern void PD_BindingDestroy(
+    __pd_take PD_Binding* pd_binding);
+
 ///
 /// \brief Get version info.
 ///
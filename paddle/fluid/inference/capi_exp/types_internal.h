@@ -16,6 +16,8 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <memory>
+#include <vector>
 
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/capi_exp/pd_common.h"
@@ -27,3 +29,24 @@ typedef struct PD_Tensor {
 typedef struct PD_Predictor {
   std::shared_ptr<paddle_infer::Predictor> predictor;
 } PD_Predictor;
+
+// An input or output of a binding, whose handle and shape are kept across
+// the runs.
+typedef struct PD_BindingSlot {
+  PD_DataType dtype;
+  PD_PlaceType place;
+  std::vector<int64_t> max_shape;
+  void* buffer;
+  std::unique_ptr<paddle_infer::Tensor> tensor;
+  // whether the buffer is copied instead of shared with the predictor
+  bool copy;
+  std::vector<int> shape;
+  // the output buffer shared with the predictor
+  void* shared_buffer;
+} PD_BindingSlot;
+
+typedef struct PD_Binding {
+  std::shared_ptr<paddle_infer::Predictor> predictor;
+  std::vector<PD_BindingSlot> inputs;
+  std::vector<PD_BindingSlot> outputs;
+} PD_Binding;
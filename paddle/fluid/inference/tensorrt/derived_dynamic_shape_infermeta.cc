@@ -0,0 +1,329 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/tensorrt/derived_dynamic_shape_infermeta.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
+#include "glog/logging.h"
+#include "paddle/fluid/framework/program_desc.h"
+#include "paddle/fluid/inference/tensorrt/plugin_arg_mapping_context.h"
+#include "paddle/phi/core/compat/op_utils.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle::inference::tensorrt {
+
+namespace {
+
+// The probe of the symbolic dim `symbol` in the run `run`. The probes are
+// large multiples of a power of two, so that they are neither confused with
+// the constant dims nor rejected by the checks of divisibility.
+constexpr int64_t kProbeUnit = 1024;
+constexpr int64_t kProbeBase[2] = {1009, 2003};
+
+int64_t Probe(int run, int symbol) {
+  return kProbeUnit * (kProbeBase[run] + symbol);
+}
+
+// A derived output dim: the constant value if symbol is -1, otherwise the
+// symbolic input dim `symbol`.
+struct DerivedDim {
+  int64_t value{0};
+  int symbol{-1};
+};
+
+// The input and output vars of the generic plugin of an op, in the order of
+// its kernel signature, see GenericPluginCreater.
+struct PluginArguments {
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+};
+
+bool GetPluginArguments(const framework::OpDesc& op_desc,
+                        PluginArguments* args) {
+  const std::string& op_type = op_desc.Type();
+  phi::KernelSignature signature;
+  if (phi::OpUtilsMap::Instance().HasArgumentMappingFn(op_type)) {
+    const phi::ArgumentMappingFn* argument_mapping_func =
+        phi::OpUtilsMap::Instance().GetArgumentMappingFn(op_type);
+    PluginArgumentMappingContext argument_mapping_context(&op_desc);
+    signature = (*argument_mapping_func)(argument_mapping_context);
+  } else if (phi::DefaultKernelSignatureMap::Instance().Has(op_type)) {
+    signature = phi::DefaultKernelSignatureMap::Instance().Get(op_type);
+  } else {
+    return false;
+  }
+  for (const char* name : signature.input_names) {
+    for (const auto& arg : op_desc.Input(name)) {
+      args->inputs.push_back(arg);
+    }
+  }
+  for (const char* name : signature.output_names) {
+    for (const auto& arg : op_desc.Output(name)) {
+      args->outputs.push_back(arg);
+    }
+  }
+  return !args->outputs.empty();
+}
+
+// Runs the InferMeta of op_desc on the input dims in which the dims of a
+// symbol other than -1 are replaced by the probes of the run.
+bool ProbeOutputDims(
+    const framework::OpDesc& op_desc,
+    const PluginArguments& args,
+    const std::vector<std::vector<int64_t>>& input_dims,
+    const std::vector<std::vector<int>>& input_symbols,
+    const std::vector<framework::proto::VarType::Type>& input_dtypes,
+    int run,
+    std::vector<std::vector<int64_t>>* output_dims) {
+  framework::ProgramDesc program;
+  framework::BlockDesc* block = program.MutableBlock(0);
+  for (size_t i = 0; i < args.inputs.size(); ++i) {
+    std::vector<int64_t> dims = input_dims[i];
+    for (size_t j = 0; j < dims.size(); ++j) {
+      if (input_symbols[i][j] >= 0) {
+        dims[j] = Probe(run, input_symbols[i][j]);
+      }
+    }
+    auto* var = block->Var(args.inputs[i]);
+    var->SetType(framework::proto::VarType::LOD_TENSOR);
+    var->SetDataType(input_dtypes[i]);
+    var->SetShape(dims);
+  }
+
+  framework::OpDesc* op = block->AppendOp();
+  op->CopyFrom(op_desc);
+  // The inputs which are not the inputs of the plugin are not given to it.
+  std::unordered_set<std::string> plugin_inputs(args.inputs.begin(),
+                                                args.inputs.end());
+  for (const auto& input : op_desc.Inputs()) {
+    for (const auto& arg : input.second) {
+      if (!plugin_inputs.count(arg)) {
+        op->SetInput(input.first, {});
+        break;
+      }
+    }
+  }
+  for (const auto& output : op_desc.Outputs()) {
+    for (const auto& arg : output.second) {
+      if (block->FindVar(arg) == nullptr) {
+        block->Var(arg)->SetType(framework::proto::VarType::LOD_TENSOR);
+      }
+    }
+  }
+
+  try {
+    op->InferShape(*block);
+  } catch (const std::exception& e) {
+    VLOG(3) << "The InferMeta of " << op_desc.Type()
+            << " fails on the probe dims: " << e.what();
+    return false;
+  }
+  output_dims->clear();
+  for (const auto& arg : args.outputs) {
+    output_dims->push_back(block->FindVar(arg)->GetShape());
+  }
+  return true;
+}
+
+bool DeriveOutputDims(
+    const framework::OpDesc& op_desc,
+    const PluginArguments& args,
+    const std::vector<std::vector<int64_t>>& input_dims,
+    const std::vector<std::vector<int>>& input_symbols,
+    const std::vector<framework::proto::VarType::Type>& input_dtypes,
+    std::vector<std::vector<DerivedDim>>* output_dims) {
+  std::vector<std::vector<int64_t>> probed[2];
+  for (int run = 0; run < 2; ++run) {
+    if (!ProbeOutputDims(op_desc,
+                         args,
+                         input_dims,
+                         input_symbols,
+                         input_dtypes,
+                         run,
+                         &probed[run])) {
+      return false;
+    }
+  }
+  int num_symbols = 0;
+  for (const auto& symbols : input_symbols) {
+    for (int symbol : symbols) {
+      num_symbols = std::max(num_symbols, symbol + 1);
+    }
+  }
+
+  output_dims->assign(args.outputs.size(), {});
+  for (size_t i = 0; i < args.outputs.size(); ++i) {
+    if (probed[0][i].size() != probed[1][i].size()) {
+      return false;
+    }
+    for (size_t j = 0; j < probed[0][i].size(); ++j) {
+      int64_t first = probed[0][i][j];
+      int64_t second = probed[1][i][j];
+      DerivedDim dim;
+      if (first == second && first >= 0) {
+        dim.value = first;
+      } else {
+        for (int symbol = 0; symbol < num_symbols; ++symbol) {
+          if (Probe(0, symbol) == first && Probe(1, symbol) == second) {
+            dim.symbol = symbol;
+            break;
+          }
+        }
+        if (dim.symbol < 0) {
+          VLOG(3) << "The dim " << j << " of the output " << args.outputs[i]
+                  << " of " << op_desc.Type() << " can not be derived.";
+          return false;
+        }
+      }
+      (*output_dims)[i].push_back(dim);
+    }
+  }
+  return true;
+}
+
+// The symbol of a symbolic dim at the position j of a rank-dims input when
+// the dims at the same distance from the innermost dim are taken as equal.
+int RightAlignedSymbol(int rank, int j) { return rank - 1 - j; }
+
+}  // namespace
+
+bool CanDeriveDynamicShape(const framework::OpDesc& op_desc,
+                           const framework::BlockDesc& block) {
+  PluginArguments args;
+  if (!GetPluginArguments(op_desc, &args)) {
+    return false;
+  }
+  std::vector<std::vector<int64_t>> input_dims;
+  std::vector<std::vector<int>> input_symbols;
+  std::vector<framework::proto::VarType::Type> input_dtypes;
+  for (const auto& arg : args.inputs) {
+    auto* var = block.FindVarRecursive(arg);
+    if (var == nullptr ||
+        var->GetType() != framework::proto::VarType::LOD_TENSOR) {
+      return false;
+    }
+    std::vector<int64_t> dims = var->GetShape();
+    std::vector<int> symbols(dims.size(), -1);
+    int rank = static_cast<int>(dims.size());
+    for (int j = 0; j < rank; ++j) {
+      if (dims[j] < 0) {
+        symbols[j] = RightAlignedSymbol(rank, j);
+      }
+    }
+    input_dims.push_back(std::move(dims));
+    input_symbols.push_back(std::move(symbols));
+    input_dtypes.push_back(var->GetDataType());
+  }
+  std::vector<std::vector<DerivedDim>> output_dims;
+  return DeriveOutputDims(
+      op_desc, args, input_dims, input_symbols, input_dtypes, &output_dims);
+}
+
+nvinfer1::DimsExprs DeriveDynamicShape(
+    int output_index,
+    const nvinfer1::DimsExprs* inputs,
+    int nb_inputs,
+    nvinfer1::IExprBuilder& expr_builder,  // NOLINT
+    const framework::OpDesc& op_desc,
+    const std::vector<framework::proto::VarType::Type>& input_dtypes) {
+  PluginArguments args;
+  PADDLE_ENFORCE_EQ(GetPluginArguments(op_desc, &args),
+                    true,
+                    common::errors::NotFound(
+                        "The %s op has no kernel signature.", op_desc.Type()));
+  PADDLE_ENFORCE_EQ(
+      args.inputs.size() == static_cast<size_t>(nb_inputs) &&
+          input_dtypes.size() == static_cast<size_t>(nb_inputs),
+      true,
+      common::errors::InvalidArgument(
+          "The %s op expects %d inputs, but got %d inputs and %d dtypes.",
+          op_desc.Type(),
+          args.inputs.size(),
+          nb_inputs,
+          input_dtypes.size()));
+
+  std::vector<std::vector<int64_t>> input_dims(nb_inputs);
+  std::vector<std::vector<int>> expr_symbols(nb_inputs);
+  std::vector<std::vector<int>> aligned_symbols(nb_inputs);
+  // The expressions of the symbols of both ways.
+  std::vector<const nvinfer1::IDimensionExpr*> exprs;
+  std::vector<const nvinfer1::IDimensionExpr*> aligned_exprs;
+  for (int i = 0; i < nb_inputs; ++i) {
+    int rank = inputs[i].nbDims;
+    for (int j = 0; j < rank; ++j) {
+      const nvinfer1::IDimensionExpr* expr = inputs[i].d[j];
+      if (expr->isConstant()) {
+        input_dims[i].push_back(
+            static_cast<int64_t>(expr->getConstantValue()));
+        expr_symbols[i].push_back(-1);
+        aligned_symbols[i].push_back(-1);
+        continue;
+      }
+      input_dims[i].push_back(-1);
+      auto it = std::find(exprs.begin(), exprs.end(), expr);
+      expr_symbols[i].push_back(static_cast<int>(it - exprs.begin()));
+      if (it == exprs.end()) {
+        exprs.push_back(expr);
+      }
+      int symbol = RightAlignedSymbol(rank, j);
+      aligned_symbols[i].push_back(symbol);
+      if (static_cast<int>(aligned_exprs.size()) <= symbol) {
+        aligned_exprs.resize(symbol + 1, nullptr);
+      }
+      if (aligned_exprs[symbol] == nullptr) {
+        aligned_exprs[symbol] = expr;
+      }
+    }
+  }
+
+  std::vector<std::vector<DerivedDim>> output_dims;
+  const std::vector<const nvinfer1::IDimensionExpr*>* symbol_exprs = &exprs;
+  bool derived = DeriveOutputDims(
+      op_desc, args, input_dims, expr_symbols, input_dtypes, &output_dims);
+  if (!derived) {
+    derived = DeriveOutputDims(op_desc,
+                               args,
+                               input_dims,
+                               aligned_symbols,
+                               input_dtypes,
+                               &output_dims);
+    symbol_exprs = &aligned_exprs;
+  }
+  PADDLE_ENFORCE_EQ(
+      derived,
+      true,
+      common::errors::Unimplemented(
+          "The output dims of %s can not be derived from its InferMeta.",
+          op_desc.Type()));
+  PADDLE_ENFORCE_LT(output_index,
+                    static_cast<int>(output_dims.size()),
+                    common::errors::InvalidArgument(
+                        "The output_index should be less than %d.",
+                        output_dims.size()));
+
+  const auto& dims = output_dims[output_index];
+  nvinfer1::DimsExprs output;
+  output.nbDims = static_cast<int>(dims.size());
+  for (size_t j = 0; j < dims.size(); ++j) {
+    output.d[j] = dims[j].symbol < 0
+                      ? expr_builder.constant(static_cast<int>(dims[j].value))
+                      : (*symbol_exprs)[dims[j].symbol];
+  }
+  return output;
+}
+
+}  // namespace paddle::inference::tensorrt
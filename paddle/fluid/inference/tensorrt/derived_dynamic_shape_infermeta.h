@@ -0,0 +1,55 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <NvInfer.h>
+#include <vector>
+
+#include "paddle/fluid/framework/block_desc.h"
+#include "paddle/fluid/framework/op_desc.h"
+
+namespace paddle {
+namespace inference {
+namespace tensorrt {
+
+// The output dims of the generic plugin of an op without a DynamicMetaFn are
+// derived from the InferMeta of the op. It is run twice on the input dims in
+// which each symbolic dim is replaced by a probe value, a different one in
+// each run. An output dim equal in both runs is a constant, one equal to the
+// probes of a symbolic input dim in both runs is that dim, and the dims can
+// not be derived when an output dim is neither, e.g. the sum of two dims.
+
+// Whether the output dims of op_desc can be derived, with its vars taken from
+// block. Which -1 dims of the vars are equal is not known, so the -1 dims at
+// the same distance from the innermost dim are taken as equal, as the
+// broadcasting of most ops requires.
+bool CanDeriveDynamicShape(const framework::OpDesc& op_desc,
+                           const framework::BlockDesc& block);
+
+// The output_index-th output dims of the generic plugin of op_desc, whose
+// inputs, in the order of the kernel signature, have the given dtypes. The
+// symbolic dims are equal if they are the same expression, and if the dims
+// can not be derived so, the dims are taken as equal as above.
+nvinfer1::DimsExprs DeriveDynamicShape(
+    int output_index,
+    const nvinfer1::DimsExprs* inputs,
+    int nb_inputs,
+    nvinfer1::IExprBuilder& expr_builder,  // NOLINT
+    const framework::OpDesc& op_desc,
+    const std::vector<framework::proto::VarType::Type>& input_dtypes);
+
+}  // namespace tensorrt
+}  // namespace inference
+}  // namespace paddle
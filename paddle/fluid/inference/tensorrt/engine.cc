@@ -20,6 +20,7 @@ limitations under the License. */
 #include "NvInferRuntimeCommon.h"
 #include "cuda_runtime_api.h"  // NOLINT
 
+#include "paddle/common/startup_trace.h"
 #include "paddle/fluid/inference/tensorrt/helper.h"
 #include "paddle/fluid/inference/tensorrt/trt_int8_calibrator.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
@@ -218,6 +219,8 @@ void TensorRTEngine::FreezeNetwork() {
   PADDLE_ENFORCE_NOT_NULL(network(),
                           common::errors::InvalidArgument(
                               "Call InitNetwork first to initialize network."));
+  common::StartupTraceScope startup_trace("TensorRTBuild",
+                                          network()->getName());
   // build engine.
 #if IS_TRT_VERSION_LT(10000)
   if (!with_dynamic_shape()) {
@@ -19,6 +19,7 @@
 #include "paddle/fluid/framework/block_desc.h"
 #include "paddle/fluid/framework/data_layout.h"
 #include "paddle/fluid/framework/phi_utils.h"
+#include "paddle/fluid/inference/tensorrt/derived_dynamic_shape_infermeta.h"
 #include "paddle/fluid/inference/tensorrt/dynamic_shape_infermeta_factory.h"
 #include "paddle/phi/api/ext/op_meta_info.h"
 #include "paddle/phi/core/compat/op_utils.h"
@@ -3397,9 +3398,13 @@ struct GenericPluginTeller : public Teller {
       }
       auto& dynamic_infermeta_factory =
           tensorrt::DynamicMetaFnFactory::Instance();
-      res = dynamic_infermeta_factory.Contains(op_type);
+      res = dynamic_infermeta_factory.Contains(op_type) ||
+            (desc.Block() != nullptr &&
+             CanDeriveDynamicShape(desc, *desc.Block()));
       if (!res) {
-        VLOG(3) << op_type << " has no DynamicMetaFn.";
+        VLOG(3) << op_type
+                << " has no DynamicMetaFn, and its output dims can not be "
+                   "derived from its InferMeta.";
         return false;
       }
       if (forbid_dynamic_op_enter_into_trt && IsDynamicShapeOp(desc)) {
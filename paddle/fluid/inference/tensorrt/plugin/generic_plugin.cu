@@ -16,6 +16,7 @@
 
 #include "paddle/fluid/framework/op_kernel_type.h"
 #include "paddle/fluid/framework/phi_utils.h"
+#include "paddle/fluid/inference/tensorrt/derived_dynamic_shape_infermeta.h"
 #include "paddle/fluid/inference/tensorrt/dynamic_shape_infermeta_registry.h"
 #include "paddle/fluid/inference/tensorrt/plugin/generic_plugin.h"
 #include "paddle/phi/backends/gpu/gpu_context.h"
@@ -67,6 +68,42 @@ GeneratePluginDataType ProtoTypeToGeneratePluginDataType(
   }
 }
 
+framework::proto::VarType_Type GeneratePluginDataTypeToProtoType(
+    GeneratePluginDataType data_type) {
+  using framework::proto::VarType_Type;
+  switch (data_type) {
+    case GeneratePluginDataType::PLUGIN_BOOL:
+      return VarType_Type::VarType_Type_BOOL;
+    case GeneratePluginDataType::PLUGIN_UINT8:
+      return VarType_Type::VarType_Type_UINT8;
+    case GeneratePluginDataType::PLUGIN_INT8:
+      return VarType_Type::VarType_Type_INT8;
+    case GeneratePluginDataType::PLUGIN_INT16:
+      return VarType_Type::VarType_Type_INT16;
+    case GeneratePluginDataType::PLUGIN_INT32:
+      return VarType_Type::VarType_Type_INT32;
+    case GeneratePluginDataType::PLUGIN_INT64:
+      return VarType_Type::VarType_Type_INT64;
+    case GeneratePluginDataType::PLUGIN_FP16:
+      return VarType_Type::VarType_Type_FP16;
+    case GeneratePluginDataType::PLUGIN_FP32:
+      return VarType_Type::VarType_Type_FP32;
+    case GeneratePluginDataType::PLUGIN_FP64:
+      return VarType_Type::VarType_Type_FP64;
+    case GeneratePluginDataType::PLUGIN_SIZE_T:
+      return VarType_Type::VarType_Type_SIZE_T;
+    case GeneratePluginDataType::PLUGIN_BF16:
+      return VarType_Type::VarType_Type_BF16;
+    case GeneratePluginDataType::PLUGIN_COMPLEX64:
+      return VarType_Type::VarType_Type_COMPLEX64;
+    case GeneratePluginDataType::PLUGIN_COMPLEX128:
+      return VarType_Type::VarType_Type_COMPLEX128;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "This data type is currently not supported"));
+  }
+}
+
 void BuildPhiKernelContextAttr(const framework::OpDesc& op_desc,
                                phi::KernelContext* kernel_context,
                                const phi::KernelSignature& signature,
@@ -553,15 +590,24 @@ nvinfer1::DimsExprs GenericPlugin::getOutputDimensions(
       common::errors::InvalidArgument(
           "The output_index should be less than getNbOutputs()."));
   auto& dynamic_infermeta_factory = tensorrt::DynamicMetaFnFactory::Instance();
-  PADDLE_ENFORCE_EQ(dynamic_infermeta_factory.Contains(op_desc_.Type()),
-                    true,
-                    common::errors::InvalidArgument(
-                        "The %s op has no dynamic plugin infershape function!",
-                        op_desc_.Type().c_str()));
+  if (dynamic_infermeta_factory.Contains(op_desc_.Type())) {
+    auto* infershape_func = dynamic_infermeta_factory.Get(op_desc_.Type());
+    return infershape_func(
+        output_index, inputs, nb_inputs, expr_builder, op_desc_);
+  }
 
-  auto* infershape_func = dynamic_infermeta_factory.Get(op_desc_.Type());
-  return infershape_func(
-      output_index, inputs, nb_inputs, expr_builder, op_desc_);
+  // The ops without a DynamicMetaFn are told by GenericPluginTeller only if
+  // their output dims can be derived from their InferMeta.
+  std::vector<framework::proto::VarType::Type> input_dtypes;
+  for (auto data_type : inputs_data_type_) {
+    input_dtypes.push_back(GeneratePluginDataTypeToProtoType(data_type));
+  }
+  return tensorrt::DeriveDynamicShape(output_index,
+                                      inputs,
+                                      nb_inputs,
+                                      expr_builder,
+                                      op_desc_,
+                                      input_dtypes);
 }
 
 void GenericPlugin::configurePlugin(
@@ -59,6 +59,9 @@ enum class GeneratePluginDataType {
 GeneratePluginDataType ProtoTypeToGeneratePluginDataType(
     framework::proto::VarType_Type proto_type);
 
+framework::proto::VarType_Type GeneratePluginDataTypeToProtoType(
+    GeneratePluginDataType data_type);
+
 void BuildPhiKernelContextAttr(const framework::OpDesc& op_desc,
                                phi::KernelContext* kernel_context,
                                const phi::KernelSignature& signature,
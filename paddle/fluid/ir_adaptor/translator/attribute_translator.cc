@@ -14,6 +14,10 @@
 
 #include "paddle/fluid/ir_adaptor/translator/attribute_translator.h"
 
+#include <array>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -267,7 +271,111 @@ class BoolAttributeVisitor : public AttributeVisitor {
   }
 };
 
+// Appends the type and the bytes of the attributes of plain values to the
+// key, and returns false for the others.
+class AttributeKeyVisitor {
+ public:
+  explicit AttributeKeyVisitor(std::string* key) : key_(key) {}
+
+  bool operator()(int i) { return Append(&i, sizeof(i)); }
+
+  bool operator()(int64_t i) { return Append(&i, sizeof(i)); }
+
+  bool operator()(float f) { return Append(&f, sizeof(f)); }
+
+  bool operator()(bool b) { return Append(&b, sizeof(b)); }
+
+  bool operator()(double d) { return Append(&d, sizeof(d)); }
+
+  bool operator()(const std::string& str) {
+    return Append(str.data(), str.size());
+  }
+
+  bool operator()(const std::vector<std::string>& strs) {
+    for (const auto& str : strs) {
+      size_t size = str.size();
+      Append(&size, sizeof(size));
+      Append(str.data(), size);
+    }
+    return true;
+  }
+
+  bool operator()(const std::vector<float>& fs) {
+    return Append(fs.data(), fs.size() * sizeof(float));
+  }
+
+  bool operator()(const std::vector<int>& is) {
+    return Append(is.data(), is.size() * sizeof(int));
+  }
+
+  bool operator()(const std::vector<bool>& bs) {
+    for (bool b : bs) {
+      key_->push_back(b ? '1' : '0');
+    }
+    return true;
+  }
+
+  bool operator()(const std::vector<int64_t>& i64s) {
+    return Append(i64s.data(), i64s.size() * sizeof(int64_t));
+  }
+
+  bool operator()(const std::vector<double>& ds) {
+    return Append(ds.data(), ds.size() * sizeof(double));
+  }
+
+  bool operator()(const paddle::blank& blank) { return true; }
+
+  template <typename T>
+  bool operator()(const T& attr) {
+    return false;
+  }
+
+ private:
+  bool Append(const void* data, size_t size) {
+    key_->append(static_cast<const char*>(data), size);
+    return true;
+  }
+
+  std::string* key_;
+};
+
+class AttributeCache {
+ public:
+  // The larger values, e.g. the weights of assign_value, are seldom the
+  // same, and not cached.
+  static constexpr size_t kMaxKeySize = 4096;
+
+  pir::Attribute GetOrTranslate(
+      const std::string& key,
+      const std::function<pir::Attribute()>& translate) {
+    Stripe& stripe = stripes_[std::hash<std::string>()(key) % kNumStripes];
+    {
+      std::shared_lock<std::shared_mutex> guard(stripe.mutex);
+      auto iter = stripe.attributes.find(key);
+      if (iter != stripe.attributes.end()) {
+        return iter->second;
+      }
+    }
+    // The attributes are unique in the IrContext, so that the threads
+    // translating the same value at the same time get the same one.
+    pir::Attribute attr = translate();
+    std::unique_lock<std::shared_mutex> guard(stripe.mutex);
+    stripe.attributes.emplace(key, attr);
+    return attr;
+  }
+
+ private:
+  struct Stripe {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, pir::Attribute> attributes;
+  };
+  static constexpr size_t kNumStripes = 16;
+
+  std::array<Stripe, kNumStripes> stripes_;
+};
+
 AttributeTranslator::AttributeTranslator() {
+  cache = new AttributeCache();
   general_visitor = new AttributeVisitor();
   special_visitors["paddle::dialect::IntArrayAttribute"] =
       new IntArrayAttributeVisitor();
@@ -283,18 +391,55 @@ AttributeTranslator::AttributeTranslator() {
   special_visitors["pir::BoolAttribute"] = new BoolAttributeVisitor();
 }
 
+// The key of attr in the cache, false if it is not cached.
+static bool GetAttributeKey(const std::string& visitor_name,
+                            const framework::Attribute& attr,
+                            std::string* key) {
+  *key = visitor_name;
+  key->push_back('\0');
+  key->push_back(static_cast<char>(attr.index()));
+  AttributeKeyVisitor key_visitor(key);
+  return paddle::visit(key_visitor, attr) &&
+         key->size() <= AttributeCache::kMaxKeySize;
+}
+
+pir::Attribute AttributeTranslator::Translate(
+    const std::string& visitor_name,
+    AttributeVisitor* visitor,
+    const framework::Attribute& attr) {
+  std::string key;
+  if (!GetAttributeKey(visitor_name, attr, &key)) {
+    return paddle::visit(*visitor, attr);
+  }
+  return cache->GetOrTranslate(
+      key, [&]() { return paddle::visit(*visitor, attr); });
+}
+
 pir::Attribute AttributeTranslator::operator()(
     const framework::Attribute& attr) {
-  return paddle::visit(*general_visitor, attr);
+  return Translate("", general_visitor, attr);
 }
 
 pir::Attribute AttributeTranslator::operator()(
     const std::string& target_type, const framework::Attribute& attr) {
   if (special_visitors.find(target_type) == special_visitors.end()) {
     VLOG(10) << "[" << target_type << "] not found";
-    return paddle::visit(*general_visitor, attr);
+    return Translate("", general_visitor, attr);
+  }
+  return Translate(target_type, special_visitors.at(target_type), attr);
+}
+
+void AttributeTranslator::Prefetch(const framework::Attribute& attr) {
+  std::string key;
+  if (!GetAttributeKey("", attr, &key)) {
+    return;
+  }
+  try {
+    cache->GetOrTranslate(
+        key, [&]() { return paddle::visit(*general_visitor, attr); });
+  } catch (const std::exception& e) {
+    VLOG(10) << "failed to prefetch an attribute: " << e.what();
   }
-  return paddle::visit(*(special_visitors.at(target_type)), attr);
 }
 
 }  // namespace translator
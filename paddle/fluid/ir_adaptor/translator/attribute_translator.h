@@ -27,12 +27,20 @@ namespace paddle {
 namespace translator {
 
 class AttributeVisitor;
+class AttributeCache;
 
 class AttributeTranslator {
  private:
   TEST_API AttributeTranslator();
   AttributeVisitor* general_visitor;
   std::unordered_map<std::string, AttributeVisitor*> special_visitors;
+  // The attributes of plain values translated before, by the visitor and
+  // the value, shared by the threads.
+  AttributeCache* cache;
+
+  pir::Attribute Translate(const std::string& visitor_name,
+                           AttributeVisitor* visitor,
+                           const framework::Attribute& attr);
 
  public:
   AttributeTranslator(const AttributeTranslator&) = delete;
@@ -48,6 +56,11 @@ class AttributeTranslator {
   TEST_API pir::Attribute operator()(const framework::Attribute& attr);
   TEST_API pir::Attribute operator()(const std::string& target_type,
                                      const framework::Attribute& attr);
+
+  // Translate attr into the cache if it is of a plain value, so that the
+  // later translation of it is a lookup. It is thread safe and ignores the
+  // errors, which the later translation raises.
+  TEST_API void Prefetch(const framework::Attribute& attr);
 };
 
 }  // namespace translator
@@ -14,11 +14,14 @@
 
 #include "paddle/fluid/ir_adaptor/translator/program_translator.h"
 
+#include <algorithm>
 #include <chrono>
+#include <thread>
 #include <unordered_map>
 
 #include "glog/logging.h"
 #include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/program_desc.h"
 #include "paddle/fluid/framework/var_desc.h"
 #include "paddle/fluid/ir_adaptor/translator/attribute_translator.h"
@@ -41,6 +44,8 @@
 #include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
 #include "paddle/pir/include/dialect/control_flow/ir/cf_type.h"
 
+COMMON_DECLARE_int32(program_translator_num_threads);
+
 namespace paddle::translator {
 
 using ProgramDesc = ::paddle::framework::ProgramDesc;
@@ -166,12 +171,15 @@ ProgramTranslator::ProgramTranslator(const ProgramDesc* legacy_program,
 }
 
 void ProgramTranslator::Translate() {
+  pir::OperationArenaGuard arena_guard(program_->arena());
   GetParameterForSingleBlock(legacy_program_->Block(0));
 
   InsertDataOpForSingleBlock(legacy_program_->Block(0));
 
   PreAnalysisForCond();
 
+  PrefetchAttributes();
+
   TranslateBlock(legacy_program_->Block(0),
                  0,
                  legacy_program_->Block(0).OpSize(),
@@ -191,6 +199,42 @@ void ProgramTranslator::Translate() {
   }
 }
 
+void ProgramTranslator::PrefetchAttributes() {
+  // The fewer ops are not worth the threads.
+  constexpr size_t kMinOpsPerThread = 4096;
+  std::vector<const OpDesc*> ops;
+  for (size_t block_idx = 0; block_idx < legacy_program_->Size(); block_idx++) {
+    const BlockDesc& block = legacy_program_->Block(block_idx);
+    for (auto* op : block.AllOps()) {
+      ops.push_back(op);
+    }
+  }
+  size_t num_threads = FLAGS_program_translator_num_threads > 0
+                           ? FLAGS_program_translator_num_threads
+                           : std::thread::hardware_concurrency();
+  num_threads = std::min(num_threads, ops.size() / kMinOpsPerThread);
+  if (num_threads <= 1) {
+    return;
+  }
+  VLOG(6) << "prefetch the attributes of " << ops.size() << " ops by "
+          << num_threads << " threads";
+  auto& attribute_translator = AttributeTranslator::instance();
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t thread_idx = 0; thread_idx < num_threads; thread_idx++) {
+    threads.emplace_back([&, thread_idx]() {
+      for (size_t i = thread_idx; i < ops.size(); i += num_threads) {
+        for (const auto& attr_pair : ops[i]->GetAttrMap()) {
+          attribute_translator.Prefetch(attr_pair.second);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 void ProgramTranslator::TranslateBlock(const BlockDesc& src_block,
                                        uint64_t start_id,
                                        uint64_t end_id,
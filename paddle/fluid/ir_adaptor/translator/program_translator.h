@@ -142,6 +142,9 @@ class ProgramTranslator {
   std::unordered_map<const OpDesc*, std::vector<pir::Value>>
       cond_to_stack_value_;
   void PreAnalysisForCond();
+  // Translate the attributes of all the ops by several threads, so that the
+  // translation of the ops, which is sequential, looks them up.
+  void PrefetchAttributes();
   void TranslateIfOperation(const OpDesc* op,
                             TranslationContext* translation_ctx,
                             pir::Block* dst_block,
@@ -0,0 +1,115 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/jit/param_store.h"
+
+#include <xxhash.h>
+
+#include <cstring>
+#include <vector>
+
+#include "paddle/fluid/framework/tensor_util.h"
+#include "paddle/fluid/framework/variable.h"
+
+namespace paddle {
+namespace jit {
+
+namespace {
+
+uint64_t ContentHash(const DenseTensor& tensor, const phi::Place& place) {
+  size_t bytes = tensor.numel() * phi::SizeOf(tensor.dtype());
+  uint64_t hash = bytes == 0 ? 0 : XXH64(tensor.data(), bytes, 0);
+  std::vector<int64_t> meta = common::vectorize(tensor.dims());
+  meta.push_back(static_cast<int64_t>(tensor.dtype()));
+  meta.push_back(static_cast<int64_t>(place.GetType()));
+  meta.push_back(place.GetDeviceId());
+  return XXH64(meta.data(), meta.size() * sizeof(int64_t), hash);
+}
+
+// Whether the shared tensor is cpu_tensor on place, the hashes being equal.
+bool SameParam(const DenseTensor& shared,
+               const DenseTensor& cpu_tensor,
+               const phi::Place& place) {
+  if (shared.place() != place || shared.dtype() != cpu_tensor.dtype() ||
+      shared.dims() != cpu_tensor.dims()) {
+    return false;
+  }
+  const DenseTensor* host = &shared;
+  DenseTensor host_copy;
+  if (!phi::is_cpu_place(place)) {
+    framework::TensorCopySync(shared, phi::CPUPlace(), &host_copy);
+    host = &host_copy;
+  }
+  size_t bytes = cpu_tensor.numel() * phi::SizeOf(cpu_tensor.dtype());
+  return bytes == 0 || std::memcmp(host->data(), cpu_tensor.data(), bytes) == 0;
+}
+
+}  // namespace
+
+ParamStore& ParamStore::Instance() {
+  static ParamStore store;
+  return store;
+}
+
+std::shared_ptr<Variable> ParamStore::Share(const DenseTensor& cpu_tensor,
+                                            const phi::Place& place) {
+  PADDLE_ENFORCE_EQ(
+      phi::is_cpu_place(cpu_tensor.place()),
+      true,
+      common::errors::InvalidArgument(
+          "The parameter to share should be read to CPU first."));
+  uint64_t hash = ContentHash(cpu_tensor, place);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = params_.equal_range(hash);
+  for (auto it = range.first; it != range.second;) {
+    auto var = it->second.lock();
+    if (var == nullptr) {
+      it = params_.erase(it);
+      continue;
+    }
+    if (SameParam(var->Get<DenseTensor>(), cpu_tensor, place)) {
+      VLOG(3) << "Share the parameter of hash " << hash;
+      return var;
+    }
+    ++it;
+  }
+
+  auto var = std::make_shared<Variable>();
+  auto* tensor = var->GetMutable<DenseTensor>();
+  if (phi::is_cpu_place(place)) {
+    *tensor = cpu_tensor;
+  } else {
+    framework::TensorCopySync(cpu_tensor, place, tensor);
+  }
+  params_.emplace(hash, var);
+  return var;
+}
+
+size_t ParamStore::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t size = 0;
+  for (auto it = params_.begin(); it != params_.end();) {
+    if (it->second.expired()) {
+      it = params_.erase(it);
+    } else {
+      ++size;
+      ++it;
+    }
+  }
+  return size;
+}
+
+}  // namespace jit
+}  // namespace paddle
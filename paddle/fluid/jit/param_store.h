@@ -0,0 +1,60 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace paddle {
+
+namespace framework {
+class Variable;
+}  // namespace framework
+
+namespace jit {
+using DenseTensor = phi::DenseTensor;
+using Variable = paddle::framework::Variable;
+
+// The parameters shared by the layers loaded in a process. A parameter read
+// by a layer is looked up by the hash of its content, so the layers loading
+// the same weights, and their engines, alias one tensor on each place
+// instead of holding a copy each. The shared tensors are immutable: they
+// must not be modified in place. The store keeps weak references only, a
+// tensor is freed with the last layer using it.
+class ParamStore {
+ public:
+  static ParamStore& Instance();
+
+  // The variable of a tensor on place equal to cpu_tensor, in dtype, dims
+  // and content. cpu_tensor is copied to place and kept if there is none.
+  std::shared_ptr<Variable> Share(const DenseTensor& cpu_tensor,
+                                  const phi::Place& place);
+
+  // The number of tensors in the store still used by a layer.
+  size_t Size();
+
+ private:
+  ParamStore() = default;
+
+  std::mutex mutex_;
+  std::unordered_multimap<uint64_t, std::weak_ptr<Variable>> params_;
+};
+
+}  // namespace jit
+}  // namespace paddle
@@ -19,17 +19,20 @@
 #include "paddle/fluid/framework/var_desc.h"
 #include "paddle/fluid/framework/variable.h"
 #include "paddle/fluid/jit/engine/pir_interpreter_engine.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/flat_params.h"
 #include "paddle/phi/core/platform/device_context.h"
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/jit/engine/interpreter_engine.h"
 #include "paddle/fluid/jit/engine/predictor_engine.h"
 #include "paddle/fluid/jit/layer.h"
+#include "paddle/fluid/jit/param_store.h"
 #include "paddle/fluid/jit/property.h"
 #include "paddle/fluid/jit/serializer_utils.h"
 
 COMMON_DECLARE_string(jit_engine_type);
 COMMON_DECLARE_bool(enable_pir_api);
+COMMON_DECLARE_bool(jit_share_params);
 namespace paddle {
 namespace jit {
 
@@ -128,16 +131,34 @@ void Deserializer::ReadTensorData(
     const phi::Place& place,
     std::shared_ptr<VariableMap> params_dict) const {
   VLOG(3) << "ReadTensorData from: " << file_name;
-  std::ifstream fin(file_name, std::ios::binary);
   phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
-  auto& dev_ctx = *pool.Get(place);
+  // The shared parameters are read to CPU to be looked up by their content,
+  // and copied to place only if they are not in the store.
+  auto& dev_ctx = *pool.Get(FLAGS_jit_share_params ? phi::CPUPlace() : place);
+  auto add_param = [&](const std::string& name, const Variable& v) {
+    (*params_dict)[name] =
+        FLAGS_jit_share_params
+            ? ParamStore::Instance().Share(v.Get<DenseTensor>(), place)
+            : std::make_shared<Variable>(v);
+  };
+  if (pir::FlatParamsFile::Match(file_name)) {
+    pir::FlatParamsFile flat_file(file_name);
+    for (const auto& item : var_name) {
+      VLOG(3) << "load Tensor: " << item;
+      Variable v;
+      flat_file.Read(item, v.GetMutable<DenseTensor>(), dev_ctx);
+      add_param(item, v);
+    }
+    return;
+  }
+  std::ifstream fin(file_name, std::ios::binary);
   for (const auto& item : var_name) {
     VLOG(3) << "load Tensor: " << item;
     Variable v;
     // TODO(dev): Support framework::Vocab
     DenseTensor* dense_tensor = v.GetMutable<DenseTensor>();
     framework::DeserializeFromStream(fin, dense_tensor, dev_ctx);
-    (*params_dict)[item] = std::make_shared<Variable>(v);
+    add_param(item, v);
   }
 }
 
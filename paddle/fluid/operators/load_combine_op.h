@@ -18,14 +18,18 @@ limitations under the License. */
 #include <string>
 #include <vector>
 
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/framework/data_type.h"
 #include "paddle/fluid/framework/data_type_transform.h"
+#include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/tensor_util.h"
 #include "paddle/phi/core/platform/device_context.h"
 #include "paddle/phi/core/vocab/string_array.h"
 
+COMMON_DECLARE_bool(mmap_params_zero_copy);
+
 namespace paddle {
 namespace operators {
 template <typename T, typename DeviceContext>
@@ -44,7 +48,11 @@ class LoadCombineOpKernel : public framework::OpKernel<T> {
                           "The number of variables to be loaded is %d, expect "
                           "it to be greater than 0.",
                           out_var_names.size()));
-    if (!model_from_memory) {
+    if (!model_from_memory && framework::UseMappedTensorFile() &&
+        !HasVocabOutput(ctx)) {
+      LoadParamsFromMappedFile(
+          ctx, place, filename, load_as_fp16, out_var_names);
+    } else if (!model_from_memory) {
       std::ifstream fin(filename, std::ios::binary);
       PADDLE_ENFORCE_EQ(
           static_cast<bool>(fin),
@@ -115,28 +123,7 @@ class LoadCombineOpKernel : public framework::OpKernel<T> {
 
         // Get data from fin to tensor
         paddle::framework::DeserializeFromStream(*buffer, tensor, dev_ctx);
-
-        auto in_dtype = tensor->dtype();
-        auto out_dtype = load_as_fp16 ? phi::DataType::FLOAT16 : in_dtype;
-
-        if (in_dtype != out_dtype) {
-          // convert to float16 tensor
-          auto in_kernel_type =
-              phi::KernelKey(place, phi::DataLayout::ALL_LAYOUT, in_dtype);
-          auto out_kernel_type =
-              phi::KernelKey(place, phi::DataLayout::ALL_LAYOUT, out_dtype);
-          phi::DenseTensor fp16_tensor;
-          // copy LoD info to the new tensor
-          fp16_tensor.set_lod(tensor->lod());
-          framework::TransDataType(
-              in_kernel_type, out_kernel_type, *tensor, &fp16_tensor);
-
-          // reset output tensor
-          out_vars[i]->Clear();
-          tensor = out_vars[i]->GetMutable<phi::DenseTensor>();
-          tensor->set_lod(fp16_tensor.lod());
-          tensor->ShareDataWith(fp16_tensor);
-        }
+        CastToFP16IfNeeded(place, load_as_fp16, out_vars[i]);
       }
     }
     buffer->peek();
@@ -146,6 +133,71 @@ class LoadCombineOpKernel : public framework::OpKernel<T> {
                           "Not allowed to load partial data via "
                           "load_combine_op, please use load_op instead."));
   }
+
+  void LoadParamsFromMappedFile(
+      const framework::ExecutionContext &context,
+      const phi::Place &place,
+      const std::string &filename,
+      bool load_as_fp16,
+      const std::vector<std::string> &out_var_names) const {
+    phi::DeviceContextPool &pool = phi::DeviceContextPool::Instance();
+    auto &dev_ctx = *pool.Get(place);
+    auto out_vars = context.MultiOutputVar("Out");
+    framework::MappedTensorFile file(filename, FLAGS_mmap_params_zero_copy);
+
+    for (size_t i = 0; i < out_var_names.size(); i++) {
+      VLOG(4) << "loading tensor: " << out_var_names[i];
+      PADDLE_ENFORCE_NOT_NULL(
+          out_vars[i],
+          common::errors::InvalidArgument(
+              "The variable %s to be loaded cannot be found.",
+              out_var_names[i]));
+      file.Next(out_vars[i]->GetMutable<phi::DenseTensor>(), dev_ctx);
+      CastToFP16IfNeeded(place, load_as_fp16, out_vars[i]);
+    }
+    PADDLE_ENFORCE_EQ(file.AtEnd(),
+                      true,
+                      common::errors::Unavailable(
+                          "Not allowed to load partial data via "
+                          "load_combine_op, please use load_op instead."));
+  }
+
+ private:
+  static bool HasVocabOutput(const framework::ExecutionContext &context) {
+    for (auto *var : context.MultiOutputVar("Out")) {
+      if (var != nullptr && var->IsType<framework::Vocab>()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void CastToFP16IfNeeded(const phi::Place &place,
+                                 bool load_as_fp16,
+                                 framework::Variable *var) {
+    auto *tensor = var->GetMutable<phi::DenseTensor>();
+    auto in_dtype = tensor->dtype();
+    auto out_dtype = load_as_fp16 ? phi::DataType::FLOAT16 : in_dtype;
+
+    if (in_dtype != out_dtype) {
+      // convert to float16 tensor
+      auto in_kernel_type =
+          phi::KernelKey(place, phi::DataLayout::ALL_LAYOUT, in_dtype);
+      auto out_kernel_type =
+          phi::KernelKey(place, phi::DataLayout::ALL_LAYOUT, out_dtype);
+      phi::DenseTensor fp16_tensor;
+      // copy LoD info to the new tensor
+      fp16_tensor.set_lod(tensor->lod());
+      framework::TransDataType(
+          in_kernel_type, out_kernel_type, *tensor, &fp16_tensor);
+
+      // reset output tensor
+      var->Clear();
+      tensor = var->GetMutable<phi::DenseTensor>();
+      tensor->set_lod(fp16_tensor.lod());
+      tensor->ShareDataWith(fp16_tensor);
+    }
+  }
 };
 
 }  // namespace operators
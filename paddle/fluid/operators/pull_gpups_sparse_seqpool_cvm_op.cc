@@ -0,0 +1,205 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/operators/pull_gpups_sparse_seqpool_cvm_op.h"
+
+namespace paddle {
+namespace operators {
+
+class PullGpuPSSparseSeqpoolCVMOp : public framework::OperatorWithKernel {
+ public:
+  using framework::OperatorWithKernel::OperatorWithKernel;
+  void InferShape(framework::InferShapeContext* ctx) const override {
+    PADDLE_ENFORCE_GE(
+        ctx->Inputs("Ids").size(),
+        1UL,
+        common::errors::InvalidArgument(
+            "Inputs(Ids) of PullGpuPSSparseSeqpoolCVMOp should not be "
+            "empty."));
+    PADDLE_ENFORCE_EQ(
+        ctx->Outputs("Out").size(),
+        ctx->Inputs("Ids").size(),
+        common::errors::InvalidArgument(
+            "The size of Outputs(Out) of PullGpuPSSparseSeqpoolCVMOp should "
+            "be equal to the size of Inputs(Ids)."));
+    auto embedding_size_vec = ctx->Attrs().Get<std::vector<int>>("size");
+    PADDLE_ENFORCE_EQ(
+        ctx->Inputs("Ids").size(),
+        embedding_size_vec.size(),
+        common::errors::InvalidArgument("The ids size: %lu must be equal to "
+                                        "the length of embedding size: %lu.",
+                                        ctx->Inputs("Ids").size(),
+                                        embedding_size_vec.size()));
+    bool use_cvm = ctx->Attrs().Get<bool>("use_cvm");
+    int cvm_offset = ctx->Attrs().Get<int>("cvm_offset");
+    auto cvm_dims = ctx->GetInputDim("CVM");
+    PADDLE_ENFORCE_EQ(
+        cvm_dims.size(),
+        2UL,
+        common::errors::InvalidArgument("Input(CVM)'s rank should be 2."));
+    PADDLE_ENFORCE_EQ(cvm_dims[1],
+                      cvm_offset,
+                      common::errors::InvalidArgument(
+                          "The second dimension of Input(CVM) should be "
+                          "equal to the attr cvm_offset %d.",
+                          cvm_offset));
+    auto all_ids_dim = ctx->GetInputsDim("Ids");
+    const size_t n_ids = all_ids_dim.size();
+    std::vector<phi::DDim> outs_dims;
+    outs_dims.resize(n_ids);
+    for (size_t i = 0; i < n_ids; ++i) {
+      const auto ids_dims = all_ids_dim[i];
+      int ids_rank = ids_dims.size();
+      PADDLE_ENFORCE_EQ(ids_dims[ids_rank - 1],
+                        1,
+                        common::errors::InvalidArgument(
+                            "Shape error in %lu id, the last dimension of the "
+                            "'Ids' tensor must be 1.",
+                            i));
+      PADDLE_ENFORCE_GT(embedding_size_vec[i],
+                        cvm_offset,
+                        common::errors::InvalidArgument(
+                            "The embedding size of the %lu-th slot should be "
+                            "greater than cvm_offset %d.",
+                            i,
+                            cvm_offset));
+      // one pooled row per instance, resized by the kernel as the batch
+      // size is known from the lod of the Ids only
+      int out_dim = use_cvm ? embedding_size_vec[i]
+                            : embedding_size_vec[i] - cvm_offset;
+      outs_dims[i] = common::make_ddim({-1, out_dim});
+    }
+    ctx->SetOutputsDim("Out", outs_dims);
+  }
+
+ protected:
+  phi::KernelKey GetExpectedKernelType(
+      const framework::ExecutionContext& ctx) const override {
+    return phi::KernelKey(framework::proto::VarType::FP32, ctx.GetPlace());
+  }
+};
+
+class PullGpuPSSparseSeqpoolCVMOpMaker
+    : public framework::OpProtoAndCheckerMaker {
+ public:
+  void Make() override {
+    AddInput("W",
+             "(Tensor) The input represents embedding tensors, "
+             "which is a learnable parameter.")
+        .AsDispensable();
+    AddInput("Ids",
+             "Input LoDTensors with type int64 "
+             "contains the ids to be looked up in GpuPS, "
+             "one sequence of ids per instance. "
+             "The last dimension size must be 1.")
+        .AsDuplicable();
+    AddInput("CVM",
+             "(Tensor) The show and click of each instance, "
+             "a 2-D Tensor with shape [N, cvm_offset], "
+             "used by the gradient only.");
+    AddOutput("Out",
+              "The sum pooled lookup results of each instance, "
+              "with the cvm applied to the first cvm_offset dims.")
+        .AsDuplicable();
+    AddAttr<std::vector<int>>(
+        "size", "(vector<int>, the embedding size of corresponding slot")
+        .SetDefault(std::vector<int>());
+    AddAttr<float>("pad_value",
+                   "(float, default 0.0) The value the sum pooling of each "
+                   "instance starts from.")
+        .SetDefault(0.0);
+    AddAttr<bool>("use_cvm",
+                  "(boolean, default true) Whether to apply the cvm to the "
+                  "first cvm_offset dims, or to drop them.")
+        .SetDefault(true);
+    AddAttr<int>("cvm_offset", "(int, default 2) The size of the cvm.")
+        .SetDefault(2);
+    AddAttr<bool>("is_sparse",
+                  "(boolean, default false) "
+                  "Sparse update.")
+        .SetDefault(false);
+    AddAttr<bool>("is_distributed",
+                  "(boolean, default false) distributed lookup table.")
+        .SetDefault(false);
+    AddComment(R"DOC(
+Pull GpuPS Sparse Seqpool CVM Operator.
+
+This operator performs lookups on the GpuPS as pull_gpups_sparse, then
+sums the embeddings of the ids of each instance and applies the cvm as
+fused_seqpool_cvm with pooltype SUM. The ids of all the slots are deduped
+together and the pooled embeddings are written right into Out, without
+the embedding of each id in between.
+
+The input Ids must carry the LoD of one level, one sequence per instance.
+
+)DOC");
+  }
+};
+
+template <typename T>
+class PushGpuPSSparseSeqpoolCVMOpMaker
+    : public framework::SingleGradOpMaker<T> {
+ public:
+  using framework::SingleGradOpMaker<T>::SingleGradOpMaker;
+
+ protected:
+  void Apply(GradOpPtr<T> op) const override {
+    op->SetType("push_gpups_sparse_seqpool_cvm");
+    op->SetInput("Ids", this->Input("Ids"));
+    op->SetInput("CVM", this->Input("CVM"));
+    op->SetInput(framework::GradVarName("Out"), this->OutputGrad("Out"));
+    op->SetOutput(framework::GradVarName("Out"), this->OutputGrad("Out"));
+    op->SetAttrMap(this->Attrs());
+  }
+};
+
+class PushGpuPSSparseSeqpoolCVMOp : public framework::OperatorWithKernel {
+ public:
+  using framework::OperatorWithKernel::OperatorWithKernel;
+
+  void InferShape(framework::InferShapeContext* ctx) const override {}
+
+ protected:
+  phi::KernelKey GetExpectedKernelType(
+      const framework::ExecutionContext& ctx) const override {
+    return phi::KernelKey(OperatorWithKernel::IndicateVarDataType(
+                              ctx, framework::GradVarName("Out")),
+                          ctx.GetPlace());
+  }
+};
+}  // namespace operators
+}  // namespace paddle
+
+namespace ops = paddle::operators;
+REGISTER_OPERATOR(
+    pull_gpups_sparse_seqpool_cvm,
+    ops::PullGpuPSSparseSeqpoolCVMOp,
+    ops::PullGpuPSSparseSeqpoolCVMOpMaker,
+    ops::PushGpuPSSparseSeqpoolCVMOpMaker<paddle::framework::OpDesc>,
+    ops::PushGpuPSSparseSeqpoolCVMOpMaker<paddle::imperative::OpBase>);
+REGISTER_OPERATOR(push_gpups_sparse_seqpool_cvm,
+                  ops::PushGpuPSSparseSeqpoolCVMOp);
+
+PD_REGISTER_STRUCT_KERNEL(pull_gpups_sparse_seqpool_cvm,
+                          CPU,
+                          ALL_LAYOUT,
+                          ops::PullGpuPSSparseSeqpoolCVMCPUKernel,
+                          float,
+                          double) {}
+PD_REGISTER_STRUCT_KERNEL(push_gpups_sparse_seqpool_cvm,
+                          CPU,
+                          ALL_LAYOUT,
+                          ops::PushGpuPSSparseSeqpoolCVMCPUKernel,
+                          float,
+                          double) {}
@@ -0,0 +1,50 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/operators/pull_gpups_sparse_seqpool_cvm_op.h"
+
+namespace paddle {
+namespace operators {
+
+template <typename T, typename DeviceContext>
+class PullGpuPSSparseSeqpoolCVMCUDAKernel : public framework::OpKernel<T> {
+ public:
+  void Compute(const framework::ExecutionContext &ctx) const override {
+    PullGpuPSSparseSeqpoolCVMFunctor<T>(ctx);
+  }
+};
+
+template <typename T, typename DeviceContext>
+class PushGpuPSSparseSeqpoolCVMCUDAKernel : public framework::OpKernel<T> {
+ public:
+  void Compute(const framework::ExecutionContext &ctx) const override {
+    PushGpuPSSparseSeqpoolCVMFunctor<T>(ctx);
+  }
+};
+}  // namespace operators
+}  // namespace paddle
+
+namespace ops = paddle::operators;
+PD_REGISTER_STRUCT_KERNEL(pull_gpups_sparse_seqpool_cvm,
+                          GPU,
+                          ALL_LAYOUT,
+                          ops::PullGpuPSSparseSeqpoolCVMCUDAKernel,
+                          float,
+                          double) {}
+PD_REGISTER_STRUCT_KERNEL(push_gpups_sparse_seqpool_cvm,
+                          GPU,
+                          ALL_LAYOUT,
+                          ops::PushGpuPSSparseSeqpoolCVMCUDAKernel,
+                          float,
+                          double) {}
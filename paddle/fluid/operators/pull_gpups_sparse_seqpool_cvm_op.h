@@ -0,0 +1,163 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "paddle/fluid/framework/fleet/ps_gpu_wrapper.h"
+#include "paddle/fluid/framework/op_registry.h"
+#include "paddle/fluid/framework/tensor.h"
+
+namespace paddle {
+namespace operators {
+
+// The key offsets of the instances of all the slots in the keys of all the
+// slots, slot_size * (batch_size + 1) of them, from the lod of the Ids.
+static std::vector<size_t> GetInsOffsets(
+    const std::vector<const phi::DenseTensor *> &inputs, int *batch_size) {
+  std::vector<size_t> ins_offsets;
+  size_t slot_start = 0;
+  *batch_size = -1;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const auto *slot = inputs[i];
+    PADDLE_ENFORCE_EQ(slot->lod().size(),
+                      1UL,
+                      common::errors::InvalidArgument(
+                          "The Ids of pull_gpups_sparse_seqpool_cvm should "
+                          "have a lod of one level, but the %lu-th has %lu.",
+                          i,
+                          slot->lod().size()));
+    const auto &lod = slot->lod()[0];
+    int cur_batch_size = static_cast<int>(lod.size()) - 1;
+    if (*batch_size == -1) {
+      *batch_size = cur_batch_size;
+    } else {
+      PADDLE_ENFORCE_EQ(*batch_size,
+                        cur_batch_size,
+                        common::errors::PreconditionNotMet(
+                            "The batch size of all input slots should be same, "
+                            "please check"));
+    }
+    for (size_t offset : lod) {
+      ins_offsets.push_back(slot_start + offset);
+    }
+    slot_start += slot->numel();
+  }
+  return ins_offsets;
+}
+
+template <typename T>
+static void PullGpuPSSparseSeqpoolCVMFunctor(
+    const framework::ExecutionContext &ctx) {
+  auto inputs = ctx.MultiInput<phi::DenseTensor>("Ids");
+  auto outputs = ctx.MultiOutput<phi::DenseTensor>("Out");
+  auto embedding_size_vec = ctx.Attr<std::vector<int>>("size");
+  auto use_cvm = ctx.Attr<bool>("use_cvm");
+  auto cvm_offset = ctx.Attr<int>("cvm_offset");
+  const auto slot_size = inputs.size();
+  int batch_size = -1;
+  std::vector<size_t> ins_offsets = GetInsOffsets(inputs, &batch_size);
+  std::vector<const uint64_t *> all_keys(slot_size);
+  // GpuPS only supports float now
+  std::vector<float *> all_values(slot_size);
+  std::vector<int64_t> slot_lengths(slot_size);
+  for (size_t i = 0; i < slot_size; i++) {
+    const auto *slot = inputs[i];
+    const uint64_t *single_slot_keys =
+        reinterpret_cast<const uint64_t *>(slot->data<int64_t>());
+    all_keys[i] = single_slot_keys;
+    slot_lengths[i] = slot->numel();
+    int out_dim = use_cvm ? embedding_size_vec[i]
+                          : embedding_size_vec[i] - cvm_offset;
+    outputs[i]->Resize({batch_size, out_dim});
+    auto *output = outputs[i]->mutable_data<T>(ctx.GetPlace());
+    // double type is not fully supported now
+    all_values[i] = reinterpret_cast<float *>(output);
+  }
+#ifdef PADDLE_WITH_HETERPS
+  auto pad_value = ctx.Attr<float>("pad_value");
+  auto gpu_ps_ptr = paddle::framework::PSGPUWrapper::GetInstance();
+  gpu_ps_ptr->PullSparseSeqpoolCVM(ctx.GetPlace(),
+                                   all_keys,
+                                   all_values,
+                                   slot_lengths,
+                                   embedding_size_vec,
+                                   ins_offsets,
+                                   batch_size,
+                                   pad_value,
+                                   use_cvm,
+                                   cvm_offset);
+#endif
+}
+
+template <typename T>
+static void PushGpuPSSparseSeqpoolCVMFunctor(
+    const framework::ExecutionContext &ctx) {
+  auto inputs = ctx.MultiInput<phi::DenseTensor>("Ids");
+  auto d_output =
+      ctx.MultiInput<phi::DenseTensor>(framework::GradVarName("Out"));
+  const auto slot_size = inputs.size();
+  std::vector<const float *> all_grad_values(slot_size);
+  std::vector<int64_t> slot_lengths(slot_size);
+  int batch_size = -1;
+  for (size_t i = 0; i < slot_size; i++) {
+    const auto *slot = inputs[i];
+    slot_lengths[i] = slot->numel();
+    int cur_batch_size =
+        slot->lod().size() ? slot->lod()[0].size() - 1 : slot->dims()[0];
+    if (batch_size == -1) {
+      batch_size = cur_batch_size;
+    } else {
+      PADDLE_ENFORCE_EQ(batch_size,
+                        cur_batch_size,
+                        common::errors::PreconditionNotMet(
+                            "The batch size of all input slots should be same, "
+                            "please check"));
+    }
+    const float *grad_value = d_output[i]->data<float>();
+    all_grad_values[i] = grad_value;
+  }
+#ifdef PADDLE_WITH_HETERPS
+  const auto *cvm = ctx.Input<phi::DenseTensor>("CVM");
+  auto use_cvm = ctx.Attr<bool>("use_cvm");
+  auto cvm_offset = ctx.Attr<int>("cvm_offset");
+  auto gpu_ps_ptr = paddle::framework::PSGPUWrapper::GetInstance();
+  gpu_ps_ptr->PushSparseGradSeqpoolCVM(ctx.GetPlace(),
+                                       all_grad_values,
+                                       cvm->data<float>(),
+                                       slot_lengths,
+                                       batch_size,
+                                       use_cvm,
+                                       cvm_offset);
+#endif
+}
+
+template <typename T, typename DeviceContext>
+class PullGpuPSSparseSeqpoolCVMCPUKernel : public framework::OpKernel<T> {
+ public:
+  void Compute(const framework::ExecutionContext &ctx) const override {
+    PullGpuPSSparseSeqpoolCVMFunctor<T>(ctx);
+  }
+};
+
+template <typename T, typename DeviceContext>
+class PushGpuPSSparseSeqpoolCVMCPUKernel : public framework::OpKernel<T> {
+ public:
+  void Compute(const framework::ExecutionContext &ctx) const override {
+    PushGpuPSSparseSeqpoolCVMFunctor<T>(ctx);
+  }
+};
+}  // namespace operators
+}  // namespace paddle
@@ -15,15 +15,24 @@
 #pragma once
 
 #ifdef PADDLE_WITH_CUDA
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "paddle/common/errors.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/data_device_transform.h"
 #include "paddle/fluid/framework/executor.h"
 #include "paddle/fluid/framework/op_registry.h"
@@ -40,10 +49,14 @@
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/memory/memcpy.h"
+#include "paddle/phi/core/platform/cuda_device_guard.h"
 #include "paddle/phi/kernels/cast_kernel.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
 #include "paddle/utils/string/string_helper.h"
 
+COMMON_DECLARE_bool(trt_shape_bucket_engines);
+COMMON_DECLARE_string(trt_shape_bucket_cache_dir);
+
 namespace paddle {
 namespace inference {
 namespace tensorrt {
@@ -175,6 +188,14 @@ class TensorRTEngineOp : public framework::OperatorBase {
   std::string model_opt_cache_dir_;
   bool use_static_engine_;
   phi::DataType precision_mode_;
+  // The engines of the shape buckets, see FLAGS_trt_shape_bucket_engines.
+  // One bucket is built at a time by bucket_builder_.
+  mutable std::mutex bucket_mutex_;
+  mutable std::map<std::string, std::unique_ptr<TensorRTEngine>>
+      bucket_engines_;
+  mutable std::set<std::string> failed_buckets_;
+  mutable std::thread bucket_builder_;
+  mutable std::atomic<bool> bucket_building_{false};
 
  public:
   TensorRTEngineOp(const std::string &type,
@@ -236,8 +257,18 @@ class TensorRTEngineOp : public framework::OperatorBase {
     }
   }
 
+  ~TensorRTEngineOp() override {
+    if (bucket_builder_.joinable()) {
+      bucket_builder_.join();
+    }
+  }
+
   void PrepareTRTEngine(const framework::Scope &scope,
                         TensorRTEngine *engine) const {
+    // The OpConverter is shared, so the engines are converted one at a time
+    // when the shape buckets are built in the background.
+    static std::mutex convert_mutex;
+    std::lock_guard<std::mutex> lock(convert_mutex);
     LOG(INFO) << "Prepare TRT engine (Optimize model structure, Select OP "
                  "kernel etc). This process may cost a lot of time.";
     framework::proto::BlockDesc block_proto;
@@ -429,10 +460,168 @@ class TensorRTEngineOp : public framework::OperatorBase {
           }
         }
       }
+      if (FLAGS_trt_shape_bucket_engines && !enable_int8_) {
+        trt_engine = GetShapeBucketEngine(
+            scope, dev_place, runtime_input_shape, trt_engine);
+      }
     }
     RunTrt(scope, dev_place, trt_engine);
   }
 
+  // Find the bucket of the runtime input shapes, in which every dynamic dim
+  // d of trt_engine lies in (2^(k-1), 2^k] clipped to the dynamic shape range
+  // of trt_engine. Returns false if the bucket is the whole range.
+  bool GetShapeBucket(
+      const std::map<std::string, std::vector<int32_t>> &runtime_input_shape,
+      TensorRTEngine *trt_engine,
+      std::map<std::string, std::vector<int>> *min_input_shape,
+      std::map<std::string, std::vector<int>> *max_input_shape,
+      std::string *key) const {
+    bool narrower = false;
+    std::ostringstream bucket_key;
+    for (const auto &item : runtime_input_shape) {
+      const std::string &name = item.first;
+      const std::vector<int32_t> &shape = item.second;
+      std::vector<int> min_shape(shape.begin(), shape.end());
+      std::vector<int> max_shape = min_shape;
+      auto min_iter = trt_engine->min_input_shape().find(name);
+      auto max_iter = trt_engine->max_input_shape().find(name);
+      if (min_iter != trt_engine->min_input_shape().end() &&
+          max_iter != trt_engine->max_input_shape().end() &&
+          min_iter->second.size() == shape.size() &&
+          max_iter->second.size() == shape.size()) {
+        for (size_t d = 0; d < shape.size(); ++d) {
+          const int lower = min_iter->second[d];
+          const int upper = max_iter->second[d];
+          if (lower == upper) continue;
+          int bucket_max = 1;
+          while (bucket_max < shape[d]) {
+            bucket_max <<= 1;
+          }
+          min_shape[d] = std::max(bucket_max / 2 + 1, lower);
+          max_shape[d] = std::min(bucket_max, upper);
+          narrower =
+              narrower || min_shape[d] != lower || max_shape[d] != upper;
+        }
+      } else {
+        narrower = true;
+      }
+      bucket_key << name << ":" << string::join_strings(min_shape, ',') << "-"
+                 << string::join_strings(max_shape, ',') << ";";
+      (*min_input_shape)[name] = std::move(min_shape);
+      (*max_input_shape)[name] = std::move(max_shape);
+    }
+    *key = bucket_key.str();
+    return narrower;
+  }
+
+  // Returns the engine of the bucket of the runtime input shapes if it is
+  // built. Otherwise the bucket is built in the background, and trt_engine,
+  // whose dynamic shape range holds all the buckets, is returned.
+  TensorRTEngine *GetShapeBucketEngine(
+      const framework::Scope &scope,
+      const phi::Place &dev_place,
+      const std::map<std::string, std::vector<int32_t>> &runtime_input_shape,
+      TensorRTEngine *trt_engine) const {
+    std::map<std::string, std::vector<int>> min_input_shape;
+    std::map<std::string, std::vector<int>> max_input_shape;
+    std::string key;
+    if (!GetShapeBucket(runtime_input_shape,
+                        trt_engine,
+                        &min_input_shape,
+                        &max_input_shape,
+                        &key)) {
+      return trt_engine;
+    }
+
+    std::lock_guard<std::mutex> lock(bucket_mutex_);
+    auto iter = bucket_engines_.find(key);
+    if (iter != bucket_engines_.end()) {
+      return iter->second.get();
+    }
+    if (bucket_building_ || failed_buckets_.count(key)) {
+      return trt_engine;
+    }
+    if (bucket_builder_.joinable()) {
+      bucket_builder_.join();
+    }
+
+    TensorRTEngine::ConstructionParams params = EngineParams(dev_place);
+    params.optim_input_shape = max_input_shape;
+    params.min_input_shape = std::move(min_input_shape);
+    params.max_input_shape = std::move(max_input_shape);
+    params.min_shape_tensor = trt_engine->min_shape_tensor();
+    params.max_shape_tensor = trt_engine->max_shape_tensor();
+    params.optim_shape_tensor = trt_engine->optim_shape_tensor();
+    // The context memory is shared by the engines in the TRTEngineManager
+    // only.
+    params.context_memory_sharing = false;
+    params.use_inspector = false;
+
+    const framework::Scope *root_scope = &scope;
+    while (root_scope->parent()) {
+      root_scope = root_scope->parent();
+    }
+    VLOG(3) << "Build the TensorRT engine of the shape bucket " << key;
+    bucket_building_ = true;
+    bucket_builder_ = std::thread(&TensorRTEngineOp::BuildShapeBucketEngine,
+                                  this,
+                                  root_scope,
+                                  key,
+                                  std::move(params));
+    return trt_engine;
+  }
+
+  void BuildShapeBucketEngine(const framework::Scope *scope,
+                              const std::string &key,
+                              TensorRTEngine::ConstructionParams params) const {
+    platform::CUDADeviceGuard guard(params.device_id);
+    std::string cache_dir = FLAGS_trt_shape_bucket_cache_dir;
+    if (cache_dir.empty() && use_static_engine_) {
+      cache_dir = model_opt_cache_dir_;
+    }
+    const size_t key_hash = std::hash<std::string>()(key);
+    const std::string engine_key =
+        engine_key_ + "_bucket_" + std::to_string(key_hash);
+
+    std::unique_ptr<TensorRTEngine> engine;
+    try {
+      engine = std::make_unique<TensorRTEngine>(params);
+      std::string serialized_data;
+      if (!cache_dir.empty()) {
+        serialized_data = inference::analysis::GetTrtEngineSerializedData(
+            cache_dir, engine_key);
+      }
+      if (!serialized_data.empty()) {
+        engine->Deserialize(serialized_data);
+      } else {
+        PrepareTRTEngine(*scope, engine.get());
+        if (!cache_dir.empty()) {
+          nvinfer1::IHostMemory *serialized_engine_data = engine->Serialize();
+          inference::analysis::SaveTrtEngineSerializedDataToFile(
+              inference::analysis::GetTrtEngineSerializedPath(cache_dir,
+                                                              engine_key),
+              std::string(
+                  static_cast<const char *>(serialized_engine_data->data()),
+                  serialized_engine_data->size()));
+        }
+      }
+    } catch (const std::exception &e) {
+      LOG(WARNING) << "Failed to build the TensorRT engine of the shape bucket "
+                   << key << ", the inputs keep running on the engine of the "
+                   << "whole dynamic shape range: " << e.what();
+      engine.reset();
+    }
+
+    std::lock_guard<std::mutex> lock(bucket_mutex_);
+    if (engine) {
+      bucket_engines_[key] = std::move(engine);
+    } else {
+      failed_buckets_.insert(key);
+    }
+    bucket_building_ = false;
+  }
+
   void RunCalibration(const framework::Scope &scope,
                       const phi::Place &dev_place) const {
     // This process will builds a 32-bit trt engine, runs it on the calibration
@@ -955,91 +1144,96 @@ class TensorRTEngineOp : public framework::OperatorBase {
     }
   }
 
-  TensorRTEngine *GetEngine(const framework::Scope &scope,
-                            const phi::Place &dev_place) const {
-    if (!trt_engine_) {
-      TensorRTEngine::ConstructionParams params;
-      params.max_batch_size = max_batch_size_;
-      params.max_workspace_size = workspace_size_;
-      params.precision = precision_mode_;
-      params.calibrator = calibrator_.get();
-      params.device_id = dev_place.device;
-      params.with_dynamic_shape = with_dynamic_shape_;
-      if (HasAttr("context_memory_sharing")) {
-        params.context_memory_sharing = Attr<bool>("context_memory_sharing");
-      }
-      if (HasAttr("use_dla")) {
-        params.use_dla = Attr<bool>("use_dla");
-      }
-      if (HasAttr("dla_core")) {
-        params.dla_core = Attr<int>("dla_core");
-      }
-      if (HasAttr("disable_trt_plugin_fp16")) {
-        params.disable_trt_plugin_fp16 = Attr<bool>("disable_trt_plugin_fp16");
-      }
-      if (HasAttr("enable_low_precision_io")) {
-        params.enable_low_precision_io = Attr<bool>("enable_low_precision_io");
-      }
-      if (HasAttr("use_inspector")) {
-        params.use_inspector = Attr<bool>("use_inspector");
-      }
-      if (HasAttr("engine_info_path")) {
-        params.engine_info_path = Attr<std::string>("engine_info_path");
-      }
-      if (HasAttr("optimization_level")) {
-        params.optimization_level = Attr<int>("optimization_level");
-      }
-      if (!shape_range_info_path_.empty()) {
-        inference::DeserializeShapeRangeInfo(shape_range_info_path_,
-                                             &params.min_input_shape,
-                                             &params.max_input_shape,
-                                             &params.optim_input_shape,
-                                             &params.min_shape_tensor,
-                                             &params.max_shape_tensor,
-                                             &params.optim_shape_tensor);
-      } else {
-        if (HasAttr("dynamic_shape_names") &&
-            HasAttr("min_input_shape_vector") &&
-            HasAttr("max_input_shape_vector") &&
-            HasAttr("opt_input_shape_vector")) {
-          std::vector<std::string> dynamic_shape_names;
-          std::vector<std::vector<int>> min_input_shapes;
-          std::vector<std::vector<int>> max_input_shapes;
-          std::vector<std::vector<int>> opt_input_shapes;
-          std::vector<int> dynamic_shape_lens;
-          dynamic_shape_names =
-              Attr<std::vector<std::string>>("dynamic_shape_names");
-          std::vector<int> min_shapes =
-              Attr<std::vector<int>>("min_input_shape_vector");
-          std::vector<int> max_shapes =
-              Attr<std::vector<int>>("max_input_shape_vector");
-          std::vector<int> opt_shapes =
-              Attr<std::vector<int>>("opt_input_shape_vector");
-          dynamic_shape_lens = Attr<std::vector<int>>("dynamic_shape_lens");
-          int idx = 0;
-          for (size_t i = 0; i < dynamic_shape_lens.size(); ++i) {
-            std::vector<int> tmp1, tmp2, tmp3;
-            for (int j = 0; j < dynamic_shape_lens[i]; ++j) {
-              tmp1.push_back(min_shapes[idx]);
-              tmp2.push_back(max_shapes[idx]);
-              tmp3.push_back(opt_shapes[idx++]);
-            }
-            min_input_shapes.emplace_back(tmp1);
-            max_input_shapes.emplace_back(tmp2);
-            opt_input_shapes.emplace_back(tmp3);
+  TensorRTEngine::ConstructionParams EngineParams(
+      const phi::Place &dev_place) const {
+    TensorRTEngine::ConstructionParams params;
+    params.max_batch_size = max_batch_size_;
+    params.max_workspace_size = workspace_size_;
+    params.precision = precision_mode_;
+    params.calibrator = calibrator_.get();
+    params.device_id = dev_place.device;
+    params.with_dynamic_shape = with_dynamic_shape_;
+    if (HasAttr("context_memory_sharing")) {
+      params.context_memory_sharing = Attr<bool>("context_memory_sharing");
+    }
+    if (HasAttr("use_dla")) {
+      params.use_dla = Attr<bool>("use_dla");
+    }
+    if (HasAttr("dla_core")) {
+      params.dla_core = Attr<int>("dla_core");
+    }
+    if (HasAttr("disable_trt_plugin_fp16")) {
+      params.disable_trt_plugin_fp16 = Attr<bool>("disable_trt_plugin_fp16");
+    }
+    if (HasAttr("enable_low_precision_io")) {
+      params.enable_low_precision_io = Attr<bool>("enable_low_precision_io");
+    }
+    if (HasAttr("use_inspector")) {
+      params.use_inspector = Attr<bool>("use_inspector");
+    }
+    if (HasAttr("engine_info_path")) {
+      params.engine_info_path = Attr<std::string>("engine_info_path");
+    }
+    if (HasAttr("optimization_level")) {
+      params.optimization_level = Attr<int>("optimization_level");
+    }
+    if (!shape_range_info_path_.empty()) {
+      inference::DeserializeShapeRangeInfo(shape_range_info_path_,
+                                           &params.min_input_shape,
+                                           &params.max_input_shape,
+                                           &params.optim_input_shape,
+                                           &params.min_shape_tensor,
+                                           &params.max_shape_tensor,
+                                           &params.optim_shape_tensor);
+    } else {
+      if (HasAttr("dynamic_shape_names") &&
+          HasAttr("min_input_shape_vector") &&
+          HasAttr("max_input_shape_vector") &&
+          HasAttr("opt_input_shape_vector")) {
+        std::vector<std::string> dynamic_shape_names;
+        std::vector<std::vector<int>> min_input_shapes;
+        std::vector<std::vector<int>> max_input_shapes;
+        std::vector<std::vector<int>> opt_input_shapes;
+        std::vector<int> dynamic_shape_lens;
+        dynamic_shape_names =
+            Attr<std::vector<std::string>>("dynamic_shape_names");
+        std::vector<int> min_shapes =
+            Attr<std::vector<int>>("min_input_shape_vector");
+        std::vector<int> max_shapes =
+            Attr<std::vector<int>>("max_input_shape_vector");
+        std::vector<int> opt_shapes =
+            Attr<std::vector<int>>("opt_input_shape_vector");
+        dynamic_shape_lens = Attr<std::vector<int>>("dynamic_shape_lens");
+        int idx = 0;
+        for (size_t i = 0; i < dynamic_shape_lens.size(); ++i) {
+          std::vector<int> tmp1, tmp2, tmp3;
+          for (int j = 0; j < dynamic_shape_lens[i]; ++j) {
+            tmp1.push_back(min_shapes[idx]);
+            tmp2.push_back(max_shapes[idx]);
+            tmp3.push_back(opt_shapes[idx++]);
           }
+          min_input_shapes.emplace_back(tmp1);
+          max_input_shapes.emplace_back(tmp2);
+          opt_input_shapes.emplace_back(tmp3);
+        }
 
-          for (size_t i = 0; i < dynamic_shape_names.size(); ++i) {
-            params.min_input_shape.insert(
-                std::make_pair(dynamic_shape_names[i], min_input_shapes[i]));
-            params.max_input_shape.insert(
-                std::make_pair(dynamic_shape_names[i], max_input_shapes[i]));
-            params.optim_input_shape.insert(
-                std::make_pair(dynamic_shape_names[i], opt_input_shapes[i]));
-          }
+        for (size_t i = 0; i < dynamic_shape_names.size(); ++i) {
+          params.min_input_shape.insert(
+              std::make_pair(dynamic_shape_names[i], min_input_shapes[i]));
+          params.max_input_shape.insert(
+              std::make_pair(dynamic_shape_names[i], max_input_shapes[i]));
+          params.optim_input_shape.insert(
+              std::make_pair(dynamic_shape_names[i], opt_input_shapes[i]));
         }
       }
+    }
+    return params;
+  }
 
+  TensorRTEngine *GetEngine(const framework::Scope &scope,
+                            const phi::Place &dev_place) const {
+    if (!trt_engine_) {
+      TensorRTEngine::ConstructionParams params = EngineParams(dev_place);
       trt_engine_ =
           inference::Singleton<inference::tensorrt::TRTEngineManager>::Global()
               .Create(engine_key_ + std::to_string(predictor_id_), params);
@@ -0,0 +1,140 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/dialect/distributed/transforms/fuse_matmul_comm_overlap_pass.h"
+
+#include <string>
+
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/drr/include/drr_pattern_base.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+// all_gather/c_allgather + matmul -> fused_allgather_matmul
+class AllGatherMatmulPattern : public paddle::drr::DrrPatternBase {
+ public:
+  explicit AllGatherMatmulPattern(const std::string &all_gather_name)
+      : all_gather_name_(all_gather_name) {}
+
+  std::string name() const override {
+    return "AllGatherMatmulPattern_" + all_gather_name_;
+  }
+
+  void operator()(paddle::drr::DrrPatternContext *ctx) const override {
+    paddle::drr::SourcePattern pat = ctx->SourcePattern();
+    const auto &all_gather = pat.Op(all_gather_name_,
+                                    {{"ring_id", pat.Attr("ring_id")},
+                                     {"nranks", pat.Attr("nranks")}});
+    const auto &matmul = pat.Op(paddle::dialect::MatmulOp::name(),
+                                {{"transpose_x", pat.Attr("trans_x")},
+                                 {"transpose_y", pat.Attr("trans_y")}});
+
+    pat.Tensor("gathered") = all_gather(pat.Tensor("x"));
+    pat.Tensor("out") = matmul(pat.Tensor("gathered"), pat.Tensor("weight"));
+
+    pat.AddConstraint([&](const paddle::drr::MatchContext &match_ctx) {
+      auto x_dims = pir::GetShapeFromValue(match_ctx.Tensor("x"));
+      auto w_dims = pir::GetShapeFromValue(match_ctx.Tensor("weight"));
+      return !match_ctx.Attr<bool>("trans_x") &&
+             match_ctx.Attr<int>("nranks") > 1 && x_dims.size() >= 2 &&
+             w_dims.size() == 2 &&
+             match_ctx.Tensor("gathered").use_count() == 1;
+    });
+
+    paddle::drr::ResultPattern res = pat.ResultPattern();
+    const auto &fused = res.Op(paddle::dialect::FusedAllgatherMatmulOp::name(),
+                               {{"ring_id", pat.Attr("ring_id")},
+                                {"nranks", pat.Attr("nranks")},
+                                {"transpose_y", pat.Attr("trans_y")}});
+    res.Tensor("out") = fused(res.Tensor("x"), res.Tensor("weight"));
+  }
+
+ private:
+  std::string all_gather_name_;
+};
+
+// matmul + reduce_scatter -> fused_matmul_reduce_scatter
+class MatmulReduceScatterPattern : public paddle::drr::DrrPatternBase {
+ public:
+  std::string name() const override { return "MatmulReduceScatterPattern"; }
+
+  void operator()(paddle::drr::DrrPatternContext *ctx) const override {
+    paddle::drr::SourcePattern pat = ctx->SourcePattern();
+    const auto &matmul = pat.Op(paddle::dialect::MatmulOp::name(),
+                                {{"transpose_x", pat.Attr("trans_x")},
+                                 {"transpose_y", pat.Attr("trans_y")}});
+    const auto &reduce_scatter =
+        pat.Op(paddle::dialect::ReduceScatterOp::name(),
+               {{"ring_id", pat.Attr("ring_id")},
+                {"nranks", pat.Attr("nranks")}});
+
+    pat.Tensor("partial") = matmul(pat.Tensor("x"), pat.Tensor("weight"));
+    pat.Tensor("out") = reduce_scatter(pat.Tensor("partial"));
+
+    pat.AddConstraint([&](const paddle::drr::MatchContext &match_ctx) {
+      auto x_dims = pir::GetShapeFromValue(match_ctx.Tensor("x"));
+      auto w_dims = pir::GetShapeFromValue(match_ctx.Tensor("weight"));
+      int nranks = match_ctx.Attr<int>("nranks");
+      // The blocks of rows of the ranks are split along the first dim.
+      return !match_ctx.Attr<bool>("trans_x") && nranks > 1 &&
+             x_dims.size() >= 2 && w_dims.size() == 2 && x_dims[0] > 0 &&
+             x_dims[0] % nranks == 0 &&
+             match_ctx.Tensor("partial").use_count() == 1;
+    });
+
+    paddle::drr::ResultPattern res = pat.ResultPattern();
+    const auto &fused =
+        res.Op(paddle::dialect::FusedMatmulReduceScatterOp::name(),
+               {{"ring_id", pat.Attr("ring_id")},
+                {"nranks", pat.Attr("nranks")},
+                {"transpose_y", pat.Attr("trans_y")}});
+    res.Tensor("out") = fused(res.Tensor("x"), res.Tensor("weight"));
+  }
+};
+
+// Replaces the collectives of tensor parallelism around a matmul, in the
+// programs auto parallel partitions, by the fused ops that overlap the
+// transfers with the GEMM of the blocks already transferred.
+class FuseMatmulCommOverlapPass : public pir::PatternRewritePass {
+ public:
+  FuseMatmulCommOverlapPass()
+      : pir::PatternRewritePass("fuse_matmul_comm_overlap_pass", 2) {}
+
+  pir::RewritePatternSet InitializePatterns(pir::IrContext *context) override {
+    pir::RewritePatternSet ps(context);
+    ps.Add(paddle::drr::Create<AllGatherMatmulPattern>(
+        context, paddle::dialect::AllGatherOp::name()));
+    ps.Add(paddle::drr::Create<AllGatherMatmulPattern>(
+        context, paddle::dialect::CAllgatherOp::name()));
+    ps.Add(paddle::drr::Create<MatmulReduceScatterPattern>(context));
+
+    return ps;
+  }
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateFuseMatmulCommOverlapPass() {
+  return std::make_unique<FuseMatmulCommOverlapPass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(fuse_matmul_comm_overlap_pass, FuseMatmulCommOverlapPass);
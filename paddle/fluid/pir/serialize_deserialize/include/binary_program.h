@@ -0,0 +1,147 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/fluid/pir/serialize_deserialize/include/ir_deserialize.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/ir_serialize.h"
+#include "paddle/pir/include/core/program.h"
+
+namespace pir {
+/**
+ * The binary program format keeps a program in flat tables instead of a
+ * json tree:
+ *
+ *   header   | magic, format version, pir version, table sizes
+ *   types    | uint32 string id of each distinct type
+ *   attrs    | uint32 string id of each distinct attribute
+ *   program  | uint32 words of the blocks and ops in pre-order
+ *   strings  | uint64 offsets followed by the interned string bytes
+ *
+ * The op names, attribute names and the json text of each distinct type and
+ * attribute are interned, so a type shared by many values is stored and
+ * parsed once. The file is memory mapped when read, the strings are used in
+ * place and a type or attribute is only parsed the first time an op uses it.
+ *
+ * A block is written as
+ *   num_args, type_id * num_args, num_kwargs, (name_id, type_id) * num_kwargs,
+ *   num_ops, op * num_ops
+ * and an op as
+ *   name_id, num_operands, value_id * num_operands, num_results,
+ *   type_id * num_results, num_attrs, (name_id, attr_id) * num_attrs,
+ *   num_regions, (num_blocks, block * num_blocks) * num_regions
+ * The values are numbered from 1 in the order they are defined, 0 is a null
+ * operand.
+ *
+ * The version patches are written for the json format, so a binary program
+ * is only read by the same pir version that wrote it.
+ */
+class BinaryProgramWriter {
+ public:
+  BinaryProgramWriter(uint64_t version, bool trainable);
+
+  BinaryProgramWriter(const BinaryProgramWriter&) = delete;
+  BinaryProgramWriter& operator=(const BinaryProgramWriter&) = delete;
+
+  /** Write returns the bytes of the binary program. */
+  std::string Write(const pir::Program* program);
+
+ private:
+  void WriteBlock(pir::Block* block);
+  void WriteOp(const pir::Operation& op);
+  uint32_t WriteValue(pir::Value value);
+  uint32_t InternString(const std::string& str);
+  uint32_t InternType(pir::Type type);
+  uint32_t InternAttribute(const Json& attr_json);
+
+  uint64_t version_;
+  bool trainable_;
+  ProgramWriter json_writer_;
+
+  std::vector<uint32_t> words_;
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, uint32_t> string_ids_;
+  std::vector<uint32_t> type_strings_;
+  std::unordered_map<pir::Type, uint32_t> type_ids_;
+  std::vector<uint32_t> attr_strings_;
+  std::unordered_map<uint32_t, uint32_t> attr_ids_;
+  std::unordered_map<pir::Value, uint32_t> value_ids_;
+  // cf.stack_create and its tuple_push / tuple_pop are not saved unless
+  // FLAGS_save_cf_stack_op is set, the same as the json format.
+  std::unordered_set<const pir::Operation*> skipped_ops_;
+};
+
+class BinaryProgramReader {
+ public:
+  /** The data must outlive RecoverProgram. */
+  BinaryProgramReader(const char* data, size_t size);
+
+  BinaryProgramReader(const BinaryProgramReader&) = delete;
+  BinaryProgramReader& operator=(const BinaryProgramReader&) = delete;
+
+  uint64_t version() const { return version_; }
+  bool trainable() const { return trainable_; }
+
+  void RecoverProgram(pir::Program* program);
+
+ private:
+  uint32_t ReadWord();
+  void ReadBlock(pir::Block* block);
+  pir::Operation* ReadOp();
+  pir::Value GetValue(uint32_t id);
+  void AddValue(pir::Value value);
+  std::string_view GetString(uint32_t id) const;
+  pir::Type GetType(uint32_t id);
+  pir::Attribute GetAttribute(uint32_t id);
+
+  const char* data_;
+  size_t size_;
+  uint64_t version_{0};
+  bool trainable_{false};
+  ProgramReader json_reader_;
+
+  const char* words_{nullptr};
+  size_t word_num_{0};
+  size_t word_pos_{0};
+  const char* type_strings_{nullptr};
+  const char* attr_strings_{nullptr};
+  const char* string_offsets_{nullptr};
+  const char* string_data_{nullptr};
+  size_t string_num_{0};
+  size_t string_data_size_{0};
+
+  // Materialized on first use, indexed by the ids in the file.
+  std::vector<pir::Type> types_;
+  std::vector<bool> type_parsed_;
+  std::vector<pir::Attribute> attrs_;
+  std::vector<bool> attr_parsed_;
+  std::vector<pir::Value> values_;
+};
+
+/** IsBinaryProgramFile checks the magic at the beginning of the file. */
+bool IsBinaryProgramFile(const std::string& file_path);
+
+/** ReadBinaryModule memory maps the file and reads the program from it,
+ * returns whether the program is saved as trainable. */
+bool ReadBinaryModule(const std::string& file_path,
+                      pir::Program* program,
+                      uint64_t pir_version);
+
+}  // namespace pir
@@ -0,0 +1,89 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/device_context.h"
+#include "paddle/pir/include/core/dll_decl.h"
+
+namespace pir {
+/**
+ * The flat parameter format keeps the parameters as raw data after a json
+ * header, in the layout of safetensors:
+ *
+ *   uint64   | the size of the header, padded with spaces
+ *   header   | {"__metadata__": {"format": "paddle"},
+ *            |  name: {"dtype": "F32", "shape": [...],
+ *            |         "data_offsets": [begin, end]}, ...}
+ *   data     | the raw data of each parameter, from data_offsets
+ *
+ * The offsets are from the beginning of the data. Unlike safetensors, the
+ * data and each parameter in it start at a multiple of 64 bytes, padded
+ * with zeros, so that the file is read without parsing each tensor: it is
+ * memory mapped and the CPU tensors point into the mapping, whose pages are
+ * read when they are first used. The mapping is private, the tensors may be
+ * modified in place without writing to the file. The LoD is not kept.
+ *
+ * The files of safetensors are read as well, the data of their tensors not
+ * aligned is copied.
+ */
+class IR_API FlatParamsFile {
+ public:
+  explicit FlatParamsFile(const std::string& file_path);
+
+  FlatParamsFile(const FlatParamsFile&) = delete;
+  FlatParamsFile& operator=(const FlatParamsFile&) = delete;
+
+  /** Match checks whether the file begins with a flat parameter header. */
+  static bool Match(const std::string& file_path);
+
+  static void Save(const std::vector<const phi::DenseTensor*>& x,
+                   const std::vector<std::string>& names,
+                   const std::string& file_path,
+                   bool overwrite);
+
+  /** The names of the parameters, in the order of their data. */
+  const std::vector<std::string>& names() const { return names_; }
+
+  /** Read the parameter to the place of dev_ctx. A CPU tensor points to the
+   * mapping, the others are copied from it. */
+  void Read(const std::string& name,
+            phi::DenseTensor* out,
+            const phi::DeviceContext& dev_ctx) const;
+
+ private:
+  struct Entry {
+    phi::DataType dtype;
+    std::vector<int64_t> shape;
+    size_t begin;
+    size_t end;
+  };
+
+  std::string file_path_;
+  // Keeps the file mapped while the file or a tensor pointing to it lives.
+  std::shared_ptr<void> mapping_;
+  char* data_{nullptr};
+  size_t data_size_{0};
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace pir
@@ -45,6 +45,27 @@ void IR_API WriteModule(const pir::Program& program,
                         bool readable = false,
                         bool trainable = true);
 
+/**
+ * @brief Write the given PIR program into a file in the binary program
+ * format, which is memory mapped and read much faster than the json format.
+ *
+ * @param[in] program      The PIR program to be written.
+ * @param[in] file_path    The path to the file to be written.
+ * @param[in] pir_version  The version number of PIR, a binary program is
+ * only read by the same version.
+ * @param[in] overwrite    If the file already exists, this flag determines
+ * whether to overwrite the existing file.
+ * @param[in] trainable    (Optional parameter, default to true) If true,
+ * operation has opresult_attrs for training like stop_gradient,persistable.
+ *
+ * @return void。
+ */
+void IR_API WriteBinaryModule(const pir::Program& program,
+                              const std::string& file_path,
+                              uint64_t pir_version,
+                              bool overwrite,
+                              bool trainable = true);
+
 /**
  * @brief Gets a PIR program from the specified file path.
  *
@@ -59,7 +80,8 @@ void IR_API WriteModule(const pir::Program& program,
  * funtune.
  *
  * @note If 'pir_version' is larger than the version of file, will trigger
- * version compatibility modification rule.
+ * version compatibility modification rule. The files written by
+ * WriteBinaryModule are detected and read in the binary format.
  */
 bool IR_API ReadModule(const std::string& file_path,
                        pir::Program* program,
@@ -133,8 +155,10 @@ void IR_API LoadFunction(const std::string& file_path,
                          phi::Place place = phi::Place());
 
 /**
- * @brief Save the given tensor into a single file at the specified file path
- * with its name.
+ * @brief Load the tensors of the given names from a single file at the
+ * specified file path. The file is either the tensors saved in turn by
+ * SaveCombineFunction, or a FlatParamsFile, whose tensors are looked up by
+ * name and whose CPU tensors point to the mapped file.
  *
  * @param[in] file_path         The path of the file to be read.
  * @param[in] names             The names of the tensors.
@@ -39,6 +39,7 @@ class ProgramReader {
                              pir::PatchBuilder* builder);
   pir::Type RecoverType(Json* type_json);
   pir::AttributeMap RecoverOpAttributesMap(Json* attrs_json);
+  pir::Attribute RecoverAttribute(Json* attr_json);
   ~ProgramReader() = default;
 
  private:
@@ -36,6 +36,9 @@ class ProgramWriter {
   Json GetProgramJson(const pir::Program* program);
   Json GetTypeJson(const pir::Type& type);
   Json GetAttributesMapJson(const AttributeMap& attr_map);
+  /** GetOpAttributesJson returns the attributes of op which are saved,
+   * the same as the ones written by GetProgramJson. */
+  Json GetOpAttributesJson(const pir::Operation& op);
 
   ~ProgramWriter() = default;
 
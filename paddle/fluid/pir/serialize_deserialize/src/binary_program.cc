@@ -0,0 +1,492 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_program.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+#include "paddle/pir/include/core/operation.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
+
+COMMON_DECLARE_bool(save_cf_stack_op);
+
+namespace pir {
+
+namespace {
+
+constexpr char kBinaryProgramMagic[8] = {
+    'P', 'I', 'R', 'B', 'I', 'N', '\0', '\0'};
+constexpr uint32_t kBinaryProgramFormatVersion = 1;
+
+// The numbers are stored in the byte order of the host, which is little
+// endian on all the platforms paddle runs on.
+struct BinaryProgramHeader {
+  char magic[8];
+  uint32_t format_version;
+  uint32_t trainable;
+  uint64_t pir_version;
+  uint64_t type_num;
+  uint64_t attr_num;
+  uint64_t word_num;
+  uint64_t string_num;
+  uint64_t string_data_size;
+  uint64_t value_num;
+};
+
+// The sections of a mapped file are not aligned, read them by memcpy.
+template <typename T>
+T Load(const char* ptr) {
+  T value;
+  std::memcpy(&value, ptr, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void Append(std::string* out, const T& value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& file_path) {
+#ifdef _WIN32
+    std::ifstream fin(file_path, std::ios::binary);
+    PADDLE_ENFORCE_EQ(static_cast<bool>(fin),
+                      true,
+                      common::errors::Unavailable(
+                          "Cannot open %s to load the program.", file_path));
+    buffer_.assign(std::istreambuf_iterator<char>(fin),
+                   std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#else
+    int fd = open(file_path.c_str(), O_RDONLY);
+    PADDLE_ENFORCE_GE(fd,
+                      0,
+                      common::errors::Unavailable(
+                          "Cannot open %s to load the program.", file_path));
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      size_ = static_cast<size_t>(file_stat.st_size);
+      void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        data_ = static_cast<const char*>(addr);
+      }
+    }
+    close(fd);
+    PADDLE_ENFORCE_NOT_NULL(
+        data_,
+        common::errors::Unavailable("Cannot map %s to load the program.",
+                                    file_path));
+#endif
+  }
+
+  ~MappedFile() {
+#ifndef _WIN32
+    if (data_ != nullptr) {
+      munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char* data_{nullptr};
+  size_t size_{0};
+#ifdef _WIN32
+  std::string buffer_;
+#endif
+};
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// BinaryProgramWriter
+//===----------------------------------------------------------------------===//
+BinaryProgramWriter::BinaryProgramWriter(uint64_t version, bool trainable)
+    : version_(version),
+      trainable_(trainable),
+      json_writer_(version, trainable) {}
+
+std::string BinaryProgramWriter::Write(const pir::Program* program) {
+  auto module_op = program->module_op();
+  if (!FLAGS_save_cf_stack_op) {
+    module_op->Walk([this](pir::Operation* op) {
+      auto stack_op = op->dyn_cast<pir::StackCreateOp>();
+      if (!stack_op) return;
+      skipped_ops_.insert(op);
+      if (stack_op.inlet().HasOneUse()) {
+        skipped_ops_.insert(stack_op.tuple_push_op().operation());
+      }
+      if (stack_op.outlet().HasOneUse()) {
+        skipped_ops_.insert(stack_op.tuple_pop_op().operation());
+      }
+    });
+  }
+  WriteBlock(&module_op.block());
+
+  std::vector<uint64_t> string_offsets{0};
+  for (auto& str : strings_) {
+    string_offsets.push_back(string_offsets.back() + str.size());
+  }
+
+  BinaryProgramHeader header;
+  std::memcpy(header.magic, kBinaryProgramMagic, sizeof(header.magic));
+  header.format_version = kBinaryProgramFormatVersion;
+  header.trainable = trainable_ ? 1 : 0;
+  header.pir_version = version_;
+  header.type_num = type_strings_.size();
+  header.attr_num = attr_strings_.size();
+  header.word_num = words_.size();
+  header.string_num = strings_.size();
+  header.string_data_size = string_offsets.back();
+  header.value_num = value_ids_.size();
+
+  std::string out;
+  out.reserve(sizeof(header) +
+              sizeof(uint32_t) *
+                  (type_strings_.size() + attr_strings_.size() +
+                   words_.size()) +
+              sizeof(uint64_t) * string_offsets.size() +
+              header.string_data_size);
+  Append(&out, header);
+  for (uint32_t id : type_strings_) Append(&out, id);
+  for (uint32_t id : attr_strings_) Append(&out, id);
+  for (uint32_t word : words_) Append(&out, word);
+  for (uint64_t offset : string_offsets) Append(&out, offset);
+  for (auto& str : strings_) out.append(str);
+  VLOG(4) << "Write binary program with " << value_ids_.size() << " values, "
+          << type_strings_.size() << " types, " << attr_strings_.size()
+          << " attributes and " << strings_.size() << " strings.";
+  return out;
+}
+
+void BinaryProgramWriter::WriteBlock(pir::Block* block) {
+  words_.push_back(block->args_size());
+  for (auto arg : block->args()) {
+    words_.push_back(InternType(arg.type()));
+    WriteValue(arg);
+  }
+  words_.push_back(block->kwargs_size());
+  for (auto& item : block->kwargs()) {
+    words_.push_back(InternString(item.first));
+    words_.push_back(InternType(item.second.type()));
+    WriteValue(item.second);
+  }
+  uint32_t op_num = 0;
+  for (auto& op : *block) {
+    if (!skipped_ops_.count(&op)) ++op_num;
+  }
+  words_.push_back(op_num);
+  for (auto& op : *block) {
+    if (!skipped_ops_.count(&op)) WriteOp(op);
+  }
+}
+
+void BinaryProgramWriter::WriteOp(const pir::Operation& op) {
+  words_.push_back(InternString(op.name()));
+  words_.push_back(op.num_operands());
+  for (uint32_t i = 0; i < op.num_operands(); ++i) {
+    auto it = value_ids_.find(op.operand_source(i));
+    words_.push_back(it == value_ids_.end() ? 0 : it->second);
+  }
+  words_.push_back(op.num_results());
+  for (uint32_t i = 0; i < op.num_results(); ++i) {
+    words_.push_back(InternType(op.result(i).type()));
+    WriteValue(op.result(i));
+  }
+  Json attrs_json = json_writer_.GetOpAttributesJson(op);
+  words_.push_back(attrs_json.size());
+  for (auto& attr_json : attrs_json) {
+    words_.push_back(
+        InternString(attr_json.at(NAME).template get<std::string>()));
+    words_.push_back(InternAttribute(attr_json.at(ATTR_TYPE)));
+  }
+  words_.push_back(op.num_regions());
+  for (uint32_t i = 0; i < op.num_regions(); ++i) {
+    auto& region = op.region(i);
+    words_.push_back(region.size());
+    for (auto& block : region) {
+      WriteBlock(const_cast<pir::Block*>(&block));
+    }
+  }
+}
+
+uint32_t BinaryProgramWriter::WriteValue(pir::Value value) {
+  uint32_t id = value_ids_.size() + 1;
+  value_ids_[value] = id;
+  return id;
+}
+
+uint32_t BinaryProgramWriter::InternString(const std::string& str) {
+  auto it = string_ids_.find(str);
+  if (it != string_ids_.end()) return it->second;
+  uint32_t id = strings_.size();
+  strings_.push_back(str);
+  string_ids_.emplace(str, id);
+  return id;
+}
+
+uint32_t BinaryProgramWriter::InternType(pir::Type type) {
+  auto it = type_ids_.find(type);
+  if (it != type_ids_.end()) return it->second;
+  uint32_t id = type_strings_.size();
+  type_strings_.push_back(InternString(json_writer_.GetTypeJson(type).dump()));
+  type_ids_.emplace(type, id);
+  return id;
+}
+
+uint32_t BinaryProgramWriter::InternAttribute(const Json& attr_json) {
+  uint32_t string_id = InternString(attr_json.dump());
+  auto it = attr_ids_.find(string_id);
+  if (it != attr_ids_.end()) return it->second;
+  uint32_t id = attr_strings_.size();
+  attr_strings_.push_back(string_id);
+  attr_ids_.emplace(string_id, id);
+  return id;
+}
+
+//===----------------------------------------------------------------------===//
+// BinaryProgramReader
+//===----------------------------------------------------------------------===//
+BinaryProgramReader::BinaryProgramReader(const char* data, size_t size)
+    : data_(data), size_(size), json_reader_(0) {
+  PADDLE_ENFORCE_GE(size_,
+                    sizeof(BinaryProgramHeader),
+                    common::errors::InvalidArgument(
+                        "The binary program is shorter than its header."));
+  auto header = Load<BinaryProgramHeader>(data_);
+  PADDLE_ENFORCE_EQ(
+      std::memcmp(header.magic, kBinaryProgramMagic, sizeof(header.magic)),
+      0,
+      common::errors::InvalidArgument("Invalid binary program file."));
+  PADDLE_ENFORCE_EQ(header.format_version,
+                    kBinaryProgramFormatVersion,
+                    common::errors::InvalidArgument(
+                        "The binary program format version %d is not "
+                        "supported, expected %d.",
+                        header.format_version,
+                        kBinaryProgramFormatVersion));
+  version_ = header.pir_version;
+  trainable_ = header.trainable != 0;
+
+  // Check every section fits in the file before using it, the sizes are
+  // bounded by the file size so the sums do not overflow.
+  size_t pos = sizeof(BinaryProgramHeader);
+  auto Section = [&](uint64_t num, size_t elem_size) {
+    PADDLE_ENFORCE_LE(num,
+                      (size_ - pos) / elem_size,
+                      common::errors::InvalidArgument(
+                          "The binary program is truncated."));
+    const char* begin = data_ + pos;
+    pos += num * elem_size;
+    return begin;
+  };
+  type_strings_ = Section(header.type_num, sizeof(uint32_t));
+  attr_strings_ = Section(header.attr_num, sizeof(uint32_t));
+  words_ = Section(header.word_num, sizeof(uint32_t));
+  PADDLE_ENFORCE_LT(header.string_num,
+                    (size_ - pos) / sizeof(uint64_t),
+                    common::errors::InvalidArgument(
+                        "The binary program is truncated."));
+  string_offsets_ = Section(header.string_num + 1, sizeof(uint64_t));
+  string_data_ = Section(header.string_data_size, 1);
+
+  word_num_ = header.word_num;
+  string_num_ = header.string_num;
+  string_data_size_ = header.string_data_size;
+  types_.resize(header.type_num);
+  type_parsed_.resize(header.type_num, false);
+  attrs_.resize(header.attr_num);
+  attr_parsed_.resize(header.attr_num, false);
+  values_.reserve(std::min<uint64_t>(header.value_num, header.word_num) + 1);
+}
+
+void BinaryProgramReader::RecoverProgram(pir::Program* program) {
+  values_.clear();
+  values_.emplace_back();  // the null value
+  word_pos_ = 0;
+  ReadBlock(&program->module_op().block());
+  PADDLE_ENFORCE_EQ(word_pos_,
+                    word_num_,
+                    common::errors::InvalidArgument(
+                        "The binary program has %d unread words.",
+                        word_num_ - word_pos_));
+  VLOG(4) << "Read binary program with " << values_.size() - 1 << " values.";
+}
+
+uint32_t BinaryProgramReader::ReadWord() {
+  PADDLE_ENFORCE_LT(
+      word_pos_,
+      word_num_,
+      common::errors::InvalidArgument("The binary program is truncated."));
+  return Load<uint32_t>(words_ + sizeof(uint32_t) * word_pos_++);
+}
+
+void BinaryProgramReader::ReadBlock(pir::Block* block) {
+  uint32_t arg_num = ReadWord();
+  for (uint32_t i = 0; i < arg_num; ++i) {
+    AddValue(block->AddArg(GetType(ReadWord())));
+  }
+  uint32_t kwarg_num = ReadWord();
+  for (uint32_t i = 0; i < kwarg_num; ++i) {
+    std::string name(GetString(ReadWord()));
+    AddValue(block->AddKwarg(name, GetType(ReadWord())));
+  }
+  uint32_t op_num = ReadWord();
+  for (uint32_t i = 0; i < op_num; ++i) {
+    block->push_back(ReadOp());
+  }
+}
+
+pir::Operation* BinaryProgramReader::ReadOp() {
+  std::string op_name(GetString(ReadWord()));
+  pir::OpInfo op_info =
+      pir::IrContext::Instance()->GetRegisteredOpInfo(op_name);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(op_info),
+                    true,
+                    common::errors::NotFound(
+                        "The op %s of the binary program is not registered.",
+                        op_name));
+
+  std::vector<pir::Value> inputs(ReadWord());
+  for (auto& input : inputs) {
+    input = GetValue(ReadWord());
+  }
+  std::vector<pir::Type> output_types(ReadWord());
+  for (auto& type : output_types) {
+    type = GetType(ReadWord());
+  }
+  pir::AttributeMap attributes;
+  uint32_t attr_num = ReadWord();
+  for (uint32_t i = 0; i < attr_num; ++i) {
+    std::string name(GetString(ReadWord()));
+    attributes[name] = GetAttribute(ReadWord());
+  }
+  uint32_t num_regions = ReadWord();
+
+  pir::Operation* op = pir::Operation::Create(
+      inputs, attributes, output_types, op_info, num_regions);
+  for (uint32_t i = 0; i < op->num_results(); ++i) {
+    AddValue(op->result(i));
+  }
+  for (uint32_t i = 0; i < num_regions; ++i) {
+    auto& region = op->region(i);
+    uint32_t block_num = ReadWord();
+    for (uint32_t j = 0; j < block_num; ++j) {
+      region.emplace_back();
+      ReadBlock(&region.back());
+    }
+  }
+  return op;
+}
+
+pir::Value BinaryProgramReader::GetValue(uint32_t id) {
+  PADDLE_ENFORCE_LT(id,
+                    values_.size(),
+                    common::errors::InvalidArgument(
+                        "The value %d is used before it is defined.", id));
+  return values_[id];
+}
+
+void BinaryProgramReader::AddValue(pir::Value value) {
+  values_.push_back(value);
+}
+
+std::string_view BinaryProgramReader::GetString(uint32_t id) const {
+  PADDLE_ENFORCE_LT(id,
+                    string_num_,
+                    common::errors::InvalidArgument(
+                        "The string %d is out of range.", id));
+  uint64_t begin = Load<uint64_t>(string_offsets_ + sizeof(uint64_t) * id);
+  uint64_t end = Load<uint64_t>(string_offsets_ + sizeof(uint64_t) * (id + 1));
+  PADDLE_ENFORCE_EQ(
+      begin <= end && end <= string_data_size_,
+      true,
+      common::errors::InvalidArgument("The string %d is corrupted.", id));
+  return std::string_view(string_data_ + begin, end - begin);
+}
+
+pir::Type BinaryProgramReader::GetType(uint32_t id) {
+  PADDLE_ENFORCE_LT(
+      id,
+      types_.size(),
+      common::errors::InvalidArgument("The type %d is out of range.", id));
+  if (!type_parsed_[id]) {
+    auto str = GetString(Load<uint32_t>(type_strings_ + sizeof(uint32_t) * id));
+    Json type_json = Json::parse(str.begin(), str.end());
+    types_[id] = json_reader_.RecoverType(&type_json);
+    type_parsed_[id] = true;
+  }
+  return types_[id];
+}
+
+pir::Attribute BinaryProgramReader::GetAttribute(uint32_t id) {
+  PADDLE_ENFORCE_LT(
+      id,
+      attrs_.size(),
+      common::errors::InvalidArgument("The attribute %d is out of range.", id));
+  if (!attr_parsed_[id]) {
+    auto str = GetString(Load<uint32_t>(attr_strings_ + sizeof(uint32_t) * id));
+    Json attr_json = Json::parse(str.begin(), str.end());
+    attrs_[id] = json_reader_.RecoverAttribute(&attr_json);
+    attr_parsed_[id] = true;
+  }
+  return attrs_[id];
+}
+
+//===----------------------------------------------------------------------===//
+// Interface
+//===----------------------------------------------------------------------===//
+bool IsBinaryProgramFile(const std::string& file_path) {
+  std::ifstream fin(file_path, std::ios::binary);
+  char magic[sizeof(kBinaryProgramMagic)];
+  if (!fin.read(magic, sizeof(magic))) return false;
+  return std::memcmp(magic, kBinaryProgramMagic, sizeof(magic)) == 0;
+}
+
+bool ReadBinaryModule(const std::string& file_path,
+                      pir::Program* program,
+                      uint64_t pir_version) {
+  MappedFile file(file_path);
+  BinaryProgramReader reader(file.data(), file.size());
+  PADDLE_ENFORCE_EQ(reader.version(),
+                    pir_version,
+                    common::errors::InvalidArgument(
+                        "%s is saved by pir version %d, but is loaded by pir "
+                        "version %d. The version patches only apply to the "
+                        "json format, please save the program as json.",
+                        file_path,
+                        reader.version(),
+                        pir_version));
+  reader.RecoverProgram(program);
+  return reader.trainable();
+}
+
+}  // namespace pir
@@ -0,0 +1,338 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/serialize_deserialize/include/flat_params.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "glog/logging.h"
+#include "paddle/common/enforce.h"
+#include "paddle/fluid/framework/tensor_util.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/third_party.h"
+#include "paddle/phi/common/port.h"
+#include "paddle/phi/core/memory/malloc.h"
+
+namespace pir {
+namespace {
+
+// The data and each parameter in it start at a multiple of the alignment,
+// the same as the CPU allocator.
+constexpr size_t kFlatParamsAlignment = 64;
+constexpr char kFlatParamsFormat[] = "paddle";
+
+size_t AlignUp(size_t offset) {
+  return (offset + kFlatParamsAlignment - 1) / kFlatParamsAlignment *
+         kFlatParamsAlignment;
+}
+
+// The dtype names of safetensors, and of the complex types it has not.
+const std::vector<std::pair<phi::DataType, std::string>>& DtypeNames() {
+  static const std::vector<std::pair<phi::DataType, std::string>> names = {
+      {phi::DataType::BOOL, "BOOL"},
+      {phi::DataType::UINT8, "U8"},
+      {phi::DataType::INT8, "I8"},
+      {phi::DataType::UINT16, "U16"},
+      {phi::DataType::INT16, "I16"},
+      {phi::DataType::UINT32, "U32"},
+      {phi::DataType::INT32, "I32"},
+      {phi::DataType::UINT64, "U64"},
+      {phi::DataType::INT64, "I64"},
+      {phi::DataType::FLOAT16, "F16"},
+      {phi::DataType::BFLOAT16, "BF16"},
+      {phi::DataType::FLOAT32, "F32"},
+      {phi::DataType::FLOAT64, "F64"},
+      {phi::DataType::FLOAT8_E4M3FN, "F8_E4M3"},
+      {phi::DataType::FLOAT8_E5M2, "F8_E5M2"},
+      {phi::DataType::COMPLEX64, "C64"},
+      {phi::DataType::COMPLEX128, "C128"},
+  };
+  return names;
+}
+
+std::string DtypeToName(phi::DataType dtype) {
+  for (const auto& item : DtypeNames()) {
+    if (item.first == dtype) return item.second;
+  }
+  PADDLE_THROW(common::errors::Unimplemented(
+      "The flat parameter format does not support the data type %s.",
+      phi::DataTypeToString(dtype)));
+}
+
+phi::DataType NameToDtype(const std::string& name,
+                          const std::string& file_path) {
+  for (const auto& item : DtypeNames()) {
+    if (item.second == name) return item.first;
+  }
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "Unknown data type %s in the flat parameter file %s.", name, file_path));
+}
+
+// The tensor data pointing to the mapped file, which keeps the file mapped
+// while it is alive.
+class FlatParamsAllocation : public phi::Allocation {
+ public:
+  FlatParamsAllocation(void* ptr, size_t size, std::shared_ptr<void> mapping)
+      : phi::Allocation(ptr, size, phi::CPUPlace()),
+        mapping_(std::move(mapping)) {}
+
+ private:
+  std::shared_ptr<void> mapping_;
+};
+
+// Maps the whole file, or reads it to an aligned buffer on Windows.
+std::shared_ptr<void> MapFile(const std::string& file_path, size_t* size) {
+#ifdef _WIN32
+  std::ifstream fin(file_path, std::ios::binary | std::ios::ate);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fin),
+                    true,
+                    common::errors::Unavailable(
+                        "Cannot open %s to load the parameters.", file_path));
+  *size = static_cast<size_t>(fin.tellg());
+  std::shared_ptr<phi::Allocation> buffer =
+      paddle::memory::AllocShared(phi::CPUPlace(), *size);
+  fin.seekg(0);
+  fin.read(static_cast<char*>(buffer->ptr()),
+           static_cast<std::streamsize>(*size));
+  return std::shared_ptr<void>(buffer, buffer->ptr());
+#else
+  int fd = open(file_path.c_str(), O_RDONLY);
+  PADDLE_ENFORCE_GE(fd,
+                    0,
+                    common::errors::Unavailable(
+                        "Cannot open %s to load the parameters.", file_path));
+  struct stat file_stat;
+  void* addr = MAP_FAILED;
+  if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    *size = static_cast<size_t>(file_stat.st_size);
+    // Private and writable, so that the tensors pointing to the mapping may
+    // be modified in place without writing to the file.
+    addr = mmap(nullptr, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  PADDLE_ENFORCE_NE(
+      addr,
+      MAP_FAILED,
+      common::errors::Unavailable("Cannot map %s to load the parameters.",
+                                  file_path));
+  size_t mapped_size = *size;
+  return std::shared_ptr<void>(
+      addr, [mapped_size](void* p) { munmap(p, mapped_size); });
+#endif
+}
+
+}  // namespace
+
+bool FlatParamsFile::Match(const std::string& file_path) {
+  std::ifstream fin(file_path, std::ios::binary | std::ios::ate);
+  if (!fin) return false;
+  const auto file_size = static_cast<uint64_t>(fin.tellg());
+  fin.seekg(0);
+  uint64_t header_size = 0;
+  char first = 0;
+  if (!fin.read(reinterpret_cast<char*>(&header_size), sizeof(header_size)) ||
+      !fin.get(first)) {
+    return false;
+  }
+  // The combined format begins with a uint32 version 0 and the uint64 LoD
+  // level, whose bytes in place of the '{' are zero. The pickles of
+  // paddle.save begin with bytes too large for the size of the header.
+  return header_size > 0 && header_size <= file_size - sizeof(header_size) &&
+         first == '{';
+}
+
+void FlatParamsFile::Save(const std::vector<const phi::DenseTensor*>& x,
+                          const std::vector<std::string>& names,
+                          const std::string& file_path,
+                          bool overwrite) {
+  PADDLE_ENFORCE_EQ(
+      FileExists(file_path) && !overwrite,
+      false,
+      common::errors::PreconditionNotMet(
+          "%s exists!, cannot save to it when overwrite is set to false.",
+          file_path));
+  PADDLE_ENFORCE_EQ(x.size(),
+                    names.size(),
+                    common::errors::InvalidArgument(
+                        "The number of tensors (%d) and of names (%d) to be "
+                        "saved should be the same.",
+                        x.size(),
+                        names.size()));
+
+  Json header;
+  header["__metadata__"] = {{"format", kFlatParamsFormat}};
+  std::vector<size_t> begins;
+  size_t offset = 0;
+  for (size_t i = 0; i < x.size(); ++i) {
+    const auto& tensor = *x[i];
+    PADDLE_ENFORCE_EQ(
+        tensor.IsInitialized(),
+        true,
+        common::errors::InvalidArgument(
+            "The Tensor with Index (%d) to be saved is not initialized.", i));
+    PADDLE_ENFORCE_EQ(header.contains(names[i]),
+                      false,
+                      common::errors::InvalidArgument(
+                          "The name %s is saved more than once.", names[i]));
+    offset = AlignUp(offset);
+    const size_t bytes = tensor.numel() * phi::SizeOf(tensor.dtype());
+    header[names[i]] = {{"dtype", DtypeToName(tensor.dtype())},
+                        {"shape", common::vectorize(tensor.dims())},
+                        {"data_offsets", {offset, offset + bytes}}};
+    begins.push_back(offset);
+    offset += bytes;
+  }
+  std::string header_text = header.dump();
+  header_text.resize(AlignUp(sizeof(uint64_t) + header_text.size()) -
+                         sizeof(uint64_t),
+                     ' ');
+
+  MkDirRecursively(DirName(file_path).c_str());
+  std::ofstream fout(file_path, std::ios::binary);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fout),
+                    true,
+                    common::errors::Unavailable(
+                        "Cannot open %s to save variables.", file_path));
+  const uint64_t header_size = header_text.size();
+  fout.write(reinterpret_cast<const char*>(&header_size), sizeof(header_size));
+  fout.write(header_text.data(),
+             static_cast<std::streamsize>(header_text.size()));
+  size_t written = 0;
+  const std::string padding(kFlatParamsAlignment, '\0');
+  for (size_t i = 0; i < x.size(); ++i) {
+    fout.write(padding.data(),
+               static_cast<std::streamsize>(begins[i] - written));
+    phi::DenseTensor cpu_tensor;
+    const phi::DenseTensor* tensor = x[i];
+    if (!phi::is_cpu_place(tensor->place())) {
+      paddle::framework::TensorCopySync(*tensor, phi::CPUPlace(), &cpu_tensor);
+      tensor = &cpu_tensor;
+    }
+    const size_t bytes = tensor->numel() * phi::SizeOf(tensor->dtype());
+    fout.write(static_cast<const char*>(tensor->data()),
+               static_cast<std::streamsize>(bytes));
+    written = begins[i] + bytes;
+  }
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fout),
+                    true,
+                    common::errors::Unavailable(
+                        "Failed to write the parameters to %s.", file_path));
+  fout.close();
+  VLOG(6) << "save flat params done: " << file_path;
+}
+
+FlatParamsFile::FlatParamsFile(const std::string& file_path)
+    : file_path_(file_path) {
+  size_t size = 0;
+  mapping_ = MapFile(file_path, &size);
+  char* base = static_cast<char*>(mapping_.get());
+
+  uint64_t header_size = 0;
+  PADDLE_ENFORCE_GE(size,
+                    sizeof(header_size),
+                    common::errors::InvalidArgument(
+                        "%s is not a flat parameter file.", file_path));
+  std::memcpy(&header_size, base, sizeof(header_size));
+  PADDLE_ENFORCE_LE(header_size,
+                    size - sizeof(header_size),
+                    common::errors::InvalidArgument(
+                        "The header of the flat parameter file %s is "
+                        "truncated, please check whether the file is "
+                        "complete or damaged.",
+                        file_path));
+  data_ = base + sizeof(header_size) + header_size;
+  data_size_ = size - sizeof(header_size) - header_size;
+
+  Json header = Json::parse(base + sizeof(header_size),
+                            base + sizeof(header_size) + header_size);
+  for (const auto& item : header.items()) {
+    if (item.key() == "__metadata__") continue;
+    const auto& value = item.value();
+    Entry entry;
+    entry.dtype = NameToDtype(value.at("dtype").get<std::string>(), file_path);
+    entry.shape = value.at("shape").get<std::vector<int64_t>>();
+    entry.begin = value.at("data_offsets").at(0).get<size_t>();
+    entry.end = value.at("data_offsets").at(1).get<size_t>();
+    PADDLE_ENFORCE_EQ(entry.begin <= entry.end && entry.end <= data_size_,
+                      true,
+                      common::errors::InvalidArgument(
+                          "The data of %s is out of the flat parameter file "
+                          "%s, please check whether the file is complete or "
+                          "damaged.",
+                          item.key(),
+                          file_path));
+    names_.push_back(item.key());
+    entries_.emplace(item.key(), std::move(entry));
+  }
+  std::sort(names_.begin(),
+            names_.end(),
+            [this](const std::string& a, const std::string& b) {
+              return entries_.at(a).begin < entries_.at(b).begin;
+            });
+}
+
+void FlatParamsFile::Read(const std::string& name,
+                          phi::DenseTensor* out,
+                          const phi::DeviceContext& dev_ctx) const {
+  auto it = entries_.find(name);
+  PADDLE_ENFORCE_NE(it,
+                    entries_.end(),
+                    common::errors::NotFound(
+                        "The parameter %s is not found in %s.",
+                        name,
+                        file_path_));
+  const auto& entry = it->second;
+  out->Resize(common::make_ddim(entry.shape));
+  const size_t bytes = out->numel() * phi::SizeOf(entry.dtype);
+  PADDLE_ENFORCE_EQ(bytes,
+                    entry.end - entry.begin,
+                    common::errors::InvalidArgument(
+                        "The data of %s in %s has %d bytes, but its shape "
+                        "and data type need %d bytes.",
+                        name,
+                        file_path_,
+                        entry.end - entry.begin,
+                        bytes));
+  const auto& place = dev_ctx.GetPlace();
+  if (bytes == 0) {
+    dev_ctx.Alloc(out, entry.dtype);
+    return;
+  }
+  char* src = data_ + entry.begin;
+  // The data in the files of safetensors may not be aligned, it is copied.
+  if (phi::is_cpu_place(place) &&
+      reinterpret_cast<uintptr_t>(src) % kFlatParamsAlignment != 0) {
+    std::memcpy(dev_ctx.Alloc(out, entry.dtype), src, bytes);
+    return;
+  }
+  auto holder = std::make_shared<FlatParamsAllocation>(src, bytes, mapping_);
+  if (phi::is_cpu_place(place)) {
+    out->ResetHolderWithType(holder, entry.dtype);
+    return;
+  }
+  phi::DenseTensor cpu_tensor;
+  cpu_tensor.Resize(out->dims());
+  cpu_tensor.ResetHolderWithType(holder, entry.dtype);
+  paddle::framework::TensorCopySync(cpu_tensor, place, out);
+}
+
+}  // namespace pir
@@ -15,6 +15,7 @@
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include <stdio.h>
 #include "paddle/common/enforce.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_program.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_deserialize.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_serialize.h"
 #include "paddle/phi/common/port.h"
@@ -66,9 +67,42 @@ void WriteModule(const pir::Program& program,
   fout.close();
 }
 
+void WriteBinaryModule(const pir::Program& program,
+                       const std::string& file_path,
+                       uint64_t pir_version,
+                       bool overwrite,
+                       bool trainable) {
+  PADDLE_ENFORCE_EQ(
+      FileExists(file_path) && !overwrite,
+      false,
+      common::errors::PreconditionNotMet(
+          "%s exists!, cannot save to it when overwrite is set to false.",
+          file_path,
+          overwrite));
+
+  BinaryProgramWriter writer(pir_version, trainable);
+  std::string program_str = writer.Write(&program);
+
+  MkDirRecursively(DirName(file_path).c_str());
+  std::ofstream fout(file_path, std::ios::binary);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fout),
+                    true,
+                    common::errors::Unavailable(
+                        "Cannot open %s to save variables.", file_path));
+  fout.write(program_str.data(), program_str.size());
+  fout.close();
+}
+
 bool ReadModule(const std::string& file_path,
                 pir::Program* program,
                 int64_t pir_version) {
+  pir::OperationArenaGuard arena_guard(program->arena());
+  if (IsBinaryProgramFile(file_path)) {
+    if (pir_version < 0) {
+      pir_version = DEVELOP_VERSION;
+    }
+    return ReadBinaryModule(file_path, program, pir_version);
+  }
   std::ifstream f(file_path);
   Json data = Json::parse(f);
   if (pir_version < 0) {
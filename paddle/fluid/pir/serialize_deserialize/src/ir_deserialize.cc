@@ -36,6 +36,10 @@ pir::AttributeMap ProgramReader::RecoverOpAttributesMap(Json* attrs_json) {
   return ReadAttributesMap(attrs_json, &empty_json, attr_patch);
 }
 
+pir::Attribute ProgramReader::RecoverAttribute(Json* attr_json) {
+  return pir::parseAttr(attr_json);
+}
+
 void ProgramReader::ReadProgram(Json* program_json, pir::Program* program) {
   auto top_level_op = program->module_op();
   PADDLE_ENFORCE_EQ(
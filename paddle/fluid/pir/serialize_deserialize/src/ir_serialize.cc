@@ -44,6 +44,17 @@ Json ProgramWriter::GetAttributesMapJson(const AttributeMap& attr_map) {
   return attrs_json;
 }
 
+Json ProgramWriter::GetOpAttributesJson(const pir::Operation& op) {
+  Json attrs_json = WriteAttributesMapOpinfo(
+      const_cast<pir::Operation*>(&op), op.attributes());
+  if (trainable_) {
+    for (auto& attr_json : WriteAttributesMapOther(op.attributes())) {
+      attrs_json.emplace_back(attr_json);
+    }
+  }
+  return attrs_json;
+}
+
 Json ProgramWriter::WriteProgram(const pir::Program* program) {
   Json program_json;
   program_json[REGIONS] = Json::array();
@@ -11,14 +11,19 @@ limitations under the License. */
 
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <numeric>
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/flat_params.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include "paddle/phi/common/port.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
 
+COMMON_DECLARE_bool(mmap_params_zero_copy);
+
 namespace pir {
 
 const phi::DeviceContext* GetDeviceContext(
@@ -206,9 +211,34 @@ void LoadCombineFunction(const std::string& file_path,
                         "it to be greater than 0.",
                         out->size()));
   const phi::DeviceContext* dev_ctx = GetDeviceContext(*(out->at(0)), place);
+  if (FlatParamsFile::Match(file_path)) {
+    // The parameters are looked up by name, the others in the file are not
+    // read.
+    fin.close();
+    FlatParamsFile flat_file(file_path);
+    for (size_t i = 0; i < names.size(); i++) {
+      auto tensor = out->at(i);
+      flat_file.Read(names[i], tensor, *dev_ctx);
+      if (load_as_fp16 && tensor->dtype() != phi::DataType::FLOAT16) {
+        auto cast_in = *tensor;
+        *tensor = CastTensorType(dev_ctx, cast_in, phi::DataType::FLOAT16);
+      }
+    }
+    return;
+  }
+  std::unique_ptr<paddle::framework::MappedTensorFile> mapped_file;
+  if (paddle::framework::UseMappedTensorFile()) {
+    fin.close();
+    mapped_file = std::make_unique<paddle::framework::MappedTensorFile>(
+        file_path, FLAGS_mmap_params_zero_copy);
+  }
   for (size_t i = 0; i < names.size(); i++) {
     auto tensor = out->at(i);
-    paddle::framework::DeserializeFromStream(fin, tensor, *dev_ctx);
+    if (mapped_file) {
+      mapped_file->Next(tensor, *dev_ctx);
+    } else {
+      paddle::framework::DeserializeFromStream(fin, tensor, *dev_ctx);
+    }
 
     auto in_dtype = tensor->dtype();
     auto out_dtype = load_as_fp16 ? phi::DataType::FLOAT16 : in_dtype;
@@ -217,8 +247,14 @@ void LoadCombineFunction(const std::string& file_path,
       *tensor = CastTensorType(dev_ctx, cast_in, out_dtype);
     }
   }
-  fin.peek();
-  PADDLE_ENFORCE_EQ(fin.eof(),
+  bool at_end = false;
+  if (mapped_file) {
+    at_end = mapped_file->AtEnd();
+  } else {
+    fin.peek();
+    at_end = fin.eof();
+  }
+  PADDLE_ENFORCE_EQ(at_end,
                     true,
                     common::errors::Unavailable(
                         "Not allowed to load partial data via "
@@ -14,20 +14,59 @@
 
 #include "paddle/fluid/pir/transforms/build_cinn_pass.h"
 
+#include <algorithm>
+
 #include "paddle/cinn/hlir/dialect/operator/ir/manual_op.h"
 #include "paddle/cinn/hlir/framework/pir/utils.h"
 #include "paddle/cinn/utils/string.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/pir/transforms/sub_graph_detector.h"
 #include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/builtin_type.h"
+#include "paddle/pir/include/dialect/shape/utils/shape_analysis.h"
 #include "paddle/pir/include/pass/pass.h"
 #include "paddle/pir/include/pass/pass_registry.h"
 
+COMMON_DECLARE_bool(cinn_horizontal_merge_subgraph);
+
 namespace {
 using GroupOpsVec = std::vector<pir::Operation*>;
 using CompatibleInfo = cinn::hlir::framework::pir::CompatibleInfo;
 
 void VerifyOperationOrder(const pir::Block& block);
 
+// The sub-graphs whose outputs have the same shapes have compatible
+// iteration spaces, merging them lets the operator fusion fuse them
+// horizontally. It returns an empty key for the sub-graphs not to merge.
+std::string HorizontalMergeKey(const GroupOpsVec& group_ops) {
+  if (group_ops.size() == 1 && group_ops[0]->name() == "pd_op.full") {
+    return "";
+  }
+  std::vector<std::string> shapes;
+  for (const auto& value : ::pir::AnalysisOutputs(group_ops)) {
+    auto type = value.type().dyn_cast<pir::DenseTensorType>();
+    if (!type) {
+      return "";
+    }
+    std::vector<std::string> dims;
+    if (common::contain_unknown_dim(type.dims())) {
+      auto& shape_analysis = pir::ShapeAnalysisManager::Instance().Get(
+          value.defining_op()->GetParentProgram());
+      for (const auto& dim :
+           shape_analysis.GetShapeOrDataForValue(value).shape()) {
+        dims.push_back(symbol::ToString(dim));
+      }
+    } else {
+      for (int i = 0; i < type.dims().size(); ++i) {
+        dims.push_back(std::to_string(type.dims()[i]));
+      }
+    }
+    shapes.push_back(cinn::utils::Join(dims, ","));
+  }
+  std::sort(shapes.begin(), shapes.end());
+  return cinn::utils::Join(shapes, ";");
+}
+
 class BuildCinnPass : public pir::Pass {
  public:
   BuildCinnPass() : pir::Pass("build_cinn_pass", /*opt_level=*/1) {}
@@ -48,8 +87,11 @@ class BuildCinnPass : public pir::Pass {
 
  private:
   void ProcessBlock(pir::Block* block) {
-    std::vector<GroupOpsVec> groups =
-        ::pir::SubgraphDetector(block, CompatibleInfo::IsSupportForCinn)();
+    std::vector<GroupOpsVec> groups = ::pir::SubgraphDetector(
+        block,
+        CompatibleInfo::IsSupportForCinn,
+        FLAGS_cinn_horizontal_merge_subgraph ? HorizontalMergeKey
+                                             : nullptr)();
     AddStatistics(groups.size());
     for (auto& group_ops : groups) {
       if (group_ops.size() == 1 && group_ops[0]->name() == "pd_op.full") {
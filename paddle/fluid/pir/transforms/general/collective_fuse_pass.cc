@@ -0,0 +1,264 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/general/collective_fuse_pass.h"
+
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/dialect/operator/trait/inplace.h"
+#include "paddle/fluid/pir/dialect/operator/utils/utils.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+// Fuses runs of small c_allreduce_*, c_allgather and all_gather ops of a
+// block on the same communicator into one collective on the concatenation
+// of their flattened inputs, whose result is split back. Each collective
+// launch costs about the same below some size, so the fused one takes about
+// as long as one of the small ones.
+//
+// The fused op is placed after the last op of its run. A run ends at an op
+// reading the result of one of its ops, or updating one of their inputs in
+// place, and at any other communication op, so that the collectives keep
+// their order on all the ranks.
+class CollectiveFusePass : public pir::Pass {
+ public:
+  CollectiveFusePass() : pir::Pass("collective_fuse_pass", 1) {}
+
+  void Run(pir::Operation* op) override {
+    int64_t num_fused = 0;
+    for (size_t i = 0; i < op->num_regions(); ++i) {
+      for (auto& block : op->region(i)) {
+        num_fused += FuseBlock(&block);
+      }
+    }
+    AddStatistics(num_fused);
+  }
+
+  bool CanApplyOn(pir::Operation* op) const override {
+    return op->num_regions() > 0;
+  }
+
+ private:
+  // Collectives of larger inputs are bandwidth bound, they gain little from
+  // the fusion and would pay for the copies.
+  static constexpr int64_t kMaxInputBytes = 1 << 20;
+  static constexpr int64_t kMaxFusedBytes = 32 << 20;
+
+  static bool IsAllGather(pir::Operation* op) {
+    return op->isa<paddle::dialect::CAllgatherOp>() ||
+           op->isa<paddle::dialect::AllGatherOp>();
+  }
+
+  static bool IsFusible(pir::Operation* op) {
+    return op->isa<paddle::dialect::CAllreduceSumOp>() ||
+           op->isa<paddle::dialect::CAllreduceMaxOp>() ||
+           op->isa<paddle::dialect::CAllreduceMinOp>() ||
+           op->isa<paddle::dialect::CAllreduceProdOp>() || IsAllGather(op);
+  }
+
+  static int64_t Numel(pir::Value value) {
+    int64_t numel = 1;
+    for (int64_t dim : pir::GetShapeFromValue(value)) {
+      if (dim <= 0) return -1;
+      numel *= dim;
+    }
+    return numel;
+  }
+
+  static int64_t Bytes(pir::Value value) {
+    return Numel(value) *
+           phi::SizeOf(paddle::dialect::TransToPhiDataType(
+               pir::GetDataTypeFromValue(value)));
+  }
+
+  // Ops with equal keys are fused together, an empty key means the op is left
+  // alone. The key holds the op name, the dtype of the input and the
+  // attributes, the communicator among them.
+  std::string GroupKey(pir::Operation* op) const {
+    if (!IsFusible(op)) return "";
+    pir::Value x = op->operand_source(0);
+    if (!x || !x.type().isa<paddle::dialect::DenseTensorType>()) return "";
+    int64_t numel = Numel(x);
+    if (numel <= 0 || Bytes(x) > kMaxInputBytes) return "";
+
+    std::ostringstream key;
+    key << op->name() << " " << pir::GetDataTypeFromValue(x) << " "
+        << op->attribute<pir::Int32Attribute>("ring_id").data();
+    if (IsAllGather(op)) {
+      int nranks = op->attribute<pir::Int32Attribute>("nranks").data();
+      if (nranks <= 0) return "";
+      key << " " << nranks;
+    }
+    for (auto name : {"use_calc_stream", "use_model_parallel"}) {
+      if (op->HasAttribute(name)) {
+        key << " " << op->attribute<pir::BoolAttribute>(name).data();
+      }
+    }
+    return key.str();
+  }
+
+  static pir::Value BuildCollective(pir::Builder* builder,
+                                    pir::Operation* op,
+                                    pir::Value x) {
+    const auto& attrs = op->attributes();
+    if (op->isa<paddle::dialect::CAllreduceSumOp>()) {
+      return builder->Build<paddle::dialect::CAllreduceSumOp>(x, attrs).out();
+    } else if (op->isa<paddle::dialect::CAllreduceMaxOp>()) {
+      return builder->Build<paddle::dialect::CAllreduceMaxOp>(x, attrs).out();
+    } else if (op->isa<paddle::dialect::CAllreduceMinOp>()) {
+      return builder->Build<paddle::dialect::CAllreduceMinOp>(x, attrs).out();
+    } else if (op->isa<paddle::dialect::CAllreduceProdOp>()) {
+      return builder->Build<paddle::dialect::CAllreduceProdOp>(x, attrs)
+          .out();
+    } else if (op->isa<paddle::dialect::CAllgatherOp>()) {
+      return builder->Build<paddle::dialect::CAllgatherOp>(x, attrs).out();
+    }
+    return builder->Build<paddle::dialect::AllGatherOp>(x, attrs).out();
+  }
+
+  static pir::Value Reshape(pir::Builder* builder,
+                            pir::Value x,
+                            const std::vector<int64_t>& shape) {
+    return builder->Build<paddle::dialect::ReshapeOp>(x, shape).out();
+  }
+
+  // Replaces the ops of a run by the collective of their concatenated
+  // inputs. An allgather result holds the concatenation of each rank, so it
+  // is split along the second dim of its [nranks, numel] view.
+  bool FuseGroup(pir::Builder* builder,
+                 const std::vector<pir::Operation*>& ops) const {
+    if (ops.size() < 2) return false;
+    builder->SetInsertionPointAfter(ops.back());
+    std::vector<pir::Value> flat_inputs;
+    std::vector<int64_t> sections;
+    for (auto* op : ops) {
+      pir::Value x = op->operand_source(0);
+      flat_inputs.push_back(Reshape(builder, x, {-1}));
+      sections.push_back(Numel(x));
+    }
+    auto combine_op = builder->Build<pir::CombineOp>(flat_inputs);
+    auto concat_op =
+        builder->Build<paddle::dialect::ConcatOp>(combine_op.out(), 0);
+    pir::Value out = BuildCollective(builder, ops[0], concat_op.out());
+    int axis = 0;
+    if (IsAllGather(ops[0])) {
+      int64_t nranks =
+          ops[0]->attribute<pir::Int32Attribute>("nranks").data();
+      out = Reshape(builder, out, {nranks, -1});
+      axis = 1;
+    }
+    auto split_op =
+        builder->Build<paddle::dialect::SplitOp>(out, sections, axis);
+    auto parts = builder->Build<pir::SplitOp>(split_op.out()).outputs();
+    for (size_t i = 0; i < ops.size(); ++i) {
+      pir::Value result = ops[i]->result(0);
+      result.ReplaceAllUsesWith(
+          Reshape(builder, parts[i], pir::GetShapeFromValue(result)));
+    }
+    VLOG(4) << "collective_fuse_pass fuses " << ops.size() << " "
+            << ops[0]->name() << " ops";
+    for (auto* op : ops) {
+      op->Erase();
+    }
+    return true;
+  }
+
+  static bool IsCommunication(pir::Operation* op) {
+    return op->HasAttribute("ring_id");
+  }
+
+  int64_t FuseBlock(pir::Block* block) {
+    pir::Builder builder(ctx_, block);
+    std::vector<pir::Operation*> group;
+    std::string group_key;
+    int64_t group_bytes = 0;
+    // The inputs and results of the ops of the run.
+    std::unordered_set<pir::Value> inputs;
+    std::unordered_set<pir::Value> results;
+    int64_t num_fused = 0;
+
+    auto flush = [&]() {
+      num_fused += FuseGroup(&builder, group);
+      group.clear();
+      group_key.clear();
+      group_bytes = 0;
+      inputs.clear();
+      results.clear();
+    };
+
+    std::vector<pir::Operation*> ops;
+    for (auto& op : *block) {
+      ops.push_back(&op);
+    }
+    for (auto* op : ops) {
+      if (group.empty()) {
+        group_key = GroupKey(op);
+        if (group_key.empty()) continue;
+      } else {
+        // The ops in the regions of an op may read anything, so the run
+        // stops there too.
+        bool ends_run = op->num_regions() > 0;
+        bool inplace = op->HasTrait<paddle::dialect::InplaceTrait>();
+        for (auto value : op->operands_source()) {
+          ends_run |= results.count(value) > 0;
+          ends_run |= inplace && inputs.count(value) > 0;
+        }
+        std::string key = GroupKey(op);
+        if (!key.empty()) {
+          ends_run |= key != group_key ||
+                      group_bytes + Bytes(op->operand_source(0)) >
+                          kMaxFusedBytes;
+        } else {
+          ends_run |= IsCommunication(op);
+        }
+        if (ends_run) flush();
+        if (key.empty()) continue;
+        group_key = key;
+      }
+      group.push_back(op);
+      group_bytes += Bytes(op->operand_source(0));
+      inputs.insert(op->operand_source(0));
+      results.insert(op->result(0));
+    }
+    flush();
+    return num_fused;
+  }
+
+  pir::IrContext* ctx_ = pir::IrContext::Instance();
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateCollectiveFusePass() {
+  return std::make_unique<CollectiveFusePass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(collective_fuse_pass, CollectiveFusePass);
@@ -0,0 +1,270 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/general/cpu_weight_only_linear_pass.h"
+
+#include <utility>
+
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/drr/include/drr_pattern_base.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+// The arch of weight_quantize and weight_only_linear for the CPU layout.
+constexpr int kCpuWeightOnlyArch = 0;
+
+bool IsSupportedWeight(const paddle::drr::MatchContext &match_ctx,
+                       const std::string &algo) {
+  if (!pir::ValueIsPersistable(match_ctx.Tensor("w"))) {
+    return false;
+  }
+  auto w_dtype = pir::GetDataTypeFromValue(match_ctx.Tensor("w"));
+  auto x_dtype = pir::GetDataTypeFromValue(match_ctx.Tensor("x"));
+  if (!w_dtype.isa<pir::Float32Type>() && !w_dtype.isa<pir::BFloat16Type>()) {
+    return false;
+  }
+  if (w_dtype != x_dtype) return false;
+
+  auto w_dims = pir::GetShapeFromValue(match_ctx.Tensor("w"));
+  auto x_dims = pir::GetShapeFromValue(match_ctx.Tensor("x"));
+  if (!(w_dims.size() == 2 && x_dims.size() >= 2)) {
+    return false;
+  }
+  // weight_quantize needs k % 64 == 0, weight_only_linear needs the rows
+  // of the quantized weight, n or n / 2 for int4, to be a multiple of 16.
+  int64_t n_align = algo == "weight_only_int4" ? 32 : 16;
+  if (w_dims.at(0) % 64 != 0 || w_dims.at(1) % n_align != 0) return false;
+  return x_dims.at(x_dims.size() - 1) == w_dims.at(0);
+}
+
+void BuildWeightOnlyLinear(paddle::drr::ResultPattern *res,
+                           const std::string &algo,
+                           int group_size,
+                           const paddle::drr::Tensor &bias,
+                           const std::string &out_name) {
+  const auto &weight_quantize =
+      res->Op(paddle::dialect::WeightQuantizeOp::name(),
+              {{"algo", res->StrAttr(algo)},
+               {"arch", res->Int32Attr(kCpuWeightOnlyArch)},
+               {"group_size", res->Int32Attr(group_size)}});
+  weight_quantize({&res->Tensor("w")},
+                  {&res->Tensor("quanted_weight_tensor"),
+                   &res->Tensor("weight_scale_tensor")});
+
+  const auto &weight_only_linear =
+      res->Op(paddle::dialect::WeightOnlyLinearOp::name(),
+              {{"weight_dtype",
+                res->StrAttr(algo == "weight_only_int8" ? "int8" : "int4")},
+               {"arch", res->Int32Attr(kCpuWeightOnlyArch)},
+               {"group_size", res->Int32Attr(group_size)}});
+  weight_only_linear({&res->Tensor("x"),
+                      &res->Tensor("quanted_weight_tensor"),
+                      &bias,
+                      &res->Tensor("weight_scale_tensor")},
+                     {&res->Tensor(out_name)});
+}
+
+class CpuWeightOnlyLinearWithBiasPattern : public paddle::drr::DrrPatternBase {
+ private:
+  bool reverse_add_;
+  std::string algo_;
+  int group_size_;
+
+ public:
+  CpuWeightOnlyLinearWithBiasPattern(bool reverse_add,
+                                     std::string algo,
+                                     int group_size)
+      : reverse_add_(reverse_add),
+        algo_(std::move(algo)),
+        group_size_(group_size) {}
+
+  std::string name() const override {
+    return "CpuWeightOnlyLinearWithBiasPattern";
+  }
+
+  uint32_t benefit() const override { return 2; }
+
+  void operator()(paddle::drr::DrrPatternContext *ctx) const override {
+    paddle::drr::SourcePattern src = ctx->SourcePattern();
+    const auto &matmul =
+        src.Op(paddle::dialect::MatmulOp::name(),
+               {{"transpose_x", src.Attr("matmul_transpose_x")},
+                {"transpose_y", src.Attr("matmul_transpose_y")}});
+    src.Tensor("matmul_out") = matmul(src.Tensor("x"), src.Tensor("w"));
+    const auto &add = src.Op(paddle::dialect::AddOp::name());
+    src.Tensor("add_out") =
+        reverse_add_ ? add(src.Tensor("matmul_out"), src.Tensor("bias"))
+                     : add(src.Tensor("bias"), src.Tensor("matmul_out"));
+
+    src.AddConstraint([this](const paddle::drr::MatchContext &match_ctx) {
+      if (match_ctx.Attr<bool>("matmul_transpose_x") ||
+          match_ctx.Attr<bool>("matmul_transpose_y")) {
+        return false;
+      }
+      if (!IsSupportedWeight(match_ctx, algo_)) return false;
+      auto w_dims = pir::GetShapeFromValue(match_ctx.Tensor("w"));
+      auto bias_dims = pir::GetShapeFromValue(match_ctx.Tensor("bias"));
+      return bias_dims.size() == 1 && bias_dims.at(0) == w_dims.at(1);
+    });
+
+    paddle::drr::ResultPattern res = src.ResultPattern();
+    BuildWeightOnlyLinear(
+        &res, algo_, group_size_, res.Tensor("bias"), "add_out");
+  }
+};
+
+class CpuWeightOnlyLinearNoBiasPattern : public paddle::drr::DrrPatternBase {
+ private:
+  std::string algo_;
+  int group_size_;
+
+ public:
+  CpuWeightOnlyLinearNoBiasPattern(std::string algo, int group_size)
+      : algo_(std::move(algo)), group_size_(group_size) {}
+
+  std::string name() const override {
+    return "CpuWeightOnlyLinearNoBiasPattern";
+  }
+
+  uint32_t benefit() const override { return 1; }
+
+  void operator()(paddle::drr::DrrPatternContext *ctx) const override {
+    paddle::drr::SourcePattern src = ctx->SourcePattern();
+    const auto &matmul =
+        src.Op(paddle::dialect::MatmulOp::name(),
+               {{"transpose_x", src.Attr("matmul_transpose_x")},
+                {"transpose_y", src.Attr("matmul_transpose_y")}});
+    src.Tensor("matmul_out") = matmul(src.Tensor("x"), src.Tensor("w"));
+
+    src.AddConstraint([this](const paddle::drr::MatchContext &match_ctx) {
+      if (match_ctx.Attr<bool>("matmul_transpose_x") ||
+          match_ctx.Attr<bool>("matmul_transpose_y")) {
+        return false;
+      }
+      return IsSupportedWeight(match_ctx, algo_);
+    });
+
+    paddle::drr::ResultPattern res = src.ResultPattern();
+    BuildWeightOnlyLinear(
+        &res, algo_, group_size_, res.InputNoneTensor(), "matmul_out");
+  }
+};
+
+class CpuWeightOnlyLinearFcPattern : public paddle::drr::DrrPatternBase {
+ private:
+  std::string algo_;
+  int group_size_;
+
+ public:
+  CpuWeightOnlyLinearFcPattern(std::string algo, int group_size)
+      : algo_(std::move(algo)), group_size_(group_size) {}
+
+  std::string name() const override { return "CpuWeightOnlyLinearFcPattern"; }
+
+  uint32_t benefit() const override { return 2; }
+
+  void operator()(paddle::drr::DrrPatternContext *ctx) const override {
+    paddle::drr::SourcePattern src = ctx->SourcePattern();
+    const auto &fc =
+        src.Op(paddle::dialect::FcOp::name(),
+               {{"in_num_col_dims", src.Attr("in_num_col_dims")},
+                {"activation_type", src.Attr("activation_type")},
+                {"padding_weights", src.Attr("padding_weights")}});
+    src.Tensor("fc_out") =
+        fc(src.Tensor("x"), src.Tensor("w"), src.Tensor("bias"));
+
+    src.AddConstraint([this](const paddle::drr::MatchContext &match_ctx) {
+      if (!match_ctx.Attr<std::string>("activation_type").empty() ||
+          match_ctx.Attr<bool>("padding_weights")) {
+        return false;
+      }
+      if (!IsSupportedWeight(match_ctx, algo_)) return false;
+      auto x_dims = pir::GetShapeFromValue(match_ctx.Tensor("x"));
+      if (match_ctx.Attr<int>("in_num_col_dims") !=
+          static_cast<int>(x_dims.size()) - 1) {
+        return false;
+      }
+      auto w_dims = pir::GetShapeFromValue(match_ctx.Tensor("w"));
+      auto bias_dims = pir::GetShapeFromValue(match_ctx.Tensor("bias"));
+      return bias_dims.size() == 1 && bias_dims.at(0) == w_dims.at(1);
+    });
+
+    paddle::drr::ResultPattern res = src.ResultPattern();
+    BuildWeightOnlyLinear(
+        &res, algo_, group_size_, res.Tensor("bias"), "fc_out");
+  }
+};
+
+class CpuWeightOnlyLinearPass : public pir::PatternRewritePass {
+ public:
+  CpuWeightOnlyLinearPass()
+      : pir::PatternRewritePass("cpu_weight_only_linear_pass", 2) {}
+
+  pir::RewritePatternSet InitializePatterns(pir::IrContext *context) override {
+    std::string algo = "weight_only_int8";
+    if (Has("weight_only_algo")) {
+      algo = Get<std::string>("weight_only_algo");
+    }
+    PADDLE_ENFORCE_EQ(algo == "weight_only_int8" || algo == "weight_only_int4",
+                      true,
+                      common::errors::InvalidArgument(
+                          "cpu_weight_only_linear_pass only support "
+                          "weight_only_int8 or weight_only_int4, but get %s.",
+                          algo));
+    int group_size = -1;
+    if (Has("weight_only_group_size")) {
+      group_size = Get<int>("weight_only_group_size");
+    }
+    PADDLE_ENFORCE_EQ(
+        group_size == -1 || group_size == 64 || group_size == 128,
+        true,
+        common::errors::InvalidArgument(
+            "cpu_weight_only_linear_pass only support group_size -1, 64 or "
+            "128, but get %d.",
+            group_size));
+
+    pir::RewritePatternSet ps(context);
+    ps.Add(paddle::drr::Create<CpuWeightOnlyLinearWithBiasPattern>(
+        context, true, algo, group_size));
+    ps.Add(paddle::drr::Create<CpuWeightOnlyLinearWithBiasPattern>(
+        context, false, algo, group_size));
+    ps.Add(paddle::drr::Create<CpuWeightOnlyLinearFcPattern>(
+        context, algo, group_size));
+    ps.Add(paddle::drr::Create<CpuWeightOnlyLinearNoBiasPattern>(
+        context, algo, group_size));
+    return ps;
+  }
+
+  pir::GreedyRewriteConfig InitializeConfig() override {
+    pir::GreedyRewriteConfig config;
+    // NOTE: Ensure that WithBiasPattern is executed before NoBiasPattern.
+    config.use_top_down_traversal = false;
+    config.max_iterations = 10;
+    return config;
+  }
+};
+
+}  // namespace
+
+namespace pir {
+std::unique_ptr<Pass> CreateCpuWeightOnlyLinearPass() {
+  return std::make_unique<CpuWeightOnlyLinearPass>();
+}
+}  // namespace pir
+
+REGISTER_IR_PASS(cpu_weight_only_linear_pass, CpuWeightOnlyLinearPass);
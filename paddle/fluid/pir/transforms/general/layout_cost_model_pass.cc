@@ -0,0 +1,617 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/general/layout_cost_model_pass.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+#include "paddle/common/layout.h"
+#include "paddle/fluid/pir/dialect/operator/interface/layout_transformation.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/dialect/operator/utils/utils.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/op_trait.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+#include "paddle/pir/include/pass/utils.h"
+
+COMMON_DECLARE_string(layout_cost_model_file);
+
+namespace {
+
+using DenseTensorType = paddle::dialect::DenseTensorType;
+using common::DataLayout;
+
+// Large enough to never be cut, but finite so that the residual capacities
+// stay well defined.
+constexpr double kInfCost = 1e30;
+
+// The coefficients used for the kernels missing from the calibration file.
+// The work of a conv like op is its multiply-adds, the work of the others is
+// the elements they read and write, so a multiply-add is taken as much
+// cheaper than moving an element.
+constexpr double kDefaultConvCost = 1.0 / 32;
+constexpr double kDefaultElementCost = 1.0;
+constexpr double kDefaultTransposeCost = 2.0;
+// Without measurements, the layout an op prefers runs twice as fast.
+constexpr double kDefaultPreferLayoutFactor = 0.5;
+
+bool Is4DDenseTensor(pir::Value value) {
+  if (!value || !value.type()) return false;
+  auto type = value.type().dyn_cast<DenseTensorType>();
+  return type && type.dims().size() == 4;
+}
+
+// The dynamic dims are counted as 1, they scale the cost of every op of a
+// region alike.
+int64_t KnownNumel(pir::Value value) {
+  auto dims = value.type().dyn_cast<DenseTensorType>().dims();
+  int64_t numel = 1;
+  for (int i = 0; i < dims.size(); ++i) {
+    numel *= std::max<int64_t>(dims[i], 1);
+  }
+  return numel;
+}
+
+std::string DtypeName(pir::Value value) {
+  return phi::DataTypeToString(paddle::dialect::TransToPhiDataType(
+      value.type().dyn_cast<DenseTensorType>().dtype()));
+}
+
+bool HasDataFormat(pir::Operation* op) {
+  return op->HasAttribute("data_format") &&
+         op->attribute("data_format").isa<pir::StrAttribute>();
+}
+
+DataLayout GetDataFormat(pir::Operation* op) {
+  return common::StringToDataLayout(
+      op->attribute<pir::StrAttribute>("data_format").AsString());
+}
+
+// Conv like ops take a 4-D filter as their second operand.
+bool IsConvLike(pir::Operation* op) {
+  return HasDataFormat(op) && op->num_operands() > 1 &&
+         Is4DDenseTensor(op->operand_source(1)) && op->num_results() > 0 &&
+         Is4DDenseTensor(op->result(0));
+}
+
+/**
+ * LayoutCostModel estimates the time of a kernel in a layout as the work of
+ * the op times a per kernel coefficient. The coefficients are calibrated
+ * by the file of FLAGS_layout_cost_model_file, whose lines are
+ *
+ *   <op name> <dtype|*> <NCHW|NHWC|*> <time per unit of work>
+ *
+ * measured by autotuning the kernels of both layouts, e.g.
+ * `pd_op.fused_conv2d_add_act float16 NHWC 0.0021`. The cost of the inserted
+ * transposes is calibrated by the lines of `pd_op.transpose`.
+ */
+class LayoutCostModel {
+ public:
+  void Load(const std::string& path) {
+    std::ifstream fin(path);
+    PADDLE_ENFORCE_EQ(
+        fin.is_open(),
+        true,
+        common::errors::NotFound("Cannot open the layout cost model %s.",
+                                 path));
+    std::string line;
+    while (std::getline(fin, line)) {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream ss(line);
+      std::string op_name, dtype, layout;
+      double coefficient = 0.0;
+      ss >> op_name >> dtype >> layout >> coefficient;
+      PADDLE_ENFORCE_EQ(
+          !ss.fail() && coefficient >= 0.0,
+          true,
+          common::errors::InvalidArgument(
+              "The line `%s` of the layout cost model %s should be "
+              "`<op name> <dtype> <layout> <non-negative coefficient>`.",
+              line,
+              path));
+      coefficients_[Key(op_name, dtype, layout)] = coefficient;
+    }
+    VLOG(4) << "Load " << coefficients_.size()
+            << " kernel coefficients from " << path;
+  }
+
+  double OpCost(pir::Operation* op, DataLayout layout) {
+    bool conv_like = IsConvLike(op);
+    double work = 0.0;
+    if (conv_like) {
+      auto filter = op->operand_source(1);
+      auto filter_dims = filter.type().dyn_cast<DenseTensorType>().dims();
+      work = static_cast<double>(KnownNumel(op->result(0))) *
+             KnownNumel(filter) / std::max<int64_t>(filter_dims[0], 1);
+    } else {
+      for (auto value : op->operands_source()) {
+        if (Is4DDenseTensor(value)) work += KnownNumel(value);
+      }
+      for (auto value : op->results()) {
+        if (Is4DDenseTensor(value)) work += KnownNumel(value);
+      }
+    }
+
+    auto coefficient =
+        Lookup(op->name(),
+               Is4DDenseTensor(op->result(0)) ? DtypeName(op->result(0)) : "*",
+               common::DataLayoutToString(layout));
+    if (coefficient.has_value()) {
+      return *coefficient * work;
+    }
+    double cost = (conv_like ? kDefaultConvCost : kDefaultElementCost) * work;
+    auto layout_iface =
+        op->dyn_cast<paddle::dialect::LayoutTransformationInterface>();
+    if (HasDataFormat(op) && layout_iface.PreferLayout(op) == layout) {
+      cost *= kDefaultPreferLayoutFactor;
+    }
+    return cost;
+  }
+
+  double TransposeCost(pir::Value value) {
+    auto coefficient = Lookup(
+        paddle::dialect::TransposeOp::name(), DtypeName(value), "*");
+    return coefficient.value_or(kDefaultTransposeCost) * KnownNumel(value);
+  }
+
+ private:
+  static std::string Key(const std::string& op_name,
+                         const std::string& dtype,
+                         const std::string& layout) {
+    return op_name + " " + dtype + " " + layout;
+  }
+
+  std::optional<double> Lookup(const std::string& op_name,
+                               const std::string& dtype,
+                               const std::string& layout) const {
+    for (const auto& key : {Key(op_name, dtype, layout),
+                            Key(op_name, "*", layout),
+                            Key(op_name, dtype, "*"),
+                            Key(op_name, "*", "*")}) {
+      auto it = coefficients_.find(key);
+      if (it != coefficients_.end()) return it->second;
+    }
+    return std::nullopt;
+  }
+
+  std::unordered_map<std::string, double> coefficients_;
+};
+
+// Dinic's max flow on a graph of dense node ids.
+class MinCutGraph {
+ public:
+  explicit MinCutGraph(size_t num_nodes) : adjs_(num_nodes) {}
+
+  size_t AddNode() {
+    adjs_.emplace_back();
+    return adjs_.size() - 1;
+  }
+
+  void AddEdge(size_t src, size_t dst, double capacity) {
+    if (src == dst || capacity <= 0.0) return;
+    adjs_[src].push_back(edges_.size());
+    edges_.push_back({dst, capacity});
+    adjs_[dst].push_back(edges_.size());
+    edges_.push_back({src, 0.0});
+  }
+
+  // Returns the value of the minimum cut and marks the nodes on its source
+  // side.
+  double MinCut(size_t source, size_t sink, std::vector<bool>* source_side) {
+    double total_flow = 0.0;
+    while (BuildLevels(source, sink)) {
+      next_arcs_.assign(adjs_.size(), 0);
+      while (double flow = Augment(source, sink, kInfCost)) {
+        total_flow += flow;
+      }
+    }
+    BuildLevels(source, sink);
+    source_side->assign(adjs_.size(), false);
+    for (size_t i = 0; i < adjs_.size(); ++i) {
+      (*source_side)[i] = levels_[i] >= 0;
+    }
+    return total_flow;
+  }
+
+ private:
+  struct Edge {
+    size_t dst;
+    double capacity;
+  };
+
+  bool BuildLevels(size_t source, size_t sink) {
+    levels_.assign(adjs_.size(), -1);
+    std::queue<size_t> queue;
+    levels_[source] = 0;
+    queue.push(source);
+    while (!queue.empty()) {
+      size_t node = queue.front();
+      queue.pop();
+      for (size_t e : adjs_[node]) {
+        if (edges_[e].capacity > 0.0 && levels_[edges_[e].dst] < 0) {
+          levels_[edges_[e].dst] = levels_[node] + 1;
+          queue.push(edges_[e].dst);
+        }
+      }
+    }
+    return levels_[sink] >= 0;
+  }
+
+  double Augment(size_t node, size_t sink, double limit) {
+    if (node == sink) return limit;
+    for (size_t& i = next_arcs_[node]; i < adjs_[node].size(); ++i) {
+      size_t e = adjs_[node][i];
+      size_t dst = edges_[e].dst;
+      if (edges_[e].capacity <= 0.0 || levels_[dst] != levels_[node] + 1) {
+        continue;
+      }
+      double flow =
+          Augment(dst, sink, std::min(limit, edges_[e].capacity));
+      if (flow > 0.0) {
+        edges_[e].capacity -= flow;
+        edges_[e ^ 1].capacity += flow;
+        return flow;
+      }
+    }
+    return 0.0;
+  }
+
+  std::vector<Edge> edges_;
+  std::vector<std::vector<size_t>> adjs_;
+  std::vector<int> levels_;
+  std::vector<size_t> next_arcs_;
+};
+
+constexpr int64_t kFixedNCHW = -1;
+constexpr int64_t kFixedNHWC = -2;
+
+// A 4-D value between a producer and its consumers, each of them either a
+// flexible op (its index) or a fixed layout.
+struct Coupling {
+  pir::Value value;
+  int64_t producer;
+  std::vector<int64_t> consumers;
+};
+
+class LayoutCostModelPass : public pir::Pass {
+ public:
+  LayoutCostModelPass() : pir::Pass("layout_cost_model_pass", 2) {}
+
+  bool CanApplyOn(pir::Operation* op) const override {
+    return op->isa<pir::ModuleOp>() && op->num_regions() > 0;
+  }
+
+  void Run(pir::Operation* op) override {
+    pir::IrContext* ctx = pir::IrContext::Instance();
+    ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+    ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+    block_ = op->dyn_cast<pir::ModuleOp>().program()->block();
+
+    LayoutCostModel cost_model;
+    if (!FLAGS_layout_cost_model_file.empty()) {
+      cost_model.Load(FLAGS_layout_cost_model_file);
+    }
+
+    flexible_ops_.clear();
+    flexible_index_.clear();
+    for (auto& inner_op : *block_) {
+      if (IsFlexible(&inner_op)) {
+        flexible_index_[&inner_op] = flexible_ops_.size();
+        flexible_ops_.push_back(&inner_op);
+      }
+    }
+    if (flexible_ops_.empty()) return;
+
+    auto couplings = CollectCouplings();
+    auto active = FindActiveRegions(couplings);
+
+    // Node 0 holds the NCHW side and node 1 the NHWC side, a flexible op is
+    // NHWC iff it is cut from node 0. Each coupling costs one transpose when
+    // any consumer differs from its producer, modelled exactly by two
+    // auxiliary nodes: z1 is forced to the NHWC side by an NHWC consumer and
+    // cuts the producer edge when the producer is NCHW, z2 the reverse.
+    MinCutGraph graph(2 + flexible_ops_.size());
+    auto node_of = [&](int64_t endpoint) -> size_t {
+      if (endpoint == kFixedNHWC) return 1;
+      if (endpoint == kFixedNCHW || !active[endpoint]) return 0;
+      return 2 + endpoint;
+    };
+    double baseline_cost = 0.0;
+    for (size_t i = 0; i < flexible_ops_.size(); ++i) {
+      if (!active[i]) continue;
+      double nchw_cost = cost_model.OpCost(flexible_ops_[i], DataLayout::NCHW);
+      double nhwc_cost = cost_model.OpCost(flexible_ops_[i], DataLayout::NHWC);
+      graph.AddEdge(0, 2 + i, nhwc_cost);
+      graph.AddEdge(2 + i, 1, nchw_cost);
+      baseline_cost += nchw_cost;
+    }
+    for (auto& coupling : couplings) {
+      if (!TouchesActive(coupling, active)) continue;
+      double transpose_cost = cost_model.TransposeCost(coupling.value);
+      size_t producer = node_of(coupling.producer);
+      size_t z1 = graph.AddNode();
+      size_t z2 = graph.AddNode();
+      graph.AddEdge(producer, z1, transpose_cost);
+      graph.AddEdge(z2, producer, transpose_cost);
+      for (int64_t consumer : coupling.consumers) {
+        graph.AddEdge(z1, node_of(consumer), kInfCost);
+        graph.AddEdge(node_of(consumer), z2, kInfCost);
+      }
+    }
+    std::vector<bool> nchw_side;
+    double best_cost = graph.MinCut(0, 1, &nchw_side);
+    VLOG(4) << "layout_cost_model_pass: the cost of keeping NCHW is "
+            << baseline_cost << ", the cheapest assignment costs "
+            << best_cost;
+
+    nhwc_.assign(flexible_ops_.size(), false);
+    for (size_t i = 0; i < flexible_ops_.size(); ++i) {
+      nhwc_[i] = active[i] && !nchw_side[2 + i];
+    }
+    Rewrite();
+  }
+
+ private:
+  // An op whose layout may be chosen: it implements RewriteByLayout and all
+  // of its relevant values are 4-D dense tensors. Like transfer_layout_pass,
+  // the program is taken as NCHW.
+  bool IsFlexible(pir::Operation* op) {
+    auto layout_iface =
+        op->dyn_cast<paddle::dialect::LayoutTransformationInterface>();
+    if (!layout_iface || op->num_regions() > 0 ||
+        op->HasTrait<pir::ImmutableLayoutTrait>()) {
+      return false;
+    }
+    // The ops with a data_format attribute rewrite it, the others rely on
+    // CanBeModified to reject what they cannot rewrite.
+    if (HasDataFormat(op)) {
+      if (GetDataFormat(op) != DataLayout::NCHW) return false;
+    } else if (!layout_iface.CanBeModified(op)) {
+      return false;
+    }
+    auto inputs = layout_iface.RelevantInputs(op);
+    auto outputs = layout_iface.RelevantOutputs(op);
+    return !inputs.empty() && !outputs.empty() &&
+           std::all_of(inputs.begin(), inputs.end(), Is4DDenseTensor) &&
+           std::all_of(outputs.begin(), outputs.end(), Is4DDenseTensor);
+  }
+
+  static bool Contains(const std::vector<pir::Value>& values,
+                       pir::Value value) {
+    return std::find(values.begin(), values.end(), value) != values.end();
+  }
+
+  std::vector<pir::Value> RelevantInputs(pir::Operation* op) {
+    return op->dyn_cast<paddle::dialect::LayoutTransformationInterface>()
+        .RelevantInputs(op);
+  }
+
+  std::vector<pir::Value> RelevantOutputs(pir::Operation* op) {
+    return op->dyn_cast<paddle::dialect::LayoutTransformationInterface>()
+        .RelevantOutputs(op);
+  }
+
+  pir::Operation* AncestorInBlock(pir::Operation* op) {
+    while (op && op->GetParent() != block_) {
+      op = op->GetParentOp();
+    }
+    return op;
+  }
+
+  int64_t FixedLayout(pir::Operation* op) {
+    if (op && HasDataFormat(op) && GetDataFormat(op) == DataLayout::NHWC) {
+      return kFixedNHWC;
+    }
+    return kFixedNCHW;
+  }
+
+  int64_t ProducerOf(pir::Value value) {
+    pir::Operation* op = value.defining_op();
+    auto it = flexible_index_.find(op);
+    if (it != flexible_index_.end() && Contains(RelevantOutputs(op), value)) {
+      return static_cast<int64_t>(it->second);
+    }
+    return FixedLayout(op);
+  }
+
+  int64_t ConsumerOf(const pir::OpOperand& use) {
+    pir::Operation* owner = use.owner();
+    pir::Operation* ancestor = AncestorInBlock(owner);
+    auto it = flexible_index_.find(ancestor);
+    if (ancestor == owner && it != flexible_index_.end() &&
+        Contains(RelevantInputs(owner), use.source())) {
+      return static_cast<int64_t>(it->second);
+    }
+    // A flexible op using the value as an irrelevant operand keeps NCHW.
+    return it != flexible_index_.end() ? kFixedNCHW : FixedLayout(ancestor);
+  }
+
+  std::vector<Coupling> CollectCouplings() {
+    std::vector<Coupling> couplings;
+    std::unordered_set<pir::Value> visited;
+    auto add = [&](pir::Value value) {
+      if (!visited.insert(value).second) return;
+      Coupling coupling{value, ProducerOf(value), {}};
+      for (auto it = value.use_begin(); it != value.use_end(); ++it) {
+        int64_t consumer = ConsumerOf(*it);
+        if (std::find(coupling.consumers.begin(),
+                      coupling.consumers.end(),
+                      consumer) == coupling.consumers.end()) {
+          coupling.consumers.push_back(consumer);
+        }
+      }
+      couplings.push_back(std::move(coupling));
+    };
+    for (auto* op : flexible_ops_) {
+      for (auto value : RelevantInputs(op)) add(value);
+      for (auto value : RelevantOutputs(op)) add(value);
+    }
+    return couplings;
+  }
+
+  // The regions are the connected components of flexible ops. A region is
+  // only considered when it holds a conv, norm or pool op, and is left
+  // untouched when it meets a value which is already NHWC.
+  std::vector<bool> FindActiveRegions(const std::vector<Coupling>& couplings) {
+    std::vector<size_t> parents(flexible_ops_.size());
+    for (size_t i = 0; i < parents.size(); ++i) parents[i] = i;
+    std::function<size_t(size_t)> find = [&](size_t i) {
+      return parents[i] == i ? i : parents[i] = find(parents[i]);
+    };
+    for (auto& coupling : couplings) {
+      int64_t first = coupling.producer;
+      for (int64_t consumer : coupling.consumers) {
+        if (consumer < 0) continue;
+        if (first < 0) {
+          first = consumer;
+        } else {
+          parents[find(consumer)] = find(first);
+        }
+      }
+    }
+
+    std::vector<bool> has_anchor(flexible_ops_.size(), false);
+    std::vector<bool> meets_nhwc(flexible_ops_.size(), false);
+    for (size_t i = 0; i < flexible_ops_.size(); ++i) {
+      if (HasDataFormat(flexible_ops_[i])) has_anchor[find(i)] = true;
+    }
+    for (auto& coupling : couplings) {
+      std::vector<int64_t> endpoints = coupling.consumers;
+      endpoints.push_back(coupling.producer);
+      bool nhwc =
+          std::count(endpoints.begin(), endpoints.end(), kFixedNHWC) > 0;
+      for (int64_t endpoint : endpoints) {
+        if (nhwc && endpoint >= 0) meets_nhwc[find(endpoint)] = true;
+      }
+    }
+    std::vector<bool> active(flexible_ops_.size(), false);
+    for (size_t i = 0; i < flexible_ops_.size(); ++i) {
+      active[i] = has_anchor[find(i)] && !meets_nhwc[find(i)];
+    }
+    return active;
+  }
+
+  static bool TouchesActive(const Coupling& coupling,
+                            const std::vector<bool>& active) {
+    if (coupling.producer >= 0 && active[coupling.producer]) return true;
+    return std::any_of(coupling.consumers.begin(),
+                       coupling.consumers.end(),
+                       [&](int64_t c) { return c >= 0 && active[c]; });
+  }
+
+  DataLayout LayoutOf(int64_t endpoint) {
+    if (endpoint == kFixedNHWC || (endpoint >= 0 && nhwc_[endpoint])) {
+      return DataLayout::NHWC;
+    }
+    return DataLayout::NCHW;
+  }
+
+  pir::Value Transposed(pir::Value value, DataLayout layout) {
+    auto it = transposed_.find(value);
+    if (it != transposed_.end()) return it->second;
+    pir::Builder builder(pir::IrContext::Instance(), block_);
+    if (value.defining_op()) {
+      builder.SetInsertionPointAfter(value.defining_op());
+    } else {
+      builder.SetInsertionPointToStart(block_);
+    }
+    const std::vector<int> perm = layout == DataLayout::NHWC
+                                      ? std::vector<int>{0, 2, 3, 1}
+                                      : std::vector<int>{0, 3, 1, 2};
+    auto transpose_op =
+        builder.Build<paddle::dialect::TransposeOp>(value, perm);
+    transpose_op->set_attribute(
+        "source",
+        pir::StrAttribute::get(pir::IrContext::Instance(),
+                               "layout_cost_model_pass"));
+    pir::SetNewLayoutForValue(transpose_op.out(), layout);
+    ++num_transpose_ops_;
+    transposed_[value] = transpose_op.out();
+    return transpose_op.out();
+  }
+
+  // Visits the ops in order, so the inputs of an op rewritten to NHWC are
+  // transposed before its InferMeta runs, and its outputs are rewritten
+  // before they are transposed back for the NCHW consumers.
+  void Rewrite() {
+    transposed_.clear();
+    num_transpose_ops_ = 0;
+    int64_t num_layout_changed_ops{0};
+    for (size_t i = 0; i < flexible_ops_.size(); ++i) {
+      if (!nhwc_[i]) continue;
+      pir::Operation* op = flexible_ops_[i];
+      auto inputs = RelevantInputs(op);
+      for (auto& operand : op->operands()) {
+        pir::Value value = operand.source();
+        if (!Contains(inputs, value) ||
+            LayoutOf(ProducerOf(value)) == DataLayout::NHWC) {
+          continue;
+        }
+        operand.set_source(Transposed(value, DataLayout::NHWC));
+      }
+      op->dyn_cast<paddle::dialect::LayoutTransformationInterface>()
+          .RewriteByLayout(op, DataLayout::NHWC);
+      ++num_layout_changed_ops;
+
+      for (auto value : RelevantOutputs(op)) {
+        std::vector<pir::OpOperand> nchw_uses;
+        for (auto it = value.use_begin(); it != value.use_end(); ++it) {
+          if (LayoutOf(ConsumerOf(*it)) == DataLayout::NCHW) {
+            nchw_uses.push_back(*it);
+          }
+        }
+        for (auto& use : nchw_uses) {
+          use.set_source(Transposed(value, DataLayout::NCHW));
+        }
+      }
+    }
+    AddStatistics(num_transpose_ops_, num_layout_changed_ops);
+  }
+
+  pir::Block* block_{nullptr};
+  std::vector<pir::Operation*> flexible_ops_;
+  std::unordered_map<pir::Operation*, size_t> flexible_index_;
+  std::vector<bool> nhwc_;
+  std::unordered_map<pir::Value, pir::Value> transposed_;
+  int64_t num_transpose_ops_{0};
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateLayoutCostModelPass() {
+  return std::make_unique<LayoutCostModelPass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(layout_cost_model_pass, LayoutCostModelPass);
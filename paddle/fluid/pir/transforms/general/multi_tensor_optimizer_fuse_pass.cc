@@ -0,0 +1,324 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/general/multi_tensor_optimizer_fuse_pass.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/pir/dialect/operator/ir/op_attribute.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+// Groups the single tensor sgd_, momentum_, adam_ and adamw_ ops of a block
+// into merged_sgd_, merged_momentum_ and fused_adam_, which update all the
+// parameters of a group in a few multi tensor launches. Only ops agreeing on
+// everything but their tensors are grouped, see GroupKey.
+class MultiTensorOptimizerFusePass : public pir::Pass {
+ public:
+  MultiTensorOptimizerFusePass()
+      : pir::Pass("multi_tensor_optimizer_fuse_pass", 1) {}
+
+  void Run(pir::Operation* op) override {
+    int64_t num_fused = 0;
+    for (size_t i = 0; i < op->num_regions(); ++i) {
+      for (auto& block : op->region(i)) {
+        num_fused += FuseBlock(&block);
+      }
+    }
+    AddStatistics(num_fused);
+  }
+
+  bool CanApplyOn(pir::Operation* op) const override {
+    return op->num_regions() > 0;
+  }
+
+ private:
+  static bool IsDenseTensor(pir::Value value) {
+    return value && value.type().isa<paddle::dialect::DenseTensorType>();
+  }
+
+  static bool ScalarFromFull(pir::Value value, float* out) {
+    if (!value) return false;
+    auto full_op = value.defining_op<paddle::dialect::FullOp>();
+    if (!full_op) return false;
+    *out = full_op.attribute<paddle::dialect::ScalarAttribute>("value")
+               .data()
+               .to<float>();
+    return true;
+  }
+
+  template <typename AttrT>
+  static auto AttrOf(pir::Operation* op, const std::string& name) {
+    return op->attribute<AttrT>(name).data();
+  }
+
+  // Ops with equal keys are fused together, an empty key means the op is left
+  // alone. The key holds the op name, the dtype of the parameter, whether it
+  // has a master parameter and every attribute the fused op takes once.
+  std::string GroupKey(pir::Operation* op) const {
+    bool is_sgd = op->isa<paddle::dialect::Sgd_Op>();
+    bool is_momentum = op->isa<paddle::dialect::Momentum_Op>();
+    bool is_adam = op->isa<paddle::dialect::Adam_Op>();
+    bool is_adamw = op->isa<paddle::dialect::Adamw_Op>();
+    if (!is_sgd && !is_momentum && !is_adam && !is_adamw) return "";
+    // The fused ops update the parameters in place too, but their vector
+    // results cannot stand in for the single ones.
+    for (uint32_t i = 0; i < op->num_results(); ++i) {
+      if (!op->result(i).use_empty()) return "";
+    }
+
+    pir::Value param = op->operand_source(0);
+    pir::Value grad = op->operand_source(is_sgd ? 2 : 1);
+    pir::Value master_param =
+        op->operand_source(is_sgd ? 3 : is_momentum ? 4 : 7);
+    if (!IsDenseTensor(param) || !IsDenseTensor(grad)) return "";
+
+    std::ostringstream key;
+    key << op->name() << " " << pir::GetDataTypeFromValue(param) << " "
+        << static_cast<bool>(master_param) << " "
+        << AttrOf<pir::BoolAttribute>(op, "multi_precision");
+    if (is_sgd) {
+      key << " " << op->operand_source(1).impl();
+    } else if (is_momentum) {
+      key << " " << AttrOf<pir::FloatAttribute>(op, "mu") << " "
+          << AttrOf<pir::BoolAttribute>(op, "use_nesterov") << " "
+          << AttrOf<pir::FloatAttribute>(op, "rescale_grad");
+    } else {
+      // fused_adam_ takes a single learning rate, constant betas and epsilon
+      // and no lr_ratio.
+      float beta1, beta2, epsilon;
+      if (op->operand_source(8) ||
+          !ScalarFromFull(op->operand_source(9), &beta1) ||
+          !ScalarFromFull(op->operand_source(10), &beta2) ||
+          !ScalarFromFull(op->operand_source(11), &epsilon) ||
+          AttrOf<pir::BoolAttribute>(op, "lazy_mode")) {
+        return "";
+      }
+      key << " " << op->operand_source(2).impl() << " " << beta1 << " "
+          << beta2 << " " << epsilon << " "
+          << AttrOf<pir::BoolAttribute>(op, "use_global_beta_pow");
+      if (is_adamw) {
+        if (AttrOf<pir::FloatAttribute>(op, "lr_ratio") != 1.0f) return "";
+        key << " " << WeightDecay(op);
+      }
+    }
+    return key.str();
+  }
+
+  static float WeightDecay(pir::Operation* op) {
+    if (!op->isa<paddle::dialect::Adamw_Op>() ||
+        !AttrOf<pir::BoolAttribute>(op, "with_decay")) {
+      return 0.0f;
+    }
+    return AttrOf<pir::FloatAttribute>(op, "coeff");
+  }
+
+  static pir::Value Combine(pir::Builder* builder,
+                            const std::vector<pir::Operation*>& ops,
+                            uint32_t operand_index) {
+    std::vector<pir::Value> values;
+    for (auto* op : ops) {
+      pir::Value value = op->operand_source(operand_index);
+      if (!value) return pir::Value();
+      values.push_back(value);
+    }
+    return builder->Build<pir::CombineOp>(values).out();
+  }
+
+  void BuildMergedSgd(pir::Builder* builder,
+                      const std::vector<pir::Operation*>& ops) const {
+    pir::AttributeMap attrs;
+    attrs["multi_precision"] = ops[0]->attribute("multi_precision");
+    builder->Build<paddle::dialect::MergedSgd_Op>(
+        Combine(builder, ops, 0),
+        ops[0]->operand_source(1),
+        Combine(builder, ops, 2),
+        Combine(builder, ops, 3),
+        attrs);
+  }
+
+  void BuildMergedMomentum(pir::Builder* builder,
+                           const std::vector<pir::Operation*>& ops) const {
+    // merged_momentum_ wants the regularization of all the parameters or of
+    // none of them.
+    std::vector<pir::Attribute> methods, coeffs;
+    bool has_regularization = false;
+    for (auto* op : ops) {
+      auto method = op->attribute<pir::StrAttribute>("regularization_method");
+      has_regularization |= !method.AsString().empty();
+      methods.push_back(method);
+      coeffs.push_back(op->attribute("regularization_coeff"));
+    }
+    if (!has_regularization) {
+      methods.clear();
+      coeffs.clear();
+    }
+    pir::AttributeMap attrs;
+    for (auto name :
+         {"mu", "use_nesterov", "multi_precision", "rescale_grad"}) {
+      attrs[name] = ops[0]->attribute(name);
+    }
+    attrs["regularization_method"] = pir::ArrayAttribute::get(ctx_, methods);
+    attrs["regularization_coeff"] = pir::ArrayAttribute::get(ctx_, coeffs);
+    builder->Build<paddle::dialect::MergedMomentum_Op>(
+        Combine(builder, ops, 0),
+        Combine(builder, ops, 1),
+        Combine(builder, ops, 2),
+        Combine(builder, ops, 3),
+        Combine(builder, ops, 4),
+        attrs);
+  }
+
+  void BuildFusedAdam(pir::Builder* builder,
+                      const std::vector<pir::Operation*>& ops) const {
+    float beta1, beta2, epsilon;
+    ScalarFromFull(ops[0]->operand_source(9), &beta1);
+    ScalarFromFull(ops[0]->operand_source(10), &beta2);
+    ScalarFromFull(ops[0]->operand_source(11), &epsilon);
+    pir::AttributeMap attrs;
+    attrs["beta1"] = pir::FloatAttribute::get(ctx_, beta1);
+    attrs["beta2"] = pir::FloatAttribute::get(ctx_, beta2);
+    attrs["epsilon"] = pir::FloatAttribute::get(ctx_, epsilon);
+    // The chunk size fused_adam is created with by the python optimizers.
+    attrs["chunk_size"] = pir::Int32Attribute::get(ctx_, 16 * 2048);
+    attrs["weight_decay"] =
+        pir::FloatAttribute::get(ctx_, WeightDecay(ops[0]));
+    attrs["use_adamw"] = pir::BoolAttribute::get(
+        ctx_, ops[0]->isa<paddle::dialect::Adamw_Op>());
+    attrs["multi_precision"] = ops[0]->attribute("multi_precision");
+    attrs["use_global_beta_pow"] = ops[0]->attribute("use_global_beta_pow");
+    builder->Build<paddle::dialect::FusedAdam_Op>(
+        Combine(builder, ops, 0),
+        Combine(builder, ops, 1),
+        ops[0]->operand_source(2),
+        Combine(builder, ops, 3),
+        Combine(builder, ops, 4),
+        Combine(builder, ops, 5),
+        Combine(builder, ops, 6),
+        Combine(builder, ops, 7),
+        pir::Value(),
+        attrs);
+  }
+
+  // Replaces the ops of a group by one fused op placed after the last of
+  // them, where all their operands are defined.
+  bool FuseGroup(pir::Builder* builder,
+                 const std::vector<pir::Operation*>& ops) const {
+    if (ops.size() < 2) return false;
+    builder->SetInsertionPointAfter(ops.back());
+    if (ops[0]->isa<paddle::dialect::Sgd_Op>()) {
+      BuildMergedSgd(builder, ops);
+    } else if (ops[0]->isa<paddle::dialect::Momentum_Op>()) {
+      BuildMergedMomentum(builder, ops);
+    } else {
+      BuildFusedAdam(builder, ops);
+    }
+    VLOG(4) << "multi_tensor_optimizer_fuse_pass fuses " << ops.size() << " "
+            << ops[0]->name() << " ops";
+    for (auto* op : ops) {
+      op->Erase();
+    }
+    return true;
+  }
+
+  // The operands the op updates in place.
+  static std::vector<uint32_t> UpdatedOperands(pir::Operation* op) {
+    if (op->isa<paddle::dialect::Sgd_Op>()) return {0, 3};
+    if (op->isa<paddle::dialect::Momentum_Op>()) return {0, 2, 4};
+    return {0, 3, 4, 5, 6, 7};
+  }
+
+  int64_t FuseBlock(pir::Block* block) {
+    pir::Builder builder(ctx_, block);
+    std::unordered_map<std::string, std::vector<pir::Operation*>> groups;
+    std::vector<std::string> keys;
+    // The operands of the pending ops, mapped to the key of their group and
+    // whether the op updates them. A later op reading them must come after
+    // the fused op, unless both only read them from within the same group.
+    std::unordered_map<pir::Value, std::pair<std::string, bool>> pending;
+    int64_t num_fused = 0;
+
+    auto flush = [&](std::string key) {
+      auto& ops = groups[key];
+      for (auto* op : ops) {
+        for (auto value : op->operands_source()) {
+          pending.erase(value);
+        }
+      }
+      num_fused += FuseGroup(&builder, ops);
+      ops.clear();
+    };
+
+    std::vector<pir::Operation*> ops;
+    for (auto& op : *block) {
+      ops.push_back(&op);
+    }
+    for (auto* op : ops) {
+      std::string key = GroupKey(op);
+      std::vector<uint32_t> updated;
+      if (!key.empty()) updated = UpdatedOperands(op);
+      for (uint32_t i = 0; i < op->num_operands(); ++i) {
+        auto it = pending.find(op->operand_source(i));
+        if (it == pending.end()) continue;
+        bool updates = std::count(updated.begin(), updated.end(), i) > 0;
+        if (it->second.first != key || it->second.second || updates) {
+          flush(it->second.first);
+        }
+      }
+      if (key.empty()) continue;
+      if (!groups.count(key)) keys.push_back(key);
+      groups[key].push_back(op);
+      for (uint32_t i = 0; i < op->num_operands(); ++i) {
+        pir::Value value = op->operand_source(i);
+        if (!value) continue;
+        bool updates = std::count(updated.begin(), updated.end(), i) > 0;
+        pending[value] = std::make_pair(key, updates);
+      }
+    }
+    for (auto& key : keys) {
+      flush(key);
+    }
+    return num_fused;
+  }
+
+  pir::IrContext* ctx_ = pir::IrContext::Instance();
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateMultiTensorOptimizerFusePass() {
+  return std::make_unique<MultiTensorOptimizerFusePass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(multi_tensor_optimizer_fuse_pass,
+                 MultiTensorOptimizerFusePass);
@@ -0,0 +1,294 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/general/symbolic_memory_reuse_pass.h"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/common/ddim.h"
+#include "paddle/fluid/pir/dialect/operator/interface/op_yaml_info.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/trait/inplace.h"
+#include "paddle/fluid/pir/dialect/operator/utils/op_yaml_info_parser.h"
+#include "paddle/fluid/pir/dialect/operator/utils/utils.h"
+#include "paddle/phi/common/data_type.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/dialect/shape/utils/shape_analysis.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+using DenseTensorType = paddle::dialect::DenseTensorType;
+
+// The buffers of these values come from or go to the outside of the program.
+const std::unordered_set<std::string> kExternalBufferOps = {
+    "pd_op.data", "pd_op.feed", "pd_op.shadow_feed", "pd_op.fetch"};
+
+bool IsOperatorDialectOp(const pir::Operation& op) {
+  return op.dialect()->name() == paddle::dialect::OperatorDialect::name();
+}
+
+// The output of an inplace or view op keeps the buffer of its input alive,
+// so the lifetime of the input is unknown from its uses.
+bool HasAliasOutput(pir::Operation* op) {
+  if (op->HasTrait<paddle::dialect::InplaceTrait>()) {
+    return true;
+  }
+  auto yaml_interface = op->dyn_cast<paddle::dialect::OpYamlInfoInterface>();
+  if (!yaml_interface) {
+    return false;
+  }
+  paddle::dialect::OpYamlInfoParser parser(
+      yaml_interface.GetOpInfo(), paddle::dialect::IsLegacyOp(op->name()));
+  for (auto& name : parser.OutputNames()) {
+    if (parser.HasInplace(name) || parser.HasView(name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+struct BufferInterval {
+  pir::Value value;
+  size_t def;
+  size_t last_use;
+};
+
+struct BufferGroup {
+  // the largest member, which decides the size of the buffer
+  pir::Value capacity;
+  size_t free_after;
+  std::vector<pir::Value> members;
+};
+
+class SymbolicMemoryReusePass : public pir::Pass {
+ public:
+  SymbolicMemoryReusePass() : pir::Pass("symbolic_memory_reuse_pass", 2) {}
+
+  void Run(pir::Operation* op) override {
+    shape_analysis_ =
+        &pir::ShapeAnalysisManager::Instance().Get(op->GetParentProgram());
+    next_share_id_ = 0;
+    int64_t num_shared{0};
+    for (auto& region : *op) {
+      for (auto& block : region) {
+        num_shared += ProcessBlock(&block);
+      }
+    }
+    AddStatistics(num_shared);
+  }
+
+ private:
+  int64_t ProcessBlock(pir::Block* block) {
+    int64_t num_shared{0};
+    std::unordered_map<pir::Operation*, size_t> position;
+    for (auto& op : *block) {
+      size_t pos = position.size();
+      position[&op] = pos;
+      for (auto& region : op) {
+        for (auto& inner_block : region) {
+          num_shared += ProcessBlock(&inner_block);
+        }
+      }
+    }
+
+    std::vector<BufferInterval> intervals;
+    for (auto& op : *block) {
+      if (!IsOperatorDialectOp(op) || op.num_regions() > 0 ||
+          kExternalBufferOps.count(op.name()) || HasAliasOutput(&op)) {
+        continue;
+      }
+      size_t def = position.at(&op);
+      for (auto result : op.results()) {
+        if (!result || !result.type() ||
+            !result.type().isa<DenseTensorType>()) {
+          continue;
+        }
+        auto persist_attr =
+            result.attribute<pir::BoolAttribute>(kAttrIsPersistable);
+        if (persist_attr && persist_attr.data()) {
+          continue;
+        }
+        auto last_use = LastUse(result, def, position, true);
+        if (last_use.has_value()) {
+          intervals.push_back({result, def, *last_use});
+        }
+      }
+    }
+
+    // Greedy in the order of definition: a value takes the buffer of a
+    // group whose last member is dead, preferring the same size.
+    std::vector<BufferGroup> groups;
+    for (auto& interval : intervals) {
+      BufferGroup* chosen = nullptr;
+      for (auto& group : groups) {
+        if (group.free_after >= interval.def) {
+          continue;
+        }
+        bool same_size = false;
+        if (!FitsIn(interval.value, group.capacity, &same_size)) {
+          continue;
+        }
+        if (same_size) {
+          chosen = &group;
+          break;
+        }
+        if (chosen == nullptr) {
+          chosen = &group;
+        }
+      }
+      if (chosen == nullptr) {
+        groups.push_back({interval.value, interval.last_use, {interval.value}});
+        continue;
+      }
+      chosen->free_after = interval.last_use;
+      chosen->members.push_back(interval.value);
+    }
+
+    std::unordered_map<pir::Value, int64_t> share_ids;
+    for (auto& group : groups) {
+      if (group.members.size() < 2) {
+        continue;
+      }
+      int64_t id = next_share_id_++;
+      for (auto value : group.members) {
+        share_ids[value] = id;
+      }
+      num_shared += group.members.size() - 1;
+    }
+    if (share_ids.empty()) {
+      return num_shared;
+    }
+
+    pir::IrContext* ctx = pir::IrContext::Instance();
+    for (auto& op : *block) {
+      std::vector<pir::Attribute> ids;
+      bool shared = false;
+      for (auto result : op.results()) {
+        auto it = share_ids.find(result);
+        shared |= it != share_ids.end();
+        ids.push_back(pir::Int64Attribute::get(
+            ctx, it == share_ids.end() ? -1 : it->second));
+      }
+      if (shared) {
+        op.set_attribute(kAttrBufferShareIds,
+                         pir::ArrayAttribute::get(ctx, ids));
+      }
+    }
+    VLOG(4) << "symbolic_memory_reuse_pass shares " << num_shared
+            << " buffers in a block of " << block->size() << " ops";
+    return num_shared;
+  }
+
+  // Returns the position of the last op using value, or nullopt when the
+  // value is used outside of the block or by an op that may alias it. The
+  // uses of a builtin.combine output extend the lifetime of its inputs.
+  std::optional<size_t> LastUse(
+      pir::Value value,
+      size_t def,
+      const std::unordered_map<pir::Operation*, size_t>& position,
+      bool through_combine) {
+    size_t last_use = def;
+    for (auto it = value.use_begin(); it != value.use_end(); ++it) {
+      pir::Operation* user = it->owner();
+      auto pos = position.find(user);
+      if (pos == position.end() || user->num_regions() > 0) {
+        return std::nullopt;
+      }
+      if (through_combine && user->isa<pir::CombineOp>()) {
+        auto combine_last_use =
+            LastUse(user->result(0), pos->second, position, false);
+        if (!combine_last_use.has_value()) {
+          return std::nullopt;
+        }
+        last_use = std::max(last_use, *combine_last_use);
+        continue;
+      }
+      if (!IsOperatorDialectOp(*user) ||
+          kExternalBufferOps.count(user->name()) || HasAliasOutput(user)) {
+        return std::nullopt;
+      }
+      last_use = std::max(last_use, pos->second);
+    }
+    return last_use;
+  }
+
+  // Returns true if the buffer of small is never larger than the buffer of
+  // large, for every value of the symbols. Proven by matching every dim of
+  // small to an equal dim of large, the other dims of large being >= 1.
+  bool FitsIn(pir::Value small, pir::Value large, bool* same_size) {
+    auto small_type = small.type().dyn_cast<DenseTensorType>();
+    auto large_type = large.type().dyn_cast<DenseTensorType>();
+    if (phi::SizeOf(paddle::dialect::TransToPhiDataType(small_type.dtype())) !=
+        phi::SizeOf(paddle::dialect::TransToPhiDataType(large_type.dtype()))) {
+      return false;
+    }
+    if (shape_analysis_->IsSameNumel(small, large)) {
+      *same_size = true;
+      return true;
+    }
+    if (!common::contain_unknown_dim(small_type.dims()) &&
+        !common::contain_unknown_dim(large_type.dims())) {
+      return common::product(small_type.dims()) <=
+             common::product(large_type.dims());
+    }
+
+    const auto& small_shape = shape_analysis_->GetShapeOrDataForValue(small);
+    const auto& large_shape = shape_analysis_->GetShapeOrDataForValue(large);
+    if (!small_shape.isa<symbol::TensorShapeOrDataDimExprs>() ||
+        !large_shape.isa<symbol::TensorShapeOrDataDimExprs>()) {
+      return false;
+    }
+    std::vector<symbol::DimExpr> rest = large_shape.shape();
+    for (const auto& dim : small_shape.shape()) {
+      auto it = std::find_if(
+          rest.begin(), rest.end(), [&](const symbol::DimExpr& large_dim) {
+            return shape_analysis_->IsEqual(large_dim, dim);
+          });
+      if (it == rest.end()) {
+        return false;
+      }
+      rest.erase(it);
+    }
+    return std::all_of(
+        rest.begin(), rest.end(), [&](const symbol::DimExpr& dim) {
+          if (dim.isa<int64_t>()) {
+            return dim.dyn_cast<int64_t>() >= 1;
+          }
+          return shape_analysis_->IsGreatThanOne(dim);
+        });
+  }
+
+  pir::ShapeConstraintIRAnalysis* shape_analysis_{nullptr};
+  int64_t next_share_id_{0};
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateSymbolicMemoryReusePass() {
+  return std::make_unique<SymbolicMemoryReusePass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(symbolic_memory_reuse_pass, SymbolicMemoryReusePass);
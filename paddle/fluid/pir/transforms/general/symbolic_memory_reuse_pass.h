@@ -0,0 +1,30 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <memory>
+#include "paddle/pir/include/core/dll_decl.h"
+
+// The buffer share id of each result of an op, -1 for the results which own
+// their buffer. The results with the same id have disjoint lifetimes and use
+// one buffer at runtime.
+constexpr char kAttrBufferShareIds[] = "buffer_share_ids";
+
+namespace pir {
+
+class Pass;
+
+IR_API std::unique_ptr<Pass> CreateSymbolicMemoryReusePass();
+
+}  // namespace pir
@@ -0,0 +1,195 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/transforms/general/while_loop_invariant_hoist_pass.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "paddle/fluid/pir/dialect/operator/interface/op_yaml_info.h"
+#include "paddle/fluid/pir/dialect/operator/ir/control_flow_op.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/dialect/operator/trait/inplace.h"
+#include "paddle/fluid/pir/dialect/operator/utils/op_yaml_info_parser.h"
+#include "paddle/fluid/pir/dialect/operator/utils/utils.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/op_trait.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+// The indices of the operands of op which its results are inplace of or are
+// views of, i.e. the operands it may write.
+std::vector<size_t> GetWrittenOperands(pir::Operation* op) {
+  std::vector<size_t> written;
+  if (!op->HasTrait<paddle::dialect::InplaceTrait>()) {
+    return written;
+  }
+  std::string op_name = op->name();
+  if (op->attributes().count("op_name")) {
+    op_name =
+        op->attributes().at("op_name").dyn_cast<pir::StrAttribute>().AsString();
+  }
+  pir::OpInfo op_info =
+      pir::IrContext::Instance()->GetRegisteredOpInfo(op_name);
+  auto yaml_info_interface =
+      op_info.GetInterfaceImpl<paddle::dialect::OpYamlInfoInterface>();
+  if (!yaml_info_interface) {
+    return written;
+  }
+  paddle::dialect::OpYamlInfoParser yaml_parser(
+      yaml_info_interface->get_op_info_(op_name),
+      paddle::dialect::IsLegacyOp(op_name));
+  for (size_t i = 0; i < op->num_results(); ++i) {
+    const std::string& value_name = yaml_parser.OutputNames()[i];
+    if (yaml_parser.HasInplace(value_name)) {
+      written.push_back(yaml_parser.InputName2Id().at(
+          yaml_parser.InplaceName(value_name)));
+    }
+    if (yaml_parser.HasView(value_name)) {
+      written.push_back(
+          yaml_parser.InputName2Id().at(yaml_parser.ViewName(value_name)));
+    }
+  }
+  return written;
+}
+
+class WhileLoopInvariantHoistPass : public pir::Pass {
+ public:
+  WhileLoopInvariantHoistPass()
+      : pir::Pass("while_loop_invariant_hoist_pass", 1) {}
+
+  void Run(pir::Operation* op) override {
+    // The inner loops come first, so that an op hoisted out of an inner loop
+    // can be hoisted out of the outer loop too.
+    std::vector<paddle::dialect::WhileOp> while_ops;
+    op->Walk([&](pir::Operation* inner_op) {
+      if (inner_op->isa<paddle::dialect::WhileOp>()) {
+        while_ops.push_back(inner_op->dyn_cast<paddle::dialect::WhileOp>());
+      }
+    });
+    int64_t num_hoisted = 0;
+    for (auto while_op : while_ops) {
+      num_hoisted += HoistInvariantOps(while_op);
+    }
+    AddStatistics(num_hoisted);
+  }
+
+  bool CanApplyOn(pir::Operation* op) const override {
+    return op->isa<pir::ModuleOp>() && op->num_regions() > 0;
+  }
+
+ private:
+  int64_t HoistInvariantOps(paddle::dialect::WhileOp while_op) {
+    pir::Block& body = while_op.body();
+    // The values defined in the loop, and the values outside of it which the
+    // loop writes. The operands of the while op are written too when the body
+    // writes its args, since the args share their buffers.
+    std::unordered_set<pir::Value> variant_values;
+    for (const auto& arg : body.args()) {
+      variant_values.insert(arg);
+    }
+    for (size_t i = 0; i < while_op->num_operands(); ++i) {
+      variant_values.insert(while_op->operand_source(i));
+    }
+    while_op->Walk([&](pir::Operation* op) {
+      if (op == while_op.operation()) {
+        return;
+      }
+      for (auto result : op->results()) {
+        variant_values.insert(result);
+      }
+      for (size_t i = 0; i < op->num_regions(); ++i) {
+        for (auto& block : op->region(i)) {
+          for (const auto& arg : block.args()) {
+            variant_values.insert(arg);
+          }
+        }
+      }
+      for (size_t index : GetWrittenOperands(op)) {
+        variant_values.insert(op->operand_source(index));
+      }
+    });
+
+    std::vector<pir::Operation*> hoisted_ops;
+    for (auto& op : body) {
+      if (!IsInvariant(&op, variant_values)) {
+        continue;
+      }
+      for (auto result : op.results()) {
+        variant_values.erase(result);
+      }
+      hoisted_ops.push_back(&op);
+    }
+    for (auto* op : hoisted_ops) {
+      VLOG(4) << "hoist " << op->name() << " out of the while op";
+      op->MoveTo(while_op->GetParent(),
+                 while_op.operation()->operator pir::Block::Iterator());
+    }
+    return static_cast<int64_t>(hoisted_ops.size());
+  }
+
+  // Whether op computes the same results in every iteration, and may run
+  // once before the loop instead.
+  bool IsInvariant(pir::Operation* op,
+                   const std::unordered_set<pir::Value>& variant_values) {
+    if (op->HasTrait<pir::SideEffectTrait>() || op->num_regions() > 0 ||
+        op->isa<pir::YieldOp>() || op->isa<paddle::dialect::DataOp>() ||
+        paddle::dialect::IsCustomOp(op) || !GetWrittenOperands(op).empty()) {
+      return false;
+    }
+    for (auto value : op->operands_source()) {
+      if (value && variant_values.count(value)) {
+        return false;
+      }
+    }
+    // The results keep their buffers across the iterations once hoisted, so
+    // they must not be written, or carried to the next iteration.
+    for (auto result : op->results()) {
+      if (!result.type() ||
+          !result.type().isa<paddle::dialect::DenseTensorType>()) {
+        return false;
+      }
+      for (auto it = result.use_begin(); it != result.use_end(); ++it) {
+        pir::Operation* user = it->owner();
+        if (user->isa<pir::YieldOp>() ||
+            user->isa<paddle::dialect::WhileOp>()) {
+          return false;
+        }
+        for (size_t index : GetWrittenOperands(user)) {
+          if (user->operand_source(index) == result) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateWhileLoopInvariantHoistPass() {
+  return std::make_unique<WhileLoopInvariantHoistPass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(while_loop_invariant_hoist_pass, WhileLoopInvariantHoistPass);
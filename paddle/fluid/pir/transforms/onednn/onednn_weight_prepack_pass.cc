@@ -0,0 +1,181 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A prepacked weight keeps its dims [IC, OC] and gets the oneDNN layout,
+// with the {OC, IC} weights desc of the inner product permuted to its dims
+// as mem_desc. The FC kernel reads its weights through that mem_desc: it
+// uses them in place when its primitive picks the same format, and reorders
+// them otherwise, e.g. when it runs with another batch than the one assumed
+// here. The pass runs after the optimized model is saved, as the blocked
+// formats depend on the ISA of the CPU.
+
+#include "paddle/fluid/pir/transforms/onednn/onednn_weight_prepack_pass.h"
+
+#include <algorithm>
+#include <string>
+
+#include "paddle/common/errors.h"
+#include "paddle/fluid/framework/scope.h"
+#include "paddle/fluid/pir/dialect/operator/ir/onednn_op.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+#include "paddle/phi/backends/onednn/onednn_context.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/builtin_type.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_registry.h"
+
+namespace {
+
+// Whether fc runs in fp32 on a 2D fp32 parameter that only it uses.
+bool CanPrepack(pir::Operation* fc) {
+  if (fc->attribute<pir::StrAttribute>("mkldnn_data_type").AsString() !=
+          "float32" ||
+      fc->attribute<pir::BoolAttribute>("use_quantizer").data() ||
+      fc->attribute<pir::BoolAttribute>("padding_weights").data()) {
+    return false;
+  }
+  pir::Value w = fc->operand_source(1);
+  if (!w || !w.defining_op() || !w.defining_op()->isa<pir::ParameterOp>() ||
+      w.use_count() != 1) {
+    return false;
+  }
+  if (!pir::GetDataTypeFromValue(w).isa<pir::Float32Type>()) {
+    return false;
+  }
+  auto w_dims = pir::GetShapeFromValue(w);
+  return w_dims.size() == 2 && w_dims[0] > 0 && w_dims[1] > 0;
+}
+
+// The rows of the input of fc as the kernel flattens it, the unknown dims
+// taken as 1.
+int64_t GetBatch(pir::Operation* fc) {
+  auto x_dims = pir::GetShapeFromValue(fc->operand_source(0));
+  int in_num_col_dims =
+      fc->attribute<pir::Int32Attribute>("in_num_col_dims").data();
+  int64_t batch = 1;
+  for (int i = 0; i < in_num_col_dims && i < static_cast<int>(x_dims.size());
+       ++i) {
+    batch *= std::max<int64_t>(x_dims[i], 1);
+  }
+  return batch;
+}
+
+class OneDNNWeightPrepackPass : public pir::Pass {
+ public:
+  OneDNNWeightPrepackPass() : pir::Pass("onednn_weight_prepack_pass", 3) {}
+
+  bool Initialize(pir::IrContext* context) override {
+    PADDLE_ENFORCE_EQ(
+        Has(pir::Pass::kParamScopeAttr),
+        true,
+        common::errors::InvalidArgument(
+            "Pass initialize failed."
+            "When using OneDNNWeightPrepackPass, scope attribute is required!"
+            "Use Set method to set the scope attribute."));
+    scope_ = &Get<paddle::framework::Scope>(pir::Pass::kParamScopeAttr);
+    return true;
+  }
+
+  void Run(pir::Operation* op) override {
+    auto module_op = op->dyn_cast<pir::ModuleOp>();
+    PADDLE_ENFORCE_NOT_NULL(
+        module_op,
+        common::errors::PreconditionNotMet(
+            "onednn_weight_prepack_pass should run on module op."));
+    int64_t num_prepacked = 0;
+    for (auto& inner_op : module_op.block()) {
+      if (!inner_op.isa<paddle::onednn::dialect::FcOp>() ||
+          !CanPrepack(&inner_op)) {
+        continue;
+      }
+      std::string param_name =
+          pir::GetParameterNameFromValue(inner_op.operand_source(1));
+      auto* param_var = scope_->FindVar(param_name);
+      PADDLE_ENFORCE_NOT_NULL(
+          param_var,
+          common::errors::InvalidArgument("Parameter var [%s] not in scope.",
+                                          param_name));
+      auto* weights = param_var->GetMutable<phi::DenseTensor>();
+      if (!weights->initialized() || !phi::is_cpu_place(weights->place()) ||
+          weights->layout() == phi::DataLayout::ONEDNN) {
+        continue;
+      }
+      if (Prepack(GetBatch(&inner_op), weights)) {
+        VLOG(6) << "prepacked the weights " << param_name;
+        ++num_prepacked;
+      }
+    }
+    AddStatistics(num_prepacked);
+  }
+
+  bool CanApplyOn(pir::Operation* op) const override {
+    return op->isa<pir::ModuleOp>() && op->num_regions() > 0;
+  }
+
+ private:
+  // Replaces weights by their prepacked copy, which frees them. Returns
+  // false when the inner product reads the weights as they are.
+  bool Prepack(int64_t batch, phi::DenseTensor* weights) const {
+    using dnnl::memory;
+    const auto& engine = phi::OneDNNContext::tls().get_engine();
+    const int64_t ic = weights->dims()[0];
+    const int64_t oc = weights->dims()[1];
+    const auto f32 = memory::data_type::f32;
+    const auto any = memory::format_tag::any;
+    // As the FC kernel builds its inner product, less the bias and the
+    // post-ops, which do not change the format of the weights.
+    dnnl::inner_product_forward::primitive_desc pd(
+        engine,
+        dnnl::prop_kind::forward_inference,
+        memory::desc({batch, ic}, f32, any),
+        memory::desc({oc, ic}, f32, any),
+        memory::desc({batch, oc}, f32, any));
+    const memory::desc packed_md = pd.weights_desc();
+    const memory::desc user_md({oc, ic}, f32, memory::format_tag::io);
+    if (packed_md == user_md) {
+      return false;
+    }
+
+    phi::DenseTensor packed;
+    packed.Resize(weights->dims());
+    auto* dev_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+    dev_ctx->Alloc(&packed, phi::DataType::FLOAT32, packed_md.get_size());
+    memory user_mem(user_md, engine, weights->data<float>());
+    memory packed_mem(packed_md, engine, packed.data<float>());
+    auto& astream = phi::OneDNNContext::tls().get_stream();
+    dnnl::reorder(user_mem, packed_mem).execute(astream, user_mem, packed_mem);
+    astream.wait();
+    packed.set_mem_desc(packed_md.permute_axes({1, 0}));
+    *weights = std::move(packed);
+    return true;
+  }
+
+  paddle::framework::Scope* scope_{nullptr};
+};
+
+}  // namespace
+
+namespace pir {
+
+std::unique_ptr<Pass> CreateOneDNNWeightPrepackPass() {
+  return std::make_unique<OneDNNWeightPrepackPass>();
+}
+
+}  // namespace pir
+
+REGISTER_IR_PASS(onednn_weight_prepack_pass, OneDNNWeightPrepackPass);
@@ -0,0 +1,29 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include "paddle/pir/include/core/dll_decl.h"
+
+namespace pir {
+
+class Pass;
+
+// Reorders the weights of the fp32 onednn_op.fc in the scope to the blocked
+// layout of their inner product, so that the kernel neither reorders them
+// on its first run nor keeps a second, reordered copy.
+IR_API std::unique_ptr<Pass> CreateOneDNNWeightPrepackPass();
+
+}  // namespace pir
@@ -24,8 +24,10 @@ USE_PIR_PASS(fused_dropout_add_pass);
 USE_PIR_PASS(fused_weight_only_linear_pass);
 USE_PIR_PASS(fused_linear_param_grad_add_pass);
 USE_PIR_PASS(fuse_allreduce_split_to_reducescatter_pass);
+USE_PIR_PASS(fuse_matmul_comm_overlap_pass);
 USE_PIR_PASS(inplace_pass);
 USE_PIR_PASS(replace_fetch_with_shadow_output_pass);
+USE_PIR_PASS(symbolic_memory_reuse_pass);
 USE_PIR_PASS(identity_op_clean_pass);
 USE_PIR_PASS(map_op_to_another_pass);
 USE_PIR_PASS(matmul_scale_fuse_pass);
@@ -45,13 +47,18 @@ USE_PIR_PASS(remove_redundant_transpose_pass);
 USE_PIR_PASS(delete_weight_dequant_linear_op_pass);
 USE_PIR_PASS(delete_quant_dequant_linear_op_pass);
 USE_PIR_PASS(transfer_layout_pass);
+USE_PIR_PASS(layout_cost_model_pass);
 USE_PIR_PASS(fused_rotary_position_embedding_pass);
 USE_PIR_PASS(auto_mixed_precision_pass);
 USE_PIR_PASS(horizontal_fuse_pass);
 USE_PIR_PASS(auto_layout_simplify_pass);
 USE_PIR_PASS(auto_layout_pass);
 USE_PIR_PASS(common_subexpression_elimination_pass);
+USE_PIR_PASS(while_loop_invariant_hoist_pass);
 USE_PIR_PASS(add_shadow_output_after_dead_parameter_pass);
+USE_PIR_PASS(multi_tensor_optimizer_fuse_pass);
+USE_PIR_PASS(collective_fuse_pass);
+USE_PIR_PASS(cpu_weight_only_linear_pass);
 
 #ifdef PADDLE_WITH_DNNL
 USE_PIR_PASS(depthwise_conv_onednn_pass);
@@ -82,6 +89,7 @@ USE_PIR_PASS(operator_scale_onednn_fuse_pass);
 USE_PIR_PASS(operator_unsqueeze_onednn_fuse_pass);
 USE_PIR_PASS(operator_reshape_onednn_fuse_pass);
 USE_PIR_PASS(onednn_placement_pass);
+USE_PIR_PASS(onednn_weight_prepack_pass);
 USE_PIR_PASS(conv2d_transpose_bn_fuse_pass);
 USE_PIR_PASS(conv2d_transpose_bias_bn_fuse_pass);
 USE_PIR_PASS(matmul_reshape_add_fuse_pass);
@@ -266,8 +266,9 @@ struct SubGraph {
 using OpClassifier = std::function<bool(const pir::Operation&)>;
 
 SubgraphDetector::SubgraphDetector(pir::Block* block,
-                                   const OpClassifier& classifier)
-    : block_(block), op_classifier_(classifier) {
+                                   const OpClassifier& classifier,
+                                   const HorizontalMergeKey& merge_key)
+    : block_(block), op_classifier_(classifier), merge_key_(merge_key) {
   sort_ops_ = InverselyTopologicalSort(block_);
   size_t index = 0;
   for (auto& op : *block) {
@@ -475,6 +476,51 @@ void MergeSubGraphs(Operation* op,
       op_graph_ptr, producer_graph_ptr, union_find.GetSetFromOp(op));
 }
 
+// Merges the independent sub-graphs with the same key. A merged sub-graph
+// holds at most kMaxHorizontalMergeNum of them to bound its inputs and
+// outputs.
+void HorizontalMergeSubGraphs(
+    const std::vector<pir::Operation*>& sort_ops,
+    const SubgraphDetector::HorizontalMergeKey& merge_key,
+    UnionFindSet& union_find,            // NOT NOLINT
+    LoopDetectionMapping& loop_detector  // NOT NOLINT
+) {
+  constexpr size_t kMaxHorizontalMergeNum = 8;
+  std::unordered_set<SubGraphPtr> visited;
+  // key -> an op of each merged sub-graph and the number merged into it
+  std::unordered_map<std::string,
+                     std::vector<std::pair<pir::Operation*, size_t>>>
+      merged_subgraphs;
+  for (auto* op : sort_ops) {
+    auto subgraph = union_find.GetSetFromOp(op);
+    if (!subgraph->substitute || !visited.insert(subgraph).second) {
+      continue;
+    }
+    const std::string key = merge_key(subgraph->ops);
+    if (key.empty()) {
+      continue;
+    }
+    auto& candidates = merged_subgraphs[key];
+    bool is_merged = false;
+    for (auto& [merged_op, merged_num] : candidates) {
+      if (merged_num >= kMaxHorizontalMergeNum) {
+        continue;
+      }
+      MergeSubGraphs(op, merged_op, union_find, loop_detector);
+      if (union_find.GetSetFromOp(op) == union_find.GetSetFromOp(merged_op)) {
+        VLOG(4) << "Horizontally merge " << op->id() << " into "
+                << merged_op->id() << " with key " << key;
+        ++merged_num;
+        is_merged = true;
+        break;
+      }
+    }
+    if (!is_merged) {
+      candidates.emplace_back(op, 1);
+    }
+  }
+}
+
 void SubgraphDetector::DoOpFusion() {
   // do fusion
   VLOG(4) << "DoOpFusion";
@@ -511,6 +557,10 @@ void SubgraphDetector::DoOpFusion() {
     }
   }
 
+  if (merge_key_) {
+    HorizontalMergeSubGraphs(sort_ops_, merge_key_, union_find, loop_detector);
+  }
+
   for (const auto& op : sort_ops_) {
     subgraph_map_[op] = union_find.GetSetFromOp(op);
   }
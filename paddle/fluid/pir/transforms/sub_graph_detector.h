@@ -38,8 +38,13 @@ class SubgraphDetector {
  public:
   // Tell whether a node is inside a sub-graph.
   using OpClassifier = std::function<bool(const pir::Operation&)>;
+  // The independent sub-graphs with the same non-empty key are merged after
+  // the producer-consumer fusion.
+  using HorizontalMergeKey = std::function<std::string(const GroupOpsVec&)>;
 
-  SubgraphDetector(pir::Block* block, const OpClassifier& classifier);
+  SubgraphDetector(pir::Block* block,
+                   const OpClassifier& classifier,
+                   const HorizontalMergeKey& merge_key = nullptr);
 
   std::vector<GroupOpsVec> operator()();
 
@@ -52,6 +57,7 @@ class SubgraphDetector {
  private:
   pir::Block* block_;
   OpClassifier op_classifier_;
+  HorizontalMergeKey merge_key_;
 
   std::vector<pir::Operation*> sort_ops_;
   std::unordered_map<pir::Operation*, size_t> op2id_;
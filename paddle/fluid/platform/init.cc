@@ -431,6 +431,15 @@ void InitMemoryMethod() {
     memory_method->alloc_shared = paddle::memory::AllocShared;
     memory_method->alloc_shared_with_stream = paddle::memory::AllocShared;
     memory_method->in_same_stream = paddle::memory::InSameStream;
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    memory_method->record_stream =
+        [](const std::shared_ptr<phi::Allocation> &allocation,
+           const phi::Stream &stream) {
+          paddle::memory::RecordStream(
+              allocation,
+              reinterpret_cast<phi::gpuStream_t>(stream.id()));  // NOLINT
+        };
+#endif
     memory_method->allocation_deleter =
         paddle::memory::allocation::Allocator::AllocationDeleter;
 #if defined(PADDLE_WITH_CUSTOM_DEVICE) || defined(PADDLE_WITH_CUDA) || \
@@ -0,0 +1,159 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/platform/profiler/continuous_profiler.h"
+
+#include <algorithm>
+
+#include "glog/logging.h"
+#include "paddle/fluid/platform/enforce.h"
+#include "paddle/phi/core/os_info.h"
+#include "paddle/phi/core/platform/profiler.h"
+#include "paddle/phi/core/platform/profiler/utils.h"
+#ifdef PADDLE_WITH_CUSTOM_DEVICE
+#include "paddle/phi/backends/device_manager.h"
+#endif
+
+namespace paddle {
+namespace platform {
+
+void EventCounter::Add(uint64_t ns) {
+  ++calls;
+  total_ns += ns;
+  min_ns = std::min(min_ns, ns);
+  max_ns = std::max(max_ns, ns);
+}
+
+ContinuousProfiler& ContinuousProfiler::Instance() {
+  static ContinuousProfiler profiler;
+  return profiler;
+}
+
+void ContinuousProfiler::Enable(const ContinuousProfilerOptions& options) {
+  PADDLE_ENFORCE_GT(options.sample_interval,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The sample interval of the continuous profiler "
+                        "should be greater than 0, but got %d.",
+                        options.sample_interval));
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (profiler_) {
+    EndSample();
+  }
+  options_ = options;
+  enabled_ = true;
+}
+
+void ContinuousProfiler::Disable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (profiler_) {
+    EndSample();
+  }
+  enabled_ = false;
+}
+
+bool ContinuousProfiler::IsEnabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return enabled_;
+}
+
+void ContinuousProfiler::Step() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!enabled_) {
+    return;
+  }
+  if (profiler_) {
+    EndSample();
+  }
+  ++aggregates_.steps;
+  if (aggregates_.steps % options_.sample_interval == 0) {
+    BeginSample();
+  }
+}
+
+void ContinuousProfiler::BeginSample() {
+  ProfilerOptions options;
+  options.trace_switch = options_.trace_switch;
+  options.trace_level = options_.trace_level;
+  std::vector<std::string> custom_device_types;
+#ifdef PADDLE_WITH_CUSTOM_DEVICE
+  custom_device_types = phi::DeviceManager::GetAllCustomDeviceTypes();
+#endif
+  profiler_ = Profiler::Create(options, custom_device_types);
+  if (!profiler_) {
+    VLOG(4) << "A Profiler is alive, the step is not sampled.";
+    return;
+  }
+  EnableHostEventRecorder();
+  profiler_->Prepare();
+  profiler_->Start();
+  sample_start_ns_ = phi::PosixInNsec();
+}
+
+void ContinuousProfiler::EndSample() {
+  DisableHostEventRecorder();
+  TraceEventCollector collector;
+  profiler_->Stop(&collector);
+  profiler_.reset();
+  ++aggregates_.sampled_steps;
+  aggregates_.sampled_ns += phi::PosixInNsec() - sample_start_ns_;
+
+  for (const auto& event : collector.HostEvents()) {
+    Count(&aggregates_.host_events, event.name, event.end_ns - event.start_ns);
+    host_events_.push_back(event);
+  }
+  while (host_events_.size() > options_.max_host_events) {
+    host_events_.pop_front();
+    ++aggregates_.dropped_host_events;
+  }
+  for (const auto& event : collector.DeviceEvents()) {
+    uint64_t ns = event.end_ns - event.start_ns;
+    Count(&aggregates_.device_events, event.name, ns);
+    aggregates_.device_event_types[StringTracerEventType(event.type)].Add(ns);
+  }
+}
+
+void ContinuousProfiler::Count(std::map<std::string, EventCounter>* counters,
+                               const std::string& name,
+                               uint64_t ns) {
+  auto iter = counters->find(name);
+  if (iter == counters->end()) {
+    // Keeps the counters bounded when the names are unique, e.g. numbered.
+    if (counters->size() >= options_.max_counters) {
+      (*counters)[kOtherEvents].Add(ns);
+      return;
+    }
+    iter = counters->emplace(name, EventCounter()).first;
+  }
+  iter->second.Add(ns);
+}
+
+ContinuousProfilerAggregates ContinuousProfiler::GetAggregates() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return aggregates_;
+}
+
+std::vector<HostTraceEvent> ContinuousProfiler::GetRecentHostEvents() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::vector<HostTraceEvent>(host_events_.begin(), host_events_.end());
+}
+
+void ContinuousProfiler::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  aggregates_ = ContinuousProfilerAggregates();
+  host_events_.clear();
+}
+
+}  // namespace platform
+}  // namespace paddle
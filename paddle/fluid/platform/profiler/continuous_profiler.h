@@ -0,0 +1,110 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "paddle/common/macros.h"
+#include "paddle/fluid/platform/profiler/profiler.h"
+
+namespace paddle {
+namespace platform {
+
+struct ContinuousProfilerOptions {
+  uint32_t trace_switch = 0;  // the bits of ProfilerOptions
+  uint32_t trace_level = FLAGS_host_trace_level;
+  // One step traced every sample_interval steps.
+  int64_t sample_interval = 100;
+  // The host events kept, the oldest are dropped beyond.
+  size_t max_host_events = 100000;
+  // The names counted for the host and the device each, the events of the
+  // names beyond are counted as kOtherEvents.
+  size_t max_counters = 10000;
+};
+
+struct EventCounter {
+  uint64_t calls = 0;
+  uint64_t total_ns = 0;
+  uint64_t min_ns = UINT64_MAX;
+  uint64_t max_ns = 0;
+
+  void Add(uint64_t ns);
+};
+
+struct ContinuousProfilerAggregates {
+  int64_t steps = 0;
+  int64_t sampled_steps = 0;
+  // The wall time of the sampled steps.
+  uint64_t sampled_ns = 0;
+  uint64_t dropped_host_events = 0;
+  // By the name of the event.
+  std::map<std::string, EventCounter> host_events;
+  std::map<std::string, EventCounter> device_events;
+  // By the type of the event, e.g. Kernel or Memcpy.
+  std::map<std::string, EventCounter> device_event_types;
+};
+
+// Profiles a training always on, with a bounded overhead: one step every
+// sample_interval steps is traced by the tracers of Profiler, and its events
+// are counted by name rather than kept as a trace, but for a ring of the
+// latest host events. The aggregates are pulled by GetAggregates.
+//
+// A sampled step synchronizes the devices when it begins and ends, as
+// Profiler does. No step is sampled while a Profiler is alive.
+class ContinuousProfiler {
+ public:
+  static constexpr const char* kOtherEvents = "<other>";
+
+  static ContinuousProfiler& Instance();
+
+  void Enable(const ContinuousProfilerOptions& options);
+  void Disable();
+  bool IsEnabled() const;
+
+  // Marks the end of a step, ending the sample of the step if any, and
+  // beginning the sample of the next one every sample_interval steps.
+  void Step();
+
+  ContinuousProfilerAggregates GetAggregates() const;
+  std::vector<HostTraceEvent> GetRecentHostEvents() const;
+  void Reset();
+
+ private:
+  ContinuousProfiler() = default;
+  DISABLE_COPY_AND_ASSIGN(ContinuousProfiler);
+
+  void BeginSample();
+  void EndSample();
+  void Count(std::map<std::string, EventCounter>* counters,
+             const std::string& name,
+             uint64_t ns);
+
+  mutable std::mutex mutex_;
+  bool enabled_ = false;
+  ContinuousProfilerOptions options_;
+  std::unique_ptr<Profiler> profiler_;
+  uint64_t sample_start_ns_ = 0;
+  ContinuousProfilerAggregates aggregates_;
+  std::deque<HostTraceEvent> host_events_;
+};
+
+}  // namespace platform
+}  // namespace paddle
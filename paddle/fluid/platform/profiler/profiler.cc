@@ -134,13 +134,17 @@ void Profiler::Start() {
   cpu_utilization_.RecordBeginTimeInfo();
 }
 
-std::unique_ptr<ProfilerResult> Profiler::Stop() {
+void Profiler::Stop(TraceEventCollector* collector) {
   SynchronizeDevice();
-  TraceEventCollector collector;
   for (auto& tracer : tracers_) {
     tracer.Get().StopTracing();
-    tracer.Get().CollectTraceData(&collector);
+    tracer.Get().CollectTraceData(collector);
   }
+}
+
+std::unique_ptr<ProfilerResult> Profiler::Stop() {
+  TraceEventCollector collector;
+  Stop(&collector);
   std::unique_ptr<NodeTrees> tree(
       new NodeTrees(collector.HostEvents(),
                     collector.RuntimeEvents(),
@@ -66,6 +66,10 @@ class Profiler {
 
   std::unique_ptr<ProfilerResult> Stop();
 
+  // Stops the tracers and collects their events without building the
+  // result, for ContinuousProfiler which only counts them.
+  void Stop(TraceEventCollector* collector);
+
   ~Profiler();
 
  private:
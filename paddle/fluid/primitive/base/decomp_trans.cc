@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "paddle/fluid/primitive/base/decomp_trans.h"
+#include <map>
 #include <regex>
 #include "paddle/fluid/eager/api/utils/global_utils.h"
 #include "paddle/fluid/imperative/amp_auto_cast.h"
@@ -29,6 +30,7 @@
 COMMON_DECLARE_bool(prim_check_ops);
 COMMON_DECLARE_bool(prim_enable_dynamic);
 COMMON_DECLARE_string(prim_forward_blacklist);
+COMMON_DECLARE_string(prim_selective_decomp_ops);
 
 using paddle::dialect::DenseTensorType;
 using paddle::dialect::SelectedRowsType;
@@ -53,6 +55,32 @@ std::unordered_set<std::string> decomp_op_contain_none = {
 std::unordered_set<std::string> dynamic_shape_blacklist = {
     "pd_op.squeeze", "pd_op.unsqueeze", "pd_op.flatten"};
 
+// The primitive ops that CINN does not fuse with their neighbors.
+std::unordered_set<std::string> unfusible_primitive_ops = {
+    "pd_op.matmul",
+    "pd_op.conv2d",
+    "pd_op.pad3d",
+    "pd_op.nearest_interp",
+    "pd_op.gather",
+    "pd_op.gather_nd",
+    "pd_op.scatter",
+    "pd_op.scatter_nd_add",
+    "pd_op.put_along_axis",
+    "pd_op.cumsum",
+    "pd_op.argmax",
+    "pd_op.argmin",
+    "pd_op.uniform",
+    "pd_op.top_p_sampling",
+    "pd_op.select_input",
+    "pd_op.increment_",
+    "pd_op.feed",
+    "pd_op.fetch",
+    "pd_op.data",
+    "pd_op.if",
+    "pd_op.while",
+    "cf.yield",
+};
+
 namespace {
 std::set<std::string> StringSplit(const std::string& str) {
   std::istringstream iss(str);
@@ -72,6 +100,31 @@ std::set<std::string> StringSplit(const std::string& str) {
   return tokens;
 }
 
+// Parses FLAGS_prim_selective_decomp_ops, "op_name[:ratio];...", into the
+// time of each op decomposed and fused relative to its phi kernel, 1 when
+// not measured.
+std::map<std::string, double> ParseSelectiveDecompOps() {
+  std::map<std::string, double> ops;
+  for (const auto& item : StringSplit(FLAGS_prim_selective_decomp_ops)) {
+    if (item.empty()) {
+      continue;
+    }
+    size_t pos = item.find(':');
+    double ratio =
+        pos == std::string::npos ? 1.0 : std::stod(item.substr(pos + 1));
+    PADDLE_ENFORCE_GT(
+        ratio,
+        0.0,
+        common::errors::InvalidArgument(
+            "[Prim] The cost ratio of %s in FLAGS_prim_selective_decomp_ops "
+            "must be positive, but received %f.",
+            item,
+            ratio));
+    ops[item.substr(0, pos)] = ratio;
+  }
+  return ops;
+}
+
 void RemoveOp(pir::Block* block, pir::Operation* op) {
   bool remove_op = true;
   for (auto& item : op->results()) {
@@ -144,6 +197,22 @@ static phi::DataType GetValueDtype(pir::Value value) {
   }
 }
 
+// The bytes of a dense tensor value, 0 for other values. A dynamic dim
+// counts as 1: the tensors around an op mostly share their dynamic dims, so
+// the ratios of the costs are kept.
+static int64_t GetValueBytes(pir::Value value) {
+  if (!value || !value.type() || !value.type().isa<DenseTensorType>()) {
+    return 0;
+  }
+  auto type = value.type().dyn_cast<DenseTensorType>();
+  int64_t numel = 1;
+  for (int i = 0; i < type.dims().size(); ++i) {
+    numel *= std::max<int64_t>(type.dims()[i], 1);
+  }
+  return numel * static_cast<int64_t>(phi::SizeOf(
+                     paddle::dialect::TransToPhiDataType(type.dtype())));
+}
+
 static bool check_dynamic_shape(const pir::OpOperand& item,
                                 const pir::Operation& op) {
   auto dims = GetValueDims(item.source());
@@ -367,6 +436,58 @@ bool DecompProgram::enable_decomp_by_filter(const std::string& op_name) {
   return flag;
 }
 
+bool DecompProgram::is_fusible_neighbor(pir::Operation* op) {
+  const std::string& name = op->name();
+  if (unfusible_primitive_ops.count(name) ||
+      name.compare(0, 8, "builtin.") == 0) {
+    return false;
+  }
+  if (GetPrimitiveOpNames().count(name)) {
+    return true;
+  }
+  // decomposed into primitives unless it is selective itself
+  return has_decomp_rule(*op) && enable_decomp_by_filter(name) &&
+         !ParseSelectiveDecompOps().count(name);
+}
+
+bool DecompProgram::enable_decomp_by_cost(pir::Operation* op) {
+  auto selective_ops = ParseSelectiveDecompOps();
+  auto it = selective_ops.find(op->name());
+  if (it == selective_ops.end()) {
+    return true;
+  }
+  // The ops are memory bound: the phi kernel reads the inputs and writes the
+  // outputs once, and decomposing lets CINN fuse the op with its fusible
+  // neighbors, which saves the write and the read of each tensor between
+  // them, at the cost of the decomposed kernel being ratio times slower.
+  int64_t kernel_bytes = 0;
+  int64_t saved_bytes = 0;
+  for (auto operand : op->operands_source()) {
+    int64_t bytes = GetValueBytes(operand);
+    kernel_bytes += bytes;
+    pir::Operation* producer = operand ? operand.defining_op() : nullptr;
+    if (producer != nullptr && is_fusible_neighbor(producer)) {
+      saved_bytes += 2 * bytes;
+    }
+  }
+  for (auto result : op->results()) {
+    int64_t bytes = GetValueBytes(result);
+    kernel_bytes += bytes;
+    for (auto use = result.use_begin(); use != result.use_end(); ++use) {
+      if (is_fusible_neighbor(use->owner())) {
+        saved_bytes += 2 * bytes;
+        break;
+      }
+    }
+  }
+  double penalty = (it->second - 1.0) * static_cast<double>(kernel_bytes);
+  bool enable = static_cast<double>(saved_bytes) > penalty;
+  VLOG(4) << "[Prim] " << (enable ? "decomp" : "keep") << " selective op "
+          << op->name() << ", saved bytes by fusion: " << saved_bytes
+          << ", penalty of the decomposed kernel: " << penalty;
+  return enable;
+}
+
 std::vector<std::vector<pir::Value>> call_decomp_rule(pir::Operation* op) {
   paddle::dialect::DecompInterface decomp_interface =
       op->dyn_cast<paddle::dialect::DecompInterface>();
@@ -470,6 +591,9 @@ void DecompProgram::decomp_block(
              dynamic_shape_blacklist.end())) {
       enable_prim = false;
     }
+    if (enable_prim && !enable_decomp_by_cost(op)) {
+      enable_prim = false;
+    }
     if (enable_prim) {
       VLOG(4) << "[Prim] decomp op name " << op->name();
       check_decomp_dynamic_shape(op);
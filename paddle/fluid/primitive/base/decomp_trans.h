@@ -60,6 +60,10 @@ class DecompProgram {
                           std::unordered_map<pir::Value, int> orig_vars_dict,
                           std::vector<pir::Value>* tar_vars);
   bool enable_decomp_by_filter(const std::string& op_name);
+  // Whether an op of FLAGS_prim_selective_decomp_ops is worth decomposing,
+  // i.e. whether fusing it with its neighbors saves more memory traffic
+  // than its decomposed kernel loses to the phi kernel. Other ops are.
+  bool enable_decomp_by_cost(pir::Operation* op);
   void set_src_vars(const std::vector<pir::Value>& src_vars) {
     src_vars_ = src_vars;
   }
@@ -73,6 +77,7 @@ class DecompProgram {
 
  private:
   std::vector<pir::Operation*> parse_block_ops(pir::Block* block);
+  bool is_fusible_neighbor(pir::Operation* op);
 
   pir::Program* program_;
   std::vector<pir::Value> src_vars_;
@@ -32,6 +32,10 @@ limitations under the License. */
 #include "paddle/phi/core/distributed/store/store_utils.h"
 #include "paddle/phi/core/distributed/store/tcp_store.h"
 
+#if defined(PADDLE_WITH_RCCL) || defined(PADDLE_WITH_NCCL)
+#include "paddle/phi/core/distributed/comm_flight_recorder.h"
+#endif
+
 namespace py = pybind11;
 
 namespace paddle {
@@ -60,7 +64,25 @@ void BindCommContextManager(py::module *m) {
               py::arg("p2p_opt") = nullptr,
               py::arg("nccl_comm_init_option") = 0,
               py::call_guard<py::gil_scoped_release>())
+          .def_static(
+              "split_nccl_comm_context",
+              &phi::distributed::CommContextManager::SplitNCCLCommContext,
+              py::arg("parent_comm_key"),
+              py::arg("unique_comm_key"),
+              py::arg("color"),
+              py::arg("key"),
+              py::call_guard<py::gil_scoped_release>())
+          .def_static(
+              "is_nccl_comm_split_supported",
+              &phi::distributed::CommContextManager::IsNCCLCommSplitSupported)
 #endif
+          .def_static("begin_batch_init",
+                      &phi::distributed::CommContextManager::BeginBatchInit)
+          .def_static("end_batch_init",
+                      &phi::distributed::CommContextManager::EndBatchInit,
+                      py::call_guard<py::gil_scoped_release>())
+          .def_static("comm_init_times",
+                      &phi::distributed::CommContextManager::GetCommInitTimes)
 #if defined(PADDLE_WITH_XPU_BKCL)
           .def_static(
               "create_bkcl_comm_context",
@@ -85,6 +107,15 @@ void BindCommContextManager(py::module *m) {
               py::call_guard<py::gil_scoped_release>())
 #endif
           .def("set_store", &phi::distributed::CommContextManager::SetStore);
+
+#if defined(PADDLE_WITH_RCCL) || defined(PADDLE_WITH_NCCL)
+  m->def(
+      "dump_comm_flight_recorder",
+      []() {
+        return phi::distributed::CommFlightRecorder::GetInstance().Dump();
+      },
+      py::call_guard<py::gil_scoped_release>());
+#endif
 }
 
 using TCPStore = phi::distributed::TCPStore;
@@ -120,6 +151,42 @@ void BindTCPStore(py::module *m) {
                         py::call_guard<py::gil_scoped_release>())
                    .def("wait",
                         &phi::distributed::Store::wait,
+                        py::call_guard<py::gil_scoped_release>())
+                   .def(
+                       "multi_set",
+                       [](phi::distributed::Store &self,
+                          const std::vector<std::string> &keys,
+                          const std::vector<std::string> &values) {
+                         std::vector<std::vector<uint8_t>> data;
+                         data.reserve(values.size());
+                         for (const auto &value : values) {
+                           data.emplace_back(value.begin(), value.end());
+                         }
+                         self.multi_set(keys, data);
+                       },
+                       py::arg("keys"),
+                       py::arg("values"),
+                       py::call_guard<py::gil_scoped_release>())
+                   .def(
+                       "multi_get",
+                       [](phi::distributed::Store &self,
+                          const std::vector<std::string> &keys) {
+                         auto data = self.multi_get(keys);
+                         py::gil_scoped_acquire acquire;
+                         py::list values;
+                         for (const auto &value : data) {
+                           values.append(py::bytes(
+                               std::string(value.begin(), value.end())));
+                         }
+                         return values;
+                       },
+                       py::arg("keys"),
+                       py::call_guard<py::gil_scoped_release>())
+                   .def("barrier",
+                        &phi::distributed::Store::barrier,
+                        py::arg("key"),
+                        py::arg("rank"),
+                        py::arg("world_size"),
                         py::call_guard<py::gil_scoped_release>());
 
   py::class_<TCPStore, std::shared_ptr<TCPStore>>(*m, "TCPStore", Store)
@@ -127,15 +194,17 @@ void BindTCPStore(py::module *m) {
                        uint16_t port,
                        bool is_master,
                        size_t world_size,
-                       int timeout) {
+                       int timeout,
+                       int num_shards) {
              return std::make_shared<TCPStore>(
-                 hostname, port, is_master, world_size, timeout);
+                 hostname, port, is_master, world_size, timeout, num_shards);
            }),
            py::arg("hostname"),
            py::arg("port"),
            py::arg("is_master"),
            py::arg("world_size"),
            py::arg("timeout") = 900,
+           py::arg("num_shards") = 1,
            py::call_guard<py::gil_scoped_release>());
 
   m->def("create_or_get_global_tcp_store",
@@ -17,6 +17,7 @@
 #include <string>
 #include <vector>
 
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/api/profiler/event.h"
 #include "paddle/phi/core/platform/device_event_base.h"
 
@@ -76,6 +77,7 @@ void BindCudaStream(py::module *m_ptr) {
 
   m.def("_device_synchronize", [](int device_id) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+    paddle::experimental::AsyncKernelLauncher::Instance().Wait();
     if (device_id == -1) {
       device_id = paddle::platform::GetCurrentDeviceId();
     }
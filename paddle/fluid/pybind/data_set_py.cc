@@ -222,6 +222,9 @@ void BindDataset(py::module *m) {
       .def("set_thread_num",
            &framework::Dataset::SetThreadNum,
            py::call_guard<py::gil_scoped_release>())
+      .def("set_reader_autoscale",
+           &framework::Dataset::SetReaderAutoscale,
+           py::call_guard<py::gil_scoped_release>())
       .def("set_trainer_num",
            &framework::Dataset::SetTrainerNum,
            py::call_guard<py::gil_scoped_release>())
@@ -288,6 +291,9 @@ void BindDataset(py::module *m) {
       .def("global_shuffle",
            &framework::Dataset::GlobalShuffle,
            py::call_guard<py::gil_scoped_release>())
+      .def("streaming_global_shuffle",
+           &framework::Dataset::StreamingGlobalShuffle,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_memory_data_size",
            &framework::Dataset::GetMemoryDataSize,
            py::call_guard<py::gil_scoped_release>())
@@ -387,6 +393,9 @@ void BindDataset(py::module *m) {
            py::call_guard<py::gil_scoped_release>())
       .def("dump_sample_neighbors",
            &framework::Dataset::DumpSampleNeighbors,
+           py::call_guard<py::gil_scoped_release>())
+      .def("dump_slot_records",
+           &framework::Dataset::DumpSlotRecords,
            py::call_guard<py::gil_scoped_release>());
 
   py::class_<IterableDatasetWrapper>(*m, "IterableDatasetWrapper")
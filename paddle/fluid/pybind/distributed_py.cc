@@ -21,6 +21,7 @@ limitations under the License. */
 #undef _XOPEN_SOURCE
 #endif
 
+#include "paddle/fluid/distributed/collective/param_sharder.h"
 #include "paddle/fluid/distributed/collective/process_group.h"
 #include "paddle/fluid/distributed/collective/reducer.h"
 #include "paddle/fluid/framework/lod_tensor.h"
@@ -66,14 +67,34 @@ std::shared_ptr<distributed::EagerReducer> CreateEagerReducer(
     const std::vector<bool> &is_sparse_gradient,
     std::shared_ptr<distributed::ProcessGroup> process_group,
     const std::vector<size_t> &group_size_limits,
-    bool find_unused_parameters) {
+    bool find_unused_parameters,
+    bool rebuild_groups,
+    size_t first_group_size_limit,
+    bool grad_as_bucket_view) {
   auto params = CastPyArg2VectorOfTensor(py_tensors.ptr(), 0);
   return std::make_shared<distributed::EagerReducer>(params,
                                                      group_indices,
                                                      is_sparse_gradient,
                                                      process_group,
                                                      group_size_limits,
-                                                     find_unused_parameters);
+                                                     find_unused_parameters,
+                                                     rebuild_groups,
+                                                     first_group_size_limit,
+                                                     grad_as_bucket_view);
+}
+
+std::shared_ptr<distributed::EagerParamSharder> CreateEagerParamSharder(
+    py::handle py_tensors,
+    const std::vector<std::vector<size_t>> &layer_param_indices,
+    std::shared_ptr<distributed::ProcessGroup> process_group,
+    size_t prefetch_layers,
+    size_t bucket_size_limit) {
+  auto params = CastPyArg2VectorOfTensor(py_tensors.ptr(), 0);
+  return std::make_shared<distributed::EagerParamSharder>(params,
+                                                          layer_param_indices,
+                                                          process_group,
+                                                          prefetch_layers,
+                                                          bucket_size_limit);
 }
 
 #if defined(PADDLE_WITH_GLOO)
@@ -160,6 +181,63 @@ void BindDistributed(py::module *m) {
               py::arg("sync_op"),
               py::call_guard<py::gil_scoped_release>())
 
+          .def(
+              "all_reduce_coalesced",
+              [](distributed::ProcessGroup &self,
+                 py::handle py_tensor_list,
+                 distributed::ReduceOp op,
+                 bool use_calc_stream) {
+                auto tensor_list =
+                    CastPyArg2VectorOfTensor(py_tensor_list.ptr(), 0);
+                std::vector<phi::DenseTensor *> out_dense_list;
+                std::vector<phi::DenseTensor> in_dense_list;
+                for (auto &tensor : tensor_list) {
+                  auto p_dense =
+                      std::dynamic_pointer_cast<phi::DenseTensor>(
+                          tensor.impl());
+                  out_dense_list.push_back(p_dense.get());
+                  in_dense_list.push_back(*p_dense);
+                }
+                distributed::AllreduceOptions opts{op};
+                return self.AllReduceCoalesced(
+                    out_dense_list, in_dense_list, opts, use_calc_stream);
+              },
+              py::arg("tensors"),
+              py::arg("op"),
+              py::arg("use_calc_stream") = false,
+              py::call_guard<py::gil_scoped_release>())
+
+          .def(
+              "all_gather_coalesced",
+              [](distributed::ProcessGroup &self,
+                 py::handle py_out_tensor_list,
+                 py::handle py_in_tensor_list,
+                 bool use_calc_stream) {
+                auto out_tensor_list =
+                    CastPyArg2VectorOfTensor(py_out_tensor_list.ptr(), 0);
+                auto in_tensor_list =
+                    CastPyArg2VectorOfTensor(py_in_tensor_list.ptr(), 1);
+                std::vector<phi::DenseTensor *> out_dense_list;
+                for (auto &tensor : out_tensor_list) {
+                  out_dense_list.push_back(
+                      std::dynamic_pointer_cast<phi::DenseTensor>(
+                          tensor.impl())
+                          .get());
+                }
+                std::vector<phi::DenseTensor> in_dense_list;
+                for (auto &tensor : in_tensor_list) {
+                  in_dense_list.push_back(
+                      *std::dynamic_pointer_cast<phi::DenseTensor>(
+                          tensor.impl()));
+                }
+                return self.AllGatherCoalesced(
+                    out_dense_list, in_dense_list, use_calc_stream);
+              },
+              py::arg("out"),
+              py::arg("in"),
+              py::arg("use_calc_stream") = false,
+              py::call_guard<py::gil_scoped_release>())
+
           .def(
               "broadcast",
               [](distributed::ProcessGroup &self,
@@ -1257,6 +1335,11 @@ void BindDistributed(py::module *m) {
                   py::arg("timeout") = 30 * 60 * 1000,
                   py::arg("nccl_comm_init_option") = 0,
                   py::call_guard<py::gil_scoped_release>())
+      .def("split_comm",
+           &distributed::ProcessGroupNCCL::SplitComm,
+           py::arg("group_id"),
+           py::arg("rank_in_group"),
+           py::call_guard<py::gil_scoped_release>())
       .def_static("group_start", distributed::ProcessGroupNCCL::GroupStart)
       .def_static("group_end", distributed::ProcessGroupNCCL::GroupEnd);
 
@@ -1416,7 +1499,16 @@ void BindDistributed(py::module *m) {
   py::class_<distributed::EagerReducer,
              std::shared_ptr<distributed::EagerReducer>>(
       *m, "EagerReducer", R"DOC()DOC")
-      .def(py::init(&CreateEagerReducer))
+      .def(py::init(&CreateEagerReducer),
+           py::arg("tensors"),
+           py::arg("group_indices"),
+           py::arg("is_sparse_gradient"),
+           py::arg("process_group"),
+           py::arg("group_size_limits"),
+           py::arg("find_unused_parameters"),
+           py::arg("rebuild_groups") = true,
+           py::arg("first_group_size_limit") = 0,
+           py::arg("grad_as_bucket_view") = false)
       .def(
           "prepare_for_backward",
           [](distributed::EagerReducer &self, py::handle py_tensors) {
@@ -1424,7 +1516,87 @@ void BindDistributed(py::module *m) {
             self.PrepareForBackward(params);
           },
           py::arg("tensors"),
-          py::call_guard<py::gil_scoped_release>());
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "set_gradient_compression",
+          [](distributed::EagerReducer &self,
+             const std::string &type,
+             bool error_feedback,
+             int powersgd_rank,
+             double topk_ratio) {
+            distributed::GradientCompressionOptions options;
+            options.type = distributed::GradientCompressionTypeFromString(type);
+            options.error_feedback = error_feedback;
+            options.powersgd_rank = powersgd_rank;
+            options.topk_ratio = topk_ratio;
+            self.SetGradientCompression(options);
+          },
+          py::arg("type"),
+          py::arg("error_feedback") = true,
+          py::arg("powersgd_rank") = 4,
+          py::arg("topk_ratio") = 0.01,
+          py::call_guard<py::gil_scoped_release>())
+      .def("gradient_compression_stats",
+           [](const distributed::EagerReducer &self) {
+             py::list stats;
+             for (const auto &group : self.GetGradientCompressionStats()) {
+               py::dict item;
+               item["group_index"] = group.group_index;
+               item["original_bytes"] = group.original_bytes;
+               item["compressed_bytes"] = group.compressed_bytes;
+               item["compression_ratio"] = group.compression_ratio;
+               item["relative_error"] = group.relative_error;
+               stats.append(item);
+             }
+             return stats;
+           });
+
+  py::class_<distributed::EagerParamSharder,
+             std::shared_ptr<distributed::EagerParamSharder>>(
+      *m, "EagerParamSharder", R"DOC()DOC")
+      .def(py::init(&CreateEagerParamSharder),
+           py::arg("tensors"),
+           py::arg("layer_param_indices"),
+           py::arg("process_group"),
+           py::arg("prefetch_layers") = 1,
+           py::arg("bucket_size_limit") = 25 * 1024 * 1024)
+      .def("pre_forward",
+           &distributed::EagerParamSharder::PreForward,
+           py::arg("layer_index"),
+           py::call_guard<py::gil_scoped_release>())
+      .def(
+          "post_forward",
+          [](distributed::EagerParamSharder &self,
+             size_t layer_index,
+             py::handle py_tensors) {
+            auto outputs = CastPyArg2VectorOfTensor(py_tensors.ptr(), 0);
+            py::gil_scoped_release release;
+            self.PostForward(layer_index, outputs);
+          },
+          py::arg("layer_index"),
+          py::arg("outputs"))
+      .def("finalize_backward",
+           &distributed::EagerParamSharder::FinalizeBackward,
+           py::call_guard<py::gil_scoped_release>())
+      .def("shards",
+           [](const distributed::EagerParamSharder &self) {
+             return py::reinterpret_steal<py::object>(
+                 ToPyObject(self.Shards()));
+           })
+      .def("shard_grads",
+           [](const distributed::EagerParamSharder &self) {
+             return py::reinterpret_steal<py::object>(
+                 ToPyObject(self.ShardGrads(), true));
+           })
+      .def("clear_shard_grads",
+           &distributed::EagerParamSharder::ClearShardGrads,
+           py::call_guard<py::gil_scoped_release>())
+      .def("gather_all",
+           &distributed::EagerParamSharder::GatherAll,
+           py::call_guard<py::gil_scoped_release>())
+      .def("release_all",
+           &distributed::EagerParamSharder::ReleaseAll,
+           py::call_guard<py::gil_scoped_release>());
 
   py::class_<distributed::ProcessGroupIdMap,
              std::shared_ptr<distributed::ProcessGroupIdMap>>(
@@ -26,10 +26,12 @@ typedef SSIZE_T ssize_t;
 #include <vector>
 
 #include "paddle/fluid/eager/accumulation/accumulation_node.h"
+#include "paddle/fluid/eager/activation_offload.h"
 #include "paddle/fluid/eager/api/all.h"
 #include "paddle/fluid/eager/autograd_meta.h"
 #include "paddle/fluid/eager/backward.h"
 #include "paddle/fluid/eager/custom_operator/custom_operator_node.h"
+#include "paddle/fluid/eager/recompute.h"
 #include "paddle/fluid/eager/utils.h"
 #include "paddle/fluid/framework/convert_utils.h"
 #include "paddle/fluid/framework/custom_operator.h"
@@ -69,6 +71,7 @@ typedef SSIZE_T ssize_t;
 #include "paddle/phi/api/lib/data_transform.h"
 #ifdef PADDLE_WITH_DISTRIBUTE
 #include "paddle/phi/api/lib/api_gen_utils.h"
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_utils.h"
 #include "paddle/phi/infermeta/spmd_rules/rules.h"
 #endif
@@ -468,7 +471,7 @@ static PyObject* eager_api__get_custom_operator_inplace_reverse_idx(
     PyObject* self, PyObject* args, PyObject* kwargs) {
   EAGER_TRY
   std::string op_type = CastPyArg2AttrString(PyTuple_GET_ITEM(args, 0), 0);
-  auto meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
+  const auto& meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
   PADDLE_ENFORCE_NE(meta_info_map.find(op_type),
                     meta_info_map.end(),
                     common::errors::NotFound(
@@ -530,6 +533,8 @@ PyObject* eager_api_run_custom_op(PyObject* self,
                                   PyObject* args,
                                   PyObject* kwargs) {
   EAGER_TRY
+  // custom kernels run outside of the API layer
+  paddle::experimental::AsyncKernelLauncher::Instance().Wait();
   FLAGS_tensor_operants_mode = "phi";
   if (paddle::OperantsManager::Instance().phi_operants.get() == nullptr) {
     paddle::OperantsManager::Instance().phi_operants =
@@ -540,7 +545,7 @@ PyObject* eager_api_run_custom_op(PyObject* self,
   std::string op_type = CastPyArg2AttrString(PyTuple_GET_ITEM(args, 0), 0);
   VLOG(7) << "Get things from python for Custom Op: " << op_type;
   paddle::CustomOpKernelContext ctx;
-  auto meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
+  const auto& meta_info_map = egr::Controller::Instance().GetOpMetaInfoMap();
   PADDLE_ENFORCE_NE(meta_info_map.find(op_type),
                     meta_info_map.end(),
                     common::errors::NotFound(
@@ -549,9 +554,11 @@ PyObject* eager_api_run_custom_op(PyObject* self,
                         "sure you registered your op first and try again. ",
                         op_type));
   const auto& vec_map = meta_info_map.at(op_type);
-  const auto& inputs = paddle::OpMetaInfoHelper::GetInputs(vec_map[0]);
-  const auto& attrs = paddle::OpMetaInfoHelper::GetAttrs(vec_map[0]);
-  const auto& outputs = paddle::OpMetaInfoHelper::GetOutputs(vec_map[0]);
+  const auto& signature =
+      paddle::framework::detail::GetCustomOpSignature(vec_map[0]);
+  const auto& inputs = signature.inputs;
+  const auto& attrs = signature.attrs;
+  const auto& outputs = signature.outputs;
   const auto& inplace_map = paddle::OpMetaInfoHelper::GetInplaceMap(vec_map[0]);
 
   for (size_t i = 0; i < inputs.size(); ++i) {
@@ -568,7 +575,7 @@ PyObject* eager_api_run_custom_op(PyObject* self,
       ctx.EmplaceBackInput(paddle::Tensor());
       continue;
     }
-    if (paddle::framework::detail::IsDuplicableVar(input)) {
+    if (signature.duplicable_inputs[i]) {
       std::vector<paddle::Tensor> tensors =
           CastPyArg2VectorOfTensor(obj, i + 1);
       ctx.EmplaceBackInputs(std::move(tensors));
@@ -601,7 +608,7 @@ PyObject* eager_api_run_custom_op(PyObject* self,
         ctx.EmplaceBackInput(paddle::Tensor());
         continue;
       }
-      if (paddle::framework::detail::IsDuplicableVar(input)) {
+      if (signature.duplicable_inputs[i]) {
         std::vector<paddle::Tensor> tensors =
             CastPyArg2VectorOfTensor(obj, i + 1, mesh);
         ctx.EmplaceBackInputs(std::move(tensors));
@@ -622,45 +629,46 @@ PyObject* eager_api_run_custom_op(PyObject* self,
   int attr_start_idx = static_cast<int>(1 + inputs.size());
   for (size_t i = 0; i < attrs.size(); ++i) {
     const auto& attr = attrs.at(i);
-    std::vector<std::string> attr_name_and_type = paddle::ParseAttrStr(attr);
-    auto attr_type_str = attr_name_and_type[1];
-    VLOG(7) << "Custom operator add attrs " << attr_name_and_type[0]
-            << " to CustomOpKernelContext. Attribute type = " << attr_type_str;
+    VLOG(7) << "Custom operator add attrs " << attr.name
+            << " to CustomOpKernelContext. Attribute type = " << attr.type_str;
     PyObject* obj = PyTuple_GET_ITEM(args, attr_start_idx + i);
-    if (attr_type_str == "bool") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrBoolean(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "int") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrInt(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "float") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrFloat(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "int64_t") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2Long(obj, op_type, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "std::string") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2AttrString(obj, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "std::vector<int>") {      // NOLINT
-      ctx.EmplaceBackAttr(CastPyArg2VectorOfInt(obj, attr_start_idx + i));
-    } else if (attr_type_str == "std::vector<float>") {
-      ctx.EmplaceBackAttr(CastPyArg2VectorOfFloat(obj, attr_start_idx + i));
-    } else if (attr_type_str == "std::vector<int64_t>") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2Longs(obj, op_type, attr_start_idx + i));  // NOLINT
-    } else if (attr_type_str == "std::vector<std::string>") {
-      ctx.EmplaceBackAttr(
-          CastPyArg2VectorOfString(obj, attr_start_idx + i));  // NOLINT
-    } else {
-      PADDLE_THROW(common::errors::Unimplemented(
-          "Unsupported `%s` type value as custom attribute now. "
-          "Supported data types include `bool`, `int`, `float`, "
-          "`int64_t`, `std::string`, `std::vector<int>`, "
-          "`std::vector<float>`, `std::vector<int64_t>`, "
-          "`std::vector<std::string>`, Please check whether "
-          "the attribute data type and data type string are matched.",
-          attr_type_str));
+    switch (attr.type) {
+      case paddle::framework::detail::CustomAttrType::kBool:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrBoolean(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case paddle::framework::detail::CustomAttrType::kInt:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrInt(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case paddle::framework::detail::CustomAttrType::kFloat:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrFloat(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case paddle::framework::detail::CustomAttrType::kInt64:
+        ctx.EmplaceBackAttr(
+            CastPyArg2Long(obj, op_type, attr_start_idx + i));  // NOLINT
+        break;
+      case paddle::framework::detail::CustomAttrType::kString:
+        ctx.EmplaceBackAttr(
+            CastPyArg2AttrString(obj, attr_start_idx + i));  // NOLINT
+        break;
+      case paddle::framework::detail::CustomAttrType::kInts:
+        ctx.EmplaceBackAttr(CastPyArg2VectorOfInt(obj, attr_start_idx + i));
+        break;
+      case paddle::framework::detail::CustomAttrType::kFloats:
+        ctx.EmplaceBackAttr(CastPyArg2VectorOfFloat(obj, attr_start_idx + i));
+        break;
+      case paddle::framework::detail::CustomAttrType::kInt64s:
+        ctx.EmplaceBackAttr(
+            CastPyArg2Longs(obj, op_type, attr_start_idx + i));  // NOLINT
+        break;
+      case paddle::framework::detail::CustomAttrType::kStrings:
+        ctx.EmplaceBackAttr(
+            CastPyArg2VectorOfString(obj, attr_start_idx + i));  // NOLINT
+        break;
+      default:
+        paddle::framework::detail::ThrowUnsupportedCustomAttr(attr.type_str);
     }
   }
 
@@ -677,7 +685,7 @@ PyObject* eager_api_run_custom_op(PyObject* self,
         const auto& input_range = ctx.InputRangeAt(in_idx);
         const auto& input_tensor = ctx.InputAt(input_range.first);
         // inplace optional [Tensor or vector<Tensor>], un-initialized tensor.
-        if (paddle::framework::detail::IsOptionalVar(output) &&
+        if (signature.optional_outputs[out_idx] &&
             !input_tensor.initialized()) {
           VLOG(7) << "Custom operator add output " << output
                   << " to CustomOpKernelContext. Add un-initialized tensor "
@@ -686,7 +694,7 @@ PyObject* eager_api_run_custom_op(PyObject* self,
           continue;
         }
         /// inplace vector<Tensor>, initialized tensor.
-        if (paddle::framework::detail::IsDuplicableVar(output)) {
+        if (signature.duplicable_outputs[out_idx]) {
           std::vector<paddle::Tensor> empty_tensors;
           size_t vector_size = input_range.second - input_range.first;
           empty_tensors.resize(vector_size);
@@ -717,7 +725,7 @@ PyObject* eager_api_run_custom_op(PyObject* self,
             ctx.MutableOutputAt(ctx.OutputRangeAt(i).first);
         if (!out_tensor->initialized()) {
           PADDLE_ENFORCE(
-              paddle::framework::detail::IsOptionalVar(outputs.at(i)) ||
+              signature.optional_outputs[i] ||
                   out_tensor->is_dist_tensor(),
               common::errors::InvalidArgument(
                   "Custom operator's %d-th output is not initialized. "
@@ -972,6 +980,46 @@ static PyObject* eager_api_reset_saved_tensors_hooks(PyObject* self,
   EAGER_CATCH_AND_THROW_RETURN_NULL
 }
 
+static PyObject* eager_api_enable_activation_offload(PyObject* self,
+                                                     PyObject* args,
+                                                     PyObject* kwargs) {
+  EAGER_TRY
+  auto min_bytes = CastPyArg2AttrLong(PyTuple_GET_ITEM(args, 0), 0);
+  auto prefetch_num = CastPyArg2AttrInt(PyTuple_GET_ITEM(args, 1), 1);
+  egr::ActivationOffloader::Instance().Enable(min_bytes, prefetch_num);
+  RETURN_PY_NONE
+  EAGER_CATCH_AND_THROW_RETURN_NULL
+}
+
+static PyObject* eager_api_disable_activation_offload(PyObject* self,
+                                                      PyObject* args,
+                                                      PyObject* kwargs) {
+  EAGER_TRY
+  egr::ActivationOffloader::Instance().Disable();
+  RETURN_PY_NONE
+  EAGER_CATCH_AND_THROW_RETURN_NULL
+}
+
+static PyObject* eager_api_enable_recompute(PyObject* self,
+                                            PyObject* args,
+                                            PyObject* kwargs) {
+  EAGER_TRY
+  auto budget_bytes = CastPyArg2AttrLong(PyTuple_GET_ITEM(args, 0), 0);
+  auto ops = CastPyArg2VectorOfString(PyTuple_GET_ITEM(args, 1), 1);
+  egr::Recomputer::Instance().Enable(budget_bytes, ops);
+  RETURN_PY_NONE
+  EAGER_CATCH_AND_THROW_RETURN_NULL
+}
+
+static PyObject* eager_api_disable_recompute(PyObject* self,
+                                             PyObject* args,
+                                             PyObject* kwargs) {
+  EAGER_TRY
+  egr::Recomputer::Instance().Disable();
+  RETURN_PY_NONE
+  EAGER_CATCH_AND_THROW_RETURN_NULL
+}
+
 #if defined(PADDLE_WITH_CUDA)
 static PyObject* eager_api_async_read(PyObject* self,
                                       PyObject* args,
@@ -1427,6 +1475,22 @@ PyMethodDef variable_functions[] = {  // NOLINT
      (PyCFunction)(void (*)())eager_api_reset_saved_tensors_hooks,
      METH_VARARGS | METH_KEYWORDS,
      nullptr},
+    {"enable_activation_offload",
+     (PyCFunction)(void (*)())eager_api_enable_activation_offload,
+     METH_VARARGS | METH_KEYWORDS,
+     nullptr},
+    {"disable_activation_offload",
+     (PyCFunction)(void (*)())eager_api_disable_activation_offload,
+     METH_VARARGS | METH_KEYWORDS,
+     nullptr},
+    {"enable_recompute",
+     (PyCFunction)(void (*)())eager_api_enable_recompute,
+     METH_VARARGS | METH_KEYWORDS,
+     nullptr},
+    {"disable_recompute",
+     (PyCFunction)(void (*)())eager_api_disable_recompute,
+     METH_VARARGS | METH_KEYWORDS,
+     nullptr},
     /**amp functions**/
     {"set_master_grads",
      (PyCFunction)(void (*)())eager_api_set_master_grads,
@@ -40,6 +40,7 @@ typedef SSIZE_T ssize_t;
 #include "paddle/fluid/pybind/slice_utils.h"
 #include "paddle/fluid/pybind/uva_utils.h"
 #include "paddle/phi/api/include/api.h"
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/api/lib/data_transform.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/core/compat/convert_utils.h"
@@ -152,6 +153,7 @@ static PyObject* tensor_method_numpy(TensorObject* self,
                                      PyObject* args,
                                      PyObject* kwargs) {
   EAGER_TRY
+  paddle::experimental::AsyncKernelLauncher::Instance().Wait();
   auto& api = pybind11::detail::npy_api::get();
   if (!self->tensor.impl()) {
     Py_intptr_t py_dims[phi::DDim::kMaxRank];     // NOLINT
@@ -1527,6 +1529,7 @@ static PyObject* tensor__getitem_from_offset(TensorObject* self,
                                              PyObject* args,
                                              PyObject* kwargs) {
   EAGER_TRY
+  paddle::experimental::AsyncKernelLauncher::Instance().Wait();
   phi::DenseTensor* ptr = nullptr;
   phi::DenseTensor tensor_after_reshard;
   if (self->tensor.is_selected_rows()) {
@@ -452,7 +452,11 @@ void BindIndexSampler(py::module* m) {
       }))
       .def("init_layerwise_conf", &IndexSampler::init_layerwise_conf)
       .def("init_beamsearch_conf", &IndexSampler::init_beamsearch_conf)
-      .def("sample", &IndexSampler::sample);
+      .def("sample", &IndexSampler::sample)
+      .def("set_beamsearch_embedding", &IndexSampler::set_beamsearch_embedding)
+      .def("beam_search",
+           &IndexSampler::beam_search,
+           py::call_guard<py::gil_scoped_release>());
 }
 }  // end namespace pybind
 }  // namespace paddle
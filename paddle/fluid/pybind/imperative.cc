@@ -42,6 +42,7 @@ limitations under the License. */
 #include "paddle/fluid/imperative/basic_engine.h"
 #include "paddle/fluid/imperative/bkcl_context.h"
 #include "paddle/fluid/imperative/data_loader.h"
+#include "paddle/fluid/imperative/data_pipeline.h"
 #include "paddle/fluid/imperative/gloo_context.h"
 #include "paddle/fluid/imperative/heter_ccl_context.h"
 #include "paddle/fluid/imperative/hooks.h"
@@ -123,6 +124,18 @@ class PyVariableWrapperHook : public imperative::VariableWrapperHook {
   PyObject *py_func_;
 };
 
+// The workers of the pipeline take the GIL to fetch the samples, it is
+// released while they are joined.
+class PyDataPipeline : public imperative::DataPipeline {
+ public:
+  using imperative::DataPipeline::DataPipeline;
+
+  ~PyDataPipeline() override {
+    py::gil_scoped_release release;
+    Shutdown();
+  }
+};
+
 static const phi::Place PyObjectToPlace(const py::object &place_obj) {
   if (py::isinstance<phi::CPUPlace>(place_obj)) {
     return place_obj.cast<phi::CPUPlace>();
@@ -613,6 +626,61 @@ void BindImperative(py::module *m_ptr) {
   });
 #endif
 
+  // Dygraph DataLoader thread pipeline. fetch(index) returns the fields of
+  // sample index as a list of numpy arrays, which are stacked without a copy
+  // to a tensor first.
+  py::class_<PyDataPipeline>(m, "_DataPipeline")
+      .def(py::init([](py::function fetch,
+                       int num_threads,
+                       int prefetch_num,
+                       bool pin_memory) {
+             auto fetch_fn = [fetch](int64_t index) {
+               py::gil_scoped_acquire gil;
+               imperative::DataPipeline::Sample sample;
+               try {
+                 py::list fields = fetch(index);
+                 sample.resize(fields.size());
+                 for (size_t i = 0; i < fields.size(); ++i) {
+                   SetTensorFromPyArray<phi::CPUPlace>(
+                       &sample[i], fields[i], phi::CPUPlace(), true);
+                 }
+               } catch (py::error_already_set &e) {
+                 PADDLE_THROW(common::errors::External(
+                     "DataLoader failed to fetch sample %d: %s",
+                     index,
+                     e.what()));
+               }
+               return sample;
+             };
+             return std::make_unique<PyDataPipeline>(
+                 fetch_fn, num_threads, prefetch_num, pin_memory);
+           }),
+           py::arg("fetch"),
+           py::arg("num_threads"),
+           py::arg("prefetch_num"),
+           py::arg("pin_memory"))
+      .def("reset",
+           [](PyDataPipeline &self,
+              std::vector<std::vector<int64_t>> batches) {
+             self.Reset(std::move(batches));
+           })
+      .def("next",
+           [](PyDataPipeline &self) -> py::object {
+             std::vector<phi::DenseTensor> batch;
+             bool has_next = false;
+             {
+               py::gil_scoped_release release;
+               has_next = self.Next(&batch);
+             }
+             if (!has_next) {
+               return py::none();
+             }
+             return py::cast(phi::TensorArray(batch));
+           })
+      .def("shutdown",
+           &PyDataPipeline::Shutdown,
+           py::call_guard<py::gil_scoped_release>());
+
   m.def("start_imperative_gperf_profiler",
         []() { imperative::StartProfile(); });
   m.def("_set_eager_tracer",
@@ -633,6 +701,11 @@ void BindImperative(py::module *m_ptr) {
   m.def("_set_has_grad", [](bool has_grad) {
     return egr::Controller::Instance().SetHasGrad(has_grad);
   });
+  m.def("_is_inference_mode",
+        []() { return egr::Controller::Instance().IsInferenceMode(); });
+  m.def("_set_inference_mode", [](bool inference_mode) {
+    return egr::Controller::Instance().SetInferenceMode(inference_mode);
+  });
   m.def("_get_amp_attrs",
         []() { return egr::Controller::Instance().GetCurrentAmpAttrs(); });
   m.def("_set_amp_op_list",
@@ -874,6 +874,10 @@ void BindAnalysisConfig(py::module *m) {
       .def("enable_new_ir", &AnalysisConfig::EnableNewIR, py::arg("x") = true)
       .def("new_ir_enabled", &AnalysisConfig::new_ir_enabled)
       .def("enable_profile", &AnalysisConfig::EnableProfile)
+      .def("enable_startup_trace",
+           &AnalysisConfig::EnableStartupTrace,
+           py::arg("x") = true)
+      .def("startup_trace_enabled", &AnalysisConfig::startup_trace_enabled)
       .def("disable_glog_info", &AnalysisConfig::DisableGlogInfo)
       .def("glog_info_disabled", &AnalysisConfig::glog_info_disabled)
       .def("enable_save_optim_model",
@@ -927,6 +931,15 @@ void BindAnalysisConfig(py::module *m) {
       .def("shape_range_info_path", &AnalysisConfig::shape_range_info_path)
       .def("shape_range_info_collected",
            &AnalysisConfig::shape_range_info_collected)
+      .def("collect_allocation_profile",
+           &AnalysisConfig::CollectAllocationProfile)
+      .def("enable_allocation_profile_replay",
+           &AnalysisConfig::EnableAllocationProfileReplay)
+      .def("allocation_profile_path", &AnalysisConfig::allocation_profile_path)
+      .def("allocation_profile_collected",
+           &AnalysisConfig::allocation_profile_collected)
+      .def("allocation_profile_replay_enabled",
+           &AnalysisConfig::allocation_profile_replay_enabled)
       .def("enable_tuned_tensorrt_dynamic_shape",
            &AnalysisConfig::EnableTunedTensorRtDynamicShape,
            py::arg("shape_range_info_path") = "",
@@ -973,6 +986,8 @@ void BindAnalysisConfig(py::module *m) {
            &AnalysisConfig::SetCpuMathLibraryNumThreads)
       .def("cpu_math_library_num_threads",
            &AnalysisConfig::cpu_math_library_num_threads)
+      .def("set_cpu_thread_affinity", &AnalysisConfig::SetCpuThreadAffinity)
+      .def("cpu_thread_affinity", &AnalysisConfig::cpu_thread_affinity)
       .def("to_native_config", &AnalysisConfig::ToNativeConfig)
       .def("enable_mkldnn_bfloat16", &AnalysisConfig::EnableMkldnnBfloat16)
 #ifdef PADDLE_WITH_DNNL
@@ -1097,6 +1112,7 @@ void BindAnalysisPredictor(py::module *m) {
       .def("clear_intermediate_tensor",
            &AnalysisPredictor::ClearIntermediateTensor)
       .def("try_shrink_memory", &AnalysisPredictor::TryShrinkMemory)
+      .def("update_parameters", &AnalysisPredictor::UpdateParameters)
       .def("create_feed_fetch_var", &AnalysisPredictor::CreateFeedFetchVar)
       .def("prepare_feed_fetch", &AnalysisPredictor::PrepareFeedFetch)
       .def("prepare_argument", &AnalysisPredictor::PrepareArgument)
@@ -1157,10 +1173,14 @@ void BindPaddleInferPredictor(py::module *m) {
            })
 #endif
       .def("try_shrink_memory", &paddle_infer::Predictor::TryShrinkMemory)
+      .def("update_parameters", &paddle_infer::Predictor::UpdateParameters)
       .def("clear_intermediate_tensor",
            &paddle_infer::Predictor::ClearIntermediateTensor)
       .def("register_output_hook", &paddle_infer::Predictor::RegisterOutputHook)
-      .def("register_input_hook", &paddle_infer::Predictor::RegisterInputHook);
+      .def("register_input_hook", &paddle_infer::Predictor::RegisterInputHook)
+      .def("get_startup_summary", &paddle_infer::Predictor::GetStartupSummary)
+      .def("export_startup_trace",
+           &paddle_infer::Predictor::ExportStartupTrace);
 }
 
 void BindZeroCopyTensor(py::module *m) {
@@ -17,6 +17,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/io/save_load_tensor.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/framework/selected_rows_utils.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/flat_params.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/fluid/pybind/eager_utils.h"
@@ -161,6 +162,27 @@ void BindIO(pybind11::module *m) {
   m->def("load_combine_func", &LoadCombine<phi::IPUPlace>);
   m->def("load_combine_func", &LoadCombine<phi::Place>);
 
+  m->def("save_flat_params_func",
+         &pir::FlatParamsFile::Save,
+         py::arg("x"),
+         py::arg("names"),
+         py::arg("file_path"),
+         py::arg("overwrite") = true);
+  m->def("is_flat_params_file", &pir::FlatParamsFile::Match);
+  // The CPU tensors of all the parameters in the file, in the order of their
+  // data, which point to the mapped file.
+  m->def("load_flat_params_func", [](const std::string &file_path) {
+    pir::FlatParamsFile flat_file(file_path);
+    auto &dev_ctx = *phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+    std::vector<std::pair<std::string, phi::DenseTensor>> tensors;
+    for (const auto &name : flat_file.names()) {
+      phi::DenseTensor tensor;
+      flat_file.Read(name, &tensor, dev_ctx);
+      tensors.emplace_back(name, std::move(tensor));
+    }
+    return tensors;
+  });
+
   m->def("serialize_pir_program",
          &pir::WriteModule,
          py::arg("program"),
@@ -169,6 +191,13 @@ void BindIO(pybind11::module *m) {
          py::arg("overwrite") = true,
          py::arg("readable") = false,
          py::arg("trainable") = true);
+  m->def("serialize_pir_program_binary",
+         &pir::WriteBinaryModule,
+         py::arg("program"),
+         py::arg("file_path"),
+         py::arg("pir_version"),
+         py::arg("overwrite") = true,
+         py::arg("trainable") = true);
   m->def("deserialize_pir_program",
          &pir::ReadModule,
          py::arg("file_path"),
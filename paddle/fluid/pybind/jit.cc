@@ -13,7 +13,13 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "paddle/fluid/pybind/jit.h"
+
+#include <string>
+#include <unordered_map>
+
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/eager/utils.h"
 #include "paddle/fluid/framework/variable.h"
 #include "paddle/fluid/imperative/layer.h"
 #include "paddle/fluid/jit/function.h"
@@ -26,6 +32,9 @@ limitations under the License. */
 #include "paddle/phi/common/place.h"
 #include "paddle/utils/pybind.h"
 
+COMMON_DECLARE_bool(enable_pir_in_executor);
+COMMON_DECLARE_bool(enable_pir_with_pt_in_dy2st);
+
 namespace py = pybind11;
 
 namespace paddle {
@@ -34,6 +43,155 @@ namespace pybind {
 PyTypeObject *g_jit_function_pytype = nullptr;
 using Variable = paddle::framework::Variable;
 
+template <typename T>
+static void AppendGuardValue(std::string *key, T value) {
+  key->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// Appends what the program traced for obj depends on to key: the meta of a
+// tensor, the value of a python scalar and the structure of a container.
+// Returns false for the objects not guarded here, whose calls are left to
+// the CacheKey built in python.
+static bool AppendGuardKey(PyObject *obj, std::string *key) {
+  if (PyCheckTensor(obj)) {
+    const paddle::Tensor &tensor =
+        reinterpret_cast<TensorObject *>(obj)->tensor;
+    if (!tensor.is_dense_tensor()) {
+      return false;
+    }
+    auto *meta = egr::EagerUtils::nullable_autograd_meta(tensor);
+    const phi::DDim &dims = tensor.dims();
+    key->push_back('T');
+    AppendGuardValue(key, static_cast<int>(tensor.dtype()));
+    AppendGuardValue(key, static_cast<int>(tensor.place().GetType()));
+    AppendGuardValue(key, tensor.place().GetDeviceId());
+    AppendGuardValue(key, meta == nullptr || meta->StopGradient());
+    AppendGuardValue(key, dims.size());
+    for (int i = 0; i < dims.size(); ++i) {
+      AppendGuardValue(key, dims[i]);
+    }
+  } else if (obj == Py_None) {
+    key->push_back('N');
+  } else if (PyBool_Check(obj)) {
+    key->push_back(obj == Py_True ? 't' : 'f');
+  } else if (PyLong_CheckExact(obj)) {
+    int overflow = 0;
+    int64_t value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+    if (overflow != 0) {
+      return false;
+    }
+    key->push_back('I');
+    AppendGuardValue(key, value);
+  } else if (PyFloat_CheckExact(obj)) {
+    key->push_back('F');
+    AppendGuardValue(key, PyFloat_AS_DOUBLE(obj));
+  } else if (PyUnicode_CheckExact(obj)) {
+    Py_ssize_t size = 0;
+    const char *data = PyUnicode_AsUTF8AndSize(obj, &size);
+    if (data == nullptr) {
+      PyErr_Clear();
+      return false;
+    }
+    key->push_back('S');
+    AppendGuardValue(key, size);
+    key->append(data, size);
+  } else if (PyTuple_CheckExact(obj) || PyList_CheckExact(obj)) {
+    bool is_tuple = PyTuple_CheckExact(obj);
+    Py_ssize_t size = is_tuple ? PyTuple_GET_SIZE(obj) : PyList_GET_SIZE(obj);
+    key->push_back(is_tuple ? '(' : '[');
+    AppendGuardValue(key, size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+      if (!AppendGuardKey(
+              is_tuple ? PyTuple_GET_ITEM(obj, i) : PyList_GET_ITEM(obj, i),
+              key)) {
+        return false;
+      }
+    }
+  } else if (PyDict_CheckExact(obj)) {
+    key->push_back('{');
+    AppendGuardValue(key, PyDict_Size(obj));
+    PyObject *name = nullptr;
+    PyObject *value = nullptr;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(obj, &pos, &name, &value)) {
+      if (!PyUnicode_CheckExact(name) || !AppendGuardKey(name, key) ||
+          !AppendGuardKey(value, key)) {
+        return false;
+      }
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Maps the arguments a function converted by to_static is called with to
+// the program cached for them. Once the arguments are guarded, a call with
+// the meta seen before finds its program by the key built here instead of
+// turning every argument into an InputSpec and hashing them in python.
+class ProgramGuardCache {
+ public:
+  explicit ProgramGuardCache(size_t capacity) : capacity_(capacity) {}
+
+  py::object Lookup(const py::handle &args,
+                    const py::handle &kwargs,
+                    bool with_hook,
+                    bool is_train) {
+    std::string key;
+    if (MakeKey(args, kwargs, with_hook, is_train, &key)) {
+      auto iter = items_.find(key);
+      if (iter != items_.end()) {
+        ++hits_;
+        return iter->second;
+      }
+    }
+    ++misses_;
+    return py::none();
+  }
+
+  void Insert(const py::handle &args,
+              const py::handle &kwargs,
+              bool with_hook,
+              bool is_train,
+              const py::object &item) {
+    std::string key;
+    if (!MakeKey(args, kwargs, with_hook, is_train, &key)) {
+      return;
+    }
+    // the entries are only a shortcut, a full cache is simply started over
+    if (items_.size() >= capacity_ && items_.count(key) == 0) {
+      items_.clear();
+    }
+    items_[key] = item;
+  }
+
+  void Clear() { items_.clear(); }
+  size_t Size() const { return items_.size(); }
+  int64_t Hits() const { return hits_; }
+  int64_t Misses() const { return misses_; }
+
+ private:
+  static bool MakeKey(const py::handle &args,
+                      const py::handle &kwargs,
+                      bool with_hook,
+                      bool is_train,
+                      std::string *key) {
+    key->push_back(with_hook ? 't' : 'f');
+    key->push_back(is_train ? 't' : 'f');
+    key->push_back(FLAGS_enable_pir_in_executor ||
+                           FLAGS_enable_pir_with_pt_in_dy2st
+                       ? 't'
+                       : 'f');
+    return AppendGuardKey(args.ptr(), key) &&
+           AppendGuardKey(kwargs.ptr(), key);
+  }
+
+  size_t capacity_;
+  std::unordered_map<std::string, py::object> items_;
+  int64_t hits_ = 0;
+  int64_t misses_ = 0;
+};
+
 void BindJit(pybind11::module *m) {
   py::class_<jit::Layer>(*m, "Layer", R"DOC(Layer Class.)DOC")
       .def("function_names", &jit::Layer::FunctionNames)
@@ -57,6 +215,27 @@ void BindJit(pybind11::module *m) {
   m->def("Load", [](const std::string &path, const phi::GPUPlace &cuda_place) {
     return paddle::jit::Load(path, cuda_place);
   });
+
+  py::class_<ProgramGuardCache>(
+      *m, "ProgramGuardCache", R"DOC(ProgramGuardCache Class.)DOC")
+      .def(py::init<size_t>(), py::arg("capacity"))
+      .def("lookup",
+           &ProgramGuardCache::Lookup,
+           py::arg("args"),
+           py::arg("kwargs"),
+           py::arg("with_hook"),
+           py::arg("is_train"))
+      .def("insert",
+           &ProgramGuardCache::Insert,
+           py::arg("args"),
+           py::arg("kwargs"),
+           py::arg("with_hook"),
+           py::arg("is_train"),
+           py::arg("item"))
+      .def("clear", &ProgramGuardCache::Clear)
+      .def("__len__", &ProgramGuardCache::Size)
+      .def_property_readonly("hits", &ProgramGuardCache::Hits)
+      .def_property_readonly("misses", &ProgramGuardCache::Misses);
 }
 
 void BindSot(pybind11::module *m) {
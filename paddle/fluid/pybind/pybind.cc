@@ -13,6 +13,7 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 #include <Python.h>
+#include <frameobject.h>
 #include "paddle/fluid/eager/grad_node_info.h"
 
 // Avoid a problem with copysign defined in pyconfig.h on Windows.
@@ -59,6 +60,7 @@ limitations under the License. */
 #include "paddle/fluid/framework/new_executor/executor_statistics.h"
 #include "paddle/fluid/framework/new_executor/interpreter/job.h"
 #include "paddle/fluid/framework/new_executor/interpreter/plan.h"
+#include "paddle/fluid/framework/new_executor/op_latency_monitor.h"
 #include "paddle/fluid/framework/new_executor/standalone_executor.h"
 #include "paddle/fluid/framework/op_info.h"
 #include "paddle/fluid/framework/op_registry.h"
@@ -82,6 +84,8 @@ limitations under the License. */
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 #include "paddle/phi/core/memory/allocation/auto_growth_best_fit_allocator_v2.h"
 #include "paddle/phi/core/memory/allocation/cuda_ipc_allocator.h"
+#include "paddle/phi/core/memory/allocation/memory_timeline.h"
+#include "paddle/phi/kernels/funcs/fft.h"
 #endif
 #include "paddle/common/macros.h"
 #include "paddle/fluid/operators/activation_op.h"
@@ -89,6 +93,7 @@ limitations under the License. */
 #include "paddle/fluid/operators/py_func_op.h"
 #include "paddle/fluid/platform/enforce.h"
 #include "paddle/fluid/platform/init.h"
+#include "paddle/fluid/platform/profiler/continuous_profiler.h"
 #include "paddle/fluid/platform/profiler/event_python.h"
 #include "paddle/fluid/platform/profiler/profiler.h"
 #include "paddle/fluid/platform/tensorrt/engine_params.h"
@@ -130,6 +135,7 @@ limitations under the License. */
 #include "paddle/phi/core/compat/convert_utils.h"
 #include "paddle/phi/core/lod_utils.h"
 #include "paddle/phi/core/memory/allocation/mmap_allocator.h"
+#include "paddle/phi/core/memory/malloc.h"
 #include "paddle/phi/core/platform/cpu_helper.h"
 #include "paddle/phi/core/platform/device/device_wrapper.h"
 #include "paddle/phi/core/platform/device_context.h"
@@ -721,6 +727,37 @@ static int GetNCCLVersion() {
 }
 #endif
 
+// The Python stack of the calling thread for MemoryTimeline, the innermost
+// frame first. The threads without a Python thread state, e.g. the workers
+// of the executors, have no stack.
+static std::string PythonStackOfThread() {
+  constexpr int kMaxFrames = 64;
+  if (!Py_IsInitialized() || PyGILState_GetThisThreadState() == nullptr) {
+    return "";
+  }
+  // The eager APIs release the GIL while running the kernels.
+  PyGILState_STATE gil_state = PyGILState_Ensure();
+  std::string stack;
+  PyFrameObject *frame = PyEval_GetFrame();
+  Py_XINCREF(frame);
+  for (int i = 0; frame != nullptr && i < kMaxFrames; ++i) {
+    PyCodeObject *code = PyFrame_GetCode(frame);
+    const char *filename = PyUnicode_AsUTF8(code->co_filename);
+    const char *name = PyUnicode_AsUTF8(code->co_name);
+    stack += string::Sprintf("%s:%d in %s\n",
+                             filename ? filename : "?",
+                             PyFrame_GetLineNumber(frame),
+                             name ? name : "?");
+    Py_DECREF(code);
+    PyFrameObject *back = PyFrame_GetBack(frame);
+    Py_DECREF(frame);
+    frame = back;
+  }
+  Py_XDECREF(frame);
+  PyGILState_Release(gil_state);
+  return stack;
+}
+
 // NOTE: Use to manage the context of pylayer op constructing block
 class PyLayerBlockContextManager {
  public:
@@ -1448,7 +1485,7 @@ PYBIND11_MODULE(libpaddle, m) {
   // unloaded. We need manually clear symbols(may contain plugins' symbols)
   // stored in this static instance to avoid illegal memory access.
   m.def("clear_kernel_factory",
-        []() { phi::KernelFactory::Instance().kernels().clear(); });
+        []() { phi::KernelFactory::Instance().mutable_kernels().clear(); });
   m.def("clear_device_manager", []() {
 #ifdef PADDLE_WITH_CUSTOM_DEVICE
     platform::XCCLCommContext::Release();
@@ -2439,6 +2476,20 @@ All parameter, weight, gradient are variables in Paddle.
   m.def("device_memory_stat_peak_value", memory::DeviceMemoryStatPeakValue);
   m.def("host_memory_stat_current_value", memory::HostMemoryStatCurrentValue);
   m.def("host_memory_stat_peak_value", memory::HostMemoryStatPeakValue);
+  m.def("allocator_telemetry", [](const phi::Place &place) {
+    py::list result;
+    for (auto &info : memory::GetAllocatorTelemetry(place)) {
+      py::dict item;
+      item["allocator"] = info.allocator;
+      item["live_bytes"] = info.live_bytes;
+      item["reserved_bytes"] = info.reserved_bytes;
+      item["largest_free_block"] = info.largest_free_block;
+      item["free_block_histogram"] = info.free_block_histogram;
+      item["lifetime_histogram"] = info.lifetime_histogram;
+      result.append(item);
+    }
+    return result;
+  });
   m.def(
       "run_cmd",
       [](const std::string &cmd,
@@ -2727,6 +2778,9 @@ All parameter, weight, gradient are variables in Paddle.
 #endif
 #endif
 
+  m.def("itt_enable_record_event", platform::IttEnableRecordEvent);
+  m.def("itt_disable_record_event", platform::IttDisableRecordEvent);
+
 #ifdef PADDLE_WITH_IPU
   m.def("get_ipu_device_count", platform::GetIPUDeviceCount);
 #endif
@@ -2941,11 +2995,145 @@ All parameter, weight, gradient are variables in Paddle.
           },
           py::return_value_policy::automatic_reference);
 
+  m.def("_start_host_event_dump", platform::StartHostEventDump);
+  m.def("_stop_host_event_dump", platform::StopHostEventDump);
+
   py::class_<paddle::platform::ProfilerOptions>(m, "ProfilerOptions")
       .def(py::init<>())
       .def_readwrite("trace_switch",
                      &paddle::platform::ProfilerOptions::trace_switch);
 
+  py::class_<paddle::platform::ContinuousProfilerOptions>(
+      m, "_ContinuousProfilerOptions")
+      .def(py::init<>())
+      .def_readwrite(
+          "trace_switch",
+          &paddle::platform::ContinuousProfilerOptions::trace_switch)
+      .def_readwrite(
+          "sample_interval",
+          &paddle::platform::ContinuousProfilerOptions::sample_interval)
+      .def_readwrite(
+          "max_host_events",
+          &paddle::platform::ContinuousProfilerOptions::max_host_events)
+      .def_readwrite(
+          "max_counters",
+          &paddle::platform::ContinuousProfilerOptions::max_counters);
+
+  m.def("_enable_continuous_profiler",
+        [](const paddle::platform::ContinuousProfilerOptions &options) {
+          paddle::platform::ContinuousProfiler::Instance().Enable(options);
+        });
+  m.def("_disable_continuous_profiler", []() {
+    pybind11::gil_scoped_release release;
+    paddle::platform::ContinuousProfiler::Instance().Disable();
+  });
+  m.def("_continuous_profiler_step", []() {
+    pybind11::gil_scoped_release release;
+    paddle::platform::ContinuousProfiler::Instance().Step();
+  });
+  m.def("_reset_continuous_profiler", []() {
+    paddle::platform::ContinuousProfiler::Instance().Reset();
+  });
+  m.def("_get_continuous_profiler_aggregates", []() {
+    auto aggregates =
+        paddle::platform::ContinuousProfiler::Instance().GetAggregates();
+    auto to_dict =
+        [](const std::map<std::string, paddle::platform::EventCounter>
+               &counters) {
+          py::dict result;
+          for (const auto &item : counters) {
+            py::dict counter;
+            counter["calls"] = item.second.calls;
+            counter["total_ns"] = item.second.total_ns;
+            counter["min_ns"] = item.second.min_ns;
+            counter["max_ns"] = item.second.max_ns;
+            result[py::str(item.first)] = counter;
+          }
+          return result;
+        };
+    py::dict result;
+    result["steps"] = aggregates.steps;
+    result["sampled_steps"] = aggregates.sampled_steps;
+    result["sampled_ns"] = aggregates.sampled_ns;
+    result["dropped_host_events"] = aggregates.dropped_host_events;
+    result["host_events"] = to_dict(aggregates.host_events);
+    result["device_events"] = to_dict(aggregates.device_events);
+    result["device_event_types"] = to_dict(aggregates.device_event_types);
+    return result;
+  });
+  m.def("_get_continuous_profiler_host_events", []() {
+    py::list result;
+    for (const auto &event :
+         paddle::platform::ContinuousProfiler::Instance()
+             .GetRecentHostEvents()) {
+      py::dict item;
+      item["name"] = event.name;
+      item["type"] = paddle::platform::StringTracerEventType(event.type);
+      item["start_ns"] = event.start_ns;
+      item["end_ns"] = event.end_ns;
+      item["process_id"] = event.process_id;
+      item["thread_id"] = event.thread_id;
+      result.append(item);
+    }
+    return result;
+  });
+
+  m.def(
+      "_start_memory_timeline",
+      [](size_t max_events, bool record_stack) {
+        static std::once_flag set_stack_provider;
+        std::call_once(set_stack_provider, []() {
+          memory::allocation::MemoryTimeline::Instance().SetStackProvider(
+              PythonStackOfThread);
+        });
+        memory::allocation::MemoryTimeline::Instance().Start(max_events,
+                                                             record_stack);
+      },
+      py::arg("max_events"),
+      py::arg("record_stack"));
+  m.def("_stop_memory_timeline",
+        []() { memory::allocation::MemoryTimeline::Instance().Stop(); });
+  m.def("_get_memory_timeline", []() {
+    auto &timeline = memory::allocation::MemoryTimeline::Instance();
+    // The events are tuples, a long timeline has millions of them.
+    py::list events;
+    for (const auto &event : timeline.GetEvents()) {
+      events.append(py::make_tuple(
+          event.time_ns,
+          reinterpret_cast<uintptr_t>(event.ptr),
+          event.size,
+          event.place.DebugString(),
+          paddle::platform::StringTracerMemEventType(event.type),
+          event.op,
+          event.stack));
+    }
+    py::list peaks;
+    for (const auto &peak : timeline.GetPeaks()) {
+      py::list holders;
+      for (const auto &holder : peak.holders) {
+        py::dict item;
+        item["op"] = holder.op;
+        item["stack"] = holder.stack;
+        item["bytes"] = holder.bytes;
+        item["count"] = holder.count;
+        holders.append(item);
+      }
+      py::dict item;
+      item["place"] = peak.place.DebugString();
+      item["peak_allocated"] = peak.peak_allocated;
+      item["peak_time_ns"] = peak.peak_time_ns;
+      item["peak_reserved"] = peak.peak_reserved;
+      item["holders"] = holders;
+      peaks.append(item);
+    }
+    py::dict result;
+    result["names"] = timeline.GetNames();
+    result["events"] = events;
+    result["peaks"] = peaks;
+    result["dropped_events"] = timeline.DroppedEvents();
+    return result;
+  });
+
   py::class_<phi::RecordEvent>(m, "_RecordEvent")
       .def(py::init([](std::string name, phi::TracerEventType type) {
         return std::make_unique<phi::RecordEvent>(
@@ -3198,6 +3386,19 @@ All parameter, weight, gradient are variables in Paddle.
     return res;
   });
 
+  m.def("save_autotune_cache", [](const std::string &path) {
+    phi::autotune::AutoTuneCache::Instance().Save(path);
+  });
+
+  m.def("load_autotune_cache", [](const std::string &path) {
+    return phi::autotune::AutoTuneCache::Instance().Load(path);
+  });
+
+  m.def("merge_autotune_cache_files",
+        &phi::autotune::MergeAutoTuneCacheFiles,
+        py::arg("inputs"),
+        py::arg("output"));
+
   m.def("enable_layout_autotune",
         [] { return egr::Controller::Instance().EnableLayoutAutoTune(); });
 
@@ -3214,6 +3415,38 @@ All parameter, weight, gradient are variables in Paddle.
   m.def("set_nan_inf_debug_path",
         &paddle::framework::details::SetNanInfDebugPath);
 
+  // Add the api to fetch the counts of FLAGS_check_nan_inf_async
+  m.def("get_nan_inf_count", &phi::funcs::FetchNanInfCount);
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // Add the api to inspect and warm up the cuFFT plan cache of a device
+  m.def("get_fft_plan_cache_info", [](int64_t device_id) {
+    auto info = phi::funcs::GetFFTPlanCacheInfo(device_id);
+    py::dict result;
+    result["size"] = info.size;
+    result["max_size"] = info.max_size;
+    result["hits"] = info.hits;
+    result["misses"] = info.misses;
+    return result;
+  });
+  m.def("set_fft_plan_cache_max_size", &phi::funcs::SetFFTPlanCacheMaxSize);
+  m.def("clear_fft_plan_cache", &phi::funcs::ClearFFTPlanCache);
+  m.def("warmup_fft_plan_cache",
+        [](int64_t device_id,
+           const std::vector<int64_t> &x_shape,
+           const std::vector<int64_t> &out_shape,
+           const std::vector<int64_t> &axes,
+           const std::string &x_dtype,
+           const std::string &out_dtype) {
+          phi::funcs::WarmupFFTPlanCache(device_id,
+                                         x_shape,
+                                         out_shape,
+                                         axes,
+                                         phi::StringToDataType(x_dtype),
+                                         phi::StringToDataType(out_dtype));
+        });
+#endif
+
   // Add check op lost
   m.def("set_checked_op_list",
         [](const std::string &op_list) { egr::SetCheckOpList(op_list); });
@@ -3293,6 +3526,31 @@ All parameter, weight, gradient are variables in Paddle.
           return res;
         });
 
+  m.def(
+      "get_pir_op_latency",
+      [](size_t top_n, bool by_device) -> py::list {
+        py::list result;
+        for (auto &summary :
+             paddle::framework::OpLatencyMonitor::Instance().GetSlowOps(
+                 top_n, by_device)) {
+          py::dict item;
+          item["op_name"] = summary.op_name;
+          item["host_count"] = summary.host_count;
+          item["host_p50_us"] = summary.host_p50_us;
+          item["host_p99_us"] = summary.host_p99_us;
+          item["device_count"] = summary.device_count;
+          item["device_p50_us"] = summary.device_p50_us;
+          item["device_p99_us"] = summary.device_p99_us;
+          result.append(item);
+        }
+        return result;
+      },
+      py::arg("top_n") = 10,
+      py::arg("by_device") = false);
+  m.def("reset_pir_op_latency", []() {
+    paddle::framework::OpLatencyMonitor::Instance().Reset();
+  });
+
 #if defined(PADDLE_WITH_PSLIB) && !defined(PADDLE_WITH_HETERPS)
   BindHeterWrapper(&m);
   BindMetrics(&m);
@@ -44,13 +44,17 @@ void BindFuture(py::module* m) {
 void InitAndSetAgentInstance(py::module* m) {
   m->def(
       "init_and_set_agent_instance",
-      [](const std::string& name, const std::vector<WorkerInfo>& infos) {
-        auto instance = std::make_shared<RpcAgent>(name, infos);
+      [](const std::string& name,
+         const std::vector<WorkerInfo>& infos,
+         size_t max_batch_size) {
+        auto instance =
+            std::make_shared<RpcAgent>(name, infos, max_batch_size);
         instance->SetAgentInstance(instance);
       },
       py::call_guard<py::gil_scoped_release>(),
       py::arg("name"),
-      py::arg("infos"));
+      py::arg("infos"),
+      py::arg("max_batch_size") = 1);
 }
 void InvokeRpc(py::module* m) {
   m->def(
@@ -64,6 +68,22 @@ void InvokeRpc(py::module* m) {
       py::arg("to"),
       py::arg("py_func"),
       py::arg("timeout_ms"));
+  m->def(
+      "invoke_rpc_function",
+      [](const std::string& name,
+         const std::string& function,
+         const std::string& message,
+         int timeout_ms) {
+        auto instance = RpcAgent::RpcAgentInstance();
+        return std::make_shared<FutureWrapper>(
+            instance->InvokeRpcFunction(function, message, name, timeout_ms),
+            /*raw=*/true);
+      },
+      py::call_guard<py::gil_scoped_release>(),
+      py::arg("to"),
+      py::arg("function"),
+      py::arg("message"),
+      py::arg("timeout_ms"));
 }
 void StartWorker(py::module* m) {
   m->def(
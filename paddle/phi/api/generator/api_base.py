@@ -1255,6 +1255,23 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
     def gene_return_code(self):
         return "return api_output;"
 
+    # Override by child class
+    def can_launch_kernel_async(self, kernel_dispatch, inplace_flag):
+        # The kernel call is queued with copies of its arguments, which holds
+        # the dense inputs and the api_output, see AsyncKernelLauncher.
+        if inplace_flag or self.view_map:
+            return False
+        if kernel_dispatch and any(
+            tensor_type != 'dense'
+            for tensor_type in kernel_dispatch[0] + kernel_dispatch[1]
+        ):
+            return False
+        return all(
+            input_type
+            in ['const Tensor&', 'const paddle::optional<Tensor>&']
+            for input_type in self.inputs['input_info'].values()
+        ) and all(out_type == 'Tensor' for out_type in self.outputs['types'])
+
     # Override by child class
     def gene_output(
         self,
@@ -1322,10 +1339,33 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
 {code_indent}      auto target_ptr = static_cast<phi::DenseTensor*>({target_input}.at(i).impl().get());
 {code_indent}      *target_ptr = *{kernel_out}.at(i);
 {code_indent}    }}"""
+        launch_async = self.can_launch_kernel_async(
+            kernel_dispatch, inplace_flag
+        )
+        kernel_call = f"(*kernel_fn)({kernel_args}, {', '.join(outputs_args)});"
+        if launch_async:
+            wait_arg = ", /*wait_async_kernels=*/false"
+            kernel_call_code = f"""
+{code_indent}  auto& async_launcher = AsyncKernelLauncher::Instance();
+{code_indent}  if (async_launcher.PrepareLaunch(kernel_result, dev_ctx, {{{', '.join(outputs_args)}}})) {{
+{code_indent}    async_launcher.Launch(dev_ctx->GetPlace(), [=, api_output = api_output]() {{
+{code_indent}      paddle::memory::allocation::MemoryTimelineOpScope memory_timeline_op("{self.api}");
+{code_indent}      {kernel_call}
+{code_indent}    }});
+{code_indent}  }} else {{
+{code_indent}    async_launcher.Wait();
+{code_indent}    {kernel_call}
+{code_indent}  }}"""
+        else:
+            wait_arg = ""
+            kernel_call_code = f"""
+{code_indent}    {kernel_call}"""
         return f"""
 {code_indent}  VLOG(6) << "{self.api} API kernel key: [" << kernel_backend << ", " << kernel_layout << ", "<< kernel_data_type << "]";
-{code_indent}  auto kernel_result = phi::KernelFactory::Instance().SelectKernelOrThrowError(
-{code_indent}      "{kernel_name}", {{kernel_backend, kernel_layout, kernel_data_type}}, true);
+{code_indent}  paddle::memory::allocation::MemoryTimelineOpScope memory_timeline_op("{self.api}");
+{code_indent}  static thread_local phi::KernelHandle kernel_handle("{kernel_name}");
+{code_indent}  auto kernel_result = kernel_handle.Select(
+{code_indent}      {{kernel_backend, kernel_layout, kernel_data_type}}, true);
 {code_indent}  const auto& kernel = kernel_result.kernel;
 {code_indent}  if (FLAGS_low_precision_op_list) {{
 {code_indent}    phi::KernelFactory::Instance().AddToLowPrecisionKernelList("{self.api}", kernel_data_type);
@@ -1333,7 +1373,7 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
 {code_indent}  VLOG(6) << "{kernel_name} kernel: " << kernel;
 {code_indent}  // add actual_kernel_backend to select actual kernel backend after a potential falling-back to CPU
 {code_indent}  Backend actual_kernel_backend = kernel_result.has_fallback_cpu ? Backend::CPU : kernel_backend;
-{code_indent}  auto* dev_ctx = GetDeviceContextByBackend(actual_kernel_backend);
+{code_indent}  auto* dev_ctx = GetDeviceContextByBackend(actual_kernel_backend{wait_arg});
 {input_tensors}
 {output_create}
 {pre_save_stride}
@@ -1351,7 +1391,7 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
 {code_indent}  if(phi::RecordEvent::IsEnabled()){{
 {code_indent}    kernel_record_event = new phi::RecordEvent(\"{kernel_name} kernel launch\", phi::TracerEventType::DygraphKernelLaunch, 1);
 {code_indent}  }}
-{code_indent}    (*kernel_fn)({kernel_args}, {", ".join(outputs_args)});
+{kernel_call_code}
 {code_indent}  if (FLAGS_benchmark) {{
 {code_indent}      dev_ctx->Wait();
 {code_indent}      std::cout << \"{kernel_name} kernel run finish.\" << std::endl;
@@ -1363,7 +1403,7 @@ PADDLE_API {self.get_return_type(inplace_flag=True)} {api_func_name}({self.get_d
 {fallback_kernel_output_trans}
 {self.reset_view_after_fallback(self.outputs['types'], code_indent, inplace_flag)}
 {code_indent}  }}
-{code_indent}  dev_ctx = GetDeviceContextByBackend(kernel_backend);
+{code_indent}  dev_ctx = GetDeviceContextByBackend(kernel_backend{wait_arg});
 {transdata2strided}
 {code_indent}  {self.gene_return_code()}"""
 
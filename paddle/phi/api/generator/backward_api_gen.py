@@ -111,6 +111,10 @@ class BackwardAPI(BaseAPI):
     def gene_return_code(self):
         return ""
 
+    def can_launch_kernel_async(self, kernel_dispatch, inplace_flag):
+        # the outputs are owned by the caller
+        return False
+
     def gene_api_declaration(self):
         if not self.is_base_api and not self.is_only_composite_api:
             invoke_func_name = self.invoke.split('(')[0]
@@ -287,6 +291,7 @@ def source_include(header_file_path, fw_header_file_path):
 #include "paddle/phi/infermeta/fusion.h"
 
 #include "paddle/phi/api/profiler/event_tracing.h"
+#include "paddle/phi/core/memory/allocation/memory_timeline.h"
 #include "paddle/phi/api/profiler/supplement_tracing.h"
 
 PD_DECLARE_bool(conv2d_disable_cudnn);
@@ -99,12 +99,16 @@ OPTIONAL_VECTOR_DIST_META_IN_TEMPLATE = """
         }}
     }}"""
 INFER_SPMD_TEMPLATE = """
-    auto spmd_info = phi::distributed::{}({});
-    DebugInfoForInferSpmd("{}", spmd_info);
+    auto spmd_info = phi::distributed::CachedInferSpmd("{0}", [&]() {{
+      return phi::distributed::{0}({1});
+    }}, {1});
+    DebugInfoForInferSpmd("{2}", spmd_info);
 """
 GENERAL_INFER_SPMD_TEMPLATE = """
-    auto spmd_info = phi::distributed::VariadicReplicatedInferSpmdDynamic({});
-    DebugInfoForInferSpmd("{}", spmd_info);
+    auto spmd_info = phi::distributed::CachedInferSpmd("VariadicReplicatedInferSpmdDynamic", [&]() {{
+      return phi::distributed::VariadicReplicatedInferSpmdDynamic({0});
+    }}, {0});
+    DebugInfoForInferSpmd("{1}", spmd_info);
 """
 UNSUPPORTED_INFER_SPMD_COMMENT_TEMPLATE = """
     // API `{}` does not support InferSpmd now
@@ -515,10 +515,12 @@ def source_include(header_file_path, fw_header_file_path):
 #include "paddle/phi/infermeta/fusion.h"
 
 #include "paddle/phi/api/profiler/event_tracing.h"
+#include "paddle/phi/core/memory/allocation/memory_timeline.h"
 #include "paddle/phi/api/profiler/supplement_tracing.h"
 
 #ifdef PADDLE_WITH_DISTRIBUTE
 #include "paddle/phi/infermeta/spmd_rules/rules.h"
+#include "paddle/phi/core/distributed/auto_parallel/inferspmd_cache.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_utils.h"
 #endif
 
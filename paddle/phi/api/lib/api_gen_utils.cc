@@ -38,7 +38,7 @@ std::shared_ptr<phi::DenseTensor> TensorToDenseTensor(const Tensor& tensor) {
 paddle::optional<phi::DenseTensor> TensorToDenseTensor(
     const paddle::optional<Tensor>& tensor) {
   if (tensor) {
-    return {*std::static_pointer_cast<phi::DenseTensor>(tensor->impl())};
+    return {*static_cast<phi::DenseTensor*>(tensor->impl().get())};
   }
   return nullptr;
 }
@@ -49,8 +49,7 @@ std::unique_ptr<std::vector<phi::DenseTensor*>> TensorToDenseTensor(
   pt_tensors->reserve(tensors.size());
 
   for (const auto& t : tensors) {
-    pt_tensors->push_back(
-        std::dynamic_pointer_cast<phi::DenseTensor>(t.impl()).get());
+    pt_tensors->push_back(dynamic_cast<phi::DenseTensor*>(t.impl().get()));
   }
 
   return pt_tensors;
@@ -91,7 +90,7 @@ std::shared_ptr<phi::SelectedRows> TensorToSelectedRows(const Tensor& tensor) {
 paddle::optional<phi::SelectedRows> TensorToSelectedRows(
     const paddle::optional<Tensor>& tensor) {
   if (tensor) {
-    return {*std::static_pointer_cast<phi::SelectedRows>(tensor->impl())};
+    return {*static_cast<phi::SelectedRows*>(tensor->impl().get())};
   }
   return nullptr;
 }
@@ -0,0 +1,164 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
+
+#include "glog/logging.h"
+
+#include "paddle/common/ddim.h"
+#include "paddle/common/flags.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#endif
+
+COMMON_DECLARE_bool(eager_async_kernel_launch);
+COMMON_DECLARE_bool(benchmark);
+
+namespace paddle::experimental {
+
+namespace {
+
+// The calling thread blocks beyond it, which bounds the memory of the
+// outputs allocated ahead of their kernels.
+constexpr size_t kMaxQueuedKernels = 1024;
+
+thread_local int suspend_depth = 0;
+
+}  // namespace
+
+AsyncKernelLauncher& AsyncKernelLauncher::Instance() {
+  // Never destroyed, the launcher thread runs until the process exits.
+  static auto* launcher = new AsyncKernelLauncher();
+  return *launcher;
+}
+
+bool AsyncKernelLauncher::PrepareLaunch(
+    const phi::KernelResult& kernel_result,
+    const phi::DeviceContext* dev_ctx,
+    const std::vector<phi::DenseTensor*>& outs) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (!FLAGS_eager_async_kernel_launch || FLAGS_benchmark ||
+      suspend_depth > 0 || kernel_result.has_fallback_cpu ||
+      kernel_result.is_stride_kernel ||
+      dev_ctx->GetPlace().GetType() != phi::AllocationType::GPU) {
+    return false;
+  }
+  std::call_once(start_flag_, [this] {
+    owner_id_ = std::this_thread::get_id();
+    launcher_ = std::thread(&AsyncKernelLauncher::LaunchLoop, this);
+  });
+  // Only the first thread launching asynchronously does it, the others
+  // would not see the kernels of each other in order.
+  if (std::this_thread::get_id() != owner_id_) {
+    return false;
+  }
+  for (const auto& arg_def : kernel_result.kernel.args_def().output_defs()) {
+    // The kernel allocates the output on the host, e.g. shape.
+    if (arg_def.backend == phi::Backend::CPU) {
+      return false;
+    }
+  }
+  for (auto* out : outs) {
+    // The shape of the output depends on the data, e.g. nonzero.
+    if (out && (out->dtype() == phi::DataType::UNDEFINED ||
+                common::contain_unknown_dim(out->dims()))) {
+      return false;
+    }
+  }
+  for (auto* out : outs) {
+    if (out) {
+      dev_ctx->Alloc(out, out->dtype());
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AsyncKernelLauncher::Launch(const phi::Place& place,
+                                 std::function<void()> kernel_call) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_full_.wait(lock, [this] { return queue_.size() < kMaxQueuedKernels; });
+  queue_.push_back(Task{place, std::move(kernel_call)});
+  ++pending_;
+  not_empty_.notify_one();
+}
+
+void AsyncKernelLauncher::Wait() {
+  if (pending_ == 0 && !has_error_) {
+    return;
+  }
+  // A kernel calling a C++ API on the launcher thread
+  if (std::this_thread::get_id() == launcher_.get_id()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return pending_ == 0; });
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    has_error_ = false;
+    std::rethrow_exception(error);
+  }
+}
+
+void AsyncKernelLauncher::LaunchLoop() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return !queue_.empty(); });
+      task = std::move(queue_.front());
+      queue_.pop_front();
+      not_full_.notify_one();
+    }
+    // The kernels queued after a failed one are dropped, Wait rethrows the
+    // error on the calling thread.
+    if (!has_error_) {
+      try {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+        if (phi::backends::gpu::GetCurrentDeviceId() !=
+            task.place.GetDeviceId()) {
+          phi::backends::gpu::SetDeviceId(task.place.GetDeviceId());
+        }
+#endif
+        task.kernel_call();
+      } catch (...) {
+        VLOG(3) << "The kernel launched asynchronously on " << task.place
+                << " failed.";
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = std::current_exception();
+        has_error_ = true;
+      }
+    }
+    // Releases the tensors of the kernel before it counts as done.
+    task.kernel_call = nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) {
+      idle_.notify_all();
+    }
+  }
+}
+
+AsyncKernelLaunchSuspendGuard::AsyncKernelLaunchSuspendGuard() {
+  AsyncKernelLauncher::Instance().Wait();
+  ++suspend_depth;
+}
+
+AsyncKernelLaunchSuspendGuard::~AsyncKernelLaunchSuspendGuard() {
+  --suspend_depth;
+}
+
+}  // namespace paddle::experimental
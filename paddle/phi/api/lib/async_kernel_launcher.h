@@ -0,0 +1,97 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/device_context.h"
+#include "paddle/phi/core/kernel_factory.h"
+
+namespace paddle {
+namespace experimental {
+
+// With FLAGS_eager_async_kernel_launch, the generated C++ APIs infer the
+// shapes and allocate the outputs of a GPU kernel on the calling thread, and
+// leave the kernel call to a launcher thread, so that the host work of the
+// next ops overlaps the launch of this one.
+//
+// Only the APIs whose inputs and outputs are plain dense tensors, and not
+// inplace or views, are launched this way, once InferMeta has given all the
+// output shapes. Everything else in the API layer waits for the queued
+// kernels first (GetDeviceContextByBackend, data transforms, copies), which
+// keeps the order of the kernels on the stream. Code issuing device work or
+// reading tensor data outside of the API layer must call Wait() too.
+class AsyncKernelLauncher {
+ public:
+  static AsyncKernelLauncher& Instance();
+
+  // Returns whether the kernel writing outs may be called by Launch, in
+  // which case the outputs are allocated here.
+  bool PrepareLaunch(const phi::KernelResult& kernel_result,
+                     const phi::DeviceContext* dev_ctx,
+                     const std::vector<phi::DenseTensor*>& outs);
+
+  // Queues the kernel call, which holds the tensors it reads and writes.
+  void Launch(const phi::Place& place, std::function<void()> kernel_call);
+
+  // Waits until the queued kernels are called, and rethrows the first error
+  // one of them raised.
+  void Wait();
+
+ private:
+  struct Task {
+    phi::Place place;
+    std::function<void()> kernel_call;
+  };
+
+  AsyncKernelLauncher() = default;
+
+  void LaunchLoop();
+
+  std::once_flag start_flag_;
+  std::thread::id owner_id_;
+  std::thread launcher_;
+
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::condition_variable idle_;
+  std::deque<Task> queue_;
+  // queued or running
+  std::atomic<size_t> pending_{0};
+  std::atomic<bool> has_error_{false};
+  std::exception_ptr error_;
+};
+
+// Waits for the queued kernels and keeps the kernels of the current thread
+// from being launched asynchronously in its scope, e.g. in a backward which
+// also sums grads with kernels called outside of the API layer.
+class AsyncKernelLaunchSuspendGuard {
+ public:
+  AsyncKernelLaunchSuspendGuard();
+  ~AsyncKernelLaunchSuspendGuard();
+};
+
+}  // namespace experimental
+}  // namespace paddle
@@ -19,6 +19,7 @@ limitations under the License. */
 #include "glog/logging.h"
 
 #include "paddle/common/flags.h"
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/api/lib/kernel_dispatch.h"
 #include "paddle/phi/api/lib/utils/allocator.h"
 #include "paddle/phi/backends/context_pool.h"
@@ -238,6 +239,7 @@ phi::DenseTensor TensorContiguous(const Context& dev_ctx,
 }
 
 phi::DenseTensor Trans2Contiguous(const phi::DenseTensor& tensor) {
+  AsyncKernelLauncher::Instance().Wait();
   auto& pool = phi::DeviceContextPool::Instance();
 
   VLOG(3) << "Trans2Contiguous...";
@@ -313,6 +315,8 @@ phi::DenseTensor TransformData(const phi::DenseTensor& tensor,
                                const phi::TensorArgDef& target_args_def,
                                const TransformFlag& transform_flag,
                                bool is_stride_kernel) {
+  // The transforms run on the calling thread, after the kernels queued.
+  AsyncKernelLauncher::Instance().Wait();
   phi::DenseTensor out = tensor;
   bool trans_layout = false;
   bool trans_dtype = false;
@@ -382,9 +386,8 @@ std::shared_ptr<phi::DenseTensor> PrepareData(
       if (NeedTransform2Contiguous(is_stride_kernel,
                                    dense_tensor.meta().is_contiguous()) &&
           dense_tensor.initialized()) {
-        phi::DenseTensor out = dense_tensor;
-        out = Trans2Contiguous(out);
-        return std::make_shared<phi::DenseTensor>(std::move(out));
+        return std::make_shared<phi::DenseTensor>(
+            Trans2Contiguous(dense_tensor));
       }
       return std::static_pointer_cast<phi::DenseTensor>(tensor_in);
     }
@@ -417,7 +420,9 @@ std::unique_ptr<std::vector<phi::DenseTensor>> PrepareData(
 
   for (const auto& input : inputs) {
     const auto& tensor_in = input.impl();
-    auto dense_tensor = std::dynamic_pointer_cast<phi::DenseTensor>(tensor_in);
+    // A raw pointer, the inputs are kept alive by the caller and copying the
+    // shared_ptr of each of them costs two atomic operations.
+    auto* dense_tensor = dynamic_cast<phi::DenseTensor*>(tensor_in.get());
     if (!transform_flag.NeedTransform() || !tensor_in->initialized() ||
         (!NeedTransformPlace(
              tensor_in->place(), target_args_def.backend, transform_flag) &&
@@ -433,13 +438,9 @@ std::unique_ptr<std::vector<phi::DenseTensor>> PrepareData(
       if (NeedTransform2Contiguous(is_stride_kernel,
                                    dense_tensor->meta().is_contiguous()) &&
           tensor_in->initialized()) {
-        phi::DenseTensor out =
-            *(static_cast<phi::DenseTensor*>(tensor_in.get()));
-        out = Trans2Contiguous(out);
-        pt_tensors->emplace_back(out);
+        pt_tensors->emplace_back(Trans2Contiguous(*dense_tensor));
       } else {
-        pt_tensors->emplace_back(
-            *std::dynamic_pointer_cast<phi::DenseTensor>(tensor_in));
+        pt_tensors->emplace_back(*dense_tensor);
       }
     } else {
       pt_tensors->emplace_back(
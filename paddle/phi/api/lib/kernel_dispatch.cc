@@ -18,6 +18,7 @@ limitations under the License. */
 #endif
 
 #include "paddle/phi/api/include/context_pool.h"
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/core/compat/convert_utils.h"
 #include "paddle/phi/core/distributed/auto_parallel/dist_tensor.h"
 #include "paddle/phi/core/string_tensor_utils.h"
@@ -110,7 +111,11 @@ std::size_t CountLeadingZeros(uint32_t val) {
 }  // namespace paddle::experimental::detail
 namespace paddle::experimental {
 
-phi::DeviceContext* GetDeviceContextByBackend(phi::Backend backend) {
+phi::DeviceContext* GetDeviceContextByBackend(phi::Backend backend,
+                                              bool wait_async_kernels) {
+  if (wait_async_kernels) {
+    AsyncKernelLauncher::Instance().Wait();
+  }
   auto& pool = paddle::experimental::DeviceContextPool::Instance();
   return pool.GetMutable(phi::TransToPhiPlace(backend));
 }
@@ -40,7 +40,10 @@ BackendSet GetTensorBackendSet(const phi::TensorBase& t);
 std::size_t CountLeadingZeros(uint32_t val);
 }  // namespace detail
 
-phi::DeviceContext* GetDeviceContextByBackend(phi::Backend backend);
+// Also waits for the kernels launched asynchronously, unless
+// wait_async_kernels is false, see AsyncKernelLauncher.
+phi::DeviceContext* GetDeviceContextByBackend(phi::Backend backend,
+                                              bool wait_async_kernels = true);
 
 enum class KernelType {
   DENSE_TENSOR_KERNEL,   // kernel for DenseTensor
@@ -18,6 +18,7 @@ limitations under the License. */
 
 #include "paddle/phi/api/include/context_pool.h"
 #include "paddle/phi/api/lib/api_gen_utils.h"
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/api/lib/kernel_dispatch.h"
 #include "paddle/phi/core/compat/convert_utils.h"
 #include "paddle/phi/core/kernel_registry.h"
@@ -33,6 +34,7 @@ namespace paddle {
 namespace experimental {
 
 void copy(const Tensor& src, const Place& place, bool blocking, Tensor* dst) {
+  AsyncKernelLauncher::Instance().Wait();
   auto kernel_key_set = ParseKernelKeyByInputArgs(src);
   kernel_key_set.backend_set =
       kernel_key_set.backend_set | BackendSet(phi::TransToPhiBackend(place));
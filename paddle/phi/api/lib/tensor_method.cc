@@ -23,6 +23,7 @@ limitations under the License. */
 #include "paddle/phi/api/include/context_pool.h"
 #include "paddle/phi/api/include/sparse_api.h"
 #include "paddle/phi/api/lib/api_gen_utils.h"
+#include "paddle/phi/api/lib/async_kernel_launcher.h"
 #include "paddle/phi/api/lib/kernel_dispatch.h"
 #include "paddle/phi/core/tensor_utils.h"
 #include "paddle/phi/infermeta/unary.h"
@@ -132,6 +133,7 @@ void Tensor::copy_(const Tensor &src,
                                BackendSet(phi::TransToPhiBackend(target_place));
   auto kernel_key = kernel_key_set.GetHighestPriorityKernelKey();
   auto place = phi::TransToPhiPlace(kernel_key.backend());
+  paddle::experimental::AsyncKernelLauncher::Instance().Wait();
   auto &pool = paddle::experimental::DeviceContextPool::Instance();
   auto *dev_ctx = pool.GetMutable(
       place.GetType() == target_place.GetType() ? target_place : place);
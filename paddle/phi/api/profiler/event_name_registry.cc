@@ -0,0 +1,48 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/api/profiler/event_name_registry.h"
+
+#include <unordered_map>
+
+namespace phi {
+
+EventNameRegistry& EventNameRegistry::Instance() {
+  static EventNameRegistry registry;
+  return registry;
+}
+
+const char* EventNameRegistry::Intern(const std::string& name) {
+  thread_local std::unordered_map<std::string, const char*> cache;
+  auto it = cache.find(name);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  const char* interned = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(mtx_);
+    auto found = names_.find(name);
+    if (found != names_.end()) {
+      interned = found->c_str();
+    } else if (names_.size() < kMaxNames) {
+      interned = names_.insert(name).first->c_str();
+    }
+  }
+  if (interned != nullptr) {
+    cache.emplace(name, interned);
+  }
+  return interned;
+}
+
+}  // namespace phi
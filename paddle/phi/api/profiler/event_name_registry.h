@@ -0,0 +1,48 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "paddle/utils/test_macros.h"
+
+namespace phi {
+
+// Interns the names of the host events. An event named by a std::string
+// then records the interned name, as an event named by a string literal,
+// instead of copying its name to the heap and to the event arena, which
+// contends on the allocator when many threads record.
+// The interned names are never freed, so at most kMaxNames are interned;
+// past that, Intern returns nullptr and the caller copies the name.
+class TEST_API EventNameRegistry {
+ public:
+  static constexpr size_t kMaxNames = 1 << 16;
+
+  static EventNameRegistry& Instance();
+
+  // thread-safe, and lock-free for the names the thread interned before.
+  const char* Intern(const std::string& name);
+
+ private:
+  EventNameRegistry() = default;
+
+  std::mutex mtx_;
+  // The elements of a node-based set keep their address on rehash.
+  std::unordered_set<std::string> names_;
+};
+
+}  // namespace phi
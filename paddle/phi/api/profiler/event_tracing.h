@@ -14,6 +14,7 @@ limitations under the License. */
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "paddle/phi/api/profiler/event.h"
@@ -80,7 +81,8 @@ class TEST_API RecordEvent {
                          const std::string& attr);
 
   bool is_enabled_{false};
-  bool is_pushed_{false};
+  // The external ranges pushed, NVTX or ITT, to be popped by End.
+  uint8_t pushed_ranges_{0};
   // Event name
   std::string* name_{nullptr};
   const char* shallow_copy_name_{nullptr};
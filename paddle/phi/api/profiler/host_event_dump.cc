@@ -0,0 +1,130 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/api/profiler/host_event_dump.h"
+
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/phi/core/enforce.h"
+
+namespace phi {
+
+namespace {
+
+class StringTable {
+ public:
+  uint32_t Id(const char* str) {
+    if (str == nullptr) {
+      return kHostEventDumpNoString;
+    }
+    // The interned names are looked up by address, the others by content.
+    auto it = by_address_.find(str);
+    if (it != by_address_.end()) {
+      return it->second;
+    }
+    std::string_view view(str);
+    auto found = by_content_.find(view);
+    uint32_t id = 0;
+    if (found != by_content_.end()) {
+      id = found->second;
+    } else {
+      id = static_cast<uint32_t>(strings_.size());
+      strings_.push_back(view);
+      by_content_.emplace(view, id);
+    }
+    by_address_.emplace(str, id);
+    return id;
+  }
+
+  const std::vector<std::string_view>& Strings() const { return strings_; }
+
+ private:
+  std::unordered_map<const char*, uint32_t> by_address_;
+  std::unordered_map<std::string_view, uint32_t> by_content_;
+  std::vector<std::string_view> strings_;
+};
+
+template <typename T>
+void Write(std::ofstream* out, const T& value) {
+  out->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+size_t DumpHostEvents(const HostEventSection<CommonEvent>& events,
+                      const std::string& path) {
+  StringTable table;
+  std::vector<uint32_t> type_names;
+#define TYPE_NAME(name) type_names.push_back(table.Id(#name));
+  FOR_EACH_TRACER_EVENT_TYPES(TYPE_NAME)
+#undef TYPE_NAME
+
+  std::vector<uint32_t> thread_names;
+  std::vector<std::vector<HostEventDumpRecord>> records;
+  size_t num_events = 0;
+  for (const auto& thr_sec : events.thr_sections) {
+    thread_names.push_back(table.Id(thr_sec.thread_name.c_str()));
+    records.emplace_back();
+    auto& thread_records = records.back();
+    thread_records.reserve(thr_sec.events.size());
+    for (const auto& event : thr_sec.events) {
+      HostEventDumpRecord record{};
+      record.start_ns = event.start_ns;
+      record.end_ns = event.end_ns;
+      record.name_id = table.Id(event.name);
+      record.attr_id = table.Id(event.attr);
+      record.type = static_cast<uint8_t>(event.type);
+      record.role = static_cast<uint8_t>(event.role);
+      thread_records.push_back(record);
+    }
+    num_events += thread_records.size();
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  PADDLE_ENFORCE_EQ(out.is_open(),
+                    true,
+                    common::errors::Unavailable(
+                        "Cannot open %s to dump the host events.", path));
+  out.write(kHostEventDumpMagic, sizeof(kHostEventDumpMagic) - 1);
+  Write(&out, static_cast<uint64_t>(events.process_id));
+  Write(&out, static_cast<uint32_t>(table.Strings().size()));
+  for (const auto& str : table.Strings()) {
+    Write(&out, static_cast<uint32_t>(str.size()));
+    out.write(str.data(), static_cast<std::streamsize>(str.size()));
+  }
+  Write(&out, static_cast<uint32_t>(type_names.size()));
+  for (uint32_t id : type_names) {
+    Write(&out, id);
+  }
+  Write(&out, static_cast<uint32_t>(records.size()));
+  for (size_t i = 0; i < records.size(); ++i) {
+    Write(&out, static_cast<uint64_t>(events.thr_sections[i].thread_id));
+    Write(&out, thread_names[i]);
+    Write(&out, static_cast<uint64_t>(records[i].size()));
+    out.write(reinterpret_cast<const char*>(records[i].data()),
+              static_cast<std::streamsize>(records[i].size() *
+                                           sizeof(HostEventDumpRecord)));
+  }
+  PADDLE_ENFORCE_EQ(out.good(),
+                    true,
+                    common::errors::Unavailable(
+                        "Failed to dump the host events to %s.", path));
+  return num_events;
+}
+
+}  // namespace phi
@@ -0,0 +1,60 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "paddle/phi/api/profiler/common_event.h"
+#include "paddle/phi/api/profiler/host_event_recorder.h"
+#include "paddle/utils/test_macros.h"
+
+namespace phi {
+
+// The magic bytes at the beginning of a dump, with the version of its format.
+constexpr char kHostEventDumpMagic[] = "PDHEDMP1";
+// The string id of an event without attribute.
+constexpr uint32_t kHostEventDumpNoString = UINT32_MAX;
+
+// An event in the dump, the strings are ids in the string table.
+struct HostEventDumpRecord {
+  uint64_t start_ns;
+  uint64_t end_ns;
+  uint32_t name_id;
+  uint32_t attr_id;
+  uint8_t type;
+  uint8_t role;
+  uint8_t padding[6];
+};
+static_assert(sizeof(HostEventDumpRecord) == 32,
+              "HostEventDumpRecord must be 32 bytes");
+
+/**
+ * Writes the host events to path, in a compact binary format which
+ * python/paddle/profiler/host_event_dump.py converts to the chrome tracing
+ * format offline. The integers are little-endian:
+ *
+ *   the 8 bytes of kHostEventDumpMagic, the u64 process id,
+ *   the u32 number of strings, each as its u32 length and its bytes,
+ *   the u32 number of event types, each as the u32 string id of its name,
+ *   the u32 number of threads, each as its u64 id, the u32 string id of its
+ *   name, the u64 number of its events and their HostEventDumpRecord.
+ *
+ * Returns the number of events written.
+ */
+TEST_API size_t DumpHostEvents(const HostEventSection<CommonEvent>& events,
+                               const std::string& path);
+
+}  // namespace phi
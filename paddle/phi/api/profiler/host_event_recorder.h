@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -254,6 +255,7 @@ class HostEventRecorder {
           thread_event_recorder_ptr =
               std::make_shared<ThreadEventRecorder<EventType>>();
       *(GetThreadLocalRecorder()) = thread_event_recorder_ptr;
+      std::lock_guard<std::mutex> guard(thr_recorders_mtx_);
       thr_recorders_.push_back(thread_event_recorder_ptr);
     }
     (*GetThreadLocalRecorder())->RecordEvent(std::forward<Args>(args)...);
@@ -264,6 +266,7 @@ class HostEventRecorder {
   HostEventSection<EventType> GatherEvents() {
     HostEventSection<EventType> host_sec;
     host_sec.process_id = GetProcessId();
+    std::lock_guard<std::mutex> guard(thr_recorders_mtx_);
     host_sec.thr_sections.reserve(thr_recorders_.size());
     for (auto &v : thr_recorders_) {
       host_sec.thr_sections.emplace_back(std::move(v->GatherEvents()));
@@ -287,6 +290,8 @@ class HostEventRecorder {
   // shared pointer. We add this to prevent ThreadEventRecorder being destroyed
   // by thread-local variable in ThreadEventRecorderRegistry and lose data.
   std::vector<std::shared_ptr<ThreadEventRecorder<EventType>>> thr_recorders_;
+  // Guards thr_recorders_ against the threads recording their first event.
+  std::mutex thr_recorders_mtx_;
 };
 
 }  // namespace phi
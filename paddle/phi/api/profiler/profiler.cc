@@ -19,11 +19,13 @@ limitations under the License. */
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 
 #include "glog/logging.h"
 
 #include "paddle/phi/api/profiler/common_event.h"
 #include "paddle/phi/api/profiler/device_tracer.h"
+#include "paddle/phi/api/profiler/event_name_registry.h"
 #include "paddle/phi/api/profiler/host_event_recorder.h"
 #include "paddle/phi/api/profiler/host_tracer.h"
 #include "paddle/phi/api/profiler/profiler_helper.h"
@@ -32,6 +34,9 @@ limitations under the License. */
 #ifdef PADDLE_WITH_CUDA
 #include "paddle/phi/backends/dynload/nvtx.h"
 #endif
+#ifdef PADDLE_WITH_ITT
+#include <ittnotify.h>
+#endif
 
 PHI_DEFINE_bool(enable_host_event_recorder_hook,
                 false,
@@ -45,6 +50,7 @@ namespace phi {
 
 ProfilerState ProfilerHelper::g_state = ProfilerState::kDisabled;
 bool ProfilerHelper::g_enable_nvprof_hook = false;
+bool ProfilerHelper::g_enable_itt_hook = false;
 thread_local uint64_t ProfilerHelper::g_thread_id;
 uint32_t ProfilerHelper::g_next_thread_id = 0;
 std::mutex ProfilerHelper::g_all_event_lists_mutex;
@@ -96,18 +102,72 @@ void PopEvent(const std::string &name, const EventRole role, std::string attr) {
       EventType::kPopRange, name, ProfilerHelper::g_thread_id, role, attr);
 }
 
-RecordEvent::RecordEvent(const char *name,
-                         const TracerEventType type,
-                         uint32_t level,
-                         const EventRole role) {
-#ifndef _WIN32
-#ifdef PADDLE_WITH_CUDA
+namespace {
+
+constexpr uint8_t kNvtxRange = 1;
+constexpr uint8_t kIttRange = 2;
+
+#ifdef PADDLE_WITH_ITT
+__itt_domain *IttDomain() {
+  static __itt_domain *domain = __itt_domain_create("Paddle");
+  return domain;
+}
+
+// __itt_string_handle_create looks the name up under a lock, so the handles
+// are cached by each thread.
+__itt_string_handle *IttStringHandle(const char *name) {
+  thread_local std::unordered_map<std::string, __itt_string_handle *> handles;
+  auto it = handles.find(name);
+  if (it == handles.end()) {
+    it = handles.emplace(name, __itt_string_handle_create(name)).first;
+  }
+  return it->second;
+}
+#endif
+
+// Pushes the range of a RecordEvent to the external profilers hooked, NVTX
+// for Nsight Systems and ITT for VTune, and returns those pushed to.
+uint8_t PushExternalRanges(const char *name) {
+  uint8_t pushed = 0;
+#if defined(PADDLE_WITH_CUDA) && !defined(_WIN32)
   if (ProfilerHelper::g_enable_nvprof_hook) {
     dynload::nvtxRangePushA(name);
-    is_pushed_ = true;
+    pushed |= kNvtxRange;
   }
 #endif
+#ifdef PADDLE_WITH_ITT
+  if (ProfilerHelper::g_enable_itt_hook) {
+    __itt_task_begin(
+        IttDomain(), __itt_null, __itt_null, IttStringHandle(name));
+    pushed |= kIttRange;
+  }
+#endif
+  return pushed;
+}
+
+void PopExternalRanges(uint8_t pushed) {
+#if defined(PADDLE_WITH_CUDA) && !defined(_WIN32)
+  if (pushed & kNvtxRange) {
+    dynload::nvtxRangePop();
+  }
+#endif
+#ifdef PADDLE_WITH_ITT
+  if (pushed & kIttRange) {
+    __itt_task_end(IttDomain());
+  }
 #endif
+}
+
+}  // namespace
+
+RecordEvent::RecordEvent(const char *name,
+                         const TracerEventType type,
+                         uint32_t level,
+                         const EventRole role) {
+  if (UNLIKELY(ProfilerHelper::g_enable_nvprof_hook ||
+               ProfilerHelper::g_enable_itt_hook)) {
+    pushed_ranges_ = PushExternalRanges(name);
+  }
   if (UNLIKELY(HostTraceLevel::GetInstance().NeedTrace(level) == false)) {
     return;
   }
@@ -134,14 +194,10 @@ RecordEvent::RecordEvent(const std::string &name,
                          const TracerEventType type,
                          uint32_t level,
                          const EventRole role) {
-#ifndef _WIN32
-#ifdef PADDLE_WITH_CUDA
-  if (ProfilerHelper::g_enable_nvprof_hook) {
-    dynload::nvtxRangePushA(name.c_str());
-    is_pushed_ = true;
+  if (UNLIKELY(ProfilerHelper::g_enable_nvprof_hook ||
+               ProfilerHelper::g_enable_itt_hook)) {
+    pushed_ranges_ = PushExternalRanges(name.c_str());
   }
-#endif
-#endif
   if (UNLIKELY(HostTraceLevel::GetInstance().NeedTrace(level) == false)) {
     return;
   }
@@ -156,7 +212,10 @@ RecordEvent::RecordEvent(const std::string &name,
   }
 
   is_enabled_ = true;
-  name_ = new std::string(name);
+  shallow_copy_name_ = EventNameRegistry::Instance().Intern(name);
+  if (UNLIKELY(shallow_copy_name_ == nullptr)) {
+    name_ = new std::string(name);
+  }
   role_ = role;
   type_ = type;
   start_ns_ = PosixInNsec();
@@ -167,14 +226,10 @@ RecordEvent::RecordEvent(const std::string &name,
                          const TracerEventType type,
                          uint32_t level,
                          const EventRole role) {
-#ifndef _WIN32
-#ifdef PADDLE_WITH_CUDA
-  if (ProfilerHelper::g_enable_nvprof_hook) {
-    dynload::nvtxRangePushA(name.c_str());
-    is_pushed_ = true;
+  if (UNLIKELY(ProfilerHelper::g_enable_nvprof_hook ||
+               ProfilerHelper::g_enable_itt_hook)) {
+    pushed_ranges_ = PushExternalRanges(name.c_str());
   }
-#endif
-#endif
 
   if (UNLIKELY(HostTraceLevel::GetInstance().NeedTrace(level) == false)) {
     return;
@@ -216,14 +271,10 @@ void RecordEvent::OriginalConstruct(const std::string &name,
 }
 
 void RecordEvent::End() {
-#ifndef _WIN32
-#ifdef PADDLE_WITH_CUDA
-  if (ProfilerHelper::g_enable_nvprof_hook && is_pushed_) {
-    dynload::nvtxRangePop();
-    is_pushed_ = false;
+  if (UNLIKELY(pushed_ranges_ != 0)) {
+    PopExternalRanges(pushed_ranges_);
+    pushed_ranges_ = 0;
   }
-#endif
-#endif
   if (LIKELY(FLAGS_enable_host_event_recorder_hook && is_enabled_)) {
     uint64_t end_ns = PosixInNsec();
     if (LIKELY(shallow_copy_name_ != nullptr)) {
@@ -268,6 +319,7 @@ void RecordEvent::End() {
 bool RecordEvent::IsEnabled() {
   return FLAGS_enable_host_event_recorder_hook ||
          ProfilerHelper::g_enable_nvprof_hook ||
+         ProfilerHelper::g_enable_itt_hook ||
          ProfilerHelper::g_state != ProfilerState::kDisabled;
 }
 
@@ -39,6 +39,8 @@ class ProfilerHelper {
   static ProfilerState g_state;
   // To hook RecordEvent's events, use it to nvtx timeline
   static bool g_enable_nvprof_hook;
+  // To hook RecordEvent's events, use it to the ITT tasks of VTune
+  static bool g_enable_itt_hook;
   // The thread local event list only can be accessed by the specific thread
   // The thread index of each thread
   static thread_local uint64_t g_thread_id;
@@ -272,15 +272,13 @@ class CustomDevice : public DeviceInterface {
                      size_t size,
                      const stream::Stream* stream = nullptr) override {
     const auto device = &devices_pool[dev_id];
-    auto place = CustomPlace(Type(), dev_id);
 
     if (stream && stream->raw_stream() && pimpl_->async_memory_copy_h2d) {
       C_Stream c_stream = reinterpret_cast<C_Stream>(stream->raw_stream());
       PADDLE_ENFORCE_CUSTOM_DEVICE_SUCCESS(
           pimpl_->async_memory_copy_h2d(device, c_stream, dst, src, size));
     } else if (pimpl_->memory_copy_h2d) {
-      phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
-      pool.Get(place)->Wait();
+      WaitBeforeSyncCopy(dev_id, stream);
       PADDLE_ENFORCE_CUSTOM_DEVICE_SUCCESS(
           pimpl_->memory_copy_h2d(device, dst, src, size));
     }
@@ -292,15 +290,13 @@ class CustomDevice : public DeviceInterface {
                      size_t size,
                      const stream::Stream* stream = nullptr) override {
     const auto device = &devices_pool[dev_id];
-    auto place = CustomPlace(Type(), dev_id);
 
     if (stream && stream->raw_stream() && pimpl_->async_memory_copy_d2h) {
       C_Stream c_stream = reinterpret_cast<C_Stream>(stream->raw_stream());
       PADDLE_ENFORCE_CUSTOM_DEVICE_SUCCESS(
           pimpl_->async_memory_copy_d2h(device, c_stream, dst, src, size));
     } else if (pimpl_->memory_copy_d2h) {
-      phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
-      pool.Get(place)->Wait();
+      WaitBeforeSyncCopy(dev_id, stream);
       PADDLE_ENFORCE_CUSTOM_DEVICE_SUCCESS(
           pimpl_->memory_copy_d2h(device, dst, src, size));
     }
@@ -312,15 +308,13 @@ class CustomDevice : public DeviceInterface {
                      size_t size,
                      const stream::Stream* stream = nullptr) override {
     const auto device = &devices_pool[dev_id];
-    auto place = CustomPlace(Type(), dev_id);
 
     if (stream && stream->raw_stream() && pimpl_->async_memory_copy_d2d) {
       C_Stream c_stream = reinterpret_cast<C_Stream>(stream->raw_stream());
       PADDLE_ENFORCE_CUSTOM_DEVICE_SUCCESS(
           pimpl_->async_memory_copy_d2d(device, c_stream, dst, src, size));
     } else if (pimpl_->memory_copy_d2d) {
-      phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
-      pool.Get(place)->Wait();
+      WaitBeforeSyncCopy(dev_id, stream);
       PADDLE_ENFORCE_CUSTOM_DEVICE_SUCCESS(
           pimpl_->memory_copy_d2d(device, dst, src, size));
     }
@@ -338,6 +332,7 @@ class CustomDevice : public DeviceInterface {
 
     if (stream && stream->raw_stream()) {
       if (!pimpl_->async_memory_copy_p2p) {
+        WaitBeforeSyncCopy(src_dev_id, stream);
         MemoryCopyP2P(dst_place, dst, src_dev_id, src, size);
       } else {
         PADDLE_ENFORCE_CUSTOM_DEVICE_SUCCESS(pimpl_->async_memory_copy_p2p(
@@ -941,6 +936,19 @@ class CustomDevice : public DeviceInterface {
     return dev_id;
   }
 
+  // A synchronous copy must follow the work queued before it. A copy given a
+  // stream waits for that stream only, so that the copies on the H2D and D2H
+  // streams of the executor neither race with the kernels of their own stream
+  // nor wait for the kernels of the default one.
+  void WaitBeforeSyncCopy(size_t dev_id, const stream::Stream* stream) {
+    if (stream && stream->raw_stream() && pimpl_->synchronize_stream) {
+      SynchronizeStream(dev_id, stream);
+    } else {
+      phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
+      pool.Get(CustomPlace(Type(), dev_id))->Wait();
+    }
+  }
+
   std::unique_ptr<C_DeviceInterface> pimpl_;
   void* dso_handle_;
   std::unordered_map<size_t, C_Device_st> devices_pool;
@@ -23,6 +23,7 @@ void* mklml_dso_handle = nullptr;
 #define DEFINE_WRAP(__name) DynLoad__##__name __name
 
 MKLML_ROUTINE_EACH(DEFINE_WRAP);
+DEFINE_WRAP(MKL_Set_Num_Threads_Local);
 
 #if !defined(_WIN32)
 DEFINE_WRAP(mkl_scsrmm);
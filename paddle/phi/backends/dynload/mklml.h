@@ -112,6 +112,7 @@ extern void *mklml_dso_handle;
   __macro(MKL_Get_Max_Threads);
 
 MKLML_ROUTINE_EACH(DECLARE_DYNAMIC_LOAD_MKLML_WRAP);
+DECLARE_DYNAMIC_LOAD_MKLML_WRAP(MKL_Set_Num_Threads_Local);
 
 #if !defined(_WIN32)
 DYNAMIC_LOAD_MKLML_WRAP(mkl_scsrmm);
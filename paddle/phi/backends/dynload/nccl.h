@@ -104,5 +104,10 @@ NCCL_RAND_ROUTINE_EACH_AFTER_2703(DECLARE_DYNAMIC_LOAD_NCCL_WRAP)
 NCCL_RAND_ROUTINE_EACH_AFTER_21100(DECLARE_DYNAMIC_LOAD_NCCL_WRAP)
 #endif
 
+#if NCCL_VERSION_CODE >= 21800
+#define NCCL_RAND_ROUTINE_EACH_AFTER_21800(__macro) __macro(ncclCommSplit);
+NCCL_RAND_ROUTINE_EACH_AFTER_21800(DECLARE_DYNAMIC_LOAD_NCCL_WRAP)
+#endif
+
 }  // namespace dynload
 }  // namespace phi
@@ -13,11 +13,43 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "paddle/phi/backends/xpu/xpu_l3_strategy.h"
+
+#include <utility>
+
 #include "glog/logging.h"
 #include "paddle/phi/backends/xpu/enforce_xpu.h"
 
 namespace phi {
 
+namespace {
+
+// Whether the blocks may be live at the same time. A block of unknown
+// lifetime is live during the whole run.
+bool LifetimesOverlap(const XPUL3CacheBlock* a, const XPUL3CacheBlock* b) {
+  if (a->first_use_ < 0 || b->first_use_ < 0) {
+    return true;
+  }
+  return a->first_use_ <= b->last_use_ && b->first_use_ <= a->last_use_;
+}
+
+// The lowest offset at which size bytes do not intersect the busy ranges,
+// or SIZE_MAX if the bytes would end past limit.
+size_t FirstFit(std::vector<std::pair<size_t, size_t>> busy,
+                size_t size,
+                size_t limit) {
+  std::sort(busy.begin(), busy.end());
+  size_t offset = 0;
+  for (const auto& range : busy) {
+    if (offset + size <= range.first) {
+      break;
+    }
+    offset = std::max(offset, range.second);
+  }
+  return offset + size <= limit ? offset : SIZE_MAX;
+}
+
+}  // namespace
+
 void XPUL3CacheBlock::Set(void* addr, size_t size) {
   if (addr == nullptr || size == 0) {
     PADDLE_THROW(
@@ -151,8 +183,74 @@ bool XPUL3Planner::RunAutotune(
     plan_[record_map[i]] = res.back().choices[i];
   }
   plan_[l3_block_dict.size()] = xdnn_ctx_l3_size;
+  PackByLifetime(l3_block_dict, l3_size);
   VLOG(3) << "AutoTune XPU L3 Cache Block End.";
   return true;
 }
 
+void XPUL3Planner::PackByLifetime(
+    const std::vector<XPUL3CacheBlock*>& l3_block_dict, size_t l3_size) {
+  size_t num_blocks = l3_block_dict.size();
+  offsets_.assign(num_blocks, 0);
+  std::vector<size_t> placed;
+  size_t peak = 0;
+  auto place = [&](size_t idx, size_t size, size_t limit) {
+    std::vector<std::pair<size_t, size_t>> busy;
+    for (size_t other : placed) {
+      if (LifetimesOverlap(l3_block_dict[idx], l3_block_dict[other])) {
+        busy.emplace_back(offsets_[other], offsets_[other] + plan_[other]);
+      }
+    }
+    size_t offset = FirstFit(busy, size, limit);
+    if (offset == SIZE_MAX) {
+      return false;
+    }
+    offsets_[idx] = offset;
+    plan_[idx] = size;
+    placed.push_back(idx);
+    peak = std::max(peak, offset + size);
+    return true;
+  };
+
+  // The blocks of the plan, the largest first. They fit, since the plan sums
+  // their sizes as if none shared a range.
+  std::vector<size_t> order;
+  for (size_t i = 0; i < num_blocks; i++) {
+    if (plan_[i] > 0) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return plan_[a] > plan_[b];
+  });
+  for (size_t idx : order) {
+    PADDLE_ENFORCE_EQ(place(idx, plan_[idx], l3_size),
+                      true,
+                      common::errors::PreconditionNotMet(
+                          "The XPU L3 block %d does not fit in %d bytes.",
+                          idx,
+                          l3_size));
+  }
+
+  // The blocks left out take the largest of their sizes that fits in a hole
+  // below the peak, so that the range of the XDNN context does not shrink.
+  for (size_t i = 0; i < num_blocks; i++) {
+    const std::vector<size_t>& history = l3_block_dict[i]->history_;
+    if (plan_[i] > 0 || history.size() <= 1) {
+      continue;
+    }
+    for (auto it = history.rbegin(); it != history.rend(); ++it) {
+      if (*it > 0 && place(i, *it, peak)) {
+        VLOG(3) << "XPU L3 Block IDX is " << i << ", Shares L3 Size " << *it
+                << " at Offset " << offsets_[i];
+        break;
+      }
+    }
+  }
+
+  plan_[num_blocks] = (l3_size - peak) / 64 * 64;
+  VLOG(3) << "Block L3 Peak : " << peak
+          << ", XDNN Ctx L3 Size : " << plan_[num_blocks];
+}
+
 }  // namespace phi
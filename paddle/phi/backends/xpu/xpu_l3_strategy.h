@@ -14,6 +14,7 @@ limitations under the License. */
 
 #pragma once
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <vector>
 
@@ -25,9 +26,18 @@ struct XPUL3CacheBlock {
     addr_ = nullptr;
     size_ = 0;
     history_.clear();
+    first_use_ = -1;
+    last_use_ = -1;
   }
   void Set(void* addr, size_t size);
   void Record(size_t size) { history_.push_back(size); }
+  // Extends the lifetime of the block to the step of the tuning run.
+  void Touch(int64_t step) {
+    if (first_use_ < 0) {
+      first_use_ = step;
+    }
+    last_use_ = std::max(last_use_, step);
+  }
   void* data() { return addr_; }
   size_t size() { return size_; }
 
@@ -37,6 +47,10 @@ struct XPUL3CacheBlock {
 
  public:
   std::vector<size_t> history_;
+  // The first and the last step of the tuning run at which the block is
+  // allocated or read, -1 if they are unknown.
+  int64_t first_use_{-1};
+  int64_t last_use_{-1};
 };
 
 class XPUL3Planner {
@@ -45,9 +59,18 @@ class XPUL3Planner {
                    size_t l3_size);
 
   std::vector<size_t>* plan() { return &plan_; }
+  std::vector<size_t>* offsets() { return &offsets_; }
 
  private:
+  // Places the blocks of the plan in L3 like a scratchpad allocator: the
+  // blocks whose lifetimes do not overlap may share the same range, and the
+  // blocks the plan left out take the holes so made. The rest of L3 is left
+  // to the XDNN context.
+  void PackByLifetime(const std::vector<XPUL3CacheBlock*>& l3_block_dict,
+                      size_t l3_size);
+
   std::vector<size_t> plan_;
+  std::vector<size_t> offsets_;
 };
 
 }  // namespace phi
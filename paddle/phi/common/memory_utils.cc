@@ -43,6 +43,11 @@ bool InSameStream(const std::shared_ptr<Allocation>& allocation,
   return MemoryUtils::Instance().InSameStream(allocation, stream);
 }
 
+void RecordStream(const std::shared_ptr<Allocation>& allocation,
+                  const phi::Stream& stream) {
+  MemoryUtils::Instance().RecordStream(allocation, stream);
+}
+
 void AllocationDeleter(Allocation* allocation) {
   MemoryUtils::Instance().AllocationDeleter(allocation);
 }
@@ -84,6 +84,16 @@ struct MemoryInterface {
   bool (*in_same_stream)(const std::shared_ptr<Allocation>& allocation,
                          const phi::Stream& stream);
 
+  /**
+   * @brief record that the allocation is used by the stream, so that it is
+   * not reused before the work queued on the stream completes
+   *
+   * @param[Allocation] allocation  the allocation used by the stream
+   * @param[phi::Stream]stream      the device's stream
+   */
+  void (*record_stream)(const std::shared_ptr<Allocation>& allocation,
+                        const phi::Stream& stream);
+
   /**
    * @brief free allocation
    *
@@ -247,6 +257,17 @@ class MemoryUtils {
     return memory_method_->in_same_stream(allocation, stream);
   }
 
+  void RecordStream(const std::shared_ptr<Allocation>& allocation,
+                    const phi::Stream& stream) {
+    CheckMemoryMethod();
+    PADDLE_ENFORCE_NE(memory_method_->record_stream,
+                      nullptr,
+                      common::errors::Unavailable(
+                          "record_stream method in memory_method_ is "
+                          "not initiazed yet. You need init it first."));
+    memory_method_->record_stream(allocation, stream);
+  }
+
   void AllocationDeleter(Allocation* allocation) {
     CheckMemoryMethod();
     PADDLE_ENFORCE_NE(memory_method_->allocation_deleter,
@@ -433,6 +454,9 @@ std::shared_ptr<Allocation> AllocShared(const phi::Place& place, size_t size);
 bool InSameStream(const std::shared_ptr<Allocation>& allocation,
                   const phi::Stream& stream);
 
+void RecordStream(const std::shared_ptr<Allocation>& allocation,
+                  const phi::Stream& stream);
+
 void AllocationDeleter(Allocation* allocation);
 
 void Copy(const Place& dst_place,
@@ -39,7 +39,7 @@ void CustomKernelMap::RegisterCustomKernels() {
     LOG(INFO) << "No custom kernel info found in loaded lib(s).";
     return;
   }
-  auto& kernels = KernelFactory::Instance().kernels();
+  auto& kernels = KernelFactory::Instance().mutable_kernels();
   for (auto& pair : kernels_) {
     for (auto& info_pair : pair.second) {
       PADDLE_ENFORCE_EQ(
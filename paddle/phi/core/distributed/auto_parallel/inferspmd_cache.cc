@@ -0,0 +1,82 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/phi/core/distributed/auto_parallel/inferspmd_cache.h"
+
+#include <algorithm>
+
+#include "paddle/common/flags.h"
+
+COMMON_DECLARE_int32(infer_spmd_cache_capacity);
+
+namespace phi {
+namespace distributed {
+
+bool SpmdCacheKeyAppender<TensorDistAttr>::Append(
+    const TensorDistAttr& dist_attr, std::string* key) {
+  const ProcessMesh& process_mesh = dist_attr.process_mesh();
+  // The partial status is a hash map, whose order is not defined.
+  std::vector<std::pair<int64_t, ReduceType>> partial_status(
+      dist_attr.partial_status().begin(), dist_attr.partial_status().end());
+  std::sort(partial_status.begin(),
+            partial_status.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.first < rhs.first;
+            });
+  std::vector<int64_t> partial_dims;
+  std::vector<ReduceType> partial_types;
+  for (const auto& status : partial_status) {
+    partial_dims.push_back(status.first);
+    partial_types.push_back(status.second);
+  }
+  std::vector<std::string> annotated;
+  for (const auto& item : dist_attr.annotated()) {
+    if (item.second) {
+      annotated.push_back(item.first);
+    }
+  }
+  return MakeSpmdCacheKey(key,
+                          process_mesh.shape(),
+                          process_mesh.process_ids(),
+                          process_mesh.dim_names(),
+                          dist_attr.dims_mapping(),
+                          partial_dims,
+                          partial_types,
+                          dist_attr.batch_dim(),
+                          dist_attr.chunk_id(),
+                          dist_attr.dynamic_dims(),
+                          annotated,
+                          dist_attr.skip_check_mesh());
+}
+
+bool SpmdCacheKeyAppender<DistMetaTensor>::Append(const DistMetaTensor& tensor,
+                                                  std::string* key) {
+  if (!tensor.initialized()) {
+    return MakeSpmdCacheKey(key, false);
+  }
+  return MakeSpmdCacheKey(key,
+                          true,
+                          common::vectorize<int64_t>(tensor.dims()),
+                          tensor.dist_attr());
+}
+
+int SpmdCacheCapacity() { return FLAGS_infer_spmd_cache_capacity; }
+
+SpmdCache<SpmdInfo>* InferSpmdCache() {
+  thread_local SpmdCache<SpmdInfo> cache;
+  return &cache;
+}
+
+}  // namespace distributed
+}  // namespace phi
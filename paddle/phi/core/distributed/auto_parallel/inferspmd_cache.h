@@ -0,0 +1,150 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "paddle/phi/common/scalar.h"
+#include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
+#include "paddle/phi/core/distributed/auto_parallel/dist_meta_tensor.h"
+#include "paddle/phi/core/distributed/type_defs.h"
+
+/* The SPMD rules are pure functions of the dims and dist attrs of their
+inputs and of their attributes, so the eager auto parallel APIs cache their
+results by the bytes of those arguments, see CachedInferSpmd. The arguments
+of the types without a SpmdCacheKeyAppender leave the call uncached. */
+
+namespace phi {
+namespace distributed {
+
+template <typename T, typename Enable = void>
+struct SpmdCacheKeyAppender {
+  static bool Append(const T&, std::string*) { return false; }
+};
+
+template <typename T>
+struct SpmdCacheKeyAppender<
+    T,
+    std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value>> {
+  static bool Append(const T& value, std::string* key) {
+    key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+    return true;
+  }
+};
+
+template <>
+struct SpmdCacheKeyAppender<std::string> {
+  static bool Append(const std::string& value, std::string* key) {
+    SpmdCacheKeyAppender<size_t>::Append(value.size(), key);
+    key->append(value);
+    return true;
+  }
+};
+
+template <>
+struct SpmdCacheKeyAppender<const char*> {
+  static bool Append(const char* value, std::string* key) {
+    return SpmdCacheKeyAppender<std::string>::Append(value, key);
+  }
+};
+
+template <typename T>
+struct SpmdCacheKeyAppender<std::vector<T>> {
+  static bool Append(const std::vector<T>& values, std::string* key) {
+    SpmdCacheKeyAppender<size_t>::Append(values.size(), key);
+    for (const auto& value : values) {
+      if (!SpmdCacheKeyAppender<T>::Append(value, key)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+template <>
+struct SpmdCacheKeyAppender<Scalar> {
+  static bool Append(const Scalar& value, std::string* key) {
+    return SpmdCacheKeyAppender<std::string>::Append(value.ToString(), key);
+  }
+};
+
+template <>
+struct SpmdCacheKeyAppender<TensorDistAttr> {
+  static bool Append(const TensorDistAttr& dist_attr, std::string* key);
+};
+
+template <>
+struct SpmdCacheKeyAppender<DistMetaTensor> {
+  static bool Append(const DistMetaTensor& tensor, std::string* key);
+};
+
+// Makes the key of args in key, returns false if one of them can not be
+// a part of a key.
+template <typename... Args>
+bool MakeSpmdCacheKey(std::string* key, const Args&... args) {
+  return (SpmdCacheKeyAppender<std::decay_t<Args>>::Append(args, key) && ...);
+}
+
+// The number of entries of a cache, not positive if the caches are disabled.
+int SpmdCacheCapacity();
+
+// A map from the keys of MakeSpmdCacheKey, which is cleared when it is full.
+// Each thread has its own caches, so they are not locked.
+template <typename T>
+class SpmdCache {
+ public:
+  const T* Find(const std::string& key) const {
+    auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : &it->second;
+  }
+
+  void Insert(std::string key, T value) {
+    if (entries_.size() >= static_cast<size_t>(SpmdCacheCapacity())) {
+      entries_.clear();
+    }
+    entries_.emplace(std::move(key), std::move(value));
+  }
+
+ private:
+  std::unordered_map<std::string, T> entries_;
+};
+
+SpmdCache<SpmdInfo>* InferSpmdCache();
+
+// Returns infer_spmd(), which calls the SPMD rule `rule` on args, or its
+// cached result for the same rule and args.
+template <typename Fn, typename... Args>
+SpmdInfo CachedInferSpmd(const char* rule,
+                         Fn&& infer_spmd,
+                         const Args&... args) {
+  std::string key;
+  if (SpmdCacheCapacity() <= 0 || !MakeSpmdCacheKey(&key, rule, args...)) {
+    return infer_spmd();
+  }
+  SpmdCache<SpmdInfo>* cache = InferSpmdCache();
+  if (const SpmdInfo* spmd_info = cache->Find(key)) {
+    return *spmd_info;
+  }
+  SpmdInfo spmd_info = infer_spmd();
+  cache->Insert(std::move(key), spmd_info);
+  return spmd_info;
+}
+
+}  // namespace distributed
+}  // namespace phi
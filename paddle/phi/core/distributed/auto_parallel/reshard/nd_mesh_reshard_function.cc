@@ -15,6 +15,7 @@
 #include "paddle/phi/core/distributed/auto_parallel/reshard/nd_mesh_reshard_function.h"
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
 #include "paddle/phi/common/int_array.h"
 #include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
 #include "paddle/phi/core/distributed/auto_parallel/dist_tensor.h"
@@ -24,9 +25,13 @@
 #include "paddle/phi/core/distributed/auto_parallel/reshard/r_to_s_reshard_function.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_utils.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/s_to_r_reshard_function.h"
+#include "paddle/phi/core/distributed/auto_parallel/reshard/s_to_s_reshard_function.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/same_status_reshard_function.h"
 #include "paddle/phi/core/distributed/store/store_utils.h"
 
+COMMON_DECLARE_bool(reshard_cost_based_planning);
+COMMON_DECLARE_int32(reshard_devices_per_node);
+
 namespace phi::distributed {
 
 namespace {
@@ -52,27 +57,6 @@ ProcessMesh GetSubProcessMesh(const ProcessMesh& mesh, int64_t axis) {
   return out_mesh;
 }
 
-// Given the input two dist_attr, traversing from high-dimension axis to
-// low-dimension. Find and return the first different axis which is shard status
-// between these two. For example, the input two dims_mapping are [-1, 0, -1,
-// -1] and [-1, -1, 0, -1], the first diff shard axis is 2.
-int64_t FindFirstDiffShardAxis(const TensorDistAttr& in_dist_attr,
-                               const TensorDistAttr& out_dist_attr) {
-  const auto& in_dims_mapping = in_dist_attr.dims_mapping();
-  const auto& out_dims_mapping = out_dist_attr.dims_mapping();
-  int64_t axis = -1;
-
-  for (int64_t i = static_cast<int64_t>(in_dims_mapping.size() - 1); i >= 0;
-       --i) {
-    if (in_dims_mapping[i] != out_dims_mapping[i]) {
-      axis = i;
-      break;
-    }
-  }
-
-  return axis;
-}
-
 }  // namespace
 
 bool SameNdMeshReshardFunction::IsSuitable(
@@ -93,183 +77,138 @@ void SameNdMeshReshardFunction::Eval(phi::DeviceContext* dev_ctx,
                                      DistTensor* out) {
   VLOG(3) << "Call " << Name();
   const auto& in_dist_attr = in.dist_attr();
-  const auto& process_mesh = out_dist_attr.process_mesh();
-
-  int64_t first_diff_axis = FindFirstDiffShardAxis(in_dist_attr, out_dist_attr);
-
-  // Backup out_dist_attr to to avoid overwriting the out's dist attr
-  auto out_dist_attr_orig = out_dist_attr;
-
+  std::vector<int64_t> global_dims = common::vectorize(in.dims());
+
+  NdMeshReshardCostModel cost_model(out_dist_attr.process_mesh(),
+                                    FLAGS_reshard_devices_per_node);
+  NdMeshReshardPlan plan =
+      FLAGS_reshard_cost_based_planning
+          ? PlanNdMeshReshard(global_dims,
+                              in.dtype(),
+                              in_dist_attr,
+                              out_dist_attr,
+                              cost_model)
+          : PlanNdMeshReshardByStatus(global_dims,
+                                      in.dtype(),
+                                      in_dist_attr,
+                                      out_dist_attr,
+                                      cost_model);
+  VLOG(3) << "Reshard from " << in_dist_attr.to_string() << " to "
+          << out_dist_attr.to_string() << " with plan " << plan.to_string();
+
+  // Copy the dims of in to avoid overwriting them when the output and input
+  // are the same value
+  DDim in_dims = in.dims();
   SetValue(out, in.value());
-  SetDistProps(out, in.dims(), in_dist_attr);
-
-  // 1. change all the partial status to replicated status if needed
-  if (in_dist_attr.is_partial()) {
-    // Copy in_dist_attr.partial_status to avoid overwriting the value of
-    // input when the output and input are the same value
-    const auto in_partial_status = in_dist_attr.partial_status();
-    const auto& out_partial_status = out_dist_attr_orig.partial_status();
-    for (const auto& kv : in_partial_status) {
-      if (out_partial_status.count(kv.first) != 0 ||
-          out_dist_attr_orig.is_shard(kv.first)) {
-        continue;
-      }
-      VLOG(3) << "Step1: partial axis " << kv.first;
-      // 1.1 Calculate the dist_attr after this transform
-      TensorDistAttr real_out_dist_attr(out->dist_attr());
-      real_out_dist_attr.clean_partial_dims({kv.first});
-
-      // 1.2 Calculate the process_mesh on specific axis
-      ProcessMesh sub_mesh = GetSubProcessMesh(process_mesh, kv.first);
-
-      // 1.3 Calculate the input one dim dist attr
-      TensorDistAttr in_one_dim_dist_attr(common::vectorize(in.dims()));
-      in_one_dim_dist_attr.set_process_mesh(sub_mesh);
-      in_one_dim_dist_attr.set_partial_status(std::vector<int64_t>{0},
-                                              kv.second);
+  SetDistProps(out, in_dims, in_dist_attr);
+  for (const auto& step : plan.steps) {
+    EvalStep(dev_ctx, in_dims, step, out);
+  }
+}
 
-      // 1.4 Calculate the output one dim dist attr
-      TensorDistAttr out_one_dim_dist_attr(common::vectorize(in.dims()));
-      out_one_dim_dist_attr.set_process_mesh(sub_mesh);
+void SameNdMeshReshardFunction::EvalStep(DeviceContext* dev_ctx,
+                                         const DDim& global_dims,
+                                         const NdMeshReshardStep& step,
+                                         DistTensor* out) {
+  using Type = NdMeshReshardStep::Type;
+  VLOG(3) << "Step: " << step.to_string();
+  int64_t mesh_axis = step.mesh_axis;
+  int64_t in_axis = step.in_tensor_axis;
+  int64_t out_axis = step.out_tensor_axis;
+
+  // 1. Calculate the dist_attr after this transform
+  TensorDistAttr real_out_dist_attr(out->dist_attr());
+  std::vector<int64_t> real_dims_mapping = real_out_dist_attr.dims_mapping();
+  if (step.type == Type::kPToR || step.type == Type::kPToS) {
+    real_out_dist_attr.clean_partial_dims({mesh_axis});
+  }
+  if (in_axis >= 0) {
+    real_dims_mapping[in_axis] = -1;
+  }
+  if (out_axis >= 0) {
+    real_dims_mapping[out_axis] = mesh_axis;
+  }
+  real_out_dist_attr.set_dims_mapping(real_dims_mapping);
+  if (step.type == Type::kRToP) {
+    real_out_dist_attr.set_partial_status(std::vector<int64_t>{mesh_axis},
+                                          step.reduce_type);
+  }
 
-      // 1.5 Change from partial to replicated
-      SetDistProps(out, in_one_dim_dist_attr);
+  // 2. Calculate the process_mesh on specific axis
+  ProcessMesh sub_mesh =
+      GetSubProcessMesh(out->dist_attr().process_mesh(), mesh_axis);
+
+  // 3. Calculate the input and output one dim dist attr. The all-to-all
+  // reshapes the local value by the dims, so it is given the local dims with
+  // the global size of the tensor dims it exchanges.
+  DDim dims = global_dims;
+  if (step.type == Type::kSToS) {
+    dims = out->local_dims();
+    dims[in_axis] = global_dims[in_axis];
+  }
+  TensorDistAttr in_one_dim_dist_attr(common::vectorize(dims));
+  in_one_dim_dist_attr.set_process_mesh(sub_mesh);
+  TensorDistAttr out_one_dim_dist_attr(common::vectorize(dims));
+  out_one_dim_dist_attr.set_process_mesh(sub_mesh);
+  if (in_axis >= 0) {
+    std::vector<int64_t> in_one_dims_mapping =
+        in_one_dim_dist_attr.dims_mapping();
+    in_one_dims_mapping[in_axis] = 0;
+    in_one_dim_dist_attr.set_dims_mapping(in_one_dims_mapping);
+  }
+  if (out_axis >= 0) {
+    std::vector<int64_t> out_one_dims_mapping =
+        out_one_dim_dist_attr.dims_mapping();
+    out_one_dims_mapping[out_axis] = 0;
+    out_one_dim_dist_attr.set_dims_mapping(out_one_dims_mapping);
+  }
+  if (step.type == Type::kPToR || step.type == Type::kPToS) {
+    in_one_dim_dist_attr.set_partial_status(std::vector<int64_t>{0},
+                                            step.reduce_type);
+  } else if (step.type == Type::kRToP) {
+    out_one_dim_dist_attr.set_partial_status(std::vector<int64_t>{0},
+                                             step.reduce_type);
+  }
 
-      DistTensor tmp_result;
+  // 4. Run the 1-D reshard
+  SetDistProps(out, dims, in_one_dim_dist_attr);
+  DistTensor tmp_result;
+  switch (step.type) {
+    case Type::kPToR: {
       PToRReshardFunction func;
       func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
-
-      // 1.6 Reset to the right dist attr
-      SetValue(out, tmp_result.value());
-      SetDistProps(out, real_out_dist_attr);
+      break;
     }
-  }
-
-  // 2. change all the shard status to replicated status
-  for (int64_t i = first_diff_axis; i >= 0; --i) {
-    int64_t in_mesh_axis = out->dist_attr().dims_mapping()[i];
-    if (in_mesh_axis != -1) {
-      VLOG(3) << "Step2: in_mesh axis " << in_mesh_axis;
-      // 2.1 Calculate the dist_attr after this transform
-      TensorDistAttr real_out_dist_attr(out->dist_attr());
-      std::vector<int64_t> real_dims_mapping =
-          real_out_dist_attr.dims_mapping();
-      real_dims_mapping[i] = -1;
-      real_out_dist_attr.set_dims_mapping(real_dims_mapping);
-
-      // 2.2 Calculate the process_mesh on specific axis
-      ProcessMesh sub_mesh = GetSubProcessMesh(process_mesh, in_mesh_axis);
-
-      // 2.3 Calculate the input one dim dist attr
-      TensorDistAttr in_one_dim_dist_attr(common::vectorize(in.dims()));
-      in_one_dim_dist_attr.set_process_mesh(sub_mesh);
-      std::vector<int64_t> in_one_dims_mapping =
-          in_one_dim_dist_attr.dims_mapping();
-      in_one_dims_mapping[i] = 0;
-      in_one_dim_dist_attr.set_dims_mapping(in_one_dims_mapping);
-
-      // 2.4 Calculate the output one dim dist attr
-      TensorDistAttr out_one_dim_dist_attr(common::vectorize(in.dims()));
-      out_one_dim_dist_attr.set_process_mesh(sub_mesh);
-
-      // 2.5 Change from shard to replicated
-      SetDistProps(out, in_one_dim_dist_attr);
-      DistTensor tmp_result;
+    case Type::kPToS: {
+      PToSReshardFunction func;
+      func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
+      break;
+    }
+    case Type::kSToR: {
       SToRReshardFunction func;
       func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
-
-      // 2.6 Reset to the right dist attr
-      SetValue(out, tmp_result.value());
-      SetDistProps(out, real_out_dist_attr);
+      break;
     }
-  }
-
-  // 3. Change replicated to partial
-  if (out_dist_attr_orig.is_partial()) {
-    const auto& in_partial_status = out->dist_attr().partial_status();
-    const auto& out_partial_status = out_dist_attr_orig.partial_status();
-    for (const auto& kv : out_partial_status) {
-      if (in_partial_status.count(kv.first) != 0) {
-        continue;
-      }
-      VLOG(3) << "Step3: Partial status mesh axis " << kv.first;
-      // 3.1 Calculate the dist_attr after this transform
-      TensorDistAttr real_out_dist_attr(out->dist_attr());
-      real_out_dist_attr.set_partial_status(std::vector<int64_t>{kv.first});
-
-      // 3.2 Calculate the process_mesh on specific axis
-      ProcessMesh sub_mesh = GetSubProcessMesh(process_mesh, kv.first);
-
-      // 3.3 Calculate the input one dim dist attr
-      TensorDistAttr in_one_dim_dist_attr(common::vectorize(in.dims()));
-      in_one_dim_dist_attr.set_process_mesh(sub_mesh);
-
-      // 3.4 Calculate the output one dim dist attr
-      TensorDistAttr out_one_dim_dist_attr(common::vectorize(in.dims()));
-      out_one_dim_dist_attr.set_process_mesh(sub_mesh);
-      out_one_dim_dist_attr.set_partial_status(std::vector<int64_t>{0});
-
-      // 3.5 Change from partial to replicated
-      DistTensor tmp_result;
-      SetDistProps(out, in_one_dim_dist_attr);
+    case Type::kSToS: {
+      SToSReshardFunction func;
+      func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
+      break;
+    }
+    case Type::kRToS: {
+      RToSReshardFunction func;
+      func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
+      break;
+    }
+    case Type::kRToP: {
       RToPReshardFunction func;
       func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
-
-      // 3.6 Reset to the right dist attr
-      SetValue(out, tmp_result.value());
-      SetDistProps(out, real_out_dist_attr);
+      break;
     }
   }
 
-  // 4. Change replicated/partial to shard
-  for (int64_t i = first_diff_axis; i >= 0; --i) {
-    int64_t out_mesh_axis = out_dist_attr_orig.dims_mapping()[i];
-    if (out_mesh_axis != -1) {
-      const auto& in_partial_status = out->dist_attr().partial_status();
-      bool is_partial = in_partial_status.count(out_mesh_axis) != 0;
-
-      VLOG(3) << "Step4: out_mesh axis : " << out_mesh_axis
-              << "; partial state :" << is_partial;
-      // 4.1 Calculate the dist_attr after this transform
-      TensorDistAttr real_out_dist_attr(out->dist_attr());
-      std::vector<int64_t> real_dims_mapping =
-          real_out_dist_attr.dims_mapping();
-      real_dims_mapping[i] = out_mesh_axis;
-      real_out_dist_attr.set_dims_mapping(real_dims_mapping);
-      if (real_out_dist_attr.is_partial(out_mesh_axis)) {
-        real_out_dist_attr.clean_partial_dims({out_mesh_axis});
-      }
-
-      // 4.2 Calculate the process_mesh on specific axis
-      ProcessMesh sub_mesh = GetSubProcessMesh(process_mesh, out_mesh_axis);
-
-      // 4.3 Calculate the input one dim dist attr
-      TensorDistAttr in_one_dim_dist_attr(common::vectorize(in.dims()));
-      in_one_dim_dist_attr.set_process_mesh(sub_mesh);
-
-      // 4.4 Calculate the output one dim dist attr
-      TensorDistAttr out_one_dim_dist_attr(common::vectorize(in.dims()));
-      out_one_dim_dist_attr.set_process_mesh(sub_mesh);
-      std::vector<int64_t> out_one_dims_mapping =
-          out_one_dim_dist_attr.dims_mapping();
-      out_one_dims_mapping[i] = 0;
-      out_one_dim_dist_attr.set_dims_mapping(out_one_dims_mapping);
-
-      // 4.5 Change from replicated to shard
-      DistTensor tmp_result;
-      SetDistProps(out, in_one_dim_dist_attr);
-      if (is_partial) {
-        PToSReshardFunction func;
-        func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
-      } else {
-        RToSReshardFunction func;
-        func.Eval(dev_ctx, *out, out_one_dim_dist_attr, &tmp_result);
-      }
-      // 4.6 Reset to the right dist attr
-      SetValue(out, tmp_result.value());
-      SetDistProps(out, real_out_dist_attr);
-    }
-  }
+  // 5. Reset to the right dist attr
+  SetValue(out, tmp_result.value());
+  SetDistProps(out, global_dims, real_out_dist_attr);
 }
 
 bool CrossNdMeshReshardFunction::IsSuitable(
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "paddle/phi/core/distributed/auto_parallel/reshard/nd_mesh_reshard_planner.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/reshard_function.h"
 
 namespace phi {
@@ -30,6 +31,13 @@ class SameNdMeshReshardFunction final : public ReshardFunction {
             DistTensor* out) override;
 
   std::string Name() override { return "SameNdMeshReshard"; }
+
+ private:
+  // Run the step as a 1-D reshard on the sub mesh along its mesh dim.
+  void EvalStep(DeviceContext* dev_ctx,
+                const DDim& global_dims,
+                const NdMeshReshardStep& step,
+                DistTensor* out);
 };
 
 class CrossNdMeshReshardFunction final : public ReshardFunction {
@@ -0,0 +1,451 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/distributed/auto_parallel/reshard/nd_mesh_reshard_planner.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace phi::distributed {
+
+namespace {
+
+// The status of a tensor along a mesh dim is replicated, partial with the
+// reduce type of the input, partial with the one of the output, or the tensor
+// dim it shards.
+constexpr int64_t kReplicated = -1;
+constexpr int64_t kPartialIn = -2;
+constexpr int64_t kPartialOut = -3;
+
+using MeshStatus = std::vector<int64_t>;
+
+// The figures of the cost model, in seconds and bytes per second. Only their
+// ratios matter to the choice of a plan.
+constexpr double kIntraNodeLatency = 5e-6;
+constexpr double kInterNodeLatency = 2e-5;
+constexpr double kIntraNodeBandwidth = 1e11;
+constexpr double kInterNodeBandwidth = 1.25e10;
+constexpr double kMemoryBandwidth = 1e12;
+// The launch of the kernels of a step, so that the plans of fewer steps are
+// preferred for the same traffic.
+constexpr double kStepOverhead = 1e-5;
+
+struct PlanContext {
+  std::vector<int64_t> global_dims;
+  std::vector<int64_t> mesh_shape;
+  double global_bytes;
+  // The reduce types of the partial status on each mesh dim.
+  std::vector<ReduceType> in_reduce_types;
+  std::vector<ReduceType> out_reduce_types;
+  MeshStatus source;
+  MeshStatus target;
+};
+
+MeshStatus GetMeshStatus(const TensorDistAttr& dist_attr,
+                         int64_t partial,
+                         std::vector<ReduceType>* reduce_types) {
+  int64_t mesh_ndim = dist_attr.process_mesh().ndim();
+  MeshStatus status(mesh_ndim, kReplicated);
+  reduce_types->assign(mesh_ndim, ReduceType::kRedSum);
+  const auto& dims_mapping = dist_attr.dims_mapping();
+  for (int64_t i = 0; i < static_cast<int64_t>(dims_mapping.size()); ++i) {
+    if (dims_mapping[i] >= 0) {
+      status[dims_mapping[i]] = i;
+    }
+  }
+  for (const auto& kv : dist_attr.partial_status()) {
+    status[kv.first] = partial;
+    (*reduce_types)[kv.first] = kv.second;
+  }
+  return status;
+}
+
+PlanContext MakePlanContext(const std::vector<int64_t>& global_dims,
+                            DataType dtype,
+                            const TensorDistAttr& in_dist_attr,
+                            const TensorDistAttr& out_dist_attr) {
+  PlanContext ctx;
+  ctx.global_dims = global_dims;
+  ctx.mesh_shape = out_dist_attr.process_mesh().shape();
+  ctx.global_bytes = static_cast<double>(SizeOf(dtype));
+  for (int64_t dim : global_dims) {
+    ctx.global_bytes *= static_cast<double>(std::max<int64_t>(dim, 0));
+  }
+  ctx.source = GetMeshStatus(in_dist_attr, kPartialIn, &ctx.in_reduce_types);
+  ctx.target = GetMeshStatus(out_dist_attr, kPartialOut, &ctx.out_reduce_types);
+  // A partial status kept with the same reduce type needs no step.
+  for (size_t i = 0; i < ctx.target.size(); ++i) {
+    if (ctx.source[i] == kPartialIn && ctx.target[i] == kPartialOut &&
+        ctx.in_reduce_types[i] == ctx.out_reduce_types[i]) {
+      ctx.target[i] = kPartialIn;
+    }
+  }
+  return ctx;
+}
+
+double LocalBytes(const PlanContext& ctx, const MeshStatus& status) {
+  double local_bytes = ctx.global_bytes;
+  for (size_t i = 0; i < status.size(); ++i) {
+    if (status[i] >= 0) {
+      local_bytes /= static_cast<double>(ctx.mesh_shape[i]);
+    }
+  }
+  return local_bytes;
+}
+
+NdMeshReshardStep MakeStep(NdMeshReshardStep::Type type,
+                           int64_t mesh_axis,
+                           int64_t in_tensor_axis,
+                           int64_t out_tensor_axis,
+                           ReduceType reduce_type = ReduceType::kRedSum) {
+  NdMeshReshardStep step;
+  step.type = type;
+  step.mesh_axis = mesh_axis;
+  step.in_tensor_axis = in_tensor_axis;
+  step.out_tensor_axis = out_tensor_axis;
+  step.reduce_type = reduce_type;
+  return step;
+}
+
+void ApplyStep(const NdMeshReshardStep& step, MeshStatus* status) {
+  using Type = NdMeshReshardStep::Type;
+  switch (step.type) {
+    case Type::kPToR:
+    case Type::kSToR:
+      (*status)[step.mesh_axis] = kReplicated;
+      break;
+    case Type::kPToS:
+    case Type::kSToS:
+    case Type::kRToS:
+      (*status)[step.mesh_axis] = step.out_tensor_axis;
+      break;
+    case Type::kRToP:
+      (*status)[step.mesh_axis] = kPartialOut;
+      break;
+  }
+}
+
+double PlanCost(const PlanContext& ctx,
+                const NdMeshReshardCostModel& cost_model,
+                const std::vector<NdMeshReshardStep>& steps) {
+  MeshStatus status = ctx.source;
+  double cost = 0.0;
+  for (const auto& step : steps) {
+    cost += cost_model.StepCost(step, LocalBytes(ctx, status));
+    ApplyStep(step, &status);
+  }
+  return cost;
+}
+
+// Whether no mesh dim other than mesh_axis shards tensor_axis.
+bool IsFree(const MeshStatus& status, int64_t mesh_axis, int64_t tensor_axis) {
+  for (size_t i = 0; i < status.size(); ++i) {
+    if (static_cast<int64_t>(i) != mesh_axis && status[i] == tensor_axis) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsDivisible(const PlanContext& ctx, int64_t tensor_axis, int64_t n) {
+  int64_t dim = ctx.global_dims[tensor_axis];
+  return dim > 0 && dim % n == 0;
+}
+
+// The steps from status moving one mesh dim not yet in its target status.
+// The reduce-scatter only sums, and the all-to-all only exchanges evenly
+// split dims.
+std::vector<NdMeshReshardStep> NextSteps(const PlanContext& ctx,
+                                         const MeshStatus& status) {
+  using Type = NdMeshReshardStep::Type;
+  std::vector<NdMeshReshardStep> steps;
+  int64_t tensor_ndim = static_cast<int64_t>(ctx.global_dims.size());
+  for (int64_t axis = 0; axis < static_cast<int64_t>(status.size()); ++axis) {
+    int64_t cur = status[axis];
+    int64_t want = ctx.target[axis];
+    int64_t n = ctx.mesh_shape[axis];
+    if (cur == want) continue;
+    if (cur == kPartialIn) {
+      ReduceType reduce_type = ctx.in_reduce_types[axis];
+      steps.push_back(MakeStep(Type::kPToR, axis, -1, -1, reduce_type));
+      if (reduce_type != ReduceType::kRedSum) continue;
+      for (int64_t i = 0; i < tensor_ndim; ++i) {
+        bool useful =
+            i == want || (want == kReplicated && IsDivisible(ctx, i, n));
+        if (useful && IsFree(status, axis, i)) {
+          steps.push_back(MakeStep(Type::kPToS, axis, -1, i, reduce_type));
+        }
+      }
+    } else if (cur >= 0) {
+      steps.push_back(MakeStep(Type::kSToR, axis, cur, -1));
+      if (want >= 0 && IsFree(status, axis, want) &&
+          IsDivisible(ctx, cur, n) && IsDivisible(ctx, want, n)) {
+        steps.push_back(MakeStep(Type::kSToS, axis, cur, want));
+      }
+    } else if (cur == kReplicated) {
+      if (want >= 0 && IsFree(status, axis, want)) {
+        steps.push_back(MakeStep(Type::kRToS, axis, -1, want));
+      } else if (want == kPartialOut) {
+        steps.push_back(MakeStep(
+            Type::kRToP, axis, -1, -1, ctx.out_reduce_types[axis]));
+      }
+    }
+  }
+  return steps;
+}
+
+// Given the input two dist_attr, traversing from high-dimension axis to
+// low-dimension. Find and return the first different axis which is shard status
+// between these two. For example, the input two dims_mapping are [-1, 0, -1,
+// -1] and [-1, -1, 0, -1], the first diff shard axis is 2.
+int64_t FindFirstDiffShardAxis(const TensorDistAttr& in_dist_attr,
+                               const TensorDistAttr& out_dist_attr) {
+  const auto& in_dims_mapping = in_dist_attr.dims_mapping();
+  const auto& out_dims_mapping = out_dist_attr.dims_mapping();
+  int64_t axis = -1;
+
+  for (int64_t i = static_cast<int64_t>(in_dims_mapping.size() - 1); i >= 0;
+       --i) {
+    if (in_dims_mapping[i] != out_dims_mapping[i]) {
+      axis = i;
+      break;
+    }
+  }
+
+  return axis;
+}
+
+std::string StepTypeName(NdMeshReshardStep::Type type) {
+  using Type = NdMeshReshardStep::Type;
+  switch (type) {
+    case Type::kPToR:
+      return "p_to_r";
+    case Type::kPToS:
+      return "p_to_s";
+    case Type::kSToR:
+      return "s_to_r";
+    case Type::kSToS:
+      return "s_to_s";
+    case Type::kRToS:
+      return "r_to_s";
+    case Type::kRToP:
+      return "r_to_p";
+  }
+  return "unknown";
+}
+
+}  // namespace
+
+std::string NdMeshReshardStep::to_string() const {
+  std::ostringstream oss;
+  oss << StepTypeName(type) << "(mesh_axis=" << mesh_axis;
+  if (in_tensor_axis >= 0) {
+    oss << ", in_tensor_axis=" << in_tensor_axis;
+  }
+  if (out_tensor_axis >= 0) {
+    oss << ", out_tensor_axis=" << out_tensor_axis;
+  }
+  oss << ")";
+  return oss.str();
+}
+
+std::string NdMeshReshardPlan::to_string() const {
+  std::ostringstream oss;
+  oss << "[";
+  for (size_t i = 0; i < steps.size(); ++i) {
+    oss << (i == 0 ? "" : ", ") << steps[i].to_string();
+  }
+  oss << "], cost: " << cost;
+  return oss.str();
+}
+
+NdMeshReshardCostModel::NdMeshReshardCostModel(
+    const ProcessMesh& process_mesh, int64_t devices_per_node)
+    : mesh_shape_(process_mesh.shape()),
+      inter_node_(process_mesh.ndim(), false) {
+  if (devices_per_node <= 0) return;
+  const auto& process_ids = process_mesh.process_ids();
+  int64_t num_ids = static_cast<int64_t>(process_ids.size());
+  int64_t stride = 1;
+  for (int64_t axis = process_mesh.ndim() - 1; axis >= 0; --axis) {
+    int64_t dim = mesh_shape_[axis];
+    for (int64_t i = 0; i < num_ids && !inter_node_[axis]; ++i) {
+      // Compare each rank with the next one along the mesh dim.
+      if ((i / stride) % dim + 1 < dim &&
+          process_ids[i] / devices_per_node !=
+              process_ids[i + stride] / devices_per_node) {
+        inter_node_[axis] = true;
+      }
+    }
+    stride *= dim;
+  }
+}
+
+double NdMeshReshardCostModel::StepCost(const NdMeshReshardStep& step,
+                                        double local_bytes) const {
+  using Type = NdMeshReshardStep::Type;
+  double n = static_cast<double>(mesh_shape_[step.mesh_axis]);
+  bool inter_node = inter_node_[step.mesh_axis];
+  double latency = inter_node ? kInterNodeLatency : kIntraNodeLatency;
+  double bandwidth = inter_node ? kInterNodeBandwidth : kIntraNodeBandwidth;
+  double copy = local_bytes / kMemoryBandwidth;
+  switch (step.type) {
+    case Type::kPToR:
+      // A ring allreduce, which is a reduce-scatter and an allgather.
+      return kStepOverhead + 2 * (n - 1) * latency +
+             2 * (n - 1) / n * local_bytes / bandwidth;
+    case Type::kPToS:
+    case Type::kSToS:
+      // Each rank keeps 1 / n of its data, with a transpose before and after.
+      return kStepOverhead + (n - 1) * latency +
+             (n - 1) / n * local_bytes / bandwidth + 2 * copy;
+    case Type::kSToR:
+      // Each rank receives the shards of the n - 1 others.
+      return kStepOverhead + (n - 1) * latency +
+             (n - 1) * local_bytes / bandwidth + copy;
+    case Type::kRToS:
+    case Type::kRToP:
+      return kStepOverhead + copy;
+  }
+  return kStepOverhead;
+}
+
+NdMeshReshardPlan PlanNdMeshReshardByStatus(
+    const std::vector<int64_t>& global_dims,
+    DataType dtype,
+    const TensorDistAttr& in_dist_attr,
+    const TensorDistAttr& out_dist_attr,
+    const NdMeshReshardCostModel& cost_model) {
+  using Type = NdMeshReshardStep::Type;
+  PlanContext ctx =
+      MakePlanContext(global_dims, dtype, in_dist_attr, out_dist_attr);
+  NdMeshReshardPlan plan;
+  MeshStatus status = ctx.source;
+  auto add_step = [&](const NdMeshReshardStep& step) {
+    plan.steps.push_back(step);
+    ApplyStep(step, &status);
+  };
+  const auto& out_dims_mapping = out_dist_attr.dims_mapping();
+  auto is_out_shard = [&](int64_t axis) {
+    return std::find(out_dims_mapping.begin(),
+                     out_dims_mapping.end(),
+                     axis) != out_dims_mapping.end();
+  };
+  int64_t first_diff_axis = FindFirstDiffShardAxis(in_dist_attr, out_dist_attr);
+  int64_t mesh_ndim = static_cast<int64_t>(status.size());
+
+  // 1. Reduce the partial dims which are neither partial nor shard in the
+  // output.
+  for (int64_t axis = 0; axis < mesh_ndim; ++axis) {
+    if (status[axis] == kPartialIn &&
+        out_dist_attr.partial_status().count(axis) == 0 &&
+        !is_out_shard(axis)) {
+      add_step(MakeStep(Type::kPToR, axis, -1, -1, ctx.in_reduce_types[axis]));
+    }
+  }
+  // 2. Replicate the tensor dims up to the first different one.
+  for (int64_t i = first_diff_axis; i >= 0; --i) {
+    for (int64_t axis = 0; axis < mesh_ndim; ++axis) {
+      if (status[axis] == i) {
+        add_step(MakeStep(Type::kSToR, axis, i, -1));
+      }
+    }
+  }
+  // 3. Set the partial dims of the output.
+  for (int64_t axis = 0; axis < mesh_ndim; ++axis) {
+    if (out_dist_attr.partial_status().count(axis) != 0 &&
+        status[axis] != kPartialIn && status[axis] != kPartialOut) {
+      add_step(MakeStep(Type::kRToP, axis, -1, -1, ctx.out_reduce_types[axis]));
+    }
+  }
+  // 4. Shard the tensor dims up to the first different one.
+  for (int64_t i = first_diff_axis; i >= 0; --i) {
+    int64_t axis = out_dims_mapping[i];
+    if (axis == -1) continue;
+    if (status[axis] == kPartialIn) {
+      add_step(MakeStep(Type::kPToS, axis, -1, i, ctx.in_reduce_types[axis]));
+    } else {
+      add_step(MakeStep(Type::kRToS, axis, -1, i));
+    }
+  }
+  plan.cost = PlanCost(ctx, cost_model, plan.steps);
+  return plan;
+}
+
+NdMeshReshardPlan PlanNdMeshReshard(const std::vector<int64_t>& global_dims,
+                                    DataType dtype,
+                                    const TensorDistAttr& in_dist_attr,
+                                    const TensorDistAttr& out_dist_attr,
+                                    const NdMeshReshardCostModel& cost_model) {
+  PlanContext ctx =
+      MakePlanContext(global_dims, dtype, in_dist_attr, out_dist_attr);
+
+  // Dijkstra's search, the status of the tensor on each mesh dim being the
+  // nodes and the steps the edges.
+  std::map<MeshStatus, double> costs;
+  std::map<MeshStatus, std::pair<MeshStatus, NdMeshReshardStep>> prevs;
+  using Entry = std::pair<double, MeshStatus>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  costs[ctx.source] = 0.0;
+  queue.emplace(0.0, ctx.source);
+  while (!queue.empty()) {
+    Entry entry = queue.top();
+    queue.pop();
+    const MeshStatus& status = entry.second;
+    if (entry.first > costs[status]) continue;
+    if (status == ctx.target) break;
+    double local_bytes = LocalBytes(ctx, status);
+    for (const auto& step : NextSteps(ctx, status)) {
+      MeshStatus next = status;
+      ApplyStep(step, &next);
+      double cost = entry.first + cost_model.StepCost(step, local_bytes);
+      auto it = costs.find(next);
+      if (it != costs.end() && it->second <= cost) continue;
+      costs[next] = cost;
+      prevs.insert_or_assign(next, std::make_pair(status, step));
+      queue.emplace(cost, next);
+    }
+  }
+
+  if (costs.count(ctx.target) == 0) {
+    VLOG(3) << "No reshard plan found from " << in_dist_attr.to_string()
+            << " to " << out_dist_attr.to_string()
+            << ", fall back to the plan by status.";
+    return PlanNdMeshReshardByStatus(
+        global_dims, dtype, in_dist_attr, out_dist_attr, cost_model);
+  }
+  NdMeshReshardPlan plan;
+  for (MeshStatus status = ctx.target; status != ctx.source;) {
+    const auto& prev = prevs.at(status);
+    plan.steps.push_back(prev.second);
+    status = prev.first;
+  }
+  std::reverse(plan.steps.begin(), plan.steps.end());
+  plan.cost = costs[ctx.target];
+  if (VLOG_IS_ON(3)) {
+    NdMeshReshardPlan by_status = PlanNdMeshReshardByStatus(
+        global_dims, dtype, in_dist_attr, out_dist_attr, cost_model);
+    VLOG(3) << "Reshard plan: " << plan.to_string()
+            << "; plan by status: " << by_status.to_string();
+  }
+  return plan;
+}
+
+}  // namespace phi::distributed
@@ -0,0 +1,97 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "paddle/phi/common/data_type.h"
+#include "paddle/phi/common/reduce_type.h"
+#include "paddle/phi/core/distributed/auto_parallel/dist_attr.h"
+#include "paddle/phi/core/distributed/auto_parallel/process_mesh.h"
+
+namespace phi {
+namespace distributed {
+
+// One change of the status of a tensor along one mesh dim, run as a 1-D
+// reshard on the sub mesh along that dim.
+struct NdMeshReshardStep {
+  enum class Type { kPToR, kPToS, kSToR, kSToS, kRToS, kRToP };
+
+  Type type;
+  int64_t mesh_axis;
+  // The tensor dim sharded along mesh_axis before the step, for kSToR and
+  // kSToS, and after it, for kPToS, kSToS and kRToS. -1 otherwise.
+  int64_t in_tensor_axis{-1};
+  int64_t out_tensor_axis{-1};
+  // The reduce type of the partial status, for kPToR, kPToS and kRToP.
+  ReduceType reduce_type{ReduceType::kRedSum};
+
+  std::string to_string() const;
+};
+
+struct NdMeshReshardPlan {
+  std::vector<NdMeshReshardStep> steps;
+  // The estimated time of the steps, in seconds.
+  double cost{0.0};
+
+  std::string to_string() const;
+};
+
+// An alpha-beta model of the collectives of the steps. The collectives along
+// a mesh dim whose ranks span several nodes run at the bandwidth between the
+// nodes, the others at the one within a node. The ranks of a node are taken
+// to be devices_per_node consecutive ones.
+class NdMeshReshardCostModel {
+ public:
+  NdMeshReshardCostModel(const ProcessMesh& process_mesh,
+                         int64_t devices_per_node);
+
+  // The cost of the step on a tensor of local_bytes bytes on each rank.
+  double StepCost(const NdMeshReshardStep& step, double local_bytes) const;
+
+  bool IsInterNode(int64_t mesh_axis) const { return inter_node_[mesh_axis]; }
+
+ private:
+  std::vector<int64_t> mesh_shape_;
+  std::vector<bool> inter_node_;
+};
+
+// The plan SameNdMeshReshardFunction followed before the planner: the
+// partial dims not kept are reduced, all the tensor dims up to the last
+// changed one are replicated, then the partial and shard status of the
+// output are set.
+NdMeshReshardPlan PlanNdMeshReshardByStatus(
+    const std::vector<int64_t>& global_dims,
+    DataType dtype,
+    const TensorDistAttr& in_dist_attr,
+    const TensorDistAttr& out_dist_attr,
+    const NdMeshReshardCostModel& cost_model);
+
+// The cheapest plan found by a shortest path search over the status of the
+// tensor on each mesh dim. Besides the direct transitions of each mesh dim,
+// the search weighs the shard to shard ones through an all-to-all, the
+// partial to replicated ones through a reduce-scatter and an allgather, and
+// every order of the steps, e.g. slicing along one mesh dim before
+// gathering along another so that less data is gathered. Falls back to
+// PlanNdMeshReshardByStatus when the search finds no plan.
+NdMeshReshardPlan PlanNdMeshReshard(const std::vector<int64_t>& global_dims,
+                                    DataType dtype,
+                                    const TensorDistAttr& in_dist_attr,
+                                    const TensorDistAttr& out_dist_attr,
+                                    const NdMeshReshardCostModel& cost_model);
+
+}  // namespace distributed
+}  // namespace phi
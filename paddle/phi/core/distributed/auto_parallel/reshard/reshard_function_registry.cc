@@ -17,6 +17,7 @@
 #include "glog/logging.h"
 
 #include "paddle/phi/core/distributed/auto_parallel/dist_tensor.h"
+#include "paddle/phi/core/distributed/auto_parallel/inferspmd_cache.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/global_and_sub_mesh_reshard_function.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/nd_mesh_reshard_function.h"
 #include "paddle/phi/core/distributed/auto_parallel/reshard/p_to_r_reshard_function.h"
@@ -35,9 +36,24 @@ namespace distributed {
 
 ReshardFunction* ChooseProperReshardFunction(
     const DistTensor& in, const TensorDistAttr& out_dist_attr) {
+  // The suitable functions only depend on the dist attrs, so the choice is
+  // cached by them.
+  thread_local SpmdCache<ReshardFunction*> cache;
+  std::string key;
+  bool cacheable = SpmdCacheCapacity() > 0 &&
+                   MakeSpmdCacheKey(&key, in.dist_attr(), out_dist_attr);
+  if (cacheable) {
+    if (ReshardFunction* const* func = cache.Find(key)) {
+      VLOG(4) << "Choose cached ReshardFunction: " << (*func)->Name();
+      return *func;
+    }
+  }
   for (const auto& func : GetReshardFunctionList()) {
     if (func->IsSuitable(in, out_dist_attr)) {
       VLOG(4) << "Choose ReshardFunction: " << func->Name();
+      if (cacheable) {
+        cache.Insert(std::move(key), func.get());
+      }
       return func.get();
     }
   }
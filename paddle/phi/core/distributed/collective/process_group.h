@@ -291,6 +291,28 @@ class ProcessGroup {
         GetBackendName()));
   }
 
+  // Run the collective of many tensors, of a dtype and place, as a single
+  // one on a buffer they are flattened into. The calculation stream waits
+  // for it, as with sync_op.
+  virtual std::shared_ptr<ProcessGroup::Task> AllReduceCoalesced(
+      const std::vector<phi::DenseTensor*>& out_tensors UNUSED,
+      const std::vector<phi::DenseTensor>& in_tensors UNUSED,
+      const AllreduceOptions& opts UNUSED,
+      bool use_calc_stream UNUSED) {
+    PADDLE_THROW(common::errors::Unimplemented(
+        "ProcessGroup%s does not support coalesced all_reduce.",
+        GetBackendName()));
+  }
+
+  virtual std::shared_ptr<ProcessGroup::Task> AllGatherCoalesced(
+      const std::vector<phi::DenseTensor*>& out_tensors UNUSED,
+      const std::vector<phi::DenseTensor>& in_tensors UNUSED,
+      bool use_calc_stream UNUSED) {
+    PADDLE_THROW(common::errors::Unimplemented(
+        "ProcessGroup%s does not support coalesced all_gather.",
+        GetBackendName()));
+  }
+
   virtual std::shared_ptr<ProcessGroup::Task> AllToAll(
       phi::DenseTensor* out_tensor UNUSED,
       const phi::DenseTensor& in_tensor UNUSED,
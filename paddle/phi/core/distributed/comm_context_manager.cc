@@ -14,10 +14,12 @@
 
 #include "paddle/phi/core/distributed/comm_context_manager.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include "glog/logging.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/phi/core/distributed/store/store.h"
 #include "paddle/phi/core/enforce.h"
@@ -43,10 +45,43 @@
 #include "paddle/phi/core/distributed/xccl_comm_context.h"
 #endif
 
+COMMON_DECLARE_bool(nccl_comm_lazy_init);
+
 namespace phi::distributed {
 
 int CommContextManager::device_id = -1;
 
+namespace {
+
+double MillisecondsSince(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - begin)
+      .count();
+}
+
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+void SetNCCLCommContextDevice(NCCLCommContext* nccl_comm_context,
+                              int device_id) {
+  std::unique_ptr<phi::GPUContext> dev_ctx(
+      new phi::GPUContext(phi::GPUPlace(device_id)));
+  dev_ctx->SetAllocator(
+      phi::memory_utils::GetAllocator(device_id, dev_ctx->stream()));
+  dev_ctx->SetHostAllocator(phi::memory_utils::GetHostAllocator());
+  dev_ctx->SetZeroAllocator(phi::memory_utils::GetZeroAllocator(device_id));
+  dev_ctx->SetHostZeroAllocator(phi::memory_utils::GetHostZeroAllocator());
+  dev_ctx->SetPinnedAllocator(phi::memory_utils::GetPinnedAllocator());
+  dev_ctx->PartialInitWithAllocator();
+  auto compute_event = phi::memory_utils::GetCudaEvent(device_id);
+  auto comm_event = phi::memory_utils::GetCudaEvent(device_id);
+
+  nccl_comm_context->SetDevContext(std::move(dev_ctx));
+  nccl_comm_context->SetComputeEvent(std::move(compute_event));
+  nccl_comm_context->SetCommEvent(std::move(comm_event));
+}
+#endif
+
+}  // namespace
+
 void CommContextManager::SetDeviceId(int dev_id) {
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
   phi::backends::gpu::SetDeviceId(dev_id);
@@ -70,6 +105,45 @@ void CommContextManager::CreateNCCLCommContext(
   if (comm_context_manager.Has(unique_comm_key)) {
     return;
   }
+  if (!FLAGS_nccl_comm_lazy_init && !comm_context_manager.in_batch_init_) {
+    InitNCCLCommContext(store,
+                        unique_comm_key,
+                        rank,
+                        size,
+                        hash_key,
+                        p2p_opt,
+                        nccl_comm_init_option);
+    return;
+  }
+
+  VLOG(3) << "register NCCLCommContext unique_comm_key: " << unique_comm_key
+          << " for lazy init";
+  bool has_p2p_opt = p2p_opt != nullptr;
+  P2POption opt = has_p2p_opt ? *p2p_opt : P2POption();
+  comm_context_manager.lazy_comm_contexts_[unique_comm_key] = [=]() {
+    InitNCCLCommContext(store,
+                        unique_comm_key,
+                        rank,
+                        size,
+                        hash_key,
+                        has_p2p_opt ? &opt : nullptr,
+                        nccl_comm_init_option);
+  };
+  if (comm_context_manager.in_batch_init_) {
+    comm_context_manager.batch_init_keys_.push_back(unique_comm_key);
+  }
+}
+
+void CommContextManager::InitNCCLCommContext(
+    const std::shared_ptr<Store>& store,
+    const std::string& unique_comm_key,
+    int rank,
+    int size,
+    const std::string& hash_key,
+    const P2POption* p2p_opt,
+    int nccl_comm_init_option) {
+  auto& comm_context_manager = CommContextManager::GetInstance();
+  auto begin = std::chrono::steady_clock::now();
   ncclUniqueId nccl_id;
   if (rank == 0 || (p2p_opt && p2p_opt->is_p2p_op && p2p_opt->p2p_rank == 0)) {
     PADDLE_ENFORCE_GPU_SUCCESS(phi::dynload::ncclGetUniqueId(&nccl_id));
@@ -97,30 +171,118 @@ void CommContextManager::CreateNCCLCommContext(
   auto nccl_comm_context = std::make_unique<NCCLCommContext>(
       rank, size, nccl_id, nccl_comm_init_option);
   if (CommContextManager::device_id != -1) {
-    std::unique_ptr<phi::GPUContext> dev_ctx(
-        new phi::GPUContext(phi::GPUPlace(CommContextManager::device_id)));
-    dev_ctx->SetAllocator(phi::memory_utils::GetAllocator(
-        CommContextManager::device_id, dev_ctx->stream()));
-    dev_ctx->SetHostAllocator(phi::memory_utils::GetHostAllocator());
-    dev_ctx->SetZeroAllocator(
-        phi::memory_utils::GetZeroAllocator(CommContextManager::device_id));
-    dev_ctx->SetHostZeroAllocator(phi::memory_utils::GetHostZeroAllocator());
-    dev_ctx->SetPinnedAllocator(phi::memory_utils::GetPinnedAllocator());
-    dev_ctx->PartialInitWithAllocator();
-    auto compute_event =
-        phi::memory_utils::GetCudaEvent(CommContextManager::device_id);
-    auto comm_event =
-        phi::memory_utils::GetCudaEvent(CommContextManager::device_id);
-
-    nccl_comm_context->SetDevContext(std::move(dev_ctx));
-    nccl_comm_context->SetComputeEvent(std::move(compute_event));
-    nccl_comm_context->SetCommEvent(std::move(comm_event));
+    SetNCCLCommContextDevice(nccl_comm_context.get(),
+                             CommContextManager::device_id);
   }
 
   comm_context_manager.SetStore(store);
   comm_context_manager.Emplace(unique_comm_key, std::move(nccl_comm_context));
+  comm_context_manager.RecordInitTime(unique_comm_key,
+                                      MillisecondsSince(begin));
 }
+
+void CommContextManager::SplitNCCLCommContext(
+    const std::string& parent_comm_key,
+    const std::string& unique_comm_key,
+    int color,
+    int key) {
+#if defined(PADDLE_WITH_NCCL) && NCCL_VERSION_CODE >= 21800
+  PADDLE_ENFORCE_EQ(IsNCCLCommSplitSupported(),
+                    true,
+                    errors::Unavailable(
+                        "ncclCommSplit is not found in the loaded NCCL."));
+  auto& comm_context_manager = CommContextManager::GetInstance();
+  auto begin = std::chrono::steady_clock::now();
+  auto* parent = static_cast<NCCLCommContext*>(
+      comm_context_manager.Get(parent_comm_key));
+  ncclConfig_t config = NCCL_CONFIG_INITIALIZER;
+  ncclComm_t nccl_comm = nullptr;
+  NCCL_CHECK(phi::dynload::ncclCommSplit(parent->GetNcclComm(),
+                                         color < 0 ? NCCL_SPLIT_NOCOLOR : color,
+                                         key,
+                                         &nccl_comm,
+                                         &config));
+  if (color < 0) {
+    return;
+  }
+
+  int rank = 0;
+  int size = 0;
+  NCCL_CHECK(phi::dynload::ncclCommUserRank(nccl_comm, &rank));
+  NCCL_CHECK(phi::dynload::ncclCommCount(nccl_comm, &size));
+  VLOG(3) << "split NCCLCommContext rank: " << rank << ", size: " << size
+          << ", unique_comm_key: " << unique_comm_key
+          << " from parent_comm_key: " << parent_comm_key;
+  auto nccl_comm_context =
+      std::make_unique<NCCLCommContext>(rank, size, nccl_comm);
+  if (CommContextManager::device_id != -1) {
+    SetNCCLCommContextDevice(nccl_comm_context.get(),
+                             CommContextManager::device_id);
+  }
+  comm_context_manager.Emplace(unique_comm_key, std::move(nccl_comm_context));
+  comm_context_manager.RecordInitTime(unique_comm_key,
+                                      MillisecondsSince(begin));
+#else
+  PADDLE_THROW(errors::Unimplemented(
+      "Splitting a communicator needs NCCL 2.18 or later."));
+#endif
+}
+
+bool CommContextManager::IsNCCLCommSplitSupported() {
+#if defined(PADDLE_WITH_NCCL) && NCCL_VERSION_CODE >= 21800
+  return phi::dynload::ncclCommSplit.IsValid();
+#else
+  return false;
+#endif
+}
+#endif
+
+void CommContextManager::BeginBatchInit() {
+  auto& comm_context_manager = CommContextManager::GetInstance();
+  comm_context_manager.in_batch_init_ = true;
+}
+
+void CommContextManager::EndBatchInit() {
+  auto& comm_context_manager = CommContextManager::GetInstance();
+  comm_context_manager.in_batch_init_ = false;
+  std::vector<std::string> keys;
+  keys.swap(comm_context_manager.batch_init_keys_);
+  if (FLAGS_nccl_comm_lazy_init || keys.empty()) {
+    return;
+  }
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+  auto begin = std::chrono::steady_clock::now();
+  // The communicators are initialized by ncclGroupEnd, all together.
+  NCCL_CHECK(phi::dynload::ncclGroupStart());
+  for (const auto& key : keys) {
+    auto iter = comm_context_manager.lazy_comm_contexts_.find(key);
+    if (iter == comm_context_manager.lazy_comm_contexts_.end()) {
+      continue;
+    }
+    auto init = std::move(iter->second);
+    comm_context_manager.lazy_comm_contexts_.erase(iter);
+    init();
+  }
+  NCCL_CHECK(phi::dynload::ncclGroupEnd());
+  double ms = MillisecondsSince(begin);
+  for (const auto& key : keys) {
+    comm_context_manager.comm_init_times_[key] = ms;
+  }
+  LOG(INFO) << "Created " << keys.size() << " communicators at once in " << ms
+            << " ms.";
 #endif
+}
+
+std::unordered_map<std::string, double> CommContextManager::GetCommInitTimes() {
+  return CommContextManager::GetInstance().comm_init_times_;
+}
+
+void CommContextManager::RecordInitTime(const std::string& unique_comm_key,
+                                        double ms) {
+  comm_init_times_[unique_comm_key] = ms;
+  LOG(INFO) << "Created communicator " << unique_comm_key << " in " << ms
+            << " ms.";
+}
 
 #if defined(PADDLE_WITH_GLOO)
 void CommContextManager::CreateGlooCommContext(
@@ -249,6 +411,12 @@ CommContext* CommContextManager::Emplace(
 }
 
 CommContext* CommContextManager::Get(const std::string& unique_comm_key) const {
+  auto lazy_iter = lazy_comm_contexts_.find(unique_comm_key);
+  if (lazy_iter != lazy_comm_contexts_.end()) {
+    auto init = std::move(lazy_iter->second);
+    lazy_comm_contexts_.erase(lazy_iter);
+    init();
+  }
   PADDLE_ENFORCE_NE(
       id_to_comm_context_.find(unique_comm_key),
       id_to_comm_context_.end(),
@@ -270,7 +438,9 @@ int CommContextManager::GetRingId(const ncclComm_t& comm) const {
 #endif
 
 bool CommContextManager::Has(const std::string& unique_comm_key) const {
-  return id_to_comm_context_.find(unique_comm_key) != id_to_comm_context_.end();
+  return id_to_comm_context_.find(unique_comm_key) !=
+             id_to_comm_context_.end() ||
+         lazy_comm_contexts_.find(unique_comm_key) != lazy_comm_contexts_.end();
 }
 
 void CommContextManager::SetGroupSize(const std::string& pg_key, int size) {
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -79,8 +80,33 @@ class CommContextManager {
                                     const std::string& hash_key = "",
                                     const P2POption* opt = nullptr,
                                     int nccl_comm_init_option = 0);
+
+  // Creates the communicator of unique_comm_key out of the one of
+  // parent_comm_key by ncclCommSplit, which reuses the connections of the
+  // parent instead of a bootstrap through the store. Collective over all the
+  // ranks of the parent, those out of the new communicator passing a
+  // negative color. The ranks in the new communicator follow key.
+  static void SplitNCCLCommContext(const std::string& parent_comm_key,
+                                   const std::string& unique_comm_key,
+                                   int color,
+                                   int key);
+
+  static bool IsNCCLCommSplitSupported();
 #endif
 
+  // Between BeginBatchInit and EndBatchInit, and always with
+  // FLAGS_nccl_comm_lazy_init, CreateNCCLCommContext only registers the
+  // communicator, which is created on its first Get. EndBatchInit creates
+  // those registered in the batch at once, so that the initializations of
+  // independent groups overlap, unless FLAGS_nccl_comm_lazy_init leaves them
+  // to their first use.
+  static void BeginBatchInit();
+  static void EndBatchInit();
+
+  // The time in milliseconds each communicator took to create. The ones
+  // created at once by EndBatchInit share the time of the batch.
+  static std::unordered_map<std::string, double> GetCommInitTimes();
+
 #if defined(PADDLE_WITH_GLOO)
   static void CreateGlooCommContext(const std::shared_ptr<Store>& store,
                                     const std::string& unique_comm_key,
@@ -108,8 +134,26 @@ class CommContextManager {
  private:
   DISABLE_COPY_AND_ASSIGN(CommContextManager);
 
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+  static void InitNCCLCommContext(const std::shared_ptr<Store>& store,
+                                  const std::string& unique_comm_key,
+                                  int rank,
+                                  int size,
+                                  const std::string& hash_key,
+                                  const P2POption* opt,
+                                  int nccl_comm_init_option);
+#endif
+
+  void RecordInitTime(const std::string& unique_comm_key, double ms);
+
   std::unordered_map<std::string, std::unique_ptr<CommContext>>
       id_to_comm_context_;
+  // The communicators registered to be created on their first Get.
+  mutable std::unordered_map<std::string, std::function<void()>>
+      lazy_comm_contexts_;
+  bool in_batch_init_ = false;
+  std::vector<std::string> batch_init_keys_;
+  std::unordered_map<std::string, double> comm_init_times_;
   std::shared_ptr<Store> store_;
   static int device_id;
 
@@ -0,0 +1,336 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/distributed/comm_flight_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#include "paddle/phi/core/distributed/nccl_tools.h"
+
+COMMON_DECLARE_int32(comm_flight_recorder_size);
+COMMON_DECLARE_string(comm_flight_recorder_dump_path);
+
+namespace phi::distributed {
+
+namespace {
+
+int64_t HostMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+#ifdef PADDLE_WITH_CUDA
+gpuEvent_t CreateTimingEvent() {
+  gpuEvent_t event;
+  CUDA_CHECK(cudaEventCreate(&event));
+  return event;
+}
+
+void DestroyEvent(gpuEvent_t event) { CUDA_CHECK(cudaEventDestroy(event)); }
+
+void RecordEvent(gpuEvent_t event, gpuStream_t stream) {
+  CUDA_CHECK(cudaEventRecord(event, stream));
+}
+
+void SynchronizeEvent(gpuEvent_t event) {
+  CUDA_CHECK(cudaEventSynchronize(event));
+}
+
+bool QueryEvent(gpuEvent_t event) {
+  cudaError_t ret = cudaEventQuery(event);
+  if (ret == cudaSuccess) {
+    return true;
+  } else if (ret != cudaErrorNotReady) {
+    CUDA_CHECK(ret);
+  } else {
+    // ignore and clear the error if not ready
+    CUDA_CHECK(cudaGetLastError());
+  }
+  return false;
+}
+
+// Returns false if either event has not completed yet.
+bool ElapsedMillis(gpuEvent_t from, gpuEvent_t to, float* ms) {
+  cudaError_t ret = cudaEventElapsedTime(ms, from, to);
+  if (ret == cudaSuccess) {
+    return true;
+  } else if (ret != cudaErrorNotReady) {
+    CUDA_CHECK(ret);
+  } else {
+    CUDA_CHECK(cudaGetLastError());
+  }
+  return false;
+}
+#else  // PADDLE_WITH_HIP
+gpuEvent_t CreateTimingEvent() {
+  gpuEvent_t event;
+  HIP_CHECK(hipEventCreate(&event));
+  return event;
+}
+
+void DestroyEvent(gpuEvent_t event) { HIP_CHECK(hipEventDestroy(event)); }
+
+void RecordEvent(gpuEvent_t event, gpuStream_t stream) {
+  HIP_CHECK(hipEventRecord(event, stream));
+}
+
+void SynchronizeEvent(gpuEvent_t event) {
+  HIP_CHECK(hipEventSynchronize(event));
+}
+
+bool QueryEvent(gpuEvent_t event) {
+  hipError_t ret = hipEventQuery(event);
+  if (ret == hipSuccess) {
+    return true;
+  } else if (ret != hipErrorNotReady) {
+    HIP_CHECK(ret);
+  } else {
+    // ignore and clear the error if not ready
+    HIP_CHECK(hipGetLastError());
+  }
+  return false;
+}
+
+bool ElapsedMillis(gpuEvent_t from, gpuEvent_t to, float* ms) {
+  hipError_t ret = hipEventElapsedTime(ms, from, to);
+  if (ret == hipSuccess) {
+    return true;
+  } else if (ret != hipErrorNotReady) {
+    HIP_CHECK(ret);
+  } else {
+    HIP_CHECK(hipGetLastError());
+  }
+  return false;
+}
+#endif
+
+// The size and the bus bandwidth factor of an op as nccl-tests defines them,
+// from the bytes of the tensor it is issued on, which is the input one.
+double AlgorithmBytes(CommType comm_type, int64_t bytes, int nranks) {
+  if (comm_type == CommType::ALLGATHER) {
+    return static_cast<double>(bytes) * nranks;
+  }
+  return static_cast<double>(bytes);
+}
+
+double BusBandwidthFactor(CommType comm_type, int nranks) {
+  switch (comm_type) {
+    case CommType::ALLREDUCE:
+      return 2.0 * (nranks - 1) / nranks;
+    case CommType::ALLGATHER:
+    case CommType::REDUCE_SCATTER:
+    case CommType::ALLTOALL:
+      return static_cast<double>(nranks - 1) / nranks;
+    default:
+      return 1.0;
+  }
+}
+
+}  // namespace
+
+bool CommFlightRecorder::IsEnabled() {
+  return FLAGS_comm_flight_recorder_size > 0;
+}
+
+const CommFlightRecorder::Reference& CommFlightRecorder::GetReference(
+    int device, gpuStream_t stream) {
+  auto iter = references_.find(device);
+  if (iter != references_.end()) {
+    return iter->second;
+  }
+  // Synchronizes once per device, at its first recorded op.
+  Reference reference;
+  reference.event = CreateTimingEvent();
+  RecordEvent(reference.event, stream);
+  SynchronizeEvent(reference.event);
+  reference.host_us = HostMicros();
+  return references_.emplace(device, reference).first->second;
+}
+
+CommFlightRecorder::Handle CommFlightRecorder::RecordStart(
+    const std::string& group_key,
+    const phi::Place& place,
+    int nranks,
+    uint64_t seq,
+    CommType comm_type,
+    int64_t numel,
+    phi::DataType dtype,
+    gpuStream_t stream,
+    bool grouped) {
+  if (!IsEnabled()) {
+    return Handle();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& ring = rings_[group_key];
+  if (!ring) {
+    ring = std::make_unique<Ring>();
+    ring->group_key = group_key;
+    ring->nranks = nranks;
+    ring->entries.resize(FLAGS_comm_flight_recorder_size);
+    ring_order_.push_back(group_key);
+  }
+
+  backends::gpu::GPUDeviceGuard guard(place.device);
+  GetReference(place.device, stream);
+
+  size_t slot = ring->next_id % ring->entries.size();
+  Entry& entry = ring->entries[slot];
+  gpuEvent_t start_event = entry.start_event;
+  gpuEvent_t end_event = entry.end_event;
+  if (start_event != nullptr && entry.device != place.device) {
+    backends::gpu::GPUDeviceGuard old_guard(entry.device);
+    DestroyEvent(start_event);
+    DestroyEvent(end_event);
+    start_event = nullptr;
+  }
+  if (start_event == nullptr) {
+    start_event = CreateTimingEvent();
+    end_event = CreateTimingEvent();
+  }
+
+  entry = Entry();
+  entry.id = ring->next_id++;
+  entry.seq = seq;
+  entry.comm_type = comm_type;
+  entry.numel = numel;
+  entry.dtype = dtype;
+  entry.stream = stream;
+  entry.device = place.device;
+  entry.grouped = grouped;
+  entry.enqueue_us = HostMicros();
+  entry.start_event = start_event;
+  entry.end_event = end_event;
+  RecordEvent(start_event, stream);
+  return Handle{ring.get(), slot, entry.id};
+}
+
+void CommFlightRecorder::RecordEnd(const Handle& handle) {
+  if (handle.ring == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry& entry = handle.ring->entries[handle.slot];
+  if (entry.id != handle.id || entry.ended) {
+    return;
+  }
+  backends::gpu::GPUDeviceGuard guard(entry.device);
+  RecordEvent(entry.end_event, entry.stream);
+  entry.ended = true;
+}
+
+void CommFlightRecorder::UpdateTimes(Entry* entry) {
+  if (entry->completed || !entry->ended) {
+    return;
+  }
+  const Reference& reference = references_.at(entry->device);
+  float start_ms = 0.0f;
+  float end_ms = 0.0f;
+  if (ElapsedMillis(reference.event, entry->start_event, &start_ms) &&
+      ElapsedMillis(reference.event, entry->end_event, &end_ms)) {
+    entry->start_us =
+        reference.host_us + static_cast<int64_t>(start_ms * 1000.0);
+    entry->end_us = reference.host_us + static_cast<int64_t>(end_ms * 1000.0);
+    entry->completed = true;
+  }
+}
+
+std::string CommFlightRecorder::EntryToString(const Ring& ring, Entry* entry) {
+  backends::gpu::GPUDeviceGuard guard(entry->device);
+  UpdateTimes(entry);
+
+  std::string state = "completed";
+  if (!entry->completed) {
+    state = QueryEvent(entry->start_event) ? "started" : "enqueued";
+  }
+  int64_t bytes = entry->numel * static_cast<int64_t>(SizeOf(entry->dtype));
+
+  std::ostringstream out;
+  out << "id:" << entry->id << ",seq:" << entry->seq
+      << ",op:" << CommTypeToString(entry->comm_type)
+      << ",numel:" << entry->numel
+      << ",dtype:" << DataTypeToString(entry->dtype) << ",bytes:" << bytes
+      << ",device:" << entry->device << ",stream:" << entry->stream
+      << ",grouped:" << entry->grouped << ",state:" << state
+      << ",enqueue_us:" << entry->enqueue_us;
+  if (entry->completed) {
+    int64_t duration_us =
+        std::max<int64_t>(entry->end_us - entry->start_us, 1);
+    double algbw = AlgorithmBytes(entry->comm_type, bytes, ring.nranks) /
+                   duration_us / 1000.0;
+    double busbw = algbw * BusBandwidthFactor(entry->comm_type, ring.nranks);
+    out << ",start_us:" << entry->start_us << ",end_us:" << entry->end_us
+        << ",duration_us:" << duration_us << ",algbw_GBps:" << algbw
+        << ",busbw_GBps:" << busbw;
+  }
+  return out.str();
+}
+
+std::string CommFlightRecorder::Dump() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream out;
+  for (const auto& group_key : ring_order_) {
+    Ring* ring = rings_.at(group_key).get();
+    uint64_t capacity = ring->entries.size();
+    uint64_t count = std::min(ring->next_id, capacity);
+    out << "group_key:" << ring->group_key << ",nranks:" << ring->nranks
+        << ",recorded:" << ring->next_id << ",kept:" << count << "\n";
+    for (uint64_t id = ring->next_id - count; id < ring->next_id; ++id) {
+      Entry* entry = &ring->entries[id % capacity];
+      out << "  " << EntryToString(*ring, entry) << "\n";
+    }
+  }
+  return out.str();
+}
+
+void CommFlightRecorder::DumpOnHang() {
+  if (!IsEnabled()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hang_dumped_) {
+      return;
+    }
+    hang_dumped_ = true;
+  }
+
+  std::string dump = Dump();
+  if (!FLAGS_comm_flight_recorder_dump_path.empty()) {
+    const char* global_rank = std::getenv("PADDLE_TRAINER_ID");
+    std::string path = FLAGS_comm_flight_recorder_dump_path + "." +
+                       (global_rank != nullptr ? global_rank : "0");
+    std::ofstream file(path);
+    file << dump;
+    if (file.good()) {
+      LOG(WARNING) << "Dumped the comm flight recorder to " << path;
+      return;
+    }
+    LOG(WARNING) << "Failed to dump the comm flight recorder to " << path;
+  }
+  std::istringstream lines(dump);
+  std::string line;
+  while (std::getline(lines, line)) {
+    LOG(WARNING) << "CommFlightRecorder: " << line;
+  }
+}
+
+}  // namespace phi::distributed
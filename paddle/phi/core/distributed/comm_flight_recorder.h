@@ -0,0 +1,134 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/common/macros.h"
+#include "paddle/phi/backends/gpu/gpu_decls.h"
+#include "paddle/phi/common/data_type.h"
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/distributed/utils.h"
+
+namespace phi {
+namespace distributed {
+
+// Keeps the last FLAGS_comm_flight_recorder_size collectives of every group in
+// a ring buffer: the op, its size, dtype and stream, and when it was enqueued,
+// started and ended. The start and end are timed by cuda events recorded
+// around the nccl call on its stream, which are only queried when dumping, so
+// recording does not synchronize anything.
+//
+// The timestamps are microseconds since the epoch, the gpu ones being mapped
+// to the host clock by a reference event per device, so the dumps of
+// different ranks can be compared to find the stragglers.
+class CommFlightRecorder {
+ public:
+  struct Entry;
+  struct Ring;
+
+  // What RecordStart returns to pass to RecordEnd, empty when the recorder
+  // is off.
+  struct Handle {
+    Ring* ring{nullptr};
+    size_t slot{0};
+    uint64_t id{0};
+  };
+
+  static CommFlightRecorder& GetInstance() {
+    static CommFlightRecorder instance;
+    return instance;
+  }
+
+  static bool IsEnabled();
+
+  // Ops issued in an nccl group (grouped) are only launched at the end of
+  // the group, so their start and end events only time the enqueueing.
+  Handle RecordStart(const std::string& group_key,
+                     const phi::Place& place,
+                     int nranks,
+                     uint64_t seq,
+                     CommType comm_type,
+                     int64_t numel,
+                     phi::DataType dtype,
+                     gpuStream_t stream,
+                     bool grouped = false);
+  void RecordEnd(const Handle& handle);
+
+  // One line per group and one per entry, from the oldest, with the achieved
+  // algorithm and bus bandwidths of the completed ones.
+  std::string Dump();
+  // Called by the watchdog when the collectives hang. Writes the dump to
+  // FLAGS_comm_flight_recorder_dump_path suffixed by the global rank, or logs
+  // it, once.
+  void DumpOnHang();
+
+  struct Entry {
+    uint64_t id{0};
+    uint64_t seq{0};
+    CommType comm_type{CommType::UNKNOWN};
+    int64_t numel{0};
+    phi::DataType dtype{phi::DataType::UNDEFINED};
+    gpuStream_t stream{nullptr};
+    int device{-1};
+    bool grouped{false};
+    bool ended{false};
+    int64_t enqueue_us{0};
+    // Filled in from the events once they have completed.
+    bool completed{false};
+    int64_t start_us{0};
+    int64_t end_us{0};
+    gpuEvent_t start_event{nullptr};
+    gpuEvent_t end_event{nullptr};
+  };
+
+  struct Ring {
+    std::string group_key;
+    int nranks{0};
+    uint64_t next_id{0};
+    std::vector<Entry> entries;
+  };
+
+ private:
+  CommFlightRecorder() = default;
+  // The events are not destroyed, the cuda context may be gone at exit.
+  ~CommFlightRecorder() = default;
+
+  struct Reference {
+    gpuEvent_t event{nullptr};
+    int64_t host_us{0};
+  };
+
+  const Reference& GetReference(int device, gpuStream_t stream);
+  void UpdateTimes(Entry* entry);
+  std::string EntryToString(const Ring& ring, Entry* entry);
+
+  std::mutex mutex_;
+  // The rings are never erased, so that the handles stay valid.
+  std::unordered_map<std::string, std::unique_ptr<Ring>> rings_;
+  std::vector<std::string> ring_order_;
+  std::unordered_map<int, Reference> references_;
+  bool hang_dumped_{false};
+
+  DISABLE_COPY_AND_ASSIGN(CommFlightRecorder);
+};
+
+}  // namespace distributed
+}  // namespace phi
@@ -33,6 +33,7 @@
 #include "paddle/phi/core/enforce.h"
 
 #if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+#include "paddle/phi/core/distributed/comm_flight_recorder.h"
 #include "paddle/phi/core/distributed/comm_task_manager.h"
 #include "paddle/phi/core/distributed/nccl_comm_context.h"
 #endif
@@ -162,6 +163,7 @@ void CommTaskManager::CommTaskLoop() {
           LogLongStr("Find last group comm task:", iter.second->GetTraceMsg());
         }
       }
+      CommFlightRecorder::GetInstance().DumpOnHang();
       logged_ = true;
     }
     for (auto iter = comm_task_list_.begin(); iter != comm_task_list_.end();) {
@@ -170,11 +172,13 @@ void CommTaskManager::CommTaskLoop() {
         if (!task->IsStarted()) {
           LOG(WARNING) << "Find timeout init but not start task:"
                        << task->GetTraceMsg();
+          CommFlightRecorder::GetInstance().DumpOnHang();
           std::string task_key = task->UniqueKey();
           init_comm_task_map_[task_key] = task;
         } else if (!task->IsCompleted()) {
           LOG(WARNING) << "Find timeout start but not finish task:"
                        << task->GetTraceMsg();
+          CommFlightRecorder::GetInstance().DumpOnHang();
           std::string task_key = task->UniqueKey();
           start_comm_task_map_[task_key] = task;
         }
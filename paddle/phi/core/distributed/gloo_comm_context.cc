@@ -24,11 +24,14 @@
 #include <gloo/scatter.h>
 #include <gloo/types.h>
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/distributed/check/static_check.h"
 #include "paddle/phi/core/enforce.h"
 
+COMMON_DECLARE_int64(gloo_allreduce_bcube_max_bytes);
+
 namespace phi {
 namespace distributed {
 
@@ -84,6 +87,11 @@ void GlooCommContext::AllReduce(phi::DenseTensor* out_tensor,
   gloo::AllreduceOptions opts(gloo_context_);
   opts.setTag(tag);
   const auto& dtype = in_tensor.dtype();
+  int64_t bytes = in_tensor.numel() * static_cast<int64_t>(SizeOf(dtype));
+  if (FLAGS_gloo_allreduce_bcube_max_bytes > 0 &&
+      bytes <= FLAGS_gloo_allreduce_bcube_max_bytes) {
+    opts.setAlgorithm(gloo::AllreduceOptions::Algorithm::BCUBE);
+  }
   GENERATE_FUNC(dtype, SetInput, &opts, in_tensor);
   GENERATE_FUNC(dtype, SetOutput, &opts, out_tensor);
   GENERATE_FUNC(dtype, SetReduceFunc, &opts, reduce_type);
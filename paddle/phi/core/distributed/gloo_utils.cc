@@ -26,7 +26,13 @@
 #include <cstdlib>
 #include <cstring>
 
+#if defined(PADDLE_WITH_AVX512F) && !defined(_WIN32)
+#include <immintrin.h>
+#define PADDLE_GLOO_AVX512_SUM
+#endif
+
 #include "paddle/common/errors.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
 #include "paddle/phi/core/distributed/gloo_utils.h"
 #include "paddle/phi/core/distributed/store/tcp_utils.h"
 #include "paddle/phi/core/enforce.h"
@@ -90,6 +96,137 @@ std::shared_ptr<gloo::transport::Device> CreateGlooDevice() {
   }
 }
 
+#ifdef PADDLE_GLOO_AVX512_SUM
+namespace {
+
+// The functions of AVX-512 are compiled for it whatever the flags of the
+// file, and only called when the CPU supports it.
+#define GLOO_AVX512 __attribute__((target("avx512f")))
+
+GLOO_AVX512 void Avx512SumFloat(float* c,
+                                const float* a,
+                                const float* b,
+                                size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(
+        c + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+  }
+  for (; i < n; ++i) {
+    c[i] = a[i] + b[i];
+  }
+}
+
+GLOO_AVX512 __m512 LoadFloat16(const uint16_t* p) {
+  return _mm512_cvtph_ps(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+}
+
+GLOO_AVX512 void StoreFloat16(uint16_t* p, __m512 v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),
+                      _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+GLOO_AVX512 __m512 LoadBFloat16(const uint16_t* p) {
+  __m512i x = _mm512_cvtepu16_epi32(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+  return _mm512_castsi512_ps(_mm512_slli_epi32(x, 16));
+}
+
+// Rounds to the nearest even as cpu_float_to_bfloat16, with the NaNs stored
+// as 0x7FFF.
+GLOO_AVX512 void StoreBFloat16(uint16_t* p, __m512 v) {
+  __m512i x = _mm512_castps_si512(v);
+  __m512i lsb =
+      _mm512_and_si512(_mm512_srli_epi32(x, 16), _mm512_set1_epi32(1));
+  __m512i bias = _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF));
+  __m512i rounded = _mm512_add_epi32(x, bias);
+  __mmask16 nan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+  rounded =
+      _mm512_mask_blend_epi32(nan, rounded, _mm512_set1_epi32(0x7FFF << 16));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),
+                      _mm512_cvtepi32_epi16(_mm512_srli_epi32(rounded, 16)));
+}
+
+// The sum of 16-bit floats, added in float. Returns the number of elements
+// added, the tail of less than 16 elements is left to the caller.
+template <__m512 (*Load)(const uint16_t*), void (*Store)(uint16_t*, __m512)>
+GLOO_AVX512 size_t Avx512SumHalf(uint16_t* c,
+                                 const uint16_t* a,
+                                 const uint16_t* b,
+                                 size_t n) {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    Store(c + i, _mm512_add_ps(Load(a + i), Load(b + i)));
+  }
+  return i;
+}
+
+#undef GLOO_AVX512
+
+bool UseAvx512() {
+  static const bool use_avx512 =
+      phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f);
+  return use_avx512;
+}
+
+}  // namespace
+#endif
+
+template <>
+void GlooSum<float>(void* c, const void* a, const void* b, size_t n) {
+#ifdef PADDLE_GLOO_AVX512_SUM
+  if (UseAvx512()) {
+    Avx512SumFloat(static_cast<float*>(c),
+                   static_cast<const float*>(a),
+                   static_cast<const float*>(b),
+                   n);
+    return;
+  }
+#endif
+  gloo::sum<float>(c, a, b, n);
+}
+
+template <>
+void GlooSum<gloo::float16>(void* c, const void* a, const void* b, size_t n) {
+  size_t done = 0;
+#ifdef PADDLE_GLOO_AVX512_SUM
+  if (UseAvx512()) {
+    done = Avx512SumHalf<LoadFloat16, StoreFloat16>(
+        static_cast<uint16_t*>(c),
+        static_cast<const uint16_t*>(a),
+        static_cast<const uint16_t*>(b),
+        n);
+  }
+#endif
+  gloo::sum<gloo::float16>(static_cast<gloo::float16*>(c) + done,
+                           static_cast<const gloo::float16*>(a) + done,
+                           static_cast<const gloo::float16*>(b) + done,
+                           n - done);
+}
+
+template <>
+void GlooSum<phi::dtype::bfloat16>(void* c,
+                                   const void* a,
+                                   const void* b,
+                                   size_t n) {
+  size_t done = 0;
+#ifdef PADDLE_GLOO_AVX512_SUM
+  if (UseAvx512()) {
+    done = Avx512SumHalf<LoadBFloat16, StoreBFloat16>(
+        static_cast<uint16_t*>(c),
+        static_cast<const uint16_t*>(a),
+        static_cast<const uint16_t*>(b),
+        n);
+  }
+#endif
+  gloo::sum<phi::dtype::bfloat16>(
+      static_cast<phi::dtype::bfloat16*>(c) + done,
+      static_cast<const phi::dtype::bfloat16*>(a) + done,
+      static_cast<const phi::dtype::bfloat16*>(b) + done,
+      n - done);
+}
+
 void send_recv(SendRecvOptions* opts) {
   const auto& context = opts->context;
   gloo::transport::UnboundBuffer* in = opts->in.get();
@@ -48,6 +48,11 @@ NCCLCommContext::NCCLCommContext(int rank,
   NCCL_CHECK(phi::dynload::ncclGetVersion(&nccl_version_));
 }
 
+NCCLCommContext::NCCLCommContext(int rank, int size, ncclComm_t nccl_comm)
+    : CommContext(rank, size), nccl_version_(0), nccl_comm_(nccl_comm) {
+  NCCL_CHECK(phi::dynload::ncclGetVersion(&nccl_version_));
+}
+
 int NCCLCommContext::GetNcclVersion() { return nccl_version_; }
 
 ncclComm_t NCCLCommContext::GetNcclComm() { return nccl_comm_; }
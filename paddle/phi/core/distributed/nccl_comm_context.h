@@ -43,6 +43,8 @@ class NCCLCommContext final : public CommContext {
                   int size,
                   ncclUniqueId nccl_id,
                   int nccl_comm_init_option = 0);
+  // Takes an initialized communicator, e.g. one split from another.
+  NCCLCommContext(int rank, int size, ncclComm_t nccl_comm);
   ~NCCLCommContext() override = default;
 
   int GetNcclVersion();
@@ -43,5 +43,56 @@ void Store::set(const std::string& key, const std::vector<uint8_t>& value) {
       errors::InvalidArgument("Implement the set method in the subclass."));
 }
 
+std::vector<std::vector<uint8_t>> Store::multi_get(
+    const std::vector<std::string>& keys) {
+  std::vector<std::vector<uint8_t>> values;
+  values.reserve(keys.size());
+  for (const auto& key : keys) {
+    values.emplace_back(get(key));
+  }
+  return values;
+}
+
+void Store::multi_set(const std::vector<std::string>& keys,
+                      const std::vector<std::vector<uint8_t>>& values) {
+  PADDLE_ENFORCE_EQ(
+      keys.size(),
+      values.size(),
+      errors::InvalidArgument("The number of keys (%d) and values (%d) to set "
+                              "should be equal.",
+                              keys.size(),
+                              values.size()));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    set(keys[i], values[i]);
+  }
+}
+
+void Store::barrier(const std::string& key, int rank, int world_size) {
+  PADDLE_ENFORCE_EQ(
+      rank >= 0 && rank < world_size,
+      true,
+      errors::InvalidArgument(
+          "The rank %d should be in [0, %d).", rank, world_size));
+  const std::string prefix =
+      "barrier/" + key + "/" + std::to_string(_barrier_count++) + "/";
+  std::vector<std::string> children;
+  for (int64_t child = static_cast<int64_t>(rank) * kBarrierFanout + 1;
+       child <= static_cast<int64_t>(rank + 1) * kBarrierFanout &&
+       child < world_size;
+       ++child) {
+    children.emplace_back(prefix + std::to_string(child));
+  }
+  if (!children.empty()) {
+    multi_get(children);
+  }
+  const std::vector<uint8_t> arrived{1};
+  if (rank == 0) {
+    set(prefix + "release", arrived);
+  } else {
+    set(prefix + std::to_string(rank), arrived);
+  }
+  wait(prefix + "release");
+}
+
 }  // namespace distributed
 }  // namespace phi
@@ -32,11 +32,27 @@ class Store {
   virtual bool check(const std::string& key);
   virtual void wait(const std::string& key);
   virtual void set(const std::string& key, const std::vector<uint8_t>& value);
+  // Waits for all the keys, as get does.
+  virtual std::vector<std::vector<uint8_t>> multi_get(
+      const std::vector<std::string>& keys);
+  virtual void multi_set(const std::vector<std::string>& keys,
+                         const std::vector<std::vector<uint8_t>>& values);
+  // Blocks until world_size ranks called barrier with the same key. The
+  // ranks report their arrival up a tree of fanout kBarrierFanout and are
+  // released by the root through a single key, so that no rank waits for
+  // more than kBarrierFanout keys and none polls a shared counter. All the
+  // ranks should call the barriers of a store in the same order.
+  virtual void barrier(const std::string& key, int rank, int world_size);
 
   virtual int timeout() { return _timeout; }
 
+  static constexpr int kBarrierFanout = 32;
+
  protected:
   int _timeout;
+
+ private:
+  int64_t _barrier_count = 0;
 };
 
 }  // namespace distributed
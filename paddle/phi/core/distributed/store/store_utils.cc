@@ -20,8 +20,11 @@
 // there will be symbol redefinition error on windows
 #include "paddle/phi/core/distributed/store/tcp_store.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/core/distributed/auto_parallel/utils.h"
 
+COMMON_DECLARE_int32(tcp_store_num_shards);
+
 namespace phi {
 namespace distributed {
 using auto_parallel::str_split;
@@ -80,7 +83,12 @@ std::shared_ptr<Store> CreateOrGetGlobalTCPStore() {
   bool is_master = (cur_rank == 0);
 
   static std::shared_ptr<TCPStore> store =
-      std::make_shared<TCPStore>(host, port, is_master, world_size);
+      std::make_shared<TCPStore>(host,
+                                 port,
+                                 is_master,
+                                 world_size,
+                                 /*timeout=*/900,
+                                 FLAGS_tcp_store_num_shards);
   return store;
 }
 
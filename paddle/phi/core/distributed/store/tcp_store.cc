@@ -14,6 +14,11 @@
 
 #include "paddle/phi/core/distributed/store/tcp_store.h"
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <thread>
@@ -26,6 +31,9 @@
 namespace phi::distributed::detail {
 
 constexpr int INFTIME = 10000;  // 10 seconds
+#ifdef __linux__
+constexpr int kMaxEpollEvents = 1024;
+#endif
 
 std::unique_ptr<MasterDaemon> MasterDaemon::start(SocketType socket,
                                                   int nranks,
@@ -94,6 +102,35 @@ void MasterDaemon::_notify_waiting_sockets(const std::string& key) {
   }
 }
 
+void MasterDaemon::_do_multi_set(SocketType socket) {
+  auto num_keys = tcputils::receive_value<size_t>(socket);
+  VLOG(8) << "MasterDaemon::_do_multi_set " << num_keys << " keys "
+          << GetSockName(socket);
+  for (size_t i = 0; i < num_keys; ++i) {
+    std::string key = tcputils::receive_string(socket);
+    _store[key] = tcputils::receive_vector<uint8_t>(socket);
+    _notify_waiting_sockets(key);
+  }
+}
+
+void MasterDaemon::_do_multi_get(SocketType socket) {
+  auto num_keys = tcputils::receive_value<size_t>(socket);
+  VLOG(8) << "MasterDaemon::_do_multi_get " << num_keys << " keys "
+          << GetSockName(socket);
+  std::vector<std::string> keys(num_keys);
+  for (auto& key : keys) {
+    key = tcputils::receive_string(socket);
+  }
+  for (const auto& key : keys) {
+    auto iter = _store.find(key);
+    PADDLE_ENFORCE_NE(
+        iter,
+        _store.end(),
+        common::errors::InvalidArgument("Key %s not found in TCPStore.", key));
+    tcputils::send_vector<uint8_t>(socket, iter->second);
+  }
+}
+
 void MasterDaemon::_do_get(SocketType socket) {
   std::string key = tcputils::receive_string(socket);
   VLOG(8) << "MasterDaemon::_do_get key(" << key << ") " << GetSockName(socket);
@@ -174,80 +211,142 @@ void MasterDaemon::_do_wait(SocketType socket) {
   }
 }
 
+bool MasterDaemon::ProcessCommand(SocketType socket) {
+  try {
+    VLOG(8) << "Plan to receive command from " << GetSockName(socket);
+    Command command = tcputils::receive_value<Command>(socket);
+    VLOG(7) << "TCPStore: recv command: " << static_cast<int>(command) << ".";
+
+    switch (command) {
+      case Command::ADD:
+        _do_add(socket);
+        break;
+      case Command::GET:
+        _do_get(socket);
+        break;
+      case Command::CHECK:
+        _do_check(socket);
+        break;
+      case Command::SET:
+        _do_set(socket);
+        break;
+      case Command::WAIT:
+        _do_wait(socket);
+        break;
+      case Command::MULTI_GET:
+        _do_multi_get(socket);
+        break;
+      case Command::MULTI_SET:
+        _do_multi_set(socket);
+        break;
+      default:
+        VLOG(8) << "Unknown command: " << static_cast<int>(command)
+                << " from addr info:" << GetSockName(socket);
+    }
+  } catch (const std::exception& ex) {
+    std::string s(ex.what());
+    if (s.find("TCP connection reset by peer") != std::string::npos) {
+      VLOG(5) << "TCP connection reset by peer";
+    } else {
+      VLOG(5) << "Meet some exceptions during run:" << ex.what();
+    }
+    return false;
+  }
+  return true;
+}
+
+void MasterDaemon::CloseSocket(SocketType socket) {
+  auto map_iter = _waiting_sockets.begin();
+  while (map_iter != _waiting_sockets.end()) {
+    auto& sockets = map_iter->second;
+    sockets.erase(std::remove(sockets.begin(), sockets.end(), socket),
+                  sockets.end());
+    if (sockets.empty()) {
+      map_iter = _waiting_sockets.erase(map_iter);
+    } else {
+      ++map_iter;
+    }
+  }
+  tcputils::close_socket(socket);
+  _sockets.erase(std::remove(_sockets.begin(), _sockets.end(), socket),
+                 _sockets.end());
+}
+
+#ifdef __linux__
+void MasterDaemon::run() {
+  int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+  PADDLE_ENFORCE_NE(
+      epoll_fd,
+      -1,
+      common::errors::Fatal("failed to create epoll errno:%d", errno));
+  auto watch = [epoll_fd](int fd) {
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    PADDLE_ENFORCE_NE(
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event),
+        -1,
+        common::errors::Fatal("failed to watch fd:%d errno:%d", fd, errno));
+  };
+  watch(_listen_socket);
+  watch(_control_fd[0]);
+
+  // Only the sockets with events are visited on a wakeup, rather than the
+  // connections of all the ranks.
+  std::vector<struct epoll_event> events(kMaxEpollEvents);
+  bool finished = false;
+  while (!finished) {
+    int num_events =
+        ::epoll_wait(epoll_fd, events.data(), kMaxEpollEvents, INFTIME);
+    if (num_events == -1) {
+      PADDLE_ENFORCE_EQ(
+          errno,
+          EINTR,
+          common::errors::Fatal("failed to wait epoll errno:%d", errno));
+      continue;
+    }
+    VLOG(9) << "begin to process events_size:"
+            << paddle::string::Sprintf("%d", num_events);
+
+    for (int i = 0; i < num_events && !finished; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == _control_fd[0]) {
+        // The control pipe receive shutdown event, and begin to close it.
+        VLOG(0)
+            << "receive shutdown event and so quit from MasterDaemon run loop";
+        finished = true;
+      } else if (fd == _listen_socket) {
+        // accept connect request.
+        auto socket = tcputils::tcp_accept(_listen_socket);
+        _sockets.emplace_back(socket);
+        watch(socket);
+      } else if (!ProcessCommand(fd)) {
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        CloseSocket(fd);
+      }
+    }
+  }
+  ::close(epoll_fd);
+}
+#else
 void MasterDaemon::ProcessCommands(std::vector<struct pollfd>* p_fds) {
   std::vector<struct pollfd>& fds = *p_fds;
-  // FIXME(gongwb): Don't loop all fds of set just the fds who have event.
 #ifdef _WIN32
   // 0: listen socket, so loop from 1.
-  for (size_t i = 1; i < fds.size(); i++) {
+  size_t i = 1;
 #else
   // 0: listen socket, 1:controller pipe, so loop from 2.
-  for (uint i = 2; i < fds.size(); i++) {
+  size_t i = 2;
 #endif
-    try {
-      if (fds[i].revents == 0) {
-        continue;
-      }
-
-      VLOG(8) << "Plan to receive command from " << GetSockName(fds[i].fd);
-      Command command = tcputils::receive_value<Command>(fds[i].fd);
-      VLOG(7) << "TCPStore: recv command: " << static_cast<int>(command) << ".";
-
-      switch (command) {
-        case Command::ADD:
-          _do_add(fds[i].fd);
-          break;
-        case Command::GET:
-          _do_get(fds[i].fd);
-          break;
-        case Command::CHECK:
-          _do_check(fds[i].fd);
-          break;
-        case Command::SET:
-          _do_set(fds[i].fd);
-          break;
-        case Command::WAIT:
-          _do_wait(fds[i].fd);
-          break;
-        default:
-          VLOG(8) << "Unknown command: " << static_cast<int>(command)
-                  << " from addr info:" << GetSockName(fds[i].fd);
-      }
-    } catch (const std::exception& ex) {
-      auto map_iter = _waiting_sockets.begin();
-      while (map_iter != _waiting_sockets.end()) {
-        auto vec_iter = map_iter->second.begin();
-        while (vec_iter != map_iter->second.end()) {
-          if (*vec_iter == fds[i].fd) {
-            vec_iter = map_iter->second.erase(vec_iter);
-          } else {
-            ++vec_iter;
-          }
-        }
-        if (map_iter->second.empty()) {
-          map_iter = _waiting_sockets.erase(map_iter);
-        } else {
-          ++map_iter;
-        }
-      }
-
-      tcputils::close_socket(fds[i].fd);
+  while (i < fds.size()) {
+    if (fds[i].revents != 0 && !ProcessCommand(fds[i].fd)) {
+      CloseSocket(fds[i].fd);
       fds.erase(fds.begin() + i);
-#ifdef _WIN32
-      _sockets.erase(_sockets.begin() + i - 1);
-#else
-      _sockets.erase(_sockets.begin() + i - 2);
-#endif
-      std::string s(ex.what());
-      if (s.find("TCP connection reset by peer") != std::string::npos) {
-        VLOG(5) << "TCP connection reset by peer";
-      } else {
-        VLOG(5) << "Meet some exceptions during run:" << ex.what();
-      }
+      continue;
     }
+    ++i;
   }
 }
-
 void MasterDaemon::run() {
   std::vector<struct pollfd> fds;
 #ifdef _WIN32
@@ -308,14 +407,18 @@ void MasterDaemon::run() {
     ProcessCommands(&fds);
   }
 }
+#endif
 
 std::unique_ptr<TCPServer> TCPServer::create(uint16_t port,
                                              int nranks,
-                                             int stop_check_timeout) {
-  int socket = tcputils::tcp_listen("", std::to_string(port), AF_INET);
+                                             int stop_check_timeout,
+                                             int num_shards) {
   auto server = std::make_unique<TCPServer>();
-  server->_master_daemon =
-      MasterDaemon::start(socket, nranks, stop_check_timeout);
+  for (int i = 0; i < num_shards; ++i) {
+    int socket = tcputils::tcp_listen("", std::to_string(port + i), AF_INET);
+    server->_master_daemons.emplace_back(
+        MasterDaemon::start(socket, nranks, stop_check_timeout));
+  }
   return server;
 }
 
@@ -333,6 +436,10 @@ void TCPClient::send_command_for_key(Command type, const std::string& key) {
   tcputils::send_string(_socket, key);
 }
 
+void TCPClient::send_string(const std::string& value) {
+  tcputils::send_string(_socket, value);
+}
+
 template <typename T>
 void TCPClient::send_value(const T& value) {
   tcputils::send_bytes<T>(_socket, &value, 1);
@@ -358,11 +465,18 @@ std::vector<T> TCPClient::receive_vector() {
 }  // namespace phi::distributed::detail
 namespace phi::distributed {
 
+namespace {
+// The replies of the pipelined waits are read after all of them are sent,
+// so their number is bounded to fit in the receive buffer of the socket.
+constexpr size_t kMaxPipelinedWaits = 4096;
+}  // namespace
+
 TCPStore::TCPStore(std::string host,
                    uint16_t port,
                    bool is_master,
                    size_t num_workers,
-                   int timeout)
+                   int timeout,
+                   int num_shards)
     : Store(timeout),
       _is_master(is_master),
       _num_workers(static_cast<int>(num_workers)) {
@@ -372,12 +486,25 @@ TCPStore::TCPStore(std::string host,
       0,
       common::errors::InvalidArgument("timeout must >= %d", timeout));
 
+  PADDLE_ENFORCE_EQ(
+      num_shards >= 1 && port + num_shards - 1 <= UINT16_MAX,
+      true,
+      common::errors::InvalidArgument(
+          "The number of shards %d should be at least 1, and the ports from "
+          "%d should not exceed %d.",
+          num_shards,
+          port,
+          UINT16_MAX));
+
   VLOG(7) << "input timeout" << timeout << ", member timeout:" << _timeout;
   if (_is_master) {
-    _server = detail::TCPServer::create(port, this->_num_workers, timeout);
+    _server = detail::TCPServer::create(
+        port, this->_num_workers, timeout, num_shards);
   }
 
-  _client = detail::TCPClient::connect(host, port);
+  for (int i = 0; i < num_shards; ++i) {
+    _clients.emplace_back(detail::TCPClient::connect(host, port + i));
+  }
   waitWorkers();
 }
 
@@ -420,30 +547,124 @@ void TCPStore::waitWorkers() {
   VLOG(7) << "TCPStore initialized.";
 }
 
+size_t TCPStore::shard(const std::string& key) const {
+  if (_clients.size() == 1) {
+    return 0;
+  }
+  // FNV-1a, which unlike std::hash is the same in all the processes.
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : key) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+  }
+  return hash % _clients.size();
+}
+
 int64_t TCPStore::add(const std::string& key, int64_t value) {
   VLOG(7) << "TCPStore add.";
-  _client->send_command_for_key(Command::ADD, _key_prefix + key);
-  _client->send_value<std::int64_t>(value);
-  return _client->receive_value<std::int64_t>();
+  auto* client = this->client(key);
+  client->send_command_for_key(Command::ADD, _key_prefix + key);
+  client->send_value<std::int64_t>(value);
+  return client->receive_value<std::int64_t>();
 }
 
 void TCPStore::set(const std::string& key, const std::vector<uint8_t>& value) {
   VLOG(7) << "TCPStore set.";
-  _client->send_command_for_key(Command::SET, _key_prefix + key);
-  _client->send_vector<uint8_t>(value);
+  auto* client = this->client(key);
+  client->send_command_for_key(Command::SET, _key_prefix + key);
+  client->send_vector<uint8_t>(value);
 }
 
 std::vector<uint8_t> TCPStore::get(const std::string& key) {
   wait(key);
-  _client->send_command_for_key(Command::GET, _key_prefix + key);
+  auto* client = this->client(key);
+  client->send_command_for_key(Command::GET, _key_prefix + key);
   VLOG(7) << "TCPStore get.";
-  return _client->receive_vector<uint8_t>();
+  return client->receive_vector<uint8_t>();
+}
+
+std::vector<std::vector<uint8_t>> TCPStore::multi_get(
+    const std::vector<std::string>& keys) {
+  VLOG(7) << "TCPStore multi_get " << keys.size() << " keys.";
+  std::vector<std::vector<size_t>> shard_keys(_clients.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    shard_keys[shard(keys[i])].push_back(i);
+  }
+
+  for (size_t begin = 0; begin < keys.size(); begin += kMaxPipelinedWaits) {
+    for (size_t s = 0; s < _clients.size(); ++s) {
+      const auto& indices = shard_keys[s];
+      const size_t end = std::min(indices.size(), begin + kMaxPipelinedWaits);
+      for (size_t j = begin; j < end; ++j) {
+        _clients[s]->send_command_for_key(Command::WAIT,
+                                          _key_prefix + keys[indices[j]]);
+      }
+    }
+    for (size_t s = 0; s < _clients.size(); ++s) {
+      const auto& indices = shard_keys[s];
+      const size_t end = std::min(indices.size(), begin + kMaxPipelinedWaits);
+      for (size_t j = begin; j < end; ++j) {
+        PADDLE_ENFORCE_EQ(
+            _clients[s]->receive_value<ReplyType>() == ReplyType::STOP_WAIT,
+            true,
+            common::errors::InvalidArgument(
+                "Stop_waiting response is expected"));
+      }
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> values(keys.size());
+  for (size_t s = 0; s < _clients.size(); ++s) {
+    const auto& indices = shard_keys[s];
+    if (indices.empty()) {
+      continue;
+    }
+    _clients[s]->send_command_for_key(Command::MULTI_GET, "");
+    _clients[s]->send_value<size_t>(indices.size());
+    for (auto i : indices) {
+      _clients[s]->send_string(_key_prefix + keys[i]);
+    }
+  }
+  for (size_t s = 0; s < _clients.size(); ++s) {
+    for (auto i : shard_keys[s]) {
+      values[i] = _clients[s]->receive_vector<uint8_t>();
+    }
+  }
+  return values;
+}
+
+void TCPStore::multi_set(const std::vector<std::string>& keys,
+                         const std::vector<std::vector<uint8_t>>& values) {
+  PADDLE_ENFORCE_EQ(
+      keys.size(),
+      values.size(),
+      common::errors::InvalidArgument(
+          "The number of keys (%d) and values (%d) to set should be equal.",
+          keys.size(),
+          values.size()));
+  VLOG(7) << "TCPStore multi_set " << keys.size() << " keys.";
+  std::vector<std::vector<size_t>> shard_keys(_clients.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    shard_keys[shard(keys[i])].push_back(i);
+  }
+  for (size_t s = 0; s < _clients.size(); ++s) {
+    const auto& indices = shard_keys[s];
+    if (indices.empty()) {
+      continue;
+    }
+    _clients[s]->send_command_for_key(Command::MULTI_SET, "");
+    _clients[s]->send_value<size_t>(indices.size());
+    for (auto i : indices) {
+      _clients[s]->send_string(_key_prefix + keys[i]);
+      _clients[s]->send_vector<uint8_t>(values[i]);
+    }
+  }
 }
 
 bool TCPStore::check(const std::string& key) {
-  _client->send_command_for_key(Command::CHECK, _key_prefix + key);
+  auto* client = this->client(key);
+  client->send_command_for_key(Command::CHECK, _key_prefix + key);
   VLOG(3) << "TCPStore check.";
-  auto response = _client->receive_value<ReplyType>();
+  auto response = client->receive_value<ReplyType>();
   if (response == ReplyType::READY) {
     return true;
   } else {
@@ -454,8 +675,9 @@ bool TCPStore::check(const std::string& key) {
 void TCPStore::wait(const std::string& key) {
   ReplyType reply;  // NOLINT
   VLOG(7) << "TCPStore wait.";
-  _client->send_command_for_key(Command::WAIT, _key_prefix + key);
-  reply = _client->receive_value<ReplyType>();
+  auto* client = this->client(key);
+  client->send_command_for_key(Command::WAIT, _key_prefix + key);
+  reply = client->receive_value<ReplyType>();
   PADDLE_ENFORCE_EQ(
       reply == ReplyType::STOP_WAIT,
       true,
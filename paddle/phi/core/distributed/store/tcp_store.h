@@ -38,7 +38,16 @@ namespace phi {
 namespace distributed {
 
 enum class ReplyType { WAITING, STOP_WAIT, READY, NOT_READY };
-enum class Command { ADD, GET, CHECK, SET, WAIT, STOP };
+enum class Command {
+  ADD,
+  GET,
+  CHECK,
+  SET,
+  WAIT,
+  STOP,
+  MULTI_GET,
+  MULTI_SET
+};
 
 namespace detail {
 
@@ -55,12 +64,19 @@ class MasterDaemon {
 
  private:
   void run();
+#ifndef __linux__
   void ProcessCommands(std::vector<struct pollfd>* p_fds);
+#endif
+  // Returns false when the connection is closed or broken.
+  bool ProcessCommand(SocketType socket);
+  void CloseSocket(SocketType socket);
   void _do_add(SocketType socket);
   void _do_wait(SocketType socket);
   void _do_get(SocketType socket);
   void _do_check(SocketType socket);
   void _do_set(SocketType socket);
+  void _do_multi_get(SocketType socket);
+  void _do_multi_set(SocketType socket);
   void _notify_waiting_sockets(const std::string&);
   SocketType _listen_socket;
   std::vector<SocketType> _sockets;
@@ -81,15 +97,18 @@ class MasterDaemon {
 #endif
 };
 
+// Serves the shards of the key space on num_shards consecutive ports from
+// port, each by a MasterDaemon of its own thread.
 class TCPServer {
  public:
   TCPServer() = default;
   static std::unique_ptr<TCPServer> create(std::uint16_t port,
                                            int nranks,
-                                           int stop_check_timeout);
+                                           int stop_check_timeout,
+                                           int num_shards = 1);
 
  private:
-  std::unique_ptr<MasterDaemon> _master_daemon;
+  std::vector<std::unique_ptr<MasterDaemon>> _master_daemons;
 };
 
 class TCPClient {
@@ -99,6 +118,7 @@ class TCPClient {
                                             uint16_t port);
   ~TCPClient() { tcputils::close_socket(_socket); }
   void send_command_for_key(Command type, const std::string& key);
+  void send_string(const std::string& value);
 
   template <typename T>
   void send_value(const T& value);
@@ -118,6 +138,9 @@ class TCPClient {
 }  // namespace detail
 
 // TODO(gongwb) :Add IP6 support.
+// With num_shards > 1, the keys are hashed over num_shards servers on the
+// consecutive ports from port, so that no single server loop handles the
+// requests of all the ranks. All the ranks should use the same num_shards.
 class TCPStore : public Store {
  public:
   static constexpr std::uint16_t kDefaultPort = 6170;
@@ -125,7 +148,8 @@ class TCPStore : public Store {
                     uint16_t port = kDefaultPort,
                     bool is_master = false,
                     size_t num_workers = 1,
-                    int timeout = 900);
+                    int timeout = 900,
+                    int num_shards = 1);
 
   ~TCPStore();
 
@@ -134,11 +158,21 @@ class TCPStore : public Store {
   bool check(const std::string& key) override;
   void wait(const std::string& key) override;
   void set(const std::string& key, const std::vector<uint8_t>& value) override;
+  // One round trip per shard: the waits for all the keys are sent before
+  // any reply is read.
+  std::vector<std::vector<uint8_t>> multi_get(
+      const std::vector<std::string>& keys) override;
+  void multi_set(const std::vector<std::string>& keys,
+                 const std::vector<std::vector<uint8_t>>& values) override;
 
  private:
   void waitWorkers();
+  size_t shard(const std::string& key) const;
+  detail::TCPClient* client(const std::string& key) const {
+    return _clients[shard(key)].get();
+  }
   std::unique_ptr<detail::TCPServer> _server;
-  std::unique_ptr<detail::TCPClient> _client;
+  std::vector<std::unique_ptr<detail::TCPClient>> _clients;
 
   const std::string _init_key = "init/";
   const std::string _key_prefix = "/";
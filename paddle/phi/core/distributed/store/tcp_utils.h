@@ -45,7 +45,9 @@ using SocketType = int;
 
 namespace tcputils {
 
-constexpr int LISTENQ = 2048;
+// Large enough for all the ranks of a job to connect at once, the kernel
+// clamps it to net.core.somaxconn.
+constexpr int LISTENQ = 16384;
 constexpr std::chrono::seconds kDelay = std::chrono::seconds(3);
 constexpr std::chrono::seconds kNoTimeout = std::chrono::seconds::zero();
 constexpr std::chrono::seconds kDefaultTimeout = std::chrono::seconds(360);
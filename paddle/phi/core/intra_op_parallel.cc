@@ -0,0 +1,310 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/intra_op_parallel.h"
+
+#include <algorithm>
+#include <map>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+
+#ifdef PADDLE_WITH_MKLML
+#include "paddle/phi/backends/dynload/mklml.h"
+#endif
+
+namespace phi {
+
+namespace {
+
+thread_local IntraOpThreadPool* current_pool = nullptr;
+// Whether the thread runs a chunk of a loop, in which ParallelFor runs
+// serially.
+thread_local bool in_parallel_loop = false;
+
+std::vector<int> GetThreadCores() {
+  std::vector<int> cores;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int core = 0; core < CPU_SETSIZE; ++core) {
+      if (CPU_ISSET(core, &set)) {
+        cores.push_back(core);
+      }
+    }
+  }
+#endif
+  return cores;
+}
+
+void PinThread(const std::vector<int>& cores) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int core : cores) {
+    CPU_SET(core, &set);
+  }
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    VLOG(1) << "Failed to pin a thread of the intra-op thread pool.";
+  }
+#endif
+}
+
+// Sets the flag for the chunks run by the calling thread.
+class ParallelLoopScope {
+ public:
+  ParallelLoopScope() : prev_(in_parallel_loop) { in_parallel_loop = true; }
+  ~ParallelLoopScope() { in_parallel_loop = prev_; }
+
+ private:
+  bool prev_;
+};
+
+}  // namespace
+
+IntraOpThreadPool::IntraOpThreadPool(const std::vector<int>& cores)
+    : cores_(cores) {
+  PADDLE_ENFORCE_GT(cores_.size(),
+                    0UL,
+                    common::errors::InvalidArgument(
+                        "The cores of an intra-op thread pool are empty."));
+  const int num_cores = static_cast<int>(std::thread::hardware_concurrency());
+  for (int core : cores_) {
+    PADDLE_ENFORCE_EQ(
+        core >= 0 && core < num_cores,
+        true,
+        common::errors::InvalidArgument(
+            "The core %d of an intra-op thread pool is out of the %d cores.",
+            core,
+            num_cores));
+  }
+  threads_.reserve(cores_.size() - 1);
+  for (size_t i = 1; i < cores_.size(); ++i) {
+    threads_.emplace_back([this, i] { WorkerLoop(cores_[i]); });
+  }
+}
+
+IntraOpThreadPool::~IntraOpThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  scheduled_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::shared_ptr<IntraOpThreadPool> IntraOpThreadPool::GetOrCreate(
+    const std::vector<int>& cores) {
+  static std::mutex mutex;
+  static std::map<std::vector<int>, std::weak_ptr<IntraOpThreadPool>> pools;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto pool = pools[cores].lock();
+  if (pool == nullptr) {
+    pool = std::make_shared<IntraOpThreadPool>(cores);
+    pools[cores] = pool;
+  }
+  return pool;
+}
+
+IntraOpThreadPool* IntraOpThreadPool::Current() { return current_pool; }
+
+void IntraOpThreadPool::ParallelFor(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    const std::function<void(int64_t, int64_t)>& fn) {
+  if (begin >= end) {
+    return;
+  }
+  ParallelLoopScope loop_scope;
+  const int64_t size = end - begin;
+  grain_size = std::max<int64_t>(grain_size, 1);
+  // A few chunks per thread, so that a thread busy with the loop of
+  // another caller does not hold this one up.
+  const int64_t num_chunks =
+      std::min((size + grain_size - 1) / grain_size,
+               static_cast<int64_t>(NumThreads()) * 4);
+  if (num_chunks <= 1 || threads_.empty()) {
+    fn(begin, end);
+    return;
+  }
+
+  auto loop = std::make_shared<Loop>();
+  loop->begin = begin;
+  loop->end = end;
+  loop->chunk_size = (size + num_chunks - 1) / num_chunks;
+  loop->num_chunks = (size + loop->chunk_size - 1) / loop->chunk_size;
+  loop->fn = &fn;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loops_.push_back(loop);
+  }
+  scheduled_.notify_all();
+
+  RunChunks(loop.get());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find(loops_.begin(), loops_.end(), loop);
+    if (it != loops_.end()) {
+      loops_.erase(it);
+    }
+  }
+  {
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->finished.wait(
+        lock, [&] { return loop->done.load() == loop->num_chunks; });
+  }
+  if (loop->error) {
+    std::rethrow_exception(loop->error);
+  }
+}
+
+void IntraOpThreadPool::RunChunks(Loop* loop) {
+  int64_t i = 0;
+  while ((i = loop->next.fetch_add(1)) < loop->num_chunks) {
+    const int64_t chunk_begin = loop->begin + i * loop->chunk_size;
+    const int64_t chunk_end =
+        std::min(loop->end, chunk_begin + loop->chunk_size);
+    try {
+      (*loop->fn)(chunk_begin, chunk_end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(loop->mutex);
+      if (!loop->error) {
+        loop->error = std::current_exception();
+      }
+    }
+    if (loop->done.fetch_add(1) + 1 == loop->num_chunks) {
+      std::lock_guard<std::mutex> lock(loop->mutex);
+      loop->finished.notify_all();
+    }
+  }
+}
+
+void IntraOpThreadPool::WorkerLoop(int core) {
+  PinThread({core});
+  ParallelLoopScope loop_scope;
+  while (true) {
+    std::shared_ptr<Loop> loop;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      scheduled_.wait(lock, [this] { return !running_ || !loops_.empty(); });
+      if (!running_) {
+        return;
+      }
+      loop = loops_.front();
+      if (loop->next.load() >= loop->num_chunks) {
+        loops_.pop_front();
+        continue;
+      }
+    }
+    RunChunks(loop.get());
+  }
+}
+
+IntraOpThreadPoolGuard::IntraOpThreadPoolGuard(IntraOpThreadPool* pool)
+    : pool_(pool), prev_pool_(current_pool) {
+  if (pool_ == nullptr) {
+    return;
+  }
+  current_pool = pool_;
+  prev_cores_ = GetThreadCores();
+  PinThread(pool_->cores());
+#ifdef _OPENMP
+  prev_omp_threads_ = omp_get_max_threads();
+  omp_set_num_threads(pool_->NumThreads());
+#endif
+#ifdef PADDLE_WITH_MKLML
+  prev_mkl_threads_ =
+      phi::dynload::MKL_Set_Num_Threads_Local(pool_->NumThreads());
+#endif
+}
+
+IntraOpThreadPoolGuard::~IntraOpThreadPoolGuard() {
+  if (pool_ == nullptr) {
+    return;
+  }
+#ifdef PADDLE_WITH_MKLML
+  // 0 restores the global number of threads.
+  phi::dynload::MKL_Set_Num_Threads_Local(prev_mkl_threads_);
+#endif
+#ifdef _OPENMP
+  omp_set_num_threads(prev_omp_threads_);
+#endif
+  if (!prev_cores_.empty()) {
+    PinThread(prev_cores_);
+  }
+  current_pool = prev_pool_;
+}
+
+void ParallelFor(int64_t begin,
+                 int64_t end,
+                 int64_t grain_size,
+                 const std::function<void(int64_t, int64_t)>& fn) {
+  if (begin >= end) {
+    return;
+  }
+  if (in_parallel_loop) {
+    fn(begin, end);
+    return;
+  }
+  if (current_pool != nullptr) {
+    current_pool->ParallelFor(begin, end, grain_size, fn);
+    return;
+  }
+#ifdef _OPENMP
+  const int64_t size = end - begin;
+  grain_size = std::max<int64_t>(grain_size, 1);
+  const int64_t num_chunks =
+      std::min((size + grain_size - 1) / grain_size,
+               static_cast<int64_t>(omp_get_max_threads()));
+  if (num_chunks > 1 && !omp_in_parallel()) {
+    const int64_t chunk_size = (size + num_chunks - 1) / num_chunks;
+    std::exception_ptr error;
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < num_chunks; ++i) {
+      const int64_t chunk_begin = begin + i * chunk_size;
+      const int64_t chunk_end = std::min(end, chunk_begin + chunk_size);
+      if (chunk_begin >= chunk_end) {
+        continue;
+      }
+      ParallelLoopScope loop_scope;
+      try {
+        fn(chunk_begin, chunk_end);
+      } catch (...) {
+#pragma omp critical(phi_parallel_for_error)
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
+#endif
+  fn(begin, end);
+}
+
+}  // namespace phi
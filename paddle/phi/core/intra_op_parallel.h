@@ -0,0 +1,127 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "paddle/common/macros.h"  // for DISABLE_COPY_AND_ASSIGN
+#include "paddle/utils/test_macros.h"
+
+namespace phi {
+
+// IntraOpThreadPool runs the parallel loops of the CPU kernels, see
+// ParallelFor, on threads pinned to a set of cores. The thread calling a
+// loop takes part in it, and the chunks of the loops are claimed by
+// whichever thread is free, so that the loops of several callers share
+// the threads instead of each starting threads of its own.
+class IntraOpThreadPool {
+ public:
+  // Starts cores.size() - 1 threads, each pinned to one of the cores but
+  // the first, which is left to the caller.
+  explicit IntraOpThreadPool(const std::vector<int>& cores);
+
+  ~IntraOpThreadPool();
+
+  // Returns the pool of the cores, shared by its users while it has some.
+  TEST_API static std::shared_ptr<IntraOpThreadPool> GetOrCreate(
+      const std::vector<int>& cores);
+
+  // The pool bound to the calling thread by IntraOpThreadPoolGuard.
+  TEST_API static IntraOpThreadPool* Current();
+
+  const std::vector<int>& cores() const { return cores_; }
+
+  // The threads of a loop, the caller included.
+  int NumThreads() const { return static_cast<int>(cores_.size()); }
+
+  // Runs fn on the chunks of [begin, end), of at least grain_size
+  // elements, and returns when all are done. Rethrows the first exception
+  // of fn.
+  TEST_API void ParallelFor(
+      int64_t begin,
+      int64_t end,
+      int64_t grain_size,
+      const std::function<void(int64_t, int64_t)>& fn);
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(IntraOpThreadPool);
+
+  struct Loop {
+    int64_t begin;
+    int64_t end;
+    int64_t chunk_size;
+    int64_t num_chunks;
+    const std::function<void(int64_t, int64_t)>* fn;
+    std::atomic<int64_t> next{0};
+    std::atomic<int64_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+  };
+
+  // Runs the chunks of loop until none is left to claim.
+  static void RunChunks(Loop* loop);
+
+  void WorkerLoop(int core);
+
+  std::vector<int> cores_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable scheduled_;
+  // The loops with chunks left to claim, oldest first.
+  std::deque<std::shared_ptr<Loop>> loops_;
+  bool running_{true};
+};
+
+// Binds pool to the calling thread for its lifetime: the thread is pinned
+// to the cores of the pool, ParallelFor runs on the pool, and the OpenMP
+// and MKL threads of the calling thread, which oneDNN and the BLAS calls
+// use, are limited to the threads of the pool. Does nothing for a null
+// pool.
+class TEST_API IntraOpThreadPoolGuard {
+ public:
+  explicit IntraOpThreadPoolGuard(IntraOpThreadPool* pool);
+  ~IntraOpThreadPoolGuard();
+
+ private:
+  DISABLE_COPY_AND_ASSIGN(IntraOpThreadPoolGuard);
+
+  IntraOpThreadPool* pool_;
+  IntraOpThreadPool* prev_pool_;
+  std::vector<int> prev_cores_;
+  int prev_omp_threads_{0};
+  int prev_mkl_threads_{0};
+};
+
+// Runs fn on the chunks of [begin, end), of at least grain_size elements,
+// on the pool bound to the calling thread. Without a pool it runs them on
+// OpenMP when compiled with it, and a ParallelFor called from within a
+// loop runs serially.
+TEST_API void ParallelFor(int64_t begin,
+                          int64_t end,
+                          int64_t grain_size,
+                          const std::function<void(int64_t, int64_t)>& fn);
+
+}  // namespace phi
@@ -14,6 +14,8 @@
 
 #include "paddle/phi/core/kernel_factory.h"
 
+#include <algorithm>
+
 #include "glog/logging.h"
 #include "paddle/common/flags.h"
 #include "paddle/phi/core/enforce.h"
@@ -55,6 +57,30 @@ uint32_t KernelKey::Hash::operator()(const KernelKey& key) const {
   return hash_value;
 }
 
+KernelTableRow::KernelTableRow(const KernelKeyMap* kernels,
+                               uint64_t kernels_version)
+    : kernels_version_(kernels_version) {
+  if (kernels == nullptr) return;
+  for (const auto& kernel_pair : *kernels) {
+    const KernelKey& kernel_key = kernel_pair.first;
+    auto backend = static_cast<size_t>(kernel_key.backend());
+    auto layout = static_cast<size_t>(kernel_key.layout());
+    auto dtype = static_cast<size_t>(kernel_key.dtype());
+    // e.g. the backends of the custom devices, found by the factory only
+    if (backend >= kNumBackends || layout >= kNumLayouts ||
+        dtype >= kNumDataTypes) {
+      continue;
+    }
+    uint16_t& slot = slots_[backend * kNumLayouts + layout];
+    if (slot == 0) {
+      kernels_.emplace_back();
+      kernels_.back().fill(nullptr);
+      slot = static_cast<uint16_t>(kernels_.size());
+    }
+    kernels_[slot - 1][dtype] = &kernel_pair.second;
+  }
+}
+
 KernelFactory& KernelFactory::Instance() {
   static KernelFactory g_op_kernel_factory;
   return g_op_kernel_factory;
@@ -264,35 +290,31 @@ KernelFactory::GetLowPrecisionKernelList() {
   return low_precision_kernels_;
 }
 
-KernelResult KernelFactory::SelectKernelOrThrowError(
-    const std::string& kernel_name,
-    const KernelKey& const_kernel_key,
-    bool use_strided_kernel) const {
-  auto iter = kernels_.find(kernel_name);
-
-  PADDLE_ENFORCE_NE(iter,
-                    kernels_.end(),
-                    common::errors::NotFound(
-                        "The kernel `%s` is not registered.", kernel_name));
-
+// The kernel selection rules of SelectKernelOrThrowError, shared with
+// KernelHandle::Select. find returns the kernel registered with a kernel key
+// of kernel_name, or nullptr.
+template <typename Find>
+static KernelResult SelectKernelByRules(const std::string& kernel_name,
+                                        const KernelKey& const_kernel_key,
+                                        bool use_strided_kernel,
+                                        const Find& find) {
   if (FLAGS_use_stride_kernel && use_strided_kernel) {
-    auto stride_kernel_iter = iter->second.find(
+    const Kernel* stride_kernel = find(
         {const_kernel_key.backend() == paddle::experimental::Backend::GPUDNN
              ? paddle::experimental::Backend::GPU
              : const_kernel_key.backend(),
          phi::DataLayout::STRIDED,
          const_kernel_key.dtype()});
-    if (stride_kernel_iter != iter->second.end()) {
-      return {stride_kernel_iter->second, false, true};
+    if (stride_kernel != nullptr) {
+      return {*stride_kernel, false, true};
     }
 #ifdef PADDLE_WITH_CUSTOM_DEVICE
-    if (stride_kernel_iter == iter->second.end() &&
-        const_kernel_key.backend() > phi::Backend::NUM_BACKENDS) {
-      stride_kernel_iter = iter->second.find({phi::Backend::CUSTOM,
-                                              phi::DataLayout::STRIDED,
-                                              const_kernel_key.dtype()});
-      if (stride_kernel_iter != iter->second.end()) {
-        return {stride_kernel_iter->second, false, true};
+    if (const_kernel_key.backend() > phi::Backend::NUM_BACKENDS) {
+      stride_kernel = find({phi::Backend::CUSTOM,
+                            phi::DataLayout::STRIDED,
+                            const_kernel_key.dtype()});
+      if (stride_kernel != nullptr) {
+        return {*stride_kernel, false, true};
       }
     }
 #endif
@@ -303,19 +325,19 @@ KernelResult KernelFactory::SelectKernelOrThrowError(
                                    const_kernel_key.dtype());
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   if (kernel_key.backend() == Backend::GPUDNN) {
-    auto kernel_iter = iter->second.find(
+    const Kernel* dnn_kernel = find(
         {Backend::GPUDNN, phi::DataLayout::ALL_LAYOUT, kernel_key.dtype()});
-    if (kernel_iter != iter->second.end()) {
-      return {kernel_iter->second, false, false};
+    if (dnn_kernel != nullptr) {
+      return {*dnn_kernel, false, false};
     }
     kernel_key =
         KernelKey(Backend::GPU, kernel_key.layout(), kernel_key.dtype());
   }
 #endif
-  auto kernel_iter = iter->second.find(kernel_key);
+  const Kernel* kernel = find(kernel_key);
 
   PADDLE_ENFORCE_NE(
-      kernel_iter == iter->second.end() && kernel_key.backend() == Backend::CPU,
+      kernel == nullptr && kernel_key.backend() == Backend::CPU,
       true,
       common::errors::NotFound(
           "The kernel with key %s of kernel `%s` is not registered. %s",
@@ -333,11 +355,11 @@ KernelResult KernelFactory::SelectKernelOrThrowError(
   if (is_xpu_kp_supported && FLAGS_run_kp_kernel) {
     auto kernel_key_kp =
         KernelKey(Backend::KPS, kernel_key.layout(), kernel_key.dtype());
-    auto kernel_iter_kp = iter->second.find(kernel_key_kp);
-    has_kp_kernel = (kernel_iter_kp != iter->second.end());
+    const Kernel* kernel_kp = find(kernel_key_kp);
+    has_kp_kernel = (kernel_kp != nullptr);
     if (has_kp_kernel) {
       kernel_key = kernel_key_kp;
-      kernel_iter = kernel_iter_kp;
+      kernel = kernel_kp;
     }
   }
   // check in xpu
@@ -347,38 +369,36 @@ KernelResult KernelFactory::SelectKernelOrThrowError(
   // Fall back to CPU, when FLAGS_enable_api_kernel_fallback is true and op
   // was unregistered in xpu and kp
   if (FLAGS_enable_api_kernel_fallback &&
-      (kernel_iter == iter->second.end() || (xpu_unsupport && !has_kp_kernel))
+      (kernel == nullptr || (xpu_unsupport && !has_kp_kernel))
 #elif defined(PADDLE_WITH_XPU) && !defined(PADDLE_WITH_XPU_KP)
   VLOG(6) << "fluid_op_name: " << TransToFluidOpName(kernel_name);
   bool is_xpu_support1 = phi::backends::xpu::is_xpu_support_op(
       TransToFluidOpName(kernel_name), kernel_key.dtype());
   bool is_xpu_support2 =
       phi::backends::xpu::is_xpu_support_op(kernel_name, kernel_key.dtype());
-  if ((FLAGS_enable_api_kernel_fallback && kernel_iter == iter->second.end()) ||
+  if ((FLAGS_enable_api_kernel_fallback && kernel == nullptr) ||
       (!is_xpu_support1 && !is_xpu_support2)
 #elif defined(PADDLE_WITH_CUSTOM_DEVICE)
-  if (kernel_iter == iter->second.end() &&
-      kernel_key.backend() > phi::Backend::NUM_BACKENDS) {
-    kernel_iter = iter->second.find({phi::Backend::CUSTOM,
-                                     phi::DataLayout::ALL_LAYOUT,
-                                     kernel_key.dtype()});
+  if (kernel == nullptr && kernel_key.backend() > phi::Backend::NUM_BACKENDS) {
+    kernel = find({phi::Backend::CUSTOM,
+                   phi::DataLayout::ALL_LAYOUT,
+                   kernel_key.dtype()});
   }
   if (FLAGS_enable_api_kernel_fallback &&
-      (kernel_iter == iter->second.end() ||
+      (kernel == nullptr ||
        phi::backends::custom_device::is_in_custom_black_list(
            TransToFluidOpName(kernel_name)))
 #else
-  if ((FLAGS_enable_api_kernel_fallback && kernel_iter == iter->second.end())
+  if ((FLAGS_enable_api_kernel_fallback && kernel == nullptr)
 #endif
   ) {
     // Fallback CPU backend
     phi::KernelKey cpu_kernel_key(
         phi::Backend::CPU, kernel_key.layout(), kernel_key.dtype());
-    kernel_iter = iter->second.find(cpu_kernel_key);
+    kernel = find(cpu_kernel_key);
 
-    PADDLE_ENFORCE_NE(
-        kernel_iter,
-        iter->second.end(),
+    PADDLE_ENFORCE_NOT_NULL(
+        kernel,
         common::errors::NotFound(
             "The kernel with key %s of kernel `%s` is not registered and "
             "fail to fallback to CPU one. %s",
@@ -390,12 +410,11 @@ KernelResult KernelFactory::SelectKernelOrThrowError(
             << ", expected_kernel_key:" << kernel_key
             << ", fallbacking to CPU one!";
 
-    return {kernel_iter->second, true, false};
+    return {*kernel, true, false};
   }
 
-  PADDLE_ENFORCE_NE(
-      kernel_iter,
-      iter->second.end(),
+  PADDLE_ENFORCE_NOT_NULL(
+      kernel,
       common::errors::NotFound(
           "The kernel with key %s of kernel `%s` is not registered. %s "
           "The current value of FLAGS_enable_api_kernel_fallback(bool,"
@@ -405,7 +424,87 @@ KernelResult KernelFactory::SelectKernelOrThrowError(
           kernel_name,
           KernelSelectionErrorMessage(kernel_name, kernel_key)));
 
-  return {kernel_iter->second, false, false};
+  return {*kernel, false, false};
+}
+
+KernelResult KernelFactory::SelectKernelOrThrowError(
+    const std::string& kernel_name,
+    const KernelKey& const_kernel_key,
+    bool use_strided_kernel) const {
+  auto iter = kernels_.find(kernel_name);
+
+  PADDLE_ENFORCE_NE(iter,
+                    kernels_.end(),
+                    common::errors::NotFound(
+                        "The kernel `%s` is not registered.", kernel_name));
+
+  const KernelKeyMap& kernels = iter->second;
+  return SelectKernelByRules(
+      kernel_name,
+      const_kernel_key,
+      use_strided_kernel,
+      [&kernels](const KernelKey& kernel_key) -> const Kernel* {
+        auto kernel_iter = kernels.find(kernel_key);
+        return kernel_iter == kernels.end() ? nullptr : &kernel_iter->second;
+      });
+}
+
+KernelNameId KernelFactory::InternKernelName(const std::string& kernel_name) {
+  std::lock_guard<std::mutex> guard(kernel_table_mutex_);
+  auto iter = kernel_name_ids_.find(kernel_name);
+  if (iter != kernel_name_ids_.end()) {
+    return iter->second;
+  }
+  auto id = static_cast<KernelNameId>(kernel_names_.size());
+  kernel_name_ids_.emplace(kernel_name, id);
+  kernel_names_.push_back(kernel_name);
+  kernel_table_.emplace_back(nullptr);
+  return id;
+}
+
+std::shared_ptr<const KernelTableRow> KernelFactory::GetKernelTableRow(
+    KernelNameId id) {
+  std::lock_guard<std::mutex> guard(kernel_table_mutex_);
+  PADDLE_ENFORCE_LT(
+      id,
+      kernel_table_.size(),
+      common::errors::InvalidArgument(
+          "The kernel name id %d is not interned, the number of the interned "
+          "kernel names is %d.",
+          id,
+          kernel_table_.size()));
+  auto& row = kernel_table_[id];
+  uint64_t kernels_version = KernelsVersion();
+  if (row == nullptr || row->kernels_version() != kernels_version) {
+    auto iter = kernels_.find(kernel_names_[id]);
+    row = std::make_shared<const KernelTableRow>(
+        iter == kernels_.end() ? nullptr : &iter->second, kernels_version);
+  }
+  return row;
+}
+
+KernelHandle::KernelHandle(const std::string& kernel_name)
+    : kernel_name_(kernel_name),
+      name_id_(KernelFactory::Instance().InternKernelName(kernel_name)) {}
+
+KernelResult KernelHandle::Select(const KernelKey& kernel_key,
+                                  bool use_strided_kernel) {
+#if defined(PADDLE_WITH_CUSTOM_DEVICE)
+  // the table rows do not hold the kernels of the custom device backends
+  return KernelFactory::Instance().SelectKernelOrThrowError(
+      kernel_name_, kernel_key, use_strided_kernel);
+#else
+  const KernelTableRow& row = Row();
+  PADDLE_ENFORCE_EQ(row.empty(),
+                    false,
+                    common::errors::NotFound(
+                        "The kernel `%s` is not registered.", kernel_name_));
+  return SelectKernelByRules(
+      kernel_name_,
+      kernel_key,
+      use_strided_kernel,
+      [&row](const KernelKey& kernel_key) { return row.Find(kernel_key); });
+#endif
 }
 
 const KernelArgsDef& KernelFactory::GetFirstKernelArgsDef(
@@ -591,7 +690,7 @@ std::string KernelSelectionErrorMessage(const std::string& kernel_name,
   std::unordered_set<std::string> dtype_set;
 
   // Record all kernel information of kernel_name
-  for (auto const& iter : KernelFactory::Instance().kernels()[kernel_name]) {
+  for (auto const& iter : KernelFactory::Instance().kernels().at(kernel_name)) {
     KernelKey kernel_key = iter.first;
     if (kernel_key.backend() == target_key.backend()) {
       support_backend = true;
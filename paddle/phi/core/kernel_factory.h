@@ -14,10 +14,16 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include "paddle/common/layout.h"
 #include "paddle/phi/common/backend.h"
 #include "paddle/phi/common/data_type.h"
@@ -307,6 +313,50 @@ struct KernelResult {
   bool is_stride_kernel = false;
 };
 
+using KernelNameId = uint32_t;
+
+/**
+ * Note: The kernels of one kernel name, indexed directly by the backend and
+ *       the layout, then by the dtype of the kernel key, so that a kernel is
+ *       found without hashing. A row is built from the kernels of one
+ *       version of the KernelFactory, and is not used once they change.
+ */
+class KernelTableRow {
+ public:
+  KernelTableRow(const KernelKeyMap* kernels, uint64_t kernels_version);
+
+  // The kernel registered with kernel_key, or nullptr.
+  const Kernel* Find(const KernelKey& kernel_key) const {
+    auto backend = static_cast<size_t>(kernel_key.backend());
+    auto layout = static_cast<size_t>(kernel_key.layout());
+    auto dtype = static_cast<size_t>(kernel_key.dtype());
+    if (backend >= kNumBackends || layout >= kNumLayouts ||
+        dtype >= kNumDataTypes) {
+      return nullptr;
+    }
+    uint16_t slot = slots_[backend * kNumLayouts + layout];
+    return slot == 0 ? nullptr : kernels_[slot - 1][dtype];
+  }
+
+  uint64_t kernels_version() const { return kernels_version_; }
+
+  // Whether no kernel of the name is registered.
+  bool empty() const { return kernels_.empty(); }
+
+ private:
+  static constexpr size_t kNumBackends =
+      static_cast<size_t>(Backend::NUM_BACKENDS);
+  static constexpr size_t kNumLayouts =
+      static_cast<size_t>(DataLayout::NUM_DATA_LAYOUTS);
+  static constexpr size_t kNumDataTypes =
+      static_cast<size_t>(DataType::NUM_DATA_TYPES);
+
+  uint64_t kernels_version_;
+  // 1 + the index in kernels_ of each backend and layout, 0 for none
+  std::array<uint16_t, kNumBackends * kNumLayouts> slots_{};
+  std::vector<std::array<const Kernel*, kNumDataTypes>> kernels_;
+};
+
 /**
  * Note: Each Computation need a basic kernel map that named by kernel_name.
  *       Such as for scale op, KernelMap contains a `scale` kernel map,
@@ -317,7 +367,18 @@ class KernelFactory {
  public:
   static KernelFactory& Instance();
 
-  KernelNameMap& kernels() { return kernels_; }
+  const KernelNameMap& kernels() const { return kernels_; }
+
+  // The kernels may be registered or removed through the returned map, so
+  // the table rows built before are not used again.
+  KernelNameMap& mutable_kernels() {
+    kernels_version_.fetch_add(1, std::memory_order_relaxed);
+    return kernels_;
+  }
+
+  uint64_t KernelsVersion() const {
+    return kernels_version_.load(std::memory_order_relaxed);
+  }
 
   bool HasCompatiblePhiKernel(const std::string& op_type) const;
 
@@ -348,15 +409,69 @@ class KernelFactory {
 
   void ClearLowPrecisionKernelList() { low_precision_kernels_.clear(); }
 
+  // The id of kernel_name, assigned when it is interned first, i.e. when
+  // its first kernel is registered. The ids are not reused.
+  KernelNameId InternKernelName(const std::string& kernel_name);
+
+  // The table row of the kernels of a kernel name, built again when the
+  // kernels change.
+  std::shared_ptr<const KernelTableRow> GetKernelTableRow(KernelNameId id);
+
  private:
   KernelFactory() = default;
 
   KernelNameMap kernels_;
+  std::atomic<uint64_t> kernels_version_{0};
+
+  std::mutex kernel_table_mutex_;
+  paddle::flat_hash_map<std::string, KernelNameId> kernel_name_ids_;
+  // the kernel names and the table rows, by the kernel name id
+  std::vector<std::string> kernel_names_;
+  std::vector<std::shared_ptr<const KernelTableRow>> kernel_table_;
 
   // Get the low precision kernel list of current module.
   std::map<const std::string, OpCount> low_precision_kernels_;
 };
 
+/**
+ * Note: The handle of the kernels of one kernel name, which selects a kernel
+ *       in the KernelTableRow of the name instead of hashing the kernel name
+ *       and the kernel key. It keeps the row until the kernels change, so
+ *       that each thread has its own handle, such as a `static thread_local`
+ *       one in the generated API.
+ */
+class KernelHandle {
+ public:
+  explicit KernelHandle(const std::string& kernel_name);
+
+  KernelNameId name_id() const { return name_id_; }
+
+  const std::string& kernel_name() const { return kernel_name_; }
+
+  // The kernel registered with kernel_key, or nullptr.
+  const Kernel* Find(const KernelKey& kernel_key) {
+    return Row().Find(kernel_key);
+  }
+
+  // The same as KernelFactory::SelectKernelOrThrowError, by the same rules.
+  KernelResult Select(const KernelKey& kernel_key,
+                      bool use_strided_kernel = false);
+
+ private:
+  const KernelTableRow& Row() {
+    auto& factory = KernelFactory::Instance();
+    if (row_ == nullptr ||
+        row_->kernels_version() != factory.KernelsVersion()) {
+      row_ = factory.GetKernelTableRow(name_id_);
+    }
+    return *row_;
+  }
+
+  std::string kernel_name_;
+  KernelNameId name_id_;
+  std::shared_ptr<const KernelTableRow> row_;
+};
+
 inline std::ostream& operator<<(std::ostream& os, const KernelKey& kernel_key) {
   os << "(" << kernel_key.backend() << ", " << kernel_key.layout() << ", "
      << kernel_key.dtype() << ")";
@@ -145,7 +145,9 @@ struct KernelRegistrar {
     }
     args_def_fn(kernel_key, &kernel);
     if (reg_type == RegType::INNER) {
-      KernelFactory::Instance().kernels()[kernel_name][kernel_key] = kernel;
+      KernelFactory::Instance().mutable_kernels()[kernel_name][kernel_key] =
+          kernel;
+      KernelFactory::Instance().InternKernelName(kernel_name);
     } else {
       CustomKernelMap::Instance().RegisterCustomKernel(
           kernel_name, kernel_key, kernel);
@@ -15,6 +15,7 @@
 #pragma once
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "paddle/phi/core/memory/allocation/allocator.h"
 
@@ -29,6 +30,11 @@ class AlignedAllocator : public Allocator {
 
   bool IsAllocThreadSafe() const override;
 
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry) const override {
+    underlying_allocator_->CollectTelemetry(telemetry);
+  }
+
  protected:
   phi::Allocation* AllocateImpl(size_t size) override;
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/allocation_profiler.h"
+
+#include <fstream>
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle::memory::allocation {
+
+static constexpr char kProfileHeader[] = "paddle_allocation_profile";
+static constexpr int kProfileVersion = 1;
+
+AllocationProfiler& AllocationProfiler::Instance() {
+  static AllocationProfiler profiler;
+  return profiler;
+}
+
+void AllocationProfiler::Start() {
+  std::lock_guard<std::mutex> guard(mtx_);
+  records_.clear();
+  recording_.store(true);
+}
+
+void AllocationProfiler::Stop() { recording_.store(false); }
+
+void AllocationProfiler::RecordAlloc(const phi::Place& place, size_t size) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  if (!recording_.load()) {
+    return;
+  }
+  auto& record = records_[place];
+  ++record.live_blocks[size];
+  record.live_bytes += static_cast<int64_t>(size);
+  if (record.live_bytes > record.peak_bytes) {
+    record.peak_bytes = record.live_bytes;
+    record.peak_blocks = record.live_blocks;
+  }
+}
+
+void AllocationProfiler::RecordFree(const phi::Place& place, size_t size) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  if (!recording_.load()) {
+    return;
+  }
+  auto record_it = records_.find(place);
+  if (record_it == records_.end()) {
+    return;
+  }
+  // Allocations made before Start are not tracked.
+  auto& record = record_it->second;
+  auto block_it = record.live_blocks.find(size);
+  if (block_it == record.live_blocks.end()) {
+    return;
+  }
+  if (--block_it->second == 0) {
+    record.live_blocks.erase(block_it);
+  }
+  record.live_bytes -= static_cast<int64_t>(size);
+}
+
+std::vector<AllocationProfile> AllocationProfiler::GetProfiles() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  std::vector<AllocationProfile> profiles;
+  for (auto& pair : records_) {
+    AllocationProfile profile;
+    profile.place = pair.first;
+    profile.peak_bytes = pair.second.peak_bytes;
+    profile.blocks.assign(pair.second.peak_blocks.begin(),
+                          pair.second.peak_blocks.end());
+    profiles.emplace_back(std::move(profile));
+  }
+  return profiles;
+}
+
+void SaveAllocationProfiles(const std::string& path,
+                            const std::vector<AllocationProfile>& profiles) {
+  std::ofstream fout(path);
+  PADDLE_ENFORCE_EQ(
+      fout.is_open(),
+      true,
+      common::errors::Unavailable(
+          "Cannot open %s to save the allocation profile.", path));
+  fout << kProfileHeader << " " << kProfileVersion << "\n";
+  for (auto& profile : profiles) {
+    std::string device_type = profile.place.GetDeviceType();
+    fout << "place " << static_cast<int>(profile.place.GetType()) << " "
+         << static_cast<int>(profile.place.GetDeviceId()) << " "
+         << (device_type.empty() ? "-" : device_type) << " "
+         << profile.peak_bytes << " " << profile.blocks.size() << "\n";
+    for (auto& block : profile.blocks) {
+      fout << block.first << " " << block.second << "\n";
+    }
+  }
+  VLOG(3) << "Save the allocation profile of " << profiles.size()
+          << " places to " << path;
+}
+
+std::vector<AllocationProfile> LoadAllocationProfiles(const std::string& path) {
+  std::ifstream fin(path);
+  PADDLE_ENFORCE_EQ(
+      fin.is_open(),
+      true,
+      common::errors::NotFound("Cannot open the allocation profile %s.", path));
+  std::string header;
+  int version = 0;
+  fin >> header >> version;
+  PADDLE_ENFORCE_EQ(
+      header == kProfileHeader && version == kProfileVersion,
+      true,
+      common::errors::InvalidArgument(
+          "%s is not an allocation profile of version %d.",
+          path,
+          kProfileVersion));
+
+  std::vector<AllocationProfile> profiles;
+  std::string tag;
+  while (fin >> tag) {
+    PADDLE_ENFORCE_EQ(tag == "place",
+                      true,
+                      common::errors::InvalidArgument(
+                          "The allocation profile %s is corrupted.", path));
+    int type = 0, device_id = 0;
+    std::string device_type;
+    size_t block_num = 0;
+    AllocationProfile profile;
+    fin >> type >> device_id >> device_type >> profile.peak_bytes >> block_num;
+    profile.place = phi::Place(static_cast<phi::AllocationType>(type),
+                               static_cast<int8_t>(device_id),
+                               device_type == "-" ? "" : device_type);
+    for (size_t i = 0; i < block_num; ++i) {
+      size_t size = 0, count = 0;
+      fin >> size >> count;
+      profile.blocks.emplace_back(size, count);
+    }
+    PADDLE_ENFORCE_EQ(fin.fail(),
+                      false,
+                      common::errors::InvalidArgument(
+                          "The allocation profile %s is corrupted.", path));
+    profiles.emplace_back(std::move(profile));
+  }
+  return profiles;
+}
+
+}  // namespace paddle::memory::allocation
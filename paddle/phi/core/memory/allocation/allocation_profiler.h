@@ -0,0 +1,91 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paddle/phi/common/place.h"
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// The allocations of one place that were alive together when its usage
+// peaked, replaying them grows and splits the allocator like the recorded
+// run did.
+struct AllocationProfile {
+  phi::Place place;
+  int64_t peak_bytes{0};
+  // (size, count) sorted by size
+  std::vector<std::pair<size_t, size_t>> blocks;
+};
+
+/**
+ * AllocationProfiler records the AllocationProfile of every place from the
+ * allocations going through StatAllocator between Start and Stop. It is
+ * meant for a warmup run, whose profile is saved next to the model and
+ * replayed by ReplayAllocationProfile at startup.
+ *
+ * Only the sizes of the live allocations are tracked, and the set of live
+ * sizes is copied whenever a new peak is reached, which is rare after the
+ * first iterations.
+ */
+class TEST_API AllocationProfiler {
+ public:
+  static AllocationProfiler& Instance();
+
+  static bool IsRecording() {
+    return Instance().recording_.load(std::memory_order_relaxed);
+  }
+
+  // Discards the previous records and starts recording.
+  void Start();
+  void Stop();
+
+  void RecordAlloc(const phi::Place& place, size_t size);
+  void RecordFree(const phi::Place& place, size_t size);
+
+  std::vector<AllocationProfile> GetProfiles() const;
+
+ private:
+  AllocationProfiler() = default;
+
+  struct PlaceRecord {
+    int64_t live_bytes{0};
+    int64_t peak_bytes{0};
+    std::map<size_t, size_t> live_blocks;
+    std::map<size_t, size_t> peak_blocks;
+  };
+
+  std::atomic<bool> recording_{false};
+  std::map<phi::Place, PlaceRecord> records_;
+  mutable std::mutex mtx_;
+};
+
+TEST_API void SaveAllocationProfiles(
+    const std::string& path, const std::vector<AllocationProfile>& profiles);
+
+TEST_API std::vector<AllocationProfile> LoadAllocationProfiles(
+    const std::string& path);
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -169,6 +169,31 @@ static T&& FillValue(T&& allocation) {
   return std::forward<T>(allocation);
 }
 
+// AllocatorTelemetry is a snapshot of one layer of an allocator chain,
+// returned by Allocator::CollectTelemetry. A field is -1 or empty when the
+// layer does not track it.
+struct AllocatorTelemetry {
+  std::string allocator;
+  int64_t live_bytes{-1};
+  int64_t reserved_bytes{-1};
+  int64_t largest_free_block{-1};
+  // free_block_histogram[i] is the number of free blocks whose size is in
+  // [2^i, 2^(i+1)) bytes.
+  std::vector<int64_t> free_block_histogram;
+  // lifetime_histogram[i] is the number of sampled allocations freed after
+  // [2^i, 2^(i+1)) microseconds.
+  std::vector<int64_t> lifetime_histogram;
+};
+
+// Returns i such that value is in [2^i, 2^(i+1)), and 0 for value 0.
+inline size_t Log2Bucket(uint64_t value) {
+  size_t bucket = 0;
+  while (value >>= 1) {
+    ++bucket;
+  }
+  return bucket;
+}
+
 // Base interface class of memory Allocator.
 class Allocator : public phi::Allocator {
  public:
@@ -195,6 +220,12 @@ class Allocator : public phi::Allocator {
 
   uint64_t Release(const phi::Place& place) { return ReleaseImpl(place); }
 
+  // Appends the telemetry of this allocator and of its underlying allocators,
+  // from the outermost layer to the innermost one. Layers tracking nothing
+  // append nothing.
+  virtual void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry UNUSED) const {}
+
  protected:
   virtual phi::Allocation* AllocateImpl(size_t size) = 0;
   virtual void FreeImpl(phi::Allocation* allocation);
@@ -27,6 +27,8 @@
 #include "paddle/phi/core/memory/allocation/naive_best_fit_allocator.h"
 #include "paddle/phi/core/memory/allocation/retry_allocator.h"
 #include "paddle/phi/core/memory/allocation/stat_allocator.h"
+#include "paddle/phi/core/memory/allocation/numa_aware_cpu_allocator.h"
+#include "paddle/phi/core/memory/allocation/thread_local_cached_cpu_allocator.h"
 #include "paddle/phi/core/platform/device_context.h"
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -38,6 +40,7 @@
 #include "paddle/phi/core/memory/allocation/cuda_managed_allocator.h"
 #include "paddle/phi/core/memory/allocation/pinned_allocator.h"
 #include "paddle/phi/core/memory/allocation/stream_safe_cuda_allocator.h"
+#include "paddle/phi/core/memory/allocation/stream_safe_cuda_pinned_allocator.h"
 #include "paddle/phi/core/memory/allocation/thread_local_allocator.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 
@@ -50,6 +53,7 @@
 #if CUDA_VERSION >= 10020
 #include "paddle/phi/backends/dynload/cuda_driver.h"
 #include "paddle/phi/core/memory/allocation/cuda_malloc_async_allocator.h"
+#include "paddle/phi/core/memory/allocation/cuda_expandable_segment_allocator.h"
 #include "paddle/phi/core/memory/allocation/cuda_virtual_mem_allocator.h"
 #include "paddle/phi/core/memory/allocation/virtual_memory_auto_growth_best_fit_allocator.h"
 #endif
@@ -92,6 +96,13 @@ PHI_DEFINE_EXPORTED_bool(use_virtual_memory_auto_growth,
                          false,
                          "Use VirtualMemoryAutoGrowthBestFitAllocator.");
 
+PHI_DEFINE_EXPORTED_bool(
+    use_cuda_expandable_segments,
+    false,
+    "Whether to serve the memory of each stream from one virtual address "
+    "range that grows on demand, see CUDAExpandableSegmentAllocator. It "
+    "requires the auto_growth strategy and CUDA virtual memory management.");
+
 // NOTE(Ruibiao): This FLAGS is just to be compatible with
 // the old single-stream CUDA allocator. It will be removed
 // after StreamSafeCudaAllocator has been fully tested.
@@ -113,7 +124,10 @@ PHI_DEFINE_EXPORTED_bool(
 
 COMMON_DECLARE_string(allocator_strategy);
 COMMON_DECLARE_uint64(auto_growth_chunk_size_in_mb);
+COMMON_DECLARE_uint64(cpu_allocator_thread_cache_size_in_mb);
+COMMON_DECLARE_uint64(cpu_allocator_huge_page_threshold_in_mb);
 COMMON_DECLARE_bool(use_auto_growth_pinned_allocator);
+COMMON_DECLARE_bool(use_stream_safe_cuda_pinned_allocator);
 COMMON_DECLARE_bool(use_cuda_malloc_async_allocator);
 COMMON_DECLARE_bool(auto_free_cudagraph_allocations_on_launch);
 
@@ -533,6 +547,10 @@ class AllocatorFacadePrivate {
                        allocation)) {
       cuda_malloc_async_allocation->RecordStream(stream);
 #endif
+    } else if (auto pinned_allocation =
+                   std::dynamic_pointer_cast<StreamSafeCUDAPinnedAllocation>(
+                       allocation)) {
+      pinned_allocation->RecordStream(stream);
     } else {
       VLOG(6) << "RecordStream for a non-StreamSafeCUDAAllocation";
     }
@@ -549,6 +567,10 @@ class AllocatorFacadePrivate {
                        allocation)) {
       cuda_malloc_async_allocation->EraseStream(stream);
 #endif
+    } else if (auto pinned_allocation =
+                   std::dynamic_pointer_cast<StreamSafeCUDAPinnedAllocation>(
+                       allocation)) {
+      pinned_allocation->EraseStream(stream);
     } else {
       VLOG(6) << "EraseStream for a non-StreamSafeCUDAAllocation";
     }
@@ -827,8 +849,24 @@ class AllocatorFacadePrivate {
     allocators_[phi::CPUPlace()] =
         std::make_shared<NaiveBestFitAllocator>(phi::CPUPlace());
 #else
-    allocators_[phi::CPUPlace()] = std::make_shared<CPUAllocator>();
+    if (GetCPUNumaPolicy() != CPUNumaPolicy::kNone ||
+        GetCPUHugePagePolicy() != CPUHugePagePolicy::kNone) {
+      allocators_[phi::CPUPlace()] = std::make_shared<NumaAwareCPUAllocator>(
+          GetCPUNumaPolicy(),
+          GetCPUHugePagePolicy(),
+          FLAGS_cpu_allocator_huge_page_threshold_in_mb << 20);
+    } else {
+      allocators_[phi::CPUPlace()] = std::make_shared<CPUAllocator>();
+    }
 #endif
+    if (GetCPUAllocatorStrategy() == CPUAllocatorStrategy::kThreadLocalCache) {
+      VLOG(4) << "FLAGS_cpu_allocator_thread_cache_size_in_mb is "
+              << FLAGS_cpu_allocator_thread_cache_size_in_mb;
+      allocators_[phi::CPUPlace()] =
+          std::make_shared<ThreadLocalCachedCPUAllocator>(
+              allocators_[phi::CPUPlace()],
+              FLAGS_cpu_allocator_thread_cache_size_in_mb << 20);
+    }
   }
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -848,6 +886,11 @@ class AllocatorFacadePrivate {
       allocators_[phi::GPUPinnedPlace()] =
           std::make_shared<NaiveBestFitAllocator>(phi::GPUPinnedPlace());
     }
+    if (FLAGS_use_stream_safe_cuda_pinned_allocator) {
+      allocators_[phi::GPUPinnedPlace()] =
+          std::make_shared<StreamSafeCUDAPinnedAllocator>(
+              allocators_[phi::GPUPinnedPlace()]);
+    }
   }
 
   void InitNaiveBestFitCUDAAllocator(phi::GPUPlace p) {
@@ -965,7 +1008,11 @@ class AllocatorFacadePrivate {
       val = 0;
     }
 
-    if (val > 0 && FLAGS_use_virtual_memory_auto_growth) {
+    if (val > 0 && FLAGS_use_cuda_expandable_segments) {
+      cuda_allocators_[p][stream] =
+          std::make_shared<CUDAExpandableSegmentAllocator>(
+              p, platform::GpuMinChunkSize());
+    } else if (val > 0 && FLAGS_use_virtual_memory_auto_growth) {
       auto cuda_allocator = std::make_shared<CUDAVirtualMemAllocator>(p);
       cuda_allocators_[p][stream] =
           std::make_shared<VirtualMemoryAutoGrowthBestFitAllocator>(
@@ -1081,7 +1128,10 @@ class AllocatorFacadePrivate {
       val = 0;
     }
 
-    if (val > 0 && FLAGS_use_virtual_memory_auto_growth) {
+    if (val > 0 && FLAGS_use_cuda_expandable_segments) {
+      allocators_[p] = std::make_shared<CUDAExpandableSegmentAllocator>(
+          p, platform::GpuMinChunkSize());
+    } else if (val > 0 && FLAGS_use_virtual_memory_auto_growth) {
       auto cuda_allocator = std::make_shared<CUDAVirtualMemAllocator>(p);
       allocators_[p] =
           std::make_shared<VirtualMemoryAutoGrowthBestFitAllocator>(
@@ -1691,6 +1741,15 @@ uint64_t AllocatorFacade::Release(const phi::Place& place) {
       ->Release(place);
 }
 
+std::vector<AllocatorTelemetry> AllocatorFacade::GetAllocatorTelemetry(
+    const phi::Place& place) {
+  std::vector<AllocatorTelemetry> telemetry;
+  GetPrivate()
+      ->GetAllocator(place, /* A non-zero num to choose allocator_ */ 1)
+      ->CollectTelemetry(&telemetry);
+  return telemetry;
+}
+
 std::shared_ptr<phi::Allocation> AllocatorFacade::AllocShared(
     const phi::Place& place, size_t size, const phi::Stream& stream) {
   return std::shared_ptr<phi::Allocation>(Alloc(place, size, stream));
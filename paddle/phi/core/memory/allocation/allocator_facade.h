@@ -14,6 +14,7 @@
 
 #pragma once
 #include <memory>
+#include <vector>
 
 #include "paddle/phi/core/memory/allocation/allocator.h"
 #ifdef PADDLE_WITH_CUDA
@@ -69,6 +70,9 @@ class AllocatorFacade {
   AllocationPtr Alloc(const phi::Place& place, size_t size);
   // Release unused memory pool.
   uint64_t Release(const phi::Place& place);
+  // Telemetry of each layer of the allocator used for place.
+  std::vector<AllocatorTelemetry> GetAllocatorTelemetry(
+      const phi::Place& place);
 
   std::shared_ptr<Allocation> AllocShared(const phi::Place& place,
                                           size_t size,
@@ -18,6 +18,9 @@
 #include "paddle/phi/core/enforce.h"
 
 COMMON_DECLARE_string(allocator_strategy);
+COMMON_DECLARE_string(cpu_allocator_strategy);
+COMMON_DECLARE_string(cpu_allocator_numa_policy);
+COMMON_DECLARE_string(cpu_allocator_huge_page);
 
 namespace paddle {
 namespace memory {
@@ -47,6 +50,74 @@ AllocatorStrategy GetAllocatorStrategy() {
   return strategy;
 }
 
+static CPUAllocatorStrategy GetCPUStrategyFromFlag() {
+  if (FLAGS_cpu_allocator_strategy == "system") {
+    return CPUAllocatorStrategy::kSystem;
+  }
+
+  if (FLAGS_cpu_allocator_strategy == "thread_local_cache") {
+    return CPUAllocatorStrategy::kThreadLocalCache;
+  }
+
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "Unsupported CPU allocator strategy: %s, candidates are system or "
+      "thread_local_cache.",
+      FLAGS_cpu_allocator_strategy));
+}
+
+CPUAllocatorStrategy GetCPUAllocatorStrategy() {
+  static CPUAllocatorStrategy strategy = GetCPUStrategyFromFlag();
+  return strategy;
+}
+
+static CPUNumaPolicy GetCPUNumaPolicyFromFlag() {
+  if (FLAGS_cpu_allocator_numa_policy == "none") {
+    return CPUNumaPolicy::kNone;
+  }
+
+  if (FLAGS_cpu_allocator_numa_policy == "local") {
+    return CPUNumaPolicy::kLocal;
+  }
+
+  if (FLAGS_cpu_allocator_numa_policy == "interleave") {
+    return CPUNumaPolicy::kInterleave;
+  }
+
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "Unsupported CPU NUMA policy: %s, candidates are none, local or "
+      "interleave.",
+      FLAGS_cpu_allocator_numa_policy));
+}
+
+CPUNumaPolicy GetCPUNumaPolicy() {
+  static CPUNumaPolicy policy = GetCPUNumaPolicyFromFlag();
+  return policy;
+}
+
+static CPUHugePagePolicy GetCPUHugePagePolicyFromFlag() {
+  if (FLAGS_cpu_allocator_huge_page == "none") {
+    return CPUHugePagePolicy::kNone;
+  }
+
+  if (FLAGS_cpu_allocator_huge_page == "transparent") {
+    return CPUHugePagePolicy::kTransparent;
+  }
+
+  if (FLAGS_cpu_allocator_huge_page == "explicit") {
+    return CPUHugePagePolicy::kExplicit;
+  }
+
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "Unsupported CPU huge page policy: %s, candidates are none, "
+      "transparent or explicit.",
+      FLAGS_cpu_allocator_huge_page));
+}
+
+CPUHugePagePolicy GetCPUHugePagePolicy() {
+  static CPUHugePagePolicy policy = GetCPUHugePagePolicyFromFlag();
+  return policy;
+}
+
 void UseAllocatorStrategyGFlag() {}
 }  // namespace allocation
 }  // namespace memory
@@ -23,6 +23,21 @@ enum class AllocatorStrategy { kNaiveBestFit, kAutoGrowth, kThreadLocal };
 
 extern AllocatorStrategy GetAllocatorStrategy();
 
+// The strategy of the CPUPlace allocator, independent of the device one.
+enum class CPUAllocatorStrategy { kSystem, kThreadLocalCache };
+
+extern CPUAllocatorStrategy GetCPUAllocatorStrategy();
+
+// Where the pages of large CPU blocks are placed on NUMA hosts.
+enum class CPUNumaPolicy { kNone, kLocal, kInterleave };
+
+extern CPUNumaPolicy GetCPUNumaPolicy();
+
+// Whether large CPU blocks are backed by huge pages.
+enum class CPUHugePagePolicy { kNone, kTransparent, kExplicit };
+
+extern CPUHugePagePolicy GetCPUHugePagePolicy();
+
 // Do nothing, just make sure linker do not prune this file.
 TEST_API void UseAllocatorStrategyGFlag();
 
@@ -22,6 +22,7 @@
 #include "paddle/phi/api/profiler/event_tracing.h"
 #include "paddle/phi/backends/device_manager.h"
 #include "paddle/phi/core/memory/allocation/aligned_allocator.h"
+#include "paddle/phi/core/memory/stats.h"
 
 PHI_DEFINE_EXPORTED_READONLY_bool(
     free_idle_chunk,
@@ -44,8 +45,21 @@ PHI_DEFINE_EXPORTED_READONLY_bool(print_allocator_trace_info,
                                   "print trace memory info");
 
 PHI_DEFINE_EXPORTED_READONLY_bool(dump_chunk_info, false, "dump chunk info");
+
+PHI_DEFINE_EXPORTED_uint64(
+    auto_growth_size_class_threshold,
+    0,
+    "The max size (in bytes) of requests served by the segregated size-class "
+    "free lists of AutoGrowthBestFitAllocator. Requests larger than it go "
+    "through the best-fit free map. 0 means size classes are disabled. This "
+    "flag only works when FLAGS_allocator_strategy=auto_growth.");
+
 namespace paddle::memory::allocation {
 
+// Bytes fetched from the best-fit map each time a size class runs empty.
+static constexpr size_t kSizeClassRefillBytes = 1 << 20;
+static constexpr size_t kSizeClassMaxRefillBlocks = 16;
+
 AutoGrowthBestFitAllocator::AutoGrowthBestFitAllocator(
     std::shared_ptr<Allocator> underlying_allocator,
     size_t alignment,
@@ -62,6 +76,97 @@ AutoGrowthBestFitAllocator::AutoGrowthBestFitAllocator(
   total_free_times_ = 0;
   total_free_size_ = 0;
   VLOG(4) << "chunk_size_:" << chunk_size_;
+
+  // Size classes are alignment_ << k, so every class size is aligned and the
+  // class holding a block can be recovered from the block size alone. They
+  // are disabled with FLAGS_free_idle_chunk, which asks for no caching.
+  size_t threshold =
+      FLAGS_free_idle_chunk ? 0 : FLAGS_auto_growth_size_class_threshold;
+  for (size_t block_size = alignment_;
+       block_size > 0 && block_size <= threshold;
+       block_size <<= 1) {
+    size_classes_.emplace_back(std::make_unique<SizeClass>(block_size));
+  }
+  VLOG(4) << "size_classes_num:" << size_classes_.size();
+}
+
+int AutoGrowthBestFitAllocator::SizeClassIndex(size_t size) const {
+  if (size_classes_.empty() || size > size_classes_.back()->block_size) {
+    return -1;
+  }
+  int idx = 0;
+  while (size_classes_[idx]->block_size < size) {
+    ++idx;
+  }
+  return idx;
+}
+
+std::vector<SizeClassStatInfo> AutoGrowthBestFitAllocator::GetSizeClassStats()
+    const {
+  std::vector<SizeClassStatInfo> stats;
+  stats.reserve(size_classes_.size());
+  for (auto &size_class : size_classes_) {
+    std::lock_guard<SpinLock> guard(size_class->lock);
+    SizeClassStatInfo info;
+    info.block_size = size_class->block_size;
+    info.alloc_times = size_class->alloc_times;
+    info.hit_times = size_class->hit_times;
+    info.refill_times = size_class->refill_times;
+    info.cached_blocks = size_class->free_blocks.size();
+    stats.emplace_back(info);
+  }
+  return stats;
+}
+
+void AutoGrowthBestFitAllocator::CollectTelemetry(
+    std::vector<AllocatorTelemetry> *telemetry) const {
+  AllocatorTelemetry info;
+  info.allocator = "AutoGrowthBestFitAllocator";
+  int64_t reserved_bytes = 0;
+  int64_t free_bytes = 0;
+  auto add_free_block = [&](size_t size) {
+    size_t bucket = Log2Bucket(size);
+    if (info.free_block_histogram.size() <= bucket) {
+      info.free_block_histogram.resize(bucket + 1, 0);
+    }
+    ++info.free_block_histogram[bucket];
+    free_bytes += static_cast<int64_t>(size);
+  };
+  {
+    std::lock_guard<SpinLock> guard(spinlock_);
+    for (auto &chunk : chunks_) {
+      reserved_bytes += static_cast<int64_t>(chunk.allocation_->size());
+    }
+    for (auto &pair : free_blocks_) {
+      add_free_block(pair.first.first);
+    }
+    info.largest_free_block =
+        free_blocks_.empty()
+            ? 0
+            : static_cast<int64_t>(free_blocks_.rbegin()->first.first);
+    // Blocks cached by size classes are free for the users of this
+    // allocator, although they are not coalesced.
+    for (auto &size_class : size_classes_) {
+      std::lock_guard<SpinLock> class_guard(size_class->lock);
+      for (size_t i = 0; i < size_class->free_blocks.size(); ++i) {
+        add_free_block(size_class->block_size);
+      }
+    }
+  }
+  info.reserved_bytes = reserved_bytes;
+  info.live_bytes = reserved_bytes - free_bytes;
+  telemetry->emplace_back(std::move(info));
+  underlying_allocator_->CollectTelemetry(telemetry);
+}
+
+void AutoGrowthBestFitAllocator::UpdateSizeClassCachedStat(
+    BlockIt block_it, int64_t increment) const {
+  const phi::Place &place = block_it->chunk_->allocation_->place();
+  if (phi::is_cpu_place(place) || phi::is_cuda_pinned_place(place)) {
+    HOST_MEMORY_STAT_UPDATE(SizeClassCached, place.GetDeviceId(), increment);
+  } else {
+    DEVICE_MEMORY_STAT_UPDATE(SizeClassCached, place.GetDeviceId(), increment);
+  }
 }
 
 void AutoGrowthBestFitAllocator::DumpInfo() const {
@@ -96,7 +201,73 @@ phi::Allocation *AutoGrowthBestFitAllocator::AllocateImpl(
   VLOG(10) << "Allocate " << unaligned_size << " bytes, aligned to " << size
            << ", extra size " << extra_padding_size_;
 
+  int class_idx = SizeClassIndex(size);
+  if (class_idx >= 0) {
+    return AllocateFromSizeClass(size_classes_[class_idx].get());
+  }
+
   std::lock_guard<SpinLock> guard(spinlock_);
+  BlockIt block_it = AllocFromFreeBlocksOrGrow(size);
+  ++total_alloc_times_;
+  total_alloc_size_ += size;
+  VLOG(10) << "Alloc " << block_it->size_ << " bytes, ptr = " << block_it->ptr_;
+  return new BlockAllocation(block_it);
+}
+
+phi::Allocation *AutoGrowthBestFitAllocator::AllocateFromSizeClass(
+    SizeClass *size_class) {
+  size_t size = size_class->block_size;
+  {
+    std::lock_guard<SpinLock> guard(size_class->lock);
+    ++size_class->alloc_times;
+    if (!size_class->free_blocks.empty()) {
+      BlockIt block_it = size_class->free_blocks.back();
+      size_class->free_blocks.pop_back();
+      ++size_class->hit_times;
+      UpdateSizeClassCachedStat(block_it, -static_cast<int64_t>(size));
+      VLOG(10) << "Alloc " << size << " bytes from size class, ptr = "
+               << block_it->ptr_;
+      return new BlockAllocation(block_it);
+    }
+  }
+
+  // Refill without holding the size class lock, so that the lock order is
+  // always spinlock_ -> size_class->lock.
+  size_t refill_num = std::min(
+      std::max(kSizeClassRefillBytes / size, static_cast<size_t>(1)),
+      kSizeClassMaxRefillBlocks);
+  std::vector<BlockIt> blocks;
+  blocks.reserve(refill_num);
+  {
+    std::lock_guard<SpinLock> guard(spinlock_);
+    blocks.emplace_back(AllocFromFreeBlocksOrGrow(size));
+    // The extra blocks are only carved from cached memory, a refill never
+    // grows a new chunk on their behalf.
+    while (blocks.size() < refill_num &&
+           free_blocks_.lower_bound(std::make_pair(size, nullptr)) !=
+               free_blocks_.end()) {
+      blocks.emplace_back(AllocFromFreeBlocksOrGrow(size));
+    }
+    total_alloc_times_ += blocks.size();
+    total_alloc_size_ += blocks.size() * size;
+  }
+
+  BlockIt block_it = blocks.front();
+  if (blocks.size() > 1) {
+    std::lock_guard<SpinLock> guard(size_class->lock);
+    ++size_class->refill_times;
+    size_class->free_blocks.insert(
+        size_class->free_blocks.end(), blocks.begin() + 1, blocks.end());
+    UpdateSizeClassCachedStat(
+        block_it, static_cast<int64_t>((blocks.size() - 1) * size));
+  }
+  VLOG(10) << "Alloc " << size << " bytes from size class after refilling "
+           << blocks.size() << " blocks, ptr = " << block_it->ptr_;
+  return new BlockAllocation(block_it);
+}
+
+AutoGrowthBestFitAllocator::BlockIt
+AutoGrowthBestFitAllocator::AllocFromFreeBlocksOrGrow(size_t size) {
   auto iter = free_blocks_.lower_bound(std::make_pair(size, nullptr));
   BlockIt block_it;
   if (iter != free_blocks_.end()) {
@@ -164,10 +335,7 @@ phi::Allocation *AutoGrowthBestFitAllocator::AllocateImpl(
       DumpInfo();
     }
   }
-  ++total_alloc_times_;
-  total_alloc_size_ += size;
-  VLOG(10) << "Alloc " << block_it->size_ << " bytes, ptr = " << block_it->ptr_;
-  return new BlockAllocation(block_it);
+  return block_it;
 }
 
 void AutoGrowthBestFitAllocator::FreeImpl(phi::Allocation *allocation) {
@@ -176,8 +344,29 @@ void AutoGrowthBestFitAllocator::FreeImpl(phi::Allocation *allocation) {
                           9 /*level*/);
   VLOG(10) << "Free " << allocation->size()
            << " bytes, ptr = " << allocation->ptr();
-  std::lock_guard<SpinLock> guard(spinlock_);
   auto block_it = static_cast<BlockAllocation *>(allocation)->block_it_;
+  int class_idx = SizeClassIndex(allocation->size());
+  if (class_idx >= 0 &&
+      size_classes_[class_idx]->block_size == allocation->size()) {
+    auto *size_class = size_classes_[class_idx].get();
+    std::lock_guard<SpinLock> guard(size_class->lock);
+    size_class->free_blocks.emplace_back(block_it);
+    UpdateSizeClassCachedStat(block_it,
+                              static_cast<int64_t>(size_class->block_size));
+    delete allocation;
+    return;
+  }
+
+  std::lock_guard<SpinLock> guard(spinlock_);
+  FreeBlock(block_it);
+  delete allocation;
+
+  if (FLAGS_free_idle_chunk) {
+    FreeIdleChunks();
+  }
+}
+
+void AutoGrowthBestFitAllocator::FreeBlock(BlockIt block_it) {
   auto &blocks = block_it->chunk_->blocks_;
 
   total_free_times_ += 1;
@@ -208,11 +397,20 @@ void AutoGrowthBestFitAllocator::FreeImpl(phi::Allocation *allocation) {
 
   free_blocks_.emplace(std::make_pair(block_it->size_, block_it->ptr_),
                        block_it);
+}
 
-  delete allocation;
-
-  if (FLAGS_free_idle_chunk) {
-    FreeIdleChunks();
+void AutoGrowthBestFitAllocator::FlushSizeClasses() {
+  for (auto &size_class : size_classes_) {
+    std::vector<BlockIt> blocks;
+    {
+      std::lock_guard<SpinLock> guard(size_class->lock);
+      blocks.swap(size_class->free_blocks);
+    }
+    for (auto block_it : blocks) {
+      UpdateSizeClassCachedStat(block_it,
+                                -static_cast<int64_t>(size_class->block_size));
+      FreeBlock(block_it);
+    }
   }
 }
 
@@ -223,6 +421,7 @@ uint64_t AutoGrowthBestFitAllocator::FreeIdleChunks() {
   if (!allow_free_idle_chunk_) {
     return 0;
   }
+  FlushSizeClasses();
   uint64_t bytes = 0;
   for (auto chunk_it = chunks_.begin(); chunk_it != chunks_.end();) {
     auto &blocks = chunk_it->blocks_;
@@ -267,6 +466,14 @@ void AutoGrowthBestFitAllocator::Trace() const {
           << " free_times:" << total_free_times_
           << " free_blocks_num:" << free_blocks_.size()
           << " curr_chunks_num:" << chunks_.size();
+
+  for (auto &info : GetSizeClassStats()) {
+    VLOG(1) << "size_class:" << info.block_size
+            << " alloc_times:" << info.alloc_times
+            << " hit_times:" << info.hit_times
+            << " refill_times:" << info.refill_times
+            << " cached_blocks:" << info.cached_blocks;
+  }
 }
 
 }  // namespace paddle::memory::allocation
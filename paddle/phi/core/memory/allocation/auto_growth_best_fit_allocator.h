@@ -19,6 +19,7 @@
 #include <memory>
 #include <mutex>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "paddle/phi/core/memory/allocation/allocator.h"
 #include "paddle/phi/core/memory/allocation/spin_lock.h"
@@ -27,6 +28,25 @@ namespace paddle {
 namespace memory {
 namespace allocation {
 
+struct SizeClassStatInfo {
+  size_t block_size{0};
+  size_t alloc_times{0};
+  size_t hit_times{0};
+  size_t refill_times{0};
+  size_t cached_blocks{0};
+};
+
+/**
+ * AutoGrowthBestFitAllocator serves requests from a best-fit map of free
+ * blocks and grows by chunks when no free block fits.
+ *
+ * When FLAGS_auto_growth_size_class_threshold is greater than 0, requests no
+ * larger than the threshold are served from segregated free lists instead.
+ * Each list holds blocks of exactly one size class (alignment << k) and is
+ * guarded by its own lock, so small allocations neither contend on the global
+ * lock nor fragment the best-fit map. Lists are refilled in batches from the
+ * best-fit map and flushed back to it on Release() or when out of memory.
+ */
 class AutoGrowthBestFitAllocator : public Allocator {
  public:
   AutoGrowthBestFitAllocator(std::shared_ptr<Allocator> underlying_allocator,
@@ -39,6 +59,13 @@ class AutoGrowthBestFitAllocator : public Allocator {
 
   void DumpInfo() const;
 
+  bool IsSizeClassEnabled() const { return !size_classes_.empty(); }
+
+  std::vector<SizeClassStatInfo> GetSizeClassStats() const;
+
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry> *telemetry) const override;
+
  protected:
   phi::Allocation *AllocateImpl(size_t size) override;
 
@@ -51,6 +78,7 @@ class AutoGrowthBestFitAllocator : public Allocator {
   }
 
  protected:
+  // Flushes all size-class caches back to free_blocks_ before releasing.
   uint64_t FreeIdleChunks();
   void Trace() const;
 
@@ -90,6 +118,28 @@ class AutoGrowthBestFitAllocator : public Allocator {
 
   using BlockIt = List<Block>::iterator;
 
+  struct SizeClass {
+    explicit SizeClass(size_t size) : block_size(size) {}
+
+    const size_t block_size;
+    std::vector<BlockIt> free_blocks;
+    size_t alloc_times{0};
+    size_t hit_times{0};
+    size_t refill_times{0};
+    mutable SpinLock lock;
+  };
+
+  // The following methods must be called with spinlock_ held.
+  BlockIt AllocFromFreeBlocksOrGrow(size_t size);
+  void FreeBlock(BlockIt block_it);
+  void FlushSizeClasses();
+
+  // Returns the index of the size class serving `size`, or -1 if `size` should
+  // go through the best-fit map.
+  int SizeClassIndex(size_t size) const;
+  phi::Allocation *AllocateFromSizeClass(SizeClass *size_class);
+  void UpdateSizeClassCachedStat(BlockIt block_it, int64_t increment) const;
+
   std::shared_ptr<Allocator> underlying_allocator_;
   std::map<std::pair<size_t, void *>, BlockIt> free_blocks_;
   std::list<Chunk> chunks_;
@@ -97,6 +147,7 @@ class AutoGrowthBestFitAllocator : public Allocator {
   size_t chunk_size_;
   bool allow_free_idle_chunk_;
   int extra_padding_size_;
+  std::vector<std::unique_ptr<SizeClass>> size_classes_;
 
   // stat info
   size_t total_alloc_times_;
@@ -104,7 +155,7 @@ class AutoGrowthBestFitAllocator : public Allocator {
   size_t total_free_times_;
   size_t total_free_size_;
 
-  SpinLock spinlock_;
+  mutable SpinLock spinlock_;
 };
 
 }  // namespace allocation
@@ -0,0 +1,320 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/cuda_expandable_segment_allocator.h"
+
+#include <algorithm>
+#include <string>
+
+#include "paddle/phi/core/enforce.h"
+
+#ifdef PADDLE_WITH_CUDA
+#include "paddle/phi/backends/dynload/cuda_driver.h"
+#include "paddle/phi/core/platform/cuda_device_guard.h"
+#include "paddle/phi/core/platform/device/gpu/gpu_info.h"
+#endif
+#if CUDA_VERSION >= 10020
+
+namespace paddle::memory::allocation {
+
+CUDAExpandableSegmentAllocator::CUDAExpandableSegmentAllocator(
+    const phi::GPUPlace& place, size_t alignment)
+    : place_(place), alignment_(alignment), base_(0), prop_{} {
+  prop_.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+  prop_.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+  prop_.location.id = place.device;  // NOLINT
+
+  // The pages are accessible from the peers of the device, like the memory
+  // of CUDAVirtualMemAllocator.
+  for (int dev_id = 0; dev_id < platform::GetGPUDeviceCount(); ++dev_id) {
+    if (place.device != dev_id) {
+      int capable = 0;
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaDeviceCanAccessPeer(&capable, place.device, dev_id));
+      if (!capable) {
+        VLOG(1) << "device(" << place.device
+                << ") can not access peer to device(" << dev_id << ")";
+        continue;
+      }
+    }
+    CUmemAccessDesc access_desc = {};
+    access_desc.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+    access_desc.location.id = dev_id;
+    access_desc.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+    access_desc_.push_back(access_desc);
+  }
+
+  granularity_ = 0;
+  CUmemAllocationProp prop = prop_;
+  for (int dev_id = 0; dev_id < platform::GetGPUDeviceCount(); ++dev_id) {
+    size_t granularity;
+    prop.location.id = dev_id;
+    PADDLE_ENFORCE_GPU_SUCCESS(phi::dynload::cuMemGetAllocationGranularity(
+        &granularity, &prop, CU_MEM_ALLOC_GRANULARITY_MINIMUM));
+    granularity_ = std::max(granularity, granularity_);
+  }
+
+  size_t actual_avail, actual_total;
+  paddle::platform::CUDADeviceGuard guard(place.device);
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaMemGetInfo(&actual_avail, &actual_total));
+
+  // No stream can use more than the whole device memory, so the range is
+  // never exhausted before the physical memory.
+  reserved_size_ = AlignedSize(actual_total, granularity_);
+  PADDLE_ENFORCE_GPU_SUCCESS(
+      phi::dynload::cuMemAddressReserve(&base_, reserved_size_, 0, 0, 0));
+
+  blocks_.emplace_back(0, reserved_size_, true);
+  InsertFreeBlock(blocks_.begin());
+}
+
+CUDAExpandableSegmentAllocator::~CUDAExpandableSegmentAllocator() {
+  // NOTE: the CUDA driver may have been deinitialized at exit, so errors are
+  // ignored here.
+  int prev_id;
+  cudaGetDevice(&prev_id);
+  if (prev_id != place_.device) {
+    cudaSetDevice(place_.device);
+  }
+  for (auto& pair : pages_) {
+    CUdeviceptr ptr = base_ + pair.first * granularity_;
+    auto result = phi::dynload::cuMemUnmap(ptr, granularity_);
+    if (result == CUDA_SUCCESS) {
+      platform::RecordedGpuMemRelease(pair.second, granularity_, place_.device);
+    }
+  }
+  pages_.clear();
+  phi::dynload::cuMemAddressFree(base_, reserved_size_);
+  if (prev_id != place_.device) {
+    cudaSetDevice(prev_id);
+  }
+}
+
+size_t CUDAExpandableSegmentAllocator::MappedSize() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  return pages_.size() * granularity_;
+}
+
+phi::Allocation* CUDAExpandableSegmentAllocator::AllocateImpl(size_t size) {
+  size = AlignedSize(std::max<size_t>(size, 1), alignment_);
+  std::lock_guard<std::mutex> guard(mtx_);
+
+  auto iter = free_blocks_.lower_bound(std::make_pair(size, size_t{0}));
+  if (iter == free_blocks_.end()) {
+    PADDLE_THROW_BAD_ALLOC(common::errors::ResourceExhausted(
+        "\n\nOut of memory error on GPU %d. Cannot allocate %s memory, the "
+        "reserved virtual address range of %s has no such large free "
+        "block.\n\n",
+        place_.device,
+        string::HumanReadableSize(size),
+        string::HumanReadableSize(reserved_size_)));
+  }
+
+  // Take the front of the best fit block, so that the used part of the range
+  // grows from the beginning.
+  BlockIt block_it = iter->second;
+  free_blocks_.erase(iter);
+  if (block_it->size_ > size) {
+    auto remaining = blocks_.insert(
+        std::next(block_it),
+        SegmentBlock(block_it->offset_ + size, block_it->size_ - size, true));
+    InsertFreeBlock(remaining);
+    block_it->size_ = size;
+  }
+  block_it->is_free_ = false;
+
+  size_t begin = block_it->offset_ / granularity_;
+  size_t end = (block_it->offset_ + size + granularity_ - 1) / granularity_;
+  if (!MapPages(begin, end)) {
+    VLOG(4) << "Mapping " << string::HumanReadableSize(size) << " on GPU "
+            << place_.device << " failed, unmap the idle pages and retry";
+    if (UnmapIdlePages() == 0 || !MapPages(begin, end)) {
+      FreeBlock(block_it);
+      UnmapIdlePages();
+
+      size_t actual_avail, actual_total;
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaMemGetInfo(&actual_avail, &actual_total));
+      PADDLE_THROW_BAD_ALLOC(common::errors::ResourceExhausted(
+          "\n\nOut of memory error on GPU %d. "
+          "Cannot allocate %s memory on GPU %d, %s memory has been allocated "
+          "and available memory is only %s.\n\n"
+          "Please check whether there is any other process using GPU %d.\n"
+          "1. If yes, please stop them, or start PaddlePaddle on another GPU.\n"
+          "2. If no, please decrease the batch size of your model.\n\n",
+          place_.device,
+          string::HumanReadableSize(size),
+          place_.device,
+          string::HumanReadableSize(actual_total - actual_avail),
+          string::HumanReadableSize(actual_avail),
+          place_.device));
+    }
+  }
+
+  return new SegmentAllocation(
+      reinterpret_cast<void*>(base_ + block_it->offset_),  // NOLINT
+      block_it,
+      phi::Place(place_));
+}
+
+void CUDAExpandableSegmentAllocator::FreeImpl(phi::Allocation* allocation) {
+  PADDLE_ENFORCE_EQ(
+      allocation->place(),
+      place_,
+      common::errors::PermissionDenied(
+          "GPU memory is freed in incorrect device. This may be a bug"));
+  {
+    std::lock_guard<std::mutex> guard(mtx_);
+    FreeBlock(static_cast<SegmentAllocation*>(allocation)->block_it_);
+  }
+  delete allocation;
+}
+
+uint64_t CUDAExpandableSegmentAllocator::ReleaseImpl(const phi::Place& place) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  return UnmapIdlePages();
+}
+
+void CUDAExpandableSegmentAllocator::CollectTelemetry(
+    std::vector<AllocatorTelemetry>* telemetry) const {
+  AllocatorTelemetry info;
+  info.allocator = "CUDAExpandableSegmentAllocator";
+  int64_t live_bytes = 0;
+  int64_t largest_free_block = 0;
+  {
+    std::lock_guard<std::mutex> guard(mtx_);
+    for (auto& block : blocks_) {
+      if (!block.is_free_) {
+        live_bytes += static_cast<int64_t>(block.size_);
+        continue;
+      }
+      // The trailing free block is the unused tail of the range rather than
+      // a hole between allocations.
+      if (block.offset_ + block.size_ == reserved_size_) {
+        continue;
+      }
+      size_t bucket = Log2Bucket(block.size_);
+      if (info.free_block_histogram.size() <= bucket) {
+        info.free_block_histogram.resize(bucket + 1, 0);
+      }
+      ++info.free_block_histogram[bucket];
+      largest_free_block =
+          std::max(largest_free_block, static_cast<int64_t>(block.size_));
+    }
+    info.reserved_bytes = static_cast<int64_t>(pages_.size() * granularity_);
+  }
+  info.live_bytes = live_bytes;
+  info.largest_free_block = largest_free_block;
+  telemetry->push_back(std::move(info));
+}
+
+void CUDAExpandableSegmentAllocator::InsertFreeBlock(BlockIt it) {
+  free_blocks_.emplace(std::make_pair(it->size_, it->offset_), it);
+}
+
+void CUDAExpandableSegmentAllocator::EraseFreeBlock(BlockIt it) {
+  free_blocks_.erase(std::make_pair(it->size_, it->offset_));
+}
+
+void CUDAExpandableSegmentAllocator::FreeBlock(BlockIt it) {
+  it->is_free_ = true;
+  if (it != blocks_.begin()) {
+    auto pre = std::prev(it);
+    if (pre->is_free_) {
+      EraseFreeBlock(pre);
+      pre->size_ += it->size_;
+      blocks_.erase(it);
+      it = pre;
+    }
+  }
+  auto next = std::next(it);
+  if (next != blocks_.end() && next->is_free_) {
+    EraseFreeBlock(next);
+    it->size_ += next->size_;
+    blocks_.erase(next);
+  }
+  InsertFreeBlock(it);
+}
+
+bool CUDAExpandableSegmentAllocator::MapPages(size_t begin, size_t end) {
+  paddle::platform::CUDADeviceGuard guard(place_.device);
+  for (size_t page = begin; page < end; ++page) {
+    if (pages_.count(page) != 0) {
+      continue;
+    }
+    CUdeviceptr ptr = base_ + page * granularity_;
+    CUmemGenericAllocationHandle handle;
+    auto result = platform::RecordedGpuMemCreate(
+        &handle, granularity_, &prop_, 0, place_.device);
+    if (result == CUDA_ERROR_OUT_OF_MEMORY) {
+      return false;
+    }
+    PADDLE_ENFORCE_GPU_SUCCESS(result);
+
+    result = phi::dynload::cuMemMap(ptr, granularity_, 0, handle, 0);
+    if (result != CUDA_SUCCESS) {
+      platform::RecordedGpuMemRelease(handle, granularity_, place_.device);
+      PADDLE_ENFORCE_GPU_SUCCESS(result);
+    }
+
+    result = phi::dynload::cuMemSetAccess(
+        ptr, granularity_, access_desc_.data(), access_desc_.size());
+    if (result != CUDA_SUCCESS) {
+      phi::dynload::cuMemUnmap(ptr, granularity_);
+      platform::RecordedGpuMemRelease(handle, granularity_, place_.device);
+      PADDLE_ENFORCE_GPU_SUCCESS(result);
+    }
+    pages_.emplace(page, handle);
+  }
+  return true;
+}
+
+void CUDAExpandableSegmentAllocator::UnmapPage(
+    size_t page, CUmemGenericAllocationHandle handle) {
+  auto result =
+      phi::dynload::cuMemUnmap(base_ + page * granularity_, granularity_);
+  if (result != CUDA_ERROR_DEINITIALIZED) {
+    PADDLE_ENFORCE_GPU_SUCCESS(result);
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        platform::RecordedGpuMemRelease(handle, granularity_, place_.device));
+  }
+}
+
+size_t CUDAExpandableSegmentAllocator::UnmapIdlePages() {
+  if (pages_.empty()) {
+    return 0;
+  }
+  // Free blocks are always merged with their free neighbours, so a page lying
+  // entirely in a free block is not used by any allocated block, and a page
+  // partially covered by a free block is used by its neighbour.
+  paddle::platform::CUDADeviceGuard guard(place_.device);
+  size_t unmapped = 0;
+  for (auto& pair : free_blocks_) {
+    const SegmentBlock& block = *pair.second;
+    size_t begin = (block.offset_ + granularity_ - 1) / granularity_;
+    size_t end = (block.offset_ + block.size_) / granularity_;
+    auto it = pages_.lower_bound(begin);
+    while (it != pages_.end() && it->first < end) {
+      UnmapPage(it->first, it->second);
+      unmapped += granularity_;
+      it = pages_.erase(it);
+    }
+  }
+  VLOG(4) << "Unmap " << string::HumanReadableSize(unmapped)
+          << " idle memory on GPU " << place_.device;
+  return unmapped;
+}
+
+}  // namespace paddle::memory::allocation
+
+#endif
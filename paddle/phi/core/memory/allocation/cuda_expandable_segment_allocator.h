@@ -0,0 +1,125 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef PADDLE_WITH_CUDA
+#include <cuda.h>
+#include <cuda_runtime.h>
+#endif
+
+#include <list>
+#include <map>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/memory/allocation/allocator.h"
+
+#if CUDA_VERSION >= 10020
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+/**
+ * CUDAExpandableSegmentAllocator serves all the allocations of one stream
+ * from a single virtual address range, reserved once as large as the device
+ * memory. Physical pages of the allocation granularity are mapped into the
+ * range only when a block placed over them is handed out, and the pages that
+ * are no longer covered by any allocated block are unmapped on Release, even
+ * when they are in the middle of the range.
+ *
+ * Freeing a block in the middle of the range leaves a hole in the address
+ * space. Once Release unmaps the pages under it, the hole only holds virtual
+ * addresses and not device memory. A large tensor gets a contiguous
+ * block as long as a free block of the range is large enough, which the
+ * untouched tail of the range usually is. Running out of device memory
+ * means that the idle pages have to be unmapped first, which is done here
+ * before reporting an out of memory error.
+ */
+class CUDAExpandableSegmentAllocator : public Allocator {
+ public:
+  CUDAExpandableSegmentAllocator(const phi::GPUPlace& place, size_t alignment);
+  ~CUDAExpandableSegmentAllocator();
+
+  bool IsAllocThreadSafe() const override { return true; }
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry) const override;
+
+  size_t Granularity() const { return granularity_; }
+  // Bytes of physical memory mapped into the range.
+  size_t MappedSize() const;
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+  uint64_t ReleaseImpl(const phi::Place& place) override;
+
+ private:
+  struct SegmentBlock {
+    SegmentBlock(size_t offset, size_t size, bool is_free)
+        : offset_(offset), size_(size), is_free_(is_free) {}
+
+    size_t offset_;
+    size_t size_;
+    bool is_free_;
+  };
+  using BlockIt = std::list<SegmentBlock>::iterator;
+
+  struct SegmentAllocation : public Allocation {
+    SegmentAllocation(void* ptr, const BlockIt& it, const phi::Place& place)
+        : Allocation(ptr, it->size_, place), block_it_(it) {}
+
+    BlockIt block_it_;
+  };
+
+  void InsertFreeBlock(BlockIt it);
+  void EraseFreeBlock(BlockIt it);
+  // Marks the block free and merges it with its free neighbours.
+  void FreeBlock(BlockIt it);
+
+  // Maps the pages in [begin, end) that are not mapped yet, returns false
+  // when the device runs out of memory.
+  bool MapPages(size_t begin, size_t end);
+  void UnmapPage(size_t page, CUmemGenericAllocationHandle handle);
+  // Unmaps the pages not covered by any allocated block, returns the bytes
+  // unmapped.
+  size_t UnmapIdlePages();
+
+  phi::GPUPlace place_;
+  size_t alignment_;
+  size_t granularity_;
+
+  CUdeviceptr base_;
+  size_t reserved_size_;
+
+  CUmemAllocationProp prop_;
+  std::vector<CUmemAccessDesc> access_desc_;
+
+  // All blocks sorted by offset, together covering the whole range.
+  std::list<SegmentBlock> blocks_;
+  // (size, offset) -> free block
+  std::map<std::pair<size_t, size_t>, BlockIt> free_blocks_;
+  // page index -> physical memory mapped at the page
+  std::map<size_t, CUmemGenericAllocationHandle> pages_;
+
+  mutable std::mutex mtx_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
+
+#endif
@@ -28,6 +28,8 @@
 #endif
 
 #include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
 
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/platform/cuda_device_guard.h"
@@ -74,19 +76,31 @@
  */
 COMMON_DECLARE_double(cuda_malloc_async_pool_memory_throttle_ratio);
 
+/*
+ * Note: [cuda_malloc_async_per_stream_pool]
+ * The executor creates one CUDAMallocAsyncAllocator for every stream it runs
+ * on. By default all of them allocate from the default pool of the device, so
+ * that the blocks freed by one stream are shared with, and contended by, all
+ * the other streams.
+ *
+ * With FLAGS_cuda_malloc_async_per_stream_pool, every allocator owns a
+ * cudaMemPool and allocates from it with cudaMallocFromPoolAsync. A block
+ * freed on the owning stream goes back to the pool at that point of the
+ * stream and the next allocation on the stream can take it right away. A
+ * block used by other streams is freed on the free stream after it waits on
+ * them, and the pool hands it out again only once those frees have executed
+ * (cudaMemPoolReuseFollowEventDependencies). Neither path polls any event.
+ *
+ * The pool keeps up to FLAGS_cuda_memory_async_pool_realease_threshold bytes
+ * cached across synchronizations, Release trims it.
+ */
+COMMON_DECLARE_bool(cuda_malloc_async_per_stream_pool);
+COMMON_DECLARE_uint64(cuda_memory_async_pool_realease_threshold);
+
 namespace paddle::memory::allocation {
 
 thread_local std::once_flag CUDAMallocAsyncAllocation::once_flag_;
 
-inline void sync_streams(gpuStream_t to_record, gpuStream_t to_wait) {
-  cudaEvent_t event = nullptr;
-  PADDLE_ENFORCE_GPU_SUCCESS(
-      cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
-  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(event, to_record));
-  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamWaitEvent(to_wait, event));
-  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(event));
-}
-
 // CUDAMallocAsyncAllocation
 
 void CUDAMallocAsyncAllocation::RecordStream(gpuStream_t stream) {
@@ -106,7 +120,7 @@ void CUDAMallocAsyncAllocation::EraseStream(gpuStream_t stream) {
   recorded_streams_.erase(stream);
 }
 
-size_t CUDAMallocAsyncAllocation::Free() {
+size_t CUDAMallocAsyncAllocation::Free(CUDAMallocAsyncAllocator* allocator) {
   if (recorded_streams_.empty()) {
     platform::RecordedGpuFreeAsync(
         ptr(), size(), place_.device, malloc_stream_);
@@ -117,10 +131,10 @@ size_t CUDAMallocAsyncAllocation::Free() {
     }
     return size();
   } else {
-    sync_streams(malloc_stream_, free_stream_);
+    allocator->SyncStreams(malloc_stream_, free_stream_);
 
     for (const auto& recorded_stream : recorded_streams_) {
-      sync_streams(recorded_stream, free_stream_);
+      allocator->SyncStreams(recorded_stream, free_stream_);
     }
 
     platform::RecordedGpuFreeAsync(ptr(), size(), place_.device, free_stream_);
@@ -141,7 +155,10 @@ CUDAMallocAsyncAllocator::CUDAMallocAsyncAllocator(
     gpuStream_t default_stream)
     : underlying_allocator_(std::move(underlying_allocator)),
       place_(place),
+      mempool_(nullptr),
+      use_private_pool_(FLAGS_cuda_malloc_async_per_stream_pool),
       default_stream_(default_stream),
+      free_stream_(nullptr),
       current_allocated_size_(0),
       pending_release_size_(0),
       memory_throttle_ratio_(
@@ -156,6 +173,50 @@ CUDAMallocAsyncAllocator::CUDAMallocAsyncAllocator(
   });
 }
 
+CUDAMallocAsyncAllocator::~CUDAMallocAsyncAllocator() {
+  if (free_stream_ == nullptr) return;
+  // The allocator may be destroyed at exit while the driver shuts down, so
+  // the errors are ignored instead of thrown from the destructor.
+  platform::CUDADeviceGuard guard(place_.device);
+  cudaStreamSynchronize(free_stream_);
+  for (auto& item : sync_events_) {
+    cudaEventDestroy(item.second);
+  }
+  sync_events_.clear();
+  if (use_private_pool_ && mempool_ != nullptr) {
+    // Blocks still held by live allocations keep the pool alive, CUDA
+    // releases it once the last of them is freed.
+    cudaMemPoolTrimTo(mempool_, 0);
+    cudaMemPoolDestroy(mempool_);
+    mempool_ = nullptr;
+  }
+  cudaStreamDestroy(free_stream_);
+  free_stream_ = nullptr;
+}
+
+// cudaStreamWaitEvent only waits for the work recorded before it is called,
+// so one event per thread can be recorded again right after, which saves an
+// event creation for every cross-stream free. The events belong to the
+// allocator and are destroyed with it.
+void CUDAMallocAsyncAllocator::SyncStreams(gpuStream_t to_record,
+                                           gpuStream_t to_wait) {
+  cudaEvent_t event = nullptr;
+  {
+    std::lock_guard<SpinLock> lock_guard(sync_events_lock_);
+    auto it = sync_events_.find(std::this_thread::get_id());
+    if (it == sync_events_.end()) {
+      platform::CUDADeviceGuard guard(place_.device);
+      PADDLE_ENFORCE_GPU_SUCCESS(
+          cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+      sync_events_.emplace(std::this_thread::get_id(), event);
+    } else {
+      event = it->second;
+    }
+  }
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(event, to_record));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamWaitEvent(to_wait, event));
+}
+
 uint64_t CUDAMallocAsyncAllocator::ReleaseImpl(const phi::Place& place) {
   if (UNLIKELY(phi::backends::gpu::CUDAGraph::IsThisThreadCapturing())) {
     VLOG(7) << "Memory release forbidden in CUDA Graph Captruing";
@@ -163,6 +224,20 @@ uint64_t CUDAMallocAsyncAllocator::ReleaseImpl(const phi::Place& place) {
   }
 
   uint64_t released_size = 0;
+  if (use_private_pool_ && mempool_ != nullptr) {
+    // Frees queued on the free stream return their blocks to the pool only
+    // when they execute.
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(free_stream_));
+    current_allocated_size_ -= pending_release_size_;
+    pending_release_size_ = 0;
+    uint64_t reserved_before = 0, reserved_after = 0;
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaMemPoolGetAttribute(
+        mempool_, cudaMemPoolAttrReservedMemCurrent, &reserved_before));
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaMemPoolTrimTo(mempool_, 0));
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaMemPoolGetAttribute(
+        mempool_, cudaMemPoolAttrReservedMemCurrent, &reserved_after));
+    released_size += reserved_before - reserved_after;
+  }
   // we synchronize the event so all the block could be release.
   if (underlying_allocator_)
     released_size += underlying_allocator_->Release(place_);
@@ -179,7 +254,7 @@ void CUDAMallocAsyncAllocator::ClearFreeStream(bool sync) {
             << "are freed";
     PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(free_stream_));
   } else {
-    sync_streams(free_stream_, default_stream_);
+    SyncStreams(free_stream_, default_stream_);
   }
   current_allocated_size_ -= pending_release_size_;
   pending_release_size_ = 0;
@@ -206,7 +281,7 @@ void CUDAMallocAsyncAllocator::MallocThrottling() {
 
 void CUDAMallocAsyncAllocator::FreeAllocation(
     CUDAMallocAsyncAllocation* allocation) {
-  auto current_released_size = allocation->Free();
+  auto current_released_size = allocation->Free(this);
   current_allocated_size_ -= current_released_size;
   // The amount of pending release size (the space that has been queued to
   // free_stream, that are going to be freed in the future)
@@ -295,7 +370,22 @@ void CUDAMallocAsyncAllocator::LazyInitializeCudaFreeStream() {
 
     PADDLE_ENFORCE_GPU_SUCCESS(
         cudaStreamCreateWithPriority(&free_stream_, cudaStreamNonBlocking, 0));
-    cudaDeviceGetDefaultMemPool(&mempool_, place_.device);
+    if (use_private_pool_) {
+      cudaMemPoolProps props = {};
+      props.allocType = cudaMemAllocationTypePinned;
+      props.handleTypes = cudaMemHandleTypeNone;
+      props.location.type = cudaMemLocationTypeDevice;
+      props.location.id = place_.device;
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaMemPoolCreate(&mempool_, &props));
+      uint64_t threshold = FLAGS_cuda_memory_async_pool_realease_threshold;
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaMemPoolSetAttribute(
+          mempool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+      VLOG(4) << "[CUDAMallocAsyncAllocator] " << (this)
+              << " creates memory pool " << mempool_ << " for stream "
+              << default_stream_;
+    } else {
+      cudaDeviceGetDefaultMemPool(&mempool_, place_.device);
+    }
 
     platform::SetDeviceId(place_.device);
   });
@@ -308,7 +398,11 @@ phi::Allocation* CUDAMallocAsyncAllocator::AllocateImpl(size_t size) {
 
   void* ptr;
   auto result = platform::RecordedGpuMallocAsync(
-      &ptr, size, place_.device, default_stream_);
+      &ptr,
+      size,
+      place_.device,
+      default_stream_,
+      use_private_pool_ ? static_cast<void*>(mempool_) : nullptr);
   if (LIKELY(result == gpuSuccess)) {
     auto* allocation = new CUDAMallocAsyncAllocation(
         ptr, size, phi::Place(place_), default_stream_, free_stream_);
@@ -383,6 +477,23 @@ phi::Allocation* CUDAMallocAsyncAllocator::AllocateImpl(size_t size) {
       err_msg));
 }
 
+void CUDAMallocAsyncAllocator::CollectTelemetry(
+    std::vector<AllocatorTelemetry>* telemetry) const {
+  AllocatorTelemetry info;
+  info.allocator = "CUDAMallocAsyncAllocator";
+  info.live_bytes = static_cast<int64_t>(current_allocated_size_);
+  if (use_private_pool_ && mempool_ != nullptr) {
+    uint64_t reserved = 0;
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaMemPoolGetAttribute(
+        mempool_, cudaMemPoolAttrReservedMemCurrent, &reserved));
+    info.reserved_bytes = static_cast<int64_t>(reserved);
+  }
+  telemetry->emplace_back(std::move(info));
+  if (underlying_allocator_) {
+    underlying_allocator_->CollectTelemetry(telemetry);
+  }
+}
+
 gpuStream_t CUDAMallocAsyncAllocator::GetDefaultStream() const {
   return default_stream_;
 }
@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #pragma once
-#include <mutex>  // NOLINT
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "paddle/phi/backends/gpu/cuda/cuda_graph.h"
 #include "paddle/phi/common/place.h"
@@ -56,7 +59,7 @@ class CUDAMallocAsyncAllocation : public Allocation {
 
   void RecordStream(gpuStream_t stream);
   void EraseStream(gpuStream_t stream);
-  size_t Free();
+  size_t Free(CUDAMallocAsyncAllocator* allocator);
 
  private:
   static thread_local std::once_flag once_flag_;
@@ -76,8 +79,11 @@ class CUDAMallocAsyncAllocator : public Allocator {
       std::shared_ptr<Allocator> underlying_allocator,
       const phi::GPUPlace& place,
       gpuStream_t default_stream);
+  ~CUDAMallocAsyncAllocator() override;
 
   bool IsAllocThreadSafe() const override { return true; }
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry) const override;
   gpuStream_t GetDefaultStream() const;
   void SetDefaultStream(gpuStream_t stream);
   void ClearFreeStream(bool sync = false);
@@ -91,11 +97,17 @@ class CUDAMallocAsyncAllocator : public Allocator {
   void LazyInitializeCudaFreeStream();
   void MallocThrottling();
   void FreeAllocation(CUDAMallocAsyncAllocation* allocation);
+  // Makes to_wait wait for the work queued on to_record so far.
+  void SyncStreams(gpuStream_t to_record, gpuStream_t to_wait);
+  friend class CUDAMallocAsyncAllocation;
 
   std::shared_ptr<Allocator> underlying_allocator_;
   phi::GPUPlace place_;  // Specifies the CUDA device context.
 
   cudaMemPool_t mempool_;
+  // Whether mempool_ is a pool created for this allocator (and so for its
+  // default stream) rather than the default pool of the device.
+  bool use_private_pool_;
   gpuStream_t default_stream_;  // Default stream for memory operations.
 
   // we create a `free stream` for each allocator (each device should have a
@@ -103,6 +115,10 @@ class CUDAMallocAsyncAllocator : public Allocator {
   // stream, we release the allocation on `free stream`
   gpuStream_t free_stream_;
 
+  // One reusable event per thread calling SyncStreams.
+  std::unordered_map<std::thread::id, cudaEvent_t> sync_events_;
+  SpinLock sync_events_lock_;
+
   size_t current_allocated_size_;
   size_t pending_release_size_;
   size_t max_size_;
@@ -0,0 +1,54 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "paddle/phi/core/memory/allocation/memory_pressure.h"
+
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace paddle::memory::allocation {
+
+MemoryPressureNotifier& MemoryPressureNotifier::Instance() {
+  static MemoryPressureNotifier notifier;
+  return notifier;
+}
+
+int64_t MemoryPressureNotifier::Register(Callback callback) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  int64_t id = next_id_++;
+  callbacks_.emplace(id, std::move(callback));
+  num_callbacks_.store(callbacks_.size());
+  return id;
+}
+
+void MemoryPressureNotifier::Unregister(int64_t id) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  callbacks_.erase(id);
+  num_callbacks_.store(callbacks_.size());
+}
+
+void MemoryPressureNotifier::Notify() {
+  if (num_callbacks_.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  // Hold the lock while running the callbacks, so that a callback is never
+  // unregistered, and its owner destroyed, while it runs.
+  std::lock_guard<std::mutex> guard(mtx_);
+  VLOG(4) << "Notify " << callbacks_.size() << " callbacks of memory pressure";
+  for (auto& pair : callbacks_) {
+    pair.second();
+  }
+}
+
+}  // namespace paddle::memory::allocation
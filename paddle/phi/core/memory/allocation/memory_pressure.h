@@ -0,0 +1,56 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>  // NOLINT
+
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+/**
+ * MemoryPressureNotifier lets the holders of freeable memory, e.g. the
+ * garbage collectors deferring their frees, know that an allocation failed.
+ * The allocators notify before retrying the allocation, so the callbacks
+ * should free what they hold synchronously.
+ */
+class TEST_API MemoryPressureNotifier {
+ public:
+  using Callback = std::function<void()>;
+
+  static MemoryPressureNotifier& Instance();
+
+  // Returns the id to unregister the callback.
+  int64_t Register(Callback callback);
+  void Unregister(int64_t id);
+
+  void Notify();
+
+ private:
+  MemoryPressureNotifier() = default;
+
+  std::atomic<size_t> num_callbacks_{0};
+  int64_t next_id_{0};
+  std::map<int64_t, Callback> callbacks_;
+  std::mutex mtx_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
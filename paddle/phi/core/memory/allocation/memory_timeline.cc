@@ -0,0 +1,186 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/memory_timeline.h"
+
+#include <algorithm>
+
+#include "paddle/phi/core/os_info.h"
+
+namespace paddle::memory::allocation {
+
+static thread_local const char* current_op = nullptr;
+
+MemoryTimelineOpScope::MemoryTimelineOpScope(const char* op)
+    : prev_(current_op) {
+  current_op = op;
+}
+
+MemoryTimelineOpScope::~MemoryTimelineOpScope() { current_op = prev_; }
+
+const char* MemoryTimelineOpScope::CurrentOp() { return current_op; }
+
+MemoryTimeline& MemoryTimeline::Instance() {
+  static MemoryTimeline timeline;
+  return timeline;
+}
+
+void MemoryTimeline::Start(size_t max_events, bool record_stack) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  max_events_ = max_events;
+  record_stack_ = record_stack;
+  events_.clear();
+  dropped_events_ = 0;
+  names_.clear();
+  name_ids_.clear();
+  records_.clear();
+  recording_.store(true);
+}
+
+void MemoryTimeline::Stop() { recording_.store(false); }
+
+void MemoryTimeline::SetStackProvider(StackProvider provider) {
+  std::lock_guard<std::mutex> guard(mtx_);
+  stack_provider_ = std::move(provider);
+}
+
+int MemoryTimeline::Intern(const std::string& name) {
+  auto it = name_ids_.find(name);
+  if (it != name_ids_.end()) {
+    return it->second;
+  }
+  int id = static_cast<int>(names_.size());
+  names_.push_back(name);
+  name_ids_.emplace(name, id);
+  return id;
+}
+
+void MemoryTimeline::Record(const void* ptr,
+                            const phi::Place& place,
+                            size_t size,
+                            phi::TracerMemEventType type) {
+  uint64_t time_ns = phi::PosixInNsec();
+  const char* op = MemoryTimelineOpScope::CurrentOp();
+  // Only the allocations of the tensors get a stack: the provider takes the
+  // GIL, which must not be waited for under the locks of the allocators
+  // below StatAllocator. It is also called out of the lock of the timeline.
+  std::string stack;
+  if (type == phi::TracerMemEventType::Allocate && record_stack_ &&
+      stack_provider_) {
+    stack = stack_provider_();
+  }
+
+  std::lock_guard<std::mutex> guard(mtx_);
+  if (!recording_.load()) {
+    return;
+  }
+  MemoryTimelineEvent event;
+  event.time_ns = time_ns;
+  event.ptr = ptr;
+  event.size = size;
+  event.place = place;
+  event.type = type;
+  event.op = op ? Intern(op) : -1;
+  event.stack = stack.empty() ? -1 : Intern(stack);
+
+  auto& record = records_[place];
+  switch (type) {
+    case phi::TracerMemEventType::Allocate: {
+      std::pair<int, int> holder(event.op, event.stack);
+      record.live[ptr] = LiveAllocation{size, holder};
+      auto& sum = record.holders[holder];
+      sum.first += static_cast<int64_t>(size);
+      ++sum.second;
+      record.allocated += static_cast<int64_t>(size);
+      if (record.allocated > record.peak.peak_allocated) {
+        record.peak.peak_allocated = record.allocated;
+        record.peak.peak_time_ns = time_ns;
+        record.peak.holders.clear();
+        for (auto& item : record.holders) {
+          record.peak.holders.push_back(MemoryTimelineHolder{
+              item.first.first,
+              item.first.second,
+              item.second.first,
+              item.second.second});
+        }
+      }
+      break;
+    }
+    case phi::TracerMemEventType::Free: {
+      // Allocations made before Start are not tracked.
+      auto live_it = record.live.find(ptr);
+      if (live_it == record.live.end()) {
+        break;
+      }
+      auto holder_it = record.holders.find(live_it->second.holder);
+      holder_it->second.first -= static_cast<int64_t>(live_it->second.size);
+      if (--holder_it->second.second == 0) {
+        record.holders.erase(holder_it);
+      }
+      record.allocated -= static_cast<int64_t>(live_it->second.size);
+      record.live.erase(live_it);
+      break;
+    }
+    case phi::TracerMemEventType::ReservedAllocate:
+      record.reserved += static_cast<int64_t>(size);
+      record.peak_reserved = std::max(record.peak_reserved, record.reserved);
+      break;
+    case phi::TracerMemEventType::ReservedFree:
+      record.reserved -= static_cast<int64_t>(size);
+      break;
+    default:
+      break;
+  }
+
+  if (events_.size() < max_events_) {
+    events_.push_back(event);
+  } else {
+    ++dropped_events_;
+  }
+}
+
+std::vector<MemoryTimelineEvent> MemoryTimeline::GetEvents() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  return events_;
+}
+
+std::vector<std::string> MemoryTimeline::GetNames() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  return names_;
+}
+
+std::vector<MemoryTimelinePeak> MemoryTimeline::GetPeaks() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  std::vector<MemoryTimelinePeak> peaks;
+  for (auto& pair : records_) {
+    MemoryTimelinePeak peak = pair.second.peak;
+    peak.place = pair.first;
+    peak.peak_reserved = pair.second.peak_reserved;
+    std::sort(
+        peak.holders.begin(),
+        peak.holders.end(),
+        [](const MemoryTimelineHolder& a, const MemoryTimelineHolder& b) {
+          return a.bytes > b.bytes;
+        });
+    peaks.emplace_back(std::move(peak));
+  }
+  return peaks;
+}
+
+uint64_t MemoryTimeline::DroppedEvents() const {
+  std::lock_guard<std::mutex> guard(mtx_);
+  return dropped_events_;
+}
+
+}  // namespace paddle::memory::allocation
@@ -0,0 +1,159 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "paddle/phi/api/profiler/trace_event.h"
+#include "paddle/phi/common/place.h"
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// One allocation or free. The op and the stack are indices into
+// MemoryTimeline::GetNames, -1 when unknown.
+struct MemoryTimelineEvent {
+  uint64_t time_ns{0};
+  const void* ptr{nullptr};
+  size_t size{0};
+  phi::Place place;
+  // Allocate and Free come from StatAllocator, the allocations handed to
+  // the tensors, ReservedAllocate and ReservedFree from the allocators
+  // asking the device or the system for memory.
+  phi::TracerMemEventType type{phi::TracerMemEventType::Allocate};
+  int op{-1};
+  int stack{-1};
+};
+
+// The allocations issued by one op from one Python stack that were alive
+// together when the allocated memory of a place peaked.
+struct MemoryTimelineHolder {
+  int op{-1};
+  int stack{-1};
+  int64_t bytes{0};
+  int64_t count{0};
+};
+
+struct MemoryTimelinePeak {
+  phi::Place place;
+  int64_t peak_allocated{0};
+  uint64_t peak_time_ns{0};
+  int64_t peak_reserved{0};
+  // Sorted by bytes, the largest first.
+  std::vector<MemoryTimelineHolder> holders;
+};
+
+/**
+ * MemoryTimeline records every allocation and free of every allocator layer
+ * between Start and Stop, with the op running on the thread, set by
+ * MemoryTimelineOpScope, and optionally the Python stack of the allocations
+ * of the Allocate layer, from the provider set by SetStackProvider. It is fed
+ * by RecordMemEvent, so it sees the same events as the memory tracing of the
+ * profiler.
+ *
+ * Besides the events, up to max_events of them, the live allocations of the
+ * Allocate layer are summed by (op, stack), and the sums are copied whenever
+ * the allocated memory of a place reaches a new peak, which tells who holds
+ * the memory at the peak.
+ */
+class TEST_API MemoryTimeline {
+ public:
+  // Returns the Python stack of the calling thread, empty when it has none.
+  using StackProvider = std::function<std::string()>;
+
+  static MemoryTimeline& Instance();
+
+  static bool IsRecording() {
+    return Instance().recording_.load(std::memory_order_relaxed);
+  }
+
+  // Discards the previous records and starts recording.
+  void Start(size_t max_events, bool record_stack);
+  void Stop();
+
+  void Record(const void* ptr,
+              const phi::Place& place,
+              size_t size,
+              phi::TracerMemEventType type);
+
+  // Called once, before any Start, as the provider is read out of the lock.
+  void SetStackProvider(StackProvider provider);
+
+  std::vector<MemoryTimelineEvent> GetEvents() const;
+  // The ops and the stacks the events and the holders refer to.
+  std::vector<std::string> GetNames() const;
+  std::vector<MemoryTimelinePeak> GetPeaks() const;
+  // The events beyond max_events, which are still accounted in the peaks.
+  uint64_t DroppedEvents() const;
+
+ private:
+  MemoryTimeline() = default;
+
+  struct LiveAllocation {
+    size_t size;
+    std::pair<int, int> holder;
+  };
+
+  struct PlaceRecord {
+    int64_t allocated{0};
+    int64_t reserved{0};
+    int64_t peak_reserved{0};
+    std::unordered_map<const void*, LiveAllocation> live;
+    // (op, stack) -> (bytes, count)
+    std::map<std::pair<int, int>, std::pair<int64_t, int64_t>> holders;
+    MemoryTimelinePeak peak;
+  };
+
+  int Intern(const std::string& name);
+
+  std::atomic<bool> recording_{false};
+  size_t max_events_{0};
+  bool record_stack_{false};
+  StackProvider stack_provider_;
+  std::vector<MemoryTimelineEvent> events_;
+  uint64_t dropped_events_{0};
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, int> name_ids_;
+  std::map<phi::Place, PlaceRecord> records_;
+  mutable std::mutex mtx_;
+};
+
+// Names the op issuing the allocations of the current thread in its scope,
+// for MemoryTimeline. The name must outlive the scope.
+class TEST_API MemoryTimelineOpScope {
+ public:
+  explicit MemoryTimelineOpScope(const char* op);
+  ~MemoryTimelineOpScope();
+
+  // nullptr out of any scope.
+  static const char* CurrentOp();
+
+ private:
+  const char* prev_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
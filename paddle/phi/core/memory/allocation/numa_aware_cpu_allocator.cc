@@ -0,0 +1,251 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/numa_aware_cpu_allocator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/allocation/cpu_allocator.h"
+#include "paddle/phi/core/memory/stats.h"
+
+namespace paddle::memory::allocation {
+
+namespace {
+
+class NumaAwareCPUAllocation : public Allocation {
+ public:
+  NumaAwareCPUAllocation(void* ptr, size_t size, size_t mapped_size)
+      : Allocation(ptr, size, phi::CPUPlace()), mapped_size_(mapped_size) {}
+
+  // The length of the mapping, 0 for the blocks from posix_memalign.
+  size_t mapped_size_;
+};
+
+#ifdef __linux__
+// The memory policy modes of mbind, see <linux/mempolicy.h>.
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolInterleave = 3;
+constexpr size_t kMaxNumaNodes = 1024;
+constexpr size_t kBitsPerMask = 8 * sizeof(unsigned long);  // NOLINT
+
+using NodeMask = std::vector<unsigned long>;  // NOLINT
+
+// Parses the node list of the kernel, e.g. "0-1,3".
+NodeMask ReadOnlineNodeMask() {
+  NodeMask mask(kMaxNumaNodes / kBitsPerMask, 0);
+  std::ifstream fin("/sys/devices/system/node/online");
+  std::string list;
+  if (!(fin >> list)) {
+    mask[0] = 1;
+    return mask;
+  }
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    size_t first = 0, last = 0;
+    size_t dash = range.find('-');
+    try {
+      first = std::stoul(range.substr(0, dash));
+      last = dash == std::string::npos ? first
+                                       : std::stoul(range.substr(dash + 1));
+    } catch (...) {
+      continue;
+    }
+    for (size_t node = first; node <= last && node < kMaxNumaNodes; ++node) {
+      mask[node / kBitsPerMask] |= 1UL << (node % kBitsPerMask);
+    }
+  }
+  return mask;
+}
+
+const NodeMask& OnlineNodeMask() {
+  static NodeMask mask = ReadOnlineNodeMask();
+  return mask;
+}
+#endif
+
+}  // namespace
+
+NumaAwareCPUAllocator::NumaAwareCPUAllocator(CPUNumaPolicy numa_policy,
+                                             CPUHugePagePolicy huge_page_policy,
+                                             size_t huge_page_threshold)
+    : numa_policy_(numa_policy),
+      huge_page_policy_(huge_page_policy),
+      huge_page_threshold_(std::max(huge_page_threshold, kMmapThreshold)) {
+  VLOG(4) << "NumaAwareCPUAllocator with numa policy "
+          << static_cast<int>(numa_policy_) << ", huge page policy "
+          << static_cast<int>(huge_page_policy_) << " and " << NumaNodeCount()
+          << " NUMA nodes";
+}
+
+int NumaAwareCPUAllocator::CurrentNumaNode() {
+#ifdef __linux__
+  unsigned int cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node);
+  }
+#endif
+  return 0;
+}
+
+int NumaAwareCPUAllocator::NumaNodeCount() {
+#ifdef __linux__
+  int count = 0;
+  for (auto bits : OnlineNodeMask()) {
+    count += __builtin_popcountl(bits);
+  }
+  return std::max(count, 1);
+#else
+  return 1;
+#endif
+}
+
+phi::Allocation* NumaAwareCPUAllocator::AllocateImpl(size_t size) {
+#ifdef __linux__
+  if (size >= kMmapThreshold) {
+    bool use_huge_page = huge_page_policy_ != CPUHugePagePolicy::kNone &&
+                         size >= huge_page_threshold_;
+    size_t mapped_size = AlignedSize(
+        size, use_huge_page ? kHugePageSize : CPUAllocator::kAlignment);
+    void* p = nullptr;
+    if (use_huge_page && huge_page_policy_ == CPUHugePagePolicy::kExplicit) {
+      p = mmap(nullptr,
+               mapped_size,
+               PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+               -1,
+               0);
+      if (p == MAP_FAILED) {
+        VLOG(4) << "Fail to map " << mapped_size
+                << " bytes of hugetlbfs pages, errno is " << errno
+                << ", fall back to transparent huge pages";
+        p = nullptr;
+      }
+    }
+    if (p == nullptr) {
+      p = MapAligned(mapped_size,
+                     use_huge_page ? kHugePageSize : CPUAllocator::kAlignment);
+#ifdef MADV_HUGEPAGE
+      if (use_huge_page && madvise(p, mapped_size, MADV_HUGEPAGE) != 0) {
+        VLOG(4) << "madvise(MADV_HUGEPAGE) fails, errno is " << errno;
+      }
+#endif
+    }
+    BindToNodes(p, mapped_size);
+    HOST_MEMORY_STAT_UPDATE(Reserved, 0, mapped_size);
+    return new NumaAwareCPUAllocation(p, size, mapped_size);
+  }
+#endif
+
+  void* p = nullptr;
+  int error = posix_memalign(&p, CPUAllocator::kAlignment, size);
+  PADDLE_ENFORCE_EQ(
+      error,
+      0,
+      common::errors::ResourceExhausted(
+          "Fail to alloc memory of %ld size, error code is %d.", size, error));
+  HOST_MEMORY_STAT_UPDATE(Reserved, 0, size);
+  return new NumaAwareCPUAllocation(p, size, 0);
+}
+
+void NumaAwareCPUAllocator::FreeImpl(phi::Allocation* allocation) {
+  auto* numa_allocation = static_cast<NumaAwareCPUAllocation*>(allocation);
+  void* p = numa_allocation->ptr();
+#ifdef __linux__
+  if (numa_allocation->mapped_size_ > 0) {
+    munmap(p, numa_allocation->mapped_size_);
+    HOST_MEMORY_STAT_UPDATE(
+        Reserved, 0, -static_cast<int64_t>(numa_allocation->mapped_size_));
+    delete numa_allocation;
+    return;
+  }
+#endif
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  free(p);  // NOLINT
+#endif
+  HOST_MEMORY_STAT_UPDATE(
+      Reserved, 0, -static_cast<int64_t>(numa_allocation->size()));
+  delete numa_allocation;
+}
+
+void* NumaAwareCPUAllocator::MapAligned(size_t size, size_t alignment) {
+#ifdef __linux__
+  // Map a larger range and trim it to the alignment, since mmap only
+  // guarantees the alignment of normal pages.
+  size_t length = size + alignment - CPUAllocator::kAlignment;
+  void* raw = mmap(nullptr,
+                   length,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+  if (raw == MAP_FAILED) {
+    PADDLE_THROW(common::errors::ResourceExhausted(
+        "Fail to map memory of %ld size, errno is %d.", size, errno));
+  }
+  auto begin = reinterpret_cast<uintptr_t>(raw);
+  uintptr_t aligned = AlignedSize(begin, alignment);
+  size_t head = aligned - begin;
+  size_t tail = length - head - size;
+  if (head > 0) {
+    munmap(raw, head);
+  }
+  if (tail > 0) {
+    munmap(reinterpret_cast<void*>(aligned + size), tail);
+  }
+  return reinterpret_cast<void*>(aligned);
+#else
+  PADDLE_THROW(common::errors::Unimplemented(
+      "NumaAwareCPUAllocator only maps memory on Linux."));
+#endif
+}
+
+void NumaAwareCPUAllocator::BindToNodes(void* ptr, size_t size) {
+#ifdef __linux__
+  if (numa_policy_ == CPUNumaPolicy::kNone || NumaNodeCount() <= 1) {
+    return;
+  }
+  NodeMask mask(kMaxNumaNodes / kBitsPerMask, 0);
+  int mode = kMpolPreferred;
+  if (numa_policy_ == CPUNumaPolicy::kLocal) {
+    size_t node = CurrentNumaNode();
+    mask[node / kBitsPerMask] |= 1UL << (node % kBitsPerMask);
+  } else {
+    mask = OnlineNodeMask();
+    mode = kMpolInterleave;
+  }
+  // NOTE: the kernel reads maxnode - 1 bits of the mask.
+  if (syscall(SYS_mbind, ptr, size, mode, mask.data(), kMaxNumaNodes + 1, 0) !=
+      0) {
+    VLOG(4) << "mbind fails with mode " << mode << ", errno is " << errno;
+  }
+#endif
+}
+
+}  // namespace paddle::memory::allocation
@@ -0,0 +1,71 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+#include "paddle/phi/core/memory/allocation/allocator_strategy.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+/**
+ * NumaAwareCPUAllocator maps the CPU blocks not smaller than kMmapThreshold
+ * directly from the kernel, so that their pages can be placed on NUMA nodes
+ * and backed by huge pages. Smaller blocks are served like CPUAllocator.
+ *
+ * With CPUNumaPolicy::kLocal the pages prefer the node of the allocating
+ * thread, so the weights loaded by a thread stay close to the socket it runs
+ * on. With kInterleave they are spread over all the nodes, which evens out
+ * the remote access cost of blocks read from every socket. Blocks not smaller
+ * than the huge page threshold are aligned to huge pages, and are either
+ * advised to use transparent huge pages or mapped from hugetlbfs.
+ *
+ * All the placement requests are hints: when the kernel rejects one, e.g. no
+ * hugetlbfs page is reserved, the block falls back to normal pages. Only
+ * Linux is supported, elsewhere every block is served like CPUAllocator.
+ */
+class NumaAwareCPUAllocator : public Allocator {
+ public:
+  constexpr static size_t kMmapThreshold = 1UL << 20;
+  constexpr static size_t kHugePageSize = 2UL << 20;
+
+  NumaAwareCPUAllocator(CPUNumaPolicy numa_policy,
+                        CPUHugePagePolicy huge_page_policy,
+                        size_t huge_page_threshold);
+
+  bool IsAllocThreadSafe() const override { return true; }
+
+  // The NUMA node of the calling thread, 0 when it is unknown.
+  static int CurrentNumaNode();
+  // The number of online NUMA nodes, 1 when it is unknown.
+  static int NumaNodeCount();
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+
+ private:
+  void* MapAligned(size_t size, size_t alignment);
+  void BindToNodes(void* ptr, size_t size);
+
+  CPUNumaPolicy numa_policy_;
+  CPUHugePagePolicy huge_page_policy_;
+  size_t huge_page_threshold_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -26,6 +26,7 @@ void CPUPinnedAllocator::FreeImpl(phi::Allocation *allocation) {
 #endif
   VLOG(10) << "cudaFreeHost " << allocation->ptr();
   HOST_MEMORY_STAT_UPDATE(Reserved, 0, -allocation->size());
+  HOST_MEMORY_STAT_UPDATE(PinnedReserved, 0, -allocation->size());
   platform::RecordMemEvent(allocation->ptr(),
                            allocation->place(),
                            allocation->size(),
@@ -41,6 +42,7 @@ phi::Allocation *CPUPinnedAllocator::AllocateImpl(size_t size) {
 #endif
   VLOG(10) << "cudaHostAlloc " << size << " " << ptr;
   HOST_MEMORY_STAT_UPDATE(Reserved, 0, size);
+  HOST_MEMORY_STAT_UPDATE(PinnedReserved, 0, size);
   platform::RecordMemEvent(ptr,
                            phi::GPUPinnedPlace(),
                            size,
@@ -15,6 +15,7 @@
 #include "paddle/phi/core/memory/allocation/retry_allocator.h"
 
 #include "glog/logging.h"
+#include "paddle/phi/core/memory/allocation/memory_pressure.h"
 
 namespace paddle {
 namespace memory {
@@ -61,6 +62,15 @@ phi::Allocation* RetryAllocator::AllocateImpl(size_t size) {
   try {
     return alloc_func();
   } catch (BadAlloc&) {
+    // Let the holders of deferred frees release them first.
+    MemoryPressureNotifier::Instance().Notify();
+    try {
+      return alloc_func();
+    } catch (BadAlloc&) {
+      VLOG(10) << "Allocation failed after notifying memory pressure when "
+                  "allocating "
+               << size << " bytes";
+    }
     {
       WaitedAllocateSizeGuard guard(&waited_allocate_size_, size);
       VLOG(10) << "Allocation failed when allocating " << size
@@ -45,6 +45,11 @@ class RetryAllocator : public Allocator {
 
   bool IsAllocThreadSafe() const override { return true; }
 
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry) const override {
+    underlying_allocator_->CollectTelemetry(telemetry);
+  }
+
  protected:
   void FreeImpl(phi::Allocation* allocation) override;
   phi::Allocation* AllocateImpl(size_t size) override;
@@ -14,10 +14,22 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/common/macros.h"
+#include "paddle/phi/core/memory/allocation/allocation_profiler.h"
 #include "paddle/phi/core/memory/allocation/allocator.h"
+#include "paddle/phi/core/memory/allocation/spin_lock.h"
 #include "paddle/phi/core/memory/stats.h"
 #include "paddle/phi/core/platform/profiler/mem_tracing.h"
 
+COMMON_DECLARE_int32(allocator_lifetime_sample_rate);
+
 namespace paddle {
 namespace memory {
 namespace allocation {
@@ -25,16 +37,46 @@ namespace allocation {
 class StatAllocator : public Allocator {
  public:
   explicit StatAllocator(std::shared_ptr<Allocator> underlying_allocator)
-      : underlying_allocator_(std::move(underlying_allocator)) {}
+      : underlying_allocator_(std::move(underlying_allocator)),
+        lifetime_sample_rate_(FLAGS_allocator_lifetime_sample_rate) {}
 
   bool IsAllocThreadSafe() const override { return true; }
 
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry) const override {
+    AllocatorTelemetry info;
+    info.allocator = "StatAllocator";
+    info.live_bytes = live_bytes_.load();
+    {
+      std::lock_guard<SpinLock> guard(lifetime_lock_);
+      info.lifetime_histogram.assign(lifetime_histogram_.begin(),
+                                     lifetime_histogram_.end());
+    }
+    while (!info.lifetime_histogram.empty() &&
+           info.lifetime_histogram.back() == 0) {
+      info.lifetime_histogram.pop_back();
+    }
+    telemetry->emplace_back(std::move(info));
+    underlying_allocator_->CollectTelemetry(telemetry);
+  }
+
  protected:
   void FreeImpl(phi::Allocation* allocation) override {
+    live_bytes_ -= static_cast<int64_t>(allocation->size());
+    if (IsLifetimeSampled(allocation->ptr())) {
+      RecordLifetimeEnd(allocation->ptr());
+    }
+    if (UNLIKELY(AllocationProfiler::IsRecording())) {
+      AllocationProfiler::Instance().RecordFree(allocation->place(),
+                                                allocation->size());
+    }
     if (phi::is_cpu_place(allocation->place()) ||
         phi::is_cuda_pinned_place(allocation->place())) {
       HOST_MEMORY_STAT_UPDATE(
           Allocated, allocation->place().GetDeviceId(), -allocation->size());
+      if (phi::is_cuda_pinned_place(allocation->place())) {
+        HOST_MEMORY_STAT_UPDATE(PinnedAllocated, 0, -allocation->size());
+      }
     } else {
       DEVICE_MEMORY_STAT_UPDATE(
           Allocated, allocation->place().GetDeviceId(), -allocation->size());
@@ -49,11 +91,23 @@ class StatAllocator : public Allocator {
   phi::Allocation* AllocateImpl(size_t size) override {
     phi::Allocator::AllocationPtr allocation =
         underlying_allocator_->Allocate(size);
+    live_bytes_ += static_cast<int64_t>(allocation->size());
+    if (IsLifetimeSampled(allocation->ptr())) {
+      std::lock_guard<SpinLock> guard(lifetime_lock_);
+      sampled_alloc_time_[allocation->ptr()] =
+          std::chrono::steady_clock::now();
+    }
 
     const phi::Place& place = allocation->place();
+    if (UNLIKELY(AllocationProfiler::IsRecording())) {
+      AllocationProfiler::Instance().RecordAlloc(place, allocation->size());
+    }
     if (phi::is_cpu_place(place) || phi::is_cuda_pinned_place(place)) {
       HOST_MEMORY_STAT_UPDATE(
           Allocated, place.GetDeviceId(), allocation->size());
+      if (phi::is_cuda_pinned_place(place)) {
+        HOST_MEMORY_STAT_UPDATE(PinnedAllocated, 0, allocation->size());
+      }
     } else {
       DEVICE_MEMORY_STAT_UPDATE(
           Allocated, place.GetDeviceId(), allocation->size());
@@ -70,7 +124,45 @@ class StatAllocator : public Allocator {
   }
 
  private:
+  // Sampling is decided by the address, so that Free can tell whether an
+  // allocation was sampled without any lookup.
+  bool IsLifetimeSampled(const void* ptr) const {
+    int rate = lifetime_sample_rate_;
+    if (rate <= 0 || ptr == nullptr) {
+      return false;
+    }
+    // Drop the low bits which are always 0 for aligned addresses.
+    uint64_t hash = (reinterpret_cast<uintptr_t>(ptr) >> 6) *
+                    0x9E3779B97F4A7C15ULL;  // NOLINT
+    return (hash >> 32) % rate == 0;
+  }
+
+  void RecordLifetimeEnd(const void* ptr) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<SpinLock> guard(lifetime_lock_);
+    auto it = sampled_alloc_time_.find(ptr);
+    if (it == sampled_alloc_time_.end()) {
+      return;
+    }
+    auto lifetime_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                           now - it->second)
+                           .count();
+    sampled_alloc_time_.erase(it);
+    size_t bucket = std::min(Log2Bucket(static_cast<uint64_t>(lifetime_us)),
+                             lifetime_histogram_.size() - 1);
+    ++lifetime_histogram_[bucket];
+  }
+
   std::shared_ptr<Allocator> underlying_allocator_;
+  std::atomic<int64_t> live_bytes_{0};
+
+  const int lifetime_sample_rate_;
+  // Up to 2^39 microseconds, i.e., about 6 days.
+  static constexpr size_t kLifetimeBuckets = 40;
+  mutable SpinLock lifetime_lock_;
+  std::unordered_map<const void*, std::chrono::steady_clock::time_point>
+      sampled_alloc_time_;
+  std::array<int64_t, kLifetimeBuckets> lifetime_histogram_{};
 };
 
 }  // namespace allocation
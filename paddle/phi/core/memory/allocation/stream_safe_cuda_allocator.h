@@ -70,6 +70,10 @@ class StreamSafeCUDAAllocator
   ~StreamSafeCUDAAllocator();
 
   bool IsAllocThreadSafe() const override;
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry> *telemetry) const override {
+    underlying_allocator_->CollectTelemetry(telemetry);
+  }
   gpuStream_t GetDefaultStream() const;
   void SetDefaultStream(gpuStream_t stream);
 
@@ -0,0 +1,213 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/stream_safe_cuda_pinned_allocator.h"
+
+#include "paddle/phi/api/profiler/event_tracing.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+
+#if defined(PADDLE_WITH_CUDA)
+#include "paddle/phi/backends/gpu/cuda/cuda_graph.h"
+#elif defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/rocm/hip_graph.h"
+#endif
+
+namespace paddle::memory::allocation {
+
+StreamSafeCUDAPinnedAllocation::StreamSafeCUDAPinnedAllocation(
+    DecoratedAllocationPtr underlying_allocation)
+    : Allocation(underlying_allocation->ptr(),
+                 underlying_allocation->base_ptr(),
+                 underlying_allocation->size(),
+                 underlying_allocation->place()),
+      underlying_allocation_(std::move(underlying_allocation)) {}
+
+StreamSafeCUDAPinnedAllocation::~StreamSafeCUDAPinnedAllocation() {
+  for (auto& pair : outstanding_event_map_) {
+#ifdef PADDLE_WITH_CUDA
+    cudaEventDestroy(pair.second);
+#else
+    hipEventDestroy(pair.second);
+#endif
+  }
+}
+
+void StreamSafeCUDAPinnedAllocation::RecordStream(gpuStream_t stream) {
+  VLOG(8) << "Try record stream " << stream << " for pinned address "
+          << ptr();
+  // Memory used in a captured graph is held by the graph itself.
+  if (UNLIKELY(phi::backends::gpu::CUDAGraph::IsThisThreadCapturing())) {
+    return;
+  }
+
+  std::lock_guard<SpinLock> lock_guard(outstanding_event_map_lock_);
+  gpuEvent_t record_event;
+  auto it = outstanding_event_map_.find(stream);
+  if (it == outstanding_event_map_.end()) {
+#ifdef PADDLE_WITH_CUDA
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaEventCreateWithFlags(&record_event, cudaEventDisableTiming));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        hipEventCreateWithFlags(&record_event, hipEventDisableTiming));
+#endif
+    outstanding_event_map_[stream] = record_event;
+  } else {
+    record_event = it->second;
+  }
+#ifdef PADDLE_WITH_CUDA
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(record_event, stream));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(hipEventRecord(record_event, stream));
+#endif
+  VLOG(8) << "Record event " << record_event << " to stream " << stream;
+}
+
+void StreamSafeCUDAPinnedAllocation::EraseStream(gpuStream_t stream) {
+  std::lock_guard<SpinLock> lock_guard(outstanding_event_map_lock_);
+  auto it = outstanding_event_map_.find(stream);
+  if (it == outstanding_event_map_.end()) {
+    return;
+  }
+#ifdef PADDLE_WITH_CUDA
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(it->second));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(hipEventDestroy(it->second));
+#endif
+  outstanding_event_map_.erase(it);
+}
+
+bool StreamSafeCUDAPinnedAllocation::CanBeFreed() {
+  std::lock_guard<SpinLock> lock_guard(outstanding_event_map_lock_);
+  for (auto it = outstanding_event_map_.begin();
+       it != outstanding_event_map_.end();) {
+#ifdef PADDLE_WITH_CUDA
+    gpuError_t err = cudaEventQuery(it->second);
+    if (err == cudaErrorNotReady) {
+      return false;
+    }
+    PADDLE_ENFORCE_GPU_SUCCESS(err);
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(it->second));
+#else
+    gpuError_t err = hipEventQuery(it->second);
+    if (err == hipErrorNotReady) {
+      return false;
+    }
+    PADDLE_ENFORCE_GPU_SUCCESS(err);
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventDestroy(it->second));
+#endif
+    it = outstanding_event_map_.erase(it);
+  }
+  return true;
+}
+
+void StreamSafeCUDAPinnedAllocation::Synchronize() {
+  std::lock_guard<SpinLock> lock_guard(outstanding_event_map_lock_);
+  for (auto& pair : outstanding_event_map_) {
+#ifdef PADDLE_WITH_CUDA
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventSynchronize(pair.second));
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(pair.second));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventSynchronize(pair.second));
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventDestroy(pair.second));
+#endif
+  }
+  outstanding_event_map_.clear();
+}
+
+StreamSafeCUDAPinnedAllocator::StreamSafeCUDAPinnedAllocator(
+    std::shared_ptr<Allocator> underlying_allocator)
+    : underlying_allocator_(std::move(underlying_allocator)) {}
+
+StreamSafeCUDAPinnedAllocator::~StreamSafeCUDAPinnedAllocator() {
+  SynchronizeUnfreedAllocations();
+}
+
+size_t StreamSafeCUDAPinnedAllocator::PendingBytes() const {
+  std::lock_guard<SpinLock> lock_guard(unfreed_allocation_lock_);
+  return unfreed_bytes_;
+}
+
+phi::Allocation* StreamSafeCUDAPinnedAllocator::AllocateImpl(size_t size) {
+  phi::RecordEvent record("StreamSafeCUDAPinnedAllocator::Allocate",
+                          phi::TracerEventType::UserDefined,
+                          9 /*level*/);
+  ProcessUnfreedAllocations();
+  AllocationPtr underlying_allocation;
+  try {
+    underlying_allocation = underlying_allocator_->Allocate(size);
+  } catch (BadAlloc&) {
+    VLOG(4) << "Pinned allocation failed when allocating " << size
+            << " bytes, wait for the pending copies and retry";
+    SynchronizeUnfreedAllocations();
+    underlying_allocator_->Release(phi::GPUPinnedPlace());
+    underlying_allocation = underlying_allocator_->Allocate(size);
+  }
+  return new StreamSafeCUDAPinnedAllocation(
+      static_unique_ptr_cast<Allocation>(std::move(underlying_allocation)));
+}
+
+void StreamSafeCUDAPinnedAllocator::FreeImpl(phi::Allocation* allocation) {
+  phi::RecordEvent record("StreamSafeCUDAPinnedAllocator::Free",
+                          phi::TracerEventType::UserDefined,
+                          9 /*level*/);
+  auto* pinned_allocation =
+      static_cast<StreamSafeCUDAPinnedAllocation*>(allocation);
+  if (pinned_allocation->CanBeFreed()) {
+    delete pinned_allocation;
+  } else {
+    VLOG(9) << "Pinned allocation " << pinned_allocation->ptr()
+            << " is still in use by a stream, delay the free";
+    std::lock_guard<SpinLock> lock_guard(unfreed_allocation_lock_);
+    unfreed_bytes_ += pinned_allocation->size();
+    unfreed_allocations_.emplace_back(pinned_allocation);
+  }
+}
+
+uint64_t StreamSafeCUDAPinnedAllocator::ReleaseImpl(const phi::Place& place) {
+  ProcessUnfreedAllocations();
+  return underlying_allocator_->Release(place);
+}
+
+void StreamSafeCUDAPinnedAllocator::ProcessUnfreedAllocations() {
+  // NOTE: reading the list without lock only decides whether to take the
+  // lock, a misjudgment just delays the processing to the next call.
+  if (unfreed_allocations_.empty()) {
+    return;
+  }
+
+  std::lock_guard<SpinLock> lock_guard(unfreed_allocation_lock_);
+  for (auto it = unfreed_allocations_.begin();
+       it != unfreed_allocations_.end();) {
+    if ((*it)->CanBeFreed()) {
+      unfreed_bytes_ -= (*it)->size();
+      delete *it;
+      it = unfreed_allocations_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void StreamSafeCUDAPinnedAllocator::SynchronizeUnfreedAllocations() {
+  std::lock_guard<SpinLock> lock_guard(unfreed_allocation_lock_);
+  for (auto* allocation : unfreed_allocations_) {
+    allocation->Synchronize();
+    delete allocation;
+  }
+  unfreed_allocations_.clear();
+  unfreed_bytes_ = 0;
+}
+
+}  // namespace paddle::memory::allocation
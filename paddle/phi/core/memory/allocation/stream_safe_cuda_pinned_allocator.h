@@ -0,0 +1,100 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+#include "paddle/phi/core/memory/allocation/spin_lock.h"
+
+#ifdef PADDLE_WITH_CUDA
+#include <cuda_runtime.h>
+#else
+#include <hip/hip_runtime.h>
+#endif
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// A pinned host allocation that remembers the streams still reading or
+// writing it asynchronously, e.g. the H2D copy of a non-blocking `Tensor.cuda`.
+class StreamSafeCUDAPinnedAllocation : public Allocation {
+ public:
+  explicit StreamSafeCUDAPinnedAllocation(
+      DecoratedAllocationPtr underlying_allocation);
+  ~StreamSafeCUDAPinnedAllocation();
+
+  void RecordStream(gpuStream_t stream);
+  void EraseStream(gpuStream_t stream);
+  // Returns true when all the recorded work has completed.
+  bool CanBeFreed();
+  // Blocks until all the recorded work has completed.
+  void Synchronize();
+
+ private:
+  DecoratedAllocationPtr underlying_allocation_;
+  std::map<gpuStream_t, gpuEvent_t> outstanding_event_map_;
+  SpinLock outstanding_event_map_lock_;
+};
+
+/**
+ * StreamSafeCUDAPinnedAllocator makes freeing a pinned buffer safe while an
+ * asynchronous copy is still using it, so callers do not need to synchronize
+ * the stream before dropping the buffer.
+ *
+ * Streams are recorded via memory::RecordStream. A freed allocation whose
+ * events have not completed is kept aside and only returned to the
+ * underlying allocator once they have, so the block is not handed out again
+ * before the copy finishes. Pending allocations are checked on every
+ * Allocate; when the underlying allocator runs out of memory, they are waited
+ * for and the allocation is retried.
+ */
+class StreamSafeCUDAPinnedAllocator : public Allocator {
+ public:
+  explicit StreamSafeCUDAPinnedAllocator(
+      std::shared_ptr<Allocator> underlying_allocator);
+  ~StreamSafeCUDAPinnedAllocator();
+
+  bool IsAllocThreadSafe() const override { return true; }
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry) const override {
+    underlying_allocator_->CollectTelemetry(telemetry);
+  }
+
+  // Bytes freed by the user but still used by an unfinished copy.
+  size_t PendingBytes() const;
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+  uint64_t ReleaseImpl(const phi::Place& place) override;
+
+ private:
+  void ProcessUnfreedAllocations();
+  void SynchronizeUnfreedAllocations();
+
+  std::shared_ptr<Allocator> underlying_allocator_;
+  std::list<StreamSafeCUDAPinnedAllocation*> unfreed_allocations_;
+  size_t unfreed_bytes_{0};
+  mutable SpinLock unfreed_allocation_lock_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
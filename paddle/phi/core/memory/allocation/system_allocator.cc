@@ -224,6 +224,7 @@ void* CUDAPinnedAllocator::Alloc(size_t* index, size_t size) {
     *index = 1;  // PINNED memory
     cuda_pinnd_alloc_size_ += size;
     HOST_MEMORY_STAT_UPDATE(Reserved, 0, size);
+    HOST_MEMORY_STAT_UPDATE(PinnedReserved, 0, size);
     platform::RecordMemEvent(
         p, CPUPlace(), size, phi::TracerMemEventType::ReservedAllocate);
     return p;
@@ -277,6 +278,7 @@ void CUDAPinnedAllocator::Free(void* p, size_t size, size_t index) {
   }
 #endif
   HOST_MEMORY_STAT_UPDATE(Reserved, 0, -size);
+  HOST_MEMORY_STAT_UPDATE(PinnedReserved, 0, -size);
   platform::RecordMemEvent(
       p, CPUPlace(), size, phi::TracerMemEventType::ReservedFree);
 }
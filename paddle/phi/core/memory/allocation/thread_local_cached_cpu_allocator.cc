@@ -0,0 +1,355 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/thread_local_cached_cpu_allocator.h"
+
+#include <algorithm>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <utility>
+
+namespace paddle::memory::allocation {
+
+// The smallest size class, requests below it are rounded up to it.
+static constexpr size_t kMinBlockSize = 64;
+// A batch moved between a thread cache and the central pool holds at most
+// kTransferBytes bytes and kMaxTransferBlocks blocks.
+static constexpr size_t kTransferBytes = 256UL << 10;
+static constexpr size_t kMaxTransferBlocks = 32;
+// Number of Allocate/Free calls of a thread between two scavenging passes.
+static constexpr size_t kScavengeInterval = 4096;
+
+std::atomic<uint64_t> ThreadLocalCachedCPUAllocator::next_id_{0};
+
+class CachedAllocation : public Allocation {
+ public:
+  CachedAllocation(DecoratedAllocationPtr underlying_allocation, int class_idx)
+      : Allocation(underlying_allocation->ptr(),
+                   underlying_allocation->base_ptr(),
+                   underlying_allocation->size(),
+                   underlying_allocation->place()),
+        underlying_allocation_(std::move(underlying_allocation)),
+        class_idx_(class_idx) {}
+
+  // -1 if the allocation does not belong to any size class.
+  int ClassIndex() const { return class_idx_; }
+
+  DecoratedAllocationPtr TakeUnderlyingAllocation() {
+    return std::move(underlying_allocation_);
+  }
+
+ private:
+  DecoratedAllocationPtr underlying_allocation_;
+  int class_idx_;
+};
+
+class ThreadLocalCachedCPUAllocator::CentralPool {
+ public:
+  CentralPool(std::shared_ptr<Allocator> underlying_allocator,
+              size_t max_block_size)
+      : underlying_allocator_(std::move(underlying_allocator)) {
+    // Four size classes per power of two bound the internal fragmentation to
+    // 25%.
+    for (size_t base = kMinBlockSize; base <= max_block_size; base <<= 1) {
+      for (size_t i = 0; i < 4 && base + base / 4 * i <= max_block_size; ++i) {
+        class_sizes_.emplace_back(base + base / 4 * i);
+      }
+    }
+    free_blocks_.resize(class_sizes_.size());
+  }
+
+  size_t NumClasses() const { return class_sizes_.size(); }
+
+  size_t ClassSize(int idx) const { return class_sizes_[idx]; }
+
+  int ClassIndex(size_t size) const {
+    auto it = std::lower_bound(class_sizes_.begin(), class_sizes_.end(), size);
+    return it == class_sizes_.end()
+               ? -1
+               : static_cast<int>(std::distance(class_sizes_.begin(), it));
+  }
+
+  size_t TransferNum(int idx) const {
+    return std::min(
+        std::max(kTransferBytes / class_sizes_[idx], static_cast<size_t>(1)),
+        kMaxTransferBlocks);
+  }
+
+  DecoratedAllocationPtr AllocateFromUnderlying(size_t size) {
+    return static_unique_ptr_cast<Allocation>(
+        underlying_allocator_->Allocate(size));
+  }
+
+  // Appends at most `num` cached blocks of class `idx` to `blocks`.
+  void Fetch(int idx, size_t num, std::vector<DecoratedAllocationPtr>* blocks) {
+    std::lock_guard<SpinLock> guard(lock_);
+    auto& free_blocks = free_blocks_[idx];
+    num = std::min(num, free_blocks.size());
+    for (size_t i = 0; i < num; ++i) {
+      blocks->emplace_back(std::move(free_blocks.back()));
+      free_blocks.pop_back();
+    }
+    cached_bytes_ -= num * class_sizes_[idx];
+  }
+
+  // Takes the first `num` blocks of `blocks`, which are the least recently
+  // used ones of a thread cache.
+  void Return(int idx,
+              size_t num,
+              std::vector<DecoratedAllocationPtr>* blocks) {
+    num = std::min(num, blocks->size());
+    std::lock_guard<SpinLock> guard(lock_);
+    auto& free_blocks = free_blocks_[idx];
+    free_blocks.insert(free_blocks.end(),
+                       std::make_move_iterator(blocks->begin()),
+                       std::make_move_iterator(blocks->begin() + num));
+    blocks->erase(blocks->begin(), blocks->begin() + num);
+    cached_bytes_ += num * class_sizes_[idx];
+  }
+
+  uint64_t Release() {
+    std::vector<std::vector<DecoratedAllocationPtr>> free_blocks;
+    {
+      std::lock_guard<SpinLock> guard(lock_);
+      free_blocks.swap(free_blocks_);
+      free_blocks_.resize(class_sizes_.size());
+      cached_bytes_ = 0;
+    }
+    uint64_t released_bytes = 0;
+    for (size_t idx = 0; idx < free_blocks.size(); ++idx) {
+      released_bytes += free_blocks[idx].size() * class_sizes_[idx];
+    }
+    // Blocks are given back to the underlying allocator out of the lock.
+    free_blocks.clear();
+    return released_bytes;
+  }
+
+  size_t CachedBytes() const { return cached_bytes_.load(); }
+
+  void CollectTelemetry(std::vector<AllocatorTelemetry>* telemetry) const {
+    underlying_allocator_->CollectTelemetry(telemetry);
+  }
+
+ private:
+  std::shared_ptr<Allocator> underlying_allocator_;
+  std::vector<size_t> class_sizes_;
+  std::vector<std::vector<DecoratedAllocationPtr>> free_blocks_;
+  std::atomic<size_t> cached_bytes_{0};
+  SpinLock lock_;
+};
+
+class ThreadLocalCachedCPUAllocator::ThreadCache {
+ public:
+  ThreadCache(std::shared_ptr<CentralPool> central_pool,
+              size_t max_cached_bytes)
+      : central_pool_(std::move(central_pool)),
+        max_cached_bytes_(max_cached_bytes),
+        free_lists_(central_pool_->NumClasses()) {}
+
+  ~ThreadCache() { Flush(); }
+
+  DecoratedAllocationPtr Pop(int idx) {
+    MaybeScavenge();
+    auto& free_list = free_lists_[idx];
+    if (free_list.blocks.empty()) {
+      central_pool_->Fetch(
+          idx, central_pool_->TransferNum(idx), &free_list.blocks);
+      if (free_list.blocks.empty()) {
+        return central_pool_->AllocateFromUnderlying(
+            central_pool_->ClassSize(idx));
+      }
+      cached_bytes_ += free_list.blocks.size() * central_pool_->ClassSize(idx);
+    }
+    auto block = std::move(free_list.blocks.back());
+    free_list.blocks.pop_back();
+    free_list.low_water =
+        std::min(free_list.low_water, free_list.blocks.size());
+    cached_bytes_ -= central_pool_->ClassSize(idx);
+    return block;
+  }
+
+  void Push(int idx, DecoratedAllocationPtr block) {
+    auto& free_list = free_lists_[idx];
+    free_list.blocks.emplace_back(std::move(block));
+    cached_bytes_ += central_pool_->ClassSize(idx);
+
+    size_t transfer_num = central_pool_->TransferNum(idx);
+    if (free_list.blocks.size() > 2 * transfer_num) {
+      ReturnToCentral(idx, transfer_num);
+    }
+    if (cached_bytes_ > max_cached_bytes_) {
+      Trim(max_cached_bytes_ / 2);
+    }
+    MaybeScavenge();
+  }
+
+  void Flush() {
+    for (size_t idx = 0; idx < free_lists_.size(); ++idx) {
+      ReturnToCentral(idx, free_lists_[idx].blocks.size());
+    }
+  }
+
+  size_t CachedBytes() const { return cached_bytes_; }
+
+ private:
+  struct FreeList {
+    std::vector<DecoratedAllocationPtr> blocks;
+    // The min size of blocks since the last scavenging. These blocks have
+    // not been used during a whole interval.
+    size_t low_water{0};
+  };
+
+  void ReturnToCentral(int idx, size_t num) {
+    auto& free_list = free_lists_[idx];
+    num = std::min(num, free_list.blocks.size());
+    if (num == 0) return;
+    central_pool_->Return(idx, num, &free_list.blocks);
+    free_list.low_water =
+        std::min(free_list.low_water, free_list.blocks.size());
+    cached_bytes_ -= num * central_pool_->ClassSize(idx);
+  }
+
+  // Returns blocks of the largest classes first until at most `target_bytes`
+  // are cached.
+  void Trim(size_t target_bytes) {
+    for (int idx = static_cast<int>(free_lists_.size()) - 1;
+         idx >= 0 && cached_bytes_ > target_bytes;
+         --idx) {
+      size_t class_size = central_pool_->ClassSize(idx);
+      size_t num = (cached_bytes_ - target_bytes + class_size - 1) / class_size;
+      ReturnToCentral(idx, num);
+    }
+  }
+
+  void MaybeScavenge() {
+    if (++ops_ < kScavengeInterval) return;
+    ops_ = 0;
+    for (size_t idx = 0; idx < free_lists_.size(); ++idx) {
+      auto& free_list = free_lists_[idx];
+      ReturnToCentral(idx, free_list.low_water);
+      free_list.low_water = free_list.blocks.size();
+    }
+  }
+
+  std::shared_ptr<CentralPool> central_pool_;
+  size_t max_cached_bytes_;
+  std::vector<FreeList> free_lists_;
+  size_t cached_bytes_{0};
+  size_t ops_{0};
+};
+
+namespace {
+
+// Owns the thread caches of all ThreadLocalCachedCPUAllocator of one thread.
+// Allocations may still be freed by other thread_local destructors after it
+// has been destroyed, `destroyed` tells them to bypass the thread cache.
+template <typename ThreadCache>
+struct ThreadCacheHolder {
+  ~ThreadCacheHolder() { destroyed = true; }
+
+  std::unordered_map<uint64_t, std::unique_ptr<ThreadCache>> caches;
+  static thread_local bool destroyed;
+};
+
+template <typename ThreadCache>
+thread_local bool ThreadCacheHolder<ThreadCache>::destroyed = false;
+
+}  // namespace
+
+ThreadLocalCachedCPUAllocator::ThreadLocalCachedCPUAllocator(
+    std::shared_ptr<Allocator> underlying_allocator,
+    size_t max_cached_bytes_per_thread,
+    size_t max_block_size)
+    : central_pool_(std::make_shared<CentralPool>(
+          std::move(underlying_allocator),
+          std::min(max_block_size, max_cached_bytes_per_thread))),
+      max_cached_bytes_per_thread_(max_cached_bytes_per_thread),
+      id_(next_id_++) {
+  VLOG(4) << "ThreadLocalCachedCPUAllocator max_cached_bytes_per_thread:"
+          << max_cached_bytes_per_thread_
+          << " size_classes_num:" << central_pool_->NumClasses();
+}
+
+ThreadLocalCachedCPUAllocator::ThreadCache*
+ThreadLocalCachedCPUAllocator::GetThreadCache() {
+  using Holder = ThreadCacheHolder<ThreadCache>;
+  static thread_local Holder holder;
+  if (Holder::destroyed) {
+    return nullptr;
+  }
+  auto& cache = holder.caches[id_];
+  if (cache == nullptr) {
+    cache = std::make_unique<ThreadCache>(central_pool_,
+                                          max_cached_bytes_per_thread_);
+  }
+  return cache.get();
+}
+
+size_t ThreadLocalCachedCPUAllocator::ThreadCachedBytes() {
+  auto* cache = GetThreadCache();
+  return cache == nullptr ? 0 : cache->CachedBytes();
+}
+
+size_t ThreadLocalCachedCPUAllocator::CentralCachedBytes() const {
+  return central_pool_->CachedBytes();
+}
+
+void ThreadLocalCachedCPUAllocator::CollectTelemetry(
+    std::vector<AllocatorTelemetry>* telemetry) const {
+  // Thread caches are private to their threads, only the central pool is
+  // visible here.
+  AllocatorTelemetry info;
+  info.allocator = "ThreadLocalCachedCPUAllocator";
+  info.reserved_bytes = static_cast<int64_t>(central_pool_->CachedBytes());
+  telemetry->emplace_back(std::move(info));
+  central_pool_->CollectTelemetry(telemetry);
+}
+
+phi::Allocation* ThreadLocalCachedCPUAllocator::AllocateImpl(size_t size) {
+  int idx = central_pool_->ClassIndex(size);
+  if (idx < 0) {
+    return new CachedAllocation(central_pool_->AllocateFromUnderlying(size),
+                                -1);
+  }
+  auto* cache = GetThreadCache();
+  if (cache == nullptr) {
+    return new CachedAllocation(
+        central_pool_->AllocateFromUnderlying(central_pool_->ClassSize(idx)),
+        -1);
+  }
+  return new CachedAllocation(cache->Pop(idx), idx);
+}
+
+void ThreadLocalCachedCPUAllocator::FreeImpl(phi::Allocation* allocation) {
+  auto* cached_allocation = static_cast<CachedAllocation*>(allocation);
+  int idx = cached_allocation->ClassIndex();
+  if (idx >= 0) {
+    auto* cache = GetThreadCache();
+    if (cache != nullptr) {
+      cache->Push(idx, cached_allocation->TakeUnderlyingAllocation());
+    }
+  }
+  // The underlying allocation, if any, is freed with the wrapper.
+  delete cached_allocation;
+}
+
+uint64_t ThreadLocalCachedCPUAllocator::ReleaseImpl(const phi::Place& place) {
+  auto* cache = GetThreadCache();
+  if (cache != nullptr) {
+    cache->Flush();
+  }
+  return central_pool_->Release();
+}
+
+}  // namespace paddle::memory::allocation
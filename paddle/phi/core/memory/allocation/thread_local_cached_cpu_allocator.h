@@ -0,0 +1,86 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+#include "paddle/phi/core/memory/allocation/spin_lock.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+/**
+ * ThreadLocalCachedCPUAllocator puts a per-thread cache in front of an
+ * underlying CPU allocator, in the spirit of tcmalloc.
+ *
+ * Requests no larger than `max_block_size` are rounded up to a size class
+ * and served from the calling thread's cache without any lock. Each thread
+ * cache exchanges batches of blocks (magazines) with a central pool shared by
+ * all threads, which is the only place a lock is taken:
+ *
+ *   - a thread cache fetches a batch from the central pool when it runs empty,
+ *   - it returns a batch when one size class holds too many blocks, or when
+ *     the bytes it caches exceed `max_cached_bytes_per_thread`,
+ *   - every few thousand operations it returns the blocks that stayed unused
+ *     since the last scavenging, so that idle threads do not pin memory.
+ *
+ * Larger requests go to the underlying allocator directly. Release() flushes
+ * the calling thread's cache and frees every block held by the central pool.
+ */
+class ThreadLocalCachedCPUAllocator : public Allocator {
+ public:
+  static constexpr size_t kDefaultMaxBlockSize = 1UL << 20;
+
+  ThreadLocalCachedCPUAllocator(std::shared_ptr<Allocator> underlying_allocator,
+                                size_t max_cached_bytes_per_thread,
+                                size_t max_block_size = kDefaultMaxBlockSize);
+
+  bool IsAllocThreadSafe() const override { return true; }
+
+  void CollectTelemetry(
+      std::vector<AllocatorTelemetry>* telemetry) const override;
+
+  // Bytes cached by the calling thread.
+  size_t ThreadCachedBytes();
+  // Bytes cached by the central pool.
+  size_t CentralCachedBytes() const;
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+  uint64_t ReleaseImpl(const phi::Place& place) override;
+
+ private:
+  class CentralPool;
+  class ThreadCache;
+
+  ThreadCache* GetThreadCache();
+
+  std::shared_ptr<CentralPool> central_pool_;
+  size_t max_cached_bytes_per_thread_;
+  // Used to find the thread caches of this allocator, an address could be
+  // reused by a later allocator.
+  uint64_t id_;
+
+  static std::atomic<uint64_t> next_id_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -33,6 +33,26 @@ uint64_t Release(const phi::Place& place) {
   return allocation::AllocatorFacade::Instance().Release(place);
 }
 
+std::vector<allocation::AllocatorTelemetry> GetAllocatorTelemetry(
+    const phi::Place& place) {
+  return allocation::AllocatorFacade::Instance().GetAllocatorTelemetry(place);
+}
+
+uint64_t ReplayAllocationProfile(
+    const allocation::AllocationProfile& profile) {
+  std::vector<AllocationPtr> allocations;
+  uint64_t bytes = 0;
+  for (auto& block : profile.blocks) {
+    for (size_t i = 0; i < block.second; ++i) {
+      allocations.emplace_back(Alloc(profile.place, block.first));
+      bytes += block.first;
+    }
+  }
+  VLOG(3) << "Replay the allocation profile of " << profile.place << ", "
+          << allocations.size() << " blocks of " << bytes << " bytes";
+  return bytes;
+}
+
 std::shared_ptr<Allocation> AllocShared(const phi::Place& place,
                                         size_t size,
                                         const phi::Stream& stream) {
@@ -15,10 +15,12 @@ limitations under the License. */
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "paddle/phi/backends/device_manager.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/device_context.h"
+#include "paddle/phi/core/memory/allocation/allocation_profiler.h"
 #include "paddle/phi/core/memory/allocation/allocator.h"
 #include "paddle/phi/core/stream.h"
 
@@ -36,6 +38,15 @@ TEST_API extern AllocationPtr Alloc(const phi::Place& place, size_t size);
 
 extern uint64_t Release(const phi::Place& place);
 
+extern std::vector<allocation::AllocatorTelemetry> GetAllocatorTelemetry(
+    const phi::Place& place);
+
+// Allocates all the blocks of the profile at once and frees them, so that
+// the allocator of the place has grown and split its chunks before the first
+// real request. Returns the bytes allocated.
+TEST_API extern uint64_t ReplayAllocationProfile(
+    const allocation::AllocationProfile& profile);
+
 extern std::shared_ptr<Allocation> AllocShared(const phi::Place& place,
                                                size_t size,
                                                const phi::Stream& stream);
@@ -22,6 +22,12 @@ PHI_DEFINE_EXPORTED_bool(
     log_memory_stats,
     false,
     "Log memory stats after each op runs, just used for debug.");
+
+PHI_DEFINE_EXPORTED_int32(
+    allocator_lifetime_sample_rate,
+    64,
+    "Record the lifetime of one out of about N allocations in StatAllocator, "
+    "which is reported by the allocator telemetry. 0 disables sampling.");
 namespace paddle::memory {
 
 class StatRegistry {
@@ -163,9 +169,13 @@ void LogDeviceMemoryStats(const phi::Place& place, const std::string& op_name) {
 int RegisterAllStats() {
   DEVICE_MEMORY_STAT_REGISTER(Allocated);
   DEVICE_MEMORY_STAT_REGISTER(Reserved);
+  DEVICE_MEMORY_STAT_REGISTER(SizeClassCached);
 
   HOST_MEMORY_STAT_REGISTER(Allocated);
   HOST_MEMORY_STAT_REGISTER(Reserved);
+  HOST_MEMORY_STAT_REGISTER(SizeClassCached);
+  HOST_MEMORY_STAT_REGISTER(PinnedAllocated);
+  HOST_MEMORY_STAT_REGISTER(PinnedReserved);
   return 0;
 }
 
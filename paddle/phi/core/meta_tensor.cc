@@ -354,6 +354,16 @@ const LoD& MetaTensor::lod() const {
   }
 }
 
+bool MetaTensor::has_lod() const {
+  if (phi::DenseTensor::classof(tensor_) ||
+      phi::SelectedRows::classof(tensor_) ||
+      phi::SparseCooTensor::classof(tensor_) ||
+      phi::SparseCsrTensor::classof(tensor_)) {
+    return !lod().empty();
+  }
+  return false;
+}
+
 const LoD& MetaTensor::lod(int64_t index) const {
   ValidCheck(*this);
   PADDLE_ENFORCE_EQ(
@@ -93,6 +93,10 @@ class TEST_API MetaTensor {
 
   virtual bool is_same_tensor(const MetaTensor& meta_tensor) const;
 
+  // Whether the tensor carries a non-empty LoD. The LoD itself stays
+  // protected, see lod() below.
+  bool has_lod() const;
+
   virtual operator unspecified_bool_type() const {
     return tensor_ == nullptr ? 0 : unspecified_bool_true;
   }
@@ -257,7 +257,10 @@ class RecordedGpuMallocHelper {
    * or cudaSuccess would be returned, and the cudaGetLastError() flag
    * would be clear.
    */
-  gpuError_t MallocAsync(void **ptr, size_t size, gpuStream_t stream) {
+  gpuError_t MallocAsync(void **ptr,
+                         size_t size,
+                         gpuStream_t stream,
+                         void *mem_pool) {
 #if defined(PADDLE_WITH_HIP) || \
     defined(PADDLE_WITH_CUDA) && (CUDA_VERSION >= 11020)
     LockGuardPtr<std::mutex> lock(mtx_);
@@ -292,7 +295,12 @@ class RecordedGpuMallocHelper {
 
     gpuError_t result;
 #ifdef PADDLE_WITH_CUDA
-    result = cudaMallocAsync(ptr, size, stream);
+    if (mem_pool != nullptr) {
+      result = cudaMallocFromPoolAsync(
+          ptr, size, static_cast<cudaMemPool_t>(mem_pool), stream);
+    } else {
+      result = cudaMallocAsync(ptr, size, stream);
+    }
 #else  // PADDLE_WITH_HIP
     result = hipMallocAsync(ptr, size, stream);
 #endif
@@ -538,9 +546,10 @@ void RecordedGpuFree(void *p, size_t size, int dev_id) {
 gpuError_t RecordedGpuMallocAsync(void **ptr,
                                   size_t size,
                                   int dev_id,
-                                  gpuStream_t stream) {
+                                  gpuStream_t stream,
+                                  void *mem_pool) {
   return RecordedGpuMallocHelper::Instance(dev_id)->MallocAsync(
-      ptr, size, stream);
+      ptr, size, stream, mem_pool);
 }
 
 void RecordedGpuFreeAsync(void *p,
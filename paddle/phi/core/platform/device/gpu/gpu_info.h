@@ -137,11 +137,13 @@ gpuError_t RecordedGpuMalloc(void **ptr,
 //! CudaFree with recorded info
 void RecordedGpuFree(void *p, size_t size, int dev_id);
 
-//! CudaMalloc with recorded info
+//! CudaMalloc with recorded info, `mem_pool` is the cudaMemPool_t to
+//! allocate from (HIP ignores it), nullptr means the default pool.
 gpuError_t RecordedGpuMallocAsync(void **ptr,
                                   size_t size,
                                   int dev_id,
-                                  gpuStream_t stream);
+                                  gpuStream_t stream,
+                                  void *mem_pool = nullptr);
 
 //! CudaFree with recorded info
 void RecordedGpuFreeAsync(void *p, size_t size, int dev_id, gpuStream_t stream);
@@ -16,6 +16,14 @@
 
 DEFINE_INT_STATUS(STAT_total_feasign_num_in_mem)
 DEFINE_INT_STATUS(STAT_epoch_finish)
+DEFINE_INT_STATUS(STAT_dataset_reader_queue_size)
+DEFINE_INT_STATUS(STAT_dataset_reader_queue_capacity)
+DEFINE_INT_STATUS(STAT_dataset_active_reader_num)
+DEFINE_INT_STATUS(STAT_dataset_sample_cache_hit_num)
+DEFINE_INT_STATUS(STAT_dataset_sample_cache_miss_num)
+DEFINE_INT_STATUS(STAT_dataset_sample_cache_saved_ms)
+DEFINE_INT_STATUS(STAT_dataset_sample_cache_mem_bytes)
+DEFINE_INT_STATUS(STAT_dataset_sample_cache_spill_bytes)
 DEFINE_INT_STATUS(STAT_gpu0_mem_size)
 DEFINE_INT_STATUS(STAT_gpu1_mem_size)
 DEFINE_INT_STATUS(STAT_gpu2_mem_size)
@@ -25,6 +25,8 @@
 #include "paddle/fluid/platform/profiler/host_tracer.h"
 #include "paddle/fluid/platform/profiler/profiler.h"
 #include "paddle/phi/api/profiler/device_tracer.h"
+#include "paddle/phi/api/profiler/host_event_dump.h"
+#include "paddle/phi/core/memory/allocation/memory_timeline.h"
 #include "paddle/phi/core/platform/profiler/host_event_recorder.h"
 #include "paddle/phi/core/platform/profiler_helper.h"
 #ifdef PADDLE_WITH_CUDA
@@ -40,6 +42,7 @@ COMMON_DECLARE_bool(enable_record_memory);
 #if defined(_WIN32) && defined(PHI_SHARED)
 phi::ProfilerState phi::ProfilerHelper::g_state = phi::ProfilerState::kDisabled;
 bool phi::ProfilerHelper::g_enable_nvprof_hook = false;
+bool phi::ProfilerHelper::g_enable_itt_hook = false;
 thread_local uint64_t phi::ProfilerHelper::g_thread_id;
 uint32_t phi::ProfilerHelper::g_next_thread_id = 0;
 std::mutex phi::ProfilerHelper::g_all_event_lists_mutex;
@@ -129,6 +132,11 @@ RecordMemEvent::RecordMemEvent(const void *ptr,
                                const phi::Place &place,
                                size_t size,
                                const phi::TracerMemEventType type) {
+  if (UNLIKELY(memory::allocation::MemoryTimeline::IsRecording())) {
+    memory::allocation::MemoryTimeline::Instance().Record(
+        ptr, place, size, type);
+  }
+
   if (phi::ProfilerHelper::g_state == ProfilerState::kDisabled &&
       FLAGS_enable_host_event_recorder_hook == false) {
     return;
@@ -838,12 +846,45 @@ void NvprofDisableRecordEvent() {
   phi::ProfilerHelper::g_enable_nvprof_hook = false;
 }
 
+void IttEnableRecordEvent() {
+#ifdef PADDLE_WITH_ITT
+  phi::ProfilerHelper::g_enable_itt_hook = true;
+#else
+  PADDLE_THROW(common::errors::Unavailable(
+      "Paddle is not compiled with ITT, please recompile it with "
+      "-DWITH_ITT=ON to push the ranges of RecordEvent to VTune."));
+#endif
+}
+
+void IttDisableRecordEvent() {
+  phi::ProfilerHelper::g_enable_itt_hook = false;
+}
+
 void EnableHostEventRecorder() { FLAGS_enable_host_event_recorder_hook = true; }
 
 void DisableHostEventRecorder() {
   FLAGS_enable_host_event_recorder_hook = false;
 }
 
+void StartHostEventDump(uint32_t trace_level) {
+  PADDLE_ENFORCE_EQ(FLAGS_enable_host_event_recorder_hook,
+                    false,
+                    common::errors::PreconditionNotMet(
+                        "The host events are being recorded by a profiler, "
+                        "stop it before starting the host event dump."));
+  // Drops the events recorded before.
+  HostEventRecorder<CommonEvent>::GetInstance().GatherEvents();
+  HostTraceLevel::GetInstance().SetLevel(trace_level);
+  EnableHostEventRecorder();
+}
+
+size_t StopHostEventDump(const std::string &path) {
+  DisableHostEventRecorder();
+  HostTraceLevel::GetInstance().SetLevel(HostTraceLevel::kDisabled);
+  return phi::DumpHostEvents(
+      HostEventRecorder<CommonEvent>::GetInstance().GatherEvents(), path);
+}
+
 void EnableMemoryRecorder() { FLAGS_enable_record_memory = true; }
 
 void DisableMemoryRecorder() { FLAGS_enable_record_memory = false; }
@@ -215,9 +215,20 @@ int64_t ListenerId();
 void NvprofEnableRecordEvent();
 void NvprofDisableRecordEvent();
 
+// Pushes the ranges of RecordEvent to VTune as ITT tasks, when Paddle is
+// compiled with ITT.
+void IttEnableRecordEvent();
+void IttDisableRecordEvent();
+
 void EnableHostEventRecorder();
 void DisableHostEventRecorder();
 
+// Records the host events without a profiler, and writes them to path in the
+// binary format of phi::DumpHostEvents, which costs less than a profiler both
+// to record and to stop. Returns the number of events written.
+TEST_API void StartHostEventDump(uint32_t trace_level);
+TEST_API size_t StopHostEventDump(const std::string& path);
+
 void EnableMemoryRecorder();
 void DisableMemoryRecorder();
 
@@ -221,6 +221,20 @@ bool DenseTensorMeta::is_contiguous() const {
   return is_contiguous;
 }
 
+CompactDenseTensorMeta::CompactDenseTensorMeta(const DenseTensorMeta& meta)
+    : rank_(meta.dims.size()), dtype_(meta.dtype), layout_(meta.layout) {
+  if (rank_ > 0) {
+    dims_.assign(meta.dims.Get(), meta.dims.Get() + rank_);
+  }
+}
+
+DDim CompactDenseTensorMeta::dims() const {
+  if (rank_ == -1) {
+    return DDim();
+  }
+  return DDim(dims_.data(), rank_);
+}
+
 StringTensorMeta::StringTensorMeta(const DDim& dims) : dims(dims) {}
 
 bool StringTensorMeta::valid() const noexcept {
@@ -22,6 +22,7 @@ limitations under the License. */
 #include "paddle/phi/core/ddim.h"
 #include "paddle/utils/any.h"
 #include "paddle/utils/optional.h"
+#include "paddle/utils/small_vector.h"
 #include "paddle/utils/test_macros.h"
 
 namespace phi {
@@ -92,6 +93,31 @@ inline bool operator==(const DenseTensorMeta& lhs, const DenseTensorMeta& rhs) {
          (lhs.offset == rhs.offset) && (lhs.strides == rhs.strides);
 }
 
+/// \brief The dims, dtype and layout of a DenseTensorMeta, for the metas kept
+/// per tensor that need nothing else, as the autograd keeps one for each
+/// input and output of an op. The dims of rank <= 4 are stored inline and the
+/// LoD and strides are dropped, so that it takes less than a third of the
+/// size of a DenseTensorMeta and is copied without allocating.
+class TEST_API CompactDenseTensorMeta {
+ public:
+  constexpr static int kInlineRank = 4;
+
+  CompactDenseTensorMeta() = default;
+  explicit CompactDenseTensorMeta(const DenseTensorMeta& meta);
+
+  DDim dims() const;
+  /// \brief The rank of the dims, -1 when they are not set.
+  int rank() const { return rank_; }
+  DataType dtype() const { return dtype_; }
+  DataLayout layout() const { return layout_; }
+
+ private:
+  int rank_{-1};
+  DataType dtype_{DataType::UNDEFINED};
+  DataLayout layout_{DataLayout::NCHW};
+  paddle::small_vector<int64_t, kInlineRank> dims_;
+};
+
 struct StringTensorMeta {
   StringTensorMeta() = default;
   explicit StringTensorMeta(const DDim& dims);
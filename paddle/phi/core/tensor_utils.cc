@@ -164,6 +164,12 @@ void Copy(const Context& dev_ctx,
                  : reinterpret_cast<const phi::GPUContext&>(dev_ctx).stream();
     memory_utils::Copy(
         dst_gpu_place, dst_ptr, src_cpu_place, src_ptr, size, stream);
+    // The pinned source may be freed before the async copy finishes.
+    if (stream != nullptr &&
+        src_place.GetType() == AllocationType::GPUPINNED && src.Holder()) {
+      memory_utils::RecordStream(
+          src.Holder(), phi::Stream(reinterpret_cast<phi::StreamId>(stream)));
+    }
   } else if (src_place.GetType() == AllocationType::GPU &&  // NOLINT
              dst_place.GetType() == AllocationType::GPU) {
     auto src_gpu_place = src_place;
@@ -219,6 +225,10 @@ void Copy(const Context& dev_ctx,
                  : reinterpret_cast<const phi::GPUContext&>(dev_ctx).stream();
     memory_utils::Copy(
         dst_cuda_pinned_place, dst_ptr, src_gpu_place, src_ptr, size, stream);
+    if (stream != nullptr && dst->Holder()) {
+      memory_utils::RecordStream(
+          dst->Holder(), phi::Stream(reinterpret_cast<phi::StreamId>(stream)));
+    }
 #endif
 #ifdef PADDLE_WITH_XPU
   } else if (src_place.GetType() == AllocationType::XPU &&  // NOLINT
@@ -14,6 +14,8 @@
 
 #include "paddle/phi/core/vocab/string_array.h"
 #include <utf8proc.h>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include "glog/logging.h"
 
@@ -21,13 +23,70 @@ namespace phi {
 
 std::wstring_convert<std::codecvt_utf8<wchar_t>> kConverter;
 
-// Convert the std::string type to the std::wstring type.
+// Convert the std::string type to the std::wstring type. The UTF-8 is
+// decoded here rather than by kConverter, which keeps a state and so may not
+// be used by several threads at once, e.g. by the batch of faster_tokenizer.
+// It is decoded as by std::codecvt_utf8: the overlong forms and the code
+// points above 0x10FFFF, or above 0xFFFF for a 16-bit wchar_t, are rejected,
+// and a sequence cut by the end of src is dropped.
 bool ConvertStrToWstr(const std::string& src, std::wstring* res) {
-  try {
-    *res = kConverter.from_bytes(src);
-  } catch (std::range_error& e) {
-    VLOG(3) << "The string " << src << " was converted to unicode failedly! ";
-    return false;
+  constexpr uint32_t kMaxCode = sizeof(wchar_t) == 2 ? 0xFFFF : 0x10FFFF;
+  const auto* s = reinterpret_cast<const unsigned char*>(src.data());
+  const size_t n = src.size();
+  res->clear();
+  res->reserve(n);
+  size_t i = 0;
+  while (i < n) {
+    // Eight ASCII bytes at a time, checked by their high bits at once.
+    if (i + 8 <= n) {
+      uint64_t word;
+      std::memcpy(&word, s + i, sizeof(word));
+      if ((word & 0x8080808080808080ULL) == 0) {
+        for (size_t j = 0; j < 8; ++j) {
+          res->push_back(static_cast<wchar_t>(s[i + j]));
+        }
+        i += 8;
+        continue;
+      }
+    }
+    unsigned char c = s[i];
+    if (c < 0x80) {
+      res->push_back(static_cast<wchar_t>(c));
+      ++i;
+      continue;
+    }
+    size_t len = 0;
+    uint32_t code = 0;
+    uint32_t min_code = 0;
+    if (c >= 0xC2 && c <= 0xDF) {
+      len = 2;
+      code = c & 0x1F;
+      min_code = 0x80;
+    } else if ((c & 0xF0) == 0xE0) {
+      len = 3;
+      code = c & 0x0F;
+      min_code = 0x800;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      len = 4;
+      code = c & 0x07;
+      min_code = 0x10000;
+    }
+    if (len > 0 && i + len > n) {
+      break;
+    }
+    bool valid = len > 0;
+    for (size_t j = 1; valid && j < len; ++j) {
+      valid = (s[i + j] & 0xC0) == 0x80;
+      code = (code << 6) | (s[i + j] & 0x3F);
+    }
+    if (!valid || code < min_code || code > kMaxCode) {
+      VLOG(3) << "The string " << src
+              << " was converted to unicode failedly! ";
+      res->clear();
+      return false;
+    }
+    res->push_back(static_cast<wchar_t>(code));
+    i += len;
   }
   return true;
 }
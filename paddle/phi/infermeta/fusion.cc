@@ -5192,6 +5192,257 @@ void FP8OutHalfGemmFusedInferMeta(
   }
 }
 
+// The dims of x times the 2-D y, whose first dim is then gathered or
+// scattered over the ranks.
+static DDim FusedMatmulCommOutDims(const MetaTensor& x,
+                                   const MetaTensor& y,
+                                   bool transpose_y) {
+  auto x_dims = x.dims();
+  auto y_dims = y.dims();
+  PADDLE_ENFORCE_GE(x_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The Input(x) should have at least 2 dims, but "
+                        "received %d.",
+                        x_dims.size()));
+  PADDLE_ENFORCE_EQ(y_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The Input(y) should have 2 dims, but received %d.",
+                        y_dims.size()));
+  const int64_t k = transpose_y ? y_dims[1] : y_dims[0];
+  if (x_dims[x_dims.size() - 1] > 0 && k > 0) {
+    PADDLE_ENFORCE_EQ(x_dims[x_dims.size() - 1],
+                      k,
+                      common::errors::InvalidArgument(
+                          "The last dim of Input(x) should be %d as Input(y) "
+                          "has, but received %d.",
+                          k,
+                          x_dims[x_dims.size() - 1]));
+  }
+  x_dims[x_dims.size() - 1] = transpose_y ? y_dims[0] : y_dims[1];
+  return x_dims;
+}
+
+void FusedAllGatherMatmulInferMeta(const MetaTensor& x,
+                                   const MetaTensor& y,
+                                   int nranks,
+                                   bool transpose_y,
+                                   MetaTensor* out) {
+  auto out_dims = FusedMatmulCommOutDims(x, y, transpose_y);
+  if (out_dims[0] > 0) out_dims[0] *= nranks;
+  out->set_dims(out_dims);
+  out->set_dtype(x.dtype());
+  out->set_layout(x.layout());
+}
+
+void FusedMatmulReduceScatterInferMeta(const MetaTensor& x,
+                                       const MetaTensor& y,
+                                       int nranks,
+                                       bool transpose_y,
+                                       MetaTensor* out) {
+  auto out_dims = FusedMatmulCommOutDims(x, y, transpose_y);
+  if (out_dims[0] > 0) {
+    PADDLE_ENFORCE_EQ(
+        out_dims[0] % nranks,
+        0,
+        common::errors::InvalidArgument(
+            "dim[0] (%d) is not divisible by nranks(%d)", out_dims[0], nranks));
+    out_dims[0] /= nranks;
+  }
+  out->set_dims(out_dims);
+  out->set_dtype(x.dtype());
+  out->set_layout(x.layout());
+}
+
+void FusedLinearCrossEntropyInferMeta(const MetaTensor& x,
+                                      const MetaTensor& weight,
+                                      const MetaTensor& label,
+                                      int ignore_index,
+                                      int chunk_size,
+                                      MetaTensor* loss,
+                                      MetaTensor* lse) {
+  auto x_dims = x.dims();
+  auto w_dims = weight.dims();
+  PADDLE_ENFORCE_GE(x_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(x) of fused_linear_cross_entropy "
+                        "should be at least 2, but got %d.",
+                        x_dims.size()));
+  PADDLE_ENFORCE_EQ(w_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(weight) of "
+                        "fused_linear_cross_entropy should be 2, but got %d.",
+                        w_dims.size()));
+  if (x_dims[x_dims.size() - 1] > 0 && w_dims[0] > 0) {
+    PADDLE_ENFORCE_EQ(x_dims[x_dims.size() - 1],
+                      w_dims[0],
+                      common::errors::InvalidArgument(
+                          "The last dim of Input(x) should equal the first "
+                          "dim of Input(weight), but got %d and %d.",
+                          x_dims[x_dims.size() - 1],
+                          w_dims[0]));
+  }
+  PADDLE_ENFORCE_GT(chunk_size,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The chunk_size of fused_linear_cross_entropy should "
+                        "be positive, but got %d.",
+                        chunk_size));
+  int64_t rows =
+      common::product(common::slice_ddim(x_dims, 0, x_dims.size() - 1));
+  if (rows > 0 && label.numel() > 0) {
+    PADDLE_ENFORCE_EQ(label.numel(),
+                      rows,
+                      common::errors::InvalidArgument(
+                          "Input(label) should hold one class for each row "
+                          "of Input(x), which has %d rows, but got %d labels.",
+                          rows,
+                          label.numel()));
+  }
+  loss->set_dims(label.dims());
+  loss->set_dtype(x.dtype());
+  loss->set_layout(x.layout());
+  lse->set_dims(common::make_ddim({rows > 0 ? rows : -1}));
+  lse->set_dtype(DataType::FLOAT32);
+  lse->set_layout(x.layout());
+}
+
+void MoePermuteInferMeta(const MetaTensor& x,
+                         const MetaTensor& expert_ids,
+                         int num_experts,
+                         MetaTensor* permuted_x,
+                         MetaTensor* expert_offsets,
+                         MetaTensor* dest_rows) {
+  auto x_dims = x.dims();
+  auto ids_dims = expert_ids.dims();
+  PADDLE_ENFORCE_EQ(x_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(x) of moe_permute should be 2, "
+                        "but got %d.",
+                        x_dims.size()));
+  PADDLE_ENFORCE_EQ(ids_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(expert_ids) of moe_permute should "
+                        "be 2, but got %d.",
+                        ids_dims.size()));
+  PADDLE_ENFORCE_EQ(
+      expert_ids.dtype(),
+      DataType::INT32,
+      common::errors::InvalidArgument(
+          "The dtype of Input(expert_ids) of moe_permute should be int32."));
+  if (x_dims[0] > 0 && ids_dims[0] > 0) {
+    PADDLE_ENFORCE_EQ(x_dims[0],
+                      ids_dims[0],
+                      common::errors::InvalidArgument(
+                          "Input(expert_ids) should hold the experts of each "
+                          "row of Input(x), which has %d rows, but got %d.",
+                          x_dims[0],
+                          ids_dims[0]));
+  }
+  PADDLE_ENFORCE_GT(num_experts,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The num_experts of moe_permute should be positive, "
+                        "but got %d.",
+                        num_experts));
+  int64_t rows = x_dims[0] >= 0 ? x_dims[0] : ids_dims[0];
+  int64_t expanded_rows =
+      rows >= 0 && ids_dims[1] >= 0 ? rows * ids_dims[1] : -1;
+  permuted_x->set_dims(common::make_ddim({expanded_rows, x_dims[1]}));
+  permuted_x->set_dtype(x.dtype());
+  permuted_x->set_layout(x.layout());
+  expert_offsets->set_dims(common::make_ddim({num_experts}));
+  expert_offsets->set_dtype(DataType::INT64);
+  expert_offsets->set_layout(x.layout());
+  dest_rows->set_dims(common::make_ddim({expanded_rows}));
+  dest_rows->set_dtype(DataType::INT32);
+  dest_rows->set_layout(x.layout());
+}
+
+void MoeGroupedGemmInferMeta(const MetaTensor& x,
+                             const MetaTensor& weight,
+                             const MetaTensor& expert_offsets,
+                             MetaTensor* out) {
+  auto x_dims = x.dims();
+  auto w_dims = weight.dims();
+  PADDLE_ENFORCE_EQ(x_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(x) of moe_grouped_gemm should be "
+                        "2, but got %d.",
+                        x_dims.size()));
+  PADDLE_ENFORCE_EQ(w_dims.size(),
+                    3,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(weight) of moe_grouped_gemm should "
+                        "be 3, [num_experts, k, n], but got %d.",
+                        w_dims.size()));
+  if (x_dims[1] > 0 && w_dims[1] > 0) {
+    PADDLE_ENFORCE_EQ(x_dims[1],
+                      w_dims[1],
+                      common::errors::InvalidArgument(
+                          "The last dim of Input(x) should equal the second "
+                          "dim of Input(weight), but got %d and %d.",
+                          x_dims[1],
+                          w_dims[1]));
+  }
+  if (w_dims[0] > 0 && expert_offsets.numel() > 0) {
+    PADDLE_ENFORCE_EQ(expert_offsets.numel(),
+                      w_dims[0],
+                      common::errors::InvalidArgument(
+                          "Input(expert_offsets) should hold one end row for "
+                          "each of the %d experts, but got %d.",
+                          w_dims[0],
+                          expert_offsets.numel()));
+  }
+  out->set_dims(common::make_ddim({x_dims[0], w_dims[2]}));
+  out->set_dtype(x.dtype());
+  out->set_layout(x.layout());
+}
+
+void MoeUnpermuteInferMeta(const MetaTensor& permuted_y,
+                           const MetaTensor& dest_rows,
+                           const MetaTensor& weights,
+                           MetaTensor* out) {
+  auto y_dims = permuted_y.dims();
+  auto w_dims = weights.dims();
+  PADDLE_ENFORCE_EQ(y_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(permuted_y) of moe_unpermute "
+                        "should be 2, but got %d.",
+                        y_dims.size()));
+  PADDLE_ENFORCE_EQ(w_dims.size(),
+                    2,
+                    common::errors::InvalidArgument(
+                        "The rank of Input(weights) of moe_unpermute should "
+                        "be 2, [rows, k], but got %d.",
+                        w_dims.size()));
+  PADDLE_ENFORCE_EQ(
+      weights.dtype(),
+      DataType::FLOAT32,
+      common::errors::InvalidArgument(
+          "The dtype of Input(weights) of moe_unpermute should be float32."));
+  if (y_dims[0] > 0 && w_dims[0] > 0 && w_dims[1] > 0) {
+    PADDLE_ENFORCE_EQ(y_dims[0],
+                      w_dims[0] * w_dims[1],
+                      common::errors::InvalidArgument(
+                          "Input(permuted_y) should hold k rows for each row "
+                          "of Input(weights) [%d, %d], but got %d rows.",
+                          w_dims[0],
+                          w_dims[1],
+                          y_dims[0]));
+  }
+  out->set_dims(common::make_ddim({w_dims[0], y_dims[1]}));
+  out->set_dtype(permuted_y.dtype());
+  out->set_layout(permuted_y.layout());
+}
+
 void FusedEmbeddingFcLstmInferMeta(const MetaTensor& ids,
                                    const MetaTensor& embeddings,
                                    const MetaTensor& weight_h,
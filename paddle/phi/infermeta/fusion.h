@@ -1150,6 +1150,43 @@ void FP8OutHalfGemmFusedInferMeta(
     const std::string& activation_type,
     MetaTensor* out);
 
+void FusedAllGatherMatmulInferMeta(const MetaTensor& x,
+                                   const MetaTensor& y,
+                                   int nranks,
+                                   bool transpose_y,
+                                   MetaTensor* out);
+
+void FusedMatmulReduceScatterInferMeta(const MetaTensor& x,
+                                       const MetaTensor& y,
+                                       int nranks,
+                                       bool transpose_y,
+                                       MetaTensor* out);
+
+void FusedLinearCrossEntropyInferMeta(const MetaTensor& x,
+                                      const MetaTensor& weight,
+                                      const MetaTensor& label,
+                                      int ignore_index,
+                                      int chunk_size,
+                                      MetaTensor* loss,
+                                      MetaTensor* lse);
+
+void MoePermuteInferMeta(const MetaTensor& x,
+                         const MetaTensor& expert_ids,
+                         int num_experts,
+                         MetaTensor* permuted_x,
+                         MetaTensor* expert_offsets,
+                         MetaTensor* dest_rows);
+
+void MoeGroupedGemmInferMeta(const MetaTensor& x,
+                             const MetaTensor& weight,
+                             const MetaTensor& expert_offsets,
+                             MetaTensor* out);
+
+void MoeUnpermuteInferMeta(const MetaTensor& permuted_y,
+                           const MetaTensor& dest_rows,
+                           const MetaTensor& weights,
+                           MetaTensor* out);
+
 void FusedEmbeddingFcLstmInferMeta(const MetaTensor& ids,
                                    const MetaTensor& embeddings,
                                    const MetaTensor& weight_h,
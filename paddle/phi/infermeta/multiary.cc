@@ -3885,7 +3885,56 @@ void MergedMomentumInferMeta(
     float rescale_grad,
     std::vector<MetaTensor*> param_out,
     std::vector<MetaTensor*> velocity_out,
-    std::vector<MetaTensor*> master_param_out) {}
+    std::vector<MetaTensor*> master_param_out) {
+  for (size_t i = 0; i < param.size(); ++i) {
+    if (param_out[i]) param_out[i]->share_meta(*param[i]);
+    if (velocity_out[i]) velocity_out[i]->share_meta(*velocity[i]);
+    if (master_param && master_param_out[i]) {
+      master_param_out[i]->share_meta(*(master_param.get()[i]));
+    }
+  }
+}
+
+void MergedSgdInferMeta(
+    const std::vector<const MetaTensor*>& param,
+    const MetaTensor& learning_rate,
+    const std::vector<const MetaTensor*>& grad,
+    const paddle::optional<std::vector<const MetaTensor*>>& master_param,
+    bool multi_precision,
+    std::vector<MetaTensor*> param_out,
+    std::vector<MetaTensor*> master_param_out) {
+  PADDLE_ENFORCE_EQ(
+      param.size(),
+      grad.size(),
+      common::errors::InvalidArgument(
+          "The size of Input(Param) and Input(Grad) of merged_sgd should be "
+          "equal, but received %d and %d.",
+          param.size(),
+          grad.size()));
+  auto lr_dims = learning_rate.dims();
+  PADDLE_ENFORCE_EQ(common::product(lr_dims),
+                    1,
+                    common::errors::InvalidArgument(
+                        "Learning rate should have 1 element. But received "
+                        "LearningRate dims [%s]",
+                        common::product(lr_dims)));
+  if (multi_precision) {
+    PADDLE_ENFORCE_EQ(
+        master_param && master_param->size() == param.size(),
+        true,
+        common::errors::InvalidArgument(
+            "Input(MasterParam) of merged_sgd should have the same size as "
+            "Input(Param) when multi_precision is true."));
+  }
+
+  for (size_t i = 0; i < param.size(); ++i) {
+    param_out[i]->set_dims(param[i]->dims());
+    param_out[i]->set_dtype(param[i]->dtype());
+    if (multi_precision && master_param_out[i]) {
+      master_param_out[i]->share_meta(*(master_param.get()[i]));
+    }
+  }
+}
 
 void MemoryEfficientAttentionInferMeta(const MetaTensor& query,
                                        const MetaTensor& key,
@@ -742,6 +742,15 @@ void MergedMomentumInferMeta(
     std::vector<MetaTensor*> velocity_out,
     std::vector<MetaTensor*> master_param_out);
 
+void MergedSgdInferMeta(
+    const std::vector<const MetaTensor*>& param,
+    const MetaTensor& learning_rate,
+    const std::vector<const MetaTensor*>& grad,
+    const paddle::optional<std::vector<const MetaTensor*>>& master_param,
+    bool multi_precision,
+    std::vector<MetaTensor*> param_out,
+    std::vector<MetaTensor*> master_param_out);
+
 void MemoryEfficientAttentionInferMeta(const MetaTensor& query,
                                        const MetaTensor& key,
                                        const MetaTensor& value,
@@ -5886,12 +5886,13 @@ void WeightQuantizeInferMeta(const MetaTensor& x,
                              MetaTensor* out,
                              MetaTensor* scale) {
 #ifndef PADDLE_WITH_HIP
+  // arch 0 stands for the plain layout used by the CPU weight_only_linear.
   PADDLE_ENFORCE_EQ(
-      ((arch == 70) || (arch == 75) || (arch == 80) || (arch == 86) ||
-       (arch == 89) || (arch == 90)),
+      ((arch == 0) || (arch == 70) || (arch == 75) || (arch == 80) ||
+       (arch == 86) || (arch == 89) || (arch == 90)),
       true,
       common::errors::InvalidArgument(
-          "Currently, arch only support 70, 75, 80, 86, 89, 90."));
+          "Currently, arch only support 0, 70, 75, 80, 86, 89, 90."));
 #endif
 
   auto x_dims = x.dims();
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <functional>
 #include <type_traits>
+#include <utility>
 #include "glog/logging.h"
 #include "paddle/phi/kernels/autotune/gpu_timer.h"
 #include "paddle/phi/kernels/autotune/switch_autotune.h"
@@ -285,6 +287,47 @@ MakeGatherGemmScatterTuner(ReturnType (*func)(T, T, Args...)) {
                                     Args...>::Instance(func);
 }
 
+// Wraps the launch of a kernel with one of its launch configs, so that the
+// configs are tuned like different kernels.
+class LaunchConfigCallback {
+ public:
+  explicit LaunchConfigCallback(std::function<void()> launch)
+      : launch_(std::move(launch)) {}
+
+  void Run() { launch_(); }
+
+ private:
+  std::function<void()> launch_;
+};
+
+// Tunes the launch configs of one kernel per shape. The candidates capture
+// the arguments of the call, so a tuner is built for each call, and the 1st
+// candidate is the heuristic config used when autotune is off. All the
+// candidates run on the real outputs while tuning, so each of them must
+// write the same outputs without reading them.
+template <typename T>
+class LaunchConfigAutoTuner : public AutoTuneBase<T, LaunchConfigCallback> {
+ public:
+  void AddCandidate(std::function<void()> launch) {
+    this->kernels_.emplace_back(std::move(launch));
+  }
+
+  size_t CandidateNum() const { return this->kernels_.size(); }
+
+  template <typename Context>
+  void Run(const Context& ctx, const AlgorithmType& algo, const size_t key) {
+    this->CheckKernelSize();
+    if (this->kernels_.size() == 1) {
+      this->kernels_[0].Run();
+      return;
+    }
+    // The number of candidates is a part of the key, so that a cached index
+    // always refers to the same candidate.
+    AutoTuneBase<T, LaunchConfigCallback>::Run(
+        ctx, algo, GenKey(key, this->kernels_.size()));
+  }
+};
+
 // Define the auto_tuner initial object.
 #define DEFINE_AUTOTUNER_COMMON_OBJ(name)                                \
   template <typename T, typename ReturnType, typename... Args>           \
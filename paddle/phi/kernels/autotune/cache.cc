@@ -14,12 +14,33 @@
 
 #include "paddle/phi/kernels/autotune/cache.h"
 
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 #include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#endif
 
 namespace phi::autotune {
 
+static constexpr char kAutoTuneCacheHeader[] = "paddle_autotune_cache";
+static constexpr int kAutoTuneCacheVersion = 3;
+// Bounds the vectors read from a file, so that a corrupted size fails the
+// record instead of allocating.
+static constexpr size_t kMaxRecordVectorSize = 1 << 16;
+
 size_t TransposeKey(const std::vector<int64_t>& x_dims,
                     const std::vector<int32_t>& perm,
                     phi::DataType dtype) {
@@ -36,6 +57,18 @@ std::string AlgorithmTypeString(int64_t algo_type) {
   } else if (algo_type ==
              static_cast<int64_t>(AlgorithmType::kConvBackwardFilter)) {
     return "conv_backward_filter";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kReduce)) {
+    return "reduce";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kSoftmax)) {
+    return "softmax";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kLayerNorm)) {
+    return "layer_norm";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kGather)) {
+    return "gather";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kSpmm)) {
+    return "spmm";
+  } else if (algo_type == static_cast<int64_t>(AlgorithmType::kSddmm)) {
+    return "sddmm";
   }
 #ifdef PADDLE_WITH_CUDNN_FRONTEND
   if (algo_type == static_cast<int64_t>(AlgorithmType::kConvForwardV8)) {
@@ -66,6 +99,322 @@ std::string AlgorithmTypeString(int64_t algo_type) {
   return std::to_string(algo_type);
 }
 
+std::string AutoTuneEnvironment() {
+  std::ostringstream ss;
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::backends::gpu::GetGPUDeviceCount() > 0) {
+    int id = phi::backends::gpu::GetCurrentDeviceId();
+    std::string name = phi::backends::gpu::GetDeviceProperties(id).name;
+    std::replace(name.begin(), name.end(), ' ', '_');
+    ss << name << " sm" << phi::backends::gpu::GetGPUComputeCapability(id)
+       << " driver" << phi::backends::gpu::GetGPUDriverVersion(id)
+       << " runtime" << phi::backends::gpu::GetGPURuntimeVersion(id)
+       << " dnn" << phi::backends::gpu::DnnVersion();
+  } else {
+    ss << "cpu";
+  }
+#else
+  ss << "cpu";
+#endif
+  ss << " size_t" << sizeof(size_t);
+  return ss.str();
+}
+
+namespace {
+
+template <typename T>
+void WriteVector(std::ostream* os, const std::vector<T>& vec) {
+  *os << " " << vec.size();
+  for (auto& v : vec) {
+    *os << " " << v;
+  }
+}
+
+template <typename T>
+bool ReadVector(std::istream* is, std::vector<T>* vec) {
+  size_t size = 0;
+  if (!(*is >> size) || size > kMaxRecordVectorSize) {
+    return false;
+  }
+  vec->resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (!(*is >> (*vec)[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string ConvKeyString(int64_t algo_type, const ConvCacheKey& key) {
+  std::ostringstream ss;
+  ss << "conv " << algo_type << " " << static_cast<int>(key.dtype) << " "
+     << key.groups << " " << key.data_layout;
+  WriteVector(&ss, key.x_dims);
+  WriteVector(&ss, key.w_dims);
+  WriteVector(&ss, key.strides);
+  WriteVector(&ss, key.paddings);
+  WriteVector(&ss, key.dilations);
+  return ss.str();
+}
+
+bool IsExhaustiveConvRecord(const std::pair<std::string, std::string>& rec) {
+  if (rec.first.compare(0, 5, "conv ") != 0) {
+    return false;
+  }
+  std::istringstream ss(rec.second);
+  int64_t algo = 0;
+  size_t workspace_size = 0;
+  bool exhaustive_search = false;
+  return (ss >> algo >> workspace_size >> exhaustive_search) &&
+         exhaustive_search;
+}
+
+// Each record is its key line, then the size of its value and the value,
+// since the json of a cudnn-frontend plan spans several lines.
+void WriteAutoTuneFile(const std::string& path,
+                       const std::string& env,
+                       const AutoTuneRecords& records) {
+  std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream fout(tmp_path, std::ios::binary);
+    PADDLE_ENFORCE_EQ(
+        fout.is_open(),
+        true,
+        common::errors::Unavailable(
+            "Cannot open %s to save the autotune results.", tmp_path));
+    fout << kAutoTuneCacheHeader << " " << kAutoTuneCacheVersion << "\n"
+         << env << "\n";
+    for (auto& record : records) {
+      fout << record.first << "\n"
+           << record.second.size() << "\n"
+           << record.second << "\n";
+    }
+    PADDLE_ENFORCE_EQ(
+        fout.good(),
+        true,
+        common::errors::Unavailable(
+            "Fail to write the autotune results to %s.", tmp_path));
+  }
+  PADDLE_ENFORCE_EQ(
+      std::rename(tmp_path.c_str(), path.c_str()),
+      0,
+      common::errors::Unavailable("Fail to rename %s to %s.", tmp_path, path));
+}
+
+bool ReadAutoTuneFile(const std::string& path,
+                      std::string* env,
+                      AutoTuneRecords* records) {
+  std::ifstream fin(path, std::ios::binary);
+  if (!fin.is_open()) {
+    VLOG(3) << "The autotune result file " << path << " does not exist";
+    return false;
+  }
+  std::string header;
+  int version = 0;
+  if (!(fin >> header >> version) || header != kAutoTuneCacheHeader ||
+      version != kAutoTuneCacheVersion) {
+    LOG(WARNING) << path << " is not an autotune result file of version "
+                 << kAutoTuneCacheVersion << ", ignore it";
+    return false;
+  }
+  fin.get();
+  std::getline(fin, *env);
+
+  AutoTuneRecords loaded;
+  std::string key;
+  bool corrupted = false;
+  while (!corrupted && std::getline(fin, key)) {
+    size_t size = 0;
+    corrupted = !(fin >> size) || fin.get() != '\n';
+    std::string value(corrupted ? 0 : size, '\0');
+    corrupted = corrupted || !fin.read(&value[0], size) || fin.get() != '\n';
+    if (!corrupted) {
+      loaded.emplace_back(std::move(key), std::move(value));
+    }
+  }
+  if (corrupted) {
+    LOG(WARNING) << "The autotune result file " << path
+                 << " is corrupted, ignore it";
+    return false;
+  }
+  *records = std::move(loaded);
+  return true;
+}
+
+}  // namespace
+
+AutoTuneRecords AutoTuneCache::ExportRecords() {
+  AutoTuneRecords records;
+  for (auto& v : auto_tune_map_) {
+    for (auto& entry : v.second.Entries()) {
+      records.emplace_back("algo " + std::to_string(v.first) + " " +
+                               std::to_string(entry.first),
+                           std::to_string(entry.second));
+    }
+  }
+  for (auto& entry : matmul_auto_tune_map_.Entries()) {
+    records.emplace_back("matmul " + std::to_string(entry.first),
+                         std::to_string(entry.second));
+  }
+  for (auto& v : conv_auto_tune_map_) {
+    for (auto& entry : v.second.Entries()) {
+      std::ostringstream value;
+      value << entry.second.algo << " " << entry.second.workspace_size << " "
+            << entry.second.exhaustive_search;
+      records.emplace_back(ConvKeyString(v.first, entry.first), value.str());
+    }
+  }
+#ifdef PADDLE_WITH_CUDNN_FRONTEND
+  for (auto& v : cudnn_v8_auto_tune_map_) {
+    for (auto& plan : v.second.SerializePlans()) {
+      std::ostringstream key;
+      key << "plan " << v.first;
+      WriteVector(&key, plan.first);
+      records.emplace_back(key.str(), plan.second);
+    }
+  }
+#endif
+  return records;
+}
+
+bool AutoTuneCache::ImportRecord(const std::string& key,
+                                 const std::string& value) {
+  std::istringstream key_ss(key);
+  std::istringstream value_ss(value);
+  std::string kind;
+  int64_t algo_type = 0;
+  key_ss >> kind;
+  if (kind == "matmul") {
+    size_t config_key = 0;
+    int64_t algo = 0;
+    if (!(key_ss >> config_key) || !(value_ss >> algo)) {
+      return false;
+    }
+    matmul_auto_tune_map_.SetIfAbsent(config_key, algo);
+    return true;
+  } else if (kind == "algo") {
+    size_t config_key = 0;
+    int64_t algo = 0;
+    if (!(key_ss >> algo_type >> config_key) || !(value_ss >> algo)) {
+      return false;
+    }
+    auto it = auto_tune_map_.find(algo_type);
+    if (it == auto_tune_map_.end()) {
+      return false;
+    }
+    it->second.SetIfAbsent(config_key, algo);
+    return true;
+  } else if (kind == "conv") {
+    int dtype = 0;
+    ConvCacheKey conv_key;
+    ConvAutoTuneResult result;
+    if (!(key_ss >> algo_type >> dtype >> conv_key.groups >>
+          conv_key.data_layout) ||
+        !ReadVector(&key_ss, &conv_key.x_dims) ||
+        !ReadVector(&key_ss, &conv_key.w_dims) ||
+        !ReadVector(&key_ss, &conv_key.strides) ||
+        !ReadVector(&key_ss, &conv_key.paddings) ||
+        !ReadVector(&key_ss, &conv_key.dilations) ||
+        !(value_ss >> result.algo >> result.workspace_size >>
+          result.exhaustive_search)) {
+      return false;
+    }
+    conv_key.dtype = static_cast<phi::DataType>(dtype);
+    auto it = conv_auto_tune_map_.find(algo_type);
+    if (it == conv_auto_tune_map_.end()) {
+      return false;
+    }
+    it->second.SetIfAbsent(conv_key, result);
+    return true;
+  }
+#ifdef PADDLE_WITH_CUDNN_FRONTEND
+  if (kind == "plan") {
+    cudnn_frontend::feature_vector_t feature;
+    if (!(key_ss >> algo_type) || !ReadVector(&key_ss, &feature)) {
+      return false;
+    }
+    auto it = cudnn_v8_auto_tune_map_.find(algo_type);
+    if (it == cudnn_v8_auto_tune_map_.end()) {
+      return false;
+    }
+    it->second.AddSerializedPlan(feature, value);
+    return true;
+  }
+#endif
+  return false;
+}
+
+void AutoTuneCache::Save(const std::string& path) {
+  AutoTuneRecords records = ExportRecords();
+  WriteAutoTuneFile(path, AutoTuneEnvironment(), records);
+  VLOG(3) << "Save " << records.size() << " autotune results to " << path;
+}
+
+bool AutoTuneCache::Load(const std::string& path) {
+  std::string env;
+  AutoTuneRecords records;
+  if (!ReadAutoTuneFile(path, &env, &records)) {
+    return false;
+  }
+  std::string current_env = AutoTuneEnvironment();
+  if (env != current_env) {
+    LOG(WARNING) << "The autotune results in " << path << " are tuned on "
+                 << env << ", ignore them on " << current_env;
+    return false;
+  }
+  // The records of the caches not built in, such as the cudnn-frontend
+  // plans, are skipped.
+  int64_t skipped = 0;
+  for (auto& record : records) {
+    if (!ImportRecord(record.first, record.second)) {
+      ++skipped;
+    }
+  }
+  VLOG(3) << "Load " << records.size() - skipped << " autotune results from "
+          << path << ", skip " << skipped;
+  return true;
+}
+
+void MergeAutoTuneCacheFiles(const std::vector<std::string>& inputs,
+                             const std::string& output) {
+  std::string merged_env;
+  AutoTuneRecords merged;
+  std::unordered_map<std::string, size_t> merged_index;
+  for (auto& input : inputs) {
+    std::string env;
+    AutoTuneRecords records;
+    if (!ReadAutoTuneFile(input, &env, &records)) {
+      LOG(WARNING) << "Skip the autotune result file " << input;
+      continue;
+    }
+    if (merged_env.empty()) {
+      merged_env = env;
+    } else if (env != merged_env) {
+      LOG(WARNING) << "Skip the autotune result file " << input
+                   << " tuned on " << env << ", the others are tuned on "
+                   << merged_env;
+      continue;
+    }
+    for (auto& record : records) {
+      auto it = merged_index.find(record.first);
+      if (it == merged_index.end()) {
+        merged_index.emplace(record.first, merged.size());
+        merged.emplace_back(std::move(record));
+      } else if (IsExhaustiveConvRecord(record) &&
+                 !IsExhaustiveConvRecord(merged[it->second])) {
+        merged[it->second].second = std::move(record.second);
+      }
+    }
+  }
+  PADDLE_ENFORCE_EQ(merged_env.empty(),
+                    false,
+                    common::errors::InvalidArgument(
+                        "None of the %d autotune result files can be read.",
+                        inputs.size()));
+  WriteAutoTuneFile(output, merged_env, merged);
+  VLOG(3) << "Merge " << merged.size() << " autotune results to " << output;
+}
+
 void AutoTuneCache::UpdateStatus() {
   int64_t size = 0;
   int64_t cache_hits = 0;
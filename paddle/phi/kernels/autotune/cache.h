@@ -16,6 +16,9 @@
 
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/kernels/autotune/cache_base.h"
@@ -39,6 +42,13 @@ size_t TransposeKey(const std::vector<int64_t>& x_dims,
                     const std::vector<int32_t>& perm,
                     phi::DataType dtype);
 
+// The device model, driver and library versions the results are tuned on,
+// a result file is only loaded on the same environment.
+std::string AutoTuneEnvironment();
+
+// Pairs of the serialized key and value of the cached results.
+using AutoTuneRecords = std::vector<std::pair<std::string, std::string>>;
+
 enum class AlgorithmType {
   kConvForward = 1,
   kConvBackwardData = 2,
@@ -49,21 +59,29 @@ enum class AlgorithmType {
   kGatherGemmScatterFP32NN = 7,
   kGatherGemmScatterFP32TN = 8,
   kGatherGemmScatterFP32NT = 9,
+  // The launch configs of the kernels below are tuned per shape.
+  kReduce = 10,
+  kSoftmax = 11,
+  kLayerNorm = 12,
+  kGather = 13,
+  // The native sparse kernels tuned against cuSPARSE per sparsity.
+  kSpmm = 14,
+  kSddmm = 15,
 #if !defined(PADDLE_WITH_CUDNN_FRONTEND)
-  kAlgorithmCount = 10
+  kAlgorithmCount = 16
 #else
-  kConvForwardV8 = 10,
-  kConvBackwardDataV8 = 11,
-  kConvBackwardFilterV8 = 12,
-  kScaleBiasReluConvBNstats = 13,
-  kBNFinalize = 14,
-  kScaleBiasAddRelu = 15,
-  kDgradDreluBnBwdWeight = 16,
-  kDbnApply = 17,
-  kBnActWgrad = 18,
-  kPoolingForwardV8 = 19,
-  kPoolingBackwardV8 = 20,
-  kAlgorithmCount = 21
+  kConvForwardV8 = 16,
+  kConvBackwardDataV8 = 17,
+  kConvBackwardFilterV8 = 18,
+  kScaleBiasReluConvBNstats = 19,
+  kBNFinalize = 20,
+  kScaleBiasAddRelu = 21,
+  kDgradDreluBnBwdWeight = 22,
+  kDbnApply = 23,
+  kBnActWgrad = 24,
+  kPoolingForwardV8 = 25,
+  kPoolingBackwardV8 = 26,
+  kAlgorithmCount = 27
 #endif
 };
 
@@ -151,6 +169,15 @@ class AutoTuneCache {
 
   void UpdateStatus();
 
+  // Writes the tuned results to path, so that the processes running on the
+  // same environment preload them instead of tuning again. The cublasLt
+  // descriptors of matmul are bound to the process and not saved.
+  void Save(const std::string& path);
+
+  // Returns false when the file does not exist, or it is tuned on another
+  // environment. The results tuned by this process are kept.
+  bool Load(const std::string& path);
+
   // The number of total config cached
   int64_t Size() const { return total_size_; }
 
@@ -169,6 +196,9 @@ class AutoTuneCache {
   }
 
  private:
+  AutoTuneRecords ExportRecords();
+  bool ImportRecord(const std::string& key, const std::string& value);
+
   AutoTuneCache() : autotune_cache_mutex_(new std::mutex()) {
     for (int i = 1; i < static_cast<int>(AlgorithmType::kAlgorithmCount); ++i) {
       Register(static_cast<AlgorithmType>(i));
@@ -215,5 +245,11 @@ class AutoTuneCache {
   int64_t total_size_{0};
 };
 
+// Merges the result files tuned on the same environment into output, the
+// files of other environments are skipped. For a key tuned by several files,
+// an exhaustive conv search wins, otherwise the first file wins.
+void MergeAutoTuneCacheFiles(const std::vector<std::string>& inputs,
+                             const std::string& output);
+
 }  // namespace autotune
 }  // namespace phi
@@ -16,6 +16,7 @@
 
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "paddle/common/errors.h"
@@ -153,6 +154,19 @@ class AlgorithmsCache {
 
   int64_t Size() const { return hash_.size(); }
 
+  // A copy of the entries, taken under the lock for serialization.
+  std::vector<std::pair<KeyT, AlgorithmT>> Entries() const {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    return std::vector<std::pair<KeyT, AlgorithmT>>(hash_.begin(),
+                                                    hash_.end());
+  }
+
+  // Inserts a loaded entry, the one tuned by this process wins.
+  void SetIfAbsent(const KeyT& key, AlgorithmT algo) {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    hash_.emplace(key, algo);
+  }
+
  protected:
   std::unordered_map<KeyT, AlgorithmT, HashT, KeyEqualT> hash_;
   std::shared_ptr<std::mutex> cache_mutex_;
@@ -61,6 +61,7 @@ class CudnnFrontendPlanCache {
     std::lock_guard<std::mutex> lock(*cache_mutex_);
     map_.clear();
     tracker_.clear();
+    serialized_plans_.clear();
     cache_hits_ = 0;
     cache_misses_ = 0;
   }
@@ -70,7 +71,9 @@ class CudnnFrontendPlanCache {
     bool ret = false;
     std::lock_guard<std::mutex> lock(*cache_mutex_);
     auto &local_map = map_[hasher(std::this_thread::get_id())];
-    if (local_map.count(GetExtendedFeature(feature, handle)) > 0) {
+    auto ext_feature = GetExtendedFeature(feature, handle);
+    if (local_map.count(ext_feature) > 0 ||
+        BuildSerializedPlan(feature, handle, &local_map)) {
       cache_hits_++;
       ret = true;
     } else {
@@ -79,6 +82,32 @@ class CudnnFrontendPlanCache {
     return ret;
   }
 
+  // The plans of all threads in their json form, keyed by the features
+  // without the handle, including the loaded plans not built yet.
+  std::map<cudnn_frontend::feature_vector_t, std::string> SerializePlans() {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    std::map<cudnn_frontend::feature_vector_t, std::string> plans =
+        serialized_plans_;
+#if CUDNN_VERSION >= 8400
+    for (auto &thread_map : map_) {
+      for (auto &pair : thread_map.second) {
+        cudnn_frontend::feature_vector_t feature(pair.first.begin(),
+                                                 pair.first.end() - 1);
+        plans.emplace(feature, pair.second.getJsonRepresentation());
+      }
+    }
+#endif
+    return plans;
+  }
+
+  // Records a plan loaded from a file, it is built on the first FindPlan
+  // of each thread and handle, since a plan is bound to its handle.
+  void AddSerializedPlan(const cudnn_frontend::feature_vector_t &feature,
+                         const std::string &json) {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    serialized_plans_.emplace(feature, json);
+  }
+
   void GetPlanAndWorkspaceSize(const cudnn_frontend::feature_vector_t &feature,
                                const cudnn_frontend::ExecutionPlan **plan,
                                int64_t *workspace_size,
@@ -163,6 +192,34 @@ class CudnnFrontendPlanCache {
   }
   using FeatureVectorToPlanMap =
       std::map<cudnn_frontend::feature_vector_t, cudnn_frontend::ExecutionPlan>;
+
+  // Called with the lock held.
+  bool BuildSerializedPlan(const cudnn_frontend::feature_vector_t &feature,
+                           cudnnHandle_t handle,
+                           FeatureVectorToPlanMap *local_map) {
+#if CUDNN_VERSION >= 8400
+    auto it = serialized_plans_.find(feature);
+    if (it == serialized_plans_.end()) {
+      return false;
+    }
+    try {
+      auto plan = cudnn_frontend::ExecutionPlanBuilder()
+                      .setHandle(handle)
+                      .loadFromJson(it->second)
+                      .build();
+      VLOG(4) << "[cudnn_frontend] cache: Build loaded plan: "
+              << plan.getTag();
+      local_map->insert(
+          std::make_pair(GetExtendedFeature(feature, handle), plan));
+      return true;
+    } catch (cudnn_frontend::cudnnException &e) {
+      VLOG(4) << "[cudnn_frontend] cache: Drop loaded plan: " << e.what();
+      serialized_plans_.erase(it);
+    }
+#endif
+    return false;
+  }
+
   std::map<std::size_t, FeatureVectorToPlanMap> map_;
   std::hash<std::thread::id> hasher;
 
@@ -172,6 +229,7 @@ class CudnnFrontendPlanCache {
   using SaturationTracker =
       std::map<std::pair<cudnn_frontend::feature_vector_t, std::string>, int>;
   std::map<std::size_t, SaturationTracker> tracker_;
+  std::map<cudnn_frontend::feature_vector_t, std::string> serialized_plans_;
 
   int64_t cache_hits_{0};
   int64_t cache_misses_{0};
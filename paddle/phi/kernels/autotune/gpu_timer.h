@@ -97,6 +97,15 @@ class GpuTimer {
 #endif
   }
 
+  // Returns whether the work recorded before Stop is done, without blocking.
+  bool IsStopped() {
+#ifdef PADDLE_WITH_HIP
+    return hipEventQuery(stop_) == hipSuccess;
+#else
+    return cudaEventQuery(stop_) == cudaSuccess;
+#endif
+  }
+
   float ElapsedTime() {
     float milliseconds = 0;
 #ifdef PADDLE_WITH_HIP
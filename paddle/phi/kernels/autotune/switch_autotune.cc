@@ -18,6 +18,7 @@
 #include "paddle/common/flags.h"
 
 COMMON_DECLARE_bool(use_autotune);
+COMMON_DECLARE_string(autotune_cache_file);
 
 namespace phi {
 namespace autotune {
@@ -33,11 +34,22 @@ void AutoTuneStatus::DisableAutoTune() {
   Init();
 }
 
+void AutoTuneStatus::LoadCacheFile() {
+  if (cache_file_loaded_ || !FLAGS_use_autotune ||
+      FLAGS_autotune_cache_file.empty()) {
+    return;
+  }
+  cache_file_loaded_ = true;
+  AutoTuneCache::Instance().Load(FLAGS_autotune_cache_file);
+}
+
 void AutoTuneStatus::Update() {
   current_steps_id_ += 1;
   if (!FLAGS_use_autotune) {
     return;
   }
+  // FLAGS_use_autotune may be set without calling EnableAutoTune.
+  LoadCacheFile();
 
   // This function is called when each iter finished.
   if (current_steps_id_ + 1 < start_step_id_) {
@@ -55,6 +67,10 @@ void AutoTuneStatus::Update() {
             << static_cast<int>(StepHitRate() * 100) << "%";
   } else {
     use_autotune_ = false;
+    if (current_steps_id_ + 1 == stop_step_id_ &&
+        !FLAGS_autotune_cache_file.empty()) {
+      AutoTuneCache::Instance().Save(FLAGS_autotune_cache_file);
+    }
     // Set a small tolerance to avoid performance degradation
     // due to large cache size under dynamic shape.
     // TODO(limingshu): Currently works for conv op only, this
@@ -85,9 +85,15 @@ class AutoTuneStatus {
     previous_misses_ = 0;
     step_hit_rates_.clear();
     AutoTuneCache::Instance().Clean();
+    cache_file_loaded_ = false;
+    LoadCacheFile();
   }
 
+  // Preloads FLAGS_autotune_cache_file once after the cache is cleaned.
+  void LoadCacheFile();
+
   bool use_autotune_{false};
+  bool cache_file_loaded_{false};
   int64_t start_step_id_{1};
   int64_t stop_step_id_{10};
   int64_t current_steps_id_{-1};
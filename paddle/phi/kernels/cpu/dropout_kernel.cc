@@ -14,11 +14,15 @@
 
 #include "paddle/phi/kernels/dropout_kernel.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/core/generator.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/kernels/expand_kernel.h"
 #include "paddle/phi/kernels/funcs/eigen/common.h"
+#include "paddle/phi/kernels/funcs/philox_engine.h"
+
+COMMON_DECLARE_bool(use_philox_cpu_random);
 
 namespace phi {
 
@@ -82,6 +86,28 @@ void DropoutRawKernel(const Context& dev_ctx,
     } else {
       seed_data = fix_seed ? seed : 0;
     }
+    if (FLAGS_use_philox_cpu_random) {
+      auto seed_counter = funcs::GetPhiloxSeedAndCounter<float>(
+          dev_ctx.GetGenerator(), seed_data, static_cast<int64_t>(size));
+      funcs::PhiloxForEachUniform<float>(
+          static_cast<int64_t>(size),
+          seed_counter.first,
+          seed_counter.second,
+          [&](int64_t i, float u) {
+            if (u < dropout_prob) {
+              mask_data[i] = 0;
+              y_data[i] = 0;
+            } else {
+              mask_data[i] = 1;
+              if (upscale_in_train) {
+                y_data[i] = x_data[i] / static_cast<T>(1.0f - dropout_prob);
+              } else {
+                y_data[i] = x_data[i];
+              }
+            }
+          });
+      return;
+    }
     std::shared_ptr<std::mt19937_64> engine;
     if (seed_data) {
       engine = std::make_shared<std::mt19937_64>();
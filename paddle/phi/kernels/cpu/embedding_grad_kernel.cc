@@ -17,6 +17,7 @@
 #include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/embedding_lookup.h"
 #include "paddle/phi/kernels/funcs/embedding_util.h"
 
 namespace phi {
@@ -57,37 +58,36 @@ struct EmbeddingGradCPUFunctor {
       dev_ctx_.template Alloc<T>(weight_grad_);
       auto* d_table_data = weight_grad_->data<T>();
 
-      memset(d_table_data, 0, weight_grad_->numel() * sizeof(T));
       for (int64_t i = 0; i < ids_num; ++i) {
         if (padding_idx_ != kNoPadding && ids_data[i] == padding_idx_) {
-          // the gradient of padding_idx should be 0, already done by memset, so
-          // do nothing.
-        } else {
-          PADDLE_ENFORCE_LT(
-              ids_data[i],
-              N,
-              common::errors::InvalidArgument(
-                  "Variable value (input) of "
-                  "OP(paddle.nn.functional.embedding) "
-                  "expected >= 0 and < %ld, but got %ld. Please check input "
-                  "value.",
-                  N,
-                  ids_data[i]));
-          PADDLE_ENFORCE_GE(
-              ids_data[i],
-              0,
-              common::errors::InvalidArgument(
-                  "Variable value (input) of "
-                  "OP(paddle.nn.functional.embedding) "
-                  "expected >= 0 and < %ld, but got %ld. Please check input "
-                  "value.",
-                  N,
-                  ids_data[i]));
-          for (int j = 0; j < D; ++j) {
-            d_table_data[ids_data[i] * D + j] += d_output_data[i * D + j];
-          }
+          continue;
         }
+        PADDLE_ENFORCE_LT(
+            ids_data[i],
+            N,
+            common::errors::InvalidArgument(
+                "Variable value (input) of "
+                "OP(paddle.nn.functional.embedding) "
+                "expected >= 0 and < %ld, but got %ld. Please check input "
+                "value.",
+                N,
+                ids_data[i]));
+        PADDLE_ENFORCE_GE(
+            ids_data[i],
+            0,
+            common::errors::InvalidArgument(
+                "Variable value (input) of "
+                "OP(paddle.nn.functional.embedding) "
+                "expected >= 0 and < %ld, but got %ld. Please check input "
+                "value.",
+                N,
+                ids_data[i]));
       }
+
+      // the gradient of padding_idx should be 0, which is done by memset.
+      memset(d_table_data, 0, weight_grad_->numel() * sizeof(T));
+      auto groups = funcs::GroupEmbeddingIds(ids, padding_idx_);
+      funcs::MergeEmbeddingRows(d_output_data, D, groups, true, d_table_data);
     }
   }
 
@@ -145,10 +145,25 @@ struct EmbeddingSparseGradCPUFunctor {
     // paddings makes no sense and we don't deal with it in backward.
     auto* d_table = weight_grad_;
     auto* d_output = &out_grad_;
-    d_table->set_rows(ids);
+    auto d_output_dims = d_output->dims();
+    auto d_output_dims_2d =
+        flatten_to_2d(d_output_dims, d_output_dims.size() - 1);
+    PADDLE_ENFORCE_EQ(d_output_dims_2d,
+                      common::make_ddim({ids_num, table_dim[1]}),
+                      common::errors::InvalidArgument(
+                          "ShapeError: The shape of output@Grad should be "
+                          "[%d, %d], but received output@Grad's shape = [%s].",
+                          ids_num,
+                          table_dim[1],
+                          d_output_dims_2d));
+
+    // The gradients of the duplicated ids are merged into one row.
+    auto groups = funcs::GroupEmbeddingIds(ids);
+    d_table->set_rows(groups.rows);
 
     auto* d_table_value = d_table->mutable_value();
-    d_table_value->Resize({ids_num, table_dim[1]});
+    d_table_value->Resize(
+        {static_cast<int64_t>(groups.rows.size()), table_dim[1]});
 
     dev_ctx_.template Alloc<T>(d_table_value);
 
@@ -156,20 +171,8 @@ struct EmbeddingSparseGradCPUFunctor {
 
     auto* d_output_data = d_output->template data<T>();
     auto* d_table_data = d_table_value->template data<T>();
-
-    auto d_output_dims = d_output->dims();
-    auto d_output_dims_2d =
-        flatten_to_2d(d_output_dims, d_output_dims.size() - 1);
-    PADDLE_ENFORCE_EQ(d_table_value->dims(),
-                      d_output_dims_2d,
-                      common::errors::InvalidArgument(
-                          "ShapeError: The shape of lookup_table@Grad and "
-                          "output@Grad should be same. "
-                          "But received lookup_table@Grad's shape = [%s], "
-                          "output@Grad's shape = [%s].",
-                          d_table_value->dims(),
-                          d_output_dims_2d));
-    memcpy(d_table_data, d_output_data, sizeof(T) * d_output->numel());
+    funcs::MergeEmbeddingRows(
+        d_output_data, table_dim[1], groups, false, d_table_data);
   }
 
  private:
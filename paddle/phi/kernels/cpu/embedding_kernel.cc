@@ -18,6 +18,7 @@
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/embedding_lookup.h"
 #include "paddle/phi/kernels/funcs/embedding_util.h"
 #include "paddle/phi/kernels/p_norm_kernel.h"
 
@@ -72,19 +73,7 @@ struct EmbeddingCPUFunctor {
       }
     }
 
-#if defined(_OPENMP) && !defined(PADDLE_WITH_CUDA)
-#pragma omp parallel for
-#endif
-
-    for (int64_t i = 0; i < ids_numel; ++i) {
-      if (padding_idx_ != kNoPadding && ids[i] == padding_idx_) {
-        memset(output + i * row_width, 0, row_width * sizeof(T));
-      } else {
-        memcpy(output + i * row_width,
-               table + ids[i] * row_width,
-               row_width * sizeof(T));
-      }
-    }
+    funcs::EmbeddingLookupRows(table, row_width, ids, padding_idx_, output);
   }
 
  private:
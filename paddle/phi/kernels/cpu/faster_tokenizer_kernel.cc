@@ -43,10 +43,35 @@ inline bool IsWhiteSpace(const wchar_t& ch);
 
 using InvVocab = unordered_map<int, wstring>;
 
+// A token of BasicTokenizer, as a range of the normalized text.
+struct TokenSpan {
+  size_t begin;
+  size_t len;
+};
+
+// The buffers of a tokenizing thread. They are reused across the texts, so
+// that the tokens are not allocated one by one.
+struct TokenizerWorkspace {
+  wstring normalized;
+  vector<TokenSpan> tokens;
+  // The vocab key looked up, e.g. a wordpiece with its "##" prefix.
+  wstring key;
+  vector<int64_t> ids;
+  vector<int64_t> pair_ids;
+};
+
+struct Encoding {
+  vector<int64_t> input_ids;
+  vector<int64_t> token_type_ids;
+};
+
 class BasicTokenizer {
  public:
   explicit BasicTokenizer(bool do_lower_case = true);
-  void Tokenize(const string& text, vector<wstring>* res) const;
+  // Normalizes text into normalized, and splits it into tokens.
+  void Tokenize(const string& text,
+                wstring* normalized,
+                vector<TokenSpan>* tokens) const;
 
  private:
   wchar_t do_lower_case(wchar_t ch) const;
@@ -59,7 +84,10 @@ class WordPieceTokenizer {
   explicit WordPieceTokenizer(const phi::Vocab* vocab,
                               const wstring& unk_token = L"[UNK]",
                               const size_t max_input_chars_per_word = 100);
-  void Tokenize(const wstring& text, vector<int64_t>* output) const;
+  void Tokenize(const wchar_t* text,
+                size_t len,
+                wstring* key,
+                vector<int64_t>* token_ids) const;
 
  private:
   const phi::Vocab* vocab_;
@@ -79,7 +107,9 @@ class BertTokenizer {
                          const wstring& sep_token = L"[SEP]",
                          const string& padding_site = "right");
 
-  void Tokenize(const string& text, vector<int64_t>* split_tokens) const;
+  void Tokenize(const string& text,
+                vector<int64_t>* split_tokens,
+                TokenizerWorkspace* workspace) const;
   void BuildInputsWithSpecialTokens(
       vector<int64_t>* res,
       const vector<int64_t>& token_ids_0,
@@ -93,14 +123,15 @@ class BertTokenizer {
                         const size_t num_tokens_to_remove = 0,
                         const size_t stride = 0) const;
   int64_t GetNumSpecialTokensToAdd(const bool pair = false) const;
-  int Encode(unordered_map<string, vector<int64_t>>* encoded_inputs,
+  int Encode(Encoding* encoded_inputs,
+             TokenizerWorkspace* workspace,
              const string& text,
              const string& text_pair = "",
              bool is_split_into_words = false,
              const size_t max_seq_len = 0,
              bool pad_to_max_seq_len = false) const;
   void BatchEncode(
-      vector<unordered_map<string, vector<int64_t>>>* batch_encode_inputs,
+      vector<Encoding>* batch_encode_inputs,
       const Strings& batch_text,
       const Strings& batch_text_pair = Strings(),
       bool is_split_into_words = false,
@@ -125,8 +156,10 @@ class BertTokenizer {
 
 const wstring kStripChars = L" \t\n\r\v\f";
 
+// The ASCII characters are classified without utf8proc.
 inline bool IsControl(const wchar_t& ch) {
   if (ch == L'\t' || ch == L'\n' || ch == L'\r') return false;
+  if (ch < 0x80) return ch < 0x20 || ch == 0x7F;
   auto cat = utf8proc_category(ch);
   if (cat == UTF8PROC_CATEGORY_CC || cat == UTF8PROC_CATEGORY_CF) return true;
   return false;
@@ -143,6 +176,7 @@ inline bool IsChineseChar(const wchar_t& ch) {
 
 inline bool IsWhiteSpace(const wchar_t& ch) {
   if (ch == L' ' || ch == L'\t' || ch == L'\n' || ch == L'\r') return true;
+  if (ch < 0x80) return false;
   auto cat = utf8proc_category(ch);
   if (cat == UTF8PROC_CATEGORY_ZS) return true;
   return false;
@@ -152,6 +186,7 @@ inline bool IsPunctuation(const wchar_t& ch) {
   if ((ch >= 33 && ch <= 47) || (ch >= 58 && ch <= 64) ||
       (ch >= 91 && ch <= 96) || (ch >= 123 && ch <= 126))
     return true;
+  if (ch < 0x80) return false;
   auto cat = utf8proc_category(ch);
   if (cat == UTF8PROC_CATEGORY_PD || cat == UTF8PROC_CATEGORY_PS ||
       cat == UTF8PROC_CATEGORY_PE || cat == UTF8PROC_CATEGORY_PC ||
@@ -165,25 +200,35 @@ BasicTokenizer::BasicTokenizer(bool do_lower_case /* = true */)
     : do_lower_case_(do_lower_case) {}
 
 wchar_t BasicTokenizer::do_lower_case(wchar_t ch) const {
+  if (ch < 0x80) {
+    return ch >= L'A' && ch <= L'Z' ? ch + (L'a' - L'A') : ch;
+  }
   wchar_t new_ch = utf8proc_tolower(ch);
   return new_ch;
 }
 
-void BasicTokenizer::Tokenize(const string& text, vector<wstring>* res) const {
-  std::wstring unicode_text;
-  bool status = phi::ConvertStrToWstr(text, &unicode_text);
+void BasicTokenizer::Tokenize(const string& text,
+                              wstring* normalized,
+                              vector<TokenSpan>* tokens) const {
+  tokens->clear();
+  bool status = phi::ConvertStrToWstr(text, normalized);
   if (!status) {
     // String is converted into wstring failedly.
+    normalized->clear();
     return;
   }
-  std::wstring cache_text = L"";
-  auto PushCacheText = [&]() {
-    if (!cache_text.empty()) {
-      res->emplace_back(cache_text);
-      cache_text = L"";
+  // The kept characters are moved to the front of normalized in place, the
+  // tokens are ranges of them.
+  size_t size = 0;
+  size_t token_begin = 0;
+  auto PushToken = [&]() {
+    if (size > token_begin) {
+      tokens->push_back({token_begin, size - token_begin});
     }
+    token_begin = size;
   };
-  for (auto& ch : unicode_text) {
+  for (size_t i = 0; i < normalized->size(); ++i) {
+    wchar_t ch = (*normalized)[i];
     if (ch == 0 || ch == 0xfffd || IsControl(ch)) {
       continue;
     }
@@ -191,15 +236,17 @@ void BasicTokenizer::Tokenize(const string& text, vector<wstring>* res) const {
       ch = do_lower_case(ch);
     }
     if (IsChineseChar(ch) || IsPunctuation(ch)) {
-      PushCacheText();
-      res->emplace_back(std::wstring{ch});
+      PushToken();
+      (*normalized)[size++] = ch;
+      PushToken();
     } else if (IsWhiteSpace(ch)) {
-      PushCacheText();
+      PushToken();
     } else {
-      cache_text += ch;
+      (*normalized)[size++] = ch;
     }
   }
-  PushCacheText();
+  PushToken();
+  normalized->resize(size);
 }
 
 WordPieceTokenizer::WordPieceTokenizer(
@@ -212,50 +259,50 @@ WordPieceTokenizer::WordPieceTokenizer(
   unk_token_id_ = vocab_->at(unk_token_);
 }
 
-void WordPieceTokenizer::Tokenize(const wstring& text,
+void WordPieceTokenizer::Tokenize(const wchar_t* text,
+                                  size_t len,
+                                  wstring* key,
                                   vector<int64_t>* token_ids) const {
-  size_t len = text.size();
   if (len > max_input_chars_per_word_) {
     token_ids->emplace_back(unk_token_id_);
     return;
   }
 
-  auto it = vocab_->find(text);
+  key->assign(text, len);
+  auto it = vocab_->find(*key);
   if (it != vocab_->end()) {
     token_ids->emplace_back(it->second);
     return;
   }
 
+  // The wordpieces are appended to token_ids, and dropped for the unknown
+  // token if the word can not be split.
+  const size_t num_token_ids = token_ids->size();
   size_t start = 0;
-  vector<int64_t> wordpiece_ids;
   while (start < len) {
     size_t end = len;
-    std::wstring cur_substr;
-    int64_t cur_substr_id = 0;
+    bool found = false;
     while (start < end) {
-      std::wstring sub = text.substr(start, end - start);
+      key->clear();
       if (start > 0) {
-        sub.insert(0, L"##");
+        key->append(L"##");
       }
-      auto it = vocab_->find(sub);
+      key->append(text + start, end - start);
+      auto it = vocab_->find(*key);
       if (it != vocab_->end()) {
-        cur_substr = sub;
-        cur_substr_id = it->second;
+        token_ids->emplace_back(it->second);
+        found = true;
         break;
       }
       end -= 1;
     }
 
-    if (cur_substr.empty()) {
+    if (!found) {
+      token_ids->resize(num_token_ids);
       token_ids->emplace_back(unk_token_id_);
       return;
-    } else {
-      start = end;
-      wordpiece_ids.emplace_back(cur_substr_id);
     }
-  }
-  for (auto& token_id : wordpiece_ids) {
-    token_ids->emplace_back(token_id);
+    start = end;
   }
 }
 
@@ -293,28 +340,25 @@ BertTokenizer::BertTokenizer(const phi::Vocab* vocab,
 }
 
 void BertTokenizer::Tokenize(const string& text,
-                             vector<int64_t>* split_token_ids) const {
-  std::vector<std::wstring> tmp_tokens;
-  basic_tokenizer_.Tokenize(text, &tmp_tokens);
-  if (tmp_tokens.empty()) return;
-  split_token_ids->reserve(tmp_tokens.size());
-  for (auto& w_token : tmp_tokens) {
-    const auto& vec_size = w_token.size();
-    if (vec_size == 1) {
-      if (IsChineseChar(w_token[0])) {
-        auto vocab_it = vocab_->find(w_token);
-        if (vocab_it != vocab_->end()) {
-          split_token_ids->emplace_back(vocab_it->second);
-        } else {
-          split_token_ids->emplace_back(unk_token_id_);
-        }
+                             vector<int64_t>* split_token_ids,
+                             TokenizerWorkspace* workspace) const {
+  const wstring& normalized = workspace->normalized;
+  basic_tokenizer_.Tokenize(text, &workspace->normalized, &workspace->tokens);
+  if (workspace->tokens.empty()) return;
+  split_token_ids->reserve(workspace->tokens.size());
+  for (const auto& token : workspace->tokens) {
+    const wchar_t* w_token = normalized.data() + token.begin;
+    if (token.len == 1 && IsChineseChar(w_token[0])) {
+      workspace->key.assign(1, w_token[0]);
+      auto vocab_it = vocab_->find(workspace->key);
+      if (vocab_it != vocab_->end()) {
+        split_token_ids->emplace_back(vocab_it->second);
       } else {
-        word_piece_tokenizer_.Tokenize(w_token, split_token_ids);
+        split_token_ids->emplace_back(unk_token_id_);
       }
-    } else if (vec_size > 1) {
-      word_piece_tokenizer_.Tokenize(w_token, split_token_ids);
     } else {
-      continue;
+      word_piece_tokenizer_.Tokenize(
+          w_token, token.len, &workspace->key, split_token_ids);
     }
   }
 }
@@ -393,29 +437,33 @@ void BertTokenizer::TruncateSequence(
 int64_t BertTokenizer::GetPadTokenID() const { return pad_token_id_; }
 
 int BertTokenizer::Encode(
-    unordered_map<string, vector<int64_t>>* encoded_inputs,
+    Encoding* encoded_inputs,
+    TokenizerWorkspace* workspace,
     const string& text,
     const string& text_pair /* = "" */,
     bool is_split_into_words /* = false */,
     const size_t max_seq_len /* = 0 */,
     bool pad_to_max_seq_len /* = false */) const {
-  vector<int64_t> ids;
-  vector<int64_t> pair_ids;
+  vector<int64_t>& ids = workspace->ids;
+  vector<int64_t>& pair_ids = workspace->pair_ids;
+  ids.clear();
+  pair_ids.clear();
   if (!is_split_into_words) {
-    Tokenize(text, &ids);
+    Tokenize(text, &ids, workspace);
     if (ids.empty()) return 0;
     if (!text_pair.empty()) {
-      Tokenize(text_pair, &pair_ids);
+      Tokenize(text_pair, &pair_ids, workspace);
       if (pair_ids.empty()) return 0;
     }
   } else {
-    std::wstring unicode_text;
+    std::wstring& unicode_text = workspace->normalized;
     bool status_a = phi::ConvertStrToWstr(text, &unicode_text);
     if (!status_a) {
       return 0;
     }
     for (size_t i = 0; i < unicode_text.size(); i++) {
-      wstring token = unicode_text.substr(i, 1);
+      wstring& token = workspace->key;
+      token.assign(1, unicode_text[i]);
       auto it = vocab_->find(token);
       if (it != vocab_->end()) {
         ids.emplace_back(it->second);
@@ -444,15 +492,11 @@ int BertTokenizer::Encode(
   }
 
   // Add special tokens
-  vector<int64_t> sequence;
-  BuildInputsWithSpecialTokens(&sequence, ids, pair_ids);
-  size_t seq_len = sequence.size();
-  vector<int64_t> token_type_ids;
-  CreateTokenTypeIdsFromSequences(&token_type_ids, ids, pair_ids);
+  BuildInputsWithSpecialTokens(&encoded_inputs->input_ids, ids, pair_ids);
+  size_t seq_len = encoded_inputs->input_ids.size();
+  CreateTokenTypeIdsFromSequences(
+      &encoded_inputs->token_type_ids, ids, pair_ids);
 
-  // Build output dictionary
-  encoded_inputs->emplace("input_ids", sequence);
-  encoded_inputs->emplace("token_type_ids", token_type_ids);
   // Check lengths
   if (max_seq_len > 0 && seq_len > max_seq_len) {
     VLOG(3) << "There is something wrong with the input sequence length."
@@ -470,21 +514,21 @@ int BertTokenizer::Encode(
   if (needs_to_be_padded) {
     int64_t difference = static_cast<int64_t>(max_seq_len - seq_len);
     size_t pad_start = max_seq_len - 1 - difference;
-    encoded_inputs->at("token_type_ids").resize(max_seq_len);
+    encoded_inputs->token_type_ids.resize(max_seq_len);
     for (size_t i = max_seq_len - 1; i > pad_start; i--) {
-      encoded_inputs->at("token_type_ids")[i] = pad_token_id_;
+      encoded_inputs->token_type_ids[i] = pad_token_id_;
     }
 
-    encoded_inputs->at("input_ids").resize(max_seq_len);
+    encoded_inputs->input_ids.resize(max_seq_len);
     for (size_t i = max_seq_len - 1; i > pad_start; i--) {
-      encoded_inputs->at("input_ids")[i] = pad_token_id_;
+      encoded_inputs->input_ids[i] = pad_token_id_;
     }
   }
   return 1;
 }
 
 void BertTokenizer::BatchEncode(
-    vector<unordered_map<string, vector<int64_t>>>* batch_encode_inputs,
+    vector<Encoding>* batch_encode_inputs,
     const Strings& batch_text,
     const Strings& batch_text_pair /* = vector<string>() */,
     bool is_split_into_words /* = false */,
@@ -497,36 +541,42 @@ void BertTokenizer::BatchEncode(
 
   size_t batch_size = batch_text.size();
 #ifdef PADDLE_WITH_MKLML
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-  for (size_t i = 0; i < batch_size; i++) {
-    unordered_map<string, vector<int64_t>> res;
-    if (has_text_pair) {
-      auto status = Encode(&res,
-                           batch_text[i],
-                           batch_text_pair[i],
-                           is_split_into_words,
-                           max_seq_len,
-                           pad_to_max_seq_len);
-      if (!status) {
-        res["input_ids"] =
-            std::vector<int64_t>{cls_token_id_, sep_token_id_, cls_token_id_};
-        res["token_type_ids"] = std::vector<int64_t>{0, 0, 1};
-      }
-    } else {
-      auto status = Encode(&res,
-                           batch_text[i],
-                           {},
-                           is_split_into_words,
-                           max_seq_len,
-                           pad_to_max_seq_len);
-
-      if (!status) {
-        res["input_ids"] = std::vector<int64_t>{cls_token_id_, sep_token_id_};
-        res["token_type_ids"] = std::vector<int64_t>{0, 0};
+  {
+    TokenizerWorkspace workspace;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp for
+#endif
+    for (size_t i = 0; i < batch_size; i++) {
+      Encoding& res = batch_encode_inputs->at(i);
+      if (has_text_pair) {
+        auto status = Encode(&res,
+                             &workspace,
+                             batch_text[i],
+                             batch_text_pair[i],
+                             is_split_into_words,
+                             max_seq_len,
+                             pad_to_max_seq_len);
+        if (!status) {
+          res.input_ids = {cls_token_id_, sep_token_id_, cls_token_id_};
+          res.token_type_ids = {0, 0, 1};
+        }
+      } else {
+        auto status = Encode(&res,
+                             &workspace,
+                             batch_text[i],
+                             {},
+                             is_split_into_words,
+                             max_seq_len,
+                             pad_to_max_seq_len);
+
+        if (!status) {
+          res.input_ids = {cls_token_id_, sep_token_id_};
+          res.token_type_ids = {0, 0};
+        }
       }
     }
-    batch_encode_inputs->at(i) = std::move(res);
   }
 }
 
@@ -556,8 +606,7 @@ void FasterTokenizerKernel(const Context& dev_ctx,
   size_t batch_max_seq_len = 0;
   size_t batch_size = text->size();
 
-  vector<unordered_map<string, vector<int64_t>>> batch_encode_inputs(
-      batch_size);
+  vector<Encoding> batch_encode_inputs(batch_size);
   if (text_pair) {
     tokenizer.BatchEncode(&batch_encode_inputs,
                           *text,
@@ -575,7 +624,7 @@ void FasterTokenizerKernel(const Context& dev_ctx,
   }
 
   for (size_t i = 0; i < batch_size; ++i) {
-    size_t seq_len = batch_encode_inputs[i]["input_ids"].size();
+    size_t seq_len = batch_encode_inputs[i].input_ids.size();
     if (seq_len > batch_max_seq_len) {
       batch_max_seq_len = seq_len;
     }
@@ -591,8 +640,8 @@ void FasterTokenizerKernel(const Context& dev_ctx,
 
   auto pad_token_id = tokenizer.GetPadTokenID();
   for (size_t i = 0; i < batch_size; i++) {
-    auto& encoder_input_ids = batch_encode_inputs[i]["input_ids"];
-    auto& encoder_seg_ids = batch_encode_inputs[i]["token_type_ids"];
+    auto& encoder_input_ids = batch_encode_inputs[i].input_ids;
+    auto& encoder_seg_ids = batch_encode_inputs[i].token_type_ids;
     const size_t& seq_len = encoder_input_ids.size();
     // Copy the memory
     std::memcpy(input_ids_data + i * batch_max_seq_len,
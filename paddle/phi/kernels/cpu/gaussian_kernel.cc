@@ -14,11 +14,50 @@
 
 #include "paddle/phi/kernels/gaussian_kernel.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/kernels/funcs/norm_distribution.h"
+#include "paddle/phi/kernels/funcs/philox_engine.h"
+
+COMMON_DECLARE_bool(use_philox_cpu_random);
 
 namespace phi {
 
+template <typename T>
+static bool PhiloxNormalFill(Generator* gen,
+                             T* data,
+                             int64_t size,
+                             float mean,
+                             float std,
+                             int seed) {
+  if (!FLAGS_use_philox_cpu_random) {
+    return false;
+  }
+  auto seed_counter = funcs::GetPhiloxSeedAndCounter<T>(gen, seed, size);
+  funcs::PhiloxNormalDistribution<T>(
+      data, size, mean, std, seed_counter.first, seed_counter.second);
+  return true;
+}
+
+// The complex numbers keep using the engine of the generator.
+static bool PhiloxNormalFill(Generator* gen UNUSED,
+                             phi::dtype::complex<float>* data UNUSED,
+                             int64_t size UNUSED,
+                             float mean UNUSED,
+                             float std UNUSED,
+                             int seed UNUSED) {
+  return false;
+}
+
+static bool PhiloxNormalFill(Generator* gen UNUSED,
+                             phi::dtype::complex<double>* data UNUSED,
+                             int64_t size UNUSED,
+                             float mean UNUSED,
+                             float std UNUSED,
+                             int seed UNUSED) {
+  return false;
+}
+
 template <typename T, typename Context>
 void GaussianKernel(const Context& dev_ctx,
                     const IntArray& shape,
@@ -30,6 +69,9 @@ void GaussianKernel(const Context& dev_ctx,
   out->Resize(common::make_ddim(shape.GetData()));
   int64_t size = out->numel();
   T* data = dev_ctx.template Alloc<T>(out);
+  if (PhiloxNormalFill(dev_ctx.GetGenerator(), data, size, mean, std, seed)) {
+    return;
+  }
   std::shared_ptr<std::mt19937_64> engine;
   if (seed) {
     engine = std::make_shared<std::mt19937_64>();
@@ -50,6 +92,9 @@ void GaussianInplaceKernel(const Context& dev_ctx,
   T* data = dev_ctx.template Alloc<T>(out);
 
   int64_t size = out->numel();
+  if (PhiloxNormalFill(dev_ctx.GetGenerator(), data, size, mean, std, seed)) {
+    return;
+  }
   std::shared_ptr<std::mt19937_64> engine;
   if (seed) {
     engine = std::make_shared<std::mt19937_64>();
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/merged_sgd_kernel.h"
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/sgd_kernel.h"
+
+namespace phi {
+
+template <typename T, typename Context>
+void MergedSGDKernel(
+    const Context& dev_ctx,
+    const std::vector<const DenseTensor*>& param,
+    const DenseTensor& learning_rate,
+    const std::vector<const DenseTensor*>& grad,
+    const paddle::optional<std::vector<const DenseTensor*>>& master_param
+        UNUSED,
+    bool multi_precision UNUSED,
+    std::vector<DenseTensor*> param_out,
+    std::vector<DenseTensor*> master_param_out UNUSED) {
+  PADDLE_ENFORCE_EQ(
+      param.size(),
+      grad.size(),
+      common::errors::InvalidArgument(
+          "The size of Input(Param) and Input(Grad) of merged_sgd should be "
+          "equal, but received %d and %d.",
+          param.size(),
+          grad.size()));
+  // There is no launch overhead to save on CPU, each parameter runs the jit
+  // sgd kernel of sgd_.
+  for (size_t i = 0; i < param.size(); ++i) {
+    SGDDenseKernel<T, Context>(dev_ctx,
+                               *param[i],
+                               learning_rate,
+                               *grad[i],
+                               paddle::none,
+                               false,
+                               param_out[i],
+                               nullptr);
+  }
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(merged_sgd,
+                   CPU,
+                   ALL_LAYOUT,
+                   phi::MergedSGDKernel,
+                   phi::dtype::bfloat16,
+                   float,
+                   double) {}
@@ -0,0 +1,201 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The strided kernels of the elementwise operators and of cast read their
+// inputs through the strides, so that a view, e.g. of transpose or slice, is
+// not copied to a contiguous tensor first. The output is contiguous.
+
+#include <array>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/core/visit_type.h"
+#include "paddle/phi/kernels/cast_kernel.h"
+#include "paddle/phi/kernels/elementwise_add_kernel.h"
+#include "paddle/phi/kernels/elementwise_divide_kernel.h"
+#include "paddle/phi/kernels/elementwise_multiply_kernel.h"
+#include "paddle/phi/kernels/elementwise_subtract_kernel.h"
+#include "paddle/phi/kernels/funcs/elementwise_functor.h"
+#include "paddle/phi/kernels/funcs/strided_utils.h"
+
+COMMON_DECLARE_bool(use_stride_kernel);
+
+namespace phi {
+
+namespace {
+
+// Calls func with the offsets of the N inputs at each element of dims, in
+// order. The offsets are moved by the strides as the index is incremented,
+// instead of being computed from the index each time.
+template <size_t N, typename Func>
+void ForEachStridedOffset(const DDim& dims,
+                          const std::array<std::vector<int64_t>, N>& strides,
+                          Func func) {
+  int rank = dims.size();
+  int64_t numel = product(dims);
+  std::vector<int64_t> index(rank, 0);
+  std::array<int64_t, N> offsets{};
+  for (int64_t i = 0; i < numel; ++i) {
+    func(i, offsets);
+    for (int d = rank - 1; d >= 0; --d) {
+      ++index[d];
+      for (size_t k = 0; k < N; ++k) {
+        offsets[k] += strides[k][d];
+      }
+      if (index[d] < dims[d]) {
+        break;
+      }
+      for (size_t k = 0; k < N; ++k) {
+        offsets[k] -= strides[k][d] * dims[d];
+      }
+      index[d] = 0;
+    }
+  }
+}
+
+template <typename T, typename Functor>
+void StridedBinaryCompute(const CPUContext& dev_ctx,
+                          const DenseTensor& x,
+                          const DenseTensor& y,
+                          Functor func,
+                          DenseTensor* out) {
+  T* out_data = dev_ctx.Alloc<T>(out);
+  if (out->numel() == 0) {
+    return;
+  }
+  const T* x_data = x.data<T>();
+  const T* y_data = y.data<T>();
+  const DDim& dims = out->dims();
+  ForEachStridedOffset<2>(
+      dims,
+      {BroadcastStrides(x, dims), BroadcastStrides(y, dims)},
+      [&](int64_t i, const std::array<int64_t, 2>& offsets) {
+        out_data[i] = func(x_data[offsets[0]], y_data[offsets[1]]);
+      });
+}
+
+template <typename InT, typename OutT>
+void StridedCastCompute(const CPUContext& dev_ctx,
+                        const DenseTensor& x,
+                        DenseTensor* out) {
+  OutT* out_data = dev_ctx.Alloc<OutT>(out);
+  if (out->numel() == 0) {
+    return;
+  }
+  const InT* x_data = x.data<InT>();
+  ForEachStridedOffset<1>(
+      x.dims(),
+      {common::vectorize<int64_t>(x.strides())},
+      [&](int64_t i, const std::array<int64_t, 1>& offsets) {
+        out_data[i] = static_cast<OutT>(x_data[offsets[0]]);
+      });
+}
+
+void CheckStrideKernelEnabled() {
+  if (!FLAGS_use_stride_kernel) {
+    PADDLE_THROW(common::errors::Fatal(
+        "FLAGS_use_stride_kernel is closed. Strided kernel "
+        "be called, something wrong has happened!"));
+  }
+}
+
+}  // namespace
+
+#define DEFINE_CPU_STRIDED_BINARY_KERNEL(name, functor)               \
+  template <typename T, typename Context>                             \
+  void name##StridedKernel(const Context& dev_ctx,                    \
+                           const DenseTensor& x,                      \
+                           const DenseTensor& y,                      \
+                           DenseTensor* out) {                        \
+    CheckStrideKernelEnabled();                                       \
+    if (x.meta().is_contiguous() && y.meta().is_contiguous()) {       \
+      name##Kernel<T, Context>(dev_ctx, x, y, out);                   \
+      return;                                                         \
+    }                                                                 \
+    StridedBinaryCompute<T>(dev_ctx, x, y, funcs::functor<T>(), out); \
+  }
+
+DEFINE_CPU_STRIDED_BINARY_KERNEL(Add, AddFunctor)
+DEFINE_CPU_STRIDED_BINARY_KERNEL(Subtract, SubtractFunctor)
+DEFINE_CPU_STRIDED_BINARY_KERNEL(Multiply, MultiplyFunctor)
+DEFINE_CPU_STRIDED_BINARY_KERNEL(Divide, DivideFunctor)
+
+template <typename T, typename Context>
+void CastStridedKernel(const Context& dev_ctx,
+                       const DenseTensor& x,
+                       DataType out_dtype,
+                       DenseTensor* out) {
+  CheckStrideKernelEnabled();
+  if (x.meta().is_contiguous()) {
+    CastKernel<T, Context>(dev_ctx, x, out_dtype, out);
+    return;
+  }
+  PD_VISIT_ALL_TYPES(out_dtype, "CastStridedKernel", ([&] {
+                       StridedCastCompute<T, data_t>(dev_ctx, x, out);
+                     }));
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(add,
+                   CPU,
+                   STRIDED,
+                   phi::AddStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t) {}
+
+PD_REGISTER_KERNEL(subtract,
+                   CPU,
+                   STRIDED,
+                   phi::SubtractStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t) {}
+
+PD_REGISTER_KERNEL(multiply,
+                   CPU,
+                   STRIDED,
+                   phi::MultiplyStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t) {}
+
+PD_REGISTER_KERNEL(divide,
+                   CPU,
+                   STRIDED,
+                   phi::DivideStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t) {}
+
+PD_REGISTER_KERNEL(cast,
+                   CPU,
+                   STRIDED,
+                   phi::CastStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   bool,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->OutputAt(0).SetDataType(phi::DataType::UNDEFINED);
+}
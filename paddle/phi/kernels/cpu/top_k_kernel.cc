@@ -14,17 +14,63 @@
 
 #include "paddle/phi/kernels/top_k_kernel.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/core/kernel_registry.h"
-#include "paddle/phi/kernels/funcs/eigen/common.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 
 namespace phi {
 
+// Whether l comes before r in the top k, NaN being the largest value.
+template <typename T, typename Type>
+static inline bool TopKBefore(const std::pair<T, Type>& l,
+                              const std::pair<T, Type>& r,
+                              bool largest) {
+  if (largest) {
+    return (std::isnan(static_cast<double>(l.first)) &&
+            !std::isnan(static_cast<double>(r.first))) ||
+           (l.first > r.first);
+  } else {
+    return (!std::isnan(static_cast<double>(l.first)) &&
+            std::isnan(static_cast<double>(r.first))) ||
+           (l.first < r.first);
+  }
+}
+
+// Keeps the best k of a row in a heap whose top is the worst of them, so
+// only the row itself is read and nothing of its size is allocated.
+template <typename T, typename Type>
+static void HeapTopK(const T* row,
+                     Type width,
+                     int k,
+                     bool largest,
+                     std::vector<std::pair<T, Type>>* heap) {
+  auto before = [largest](const std::pair<T, Type>& l,
+                          const std::pair<T, Type>& r) {
+    return TopKBefore(l, r, largest);
+  };
+  heap->clear();
+  for (Type j = 0; j < k; ++j) {
+    heap->emplace_back(row[j], j);
+  }
+  std::make_heap(heap->begin(), heap->end(), before);
+  for (Type j = k; j < width; ++j) {
+    std::pair<T, Type> item(row[j], j);
+    if (before(item, heap->front())) {
+      std::pop_heap(heap->begin(), heap->end(), before);
+      heap->back() = item;
+      std::push_heap(heap->begin(), heap->end(), before);
+    }
+  }
+  std::sort_heap(heap->begin(), heap->end(), before);
+}
+
 template <typename T, typename Type>
 static void FullTopK(Type input_height,
                      Type input_width,
-                     int input_dim,
                      const DenseTensor* input,
                      T* t_out,
                      Type* t_indices,
@@ -39,86 +85,35 @@ static void FullTopK(Type input_height,
                               k,
                               input_width));
 
-  // when the k is small, will the partial sort
-  bool partial_sort_flag = (k * 64) < input_width;
+  // when the k is small, keep a heap of k elements, the sorted output then
+  // costs nothing more
+  bool heap_flag = (k * 64) < input_width;
+  const T* input_data = input->data<T>();
 
 #ifdef PADDLE_WITH_MKLML
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 4)
 #endif
   for (Type i = 0; i < input_height; ++i) {
+    const T* row = input_data + i * input_width;
     std::vector<std::pair<T, Type>> col_vec;
-    col_vec.reserve(input_width);
-    if (input_dim == 1) {
-      auto e_input = EigenVector<T>::Flatten(*input);
-      for (Type j = 0; j < input_width; ++j) {
-        col_vec.emplace_back(std::pair<T, Type>(e_input(j), j));
-      }
+    if (heap_flag) {
+      col_vec.reserve(k);
+      HeapTopK(row, input_width, k, largest, &col_vec);
     } else {
-      auto e_input = EigenMatrix<T>::Reshape(*input, input_dim - 1);
+      auto before = [largest](const std::pair<T, Type>& l,
+                              const std::pair<T, Type>& r) {
+        return TopKBefore(l, r, largest);
+      };
+      col_vec.reserve(input_width);
       for (Type j = 0; j < input_width; ++j) {
-        col_vec.emplace_back(std::pair<T, Type>(e_input(i, j), j));
+        col_vec.emplace_back(row[j], j);
       }
-    }
-    if (partial_sort_flag) {
-      std::partial_sort(
-          col_vec.begin(),
-          col_vec.begin() + k,
-          col_vec.end(),
-          [&largest](const std::pair<T, Type>& l, const std::pair<T, Type>& r) {
-            if (largest) {
-              return (std::isnan(static_cast<double>(l.first)) &&
-                      !std::isnan(static_cast<double>(r.first))) ||
-                     (l.first > r.first);
-            } else {
-              return (!std::isnan(static_cast<double>(l.first)) &&
-                      std::isnan(static_cast<double>(r.first))) ||
-                     (l.first < r.first);
-            }
-          });
-    } else {
       // use the nth-element to get the K-larger or K-small element
-      if (largest) {
-        std::nth_element(
-            col_vec.begin(),
-            col_vec.begin() + k - 1,
-            col_vec.end(),
-            [](const std::pair<T, Type>& l, const std::pair<T, Type>& r) {
-              return (std::isnan(static_cast<double>(l.first)) &&
-                      !std::isnan(static_cast<double>(r.first))) ||
-                     (l.first > r.first);
-            });
-        // the nth-element will get the unorder elements, sort the element
-        if (sorted) {
-          std::sort(
-              col_vec.begin(),
-              col_vec.begin() + k - 1,
-              [](const std::pair<T, Type>& l, const std::pair<T, Type>& r) {
-                return (std::isnan(static_cast<double>(l.first)) &&
-                        !std::isnan(static_cast<double>(r.first))) ||
-                       (l.first > r.first);
-              });
-        }
-      } else {
-        std::nth_element(
-            col_vec.begin(),
-            col_vec.begin() + k - 1,
-            col_vec.end(),
-            [](const std::pair<T, Type>& l, const std::pair<T, Type>& r) {
-              return (!std::isnan(static_cast<double>(l.first)) &&
-                      std::isnan(static_cast<double>(r.first))) ||
-                     (l.first < r.first);
-            });
-        // the nth-element will get the unorder elements, sort the element
-        if (sorted) {
-          std::sort(
-              col_vec.begin(),
-              col_vec.begin() + k - 1,
-              [](const std::pair<T, Type>& l, const std::pair<T, Type>& r) {
-                return (!std::isnan(static_cast<double>(l.first)) &&
-                        std::isnan(static_cast<double>(r.first))) ||
-                       (l.first < r.first);
-              });
-        }
+      std::nth_element(
+          col_vec.begin(), col_vec.begin() + k - 1, col_vec.end(), before);
+      // the nth-element will get the unorder elements, sort the element
+      if (sorted) {
+        std::sort(col_vec.begin(), col_vec.begin() + k - 1, before);
       }
     }
     for (Type j = 0; j < k; ++j) {
@@ -176,7 +171,6 @@ void TopkKernel(const Context& dev_ctx,
     const int64_t& input_width = in_dims[in_dims.size() - 1];
     FullTopK<T, int64_t>(input_height,
                          input_width,
-                         in_dims.size(),
                          input,
                          out_data,
                          indices_data,
@@ -229,7 +223,6 @@ void TopkKernel(const Context& dev_ctx,
     // get the TopK value
     FullTopK<T, int64_t>(input_height,
                          input_width,
-                         in_dims.size(),
                          &trans_inp,
                          t_out,
                          t_ind,
@@ -14,9 +14,13 @@
 
 #include "paddle/phi/kernels/uniform_kernel.h"
 
+#include "paddle/common/flags.h"
 #include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/philox_engine.h"
 #include "paddle/phi/kernels/funcs/uniform_real_distribution.h"
 
+COMMON_DECLARE_bool(use_philox_cpu_random);
+
 namespace phi {
 
 template <typename T, typename Context>
@@ -30,6 +34,17 @@ void UniformKernel(const Context &dev_ctx,
   out->Resize(common::make_ddim(shape.GetData()));
   T *data = dev_ctx.template Alloc<T>(out);
   auto size = out->numel();
+  if (FLAGS_use_philox_cpu_random) {
+    auto seed_counter = funcs::GetPhiloxSeedAndCounter<T>(
+        dev_ctx.GetGenerator(), seed, size);
+    funcs::PhiloxUniformDistribution<T>(data,
+                                        size,
+                                        min.to<float>(),
+                                        max.to<float>(),
+                                        seed_counter.first,
+                                        seed_counter.second);
+    return;
+  }
   std::shared_ptr<std::mt19937_64> engine;
   if (seed) {
     engine = std::make_shared<std::mt19937_64>();
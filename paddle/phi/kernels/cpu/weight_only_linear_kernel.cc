@@ -0,0 +1,268 @@
+// Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/weight_only_linear_kernel.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/intra_op_parallel.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/blas/blas.h"
+
+namespace phi {
+
+// With fewer rows than this, every quantized weight is dequantized into a
+// small buffer right before it is used, so the weight is read from memory
+// once in its quantized form. Otherwise blocks of the weight are
+// dequantized and multiplied by the float GEMM.
+constexpr int64_t kWeightOnlyGemvMaxRows = 16;
+// Number of weights along k dequantized at a time for per-channel scales,
+// which keeps the dequantized weights in L1 cache.
+constexpr int64_t kWeightOnlyDequantSpan = 256;
+// Number of output channels dequantized for each GEMM call.
+constexpr int64_t kWeightOnlyGemmBlockCols = 64;
+
+// Dequantize the weights of output channel `col` in [k_begin, k_end). The
+// int8 weight is [n, k], the int4 weight is [n / 2, k] where the output
+// channels 2i and 2i + 1 are the low and high 4 bits of one byte.
+template <int Bits>
+inline void DequantizeWeightSpan(const int8_t* weight,
+                                 int64_t k,
+                                 int64_t col,
+                                 int64_t k_begin,
+                                 int64_t k_end,
+                                 float scale,
+                                 float* dst) {
+  if (Bits == 8) {
+    const int8_t* w_row = weight + col * k;
+    for (int64_t i = k_begin; i < k_end; ++i) {
+      dst[i - k_begin] = static_cast<float>(w_row[i]) * scale;
+    }
+  } else {
+    const uint8_t* w_row =
+        reinterpret_cast<const uint8_t*>(weight) + (col >> 1) * k;
+    // Move the wanted 4 bits to the top and shift them back with sign.
+    const int shift = (col & 1) ? 0 : 4;
+    for (int64_t i = k_begin; i < k_end; ++i) {
+      int8_t value = static_cast<int8_t>(w_row[i] << shift) >> 4;
+      dst[i - k_begin] = static_cast<float>(value) * scale;
+    }
+  }
+}
+
+template <typename T>
+inline float GetWeightScale(const T* scale,
+                            int64_t n,
+                            int64_t col,
+                            int64_t k_begin,
+                            int32_t group_size) {
+  return group_size == -1
+             ? static_cast<float>(scale[col])
+             : static_cast<float>(scale[(k_begin / group_size) * n + col]);
+}
+
+template <typename T, int Bits>
+void WeightOnlyGemv(const float* x,
+                    const int8_t* weight,
+                    const T* scale,
+                    int64_t m,
+                    int64_t n,
+                    int64_t k,
+                    int32_t group_size,
+                    float* out) {
+  const int64_t span = group_size == -1 ? kWeightOnlyDequantSpan : group_size;
+  ParallelFor(0, n, 1, [&](int64_t col_begin, int64_t col_end) {
+    std::vector<float> w_buf(span);
+    std::vector<float> acc(m);
+    for (int64_t col = col_begin; col < col_end; ++col) {
+      std::fill(acc.begin(), acc.end(), 0.f);
+      for (int64_t k_begin = 0; k_begin < k; k_begin += span) {
+        int64_t k_end = std::min(k, k_begin + span);
+        DequantizeWeightSpan<Bits>(
+            weight,
+            k,
+            col,
+            k_begin,
+            k_end,
+            GetWeightScale(scale, n, col, k_begin, group_size),
+            w_buf.data());
+        for (int64_t row = 0; row < m; ++row) {
+          const float* x_row = x + row * k + k_begin;
+          float sum = 0.f;
+          for (int64_t i = 0; i < k_end - k_begin; ++i) {
+            sum += x_row[i] * w_buf[i];
+          }
+          acc[row] += sum;
+        }
+      }
+      for (int64_t row = 0; row < m; ++row) {
+        out[row * n + col] = acc[row];
+      }
+    }
+  });
+}
+
+template <typename T, int Bits>
+void WeightOnlyGemm(const CPUContext& dev_ctx,
+                    const float* x,
+                    const int8_t* weight,
+                    const T* scale,
+                    int64_t m,
+                    int64_t n,
+                    int64_t k,
+                    int32_t group_size,
+                    float* out) {
+  const int64_t span = group_size == -1 ? k : group_size;
+  DenseTensor w_block;
+  w_block.Resize({kWeightOnlyGemmBlockCols, k});
+  float* w_block_data = dev_ctx.template Alloc<float>(&w_block);
+  auto blas = funcs::GetBlas<CPUContext, float>(dev_ctx);
+  for (int64_t col_begin = 0; col_begin < n;
+       col_begin += kWeightOnlyGemmBlockCols) {
+    int64_t cols = std::min(kWeightOnlyGemmBlockCols, n - col_begin);
+    ParallelFor(0, cols, 1, [&](int64_t j_begin, int64_t j_end) {
+      for (int64_t j = j_begin; j < j_end; ++j) {
+        int64_t col = col_begin + j;
+        for (int64_t k_begin = 0; k_begin < k; k_begin += span) {
+          DequantizeWeightSpan<Bits>(
+              weight,
+              k,
+              col,
+              k_begin,
+              std::min(k, k_begin + span),
+              GetWeightScale(scale, n, col, k_begin, group_size),
+              w_block_data + j * k + k_begin);
+        }
+      }
+    });
+    blas.GEMM(false,
+              true,
+              static_cast<int>(m),
+              static_cast<int>(cols),
+              static_cast<int>(k),
+              1.f,
+              x,
+              static_cast<int>(k),
+              w_block_data,
+              static_cast<int>(k),
+              0.f,
+              out + col_begin,
+              static_cast<int>(n));
+  }
+}
+
+template <typename T, typename Context>
+void WeightOnlyLinearKernel(const Context& dev_ctx,
+                            const DenseTensor& x,
+                            const DenseTensor& weight,
+                            const paddle::optional<DenseTensor>& bias,
+                            const DenseTensor& weight_scale,
+                            const std::string& weight_dtype,
+                            const int32_t arch,
+                            const int32_t group_size,
+                            DenseTensor* out) {
+  PADDLE_ENFORCE_EQ(
+      arch,
+      0,
+      common::errors::InvalidArgument(
+          "The CPU weight_only_linear expects the weight quantized by "
+          "weight_quantize with arch = 0, but received arch = %d.",
+          arch));
+  dev_ctx.template Alloc<T>(out);
+  const int64_t k = weight.dims()[1];
+  const int64_t m = x.numel() / k;
+  const int64_t n = out->dims()[out->dims().size() - 1];
+  if (m == 0) {
+    return;
+  }
+
+  const float* x_data = nullptr;
+  float* out_data = nullptr;
+  DenseTensor x_fp32, out_fp32;
+  if (std::is_same<T, float>::value) {
+    x_data = reinterpret_cast<const float*>(x.data<T>());
+    out_data = reinterpret_cast<float*>(out->data<T>());
+  } else {
+    x_fp32.Resize({m, k});
+    float* x_fp32_data = dev_ctx.template Alloc<float>(&x_fp32);
+    const T* x_src = x.data<T>();
+    for (int64_t i = 0; i < m * k; ++i) {
+      x_fp32_data[i] = static_cast<float>(x_src[i]);
+    }
+    x_data = x_fp32_data;
+    out_fp32.Resize({m, n});
+    out_data = dev_ctx.template Alloc<float>(&out_fp32);
+  }
+
+  const int8_t* weight_data = weight.data<int8_t>();
+  const T* scale_data = weight_scale.data<T>();
+  if (weight_dtype == "int8") {
+    if (m < kWeightOnlyGemvMaxRows) {
+      WeightOnlyGemv<T, 8>(
+          x_data, weight_data, scale_data, m, n, k, group_size, out_data);
+    } else {
+      WeightOnlyGemm<T, 8>(dev_ctx,
+                           x_data,
+                           weight_data,
+                           scale_data,
+                           m,
+                           n,
+                           k,
+                           group_size,
+                           out_data);
+    }
+  } else if (weight_dtype == "int4") {
+    if (m < kWeightOnlyGemvMaxRows) {
+      WeightOnlyGemv<T, 4>(
+          x_data, weight_data, scale_data, m, n, k, group_size, out_data);
+    } else {
+      WeightOnlyGemm<T, 4>(dev_ctx,
+                           x_data,
+                           weight_data,
+                           scale_data,
+                           m,
+                           n,
+                           k,
+                           group_size,
+                           out_data);
+    }
+  } else {
+    PADDLE_THROW(common::errors::Unimplemented(
+        "The weight_dtype must be int8 or int4, but got %s.", weight_dtype));
+  }
+
+  const T* bias_data = bias ? bias->data<T>() : nullptr;
+  T* out_ptr = out->data<T>();
+  for (int64_t row = 0; row < m; ++row) {
+    for (int64_t col = 0; col < n; ++col) {
+      float value = out_data[row * n + col];
+      if (bias_data) {
+        value += static_cast<float>(bias_data[col]);
+      }
+      out_ptr[row * n + col] = static_cast<T>(value);
+    }
+  }
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(weight_only_linear,
+                   CPU,
+                   ALL_LAYOUT,
+                   phi::WeightOnlyLinearKernel,
+                   float,
+                   phi::dtype::bfloat16) {}
@@ -36,11 +36,11 @@ void quant_compute(const DeviceContext& dev_ctx,
                    const int32_t group_size) {
 #ifndef PADDLE_WITH_HIP
   PADDLE_ENFORCE_EQ(
-      ((arch == 70) || (arch == 75) || (arch == 80) || (arch == 86) ||
-       (arch == 89) || (arch == 90)),
+      ((arch == 0) || (arch == 70) || (arch == 75) || (arch == 80) ||
+       (arch == 86) || (arch == 89) || (arch == 90)),
       true,
       common::errors::InvalidArgument(
-          "Currently, arch only support 70, 75, 80, 86, 89, 90."));
+          "Currently, arch only support 0, 70, 75, 80, 86, 89, 90."));
 
 #endif
   const auto x_dims = x.dims();
@@ -62,8 +62,8 @@ void quant_compute(const DeviceContext& dev_ctx,
 #ifdef PADDLE_WITH_HIP
   x_int.Resize({static_cast<int64_t>(m), static_cast<int64_t>(n)});
 #else
-  if ((arch == 80) || (arch == 75) || (arch == 86) || (arch == 89) ||
-      (arch == 90)) {
+  if ((arch == 0) || (arch == 80) || (arch == 75) || (arch == 86) ||
+      (arch == 89) || (arch == 90)) {
     x_int.Resize({static_cast<int64_t>(m), static_cast<int64_t>(n)});
   } else {
     // phi::Copy may change tensor meta info, here we transpose the quanted
@@ -142,6 +142,15 @@ void quant_compute(const DeviceContext& dev_ctx,
       interleave_column_major_tensor<bits>(
           out_data, int_processed_2_data, std::vector<size_t>{m, n});
       add_bias_and_interleave_inplace<bits>(out_data, num);
+    } else if (arch == 0) {
+      // The CPU weight_only_linear reads the weight as row-major [n, k] for
+      // int8, and [n / 2, k] for int4 where the output channels 2i and
+      // 2i + 1 are packed into the low and high 4 bits of one byte.
+      x_int.Resize(
+          {static_cast<int64_t>(m), static_cast<int64_t>(n * bits / 8)});
+      std::vector<int> axis = {1, 0};
+      funcs::Transpose<DeviceContext, int8_t, 2> trans;
+      trans(dev_ctx, x_int, out, axis);
     }
 #endif
   }
@@ -182,5 +191,6 @@ PD_REGISTER_KERNEL(weight_quantize,
                    CPU,
                    ALL_LAYOUT,
                    phi::WeightQuantizeKernel,
+                   float,
                    phi::dtype::float16,
                    phi::dtype::bfloat16) {}
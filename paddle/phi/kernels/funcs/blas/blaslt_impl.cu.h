@@ -21,6 +21,7 @@ limitations under the License. */
 #include <cuda_runtime_api.h>  // NOLINT
 #include "cuda.h"              // NOLINT
 #include "paddle/phi/backends/dynload/cublasLt.h"
+#include "paddle/phi/backends/gpu/cuda/cuda_graph.h"
 #include "paddle/phi/backends/gpu/cuda/cuda_helper.h"
 
 #include "paddle/common/flags.h"
@@ -31,6 +32,7 @@ limitations under the License. */
 #include "paddle/phi/kernels/funcs/blas/blaslt_gemm_search.h"
 
 COMMON_DECLARE_int64(cublaslt_exhaustive_search_times);
+COMMON_DECLARE_bool(cublaslt_skinny_gemm_search);
 COMMON_DECLARE_bool(enable_blaslt_global_search);
 #endif
 
@@ -440,6 +442,22 @@ struct MatmulGradDescriptor : MatmulDescriptor {
   }
 };
 
+// Matmul with a few rows and a large K, like the ones in decode-phase
+// inference, gets too few output tiles to occupy all SMs with the default
+// algorithm. For them the algorithm is searched among the split-K variants
+// too, and cached in the matmul autotune cache even if autotune is off.
+constexpr int64_t kSkinnyGemmMaxRows = 16;
+constexpr int64_t kSkinnyGemmMinK = 1024;
+// Every split part shall still have a long enough K.
+constexpr int64_t kSkinnyGemmMinSplitK = 256;
+// The least times to measure each algorithm for skinny matmul.
+constexpr int kSkinnyGemmSearchTimes = 5;
+
+inline bool IsSkinnyGemm(const int64_t M, const int64_t N, const int64_t K) {
+  return FLAGS_cublaslt_skinny_gemm_search && M > 0 && N > 0 &&
+         std::min(M, N) <= kSkinnyGemmMaxRows && K >= kSkinnyGemmMinK;
+}
+
 template <typename T, typename OutT = T, class MatmulDescT = MatmulDescriptor>
 struct CublasLtBase {
  public:
@@ -470,7 +488,13 @@ struct CublasLtBase {
     phi::Allocator::AllocationPtr workspace = GetWorkspace(ctx, workspace_size);
 
     if (planner != nullptr) {
-      if (phi::autotune::AutoTuneStatus::Instance().UseAutoTune() &&
+      // The search runs the matmul repeatedly, which is only harmless when
+      // the output is overwritten, and not allowed in cuda graph capturing.
+      bool search_skinny =
+          IsSkinnyGemm(desc->M_, desc->N_, desc->K_) && !planner->UseAddTo() &&
+          !phi::backends::gpu::CUDAGraph::IsThisThreadCapturing();
+      if ((phi::autotune::AutoTuneStatus::Instance().UseAutoTune() ||
+           search_skinny) &&
           (!desc->is_cached)) {
         SearchBestAlgo(ctx,
                        cublaslt_handle,
@@ -481,7 +505,8 @@ struct CublasLtBase {
                        x_ptr,
                        out_ptr,
                        workspace->ptr(),
-                       workspace_size);
+                       workspace_size,
+                       search_skinny);
         MatmulDescT* best_desc = new MatmulDescT(*desc);
         VLOG(6) << "[Searched CublasltDescriptor] ";
 
@@ -519,7 +544,8 @@ struct CublasLtBase {
                              const void* x_data,
                              void* out_data,
                              void* workspace_ptr,
-                             size_t workspace_size) {
+                             size_t workspace_size,
+                             bool with_split_k = false) {
     cublasLtMatmulPreference_t preference;
     PADDLE_ENFORCE_GPU_SUCCESS(
         dynload::cublasLtMatmulPreferenceCreate(&preference));
@@ -548,24 +574,35 @@ struct CublasLtBase {
         returned_results,
         0,
         common::errors::Unavailable("No GEMM algorithm available."));
+    std::vector<cublasLtMatmulAlgo_t> algos;
+    for (int algo_idx = 0; algo_idx < returned_results; ++algo_idx) {
+      algos.push_back(heuristic_results[algo_idx].algo);
+    }
+    int repeats = FLAGS_cublaslt_exhaustive_search_times;
+    if (with_split_k) {
+      AppendSplitKAlgos(lt_handle, desc, workspace_size, &algos);
+      repeats = std::max(repeats, static_cast<int64_t>(kSkinnyGemmSearchTimes));
+    }
+
     int best_algo_idx = -1;
-    if (returned_results == 1 || FLAGS_cublaslt_exhaustive_search_times <= 0) {
+    if (algos.size() == 1 || repeats <= 1) {
       best_algo_idx = 0;
     } else {
       float min_time_cost = std::numeric_limits<float>::max();
-      for (int algo_idx = 0; algo_idx < returned_results; ++algo_idx) {
-        float cur_time_cost =
-            RunAndMeasureAlgo(ctx,
-                              lt_handle,
-                              desc,
-                              alpha,
-                              beta,
-                              y_data,
-                              x_data,
-                              out_data,
-                              workspace_ptr,
-                              workspace_size,
-                              &(heuristic_results[algo_idx].algo));
+      for (int algo_idx = 0; algo_idx < static_cast<int>(algos.size());
+           ++algo_idx) {
+        float cur_time_cost = RunAndMeasureAlgo(ctx,
+                                                lt_handle,
+                                                desc,
+                                                alpha,
+                                                beta,
+                                                y_data,
+                                                x_data,
+                                                out_data,
+                                                workspace_ptr,
+                                                workspace_size,
+                                                &(algos[algo_idx]),
+                                                repeats);
         VLOG(6) << "[MatmulWithCublaslt] algo[" << algo_idx
                 << "] time: " << cur_time_cost << " s";
 
@@ -579,11 +616,76 @@ struct CublasLtBase {
     VLOG(6) << "[MatmulWithCublaslt] best_algo_idx: " << best_algo_idx;
 
     cublasLtMatmulAlgo_t* best_algo = desc->SetAlgo();
-    *best_algo = heuristic_results[best_algo_idx].algo;
+    *best_algo = algos[best_algo_idx];
     PADDLE_ENFORCE_GPU_SUCCESS(
         dynload::cublasLtMatmulPreferenceDestroy(preference));
   }
 
+  // Append the split-K variants of the algorithms which support it, with
+  // the first reduction scheme available, in-place one preferred.
+  static void AppendSplitKAlgos(const cublasLtHandle_t& lt_handle,
+                                MatmulDescT* desc,
+                                size_t workspace_size,
+                                std::vector<cublasLtMatmulAlgo_t>* algos) {
+    const size_t num_heuristic_algos = algos->size();
+    for (size_t i = 0; i < num_heuristic_algos; ++i) {
+      cublasLtMatmulAlgo_t algo = (*algos)[i];
+      int splitk_support = 0;
+      int red_mask = 0;
+      size_t attr_size = 0;
+      PADDLE_ENFORCE_GPU_SUCCESS(dynload::cublasLtMatmulAlgoCapGetAttribute(
+          &algo,
+          CUBLASLT_ALGO_CAP_SPLITK_SUPPORT,
+          &splitk_support,
+          sizeof(splitk_support),
+          &attr_size));
+      PADDLE_ENFORCE_GPU_SUCCESS(dynload::cublasLtMatmulAlgoCapGetAttribute(
+          &algo,
+          CUBLASLT_ALGO_CAP_REDUCTION_SCHEME_MASK,
+          &red_mask,
+          sizeof(red_mask),
+          &attr_size));
+      if (!splitk_support || red_mask == 0) {
+        continue;
+      }
+      int reduction_scheme = red_mask & (-red_mask);
+      for (int split_k : cublaslt_internal::split_k_candidates) {
+        if (desc->K_ / split_k < kSkinnyGemmMinSplitK) {
+          break;
+        }
+        cublasLtMatmulAlgo_t split_k_algo = algo;
+        PADDLE_ENFORCE_GPU_SUCCESS(
+            dynload::cublasLtMatmulAlgoConfigSetAttribute(
+                &split_k_algo,
+                CUBLASLT_ALGO_CONFIG_SPLITK_NUM,
+                &split_k,
+                sizeof(split_k)));
+        PADDLE_ENFORCE_GPU_SUCCESS(
+            dynload::cublasLtMatmulAlgoConfigSetAttribute(
+                &split_k_algo,
+                CUBLASLT_ALGO_CONFIG_REDUCTION_SCHEME,
+                &reduction_scheme,
+                sizeof(reduction_scheme)));
+        cublasLtMatmulHeuristicResult_t result;
+        cublasStatus_t status =
+            dynload::cublasLtMatmulAlgoCheck(lt_handle,
+                                             desc->op_desc,
+                                             desc->y_desc,
+                                             desc->x_desc,
+                                             desc->out_desc,
+                                             desc->out_desc,
+                                             &split_k_algo,
+                                             &result);
+        if (status == CUBLAS_STATUS_SUCCESS &&
+            result.workspaceSize <= workspace_size) {
+          algos->push_back(split_k_algo);
+        }
+      }
+    }
+    VLOG(6) << "[MatmulWithCublaslt] " << algos->size() - num_heuristic_algos
+            << " split-K algos appended for skinny matmul";
+  }
+
   static float RunAndMeasureAlgo(const phi::GPUContext& ctx,
                                  const cublasLtHandle_t& lt_handle,
                                  MatmulDescT* desc,
@@ -594,8 +696,8 @@ struct CublasLtBase {
                                  void* out_data,
                                  void* workspace_ptr,
                                  size_t workspace_size,
-                                 cublasLtMatmulAlgo_t* algo) {
-    int repeats = FLAGS_cublaslt_exhaustive_search_times;
+                                 cublasLtMatmulAlgo_t* algo,
+                                 int repeats) {
     if (repeats <= 0) {
       return std::numeric_limits<float>::max();
     }
@@ -1009,7 +1111,8 @@ struct DescriptorSetter {
     }
 
     bool has_cache = false;
-    if (phi::autotune::AutoTuneStatus::Instance().UseAutoTune()) {
+    if (phi::autotune::AutoTuneStatus::Instance().UseAutoTune() ||
+        IsSkinnyGemm(M, N, K)) {
       auto& matmul_cache = phi::autotune::AutoTuneCache::Instance().GetMatmul();
       has_cache = matmul_cache.FindSubKey(sub_key);
     }
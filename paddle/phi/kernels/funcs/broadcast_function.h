@@ -34,9 +34,12 @@ enum BroadcastType { kMixed = 1, kBroadcast = 2, kElementwise = 3 };
 template <typename OutT, typename Functor, int Arity, int NumOuts>
 struct BroadcastTypeClassifier {
   int64_t numel{0};
-  int broadcast_num{0};              // Not used for XPU
-  bool all_elementwise{true};        // Not used for XPU
-  Array<bool, Arity> use_broadcast;  // Not used for XPU
+  int broadcast_num{0};                  // Not used for XPU
+  bool all_elementwise{true};            // Not used for XPU
+  Array<bool, Arity> use_broadcast;      // Not used for XPU
+  bool row_col_broadcast{false};         // Not used for XPU
+  int64_t broadcast_cols{0};             // Not used for XPU
+  Array<int, Arity> broadcast_patterns;  // Not used for XPU
   Array<kps::details::BroadcastConfig, Arity> configs;
   Array<const _ptr_ char *__restrict__, Arity> ins_data;
   Array<_ptr_ OutT *, NumOuts> outs_data;
@@ -107,6 +110,14 @@ struct BroadcastTypeClassifier {
                                                      dims_simplifier.rank);
         }
       }
+      // Inputs which are only broadcast along the rows or the columns of the
+      // simplified output can be loaded without index decomposition.
+      row_col_broadcast = true;
+      for (int i = 0; i < Arity; ++i) {
+        broadcast_patterns[i] = dims_simplifier.GetBroadcastPattern(i);
+        row_col_broadcast &= broadcast_patterns[i] != kGeneralBroadcast;
+      }
+      broadcast_cols = dims_simplifier.out_dims[0];
     }
 #endif
   }
@@ -250,6 +261,40 @@ struct BroadcastDataSetter {
   }
 };
 
+// Loader for the inputs which are broadcast only along the rows or the
+// columns of the simplified output, a single vectorized or scalar load
+// covers VecSize outputs.
+template <int Index, int VecSize>
+struct RowColBroadcastDataLoader {
+  template <typename Array1, typename Array2, typename ArgsT>
+  static __device__ __forceinline__ void Apply(const Array1 &ins,
+                                               ArgsT *args,
+                                               const Array2 &patterns,
+                                               const uint32_t offset,
+                                               const uint32_t row,
+                                               const uint32_t col) {
+    using Type = std::tuple_element_t<Index, ArgsT>;
+    using VecType = phi::kps::details::VectorType<Type, VecSize>;
+    const _ptr_ Type *__restrict__ in =
+        reinterpret_cast<const _ptr_ Type *>(ins[Index]);
+    if (patterns[Index] == kRowBroadcast) {
+      Type value = in[row];
+#pragma unroll
+      for (int k = 0; k < VecSize; ++k) {
+        std::get<Index>(args[k]) = value;
+      }
+    } else {
+      uint32_t in_offset = patterns[Index] == kLastDimBroadcast ? col : offset;
+      VecType vec_temp =
+          *reinterpret_cast<const VecType *__restrict__>(in + in_offset);
+#pragma unroll
+      for (int k = 0; k < VecSize; ++k) {
+        std::get<Index>(args[k]) = vec_temp.val[k];
+      }
+    }
+  }
+};
+
 #endif
 
 // static broadcast unroller
@@ -434,6 +479,59 @@ __global__ void VectorizedBroadcastKernel(
 #endif
 }
 
+#ifndef PADDLE_WITH_XPU_KP
+// Broadcast kernel for the shapes like [B, S, H] op [H] and [B, S, H] op
+// [B, S, 1]. The cols of output is a multiple of VecSize, so the VecSize
+// outputs handled by one thread always lie in the same row and only one
+// division is needed for each of them.
+template <typename Functor,
+          typename OutT,
+          int Arity,
+          int NumOuts,
+          int VecSize>
+__global__ void VectorizedRowColBroadcastKernel(
+    Array<const _ptr_ char *__restrict__, Arity> ins,
+    Array<_ptr_ OutT *, NumOuts> outs,
+    Array<int, Arity> patterns,
+    uint32_t numel,
+    kps::details::FastDivMod cols_divmoder,
+    int main_offset,
+    int tail_tid,
+    Functor func) {
+  using Traits = phi::funcs::FunctionTraits<Functor>;
+  using ArgsT = typename Traits::ArgsTuple;
+  ArgsT args[VecSize];
+  ConditionalT<OutT, NumOuts> result[VecSize];
+
+  uint32_t block_offset = BLOCK_ID_X * BLOCK_NUM_X * VecSize;
+  uint32_t thread_offset = block_offset + THREAD_ID_X * VecSize;
+  if (thread_offset < numel) {
+    auto fast_divmoder = cols_divmoder.Divmod(thread_offset);
+    Unroller<RowColBroadcastDataLoader, VecSize, Arity>::step(
+        ins,
+        args,
+        patterns,
+        thread_offset,
+        fast_divmoder.val[0],
+        fast_divmoder.val[1]);
+  } else {
+    Unroller<BroadcastDataInit, VecSize, Arity>::step(args);
+  }
+  SameDimsElementwisePrimitiveCaller<ConditionalT<OutT, NumOuts>,
+                                     VecSize,
+                                     Functor,
+                                     ArgsT,
+                                     Arity>()(func, args, result, VecSize);
+  if (block_offset < main_offset) {
+    ElementwiseWriteDataCallerBc<OutT, VecSize, false, NumOuts>()(
+        outs, result, block_offset, BLOCK_NUM_X * VecSize, VecSize);
+  } else {
+    ElementwiseWriteDataCallerBc<OutT, VecSize, true, NumOuts>()(
+        outs, result, block_offset, tail_tid, VecSize);
+  }
+}
+#endif
+
 template <typename OutT, typename Functor, int Arity, int NumOuts, int VecSize>
 void LaunchBroadcastKernel(
     const KPDevice &ctx,
@@ -484,6 +582,18 @@ void LaunchBroadcastKernel(
                                          tail_tid,
                                          VecSize,
                                          func);
+  } else if (classifier.row_col_broadcast &&
+             classifier.broadcast_cols % VecSize == 0) {
+    VectorizedRowColBroadcastKernel<Functor, OutT, Arity, NumOuts, VecSize>
+        <<<blocks, threads, 0, stream>>>(
+            classifier.ins_data,
+            classifier.outs_data,
+            classifier.broadcast_patterns,
+            numel,
+            kps::details::FastDivMod(classifier.broadcast_cols),
+            main_offset,
+            tail_tid,
+            func);
   } else if (classifier.broadcast_num > (Arity >> 1)) {
     constexpr BroadcastType type_ = (Arity > 1) ? kBroadcast : kMixed;
     VectorizedBroadcastKernel<Functor, OutT, Arity, NumOuts, VecSize, type_>
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <mutex>
 #include <vector>
 
 #include "paddle/common/ddim.h"
@@ -137,12 +138,15 @@ class FFTConfig {
   FFTTransformType transform_type() const { return fft_type_; }
   DataType data_type() const { return precision_; }
   size_t workspace_size() const { return ws_size_; }
+  // Held while the plan is bound to a stream and a workspace and executed.
+  std::mutex& mutex() const { return mutex_; }
 
  private:
   CuFFTHandle plan_;
   size_t ws_size_;  // workspace size in bytes
   FFTTransformType fft_type_;
   DataType precision_;
+  mutable std::mutex mutex_;
 };
 
 // NOTE: R2C is forward-only, C2R is backward only
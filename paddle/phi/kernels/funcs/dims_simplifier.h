@@ -22,6 +22,17 @@ limitations under the License. */
 namespace phi {
 namespace funcs {
 
+// Broadcast patterns which can be computed without decomposing the output
+// index dimension by dimension. Taking out.shape = [B, S, H] as example,
+// in.shape = [B, S, H] is kSameDims, in.shape = [H] is kLastDimBroadcast and
+// in.shape = [B, S, 1] is kRowBroadcast.
+enum BroadcastPattern {
+  kSameDims = 0,
+  kLastDimBroadcast = 1,
+  kRowBroadcast = 2,
+  kGeneralBroadcast = 3
+};
+
 struct BroadcastDimsSimplifier {
   using DimVector = std::vector<int64_t>;
   typedef void (*MergeFunctor)(
@@ -101,6 +112,27 @@ struct BroadcastDimsSimplifier {
     }
   }
 
+  // Get the broadcast pattern of the idx-th input. The simplified dims are
+  // stored in reversed order, so out_dims is {cols, rows} when rank is 2.
+  BroadcastPattern GetBroadcastPattern(int idx) const {
+    const auto &in_dim = in_dims[idx];
+    if (rank == 1) {
+      return in_dim[0] == out_dims[0] ? kSameDims : kRowBroadcast;
+    }
+    if (rank == 2) {
+      bool same_cols = in_dim[0] == out_dims[0];
+      bool same_rows = in_dim[1] == out_dims[1];
+      if (same_cols && same_rows) {
+        return kSameDims;
+      } else if (same_cols && in_dim[1] == 1) {
+        return kLastDimBroadcast;
+      } else if (in_dim[0] == 1 && same_rows) {
+        return kRowBroadcast;
+      }
+    }
+    return kGeneralBroadcast;
+  }
+
  private:
   // To compensate the lackage of input_tensors' dimension with axis.
   void ExtendInputDimensions(int axis) {
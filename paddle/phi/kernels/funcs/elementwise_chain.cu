@@ -0,0 +1,163 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/elementwise_chain.h"
+
+#include "paddle/phi/backends/gpu/gpu_helper.h"
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/common/amp_type_traits.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace phi {
+namespace funcs {
+
+template <typename T>
+struct ElementwiseChainArgs {
+  const T* inputs[kMaxElementwiseChainInputs];
+  T* outputs[kMaxElementwiseChainOutputs];
+};
+
+template <typename MT>
+__device__ __forceinline__ MT
+RunElementwiseChainOp(ElementwiseChainOpCode code, MT x, MT y) {
+  switch (code) {
+    case ElementwiseChainOpCode::kAdd:
+      return x + y;
+    case ElementwiseChainOpCode::kSubtract:
+      return x - y;
+    case ElementwiseChainOpCode::kMultiply:
+      return x * y;
+    case ElementwiseChainOpCode::kDivide:
+      return x / y;
+    case ElementwiseChainOpCode::kMaximum:
+      return x > y ? x : y;
+    case ElementwiseChainOpCode::kMinimum:
+      return x < y ? x : y;
+    case ElementwiseChainOpCode::kRelu:
+      return x > static_cast<MT>(0) ? x : static_cast<MT>(0);
+    case ElementwiseChainOpCode::kExp:
+      return exp(x);
+    case ElementwiseChainOpCode::kSqrt:
+      return sqrt(x);
+    case ElementwiseChainOpCode::kTanh:
+      return tanh(x);
+    case ElementwiseChainOpCode::kSigmoid:
+      return static_cast<MT>(1) / (static_cast<MT>(1) + exp(-x));
+    case ElementwiseChainOpCode::kAbs:
+      return x < static_cast<MT>(0) ? -x : x;
+    case ElementwiseChainOpCode::kSquare:
+      return x * x;
+  }
+  return x;
+}
+
+template <typename T>
+__global__ void ElementwiseChainKernel(ElementwiseChainProgram program,
+                                       ElementwiseChainArgs<T> args,
+                                       int64_t numel) {
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  MT regs[kMaxElementwiseChainInputs + kMaxElementwiseChainOps];
+  CUDA_KERNEL_LOOP_TYPE(i, numel, int64_t) {
+    for (int k = 0; k < program.input_num; ++k) {
+      regs[k] = static_cast<MT>(args.inputs[k][i]);
+    }
+    for (int k = 0; k < program.op_num; ++k) {
+      const ElementwiseChainOp& op = program.ops[k];
+      regs[program.input_num + k] =
+          RunElementwiseChainOp<MT>(op.code, regs[op.x], regs[op.y]);
+    }
+    for (int k = 0; k < program.output_num; ++k) {
+      args.outputs[k][i] = static_cast<T>(regs[program.outputs[k]]);
+    }
+  }
+}
+
+template <typename T>
+static void LaunchElementwiseChainImpl(
+    const GPUContext& dev_ctx,
+    const ElementwiseChainProgram& program,
+    const std::vector<const DenseTensor*>& inputs,
+    const std::vector<DenseTensor*>& outputs) {
+  ElementwiseChainArgs<T> args;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    args.inputs[i] = inputs[i]->data<T>();
+  }
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    outputs[i]->Resize(inputs[0]->dims());
+    args.outputs[i] = dev_ctx.template Alloc<T>(outputs[i]);
+  }
+  int64_t numel = inputs[0]->numel();
+  if (numel == 0) {
+    return;
+  }
+  auto config = phi::backends::gpu::GetGpuLaunchConfig1D(dev_ctx, numel);
+  ElementwiseChainKernel<T><<<config.block_per_grid,
+                              config.thread_per_block,
+                              0,
+                              dev_ctx.stream()>>>(program, args, numel);
+}
+
+void LaunchElementwiseChain(const GPUContext& dev_ctx,
+                            const ElementwiseChainProgram& program,
+                            const std::vector<const DenseTensor*>& inputs,
+                            const std::vector<DenseTensor*>& outputs) {
+  PADDLE_ENFORCE_EQ(
+      !inputs.empty() &&
+          inputs.size() <= static_cast<size_t>(kMaxElementwiseChainInputs) &&
+          static_cast<int>(inputs.size()) == program.input_num,
+      true,
+      common::errors::InvalidArgument(
+          "The elementwise chain expects %d inputs, but received %d.",
+          program.input_num,
+          inputs.size()));
+  PADDLE_ENFORCE_EQ(
+      outputs.size() <= static_cast<size_t>(kMaxElementwiseChainOutputs) &&
+          static_cast<int>(outputs.size()) == program.output_num,
+      true,
+      common::errors::InvalidArgument(
+          "The elementwise chain expects %d outputs, but received %d.",
+          program.output_num,
+          outputs.size()));
+  PADDLE_ENFORCE_LE(program.op_num,
+                    kMaxElementwiseChainOps,
+                    common::errors::InvalidArgument(
+                        "The elementwise chain has at most %d ops.",
+                        kMaxElementwiseChainOps));
+
+  switch (inputs[0]->dtype()) {
+    case DataType::FLOAT32:
+      LaunchElementwiseChainImpl<float>(dev_ctx, program, inputs, outputs);
+      break;
+    case DataType::FLOAT64:
+      LaunchElementwiseChainImpl<double>(dev_ctx, program, inputs, outputs);
+      break;
+    case DataType::FLOAT16:
+      LaunchElementwiseChainImpl<phi::dtype::float16>(
+          dev_ctx, program, inputs, outputs);
+      break;
+    case DataType::BFLOAT16:
+      LaunchElementwiseChainImpl<phi::dtype::bfloat16>(
+          dev_ctx, program, inputs, outputs);
+      break;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "The elementwise chain does not support %s.",
+          DataTypeToString(inputs[0]->dtype())));
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,94 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#endif
+
+namespace phi {
+namespace funcs {
+
+enum class ElementwiseChainOpCode : uint8_t {
+  kAdd,
+  kSubtract,
+  kMultiply,
+  kDivide,
+  kMaximum,
+  kMinimum,
+  kRelu,
+  kExp,
+  kSqrt,
+  kTanh,
+  kSigmoid,
+  kAbs,
+  kSquare,
+};
+
+inline bool IsBinaryElementwiseChainOp(ElementwiseChainOpCode code) {
+  return code <= ElementwiseChainOpCode::kMinimum;
+}
+
+constexpr int kMaxElementwiseChainOps = 16;
+constexpr int kMaxElementwiseChainInputs = 8;
+constexpr int kMaxElementwiseChainOutputs = 4;
+
+// One op of the chain reads the registers x (and y for binary ops) and
+// writes the register input_num + its index. The registers below input_num
+// hold the inputs.
+struct ElementwiseChainOp {
+  ElementwiseChainOpCode code;
+  uint8_t x;
+  uint8_t y;
+};
+
+/**
+ * ElementwiseChainProgram describes a chain of elementwise ops over tensors
+ * of the same shape. It is passed to one kernel by value and interpreted per
+ * element, so that a chain found at runtime runs in one launch, and the
+ * intermediate results only live in registers.
+ */
+struct ElementwiseChainProgram {
+  int input_num{0};
+  int op_num{0};
+  int output_num{0};
+  ElementwiseChainOp ops[kMaxElementwiseChainOps];
+  // the register written to each output
+  uint8_t outputs[kMaxElementwiseChainOutputs];
+};
+
+// The dtypes the chain kernel is instantiated for, computed in float for
+// the low precision ones.
+inline bool IsElementwiseChainSupported(DataType dtype) {
+  return dtype == DataType::FLOAT32 || dtype == DataType::FLOAT64 ||
+         dtype == DataType::FLOAT16 || dtype == DataType::BFLOAT16;
+}
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// All the inputs have the same dtype and dims, the outputs are resized to the
+// dims of the inputs and allocated.
+void LaunchElementwiseChain(const GPUContext& dev_ctx,
+                            const ElementwiseChainProgram& program,
+                            const std::vector<const DenseTensor*>& inputs,
+                            const std::vector<DenseTensor*>& outputs);
+#endif
+
+}  // namespace funcs
+}  // namespace phi
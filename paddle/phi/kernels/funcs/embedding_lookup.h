@@ -0,0 +1,231 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/phi/common/place.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/kernels/funcs/embedding_util.h"
+#include "paddle/phi/kernels/funcs/jit/kernels.h"
+
+namespace phi {
+namespace funcs {
+
+// The ids looked up ahead of the current one, so that their rows are on the
+// way from memory while the current row is copied.
+constexpr int64_t kEmbeddingPrefetchDistance = 8;
+constexpr int64_t kEmbeddingPrefetchMaxLines = 16;
+
+template <typename T>
+inline void PrefetchEmbeddingRow(const T* row, int64_t width) {
+#if defined(__GNUC__) || defined(__clang__)
+  const char* p = reinterpret_cast<const char*>(row);
+  int64_t lines = std::min<int64_t>((width * sizeof(T) + 63) / 64,
+                                    kEmbeddingPrefetchMaxLines);
+  for (int64_t i = 0; i < lines; ++i) {
+    __builtin_prefetch(p + i * 64);
+  }
+#endif
+}
+
+// out[i] = table[ids[i]], and zeros for padding_idx. The ids should have been
+// checked to be in range.
+template <typename T>
+void EmbeddingLookupRows(const T* table,
+                         int64_t width,
+                         const std::vector<int64_t>& ids,
+                         int64_t padding_idx,
+                         T* out) {
+  const int64_t ids_num = static_cast<int64_t>(ids.size());
+  const int64_t row_bytes = width * sizeof(T);
+#if defined(_OPENMP) && !defined(PADDLE_WITH_CUDA)
+#pragma omp parallel for schedule(static)
+#endif
+  for (int64_t i = 0; i < ids_num; ++i) {
+    int64_t next = i + kEmbeddingPrefetchDistance;
+    if (next < ids_num && ids[next] != padding_idx) {
+      PrefetchEmbeddingRow(table + ids[next] * width, width);
+    }
+    if (padding_idx != kNoPadding && ids[i] == padding_idx) {
+      std::memset(out + i * width, 0, row_bytes);
+    } else {
+      std::memcpy(out + i * width, table + ids[i] * width, row_bytes);
+    }
+  }
+}
+
+/**
+ * EmbeddingRowGroups groups the positions of the ids by their rows, the
+ * positions of rows[u] are positions[offsets[u]] ~ positions[offsets[u+1]-1]
+ * in ascending order. The rows are in the order of their first occurrences.
+ * It lets the gradients of the duplicated ids be merged in parallel over the
+ * rows without atomics, and the results do not depend on the thread number.
+ */
+struct EmbeddingRowGroups {
+  std::vector<int64_t> rows;
+  std::vector<int64_t> offsets;
+  std::vector<int64_t> positions;
+};
+
+inline EmbeddingRowGroups GroupEmbeddingIds(const std::vector<int64_t>& ids,
+                                            int64_t skip_id = kNoPadding) {
+  EmbeddingRowGroups groups;
+  std::unordered_map<int64_t, int64_t> row_index;
+  row_index.reserve(ids.size());
+  std::vector<int64_t> index_of(ids.size(), -1);
+  std::vector<int64_t> counts;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (skip_id != kNoPadding && ids[i] == skip_id) {
+      continue;
+    }
+    auto it = row_index.emplace(ids[i], groups.rows.size()).first;
+    if (it->second == static_cast<int64_t>(groups.rows.size())) {
+      groups.rows.push_back(ids[i]);
+      counts.push_back(0);
+    }
+    index_of[i] = it->second;
+    ++counts[it->second];
+  }
+  groups.offsets.assign(groups.rows.size() + 1, 0);
+  for (size_t u = 0; u < counts.size(); ++u) {
+    groups.offsets[u + 1] = groups.offsets[u] + counts[u];
+  }
+  groups.positions.resize(groups.offsets.back());
+  std::vector<int64_t> cursor(groups.offsets.begin(), groups.offsets.end() - 1);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (index_of[i] >= 0) {
+      groups.positions[cursor[index_of[i]]++] = static_cast<int64_t>(i);
+    }
+  }
+  return groups;
+}
+
+// Sums the rows of src in each group into one row of dst, the row u of dst
+// when dst_by_row is false, or the row rows[u] when it is true. The rows of
+// dst not in the groups are left untouched.
+template <typename T>
+void MergeEmbeddingRows(const T* src,
+                        int64_t width,
+                        const EmbeddingRowGroups& groups,
+                        bool dst_by_row,
+                        T* dst) {
+  const int64_t group_num = static_cast<int64_t>(groups.rows.size());
+#if defined(_OPENMP) && !defined(PADDLE_WITH_CUDA)
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for (int64_t u = 0; u < group_num; ++u) {
+    T* out = dst + (dst_by_row ? groups.rows[u] : u) * width;
+    int64_t begin = groups.offsets[u];
+    int64_t end = groups.offsets[u + 1];
+    std::memcpy(out, src + groups.positions[begin] * width, width * sizeof(T));
+    for (int64_t p = begin + 1; p < end; ++p) {
+      if (p + 1 < end) {
+        PrefetchEmbeddingRow(src + groups.positions[p + 1] * width, width);
+      }
+      const T* in = src + groups.positions[p] * width;
+      for (int64_t j = 0; j < width; ++j) {
+        out[j] += in[j];
+      }
+    }
+  }
+}
+
+enum class EmbeddingPoolType { kSum, kMean };
+
+/**
+ * Looks up and pools the ids of each bag in one pass, the ids of bag b are
+ * ids[offsets[b]] ~ ids[offsets[b+1]-1] and its pooled row is out[b]. An
+ * empty bag pools to zeros. The rows are summed by the jit EmbSeqPool kernel
+ * for float, so that the looked up rows are never written out.
+ */
+template <typename T>
+void EmbeddingPooledLookup(const T* table,
+                           int64_t height,
+                           int64_t width,
+                           const int64_t* ids,
+                           const std::vector<int64_t>& offsets,
+                           EmbeddingPoolType pool_type,
+                           T* out) {
+  PADDLE_ENFORCE_GE(offsets.size(),
+                    1UL,
+                    common::errors::InvalidArgument(
+                        "The offsets of the bags should not be empty."));
+  const int64_t bag_num = static_cast<int64_t>(offsets.size()) - 1;
+  for (int64_t b = 0; b < bag_num; ++b) {
+    PADDLE_ENFORCE_LE(offsets[b],
+                      offsets[b + 1],
+                      common::errors::InvalidArgument(
+                          "The offsets of the bags should be ascending, but "
+                          "offsets[%d] = %d and offsets[%d] = %d.",
+                          b,
+                          offsets[b],
+                          b + 1,
+                          offsets[b + 1]));
+  }
+  for (int64_t i = offsets.front(); i < offsets.back(); ++i) {
+    PADDLE_ENFORCE_EQ(
+        ids[i] >= 0 && ids[i] < height,
+        true,
+        common::errors::InvalidArgument(
+            "The id should be in [0, %d), but ids[%d] is %d.",
+            height,
+            i,
+            ids[i]));
+  }
+
+#if defined(_OPENMP) && !defined(PADDLE_WITH_CUDA)
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for (int64_t b = 0; b < bag_num; ++b) {
+    const int64_t* bag = ids + offsets[b];
+    const int64_t len = offsets[b + 1] - offsets[b];
+    T* res = out + b * width;
+    if (len == 0) {
+      std::memset(res, 0, width * sizeof(T));
+      continue;
+    }
+    if constexpr (std::is_same<T, float>::value) {
+      jit::emb_seq_pool_attr_t attr(height, width, len, 1, width);
+      auto emb_seq_pool =
+          jit::KernelFuncs<jit::EmbSeqPoolTuple<T>, phi::CPUPlace>::Cache().At(
+              attr);
+      emb_seq_pool(table, bag, res, &attr);
+    } else {
+      std::memcpy(res, table + bag[0] * width, width * sizeof(T));
+      for (int64_t i = 1; i < len; ++i) {
+        if (i + 1 < len) {
+          PrefetchEmbeddingRow(table + bag[i + 1] * width, width);
+        }
+        const T* row = table + bag[i] * width;
+        for (int64_t j = 0; j < width; ++j) {
+          res[j] += row[j];
+        }
+      }
+    }
+    if (pool_type == EmbeddingPoolType::kMean) {
+      for (int64_t j = 0; j < width; ++j) {
+        res[j] = res[j] / static_cast<T>(len);
+      }
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
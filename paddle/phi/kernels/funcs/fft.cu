@@ -167,22 +167,22 @@ void exec_fft(const phi::GPUContext& ctx,
   collapsed_output.Resize(collapsed_output_shape);
   ctx.Alloc<To>(&collapsed_output);
 
-  FFTConfigKey key =
-      create_fft_configkey(collapsed_input, collapsed_output, signal_ndim);
+  FFTConfigKey key = create_fft_configkey(common::vectorize(in_sizes),
+                                          common::vectorize(out_sizes),
+                                          axes,
+                                          x.dtype(),
+                                          collapsed_output.dtype());
   int64_t device_id = ctx.GetPlace().GetDeviceId();
-  FFTConfig* config = nullptr;
-  std::unique_ptr<FFTConfig> config_ = nullptr;
+  std::shared_ptr<FFTConfig> config = nullptr;
   bool using_cache = use_cache(key.sizes_);
 
   if (using_cache) {
-    FFTConfigCache& plan_cache = get_fft_plan_cache(device_id);
-    std::unique_lock<std::mutex> guard(plan_cache.mutex, std::defer_lock);
-    guard.lock();
-    config = &(plan_cache.lookup(key));
+    config = get_fft_plan_cache(device_id).lookup(key);
   } else {
-    config_ = std::make_unique<FFTConfig>(key);
-    config = config_.get();
+    config = std::make_shared<FFTConfig>(key);
   }
+  // a cached plan may be executed by several threads, on different streams
+  std::unique_lock<std::mutex> plan_guard(config->mutex());
 
   const int64_t workspace_size = static_cast<int64_t>(config->workspace_size());
   DenseTensor workspace_tensor = Empty<uint8_t>(ctx, {workspace_size});
@@ -212,6 +212,7 @@ void exec_fft(const phi::GPUContext& ctx,
     exec_plan(
         *config, collapsed_input.data(), collapsed_output.data(), forward);
   }
+  plan_guard.unlock();
 
   // resize for the collapsed output
   collapsed_output.Resize(transposed_output_shape);
@@ -225,8 +226,133 @@ void exec_fft(const phi::GPUContext& ctx,
   TransposeKernel<To, phi::GPUContext>(
       ctx, transposed_output, reverse_dim_permute, out);
 }
+
+// The keys of the plans FFTC2CFunctor, FFTR2CFunctor and FFTC2RFunctor look
+// up, appended to keys when the plans are cached.
+static void append_fft_configkey(const std::vector<int64_t>& in_sizes,
+                                 const std::vector<int64_t>& out_sizes,
+                                 const std::vector<int64_t>& axes,
+                                 DataType in_dtype,
+                                 DataType out_dtype,
+                                 std::vector<FFTConfigKey>* keys) {
+  FFTConfigKey key =
+      create_fft_configkey(in_sizes, out_sizes, axes, in_dtype, out_dtype);
+  if (use_cache(key.sizes_)) {
+    keys->push_back(key);
+  }
+}
+
+static void c2c_fft_configkeys(const std::vector<int64_t>& sizes,
+                               const std::vector<int64_t>& axes,
+                               DataType dtype,
+                               std::vector<FFTConfigKey>* keys) {
+  std::vector<int64_t> working_axes = axes;
+  std::sort(working_axes.begin(), working_axes.end());
+  while (!working_axes.empty()) {
+    const size_t max_dims =
+        std::min(static_cast<size_t>(kMaxFFTNdim), working_axes.size());
+    std::vector<int64_t> first_dims(working_axes.end() - max_dims,
+                                    working_axes.end());
+    append_fft_configkey(sizes, sizes, first_dims, dtype, dtype, keys);
+    working_axes.resize(working_axes.size() - max_dims);
+  }
+}
+
+static void r2c_fft_configkeys(const std::vector<int64_t>& in_sizes,
+                               const std::vector<int64_t>& out_sizes,
+                               const std::vector<int64_t>& axes,
+                               DataType in_dtype,
+                               DataType out_dtype,
+                               std::vector<FFTConfigKey>* keys) {
+  if (use_optimized_fft_path(axes)) {
+    append_fft_configkey(in_sizes, out_sizes, axes, in_dtype, out_dtype, keys);
+  } else {
+    append_fft_configkey(
+        in_sizes, out_sizes, {axes.back()}, in_dtype, out_dtype, keys);
+    c2c_fft_configkeys(
+        out_sizes, {axes.begin(), axes.end() - 1}, out_dtype, keys);
+  }
+}
+
+static void c2r_fft_configkeys(const std::vector<int64_t>& in_sizes,
+                               const std::vector<int64_t>& out_sizes,
+                               const std::vector<int64_t>& axes,
+                               DataType in_dtype,
+                               DataType out_dtype,
+                               std::vector<FFTConfigKey>* keys) {
+  if (use_optimized_fft_path(axes)) {
+    append_fft_configkey(in_sizes, out_sizes, axes, in_dtype, out_dtype, keys);
+  } else {
+    c2c_fft_configkeys(
+        in_sizes, {axes.begin(), axes.end() - 1}, in_dtype, keys);
+    append_fft_configkey(
+        in_sizes, out_sizes, {axes.back()}, in_dtype, out_dtype, keys);
+  }
+}
 }  // namespace detail
 
+FFTPlanCacheInfo GetFFTPlanCacheInfo(int64_t device_id) {
+  const auto& cache = detail::get_fft_plan_cache(device_id);
+  FFTPlanCacheInfo info;
+  info.size = static_cast<int64_t>(cache.size());
+  info.max_size = static_cast<int64_t>(cache.max_size());
+  info.hits = static_cast<int64_t>(cache.hits());
+  info.misses = static_cast<int64_t>(cache.misses());
+  return info;
+}
+
+void SetFFTPlanCacheMaxSize(int64_t device_id, int64_t max_size) {
+  detail::get_fft_plan_cache(device_id).resize(max_size);
+}
+
+void ClearFFTPlanCache(int64_t device_id) {
+  detail::get_fft_plan_cache(device_id).clear();
+}
+
+void WarmupFFTPlanCache(int64_t device_id,
+                        const std::vector<int64_t>& x_shape,
+                        const std::vector<int64_t>& out_shape,
+                        const std::vector<int64_t>& axes,
+                        DataType x_dtype,
+                        DataType out_dtype) {
+  PADDLE_ENFORCE_EQ(
+      x_shape.size(),
+      out_shape.size(),
+      common::errors::InvalidArgument(
+          "The ranks of the input and output of an FFT must be equal, "
+          "But received [%d] and [%d]",
+          x_shape.size(),
+          out_shape.size()));
+  for (auto axis : axes) {
+    PADDLE_ENFORCE_EQ(
+        axis >= 0 && axis < static_cast<int64_t>(x_shape.size()),
+        true,
+        common::errors::InvalidArgument(
+            "The FFT axes must be in [0, %d), But received [%d]",
+            x_shape.size(),
+            axis));
+  }
+  if (axes.empty()) {
+    return;
+  }
+
+  std::vector<detail::FFTConfigKey> keys;
+  switch (GetFFTTransformType(x_dtype, out_dtype)) {
+    case FFTTransformType::C2C:
+      detail::c2c_fft_configkeys(x_shape, axes, x_dtype, &keys);
+      break;
+    case FFTTransformType::R2C:
+      detail::r2c_fft_configkeys(
+          x_shape, out_shape, axes, x_dtype, out_dtype, &keys);
+      break;
+    case FFTTransformType::C2R:
+      detail::c2r_fft_configkeys(
+          x_shape, out_shape, axes, x_dtype, out_dtype, &keys);
+      break;
+  }
+  detail::warmup_fft_plan_cache(device_id, keys);
+}
+
 template <typename Ti, typename To>
 struct FFTC2CFunctor<phi::GPUContext, Ti, To> {
   void operator()(const phi::GPUContext& ctx,
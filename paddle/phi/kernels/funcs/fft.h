@@ -15,6 +15,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/utils/data_type.h"
@@ -99,5 +101,32 @@ struct FFTC2RFunctor {
                   FFTNormMode normalization,
                   bool forward);
 };
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// The plan cache of a device, and the lookups which found their plan (hits)
+// or built it (misses) since the process started.
+struct FFTPlanCacheInfo {
+  int64_t size;
+  int64_t max_size;
+  int64_t hits;
+  int64_t misses;
+};
+
+FFTPlanCacheInfo GetFFTPlanCacheInfo(int64_t device_id);
+
+void SetFFTPlanCacheMaxSize(int64_t device_id, int64_t max_size);
+
+void ClearFFTPlanCache(int64_t device_id);
+
+// Builds the plans which transforming the axes of an x_dtype input of x_shape
+// into an out_dtype output of out_shape looks up, the way the FFT kernels
+// split the transform, so that the first steps of a model don't build them.
+void WarmupFFTPlanCache(int64_t device_id,
+                        const std::vector<int64_t>& x_shape,
+                        const std::vector<int64_t>& out_shape,
+                        const std::vector<int64_t>& axes,
+                        DataType x_dtype,
+                        DataType out_dtype);
+#endif
 }  // namespace funcs
 }  // namespace phi
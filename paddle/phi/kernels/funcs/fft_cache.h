@@ -20,6 +20,9 @@
 #include <mutex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
+
+#include "paddle/phi/backends/gpu/gpu_info.h"
 
 #if defined(PADDLE_WITH_CUDA)
 #include "paddle/phi/kernels/funcs/cufft_util.h"
@@ -51,9 +54,13 @@ static_assert(CUFFT_DEFAULT_CACHE_SIZE >= 0 &&
                   CUFFT_DEFAULT_CACHE_SIZE <= CUFFT_MAX_PLAN_NUM,
               "CUFFT_DEFAULT_CACHE_SIZE not in [0, CUFFT_MAX_PLAN_NUM] range");
 
+// The plans of a device, the least recently used one is evicted when the
+// cache is full. The plans don't own their workspace, which is allocated
+// from the stream allocator on each execution, and an evicted plan lives on
+// until the executions that hold it finish.
 class FFTConfigCache {
  public:
-  using kv_t = typename std::pair<FFTConfigKey, FFTConfig>;
+  using kv_t = typename std::pair<FFTConfigKey, std::shared_ptr<FFTConfig>>;
   using map_t =
       typename std::unordered_map<std::reference_wrapper<FFTConfigKey>,
                                   typename std::list<kv_t>::iterator,
@@ -68,21 +75,10 @@ class FFTConfigCache {
   FFTConfigCache(const FFTConfigCache& other) = delete;
   FFTConfigCache& operator=(const FFTConfigCache& other) = delete;
 
-  FFTConfigCache(FFTConfigCache&& other) noexcept
-      : _usage_list(std::move(other._usage_list)),
-        _cache_map(std::move(other._cache_map)),
-        _max_size(other._max_size) {}
-
-  FFTConfigCache& operator=(FFTConfigCache&& other) noexcept {
-    _usage_list = std::move(other._usage_list);
-    _cache_map = std::move(other._cache_map);
-    _max_size = other._max_size;
-    return *this;
-  }
-
   // If key is in this cache, return the cached config. Otherwise, emplace the
   // config in this cache and return it.
-  FFTConfig& lookup(FFTConfigKey params) {
+  std::shared_ptr<FFTConfig> lookup(const FFTConfigKey& params) {
+    std::lock_guard<std::mutex> guard(_mutex);
     PADDLE_ENFORCE_GT(_max_size,
                       0,
                       common::errors::InvalidArgument(
@@ -93,11 +89,13 @@ class FFTConfigCache {
     map_kkv_iter_t map_it = _cache_map.find(params);
     // Hit, put to list front
     if (map_it != _cache_map.end()) {
+      ++_hits;
       _usage_list.splice(_usage_list.begin(), _usage_list, map_it->second);
       return map_it->second->second;
     }
 
     // Miss
+    ++_misses;
     // remove if needed
     if (_usage_list.size() >= _max_size) {
       auto last = _usage_list.end();
@@ -107,9 +105,7 @@ class FFTConfigCache {
     }
 
     // construct new plan at list front, then insert into _cache_map
-    _usage_list.emplace_front(std::piecewise_construct,
-                              std::forward_as_tuple(params),
-                              std::forward_as_tuple(params));
+    _usage_list.emplace_front(params, std::make_shared<FFTConfig>(params));
     auto kv_it = _usage_list.begin();
     _cache_map.emplace(std::piecewise_construct,
                        std::forward_as_tuple(kv_it->first),
@@ -117,12 +113,21 @@ class FFTConfigCache {
     return kv_it->second;
   }
 
+  // Builds the plans of the keys ahead of their first execution.
+  void warmup(const std::vector<FFTConfigKey>& keys) {
+    for (const auto& key : keys) {
+      lookup(key);
+    }
+  }
+
   void clear() {
+    std::lock_guard<std::mutex> guard(_mutex);
     _cache_map.clear();
     _usage_list.clear();
   }
 
   void resize(int64_t new_size) {
+    std::lock_guard<std::mutex> guard(_mutex);
     _set_max_size(new_size);
     auto cur_size = _usage_list.size();
     if (cur_size > _max_size) {
@@ -135,11 +140,23 @@ class FFTConfigCache {
     }
   }
 
-  size_t size() const { return _cache_map.size(); }
+  size_t size() const {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _cache_map.size();
+  }
 
   size_t max_size() const noexcept { return _max_size; }
 
-  std::mutex mutex;
+  // The number of lookups which found their plan, and which built it.
+  size_t hits() const {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _hits;
+  }
+
+  size_t misses() const {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _misses;
+  }
 
  private:
   // Only sets size and does value check. Does not resize the data structures.
@@ -166,24 +183,39 @@ class FFTConfigCache {
   std::list<kv_t> _usage_list;
   map_t _cache_map;
   size_t _max_size;
+  size_t _hits = 0;
+  size_t _misses = 0;
+  mutable std::mutex _mutex;
 };
 
-static std::vector<std::unique_ptr<FFTConfigCache>> plan_caches;
-static std::mutex plan_caches_mutex;
-
-static inline FFTConfigCache& get_fft_plan_cache(int64_t device_index) {
-  std::lock_guard<std::mutex> guard(plan_caches_mutex);
-
-  if (device_index >= plan_caches.size()) {
-    plan_caches.resize(device_index + 1);
-  }
-
-  if (!plan_caches[device_index]) {
-    plan_caches[device_index] = std::make_unique<FFTConfigCache>();
-  }
-
+// The caches of all the devices are created at once, so that looking up the
+// cache of a device doesn't lock the others.
+inline FFTConfigCache& get_fft_plan_cache(int64_t device_index) {
+  static std::vector<std::unique_ptr<FFTConfigCache>> plan_caches = [] {
+    std::vector<std::unique_ptr<FFTConfigCache>> caches(
+        phi::backends::gpu::GetGPUDeviceCount());
+    for (auto& cache : caches) {
+      cache = std::make_unique<FFTConfigCache>();
+    }
+    return caches;
+  }();
+  PADDLE_ENFORCE_LT(
+      device_index,
+      static_cast<int64_t>(plan_caches.size()),
+      common::errors::InvalidArgument(
+          "The device index of the cuFFT plan cache must be less than the "
+          "number of devices [%d], But received is [%d]",
+          plan_caches.size(),
+          device_index));
   return *plan_caches[device_index];
 }
+
+// Builds the plans of the keys in the cache of the device, for the shapes a
+// model declares ahead of its first steps.
+inline void warmup_fft_plan_cache(int64_t device_index,
+                                  const std::vector<FFTConfigKey>& keys) {
+  get_fft_plan_cache(device_index).warmup(keys);
+}
 }  // namespace detail
 }  // namespace funcs
 }  // namespace phi
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
+#include <vector>
+
 #include "paddle/phi/core/utils/data_type.h"
 #include "paddle/phi/kernels/funcs/fft.h"
 
@@ -85,28 +88,40 @@ struct KeyEqual {
   }
 };
 
-static FFTConfigKey create_fft_configkey(const DenseTensor& input,
-                                         const DenseTensor& output,
-                                         int signal_ndim) {
+// The key of the plan transforming the axes of an input of in_sizes into an
+// output of out_sizes, once the other dims are collapsed into the batch.
+static FFTConfigKey create_fft_configkey(const std::vector<int64_t>& in_sizes,
+                                         const std::vector<int64_t>& out_sizes,
+                                         const std::vector<int64_t>& axes,
+                                         DataType input_dtype,
+                                         DataType output_dtype) {
   // Create the transform plan (either from cache or locally)
-  DataType input_dtype = input.dtype();
   const auto value_type =
       IsComplexType(input_dtype) ? ToRealType(input_dtype) : input_dtype;
-  const auto fft_type = GetFFTTransformType(input.dtype(), output.dtype());
-  // signal sizes
-  std::vector<int64_t> signal_size(signal_ndim + 1);
+  const auto fft_type = GetFFTTransformType(input_dtype, output_dtype);
+  const int signal_ndim = axes.size();
+
+  std::vector<bool> is_transformed_dim(in_sizes.size(), false);
+  for (auto axis : axes) {
+    is_transformed_dim[axis] = true;
+  }
+  int64_t batch_size = 1L;
+  for (size_t i = 0; i < in_sizes.size(); ++i) {
+    if (!is_transformed_dim[i]) {
+      batch_size *= in_sizes[i];
+    }
+  }
 
-  signal_size[0] = input.dims()[0];
+  // collapsed shapes and signal sizes
+  std::vector<int64_t> in_shape(signal_ndim + 1, batch_size);
+  std::vector<int64_t> out_shape(signal_ndim + 1, batch_size);
+  std::vector<int64_t> signal_size(signal_ndim + 1, batch_size);
   for (int64_t i = 1; i <= signal_ndim; ++i) {
-    auto in_size = input.dims()[i];
-    auto out_size = output.dims()[i];
-    signal_size[i] = std::max(in_size, out_size);
+    in_shape[i] = in_sizes[axes[i - 1]];
+    out_shape[i] = out_sizes[axes[i - 1]];
+    signal_size[i] = std::max(in_shape[i], out_shape[i]);
   }
-  FFTConfigKey key(common::vectorize(input.dims()),
-                   common::vectorize(output.dims()),
-                   signal_size,
-                   fft_type,
-                   value_type);
+  FFTConfigKey key(in_shape, out_shape, signal_size, fft_type, value_type);
   return key;
 }
 
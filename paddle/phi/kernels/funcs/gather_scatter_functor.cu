@@ -15,6 +15,7 @@ limitations under the License. */
 #include "paddle/phi/kernels/funcs/gather_scatter_functor.h"
 #include "paddle/phi/backends/gpu/gpu_context.h"
 #include "paddle/phi/backends/gpu/gpu_primitives.h"
+#include "paddle/phi/kernels/autotune/auto_tune_base.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 
 namespace phi {
@@ -418,6 +419,38 @@ struct gpu_gather_scatter_functor {
                                        include_self,
                                        reduce_op,
                                        shared_mem);
+    } else if (method_name == "gather_out_gpu" && include_self) {
+      // The gather only writes self, so its block size is tuned per shape.
+      auto& dev_ctx = reinterpret_cast<const phi::GPUContext&>(ctx);
+      phi::autotune::LaunchConfigAutoTuner<tensor_t> tuner;
+      for (int block_size : {512, 128, 256, 1024}) {
+        tuner.AddCandidate([=, &reduce_op] {
+          int64_t grid_size = (n + block_size - 1) / block_size;
+          GatherScatterGPUKernel<tensor_t, index_t, func_t, is_scatter_like>
+              <<<grid_size, block_size, 0, stream>>>(self_data,
+                                                     dim,
+                                                     index_data,
+                                                     src_data,
+                                                     select_dim_size,
+                                                     self_select_dim_size,
+                                                     src_select_dim_size,
+                                                     outer_dim_size,
+                                                     outer_dim_size_self,
+                                                     outer_dim_size_src,
+                                                     index_size,
+                                                     self_size,
+                                                     include_self,
+                                                     reduce_op,
+                                                     nullptr);
+        });
+      }
+      size_t key = phi::autotune::GenKey(common::vectorize(self_dims),
+                                         common::vectorize(index_dims),
+                                         common::vectorize(src_dims),
+                                         dim,
+                                         static_cast<int64_t>(self.dtype()),
+                                         sizeof(index_t));
+      tuner.Run(dev_ctx, phi::autotune::AlgorithmType::kGather, key);
     } else {
       int* shared_mem = nullptr;
       if (include_self == false) {
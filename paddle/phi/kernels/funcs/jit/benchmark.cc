@@ -12,8 +12,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License. */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <random>
+#include <unordered_map>
 
 #include "glog/logging.h"
 #include "paddle/common/flags.h"
@@ -23,6 +27,10 @@
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/kernels/funcs/jit/kernels.h"
 
+#ifdef PADDLE_WITH_DNNL
+#include "dnnl.hpp"  // NOLINT
+#endif
+
 PD_DEFINE_int32(burning, 10, "Burning times.");
 PD_DEFINE_int32(repeat, 3000, "Repeat times.");
 PD_DEFINE_int32(max_size, 1000, "The Max size would be tested.");
@@ -380,6 +388,148 @@ void BenchKernelMatMul() {
   }
 }
 
+#ifdef PADDLE_WITH_DNNL
+// the time of the oneDNN matmul on the unpacked weight in us, as the baseline
+// of the Gemm jit kernels
+static double BenchOneDNNMatMul(dnnl::memory::data_type a_type,
+                                dnnl::memory::data_type b_type,
+                                const void* a,
+                                const void* b,
+                                float* c,
+                                int m,
+                                int n,
+                                int k) {
+  using dnnl::memory;
+  dnnl::engine engine(dnnl::engine::kind::cpu, 0);
+  dnnl::stream stream(engine);
+  memory::desc a_md({m, k}, a_type, memory::format_tag::ab);
+  memory::desc b_md({k, n}, b_type, memory::format_tag::ab);
+  memory::desc c_md({m, n}, memory::data_type::f32, memory::format_tag::ab);
+  dnnl::matmul::primitive_desc pd(engine, a_md, b_md, c_md);
+  dnnl::matmul prim(pd);
+  memory a_mem(a_md, engine, const_cast<void*>(a));
+  memory b_mem(b_md, engine, const_cast<void*>(b));
+  memory c_mem(c_md, engine, c);
+  std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, a_mem},
+                                          {DNNL_ARG_WEIGHTS, b_mem},
+                                          {DNNL_ARG_DST, c_mem}};
+  for (int i = 0; i < FLAGS_burning; ++i) {
+    prim.execute(stream, args);
+  }
+  stream.wait();
+  double start = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+  for (int i = 0; i < FLAGS_repeat; ++i) {
+    prim.execute(stream, args);
+  }
+  stream.wait();
+  double end = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+  return static_cast<double>(end - start) / FLAGS_repeat;
+}
+#endif
+
+// truncate to bf16
+static uint16_t FloatToBF16(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+std::vector<int> GemmBenchSizes() { return {16, 64, 128, 256, 512}; }
+
+template <typename KernelTuple, typename PlaceType>
+void BenchKernelGemmBF16() {
+  using T = typename KernelTuple::data_type;
+  for (int m : {1, 4, 16, 64}) {
+    for (int n : GemmBenchSizes()) {
+      for (int k : GemmBenchSizes()) {
+        std::vector<float> fa(m * k), fb(k * n);
+        RandomVec<float>(m * k, fa.data(), -2.f, 2.f);
+        RandomVec<float>(k * n, fb.data(), -2.f, 2.f);
+        std::vector<uint16_t> a(m * k), b(k * n), packed(k * n);
+        std::transform(fa.begin(), fa.end(), a.begin(), FloatToBF16);
+        std::transform(fb.begin(), fb.end(), b.begin(), FloatToBF16);
+        jit::pack_gemm_bf16_weights(b.data(), packed.data(), n, k);
+        std::vector<T> c(m * n);
+        const jit::gemm_attr_t attr{m, n, k};
+        BenchAllImpls<KernelTuple, PlaceType>(
+            attr, a.data(), packed.data(), c.data(), &attr);
+#ifdef PADDLE_WITH_DNNL
+        LOG(INFO) << "Kernel Type " << jit::to_string(KernelTuple::kernel_type)
+                  << ": " << attr << ": oneDNN takes "
+                  << BenchOneDNNMatMul(dnnl::memory::data_type::bf16,
+                                       dnnl::memory::data_type::bf16,
+                                       a.data(),
+                                       b.data(),
+                                       c.data(),
+                                       m,
+                                       n,
+                                       k)
+                  << " us";
+#endif
+      }
+    }
+  }
+}
+
+template <typename KernelTuple, typename PlaceType>
+void BenchKernelGemmInt8() {
+  using T = typename KernelTuple::data_type;
+  std::mt19937 rng(100);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (int m : {1, 4, 16, 64}) {
+    for (int n : GemmBenchSizes()) {
+      for (int k : GemmBenchSizes()) {
+        std::vector<uint8_t> a(m * k);
+        std::vector<int8_t> b(k * n), packed(k * n);
+        for (auto& x : a) {
+          x = static_cast<uint8_t>(dist(rng));
+        }
+        for (auto& x : b) {
+          x = static_cast<int8_t>(dist(rng) - 128);
+        }
+        jit::pack_gemm_int8_weights(b.data(), packed.data(), n, k);
+        std::vector<T> c(m * n);
+        const jit::gemm_attr_t attr{m, n, k};
+        BenchAllImpls<KernelTuple, PlaceType>(
+            attr, a.data(), packed.data(), c.data(), &attr);
+#ifdef PADDLE_WITH_DNNL
+        LOG(INFO) << "Kernel Type " << jit::to_string(KernelTuple::kernel_type)
+                  << ": " << attr << ": oneDNN takes "
+                  << BenchOneDNNMatMul(dnnl::memory::data_type::u8,
+                                       dnnl::memory::data_type::s8,
+                                       a.data(),
+                                       b.data(),
+                                       c.data(),
+                                       m,
+                                       n,
+                                       k)
+                  << " us";
+#endif
+      }
+    }
+  }
+}
+
+template <typename KernelTuple, typename PlaceType>
+void BenchKernelAttention() {
+  using T = typename KernelTuple::data_type;
+  for (int seq_q : {1, 16, 128}) {
+    for (int seq_kv : {16, 128, 512}) {
+      for (int head_dim : {64, 128}) {
+        std::vector<T> q(seq_q * head_dim), k(seq_kv * head_dim),
+            v(seq_kv * head_dim), out(seq_q * head_dim);
+        RandomVec<T>(q.size(), q.data(), -2.f, 2.f);
+        RandomVec<T>(k.size(), k.data(), -2.f, 2.f);
+        RandomVec<T>(v.size(), v.data(), -2.f, 2.f);
+        const float scale = 1.f / std::sqrt(static_cast<float>(head_dim));
+        const jit::attention_attr_t attr{seq_q, seq_kv, head_dim, scale};
+        BenchAllImpls<KernelTuple, PlaceType>(
+            attr, q.data(), k.data(), v.data(), out.data(), &attr);
+      }
+    }
+  }
+}
+
 template <typename KernelTuple, typename PlaceType>
 void BenchKernelLayerNorm() {
   using T = typename KernelTuple::data_type;
@@ -536,6 +686,9 @@ BENCH_FP32_CPU(CRFDecoding);
 BENCH_FP32_CPU(SeqPool);
 BENCH_FP32_CPU(EmbSeqPool);
 BENCH_FP32_CPU(MatMul);
+BENCH_FP32_CPU(GemmBF16);
+BENCH_FP32_CPU(GemmInt8);
+BENCH_FP32_CPU(Attention);
 BENCH_FP32_CPU(Sgd);
 BENCH_FP32_CPU(VBroadcast);
 
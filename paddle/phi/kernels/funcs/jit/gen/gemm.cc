@@ -0,0 +1,181 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/gen/gemm.h"
+
+#include <algorithm>
+#include <cstddef>  // offsetof
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/kernels/funcs/jit/registry.h"
+
+namespace phi::jit::gen {
+
+constexpr int kGemmTileRows = 4;
+constexpr int kGemmTileCols = 4;
+// zmm0 ~ zmm15 are the accumulators
+constexpr int kGemmBRegIdx = kGemmTileRows * kGemmTileCols;
+constexpr int kGemmARegIdx = kGemmBRegIdx + kGemmTileCols;
+constexpr int kGemmScaleRegIdx = kGemmARegIdx + 1;
+
+void GemmJitCode::genCode() {
+  preCode();
+  vbroadcastss(zmm_t(kGemmScaleRegIdx),
+               ptr[param_attr + offsetof(gemm_attr_t, scale)]);
+  mov(reg_row_a, param_a);
+  mov(reg_row_c, param_c);
+  const int a_row_bytes = is_int8_ ? k_ : k_ * 2;
+  const int full = m_ / kGemmTileRows;
+  if (full > 0) {
+    Label l_rows;
+    mov(reg_m_cnt, full);
+    L(l_rows);
+    genRows(kGemmTileRows);
+    add(reg_row_a, kGemmTileRows * a_row_bytes);
+    add(reg_row_c, kGemmTileRows * n_ * static_cast<int>(sizeof(float)));
+    dec(reg_m_cnt);
+    jnz(l_rows, T_NEAR);
+  }
+  if (m_ % kGemmTileRows != 0) {
+    genRows(m_ % kGemmTileRows);
+  }
+  postCode();
+}
+
+void GemmJitCode::genRows(int rows) {
+  const int tile_n = kGemmTileCols * ZMM_FLOAT_BLOCK;
+  for (int n_offset = 0; n_offset < n_; n_offset += tile_n) {
+    int cols = std::min(kGemmTileCols, (n_ - n_offset) / ZMM_FLOAT_BLOCK);
+    genTile(rows, n_offset, cols);
+  }
+}
+
+void GemmJitCode::genTile(int rows, int n_offset, int cols) {
+  const int a_row_bytes = is_int8_ ? k_ : k_ * 2;
+  const int block_len = sizeof(float) * ZMM_FLOAT_BLOCK;
+  for (int r = 0; r < rows; ++r) {
+    for (int c = 0; c < cols; ++c) {
+      int acc = r * kGemmTileCols + c;
+      vpxord(zmm_t(acc), zmm_t(acc), zmm_t(acc));
+    }
+  }
+  mov(reg_ptr_a, reg_row_a);
+  mov(reg_ptr_b, param_b);
+  // each k group (2 bf16 or 4 int8) of a column takes 4 bytes of packed B
+  add(reg_ptr_b, n_offset * 4);
+  mov(reg_k_cnt, is_int8_ ? k_ / 4 : k_ / 2);
+  Label l_k;
+  L(l_k);
+  for (int c = 0; c < cols; ++c) {
+    vmovups(zmm_t(kGemmBRegIdx + c), ptr[reg_ptr_b + c * block_len]);
+  }
+  for (int r = 0; r < rows; ++r) {
+    vpbroadcastd(zmm_t(kGemmARegIdx), ptr[reg_ptr_a + r * a_row_bytes]);
+    for (int c = 0; c < cols; ++c) {
+      int acc = r * kGemmTileCols + c;
+      if (is_int8_) {
+        // the unsigned bytes come first
+        vpdpbusd(zmm_t(acc), zmm_t(kGemmARegIdx), zmm_t(kGemmBRegIdx + c));
+      } else {
+        vdpbf16ps(zmm_t(acc), zmm_t(kGemmARegIdx), zmm_t(kGemmBRegIdx + c));
+      }
+    }
+  }
+  add(reg_ptr_a, 4);
+  add(reg_ptr_b, n_ * 4);
+  dec(reg_k_cnt);
+  jnz(l_k, T_NEAR);
+
+  for (int r = 0; r < rows; ++r) {
+    for (int c = 0; c < cols; ++c) {
+      int acc = r * kGemmTileCols + c;
+      if (is_int8_) {
+        vcvtdq2ps(zmm_t(acc), zmm_t(acc));
+      }
+      vmulps(zmm_t(acc), zmm_t(acc), zmm_t(kGemmScaleRegIdx));
+      vmovups(ptr[reg_row_c + (r * n_ + n_offset) * sizeof(float) +
+                  c * block_len],
+              zmm_t(acc));
+    }
+  }
+}
+
+static size_t GemmCodeSize(const gemm_attr_t& attr) {
+  const int tile_n = kGemmTileCols * ZMM_FLOAT_BLOCK;
+  // the rows of a full tile and the rest rows are generated once each
+  return 256 + 2 * 1024 * ((attr.n + tile_n - 1) / tile_n);
+}
+
+static void CheckGemmAttr(const gemm_attr_t& attr) {
+  PADDLE_ENFORCE_GT(attr.m,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The attribute m of Gemm should be larger than 0. "
+                        "But it is %d.",
+                        attr.m));
+  PADDLE_ENFORCE_GT(attr.n,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The attribute n of Gemm should be larger than 0. "
+                        "But it is %d.",
+                        attr.n));
+  PADDLE_ENFORCE_GT(attr.k,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The attribute k of Gemm should be larger than 0. "
+                        "But it is %d.",
+                        attr.k));
+}
+
+class GemmBF16Creator : public JitCodeCreator<gemm_attr_t> {
+ public:
+  bool CanBeUsed(const gemm_attr_t& attr) const override {
+    return phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f) &&
+           phi::backends::cpu::MayIUse(phi::backends::cpu::avx512_bf16) &&
+           attr.m > 0 && attr.n > 0 && attr.n % ZMM_FLOAT_BLOCK == 0 &&
+           attr.k > 0 && attr.k % 2 == 0;
+  }
+  size_t CodeSize(const gemm_attr_t& attr) const override {
+    return GemmCodeSize(attr);
+  }
+  std::unique_ptr<GenBase> CreateJitCode(
+      const gemm_attr_t& attr) const override {
+    CheckGemmAttr(attr);
+    return make_unique<GemmJitCode>(attr, false, CodeSize(attr));
+  }
+};
+
+class GemmInt8Creator : public JitCodeCreator<gemm_attr_t> {
+ public:
+  bool CanBeUsed(const gemm_attr_t& attr) const override {
+    return phi::backends::cpu::MayIUse(phi::backends::cpu::avx512_core_vnni) &&
+           attr.m > 0 && attr.n > 0 && attr.n % ZMM_FLOAT_BLOCK == 0 &&
+           attr.k > 0 && attr.k % 4 == 0;
+  }
+  size_t CodeSize(const gemm_attr_t& attr) const override {
+    return GemmCodeSize(attr);
+  }
+  std::unique_ptr<GenBase> CreateJitCode(
+      const gemm_attr_t& attr) const override {
+    CheckGemmAttr(attr);
+    return make_unique<GemmJitCode>(attr, true, CodeSize(attr));
+  }
+};
+
+}  // namespace phi::jit::gen
+
+namespace gen = phi::jit::gen;
+
+REGISTER_JITKERNEL_GEN(kGemmBF16, gen::GemmBF16Creator);
+REGISTER_JITKERNEL_GEN(kGemmInt8, gen::GemmInt8Creator);
@@ -0,0 +1,76 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/kernels/funcs/jit/gen/jitcode.h"
+
+namespace phi {
+namespace jit {
+namespace gen {
+
+// The microkernel of GemmBF16 (vdpbf16ps) and GemmInt8 (vpdpbusd). Both of
+// them multiply 4 bytes of A with 4 bytes of each column of the packed B per
+// instruction, so that they share the same blocking: the tiles of 4 rows and
+// 4 zmm (64 floats) columns are kept in 16 accumulators while the loop over k
+// streams a row of packed B.
+class GemmJitCode : public JitCode {
+ public:
+  explicit GemmJitCode(const gemm_attr_t& attr,
+                       bool is_int8,
+                       size_t code_size = 256 * 1024,
+                       void* code_ptr = nullptr)
+      : JitCode(code_size, code_ptr),
+        m_(attr.m),
+        n_(attr.n),
+        k_(attr.k),
+        is_int8_(is_int8) {
+    this->genCode();
+  }
+
+  std::string name() const override {
+    std::string base = is_int8_ ? "GemmInt8JitCode" : "GemmBF16JitCode";
+    base = base + "_M" + std::to_string(m_) + "_N" + std::to_string(n_) + "_K" +
+           std::to_string(k_);
+    return base;
+  }
+  void genCode() override;
+
+ private:
+  void genRows(int rows);
+  void genTile(int rows, int n_offset, int cols);
+
+  int m_, n_, k_;
+  bool is_int8_;
+
+  reg64_t param_a{abi_param1};
+  reg64_t param_b{abi_param2};
+  reg64_t param_c{abi_param3};
+  reg64_t param_attr{abi_param4};
+
+  reg64_t reg_ptr_a{r8};
+  reg64_t reg_ptr_b{r9};
+  reg64_t reg_k_cnt{r10};
+  reg64_t reg_row_a{r11};
+  reg64_t reg_row_c{r12};
+  reg64_t reg_m_cnt{r13};
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace phi
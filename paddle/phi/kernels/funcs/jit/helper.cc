@@ -56,6 +56,9 @@ const char* to_string(KernelType kt) {
     ONE_CASE(kLayerNorm);
     ONE_CASE(kSeqPool);
     ONE_CASE(kMatMul);
+    ONE_CASE(kGemmBF16);
+    ONE_CASE(kGemmInt8);
+    ONE_CASE(kAttention);
     ONE_CASE(kAdam);
     ONE_CASE(kAdamW);
     ONE_CASE(kEmbSeqPool);
@@ -142,6 +145,28 @@ void pack_weights<float>(const float* src, float* dst, int n, int k) {
   }
 }
 
+template <typename T>
+static void PackGemmWeights(const T* src, T* dst, int n, int k, int group) {
+  int k_groups = (k + group - 1) / group;
+  for (int g = 0; g < k_groups; ++g) {
+    for (int j = 0; j < n; ++j) {
+      for (int i = 0; i < group; ++i) {
+        int row = g * group + i;
+        dst[(g * n + j) * group + i] =
+            row < k ? src[row * n + j] : static_cast<T>(0);
+      }
+    }
+  }
+}
+
+void pack_gemm_bf16_weights(const uint16_t* src, uint16_t* dst, int n, int k) {
+  PackGemmWeights(src, dst, n, k, 2);
+}
+
+void pack_gemm_int8_weights(const int8_t* src, int8_t* dst, int n, int k) {
+  PackGemmWeights(src, dst, n, k, 4);
+}
+
 template <typename T>
 typename std::enable_if<!std::is_same<T, float>::value>::type pack_weights(
     const T* src, T* dst, int n, int k) {
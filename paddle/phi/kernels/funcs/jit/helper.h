@@ -298,9 +298,28 @@ inline std::ostream& operator<<(std::ostream& os, const matmul_attr_t& attr) {
   return os;
 }
 
+inline std::ostream& operator<<(std::ostream& os, const gemm_attr_t& attr) {
+  os << "M[" << attr.m << "],N[" << attr.n << "],K[" << attr.k << "],Scale["
+     << attr.scale << "]";
+  return os;
+}
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const attention_attr_t& attr) {
+  os << "SeqQ[" << attr.seq_q << "],SeqKV[" << attr.seq_kv << "],HeadDim["
+     << attr.head_dim << "],Scale[" << attr.scale << "]";
+  return os;
+}
+
 // expose the method to pack matmul weight
 template <typename T>
 void pack_weights(const T* src, T* dst, int n, int k);
 
+// pack the (k,n) weight of GemmBF16 to (k/2,n,2) and the one of GemmInt8 to
+// (k/4,n,4), k is padded by zeros to the multiple of 2 or 4, so dst should
+// hold n * (k+1)/2*2 or n * (k+3)/4*4 elements.
+void pack_gemm_bf16_weights(const uint16_t* src, uint16_t* dst, int n, int k);
+void pack_gemm_int8_weights(const int8_t* src, int8_t* dst, int n, int k);
+
 }  // namespace jit
 }  // namespace phi
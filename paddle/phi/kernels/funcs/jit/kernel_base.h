@@ -26,8 +26,11 @@ typedef enum {
   // sort by alphabet
   kAdam = 1,
   kAdamW,
+  kAttention,
   kCRFDecoding,
   kEmbSeqPool,
+  kGemmBF16,
+  kGemmInt8,
   kGRUH1,
   kGRUHtPart1,
   kGRUHtPart2,
@@ -317,6 +320,62 @@ struct MatMulTuple {
   typedef void (*func_type)(const T*, const T*, T*, const matmul_attr_t*);
 };
 
+// C(m,n) = scale * A(m,k) * B(k,n), where B is packed by PackGemmBF16B or
+// PackGemmInt8B so that the pairs (bf16) or quads (int8) of k lie together.
+typedef struct gemm_attr_s {
+  int m, n, k;
+  float scale{1.f};
+  gemm_attr_s() = default;
+  explicit gemm_attr_s(int m_, int n_, int k_, float scale_ = 1.f)
+      : m(m_), n(n_), k(k_), scale(scale_) {}
+} gemm_attr_t;
+
+// The bf16 values are passed as their raw 16 bit patterns.
+template <typename T>
+struct GemmBF16Tuple {
+  static constexpr KernelType kernel_type = kGemmBF16;
+  typedef T data_type;
+  typedef gemm_attr_t attr_type;
+  typedef void (*func_type)(const uint16_t*,
+                            const uint16_t*,
+                            T*,
+                            const gemm_attr_t*);
+};
+
+// A is unsigned and B is signed, the same as vpdpbusd.
+template <typename T>
+struct GemmInt8Tuple {
+  static constexpr KernelType kernel_type = kGemmInt8;
+  typedef T data_type;
+  typedef gemm_attr_t attr_type;
+  typedef void (*func_type)(const uint8_t*,
+                            const int8_t*,
+                            T*,
+                            const gemm_attr_t*);
+};
+
+// out(seq_q,head_dim) = softmax(scale * q * k^T) * v of one head, where
+// q is (seq_q,head_dim) and k, v are (seq_kv,head_dim).
+typedef struct attention_attr_s {
+  int seq_q, seq_kv, head_dim;
+  float scale;
+  attention_attr_s() = default;
+  explicit attention_attr_s(int seq_q_,
+                            int seq_kv_,
+                            int head_dim_,
+                            float scale_)
+      : seq_q(seq_q_), seq_kv(seq_kv_), head_dim(head_dim_), scale(scale_) {}
+} attention_attr_t;
+
+template <typename T>
+struct AttentionTuple {
+  static constexpr KernelType kernel_type = kAttention;
+  typedef T data_type;
+  typedef attention_attr_t attr_type;
+  typedef void (*func_type)(
+      const T*, const T*, const T*, T*, const attention_attr_t*);
+};
+
 template <typename T>
 struct CRFDecodingTuple {
   static constexpr KernelType kernel_type = kCRFDecoding;
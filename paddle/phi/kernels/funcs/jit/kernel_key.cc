@@ -55,6 +55,17 @@ int64_t JitCodeKey<matmul_attr_t>(const matmul_attr_t& attr) {
   return static_cast<int64_t>(XXH64(&attr, sizeof(int) * 3, 0));  // m, n, k
 }
 
+template <>
+int64_t JitCodeKey<gemm_attr_t>(const gemm_attr_t& attr) {
+  return static_cast<int64_t>(XXH64(&attr, sizeof(int) * 3, 0));  // m, n, k
+}
+
+template <>
+int64_t JitCodeKey<attention_attr_t>(const attention_attr_t& attr) {
+  std::array<int, 3> keys = {attr.seq_q, attr.seq_kv, attr.head_dim};
+  return static_cast<int64_t>(XXH64(keys.data(), sizeof(int) * 3, 0));
+}
+
 template <>
 int64_t JitCodeKey<emb_seq_pool_attr_t>(const emb_seq_pool_attr_t& attr) {
   return attr.table_width;
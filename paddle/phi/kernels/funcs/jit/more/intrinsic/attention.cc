@@ -0,0 +1,99 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/more/intrinsic/attention.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/kernels/funcs/jit/registry.h"
+
+namespace phi::jit::more::intrinsic {
+
+static inline float HorizontalSum(__m256 x) {
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(x),
+                          _mm256_extractf128_ps(x, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+}
+
+void Attention(const float* q,
+               const float* k,
+               const float* v,
+               float* out,
+               const attention_attr_t* attr) {
+  constexpr int block = YMM_FLOAT_BLOCK;
+  const int d = attr->head_dim;
+  std::vector<float> acc(d);
+  for (int i = 0; i < attr->seq_q; ++i) {
+    const float* qi = q + i * d;
+    float max_score = -std::numeric_limits<float>::max();
+    float sum = 0.f;
+    for (int j = 0; j < d; j += block) {
+      _mm256_storeu_ps(acc.data() + j, _mm256_setzero_ps());
+    }
+    for (int t = 0; t < attr->seq_kv; ++t) {
+      const float* kt = k + t * d;
+      const float* vt = v + t * d;
+      __m256 dot = _mm256_setzero_ps();
+      for (int j = 0; j < d; j += block) {
+        dot = _mm256_add_ps(
+            dot,
+            _mm256_mul_ps(_mm256_loadu_ps(qi + j), _mm256_loadu_ps(kt + j)));
+      }
+      float score = attr->scale * HorizontalSum(dot);
+      // rescale the accumulated rows when the running max grows
+      if (score > max_score) {
+        float correction = std::exp(max_score - score);
+        __m256 c = _mm256_set1_ps(correction);
+        for (int j = 0; j < d; j += block) {
+          _mm256_storeu_ps(acc.data() + j,
+                           _mm256_mul_ps(_mm256_loadu_ps(acc.data() + j), c));
+        }
+        sum *= correction;
+        max_score = score;
+      }
+      float p = std::exp(score - max_score);
+      sum += p;
+      __m256 vp = _mm256_set1_ps(p);
+      for (int j = 0; j < d; j += block) {
+        _mm256_storeu_ps(
+            acc.data() + j,
+            _mm256_add_ps(_mm256_loadu_ps(acc.data() + j),
+                          _mm256_mul_ps(vp, _mm256_loadu_ps(vt + j))));
+      }
+    }
+    __m256 inv = _mm256_set1_ps(1.f / sum);
+    float* oi = out + i * d;
+    for (int j = 0; j < d; j += block) {
+      _mm256_storeu_ps(oi + j,
+                       _mm256_mul_ps(_mm256_loadu_ps(acc.data() + j), inv));
+    }
+  }
+}
+
+bool AttentionKernel::CanBeUsed(const attention_attr_t& attr) const {
+  return phi::backends::cpu::MayIUse(phi::backends::cpu::avx) &&
+         attr.head_dim > 0 && attr.head_dim % YMM_FLOAT_BLOCK == 0 &&
+         attr.seq_kv > 0;
+}
+
+}  // namespace phi::jit::more::intrinsic
+
+namespace intrinsic = phi::jit::more::intrinsic;
+
+REGISTER_JITKERNEL_MORE(kAttention, intrinsic, intrinsic::AttentionKernel);
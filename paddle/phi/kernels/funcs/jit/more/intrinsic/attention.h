@@ -0,0 +1,45 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <type_traits>
+
+#include "paddle/phi/kernels/funcs/jit/kernel_base.h"
+
+namespace phi {
+namespace jit {
+namespace more {
+namespace intrinsic {
+
+// QK^T, softmax and V are fused by the online softmax, so that the scores of
+// a query row are never written out.
+void Attention(const float* q,
+               const float* k,
+               const float* v,
+               float* out,
+               const attention_attr_t* attr);
+
+class AttentionKernel : public KernelMore<AttentionTuple<float>> {
+ public:
+  AttentionKernel() { this->func = Attention; }
+  bool CanBeUsed(
+      const typename AttentionTuple<float>::attr_type&) const override;
+  const char* ImplType() const override { return "Intrinsic"; }
+};
+
+}  // namespace intrinsic
+}  // namespace more
+}  // namespace jit
+}  // namespace phi
@@ -49,6 +49,9 @@ REGISTER_REFER_KERNEL(CRFDecoding);
 REGISTER_REFER_KERNEL(LayerNorm);
 REGISTER_REFER_KERNEL(SeqPool);
 REGISTER_REFER_KERNEL(MatMul);
+REGISTER_REFER_KERNEL(GemmBF16);
+REGISTER_REFER_KERNEL(GemmInt8);
+REGISTER_REFER_KERNEL(Attention);
 REGISTER_REFER_KERNEL(EmbSeqPool);
 REGISTER_REFER_KERNEL(Adam);
 REGISTER_REFER_KERNEL(AdamW);
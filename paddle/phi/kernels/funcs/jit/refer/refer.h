@@ -14,9 +14,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/kernels/funcs/jit/helper.h"
@@ -394,6 +397,92 @@ void MatMul(const T* A, const T* B, T* C, const matmul_attr_t* attr) {
   }
 }
 
+inline float BF16ToFloat(uint16_t x) {
+  uint32_t bits = static_cast<uint32_t>(x) << 16;
+  float res;
+  std::memcpy(&res, &bits, sizeof(res));
+  return res;
+}
+
+// A(M,K) * B(K,N) = C(M,N), B is packed as (K/2, N, 2) by
+// pack_gemm_bf16_weights
+template <typename T>
+void GemmBF16(const uint16_t* A,
+              const uint16_t* B,
+              T* C,
+              const gemm_attr_t* attr) {
+  int M = attr->m;
+  int N = attr->n;
+  int K = attr->k;
+  for (int m = 0; m < M; ++m) {
+    for (int n = 0; n < N; ++n) {
+      T sum = static_cast<T>(0);
+      for (int k = 0; k < K; ++k) {
+        sum += static_cast<T>(BF16ToFloat(A[m * K + k])) *
+               static_cast<T>(BF16ToFloat(B[((k / 2) * N + n) * 2 + k % 2]));
+      }
+      C[m * N + n] = static_cast<T>(attr->scale) * sum;
+    }
+  }
+}
+
+// A(M,K) * B(K,N) = C(M,N), B is packed as (K/4, N, 4) by
+// pack_gemm_int8_weights
+template <typename T>
+void GemmInt8(const uint8_t* A,
+              const int8_t* B,
+              T* C,
+              const gemm_attr_t* attr) {
+  int M = attr->m;
+  int N = attr->n;
+  int K = attr->k;
+  for (int m = 0; m < M; ++m) {
+    for (int n = 0; n < N; ++n) {
+      int32_t sum = 0;
+      for (int k = 0; k < K; ++k) {
+        sum += static_cast<int32_t>(A[m * K + k]) *
+               static_cast<int32_t>(B[((k / 4) * N + n) * 4 + k % 4]);
+      }
+      C[m * N + n] = static_cast<T>(attr->scale) * static_cast<T>(sum);
+    }
+  }
+}
+
+template <typename T>
+void Attention(const T* q,
+               const T* k,
+               const T* v,
+               T* out,
+               const attention_attr_t* attr) {
+  int D = attr->head_dim;
+  std::vector<T> scores(attr->seq_kv);
+  for (int i = 0; i < attr->seq_q; ++i) {
+    const T* qi = q + i * D;
+    T max_score = -std::numeric_limits<T>::max();
+    for (int j = 0; j < attr->seq_kv; ++j) {
+      T dot = static_cast<T>(0);
+      for (int d = 0; d < D; ++d) {
+        dot += qi[d] * k[j * D + d];
+      }
+      scores[j] = static_cast<T>(attr->scale) * dot;
+      max_score = std::max(max_score, scores[j]);
+    }
+    T sum = static_cast<T>(0);
+    for (int j = 0; j < attr->seq_kv; ++j) {
+      scores[j] = std::exp(scores[j] - max_score);
+      sum += scores[j];
+    }
+    T* oi = out + i * D;
+    for (int d = 0; d < D; ++d) {
+      T res = static_cast<T>(0);
+      for (int j = 0; j < attr->seq_kv; ++j) {
+        res += scores[j] * v[j * D + d];
+      }
+      oi[d] = res / sum;
+    }
+  }
+}
+
 // embedding seq pool
 // table is a matrix with (tbl_h, tbl_w)
 // idx is a matrix with (idx_h, idx_w)
@@ -602,6 +691,9 @@ DECLARE_REFER_KERNEL(CRFDecoding);
 DECLARE_REFER_KERNEL(LayerNorm);
 DECLARE_REFER_KERNEL(SeqPool);
 DECLARE_REFER_KERNEL(MatMul);
+DECLARE_REFER_KERNEL(GemmBF16);
+DECLARE_REFER_KERNEL(GemmInt8);
+DECLARE_REFER_KERNEL(Attention);
 DECLARE_REFER_KERNEL(EmbSeqPool);
 DECLARE_REFER_KERNEL(Adam);
 DECLARE_REFER_KERNEL(AdamW);
@@ -12,7 +12,10 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <random>
 
@@ -693,6 +696,130 @@ void TestKernelMatMul() {
   FLAGS_acc = last_acc;
 }
 
+static uint16_t FloatToBF16(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+template <typename KernelTuple, typename PlaceType>
+void TestKernelGemmBF16() {
+  using T = typename KernelTuple::data_type;
+  VLOG(10) << "Test JITKernel: " << jit::to_string(KernelTuple::kernel_type);
+  auto last_acc = FLAGS_acc;
+  FLAGS_acc = 1e-3;
+  for (int m : {1, 3, 4, 9}) {
+    for (int n : {7, 16, 48, 80, 128}) {
+      for (int k : {2, 3, 8, 36, 128}) {
+        auto ref = jit::GetReferFunc<KernelTuple>();
+        EXPECT_TRUE(ref != nullptr);
+        std::vector<float> fa(m * k), fb(k * n);
+        RandomVec<float>(m * k, fa.data());
+        RandomVec<float>(k * n, fb.data());
+        std::vector<uint16_t> a(m * k), b(k * n), packed((k + 1) / 2 * 2 * n);
+        std::transform(fa.begin(), fa.end(), a.begin(), FloatToBF16);
+        std::transform(fb.begin(), fb.end(), b.begin(), FloatToBF16);
+        jit::pack_gemm_bf16_weights(b.data(), packed.data(), n, k);
+        std::vector<T> c(m * n);
+        const jit::gemm_attr_t attr{m, n, k, 0.5f};
+        ref(a.data(), packed.data(), c.data(), &attr);
+        auto verifier = [](const typename KernelTuple::func_type tgt,
+                           const std::vector<uint16_t>& a,
+                           const std::vector<uint16_t>& b,
+                           const std::vector<T>& cref,
+                           const typename KernelTuple::attr_type& attr) {
+          EXPECT_TRUE(tgt != nullptr);
+          std::vector<T> c(cref.size());
+          tgt(a.data(), b.data(), c.data(), &attr);
+          ExpectEQ<T>(c.data(), cref.data(), attr.m * attr.n);
+        };
+        TestAllImpls<KernelTuple, PlaceType>(
+            attr, verifier, a, packed, c, attr);
+      }
+    }
+  }
+  FLAGS_acc = last_acc;
+}
+
+template <typename KernelTuple, typename PlaceType>
+void TestKernelGemmInt8() {
+  using T = typename KernelTuple::data_type;
+  VLOG(10) << "Test JITKernel: " << jit::to_string(KernelTuple::kernel_type);
+  std::mt19937 rng(100);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (int m : {1, 3, 4, 9}) {
+    for (int n : {7, 16, 48, 80, 128}) {
+      for (int k : {3, 4, 36, 128}) {
+        auto ref = jit::GetReferFunc<KernelTuple>();
+        EXPECT_TRUE(ref != nullptr);
+        std::vector<uint8_t> a(m * k);
+        std::vector<int8_t> b(k * n), packed((k + 3) / 4 * 4 * n);
+        for (auto& x : a) {
+          x = static_cast<uint8_t>(dist(rng));
+        }
+        for (auto& x : b) {
+          x = static_cast<int8_t>(dist(rng) - 128);
+        }
+        jit::pack_gemm_int8_weights(b.data(), packed.data(), n, k);
+        std::vector<T> c(m * n);
+        // the products are exact in float, so the scale is a power of 2
+        const jit::gemm_attr_t attr{m, n, k, 0.25f};
+        ref(a.data(), packed.data(), c.data(), &attr);
+        auto verifier = [](const typename KernelTuple::func_type tgt,
+                           const std::vector<uint8_t>& a,
+                           const std::vector<int8_t>& b,
+                           const std::vector<T>& cref,
+                           const typename KernelTuple::attr_type& attr) {
+          EXPECT_TRUE(tgt != nullptr);
+          std::vector<T> c(cref.size());
+          tgt(a.data(), b.data(), c.data(), &attr);
+          ExpectEQ<T>(c.data(), cref.data(), attr.m * attr.n);
+        };
+        TestAllImpls<KernelTuple, PlaceType>(
+            attr, verifier, a, packed, c, attr);
+      }
+    }
+  }
+}
+
+template <typename KernelTuple, typename PlaceType>
+void TestKernelAttention() {
+  using T = typename KernelTuple::data_type;
+  VLOG(10) << "Test JITKernel: " << jit::to_string(KernelTuple::kernel_type);
+  auto last_acc = FLAGS_acc;
+  FLAGS_acc = 1e-4;
+  for (int seq_q : {1, 5, 16}) {
+    for (int seq_kv : {1, 7, 64}) {
+      for (int head_dim : {3, 8, 64}) {
+        auto ref = jit::GetReferFunc<KernelTuple>();
+        EXPECT_TRUE(ref != nullptr);
+        std::vector<T> q(seq_q * head_dim), k(seq_kv * head_dim),
+            v(seq_kv * head_dim), out(seq_q * head_dim);
+        RandomVec<T>(q.size(), q.data());
+        RandomVec<T>(k.size(), k.data());
+        RandomVec<T>(v.size(), v.data());
+        const float scale = 1.f / std::sqrt(static_cast<float>(head_dim));
+        const jit::attention_attr_t attr{seq_q, seq_kv, head_dim, scale};
+        ref(q.data(), k.data(), v.data(), out.data(), &attr);
+        auto verifier = [](const typename KernelTuple::func_type tgt,
+                           const std::vector<T>& q,
+                           const std::vector<T>& k,
+                           const std::vector<T>& v,
+                           const std::vector<T>& oref,
+                           const typename KernelTuple::attr_type& attr) {
+          EXPECT_TRUE(tgt != nullptr);
+          std::vector<T> out(oref.size());
+          tgt(q.data(), k.data(), v.data(), out.data(), &attr);
+          ExpectEQ<T>(out.data(), oref.data(), oref.size());
+        };
+        TestAllImpls<KernelTuple, PlaceType>(
+            attr, verifier, q, k, v, out, attr);
+      }
+    }
+  }
+  FLAGS_acc = last_acc;
+}
+
 template <typename KernelTuple, typename PlaceType>
 void TestKernelAdam() {
   using T = typename KernelTuple::data_type;
@@ -1468,6 +1595,9 @@ TEST_CPU_KERNEL(CRFDecoding);
 TEST_CPU_KERNEL(SeqPool);
 TEST_CPU_KERNEL(EmbSeqPool);
 TEST_CPU_KERNEL(MatMul);
+TEST_CPU_KERNEL(GemmBF16);
+TEST_CPU_KERNEL(GemmInt8);
+TEST_CPU_KERNEL(Attention);
 TEST_CPU_KERNEL(Adam);
 TEST_CPU_KERNEL(AdamW);
 TEST_CPU_KERNEL(Sgd);
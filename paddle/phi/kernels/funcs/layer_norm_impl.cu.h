@@ -31,6 +31,7 @@ namespace cub = hipcub;
 #include "paddle/phi/backends/gpu/gpu_device_function.h"
 #include "paddle/phi/backends/gpu/gpu_dnn.h"
 #include "paddle/phi/common/memory_utils.h"
+#include "paddle/phi/kernels/autotune/auto_tune_base.h"
 #include "paddle/phi/kernels/funcs/aligned_vector.h"
 #include "paddle/phi/kernels/funcs/fake_quantize_functor.h"
 
@@ -129,6 +130,32 @@ __forceinline__ __device__ U BlockReduceSum(U val, U *shared) {
   FIXED_BLOCK_DIM_FIXED_BLOCK_NUM_CASE_BASE(                                  \
       1, feature_size, kMaxBlockNum, ##__VA_ARGS__)
 
+// Launches a kernel taking one row per block, such as LayerNormForward, with
+// launch(block_dim). GetDesiredBlockDim only picks the warp size or 512, so
+// the block dims between them are tuned per shape for the odd feature sizes.
+template <typename T, typename Context, typename LaunchFunc>
+void LaunchWithTunedBlockDim(const Context& dev_ctx,
+                             const phi::autotune::AlgorithmType& algo,
+                             int64_t batch_size,
+                             int64_t feature_size,
+                             bool is_same_type,
+                             const LaunchFunc& launch) {
+  int desired_block_dim = GetDesiredBlockDim(feature_size);
+  phi::autotune::LaunchConfigAutoTuner<T> tuner;
+  tuner.AddCandidate([&] { launch(desired_block_dim); });
+  for (int block_dim : {128, 256, 512}) {
+    if (block_dim != desired_block_dim && block_dim / 2 < feature_size) {
+      tuner.AddCandidate([&, block_dim] { launch(block_dim); });
+    }
+  }
+  size_t key = phi::autotune::GenKey(
+      batch_size,
+      feature_size,
+      is_same_type,
+      static_cast<int64_t>(phi::CppTypeToDataType<T>::Type()));
+  tuner.Run(dev_ctx, algo, key);
+}
+
 static __device__ __forceinline__ float real_sqrt(float x) { return sqrtf(x); }
 static __device__ __forceinline__ double real_sqrt(double x) {
   return ::sqrt(x);
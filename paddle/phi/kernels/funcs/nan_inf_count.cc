@@ -0,0 +1,34 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/nan_inf_count.h"
+
+namespace phi {
+namespace funcs {
+
+std::atomic<int64_t>* CpuNanInfCounter() {
+  static std::atomic<int64_t> counter{0};
+  return &counter;
+}
+
+int64_t FetchNanInfCount() {
+  int64_t count = CpuNanInfCounter()->exchange(0);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  count += FetchGpuNanInfCount();
+#endif
+  return count;
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,143 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/nan_inf_count.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#include "paddle/phi/common/complex.h"
+#include "paddle/phi/common/memory_utils.h"
+
+namespace phi {
+namespace funcs {
+
+using NanInfCountType = unsigned long long;  // NOLINT
+
+// The counter of each GPU, followed by the slot of its fetched value.
+struct GpuNanInfCounters {
+  std::mutex mutex;
+  std::vector<phi::Allocator::AllocationPtr> counters;
+};
+
+static GpuNanInfCounters* GetGpuNanInfCounters() {
+  static GpuNanInfCounters counters;
+  return &counters;
+}
+
+static NanInfCountType* GetGpuNanInfCounter(int dev_id, bool create) {
+  auto* counters = GetGpuNanInfCounters();
+  std::lock_guard<std::mutex> guard(counters->mutex);
+  if (counters->counters.empty()) {
+    counters->counters.resize(phi::backends::gpu::GetGPUDeviceCount());
+  }
+  auto& counter = counters->counters.at(dev_id);
+  if (counter == nullptr) {
+    if (!create) {
+      return nullptr;
+    }
+    phi::backends::gpu::GPUDeviceGuard device_guard(dev_id);
+    counter = phi::memory_utils::Alloc(phi::GPUPlace(dev_id),
+                                       2 * sizeof(NanInfCountType));
+#ifdef __HIPCC__
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        hipMemset(counter->ptr(), 0, 2 * sizeof(NanInfCountType)));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(
+        cudaMemset(counter->ptr(), 0, 2 * sizeof(NanInfCountType)));
+#endif
+  }
+  return reinterpret_cast<NanInfCountType*>(counter->ptr());
+}
+
+template <typename T, typename MT>
+__global__ void CountNanInf(const T* data,
+                            const int64_t numel,
+                            NanInfCountType* counter) {
+  NanInfCountType count = 0;
+  for (int64_t i = threadIdx.x + static_cast<int64_t>(blockIdx.x) * blockDim.x;
+       i < numel;
+       i += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    MT value = static_cast<MT>(data[i]);
+    if (isnan(value) || isinf(value)) {
+      ++count;
+    }
+  }
+  // Only the threads which find NaN or Inf touch the counter.
+  if (count > 0) {
+    atomicAdd(counter, count);
+  }
+}
+
+__global__ void ExchangeNanInfCount(NanInfCountType* counter) {
+  counter[1] = atomicExch(counter, static_cast<NanInfCountType>(0));
+}
+
+template <typename T>
+void AccumulateNanInfCount(const phi::GPUContext& ctx,
+                           const DenseTensor& tensor) {
+  if (tensor.numel() <= 0) return;
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  NanInfCountType* counter =
+      GetGpuNanInfCounter(tensor.place().GetDeviceId(), true);
+  const int64_t threads = 512;
+  const int64_t blocks =
+      std::min(static_cast<int64_t>(ctx.GetSMCount()) * 2,
+               (tensor.numel() + threads - 1) / threads);
+  CountNanInf<T, MT><<<blocks, threads, 0, ctx.stream()>>>(
+      tensor.data<T>(), tensor.numel(), counter);
+}
+
+int64_t FetchGpuNanInfCount() {
+  int64_t count = 0;
+  int dev_count = phi::backends::gpu::GetGPUDeviceCount();
+  for (int dev_id = 0; dev_id < dev_count; ++dev_id) {
+    NanInfCountType* counter = GetGpuNanInfCounter(dev_id, false);
+    if (counter == nullptr) continue;
+    phi::backends::gpu::GPUDeviceGuard device_guard(dev_id);
+    phi::GPUPlace place(dev_id);
+    auto* ctx = static_cast<phi::GPUContext*>(
+        phi::DeviceContextPool::Instance().Get(place));
+    ExchangeNanInfCount<<<1, 1, 0, ctx->stream()>>>(counter);
+    NanInfCountType value = 0;
+    phi::memory_utils::Copy(phi::CPUPlace(),
+                            &value,
+                            place,
+                            counter + 1,
+                            sizeof(NanInfCountType),
+                            ctx->stream());
+    ctx->Wait();
+    count += static_cast<int64_t>(value);
+  }
+  return count;
+}
+
+#define INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(T)                   \
+  template void AccumulateNanInfCount<T>(const phi::GPUContext&, \
+                                         const DenseTensor&)
+
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(float);
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(double);
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(phi::dtype::float16);
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(phi::dtype::bfloat16);
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(phi::dtype::complex<float>);
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(phi::dtype::complex<double>);
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(phi::dtype::float8_e4m3fn);
+INSTANTIATE_ACCUMULATE_NAN_INF_COUNT(phi::dtype::float8_e5m2);
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/common/amp_type_traits.h"
+#include "paddle/phi/core/dense_tensor.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#endif
+
+/* The asynchronous checking of NaN and Inf, see FLAGS_check_nan_inf_async.
+Each check adds the number of NaN and Inf elements of a tensor to a counter
+of its device, in the memory of the device for GPU, without copying it to the
+host or waiting for the stream, and the counters are fetched once in a while,
+e.g. once per step. Which op produced them is not known. */
+
+namespace phi {
+namespace funcs {
+
+std::atomic<int64_t>* CpuNanInfCounter();
+
+template <typename T>
+void AccumulateNanInfCount(const phi::CPUContext& ctx UNUSED,
+                           const DenseTensor& tensor) {
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  using std::isinf;
+  using std::isnan;
+  const T* data = tensor.data<T>();
+  int64_t count = 0;
+  for (int64_t i = 0; i < tensor.numel(); ++i) {
+    MT value = static_cast<MT>(data[i]);
+    if (isnan(value) || isinf(value)) {
+      ++count;
+    }
+  }
+  if (count > 0) {
+    CpuNanInfCounter()->fetch_add(count);
+  }
+}
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+// Adds to the counter of the device of tensor on the stream of ctx.
+template <typename T>
+void AccumulateNanInfCount(const phi::GPUContext& ctx,
+                           const DenseTensor& tensor);
+
+// Returns the sum of the counters of the GPUs and resets them, waiting for
+// the default streams of the GPUs.
+int64_t FetchGpuNanInfCount();
+#endif
+
+// Returns the number of NaN and Inf elements counted on all the devices since
+// the last fetch.
+int64_t FetchNanInfCount();
+
+}  // namespace funcs
+}  // namespace phi
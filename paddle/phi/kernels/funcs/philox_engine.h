@@ -0,0 +1,210 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+#include "paddle/phi/common/amp_type_traits.h"
+#include "paddle/phi/core/generator.h"
+
+namespace phi {
+namespace funcs {
+
+// The Philox4x32-10 counter-based engine, as in curand. The numbers of a
+// counter only depend on the seed and the counter, so that the elements of
+// a tensor can be generated in any order and by any number of threads.
+class Philox4x32 {
+ public:
+  using Result = std::array<uint32_t, 4>;
+
+  explicit Philox4x32(uint64_t seed)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+
+  // The 4 numbers of the counter, the ones curand generates after skipping
+  // 4 * counter numbers of subsequence 0.
+  Result operator()(uint64_t counter) const {
+    Result ctr = {static_cast<uint32_t>(counter),
+                  static_cast<uint32_t>(counter >> 32),
+                  0,
+                  0};
+    std::array<uint32_t, 2> key = key_;
+    for (int i = 0; i < 9; ++i) {
+      ctr = Round(ctr, key);
+      key[0] += kW0;
+      key[1] += kW1;
+    }
+    return Round(ctr, key);
+  }
+
+ private:
+  static constexpr uint32_t kM0 = 0xD2511F53;
+  static constexpr uint32_t kM1 = 0xCD9E8D57;
+  static constexpr uint32_t kW0 = 0x9E3779B9;
+  static constexpr uint32_t kW1 = 0xBB67AE85;
+
+  static Result Round(const Result& ctr, const std::array<uint32_t, 2>& key) {
+    uint64_t prod0 = static_cast<uint64_t>(kM0) * ctr[0];
+    uint64_t prod1 = static_cast<uint64_t>(kM1) * ctr[2];
+    return {static_cast<uint32_t>(prod1 >> 32) ^ ctr[1] ^ key[0],
+            static_cast<uint32_t>(prod1),
+            static_cast<uint32_t>(prod0 >> 32) ^ ctr[3] ^ key[1],
+            static_cast<uint32_t>(prod0)};
+  }
+
+  std::array<uint32_t, 2> key_;
+};
+
+// A float in (0, 1], as curand_uniform.
+inline float PhiloxToFloat(uint32_t x) {
+  constexpr float kScale = 2.3283064e-10f;
+  return x * kScale + kScale / 2.0f;
+}
+
+// A double in (0, 1], as curand_uniform_double.
+inline double PhiloxToDouble(uint32_t x, uint32_t y) {
+  constexpr double kScale = 1.1102230246251565e-16;
+  uint64_t z = static_cast<uint64_t>(x) ^ (static_cast<uint64_t>(y) << 21);
+  return z * kScale + kScale / 2.0;
+}
+
+// The uniform numbers in (0, 1] of one counter, 4 floats or 2 doubles.
+template <typename T>
+struct PhiloxUniform {
+  static constexpr int kNumPerCounter = 4;
+
+  static std::array<T, kNumPerCounter> Generate(const Philox4x32& engine,
+                                                uint64_t counter) {
+    auto x = engine(counter);
+    return {PhiloxToFloat(x[0]),
+            PhiloxToFloat(x[1]),
+            PhiloxToFloat(x[2]),
+            PhiloxToFloat(x[3])};
+  }
+};
+
+template <>
+struct PhiloxUniform<double> {
+  static constexpr int kNumPerCounter = 2;
+
+  static std::array<double, kNumPerCounter> Generate(const Philox4x32& engine,
+                                                     uint64_t counter) {
+    auto x = engine(counter);
+    return {PhiloxToDouble(x[0], x[1]), PhiloxToDouble(x[2], x[3])};
+  }
+};
+
+// The normal numbers of one counter by the Box-Muller transform of its
+// uniform numbers, as curand_normal4 and curand_normal2_double.
+template <typename T>
+std::array<T, PhiloxUniform<T>::kNumPerCounter> PhiloxNormal(
+    const Philox4x32& engine, uint64_t counter) {
+  auto u = PhiloxUniform<T>::Generate(engine, counter);
+  std::array<T, PhiloxUniform<T>::kNumPerCounter> result;
+  for (int i = 0; i < PhiloxUniform<T>::kNumPerCounter; i += 2) {
+    T radius = std::sqrt(static_cast<T>(-2.0) * std::log(u[i]));
+    T theta = static_cast<T>(6.283185307179586) * u[i + 1];
+    result[i] = radius * std::sin(theta);
+    result[i + 1] = radius * std::cos(theta);
+  }
+  return result;
+}
+
+// The offset of the generator to reserve for size elements of type T, in
+// numbers of 32 bits like the GPU kernels, a multiple of 4.
+template <typename T>
+uint64_t PhiloxOffsetIncrement(int64_t size) {
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  constexpr int64_t kNum = PhiloxUniform<MT>::kNumPerCounter;
+  return static_cast<uint64_t>((size + kNum - 1) / kNum) * 4;
+}
+
+// The seed and the first counter of size elements of type T. A nonzero seed
+// of the op starts from counter 0, as a freshly seeded engine does.
+template <typename T>
+std::pair<uint64_t, uint64_t> GetPhiloxSeedAndCounter(Generator* gen,
+                                                      int seed,
+                                                      int64_t size) {
+  if (seed) {
+    return {static_cast<uint64_t>(seed), 0};
+  }
+  auto seed_offset = gen->IncrementOffset(PhiloxOffsetIncrement<T>(size));
+  return {seed_offset.first, (seed_offset.second + 3) / 4};
+}
+
+// Calls func(i, u) with the uniform number u in (0, 1] of each of the size
+// elements, in parallel. Element i takes number i % n of counter
+// first_counter + i / n, where n is the number of numbers per counter.
+template <typename MT, typename Func>
+void PhiloxForEachUniform(int64_t size,
+                          uint64_t seed,
+                          uint64_t first_counter,
+                          Func func) {
+  constexpr int64_t kNum = PhiloxUniform<MT>::kNumPerCounter;
+  Philox4x32 engine(seed);
+  int64_t num_counters = (size + kNum - 1) / kNum;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t c = 0; c < num_counters; ++c) {
+    auto u = PhiloxUniform<MT>::Generate(engine, first_counter + c);
+    for (int64_t j = 0; j < kNum && c * kNum + j < size; ++j) {
+      func(c * kNum + j, u[j]);
+    }
+  }
+}
+
+template <typename T>
+void PhiloxUniformDistribution(T* data,
+                               int64_t size,
+                               float min,
+                               float max,
+                               uint64_t seed,
+                               uint64_t first_counter) {
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  MT low = static_cast<MT>(min);
+  MT range = static_cast<MT>(max) - low;
+  PhiloxForEachUniform<MT>(size, seed, first_counter, [&](int64_t i, MT u) {
+    data[i] = static_cast<T>(u * range + low);
+  });
+}
+
+template <typename T>
+void PhiloxNormalDistribution(T* data,
+                              int64_t size,
+                              float mean,
+                              float std,
+                              uint64_t seed,
+                              uint64_t first_counter) {
+  using MT = typename phi::dtype::MPTypeTrait<T>::Type;
+  constexpr int64_t kNum = PhiloxUniform<MT>::kNumPerCounter;
+  Philox4x32 engine(seed);
+  int64_t num_counters = (size + kNum - 1) / kNum;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t c = 0; c < num_counters; ++c) {
+    auto n = PhiloxNormal<MT>(engine, first_counter + c);
+    for (int64_t j = 0; j < kNum && c * kNum + j < size; ++j) {
+      data[c * kNum + j] = static_cast<T>(n[j] * static_cast<MT>(std) +
+                                          static_cast<MT>(mean));
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
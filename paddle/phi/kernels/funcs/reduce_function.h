@@ -37,6 +37,7 @@ namespace cub = hipcub;
 #include "paddle/phi/backends/gpu/gpu_device_function.h"
 #include "paddle/phi/backends/gpu/gpu_info.h"
 #include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/kernels/autotune/auto_tune_base.h"
 #endif
 
 #include "paddle/phi/kernels/cast_kernel.h"
@@ -250,6 +251,9 @@ struct ReduceConfig {
   bool should_reduce_again = false;
   bool reduce_last_dim = false;
   bool vectorize_input = false;
+  // Scales the number of splits of the reduce dims chosen by the heuristic
+  // by 2^split_shift, for the autotune.
+  int split_shift = 0;
   MPType* tmp_data;
   dim3 block;
   dim3 grid;
@@ -488,9 +492,16 @@ struct ReduceConfig {
         details::CeilingDiv(reduce_num_per_thread, max_reduce_num_per_thread);
     int input_split_num_3 = details::CeilingDiv(max_num_blocks, grid_num);
 
+    int split_num = std::max(std::min(input_split_num_1, input_split_num_3),
+                             input_split_num_2);
+    if (split_shift > 0) {
+      split_num = std::max(
+          split_num, std::min(split_num << split_shift, reduce_num_per_thread));
+    } else if (split_shift < 0) {
+      split_num = std::max(split_num >> -split_shift, 1);
+    }
     grid_dim->x = grid_num;
-    grid_dim->y = std::max(std::min(input_split_num_1, input_split_num_3),
-                           input_split_num_2);
+    grid_dim->y = split_num;
     // if grid.y > 1, we need launch reduce kernel again.
     if (grid_dim->y > 1) {
       should_reduce_again = true;
@@ -525,6 +536,12 @@ struct ReduceConfig {
       } else if (blocking_size * 2 < reduce_num) {
         blocking_size *= 2;
       }
+      if (split_shift > 0) {
+        blocking_size = std::max(blocking_size >> split_shift, 1);
+      } else if (split_shift < 0) {
+        blocking_size = std::min(blocking_size << -split_shift,
+                                 details::GetLastPow2(reduce_num));
+      }
       should_reduce_again = true;
       grid_dim->y = details::CeilingDiv(reduce_num, blocking_size);
     }
@@ -1073,13 +1090,6 @@ void ReduceKernel(const KPDevice& dev_ctx,
   auto config = ReduceConfig<Ty, MPType>(origin_reduce_dims, x_dim);
   config.Run(dev_ctx);
   int numel = x.numel();
-  // after config.run()
-  // SetOutputData for ReduceHigherDim when should_reduce_again is true,
-  // temp_output should be stored temp_data in output_data space or stored in
-  // y_data;
-
-  phi::DDim tmp_ddim;
-  phi::DenseTensor tmp;
 
   auto x_data = x.data<Tx>();
   auto y_data = y->data<Ty>();
@@ -1091,7 +1101,6 @@ void ReduceKernel(const KPDevice& dev_ctx,
     return;
   }
 
-  config.SetOutputData(y_data, dev_ctx, &tmp);
   constexpr bool kIsTxFP16 = std::is_same<Tx, phi::dtype::float16>::value;
   constexpr bool kIsTxBF16 = std::is_same<Tx, phi::dtype::bfloat16>::value;
   bool use_cub_reduce = config.reduce_num == numel && !kIsTxFP16 && !kIsTxBF16;
@@ -1105,96 +1114,128 @@ void ReduceKernel(const KPDevice& dev_ctx,
 #endif
 
   auto reducer = ReduceOp<MPType>();
-  // launch ReduceHigherDimKernel
-  // when reduce_dim.size() == 1 and reduce_dim[0] != x_dim.size() - 1, this
-  // function will be used
-  // eg: x_dim = {nz, ny, nx}, nx != 1, axis can be 0 or 1
-  //     if axis = 1 then grid.z = nz, grid.y = ny / block_size, grid.x = nx /
-  //     32
-  //     else grid.z = 1, grid.y = ny / block_size, grid.x = nx /32
-  if (config.reduce_type == ReduceType::kReduceHigherDim) {
-    kps::DimConfig dim = kps::DimConfig(config.grid.x,
-                                        config.grid.y,
-                                        config.grid.z,
-                                        config.block.x,
-                                        config.blocking_size,
-                                        0);
-    dim.SetRem(config.left_num % config.block.x,
-               config.reduce_num % config.blocking_size,
-               0);
-
-#ifdef PADDLE_WITH_XPU_KP
-    auto grid_num = 8;
-    auto block_num = 64;
-#else
-    auto grid_num = config.grid;
-    auto block_num = config.block;
-#endif
-    ReduceHigherDimKernel<Tx, Ty, MPType, ReduceOp<MPType>, TransformOp>
-        <<<grid_num, block_num, 0, stream>>>(
-            x_data,
-            y_data,
-            reducer,
-            transform,
-            reducer.initial(),
-            config.reduce_num,
-            config.left_num,
-            config.blocking_size,
-            dim,
-            config.reduce_num,
-            IsMean && (!config.should_reduce_again),
-            config.tmp_data,
-            config.should_reduce_again);
-
-    if (config.should_reduce_again) {
-      dim3 block = dim3(config.block.x, 1, 1);
-      dim3 grid = dim3(config.grid.x, 1, config.grid.z);
-      kps::DimConfig dim2 =
-          kps::DimConfig(grid.x, grid.y, grid.z, block.x, config.grid.y, 0);
-      dim2.SetRem(config.left_num % config.block.x, 0, 0);
+  auto launch = [&](ReduceConfig<Ty, MPType> config) {
+    // SetOutputData for ReduceHigherDim when should_reduce_again is true,
+    // temp_output should be stored temp_data in output_data space or stored
+    // in y_data;
+    phi::DenseTensor tmp;
+    config.SetOutputData(y_data, dev_ctx, &tmp);
+    // launch ReduceHigherDimKernel
+    // when reduce_dim.size() == 1 and reduce_dim[0] != x_dim.size() - 1, this
+    // function will be used
+    // eg: x_dim = {nz, ny, nx}, nx != 1, axis can be 0 or 1
+    //     if axis = 1 then grid.z = nz, grid.y = ny / block_size, grid.x = nx /
+    //     32
+    //     else grid.z = 1, grid.y = ny / block_size, grid.x = nx /32
+    if (config.reduce_type == ReduceType::kReduceHigherDim) {
+      kps::DimConfig dim = kps::DimConfig(config.grid.x,
+                                          config.grid.y,
+                                          config.grid.z,
+                                          config.block.x,
+                                          config.blocking_size,
+                                          0);
+      dim.SetRem(config.left_num % config.block.x,
+                 config.reduce_num % config.blocking_size,
+                 0);
 
 #ifdef PADDLE_WITH_XPU_KP
-      int grid_size = 8;
-      int block_size = 64;
+      auto grid_num = 8;
+      auto block_num = 64;
 #else
-      auto grid_size = grid;
-      auto block_size = block;
+      auto grid_num = config.grid;
+      auto block_num = config.block;
 #endif
-      ReduceHigherDimKernel<MPType,
-                            Ty,
-                            MPType,
-                            ReduceOp<MPType>,
-                            kps::IdentityFunctor<MPType, MPType>>
-          <<<grid_size, block_size, 0, stream>>>(
-              config.tmp_data,
+      ReduceHigherDimKernel<Tx, Ty, MPType, ReduceOp<MPType>, TransformOp>
+          <<<grid_num, block_num, 0, stream>>>(
+              x_data,
               y_data,
               reducer,
-              kps::IdentityFunctor<MPType, MPType>(config.grid.y),
+              transform,
               reducer.initial(),
-              config.grid.y,
+              config.reduce_num,
               config.left_num,
-              config.grid.y,
-              dim2,
+              config.blocking_size,
+              dim,
               config.reduce_num,
-              IsMean,
+              IsMean && (!config.should_reduce_again),
               config.tmp_data,
-              false);
+              config.should_reduce_again);
+
+      if (config.should_reduce_again) {
+        dim3 block = dim3(config.block.x, 1, 1);
+        dim3 grid = dim3(config.grid.x, 1, config.grid.z);
+        kps::DimConfig dim2 =
+            kps::DimConfig(grid.x, grid.y, grid.z, block.x, config.grid.y, 0);
+        dim2.SetRem(config.left_num % config.block.x, 0, 0);
+
+#ifdef PADDLE_WITH_XPU_KP
+        int grid_size = 8;
+        int block_size = 64;
+#else
+        auto grid_size = grid;
+        auto block_size = block;
+#endif
+        ReduceHigherDimKernel<MPType,
+                              Ty,
+                              MPType,
+                              ReduceOp<MPType>,
+                              kps::IdentityFunctor<MPType, MPType>>
+            <<<grid_size, block_size, 0, stream>>>(
+                config.tmp_data,
+                y_data,
+                reducer,
+                kps::IdentityFunctor<MPType, MPType>(config.grid.y),
+                reducer.initial(),
+                config.grid.y,
+                config.left_num,
+                config.grid.y,
+                dim2,
+                config.reduce_num,
+                IsMean,
+                config.tmp_data,
+                false);
+      }
+      return;
     }
-    return;
-  }
 
-  // when reduce_dim.size() == 1 and reduce_dim[0] == x_dim.size() - 1, or
-  // when reduce_dim.size() != 1 and reduce_dim.size() != x_dim.size(), this
-  // function will be used
-  LaunchReduceKernel<Tx, Ty, MPType, ReduceOp<MPType>, TransformOp>(
-      x_data,
-      y_data,
-      reducer,
-      transform,
-      reducer.initial(),
-      stream,
-      config,
-      IsMean);
+    // when reduce_dim.size() == 1 and reduce_dim[0] == x_dim.size() - 1, or
+    // when reduce_dim.size() != 1 and reduce_dim.size() != x_dim.size(), this
+    // function will be used
+    LaunchReduceKernel<Tx, Ty, MPType, ReduceOp<MPType>, TransformOp>(
+        x_data,
+        y_data,
+        reducer,
+        transform,
+        reducer.initial(),
+        stream,
+        config,
+        IsMean);
+  };
+
+#ifdef PADDLE_WITH_XPU_KP
+  launch(config);
+#else
+  // The splits of the large reduce dims are tuned per shape, the candidates
+  // other than the heuristic are only configured when they run.
+  phi::autotune::LaunchConfigAutoTuner<Ty> tuner;
+  tuner.AddCandidate([&] { launch(config); });
+  if (config.reduce_num >= REDUCE_SPLIT_BOUNDARY) {
+    for (int split_shift : {1, -1, 2}) {
+      tuner.AddCandidate([&, split_shift] {
+        auto tuned_config = ReduceConfig<Ty, MPType>(origin_reduce_dims, x_dim);
+        tuned_config.split_shift = split_shift;
+        tuned_config.Run(dev_ctx);
+        launch(tuned_config);
+      });
+    }
+  }
+  size_t key = phi::autotune::GenKey(common::vectorize<int64_t>(x.dims()),
+                                     origin_reduce_dims,
+                                     static_cast<int64_t>(x.dtype()),
+                                     static_cast<int64_t>(y->dtype()),
+                                     IsMean);
+  tuner.Run(dev_ctx, phi::autotune::AlgorithmType::kReduce, key);
+#endif
 }
 
 template <typename Tx,
@@ -18,6 +18,9 @@ limitations under the License. */
 #include <map>
 #include <set>
 #include <vector>
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
 
 #include "paddle/common/ddim.h"
 #include "paddle/phi/core/mixed_vector.h"
@@ -499,6 +502,134 @@ add_sparse_inputs(const std::vector<const phi::SelectedRows*>& inputs,
   }
 }
 
+// From this number of rows, MergeAdd sorts the rows by radix instead of
+// inserting them in a std::set and a hash map.
+constexpr size_t kMergeAddSortMinRows = 1 << 14;
+constexpr size_t kMergeAddMinRowsPerThread = 1 << 12;
+
+static int MergeAddNumThreads(size_t row_num) {
+  int num_threads = 1;
+#ifdef PADDLE_WITH_MKLML
+  num_threads = static_cast<int>(
+      std::min<size_t>(omp_get_max_threads(),
+                       row_num / kMergeAddMinRowsPerThread));
+#endif
+  return std::max(num_threads, 1);
+}
+
+// Sorts the rows by an LSD radix sort on bytes, carrying the data of each
+// row along, and stably, so that the duplicated rows keep the order of the
+// inputs. The passes stop at the highest byte set in any row. Each thread
+// counts the digits of its chunk of the rows, so that the threads then
+// scatter their chunks to disjoint slots.
+template <typename T>
+void RadixSortRows(std::vector<uint64_t>* rows,
+                   std::vector<const T*>* data) {
+  const size_t row_num = rows->size();
+  uint64_t row_bits = 0;
+  for (uint64_t row : *rows) {
+    row_bits |= row;
+  }
+  const int num_threads = MergeAddNumThreads(row_num);
+  const size_t chunk = (row_num + num_threads - 1) / num_threads;
+  std::vector<uint64_t> sorted_rows(row_num);
+  std::vector<const T*> sorted_data(row_num);
+  std::vector<size_t> offsets(static_cast<size_t>(num_threads) * 256);
+  for (int shift = 0; shift < 64 && (row_bits >> shift) != 0; shift += 8) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for num_threads(num_threads)
+#endif
+    for (int t = 0; t < num_threads; ++t) {
+      size_t* counts = offsets.data() + t * 256;
+      size_t end = std::min(row_num, (t + 1) * chunk);
+      for (size_t i = t * chunk; i < end; ++i) {
+        ++counts[((*rows)[i] >> shift) & 0xff];
+      }
+    }
+    size_t offset = 0;
+    for (int digit = 0; digit < 256; ++digit) {
+      for (int t = 0; t < num_threads; ++t) {
+        size_t count = offsets[t * 256 + digit];
+        offsets[t * 256 + digit] = offset;
+        offset += count;
+      }
+    }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for num_threads(num_threads)
+#endif
+    for (int t = 0; t < num_threads; ++t) {
+      size_t* slots = offsets.data() + t * 256;
+      size_t end = std::min(row_num, (t + 1) * chunk);
+      for (size_t i = t * chunk; i < end; ++i) {
+        size_t& slot = slots[((*rows)[i] >> shift) & 0xff];
+        sorted_rows[slot] = (*rows)[i];
+        sorted_data[slot] = (*data)[i];
+        ++slot;
+      }
+    }
+    rows->swap(sorted_rows);
+    data->swap(sorted_data);
+  }
+}
+
+// MergeAdd of many rows: the rows are sorted, then each run of equal rows
+// is summed into one output row, the runs in parallel. The output rows are
+// sorted whatever sorted_result is.
+template <typename DeviceContext, typename T>
+void MergeAddBySort(const DeviceContext& context,
+                    const std::vector<const phi::SelectedRows*>& inputs,
+                    size_t row_num,
+                    int64_t input_width,
+                    phi::SelectedRows* out) {
+  std::vector<uint64_t> rows;
+  std::vector<const T*> data;
+  rows.reserve(row_num);
+  data.reserve(row_num);
+  for (auto* input : inputs) {
+    if (input->rows().empty()) {
+      continue;
+    }
+    auto* input_data = input->value().data<T>();
+    for (size_t i = 0; i < input->rows().size(); ++i) {
+      rows.push_back(static_cast<uint64_t>(input->rows()[i]));
+      data.push_back(input_data + i * input_width);
+    }
+  }
+  RadixSortRows<T>(&rows, &data);
+
+  std::vector<size_t> run_begins;
+  std::vector<int64_t> merge_rows;
+  for (size_t i = 0; i < row_num; ++i) {
+    if (i == 0 || rows[i] != rows[i - 1]) {
+      run_begins.push_back(i);
+      merge_rows.push_back(static_cast<int64_t>(rows[i]));
+    }
+  }
+  run_begins.push_back(row_num);
+  const int64_t merge_row_num = static_cast<int64_t>(merge_rows.size());
+  out->set_rows(merge_rows);
+
+  DenseTensor* out_tensor = out->mutable_value();
+  out_tensor->Resize(common::make_ddim({merge_row_num, input_width}));
+  auto* out_data = context.template Alloc<T>(out_tensor);
+
+  const int num_threads = MergeAddNumThreads(row_num);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for num_threads(num_threads)
+#endif
+  for (int64_t r = 0; r < merge_row_num; ++r) {
+    T* out_row = out_data + r * input_width;
+    std::copy(data[run_begins[r]], data[run_begins[r]] + input_width, out_row);
+    for (size_t i = run_begins[r] + 1; i < run_begins[r + 1]; ++i) {
+      const T* in_row = data[i];
+      for (int64_t j = 0; j < input_width; ++j) {
+        out_row[j] += in_row[j];
+      }
+    }
+  }
+}
+
 template <typename DeviceContext, typename T>
 struct MergeAddImpl {
   phi::SelectedRows operator()(const DeviceContext& context,
@@ -540,7 +671,6 @@ struct MergeAddImpl {
     auto input_width = has_value_input->value().dims()[1];
     auto input_height = has_value_input->height();
     phi::SelectedRows& out = *output;
-    std::set<int64_t> merged_row_set;
     size_t row_num = 0;
     for (auto* input : inputs) {
       if (input->rows().empty()) {
@@ -556,10 +686,19 @@ struct MergeAddImpl {
                         common::errors::InvalidArgument(
                             "All inputs should have same height."));
       row_num += input->rows().size();
-      merged_row_set.insert(input->rows().begin(), input->rows().end());
     }
 
     out.set_height(input_height);
+    if (row_num >= kMergeAddSortMinRows) {
+      MergeAddBySort<DeviceContext, T>(
+          context, inputs, row_num, input_width, &out);
+      return;
+    }
+
+    std::set<int64_t> merged_row_set;
+    for (auto* input : inputs) {
+      merged_row_set.insert(input->rows().begin(), input->rows().end());
+    }
     DenseTensor* out_tensor = out.mutable_value();
     out_tensor->Resize(common::make_ddim(
         {static_cast<int64_t>(merged_row_set.size()), input_width}));
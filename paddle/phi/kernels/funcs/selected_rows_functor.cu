@@ -15,11 +15,22 @@ limitations under the License. */
 #include <set>
 #include <vector>
 
+#ifdef __NVCC__
+#include "cub/cub.cuh"
+#endif
+#ifdef __HIPCC__
+#include <hipcub/hipcub.hpp>
+namespace cub = hipcub;
+#endif
+
 #include "glog/logging.h"
 
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
 #include "paddle/phi/backends/gpu/gpu_primitives.h"
+#include "paddle/phi/common/amp_type_traits.h"
 #include "paddle/phi/common/bfloat16.h"
 #include "paddle/phi/common/float16.h"
+#include "paddle/phi/common/memory_utils.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 #include "paddle/phi/kernels/funcs/selected_rows_functor.h"
 
@@ -370,6 +381,191 @@ __global__ void MergeAddKernel(const T* input,
   }
 }
 
+// From this number of rows, MergeAdd sorts the rows by radix instead of
+// searching the output row of each input row, which is linear in the
+// number of output rows.
+constexpr size_t kMergeAddSortMinRows = 1 << 12;
+
+template <typename T>
+__global__ void FillRowAddressesKernel(const T* data,
+                                       int64_t row_num,
+                                       int64_t row_numel,
+                                       const T** addresses) {
+  CUDA_KERNEL_LOOP_TYPE(i, row_num, int64_t) {
+    addresses[i] = data + i * row_numel;
+  }
+}
+
+// One block per run of equal rows after the sort, which sums the input rows
+// of the run in their order, so that the result is deterministic.
+template <typename T>
+__global__ void SumSortedRowsKernel(const T* const* addresses,
+                                    const int64_t* run_offsets,
+                                    T* out,
+                                    int64_t row_numel) {
+  using MPType = typename phi::dtype::MPTypeTrait<T>::Type;
+  const int64_t run = blockIdx.x;
+  const int64_t begin = run_offsets[run];
+  const int64_t end = run_offsets[run + 1];
+  for (int64_t j = threadIdx.x; j < row_numel; j += blockDim.x) {
+    MPType sum = static_cast<MPType>(0);
+    for (int64_t k = begin; k < end; ++k) {
+      sum += static_cast<MPType>(addresses[k][j]);
+    }
+    out[run * row_numel + j] = static_cast<T>(sum);
+  }
+}
+
+// MergeAdd of many rows: the rows are sorted by cub with the addresses of
+// their data, the runs of equal rows are counted, and each run is summed
+// into one output row. The output rows are sorted.
+template <typename T>
+void MergeAddBySort(const phi::GPUContext& context,
+                    const std::vector<const phi::SelectedRows*>& inputs,
+                    size_t row_num,
+                    int64_t input_width,
+                    int64_t input_height,
+                    phi::SelectedRows* out) {
+  auto place = context.GetPlace();
+  auto stream = context.stream();
+  auto alloc = [&](size_t bytes) {
+    return phi::memory_utils::Alloc(
+        place, bytes, phi::Stream(reinterpret_cast<phi::StreamId>(stream)));
+  };
+  const int64_t n = static_cast<int64_t>(row_num);
+  auto rows_mem = alloc(2 * row_num * sizeof(int64_t));
+  auto addresses_mem = alloc(2 * row_num * sizeof(const T*));
+  auto* rows = reinterpret_cast<int64_t*>(rows_mem->ptr());
+  auto* sorted_rows = rows + row_num;
+  auto* addresses = reinterpret_cast<const T**>(addresses_mem->ptr());
+  auto* sorted_addresses = addresses + row_num;
+
+  int64_t offset = 0;
+  for (auto* input : inputs) {
+    int64_t input_row_num = static_cast<int64_t>(input->rows().size());
+    if (input_row_num == 0) {
+      continue;
+    }
+    memory_utils::Copy(place,
+                       rows + offset,
+                       phi::CPUPlace(),
+                       input->rows().data(),
+                       input_row_num * sizeof(int64_t),
+                       stream);
+    auto config =
+        phi::backends::gpu::GetGpuLaunchConfig1D(context, input_row_num);
+    FillRowAddressesKernel<T>
+        <<<config.block_per_grid, config.thread_per_block, 0, stream>>>(
+            input->value().data<T>(),
+            input_row_num,
+            input_width,
+            addresses + offset);
+    offset += input_row_num;
+  }
+
+  // The rows are in [0, height), so the bits above are not sorted.
+  int end_bit = sizeof(int64_t) * 8;
+  if (input_height > 0) {
+    end_bit = 1;
+    while (end_bit < 63 && ((input_height - 1) >> end_bit) != 0) {
+      ++end_bit;
+    }
+  }
+  size_t sort_bytes = 0;
+  cub::DeviceRadixSort::SortPairs(nullptr,
+                                  sort_bytes,
+                                  rows,
+                                  sorted_rows,
+                                  addresses,
+                                  sorted_addresses,
+                                  n,
+                                  0,
+                                  end_bit,
+                                  stream);
+  auto sort_mem = alloc(sort_bytes);
+  cub::DeviceRadixSort::SortPairs(sort_mem->ptr(),
+                                  sort_bytes,
+                                  rows,
+                                  sorted_rows,
+                                  addresses,
+                                  sorted_addresses,
+                                  n,
+                                  0,
+                                  end_bit,
+                                  stream);
+
+  // The unique rows overwrite the unsorted rows, and the run lengths, with
+  // a zero after the last, are scanned to the run offsets.
+  auto runs_mem = alloc((2 * row_num + 3) * sizeof(int64_t));
+  auto* run_lengths = reinterpret_cast<int64_t*>(runs_mem->ptr());
+  auto* run_offsets = run_lengths + row_num + 1;
+  auto* num_runs_ptr = run_offsets + row_num + 1;
+#ifdef __HIPCC__
+  PADDLE_ENFORCE_GPU_SUCCESS(hipMemsetAsync(
+      run_lengths, 0, (row_num + 1) * sizeof(int64_t), stream));
+#else
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaMemsetAsync(
+      run_lengths, 0, (row_num + 1) * sizeof(int64_t), stream));
+#endif
+  size_t encode_bytes = 0;
+  cub::DeviceRunLengthEncode::Encode(nullptr,
+                                     encode_bytes,
+                                     sorted_rows,
+                                     rows,
+                                     run_lengths,
+                                     num_runs_ptr,
+                                     n,
+                                     stream);
+  auto encode_mem = alloc(encode_bytes);
+  cub::DeviceRunLengthEncode::Encode(encode_mem->ptr(),
+                                     encode_bytes,
+                                     sorted_rows,
+                                     rows,
+                                     run_lengths,
+                                     num_runs_ptr,
+                                     n,
+                                     stream);
+  int64_t num_runs = 0;
+  memory_utils::Copy(phi::CPUPlace(),
+                     &num_runs,
+                     place,
+                     num_runs_ptr,
+                     sizeof(int64_t),
+                     stream);
+  context.Wait();
+
+  size_t scan_bytes = 0;
+  cub::DeviceScan::ExclusiveSum(
+      nullptr, scan_bytes, run_lengths, run_offsets, num_runs + 1, stream);
+  auto scan_mem = alloc(scan_bytes);
+  cub::DeviceScan::ExclusiveSum(scan_mem->ptr(),
+                                scan_bytes,
+                                run_lengths,
+                                run_offsets,
+                                num_runs + 1,
+                                stream);
+
+  std::vector<int64_t> merge_rows(num_runs);
+  memory_utils::Copy(phi::CPUPlace(),
+                     merge_rows.data(),
+                     place,
+                     rows,
+                     num_runs * sizeof(int64_t),
+                     stream);
+
+  DenseTensor* out_tensor = out->mutable_value();
+  out_tensor->Resize(common::make_ddim({num_runs, input_width}));
+  auto* out_data = context.template Alloc<T>(out_tensor);
+  int threads = 256;
+  while (threads > 32 && threads / 2 >= input_width) {
+    threads /= 2;
+  }
+  SumSortedRowsKernel<T><<<num_runs, threads, 0, stream>>>(
+      sorted_addresses, run_offsets, out_data, input_width);
+  context.Wait();
+  out->set_rows(merge_rows);
+}
+
 template <typename DeviceContext, typename T>
 struct MergeAddImpl {
   phi::SelectedRows operator()(const DeviceContext& context,
@@ -384,6 +580,13 @@ struct MergeAddImpl {
                   const phi::SelectedRows& input,
                   phi::SelectedRows* output,
                   const bool sorted_result = false) {
+    if (input.rows().size() >= kMergeAddSortMinRows) {
+      (*this)(context,
+              std::vector<const phi::SelectedRows*>{&input},
+              output,
+              sorted_result);
+      return;
+    }
     phi::Vector<int64_t> input_rows(input.rows());
     if (input_rows.size() == 0) {
       return;
@@ -447,7 +650,7 @@ struct MergeAddImpl {
     auto input_width = has_value_input->value().dims()[1];
     auto input_height = has_value_input->height();
     phi::SelectedRows& out = *output;
-    std::set<int64_t> merged_row_set;
+    size_t row_num = 0;
     for (auto* input : inputs) {
       if (input->rows().size() == 0) {
         continue;
@@ -461,6 +664,16 @@ struct MergeAddImpl {
                         input->height(),
                         common::errors::InvalidArgument(
                             "All input should have same height."));
+      row_num += input->rows().size();
+    }
+    if (row_num >= kMergeAddSortMinRows) {
+      out.set_height(input_height);
+      MergeAddBySort<T>(
+          context, inputs, row_num, input_width, input_height, &out);
+      return;
+    }
+    std::set<int64_t> merged_row_set;
+    for (auto* input : inputs) {
       merged_row_set.insert(input->rows().begin(), input->rows().end());
     }
     std::vector<int64_t> merge_rows_cpu(merged_row_set.begin(),
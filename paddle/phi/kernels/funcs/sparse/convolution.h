@@ -14,6 +14,10 @@ limitations under the License. */
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "paddle/common/ddim.h"
 #include "paddle/phi/core/kmap_cache.h"
 #include "paddle/phi/core/tensor_utils.h"
@@ -266,12 +270,11 @@ inline const IntT* PrepareSubm(const Context& dev_ctx,
 
     *rulebook_len = rulebook.dims()[1];
 
-    DenseTensor out_indices =
-        phi::EmptyLike<IntT>(dev_ctx, x.non_zero_indices());
-    DenseTensor out_values = phi::EmptyLike<T>(dev_ctx, x.non_zero_elements());
-    phi::Copy(
-        dev_ctx, x.non_zero_indices(), dev_ctx.GetPlace(), false, &out_indices);
-    out->SetMember(out_indices, out_values, out_dims, false);
+    // The indices are not modified in place, so they are shared with x. The
+    // values have the out channels, which may differ from those of x.
+    DenseTensor out_values =
+        phi::Empty<T>(dev_ctx, {x.nnz(), out_dims[out_dims.size() - 1]});
+    out->SetMember(x.non_zero_indices(), out_values, out_dims, false);
     PrefixSum<int>(counter, offsets, counter_size);
     return rulebook.data<IntT>();
   }
@@ -298,6 +301,52 @@ inline void SaveToTable(const Context& dev_ctx,
   }
 }
 
+/* The key of the rulebook of a submanifold conv without a user key. The
+output of a submanifold conv shares the indices of its input, so the address
+of the indices identifies the points along the layers, and the following
+submanifold convs of the same kernel, paddings, dilations and strides reuse
+the rulebook instead of building the hash table again. The channels are left
+out of the key, as the rulebook does not depend on them. */
+inline std::string SubmRulebookKey(const SparseCooTensor& x,
+                                   const std::vector<int>& kernel_sizes,
+                                   const std::vector<int>& paddings,
+                                   const std::vector<int>& dilations,
+                                   const std::vector<int>& strides) {
+  std::string key = "__subm_rulebook_";
+  key += std::to_string(reinterpret_cast<uintptr_t>(x.indices().data()));
+  const DDim& dims = x.dims();
+  for (int i = 0; i < dims.size() - 1; ++i) {
+    key += "_" + std::to_string(dims[i]);
+  }
+  // The kernel sizes end with the in and out channels.
+  for (size_t i = 0; i + 2 < kernel_sizes.size(); ++i) {
+    key += "_k" + std::to_string(kernel_sizes[i]);
+  }
+  for (int padding : paddings) {
+    key += "_p" + std::to_string(padding);
+  }
+  for (int dilation : dilations) {
+    key += "_d" + std::to_string(dilation);
+  }
+  for (int stride : strides) {
+    key += "_s" + std::to_string(stride);
+  }
+  return key;
+}
+
+/* Saves the rulebook of SubmRulebookKey in the table shared along the
+layers. The indices are saved as well, so that their address is not reused
+by other indices while the rulebook may be found. */
+inline void SaveSubmRulebook(const SparseCooTensor& x,
+                             const std::string& key,
+                             const DenseTensor& rulebook,
+                             const DenseTensor& h_counter,
+                             SparseCooTensor* out) {
+  out->SaveIndicesPairs(key, std::make_pair(rulebook, h_counter));
+  out->SaveIndicesPairs(key + "_indices",
+                        std::make_pair(x.indices(), DenseTensor()));
+}
+
 }  // namespace sparse
 }  // namespace funcs
 }  // namespace phi
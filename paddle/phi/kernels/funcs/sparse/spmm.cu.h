@@ -0,0 +1,286 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_primitives.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/kernels/funcs/math_function.h"
+
+/* The native kernels of the 2D sparse x dense matmul (SpMM) and of the
+dense x dense matmul sampled by a sparse mask (SDDMM). Each suits another
+sparsity pattern, so that the kernels of sparse/gpu/matmul_kernel.cu tune
+them against cuSPARSE per shape and number of non-zeros. A warp works on
+the non-zeros of x in chunks of 32: each lane loads one, then they are
+broadcast by shuffles while the lanes split the columns of y. */
+
+namespace phi {
+namespace funcs {
+namespace sparse {
+
+constexpr int kSpmmWarpSize = 32;
+constexpr int kSpmmWarpsPerBlock = 4;
+
+/* Row-split: one warp per row of x, the lanes split the columns of y. Suits
+rows of similar lengths and a wide y. */
+template <typename T, typename IntT>
+__global__ void CsrSpmmRowSplitKernel(const IntT* crows,
+                                      const IntT* cols,
+                                      const T* values,
+                                      const T* y,
+                                      T* out,
+                                      int64_t rows,
+                                      int64_t n) {
+  int64_t row = static_cast<int64_t>(blockIdx.x) * blockDim.y + threadIdx.y;
+  if (row >= rows) {
+    return;
+  }
+  const int lane = threadIdx.x;
+  const int64_t begin = crows[row];
+  const int64_t end = crows[row + 1];
+  for (int64_t j0 = 0; j0 < n; j0 += kSpmmWarpSize) {
+    const int64_t j = j0 + lane;
+    T sum = static_cast<T>(0);
+    for (int64_t base = begin; base < end; base += kSpmmWarpSize) {
+      const int64_t k = base + lane;
+      int64_t col = k < end ? static_cast<int64_t>(cols[k]) : 0;
+      T value = k < end ? values[k] : static_cast<T>(0);
+      const int count = static_cast<int>(
+          end - base < kSpmmWarpSize ? end - base : kSpmmWarpSize);
+      for (int i = 0; i < count; ++i) {
+        int64_t c = __shfl_sync(0xffffffff, col, i);
+        T v = __shfl_sync(0xffffffff, value, i);
+        if (j < n) {
+          sum += v * y[c * n + j];
+        }
+      }
+    }
+    if (j < n) {
+      out[row * n + j] = sum;
+    }
+  }
+}
+
+/* Row-vector: one warp per row of x, the lanes split the non-zeros of the
+row and the products are reduced across the warp. Suits long rows and a
+narrow y. */
+template <typename T, typename IntT>
+__global__ void CsrSpmmRowVectorKernel(const IntT* crows,
+                                       const IntT* cols,
+                                       const T* values,
+                                       const T* y,
+                                       T* out,
+                                       int64_t rows,
+                                       int64_t n) {
+  int64_t row = static_cast<int64_t>(blockIdx.x) * blockDim.y + threadIdx.y;
+  if (row >= rows) {
+    return;
+  }
+  const int lane = threadIdx.x;
+  const int64_t begin = crows[row];
+  const int64_t end = crows[row + 1];
+  for (int64_t j = 0; j < n; ++j) {
+    T sum = static_cast<T>(0);
+    for (int64_t k = begin + lane; k < end; k += kSpmmWarpSize) {
+      sum += values[k] * y[static_cast<int64_t>(cols[k]) * n + j];
+    }
+    for (int offset = kSpmmWarpSize / 2; offset > 0; offset /= 2) {
+      sum += __shfl_down_sync(0xffffffff, sum, offset);
+    }
+    if (lane == 0) {
+      out[row * n + j] = sum;
+    }
+  }
+}
+
+/* Non-zero split: each warp takes the same number of non-zeros whatever
+their rows, and adds the sums of each row to out, which is zeroed first.
+Suits rows of skewed lengths. The row of a non-zero is read from coo_rows,
+or searched in crows when it is null, so the non-zeros need not be
+sorted for COO. */
+template <typename T, typename IntT>
+__global__ void SpmmNnzSplitKernel(const IntT* coo_rows,
+                                   const IntT* crows,
+                                   const IntT* cols,
+                                   const T* values,
+                                   const T* y,
+                                   T* out,
+                                   int64_t rows,
+                                   int64_t nnz,
+                                   int64_t n) {
+  const int64_t base =
+      (static_cast<int64_t>(blockIdx.x) * blockDim.y + threadIdx.y) *
+      kSpmmWarpSize;
+  if (base >= nnz) {
+    return;
+  }
+  const int lane = threadIdx.x;
+  const int64_t k = base + lane;
+  int64_t row = 0;
+  int64_t col = 0;
+  T value = static_cast<T>(0);
+  if (k < nnz) {
+    if (coo_rows != nullptr) {
+      row = coo_rows[k];
+    } else {
+      // The last row whose begin is not after k.
+      int64_t lo = 0;
+      int64_t hi = rows;
+      while (lo < hi) {
+        int64_t mid = (lo + hi + 1) / 2;
+        if (crows[mid] <= k) {
+          lo = mid;
+        } else {
+          hi = mid - 1;
+        }
+      }
+      row = lo;
+    }
+    col = cols[k];
+    value = values[k];
+  }
+  const int count = static_cast<int>(
+      nnz - base < kSpmmWarpSize ? nnz - base : kSpmmWarpSize);
+  for (int64_t j0 = 0; j0 < n; j0 += kSpmmWarpSize) {
+    const int64_t j = j0 + lane;
+    int64_t cur_row = __shfl_sync(0xffffffff, row, 0);
+    T sum = static_cast<T>(0);
+    for (int i = 0; i < count; ++i) {
+      int64_t r = __shfl_sync(0xffffffff, row, i);
+      int64_t c = __shfl_sync(0xffffffff, col, i);
+      T v = __shfl_sync(0xffffffff, value, i);
+      if (r != cur_row) {
+        if (j < n) {
+          phi::CudaAtomicAdd(out + cur_row * n + j, sum);
+        }
+        cur_row = r;
+        sum = static_cast<T>(0);
+      }
+      if (j < n) {
+        sum += v * y[c * n + j];
+      }
+    }
+    if (j < n) {
+      phi::CudaAtomicAdd(out + cur_row * n + j, sum);
+    }
+  }
+}
+
+/* SDDMM: one warp per row of the mask, for each of its non-zeros the lanes
+split the inner dim and the products are reduced across the warp. */
+template <typename T, typename IntT>
+__global__ void CsrSddmmKernel(const T* x,
+                               const T* y,
+                               const IntT* crows,
+                               const IntT* cols,
+                               T* out_values,
+                               int64_t rows,
+                               int64_t k_dim,
+                               int64_t n) {
+  int64_t row = static_cast<int64_t>(blockIdx.x) * blockDim.y + threadIdx.y;
+  if (row >= rows) {
+    return;
+  }
+  const int lane = threadIdx.x;
+  const T* x_row = x + row * k_dim;
+  for (int64_t k = crows[row]; k < crows[row + 1]; ++k) {
+    const int64_t col = cols[k];
+    T sum = static_cast<T>(0);
+    for (int64_t i = lane; i < k_dim; i += kSpmmWarpSize) {
+      sum += x_row[i] * y[i * n + col];
+    }
+    for (int offset = kSpmmWarpSize / 2; offset > 0; offset /= 2) {
+      sum += __shfl_down_sync(0xffffffff, sum, offset);
+    }
+    if (lane == 0) {
+      out_values[k] = sum;
+    }
+  }
+}
+
+inline dim3 SpmmBlock() { return dim3(kSpmmWarpSize, kSpmmWarpsPerBlock); }
+
+inline int64_t SpmmGrid(int64_t num_warps) {
+  return (num_warps + kSpmmWarpsPerBlock - 1) / kSpmmWarpsPerBlock;
+}
+
+/* out[rows, n] = x[rows, :] * y[:, n], x in CSR. */
+template <typename T, typename IntT>
+void CsrSpmmRowSplit(const phi::GPUContext& dev_ctx,
+                     const IntT* crows,
+                     const IntT* cols,
+                     const T* values,
+                     const T* y,
+                     T* out,
+                     int64_t rows,
+                     int64_t n) {
+  CsrSpmmRowSplitKernel<T, IntT>
+      <<<SpmmGrid(rows), SpmmBlock(), 0, dev_ctx.stream()>>>(
+          crows, cols, values, y, out, rows, n);
+}
+
+template <typename T, typename IntT>
+void CsrSpmmRowVector(const phi::GPUContext& dev_ctx,
+                      const IntT* crows,
+                      const IntT* cols,
+                      const T* values,
+                      const T* y,
+                      T* out,
+                      int64_t rows,
+                      int64_t n) {
+  CsrSpmmRowVectorKernel<T, IntT>
+      <<<SpmmGrid(rows), SpmmBlock(), 0, dev_ctx.stream()>>>(
+          crows, cols, values, y, out, rows, n);
+}
+
+/* Either coo_rows or crows gives the rows of the non-zeros. */
+template <typename T, typename IntT>
+void SpmmNnzSplit(const phi::GPUContext& dev_ctx,
+                  const IntT* coo_rows,
+                  const IntT* crows,
+                  const IntT* cols,
+                  const T* values,
+                  const T* y,
+                  DenseTensor* out,
+                  int64_t rows,
+                  int64_t nnz,
+                  int64_t n) {
+  phi::funcs::SetConstant<phi::GPUContext, T> set_zero;
+  set_zero(dev_ctx, out, static_cast<T>(0));
+  int64_t num_warps = (nnz + kSpmmWarpSize - 1) / kSpmmWarpSize;
+  SpmmNnzSplitKernel<T, IntT>
+      <<<SpmmGrid(num_warps), SpmmBlock(), 0, dev_ctx.stream()>>>(
+          coo_rows, crows, cols, values, y, out->data<T>(), rows, nnz, n);
+}
+
+/* out_values = (x[rows, k_dim] * y[k_dim, n]) at the non-zeros of the
+mask given by crows and cols. */
+template <typename T, typename IntT>
+void CsrSddmm(const phi::GPUContext& dev_ctx,
+              const T* x,
+              const T* y,
+              const IntT* crows,
+              const IntT* cols,
+              T* out_values,
+              int64_t rows,
+              int64_t k_dim,
+              int64_t n) {
+  CsrSddmmKernel<T, IntT><<<SpmmGrid(rows), SpmmBlock(), 0, dev_ctx.stream()>>>(
+      x, y, crows, cols, out_values, rows, k_dim, n);
+}
+
+}  // namespace sparse
+}  // namespace funcs
+}  // namespace phi
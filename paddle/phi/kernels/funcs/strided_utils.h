@@ -22,6 +22,23 @@
 #include "paddle/phi/kernels/strided_copy_kernel.h"
 
 namespace phi {
+
+// The strides to read x at each index of out_dims, which x is broadcast to:
+// the dims of x are aligned to the last ones of out_dims, and the broadcast
+// dims have the stride 0.
+inline std::vector<int64_t> BroadcastStrides(const phi::DenseTensor& x,
+                                             const phi::DDim& out_dims) {
+  int rank = out_dims.size();
+  int x_rank = x.dims().size();
+  std::vector<int64_t> strides(rank, 0);
+  for (int i = 0; i < x_rank; ++i) {
+    if (x.dims()[i] != 1) {
+      strides[rank - x_rank + i] = x.strides()[i];
+    }
+  }
+  return strides;
+}
+
 template <typename T>
 inline void StridedTensorCopy(const phi::DenseTensor& input,
                               const std::vector<int64_t>& dims,
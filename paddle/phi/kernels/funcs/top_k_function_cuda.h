@@ -912,6 +912,8 @@ void LaunchGatherKthValue(const phi::GPUContext& dev_ctx,
       input_data, k, num_rows, num_cols, out_data, indices_data);
 }
 
+// Gathers the unsorted top k of every row, one block per row at a time, the
+// blocks striding over the rows when there are more rows than blocks.
 template <typename T, bool Largest>
 __global__ void RadixTopK(const T* input,
                           int k,
@@ -921,66 +923,75 @@ __global__ void RadixTopK(const T* input,
                           int64_t* indices) {
   __shared__ int shared_mem[32];
 
-  // 1. Find the k-th value
-  T kth_value = static_cast<T>(0);
-  RadixSearch<T, typename RadixTypeConfig<T>::RadixType, Largest>(
-      input, k, slice_size, shared_mem, &kth_value);
-  const auto converted_kth_value = RadixTypeConfig<T>::Convert(kth_value);
-
-  // 2. Select the value strictly less/greater than kth_value and their indices
-  int block_dim = static_cast<int>(blockDim.x);
-  int loop = ((slice_size + block_dim - 1) / block_dim * block_dim);
-  int write_start = 0;
+  for (int64_t slice = blockIdx.x; slice < slice_num; slice += gridDim.x) {
+    const T* slice_input = input + slice * slice_size;
+    T* slice_output = output + slice * k;
+    int64_t* slice_indices = indices + slice * k;
+
+    // 1. Find the k-th value
+    T kth_value = static_cast<T>(0);
+    RadixSearch<T, typename RadixTypeConfig<T>::RadixType, Largest>(
+        slice_input, k, slice_size, shared_mem, &kth_value);
+    const auto converted_kth_value = RadixTypeConfig<T>::Convert(kth_value);
+
+    // 2. Select the value strictly less/greater than kth_value and their
+    // indices
+    int block_dim = static_cast<int>(blockDim.x);
+    int loop = ((slice_size + block_dim - 1) / block_dim * block_dim);
+    int write_start = 0;
+
+    for (int i = threadIdx.x; i < loop; i += blockDim.x) {
+      bool valid = i < slice_size;
+      T v = valid ? slice_input[i] : static_cast<T>(0);
+      const auto convertd_v = RadixTypeConfig<T>::Convert(v);
+      bool is_top_k;
+      if (Largest) {
+        is_top_k = valid && (convertd_v > converted_kth_value);
+      } else {
+        is_top_k = valid && (convertd_v < converted_kth_value);
+      }
 
-  for (int i = threadIdx.x; i < loop; i += blockDim.x) {
-    bool valid = i < slice_size;
-    T v = valid ? input[i] : static_cast<T>(0);
-    const auto convertd_v = RadixTypeConfig<T>::Convert(v);
-    bool is_top_k;
-    if (Largest) {
-      is_top_k = valid && (convertd_v > converted_kth_value);
-    } else {
-      is_top_k = valid && (convertd_v < converted_kth_value);
+      int index;
+      int carry;
+      ExclusiveBinaryPrefixScan<int, true, kps::AddFunctor<int>>(
+          shared_mem, is_top_k, &index, &carry, kps::AddFunctor<int>());
+      if (is_top_k) {
+        int write_index = write_start + index;
+        slice_output[write_index] = v;
+        slice_indices[write_index] = i;
+      }
+      write_start += carry;
     }
 
-    int index;
-    int carry;
-    ExclusiveBinaryPrefixScan<int, true, kps::AddFunctor<int>>(
-        shared_mem, is_top_k, &index, &carry, kps::AddFunctor<int>());
-    if (is_top_k) {
-      int write_index = write_start + index;
-      output[write_index] = v;
-      indices[write_index] = i;
-    }
-    write_start += carry;
-  }
+    // 3. Fill the rest with value == kth_value
+    assert(k >= write_start);
+    int remain = k - write_start;
+    for (int i = threadIdx.x; i < loop; i += blockDim.x) {
+      bool valid = i < slice_size;
+      T v = valid ? slice_input[i] : static_cast<T>(0);
+      const auto convertd_v = RadixTypeConfig<T>::Convert(v);
+      bool is_top_k = valid && (convertd_v == converted_kth_value);
+
+      int index;
+      int carry;
+      ExclusiveBinaryPrefixScan<int, true, kps::AddFunctor<int>>(
+          shared_mem, is_top_k, &index, &carry, kps::AddFunctor<int>());
+      if (is_top_k && index < remain) {
+        int write_index = write_start + index;
+        assert(write_index < k);
+        slice_output[write_index] = v;
+        slice_indices[write_index] = i;
+      }
 
-  // 3. Fill the rest with value == kth_value
-  assert(k >= write_start);
-  int remain = k - write_start;
-  for (int i = threadIdx.x; i < loop; i += blockDim.x) {
-    bool valid = i < slice_size;
-    T v = valid ? input[i] : static_cast<T>(0);
-    const auto convertd_v = RadixTypeConfig<T>::Convert(v);
-    bool is_top_k = valid && (convertd_v == converted_kth_value);
-
-    int index;
-    int carry;
-    ExclusiveBinaryPrefixScan<int, true, kps::AddFunctor<int>>(
-        shared_mem, is_top_k, &index, &carry, kps::AddFunctor<int>());
-    if (is_top_k && index < remain) {
-      int write_index = write_start + index;
-      assert(write_index < k);
-      output[write_index] = v;
-      indices[write_index] = i;
-    }
+      if (carry >= remain) {
+        break;
+      }
 
-    if (carry >= remain) {
-      break;
+      remain -= carry;
+      write_start += carry;
     }
-
-    remain -= carry;
-    write_start += carry;
+    // The next row reuses shared_mem.
+    __syncthreads();
   }
 }
 #endif
@@ -0,0 +1,91 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/kernels/funcs/math_cuda_utils.h"
+
+namespace phi {
+namespace fusion {
+
+// The kernels below work on the expanded rows of moe_permute. Token row of
+// num_rows tokens routed to k experts has the expanded source rows
+// k_idx * num_rows + row, the layout of initialize_moe_routing, and
+// dest_rows maps each of them to its row in the permuted tensor.
+
+constexpr int kMoeRowsThreads = 256;
+
+// out[row] = sum over k_idx of weights[row * k + k_idx] times
+// rows[dest_rows[k_idx * num_rows + row]], or the plain sum without weights.
+// One block per token; the sum runs in float whatever T is.
+template <typename T>
+__global__ void MoeCombineRowsKernel(const T* rows,
+                                     const int* dest_rows,
+                                     const float* weights,
+                                     const int num_rows,
+                                     const int cols,
+                                     const int k,
+                                     T* out) {
+  const int row = blockIdx.x;
+  for (int col = threadIdx.x; col < cols; col += blockDim.x) {
+    float sum = 0.0f;
+    for (int k_idx = 0; k_idx < k; ++k_idx) {
+      const int64_t dest = dest_rows[k_idx * num_rows + row];
+      const float scale = weights ? weights[row * k + k_idx] : 1.0f;
+      sum += scale * static_cast<float>(rows[dest * cols + col]);
+    }
+    out[static_cast<int64_t>(row) * cols + col] = static_cast<T>(sum);
+  }
+}
+
+// The grad of MoeCombineRowsKernel. Each block takes one expanded row
+// row * k + k_idx, writes weights[row * k + k_idx] * out_grad[row] to
+// rows_grad[dest], and, when weights_grad is given, the dot product of
+// out_grad[row] and rows[dest] to weights_grad[row * k + k_idx]. Every row of
+// rows_grad is the dest of exactly one expanded row, so it is fully written.
+template <typename T>
+__global__ void MoeScatterRowsGradKernel(const T* out_grad,
+                                         const T* rows,
+                                         const int* dest_rows,
+                                         const float* weights,
+                                         const int num_rows,
+                                         const int cols,
+                                         const int k,
+                                         T* rows_grad,
+                                         float* weights_grad) {
+  const int expanded_row = blockIdx.x;
+  const int row = expanded_row / k;
+  const int k_idx = expanded_row % k;
+  const int64_t dest = dest_rows[k_idx * num_rows + row];
+  const float scale = weights ? weights[expanded_row] : 1.0f;
+  const T* grad_row = out_grad + static_cast<int64_t>(row) * cols;
+  float dot = 0.0f;
+  for (int col = threadIdx.x; col < cols; col += blockDim.x) {
+    const float grad = static_cast<float>(grad_row[col]);
+    rows_grad[dest * cols + col] = static_cast<T>(scale * grad);
+    if (weights_grad) {
+      dot += grad * static_cast<float>(rows[dest * cols + col]);
+    }
+  }
+  if (weights_grad) {
+    dot = phi::funcs::BlockReduceSum<float>(dot, FINAL_MASK);
+    if (threadIdx.x == 0) {
+      weights_grad[expanded_row] = dot;
+    }
+  }
+}
+
+}  // namespace fusion
+}  // namespace phi
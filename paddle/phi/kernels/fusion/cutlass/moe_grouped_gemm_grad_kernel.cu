@@ -0,0 +1,129 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/datatype_traits.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/core/tensor_utils.h"
+#include "paddle/phi/kernels/funcs/blas/blas.h"
+#include "paddle/phi/kernels/funcs/math_function.h"
+#include "paddle/phi/kernels/transpose_kernel.h"
+
+// Ignore CUTLASS warnings about type punning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+#include "paddle/phi/kernels/fusion/cutlass/cutlass_kernels/moe_gemm/fused_moe_gemm_kernels.h"
+
+#pragma GCC diagnostic pop
+
+namespace phi {
+namespace fusion {
+
+// x_grad is the same grouped GEMM as forward, of out_grad and the weights
+// transposed to [num_experts, n, k]. weight_grad[e] is x^T * out_grad over
+// the rows of expert e, one GEMM per expert that has rows: the GEMM sizes
+// need the offsets on the host, which costs one copy and sync per call.
+template <typename T, typename Context>
+void MoeGroupedGemmGradKernel(const Context& dev_ctx,
+                              const DenseTensor& x,
+                              const DenseTensor& weight,
+                              const DenseTensor& expert_offsets,
+                              const DenseTensor& out_grad,
+                              DenseTensor* x_grad,
+                              DenseTensor* weight_grad) {
+  using NvType = typename PDDataTypeTraits<T>::DataType;
+  const int64_t total_rows = x.dims()[0];
+  const int64_t gemm_k = x.dims()[1];
+  const int num_experts = weight.dims()[0];
+  const int64_t gemm_n = weight.dims()[2];
+
+  if (x_grad) {
+    x_grad->Resize(x.dims());
+    T* x_grad_data = dev_ctx.template Alloc<T>(x_grad);
+    if (total_rows > 0 && gemm_k > 0) {
+      DenseTensor weight_t =
+          phi::Transpose<T, Context>(dev_ctx, weight, {0, 2, 1});
+      MoeGemmRunner<NvType, NvType> runner;
+      runner.moe_gemm(reinterpret_cast<const NvType*>(out_grad.data<T>()),
+                      reinterpret_cast<const NvType*>(weight_t.data<T>()),
+                      nullptr,
+                      reinterpret_cast<NvType*>(x_grad_data),
+                      const_cast<int64_t*>(expert_offsets.data<int64_t>()),
+                      total_rows,
+                      gemm_k,
+                      gemm_n,
+                      num_experts,
+                      dev_ctx.stream());
+    }
+  }
+
+  if (weight_grad) {
+    weight_grad->Resize(weight.dims());
+    T* weight_grad_data = dev_ctx.template Alloc<T>(weight_grad);
+    phi::funcs::SetConstant<Context, T>()(
+        dev_ctx, weight_grad, static_cast<T>(0));
+    if (total_rows == 0) {
+      return;
+    }
+    DenseTensor host_offsets;
+    phi::Copy(dev_ctx, expert_offsets, phi::CPUPlace(), true, &host_offsets);
+    const int64_t* offsets = host_offsets.data<int64_t>();
+    auto blas = phi::funcs::GetBlas<Context, T>(dev_ctx);
+    int64_t begin = 0;
+    for (int e = 0; e < num_experts; ++e) {
+      const int64_t end = offsets[e];
+      if (end > begin) {
+        blas.GEMM(CblasTrans,
+                  CblasNoTrans,
+                  static_cast<int>(gemm_k),
+                  static_cast<int>(gemm_n),
+                  static_cast<int>(end - begin),
+                  static_cast<T>(1),
+                  x.data<T>() + begin * gemm_k,
+                  out_grad.data<T>() + begin * gemm_n,
+                  static_cast<T>(0),
+                  weight_grad_data + e * gemm_k * gemm_n);
+      }
+      begin = end;
+    }
+  }
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+#ifdef PADDLE_CUDA_BF16
+PD_REGISTER_KERNEL(moe_grouped_gemm_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeGroupedGemmGradKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->InputAt(2).SetDataType(phi::DataType::INT64);
+}
+#else
+PD_REGISTER_KERNEL(moe_grouped_gemm_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeGroupedGemmGradKernel,
+                   float,
+                   phi::dtype::float16) {
+  kernel->InputAt(2).SetDataType(phi::DataType::INT64);
+}
+#endif
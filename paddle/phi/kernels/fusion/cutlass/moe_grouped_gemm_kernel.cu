@@ -0,0 +1,88 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/datatype_traits.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+
+// Ignore CUTLASS warnings about type punning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+#include "paddle/phi/kernels/fusion/cutlass/cutlass_kernels/moe_gemm/fused_moe_gemm_kernels.h"
+
+#pragma GCC diagnostic pop
+
+namespace phi {
+namespace fusion {
+
+// out[rows of expert e] = x[rows of expert e] * weight[e], with the rows of
+// expert e running from expert_offsets[e - 1] (or 0) to expert_offsets[e], as
+// moe_permute returns them. All experts go in one grouped GEMM of the
+// MoeGemmRunner that fused_moe uses.
+template <typename T, typename Context>
+void MoeGroupedGemmKernel(const Context& dev_ctx,
+                          const DenseTensor& x,
+                          const DenseTensor& weight,
+                          const DenseTensor& expert_offsets,
+                          DenseTensor* out) {
+  using NvType = typename PDDataTypeTraits<T>::DataType;
+  const int64_t total_rows = x.dims()[0];
+  const int64_t gemm_k = x.dims()[1];
+  const int num_experts = weight.dims()[0];
+  const int64_t gemm_n = weight.dims()[2];
+  out->Resize({total_rows, gemm_n});
+  T* out_data = dev_ctx.template Alloc<T>(out);
+  if (total_rows == 0 || gemm_n == 0) {
+    return;
+  }
+  MoeGemmRunner<NvType, NvType> runner;
+  runner.moe_gemm(reinterpret_cast<const NvType*>(x.data<T>()),
+                  reinterpret_cast<const NvType*>(weight.data<T>()),
+                  nullptr,
+                  reinterpret_cast<NvType*>(out_data),
+                  const_cast<int64_t*>(expert_offsets.data<int64_t>()),
+                  total_rows,
+                  gemm_n,
+                  gemm_k,
+                  num_experts,
+                  dev_ctx.stream());
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+#ifdef PADDLE_CUDA_BF16
+PD_REGISTER_KERNEL(moe_grouped_gemm,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeGroupedGemmKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->InputAt(2).SetDataType(phi::DataType::INT64);
+}
+#else
+PD_REGISTER_KERNEL(moe_grouped_gemm,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeGroupedGemmKernel,
+                   float,
+                   phi::dtype::float16) {
+  kernel->InputAt(2).SetDataType(phi::DataType::INT64);
+}
+#endif
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/fusion/cutlass/moe/moe_permute_utils.h"
+
+namespace phi {
+namespace fusion {
+
+// Each token was copied to k permuted rows, so its grad is the sum of theirs.
+template <typename T, typename Context>
+void MoePermuteGradKernel(const Context& dev_ctx,
+                          const DenseTensor& x,
+                          const DenseTensor& dest_rows,
+                          const DenseTensor& permuted_x_grad,
+                          DenseTensor* x_grad) {
+  const int num_rows = x.dims()[0];
+  const int cols = x.dims()[1];
+  x_grad->Resize(x.dims());
+  T* x_grad_data = dev_ctx.template Alloc<T>(x_grad);
+  if (num_rows == 0 || cols == 0) {
+    return;
+  }
+  const int k = dest_rows.numel() / num_rows;
+  MoeCombineRowsKernel<T>
+      <<<num_rows, kMoeRowsThreads, 0, dev_ctx.stream()>>>(
+          permuted_x_grad.data<T>(),
+          dest_rows.data<int>(),
+          nullptr,
+          num_rows,
+          cols,
+          k,
+          x_grad_data);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+#ifdef PADDLE_CUDA_BF16
+PD_REGISTER_KERNEL(moe_permute_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoePermuteGradKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
+#else
+PD_REGISTER_KERNEL(moe_permute_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoePermuteGradKernel,
+                   float,
+                   phi::dtype::float16) {}
+#endif
@@ -0,0 +1,146 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/empty_kernel.h"
+#include "paddle/phi/kernels/funcs/math_function.h"
+
+// Ignore CUTLASS warnings about type punning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#pragma GCC diagnostic ignored "-Wunused-function"
+
+#include "paddle/phi/kernels/fusion/cutlass/moe/fused_moe_op.h"
+
+#pragma GCC diagnostic pop
+
+namespace phi {
+namespace fusion {
+
+// source_rows[row * k + k_idx] = k_idx * num_rows + row, the expanded source
+// row that topk_gating_softmax pairs with the expert of that slot.
+__global__ void MoeInitSourceRowsKernel(const int num_rows,
+                                        const int k,
+                                        int* source_rows) {
+  const int idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx < num_rows * k) {
+    source_rows[idx] = (idx % k) * num_rows + idx / k;
+  }
+}
+
+// Groups the rows of x by expert like fused_moe does before its GEMMs: sorts
+// the expanded rows by expert_ids with the same stable radix sort, copies each
+// token once per expert it goes to, and returns the end row of every expert.
+// expert_ids must lie in [0, num_experts).
+template <typename T, typename Context>
+void MoePermuteKernel(const Context& dev_ctx,
+                      const DenseTensor& x,
+                      const DenseTensor& expert_ids,
+                      int num_experts,
+                      DenseTensor* permuted_x,
+                      DenseTensor* expert_offsets,
+                      DenseTensor* dest_rows) {
+  const int num_rows = x.dims()[0];
+  const int cols = x.dims()[1];
+  const int k = expert_ids.dims()[1];
+  const int expanded_rows = num_rows * k;
+  auto stream = dev_ctx.stream();
+
+  permuted_x->Resize({expanded_rows, cols});
+  T* permuted_x_data = dev_ctx.template Alloc<T>(permuted_x);
+  expert_offsets->Resize({num_experts});
+  int64_t* offsets_data = dev_ctx.template Alloc<int64_t>(expert_offsets);
+  dest_rows->Resize({expanded_rows});
+  int* dest_rows_data = dev_ctx.template Alloc<int>(dest_rows);
+  if (expanded_rows == 0) {
+    phi::funcs::SetConstant<Context, int64_t>()(
+        dev_ctx, expert_offsets, static_cast<int64_t>(0));
+    return;
+  }
+
+  DenseTensor source_rows = phi::Empty<int, Context>(dev_ctx, {expanded_rows});
+  const int threads = 256;
+  MoeInitSourceRowsKernel<<<(expanded_rows + threads - 1) / threads,
+                            threads,
+                            0,
+                            stream>>>(num_rows, k, source_rows.data<int>());
+
+  DenseTensor sorted_experts =
+      phi::Empty<int, Context>(dev_ctx, {expanded_rows});
+  DenseTensor permuted_rows =
+      phi::Empty<int, Context>(dev_ctx, {expanded_rows});
+  CubKeyValueSorter sorter(num_experts);
+  const size_t workspace_size = sorter.getWorkspaceSize(expanded_rows);
+  DenseTensor workspace = phi::Empty<int8_t, Context>(
+      dev_ctx, {static_cast<int64_t>(std::max<size_t>(workspace_size, 1))});
+  sorter.run(workspace.data<int8_t>(),
+             workspace_size,
+             expert_ids.data<int>(),
+             sorted_experts.data<int>(),
+             source_rows.data<int>(),
+             permuted_rows.data<int>(),
+             expanded_rows,
+             false,
+             stream);
+
+  initialize_moe_routing_kernelLauncher(x.data<T>(),
+                                        permuted_x_data,
+                                        permuted_rows.data<int>(),
+                                        dest_rows_data,
+                                        num_rows,
+                                        num_rows,
+                                        cols,
+                                        k,
+                                        stream);
+
+  compute_total_rows_before_expert(sorted_experts.data<int>(),
+                                   x.data<T>(),
+                                   expanded_rows,
+                                   num_experts,
+                                   offsets_data,
+                                   stream);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+#ifdef PADDLE_CUDA_BF16
+PD_REGISTER_KERNEL(moe_permute,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoePermuteKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->InputAt(1).SetDataType(phi::DataType::INT32);
+  kernel->OutputAt(1).SetDataType(phi::DataType::INT64);
+  kernel->OutputAt(2).SetDataType(phi::DataType::INT32);
+}
+#else
+PD_REGISTER_KERNEL(moe_permute,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoePermuteKernel,
+                   float,
+                   phi::dtype::float16) {
+  kernel->InputAt(1).SetDataType(phi::DataType::INT32);
+  kernel->OutputAt(1).SetDataType(phi::DataType::INT64);
+  kernel->OutputAt(2).SetDataType(phi::DataType::INT32);
+}
+#endif
@@ -0,0 +1,93 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/math_function.h"
+#include "paddle/phi/kernels/fusion/cutlass/moe/moe_permute_utils.h"
+
+namespace phi {
+namespace fusion {
+
+template <typename T, typename Context>
+void MoeUnpermuteGradKernel(const Context& dev_ctx,
+                            const DenseTensor& permuted_y,
+                            const DenseTensor& dest_rows,
+                            const DenseTensor& weights,
+                            const DenseTensor& out_grad,
+                            DenseTensor* permuted_y_grad,
+                            DenseTensor* weights_grad) {
+  const int num_rows = weights.dims()[0];
+  const int k = weights.dims()[1];
+  const int cols = permuted_y.dims()[1];
+  // The scatter writes permuted_y_grad as it goes, so it is computed even
+  // when only weights_grad is asked for.
+  DenseTensor y_grad_buffer;
+  if (permuted_y_grad == nullptr) {
+    permuted_y_grad = &y_grad_buffer;
+  }
+  permuted_y_grad->Resize(permuted_y.dims());
+  T* y_grad_data = dev_ctx.template Alloc<T>(permuted_y_grad);
+  float* weights_grad_data = nullptr;
+  if (weights_grad) {
+    weights_grad->Resize(weights.dims());
+    weights_grad_data = dev_ctx.template Alloc<float>(weights_grad);
+  }
+  if (num_rows == 0 || k == 0) {
+    return;
+  }
+  if (cols == 0) {
+    if (weights_grad) {
+      phi::funcs::SetConstant<Context, float>()(dev_ctx, weights_grad, 0.0f);
+    }
+    return;
+  }
+  MoeScatterRowsGradKernel<T>
+      <<<num_rows * k, kMoeRowsThreads, 0, dev_ctx.stream()>>>(
+          out_grad.data<T>(),
+          permuted_y.data<T>(),
+          dest_rows.data<int>(),
+          weights.data<float>(),
+          num_rows,
+          cols,
+          k,
+          y_grad_data,
+          weights_grad_data);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+#ifdef PADDLE_CUDA_BF16
+PD_REGISTER_KERNEL(moe_unpermute_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeUnpermuteGradKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->OutputAt(1).SetDataType(phi::DataType::FLOAT32);
+}
+#else
+PD_REGISTER_KERNEL(moe_unpermute_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeUnpermuteGradKernel,
+                   float,
+                   phi::dtype::float16) {
+  kernel->OutputAt(1).SetDataType(phi::DataType::FLOAT32);
+}
+#endif
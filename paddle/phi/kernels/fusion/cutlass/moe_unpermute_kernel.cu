@@ -0,0 +1,76 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/fusion/cutlass/moe/moe_permute_utils.h"
+
+namespace phi {
+namespace fusion {
+
+// Gathers the k expert outputs of every token back to its row and sums them
+// with the routing weights, the unpermute and combine of fused_moe in one
+// pass. The sums run in float.
+template <typename T, typename Context>
+void MoeUnpermuteKernel(const Context& dev_ctx,
+                        const DenseTensor& permuted_y,
+                        const DenseTensor& dest_rows,
+                        const DenseTensor& weights,
+                        DenseTensor* out) {
+  const int num_rows = weights.dims()[0];
+  const int k = weights.dims()[1];
+  const int cols = permuted_y.dims()[1];
+  out->Resize({num_rows, cols});
+  T* out_data = dev_ctx.template Alloc<T>(out);
+  if (num_rows == 0 || cols == 0) {
+    return;
+  }
+  MoeCombineRowsKernel<T>
+      <<<num_rows, kMoeRowsThreads, 0, dev_ctx.stream()>>>(
+          permuted_y.data<T>(),
+          dest_rows.data<int>(),
+          weights.data<float>(),
+          num_rows,
+          cols,
+          k,
+          out_data);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+#ifdef PADDLE_CUDA_BF16
+PD_REGISTER_KERNEL(moe_unpermute,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeUnpermuteKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->InputAt(1).SetDataType(phi::DataType::INT32);
+  kernel->InputAt(2).SetDataType(phi::DataType::FLOAT32);
+}
+#else
+PD_REGISTER_KERNEL(moe_unpermute,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MoeUnpermuteKernel,
+                   float,
+                   phi::dtype::float16) {
+  kernel->InputAt(1).SetDataType(phi::DataType::INT32);
+  kernel->InputAt(2).SetDataType(phi::DataType::FLOAT32);
+}
+#endif
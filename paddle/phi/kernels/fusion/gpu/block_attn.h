@@ -22,6 +22,7 @@
 #include "paddle/phi/kernels/fusion/gpu/mmha_util.cu.h"
 
 COMMON_DECLARE_bool(use_xqa_optim);
+COMMON_DECLARE_int32(blha_split_kv_len);
 
 #ifdef PADDLE_WITH_HIP
 #define GPU(str) hip##str
@@ -95,6 +96,16 @@ struct Block_AttN_params {
   const float *cache_v_dequant_scales = nullptr;
 
   float rope_theta = 10000.0f;
+
+  // The timesteps of a sequence may be split in chunks of split_len, each
+  // computed by a thread block. The outputs, max logits and sums of the
+  // logits of the splits, [B, q_num_head, num_splits(, head_size)], are then
+  // combined by block_attention_split_reduce_kernel.
+  int num_splits = 1;
+  int split_len = 0;
+  float *split_out = nullptr;
+  float *split_max = nullptr;
+  float *split_sum = nullptr;
 };
 
 template <typename T,
@@ -118,6 +129,19 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
 
   act_time_step += params.pre_cache_length;
 
+  // The thread block computes the timesteps [split_begin, split_end), the
+  // cached ones before cache_end and the current one if has_current.
+  const int split_begin = blockIdx.z * params.split_len;
+  if (split_begin > act_time_step) {
+    return;
+  }
+  const int split_end =
+      params.num_splits > 1
+          ? min(split_begin + params.split_len, act_time_step + 1)
+          : act_time_step + 1;
+  const bool has_current = split_end == act_time_step + 1;
+  const int cache_end = min(split_end, act_time_step);
+
   const int *block_table =
       params.block_tables + bi * params.max_num_blocks_per_seq;
 
@@ -308,7 +332,7 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
       }
     }
     *reinterpret_cast<Qk_vec *>(&q_smem[tid * QK_VEC_SIZE]) = q;
-    if (Dh == Dh_MAX || tid * QK_VEC_SIZE < Dh) {
+    if (has_current && (Dh == Dh_MAX || tid * QK_VEC_SIZE < Dh)) {
       if (CACHE_TYPE == CacheType::INT8) {
         const int offset = base_cache_offset + tid * QK_VEC_SIZE;
         QK_Packed_Int8_t k_tmp =
@@ -340,7 +364,7 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
         (QK_VECS_PER_WARP + WARP_SIZE - 1) / WARP_SIZE;
     qk = block_sum<WARPS_PER_RED>(&red_smem[WARPS_PER_RED], qk);
   }
-  if (tid == 0) {
+  if (tid == 0 && has_current) {
     qk *= params.inv_sqrt_dh;
     if (params.attn_mask) {
       auto mask_bhi = bhi;
@@ -351,7 +375,7 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
       qk += static_cast<float>(mask);
     }
     qk_max = qk;
-    qk_smem[act_time_step] = qk;
+    qk_smem[act_time_step - split_begin] = qk;
   }
   __syncthreads();
   using K_vec = typename K_vec_bttn_<T>::Type;
@@ -378,13 +402,14 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
   // threads in one warp can process 'K_PER_ITER' keys
   constexpr int K_PER_WARP = WARP_SIZE / THREADS_PER_KEY;
 
-  int ti_end = div_up(act_time_step, K_PER_WARP) * K_PER_WARP;
+  int ti_end =
+      split_begin + div_up(cache_end - split_begin, K_PER_WARP) * K_PER_WARP;
 
   K_vec k[K_VECS_PER_THREAD];
   K_vec k_vec_zero;
   zero(k_vec_zero);
   // ti is the timestep index
-  for (int ti = ko; ti < ti_end; ti += K_PER_ITER) {
+  for (int ti = split_begin + ko; ti < ti_end; ti += K_PER_ITER) {
     const int physical_block_number = block_table_smem[ti / BLOCK_SIZE];
     const int block_offset = ti % BLOCK_SIZE;
     const int k_offset =
@@ -392,7 +417,7 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
         kv_hi * BLOCK_SIZE * Dh + block_offset * Dh + ki;
 #pragma unroll
     for (int ii = 0; ii < K_VECS_PER_THREAD; ++ii) {
-      if (ti < act_time_step) {
+      if (ti < cache_end) {
         if (CACHE_TYPE == CacheType::INT8) {
           mul_pointer_v2<K_vec, float, K_vec_I, CACHE_TYPE>(
               &k[ii],
@@ -422,9 +447,9 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
       qk += static_cast<float>(mask);
     }
 
-    if (ti < act_time_step && tid % THREADS_PER_KEY == 0) {
+    if (ti < cache_end && tid % THREADS_PER_KEY == 0) {
       qk_max = fmaxf(qk_max, qk);
-      qk_smem[ti] = qk;
+      qk_smem[ti - split_begin] = qk;
     }
   }
 
@@ -469,7 +494,7 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
 #endif
 
   float sum = 0.f;
-  for (int ti = tid; ti <= act_time_step; ti += THREADS_PER_BLOCK) {
+  for (int ti = tid; ti < split_end - split_begin; ti += THREADS_PER_BLOCK) {
     float logit = __expf(qk_smem[ti] - qk_max);
     sum += logit;
     qk_smem[ti] = logit;
@@ -477,9 +502,11 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
 
   sum = block_sum<WARPS_PER_BLOCK>(&red_smem[WARPS_PER_BLOCK], sum);
 
-  float inv_sum = __fdividef(1.f, sum + 1.e-6f);
+  // The logits of a split are normalized when the splits are combined.
+  float inv_sum =
+      params.num_splits > 1 ? 1.f : __fdividef(1.f, sum + 1.e-6f);
 
-  for (int ti = tid; ti <= act_time_step; ti += THREADS_PER_BLOCK) {
+  for (int ti = tid; ti < split_end - split_begin; ti += THREADS_PER_BLOCK) {
     convert_from_float(logits_smem[ti], qk_smem[ti] * inv_sum);
   }
   __syncthreads();
@@ -502,7 +529,7 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
 
   constexpr int V_PER_ITER = THREADS_PER_BLOCK / THREADS_PER_VALUE;
   if (Dh == Dh_MAX || vi < Dh) {
-    for (int ti = vo; ti < act_time_step; ti += V_PER_ITER) {
+    for (int ti = split_begin + vo; ti < cache_end; ti += V_PER_ITER) {
       int physical_block_number = block_table_smem[ti / BLOCK_SIZE];
 
       const int block_offset = ti % BLOCK_SIZE;
@@ -519,10 +546,10 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
         v = *reinterpret_cast<const V_vec *>(params.v_cache + v_offset);
       }
 #if defined(MMHA_USE_FP32_ACUM_FOR_LOGITS)
-      float logit = logits_smem[ti];
+      float logit = logits_smem[ti - split_begin];
       out = fma(logit, cast_to_float(v), out);
 #else
-      DataType_ logit = static_cast<DataType_>(logits_smem[ti]);
+      DataType_ logit = static_cast<DataType_>(logits_smem[ti - split_begin]);
       // Update the partial sums.
       out = fma(logit, v, out);
 #endif
@@ -531,7 +558,8 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
 
   V_vec v_bias;
   zero(v_bias);
-  if (vo == (act_time_step % V_PER_ITER) && (Dh == Dh_MAX || vi < Dh)) {
+  if (has_current && vo == (act_time_step % V_PER_ITER) &&
+      (Dh == Dh_MAX || vi < Dh)) {
     V_vec v;
     load_func.template load<V_vec>(
         v,
@@ -554,9 +582,9 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
     }
 
 #if defined(MMHA_USE_FP32_ACUM_FOR_LOGITS)
-    out = fma(logits_smem[act_time_step], cast_to_float(v), out);
+    out = fma(logits_smem[act_time_step - split_begin], cast_to_float(v), out);
 #else
-    out = fma(logits_smem[act_time_step], v, out);
+    out = fma(logits_smem[act_time_step - split_begin], v, out);
 #endif
   }
 
@@ -586,6 +614,24 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void block_attention_kernel(
     }
   }
 
+  if (params.num_splits > 1) {
+    const int split_id = bhi * params.num_splits + blockIdx.z;
+    if (vo == 0 && (Dh == Dh_MAX || vi < Dh)) {
+#ifdef MMHA_USE_FP32_ACUM_FOR_OUT
+      *reinterpret_cast<V_vec_acum *>(&params.split_out[split_id * Dh + vi]) =
+          out;
+#else
+      *reinterpret_cast<typename V_vec_acum_fp32_<V_vec>::Type *>(
+          &params.split_out[split_id * Dh + vi]) = cast_to_float(out);
+#endif
+    }
+    if (tid == 0) {
+      params.split_max[split_id] = qk_max;
+      params.split_sum[split_id] = sum;
+    }
+    return;
+  }
+
   if (vo == 0 && (Dh == Dh_MAX || vi < Dh)) {
 #ifdef MMHA_USE_FP32_ACUM_FOR_OUT
     V_vec tmp_out;
@@ -1178,12 +1224,52 @@ __global__ __launch_bounds__(THREADS_PER_BLOCK) void gqa_block_attention_kernel(
 #endif
 }
 
+// Combines the splits of the timesteps of a head, see Block_AttN_params. Each
+// thread computes an element of the output.
+template <typename T, int Dh, typename StoreFunc>
+__global__ void block_attention_split_reduce_kernel(Block_AttN_params<T> params,
+                                                    StoreFunc store_func) {
+  const int bi = blockIdx.y;
+  int act_time_step = params.sequence_lengths[bi];
+  if (act_time_step == 0) {
+    return;
+  }
+  act_time_step += params.pre_cache_length;
+
+  const int hi = blockIdx.x;
+  const int bhi = bi * params.q_num_head + hi;
+  const int num_splits = div_up(act_time_step + 1, params.split_len);
+  const float *split_max = params.split_max + bhi * params.num_splits;
+  const float *split_sum = params.split_sum + bhi * params.num_splits;
+  const float *split_out = params.split_out + bhi * params.num_splits * Dh;
+
+  float qk_max = -FLT_MAX;
+  for (int i = 0; i < num_splits; ++i) {
+    qk_max = fmaxf(qk_max, split_max[i]);
+  }
+  float sum = 0.f;
+  float out = 0.f;
+  for (int i = 0; i < num_splits; ++i) {
+    float scale = __expf(split_max[i] - qk_max);
+    sum += split_sum[i] * scale;
+    out += split_out[i * Dh + threadIdx.x] * scale;
+  }
+  T result = static_cast<T>(out * __fdividef(1.f, sum + 1.e-6f));
+
+  const int ti =
+      params.cum_offsets ? bi * params.seq_len - params.cum_offsets[bi] : -1;
+  const int thi = params.cum_offsets ? ti * params.q_num_head + hi : -1;
+  store_func.template store<T>(
+      result, thi != -1 ? thi * Dh + threadIdx.x : bhi * Dh + threadIdx.x);
+}
+
 template <typename T>
 inline size_t smem_size_in_bytes(const Block_AttN_params<T> &params,
                                  int dim_head,
                                  int threads_per_value,
                                  int threads_per_block) {
-  size_t qk_sz = div_up(params.timestep + 1, 4) * 4 * sizeof(int);
+  int qk_len = params.num_splits > 1 ? params.split_len : params.timestep + 1;
+  size_t qk_sz = div_up(qk_len, 4) * 4 * sizeof(int);
 
   size_t block_table_sz =
       div_up(params.max_num_blocks_per_seq, 4) * 4 * sizeof(int);
@@ -1247,7 +1333,7 @@ inline size_t gqa_smem_size_in_bytes(const Block_AttN_params<T> &params,
                         hipFuncAttributeMaxDynamicSharedMemorySize,        \
                         smem_sz);                                          \
   }                                                                        \
-  dim3 grid(params.q_num_head, params.batch_size);                         \
+  dim3 grid(params.q_num_head, params.batch_size, params.num_splits);      \
   kernel_fn<<<grid, THDS_PER_BLOCK, smem_sz, stream>>>(                    \
       params, load_func, store_func);
 
@@ -1319,7 +1405,7 @@ inline size_t gqa_smem_size_in_bytes(const Block_AttN_params<T> &params,
     cudaFuncSetAttribute(                                                  \
         kernel_fn, cudaFuncAttributeMaxDynamicSharedMemorySize, smem_sz);  \
   }                                                                        \
-  dim3 grid(params.q_num_head, params.batch_size);                         \
+  dim3 grid(params.q_num_head, params.batch_size, params.num_splits);      \
   kernel_fn<<<grid, THDS_PER_BLOCK, smem_sz, stream>>>(                    \
       params, load_func, store_func);
 
@@ -1406,7 +1492,8 @@ void dispatch_blha_gqa_kernel(const Block_AttN_params<T> &params,
                               const GPU(Stream_t) & stream,
                               LoadFunc load_func,
                               StoreFunc store_func) {
-  if (params.gqa_num_per_partitions == 1 || !FLAGS_use_xqa_optim) {
+  if (params.gqa_num_per_partitions == 1 || !FLAGS_use_xqa_optim ||
+      params.num_splits > 1) {
     dispatch_blha_impl_kernel<T,
                               Dh,
                               Dh_MAX,
@@ -1580,6 +1667,11 @@ void dispatch_blha_impl_blocksize(const Block_AttN_params<T> &params,
       PADDLE_THROW(common::errors::Unimplemented(
           "block_size = %d is unsupport!", params.block_size));
   }
+  if (params.num_splits > 1) {
+    block_attention_split_reduce_kernel<T, Dh>
+        <<<dim3(params.q_num_head, params.batch_size), Dh, 0, stream>>>(
+            params, store_func);
+  }
 }
 
 template <typename T, typename LoadFunc, typename StoreFunc>
@@ -1738,6 +1830,23 @@ void blha(const phi::GPUContext &dev_ctx,
   params.rotary_emb_dims = rotary_emb_dims;
   params.rope_theta = rope_theta;
 
+  // Splitting the timesteps gives the long sequences more thread blocks than
+  // the heads, which do not fill the device for small batches.
+  phi::DenseTensor split_out;
+  phi::DenseTensor split_max;
+  phi::DenseTensor split_sum;
+  if (FLAGS_blha_split_kv_len > 0 &&
+      params.timestep + 1 > FLAGS_blha_split_kv_len) {
+    params.split_len = FLAGS_blha_split_kv_len;
+    params.num_splits = div_up(params.timestep + 1, params.split_len);
+    split_out.Resize({batch_size, q_num_head, params.num_splits, dim_head});
+    split_max.Resize({batch_size, q_num_head, params.num_splits});
+    split_sum.Resize({batch_size, q_num_head, params.num_splits});
+    params.split_out = dev_ctx.Alloc<float>(&split_out);
+    params.split_max = dev_ctx.Alloc<float>(&split_max);
+    params.split_sum = dev_ctx.Alloc<float>(&split_sum);
+  }
+
   VLOG(3) << "batch_size: " << batch_size << " q_num_head: " << q_num_head
           << " kv_num_head: " << kv_num_head << " block_size: " << block_size
           << " timestep: " << timestep;
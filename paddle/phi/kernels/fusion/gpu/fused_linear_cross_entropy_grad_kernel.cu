@@ -0,0 +1,148 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <type_traits>
+
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/math_function.h"
+#include "paddle/phi/kernels/fusion/gpu/fused_linear_cross_entropy_utils.h"
+
+namespace phi {
+namespace fusion {
+
+// Turns the logits of a chunk into their grad in place,
+// (softmax - one_hot(label)) * loss_grad, zero for the ignored rows.
+template <typename T, typename LabelT>
+__global__ void ChunkLogitsGradKernel(const LabelT* label,
+                                      const float* lse,
+                                      const T* loss_grad,
+                                      int64_t rows,
+                                      int64_t cols,
+                                      int64_t begin,
+                                      int ignore_index,
+                                      T* logits) {
+  CUDA_KERNEL_LOOP_TYPE(i, rows * cols, int64_t) {
+    int64_t row = i / cols;
+    int64_t row_label = static_cast<int64_t>(label[row]);
+    float grad = 0.f;
+    if (row_label != ignore_index) {
+      float prob = __expf(static_cast<float>(logits[i]) - lse[row]);
+      float one_hot = row_label == begin + i % cols ? 1.f : 0.f;
+      grad = (prob - one_hot) * static_cast<float>(loss_grad[row]);
+    }
+    logits[i] = static_cast<T>(grad);
+  }
+}
+
+template <typename T, typename Context>
+void FusedLinearCrossEntropyGradKernel(const Context& dev_ctx,
+                                       const DenseTensor& x,
+                                       const DenseTensor& weight,
+                                       const DenseTensor& label,
+                                       const DenseTensor& lse,
+                                       const DenseTensor& loss_grad,
+                                       int ignore_index,
+                                       int chunk_size,
+                                       DenseTensor* x_grad,
+                                       DenseTensor* weight_grad) {
+  auto shape = GetLinearCrossEntropyShape(x, weight, chunk_size);
+  T* x_grad_data = x_grad ? dev_ctx.template Alloc<T>(x_grad) : nullptr;
+  T* weight_grad_data =
+      weight_grad ? dev_ctx.template Alloc<T>(weight_grad) : nullptr;
+  if (shape.rows == 0) {
+    if (weight_grad) {
+      funcs::SetConstant<Context, T>()(
+          dev_ctx, weight_grad, static_cast<T>(0));
+    }
+    return;
+  }
+
+  DenseTensor logits;
+  logits.Resize({shape.rows, shape.chunk_size});
+  T* logits_data = dev_ctx.template Alloc<T>(&logits);
+  auto blas = funcs::GetBlas<Context, T>(dev_ctx);
+  VisitLabelType(label, [&](const auto* label_data) {
+    using LabelT = std::decay_t<decltype(*label_data)>;
+    for (int begin = 0; begin < shape.vocab; begin += shape.chunk_size) {
+      int cols = std::min(shape.chunk_size, shape.vocab - begin);
+      ComputeChunkLogits<T>(dev_ctx,
+                            shape,
+                            x.data<T>(),
+                            weight.data<T>(),
+                            begin,
+                            cols,
+                            logits_data);
+      int64_t numel = static_cast<int64_t>(shape.rows) * cols;
+      auto config = backends::gpu::GetGpuLaunchConfig1D(dev_ctx, numel);
+      ChunkLogitsGradKernel<T, LabelT><<<config.block_per_grid.x,
+                                         config.thread_per_block.x,
+                                         0,
+                                         dev_ctx.stream()>>>(
+          label_data,
+          lse.data<float>(),
+          loss_grad.data<T>(),
+          shape.rows,
+          cols,
+          begin,
+          ignore_index,
+          logits_data);
+      if (x_grad_data) {
+        // x_grad [rows, hidden] += logits_grad @ weight_chunk^T
+        blas.GEMM(false,
+                  true,
+                  shape.rows,
+                  shape.hidden,
+                  cols,
+                  static_cast<T>(1),
+                  logits_data,
+                  cols,
+                  weight.data<T>() + begin,
+                  shape.vocab,
+                  static_cast<T>(begin == 0 ? 0 : 1),
+                  x_grad_data,
+                  shape.hidden);
+      }
+      if (weight_grad_data) {
+        // weight_grad [hidden, cols] of the chunk = x^T @ logits_grad
+        blas.GEMM(true,
+                  false,
+                  shape.hidden,
+                  cols,
+                  shape.rows,
+                  static_cast<T>(1),
+                  x.data<T>(),
+                  shape.hidden,
+                  logits_data,
+                  cols,
+                  static_cast<T>(0),
+                  weight_grad_data + begin,
+                  shape.vocab);
+      }
+    }
+  });
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+PD_REGISTER_KERNEL(fused_linear_cross_entropy_grad,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedLinearCrossEntropyGradKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->InputAt(3).SetDataType(phi::DataType::FLOAT32);  // lse
+}
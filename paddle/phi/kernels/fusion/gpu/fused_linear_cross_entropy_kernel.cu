@@ -0,0 +1,158 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cfloat>
+#include <type_traits>
+
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/math_cuda_utils.h"
+#include "paddle/phi/kernels/funcs/math_function.h"
+#include "paddle/phi/kernels/fusion/gpu/fused_linear_cross_entropy_utils.h"
+
+namespace phi {
+namespace fusion {
+
+// Folds the logits of a chunk into the running max and sum of exp of each
+// row, one block a row, and picks the logit of the label in the chunk.
+template <typename T, typename LabelT>
+__global__ void UpdateChunkLseKernel(const T* logits,
+                                     const LabelT* label,
+                                     int64_t cols,
+                                     int64_t begin,
+                                     float* max_logit,
+                                     float* sum_exp,
+                                     float* label_logit) {
+  int64_t row = blockIdx.x;
+  const T* row_logits = logits + row * cols;
+  float thread_max = -FLT_MAX;
+  for (int64_t i = threadIdx.x; i < cols; i += blockDim.x) {
+    thread_max = max(thread_max, static_cast<float>(row_logits[i]));
+  }
+  float chunk_max = funcs::BlockReduceMax<float>(thread_max, FINAL_MASK);
+  float thread_sum = 0.f;
+  for (int64_t i = threadIdx.x; i < cols; i += blockDim.x) {
+    thread_sum += __expf(static_cast<float>(row_logits[i]) - chunk_max);
+  }
+  float chunk_sum = funcs::BlockReduceSum<float>(thread_sum, FINAL_MASK);
+  if (threadIdx.x == 0) {
+    float old_max = max_logit[row];
+    float new_max = max(old_max, chunk_max);
+    sum_exp[row] = sum_exp[row] * __expf(old_max - new_max) +
+                   chunk_sum * __expf(chunk_max - new_max);
+    max_logit[row] = new_max;
+    int64_t index = static_cast<int64_t>(label[row]) - begin;
+    if (index >= 0 && index < cols) {
+      label_logit[row] = static_cast<float>(row_logits[index]);
+    }
+  }
+}
+
+template <typename T, typename LabelT>
+__global__ void LinearCrossEntropyLossKernel(const float* max_logit,
+                                             const float* sum_exp,
+                                             const float* label_logit,
+                                             const LabelT* label,
+                                             int64_t rows,
+                                             int ignore_index,
+                                             T* loss,
+                                             float* lse) {
+  CUDA_KERNEL_LOOP_TYPE(i, rows, int64_t) {
+    float row_lse = max_logit[i] + __logf(sum_exp[i]);
+    lse[i] = row_lse;
+    loss[i] = static_cast<int64_t>(label[i]) == ignore_index
+                  ? static_cast<T>(0)
+                  : static_cast<T>(row_lse - label_logit[i]);
+  }
+}
+
+template <typename T, typename Context>
+void FusedLinearCrossEntropyKernel(const Context& dev_ctx,
+                                   const DenseTensor& x,
+                                   const DenseTensor& weight,
+                                   const DenseTensor& label,
+                                   int ignore_index,
+                                   int chunk_size,
+                                   DenseTensor* loss,
+                                   DenseTensor* lse) {
+  T* loss_data = dev_ctx.template Alloc<T>(loss);
+  float* lse_data = dev_ctx.template Alloc<float>(lse);
+  auto shape = GetLinearCrossEntropyShape(x, weight, chunk_size);
+  if (shape.rows == 0) {
+    return;
+  }
+
+  // the running max, sum of exp and label logit of each row
+  DenseTensor stats;
+  stats.Resize({3, shape.rows});
+  float* stats_data = dev_ctx.template Alloc<float>(&stats);
+  funcs::SetConstant<Context, float> set_constant;
+  set_constant(dev_ctx, &stats, 0.f);
+  DenseTensor max_logit = stats.Slice(0, 1);
+  set_constant(dev_ctx, &max_logit, -FLT_MAX);
+  float* sum_exp_data = stats_data + shape.rows;
+  float* label_logit_data = stats_data + 2 * shape.rows;
+
+  DenseTensor logits;
+  logits.Resize({shape.rows, shape.chunk_size});
+  T* logits_data = dev_ctx.template Alloc<T>(&logits);
+  constexpr int kThreads = 256;
+  VisitLabelType(label, [&](const auto* label_data) {
+    using LabelT = std::decay_t<decltype(*label_data)>;
+    for (int begin = 0; begin < shape.vocab; begin += shape.chunk_size) {
+      int cols = std::min(shape.chunk_size, shape.vocab - begin);
+      ComputeChunkLogits<T>(dev_ctx,
+                            shape,
+                            x.data<T>(),
+                            weight.data<T>(),
+                            begin,
+                            cols,
+                            logits_data);
+      UpdateChunkLseKernel<T, LabelT>
+          <<<shape.rows, kThreads, 0, dev_ctx.stream()>>>(logits_data,
+                                                          label_data,
+                                                          cols,
+                                                          begin,
+                                                          stats_data,
+                                                          sum_exp_data,
+                                                          label_logit_data);
+    }
+    auto config = backends::gpu::GetGpuLaunchConfig1D(dev_ctx, shape.rows);
+    LinearCrossEntropyLossKernel<T, LabelT>
+        <<<config.block_per_grid.x,
+           config.thread_per_block.x,
+           0,
+           dev_ctx.stream()>>>(stats_data,
+                               sum_exp_data,
+                               label_logit_data,
+                               label_data,
+                               shape.rows,
+                               ignore_index,
+                               loss_data,
+                               lse_data);
+  });
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+PD_REGISTER_KERNEL(fused_linear_cross_entropy,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedLinearCrossEntropyKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->OutputAt(1).SetDataType(phi::DataType::FLOAT32);
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/kernels/funcs/blas/blas.h"
+
+namespace phi {
+namespace fusion {
+
+// fused_linear_cross_entropy takes the logits of x [rows, hidden] and the
+// LM head weight [hidden, vocab] a chunk of the vocab at a time, so that at
+// most [rows, chunk_size] of them is held at once, in forward as in
+// backward where they are computed again from x and weight.
+struct LinearCrossEntropyShape {
+  int rows;
+  int hidden;
+  int vocab;
+  int chunk_size;
+};
+
+inline LinearCrossEntropyShape GetLinearCrossEntropyShape(
+    const DenseTensor& x, const DenseTensor& weight, int chunk_size) {
+  LinearCrossEntropyShape shape;
+  shape.hidden = static_cast<int>(weight.dims()[0]);
+  shape.vocab = static_cast<int>(weight.dims()[1]);
+  shape.rows = static_cast<int>(shape.hidden > 0 ? x.numel() / shape.hidden
+                                                 : 0);
+  shape.chunk_size = std::max(1, std::min(chunk_size, shape.vocab));
+  return shape;
+}
+
+// Writes the logits of the columns [begin, begin + cols) of weight to
+// logits [rows, cols].
+template <typename T>
+void ComputeChunkLogits(const GPUContext& dev_ctx,
+                        const LinearCrossEntropyShape& shape,
+                        const T* x,
+                        const T* weight,
+                        int begin,
+                        int cols,
+                        T* logits) {
+  auto blas = funcs::GetBlas<GPUContext, T>(dev_ctx);
+  blas.GEMM(false,
+            false,
+            shape.rows,
+            cols,
+            shape.hidden,
+            static_cast<T>(1),
+            x,
+            shape.hidden,
+            weight + begin,
+            shape.vocab,
+            static_cast<T>(0),
+            logits,
+            cols);
+}
+
+template <typename Visitor>
+void VisitLabelType(const DenseTensor& label, Visitor visitor) {
+  if (label.dtype() == DataType::INT64) {
+    visitor(label.data<int64_t>());
+  } else if (label.dtype() == DataType::INT32) {
+    visitor(label.data<int32_t>());
+  } else {
+    PADDLE_THROW(common::errors::InvalidArgument(
+        "The label of fused_linear_cross_entropy should be int32 or int64, "
+        "but got %s.",
+        label.dtype()));
+  }
+}
+
+}  // namespace fusion
+}  // namespace phi
@@ -0,0 +1,234 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/elementwise_add_kernel.h"
+#include "paddle/phi/kernels/empty_kernel.h"
+#include "paddle/phi/kernels/matmul_kernel.h"
+
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+#include "paddle/phi/core/distributed/nccl_comm_context.h"
+#endif
+
+namespace phi {
+namespace fusion {
+
+// The GEMM of x and y, the first dim of x being gathered before or the
+// first dim of the product scattered after, is split by the block of rows of
+// each rank. The blocks are passed around the ring of ranks on the stream of
+// the comm context while the GEMM of the blocks already there runs on the
+// calculation stream, so that only the transfer of one block is exposed.
+
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+namespace {
+
+distributed::NCCLCommContext* GetNCCLCommContext(const GPUContext& dev_ctx,
+                                                 int nranks) {
+  auto comm_ctx =
+      static_cast<distributed::NCCLCommContext*>(dev_ctx.GetCommContext());
+  PADDLE_ENFORCE_NE(
+      comm_ctx,
+      nullptr,
+      errors::Unavailable("NCCLCommContext is nullptr, collective op should "
+                          "has ring_id attr."));
+  PADDLE_ENFORCE_EQ(
+      nranks,
+      comm_ctx->GetSize(),
+      errors::InvalidArgument(
+          "nranks: %s should equal to %s", nranks, comm_ctx->GetSize()));
+  return comm_ctx;
+}
+
+// The transfers run on the calculation stream, without overlap, when the
+// comm context has no stream of its own.
+class CommStream {
+ public:
+  CommStream(const GPUContext& dev_ctx,
+             distributed::NCCLCommContext* comm_ctx)
+      : comm_ctx_(comm_ctx), calc_stream_(dev_ctx.stream()) {
+    stream_ = comm_ctx->GetDevContext() ? comm_ctx->GetStream() : calc_stream_;
+  }
+
+  gpuStream_t get() const { return stream_; }
+
+  // Makes the transfers enqueued next wait for the calculation so far.
+  void WaitCalc() const {
+    Wait(stream_, calc_stream_, comm_ctx_->GetComputeEvent());
+  }
+
+  // Makes the calculation enqueued next wait for the transfers so far.
+  void CalcWait() const {
+    Wait(calc_stream_, stream_, comm_ctx_->GetCommEvent());
+  }
+
+  // Exchanges count elements with the neighbors in the ring, sending to the
+  // next rank and receiving from the previous one.
+  void Shift(const DenseTensor& send, DenseTensor* recv, int64_t count) const {
+    const int rank = comm_ctx_->GetRank();
+    const int nranks = comm_ctx_->GetSize();
+    comm_ctx_->GroupStart();
+    comm_ctx_->Send(send, count, (rank + 1) % nranks, stream_);
+    comm_ctx_->Recv(recv, count, (rank + nranks - 1) % nranks, stream_);
+    comm_ctx_->GroupEnd();
+  }
+
+ private:
+  void Wait(gpuStream_t waiter, gpuStream_t signaler, gpuEvent_t event) const {
+    if (waiter == signaler) return;
+#ifdef PADDLE_WITH_HIP
+    PADDLE_ENFORCE_GPU_SUCCESS(hipEventRecord(event, signaler));
+    PADDLE_ENFORCE_GPU_SUCCESS(hipStreamWaitEvent(waiter, event, 0));
+#else
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(event, signaler));
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamWaitEvent(waiter, event, 0));
+#endif
+  }
+
+  distributed::NCCLCommContext* comm_ctx_;
+  gpuStream_t calc_stream_;
+  gpuStream_t stream_;
+};
+
+// The block of rows of the tensor viewed as a matrix of cols columns.
+DenseTensor RowBlock(const DenseTensor& tensor,
+                     int64_t cols,
+                     int64_t rows,
+                     int64_t block) {
+  DenseTensor matrix(tensor);
+  matrix.Resize({tensor.numel() / cols, cols});
+  return matrix.Slice(block * rows, (block + 1) * rows);
+}
+
+}  // namespace
+#endif
+
+template <typename T, typename Context>
+void FusedAllGatherMatmulKernel(const Context& dev_ctx,
+                                const DenseTensor& x,
+                                const DenseTensor& y,
+                                int nranks,
+                                bool transpose_y,
+                                DenseTensor* out) {
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+  auto* comm_ctx = GetNCCLCommContext(dev_ctx, nranks);
+  const int rank = comm_ctx->GetRank();
+  const int64_t k = x.dims()[x.dims().size() - 1];
+  const int64_t n = transpose_y ? y.dims()[0] : y.dims()[1];
+  const int64_t rows = x.numel() / k;
+  dev_ctx.template Alloc<T>(out);
+  if (rows == 0) return;
+
+  // The blocks of x of the other ranks, in the order of the ranks.
+  DenseTensor gathered = Empty<T, Context>(dev_ctx, {nranks * rows, k});
+  CommStream comm_stream(dev_ctx, comm_ctx);
+  comm_stream.WaitCalc();
+
+  DenseTensor x_matrix(x);
+  x_matrix.Resize({rows, k});
+  DenseTensor out_block = RowBlock(*out, n, rows, rank);
+  MatmulKernel<T, Context>(
+      dev_ctx, x_matrix, y, false, transpose_y, &out_block);
+  // At step i, the block of rank - i is sent and the one of rank - i - 1
+  // received, whose GEMM then runs while the next step sends it on.
+  for (int step = 0; step < nranks - 1; ++step) {
+    const int send_rank = (rank + nranks - step) % nranks;
+    const int recv_rank = (rank + nranks - step - 1) % nranks;
+    DenseTensor recv = RowBlock(gathered, k, rows, recv_rank);
+    comm_stream.Shift(step == 0 ? x_matrix
+                                : RowBlock(gathered, k, rows, send_rank),
+                      &recv,
+                      rows * k);
+    comm_stream.CalcWait();
+    out_block = RowBlock(*out, n, rows, recv_rank);
+    MatmulKernel<T, Context>(dev_ctx, recv, y, false, transpose_y, &out_block);
+  }
+#else
+  PADDLE_THROW(
+      errors::PreconditionNotMet("PaddlePaddle should compile with GPU."));
+#endif
+}
+
+template <typename T, typename Context>
+void FusedMatmulReduceScatterKernel(const Context& dev_ctx,
+                                    const DenseTensor& x,
+                                    const DenseTensor& y,
+                                    int nranks,
+                                    bool transpose_y,
+                                    DenseTensor* out) {
+#if defined(PADDLE_WITH_NCCL) || defined(PADDLE_WITH_RCCL)
+  auto* comm_ctx = GetNCCLCommContext(dev_ctx, nranks);
+  const int rank = comm_ctx->GetRank();
+  const int64_t k = x.dims()[x.dims().size() - 1];
+  const int64_t n = transpose_y ? y.dims()[0] : y.dims()[1];
+  const int64_t rows = x.numel() / k / nranks;
+  dev_ctx.template Alloc<T>(out);
+  if (rows == 0) return;
+
+  // The partial sums sent and received at each step.
+  DenseTensor partial = Empty<T, Context>(dev_ctx, {nranks * rows, n});
+  DenseTensor received = Empty<T, Context>(dev_ctx, {nranks * rows, n});
+  CommStream comm_stream(dev_ctx, comm_ctx);
+
+  DenseTensor out_matrix(*out);
+  out_matrix.Resize({rows, n});
+  // At step i, the partial sum of the block of rank - i - 1 is computed,
+  // added to the one received from the previous rank and sent to the next,
+  // while the GEMM of the following block runs. The last step leaves the sum
+  // of the block of this rank.
+  for (int step = 0; step < nranks; ++step) {
+    const int block = (rank + 2 * nranks - step - 1) % nranks;
+    DenseTensor x_block = RowBlock(x, k, rows, block);
+    DenseTensor sum = step == nranks - 1
+                          ? out_matrix
+                          : RowBlock(partial, n, rows, step);
+    MatmulKernel<T, Context>(dev_ctx, x_block, y, false, transpose_y, &sum);
+    if (step > 0) {
+      comm_stream.CalcWait();
+      AddKernel<T, Context>(
+          dev_ctx, sum, RowBlock(received, n, rows, step - 1), &sum);
+    }
+    if (step < nranks - 1) {
+      DenseTensor recv = RowBlock(received, n, rows, step);
+      comm_stream.WaitCalc();
+      comm_stream.Shift(sum, &recv, rows * n);
+    }
+  }
+#else
+  PADDLE_THROW(
+      errors::PreconditionNotMet("PaddlePaddle should compile with GPU."));
+#endif
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+PD_REGISTER_KERNEL(fused_allgather_matmul,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedAllGatherMatmulKernel,
+                   float,
+                   double,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
+
+PD_REGISTER_KERNEL(fused_matmul_reduce_scatter,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::fusion::FusedMatmulReduceScatterKernel,
+                   float,
+                   double,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
@@ -313,11 +313,15 @@ class FCOneDNNHandler
 
     if (!memory_p) {
       const float* weights_data = weights->data<float>();
+      // The weights are [IC, OC], in the oneDNN layout they may have been
+      // prepacked at load by onednn_weight_prepack_pass, and are used in
+      // place when their format is the one of the primitive.
       auto weights_dims = this->fwd_pd_->weights_desc().get_dims();
-
-      auto user_md = dnnl::memory::desc(weights_dims,
-                                        OneDNNGetDataType<float>(),
-                                        dnnl::memory::format_tag::io);
+      auto user_md = weights->layout() == DataLayout::ONEDNN
+                         ? weights->mem_desc().permute_axes({1, 0})
+                         : dnnl::memory::desc(weights_dims,
+                                              OneDNNGetDataType<float>(),
+                                              dnnl::memory::format_tag::io);
 
       if (phi::funcs::is_int8<T_w>()) {
         dnnl::primitive_attr attrs;
@@ -539,26 +539,35 @@ void LayerNormKernel(const Context &dev_ctx,
   int64_t feature_size = static_cast<int64_t>(matrix_dim[1]);
   auto stream = dev_ctx.stream();
 
-#define PADDLE_LAUNCH_LAYERNORM_FWD(ScaleBiasT, IsScaleBiasSameDTypeWithX) \
-  do {                                                                     \
-    switch (phi::funcs::GetDesiredBlockDim(feature_size)) {                \
-      FIXED_BLOCK_DIM_CASE(                                                \
-          phi::funcs::                                                     \
-              LayerNormForward<T, U, kBlockDim, IsScaleBiasSameDTypeWithX> \
-          <<<batch_size, kBlockDim, 0, stream>>>(                          \
-              x_data,                                                      \
-              static_cast<const ScaleBiasT *>(void_scale_data),            \
-              static_cast<const ScaleBiasT *>(void_bias_data),             \
-              y_data,                                                      \
-              mean_data,                                                   \
-              var_data,                                                    \
-              epsilon,                                                     \
-              feature_size));                                              \
-      default:                                                             \
-        PADDLE_THROW(common::errors::InvalidArgument(                      \
-            "Product from begin_norm_axis to end must be larger than 1")); \
-        break;                                                             \
-    }                                                                      \
+#define PADDLE_LAUNCH_LAYERNORM_FWD(ScaleBiasT, IsScaleBiasSameDTypeWithX)   \
+  do {                                                                       \
+    auto launch = [&](int block_dim) {                                       \
+      switch (block_dim) {                                                   \
+        FIXED_BLOCK_DIM_CASE(                                                \
+            phi::funcs::                                                     \
+                LayerNormForward<T, U, kBlockDim, IsScaleBiasSameDTypeWithX> \
+            <<<batch_size, kBlockDim, 0, stream>>>(                          \
+                x_data,                                                      \
+                static_cast<const ScaleBiasT *>(void_scale_data),            \
+                static_cast<const ScaleBiasT *>(void_bias_data),             \
+                y_data,                                                      \
+                mean_data,                                                   \
+                var_data,                                                    \
+                epsilon,                                                     \
+                feature_size));                                              \
+        default:                                                             \
+          PADDLE_THROW(common::errors::InvalidArgument(                      \
+              "Product from begin_norm_axis to end must be larger than 1")); \
+          break;                                                             \
+      }                                                                      \
+    };                                                                       \
+    phi::funcs::LaunchWithTunedBlockDim<T>(                                  \
+        dev_ctx,                                                             \
+        phi::autotune::AlgorithmType::kLayerNorm,                            \
+        batch_size,                                                          \
+        feature_size,                                                        \
+        IsScaleBiasSameDTypeWithX,                                           \
+        launch);                                                             \
   } while (0)
 
 #define PADDLE_LAUNCH_FAST_LAYERNORM_FWD_BASE(ScaleT, feature_size)          \
@@ -0,0 +1,250 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/merged_sgd_kernel.h"
+
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/common/amp_type_traits.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/core/tensor_utils.h"
+#include "paddle/phi/kernels/funcs/aligned_vector.h"
+#include "paddle/phi/kernels/funcs/multi_tensor_apply.h"
+
+namespace phi {
+
+template <typename T,
+          typename MT,
+          int VecSize,
+          bool IsMultiPrecision,
+          int N,
+          int MaxTensorSize,
+          int MaxBlockSize>
+struct MergedSGDFunctor {
+  __device__ __forceinline__ void operator()(
+      int chunk_size,
+      const funcs::TensorAndBlockInfo<N, MaxTensorSize, MaxBlockSize>& t_info,
+      const T* learning_rate) const {
+    MT lr = static_cast<MT>(*learning_rate);
+    int chunk_id, tensor_id;
+    t_info.GetChunkIdAndTensorId(&chunk_id, &tensor_id);
+
+    int offset = chunk_id * chunk_size;
+    int n = min(t_info.sizes[tensor_id] - offset, chunk_size);
+    const T* __restrict__ g_ptr =
+        static_cast<const T*>(t_info.grads[tensor_id]) + offset;
+    T* __restrict__ p_ptr =
+        static_cast<T*>(t_info.tensor_addrs[0][tensor_id]) + offset;
+    MT* __restrict__ mp_ptr =
+        IsMultiPrecision
+            ? static_cast<MT*>(t_info.tensor_addrs[1][tensor_id]) + offset
+            : nullptr;
+
+    int stride = blockDim.x * VecSize;
+    for (int idx = threadIdx.x * VecSize; idx < n; idx += stride) {
+      if (idx <= n - VecSize) {
+        phi::AlignedVector<T, VecSize> g_vec;
+        phi::AlignedVector<T, VecSize> p_vec;
+        phi::AlignedVector<MT, VecSize> mp_vec;
+        phi::Load<T, VecSize>(g_ptr + idx, &g_vec);
+        if (IsMultiPrecision) {
+          phi::Load<MT, VecSize>(mp_ptr + idx, &mp_vec);
+        } else {
+          phi::Load<T, VecSize>(p_ptr + idx, &p_vec);
+        }
+#pragma unroll
+        for (int j = 0; j < VecSize; j++) {
+          MT p = IsMultiPrecision ? mp_vec[j] : static_cast<MT>(p_vec[j]);
+          p -= lr * static_cast<MT>(g_vec[j]);
+          p_vec[j] = static_cast<T>(p);
+          mp_vec[j] = p;
+        }
+        phi::Store<T, VecSize>(p_vec, p_ptr + idx);
+        if (IsMultiPrecision) {
+          phi::Store<MT, VecSize>(mp_vec, mp_ptr + idx);
+        }
+      } else {
+        for (int j = idx; j < n; j++) {
+          MT p = IsMultiPrecision ? mp_ptr[j] : static_cast<MT>(p_ptr[j]);
+          p -= lr * static_cast<MT>(g_ptr[j]);
+          p_ptr[j] = static_cast<T>(p);
+          if (IsMultiPrecision) {
+            mp_ptr[j] = p;
+          }
+        }
+      }
+    }
+  }
+};
+
+template <typename Context>
+static void CopyTensorIfDifferent(const Context& dev_ctx,
+                                  const std::vector<const DenseTensor*>& src,
+                                  const std::vector<DenseTensor*>& dst) {
+  for (size_t i = 0; i < src.size(); ++i) {
+    if (src[i] != dst[i]) {
+      VLOG(10) << "Copy Tensor " << i;
+      phi::Copy<Context>(dev_ctx, *(src[i]), dev_ctx.GetPlace(), false, dst[i]);
+    }
+  }
+}
+
+template <typename T, typename TensorT>
+static int GetVecSizeFromTensors(const std::vector<TensorT*>& tensors,
+                                 int vec_size = 4) {
+  for (const auto* t : tensors) {
+    vec_size = min(vec_size, GetVectorizedSize(t->template data<T>()));
+  }
+  return vec_size;
+}
+
+template <typename T, int VecSize, bool IsMultiPrecision, typename Context>
+static void LaunchMergedSGDKernelImpl(
+    const Context& dev_ctx,
+    const std::vector<std::vector<DenseTensor*>>& input_vector,
+    const std::vector<const DenseTensor*>& grads,
+    const T* learning_rate) {
+  using MPDType = typename phi::dtype::MPTypeTrait<T>::Type;
+  // The kernel parameter holding the tensor addresses must stay below 4KB.
+  constexpr int kInputNum = IsMultiPrecision ? 3 : 2;
+  constexpr int kMaxTensorSize = IsMultiPrecision ? 96 : 144;
+  constexpr int kMaxBlockSize = 320;
+  constexpr int kBlockSize = 512;
+  constexpr int kChunkSize = 65536;
+  MergedSGDFunctor<T,
+                   MPDType,
+                   VecSize,
+                   IsMultiPrecision,
+                   kInputNum,
+                   kMaxTensorSize,
+                   kMaxBlockSize>
+      functor;
+  funcs::LaunchMultiTensorApplyKernel<kInputNum, kMaxTensorSize, kMaxBlockSize>(
+      dev_ctx,
+      kBlockSize,
+      kChunkSize,
+      input_vector,
+      grads,
+      functor,
+      learning_rate);
+}
+
+template <typename T, int VecSize, typename Context>
+static void LaunchMergedSGDKernel(
+    const Context& dev_ctx,
+    bool multi_precision,
+    const std::vector<std::vector<DenseTensor*>>& input_vector,
+    const std::vector<const DenseTensor*>& grads,
+    const T* learning_rate) {
+  if (multi_precision) {
+    LaunchMergedSGDKernelImpl<T, VecSize, true>(
+        dev_ctx, input_vector, grads, learning_rate);
+  } else {
+    LaunchMergedSGDKernelImpl<T, VecSize, false>(
+        dev_ctx, input_vector, grads, learning_rate);
+  }
+}
+
+template <typename T, typename Context>
+void MergedSGDKernel(
+    const Context& dev_ctx,
+    const std::vector<const DenseTensor*>& param,
+    const DenseTensor& learning_rate,
+    const std::vector<const DenseTensor*>& grad,
+    const paddle::optional<std::vector<const DenseTensor*>>& master_param,
+    bool multi_precision,
+    std::vector<DenseTensor*> param_out,
+    std::vector<DenseTensor*> master_param_out) {
+  using MPDType = typename phi::dtype::MPTypeTrait<T>::Type;
+  PADDLE_ENFORCE_EQ(
+      param.size(),
+      grad.size(),
+      common::errors::InvalidArgument(
+          "The size of Input(Param) and Input(Grad) of merged_sgd should be "
+          "equal, but received %d and %d.",
+          param.size(),
+          grad.size()));
+  if (multi_precision) {
+    PADDLE_ENFORCE_EQ(
+        master_param && master_param->size() == param.size(),
+        true,
+        common::errors::InvalidArgument(
+            "Input(MasterParam) of merged_sgd should have the same size as "
+            "Input(Param) when multi_precision is true."));
+  }
+
+  CopyTensorIfDifferent(dev_ctx, param, param_out);
+  if (multi_precision) {
+    CopyTensorIfDifferent(dev_ctx, master_param.get(), master_param_out);
+  }
+
+  // The launcher never flushes the blocks pending before an empty tensor
+  // ending the list, so the empty ones are dropped here.
+  std::vector<std::vector<DenseTensor*>> input_vector(multi_precision ? 2 : 1);
+  std::vector<const DenseTensor*> grads;
+  for (size_t i = 0; i < param.size(); ++i) {
+    if (param[i]->numel() == 0) continue;
+    input_vector[0].push_back(param_out[i]);
+    if (multi_precision) {
+      input_vector[1].push_back(master_param_out[i]);
+    }
+    grads.push_back(grad[i]);
+  }
+  if (grads.empty()) return;
+
+  int vec_size = GetVecSizeFromTensors<T>(input_vector[0]);
+  vec_size = GetVecSizeFromTensors<T>(grads, vec_size);
+  if (multi_precision) {
+    vec_size = GetVecSizeFromTensors<MPDType>(input_vector[1], vec_size);
+  }
+  const T* lr = learning_rate.data<T>();
+  VLOG(4) << "merged_sgd updates " << grads.size()
+          << " tensors, vec_size: " << vec_size;
+
+  switch (vec_size) {
+    case 4:
+      LaunchMergedSGDKernel<T, 4>(
+          dev_ctx, multi_precision, input_vector, grads, lr);
+      break;
+    case 2:
+      LaunchMergedSGDKernel<T, 2>(
+          dev_ctx, multi_precision, input_vector, grads, lr);
+      break;
+    case 1:
+      LaunchMergedSGDKernel<T, 1>(
+          dev_ctx, multi_precision, input_vector, grads, lr);
+      break;
+    default:
+      PADDLE_THROW(common::errors::InvalidArgument(
+          "Unsupported vectorized size %d", vec_size));
+  }
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(merged_sgd,
+                   GPU,
+                   ALL_LAYOUT,
+                   phi::MergedSGDKernel,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16,
+                   float,
+                   double) {
+  if (kernel_key.dtype() == phi::DataType::FLOAT16 ||
+      kernel_key.dtype() == phi::DataType::BFLOAT16) {
+    kernel->OutputAt(1).SetDataType(phi::DataType::FLOAT32);
+  }
+}
@@ -0,0 +1,252 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The strided kernels of the elementwise operators and of cast read their
+// inputs through the strides, see cpu/strided_elementwise_kernel.cc. The
+// offsets are computed by IndexCalculator, in int, so the tensors too large
+// for it are copied to contiguous tensors first.
+
+#include <limits>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_launch_config.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/core/visit_type.h"
+#include "paddle/phi/kernels/cast_kernel.h"
+#include "paddle/phi/kernels/contiguous_kernel.h"
+#include "paddle/phi/kernels/elementwise_add_kernel.h"
+#include "paddle/phi/kernels/elementwise_divide_kernel.h"
+#include "paddle/phi/kernels/elementwise_multiply_kernel.h"
+#include "paddle/phi/kernels/elementwise_subtract_kernel.h"
+#include "paddle/phi/kernels/funcs/elementwise_functor.h"
+#include "paddle/phi/kernels/funcs/index_calculator.h"
+#include "paddle/phi/kernels/funcs/strided_utils.h"
+
+COMMON_DECLARE_bool(use_stride_kernel);
+
+namespace phi {
+
+template <typename T, typename Functor>
+__global__ void StridedBinaryCUDAKernel(const T* x,
+                                        const T* y,
+                                        T* out,
+                                        funcs::IndexCalculator x_index,
+                                        funcs::IndexCalculator y_index,
+                                        int numel,
+                                        Functor func) {
+  CUDA_KERNEL_LOOP(i, numel) { out[i] = func(x[x_index(i)], y[y_index(i)]); }
+}
+
+template <typename InT, typename OutT>
+__global__ void StridedCastCUDAKernel(const InT* x,
+                                      OutT* out,
+                                      funcs::IndexCalculator x_index,
+                                      int numel) {
+  CUDA_KERNEL_LOOP(i, numel) { out[i] = static_cast<OutT>(x[x_index(i)]); }
+}
+
+// The offsets of a tensor read with strides at each index of dims, in the
+// order of the elements.
+static funcs::IndexCalculator StridedIndexCalculator(
+    const DDim& dims, const std::vector<int64_t>& strides) {
+  int rank = dims.size();
+  std::vector<int> cal_dims(rank);
+  std::vector<int> cal_strides(rank);
+  std::vector<int> full_strides(rank);
+  int64_t stride = 1;
+  for (int i = rank - 1; i >= 0; --i) {
+    cal_dims[i] = i;
+    cal_strides[i] = static_cast<int>(stride);
+    full_strides[i] = static_cast<int>(strides[i]);
+    stride *= dims[i];
+  }
+  return funcs::IndexCalculator(rank, cal_dims, cal_strides, full_strides);
+}
+
+// Whether the offsets of x, bounded by its holder, fit in an int.
+static bool FitsIndexCalculator(const DenseTensor& x) {
+  return x.Holder()->size() / SizeOf(x.dtype()) <=
+         static_cast<size_t>(std::numeric_limits<int>::max());
+}
+
+template <typename T>
+static DenseTensor ToContiguous(const GPUContext& dev_ctx,
+                                const DenseTensor& x) {
+  if (x.meta().is_contiguous()) {
+    return x;
+  }
+  DenseTensor out;
+  ContiguousKernel<T, GPUContext>(dev_ctx, x, &out);
+  return out;
+}
+
+static void CheckStrideKernelEnabled() {
+  if (!FLAGS_use_stride_kernel) {
+    PADDLE_THROW(common::errors::Fatal(
+        "FLAGS_use_stride_kernel is closed. Strided kernel "
+        "be called, something wrong has happened!"));
+  }
+}
+
+template <typename T, typename Functor>
+void StridedBinaryCompute(const GPUContext& dev_ctx,
+                          const DenseTensor& x,
+                          const DenseTensor& y,
+                          Functor func,
+                          DenseTensor* out) {
+  T* out_data = dev_ctx.Alloc<T>(out);
+  int numel = static_cast<int>(out->numel());
+  if (numel == 0) {
+    return;
+  }
+  const DDim& dims = out->dims();
+  auto config = backends::gpu::GetGpuLaunchConfig1D(dev_ctx, numel);
+  StridedBinaryCUDAKernel<T>
+      <<<config.block_per_grid, config.thread_per_block, 0, dev_ctx.stream()>>>(
+          x.data<T>(),
+          y.data<T>(),
+          out_data,
+          StridedIndexCalculator(dims, BroadcastStrides(x, dims)),
+          StridedIndexCalculator(dims, BroadcastStrides(y, dims)),
+          numel,
+          func);
+}
+
+#define DEFINE_GPU_STRIDED_BINARY_KERNEL(name, functor)                   \
+  template <typename T, typename Context>                                 \
+  void name##StridedKernel(const Context& dev_ctx,                        \
+                           const DenseTensor& x,                          \
+                           const DenseTensor& y,                          \
+                           DenseTensor* out) {                            \
+    CheckStrideKernelEnabled();                                           \
+    if (x.meta().is_contiguous() && y.meta().is_contiguous()) {           \
+      name##Kernel<T, Context>(dev_ctx, x, y, out);                       \
+      return;                                                             \
+    }                                                                     \
+    if (out->numel() > std::numeric_limits<int>::max() ||                 \
+        !FitsIndexCalculator(x) || !FitsIndexCalculator(y)) {             \
+      DenseTensor x_contiguous = ToContiguous<T>(dev_ctx, x);             \
+      DenseTensor y_contiguous = ToContiguous<T>(dev_ctx, y);             \
+      name##Kernel<T, Context>(dev_ctx, x_contiguous, y_contiguous, out); \
+      return;                                                             \
+    }                                                                     \
+    StridedBinaryCompute<T>(dev_ctx, x, y, funcs::functor<T>(), out);     \
+  }
+
+DEFINE_GPU_STRIDED_BINARY_KERNEL(Add, AddFunctor)
+DEFINE_GPU_STRIDED_BINARY_KERNEL(Subtract, SubtractFunctor)
+DEFINE_GPU_STRIDED_BINARY_KERNEL(Multiply, MultiplyFunctor)
+DEFINE_GPU_STRIDED_BINARY_KERNEL(Divide, DivideFunctor)
+
+template <typename InT, typename OutT>
+void StridedCastCompute(const GPUContext& dev_ctx,
+                        const DenseTensor& x,
+                        DenseTensor* out) {
+  OutT* out_data = dev_ctx.Alloc<OutT>(out);
+  int numel = static_cast<int>(out->numel());
+  if (numel == 0) {
+    return;
+  }
+  auto config = backends::gpu::GetGpuLaunchConfig1D(dev_ctx, numel);
+  StridedCastCUDAKernel<InT, OutT>
+      <<<config.block_per_grid, config.thread_per_block, 0, dev_ctx.stream()>>>(
+          x.data<InT>(),
+          out_data,
+          StridedIndexCalculator(x.dims(),
+                                 common::vectorize<int64_t>(x.strides())),
+          numel);
+}
+
+template <typename T, typename Context>
+void CastStridedKernel(const Context& dev_ctx,
+                       const DenseTensor& x,
+                       DataType out_dtype,
+                       DenseTensor* out) {
+  CheckStrideKernelEnabled();
+  if (x.meta().is_contiguous()) {
+    CastKernel<T, Context>(dev_ctx, x, out_dtype, out);
+    return;
+  }
+  if (x.numel() > std::numeric_limits<int>::max() ||
+      !FitsIndexCalculator(x)) {
+    DenseTensor x_contiguous = ToContiguous<T>(dev_ctx, x);
+    CastKernel<T, Context>(dev_ctx, x_contiguous, out_dtype, out);
+    return;
+  }
+  PD_VISIT_ALL_TYPES(out_dtype, "CastStridedKernel", ([&] {
+                       StridedCastCompute<T, data_t>(dev_ctx, x, out);
+                     }));
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(add,
+                   GPU,
+                   STRIDED,
+                   phi::AddStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
+
+PD_REGISTER_KERNEL(subtract,
+                   GPU,
+                   STRIDED,
+                   phi::SubtractStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
+
+PD_REGISTER_KERNEL(multiply,
+                   GPU,
+                   STRIDED,
+                   phi::MultiplyStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
+
+PD_REGISTER_KERNEL(divide,
+                   GPU,
+                   STRIDED,
+                   phi::DivideStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
+
+PD_REGISTER_KERNEL(cast,
+                   GPU,
+                   STRIDED,
+                   phi::CastStridedKernel,
+                   float,
+                   double,
+                   int,
+                   int64_t,
+                   bool,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->OutputAt(0).SetDataType(phi::DataType::UNDEFINED);
+}
@@ -17,6 +17,7 @@
 #include "glog/logging.h"
 
 #include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_helper.h"
 #include "paddle/phi/common/bfloat16.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/core/tensor_utils.h"
@@ -53,6 +54,94 @@ namespace phi {
   FIXED_MAXLENGTH_BASE(4, ##__VA_ARGS__); \
   FIXED_MAXLENGTH_BASE(5, ##__VA_ARGS__)
 
+#if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 9000
+// Rows at least this wide select their top k by radix select rather than by
+// KeMatrixTopK, whose per-thread top lists only pay off on short rows.
+constexpr int64_t kRadixTopKMinWidth = 1024;
+
+// Reorders the radix selected indices of every row by the positions the
+// sorting of the selected values produced.
+__global__ void GatherSortedTopKIndices(const int64_t* indices,
+                                        const int64_t* sorted_positions,
+                                        int64_t num,
+                                        int k,
+                                        int64_t* out) {
+  CUDA_KERNEL_LOOP_TYPE(i, num, int64_t) {
+    int64_t row_start = i / k * k;
+    out[i] = indices[row_start + sorted_positions[i]];
+  }
+}
+
+// Selects the top k of every row of a [height, width] input with one
+// RadixTopK launch, then sorts the k selected values of each row when asked.
+// Returns false when the sorting fails, leaving the caller to fall back.
+template <typename T, typename Context>
+static bool RadixTopKRows(const Context& dev_ctx,
+                          const T* input_data,
+                          int64_t height,
+                          int64_t width,
+                          int k,
+                          bool largest,
+                          bool sorted,
+                          DenseTensor* out,
+                          DenseTensor* indices) {
+  constexpr int max_num_threads = 1024;
+  // The blocks stride over the rows past this grid size.
+  constexpr int64_t kMaxGridSize = 65535;
+  int grid_size = static_cast<int>(std::min(height, kMaxGridSize));
+  T* output_data = out->data<T>();
+  int64_t* indices_data = indices->data<int64_t>();
+  // 1. Gather TopK, but without sorting
+  if (largest) {
+    phi::funcs::RadixTopK<T, true>
+        <<<grid_size, max_num_threads, 0, dev_ctx.stream()>>>(
+            input_data, k, height, width, output_data, indices_data);
+  } else {
+    phi::funcs::RadixTopK<T, false>
+        <<<grid_size, max_num_threads, 0, dev_ctx.stream()>>>(
+            input_data, k, height, width, output_data, indices_data);
+  }
+  if (!sorted) return true;
+
+  // 2. Sort the selected values of every row
+  DenseTensor sorted_output;
+  DenseTensor sorted_positions;
+  DenseTensor gather_indices;
+  sorted_output.Resize(out->dims());
+  sorted_positions.Resize(indices->dims());
+  gather_indices.Resize(indices->dims());
+  dev_ctx.template Alloc<T>(&sorted_output);
+  dev_ctx.template Alloc<int64_t>(&sorted_positions);
+  dev_ctx.template Alloc<int64_t>(&gather_indices);
+  auto* ctx = reinterpret_cast<const phi::GPUContext*>(&dev_ctx);
+  if (!phi::funcs::SortTopk<T>(*ctx,
+                               out,
+                               k,
+                               height,
+                               k,
+                               &sorted_output,
+                               &sorted_positions,
+                               largest)) {
+    VLOG(4) << "TopKOP: Some errors happened when use cub sorting, use "
+               "default topk kernel.";
+    return false;
+  }
+  int64_t num = height * k;
+  auto config = phi::backends::gpu::GetGpuLaunchConfig1D(dev_ctx, num);
+  GatherSortedTopKIndices<<<config.block_per_grid,
+                            config.thread_per_block,
+                            0,
+                            dev_ctx.stream()>>>(indices_data,
+                                                sorted_positions.data<int64_t>(),
+                                                num,
+                                                k,
+                                                gather_indices.data<int64_t>());
+  Copy(dev_ctx, gather_indices, indices->place(), false, indices);
+  Copy(dev_ctx, sorted_output, out->place(), false, out);
+  return true;
+}
+#endif
+
 template <typename T, typename Context>
 void TopkKernel(const Context& dev_ctx,
                 const DenseTensor& x,
@@ -126,58 +215,16 @@ void TopkKernel(const Context& dev_ctx,
     }
 
 #if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 9000
-    if (input_width >= 1024 && in_dims.size() == 1) {
-      // 1. Gather TopK, but without sorting
-      constexpr int max_num_threads = 1024;
-      if (largest) {
-        phi::funcs::RadixTopK<T, true>
-            <<<input_height, max_num_threads, 0, dev_ctx.stream()>>>(
-                input_data,
-                k,
-                input_height,
-                input_width,
-                output_data,
-                indices_data);
-      } else {
-        phi::funcs::RadixTopK<T, false>
-            <<<input_height, max_num_threads, 0, dev_ctx.stream()>>>(
-                input_data,
-                k,
-                input_height,
-                input_width,
-                output_data,
-                indices_data);
-      }
-      // 2. Sort if needed
-      if (sorted) {
-        DenseTensor sorted_output;
-        DenseTensor sorted_indices;
-        DenseTensor gather_indices;
-        sorted_output.Resize(out->dims());
-        sorted_indices.Resize(indices->dims());
-        gather_indices.Resize(indices->dims());
-        dev_ctx.template Alloc<T>(&sorted_output);
-        dev_ctx.template Alloc<int64_t>(&sorted_indices);
-        dev_ctx.template Alloc<int64_t>(&gather_indices);
-        auto* ctx = reinterpret_cast<const phi::GPUContext*>(&dev_ctx);
-        if (phi::funcs::SortTopk<T>(*ctx,
-                                    out,
-                                    k,
-                                    input_height,
-                                    k,
-                                    &sorted_output,
-                                    &sorted_indices,
-                                    largest)) {
-          funcs::GPUGather<int64_t, int64_t>(
-              dev_ctx, *indices, sorted_indices, &gather_indices);
-          Copy(dev_ctx, gather_indices, indices->place(), false, indices);
-          Copy(dev_ctx, sorted_output, out->place(), false, out);
-          return;
-        } else {
-          VLOG(4) << "TopKOP: Some errors happened when use cub sorting, use "
-                     "default topk kernel.";
-        }
-      } else {
+    if (input_width >= kRadixTopKMinWidth) {
+      if (RadixTopKRows<T>(dev_ctx,
+                           input_data,
+                           input_height,
+                           input_width,
+                           k,
+                           largest,
+                           sorted,
+                           out,
+                           indices)) {
         return;
       }
     }
@@ -294,6 +341,26 @@ void TopkKernel(const Context& dev_ctx,
       }
     }
 
+#if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 9000
+    if (input_width >= kRadixTopKMinWidth) {
+      if (RadixTopKRows<T>(dev_ctx,
+                           trans_input.data<T>(),
+                           input_height,
+                           input_width,
+                           k,
+                           largest,
+                           sorted,
+                           &trans_out,
+                           &trans_ind)) {
+        funcs::TransCompute<phi::GPUContext, int64_t>(
+            ndims, dev_ctx, trans_ind, indices, trans);
+        funcs::TransCompute<phi::GPUContext, T>(
+            ndims, dev_ctx, trans_out, out, trans);
+        return;
+      }
+    }
+#endif
+
     const int kMaxHeight = 2048;
     int gridx = input_height < kMaxHeight ? input_height : kMaxHeight;
     auto config =
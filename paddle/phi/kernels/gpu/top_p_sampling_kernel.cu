@@ -14,6 +14,9 @@
 
 #include "paddle/phi/kernels/top_p_sampling_kernel.h"
 
+#include <cfloat>
+#include <type_traits>
+
 #ifdef PADDLE_WITH_HIP
 #include <hip/hip_fp16.h>
 #include <hip/hip_runtime.h>
@@ -142,6 +145,10 @@ struct Pair {
   int id;
 };
 
+// From this vocabulary size on, the rows not sampled from the beam top k are
+// sampled by topp_sampling_radix rather than after a segmented sort.
+constexpr int kRadixSamplingMinVocabSize = 4096;
+
 int GetBlockSize(int vocab_size) {
   if (vocab_size > 512) {
     return 1024;
@@ -965,6 +972,116 @@ __global__ void topp_sampling_ft(T* sorted_probs,
   }
 }
 
+#if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 9000
+// Samples the rows the beam top k left open without sorting them. The
+// smallest probability of the top p nucleus is found by a radix select over
+// the probability mass, 8 bits per pass, then the nucleus is sampled with the
+// exponential race of topp_sampling. Unlike there, every probability tying
+// with the smallest one joins the nucleus.
+template <typename T, int BLOCK_SIZE>
+__global__ void topp_sampling_radix(const T* probs,
+                                    T* out_val,
+                                    int64_t* out_id,
+                                    const T* top_ps,
+                                    const T* threshold,
+                                    GPU(randState_t) * states,
+                                    const int vocab_size,
+                                    int* count_iter,
+                                    int* count_iter_begin) {
+  using RadixConfig = phi::funcs::RadixTypeConfig<T>;
+  using RadixType = typename RadixConfig::RadixType;
+  constexpr int kRadixBits = 8;
+  constexpr int kRadixSize = 1 << kRadixBits;
+  __shared__ float bins[kRadixSize];
+  __shared__ RadixType desired_shared;
+  __shared__ float remain_shared;
+  const int tid = threadIdx.x;
+  const int bid = blockIdx.x;
+  if (count_iter_begin[bid] == count_iter[bid + 1]) {
+    // topk
+    return;
+  }
+
+  const T* row = probs + static_cast<int64_t>(bid) * vocab_size;
+  RadixType desired = 0;
+  RadixType desired_mask = 0;
+  // The mass still needed from the values matching the digits chosen so far.
+  float remain = static_cast<float>(top_ps[bid]);
+  for (int digit_pos = sizeof(T) * 8 - kRadixBits; digit_pos >= 0;
+       digit_pos -= kRadixBits) {
+    for (int i = tid; i < kRadixSize; i += BLOCK_SIZE) {
+      bins[i] = 0.f;
+    }
+    __syncthreads();
+    for (int i = tid; i < vocab_size; i += BLOCK_SIZE) {
+      RadixType key = RadixConfig::Convert(row[i]);
+      if ((key & desired_mask) == desired) {
+        atomicAdd(&bins[(key >> digit_pos) & (kRadixSize - 1)],
+                  static_cast<float>(row[i]));
+      }
+    }
+    __syncthreads();
+    if (tid == 0) {
+      // Take the largest digit whose mass, with that of the larger digits,
+      // reaches the remaining mass. When rounding leaves it short, the
+      // smallest digit with mass is taken from here on, keeping every
+      // non-zero probability in the nucleus.
+      int digit = 0;
+      float above = 0.f;
+      bool found = false;
+      for (int b = kRadixSize - 1; b >= 0; --b) {
+        if (bins[b] <= 0.f) continue;
+        digit = b;
+        if (above + bins[b] >= remain) {
+          found = true;
+          break;
+        }
+        above += bins[b];
+      }
+      desired_shared = desired | (static_cast<RadixType>(digit) << digit_pos);
+      remain_shared = found ? remain - above : FLT_MAX;
+    }
+    __syncthreads();
+    desired = desired_shared;
+    remain = remain_shared;
+    desired_mask |= static_cast<RadixType>(kRadixSize - 1) << digit_pos;
+  }
+
+  const float threshold_now =
+      threshold ? static_cast<float>(threshold[bid]) : 0.f;
+  Pair<T> max_thread_pair(static_cast<T>(0.), -1);
+  Pair<T> top_thread_pair(static_cast<T>(0.), -1);
+  for (int i = tid; i < vocab_size; i += BLOCK_SIZE) {
+    if (RadixConfig::Convert(row[i]) < desired) continue;
+    float prob = static_cast<float>(row[i]);
+    float random_ratio =
+        exponential_transform(GPU(rand_uniform)(states + bid), 1.0f);
+    float tmp_val = (prob >= threshold_now ? prob : 0.f) / random_ratio;
+    if (static_cast<float>(max_thread_pair.v) < tmp_val) {
+      max_thread_pair.set(static_cast<T>(tmp_val), i);
+    }
+    if (top_thread_pair.id == -1 || top_thread_pair < row[i]) {
+      top_thread_pair.set(row[i], i);
+    }
+  }
+
+  typedef cub::BlockReduce<Pair<T>, BLOCK_SIZE> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage_reduce;
+  Pair<T> max_pair = BlockReduce(temp_storage_reduce)
+                         .Reduce(max_thread_pair, MaxOp<Pair<T>>());
+  __syncthreads();
+  Pair<T> top_pair = BlockReduce(temp_storage_reduce)
+                         .Reduce(top_thread_pair, MaxOp<Pair<T>>());
+  if (tid == 0) {
+    // As topp_sampling, fall back to the most probable when the threshold
+    // rules out the whole nucleus.
+    int id = max_pair.id == -1 ? top_pair.id : max_pair.id;
+    out_id[bid] = id;
+    out_val[bid] = row[id];
+  }
+}
+#endif
+
 template <typename T, typename Context>
 void DispatchTopPSampling(const Context& dev_ctx,
                           T* sorted_probs,
@@ -1098,26 +1215,6 @@ void TopPSamplingKernel(const Context& dev_ctx,
   dev_ctx.template Alloc<T>(&ps_now);
   phi::Copy(dev_ctx, ps, dev_ctx.GetPlace(), false, &ps_now);
 
-  DenseTensor inds_input;
-  inds_input.Resize(phi::make_ddim({bs, vocab_size}));
-  dev_ctx.template Alloc<int64_t>(&inds_input);
-
-  DenseTensor sorted_out;
-  sorted_out.Resize(phi::make_ddim({bs, vocab_size}));
-  dev_ctx.template Alloc<T>(&sorted_out);
-
-  DenseTensor sorted_id;
-  sorted_id.Resize(phi::make_ddim({bs, vocab_size}));
-  dev_ctx.template Alloc<int64_t>(&sorted_id);
-
-  int BlockSize = GetBlockSize(vocab_size);
-
-  switch (BlockSize) {
-    FIXED_BLOCK_DIM(FillIndex<int64_t><<<bs, kBlockDim, 0, cu_stream>>>(
-        inds_input.data<int64_t>(), bs, vocab_size));
-    default:
-      PD_THROW("the input data shape has error in the FillIndex kernel.");
-  }
   int64_t* infer_seed = SafeGetTensorPtr<int64_t>(topp_seed);
 
   GPU(randState_t) * states{nullptr};
@@ -1181,6 +1278,46 @@ void TopPSamplingKernel(const Context& dev_ctx,
       need_batch_random,
       mode);
 
+#if defined(PADDLE_WITH_CUDA) && CUDA_VERSION >= 9000
+  // Large vocabularies skip sorting the rows the beam top k left open, their
+  // nucleus is found by radix select instead.
+  if (mode != "truncated" && vocab_size >= kRadixSamplingMinVocabSize &&
+      !std::is_integral<T>::value) {
+    topp_sampling_radix<T, 1024>
+        <<<bs, 1024, 0, cu_stream>>>(x.data<T>(),
+                                     out_ptr,
+                                     ids_ptr,
+                                     ps_now.data<T>(),
+                                     threshold_data,
+                                     states,
+                                     vocab_size,
+                                     count_iter.data<int>(),
+                                     count_iter_begin.data<int>());
+    return;
+  }
+#endif
+
+  DenseTensor inds_input;
+  inds_input.Resize(phi::make_ddim({bs, vocab_size}));
+  dev_ctx.template Alloc<int64_t>(&inds_input);
+
+  DenseTensor sorted_out;
+  sorted_out.Resize(phi::make_ddim({bs, vocab_size}));
+  dev_ctx.template Alloc<T>(&sorted_out);
+
+  DenseTensor sorted_id;
+  sorted_id.Resize(phi::make_ddim({bs, vocab_size}));
+  dev_ctx.template Alloc<int64_t>(&sorted_id);
+
+  int BlockSize = GetBlockSize(vocab_size);
+
+  switch (BlockSize) {
+    FIXED_BLOCK_DIM(FillIndex<int64_t><<<bs, kBlockDim, 0, cu_stream>>>(
+        inds_input.data<int64_t>(), bs, vocab_size));
+    default:
+      PD_THROW("the input data shape has error in the FillIndex kernel.");
+  }
+
   size_t temp_storage_bytes = 0;
 
   cub::TransformInputIterator<int, SegmentOffsetIter, int*>
@@ -19,6 +19,7 @@ limitations under the License. */
 #include "paddle/phi/common/bfloat16.h"
 #include "paddle/phi/common/float16.h"
 #include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/kernels/autotune/auto_tune_base.h"
 #include "paddle/phi/kernels/funcs/aligned_vector.h"
 #include "paddle/phi/kernels/funcs/axis_utils.h"
 #include "paddle/phi/kernels/primitive/kernel_primitives.h"
@@ -1257,49 +1258,63 @@ void SoftmaxForwardCUDAKernelDriverImpl(const GPUContext& dev_ctx,
       int warp_size = (dim_ceil < 32) ? dim_ceil : 32;
       int batches_per_warp = (dim_ceil <= 32) ? 2 : 1;
 
-      // use 128 threads per block to maximimize gpu utilization
-      constexpr int threads_per_block = 128;
-
-      int warps_per_block = (threads_per_block / warp_size);
-      int batches_per_block = warps_per_block * batches_per_warp;
-      IndexType blocks = (N + batches_per_block - 1) / batches_per_block;
-      dim3 threads(warp_size, warps_per_block, 1);
-
       // vectorization read/write
       using T4 = typename VecT4<T>::Type;
       using T2 = typename VecT2<T>::Type;
 
-      if (dim % 4 == 0) {
-        SwitchWarpSoftmaxForward<T, T4, IndexType, LogMode>(blocks,
-                                                            threads,
-                                                            dev_ctx,
-                                                            out_data,
-                                                            x.data<T>(),
-                                                            N,
-                                                            dim,
-                                                            dim,
-                                                            dim_log2);
-      } else if (dim % 2 == 0) {
-        SwitchWarpSoftmaxForward<T, T2, IndexType, LogMode>(blocks,
-                                                            threads,
-                                                            dev_ctx,
-                                                            out_data,
-                                                            x.data<T>(),
-                                                            N,
-                                                            dim,
-                                                            dim,
-                                                            dim_log2);
-      } else {
-        SwitchWarpSoftmaxForward<T, T, IndexType, LogMode>(blocks,
-                                                           threads,
-                                                           dev_ctx,
-                                                           out_data,
-                                                           x.data<T>(),
-                                                           N,
-                                                           dim,
-                                                           dim,
-                                                           dim_log2);
+      auto launch = [&](int threads_per_block, int vec_size) {
+        int warps_per_block = (threads_per_block / warp_size);
+        int batches_per_block = warps_per_block * batches_per_warp;
+        IndexType blocks = (N + batches_per_block - 1) / batches_per_block;
+        dim3 threads(warp_size, warps_per_block, 1);
+        if (vec_size == 4) {
+          SwitchWarpSoftmaxForward<T, T4, IndexType, LogMode>(blocks,
+                                                              threads,
+                                                              dev_ctx,
+                                                              out_data,
+                                                              x.data<T>(),
+                                                              N,
+                                                              dim,
+                                                              dim,
+                                                              dim_log2);
+        } else if (vec_size == 2) {
+          SwitchWarpSoftmaxForward<T, T2, IndexType, LogMode>(blocks,
+                                                              threads,
+                                                              dev_ctx,
+                                                              out_data,
+                                                              x.data<T>(),
+                                                              N,
+                                                              dim,
+                                                              dim,
+                                                              dim_log2);
+        } else {
+          SwitchWarpSoftmaxForward<T, T, IndexType, LogMode>(blocks,
+                                                             threads,
+                                                             dev_ctx,
+                                                             out_data,
+                                                             x.data<T>(),
+                                                             N,
+                                                             dim,
+                                                             dim,
+                                                             dim_log2);
+        }
+      };
+
+      // The heuristic uses 128 threads per block to maximimize gpu
+      // utilization and the widest vectorization, the others are tuned.
+      int max_vec_size = (dim % 4 == 0) ? 4 : ((dim % 2 == 0) ? 2 : 1);
+      phi::autotune::LaunchConfigAutoTuner<T> tuner;
+      for (int threads_per_block : {128, 256, 64}) {
+        for (int vec_size = max_vec_size; vec_size > 0; vec_size /= 2) {
+          tuner.AddCandidate(
+              [=, &launch] { launch(threads_per_block, vec_size); });
+        }
       }
+      size_t key = phi::autotune::GenKey(static_cast<int64_t>(N),
+                                         static_cast<int64_t>(dim),
+                                         LogMode,
+                                         static_cast<int64_t>(x.dtype()));
+      tuner.Run(dev_ctx, phi::autotune::AlgorithmType::kSoftmax, key);
     } else {
       if (dim >= MATRIX_SOFTMAX_THREAHOLD) {
         LaunchKeMatrixSoftmaxForwardKernel<T, IndexType, LogMode>(
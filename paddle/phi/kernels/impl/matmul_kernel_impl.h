@@ -919,6 +919,30 @@ struct MatMulDispatcher {
 #ifdef PADDLE_WITH_CUDA
 template <typename T>
 struct MatMulDispatcher<phi::GPUContext, T> {
+#if CUDA_VERSION >= 11060
+  // Only the matmul with a 2-D weight, e.g. the linear layers in decoding,
+  // is checked here.
+  static bool IsSkinnyMatmul(const DenseTensor& x,
+                             const std::vector<std::int64_t>& x_dims,
+                             const std::vector<std::int64_t>& y_dims,
+                             bool trans_x,
+                             bool trans_y) {
+    if (!(std::is_same<T, float>::value ||
+          std::is_same<T, phi::dtype::float16>::value ||
+          std::is_same<T, phi::dtype::bfloat16>::value) ||
+        x_dims.size() < 2 || y_dims.size() != 2) {
+      return false;
+    }
+    const int64_t K = trans_y ? y_dims[1] : y_dims[0];
+    const int64_t N = trans_y ? y_dims[0] : y_dims[1];
+    if (K == 0) {
+      return false;
+    }
+    const int64_t M = trans_x ? x_dims.back() : x.numel() / K;
+    return phi::funcs::IsSkinnyGemm(M, N, K);
+  }
+#endif
+
   void operator()(const phi::GPUContext& ctx,
                   const DenseTensor& x,
                   const DenseTensor& y,
@@ -942,6 +966,22 @@ struct MatMulDispatcher<phi::GPUContext, T> {
                                              /* reserve_data */ nullptr,
                                              /* use_addto */ flag,
                                              /* no_exchange */ true);
+    // Skinny matmul goes to cublasLt even without autotune, which searches
+    // its split-K algorithms once and caches the best one.
+    if (!phi::autotune::AutoTuneStatus::Instance().UseAutoTune() &&
+        IsSkinnyMatmul(x, x_dims, y_dims, trans_x, trans_y)) {
+      MatMulFunctionImplWithCublasLt<phi::GPUContext, T>(ctx,
+                                                         x,
+                                                         y,
+                                                         x_dims,
+                                                         y_dims,
+                                                         out,
+                                                         trans_x,
+                                                         trans_y,
+                                                         flag,
+                                                         &matmul_planner);
+      return;
+    }
     tuner->Run(ctx,
                matmul_planner.GetKey(),
                ctx,
@@ -0,0 +1,36 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace phi {
+
+// SGD over a list of parameters sharing one learning rate, the GPU kernel
+// updates all of them in a few multi-tensor launches.
+template <typename T, typename Context>
+void MergedSGDKernel(
+    const Context& dev_ctx,
+    const std::vector<const DenseTensor*>& param,
+    const DenseTensor& learning_rate,
+    const std::vector<const DenseTensor*>& grad,
+    const paddle::optional<std::vector<const DenseTensor*>>& master_param,
+    bool multi_precision,
+    std::vector<DenseTensor*> param_out,
+    std::vector<DenseTensor*> master_param_out);
+
+}  // namespace phi
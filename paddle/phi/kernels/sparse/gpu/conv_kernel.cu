@@ -135,11 +135,17 @@ void Conv3dCooGPUKernel(const GPUContext& dev_ctx,
   int rulebook_len = 0;
   const IntT* rulebook_ptr = nullptr;
   bool need_product_rulebook = true;
-  if (subm && !key.empty()) {
+  // Without a user key, the rulebook of a submanifold conv is still shared
+  // with the following layers of the same points and conv params.
+  const std::string subm_key =
+      subm && key.empty() ? phi::funcs::sparse::SubmRulebookKey(
+                                x, kernel_sizes, paddings, dilations, strides)
+                          : key;
+  if (subm) {
     rulebook_ptr = phi::funcs::sparse::PrepareSubm<T, IntT, GPUContext>(
         dev_ctx,
         x,
-        key,
+        subm_key,
         out_dims,
         out,
         h_counter.data<int>(),
@@ -170,6 +176,21 @@ void Conv3dCooGPUKernel(const GPUContext& dev_ctx,
 
     phi::funcs::sparse::SaveToTable(
         dev_ctx, x, key, tmp_rulebook, h_counter, out, rulebook, counter);
+    if (subm && key.empty()) {
+      phi::funcs::sparse::SaveSubmRulebook(
+          x, subm_key, tmp_rulebook, h_counter, out);
+    }
+  } else if (key.empty()) {
+    // The backward reads the rulebook from the outputs without a user key.
+    const auto* indices_pairs = x.IndicesPairs(subm_key);
+    phi::funcs::sparse::SaveToTable(dev_ctx,
+                                    x,
+                                    key,
+                                    indices_pairs->first,
+                                    indices_pairs->second,
+                                    out,
+                                    rulebook,
+                                    counter);
   }
 
 #if defined(PADDLE_WITH_CUTLASS) && SPCONV_WITH_CUTLASS
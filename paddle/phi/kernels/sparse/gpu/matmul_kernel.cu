@@ -14,6 +14,7 @@ limitations under the License. */
 
 #include "paddle/phi/kernels/sparse/matmul_kernel.h"
 
+#include <type_traits>
 #include <vector>
 
 #include "paddle/common/ddim.h"
@@ -24,9 +25,12 @@ limitations under the License. */
 #include "paddle/phi/core/sparse_coo_tensor.h"
 #include "paddle/phi/core/sparse_csr_tensor.h"
 #include "paddle/phi/core/tensor_utils.h"
+#include "paddle/phi/core/visit_type.h"
+#include "paddle/phi/kernels/autotune/auto_tune_base.h"
 #include "paddle/phi/kernels/empty_kernel.h"
 #include "paddle/phi/kernels/funcs/math_function_impl.h"
 #include "paddle/phi/kernels/funcs/sparse/sparse_blas.h"
+#include "paddle/phi/kernels/funcs/sparse/spmm.cu.h"
 #include "paddle/phi/kernels/sparse/empty_kernel.h"
 #include "paddle/phi/kernels/sparse/impl/unary_kernel_impl.h"
 #include "paddle/phi/kernels/sparse/sparse_utils_kernel.h"
@@ -34,6 +38,103 @@ limitations under the License. */
 namespace phi {
 namespace sparse {
 
+#ifdef PADDLE_WITH_CUDA
+// Adds the native SpMM kernels of a 2D CSR x as candidates of the tuner.
+template <typename T>
+void AddSpmmCandidates(const GPUContext& dev_ctx,
+                       const SparseCsrTensor& x,
+                       const DenseTensor& y,
+                       DenseTensor* out,
+                       autotune::LaunchConfigAutoTuner<T>* tuner) {
+  const T* values = x.values().data<T>();
+  const T* y_data = y.data<T>();
+  T* out_data = out->data<T>();
+  int64_t rows = x.dims()[0];
+  int64_t nnz = x.nnz();
+  int64_t n = y.dims()[1];
+  PD_VISIT_BASE_INTEGRAL_TYPES(
+      x.crows().dtype(), "AddSpmmCandidates", ([&] {
+        const data_t* crows = x.crows().data<data_t>();
+        const data_t* cols = x.cols().data<data_t>();
+        tuner->AddCandidate([=, &dev_ctx] {
+          funcs::sparse::CsrSpmmRowSplit(
+              dev_ctx, crows, cols, values, y_data, out_data, rows, n);
+        });
+        tuner->AddCandidate([=, &dev_ctx] {
+          funcs::sparse::CsrSpmmRowVector(
+              dev_ctx, crows, cols, values, y_data, out_data, rows, n);
+        });
+        tuner->AddCandidate([=, &dev_ctx] {
+          funcs::sparse::SpmmNnzSplit<T, data_t>(dev_ctx,
+                                                 nullptr,
+                                                 crows,
+                                                 cols,
+                                                 values,
+                                                 y_data,
+                                                 out,
+                                                 rows,
+                                                 nnz,
+                                                 n);
+        });
+      }));
+}
+
+// Adds the native SpMM kernels of a 2D COO x as candidates of the tuner. The
+// rows of a coalesced x may also be compressed to CSR on each run, so the
+// format is chosen together with the kernel.
+template <typename T>
+void AddSpmmCandidates(const GPUContext& dev_ctx,
+                       const SparseCooTensor& x,
+                       const DenseTensor& y,
+                       DenseTensor* out,
+                       autotune::LaunchConfigAutoTuner<T>* tuner) {
+  const T* values = x.values().data<T>();
+  const T* y_data = y.data<T>();
+  T* out_data = out->data<T>();
+  int64_t rows = x.dims()[0];
+  int64_t nnz = x.nnz();
+  int64_t n = y.dims()[1];
+  PD_VISIT_BASE_INTEGRAL_TYPES(
+      x.indices().dtype(), "AddSpmmCandidates", ([&] {
+        const data_t* coo_rows = x.indices().data<data_t>();
+        const data_t* cols = coo_rows + nnz;
+        tuner->AddCandidate([=, &dev_ctx] {
+          funcs::sparse::SpmmNnzSplit<T, data_t>(dev_ctx,
+                                                 coo_rows,
+                                                 nullptr,
+                                                 cols,
+                                                 values,
+                                                 y_data,
+                                                 out,
+                                                 rows,
+                                                 nnz,
+                                                 n);
+        });
+        if (x.coalesced()) {
+          tuner->AddCandidate([=, &dev_ctx, &x] {
+            SparseCsrTensor x_csr = CooToCsr<T, GPUContext>(dev_ctx, x);
+            funcs::sparse::CsrSpmmRowSplit(dev_ctx,
+                                           x_csr.crows().data<data_t>(),
+                                           x_csr.cols().data<data_t>(),
+                                           values,
+                                           y_data,
+                                           out_data,
+                                           rows,
+                                           n);
+          });
+        }
+      }));
+}
+
+inline DataType IndicesType(const SparseCsrTensor& x) {
+  return x.crows().dtype();
+}
+
+inline DataType IndicesType(const SparseCooTensor& x) {
+  return x.indices().dtype();
+}
+#endif
+
 template <typename T, typename Context, typename TensorType>
 void MatmulKernelImpl(const Context& dev_ctx,
                       const TensorType& x,
@@ -89,6 +190,28 @@ void MatmulKernelImpl(const Context& dev_ctx,
 #endif
 
   auto sparse_blas = phi::funcs::sparse::GetSparseBlas<Context, T>(dev_ctx);
+#ifdef PADDLE_WITH_CUDA
+  // cuSPARSE, the first candidate, runs unless autotune picks a native
+  // kernel for the shape and the number of non-zeros.
+  if (x_ndims == 2 && xdim_vec[1] == ydim_vec[0] && x.nnz() > 0 &&
+      out->numel() > 0) {
+    autotune::LaunchConfigAutoTuner<T> tuner;
+    tuner.AddCandidate([&] {
+      sparse_blas.SPMM(
+          false, false, static_cast<T>(1), x, y, static_cast<T>(0), out);
+    });
+    AddSpmmCandidates<T>(dev_ctx, x, y, out, &tuner);
+    constexpr bool is_csr = std::is_same<TensorType, SparseCsrTensor>::value;
+    size_t key = autotune::GenKey(xdim_vec,
+                                  ydim_vec,
+                                  x.nnz(),
+                                  static_cast<int64_t>(is_csr),
+                                  static_cast<int64_t>(IndicesType(x)),
+                                  static_cast<int64_t>(y.dtype()));
+    tuner.Run(dev_ctx, autotune::AlgorithmType::kSpmm, key);
+    return;
+  }
+#endif
   sparse_blas.SPMM(
       false, false, static_cast<T>(1), x, y, static_cast<T>(0), out);
 #else
@@ -260,6 +383,44 @@ void MaskedMatmulCsrKernel(const Context& dev_ctx,
   EmptyLikeCsrKernel<T, Context>(dev_ctx, mask, out);
 
   auto sparse_blas = phi::funcs::sparse::GetSparseBlas<Context, T>(dev_ctx);
+  // cuSPARSE, the first candidate, runs unless autotune picks the native
+  // kernel for the shape and the number of non-zeros.
+  if (x_ndims == 2 && xdim_vec[1] == ydim_vec[0] && mask.nnz() > 0) {
+    autotune::LaunchConfigAutoTuner<T> tuner;
+    tuner.AddCandidate([&] {
+      sparse_blas.SDDMM(
+          false, false, static_cast<T>(1), x, y, static_cast<T>(0), out);
+    });
+    const T* x_data = x.data<T>();
+    const T* y_data = y.data<T>();
+    T* out_values = out->mutable_values()->data<T>();
+    int64_t rows = xdim_vec[0];
+    int64_t k_dim = xdim_vec[1];
+    int64_t n = ydim_vec[1];
+    PD_VISIT_BASE_INTEGRAL_TYPES(
+        mask.crows().dtype(), "MaskedMatmulCsrKernel", ([&] {
+          const data_t* crows = mask.crows().data<data_t>();
+          const data_t* cols = mask.cols().data<data_t>();
+          tuner.AddCandidate([=, &dev_ctx] {
+            funcs::sparse::CsrSddmm(dev_ctx,
+                                    x_data,
+                                    y_data,
+                                    crows,
+                                    cols,
+                                    out_values,
+                                    rows,
+                                    k_dim,
+                                    n);
+          });
+        }));
+    size_t key = autotune::GenKey(xdim_vec,
+                                  ydim_vec,
+                                  mask.nnz(),
+                                  static_cast<int64_t>(mask.crows().dtype()),
+                                  static_cast<int64_t>(x.dtype()));
+    tuner.Run(dev_ctx, autotune::AlgorithmType::kSddmm, key);
+    return;
+  }
   sparse_blas.SDDMM(
       false, false, static_cast<T>(1), x, y, static_cast<T>(0), out);
 #else
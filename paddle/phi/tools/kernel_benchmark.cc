@@ -0,0 +1,793 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// kernel_benchmark times phi kernels in isolation, called straight from the
+// KernelFactory without the API layer above them, so that the kernels of two
+// Paddle versions can be compared before upgrading.
+//
+// Each line of the cases file is a case of key=value tokens:
+//
+//   kernel=matmul backend=GPU dtype=float16 inputs=[4096,4096],[4096,4096]
+//     attrs=false;false outputs=[4096,4096] flops=137438953472
+//
+// (on a single line), where
+//   kernel   the registered name of the kernel
+//   backend  CPU, GPU or GPUDNN
+//   dtype    the data type of the kernel key
+//   layout   the layout of the kernel key, ALL_LAYOUT by default
+//   inputs   the tensor inputs in the order of the kernel arguments
+//   attrs    the attributes in the order of the kernel arguments, split by ';'
+//   outputs  the shapes of the outputs, the kernel does not infer them
+//   flops    the floating point operations of a call, for TFLOPs
+//   name     the name in the report, the kernel name by default
+//
+// A tensor is written [d0,d1,...], optionally prefixed with its data type and
+// followed by the range of its random values, e.g. int64[4096]@0:32000. The
+// data type of an input or output is the one of the kernel argument, or the
+// one of the kernel key if the argument takes any. The tensors of a vector
+// argument are split by '|', and '-' stands for a missing optional tensor.
+//
+// Before each timed call the cache is flushed by writing a buffer twice the
+// size of the L2 cache of the GPU, or FLAGS_cpu_flush_mb MB on CPU, so that
+// the inputs are read from memory. GPU calls are timed by events on the stream
+// of the kernel.
+//
+// Usage:
+//   kernel_benchmark --cases=kernel_benchmark_cases.txt --output=out.json
+//     [--filter=<regex of case names>] [--warmup=10] [--repeat=100]
+//     [--peak_gbps=<GB/s>] [--peak_tflops=<TFLOPs>]
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/common/int_array.h"
+#include "paddle/phi/common/scalar.h"
+#include "paddle/phi/core/compat/convert_utils.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/kernel_context.h"
+#include "paddle/phi/core/kernel_factory.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/core/os_info.h"
+#include "paddle/phi/core/tensor_utils.h"
+#include "paddle/phi/core/visit_type.h"
+#include "paddle/phi/kernels/declarations.h"
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+#include "paddle/phi/backends/gpu/gpu_context.h"
+#include "paddle/phi/backends/gpu/gpu_info.h"
+#endif
+
+PD_DEFINE_string(cases, "", "The file of the cases to run.");  // NOLINT
+PD_DEFINE_string(filter, "", "The regex of the case names to run.");  // NOLINT
+PD_DEFINE_string(output,  // NOLINT
+                 "",
+                 "The JSON file of the results, stdout if empty.");
+PD_DEFINE_int32(warmup, 10, "The calls before timing.");
+PD_DEFINE_int32(repeat, 100, "The timed calls.");
+PD_DEFINE_int32(device_id, 0, "The GPU to run the GPU cases on.");
+PD_DEFINE_bool(flush_cache, true, "Flush the cache before each timed call.");
+PD_DEFINE_int32(cpu_flush_mb, 64, "The MB written to flush the CPU cache.");
+PD_DEFINE_double(peak_gbps,
+                 0,
+                 "The peak memory bandwidth in GB/s for the roofline, the "
+                 "one of the GPU computed from its memory clock if 0.");
+PD_DEFINE_double(peak_tflops,
+                 0,
+                 "The peak TFLOPs for the roofline, which only takes the "
+                 "memory bandwidth into account if 0.");
+PD_DEFINE_bool(list_kernels,
+               false,
+               "Print the registered kernels, marking the ones a case runs.");
+
+namespace phi {
+namespace benchmark {
+
+struct TensorSpec {
+  DataType dtype = DataType::UNDEFINED;
+  std::vector<int64_t> dims;
+  double low = -1.0;
+  double high = 1.0;
+};
+
+// The tensors of an argument, empty for a missing optional one.
+using ArgSpec = std::vector<TensorSpec>;
+
+struct Case {
+  std::string name;
+  std::string kernel;
+  Backend backend = Backend::CPU;
+  DataLayout layout = DataLayout::ALL_LAYOUT;
+  DataType dtype = DataType::FLOAT32;
+  std::vector<ArgSpec> inputs;
+  std::vector<std::string> attrs;
+  std::vector<ArgSpec> outputs;
+  double flops = 0;
+  int line = 0;
+};
+
+struct Result {
+  std::vector<double> times_us;
+  double bytes = 0;
+};
+
+std::vector<std::string> Split(const std::string& str, char sep) {
+  std::vector<std::string> items;
+  if (str.empty()) {
+    return items;
+  }
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, sep)) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+// Splits on the separators out of brackets, e.g. the commas of "[2,3],[4]".
+std::vector<std::string> SplitTopLevel(const std::string& str, char sep) {
+  std::vector<std::string> items;
+  int depth = 0;
+  std::string item;
+  for (char c : str) {
+    if (c == '[') {
+      ++depth;
+    } else if (c == ']') {
+      --depth;
+    }
+    if (c == sep && depth == 0) {
+      items.push_back(item);
+      item.clear();
+    } else {
+      item.push_back(c);
+    }
+  }
+  if (!item.empty()) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+// Parses "[1,2,3]" or "1,2,3".
+std::vector<std::string> ParseList(std::string str) {
+  if (!str.empty() && str.front() == '[') {
+    PADDLE_ENFORCE_EQ(str.back(),
+                      ']',
+                      common::errors::InvalidArgument(
+                          "The list `%s` is not closed by ']'.", str));
+    str = str.substr(1, str.size() - 2);
+  }
+  return Split(str, ',');
+}
+
+TensorSpec ParseTensor(const std::string& str) {
+  TensorSpec spec;
+  size_t open = str.find('[');
+  size_t close = str.find(']');
+  PADDLE_ENFORCE_EQ(
+      open != std::string::npos && close != std::string::npos && open < close,
+      true,
+      common::errors::InvalidArgument(
+          "The tensor `%s` should be written as [d0,d1,...].", str));
+  if (open > 0) {
+    spec.dtype = StringToDataType(str.substr(0, open));
+  }
+  for (const auto& dim : ParseList(str.substr(open, close - open + 1))) {
+    spec.dims.push_back(std::stoll(dim));
+  }
+  if (close + 1 < str.size()) {
+    PADDLE_ENFORCE_EQ(str[close + 1],
+                      '@',
+                      common::errors::InvalidArgument(
+                          "The range of the tensor `%s` should be written as "
+                          "@low:high.",
+                          str));
+    auto range = Split(str.substr(close + 2), ':');
+    PADDLE_ENFORCE_EQ(range.size(),
+                      2UL,
+                      common::errors::InvalidArgument(
+                          "The range of the tensor `%s` should be written as "
+                          "@low:high.",
+                          str));
+    spec.low = std::stod(range[0]);
+    spec.high = std::stod(range[1]);
+  }
+  return spec;
+}
+
+std::vector<ArgSpec> ParseArgs(const std::string& str) {
+  std::vector<ArgSpec> args;
+  for (const auto& arg : SplitTopLevel(str, ',')) {
+    ArgSpec tensors;
+    if (arg != "-") {
+      for (const auto& tensor : SplitTopLevel(arg, '|')) {
+        tensors.push_back(ParseTensor(tensor));
+      }
+    }
+    args.push_back(tensors);
+  }
+  return args;
+}
+
+std::vector<Case> ParseCases(const std::string& path) {
+  std::ifstream fin(path);
+  PADDLE_ENFORCE_EQ(
+      fin.is_open(),
+      true,
+      common::errors::NotFound("Cannot open the cases file `%s`.", path));
+  std::vector<Case> cases;
+  std::string line;
+  int line_no = 0;
+  while (std::getline(fin, line)) {
+    ++line_no;
+    line = line.substr(0, line.find('#'));
+    std::stringstream ss(line);
+    std::string token;
+    Case c;
+    c.line = line_no;
+    bool empty = true;
+    while (ss >> token) {
+      empty = false;
+      size_t eq = token.find('=');
+      PADDLE_ENFORCE_NE(eq,
+                        std::string::npos,
+                        common::errors::InvalidArgument(
+                            "The token `%s` at line %d of `%s` should be "
+                            "written as key=value.",
+                            token,
+                            line_no,
+                            path));
+      std::string key = token.substr(0, eq);
+      std::string value = token.substr(eq + 1);
+      if (key == "kernel") {
+        c.kernel = value;
+      } else if (key == "name") {
+        c.name = value;
+      } else if (key == "backend") {
+        c.backend = StringToBackend(value.c_str());
+      } else if (key == "dtype") {
+        c.dtype = StringToDataType(value);
+      } else if (key == "layout") {
+        c.layout = value == "ALL_LAYOUT" ? DataLayout::ALL_LAYOUT
+                                         : common::StringToDataLayout(value);
+      } else if (key == "inputs") {
+        c.inputs = ParseArgs(value);
+      } else if (key == "attrs") {
+        c.attrs = Split(value, ';');
+      } else if (key == "outputs") {
+        c.outputs = ParseArgs(value);
+      } else if (key == "flops") {
+        c.flops = std::stod(value);
+      } else {
+        PADDLE_THROW(common::errors::InvalidArgument(
+            "Unknown key `%s` at line %d of `%s`.", key, line_no, path));
+      }
+    }
+    if (empty) {
+      continue;
+    }
+    PADDLE_ENFORCE_EQ(c.kernel.empty(),
+                      false,
+                      common::errors::InvalidArgument(
+                          "The case at line %d of `%s` has no kernel.",
+                          line_no,
+                          path));
+    if (c.name.empty()) {
+      c.name = c.kernel;
+    }
+    cases.push_back(c);
+  }
+  return cases;
+}
+
+bool ParseBool(const std::string& str) {
+  PADDLE_ENFORCE_EQ(
+      str == "true" || str == "false" || str == "1" || str == "0",
+      true,
+      common::errors::InvalidArgument("`%s` is not a bool.", str));
+  return str == "true" || str == "1";
+}
+
+Scalar ParseScalar(const std::string& str) {
+  if (str == "true" || str == "false") {
+    return Scalar(str == "true");
+  }
+  if (str.find_first_of(".eEn") != std::string::npos) {
+    return Scalar(std::stod(str));
+  }
+  return Scalar(static_cast<int64_t>(std::stoll(str)));
+}
+
+template <typename T, typename ParseFn>
+std::vector<T> ParseVector(const std::string& str, ParseFn parse) {
+  std::vector<T> values;
+  for (const auto& item : ParseList(str)) {
+    values.push_back(parse(item));
+  }
+  return values;
+}
+
+Attribute ParseAttr(const std::string& str,
+                    AttributeType type,
+                    const Place& place) {
+  auto to_int = [](const std::string& s) { return std::stoi(s); };
+  auto to_int64 = [](const std::string& s) {
+    return static_cast<int64_t>(std::stoll(s));
+  };
+  auto to_float = [](const std::string& s) { return std::stof(s); };
+  auto to_double = [](const std::string& s) { return std::stod(s); };
+  switch (type) {
+    case AttributeType::BOOL:
+      return ParseBool(str);
+    case AttributeType::INT32:
+      return to_int(str);
+    case AttributeType::INT64:
+      return to_int64(str);
+    case AttributeType::FLOAT32:
+      return to_float(str);
+    case AttributeType::FLOAT64:
+      return to_double(str);
+    case AttributeType::STRING:
+      return str;
+    case AttributeType::BOOLS:
+      return ParseVector<bool>(str, ParseBool);
+    case AttributeType::INT32S:
+      return ParseVector<int>(str, to_int);
+    case AttributeType::INT64S:
+      return ParseVector<int64_t>(str, to_int64);
+    case AttributeType::FLOAT32S:
+      return ParseVector<float>(str, to_float);
+    case AttributeType::FLOAT64S:
+      return ParseVector<double>(str, to_double);
+    case AttributeType::STRINGS:
+      return ParseList(str);
+    case AttributeType::SCALAR:
+      return ParseScalar(str);
+    case AttributeType::SCALARS:
+      return ParseVector<Scalar>(str, ParseScalar);
+    case AttributeType::INT_ARRAY:
+      return IntArray(ParseVector<int64_t>(str, to_int64));
+    case AttributeType::DATA_TYPE:
+      return StringToDataType(str);
+    case AttributeType::DATA_LAYOUT:
+      return common::StringToDataLayout(str);
+    case AttributeType::PLACE:
+      // The place of the case, whatever is written.
+      return place;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "The attribute `%s` has a type not supported.", str));
+  }
+}
+
+void FillRandom(const TensorSpec& spec, std::mt19937* gen, DenseTensor* t) {
+  PD_VISIT_ALL_TYPES(t->dtype(), "FillRandom", [&] {
+    auto* data = t->data<data_t>();
+    std::uniform_real_distribution<double> dist(spec.low, spec.high);
+    bool is_integral = t->dtype() != DataType::FLOAT16 &&
+                       t->dtype() != DataType::BFLOAT16 &&
+                       t->dtype() != DataType::FLOAT32 &&
+                       t->dtype() != DataType::FLOAT64;
+    for (int64_t i = 0; i < t->numel(); ++i) {
+      double value = dist(*gen);
+      // The integers stay below high, e.g. the indices of an embedding.
+      data[i] = static_cast<data_t>(is_integral ? std::floor(value) : value);
+    }
+  });
+}
+
+class CaseRunner {
+ public:
+  CaseRunner(const Case& c, const Kernel& kernel, DeviceContext* dev_ctx)
+      : case_(c), kernel_(kernel), dev_ctx_(dev_ctx) {}
+
+  Result Run() {
+    Prepare();
+    for (int i = 0; i < FLAGS_warmup; ++i) {
+      kernel_(&ctx_);
+    }
+    dev_ctx_->Wait();
+    Result result;
+    result.times_us = Time();
+    for (const auto& t : inputs_) {
+      result.bytes += static_cast<double>(t->memory_size());
+    }
+    for (const auto& t : outputs_) {
+      result.bytes += static_cast<double>(t->memory_size());
+    }
+    return result;
+  }
+
+ private:
+  DataType ArgDtype(const TensorSpec& spec, DataType arg_dtype) const {
+    if (spec.dtype != DataType::UNDEFINED) {
+      return spec.dtype;
+    }
+    return arg_dtype != DataType::UNDEFINED ? arg_dtype : case_.dtype;
+  }
+
+  const DenseTensor* MakeInput(const TensorSpec& spec,
+                               const TensorArgDef& def) {
+    DenseTensor cpu_tensor;
+    cpu_tensor.Resize(common::make_ddim(spec.dims));
+    auto* cpu_ctx = DeviceContextPool::Instance().Get(CPUPlace());
+    cpu_ctx->Alloc(&cpu_tensor, ArgDtype(spec, def.dtype));
+    FillRandom(spec, &gen_, &cpu_tensor);
+    auto t = std::make_shared<DenseTensor>();
+    if (dev_ctx_->GetPlace().GetType() == AllocationType::CPU) {
+      *t = cpu_tensor;
+    } else {
+      Copy(*dev_ctx_, cpu_tensor, dev_ctx_->GetPlace(), true, t.get());
+    }
+    inputs_.push_back(t);
+    return t.get();
+  }
+
+  DenseTensor* MakeOutput(const TensorSpec& spec, const TensorArgDef& def) {
+    auto t = std::make_shared<DenseTensor>();
+    t->set_meta(DenseTensorMeta(ArgDtype(spec, def.dtype),
+                                common::make_ddim(spec.dims)));
+    outputs_.push_back(t);
+    return t.get();
+  }
+
+  void Prepare() {
+    const auto& args_def = kernel_.args_def();
+    const auto& input_defs = args_def.input_defs();
+    const auto& attr_defs = args_def.attribute_defs();
+    const auto& output_defs = args_def.output_defs();
+    auto check_size = [this](size_t size, size_t expected, const char* arg) {
+      PADDLE_ENFORCE_EQ(size,
+                        expected,
+                        common::errors::InvalidArgument(
+                            "The case `%s` at line %d gives %d %s, but the "
+                            "kernel `%s` takes %d.",
+                            case_.name,
+                            case_.line,
+                            size,
+                            arg,
+                            case_.kernel,
+                            expected));
+    };
+    check_size(case_.inputs.size(), input_defs.size(), "inputs");
+    check_size(case_.attrs.size(), attr_defs.size(), "attributes");
+    check_size(case_.outputs.size(), output_defs.size(), "outputs");
+
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      const auto& def = input_defs[i];
+      const auto& arg = case_.inputs[i];
+      bool is_vector =
+          def.type_index ==
+              std::type_index(typeid(const std::vector<const DenseTensor*>&)) ||
+          def.type_index ==
+              std::type_index(typeid(
+                  const paddle::optional<std::vector<const DenseTensor*>>&));
+      bool is_dense =
+          is_vector ||
+          def.type_index == std::type_index(typeid(const DenseTensor&)) ||
+          def.type_index ==
+              std::type_index(typeid(const paddle::optional<DenseTensor>&));
+      PADDLE_ENFORCE_EQ(is_dense,
+                        true,
+                        common::errors::Unimplemented(
+                            "The input %d of the kernel `%s` is not a "
+                            "DenseTensor, which is the only one supported.",
+                            i,
+                            case_.kernel));
+      if (arg.empty()) {
+        ctx_.EmplaceBackInput(nullptr);
+      } else if (is_vector) {
+        paddle::small_vector<const TensorBase*> tensors;
+        for (const auto& spec : arg) {
+          tensors.push_back(MakeInput(spec, def));
+        }
+        ctx_.EmplaceBackInputs(std::move(tensors));
+      } else {
+        check_size(arg.size(), 1, "tensors to a single input");
+        ctx_.EmplaceBackInput(MakeInput(arg[0], def));
+      }
+    }
+
+    for (size_t i = 0; i < attr_defs.size(); ++i) {
+      ctx_.EmplaceBackAttr(ParseAttr(
+          case_.attrs[i], attr_defs[i].type_index, dev_ctx_->GetPlace()));
+    }
+
+    for (size_t i = 0; i < output_defs.size(); ++i) {
+      const auto& def = output_defs[i];
+      const auto& arg = case_.outputs[i];
+      bool is_vector =
+          def.type_index == std::type_index(typeid(std::vector<DenseTensor*>));
+      PADDLE_ENFORCE_EQ(
+          is_vector || def.type_index == std::type_index(typeid(DenseTensor*)),
+          true,
+          common::errors::Unimplemented(
+              "The output %d of the kernel `%s` is not a DenseTensor, which "
+              "is the only one supported.",
+              i,
+              case_.kernel));
+      if (arg.empty()) {
+        ctx_.EmplaceBackOutput(nullptr);
+      } else if (is_vector) {
+        paddle::small_vector<TensorBase*> tensors;
+        for (const auto& spec : arg) {
+          tensors.push_back(MakeOutput(spec, def));
+        }
+        ctx_.EmplaceBackOutputs(std::move(tensors));
+      } else {
+        check_size(arg.size(), 1, "tensors to a single output");
+        ctx_.EmplaceBackOutput(MakeOutput(arg[0], def));
+      }
+    }
+  }
+
+  std::vector<double> Time() {
+    std::vector<double> times_us(FLAGS_repeat);
+#if defined(PADDLE_WITH_CUDA)
+    if (dev_ctx_->GetPlace().GetType() == AllocationType::GPU) {
+      auto* gpu_ctx = static_cast<GPUContext*>(dev_ctx_);
+      auto stream = gpu_ctx->stream();
+      DenseTensor flush;
+      if (FLAGS_flush_cache) {
+        int l2_bytes = 0;
+        PADDLE_ENFORCE_GPU_SUCCESS(
+            cudaDeviceGetAttribute(&l2_bytes,
+                                   cudaDevAttrL2CacheSize,
+                                   dev_ctx_->GetPlace().GetDeviceId()));
+        flush.Resize({std::max<int64_t>(2 * int64_t{l2_bytes}, 1)});
+        dev_ctx_->Alloc(&flush, DataType::UINT8);
+      }
+      std::vector<cudaEvent_t> starts(FLAGS_repeat);
+      std::vector<cudaEvent_t> stops(FLAGS_repeat);
+      for (int i = 0; i < FLAGS_repeat; ++i) {
+        PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreate(&starts[i]));
+        PADDLE_ENFORCE_GPU_SUCCESS(cudaEventCreate(&stops[i]));
+      }
+      for (int i = 0; i < FLAGS_repeat; ++i) {
+        if (FLAGS_flush_cache) {
+          PADDLE_ENFORCE_GPU_SUCCESS(cudaMemsetAsync(
+              flush.data(), i & 0xff, flush.memory_size(), stream));
+        }
+        PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(starts[i], stream));
+        kernel_(&ctx_);
+        PADDLE_ENFORCE_GPU_SUCCESS(cudaEventRecord(stops[i], stream));
+      }
+      PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
+      for (int i = 0; i < FLAGS_repeat; ++i) {
+        float ms = 0;
+        PADDLE_ENFORCE_GPU_SUCCESS(
+            cudaEventElapsedTime(&ms, starts[i], stops[i]));
+        times_us[i] = ms * 1000.0;
+        PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(starts[i]));
+        PADDLE_ENFORCE_GPU_SUCCESS(cudaEventDestroy(stops[i]));
+      }
+      return times_us;
+    }
+#endif
+    // The other devices are timed on the host, waiting for each call.
+    std::vector<char> flush;
+    if (FLAGS_flush_cache &&
+        dev_ctx_->GetPlace().GetType() == AllocationType::CPU) {
+      flush.resize(static_cast<size_t>(FLAGS_cpu_flush_mb) << 20);
+    }
+    for (int i = 0; i < FLAGS_repeat; ++i) {
+      if (!flush.empty()) {
+        std::memset(flush.data(), i & 0xff, flush.size());
+      }
+      uint64_t start = PosixInNsec();
+      kernel_(&ctx_);
+      dev_ctx_->Wait();
+      times_us[i] = static_cast<double>(PosixInNsec() - start) / 1000.0;
+    }
+    return times_us;
+  }
+
+  const Case& case_;
+  const Kernel& kernel_;
+  DeviceContext* dev_ctx_;
+  KernelContext ctx_;
+  std::mt19937 gen_{2026};
+  std::vector<std::shared_ptr<DenseTensor>> inputs_;
+  std::vector<std::shared_ptr<DenseTensor>> outputs_;
+};
+
+double PeakGBps(const Place& place) {
+  if (FLAGS_peak_gbps > 0) {
+    return FLAGS_peak_gbps;
+  }
+#if defined(PADDLE_WITH_CUDA)
+  if (place.GetType() == AllocationType::GPU) {
+    int clock_khz = 0;
+    int bus_bits = 0;
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaDeviceGetAttribute(
+        &clock_khz, cudaDevAttrMemoryClockRate, place.GetDeviceId()));
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaDeviceGetAttribute(
+        &bus_bits, cudaDevAttrGlobalMemoryBusWidth, place.GetDeviceId()));
+    // Double data rate
+    return 2.0 * clock_khz * 1e3 * (bus_bits / 8) / 1e9;
+  }
+#endif
+  return 0;
+}
+
+std::string JsonString(const std::string& str) {
+  std::string out = "\"";
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out.push_back(c);
+    }
+  }
+  return out + "\"";
+}
+
+std::string JsonNumber(double value) {
+  if (!std::isfinite(value)) {
+    return "null";
+  }
+  std::ostringstream os;
+  os << std::setprecision(6) << value;
+  return os.str();
+}
+
+std::string RunCase(const Case& c) {
+  std::ostringstream json;
+  json << "    {\"name\": " << JsonString(c.name)
+       << ", \"kernel\": " << JsonString(c.kernel)
+       << ", \"backend\": " << JsonString(BackendToString(c.backend))
+       << ", \"dtype\": " << JsonString(DataTypeToString(c.dtype));
+  try {
+    KernelKey key(c.backend, c.layout, c.dtype);
+    const auto& kernel = KernelFactory::Instance().SelectKernel(c.kernel, key);
+    PADDLE_ENFORCE_EQ(kernel.IsValid(),
+                      true,
+                      common::errors::NotFound(
+                          "The kernel `%s` is not registered for %s.",
+                          c.kernel,
+                          key));
+    Place place = TransToPhiPlace(c.backend);
+    auto* dev_ctx = DeviceContextPool::Instance().Get(place);
+    Result result = CaseRunner(c, kernel, dev_ctx).Run();
+
+    auto times = result.times_us;
+    std::sort(times.begin(), times.end());
+    double median_us = times[times.size() / 2];
+    double mean_us = std::accumulate(times.begin(), times.end(), 0.0) /
+                     static_cast<double>(times.size());
+    double gbps = result.bytes / median_us / 1e3;
+    double tflops = c.flops / median_us / 1e6;
+    // The bound of the roofline at the arithmetic intensity of the kernel
+    double peak_gbps = PeakGBps(place);
+    double roofline = 0;
+    if (c.flops > 0 && FLAGS_peak_tflops > 0) {
+      double bound = FLAGS_peak_tflops;
+      if (peak_gbps > 0) {
+        bound = std::min(bound, c.flops / result.bytes * peak_gbps / 1e3);
+      }
+      roofline = tflops / bound;
+    } else if (peak_gbps > 0) {
+      roofline = gbps / peak_gbps;
+    }
+    json << ", \"median_us\": " << JsonNumber(median_us)
+         << ", \"min_us\": " << JsonNumber(times.front())
+         << ", \"max_us\": " << JsonNumber(times.back())
+         << ", \"mean_us\": " << JsonNumber(mean_us)
+         << ", \"bytes\": " << JsonNumber(result.bytes)
+         << ", \"flops\": " << JsonNumber(c.flops)
+         << ", \"gbps\": " << JsonNumber(gbps)
+         << ", \"tflops\": " << JsonNumber(tflops)
+         << ", \"roofline\": " << JsonNumber(roofline) << "}";
+    LOG(INFO) << c.name << ": " << median_us << " us, " << gbps << " GB/s, "
+              << tflops << " TFLOPs, " << roofline * 100 << "% of roofline";
+  } catch (const std::exception& e) {
+    // A broken case does not stop the others, its error is reported.
+    LOG(WARNING) << "The case `" << c.name << "` at line " << c.line
+                 << " failed: " << e.what();
+    json << ", \"error\": " << JsonString(e.what()) << "}";
+  }
+  return json.str();
+}
+
+void ListKernels(const std::vector<Case>& cases) {
+  std::set<std::string> covered;
+  for (const auto& c : cases) {
+    covered.insert(c.kernel);
+  }
+  std::map<std::string, size_t> kernels;
+  for (const auto& item : KernelFactory::Instance().kernels()) {
+    kernels[item.first] = item.second.size();
+  }
+  for (const auto& item : kernels) {
+    std::cout << (covered.count(item.first) ? "[x] " : "[ ] ") << item.first
+              << " (" << item.second << " keys)" << std::endl;
+  }
+  std::cout << covered.size() << " of " << kernels.size()
+            << " kernels have cases." << std::endl;
+}
+
+}  // namespace benchmark
+}  // namespace phi
+
+int main(int argc, char* argv[]) {
+  paddle::flags::ParseCommandLineFlags(&argc, &argv);
+  google::InitGoogleLogging(argv[0]);
+
+  std::vector<phi::Place> places = {phi::CPUPlace()};
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (phi::backends::gpu::GetGPUDeviceCount() > 0) {
+    phi::backends::gpu::SetDeviceId(FLAGS_device_id);
+    places.emplace_back(phi::GPUPlace(FLAGS_device_id));
+  }
+#endif
+  phi::DeviceContextPool::Init(places);
+
+  std::vector<phi::benchmark::Case> cases;
+  if (!FLAGS_cases.empty()) {
+    cases = phi::benchmark::ParseCases(FLAGS_cases);
+  }
+  if (FLAGS_list_kernels) {
+    phi::benchmark::ListKernels(cases);
+    return 0;
+  }
+  PADDLE_ENFORCE_EQ(FLAGS_cases.empty(),
+                    false,
+                    common::errors::InvalidArgument(
+                        "Please give the cases file by --cases."));
+
+  std::regex filter(FLAGS_filter);
+  std::vector<std::string> results;
+  for (const auto& c : cases) {
+    if (!FLAGS_filter.empty() && !std::regex_search(c.name, filter)) {
+      continue;
+    }
+    results.push_back(phi::benchmark::RunCase(c));
+  }
+
+  std::ostringstream json;
+  json << "{\n  \"warmup\": " << FLAGS_warmup
+       << ",\n  \"repeat\": " << FLAGS_repeat
+       << ",\n  \"flush_cache\": " << (FLAGS_flush_cache ? "true" : "false")
+       << ",\n  \"peak_tflops\": " << FLAGS_peak_tflops
+       << ",\n  \"cases\": [\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    json << results[i] << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  json << "  ]\n}\n";
+  if (FLAGS_output.empty()) {
+    std::cout << json.str();
+  } else {
+    std::ofstream fout(FLAGS_output);
+    fout << json.str();
+  }
+  return 0;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+#include "paddle/pir/include/core/dll_decl.h"
+
+namespace pir {
+
+///
+/// \brief A bump arena for the memory of the operations, each with its
+/// results, operands and regions. The operations created by a thread are
+/// allocated from its active arena, see OperationArenaGuard, and from the
+/// heap without one. The memory of a chunk is freed when all of its
+/// operations are destroyed and the arena moves on to another chunk or is
+/// destroyed, so that the operations may be moved into other programs and
+/// outlive the arena.
+///
+class IR_API OperationArena {
+ public:
+  OperationArena() = default;
+  OperationArena(const OperationArena &) = delete;
+  OperationArena &operator=(const OperationArena &) = delete;
+  ~OperationArena();
+
+  ///
+  /// \brief The memory of size bytes aligned to 8, from the active arena of
+  /// the thread or the heap, released by Deallocate.
+  ///
+  static void *Allocate(size_t size);
+
+  static void Deallocate(void *ptr);
+
+ private:
+  friend class OperationArenaGuard;
+  struct Chunk;
+
+  void *AllocateInChunk(size_t size);
+
+  Chunk *chunk_{nullptr};
+  char *cursor_{nullptr};
+  char *end_{nullptr};
+};
+
+///
+/// \brief Make the arena active in the current thread during the lifetime of
+/// the guard. The arena is used by one thread at a time.
+///
+class IR_API OperationArenaGuard {
+ public:
+  explicit OperationArenaGuard(OperationArena *arena);
+  OperationArenaGuard(const OperationArenaGuard &) = delete;
+  OperationArenaGuard &operator=(const OperationArenaGuard &) = delete;
+  ~OperationArenaGuard();
+
+ private:
+  OperationArena *prev_arena_;
+};
+
+}  // namespace pir
@@ -24,6 +24,7 @@
 #include "paddle/pir/include/core/builtin_op.h"
 #include "paddle/pir/include/core/ir_mapping.h"
 #include "paddle/pir/include/core/operation.h"
+#include "paddle/pir/include/core/operation_arena.h"
 #include "paddle/pir/include/core/parameter.h"
 
 namespace pir {
@@ -73,7 +74,14 @@ class IR_API Program {
 
   uint64_t id() const { return id_; }
 
+  ///
+  /// \brief The arena for the operations built in bulk into the program, e.g.
+  /// by Clone, see OperationArenaGuard.
+  ///
+  OperationArena* arena() { return &arena_; }
+
  private:
+  OperationArena arena_;
   // computation graph
   ModuleOp module_;
   // unique in current process, "almost" unique between processes.
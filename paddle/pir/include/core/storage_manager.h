@@ -15,10 +15,10 @@
 #pragma once
 
 #include <memory>
+#include <shared_mutex>
 #include <type_traits>
 #include <unordered_map>
 
-#include "paddle/pir/include/core/spin_lock.h"
 #include "paddle/pir/include/core/type_id.h"
 
 namespace pir {
@@ -40,6 +40,10 @@ struct ParametricStorageManager;
 /// provide method 'bool operator==(const ParamKey &) const', used to compare
 /// Storage instance and ParamKey instance.
 ///
+/// The storages are got from several threads when the passes run in
+/// parallel. The lookups only take the shared locks, the exclusive lock of a
+/// type is only taken to insert a new storage of that type.
+///
 class IR_API StorageManager {
  public:
   ///
@@ -141,12 +145,12 @@ class IR_API StorageManager {
   std::unordered_map<TypeId, std::unique_ptr<ParametricStorageManager>>
       parametric_instance_;
 
-  pir::SpinLock parametric_instance_lock_;
+  std::shared_mutex parametric_instance_lock_;
 
   // This map is a mapping between type id and parameterless type storage.
   std::unordered_map<TypeId, StorageBase *> parameterless_instance_;
 
-  pir::SpinLock parameterless_instance_lock_;
+  std::shared_mutex parameterless_instance_lock_;
 };
 
 }  // namespace pir
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include "paddle/pir/include/core/builtin_attribute.h"
 #include "paddle/pir/include/core/builtin_op.h"
@@ -259,6 +260,8 @@ class IR_API ShapeAnalysisManager {
 
  private:
   ShapeAnalysisManager() {}
+  // Programs are analysed by background compilation threads as well.
+  std::mutex mutex_;
   std::unordered_map<uint64_t, std::shared_ptr<ShapeConstraintIRAnalysis>>
       tables_;
 };
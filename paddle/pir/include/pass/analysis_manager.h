@@ -157,21 +157,43 @@ class AnalysisMap {
 
   Operation* GetOperation() const { return ir_; }
 
-  void Clear() { analyses_.clear(); }
+  /// Returns the analysis map of an op nested in the current operation, the
+  /// map is created on the first query and kept until it is invalidated.
+  AnalysisMap* Nest(Operation* op) {
+    auto& child = child_analyses_[op];
+    if (!child) child = std::make_unique<AnalysisMap>(op);
+    return child.get();
+  }
+
+  void Clear() {
+    analyses_.clear();
+    child_analyses_.clear();
+  }
 
   /// Invalidate any cached analyses based upon the given set of preserved
   void Invalidate(const PreservedAnalyses& pa) {
     PreservedAnalyses pa_copy(pa);
 
-    // Remove any analyses that were invalidated.
-    // As using MapVector, order of insertion is preserved and
-    // dependencies always go before users, so need only one iteration.
-    for (auto it = analyses_.begin(); it != analyses_.end();) {
-      if (it->second->Invalidate(pa_copy))
-        it = analyses_.erase(it);
-      else
-        ++it;
+    // Remove any analyses that were invalidated. An invalidated analysis is
+    // unpreserved in pa_copy, so the analyses depending on it are removed
+    // in the next iteration whatever the order of the map is.
+    bool erased = true;
+    while (erased) {
+      erased = false;
+      for (auto it = analyses_.begin(); it != analyses_.end();) {
+        if (it->second->Invalidate(pa_copy)) {
+          it = analyses_.erase(it);
+          erased = true;
+        } else {
+          ++it;
+        }
+      }
     }
+
+    // The nested ops may have been erased or replaced, and the child maps are
+    // keyed by their addresses, so they are dropped unless all analyses are
+    // preserved.
+    child_analyses_.clear();
   }
 
  private:
@@ -242,6 +264,7 @@ class AnalysisMap {
  private:
   Operation* ir_;
   std::unordered_map<TypeId, std::unique_ptr<AnalysisConcept>> analyses_;
+  std::unordered_map<Operation*, std::unique_ptr<AnalysisMap>> child_analyses_;
 };
 
 }  // namespace detail
@@ -276,6 +299,12 @@ class AnalysisManager {
 
   void Clear() { analyses_->Clear(); }
 
+  /// Returns the analysis manager of an op nested in the current operation.
+  /// Its analyses are cached across the passes run on the nested op.
+  AnalysisManager Nest(Operation* op) {
+    return AnalysisManager(analyses_->Nest(op), instrumentor_);
+  }
+
   PassInstrumentor* GetPassInstrumentor() const { return instrumentor_; }
 
   Operation* GetOperation() { return analyses_->GetOperation(); }
@@ -161,6 +161,11 @@ class IR_API Pass {
 
   virtual bool CanApplyOn(Operation* op) const;
 
+  // Whether the pass can run on several sibling ops at the same time when the
+  // parallel execution of the PassManager is enabled. Such a pass only
+  // changes the op it runs on, and keeps no state in its members during Run.
+  virtual bool CanRunInParallel() const { return false; }
+
   virtual bool Initialize(IrContext* context) { return true; }
 
   void AddStatistics(int64_t match_count) {
@@ -115,6 +115,12 @@ class IR_API PassManager {
 
   void AddInstrumentation(std::unique_ptr<PassInstrumentation> pi);
 
+  /// Runs the nested pipelines of the sibling container ops on num_threads
+  /// threads, 0 for the number of cores. Only the ops using no value defined
+  /// outside of them are run in parallel, and only when all the passes
+  /// applied on them support it.
+  void EnableParallelExecution(int num_threads = 0);
+
  private:
   bool Initialize(IrContext *context);
 
@@ -129,6 +135,8 @@ class IR_API PassManager {
 
   bool disable_log_{false};
 
+  int num_threads_{1};
+
   std::vector<std::unique_ptr<Pass>> passes_;
 
   std::unique_ptr<Pass> pass_adaptor_;
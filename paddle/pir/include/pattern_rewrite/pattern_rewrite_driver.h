@@ -42,6 +42,12 @@ class IR_API GreedyRewriteConfig {
   /// pattern, use `kNolimit` to represent unlimited.
   int64_t max_iterations = 10;
 
+  /// Scan the region only once. Afterwards only the ops notified as changed
+  /// by the rewriter are revisited: the users of the replaced ops, the
+  /// inserted ops and the producers of the erased ops. `max_iterations` is
+  /// ignored in this mode.
+  bool use_incremental_worklist = false;
+
   /// Control the upper limit of rewrite times during each iteration, use
   /// kNoLimit to represent unlimited.
   int64_t max_num_rewrites = kNoLimit;
@@ -21,6 +21,7 @@
 #include "paddle/pir/include/core/dialect.h"
 #include "paddle/pir/include/core/op_info.h"
 #include "paddle/pir/include/core/operation.h"
+#include "paddle/pir/include/core/operation_arena.h"
 #include "paddle/pir/include/core/program.h"
 #include "paddle/pir/include/core/region.h"
 #include "paddle/pir/include/core/utils.h"
@@ -76,9 +77,9 @@ Operation *Operation::Create(const std::vector<Value> &inputs,
   size_t region_mem_size = num_regions * sizeof(Region);
   size_t base_size = result_mem_size + op_mem_size + operand_mem_size +
                      region_mem_size + block_operand_size;
-  // 2. Malloc memory.
+  // 2. Malloc memory, in the active arena if any.
   char *base_ptr =
-      reinterpret_cast<char *>(detail::aligned_malloc(base_size, 8));
+      reinterpret_cast<char *>(OperationArena::Allocate(base_size));
 
   auto name = op_info ? op_info.name() : "";
   VLOG(10) << "Create Operation [" << name
@@ -244,7 +245,7 @@ void Operation::Destroy() {
 
   VLOG(10) << "Destroy Operation [" << name() << "]: {ptr = " << aligned_ptr
            << ", size = " << result_mem_size << "} done.";
-  detail::aligned_free(aligned_ptr);
+  OperationArena::Deallocate(aligned_ptr);
 }
 
 IrContext *Operation::ir_context() const { return info_.ir_context(); }
@@ -0,0 +1,113 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/pir/include/core/operation_arena.h"
+
+#include <atomic>
+#include <new>
+
+#include "paddle/pir/include/core/utils.h"
+
+namespace pir {
+
+namespace {
+constexpr size_t kAlignment = 8;
+// Each allocation is preceded by the chunk it is in, nullptr for the heap.
+constexpr size_t kAllocationHeaderSize = 8;
+constexpr size_t kChunkCapacity = 64 * 1024;
+// The larger allocations are not worth a chunk.
+constexpr size_t kMaxChunkAllocationSize = kChunkCapacity / 4;
+
+constexpr size_t AlignUp(size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+thread_local OperationArena *active_arena = nullptr;
+}  // namespace
+
+struct OperationArena::Chunk {
+  // The live allocations of the chunk, and one while the arena allocates in
+  // it.
+  std::atomic<size_t> refs{1};
+
+  static constexpr size_t kHeaderSize = AlignUp(sizeof(std::atomic<size_t>));
+
+  static Chunk *New() {
+    void *ptr =
+        detail::aligned_malloc(kHeaderSize + kChunkCapacity, kAlignment);
+    return new (ptr) Chunk();
+  }
+
+  char *begin() { return reinterpret_cast<char *>(this) + kHeaderSize; }
+
+  void Release() {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      this->~Chunk();
+      detail::aligned_free(this);
+    }
+  }
+};
+
+OperationArena::~OperationArena() {
+  if (chunk_ != nullptr) {
+    chunk_->Release();
+  }
+}
+
+void *OperationArena::Allocate(size_t size) {
+  size_t total_size = kAllocationHeaderSize + AlignUp(size);
+  char *ptr = nullptr;
+  if (active_arena != nullptr && total_size <= kMaxChunkAllocationSize) {
+    ptr = static_cast<char *>(active_arena->AllocateInChunk(total_size));
+  } else {
+    ptr = static_cast<char *>(detail::aligned_malloc(total_size, kAlignment));
+    *reinterpret_cast<Chunk **>(ptr) = nullptr;
+  }
+  return ptr + kAllocationHeaderSize;
+}
+
+void OperationArena::Deallocate(void *ptr) {
+  char *header = static_cast<char *>(ptr) - kAllocationHeaderSize;
+  Chunk *chunk = *reinterpret_cast<Chunk **>(header);
+  if (chunk == nullptr) {
+    detail::aligned_free(header);
+  } else {
+    chunk->Release();
+  }
+}
+
+void *OperationArena::AllocateInChunk(size_t size) {
+  if (chunk_ == nullptr || static_cast<size_t>(end_ - cursor_) < size) {
+    if (chunk_ != nullptr) {
+      chunk_->Release();
+    }
+    chunk_ = Chunk::New();
+    cursor_ = chunk_->begin();
+    end_ = cursor_ + kChunkCapacity;
+  }
+  chunk_->refs.fetch_add(1, std::memory_order_relaxed);
+  char *ptr = cursor_;
+  cursor_ += size;
+  *reinterpret_cast<Chunk **>(ptr) = chunk_;
+  return ptr;
+}
+
+OperationArenaGuard::OperationArenaGuard(OperationArena *arena)
+    : prev_arena_(active_arena) {
+  active_arena = arena;
+}
+
+OperationArenaGuard::~OperationArenaGuard() { active_arena = prev_arena_; }
+
+}  // namespace pir
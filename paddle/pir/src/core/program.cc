@@ -66,6 +66,7 @@ Program::~Program() {
 std::shared_ptr<Program> Program::Clone(IrMapping& ir_mapping) const {
   pir::IrContext* ctx = pir::IrContext::Instance();
   auto new_program = std::make_shared<Program>(ctx);
+  OperationArenaGuard arena_guard(new_program->arena());
   auto clone_options = CloneOptions::All();
 
   // deal kwargs
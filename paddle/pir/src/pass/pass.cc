@@ -13,7 +13,13 @@
 // limitations under the License.
 
 #include <glog/logging.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
+#include "paddle/pir/include/core/block_argument.h"
 #include "paddle/pir/include/core/ir_context.h"
 #include "paddle/pir/include/core/operation.h"
 #include "paddle/pir/include/core/program.h"
@@ -26,9 +32,17 @@
 #include "paddle/pir/src/pass/pass_adaptor.h"
 
 #include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
+#include "paddle/common/startup_trace.h"
+
+COMMON_DECLARE_bool(pir_incremental_pattern_rewrite);
 
 namespace pir {
 
+namespace detail {
+thread_local PassStateMap* tls_pass_states = nullptr;
+}  // namespace detail
+
 //===----------------------------------------------------------------------===//
 // Pass
 //===----------------------------------------------------------------------===//
@@ -45,21 +59,26 @@ Pass::~Pass() {
 bool Pass::CanApplyOn(Operation* op) const { return op->num_regions() > 0; }
 
 std::optional<detail::PassExecutionState>& Pass::pass_state() {
+  if (detail::tls_pass_states != nullptr) {
+    return (*detail::tls_pass_states)[this];
+  }
   return pass_state_;
 }
 
 void Pass::SignalPassFailure() {
-  PADDLE_ENFORCE_EQ(pass_state_.has_value(),
+  auto& state = pass_state();
+  PADDLE_ENFORCE_EQ(state.has_value(),
                     true,
                     common::errors::InvalidArgument("pass state has no value"));
-  pass_state_->pass_failed = true;
+  state->pass_failed = true;
 }
 
 AnalysisManager Pass::analysis_manager() {
-  PADDLE_ENFORCE_EQ(pass_state_.has_value(),
+  auto& state = pass_state();
+  PADDLE_ENFORCE_EQ(state.has_value(),
                     true,
                     common::errors::InvalidArgument("pass state has no value"));
-  return pass_state_->am;
+  return state->am;
 }
 //===----------------------------------------------------------------------===//
 // PatternRewritePass
@@ -84,6 +103,7 @@ GreedyRewriteConfig PatternRewritePass::InitializeConfig() {
   GreedyRewriteConfig config;
   config.use_top_down_traversal = true;
   config.max_iterations = 10;
+  config.use_incremental_worklist = FLAGS_pir_incremental_pattern_rewrite;
   return config;
 }
 
@@ -92,38 +112,153 @@ void PatternRewritePass::Run(Operation* op) {
   auto [_, num_rewrites] =
       ApplyPatternsGreedily(op, patterns_, InitializeConfig());
   AddStatistics(num_rewrites);
+  // Nothing is rewritten, the cached analyses are still valid.
+  if (num_rewrites == 0) {
+    pass_state()->preserved_analyses.PreserveAll();
+  }
 }
 
 //----------------------------------------------------------------------------------------------//
 // PassAdaptor
 //----------------------------------------------------------------------------------------------//
-void detail::PassAdaptor::Run(Operation* op, uint8_t opt_level, bool verify) {
-  RunImpl(op, opt_level, verify);
-}
-
-void detail::PassAdaptor::RunImpl(Operation* op,
+bool detail::PassAdaptor::RunImpl(Operation* op,
+                                  AnalysisManager am,
                                   uint8_t opt_level,
-                                  bool verify) {
-  auto last_am = analysis_manager();
-
+                                  bool verify,
+                                  bool* preserved_all) {
   for (size_t i = 0; i < op->num_regions(); ++i) {
     auto& region = op->region(i);
     for (auto& block : region) {
+      std::vector<Operation*> parallel_ops;
       for (auto& op : block) {
-        AnalysisManagerHolder am(&op, last_am.GetPassInstrumentor());
-        if (!RunPipeline(*pm_, &op, am, opt_level, verify))
-          return SignalPassFailure();
+        if (IsParallelizable(&op)) {
+          parallel_ops.push_back(&op);
+          continue;
+        }
+        // Only the container ops keep their analyses in the parent's cache,
+        // so that a large program does not allocate a cache per op.
+        if (op.num_regions() == 0) {
+          AnalysisManagerHolder holder(&op, am.GetPassInstrumentor());
+          if (!RunPipeline(*pm_, &op, holder, opt_level, verify, preserved_all))
+            return false;
+          continue;
+        }
+        if (!RunPipeline(
+                *pm_, &op, am.Nest(&op), opt_level, verify, preserved_all))
+          return false;
       }
+      if (!RunParallel(parallel_ops, am, opt_level, verify, preserved_all))
+        return false;
     }
   }
-  return;
+  return true;
+}
+
+bool detail::PassAdaptor::IsParallelizable(Operation* op) const {
+  if (pm_->num_threads_ <= 1 || op->num_regions() == 0 ||
+      tls_pass_states != nullptr) {
+    return false;
+  }
+  for (auto& pass : pm_->passes()) {
+    if (pass->CanApplyOn(op) && !pass->CanRunInParallel()) {
+      return false;
+    }
+  }
+  // The nested ops must not use the values defined outside of the op, the
+  // use lists of those values would be changed by several threads.
+  auto IsDefinedInside = [op](Value value) {
+    Operation* def_op = nullptr;
+    if (auto arg = value.dyn_cast<BlockArgument>()) {
+      def_op = arg.owner()->GetParentOp();
+    } else {
+      def_op = value.defining_op();
+    }
+    for (; def_op != nullptr; def_op = def_op->GetParentOp()) {
+      if (def_op == op) return true;
+    }
+    return false;
+  };
+  bool isolated = true;
+  for (auto& region : *op) {
+    for (auto& block : region) {
+      for (auto& nested_op : block) {
+        nested_op.Walk([&](Operation* inner_op) {
+          for (uint32_t i = 0; isolated && i < inner_op->num_operands(); ++i) {
+            Value operand = inner_op->operand_source(i);
+            isolated = !operand || IsDefinedInside(operand);
+          }
+        });
+        if (!isolated) return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool detail::PassAdaptor::RunParallel(const std::vector<Operation*>& ops,
+                                      AnalysisManager am,
+                                      uint8_t opt_level,
+                                      bool verify,
+                                      bool* preserved_all) {
+  if (ops.empty()) return true;
+  // The nested caches are created before the threads start, the cache of the
+  // parent is not thread safe.
+  std::vector<AnalysisManager> ams;
+  ams.reserve(ops.size());
+  for (Operation* op : ops) {
+    ams.push_back(am.Nest(op));
+  }
+
+  std::atomic<size_t> next_op{0};
+  std::atomic<bool> failed{false};
+  std::atomic<bool> all_preserved{true};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto Worker = [&]() {
+    // Each thread has its own execution states of the passes, since the
+    // same pass objects run on several ops at the same time.
+    PassStateMap states;
+    tls_pass_states = &states;
+    for (size_t i = next_op++; i < ops.size() && !failed; i = next_op++) {
+      bool op_preserved_all = true;
+      try {
+        if (!RunPipeline(
+                *pm_, ops[i], ams[i], opt_level, verify, &op_preserved_all)) {
+          failed = true;
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(error_mutex);
+        if (!error) error = std::current_exception();
+        failed = true;
+      }
+      if (!op_preserved_all) all_preserved = false;
+    }
+    tls_pass_states = nullptr;
+  };
+
+  size_t num_threads =
+      std::min(static_cast<size_t>(pm_->num_threads_), ops.size());
+  VLOG(4) << "Run the passes on " << ops.size() << " ops with " << num_threads
+          << " threads";
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(Worker);
+  }
+  Worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) std::rethrow_exception(error);
+  if (preserved_all && !all_preserved) *preserved_all = false;
+  return !failed;
 }
 
 bool detail::PassAdaptor::RunPipeline(const PassManager& pm,
                                       Operation* op,
                                       AnalysisManager am,
                                       uint8_t opt_level,
-                                      bool verify) {
+                                      bool verify,
+                                      bool* preserved_all) {
   auto* instrumentor = am.GetPassInstrumentor();
   if (instrumentor) {
     instrumentor->RunBeforePipeline(op);
@@ -131,7 +266,7 @@ bool detail::PassAdaptor::RunPipeline(const PassManager& pm,
 
   for (auto& pass : pm.passes()) {
     if (pass->CanApplyOn(op)) {
-      if (!RunPass(pass.get(), op, am, opt_level, verify)) {
+      if (!RunPass(pass.get(), op, am, opt_level, verify, preserved_all)) {
         return false;
       }
     }
@@ -142,7 +277,8 @@ bool detail::PassAdaptor::RunPipeline(const PassManager& pm,
   }
 
   // Apply pass manager on all nested ir.
-  if (!RunPass(pm.pass_adaptor_.get(), op, am, opt_level, verify)) {
+  if (!RunPass(
+          pm.pass_adaptor_.get(), op, am, opt_level, verify, preserved_all)) {
     return false;
   }
 
@@ -153,25 +289,52 @@ bool detail::PassAdaptor::RunPass(Pass* pass,
                                   Operation* op,
                                   AnalysisManager am,
                                   uint8_t opt_level,
-                                  bool verify) {
+                                  bool verify,
+                                  bool* preserved_all) {
   if (opt_level < pass->pass_info().opt_level) return true;
 
-  pass->pass_state_ = PassExecutionState(op, am);
+  // The same adaptor runs on every level of the nested ops, so its result
+  // is returned here instead of kept in its execution state.
+  if (auto* adaptor = dynamic_cast<PassAdaptor*>(pass)) {
+    bool nested_preserved_all = true;
+    if (!adaptor->RunImpl(op, am, opt_level, verify, &nested_preserved_all)) {
+      return false;
+    }
+    if (verify) {
+      pir::Verify(op, /* verify_recursively = */ false);
+    }
+    // The analyses of the current op are preserved only if no nested pass
+    // changes the IR.
+    if (!nested_preserved_all) {
+      am.Invalidate(PreservedAnalyses());
+      if (preserved_all) *preserved_all = false;
+    }
+    return true;
+  }
+
+  auto& pass_state = pass->pass_state();
+  pass_state = PassExecutionState(op, am);
 
   PassInstrumentor* instrumentor = am.GetPassInstrumentor();
-
-  if (auto* adaptor = dynamic_cast<PassAdaptor*>(pass)) {
-    adaptor->Run(op, opt_level, verify);
-  } else {
+  {
+    common::StartupTraceScope startup_trace("PirPass", pass->name());
     if (instrumentor) instrumentor->RunBeforePass(pass, op);
     pass->Run(op);
     if (instrumentor) instrumentor->RunAfterPass(pass, op);
   }
-  bool pass_failed = pass->pass_state()->pass_failed;
+  bool pass_failed = pass_state->pass_failed;
 
   if (!pass_failed && verify) {
-    bool verify_recursively = !dynamic_cast<PassAdaptor*>(pass);
-    pir::Verify(op, verify_recursively);
+    pir::Verify(op, /* verify_recursively = */ true);
+  }
+
+  // Drop the cached analyses that the pass does not preserve, the preserved
+  // ones are reused by the following passes.
+  if (!pass_failed) {
+    am.Invalidate(pass_state->preserved_analyses);
+    if (preserved_all && !pass_state->preserved_analyses.IsAll()) {
+      *preserved_all = false;
+    }
   }
 
   return !pass_failed;
@@ -185,6 +348,12 @@ PassManager::PassManager(IrContext* context, uint8_t opt_level)
   pass_adaptor_ = std::make_unique<detail::PassAdaptor>(this);
 }
 
+void PassManager::EnableParallelExecution(int num_threads) {
+  num_threads_ = num_threads > 0
+                     ? num_threads
+                     : static_cast<int>(std::thread::hardware_concurrency());
+}
+
 bool PassManager::Run(Program* program) {
   if (!Initialize(context_)) {
     return false;
@@ -218,8 +387,10 @@ void PassManager::AddInstrumentation(std::unique_ptr<PassInstrumentation> pi) {
 //----------------------------------------------------------------------------------------------//
 namespace detail {
 struct PassInstrumentorImpl {
-  // TODO(wilber): Support multi-thread.
   std::vector<std::unique_ptr<PassInstrumentation>> instrumentations;
+  // The instrumentations are not thread safe, the passes running in parallel
+  // call them one by one.
+  std::recursive_mutex mutex;
 };
 }  // namespace detail
 
@@ -230,6 +401,7 @@ PassInstrumentor::~PassInstrumentor() = default;
 
 void PassInstrumentor::RunBeforePipeline(Operation* op) {
   if (op->num_regions() == 0) return;
+  std::lock_guard<std::recursive_mutex> guard(impl_->mutex);
   for (auto& instr : impl_->instrumentations) {
     instr->RunBeforePipeline(op);
   }
@@ -237,6 +409,7 @@ void PassInstrumentor::RunBeforePipeline(Operation* op) {
 
 void PassInstrumentor::RunAfterPipeline(Operation* op) {
   if (op->num_regions() == 0) return;
+  std::lock_guard<std::recursive_mutex> guard(impl_->mutex);
   for (auto it = impl_->instrumentations.rbegin();
        it != impl_->instrumentations.rend();
        ++it) {
@@ -246,6 +419,7 @@ void PassInstrumentor::RunAfterPipeline(Operation* op) {
 
 void PassInstrumentor::RunBeforePass(Pass* pass, Operation* op) {
   if (op->num_regions() == 0) return;
+  std::lock_guard<std::recursive_mutex> guard(impl_->mutex);
   for (auto& instr : impl_->instrumentations) {
     instr->RunBeforePass(pass, op);
   }
@@ -253,6 +427,7 @@ void PassInstrumentor::RunBeforePass(Pass* pass, Operation* op) {
 
 void PassInstrumentor::RunAfterPass(Pass* pass, Operation* op) {
   if (op->num_regions() == 0) return;
+  std::lock_guard<std::recursive_mutex> guard(impl_->mutex);
   for (auto it = impl_->instrumentations.rbegin();
        it != impl_->instrumentations.rend();
        ++it) {
@@ -264,6 +439,7 @@ void PassInstrumentor::RunBeforeAnalysis(const std::string& name,
                                          TypeId id,
                                          Operation* op) {
   if (op->num_regions() == 0) return;
+  std::lock_guard<std::recursive_mutex> guard(impl_->mutex);
   for (auto& instr : impl_->instrumentations) {
     instr->RunBeforeAnalysis(name, id, op);
   }
@@ -273,15 +449,17 @@ void PassInstrumentor::RunAfterAnalysis(const std::string& name,
                                         TypeId id,
                                         Operation* op) {
   if (op->num_regions() == 0) return;
+  std::lock_guard<std::recursive_mutex> guard(impl_->mutex);
   for (auto it = impl_->instrumentations.rbegin();
        it != impl_->instrumentations.rend();
        ++it) {
-    (*it)->RunBeforeAnalysis(name, id, op);
+    (*it)->RunAfterAnalysis(name, id, op);
   }
 }
 
 void PassInstrumentor::AddInstrumentation(
     std::unique_ptr<PassInstrumentation> pi) {
+  std::lock_guard<std::recursive_mutex> guard(impl_->mutex);
   impl_->instrumentations.emplace_back(std::move(pi));
 }
 
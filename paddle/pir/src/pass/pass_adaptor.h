@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "paddle/pir/include/pass/pass.h"
 
 namespace pir {
@@ -22,6 +26,14 @@ class Operation;
 class PassManager;
 
 namespace detail {
+
+using PassStateMap =
+    std::unordered_map<const Pass*, std::optional<PassExecutionState>>;
+
+// The execution states of the passes on a worker thread of the parallel
+// PassAdaptor, nullptr on the other threads.
+extern thread_local PassStateMap* tls_pass_states;
+
 // Used to run operation passes over nested operations.
 class PassAdaptor final : public Pass {
  public:
@@ -29,22 +41,39 @@ class PassAdaptor final : public Pass {
 
   void Run(Operation*) override {}
 
-  void Run(Operation*, uint8_t opt_level, bool verify);
-
  private:
-  void RunImpl(Operation* op, uint8_t opt_level, bool verify);
+  // Runs the pipeline on the ops nested in op. preserved_all is set to false
+  // when a pass does not preserve all the analyses.
+  bool RunImpl(Operation* op,
+               AnalysisManager am,
+               uint8_t opt_level,
+               bool verify,
+               bool* preserved_all);
+
+  // Whether the pipeline can run on the op in parallel with its sibling ops:
+  // the passes applied on it support it and it only uses the values defined
+  // inside it.
+  bool IsParallelizable(Operation* op) const;
+
+  bool RunParallel(const std::vector<Operation*>& ops,
+                   AnalysisManager am,
+                   uint8_t opt_level,
+                   bool verify,
+                   bool* preserved_all);
 
   static bool RunPass(Pass* pass,
                       Operation* op,
                       AnalysisManager am,
                       uint8_t opt_level,
-                      bool verify);
+                      bool verify,
+                      bool* preserved_all = nullptr);
 
   static bool RunPipeline(const PassManager& pm,
                           Operation* op,
                           AnalysisManager am,
                           uint8_t opt_level,
-                          bool verify);
+                          bool verify,
+                          bool* preserved_all = nullptr);
 
  private:
   PassManager* pm_;
@@ -81,6 +81,20 @@ class PassTimer : public PassInstrumentation {
     pass_timers_[op][pass->name()].Stop();
   }
 
+  // The analyses are computed inside the passes querying them, so their time
+  // is part of the time of these passes and is also listed on its own.
+  void RunBeforeAnalysis(const std::string& name,
+                         TypeId id,
+                         Operation* op) override {
+    analysis_timers_[op][name].Start();
+  }
+
+  void RunAfterAnalysis(const std::string& name,
+                        TypeId id,
+                        Operation* op) override {
+    analysis_timers_[op][name].Stop();
+  }
+
  private:
   void PrintTime(Operation* op, std::ostream& os) {
     if (print_module_ && op->name() != "builtin.module") return;
@@ -92,7 +106,17 @@ class PassTimer : public PassInstrumentation {
        << pipeline_timers_[op].GetTimePerSecond() << " seconds\n\n";
     os << "  ----Walk Time----  ----Name----\n";
 
-    auto& map = pass_timers_[op];
+    PrintTimers(op, pass_timers_[op], os);
+
+    if (analysis_timers_.count(op)) {
+      os << "\n  ----Analysis Time----  ----Name----\n";
+      PrintTimers(op, analysis_timers_[op], os);
+    }
+  }
+
+  void PrintTimers(Operation* op,
+                   const std::unordered_map<std::string, Timer>& map,
+                   std::ostream& os) {
     std::vector<std::pair<std::string, Timer>> pairs(map.begin(), map.end());
     std::sort(pairs.begin(),
               pairs.end(),
@@ -121,6 +145,10 @@ class PassTimer : public PassInstrumentation {
   std::unordered_map<Operation*,
                      std::unordered_map<std::string /*pass name*/, Timer>>
       pass_timers_;
+
+  std::unordered_map<Operation*,
+                     std::unordered_map<std::string /*analysis name*/, Timer>>
+      analysis_timers_;
 };
 
 void PassManager::EnablePassTiming(bool print_module) {
@@ -84,6 +84,11 @@ class GreedyPatternRewriteDriver : public pir::PatternRewriter {
 
       num_rewrites = ProcessWorklist();
       sum_num_rewrites += num_rewrites;
+      if (config_.use_incremental_worklist) {
+        // The changed ops have been revisited through the worklist, it
+        // converges if the rewrite limit did not stop it.
+        return std::make_pair(worklist_.empty(), sum_num_rewrites);
+      }
     } while (num_rewrites != 0);
     bool converged = num_rewrites == 0;
     return std::make_pair(converged, sum_num_rewrites);
@@ -128,6 +128,7 @@ from . import (
 from .autograd import (
     enable_grad,
     grad,
+    inference_mode,
     is_grad_enabled,
     no_grad,
     set_grad_enabled,
@@ -933,6 +934,7 @@ __all__ = [
     'nanquantile',
     'no_grad',
     'enable_grad',
+    'inference_mode',
     'set_grad_enabled',
     'is_grad_enabled',
     'mod',
@@ -50,6 +50,8 @@ __all__ = [
     "disable_tensor_checker",
     "compare_accuracy",
     "check_layer_numerics",
+    "get_nan_inf_count",
+    "AsyncNanInfChecker",
 ]
 
 
@@ -724,3 +726,123 @@ def disable_tensor_checker() -> None:
 
     """
     paddle.set_flags({"FLAGS_check_nan_inf": 0})
+
+
+def get_nan_inf_count() -> int:
+    """
+    Returns the number of NaN and Inf elements found in the outputs of the
+    operators since the last call, when they are checked asynchronously by
+    FLAGS_check_nan_inf and FLAGS_check_nan_inf_async. It waits for the
+    devices, so call it once in a while, e.g. once per step.
+
+    Examples:
+
+        .. code-block:: python
+
+            >>> import paddle
+
+            >>> paddle.set_flags(
+            ...     {"FLAGS_check_nan_inf": 1, "FLAGS_check_nan_inf_async": 1}
+            ... )
+            >>> x = paddle.to_tensor([1.0, 0.0, -1.0])
+            >>> y = paddle.log(x)
+            >>> paddle.set_flags(
+            ...     {"FLAGS_check_nan_inf": 0, "FLAGS_check_nan_inf_async": 0}
+            ... )
+            >>> print(paddle.amp.debugging.get_nan_inf_count())
+            2
+    """
+    return core.get_nan_inf_count()
+
+
+class AsyncNanInfChecker:
+    """
+    Checks the NaN and Inf in the outputs of the operators of the training
+    steps without synchronizing with the devices per operator, see
+    get_nan_inf_count. The numbers of NaN and Inf are fetched every
+    ``check_interval`` steps, and when some are found, the step is replayed
+    with the checking of DebugMode.CHECK_NAN_INF_AND_ABORT, which aborts at
+    the first operator producing NaN or Inf.
+
+    Args:
+        check_interval(int, optional): The number of steps between the
+            fetches of the numbers of NaN and Inf. Default is 1.
+        checked_op_list(list|tuple|None, optional): The operators to check,
+            as in TensorCheckerConfig. Default is None.
+        skipped_op_list(list|tuple|None, optional): The operators not to
+            check, as in TensorCheckerConfig. Default is None.
+
+    Note:
+        The replay calls the step function again on the same arguments, so
+        it should not update the states it reads, e.g. it runs the forward
+        and backward, and the parameters are updated after ``run`` returns.
+        With check_interval > 1, the NaN or Inf may come from a step before
+        the replayed one.
+
+    Examples:
+
+        .. code-block:: python
+
+            >>> import paddle
+
+            >>> checker = paddle.amp.debugging.AsyncNanInfChecker()
+            >>> model = paddle.nn.Linear(4, 4)
+            >>> opt = paddle.optimizer.SGD(parameters=model.parameters())
+
+            >>> def train_step(x):
+            ...     loss = model(x).mean()
+            ...     loss.backward()
+            ...     return loss
+
+            >>> loss = checker.run(train_step, paddle.rand([2, 4]))
+            >>> opt.step()
+            >>> opt.clear_grad()
+    """
+
+    def __init__(
+        self,
+        check_interval: int = 1,
+        checked_op_list: Sequence[str] | None = None,
+        skipped_op_list: Sequence[str] | None = None,
+    ) -> None:
+        if check_interval < 1:
+            raise ValueError("check_interval must be positive")
+        self.check_interval = check_interval
+        self.step_id = 0
+        set_checked_op_list(checked_op_list)
+        set_skipped_op_list(skipped_op_list)
+
+    def run(
+        self,
+        step_fn: Callable[_InputT, _RetT],
+        *args: _InputT.args,
+        **kwargs: _InputT.kwargs,
+    ) -> _RetT:
+        self.step_id += 1
+        paddle.set_flags(
+            {"FLAGS_check_nan_inf": 1, "FLAGS_check_nan_inf_async": 1}
+        )
+        try:
+            out = step_fn(*args, **kwargs)
+        finally:
+            paddle.set_flags(
+                {"FLAGS_check_nan_inf": 0, "FLAGS_check_nan_inf_async": 0}
+            )
+        if self.step_id % self.check_interval != 0:
+            return out
+        count = get_nan_inf_count()
+        if count == 0:
+            return out
+
+        level = DebugMode.CHECK_NAN_INF_AND_ABORT.value
+        paddle.set_flags(
+            {"FLAGS_check_nan_inf": 1, "FLAGS_check_nan_inf_level": level}
+        )
+        try:
+            step_fn(*args, **kwargs)
+        finally:
+            paddle.set_flags({"FLAGS_check_nan_inf": 0})
+        raise RuntimeError(
+            f"{count} NaN or Inf elements are found by the step "
+            f"{self.step_id}, but not by its replay."
+        )
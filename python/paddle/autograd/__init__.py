@@ -15,6 +15,7 @@
 from ..base.dygraph.base import (  # noqa: F401
     enable_grad,
     grad,
+    inference_mode,
     is_grad_enabled,
     no_grad_ as no_grad,
     set_grad_enabled,
@@ -26,7 +27,11 @@ from . import (  # noqa: F401
 from .autograd import hessian, jacobian
 from .backward_mode import backward
 from .py_layer import PyLayer, PyLayerContext
-from .saved_tensors_hooks import saved_tensors_hooks
+from .saved_tensors_hooks import (
+    offload_saved_tensors,
+    recompute_saved_tensors,
+    saved_tensors_hooks,
+)
 
 __all__ = [
     'jacobian',
@@ -35,4 +40,6 @@ __all__ = [
     'PyLayer',
     'PyLayerContext',
     'saved_tensors_hooks',
+    'offload_saved_tensors',
+    'recompute_saved_tensors',
 ]
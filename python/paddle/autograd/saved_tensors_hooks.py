@@ -125,3 +125,94 @@ class saved_tensors_hooks:
 
     def __exit__(self, *args: object) -> None:
         core.eager.reset_saved_tensors_hooks()
+
+
+class offload_saved_tensors:
+    """
+    Dynamic graph, moves the tensors saved for backward to pinned host memory
+    in C++, without the python pack / unpack hooks of `saved_tensors_hooks`.
+
+    Every GPU tensor saved for backward in the context, which is not a
+    parameter and has at least `min_bytes` bytes, is copied to host on a side
+    stream and its GPU memory is released once the copy is done. Backward
+    copies it back before the grad node needs it, with the `prefetch_num`
+    tensors saved before it copied ahead, so larger batches fit without
+    recomputing the activations. Only available with CUDA.
+
+    Parameters:
+        min_bytes (int, optional): The smallest tensor to offload in bytes.
+            Default is 1048576.
+        prefetch_num (int, optional): The number of saved tensors copied back
+            ahead of the grad node running. Default is 2.
+
+    Returns:
+            None
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> paddle.device.set_device('gpu')
+            >>> a = paddle.ones([1024, 1024])
+            >>> a.stop_gradient = False
+            >>> with paddle.autograd.offload_saved_tensors():
+            ...     y = paddle.tanh(paddle.tanh(a))
+            >>> y.sum().backward()
+    """
+
+    def __init__(self, min_bytes: int = 1 << 20, prefetch_num: int = 2) -> None:
+        self.min_bytes = min_bytes
+        self.prefetch_num = prefetch_num
+
+    def __enter__(self) -> None:
+        core.eager.enable_activation_offload(self.min_bytes, self.prefetch_num)
+
+    def __exit__(self, *args: object) -> None:
+        core.eager.disable_activation_offload()
+
+
+class recompute_saved_tensors:
+    """
+    Dynamic graph, recomputes the tensors saved for backward from the inputs
+    of the ops producing them, instead of keeping them until backward.
+
+    In the context, the output of an op whose inputs are all saved for its own
+    backward, such as an activation or a matmul, is registered with its
+    kernel. The first `budget_bytes` bytes of such outputs saved for backward
+    are kept, the rest only keep their shape and are computed again by the
+    grad node needing them, so the saved activations take about the budget on
+    top of what the ops keep anyway. Ops drawing random numbers, like dropout,
+    are never recomputed.
+
+    Parameters:
+        budget_bytes (int, optional): The bytes of recomputable tensors kept
+            between forward and backward. Default is 0, recomputing all.
+        ops (list[str]|None, optional): The ops whose outputs may be
+            recomputed, all the supported ones when None. Default is None.
+
+    Returns:
+            None
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> a = paddle.ones([16, 16])
+            >>> a.stop_gradient = False
+            >>> with paddle.autograd.recompute_saved_tensors(ops=['matmul']):
+            ...     y = paddle.nn.functional.gelu(paddle.matmul(a, a))
+            >>> y.sum().backward()
+    """
+
+    def __init__(
+        self, budget_bytes: int = 0, ops: list[str] | None = None
+    ) -> None:
+        self.budget_bytes = budget_bytes
+        self.ops = [] if ops is None else list(ops)
+
+    def __enter__(self) -> None:
+        core.eager.enable_recompute(self.budget_bytes, self.ops)
+
+    def __exit__(self, *args: object) -> None:
+        core.eager.disable_recompute()
@@ -1202,6 +1202,32 @@ class InMemoryDataset(DatasetBase):
         """
         self.dataset.dump_sample_neighbors(path)
 
+    def dump_slot_records(self, path_prefix, compress=True):
+        """
+        Dump the data in memory to binary columnar slot record files, one
+        per thread named path_prefix-<thread>.slotbin, which are loaded
+        without parsing text when set in the filelist. Only supported by
+        the SlotRecordInMemoryDataFeed feed type.
+
+        Args:
+            path_prefix(str): the prefix of the files, local or on hdfs.
+            compress(bool): whether to compress the blocks of the files with
+                zlib. Default is True.
+
+        Examples:
+            .. code-block:: python
+
+                >>> # doctest: +SKIP('need to work with real dataset')
+                >>> import paddle.base as base
+                >>> dataset = base.DatasetFactory().create_dataset("InMemoryDataset")
+                >>> dataset.set_feed_type("SlotRecordInMemoryDataFeed")
+                >>> filelist = ["a.txt", "b.txt"]
+                >>> dataset.set_filelist(filelist)
+                >>> dataset.load_into_memory()
+                >>> dataset.dump_slot_records("hdfs:/data/part")
+        """
+        self.dataset.dump_slot_records(path_prefix, compress)
+
 
 class QueueDataset(DatasetBase):
     """
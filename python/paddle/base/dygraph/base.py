@@ -604,6 +604,50 @@ class enable_grad(_DecoratorContextManager):
         _set_grad_enabled(self.prev)
 
 
+class inference_mode(_DecoratorContextManager):
+    """
+    :api_attr: imperative
+
+    Create a context which disables dygraph gradient calculation like
+    `no_grad`, and besides skips creating the autograd metadata of the
+    results, which makes small ops of inference cheaper.
+
+    The results of the computation have `stop_gradient` set to `True`, and
+    should not be fed to a computation that requires gradient afterwards.
+
+    Also functions as a decorator. (Make sure to use an instance.)
+
+    Examples:
+
+        .. code-block:: python
+
+            >>> import paddle
+
+            >>> linear = paddle.nn.Linear(2, 2)
+            >>> x = paddle.ones([3, 2])
+            >>> with paddle.inference_mode():
+            ...     y = linear(x)
+            >>> print(y.stop_gradient)
+            True
+
+            >>> @paddle.inference_mode()
+            >>> def predict(x):
+            ...     return linear(x)
+            ...
+            >>> z = predict(x)
+    """
+
+    def __enter__(self) -> None:
+        self.prev = is_grad_enabled()
+        self.prev_inference_mode = core._is_inference_mode()
+        _set_grad_enabled(False)
+        core._set_inference_mode(True)
+
+    def __exit__(self, *args: object) -> None:
+        core._set_inference_mode(self.prev_inference_mode)
+        _set_grad_enabled(self.prev)
+
+
 @signature_safe_contextmanager
 def guard(place: PlaceLike | None = None) -> Generator[None, None, None]:
     """
@@ -2811,7 +2811,7 @@ class Executor:
         nrank = len(trainer_endpoints)
 
         assert 'scheduler' in fleet_opt or 'tasks' in fleet_opt, (
-            "Fleet executor need configuration for scheduler, you can choose from 1F1B or Origin. "
+            "Fleet executor need configuration for scheduler, you can choose from 1F1B, ZeroBubble or Origin. "
             "Or you can provide a list of task nodes to init fleet executor directly."
         )
         if 'tasks' in fleet_opt:
@@ -2824,7 +2824,7 @@ class Executor:
             task_id_to_rank = fleet_opt['task_id_to_rank']
         else:
             scheduler = fleet_opt['scheduler']
-            if scheduler == '1F1B':
+            if scheduler in ('1F1B', 'ZeroBubble'):
                 from paddle.distributed.fleet.fleet_executor_utils import (
                     run1f1b,
                 )
@@ -2834,7 +2834,9 @@ class Executor:
                     or "pp_degree" not in fleet_opt["dist_strategy"]
                     or fleet_opt["dist_strategy"]["pp_degree"] == 1
                 ):
-                    warnings.warn("Using 1F1B scheduler with pp_degree == 1.")
+                    warnings.warn(
+                        f"Using {scheduler} scheduler with pp_degree == 1."
+                    )
                 tasks, task_id_to_rank = run1f1b(
                     program,
                     cur_rank,
@@ -2842,6 +2844,7 @@ class Executor:
                     fleet_opt.get('dist_strategy', {}),
                     nrank,
                     with_standalone_executor,
+                    zero_bubble=scheduler == 'ZeroBubble',
                 )
             elif scheduler == 'Origin':
                 from paddle.distributed.fleet.fleet_executor_utils import origin
@@ -2859,7 +2862,7 @@ class Executor:
                     ), "For origin scheduler mode, the num micro batches should be 1."
                 tasks, task_id_to_rank = origin(program, cur_rank)
             else:
-                raise "Fleet_executor only supports 1F1B and Origin scheduler, " "but received " + str(
+                raise "Fleet_executor only supports 1F1B, ZeroBubble and Origin scheduler, " "but received " + str(
                     scheduler
                 ) + "."
             # NOTE: have to hold these vars, otherwise will be destructed
@@ -0,0 +1,343 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+
+import numpy as np
+
+import paddle
+import paddle.distributed as dist
+import paddle.nn.functional as F
+from paddle import _C_ops
+from paddle.autograd import PyLayer
+from paddle.distributed.communication.group import _get_global_group
+
+from .api import dtensor_from_local
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+    from paddle.distributed.communication.group import Group
+
+    from .process_mesh import ProcessMesh
+
+# The ring groups along the axes of the meshes, see _get_ring_group.
+_g_ring_groups = {}
+
+
+class _RingCommunicator:
+    """
+    Sends tensors to the next rank of a ring and receives the ones of the
+    previous rank, asynchronously, by the P2P ops of the process group.
+    """
+
+    def __init__(self, group: Group, ring: list[int]) -> None:
+        self._group = group
+        idx = ring.index(dist.get_rank())
+        self._next = ring[(idx + 1) % len(ring)]
+        self._prev = ring[(idx - 1) % len(ring)]
+        self._tasks = []
+
+    def send_recv(self, tensors: list[Tensor]) -> list[Tensor]:
+        assert not self._tasks, "The last send_recv is not waited."
+        buffers = [paddle.empty_like(tensor) for tensor in tensors]
+        ops = []
+        for tensor, buffer in zip(tensors, buffers):
+            ops.append(dist.P2POp(dist.isend, tensor, self._next, self._group))
+            ops.append(dist.P2POp(dist.irecv, buffer, self._prev, self._group))
+        self._tasks = dist.batch_isend_irecv(ops)
+        return buffers
+
+    def wait(self) -> None:
+        for task in self._tasks:
+            task.wait()
+        self._tasks = []
+
+
+def _per_token(lse: Tensor, seqlen: int) -> Tensor:
+    # [batch, heads, seqlen_rounded] -> [batch, seqlen, heads, 1]
+    return lse[:, :, :seqlen].transpose([0, 2, 1]).unsqueeze(-1)
+
+
+def _merge_block(
+    out: Tensor | None,
+    lse: Tensor | None,
+    block_out: Tensor,
+    block_lse: Tensor,
+) -> tuple[Tensor, Tensor]:
+    # out = (exp(lse) * out + exp(block_lse) * block_out) / exp(new_lse), in
+    # the form which does not overflow.
+    block_out = block_out.astype('float32')
+    if out is None:
+        return block_out, block_lse
+    diff = block_lse - lse
+    out = out - F.sigmoid(_per_token(diff, out.shape[1])) * (out - block_out)
+    lse = lse - F.log_sigmoid(-diff)
+    return out, lse
+
+
+def _is_computed(idx: int, src: int, causal: bool) -> bool:
+    # With causal, the query block idx only attends to the key blocks which
+    # are not after it.
+    return not causal or src <= idx
+
+
+def _ring_flash_attn_forward(group, ring, query, key, value, causal):
+    nranks = len(ring)
+    idx = ring.index(dist.get_rank())
+    comm = _RingCommunicator(group, ring)
+    out, lse, seed_offset = None, None, None
+    for step in range(nranks):
+        if step + 1 < nranks:
+            next_key, next_value = comm.send_recv([key, value])
+        src = (idx - step) % nranks
+        if _is_computed(idx, src, causal):
+            block_out, _, block_lse, block_seed_offset = _C_ops.flash_attn(
+                query,
+                key,
+                value,
+                None,
+                None,
+                0.0,
+                causal and src == idx,
+                False,
+                False,
+                "",
+            )
+            out, lse = _merge_block(out, lse, block_out, block_lse)
+            if seed_offset is None:
+                seed_offset = block_seed_offset
+        if step + 1 < nranks:
+            comm.wait()
+            key, value = next_key, next_value
+    return out.astype(query.dtype), lse, seed_offset
+
+
+def _ring_flash_attn_backward(
+    group, ring, out_grad, query, key, value, out, lse, seed_offset, causal
+):
+    # The gradients of a key block are accumulated on the ranks it passes
+    # by, and travel with it, so that they are back on its rank after the
+    # last step.
+    nranks = len(ring)
+    idx = ring.index(dist.get_rank())
+    kv_comm = _RingCommunicator(group, ring)
+    grad_comm = _RingCommunicator(group, ring)
+    query_grad, key_grad, value_grad = None, None, None
+    for step in range(nranks):
+        if step + 1 < nranks:
+            next_key, next_value = kv_comm.send_recv([key, value])
+        src = (idx - step) % nranks
+        block_key_grad, block_value_grad = None, None
+        if _is_computed(idx, src, causal):
+            block_query_grad, block_key_grad, block_value_grad = (
+                _C_ops.flash_attn_grad(
+                    query,
+                    key,
+                    value,
+                    out,
+                    lse,
+                    seed_offset,
+                    None,
+                    out_grad,
+                    0.0,
+                    causal and src == idx,
+                )
+            )
+            block_query_grad = block_query_grad.astype('float32')
+            if query_grad is None:
+                query_grad = block_query_grad
+            else:
+                query_grad = query_grad + block_query_grad
+        if step > 0:
+            grad_comm.wait()
+            key_grad, value_grad = next_key_grad, next_value_grad
+        if block_key_grad is not None:
+            block_key_grad = block_key_grad.astype('float32')
+            block_value_grad = block_value_grad.astype('float32')
+            if key_grad is None:
+                key_grad, value_grad = block_key_grad, block_value_grad
+            else:
+                key_grad = key_grad + block_key_grad
+                value_grad = value_grad + block_value_grad
+        next_key_grad, next_value_grad = grad_comm.send_recv(
+            [key_grad, value_grad]
+        )
+        if step + 1 < nranks:
+            kv_comm.wait()
+            key, value = next_key, next_value
+    grad_comm.wait()
+    return (
+        query_grad.astype(query.dtype),
+        next_key_grad.astype(key.dtype),
+        next_value_grad.astype(value.dtype),
+    )
+
+
+class RingFlashAttention(PyLayer):
+    """
+    The flash attention of the query, key and value sharded along the
+    sequence over the ranks of a ring, in the order of the ring. The key and
+    value blocks are rotated around the ring, the sends and receives of the
+    next blocks overlapping the flash attention of the current ones, and the
+    partial outputs are merged by their log-sum-exp.
+
+    The inputs are either dense tensors, the local blocks of the ring of
+    ``group``, or dist tensors of the same placements, sharded along the
+    sequence on one mesh axis, whose ring is given by ``ring``.
+    """
+
+    @staticmethod
+    def forward(ctx, query, key, value, group, ring, causal=False):
+        ctx.dist_attrs = None
+        if query.is_dist():
+            ctx.dist_attrs = [
+                (tensor.process_mesh, tensor.placements)
+                for tensor in (query, key, value)
+            ]
+            query, key, value = (
+                tensor._local_value() for tensor in (query, key, value)
+            )
+        out, lse, seed_offset = _ring_flash_attn_forward(
+            group, ring, query, key, value, causal
+        )
+        ctx.save_for_backward(query, key, value, out, lse, seed_offset)
+        ctx.group = group
+        ctx.ring = ring
+        ctx.causal = causal
+        if ctx.dist_attrs is not None:
+            out = dtensor_from_local(out, *ctx.dist_attrs[0])
+        return out
+
+    @staticmethod
+    def backward(ctx, out_grad):
+        query, key, value, out, lse, seed_offset = ctx.saved_tensor()
+        if ctx.dist_attrs is not None:
+            mesh, placements = ctx.dist_attrs[0]
+            if out_grad.placements != placements:
+                out_grad = dist.reshard(out_grad, mesh, placements)
+            out_grad = out_grad._local_value()
+        grads = _ring_flash_attn_backward(
+            ctx.group,
+            ctx.ring,
+            out_grad,
+            query,
+            key,
+            value,
+            out,
+            lse,
+            seed_offset,
+            ctx.causal,
+        )
+        if ctx.dist_attrs is not None:
+            grads = tuple(
+                dtensor_from_local(grad, *dist_attr)
+                for grad, dist_attr in zip(grads, ctx.dist_attrs)
+            )
+        return grads
+
+
+def _get_ring_group(mesh: ProcessMesh, axis: int) -> tuple[Group, list[int]]:
+    # All the ranks of the mesh create the groups of all the rings along the
+    # axis, in the same order.
+    key = (tuple(mesh.process_ids), tuple(mesh.shape), axis)
+    if key not in _g_ring_groups:
+        ids = np.array(mesh.process_ids).reshape(mesh.shape)
+        rings = np.moveaxis(ids, axis, -1).reshape([-1, mesh.shape[axis]])
+        for ring in rings.tolist():
+            group = dist.new_group(ring)
+            if dist.get_rank() in ring:
+                _g_ring_groups[key] = (group, ring)
+    return _g_ring_groups[key]
+
+
+def ring_flash_attention(
+    query: Tensor,
+    key: Tensor,
+    value: Tensor,
+    causal: bool = False,
+    group: Group | None = None,
+) -> Tensor:
+    """
+    The flash attention of sequences too long for one device, whose query,
+    key and value are sharded along the sequence across the ranks of a
+    process group. Each rank computes the attention of its query block to
+    the key and value blocks, which are passed around the ranks in a ring.
+
+    Args:
+        query (Tensor): The query, of the shape [batch_size, seqlen,
+            num_heads, head_dim], whose dtype is float16 or bfloat16.
+        key (Tensor): The key, of the shape [batch_size, seqlen,
+            num_kv_heads, head_dim].
+        value (Tensor): The value, of the same shape as key.
+        causal (bool, optional): Whether each token only attends to the
+            tokens not after it. Default: False.
+        group (Group|None, optional): The group of the ranks whose local
+            blocks of the sequence are given, in the order of the ranks of
+            the group. Default: None, for the global group. Must be None for
+            dist tensors, which are sharded along the sequence (dim 1) on
+            one axis of their mesh, and whose ring is along that axis.
+
+    Returns:
+        Tensor, the output of the shape [batch_size, seqlen, num_heads,
+        head_dim], sharded as query.
+
+    Note:
+        With causal, the blocks are not balanced: the rank of the last
+        query block computes the attention to all the key blocks, the rank
+        of the first one only to its own.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:DISTRIBUTED)
+            >>> import paddle
+            >>> import paddle.distributed as dist
+            >>> from paddle.distributed.auto_parallel.ring_attention import (
+            ...     ring_flash_attention,
+            ... )
+
+            >>> mesh = dist.ProcessMesh([0, 1], dim_names=["sep"])
+            >>> q = paddle.randn([1, 8192, 8, 128]).astype('bfloat16')
+            >>> q = dist.shard_tensor(q, mesh, [dist.Shard(1)])
+            >>> k = dist.shard_tensor(q.clone(), mesh, [dist.Shard(1)])
+            >>> v = dist.shard_tensor(q.clone(), mesh, [dist.Shard(1)])
+            >>> out = ring_flash_attention(q, k, v, causal=True)
+    """
+    if query.is_dist():
+        assert group is None, "The group of dist tensors is their mesh axis."
+        placements = query.placements
+        for tensor in (key, value):
+            assert (
+                tensor.is_dist()
+                and tensor.process_mesh == query.process_mesh
+                and tensor.placements == placements
+            ), "The query, key and value should have the same placements."
+        seq_axes = [
+            axis
+            for axis, placement in enumerate(placements)
+            if placement.is_shard() and placement.get_dim() == 1
+        ]
+        assert (
+            len(seq_axes) == 1
+        ), f"The sequence should be sharded on one mesh axis, got {placements}."
+        assert not any(
+            placement.is_partial() for placement in placements
+        ), "The query, key and value should not be partial."
+        group, ring = _get_ring_group(query.process_mesh, seq_axes[0])
+    else:
+        if group is None:
+            group = _get_global_group()
+        ring = list(group.ranks)
+    return RingFlashAttention.apply(query, key, value, group, ring, causal)
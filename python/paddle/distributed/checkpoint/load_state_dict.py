@@ -16,9 +16,12 @@ from __future__ import annotations
 
 import copy
 import os
+from concurrent.futures import ThreadPoolExecutor, as_completed
 from dataclasses import dataclass
 from typing import TYPE_CHECKING
 
+import numpy as np
+
 import paddle
 from paddle.base.framework import (
     _current_expected_place,
@@ -470,6 +473,7 @@ def load_state_dict(
     process_group: Group | None = None,
     coordinator_rank: int = 0,
     offload=False,
+    direct_read=False,
 ) -> None:
     """
     Load the state_dict inplace from a checkpoint path.
@@ -480,6 +484,7 @@ def load_state_dict(
         process_group(paddle.distributed.collective.Group): ProcessGroup to be used for cross-rank synchronization. Use the default process group which contains all cards.
         coordinator_rank(int): The rank used to coordinate the checkpoint. Rank0 is used by default.
         offload(bool): Whether to offload the checkpoint data from GPU to CPU.
+        direct_read(bool): Whether each rank reads the slices of its local tensors from the checkpoint files itself, with a thread per file, instead of receiving them from the rank loading the file. Only the slices are copied to the device, and no broadcast is needed, which suits loading on a different process mesh or placements from a shared file system. It falls back to the default loading if a rank can not access all the files it needs. False by default.
     Example:
         .. code-block:: python
 
@@ -561,6 +566,15 @@ def load_state_dict(
         for d in global_local_data_files:
             rank_to_local_data_files.update(d)
 
+        if direct_read and all(
+            set(files) <= set(rank_to_local_data_files.get(rank, []))
+            for rank, files in rank_to_files.items()
+        ):
+            _direct_load_state_dict(flat_state_dict, path, metadata_list)
+            if use_dist:
+                paddle.distributed.barrier(process_group)
+            return
+
         local_load_files = get_rank_to_read_files(
             rank_to_files, rank_to_local_data_files
         )
@@ -588,6 +602,80 @@ def load_state_dict(
         )
 
 
+def _direct_load_state_dict(
+    target_state_dict, path, metadata_list, max_workers=8
+) -> None:
+    # Each rank reads the slices its local tensors overlap from the files, and
+    # copies them to its local tensors without any collective.
+    storage_files = {}
+    for metadata in metadata_list:
+        storage_files.update(metadata.storage_metadata)
+    read_items = get_read_items(
+        metadata_list, target_state_dict, None, use_dist=False
+    )
+    file_to_read_items = {}
+    for item in read_items:
+        file_name = storage_files[item.local_tensor_index]
+        file_to_read_items.setdefault(file_name, []).append(item)
+
+    def read_file(file_name):
+        storage_state_dict = paddle.load(
+            os.path.join(path, file_name), return_numpy=True
+        )
+        chunks = []
+        for item in file_to_read_items[file_name]:
+            storage_local_tensor = storage_state_dict[
+                item.local_tensor_index.tensor_key
+            ]
+            index = tuple(
+                slice(offset, offset + length)
+                for offset, length in zip(item.storage_offset, item.lengths)
+            )
+            # Copy the slice out, so that the file is released once read.
+            chunks.append((item, np.array(storage_local_tensor[index])))
+        return chunks
+
+    use_dist = True if paddle.distributed.get_world_size() > 1 else False
+    with ThreadPoolExecutor(
+        max_workers=max(1, min(max_workers, len(file_to_read_items)))
+    ) as executor:
+        futures = [
+            executor.submit(read_file, file_name)
+            for file_name in file_to_read_items
+        ]
+        for future in as_completed(futures):
+            for item, chunk in future.result():
+                logger.debug(f"direct read item: {item}")
+                cur_tensor = target_state_dict[
+                    item.local_tensor_index.tensor_key
+                ]
+                cur_local_tensor = (
+                    cur_tensor._local_value()
+                    if use_dist and cur_tensor.is_dist()
+                    else cur_tensor
+                )
+                cur_ends = [
+                    cur_offset + cur_length
+                    for cur_offset, cur_length in zip(
+                        item.cur_offset, item.lengths
+                    )
+                ]
+                # The cur_chunk_tensor shares the memory of cur_local_tensor.
+                if len(item.lengths) > 0:
+                    cur_chunk_tensor = paddle.slice(
+                        cur_local_tensor,
+                        list(range(len(item.lengths))),
+                        item.cur_offset,
+                        cur_ends,
+                    )
+                else:
+                    cur_chunk_tensor = cur_local_tensor
+                paddle.assign(
+                    paddle.to_tensor(chunk, place=cur_local_tensor.place),
+                    cur_chunk_tensor,
+                )
+
+
 def _load_state_dict(
     target_state_dict,
     source_state_dict,
@@ -680,7 +768,7 @@ def _load_state_dict(
                     cur_offset + cur_length
                     for cur_offset, cur_length in zip(cur_offsets, cur_lengths)
                 ]
-                # The cur_chunk_tensor and cur_local_tensor share the same memory.
+                # The cur_chunk_tensor shares the memory of cur_local_tensor.
                 if len(cur_lengths) > 0:
                     cur_chunk_tensor = paddle.slice(
                         cur_local_tensor,
@@ -0,0 +1,287 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+import os
+import pickle
+from typing import TYPE_CHECKING
+
+import paddle
+import paddle.distributed as dist
+from paddle.distributed.communication.group import _get_global_group
+from paddle.distributed.fleet.utils.log_util import logger
+from paddle.framework import core
+
+from .save_state_dict import snapshot_to_host
+from .utils import flatten_state_dict
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+    from paddle.distributed.collective import Group
+
+_KEY_PREFIX = "peer_memory_checkpoint"
+
+
+def _local_tensors(state_dict):
+    flat_state_dict, _ = flatten_state_dict(state_dict)
+    return {
+        key: value._local_value() if value.is_dist() else value
+        for key, value in flat_state_dict.items()
+    }
+
+
+def _to_device(tensor):
+    place = paddle.framework._current_expected_place()
+    return tensor._copy_to(place, False)
+
+
+class PeerMemoryCheckpoint:
+    """
+    Keeps the latest checkpoint of the local shards of a rank in its host
+    memory, and a replica of it in the host memory of a buddy rank, so that
+    the state of the ranks of a failed node is restored from their buddies
+    instead of the remote storage.
+
+    The buddy of a rank is the rank ``buddy_offset`` after it in the group,
+    by default the number of ranks of a node, so that a rank and its buddy
+    are not on the same node. The replicas are sent by the P2P ops of the
+    group, which must be NCCL, overlapping the training until ``wait``.
+    Until then, the sent shards and the received replica take device
+    memory.
+
+    Only the latest checkpoint is kept. All the ranks of the group should
+    call ``save`` on the same steps, and ``restore`` together, the ranks
+    which replace the failed ones included.
+
+    Args:
+        process_group (Group|None, optional): The group of the ranks.
+            Default: None, for the global group.
+        buddy_offset (int|None, optional): The offset of the buddy of a rank
+            in the group. Default: None, for the env PADDLE_LOCAL_SIZE.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:DISTRIBUTED)
+            >>> import paddle
+            >>> import paddle.distributed as dist
+            >>> from paddle.distributed.checkpoint.peer_memory_checkpoint import (
+            ...     PeerMemoryCheckpoint,
+            ... )
+
+            >>> dist.init_parallel_env()
+            >>> model = paddle.nn.Linear(8, 8)
+            >>> ckpt = PeerMemoryCheckpoint()
+            >>> ckpt.save(model.state_dict(), step=100)
+            >>> # after a failure, on all the ranks
+            >>> step = ckpt.restore(model.state_dict())
+    """
+
+    def __init__(
+        self,
+        process_group: Group | None = None,
+        buddy_offset: int | None = None,
+    ) -> None:
+        self._group = (
+            _get_global_group() if process_group is None else process_group
+        )
+        self._ranks = list(self._group.ranks)
+        self._rank = dist.get_rank()
+        nranks = len(self._ranks)
+        if buddy_offset is None:
+            buddy_offset = int(os.getenv("PADDLE_LOCAL_SIZE", "1"))
+        buddy_offset %= nranks
+        if buddy_offset == 0 and nranks > 1:
+            buddy_offset = 1
+        self._buddy_offset = buddy_offset
+        # The rank holding the replica of this rank, and the rank whose
+        # replica this rank holds.
+        self._buddy = self._buddy_of(self._rank)
+        self._replicated = self._ranks[
+            (self._ranks.index(self._rank) - buddy_offset) % nranks
+        ]
+        self._store = core.create_or_get_global_tcp_store()
+        # (step, host state dict)
+        self._own = None
+        self._replica = None
+        # (step, tasks, sent tensors, received keys, received tensors)
+        self._pending = None
+
+    def _buddy_of(self, rank):
+        idx = self._ranks.index(rank)
+        return self._ranks[(idx + self._buddy_offset) % len(self._ranks)]
+
+    def save(self, state_dict: dict[str, Tensor], step: int) -> None:
+        """
+        Copy the local shards of state_dict to the host memory of this rank
+        and start sending them to the buddy. The copies are done before the
+        kernels launched later, e.g. the optimizer, modify the tensors.
+
+        Args:
+            state_dict (dict[str, Tensor]): The state dict, maybe nested.
+            step (int): The step of the checkpoint.
+        """
+        self.wait()
+        tensors = _local_tensors(state_dict)
+        host_state_dict, _ = snapshot_to_host(tensors)
+        self._own = (step, host_state_dict)
+        if self._buddy == self._rank:
+            return
+
+        # The receiver allocates the replica by the shapes and dtypes of the
+        # shards of the sender, which are passed by the store.
+        keys = sorted(tensors)
+        meta = [
+            (key, tensors[key].shape, str(tensors[key].dtype).split(".")[-1])
+            for key in keys
+        ]
+        self._store.set(
+            f"{_KEY_PREFIX}/meta/{step}/{self._rank}", pickle.dumps(meta)
+        )
+        replicated_meta = pickle.loads(
+            self._store.get(f"{_KEY_PREFIX}/meta/{step}/{self._replicated}")
+        )
+        # The sent tensors are copies, as the training may modify the shards
+        # before the sends are done.
+        sent = [_to_device(tensors[key]).clone() for key in keys]
+        received = [
+            paddle.empty(shape, dtype=dtype)
+            for _, shape, dtype in replicated_meta
+        ]
+        ops = [
+            dist.P2POp(dist.isend, tensor, self._buddy, self._group)
+            for tensor in sent
+        ] + [
+            dist.P2POp(dist.irecv, tensor, self._replicated, self._group)
+            for tensor in received
+        ]
+        tasks = dist.batch_isend_irecv(ops)
+        self._pending = (
+            step,
+            tasks,
+            sent,
+            [key for key, _, _ in replicated_meta],
+            received,
+        )
+
+    def wait(self) -> None:
+        """
+        Wait for the sends and receives of the last save, and move the
+        received replica to the host memory.
+        """
+        if self._pending is None:
+            return
+        step, tasks, _, keys, received = self._pending
+        for task in tasks:
+            task.wait()
+        host_state_dict, _ = snapshot_to_host(dict(zip(keys, received)))
+        self._replica = (step, host_state_dict)
+        self._pending = None
+
+    def _restorable_step(self, records):
+        # The latest step of which the shards of each rank are on it or on
+        # its buddy.
+        steps = sorted(
+            {step for record in records.values() for step in record},
+            reverse=True,
+        )
+        for step in steps:
+            if step >= 0 and all(
+                records[rank][0] == step
+                or records[self._buddy_of(rank)][1] == step
+                for rank in self._ranks
+            ):
+                return step
+        return None
+
+    def restore(self, state_dict: dict[str, Tensor]) -> int | None:
+        """
+        Restore the local shards of state_dict from the latest checkpoint
+        kept by the ranks, either on this rank or on its buddy. The ranks
+        agree on the checkpoint through the TCPStore.
+
+        Args:
+            state_dict (dict[str, Tensor]): The state dict to restore in
+                place, of the same keys, shapes and dtypes as the saved one.
+
+        Returns:
+            int|None, the step of the restored checkpoint, or None if no
+            checkpoint is kept for all the ranks, when nothing is restored.
+        """
+        self.wait()
+        # The ranks which replace the failed ones do not know how many
+        # restores are done, so that the keys of each restore are numbered
+        # by the store.
+        nranks = len(self._ranks)
+        calls = self._store.add(f"{_KEY_PREFIX}/restore_calls", 1)
+        prefix = f"{_KEY_PREFIX}/restore/{(calls - 1) // nranks}"
+        own_step = -1 if self._own is None else self._own[0]
+        replica_step = -1 if self._replica is None else self._replica[0]
+        self._store.set(
+            f"{prefix}/{self._rank}", pickle.dumps((own_step, replica_step))
+        )
+        records = {
+            rank: pickle.loads(self._store.get(f"{prefix}/{rank}"))
+            for rank in self._ranks
+        }
+        step = self._restorable_step(records)
+        if step is None:
+            logger.warning(
+                "No in-memory checkpoint is kept for all the ranks: "
+                f"{records}."
+            )
+            return None
+
+        tensors = _local_tensors(state_dict)
+        keys = sorted(tensors)
+        ops = []
+        received = None
+        if records[self._rank][0] != step:
+            received = [
+                paddle.empty(tensors[key].shape, dtype=tensors[key].dtype)
+                for key in keys
+            ]
+            ops += [
+                dist.P2POp(dist.irecv, tensor, self._buddy, self._group)
+                for tensor in received
+            ]
+        if (
+            self._replicated != self._rank
+            and records[self._replicated][0] != step
+        ):
+            replica = self._replica[1]
+            ops += [
+                dist.P2POp(
+                    dist.isend,
+                    _to_device(replica[key]),
+                    self._replicated,
+                    self._group,
+                )
+                for key in sorted(replica)
+            ]
+        if ops:
+            for task in dist.batch_isend_irecv(ops):
+                task.wait()
+
+        if received is None:
+            values = self._own[1]
+        else:
+            values = dict(zip(keys, received))
+        for key in keys:
+            paddle.assign(
+                values[key]._copy_to(tensors[key].place, False), tensors[key]
+            )
+        if received is not None:
+            self._own = (step, snapshot_to_host(tensors)[0])
+        return step
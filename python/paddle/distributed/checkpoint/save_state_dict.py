@@ -13,9 +13,8 @@
 # limitations under the License.
 from __future__ import annotations
 
-import multiprocessing
 import os
-import time
+import threading
 from typing import TYPE_CHECKING
 
 import paddle
@@ -60,6 +59,72 @@ def clear_async_save_task_queue():
             check_exitcode(task)
 
 
+class AsyncSaveTask(threading.Thread):
+    """
+    Write a state_dict snapshot to path in the background, once its copies
+    to the host are done. The file is written under a temporary name and
+    renamed, so that a checkpoint never holds a partially written file.
+    """
+
+    def __init__(self, state_dict, path, event=None):
+        super().__init__(name=f"async_save:{os.path.basename(path)}")
+        self.state_dict = state_dict
+        self.path = path
+        self.event = event
+        # 0 once written, as the exitcode of a process.
+        self.exitcode = None
+
+    def run(self):
+        try:
+            if self.event is not None:
+                self.event.synchronize()
+            tmp_path = self.path + ".tmp"
+            paddle.save(self.state_dict, tmp_path)
+            os.replace(tmp_path, self.path)
+            self.exitcode = 0
+        except Exception as e:
+            logger.error(f"Error: save ckpt to {self.path} failed: {e}")
+            self.exitcode = 1
+
+
+def snapshot_to_host(state_dict):
+    """
+    Copy the tensors of state_dict to the host without waiting for the copies.
+    The copies from GPU run on a side stream into pinned memory, and the
+    current stream waits for them, so that the kernels launched later, e.g.
+    the optimizer updating the parameters in place, run after the copies.
+
+    Returns the copies and the event recorded after them, which is None when
+    no tensor is on GPU.
+    """
+    gpu_keys = {
+        key
+        for key, value in state_dict.items()
+        if isinstance(value, paddle.Tensor) and value.place.is_gpu_place()
+    }
+    host_state_dict = {}
+    for key, value in state_dict.items():
+        if key in gpu_keys:
+            continue
+        if isinstance(value, paddle.Tensor):
+            value = value._copy_to(paddle.CPUPlace(), True)
+        host_state_dict[key] = value
+    if not gpu_keys:
+        return host_state_dict, None
+
+    current_stream = paddle.device.current_stream()
+    copy_stream = paddle.device.Stream()
+    copy_stream.wait_stream(current_stream)
+    with paddle.device.stream_guard(copy_stream):
+        for key in gpu_keys:
+            host_state_dict[key] = state_dict[key]._copy_to(
+                paddle.CUDAPinnedPlace(), False
+            )
+    event = copy_stream.record_event()
+    current_stream.wait_event(event)
+    return host_state_dict, event
+
+
 def copy_dict_to_cpu(nested_dict):
     """
     Copy the paddle.Tensor objects in the nested dictionary to the CPU and return a new dict.
@@ -157,7 +222,10 @@ def save_state_dict(
         path(str): The directory to save state_dict.
         process_group(paddle.distributed.collective.Group): ProcessGroup to be used for cross-rank synchronization. Use the default process group which contains all cards.
         coordinator_rank(int): The rank used to save non distributed values. Rank0 is used by default.
-        async_save(bool): Async save the state_dict, default is False.
+        async_save(bool): Async save the state_dict, default is False. The
+            tensors are copied to the host on a side stream, and written by a
+            background thread, so that the training goes on during the save.
+            Call clear_async_save_task_queue to wait for the writes.
 
     Examples:
         .. code-block:: python
@@ -282,30 +350,14 @@ def save_state_dict(
         )
 
         if async_save:
-            cpu_state_dict = copy_dict_to_cpu(local_state_dict)
+            # The previous save still owns its pinned copies, wait for it
+            # before taking more.
             clear_async_save_task_queue()
-
-            attempt = 0
-            ctx = multiprocessing.get_context("spawn")
-
-            def start_process():
-                nonlocal attempt
-                try:
-                    p = ctx.Process(
-                        target=paddle.save,
-                        args=(cpu_state_dict, os.path.join(path, file_name)),
-                    )
-                    p.start()
-                    return p
-                except Exception as e:
-                    logger.error(
-                        f"Attempt {attempt + 1} failed with error: {e}"
-                    )
-                    attempt += 1
-                    time.sleep(1)
-                    return start_process()
-
-            p = start_process()
-            async_save_queue.append(p)
+            host_state_dict, event = snapshot_to_host(local_state_dict)
+            task = AsyncSaveTask(
+                host_state_dict, os.path.join(path, file_name), event
+            )
+            task.start()
+            async_save_queue.append(task)
         else:
             paddle.save(local_state_dict, os.path.join(path, file_name))
@@ -180,6 +180,21 @@ def _new_process_group_impl(
     return pg
 
 
+def _use_nccl_comm_split():
+    return (
+        core.is_compiled_with_nccl()
+        and paddle.get_flags("FLAGS_nccl_comm_split")["FLAGS_nccl_comm_split"]
+        and core.CommContextManager.is_nccl_comm_split_supported()
+    )
+
+
+def _split_nccl_comm(parent_group, gid, rank_in_group):
+    # All the ranks of the parent group take part in the split, the ones out
+    # of the new group with a negative rank. The process group of the new
+    # group finds its communicator created on its first use.
+    parent_group.process_group.split_comm(gid, rank_in_group)
+
+
 # _custom_gid provides a way for users to
 # set the group id, which is usually useful
 # to be compatible with the static graph mode.
@@ -240,6 +255,12 @@ def new_group(
             )
         size = len(ranks)
         ranks = sorted(ranks)
+        if backend == 'nccl' and size > 1 and _use_nccl_comm_split():
+            _split_nccl_comm(
+                global_group,
+                gid,
+                ranks.index(global_rank) if global_rank in ranks else -1,
+            )
         if size > 1 and global_rank in ranks:
             rank = 0 if backend == 'heter' else ranks.index(global_rank)
             pg = _new_process_group_impl(
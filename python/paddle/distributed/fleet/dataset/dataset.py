@@ -1165,6 +1165,77 @@ class InMemoryDataset(DatasetBase):
         if fleet is not None:
             fleet._role_maker.barrier_worker()
 
+    def streaming_global_shuffle(
+        self,
+        fleet: Fleet | None = None,
+        thread_num: int = 12,
+        buffer_size: int = 1000000,
+    ) -> None:
+        """
+        :api_attr: Static Graph
+
+        Load data into memory and global shuffle it at the same time, instead
+        of load_into_memory followed by global_shuffle. The records are
+        shuffled through buffers of buffer_size records in all as they are
+        read, and sent to the other trainers by windows of
+        fleet_send_batch_size records, so the whole data is never held twice
+        in memory. The larger the buffers, the closer the shuffle is to
+        global_shuffle.
+
+        Examples:
+            .. code-block:: python
+
+                >>> # doctest: +SKIP('No files to read')
+                >>> import paddle
+                >>> paddle.enable_static()
+
+                >>> dataset = paddle.distributed.InMemoryDataset()
+                >>> slots = ["slot1", "slot2", "slot3", "slot4"]
+                >>> slots_vars = []
+                >>> for slot in slots:
+                ...     var = paddle.static.data(
+                ...         name=slot, shape=[None, 1], dtype="int64", lod_level=1)
+                ...     slots_vars.append(var)
+                >>> dataset.init(
+                ...     batch_size=1,
+                ...     thread_num=2,
+                ...     input_type=1,
+                ...     pipe_command="cat",
+                ...     use_var=slots_vars)
+                >>> filelist = ["a.txt", "b.txt"]
+                >>> dataset.set_filelist(filelist)
+                >>> dataset.streaming_global_shuffle(buffer_size=100000)
+
+        Args:
+            fleet(Fleet): fleet singleton. Default None.
+            thread_num(int): shuffle thread num. Default is 12.
+            buffer_size(int): records held in the shuffle buffers of a
+                trainer. Default is 1000000.
+
+        """
+        self._prepare_to_run()
+        trainer_num = 1
+        if fleet is not None:
+            fleet._role_maker.barrier_worker()
+            trainer_num = fleet.worker_num()
+        if self.fleet_send_batch_size is None:
+            self.fleet_send_batch_size = 1024
+        if self.fleet_send_sleep_seconds is None:
+            self.fleet_send_sleep_seconds = 0
+        self.dataset.register_client2client_msg_handler()
+        self.dataset.set_trainer_num(trainer_num)
+        self.dataset.set_fleet_send_batch_size(self.fleet_send_batch_size)
+        self.dataset.set_fleet_send_sleep_seconds(self.fleet_send_sleep_seconds)
+        if fleet is not None:
+            fleet._role_maker.barrier_worker()
+        self.dataset.streaming_global_shuffle(thread_num, buffer_size)
+        if fleet is not None:
+            fleet._role_maker.barrier_worker()
+        if self.merge_by_lineid:
+            self.dataset.merge_by_lineid()
+        if fleet is not None:
+            fleet._role_maker.barrier_worker()
+
     def release_memory(self) -> None:
         """
         :api_attr: Static Graph
@@ -1416,6 +1487,36 @@ class QueueDataset(DatasetBase):
         """
         super().init(**kwargs)
 
+    def _set_reader_autoscale(
+        self, min_reader_num, max_reader_num, interval_ms=1000
+    ):
+        """
+        Let only min_reader_num to max_reader_num of the readers parse at
+        once. Every interval_ms one more reader is let in while the queues
+        between the readers and the trainer threads are less than a quarter
+        full, and one less while they are more than three quarters full.
+        The queue depth, capacity and active reader num are exported as the
+        int stats STAT_dataset_reader_queue_size,
+        STAT_dataset_reader_queue_capacity and STAT_dataset_active_reader_num.
+
+        Examples:
+            .. code-block:: python
+
+                >>> import paddle
+                >>> paddle.enable_static()
+                >>> dataset = paddle.distributed.QueueDataset()
+                >>> dataset._set_reader_autoscale(2, 8)
+
+        Args:
+            min_reader_num(int): the least readers that parse at once
+            max_reader_num(int): the most readers that parse at once, 0 to
+                let all of them parse
+            interval_ms(int): how often the queues are sampled, default 1000
+        """
+        self.dataset.set_reader_autoscale(
+            min_reader_num, max_reader_num, interval_ms
+        )
+
     def _prepare_to_run(self):
         """
         Set data_feed_desc/thread num/filelist before run,
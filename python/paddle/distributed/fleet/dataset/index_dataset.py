@@ -37,6 +37,7 @@ class TreeIndex(Index):
         self._total_node_nums = self._tree.total_node_nums()
         self._emb_size = self._tree.emb_size()
         self._layerwise_sampler = None
+        self._beam_search_sampler = None
 
     def height(self) -> int:
         return self._height
@@ -102,3 +103,17 @@ class TreeIndex(Index):
         return self._layerwise_sampler.sample(
             user_input, index_input, with_hierarchy
         )
+
+    def init_beam_search(
+        self, beam_size: int, node_embs: list[float], emb_dim: int
+    ) -> None:
+        self._beam_search_sampler = core.IndexSampler(
+            "by_layerwise", self._name
+        )
+        self._beam_search_sampler.init_beamsearch_conf(beam_size)
+        self._beam_search_sampler.set_beamsearch_embedding(node_embs, emb_dim)
+
+    def beam_search(self, user_embs: list[list[float]]) -> list[list[int]]:
+        if self._beam_search_sampler is None:
+            raise ValueError("please init beam_search first.")
+        return self._beam_search_sampler.beam_search(user_embs)
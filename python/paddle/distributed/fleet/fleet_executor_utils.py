@@ -16,6 +16,9 @@ from paddle.distributed.fleet.meta_optimizers.common import OP_ROLE_KEY, OpRole
 from paddle.framework import core
 from paddle.static import Program
 
+# The ops sending the grads of the backward to the previous stage.
+_SEND_OP_TYPES = ("send_v2", "partial_send")
+
 
 class TaskNode:
     """
@@ -229,14 +232,23 @@ class CoordSys:
 
 class FleetExecutorUtils:
     def __init__(
-        self, dist_strategy=None, rank=None, nrank=None, max_run_times=None
+        self,
+        dist_strategy=None,
+        rank=None,
+        nrank=None,
+        max_run_times=None,
+        zero_bubble=False,
     ):
         self.dist_strategy = dist_strategy
         self.rank = rank
         self.nrank = nrank
         self.max_run_times = max_run_times
         self.is_auto_parallel = True if dist_strategy is None else False
-        self.num_of_functionality = 4
+        # With zero bubble, the backward is split into the ops computing the
+        # grads sent to the previous stage, and the ops computing the weight
+        # grads, which run in a fifth task node after them.
+        self.zero_bubble = zero_bubble
+        self.num_of_functionality = 5 if zero_bubble else 4
         self.coord_sys = None
         self.coord = None
         if dist_strategy:
@@ -276,16 +288,50 @@ class FleetExecutorUtils:
                 raise "The op role: " + str(
                     op_role
                 ) + " isn't one of LRSched, Forward, Backward or Optimizer."
+        if self.zero_bubble:
+            input_grad_ops, weight_grad_ops = self.split_weight_grad_ops(
+                op_list_map["bwd"]
+            )
+            op_list_map["bwd"] = input_grad_ops
+            op_list_map["bwd_w"] = weight_grad_ops
         return op_list_map
 
+    def split_weight_grad_ops(self, bwd_ops):
+        """
+        Split the backward ops into the ops the sends to the previous stage
+        depend on, which compute the input grads, and the others, which
+        compute the weight grads and can run after the grads are sent.
+        An op stays with the input grads if it has no output, or if a later
+        input grad op writes one of its vars, so that running the weight
+        grad ops last reads and writes the same values.
+        :param bwd_ops (list): The backward ops in program order.
+        :return:
+            input_grad_ops (list), weight_grad_ops (list)
+        """
+        needed_vars = set()
+        written_vars = set()
+        is_input_grad = []
+        for op in reversed(bwd_ops):
+            inputs = set(op.input_arg_names)
+            outputs = set(op.output_arg_names)
+            input_grad = (
+                op.type in _SEND_OP_TYPES
+                or not outputs
+                or not outputs.isdisjoint(needed_vars)
+                or not (inputs | outputs).isdisjoint(written_vars)
+            )
+            if input_grad:
+                needed_vars |= inputs
+                written_vars |= outputs
+            is_input_grad.append(input_grad)
+        is_input_grad.reverse()
+        input_grad_ops = [op for op, b in zip(bwd_ops, is_input_grad) if b]
+        weight_grad_ops = [op for op, b in zip(bwd_ops, is_input_grad) if not b]
+        return input_grad_ops, weight_grad_ops
+
     def convert_op_list_to_program(self, op_list, complete_program):
         # TODO(liyurui): Complete this convert logic
-        program_map = {
-            "lr": Program(),
-            "fwd": Program(),
-            "bwd": Program(),
-            "opt": Program(),
-        }
+        program_map = {key: Program() for key in op_list}
         return program_map
 
     def build_1f1b_dependency(self, task_node_map):
@@ -308,8 +354,15 @@ class FleetExecutorUtils:
         task_node_map["fwd"].add_upstream_task(cur_start_id)
         task_node_map["fwd"].add_downstream_task(cur_start_id + 2, pp_buff_size)
         task_node_map["bwd"].add_upstream_task(cur_start_id + 1, pp_buff_size)
-        task_node_map["bwd"].add_downstream_task(cur_start_id + 3)
-        task_node_map["opt"].add_upstream_task(cur_start_id + 2)
+        if self.zero_bubble:
+            # backward -> weight grad -> (m:1)optimize
+            task_node_map["bwd"].add_downstream_task(cur_start_id + 4)
+            task_node_map["bwd_w"].add_upstream_task(cur_start_id + 2)
+            task_node_map["bwd_w"].add_downstream_task(cur_start_id + 3)
+            task_node_map["opt"].add_upstream_task(cur_start_id + 4)
+        else:
+            task_node_map["bwd"].add_downstream_task(cur_start_id + 3)
+            task_node_map["opt"].add_upstream_task(cur_start_id + 2)
         # add dependency inter stage
         upstream_coord, downstream_coord = self.coord.copy(), self.coord.copy()
         upstream_coord['pp_idx'] = upstream_coord['pp_idx'] - 1
@@ -354,12 +407,20 @@ class FleetExecutorUtils:
             program=program_map["opt"],
             task_id=cur_start_id + 3,
         )
-        return {
+        task_node_map = {
             "lr": lr_task_node,
             "fwd": fwd_task_node,
             "bwd": bwd_task_node,
-            "opt": opt_task_node,
         }
+        if self.zero_bubble:
+            task_node_map["bwd_w"] = TaskNode(
+                rank=self.rank,
+                max_run_times=self.max_run_times,
+                program=program_map["bwd_w"],
+                task_id=cur_start_id + 4,
+            )
+        task_node_map["opt"] = opt_task_node
+        return task_node_map
 
     def task_id_to_rank(self):
         task_id_to_rank = {}
@@ -405,12 +466,24 @@ class FleetExecutorUtils:
         )
         opt_task_node.set_run_pre_steps(self.max_run_times)
         opt_task_node.set_run_at_offset(self.max_run_times - 1)
-        return {
+        task_node_map = {
             "lr": lr_task_node,
             "fwd": fwd_task_node,
             "bwd": bwd_task_node,
-            "opt": opt_task_node,
         }
+        if self.zero_bubble:
+            task_node_map["bwd_w"] = TaskNode(
+                rank=self.rank,
+                max_run_times=self.max_run_times,
+                role=int(OpRole.Backward),
+                ops=op_list_map["bwd_w"],
+                task_id=cur_start_id + 4,
+                node_type="Compute",
+            )
+        # The optimizer comes last, since the unused vars are analysed
+        # along the ops of the task nodes in order.
+        task_node_map["opt"] = opt_task_node
+        return task_node_map
 
 
 def run1f1b(
@@ -420,18 +493,22 @@ def run1f1b(
     dist_opt,
     nrank,
     with_standalone_executor=False,
+    zero_bubble=False,
 ):
     """
     Split the program to support 1f1b pipeline scheduler.
     This function will split the program based on the op_role.
     The program will be split into four parts: lr_sched, fwd, bwd, opt.
     And will create task nodes based on the four parts of the program.
+    With zero_bubble, the weight grad ops of bwd are split to a fifth part,
+    so that the grads are sent to the previous stage before they run.
     :param program: The origin program.
     :param rank: Current rank (can be got from fleet.worker_index()).
     :param max_run_times: Max run times for a micro batch. AKA number of micro steps.
     :param dist_opt: The fleet_opt configured by user.
     :param nrank: Number of workers (can be got from fleet.worker_num()).
     :param with_standalone_executor: Experiment feature, use fleet executor with standalone executor.
+    :param zero_bubble: Split the weight grads out of the backward.
     :return:
         task_nodes (list): four task nodes for current rank
         task_id_to_rank (dict): task nodes' ids to it's corresponding rank
@@ -442,6 +519,7 @@ def run1f1b(
         rank=rank,
         nrank=nrank,
         max_run_times=max_run_times,
+        zero_bubble=zero_bubble,
     )
     op_list_map = fleet_executor_utils.split_program_to_op_list(program)
     task_node_map = None
@@ -453,7 +531,7 @@ def run1f1b(
             program_map
         )
     else:
-        op_desc_list_map = {"lr": [], "fwd": [], "bwd": [], "opt": []}
+        op_desc_list_map = {key: [] for key in op_list_map}
         for key in op_list_map:
             for op in op_list_map[key]:
                 op_desc_list_map[key].append(op.desc)
@@ -245,6 +245,16 @@ class DataParallel(Layer):
         last_comm_buffer_size(float, optional): It limits memory size(MB) of last buffer in communication
                                          calling. Making the last communication buffer size small is useful to
                                          improve performance. Default: 1.
+        first_comm_buffer_size(float, optional): After the first backward, the buffers are rebuilt
+                                         in the order the gradients were ready. If it is positive, it
+                                         limits memory size(MB) of the first buffer ready instead of the
+                                         last one, so that its communication starts while the gradients
+                                         of the next buffers are still computed. Default: 0.
+        grad_as_bucket_view(bool, optional): Whether the gradients of the dense parameters are views
+                                         of the communication buffers, laid out in the order of the
+                                         buffers. After the first backward they are accumulated in the
+                                         buffers directly, which saves the memory and the copies of the
+                                         gradients in and out of the buffers. Default: False.
         find_unused_parameters(bool, optional): Whether to traverse the entire backward graph from the
                                                 all tensors in the return value of the wrapped model's
                                                 forward function. For parameters not involved in loss
@@ -369,6 +379,8 @@ class DataParallel(Layer):
     var_dtype: Tensor
     comm_buffer_size: int
     last_comm_buffer_size: int
+    first_comm_buffer_size: int
+    grad_as_bucket_view: bool
 
     def __init__(
         self,
@@ -378,6 +390,8 @@ class DataParallel(Layer):
         last_comm_buffer_size: float = 1,
         find_unused_parameters: bool = False,
         group: Group | None = None,
+        first_comm_buffer_size: float = 0,
+        grad_as_bucket_view: bool = False,
     ) -> None:
         super().__init__(layers.full_name() + "_data_parallel")
 
@@ -387,6 +401,7 @@ class DataParallel(Layer):
 
         self._layers = layers
         self.find_unused_parameters = find_unused_parameters
+        self.grad_as_bucket_view = grad_as_bucket_view
         self.grad_need_sync = True
         self.group = group
         self.var_dtype = core.eager.Tensor
@@ -436,6 +451,9 @@ class DataParallel(Layer):
             self.last_comm_buffer_size = int(
                 last_comm_buffer_size * 1024 * 1024
             )
+            self.first_comm_buffer_size = int(
+                first_comm_buffer_size * 1024 * 1024
+            )
             self.init_reducer()
         else:
             warnings.warn(
@@ -501,6 +519,9 @@ class DataParallel(Layer):
                 self.group.process_group,
                 [self.last_comm_buffer_size, self.comm_buffer_size],
                 self.find_unused_parameters,
+                True,
+                self.first_comm_buffer_size,
+                self.grad_as_bucket_view,
             )
 
     def _find_tensor(self, obj):
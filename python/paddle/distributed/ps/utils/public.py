@@ -129,6 +129,13 @@ class TrainerRuntimeConfig:
         self.runtime_configs['communicator_is_sgd_optimizer'] = os.getenv(
             "FLAGS_communicator_is_sgd_optimizer", "1"
         )
+        # none, fp16 or int8
+        self.runtime_configs['communicator_geo_delta_compress'] = os.getenv(
+            "FLAGS_communicator_geo_delta_compress", "none"
+        )
+        self.runtime_configs['communicator_geo_delta_threshold'] = os.getenv(
+            "FLAGS_communicator_geo_delta_threshold", "0"
+        )
 
     def get_communicator_flags(self):
         need_keys = []
@@ -155,6 +162,8 @@ class TrainerRuntimeConfig:
                 'communicator_send_wait_times',
                 'communicator_max_merge_var_num',
                 'communicator_send_queue_size',
+                'communicator_geo_delta_compress',
+                'communicator_geo_delta_threshold',
             ]
         else:
             raise ValueError("Unsupported Mode")
@@ -149,7 +149,10 @@ def init_rpc(
             node_info.name, node_info.rank, node_info.ip, node_info.port
         )
         c_infos.append(info)
-    core.init_and_set_agent_instance(name, c_infos)
+    # the calls to a worker made while others are in flight to it are sent
+    # together, up to this number at a time
+    max_batch_size = int(os.getenv("PADDLE_RPC_MAX_BATCH_SIZE", "1"))
+    core.init_and_set_agent_instance(name, c_infos, max_batch_size)
     core.rpc_start_worker()
     # ensure that all the workers are started
     _barrier_never_timeout(rank, world_size)
@@ -159,7 +162,7 @@ def init_rpc(
 
 def rpc_sync(
     to: str,
-    fn: Callable[..., _RetT],
+    fn: Callable[..., _RetT] | str,
     args: tuple[Any, ...] | None = None,
     kwargs: dict[str, Any] | None = None,
     timeout: int = _DEFAULT_RPC_TIMEOUT,
@@ -169,7 +172,9 @@ def rpc_sync(
 
     Args:
         to (str): name of the destination worker.
-        fn (fn): a callable function, such as Python callables.
+        fn (fn|str): a callable function, such as Python callables, or the name of
+            a C++ function registered by ``REGISTER_RPC_FUNCTION``, which is called
+            on the bytes of ``args[0]`` without the GIL and returns bytes.
         args (tuple, optional): the argument tuple for the ``fn`` invocation, default is None.
         kwargs (dict, optional): is a dictionary of keyword arguments for the ``fn``
                        invocation, default is None.
@@ -205,7 +210,7 @@ def rpc_sync(
 
 def rpc_async(
     to: str,
-    fn: Callable[..., _RetT],
+    fn: Callable[..., _RetT] | str,
     args: tuple[Any, ...] | None = None,
     kwargs: dict[str, Any] | None = None,
     timeout: int = _DEFAULT_RPC_TIMEOUT,
@@ -215,7 +220,9 @@ def rpc_async(
 
     Args:
         to (str): name of the destination worker.
-        fn (fn): a callable function, such as Python callables.
+        fn (fn|str): a callable function, such as Python callables, or the name of
+            a C++ function registered by ``REGISTER_RPC_FUNCTION``, which is called
+            on the bytes of ``args[0]`` without the GIL and returns bytes.
         args (tuple, optional): the argument tuple for the ``fn`` invocation, default is None.
         kwargs (dict, optional): is a dictionary of keyword arguments for the ``fn``
                        invocation, default is None.
@@ -256,9 +263,15 @@ def rpc_async(
 def _invoke_rpc(to, fn, args, kwargs, timeout):
     args = args if args else ()
     kwargs = kwargs if kwargs else {}
-    serial_obj = _serialize(PythonFunc(fn, args, kwargs))
     timeout_ms = timeout * 1000
     timeout_ms = _MAX_RPC_TIMEOUT_MS if timeout_ms <= 0 else timeout_ms
+    if isinstance(fn, str):
+        assert (
+            len(args) <= 1 and not kwargs
+        ), "A C++ RPC function takes the bytes of one argument."
+        message = args[0] if args else b""
+        return core.invoke_rpc_function(to, fn, message, timeout_ms)
+    serial_obj = _serialize(PythonFunc(fn, args, kwargs))
     future = core.invoke_rpc(to, serial_obj, timeout_ms)
     return future
 
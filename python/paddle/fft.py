@@ -22,7 +22,8 @@ import numpy as np
 import paddle
 
 from . import _C_ops
-from .base.data_feeder import check_variable_and_dtype
+from .base import core
+from .base.data_feeder import check_variable_and_dtype, convert_dtype
 from .base.layer_helper import LayerHelper
 from .framework import in_dynamic_or_pir_mode
 from .tensor.attribute import is_floating_point, is_integer
@@ -58,6 +59,10 @@ __all__ = [
     'rfftfreq',
     'fftshift',
     'ifftshift',
+    'plan_cache_info',
+    'set_plan_cache_max_size',
+    'clear_plan_cache',
+    'warmup_plan_cache',
 ]
 
 
@@ -1540,6 +1545,195 @@ def ifftshift(
     return paddle.roll(x, shifts, axes, name=name)
 
 
+_FFT_PLAN_REAL_TO_COMPLEX = {'float32': 'complex64', 'float64': 'complex128'}
+_FFT_PLAN_COMPLEX_TO_REAL = {'complex64': 'float32', 'complex128': 'float64'}
+
+
+def _fft_plan_cache_device(device, op_name):
+    if not (core.is_compiled_with_cuda() or core.is_compiled_with_rocm()):
+        raise RuntimeError(
+            f"{op_name} needs Paddle compiled with CUDA or ROCm, the FFT plan "
+            "cache only exists on GPUs."
+        )
+    from paddle.device.cuda import extract_cuda_device_id
+
+    return extract_cuda_device_id(device, op_name=op_name)
+
+
+def plan_cache_info(device: int | str | None = None) -> dict[str, int]:
+    """
+    Return the state of the cuFFT plan cache of a GPU, which the FFTs on
+    the GPU look their plans up in.
+
+    Args:
+        device (int|str|None, optional): The id of the GPU, or its name like
+            'gpu:x'. Default is None, the current GPU.
+
+    Returns:
+        dict. ``size`` and ``max_size`` are the number of cached plans and
+        the number beyond which the least recently used plan is evicted,
+        ``hits`` and ``misses`` are the number of lookups which found their
+        plan and which built it since the process started.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+
+            >>> x = paddle.randn([4, 64], dtype='float32')
+            >>> y = paddle.fft.rfft(x)
+            >>> info = paddle.fft.plan_cache_info()
+            >>> print(info['size'] > 0)
+            True
+    """
+    device_id = _fft_plan_cache_device(device, "plan_cache_info")
+    return core.get_fft_plan_cache_info(device_id)
+
+
+def set_plan_cache_max_size(
+    max_size: int, device: int | str | None = None
+) -> None:
+    """
+    Set the number of plans the cuFFT plan cache of a GPU keeps, evicting the
+    least recently used plans beyond it.
+
+    Args:
+        max_size (int): The number of plans to keep, greater than 0 for the
+            FFTs to run.
+        device (int|str|None, optional): The id of the GPU, or its name like
+            'gpu:x'. Default is None, the current GPU.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+
+            >>> paddle.fft.set_plan_cache_max_size(16)
+            >>> print(paddle.fft.plan_cache_info()['max_size'])
+            16
+    """
+    device_id = _fft_plan_cache_device(device, "set_plan_cache_max_size")
+    core.set_fft_plan_cache_max_size(device_id, max_size)
+
+
+def clear_plan_cache(device: int | str | None = None) -> None:
+    """
+    Drop the plans of the cuFFT plan cache of a GPU. The plans still used by
+    running FFTs are released once they finish.
+
+    Args:
+        device (int|str|None, optional): The id of the GPU, or its name like
+            'gpu:x'. Default is None, the current GPU.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+
+            >>> paddle.fft.clear_plan_cache()
+            >>> print(paddle.fft.plan_cache_info()['size'])
+            0
+    """
+    device_id = _fft_plan_cache_device(device, "clear_plan_cache")
+    core.clear_fft_plan_cache(device_id)
+
+
+def warmup_plan_cache(
+    shape: Sequence[int],
+    axes: Sequence[int] | None = None,
+    transform: Literal["c2c", "r2c", "c2r"] = "c2c",
+    dtype: DTypeLike = 'complex64',
+    last_dim_size: int | None = None,
+    device: int | str | None = None,
+) -> None:
+    """
+    Build the cuFFT plans which an FFT of an input of ``shape`` looks up,
+    so that the first steps of a model whose FFT shapes are known don't
+    build them.
+
+    Args:
+        shape (Sequence[int]): The shape of the input of the FFT, after it
+            is resized to ``n`` or ``s``.
+        axes (Sequence[int]|None, optional): The axes to transform. Default
+            is None, all the axes.
+        transform (str, optional): ``'c2c'`` for the complex to complex FFTs
+            like ``fft`` and ``ifftn``, ``'r2c'`` for the real to complex
+            ones like ``rfft`` and ``ihfft``, ``'c2r'`` for the complex to
+            real ones like ``irfft`` and ``hfft``. Default is ``'c2c'``.
+        dtype (str|paddle.dtype, optional): The data type of the input, real
+            for ``'r2c'`` and complex otherwise. Default is ``'complex64'``.
+        last_dim_size (int|None, optional): For ``'c2r'``, the size of the
+            output along the last axis. Default is None,
+            ``2 * (shape[axes[-1]] - 1)``.
+        device (int|str|None, optional): The id of the GPU, or its name like
+            'gpu:x'. Default is None, the current GPU.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+
+            >>> paddle.fft.warmup_plan_cache(
+            ...     [4, 64], axes=[1], transform='r2c', dtype='float32'
+            ... )
+            >>> misses = paddle.fft.plan_cache_info()['misses']
+            >>> y = paddle.fft.rfft(paddle.randn([4, 64], dtype='float32'))
+            >>> print(paddle.fft.plan_cache_info()['misses'] == misses)
+            True
+    """
+    device_id = _fft_plan_cache_device(device, "warmup_plan_cache")
+    shape = list(shape)
+    rank = len(shape)
+    if axes is None:
+        axes = list(range(rank))
+    axes = [axis + rank if axis < 0 else axis for axis in axes]
+    for axis in axes:
+        if axis < 0 or axis >= rank:
+            raise ValueError(
+                f"Invalid FFT axis ({axis}), it should be in range [-{rank}, {rank})."
+            )
+    if not axes:
+        return
+    # the FFT apis sort all but the last axis the same way
+    axes = sorted(axes[:-1]) + [axes[-1]]
+    x_dtype = convert_dtype(dtype)
+    out_shape = list(shape)
+    if transform == "c2c":
+        if x_dtype not in _FFT_PLAN_COMPLEX_TO_REAL:
+            raise ValueError(
+                f"The dtype of a 'c2c' transform must be complex64 or complex128, but received {x_dtype}."
+            )
+        out_dtype = x_dtype
+    elif transform == "r2c":
+        if x_dtype not in _FFT_PLAN_REAL_TO_COMPLEX:
+            raise ValueError(
+                f"The dtype of a 'r2c' transform must be float32 or float64, but received {x_dtype}."
+            )
+        out_dtype = _FFT_PLAN_REAL_TO_COMPLEX[x_dtype]
+        out_shape[axes[-1]] = shape[axes[-1]] // 2 + 1
+    elif transform == "c2r":
+        if x_dtype not in _FFT_PLAN_COMPLEX_TO_REAL:
+            raise ValueError(
+                f"The dtype of a 'c2r' transform must be complex64 or complex128, but received {x_dtype}."
+            )
+        out_dtype = _FFT_PLAN_COMPLEX_TO_REAL[x_dtype]
+        if last_dim_size is None:
+            last_dim_size = 2 * (shape[axes[-1]] - 1)
+        _check_fft_n(last_dim_size)
+        out_shape[axes[-1]] = last_dim_size
+    else:
+        raise ValueError(
+            f"Unexpected transform ({transform}), it should be 'c2c', 'r2c' or 'c2r'."
+        )
+    core.warmup_fft_plan_cache(
+        device_id, shape, out_shape, axes, x_dtype, out_dtype
+    )
+
+
 # internal functions
 def fft_c2c(x, n, axis, norm, forward, name):
     if is_integer(x):
@@ -74,6 +74,7 @@ if TYPE_CHECKING:
 
     class _SaveOptions(TypedDict):
         use_binary_format: NotRequired[bool]
+        use_flat_format: NotRequired[bool]
         pickle_protocol: NotRequired[Literal[2, 3, 4]]
 
 
@@ -389,7 +390,11 @@ def _parse_load_config(configs):
 
 
 def _parse_save_config(configs):
-    supported_configs = ['use_binary_format', 'pickle_protocol']
+    supported_configs = [
+        'use_binary_format',
+        'use_flat_format',
+        'pickle_protocol',
+    ]
 
     # input check
     for key in configs:
@@ -405,6 +410,7 @@ def _parse_save_config(configs):
 
     inner_config = _SaveLoadConfig()
     inner_config.use_binary_format = configs.get('use_binary_format', False)
+    inner_config.use_flat_format = configs.get('use_flat_format', False)
     inner_config.pickle_protocol = configs.get('pickle_protocol', None)
 
     return inner_config
@@ -770,6 +776,44 @@ def _save_binary_var(obj, path):
         )
 
 
+def _save_flat_params(obj, path):
+    if not _is_file_path(path):
+        raise ValueError(
+            "When use_flat_format = True, `paddle.save` only saves to a file."
+        )
+    if not isinstance(obj, dict):
+        raise TypeError(
+            f"When use_flat_format = True, `paddle.save` expected a dict of Tensor, but received {type(obj)}."
+        )
+    tensors = []
+    for key, value in obj.items():
+        if isinstance(value, core.eager.Tensor):
+            value = value.value().get_tensor()
+        elif isinstance(value, np.ndarray):
+            value = _to_LodTensor(value)
+        elif not isinstance(value, core.LoDTensor):
+            raise TypeError(
+                f"When use_flat_format = True, `paddle.save` expected a dict of Tensor, but the value of {key} is {type(value)}."
+            )
+        tensors.append(value)
+    core.save_flat_params_func(tensors, list(obj.keys()), path, True)
+
+
+def _load_flat_params(path, return_numpy):
+    # The CPU tensors point to the mapped file, without a copy.
+    load_result = {}
+    for name, tensor in core.load_flat_params_func(path):
+        if return_numpy:
+            load_result[name] = np.array(tensor)
+        elif in_dygraph_mode():
+            load_result[name] = core.eager.Tensor(
+                value=tensor, place=core.CPUPlace(), name=name
+            )
+        else:
+            load_result[name] = tensor
+    return load_result
+
+
 def save(
     obj: _StateDict | NestedStructure[Tensor] | Program,
     path: str | BytesIO,
@@ -801,6 +845,11 @@ def save(
           use_binary_format(bool): When the saved object is static graph variable, you can specify ``use_binary_for_var``.
           If True, save the file in the c++ binary format when saving a single static graph variable; otherwise, save it in pickle format.
           Default: False
+          use_flat_format(bool): When the saved object is a dict of Tensor, such as a ``state_dict`` without nested structure, you can specify ``use_flat_format``.
+          If True, save the tensors in the flat parameter format, a json header of the names, data types, shapes and offsets followed by the aligned raw data,
+          as safetensors does. ``paddle.load`` memory maps such a file and returns the CPU tensors pointing to the mapping without parsing or copying them,
+          and ``paddle.jit.load`` and the inference predictor read it as the ``.pdiparams`` file, whose tensors are named as the parameters in the program.
+          Default: False
 
     Returns:
         None
@@ -932,8 +981,15 @@ def save(
             f"Type of `use_binary_format` should be bool, but received {type(config.use_binary_format)}."
         )
 
+    if not isinstance(config.use_flat_format, bool):
+        raise TypeError(
+            f"Type of `use_flat_format` should be bool, but received {type(config.use_flat_format)}."
+        )
+
     if config.use_binary_format:
         _save_binary_var(obj, path)
+    elif config.use_flat_format:
+        _save_flat_params(obj, path)
     else:
         # `protocol` need to be used, `pickle_protocol` is a deprecated arg.
         if config.pickle_protocol is not None:
@@ -1184,6 +1240,8 @@ def load(path: str | BytesIO, **configs: Unpack[_LoadOptions]) -> Any:
 
     if _is_memory_buffer(path) or os.path.isfile(path):
         config = _parse_load_config(configs)
+        if _is_file_path(path) and core.is_flat_params_file(path):
+            return _load_flat_params(path, config.return_numpy)
         exception_type = pickle.UnpicklingError
         try:
             with _open_file_buffer(path, 'rb') as f:
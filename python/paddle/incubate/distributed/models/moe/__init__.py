@@ -14,6 +14,7 @@
 
 from .gate import BaseGate, GShardGate, NaiveGate, SwitchGate  # noqa: F401
 from .grad_clip import ClipGradForMOEByGlobalNorm
+from .grouped_experts import GroupedExperts  # noqa: F401
 from .moe_layer import MoELayer  # noqa: F401
 
 ClipGradByGlobalNorm = ClipGradForMOEByGlobalNorm
@@ -56,15 +56,18 @@ class SwitchGate(NaiveGate):
         score = F.softmax(score, axis=-1)
         top1_score, top1_idx = paddle.topk(score, k=1, axis=-1, largest=True)
 
-        cap_rate = self.capacity[0 if self.training else 1]
-        capacity = math.ceil(cap_rate * inp.shape[0])
-        _new_lec, _new_gec, top1_idx = limit_by_capacity(
-            top1_idx,
-            self.num_expert,
-            self.world_size,
-            capacity,
-            group=self.group,
-        )
+        # Without a capacity no token is dropped, for the experts that take
+        # any number of tokens, like GroupedExperts.
+        if self.capacity is not None:
+            cap_rate = self.capacity[0 if self.training else 1]
+            capacity = math.ceil(cap_rate * inp.shape[0])
+            _new_lec, _new_gec, top1_idx = limit_by_capacity(
+                top1_idx,
+                self.num_expert,
+                self.world_size,
+                capacity,
+                group=self.group,
+            )
         valid_idx = top1_idx[top1_idx > -1]
         valid_idx_tmp = paddle.reshape(valid_idx, shape=[len(valid_idx), 1])
         fraction_expert = (
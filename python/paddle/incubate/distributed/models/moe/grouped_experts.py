@@ -0,0 +1,90 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+
+import paddle.nn.functional as F
+from paddle import nn
+from paddle.incubate.nn.functional import moe_grouped_gemm
+
+
+class GroupedExperts(nn.Layer):
+    r"""
+    ``num_expert`` feed-forward experts of the same shape, whose weights
+    are stacked so that each of their two GEMMs runs for all the experts in
+    one grouped GEMM.
+
+    .. math::
+
+        out_e = act(x_e \times w1[e]) \times w2[e]
+
+    Given as the ``experts`` of :class:`MoELayer`, it makes the layer route
+    the tokens with :func:`paddle.incubate.nn.functional.moe_permute` and
+    :func:`paddle.incubate.nn.functional.moe_unpermute` instead of running
+    a list of experts one by one. The experts have no biases.
+
+    Args:
+        num_expert (int): The number of experts.
+        d_model (int): The input and output size of each expert.
+        d_hidden (int): The hidden size of each expert.
+        activation (str, optional): The name of the function of
+            ``paddle.nn.functional`` applied between the GEMMs.
+            Default: "gelu".
+        weight_attr (ParamAttr, optional): The attribute of ``w1`` and
+            ``w2``. Default: None, which initializes them uniformly in
+            :math:`\pm 1/\sqrt{fan\_in}` like :class:`paddle.nn.Linear`.
+    """
+
+    def __init__(
+        self,
+        num_expert,
+        d_model,
+        d_hidden,
+        activation="gelu",
+        weight_attr=None,
+    ):
+        super().__init__()
+        self.num_expert = num_expert
+        self.d_model = d_model
+        self.d_hidden = d_hidden
+        self.activation = getattr(F, activation)
+        self.w1 = self.create_parameter(
+            shape=[num_expert, d_model, d_hidden],
+            attr=weight_attr,
+            default_initializer=nn.initializer.Uniform(
+                -1.0 / math.sqrt(d_model), 1.0 / math.sqrt(d_model)
+            ),
+        )
+        self.w2 = self.create_parameter(
+            shape=[num_expert, d_hidden, d_model],
+            attr=weight_attr,
+            default_initializer=nn.initializer.Uniform(
+                -1.0 / math.sqrt(d_hidden), 1.0 / math.sqrt(d_hidden)
+            ),
+        )
+
+    def __len__(self):
+        return self.num_expert
+
+    def forward(self, x, expert_offsets):
+        """
+        Args:
+            x (Tensor): The rows of shape [num_rows, d_model], grouped by
+                expert.
+            expert_offsets (Tensor): The int64 end row of each expert in
+                ``x``, of shape [num_expert].
+        """
+        h = moe_grouped_gemm(x, self.w1, expert_offsets)
+        h = self.activation(h)
+        return moe_grouped_gemm(h, self.w2, expert_offsets)
@@ -24,15 +24,18 @@ import os
 import numpy as np
 
 import paddle
+import paddle.distributed as dist
 from paddle import nn
 from paddle.autograd import PyLayer
 from paddle.distributed.utils.moe_utils import global_gather, global_scatter
 from paddle.distributed.utils.nccl_utils import check_nccl_version_for_p2p
 from paddle.framework import in_dynamic_mode
 from paddle.incubate.distributed.fleet import recompute_hybrid
+from paddle.incubate.nn.functional import moe_permute, moe_unpermute
 
 from .gate import BaseGate, GShardGate, NaiveGate, SwitchGate
-from .utils import count_by_gate
+from .grouped_experts import GroupedExperts
+from .utils import _alltoall, count_by_gate
 
 
 def _local_scatter(inp, pos):
@@ -260,17 +263,183 @@ def prepare_forward(gate, num_expert, world_size, moe_group):
     )
 
 
+class _ExchangeHandle:
+    """The tasks and buffers of one exchange, in forward and in backward."""
+
+    def __init__(self, dst, src, send_rows, group):
+        self.dst = dst
+        self.src = src
+        self.send_rows = send_rows
+        self.group = group
+        self.tasks = []
+        self.grad = None
+        self.grad_tasks = []
+
+
+def _post_exchange(send, recv, dst, src, group):
+    # Sends send to rank dst and receives recv from rank src of the group,
+    # leaving out the empty ones, which the peer leaves out as well.
+    ops = []
+    if send.shape[0] > 0:
+        ops.append(dist.P2POp(dist.isend, send, group.ranks[dst], group))
+    if recv.shape[0] > 0:
+        ops.append(dist.P2POp(dist.irecv, recv, group.ranks[src], group))
+    if not ops:
+        return []
+    return dist.batch_isend_irecv(ops)
+
+
+class _StartExchange(PyLayer):
+    r"""
+    Starts sending the rows to rank ``dst`` and receiving ``recv_rows`` rows
+    from rank ``src``, and returns the buffer they are received in. The
+    buffer is only valid after :class:`_WaitExchange`, so that the work
+    between them overlaps with the exchange. Backward waits for the grad of
+    the rows sent, which the backward of :class:`_ExchangeBarrier` fetches.
+    """
+
+    @staticmethod
+    def forward(ctx, send, recv_rows, handle):
+        recv = paddle.empty([recv_rows, send.shape[1]], dtype=send.dtype)
+        handle.tasks = _post_exchange(
+            send, recv, handle.dst, handle.src, handle.group
+        )
+        ctx.handle = handle
+        return recv
+
+    @staticmethod
+    def backward(ctx, grad):
+        handle = ctx.handle
+        for task in handle.grad_tasks:
+            task.wait()
+        return handle.grad
+
+
+class _ExchangeBarrier(PyLayer):
+    r"""
+    Returns the buffers of the exchanges started before it. Backward gets
+    the grads of all of them at once and starts their exchanges back in the
+    order of ``handles``: the grad of the rows received goes to ``src`` and
+    the grad of the rows sent comes from ``dst``. Starting them in one place
+    keeps the order the same on every rank, whatever order autograd runs
+    the nodes in, so that the point-to-point exchanges always match.
+    """
+
+    @staticmethod
+    def forward(ctx, recvs, handles):
+        ctx.handles = handles
+        ctx.mark_not_inplace(*recvs)
+        return recvs
+
+    @staticmethod
+    def backward(ctx, grads):
+        for handle, grad in zip(ctx.handles, grads):
+            handle.grad = paddle.empty(
+                [handle.send_rows, grad.shape[1]], dtype=grad.dtype
+            )
+            handle.grad_tasks = _post_exchange(
+                grad, handle.grad, handle.src, handle.dst, handle.group
+            )
+        return grads
+
+
+class _WaitExchange(PyLayer):
+    """Waits for the exchange of :class:`_StartExchange` to finish."""
+
+    @staticmethod
+    def forward(ctx, recv, handle):
+        for task in handle.tasks:
+            task.wait()
+        ctx.mark_not_inplace(recv)
+        return recv
+
+    @staticmethod
+    def backward(ctx, grad):
+        return grad
+
+
+def _start_exchange(send, recv_rows, dst, src, group):
+    handle = _ExchangeHandle(dst, src, send.shape[0], group)
+    return _StartExchange.apply(send, recv_rows, handle), handle
+
+
+def _grouped_experts_alltoall(
+    x, expert_offsets, run_experts, num_expert, group
+):
+    r"""
+    Runs the experts of all the ranks of ``group`` on the rows of ``x``,
+    grouped by global expert as :func:`moe_permute` returns them, and
+    returns their outputs in the same rows.
+
+    The rows go round the ranks in ``world_size - 1`` steps: at step ``s``
+    each rank sends to rank ``rank + s`` and receives from ``rank - s``.
+    All the steps start at once, and the rows a rank keeps are computed
+    while they run. Then each step is computed as soon as it arrives, and
+    its outputs start going back while the next one is computed. Backward
+    overlaps the same way.
+    """
+    world_size = group.nranks
+    rank = group.rank
+    with paddle.no_grad():
+        local_count = paddle.diff(
+            expert_offsets, prepend=paddle.zeros([1], dtype="int64")
+        )
+        global_count = _alltoall(local_count, group=group)
+    # The row counts, sent as [to rank, expert] and received as
+    # [from rank, expert], size the buffers and the GEMMs on the host.
+    local_count = local_count.numpy().reshape([world_size, num_expert])
+    global_count = global_count.numpy().reshape([world_size, num_expert])
+    send_rows = local_count.sum(axis=1)
+    recv_rows = global_count.sum(axis=1)
+    send_begin = np.concatenate([[0], np.cumsum(send_rows)])
+
+    def rows_to(dst):
+        return x[int(send_begin[dst]) : int(send_begin[dst + 1])]
+
+    def offsets_of(counts):
+        return paddle.to_tensor(np.cumsum(counts), dtype="int64")
+
+    shifts = range(1, world_size)
+    dsts = [(rank + shift) % world_size for shift in shifts]
+    srcs = [(rank - shift) % world_size for shift in shifts]
+    recvs, handles = zip(
+        *[
+            _start_exchange(rows_to(dst), int(recv_rows[src]), dst, src, group)
+            for dst, src in zip(dsts, srcs)
+        ]
+    )
+    recvs = _ExchangeBarrier.apply(list(recvs), handles)
+
+    outputs = [None] * world_size
+    outputs[rank] = run_experts(rows_to(rank), offsets_of(local_count[rank]))
+
+    # The outputs go back to the rank the rows came from, and those of the
+    # rows sent come back from the rank they went to.
+    returns = []
+    for dst, src, recv, handle in zip(dsts, srcs, recvs, handles):
+        rows = _WaitExchange.apply(recv, handle)
+        y = run_experts(rows, offsets_of(global_count[src]))
+        returns.append(_start_exchange(y, int(send_rows[dst]), src, dst, group))
+    recvs, handles = zip(*returns)
+    recvs = _ExchangeBarrier.apply(list(recvs), handles)
+    for dst, recv, handle in zip(dsts, recvs, handles):
+        outputs[dst] = _WaitExchange.apply(recv, handle)
+    return paddle.concat(outputs, axis=0)
+
+
 class MoELayer(nn.Layer):
     """MoE Layer
     Args:
         d_model (int): Model dimension.
-        experts (nn.LayerList): Expert networks list.
+        experts (nn.LayerList|GroupedExperts): Expert networks list, or the
+            experts with stacked weights.
         gate (dict|NaiveGate|SwitchGate|NaiveGate):
 
             - If gate is a dict:
-              gate is a gate network config, containing 2 keys:
+              gate is a gate network config, containing up to 3 keys:
               `type` (str) value can be: "naive", "gshard", "switch" or None, default is "gshard".
               `top_k` (int) Default value is 2.
+              `capacity` (tuple|None) The train and eval capacity rates of the gshard and switch gates, None for no capacity. Default value is (1.2, 2.4).
             else gate is an instance of NaiveGate|SwitchGate|NaiveGate:
 
         moe_group: moe group for experts communication.
@@ -278,6 +447,20 @@ class MoELayer(nn.Layer):
         recompute_interval (int, optional): Whether to use recompute, default 0, means to disable recompute.
         recompute_ctx (dict, optional): The context for recompute, if recompute_interval > 1, recompute_ctx must be given.
 
+    When experts is a LayerList, the experts are arbitrary Layers run one
+    after another on their tokens, and the tokens are exchanged by
+    global_scatter and global_gather before and after them.
+
+    When experts is a :class:`GroupedExperts`, the tokens are grouped by
+    expert with :func:`paddle.incubate.nn.functional.moe_permute`, each GEMM
+    of the experts runs for all of them in one grouped GEMM, and
+    :func:`paddle.incubate.nn.functional.moe_unpermute` brings the outputs
+    back and combines them in one kernel. No token is padded or dropped by
+    the layer: with a gate config of ``"capacity": None``, the gshard and
+    switch gates do not drop any either. Across the ranks of moe_group, the
+    tokens go to the experts and back by point-to-point exchanges that
+    overlap with the expert compute.
+
     Examples:
 
         .. code-block:: python
@@ -369,6 +552,7 @@ class MoELayer(nn.Layer):
         self.d_model = d_model
         if isinstance(gate, dict):
             self.top_k = gate.get("top_k", 2)
+            capacity = gate.get("capacity", (1.2, 2.4))
             gate = gate.get("type", "gshard")
             if gate == "naive" or gate is None:
                 gate = NaiveGate(
@@ -383,6 +567,7 @@ class MoELayer(nn.Layer):
                     num_expert=len(experts),
                     world_size=self.world_size,
                     topk=self.top_k,
+                    capacity=capacity,
                     group=self.group,
                 )
             elif gate == "switch":
@@ -391,6 +576,7 @@ class MoELayer(nn.Layer):
                     num_expert=len(experts),
                     world_size=self.world_size,
                     topk=self.top_k,
+                    capacity=capacity,
                     group=self.group,
                 )
             else:
@@ -420,6 +606,12 @@ class MoELayer(nn.Layer):
             inp = Slice.apply(inp, mp_rank, mp_size, self.mp_group)
         value, gate = self.gate(inp)
 
+        if isinstance(self.experts, GroupedExperts):
+            x = self._grouped_experts_fwd(inp, value, gate)
+            if mp_size > 1:
+                x = AllGather.apply(x, mp_rank, mp_size, self.mp_group)
+            return paddle.reshape_(x, origin_shape)
+
         (
             pos,
             local_expert_count,
@@ -453,17 +645,17 @@ class MoELayer(nn.Layer):
         def experts_fwd(x, fwd_expert_count, experts):
             if x.shape[0] == 0:
                 return x
-            y = []
-            last_index = 0
             assert isinstance(fwd_expert_count, np.ndarray)
             assert len(experts) == len(fwd_expert_count)
-            for idx, expert_count in enumerate(fwd_expert_count):
-                if expert_count <= 0:
-                    continue
-                y.append(
-                    experts[idx](x[last_index : expert_count + last_index])
-                )
-                last_index = expert_count + last_index
+            # The tokens of each expert are contiguous, so they are split in
+            # one op rather than sliced for each expert.
+            active = [
+                idx for idx, count in enumerate(fwd_expert_count) if count > 0
+            ]
+            inputs = paddle.split(
+                x, [int(fwd_expert_count[idx]) for idx in active], axis=0
+            )
+            y = [experts[idx](inp) for idx, inp in zip(active, inputs)]
             return paddle.concat(y, axis=0)
 
         if self.recompute_interval <= 0 or x.shape[0] == 0:
@@ -501,3 +693,34 @@ class MoELayer(nn.Layer):
         x = paddle.reshape_(x, origin_shape)
 
         return x
+
+    def _grouped_experts_fwd(self, inp, value, gate):
+        topk = gate.shape[1] if len(gate.shape) == 2 else 1
+        assert topk == self.top_k
+        gate = gate.reshape([-1, topk])
+        value = value.reshape([-1, topk]).astype("float32")
+        # The gates with a capacity mark the tokens they drop with -1. They
+        # go to expert 0 with a zero weight, so they add nothing.
+        dropped = gate < 0
+        expert_ids = paddle.where(dropped, paddle.zeros_like(gate), gate)
+        value = paddle.where(dropped, paddle.zeros_like(value), value)
+        x, expert_offsets, dest_rows = moe_permute(
+            inp,
+            expert_ids.astype("int32"),
+            self.num_expert * self.world_size,
+        )
+
+        def run_experts(x, expert_offsets):
+            if self.recompute_interval <= 0 or x.shape[0] == 0:
+                return self.experts(x, expert_offsets)
+            return recompute_hybrid(
+                self.recompute_ctx, self.experts, x, expert_offsets
+            )
+
+        if self.world_size > 1:
+            x = _grouped_experts_alltoall(
+                x, expert_offsets, run_experts, self.num_expert, self.group
+            )
+        else:
+            x = run_experts(x, expert_offsets)
+        return moe_unpermute(x, dest_rows, value)
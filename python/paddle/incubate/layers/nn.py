@@ -1403,6 +1403,86 @@ def _pull_gpups_sparse(
     return outs
 
 
+def _pull_gpups_sparse_seqpool_cvm(
+    input,
+    cvm,
+    size,
+    pad_value=0.0,
+    use_cvm=True,
+    cvm_offset=2,
+    dtype='float32',
+    is_distributed=False,
+    is_sparse=False,
+):
+    r"""
+    **Pull GpuPS Sparse Seqpool CVM Layer**
+
+    This layer looks up the embeddings of the IDs in :attr:`input` in the GpuPS
+    lookup table as :ref:`_pull_gpups_sparse`, then sums the embeddings of each
+    instance and applies the cvm as :ref:`fused_seqpool_cvm` with pool_type
+    sum. The IDs of all the inputs are deduplicated together, and the pooled
+    embeddings are written directly into the outputs.
+
+    Args:
+        input (list[Tensor]): The Tensor<int64> of the IDs of each slot, with a LoD of one level, one sequence per instance.
+        cvm (Tensor): The show and click of each instance, a 2-D Tensor with shape [N, cvm_offset], used by the gradient.
+        size (list of int): The embedding size of each input, including its cvm_offset leading dims.
+        pad_value (float, optional): The value the sum pooling of each instance starts from. Default is 0.0.
+        use_cvm (bool, optional): Whether to apply the cvm to the leading cvm_offset dims, or to drop them. Default is True.
+        cvm_offset (int, optional): The size of the cvm. Default is 2.
+        dtype (str, optional): The dtype refers to the data type of output tensor. Only supports float32 now. Default is float32.
+        is_distributed (bool, optional): Whether to use distributed mode. Default is False.
+        is_sparse (bool, optional): Whether to use sparse mode. Default is False.
+
+    Returns:
+        list[Tensor]: The pooled embeddings of each input, with shape [N, size] if use_cvm, otherwise [N, size - cvm_offset].
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle.incubate as incubate
+            >>> import paddle
+            >>> paddle.enable_static()
+
+            >>> slots = []
+            >>> data_1 = paddle.static.data(name='sequence_1', shape=[-1,1], dtype='int64', lod_level=1)
+            >>> slots.append(data_1)
+            >>> data_2 = paddle.static.data(name='sequence_2', shape=[-1,1], dtype='int64', lod_level=1)
+            >>> slots.append(data_2)
+            >>> cvm = paddle.static.data(name='cvm', shape=[-1, 2], dtype='float32')
+            >>> embs = incubate.layers._pull_gpups_sparse_seqpool_cvm(input=slots, cvm=cvm, size=[11, 35])
+    """
+    helper = LayerHelper('pull_gpups_sparse_seqpool_cvm', **locals())
+    if dtype != 'float32':
+        raise ValueError(
+            "GpuPS only support float type embedding now, and your type is: "
+            + dtype
+        )
+    helper.input_dtype()
+    inputs = helper.multiple_input()
+    outs = [
+        helper.create_variable_for_type_inference(dtype)
+        for i in range(len(inputs))
+    ]
+    w = helper.create_parameter(
+        attr=helper.param_attr, shape=[size[0]], dtype=dtype, is_bias=False
+    )
+    helper.append_op(
+        type='pull_gpups_sparse_seqpool_cvm',
+        inputs={'Ids': inputs, 'W': w, 'CVM': cvm},
+        outputs={'Out': outs},
+        attrs={
+            'size': size,
+            'pad_value': pad_value,
+            'use_cvm': use_cvm,
+            'cvm_offset': cvm_offset,
+            'is_distributed': is_distributed,
+            'is_sparse': is_sparse,
+        },
+    )
+    return outs
+
+
 def _pull_box_sparse(
     input, size, dtype='float32', is_distributed=False, is_sparse=False
 ):
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from .layer.fp8_linear import FP8Linear, convert_to_fp8_linear
 from .layer.fused_dropout_add import FusedDropoutAdd
 from .layer.fused_dropout_nd import FusedDropout  # noqa: F401
 from .layer.fused_linear import FusedLinear
@@ -31,4 +32,6 @@ __all__ = [
     'FusedLinear',
     'FusedBiasDropoutResidualLayerNorm',
     'FusedDropoutAdd',
+    'FP8Linear',
+    'convert_to_fp8_linear',
 ]
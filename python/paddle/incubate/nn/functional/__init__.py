@@ -17,6 +17,7 @@ from .block_multihead_attention import (
     block_multihead_attention,
     block_multihead_attention_xpu,  # noqa: F401
 )
+from .fp8_linear import fp8_linear
 from .fused_bias_act import fused_bias_act
 from .fused_dot_product_attention import (
     cudnn_flash_attention,  # noqa: F401
@@ -25,6 +26,7 @@ from .fused_dot_product_attention import (
 from .fused_dropout_add import fused_dropout_add
 from .fused_gate_attention import fused_gate_attention  # noqa: F401
 from .fused_layer_norm import fused_layer_norm
+from .fused_linear_cross_entropy import fused_linear_cross_entropy
 from .fused_matmul_bias import (
     fused_linear,
     fused_linear_activation,
@@ -40,6 +42,7 @@ from .fused_transformer import (
     fused_multi_transformer,
 )
 from .masked_multihead_attention import masked_multihead_attention
+from .moe_grouped_gemm import moe_grouped_gemm, moe_permute, moe_unpermute
 from .swiglu import swiglu
 from .variable_length_memory_efficient_attention import (
     variable_length_memory_efficient_attention,
@@ -59,9 +62,14 @@ __all__ = [
     'variable_length_memory_efficient_attention',
     "fused_rms_norm",
     "fused_layer_norm",
+    "fused_linear_cross_entropy",
+    "fp8_linear",
     "fused_bias_act",
     "masked_multihead_attention",
     "blha_get_max_len",
     "block_multihead_attention",
     "swiglu",
+    "moe_permute",
+    "moe_grouped_gemm",
+    "moe_unpermute",
 ]
@@ -0,0 +1,169 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+
+import paddle
+from paddle.autograd import PyLayer
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+
+# The largest finite value of float8_e4m3fn.
+E4M3_MAX = 448.0
+
+# The rows of the scaling state of an fp8 linear.
+_INPUT, _WEIGHT, _GRAD = 0, 1, 2
+
+
+def _cast(x, scale):
+    return (
+        (x * scale.astype(x.dtype))
+        .clip(-E4M3_MAX, E4M3_MAX)
+        .astype(paddle.float8_e4m3fn)
+    )
+
+
+def _update_scale(scale, amax_history, row, x, margin):
+    # Records the amax of x and sets the scale of the next step from the
+    # history, all on the device so that nothing waits for it.
+    amax = x.abs().max().astype('float32').reshape([1])
+    history = paddle.concat([amax, amax_history[row, :-1]])
+    amax_history[row] = history
+    max_amax = history.max()
+    # a power of 2, so that scaling is exact in any dtype
+    exponent = paddle.floor(paddle.log2(E4M3_MAX / max_amax)) - margin
+    new_scale = paddle.pow(paddle.full([], 2.0, 'float32'), exponent)
+    scale[row] = paddle.where(max_amax > 0, new_scale, scale[row])
+
+
+def _fp8_gemm(x8, y8, inv_scale, dtype):
+    # x8 [m, k] by the transpose of y8 [n, k]: cuBLASLt takes both fp8
+    # operands k-major.
+    out = paddle.tensor.linalg.fp8_fp8_half_gemm_fused(
+        x8, y8, transpose_y=True, output_dtype=dtype
+    )
+    return out * inv_scale.astype(out.dtype)
+
+
+class _FP8Linear(PyLayer):
+    @staticmethod
+    def forward(ctx, x, weight, bias, scale, amax_history, margin):
+        out_features = weight.shape[1]
+        x2d = x.reshape([-1, weight.shape[0]])
+        dtype = 'bfloat16' if x.dtype == paddle.bfloat16 else 'float16'
+        with paddle.no_grad():
+            # the scales of the previous steps are used, delayed scaling
+            input_scale = scale[_INPUT].clone()
+            weight_scale = scale[_WEIGHT].clone()
+            x8 = _cast(x2d, input_scale)
+            weight_t8 = _cast(weight.t(), weight_scale)
+            out = _fp8_gemm(
+                x8, weight_t8, 1.0 / (input_scale * weight_scale), dtype
+            )
+            if bias is not None:
+                out = out + bias.astype(out.dtype)
+            # the input is kept for the weight grad in fp8 and transposed
+            x_t8 = _cast(x2d.t(), input_scale)
+            _update_scale(scale, amax_history, _INPUT, x2d, margin)
+            _update_scale(scale, amax_history, _WEIGHT, weight, margin)
+        ctx.save_for_backward(
+            x_t8, weight, input_scale, weight_scale, scale, amax_history
+        )
+        ctx.margin = margin
+        ctx.dtype = dtype
+        ctx.x_shape = x.shape
+        ctx.bias_dtype = None if bias is None else bias.dtype
+        return out.reshape([*x.shape[:-1], out_features])
+
+    @staticmethod
+    def backward(ctx, grad_out):
+        (
+            x_t8,
+            weight,
+            input_scale,
+            weight_scale,
+            scale,
+            amax_history,
+        ) = ctx.saved_tensor()
+        grad2d = grad_out.reshape([-1, weight.shape[1]])
+        with paddle.no_grad():
+            grad_scale = scale[_GRAD].clone()
+            grad8 = _cast(grad2d, grad_scale)
+            grad_t8 = _cast(grad2d.t(), grad_scale)
+            # dx = grad @ weight^T and dw = x^T @ grad, both gemms in fp8
+            grad_x = _fp8_gemm(
+                grad8,
+                _cast(weight, weight_scale),
+                1.0 / (grad_scale * weight_scale),
+                ctx.dtype,
+            )
+            grad_weight = _fp8_gemm(
+                x_t8, grad_t8, 1.0 / (input_scale * grad_scale), ctx.dtype
+            )
+            _update_scale(scale, amax_history, _GRAD, grad2d, ctx.margin)
+            grad_x = grad_x.reshape(ctx.x_shape)
+            grad_weight = grad_weight.astype(weight.dtype)
+            # no grads for the scaling state
+            if ctx.bias_dtype is None:
+                return grad_x, grad_weight, None, None
+            grad_bias = grad2d.sum(axis=0).astype(ctx.bias_dtype)
+            return grad_x, grad_weight, grad_bias, None, None
+
+
+def fp8_linear(
+    x: Tensor,
+    weight: Tensor,
+    bias: Tensor | None,
+    scale: Tensor,
+    amax_history: Tensor,
+    margin: int = 0,
+    name: str | None = None,
+) -> Tensor:
+    r"""
+    Computes ``x @ weight + bias`` with the gemms of forward and backward,
+    the weight grad included, in float8_e4m3fn, scaled by delayed scaling.
+
+    Each of the input, the weight and the output grad is cast to fp8 times
+    its scale, which is the largest power of 2 that keeps the largest amax
+    of the last steps, divided by ``2 ** margin``, below the fp8 max 448.
+    The scales of a step come from the amax of the previous ones, so that
+    the amax of a tensor is not waited for before casting it: they and the
+    history are updated on the device by each step, in place.
+
+    Args:
+        x (Tensor): The input of shape [..., in_features], float16 or
+            bfloat16, which is also the data type of the output.
+        weight (Tensor): The weight of shape [in_features, out_features].
+        bias (Tensor|None): The bias of shape [out_features], or None.
+        scale (Tensor): The float32 scales of the input, the weight and the
+            output grad, of shape [3], 1 at first.
+        amax_history (Tensor): The float32 amax of the input, the weight and
+            the output grad of the last steps, of shape [3, history_len],
+            0 at first.
+        margin (int, optional): The scales are divided by ``2 ** margin``
+            more, for the amax growing until the next step. Default: 0.
+        name (str|None, optional): For details, please refer to
+            :ref:`api_guide_Name`. Generally, no setting is required.
+            Default: None.
+
+    Returns:
+        Tensor, the output of shape [..., out_features].
+
+    Note:
+        The fp8 gemm needs CUDA 12.1+ on sm_89+, and in_features,
+        out_features and the number of rows of x to be multiples of 16.
+    """
+    return _FP8Linear.apply(x, weight, bias, scale, amax_history, margin)
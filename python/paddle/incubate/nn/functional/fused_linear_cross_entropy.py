@@ -0,0 +1,103 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+from typing import TYPE_CHECKING, Literal
+
+import paddle
+from paddle import _C_ops
+
+from ....framework import in_dynamic_or_pir_mode
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+
+
+def fused_linear_cross_entropy(
+    x: Tensor,
+    weight: Tensor,
+    label: Tensor,
+    ignore_index: int = -100,
+    reduction: Literal['mean', 'sum', 'none'] = 'mean',
+    chunk_size: int = 8192,
+    name: str | None = None,
+) -> Tensor:
+    r"""
+    Computes the cross entropy of the logits ``x @ weight`` and ``label``
+    without holding all of the logits.
+
+    The logits are computed for ``chunk_size`` classes at a time, in forward
+    as in backward where they are computed again, so the memory they take is
+    about ``x.shape[:-1]`` by ``chunk_size`` instead of by the number of
+    classes. It suits the LM head of a large vocabulary, whose logits and
+    their grad would otherwise take several GB.
+
+    .. math::
+
+        loss = log(\sum_j exp((x @ weight)_j)) - (x @ weight)_{label}
+
+    Args:
+        x (Tensor): The hidden states of shape [..., hidden_size]. The data
+            type is float16, bfloat16 or float32.
+        weight (Tensor): The weight of shape [hidden_size, num_classes],
+            with the same data type as ``x``.
+        label (Tensor): The class of each row of ``x``, of shape
+            ``x.shape[:-1]`` or ``x.shape[:-1] + [1]``. The data type is
+            int32 or int64.
+        ignore_index (int, optional): The label whose loss and grads are
+            zero. Default: -100.
+        reduction (str, optional): 'mean' averages the loss over the labels
+            not ignored, 'sum' sums it and 'none' returns the loss of each
+            label. Default: 'mean'.
+        chunk_size (int, optional): The number of classes whose logits are
+            computed at a time. Default: 8192.
+        name (str, optional): For details, please refer to :ref:`api_guide_Name`. Generally, no setting is required. Default: None.
+
+    Returns:
+        The loss, a scalar Tensor unless ``reduction`` is 'none', when it has
+        the shape of ``label``.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> from paddle.incubate.nn.functional import fused_linear_cross_entropy
+
+            >>> paddle.set_device('gpu')
+            >>> x = paddle.randn([4, 16])
+            >>> weight = paddle.randn([16, 100])
+            >>> label = paddle.randint(0, 100, [4])
+            >>> loss = fused_linear_cross_entropy(x, weight, label, chunk_size=32)
+            >>> print(loss.shape)
+            []
+    """
+    if reduction not in ('mean', 'sum', 'none'):
+        raise ValueError(
+            f"reduction should be 'mean', 'sum' or 'none', but got {reduction}"
+        )
+    if not in_dynamic_or_pir_mode():
+        raise NotImplementedError(
+            "fused_linear_cross_entropy is only supported in dynamic graph "
+            "mode and PIR mode."
+        )
+    loss = _C_ops.fused_linear_cross_entropy(
+        x, weight, label, ignore_index, chunk_size
+    )
+    if reduction == 'none':
+        return loss
+    if reduction == 'sum':
+        return paddle.sum(loss)
+    valid = paddle.sum((label != ignore_index).astype(loss.dtype))
+    return paddle.sum(loss) / valid
@@ -0,0 +1,193 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+
+from paddle import _C_ops
+
+from ....framework import in_dynamic_or_pir_mode
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+
+
+def _check_mode(api):
+    if not in_dynamic_or_pir_mode():
+        raise NotImplementedError(
+            f"{api} is only supported in dynamic graph mode and PIR mode."
+        )
+
+
+def moe_permute(
+    x: Tensor,
+    expert_ids: Tensor,
+    num_experts: int,
+    name: str | None = None,
+) -> tuple[Tensor, Tensor, Tensor]:
+    r"""
+    Groups the tokens of a mixture of experts by expert, without padding
+    them to a capacity.
+
+    Each token is copied once for each of the ``k`` experts it is routed
+    to, and the copies are sorted by expert with a stable sort, so the rows
+    of each expert keep the order of the tokens. It is the token dispatch of
+    :func:`paddle.incubate.nn.functional.fused_moe`, with a backward.
+
+    Args:
+        x (Tensor): The tokens of shape [num_tokens, hidden_size]. The data
+            type is float16, bfloat16 or float32.
+        expert_ids (Tensor): The experts of each token, of shape
+            [num_tokens, k] and data type int32, each in
+            [0, num_experts).
+        num_experts (int): The number of experts.
+        name (str, optional): For details, please refer to :ref:`api_guide_Name`. Generally, no setting is required. Default: None.
+
+    Returns:
+        - permuted_x (Tensor), the tokens of shape
+          [num_tokens * k, hidden_size], grouped by expert.
+        - expert_offsets (Tensor), the int64 end row of each expert in
+          ``permuted_x``, of shape [num_experts].
+        - dest_rows (Tensor), the int32 row in ``permuted_x`` of the copy of
+          token ``t`` for its ``j``-th expert, at ``j * num_tokens + t``.
+          :func:`moe_unpermute` takes it to bring the rows back.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> from paddle.incubate.nn.functional import moe_permute
+
+            >>> paddle.set_device('gpu')
+            >>> x = paddle.randn([4, 16])
+            >>> expert_ids = paddle.to_tensor(
+            ...     [[0, 2], [1, 2], [2, 0], [1, 1]], dtype='int32'
+            ... )
+            >>> permuted_x, expert_offsets, dest_rows = moe_permute(
+            ...     x, expert_ids, 3
+            ... )
+            >>> print(expert_offsets.numpy())
+            [2 5 8]
+    """
+    _check_mode("moe_permute")
+    return _C_ops.moe_permute(x, expert_ids, num_experts)
+
+
+def moe_grouped_gemm(
+    x: Tensor,
+    weight: Tensor,
+    expert_offsets: Tensor,
+    name: str | None = None,
+) -> Tensor:
+    r"""
+    Multiplies the rows of each expert by the weight of that expert, all
+    the experts in one grouped GEMM.
+
+    .. math::
+
+        out[o_{e-1}:o_e] = x[o_{e-1}:o_e] \times weight[e]
+
+    where :math:`o_e` is ``expert_offsets[e]`` and :math:`o_{-1} = 0`. The
+    forward and the grad of ``x`` run the CUTLASS grouped GEMM of
+    :func:`paddle.incubate.nn.functional.fused_moe`. The grad of ``weight``
+    runs one GEMM per expert that has rows.
+
+    Args:
+        x (Tensor): The rows of shape [num_rows, k] grouped by expert, as
+            :func:`moe_permute` returns them. The data type is float16,
+            bfloat16 or float32.
+        weight (Tensor): The weights of the experts, of shape
+            [num_experts, k, n] and the data type of ``x``. For float16 and
+            bfloat16, ``k`` and ``n`` should be multiples of 8.
+        expert_offsets (Tensor): The int64 end row of each expert, of shape
+            [num_experts]. The last one should be ``num_rows``.
+        name (str, optional): For details, please refer to :ref:`api_guide_Name`. Generally, no setting is required. Default: None.
+
+    Returns:
+        The Tensor of shape [num_rows, n].
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> from paddle.incubate.nn.functional import moe_grouped_gemm
+
+            >>> paddle.set_device('gpu')
+            >>> x = paddle.randn([6, 16])
+            >>> weight = paddle.randn([3, 16, 32])
+            >>> expert_offsets = paddle.to_tensor([2, 2, 6], dtype='int64')
+            >>> out = moe_grouped_gemm(x, weight, expert_offsets)
+            >>> print(out.shape)
+            [6, 32]
+    """
+    _check_mode("moe_grouped_gemm")
+    return _C_ops.moe_grouped_gemm(x, weight, expert_offsets)
+
+
+def moe_unpermute(
+    permuted_y: Tensor,
+    dest_rows: Tensor,
+    weights: Tensor,
+    name: str | None = None,
+) -> Tensor:
+    r"""
+    Brings the expert outputs of :func:`moe_permute` back to their tokens
+    and sums the ``k`` outputs of each token with its routing weights, in
+    one kernel.
+
+    .. math::
+
+        out[t] = \sum_j weights[t, j] \cdot permuted\_y[dest\_rows[j \cdot num\_tokens + t]]
+
+    The sums run in float32. The grad of ``weights`` lets the router learn
+    from the combine.
+
+    Args:
+        permuted_y (Tensor): The expert outputs of shape
+            [num_tokens * k, hidden_size], in the rows of ``permuted_x``.
+        dest_rows (Tensor): The ``dest_rows`` of :func:`moe_permute`.
+        weights (Tensor): The float32 routing weights of shape
+            [num_tokens, k].
+        name (str, optional): For details, please refer to :ref:`api_guide_Name`. Generally, no setting is required. Default: None.
+
+    Returns:
+        The Tensor of shape [num_tokens, hidden_size].
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> from paddle.incubate.nn.functional import (
+            ...     moe_permute,
+            ...     moe_unpermute,
+            ... )
+
+            >>> paddle.set_device('gpu')
+            >>> x = paddle.randn([4, 16])
+            >>> expert_ids = paddle.to_tensor(
+            ...     [[0, 2], [1, 2], [2, 0], [1, 1]], dtype='int32'
+            ... )
+            >>> weights = paddle.full([4, 2], 0.5)
+            >>> permuted_x, expert_offsets, dest_rows = moe_permute(
+            ...     x, expert_ids, 3
+            ... )
+            >>> out = moe_unpermute(permuted_x, dest_rows, weights)
+            >>> print(paddle.allclose(out, x).item())
+            True
+    """
+    _check_mode("moe_unpermute")
+    return _C_ops.moe_unpermute(permuted_y, dest_rows, weights)
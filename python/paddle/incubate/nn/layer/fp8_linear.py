@@ -0,0 +1,162 @@
+# Copyright (c) 2022 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+
+import paddle
+from paddle.incubate.nn import functional as F
+from paddle.nn import Layer, Linear
+
+if TYPE_CHECKING:
+    from paddle import Tensor
+    from paddle._typing import ParamAttrLike
+
+
+class FP8Linear(Layer):
+    r"""
+    Linear layer whose gemms, in forward and backward, run in
+    float8_e4m3fn with delayed scaling, see
+    :ref:`paddle.incubate.nn.functional.fp8_linear`. The scales and the
+    amax history are buffers of the layer, saved in its state dict.
+
+    The layer falls back to the linear of ``paddle.nn.functional`` for the
+    float32 inputs and for the shapes that the fp8 gemm does not support,
+    i.e. whose in_features, out_features or number of rows is not a
+    multiple of 16.
+
+    Parameters:
+        in_features (int): The number of input units.
+        out_features (int): The number of output units.
+        weight_attr (ParamAttr|None, optional): The attribute for the
+            weight of shape [in_features, out_features]. Default: None.
+        bias_attr (ParamAttr|bool|None, optional): The attribute for the
+            bias of shape [out_features], False for no bias. Default: None.
+        amax_history_len (int, optional): The number of steps whose amax
+            the scales come from. Default: 16.
+        margin (int, optional): The scales are divided by ``2 ** margin``
+            more. Default: 0.
+        name (str|None, optional): For details, please refer to
+            :ref:`api_guide_Name`. Default: None.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> from paddle.incubate.nn import FP8Linear
+
+            >>> x = paddle.randn([32, 64]).astype('bfloat16')
+            >>> linear = FP8Linear(64, 128)
+            >>> y = linear(x)
+            >>> print(y.shape)
+            [32, 128]
+    """
+
+    weight: Tensor
+    bias: Tensor | None
+
+    def __init__(
+        self,
+        in_features: int,
+        out_features: int,
+        weight_attr: ParamAttrLike | None = None,
+        bias_attr: ParamAttrLike | None = None,
+        amax_history_len: int = 16,
+        margin: int = 0,
+        name: str | None = None,
+    ) -> None:
+        super().__init__()
+        dtype = self._helper.get_default_dtype()
+        self.weight = self.create_parameter(
+            shape=[in_features, out_features],
+            attr=weight_attr,
+            dtype=dtype,
+            is_bias=False,
+        )
+        self.bias = self.create_parameter(
+            shape=[out_features], attr=bias_attr, dtype=dtype, is_bias=True
+        )
+        self._init_fp8_state(amax_history_len, margin)
+        self.name = name
+
+    def _init_fp8_state(self, amax_history_len, margin):
+        self.margin = margin
+        self.register_buffer(
+            'fp8_scale', paddle.ones([3], dtype='float32'), persistable=True
+        )
+        self.register_buffer(
+            'fp8_amax_history',
+            paddle.zeros([3, amax_history_len], dtype='float32'),
+            persistable=True,
+        )
+
+    def _supports_fp8(self, input: Tensor) -> bool:
+        in_features, out_features = self.weight.shape
+        rows = input.size // max(in_features, 1)
+        return (
+            input.dtype in (paddle.float16, paddle.bfloat16)
+            and in_features % 16 == 0
+            and out_features % 16 == 0
+            and rows % 16 == 0
+        )
+
+    def forward(self, input: Tensor) -> Tensor:
+        if not self._supports_fp8(input):
+            return paddle.nn.functional.linear(
+                input, self.weight, self.bias, self.name
+            )
+        return F.fp8_linear(
+            input,
+            self.weight,
+            self.bias,
+            self.fp8_scale,
+            self.fp8_amax_history,
+            self.margin,
+            self.name,
+        )
+
+    @classmethod
+    def from_linear(
+        cls, linear: Linear, amax_history_len: int = 16, margin: int = 0
+    ) -> FP8Linear:
+        """
+        Returns an FP8Linear sharing the parameters of ``linear``.
+        """
+        layer = cls.__new__(cls)
+        Layer.__init__(layer)
+        layer.weight = linear.weight
+        layer.bias = linear.bias
+        layer._init_fp8_state(amax_history_len, margin)
+        layer.name = linear.name
+        return layer
+
+
+def convert_to_fp8_linear(
+    model: Layer, amax_history_len: int = 16, margin: int = 0
+) -> Layer:
+    """
+    Replaces the ``paddle.nn.Linear`` sublayers of ``model`` in place by
+    FP8Linear layers sharing their parameters, and returns ``model``.
+    """
+    for name, sublayer in model.named_children():
+        if isinstance(sublayer, Linear):
+            setattr(
+                model,
+                name,
+                FP8Linear.from_linear(sublayer, amax_history_len, margin),
+            )
+        else:
+            convert_to_fp8_linear(sublayer, amax_history_len, margin)
+    return model
@@ -14,8 +14,11 @@
 
 from __future__ import annotations
 
+import json
 import logging
 import os
+import tempfile
+import time
 from typing import TYPE_CHECKING, Any, TypedDict
 
 import numpy as np
@@ -38,8 +41,11 @@ if TYPE_CHECKING:
 
     from paddle import Tensor
 
-    class _WhiteList(TypedDict):
+    class _WhiteList(TypedDict, total=False):
         white_list: set[str]
+        calibration_data: list[dict[str, npt.NDArray[Any]]]
+        max_error: float
+        op_speedups: dict[str, float]
 
 
 _logger = get_logger(
@@ -112,8 +118,24 @@ def convert_to_mixed_precision(
         keep_io_types: Whether the model input and output dtype remains unchanged.
             Default is True.
         black_list: Operators that do not convert precision.
-        kwargs: Supported keys including 'white_list'.
+        kwargs: Supported keys including 'white_list', 'calibration_data',
+            'max_error' and 'op_speedups'.
             - white_list: Operators that do convert precision.
+            - calibration_data: A list of feeds, each a dict from the input
+              names to numpy arrays. When given, the operator types to
+              convert are searched, see below.
+            - max_error: The accuracy budget of the search, the largest
+              relative L2 error of the outputs against fp32. Default 1e-3.
+            - op_speedups: The speedups of the operator types converted,
+              which replace the ones measured by the search.
+
+    In the search mode, the model is run on calibration_data in fp32 and with
+    each operator type converted alone, to measure the error and the speedup
+    of each type. The types are then converted by decreasing speedup per
+    error while the errors add up to at most max_error, and the assignment
+    is checked on the whole model, dropping the last types added until the
+    error fits. The chosen assignment is what is converted, and it is saved
+    next to mixed_model_file as <name>.mixed_precision.json.
     '''
     if backend is PlaceType.GPU and not core.is_compiled_with_cuda():
         _logger.error(
@@ -132,6 +154,21 @@ def convert_to_mixed_precision(
     if not os.path.exists(mixed_params_dirname):
         os.makedirs(mixed_params_dirname)
     white_list = kwargs.get('white_list', set())
+    calibration_data = kwargs.get('calibration_data')
+    if calibration_data:
+        black_list = _search_mixed_precision(
+            model_file,
+            params_file,
+            mixed_model_file,
+            mixed_precision,
+            backend,
+            keep_io_types,
+            black_list,
+            white_list,
+            calibration_data,
+            kwargs.get('max_error', 1e-3),
+            kwargs.get('op_speedups', {}),
+        )
     convert_to_mixed_precision_bind(
         model_file,
         params_file,
@@ -145,5 +182,150 @@ def convert_to_mixed_precision(
     )
 
 
+def _run_calibration(model_file, params_file, backend, calibration_data):
+    config = Config(model_file, params_file)
+    if backend is PlaceType.GPU:
+        config.enable_use_gpu(256, 0)
+    config.disable_glog_info()
+    predictor = core.create_predictor(config)
+
+    def run(feed):
+        for name, value in feed.items():
+            predictor.get_input_handle(name).copy_from_cpu(value)
+        predictor.run()
+        return [
+            predictor.get_output_handle(name).copy_to_cpu()
+            for name in predictor.get_output_names()
+        ]
+
+    # warm up before timing
+    run(calibration_data[0])
+    start = time.perf_counter()
+    outputs = [run(feed) for feed in calibration_data]
+    return outputs, time.perf_counter() - start
+
+
+def _relative_error(outputs, ref_outputs):
+    error = 0.0
+    for sample, ref_sample in zip(outputs, ref_outputs):
+        for out, ref in zip(sample, ref_sample):
+            ref = ref.astype(np.float64)
+            diff = np.linalg.norm(out.astype(np.float64) - ref)
+            error = max(error, diff / (np.linalg.norm(ref) + 1e-12))
+    return float(error)
+
+
+def _search_mixed_precision(
+    model_file,
+    params_file,
+    mixed_model_file,
+    mixed_precision,
+    backend,
+    keep_io_types,
+    black_list,
+    white_list,
+    calibration_data,
+    max_error,
+    op_speedups,
+):
+    '''
+    Search the operator types to convert, and return the black list that
+    keeps the others in fp32.
+    '''
+    with open(model_file, 'rb') as f:
+        program_desc = core.ProgramDesc(f.read())
+    op_types = {
+        program_desc.block(i).op(j).type()
+        for i in range(program_desc.num_blocks())
+        for j in range(program_desc.block(i).op_size())
+    }
+    candidates = sorted(
+        op_types - set(black_list) - set(white_list) - {'feed', 'fetch'}
+    )
+
+    ref_outputs, ref_time = _run_calibration(
+        model_file, params_file, backend, calibration_data
+    )
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+
+        def measure(low_precision_ops):
+            model = os.path.join(temp_dir, 'search.pdmodel')
+            params = os.path.join(temp_dir, 'search.pdiparams')
+            convert_to_mixed_precision_bind(
+                model_file,
+                params_file,
+                model,
+                params,
+                mixed_precision,
+                backend,
+                keep_io_types,
+                set(black_list) | (set(candidates) - set(low_precision_ops)),
+                white_list,
+            )
+            outputs, run_time = _run_calibration(
+                model, params, backend, calibration_data
+            )
+            return _relative_error(outputs, ref_outputs), run_time
+
+        errors = {}
+        speedups = {}
+        for op_type in candidates:
+            errors[op_type], run_time = measure([op_type])
+            speedups[op_type] = op_speedups.get(
+                op_type, ref_time / max(run_time, 1e-12)
+            )
+            _logger.info(
+                f"Mixed precision search: {op_type} error {errors[op_type]:.3e}"
+                f" speedup {speedups[op_type]:.3f}"
+            )
+
+        # greedily by speedup per error, the types that do not speed up the
+        # model are left out
+        order = sorted(
+            (t for t in candidates if speedups[t] > 1.0),
+            key=lambda t: (speedups[t] - 1.0) / max(errors[t], 1e-12),
+            reverse=True,
+        )
+        chosen = []
+        total_error = 0.0
+        for op_type in order:
+            if total_error + errors[op_type] <= max_error:
+                chosen.append(op_type)
+                total_error += errors[op_type]
+        # the errors need not add up, check the assignment as a whole
+        error = measure(chosen)[0] if chosen else 0.0
+        while chosen and error > max_error:
+            chosen.pop()
+            error = measure(chosen)[0] if chosen else 0.0
+
+    fp32_ops = sorted(set(candidates) - set(chosen))
+    assignment_file = (
+        os.path.splitext(mixed_model_file)[0] + '.mixed_precision.json'
+    )
+    os.makedirs(
+        os.path.dirname(os.path.abspath(assignment_file)), exist_ok=True
+    )
+    with open(assignment_file, 'w') as f:
+        json.dump(
+            {
+                'mixed_precision': str(mixed_precision),
+                'max_error': max_error,
+                'error': error,
+                'low_precision_ops': sorted(set(chosen) | set(white_list)),
+                'fp32_ops': sorted(set(black_list) | set(fp32_ops)),
+                'op_errors': errors,
+                'op_speedups': speedups,
+            },
+            f,
+            indent=2,
+        )
+    _logger.info(
+        f"Mixed precision search: converted {sorted(chosen)} with error "
+        f"{error:.3e}, the assignment is saved to {assignment_file}"
+    )
+    return set(black_list) | set(fp32_ops)
+
+
 Tensor.copy_from_cpu = tensor_copy_from_cpu
 Tensor.share_external_data = tensor_share_external_data
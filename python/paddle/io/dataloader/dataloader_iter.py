@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import copy
 import itertools
 import logging
 import os
@@ -38,7 +39,7 @@ from ..multiprocess_utils import (
 )
 from .batch_sampler import _InfiniteIterableSampler
 from .collate import default_collate_fn, default_convert_fn
-from .flat import _flatten_batch, _restore_batch
+from .flat import _flatten_batch, _flatten_sample, _restore_batch
 from .worker import (
     _DatasetKind,
     _IterableDatasetStopIteration,
@@ -365,6 +366,79 @@ class _DataLoaderIterSingleProcess(_DataLoaderIterBase):
         self._try_shutdown_all()
 
 
+class _DataLoaderIterThreadPipeline(_DataLoaderIterSingleProcess):
+    """
+    Thread pipeline implement of DataLoaderIter, loading data with
+    num_workers threads of the C++ data pipeline in main process, which
+    stack the samples into batches, in pinned memory if pin_memory, and
+    hand them to the blocking queue without pickling or shared memory
+    """
+
+    def __init__(self, loader):
+        _DataLoaderIterBase.__init__(self, loader)
+        self._pipeline = None
+        self._shutdown = False
+
+        # NOTE: every sample shares the structure of the first one, the
+        # fetch function does not refer to self, for self would not be
+        # collected through the C++ pipeline holding it
+        dataset = self._dataset
+        self._sample_structure = sample_structure = []
+
+        def _fetch(index):
+            flat_sample = []
+            structure = _flatten_sample(dataset[index], flat_sample)
+            if not sample_structure:
+                sample_structure.append(structure)
+            return flat_sample
+
+        self._structure_infos = []
+        self._blocking_queue_capacity = self._prefetch_factor * len(
+            self._places
+        )
+        self._pipeline = core._DataPipeline(
+            _fetch,
+            self._num_workers,
+            self._prefetch_factor * self._num_workers,
+            self._pin_memory,
+        )
+        self._pipeline.reset([list(indices) for indices in self._sampler_iter])
+
+        self._init_thread()
+
+        global _loader
+        _loader = self
+
+    def _thread_loop(self, legacy_expected_place):
+        core.set_current_thread_name("Dataloader_" + str(id(self)))
+        _set_expected_place(legacy_expected_place)
+
+        while not self._thread_done_event.is_set():
+            try:
+                array = self._pipeline.next()
+            except Exception as e:
+                self._exit_thread_unexpectedly()
+                raise e
+
+            if array is None or self._thread_done_event.is_set():
+                break
+
+            self._structure_infos.append(
+                copy.deepcopy(self._sample_structure[0])
+            )
+            try:
+                self._blocking_queue.push(array)
+            except:
+                self._exit_thread_expectedly()
+
+        self._exit_thread_expectedly()
+
+    def _try_shutdown_all(self):
+        if not self._shutdown and self._pipeline is not None:
+            self._pipeline.shutdown()
+        super()._try_shutdown_all()
+
+
 class _DataLoaderIterMultiProcess(_DataLoaderIterBase):
     def __init__(self, loader):
         super().__init__(loader)
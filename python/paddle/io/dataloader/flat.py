@@ -93,6 +93,34 @@ def _flatten_batch(batch):
     return flat_batch, structure
 
 
+def _flatten_sample(sample, flat_sample):
+    """
+    Flatten a sample for the DataLoader thread pipeline, which stacks the
+    samples into batches by itself: every number, numpy.array and Tensor
+    field is appended to flat_sample as a numpy.array, and the structure
+    to restore the batch from the stacked fields by :code:`_restore_batch`
+    is returned
+    """
+    if isinstance(
+        sample, (np.ndarray, paddle.Tensor, paddle.base.core.eager.Tensor)
+    ):
+        if not isinstance(sample, np.ndarray):
+            sample = sample.numpy()
+        flat_sample.append(sample)
+        return f'{FIELD_PREFIX}{len(flat_sample) - 1}'
+    elif isinstance(sample, numbers.Number):
+        flat_sample.append(np.asarray(sample))
+        return f'{FIELD_PREFIX}{len(flat_sample) - 1}'
+    elif isinstance(sample, Mapping):
+        return {k: _flatten_sample(v, flat_sample) for k, v in sample.items()}
+    elif isinstance(sample, Sequence) and not isinstance(sample, (str, bytes)):
+        return [_flatten_sample(field, flat_sample) for field in sample]
+    raise TypeError(
+        "sample data of DataLoader thread worker mode can only contains: "
+        f"tensor, numpy.ndarray, dict, list, number, but got {type(sample)}"
+    )
+
+
 def _restore_batch(flat_batch, structure):
     """
     After reading list of Tensor data from lod_blocking_queue outputs,
@@ -42,6 +42,7 @@ from .dataloader.batch_sampler import _InfiniteIterableSampler
 from .dataloader.dataloader_iter import (
     _DataLoaderIterMultiProcess,
     _DataLoaderIterSingleProcess,
+    _DataLoaderIterThreadPipeline,
     _DatasetKind,
 )
 
@@ -358,6 +359,15 @@ class DataLoader:
             worker id on each subprocess starting if not set as None. Default
             None.
         persistent_workers(bool, optional): whether to keep the workers in the DataLoader. Default False.
+        worker_mode(str, optional): ``'process'`` to load data in :attr:`num_workers`
+            subprocesses, or ``'thread'`` to load it with :attr:`num_workers` threads
+            of a C++ pipeline in main process, which stack the samples into
+            batches directly, without pickling or shared memory. The thread mode
+            suits datasets whose ``__getitem__`` releases the GIL, such as file
+            reading and image decoding, and only works with a map-style dataset
+            and the default :attr:`collate_fn`, falling back to subprocesses
+            otherwise. :attr:`worker_init_fn` is not called in thread mode.
+            Default ``'process'``.
 
     Returns:
         DataLoader: an iterable object for data iterating, each element of the generated data is a Tensor.
@@ -438,6 +448,7 @@ class DataLoader:
     feed_list: Sequence[Tensor] | None
     places: list[_Place]
     num_workers: int
+    worker_mode: str
     dataset_kind: _DatasetKind
     use_shared_memory: bool
     timeout: int
@@ -463,6 +474,7 @@ class DataLoader:
         timeout: int = 0,
         worker_init_fn: Callable[[int], None] | None = None,
         persistent_workers: bool = False,
+        worker_mode: str = 'process',
     ) -> None:
         self.return_list = return_list
         self.collate_fn = collate_fn
@@ -558,6 +570,23 @@ class DataLoader:
 
         self._persistent_workers = persistent_workers
         self._iterator = None
+
+        assert worker_mode in (
+            'process',
+            'thread',
+        ), f"worker_mode should be 'process' or 'thread', but got {worker_mode}"
+        self.worker_mode = worker_mode
+        if worker_mode == 'thread' and (
+            self.dataset_kind != _DatasetKind.MAP
+            or not self.auto_collate_batch
+            or collate_fn is not None
+        ):
+            warnings.warn(
+                "DataLoader thread worker mode only supports map-style dataset "
+                "with automatic batching and the default collate_fn, use "
+                "subprocess workers instead"
+            )
+            self.worker_mode = 'process'
         self.num_workers = AuToTune(self).__call__()
 
     def __len__(self) -> int:
@@ -572,6 +601,8 @@ class DataLoader:
     def __iter__(self) -> _DataLoaderIterBase:
         if self.num_workers == 0:
             return _DataLoaderIterSingleProcess(self)
+        elif self.worker_mode == 'thread':
+            return _DataLoaderIterThreadPipeline(self)
         elif self._persistent_workers:
             if self._iterator is None:
                 self._iterator = _DataLoaderIterMultiProcess(self)
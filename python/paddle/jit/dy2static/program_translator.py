@@ -86,6 +86,10 @@ __all__ = []
 # Once exceeding the threshold, we will raise warning to users to make sure the conversion is as expected.
 MAX_TRACED_PROGRAM_COUNT = 10
 
+# The calls guarded for each traced function, a call maps to one program and
+# inputs of dynamic shape map many calls to the same one.
+MAX_GUARDED_CALL_COUNT = 256
+
 CONVERSION_OPTIONS = "__jst_not_to_static"
 
 
@@ -827,9 +831,19 @@ class ASTStaticFunction(StaticFunction[_InputT, _RetT]):
         args, kwargs = self._function_spec.unified_args_and_kwargs(args, kwargs)
 
         try:
-            _, partial_program_layer = self.get_concrete_program(
-                *args, **kwargs, is_train=self._is_train_mode()
+            is_train = self._is_train_mode()
+            # A call with arguments of the same meta as a former one gets its
+            # program by the guard, without building the CacheKey again.
+            programs = self._program_cache.get_program_by_guard(
+                args, kwargs, is_train
             )
+            if programs is None:
+                _, partial_program_layer = self.get_concrete_program(
+                    *args, **kwargs, is_train=is_train
+                )
+                self._program_cache.add_recent_guard(args, kwargs, is_train)
+            else:
+                _, partial_program_layer = programs
             # 2. synchronize self.training attribute.
             if isinstance(self._class_instance, layers.Layer):
                 partial_program_layer.training = self._class_instance.training
@@ -1594,6 +1608,8 @@ class ProgramCache:
         # trace mostly recent used program
         self._recent_key = None
         self._recent_cache_key = None
+        # {meta of call arguments: (hash_id, cache_key)}, evaluated in C++
+        self._guard_cache = core.ProgramGuardCache(MAX_GUARDED_CALL_COUNT)
 
     def _build_once(self, cache_key):
         # TODO(Aurelius84): Need a gloabl FLAGS to enable/disable to_prim
@@ -1676,6 +1692,31 @@ class ProgramCache:
     def get_program_without_cache(self, cache_key):
         return self._build_once(cache_key=cache_key)
 
+    def get_program_by_guard(self, args, kwargs, is_train):
+        """
+        Returns the program cached for a former call whose arguments have the
+        same meta as args and kwargs, None if there is no such call.
+        """
+        item = self._guard_cache.lookup(args, kwargs, False, is_train)
+        if item is None or item[0] not in self._caches:
+            return None
+        self._recent_key, self._recent_cache_key = item
+        return self._caches[self._recent_key]
+
+    def add_recent_guard(self, args, kwargs, is_train):
+        """
+        Guards the program just got from the cache with the meta of args and
+        kwargs it is got for.
+        """
+        if self._recent_key is not None:
+            self._guard_cache.insert(
+                args,
+                kwargs,
+                False,
+                is_train,
+                (self._recent_key, self._recent_cache_key),
+            )
+
     def get_program(self, item):
         if not isinstance(item, CacheKey):
             raise ValueError(
@@ -1703,6 +1744,7 @@ class ProgramCache:
 
     def clear(self):
         self._caches = collections.OrderedDict()
+        self._guard_cache.clear()
 
 
 class PrimHooker(PartialProgramLayerHook):
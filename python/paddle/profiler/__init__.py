@@ -12,6 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from .continuous_profiler import ContinuousProfiler
+from .memory_timeline import MemoryTimeline
+from .multi_rank import export_rank_chrome_tracing
 from .profiler import (
     Profiler,
     ProfilerState,
@@ -23,7 +26,12 @@ from .profiler import (
     make_scheduler,
 )
 from .profiler_statistic import SortedKeys
-from .utils import RecordEvent, load_profiler_result
+from .utils import (
+    RecordEvent,
+    disable_external_ranges,
+    enable_external_ranges,
+    load_profiler_result,
+)
 
 __all__ = [
     'ProfilerState',
@@ -31,8 +39,13 @@ __all__ = [
     'make_scheduler',
     'export_chrome_tracing',
     'export_protobuf',
+    'export_rank_chrome_tracing',
     'Profiler',
+    'ContinuousProfiler',
+    'MemoryTimeline',
     'RecordEvent',
+    'enable_external_ranges',
+    'disable_external_ranges',
     'load_profiler_result',
     'SortedKeys',
     'SummaryView',
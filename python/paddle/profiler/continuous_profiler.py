@@ -0,0 +1,223 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import annotations
+
+import json
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from typing import TYPE_CHECKING, Any
+from warnings import warn
+
+from paddle.base import core
+from paddle.profiler import utils
+
+from .profiler import ProfilerTarget, _get_supported_targets
+
+if TYPE_CHECKING:
+    from collections.abc import Iterable
+    from types import TracebackType
+
+
+class ContinuousProfiler:
+    r"""
+    A profiler light enough to be left on in a production training. One step
+    every ``sample_interval`` steps is traced, and its host and device
+    events are counted by name instead of kept as a trace, but for a ring of
+    the latest ``max_host_events`` host events. The counters are pulled by
+    :meth:`aggregates`, or over HTTP once :meth:`serve` is called.
+
+    A sampled step synchronizes the devices when it begins and ends, so the
+    overhead is about that of one traced step every ``sample_interval``
+    steps. No step is sampled while a :ref:`Profiler <api_paddle_profiler_Profiler>`
+    is running.
+
+    Args:
+        targets (list, optional): The devices to trace, CPU and GPU when they
+            are supported by default.
+        sample_interval (int, optional): One step traced every
+            ``sample_interval`` steps. Default: 100.
+        max_host_events (int, optional): The latest host events kept.
+            Default: 100000.
+        max_counters (int, optional): The names counted on the host and on
+            the device each, the events of the names beyond are counted
+            together as ``<other>``. Default: 10000.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> import paddle.profiler as profiler
+
+            >>> prof = profiler.ContinuousProfiler(sample_interval=2)
+            >>> prof.start()
+            >>> for step in range(10):
+            ...     x = paddle.randn([64, 64])
+            ...     y = paddle.matmul(x, x)
+            ...     prof.step()
+            >>> prof.stop()
+            >>> print(prof.aggregates()['sampled_steps'])
+            5
+    """
+
+    def __init__(
+        self,
+        *,
+        targets: Iterable[ProfilerTarget] | None = None,
+        sample_interval: int = 100,
+        max_host_events: int = 100000,
+        max_counters: int = 10000,
+    ) -> None:
+        supported_targets = _get_supported_targets()
+        if targets:
+            self.targets = set()
+            for target in targets:
+                if target in supported_targets:
+                    self.targets.add(target)
+                else:
+                    warn(
+                        f"Profiling {target} is not supported in current context."
+                    )
+        else:
+            self.targets = {
+                target
+                for target in supported_targets
+                if target != ProfilerTarget.CUSTOM_DEVICE
+            }
+        self._options = core._ContinuousProfilerOptions()
+        if ProfilerTarget.CPU in self.targets:
+            self._options.trace_switch |= 1
+        if ProfilerTarget.GPU in self.targets:
+            self._options.trace_switch |= 1 << 1
+        if ProfilerTarget.XPU in self.targets:
+            self._options.trace_switch |= 1 << 2
+        if ProfilerTarget.CUSTOM_DEVICE in self.targets:
+            self._options.trace_switch |= 1 << 3
+        self._options.sample_interval = sample_interval
+        self._options.max_host_events = max_host_events
+        self._options.max_counters = max_counters
+        self._server = None
+        self._set_profiler_used = False
+
+    def __enter__(self) -> ContinuousProfiler:
+        self.start()
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_value: BaseException | None,
+        traceback: TracebackType | None,
+    ) -> None:
+        self.stop()
+
+    def start(self) -> None:
+        r"""
+        Start counting the steps, the first one is sampled after
+        ``sample_interval`` steps.
+        """
+        core._enable_continuous_profiler(self._options)
+        # RecordEvent only records while a profiler is used.
+        self._set_profiler_used = not utils._is_profiler_used
+        utils._is_profiler_used = True
+
+    def stop(self) -> None:
+        r"""
+        Stop sampling, keeping the aggregates. The HTTP server keeps serving
+        them until :meth:`shutdown`.
+        """
+        core._disable_continuous_profiler()
+        if self._set_profiler_used:
+            utils._is_profiler_used = False
+            self._set_profiler_used = False
+
+    def step(self) -> None:
+        r"""
+        Signal the end of a step.
+        """
+        core._continuous_profiler_step()
+
+    def reset(self) -> None:
+        r"""
+        Clear the aggregates and the host events kept.
+        """
+        core._reset_continuous_profiler()
+
+    def aggregates(self) -> dict[str, Any]:
+        r"""
+        Get the counters of the sampled steps.
+
+        Returns:
+            dict: The ``steps``, the ``sampled_steps`` and their wall time
+            ``sampled_ns``, the ``dropped_host_events`` out of the ring, and
+            the counters of ``host_events`` and ``device_events`` by name and
+            of ``device_event_types`` by type. A counter has the ``calls``,
+            and the ``total_ns``, ``min_ns`` and ``max_ns`` of the events.
+        """
+        return core._get_continuous_profiler_aggregates()
+
+    def recent_host_events(self) -> list[dict[str, Any]]:
+        r"""
+        Get the latest host events kept, the oldest first.
+        """
+        return core._get_continuous_profiler_host_events()
+
+    def serve(self, port: int, host: str = '127.0.0.1') -> None:
+        r"""
+        Serve the aggregates as JSON over HTTP, at ``/`` or ``/aggregates``,
+        and the latest host events at ``/host_events``, from a daemon thread.
+
+        Args:
+            port (int): The port to listen on, 0 for any free one, which is
+                then :attr:`port`.
+            host (str, optional): The address to listen on. Default:
+                '127.0.0.1'.
+        """
+        if self._server is not None:
+            return
+        profiler = self
+
+        class Handler(BaseHTTPRequestHandler):
+            def do_GET(self):
+                if self.path in ('/', '/aggregates'):
+                    body = profiler.aggregates()
+                elif self.path == '/host_events':
+                    body = profiler.recent_host_events()
+                else:
+                    self.send_error(404)
+                    return
+                data = json.dumps(body).encode()
+                self.send_response(200)
+                self.send_header('Content-Type', 'application/json')
+                self.send_header('Content-Length', str(len(data)))
+                self.end_headers()
+                self.wfile.write(data)
+
+            def log_message(self, format, *args):
+                pass
+
+        self._server = ThreadingHTTPServer((host, port), Handler)
+        self.port = self._server.server_address[1]
+        threading.Thread(
+            target=self._server.serve_forever, daemon=True
+        ).start()
+
+    def shutdown(self) -> None:
+        r"""
+        Stop the HTTP server started by :meth:`serve`.
+        """
+        if self._server is not None:
+            self._server.shutdown()
+            self._server.server_close()
+            self._server = None
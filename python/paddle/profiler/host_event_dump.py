@@ -0,0 +1,197 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import annotations
+
+import argparse
+import json
+import struct
+from typing import Any
+
+# See phi::DumpHostEvents for the format.
+_MAGIC = b'PDHEDMP1'
+_NO_STRING = 0xFFFFFFFF
+_RECORD = struct.Struct('<QQIIBB6x')
+# The types the chrome tracing logger shows on the Python threads.
+_PYTHON_TYPES = {
+    'ProfileStep',
+    'Forward',
+    'Backward',
+    'Dataloader',
+    'Optimization',
+    'PythonOp',
+    'PythonUserDefined',
+}
+
+
+def start_host_event_dump(trace_level: int = 1) -> None:
+    r"""
+    Start recording the host events, e.g. the operators and the interpreter
+    instructions, without a :ref:`Profiler <api_paddle_profiler_Profiler>`.
+    It costs less than a profiler: the events named by a string are
+    recorded with the interned name, and stopping writes the events as they
+    were recorded, which ``convert_host_event_dump`` converts to the chrome
+    tracing format offline, instead of building the event trees. It can not
+    run with a profiler.
+
+    Args:
+        trace_level (int, optional): The host events of a level up to
+            trace_level are recorded. Default is 1, the operators and the
+            instructions.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> from paddle.profiler import host_event_dump
+            >>> host_event_dump.start_host_event_dump()
+            >>> x = paddle.randn([4, 4])
+            >>> y = paddle.matmul(x, x)
+            >>> num_events = host_event_dump.stop_host_event_dump('host.dump')
+            >>> num_events = host_event_dump.convert_host_event_dump(
+            ...     'host.dump', 'host.paddle_trace.json'
+            ... )
+    """
+    from paddle.base import core
+
+    core._start_host_event_dump(trace_level)
+
+
+def stop_host_event_dump(path: str) -> int:
+    r"""
+    Stop recording the host events, and write them to path in a compact
+    binary format. Returns the number of events written.
+    """
+    from paddle.base import core
+
+    return core._stop_host_event_dump(path)
+
+
+def load_host_event_dump(path: str) -> dict[str, Any]:
+    r"""
+    Read a dump written by ``stop_host_event_dump``, as a dict of the
+    ``process_id`` and of the ``threads``, each with its ``thread_id``,
+    ``thread_name`` and ``events``. An event is a dict of its ``name``,
+    ``type``, ``start_ns``, ``end_ns`` and ``attr``, which is None if the
+    event has no attribute.
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if not data.startswith(_MAGIC):
+        raise ValueError(f'{path} is not a host event dump.')
+    offset = len(_MAGIC)
+
+    def read(fmt):
+        nonlocal offset
+        values = struct.unpack_from(fmt, data, offset)
+        offset += struct.calcsize(fmt)
+        return values if len(values) > 1 else values[0]
+
+    process_id = read('<Q')
+    strings = []
+    for _ in range(read('<I')):
+        length = read('<I')
+        strings.append(data[offset : offset + length].decode(errors='replace'))
+        offset += length
+    types = [strings[read('<I')] for _ in range(read('<I'))]
+
+    threads = []
+    for _ in range(read('<I')):
+        thread_id, name_id, num_events = read('<QIQ')
+        end = offset + num_events * _RECORD.size
+        events = []
+        for record in _RECORD.iter_unpack(data[offset:end]):
+            start_ns, end_ns, event_name, attr, type_id, _ = record
+            events.append(
+                {
+                    'name': strings[event_name],
+                    'type': (
+                        types[type_id] if type_id < len(types) else 'Unknown'
+                    ),
+                    'start_ns': start_ns,
+                    'end_ns': end_ns,
+                    'attr': None if attr == _NO_STRING else strings[attr],
+                }
+            )
+        offset = end
+        threads.append(
+            {
+                'thread_id': thread_id,
+                'thread_name': strings[name_id],
+                'events': events,
+            }
+        )
+    return {'process_id': process_id, 'threads': threads}
+
+
+def convert_host_event_dump(path: str, output: str) -> int:
+    r"""
+    Convert a dump written by ``stop_host_event_dump`` to the chrome tracing
+    format of the traces exported by the profiler, and return the number of
+    events.
+    """
+    dump = load_host_event_dump(path)
+    pid = dump['process_id']
+    trace_events = []
+    num_events = 0
+    for thread in dump['threads']:
+        tid = thread['thread_id']
+        for suffix in ('Python', 'C++'):
+            trace_events.append(
+                {
+                    'name': 'thread_name',
+                    'ph': 'M',
+                    'pid': pid,
+                    'tid': f'{tid}({suffix})',
+                    'args': {'name': f"{thread['thread_name']}({suffix})"},
+                }
+            )
+        for event in thread['events']:
+            dur_ms = (event['end_ns'] - event['start_ns']) / 1e6
+            if dur_ms > 1.0:
+                dur_display = f'{dur_ms:.3f} ms'
+            else:
+                dur_display = f'{dur_ms * 1000:.3f} us'
+            suffix = 'Python' if event['type'] in _PYTHON_TYPES else 'C++'
+            trace_event = {
+                'name': f"{event['name']}[{dur_display}]",
+                'pid': pid,
+                'tid': f'{tid}({suffix})',
+                'ts': event['start_ns'] // 1000,
+                'dur': round(dur_ms * 1000, 3),
+                'ph': 'X',
+                'cat': event['type'],
+            }
+            if event['attr'] is not None:
+                trace_event['args'] = {'attr': event['attr']}
+            trace_events.append(trace_event)
+            num_events += 1
+    with open(output, 'w') as f:
+        json.dump({'displayTimeUnit': 'ms', 'traceEvents': trace_events}, f)
+    return num_events
+
+
+def main(argv: list[str] | None = None) -> None:
+    parser = argparse.ArgumentParser(
+        description='Convert a host event dump to the chrome tracing format.'
+    )
+    parser.add_argument('path', help='the host event dump')
+    parser.add_argument('output', help='the chrome trace to write')
+    args = parser.parse_args(argv)
+    num_events = convert_host_event_dump(args.path, args.output)
+    print(f'Converted {num_events} host events to {args.output}.')
+
+
+if __name__ == '__main__':
+    main()
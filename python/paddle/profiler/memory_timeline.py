@@ -0,0 +1,210 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import annotations
+
+import json
+from typing import TYPE_CHECKING, Any
+
+from paddle.base import core
+
+if TYPE_CHECKING:
+    from types import TracebackType
+
+# The allocator layer of the memory event types.
+_LAYERS = {
+    'Allocate': 'allocated',
+    'Free': 'allocated',
+    'ReservedAllocate': 'reserved',
+    'ReservedFree': 'reserved',
+}
+
+
+class MemoryTimeline:
+    r"""
+    Record every allocation and free between :meth:`start` and :meth:`stop`,
+    with its time, size, place, allocator layer, the op issuing it and
+    optionally the Python stack allocating it, and tell which ops and stacks
+    hold the memory when it peaks.
+
+    The ``allocated`` layer has the allocations handed to the tensors, and
+    the ``reserved`` layer the memory the allocators ask the device or the
+    system for. The op is the name of the dygraph API, or of the operator
+    run by the static graph executor.
+
+    Args:
+        record_stack (bool, optional): Record the Python stack of the
+            allocations, which slows them down noticeably. Only the
+            allocations of a thread running Python have a stack.
+            Default: False.
+        max_events (int, optional): The events kept, the events beyond are
+            only accounted in the peaks. Default: 1000000.
+
+    Examples:
+        .. code-block:: python
+
+            >>> import paddle
+            >>> import paddle.profiler as profiler
+
+            >>> with profiler.MemoryTimeline(record_stack=True) as timeline:
+            ...     x = paddle.randn([1024, 1024])
+            ...     y = paddle.matmul(x, x)
+            >>> print(timeline.summary())
+            >>> timeline.export('memory_timeline.json')
+    """
+
+    def __init__(
+        self, *, record_stack: bool = False, max_events: int = 1000000
+    ) -> None:
+        self.record_stack = record_stack
+        self.max_events = max_events
+        self._result = None
+
+    def __enter__(self) -> MemoryTimeline:
+        self.start()
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_value: BaseException | None,
+        traceback: TracebackType | None,
+    ) -> None:
+        self.stop()
+
+    def start(self) -> None:
+        r"""
+        Discard the previous records and start recording.
+        """
+        self._result = None
+        core._start_memory_timeline(self.max_events, self.record_stack)
+
+    def stop(self) -> None:
+        r"""
+        Stop recording, the records are kept until the next :meth:`start`.
+        """
+        core._stop_memory_timeline()
+
+    def _get(self) -> dict[str, Any]:
+        if self._result is None:
+            self._result = core._get_memory_timeline()
+        return self._result
+
+    def _name(self, index: int) -> str | None:
+        return self._get()['names'][index] if index >= 0 else None
+
+    def events(self) -> list[dict[str, Any]]:
+        r"""
+        Get the events in the order they were recorded.
+
+        Returns:
+            list: A dict per event with the ``time_ns``, ``ptr``, ``size``,
+            ``place``, ``layer``, ``type``, ``op`` and ``stack``, the last two
+            are None when unknown.
+        """
+        events = self._get()['events']
+        return [
+            {
+                'time_ns': time_ns,
+                'ptr': ptr,
+                'size': size,
+                'place': place,
+                'layer': _LAYERS.get(event_type, event_type),
+                'type': event_type,
+                'op': self._name(op),
+                'stack': self._name(stack),
+            }
+            for time_ns, ptr, size, place, event_type, op, stack in events
+        ]
+
+    def dropped_events(self) -> int:
+        r"""
+        Get the number of the events beyond ``max_events``.
+        """
+        return self._get()['dropped_events']
+
+    def peak_report(self, top_k: int | None = None) -> list[dict[str, Any]]:
+        r"""
+        Get who holds the allocated memory of each place at its peak.
+
+        Args:
+            top_k (int, optional): The holders kept per place, all of them
+                by default.
+
+        Returns:
+            list: A dict per place with the ``place``, the ``peak_allocated``
+            bytes and the ``peak_time_ns``, the ``peak_reserved`` bytes, and
+            the ``holders`` sorted by bytes, each with the ``op``, ``stack``,
+            ``bytes`` and ``count`` of the live allocations.
+        """
+        report = []
+        for peak in self._get()['peaks']:
+            holders = peak['holders'][:top_k]
+            report.append(
+                {
+                    **peak,
+                    'holders': [
+                        {
+                            **holder,
+                            'op': self._name(holder['op']),
+                            'stack': self._name(holder['stack']),
+                        }
+                        for holder in holders
+                    ],
+                }
+            )
+        return report
+
+    def summary(self, top_k: int = 10) -> str:
+        r"""
+        Format the :meth:`peak_report` as a table per place.
+
+        Args:
+            top_k (int, optional): The holders shown per place. Default: 10.
+        """
+        lines = []
+        for peak in self.peak_report(top_k):
+            mb = 1024.0 * 1024.0
+            lines.append(
+                f"{peak['place']}: peak allocated "
+                f"{peak['peak_allocated'] / mb:.2f} MB, peak reserved "
+                f"{peak['peak_reserved'] / mb:.2f} MB"
+            )
+            lines.append(f"  {'MB':>10}  {'count':>8}  op")
+            for holder in peak['holders']:
+                lines.append(
+                    f"  {holder['bytes'] / mb:>10.2f}  {holder['count']:>8}  "
+                    f"{holder['op'] or '<unknown>'}"
+                )
+                if holder['stack']:
+                    frames = holder['stack'].splitlines()
+                    lines.extend(f"{'':>24}{frame}" for frame in frames[:3])
+        return '\n'.join(lines)
+
+    def export(self, path: str) -> None:
+        r"""
+        Save the events, the peak report and the dropped events as JSON.
+
+        Args:
+            path (str): The file to write.
+        """
+        with open(path, 'w') as f:
+            json.dump(
+                {
+                    'events': self.events(),
+                    'peaks': self.peak_report(),
+                    'dropped_events': self.dropped_events(),
+                },
+                f,
+            )
@@ -0,0 +1,548 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import annotations
+
+import argparse
+import bisect
+import datetime
+import glob
+import json
+import os
+import re
+import socket
+import time
+from collections import defaultdict
+from typing import TYPE_CHECKING, Any, Callable
+
+if TYPE_CHECKING:
+    from .profiler import Profiler
+
+# The name of the host events of ProcessGroupNCCL, the pair is only set for
+# the point to point communications.
+_COLLECTIVE_PATTERN = re.compile(
+    r'^ProcessGroupNCCL::(\w+)#gid=(\d+)(?:#pair=([^#]+))?#seq=(\d+)$'
+)
+# The duration the chrome tracing logger appends to the names.
+_DURATION_SUFFIX = re.compile(r'\[[^\[\]]*\]$')
+_TRACE_PATTERN = re.compile(r'^rank(\d+)_time_.*\.paddle_trace\.json$')
+
+
+def _strip_duration(name: str) -> str:
+    return _DURATION_SUFFIX.sub('', name)
+
+
+def measure_clock_offset(
+    store: Any,
+    rank: int,
+    world_size: int,
+    rounds: int = 8,
+    prefix: str = 'profiler/clock',
+) -> dict[str, int]:
+    r"""
+    Measure how far the clock of this rank is from the clock of rank 0, the
+    way NTP does: rank 0 answers ``rounds`` pings of each rank through the
+    store with its time, and the round with the shortest round trip gives the
+    offset. Every rank must call it, with the same ``rounds``.
+
+    Args:
+        store: A store with ``set`` and a blocking ``get``, as the TCPStore
+            of ``paddle.base.core.create_or_get_global_tcp_store()``.
+        rank (int): The rank of the caller.
+        world_size (int): The number of ranks.
+        rounds (int, optional): The pings per rank. Default: 8.
+        prefix (str, optional): The prefix of the keys, which must differ
+            between the measures through one store. Default:
+            'profiler/clock'.
+
+    Returns:
+        dict: The ``offset_ns`` to add to the times of this rank to get the
+        times of rank 0, and the ``rtt_ns`` of the round it comes from, both
+        0 on rank 0.
+    """
+    if rank == 0:
+        for peer in range(1, world_size):
+            for i in range(rounds):
+                store.get(f'{prefix}/{peer}/{i}/ping')
+                store.set(f'{prefix}/{peer}/{i}/pong', str(time.time_ns()))
+        return {'offset_ns': 0, 'rtt_ns': 0}
+
+    best = None
+    for i in range(rounds):
+        start = time.time_ns()
+        store.set(f'{prefix}/{rank}/{i}/ping', str(start))
+        remote = int(store.get(f'{prefix}/{rank}/{i}/pong'))
+        end = time.time_ns()
+        rtt = end - start
+        if best is None or rtt < best['rtt_ns']:
+            offset = remote - (start + end) // 2
+            best = {'offset_ns': offset, 'rtt_ns': rtt}
+    return best
+
+
+def export_rank_chrome_tracing(
+    dir_name: str,
+    rank: int | None = None,
+    world_size: int | None = None,
+    store: Any = None,
+    rounds: int = 8,
+) -> Callable[[Profiler], None]:
+    r"""
+    Return a callable for ``on_trace_ready`` of
+    :ref:`Profiler <api_paddle_profiler_Profiler>`, which exports the trace of
+    each rank of a distributed training to ``dir_name`` as
+    ``rank{rank}_time_{time}.paddle_trace.json``, and the offset of its clock
+    to the clock of rank 0 to ``rank{rank}.clock.json``, for
+    :func:`analyze_stragglers` to merge the traces of the ranks.
+
+    The offset is measured when the trace is ready, so all the ranks must
+    get their traces ready together, which they do with the same scheduler.
+
+    Args:
+        dir_name (str): The directory shared by the ranks.
+        rank (int, optional): The rank, ``paddle.distributed.get_rank()`` by
+            default.
+        world_size (int, optional): The number of ranks,
+            ``paddle.distributed.get_world_size()`` by default.
+        store (optional): The store to measure the offset through, the global
+            TCPStore by default. The offset is 0 with one rank.
+        rounds (int, optional): The pings of :func:`measure_clock_offset`.
+            Default: 8.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +SKIP('Need a distributed launch')
+            >>> import paddle.profiler as profiler
+            >>> with profiler.Profiler(
+            ...     scheduler=(3, 10),
+            ...     on_trace_ready=profiler.export_rank_chrome_tracing('./log'),
+            ... ) as p:
+            ...     for iter in range(10):
+            ...         # train()
+            ...         p.step()
+
+        Then ``python -m paddle.profiler.multi_rank ./log --merged
+        merged.json`` merges the traces and prints the stragglers.
+    """
+    os.makedirs(dir_name, exist_ok=True)
+    measures = 0
+
+    def handle_fn(prof):
+        nonlocal rank, world_size, store, measures
+        if rank is None or world_size is None:
+            import paddle.distributed as dist
+
+            rank = dist.get_rank() if rank is None else rank
+            if world_size is None:
+                world_size = dist.get_world_size()
+        clock = {'offset_ns': 0, 'rtt_ns': 0}
+        if world_size > 1:
+            if store is None:
+                from paddle.base import core
+
+                store = core.create_or_get_global_tcp_store()
+            measures += 1
+            clock = measure_clock_offset(
+                store,
+                rank,
+                world_size,
+                rounds,
+                f'profiler/clock/{dir_name}/{measures}',
+            )
+        now = datetime.datetime.now()
+        filename = 'rank{}_time_{}.paddle_trace.json'.format(
+            rank, now.strftime('%Y_%m_%d_%H_%M_%S_%f')
+        )
+        prof.export(os.path.join(dir_name, filename), "json")
+        clock.update(
+            {
+                'rank': rank,
+                'hostname': socket.gethostname(),
+                'pid': os.getpid(),
+            }
+        )
+        with open(os.path.join(dir_name, f'rank{rank}.clock.json'), 'w') as f:
+            json.dump(clock, f)
+
+    return handle_fn
+
+
+def load_rank_traces(dir_name: str) -> dict[int, list[dict[str, Any]]]:
+    r"""
+    Load the traces exported by :func:`export_rank_chrome_tracing`, the
+    latest one of each rank, with their times moved to the clock of rank 0.
+
+    Returns:
+        dict: The complete events, those with a duration, of each rank. The
+        names lose the duration the logger appends to them.
+    """
+    latest = {}
+    pattern = os.path.join(dir_name, '*.paddle_trace.json')
+    for path in sorted(glob.glob(pattern)):
+        match = _TRACE_PATTERN.match(os.path.basename(path))
+        if match:
+            # The time in the name sorts the traces of a rank.
+            latest[int(match.group(1))] = path
+    traces = {}
+    for rank, path in sorted(latest.items()):
+        offset_us = 0.0
+        clock_path = os.path.join(dir_name, f'rank{rank}.clock.json')
+        if os.path.exists(clock_path):
+            with open(clock_path) as f:
+                offset_us = json.load(f)['offset_ns'] / 1000.0
+        with open(path) as f:
+            data = json.load(f)
+        events = []
+        for event in data.get('traceEvents', []):
+            if event.get('ph') != 'X':
+                continue
+            event = dict(event)
+            event['name'] = _strip_duration(event['name'])
+            event['ts'] = event['ts'] + offset_us
+            events.append(event)
+        traces[rank] = events
+    return traces
+
+
+def merge_rank_traces(
+    traces: dict[int, list[dict[str, Any]]], path: str
+) -> None:
+    r"""
+    Write the traces of the ranks as one chrome trace, a process per process
+    or device of each rank.
+    """
+    pids = {}
+    merged = []
+    for rank, events in sorted(traces.items()):
+        for event in events:
+            key = (rank, event['pid'])
+            if key not in pids:
+                pids[key] = len(pids)
+                kind = 'CPU' if isinstance(event['tid'], str) else 'Device'
+                merged.append(
+                    {
+                        'name': 'process_name',
+                        'ph': 'M',
+                        'pid': pids[key],
+                        'args': {'name': f'rank {rank} {kind} {event["pid"]}'},
+                    }
+                )
+                merged.append(
+                    {
+                        'name': 'process_sort_index',
+                        'ph': 'M',
+                        'pid': pids[key],
+                        'args': {'sort_index': pids[key]},
+                    }
+                )
+            merged.append({**event, 'pid': pids[key]})
+    with open(path, 'w') as f:
+        json.dump({'displayTimeUnit': 'ms', 'traceEvents': merged}, f)
+
+
+def _union_us(intervals: list[tuple[float, float]]) -> float:
+    total = 0.0
+    end = None
+    for start, stop in sorted(intervals):
+        if end is None or start > end:
+            total += stop - start
+            end = stop
+        elif stop > end:
+            total += stop - end
+            end = stop
+    return total
+
+
+def _is_comm_kernel(name: str) -> bool:
+    return 'nccl' in name.lower()
+
+
+def _rank_collectives(
+    events: list[dict[str, Any]],
+) -> dict[tuple, dict[str, Any]]:
+    # The collectives of a rank by their key common to the ranks, with the
+    # span of their kernel, or of their host event when it has none.
+    kernels = {}
+    runtimes = []
+    for event in events:
+        if event.get('cat') == 'Kernel':
+            correlation = event.get('args', {}).get('correlation id')
+            if correlation is not None:
+                kernels[correlation] = event
+        elif event.get('cat') == 'CudaRuntime':
+            runtimes.append(event)
+    runtimes.sort(key=lambda event: event['ts'])
+    starts = [event['ts'] for event in runtimes]
+
+    collectives = {}
+    for event in events:
+        match = _COLLECTIVE_PATTERN.match(event['name'])
+        if event.get('cat') != 'Communication' or match is None:
+            continue
+        op, gid, pair, seq = match.groups()
+        start, end = event['ts'], event['ts'] + event['dur']
+        span = None
+        first = bisect.bisect_left(starts, start)
+        for runtime in runtimes[first:]:
+            if runtime['ts'] > end:
+                break
+            if runtime['tid'] != event['tid']:
+                continue
+            correlation = runtime.get('args', {}).get('correlation id')
+            kernel = kernels.get(correlation)
+            if kernel is not None and _is_comm_kernel(kernel['name']):
+                span = (kernel['ts'], kernel['ts'] + kernel['dur'])
+        if span is None:
+            span = (start, end)
+        collectives[(op, int(gid), pair or '', int(seq))] = {
+            'start': span[0],
+            'end': span[1],
+        }
+    if collectives:
+        return collectives
+
+    # Without the events of ProcessGroupNCCL, the communication kernels are
+    # matched by their name and their order, which holds for one group.
+    occurrences = defaultdict(int)
+    for event in sorted(kernels.values(), key=lambda event: event['ts']):
+        if _is_comm_kernel(event['name']):
+            occurrences[event['name']] += 1
+            key = (event['name'], 0, '', occurrences[event['name']])
+            collectives[key] = {
+                'start': event['ts'],
+                'end': event['ts'] + event['dur'],
+            }
+    return collectives
+
+
+def _collective_name(key: tuple) -> str:
+    op, gid, pair, seq = key
+    pair = f' pair={pair}' if pair else ''
+    return f'{op} gid={gid}{pair} seq={seq}'
+
+
+def analyze_stragglers(
+    traces: dict[int, list[dict[str, Any]]],
+) -> dict[str, Any]:
+    r"""
+    Tell, step by step, which rank holds the others back.
+
+    A collective starts on a rank when its kernel starts, and can only move
+    data once it started on every rank, so a rank waits in it for the rank
+    starting last. For each step and rank, the step time is split into the
+    time computing, the time waiting in the collectives and the time moving
+    data. The critical path of a step goes through its collectives in order,
+    each reached last by its critical rank, which makes the others wait for
+    its lateness, the time between its start and the start before.
+
+    Args:
+        traces (dict): The traces of the ranks, from
+            :func:`load_rank_traces`.
+
+    Returns:
+        dict: The ``steps``, each with its ``step``, the ``ranks`` with
+        their ``step_ms``, ``compute_ms``, ``comm_ms``, ``wait_ms`` and
+        ``late_count``, the ``straggler``, the rank making the others wait
+        most, the ``critical_path`` and the ``collectives`` matched on all
+        the ranks. Also the ``ranks`` summed over the steps.
+    """
+    windows = defaultdict(dict)
+    for rank, events in traces.items():
+        for event in events:
+            if event.get('cat') == 'ProfileStep':
+                windows[event['name']][rank] = (
+                    event['ts'],
+                    event['ts'] + event['dur'],
+                )
+    collectives = {
+        rank: _rank_collectives(events) for rank, events in traces.items()
+    }
+    ranks = sorted(traces)
+
+    def step_number(name):
+        match = re.search(r'(\d+)$', name)
+        return int(match.group(1)) if match else -1
+
+    steps = []
+    totals = {
+        rank: defaultdict(float, {'late_count': 0, 'caused_wait_ms': 0.0})
+        for rank in ranks
+    }
+    for name in sorted(windows, key=step_number):
+        window = windows[name]
+        if len(window) != len(ranks):
+            continue
+
+        def inside(rank, span, window=window):
+            return window[rank][0] <= span['start'] < window[rank][1]
+
+        keys = set.intersection(
+            *[
+                {
+                    key
+                    for key, span in collectives[rank].items()
+                    if inside(rank, span)
+                }
+                for rank in ranks
+            ]
+        )
+        stats = {
+            rank: {
+                'step_ms': (window[rank][1] - window[rank][0]) / 1000.0,
+                'wait_ms': 0.0,
+                'late_count': 0,
+                'caused_wait_ms': 0.0,
+            }
+            for rank in ranks
+        }
+        matched = []
+        for key in keys:
+            starts = {rank: collectives[rank][key]['start'] for rank in ranks}
+            last = max(ranks, key=lambda rank: starts[rank])
+            arrival = starts[last]
+            waits = {rank: (arrival - starts[rank]) / 1000.0 for rank in ranks}
+            for rank in ranks:
+                stats[rank]['wait_ms'] += waits[rank]
+            stats[last]['late_count'] += 1
+            stats[last]['caused_wait_ms'] += sum(waits.values())
+            matched.append(
+                {
+                    'name': _collective_name(key),
+                    'arrival': arrival,
+                    'last_rank': last,
+                    'wait_ms': waits,
+                    'end': max(collectives[rank][key]['end'] for rank in ranks),
+                }
+            )
+        matched.sort(key=lambda collective: collective['arrival'])
+
+        for rank in ranks:
+            begin, end = window[rank]
+            compute, comm = [], []
+            for event in traces[rank]:
+                if event.get('cat') != 'Kernel':
+                    continue
+                start = max(event['ts'], begin)
+                stop = min(event['ts'] + event['dur'], end)
+                if start < stop:
+                    spans = comm if _is_comm_kernel(event['name']) else compute
+                    spans.append((start, stop))
+            stats[rank]['compute_ms'] = _union_us(compute) / 1000.0
+            stats[rank]['comm_ms'] = _union_us(comm) / 1000.0
+
+        critical_path = []
+        previous = min(window[rank][0] for rank in ranks)
+        for collective in matched:
+            critical_path.append(
+                {
+                    'collective': collective['name'],
+                    'rank': collective['last_rank'],
+                    'lateness_ms': (collective['arrival'] - previous) / 1000.0,
+                }
+            )
+            previous = collective['end']
+        for collective in matched:
+            del collective['arrival'], collective['end']
+
+        straggler = None
+        if matched:
+            straggler = max(
+                ranks, key=lambda rank: stats[rank]['caused_wait_ms']
+            )
+        for rank in ranks:
+            for field, value in stats[rank].items():
+                totals[rank][field] += value
+        steps.append(
+            {
+                'step': step_number(name),
+                'ranks': stats,
+                'straggler': straggler,
+                'critical_path': critical_path,
+                'collectives': matched,
+            }
+        )
+    return {
+        'steps': steps,
+        'ranks': {rank: dict(total) for rank, total in totals.items()},
+    }
+
+
+def format_report(report: dict[str, Any]) -> str:
+    r"""
+    Format the report of :func:`analyze_stragglers` as a table per step.
+    """
+    lines = []
+    header = (
+        f"  {'rank':>6}{'step(ms)':>12}{'compute(ms)':>14}{'comm(ms)':>12}"
+        f"{'wait(ms)':>12}{'last in':>10}{'caused(ms)':>13}"
+    )
+
+    def row(rank, stats):
+        return (
+            f"  {rank:>6}{stats['step_ms']:>12.3f}{stats['compute_ms']:>14.3f}"
+            f"{stats['comm_ms']:>12.3f}{stats['wait_ms']:>12.3f}"
+            f"{stats['late_count']:>10}{stats['caused_wait_ms']:>13.3f}"
+        )
+
+    for step in report['steps']:
+        lines.append(
+            f"Step {step['step']}: straggler rank {step['straggler']}, "
+            f"{len(step['collectives'])} collectives"
+        )
+        lines.append(header)
+        for rank, stats in sorted(step['ranks'].items()):
+            lines.append(row(rank, stats))
+        worst = sorted(
+            step['critical_path'],
+            key=lambda item: item['lateness_ms'],
+            reverse=True,
+        )[:3]
+        for item in worst:
+            lines.append(
+                f"    critical: rank {item['rank']} reached "
+                f"{item['collective']} after {item['lateness_ms']:.3f} ms"
+            )
+    if report['steps']:
+        lines.append('All steps:')
+        lines.append(header)
+        for rank, stats in sorted(report['ranks'].items()):
+            lines.append(row(rank, stats))
+    return '\n'.join(lines)
+
+
+def main(argv: list[str] | None = None) -> None:
+    parser = argparse.ArgumentParser(
+        description='Merge the traces of the ranks exported by '
+        'paddle.profiler.export_rank_chrome_tracing and find the stragglers.'
+    )
+    parser.add_argument('dir_name', help='the directory of the traces')
+    parser.add_argument('--merged', help='write the merged chrome trace')
+    parser.add_argument('--report', help='write the report as JSON')
+    args = parser.parse_args(argv)
+
+    traces = load_rank_traces(args.dir_name)
+    if not traces:
+        raise SystemExit(f'No rank trace found in {args.dir_name}.')
+    if args.merged:
+        merge_rank_traces(traces, args.merged)
+    report = analyze_stragglers(traces)
+    if args.report:
+        with open(args.report, 'w') as f:
+            json.dump(report, f, indent=2)
+    print(format_report(report))
+
+
+if __name__ == '__main__':
+    main()
@@ -73,6 +73,8 @@ class SummaryView(Enum):
     - **SummaryView.MemoryManipulationView** : The memory manipulation summary view.
 
     - **SummaryView.UDFView** : The user defined summary view.
+
+    - **SummaryView.RooflineView** : The roofline summary view, of the ops whose shapes are recorded.
     """
 
     DeviceView = 0
@@ -84,6 +86,7 @@ class SummaryView(Enum):
     MemoryView = 6
     MemoryManipulationView = 7
     UDFView = 8
+    RooflineView = 9
 
 
 class ProfilerState(Enum):
@@ -887,9 +890,11 @@ class Profiler:
         thread_sep: bool = False,
         time_unit: Literal['s', 'ms', 'us', 'ns'] = 'ms',
         views: SummaryView | list[SummaryView] | None = None,
+        peak_tflops: float | None = None,
+        peak_gbps: float | None = None,
     ) -> None:
         r"""
-        Print the Summary table. Currently support overview, model, distributed, operator, memory manipulation and user-defined summary.
+        Print the Summary table. Currently support overview, model, distributed, operator, kernel, roofline, memory manipulation and user-defined summary.
 
         Args:
             sorted_by( :ref:`SortedKeys <api_paddle_profiler_SortedKeys>` , optional): how to rank the op table items, default value is SortedKeys.CPUTotal.
@@ -897,6 +902,8 @@ class Profiler:
             thread_sep(bool, optional): print op table each thread, default value is False.
             time_unit(str, optional): time unit for display, can be chosen from ['s', 'ms', 'us', 'ns'], default value is 'ms'.
             views(SummaryView|list[SummaryView], optional): summary tables to print, default to None means all views to be printed.
+            peak_tflops(float, optional): the peak TFLOPS of the device for the dtype of the model, to tell the memory bound ops from the compute bound ones and their headroom in the roofline summary, which needs ``record_shapes``. Default value is None.
+            peak_gbps(float, optional): the peak memory bandwidth of the device in GB/s, used with ``peak_tflops``. Default value is None.
 
         Examples:
             .. code-block:: python
@@ -932,6 +939,8 @@ class Profiler:
                     thread_sep=thread_sep,
                     time_unit=time_unit,
                     views=views,
+                    peak_tflops=peak_tflops,
+                    peak_gbps=peak_gbps,
                 )
             )
 
@@ -79,6 +79,44 @@ class SortedKeys(Enum):
     GPUMin = 7
 
 
+# The element sizes of the dtypes recorded with the op shapes.
+_DTYPE_ITEMSIZE = {
+    'BOOL': 1,
+    'INT8': 1,
+    'UINT8': 1,
+    'FP8_E4M3FN': 1,
+    'FP8_E5M2': 1,
+    'INT16': 2,
+    'FP16': 2,
+    'BF16': 2,
+    'INT32': 4,
+    'FP32': 4,
+    'INT64': 8,
+    'FP64': 8,
+    'COMPLEX64': 8,
+    'COMPLEX128': 16,
+}
+
+
+def _input_bytes(input_shapes, dtypes):
+    r'''
+    The bytes of the inputs of an op. The dygraph ops record no dtype, their
+    elements are taken as 4 bytes.
+    '''
+    total = 0
+    for name, shapes in input_shapes.items():
+        names_dtypes = dtypes.get(name, [])
+        for i, shape in enumerate(shapes):
+            numel = 1
+            for dim in shape:
+                numel *= max(dim, 0)
+            itemsize = 4
+            if i < len(names_dtypes):
+                itemsize = _DTYPE_ITEMSIZE.get(names_dtypes[i], 4)
+            total += numel * itemsize
+    return total
+
+
 def _nodename2opname(name):
     r'''
     convert static host node name to operator name
@@ -105,6 +143,7 @@ class HostStatisticNode:
         self.general_gpu_time = 0  # besides kernel, include time of gpu events like memcpy and memset
         self.self_general_gpu_time = 0
         self.flops = 0
+        self.bytes = 0
 
     def cal_flops(self):
         if self.hostnode.type == TracerEventType.Operator:
@@ -116,17 +155,28 @@ class HostStatisticNode:
                     self.hostnode.attributes,
                 )
 
+    def cal_bytes(self):
+        if self.hostnode.type == TracerEventType.Operator:
+            if hasattr(self.hostnode, 'input_shapes'):
+                self.bytes = _input_bytes(
+                    self.hostnode.input_shapes,
+                    getattr(self.hostnode, 'dtypes', {}),
+                )
+
     def cal_statistic(self):
         self.cpu_time = self.hostnode.end_ns - self.hostnode.start_ns
         self.self_cpu_time = self.cpu_time
         self.cal_flops()
+        self.cal_bytes()
         for child in self.children_node:
             child.cal_flops()
+            child.cal_bytes()
             child.cal_statistic()
             self.gpu_time += child.gpu_time
             self.general_gpu_time += child.general_gpu_time
             self.self_cpu_time -= child.end_ns - child.start_ns
             self.flops += child.flops
+            self.bytes += child.bytes
 
         for rt in self.runtime_node:
             rt.cal_statistic()
@@ -521,11 +571,16 @@ class EventSummary:
             self.min_general_gpu_time = float('inf')
             self.max_general_gpu_time = 0
             self._flops = 0
+            self._bytes = 0
 
         @property
         def flops(self):
             return self._flops
 
+        @property
+        def bytes(self):
+            return self._bytes
+
         @property
         def avg_cpu_time(self):
             return self.cpu_time / self.call
@@ -565,21 +620,79 @@ class EventSummary:
         def add_flops(self, flops):
             self._flops += flops
 
+        def add_bytes(self, nbytes):
+            self._bytes += nbytes
+
         def add_item(self, node):
             raise NotImplementedError
 
     class DeviceItem(ItemBase):
+        def __init__(self, name):
+            super().__init__(name)
+            # weighted by the time of the kernels
+            self.occupancy_time = 0
+            self.sm_coverage_time = 0
+
+        @property
+        def occupancy(self):
+            r'''
+            The theoretical occupancy of the kernels from their launch configs.
+            '''
+            if self.gpu_time == 0:
+                return 0
+            return self.occupancy_time / self.gpu_time
+
+        @property
+        def sm_coverage(self):
+            r'''
+            The share of the SMs given at least a block, an upper bound of the
+            SM efficiency, low for the grids smaller than the device.
+            '''
+            if self.gpu_time == 0:
+                return 0
+            return self.sm_coverage_time / self.gpu_time
+
         def add_item(self, node):
             self.call += 1
-            self.add_gpu_time(node.end_ns - node.start_ns)
+            time = node.end_ns - node.start_ns
+            self.add_gpu_time(time)
+            if node.type == TracerEventType.Kernel:
+                self.occupancy_time += getattr(node, 'occupancy', 0) * time
+                self.sm_coverage_time += (
+                    min(getattr(node, 'blocks_per_sm', 0), 1.0) * time
+                )
 
     class OperatorItem(ItemBase):
+        def __init__(self, name):
+            super().__init__(name)
+            # of all the kernels launched in the op
+            self.kernel_time = 0
+            self.occupancy_time = 0
+
+        @property
+        def occupancy(self):
+            r'''
+            The theoretical occupancy of the kernels of the op, weighted by
+            their time.
+            '''
+            if self.kernel_time == 0:
+                return 0
+            return self.occupancy_time / self.kernel_time
+
         def add_item(self, node):
             self.add_call()
             self.add_cpu_time(node.cpu_time)
             self.add_gpu_time(node.gpu_time)
             self.add_general_gpu_time(node.general_gpu_time)
             self.add_flops(node.flops)
+            self.add_bytes(node.bytes)
+            for devicenode in get_device_nodes(node):
+                if devicenode.type == TracerEventType.Kernel:
+                    time = devicenode.end_ns - devicenode.start_ns
+                    self.kernel_time += time
+                    self.occupancy_time += (
+                        getattr(devicenode, 'occupancy', 0) * time
+                    )
             for child in node.children_node:
                 if child.type != TracerEventType.Operator:
                     if child.name not in self.operator_inners:
@@ -880,6 +993,8 @@ def _build_table(
     row_limit=100,
     max_src_column_width=75,
     views=None,
+    peak_tflops=None,
+    peak_gbps=None,
 ):
     from .profiler import SummaryView
 
@@ -1638,6 +1753,8 @@ def _build_table(
                     name,
                     item.call,
                     f'{format_time(item.gpu_time, unit=time_unit)} / {format_time(item.avg_gpu_time, unit=time_unit)} / {format_time(item.max_gpu_time, unit=time_unit)} / {format_time(item.min_gpu_time, unit=time_unit)} / {format_ratio(gpu_ratio)}',
+                    format_ratio(item.occupancy),
+                    format_ratio(item.sm_coverage),
                 ]
                 all_row_values.append(row_values)
 
@@ -1645,6 +1762,8 @@ def _build_table(
                 'Name',
                 'Calls',
                 'GPU Total / Avg / Max / Min / Ratio(%)',
+                'Occupancy(%)',
+                'SM Cover(%)',
             ]
             # Calculate the column width
             name_column_width = 90
@@ -1665,6 +1784,8 @@ def _build_table(
             add_column(name_column_width)
             add_column(calltime_width)
             add_column(gpu_data_description_width)
+            add_column(12)
+            add_column(11)
 
             row_format = row_format_list[0]
             header_sep = header_sep_list[0]
@@ -1692,6 +1813,108 @@ def _build_table(
             append('')
             append('')
 
+    if views is None or SummaryView.RooflineView in views:
+        # ----- Print Roofline Summary Report ----- #
+        roofline_items = [
+            item
+            for item in statistic_data.event_summary.items.values()
+            if item.gpu_time > 0 and (item.flops > 0 or item.bytes > 0)
+        ]
+        if roofline_items:
+            has_peaks = peak_tflops is not None and peak_gbps is not None
+            if has_peaks:
+                # the FLOP/Byte above which the ops are compute bound
+                ridge = peak_tflops * 1e12 / (peak_gbps * 1e9)
+            all_row_values = []
+            for item in sorted(
+                roofline_items, key=lambda x: x.gpu_time, reverse=True
+            )[:row_limit]:
+                seconds = item.gpu_time / 1e9
+                intensity = item.flops / item.bytes if item.bytes else 0
+                achieved_tflops = item.flops / seconds / 1e12
+                achieved_gbps = item.bytes / seconds / 1e9
+                bound = '-'
+                headroom = '-'
+                if has_peaks and item.bytes:
+                    bound = 'compute' if intensity >= ridge else 'memory'
+                    attainable_tflops = min(
+                        peak_tflops, intensity * peak_gbps / 1e3
+                    )
+                    if achieved_tflops > 0:
+                        headroom = (
+                            f'{attainable_tflops / achieved_tflops:.2f}x'
+                        )
+                all_row_values.append(
+                    [
+                        item.name,
+                        item.call,
+                        format_time(item.gpu_time, unit=time_unit),
+                        _format_large_number(item.flops),
+                        _format_large_number(item.bytes),
+                        f'{intensity:.2f}',
+                        f'{achieved_tflops:.3f}',
+                        f'{achieved_gbps:.1f}',
+                        format_ratio(item.occupancy),
+                        bound,
+                        headroom,
+                    ]
+                )
+
+            headers = [
+                'Name',
+                'Calls',
+                'GPU Total',
+                'FLOPs',
+                'Bytes',
+                'FLOP/Byte',
+                'TFLOPS',
+                'GB/s',
+                'Occupancy(%)',
+                'Bound',
+                'Headroom',
+            ]
+            name_column_width = 30
+            for row_values in all_row_values:
+                name_column_width = max(
+                    name_column_width, min(len(row_values[0]), 60)
+                )
+            row_format_list = [""]
+            header_sep_list = [""]
+            line_length_list = [-SPACING_SIZE]
+            add_column(name_column_width)
+            for header in headers[1:]:
+                add_column(max(len(header), 10))
+
+            row_format = row_format_list[0]
+            header_sep = header_sep_list[0]
+            line_length = line_length_list[0]
+
+            # construct table string
+            append(add_title(line_length, "Roofline Summary"))
+            append(f'Time unit: {time_unit}')
+            append(
+                'FLOPs and Bytes come from the input shapes of the ops, the '
+                'bytes of the ops without recorded dtypes take 4-byte elements.'
+            )
+            if has_peaks:
+                append(
+                    f'Peaks: {peak_tflops} TFLOPS, {peak_gbps} GB/s, ridge '
+                    f'{ridge:.2f} FLOP/Byte. Headroom is the attainable over '
+                    'the achieved TFLOPS.'
+                )
+            append(header_sep)
+            append(row_format.format(*headers))
+            append(header_sep)
+            for row_values in all_row_values:
+                if len(row_values[0]) > name_column_width:
+                    row_values[0] = (
+                        row_values[0][: name_column_width - 3] + '...'
+                    )
+                append(row_format.format(*row_values))
+            append(header_sep)
+            append('')
+            append('')
+
     if views is None or SummaryView.MemoryManipulationView in views:
         # ----- Print Memory Manipulation Summary Report ----- #
         if statistic_data.event_summary.memory_manipulation_items:
@@ -25,12 +25,14 @@ from paddle.base.core import TracerEventType, _RecordEvent
 
 if TYPE_CHECKING:
     import types
+    from collections.abc import Sequence
 
     from typing_extensions import Self
 
     from paddle.base.core import _ProfilerResult
 
 _is_profiler_used = False
+_is_external_ranges_used = False
 _has_optimizer_wrapped = False
 
 _AllowedEventTypeList = [
@@ -122,7 +124,7 @@ class RecordEvent(ContextDecorator):
                 >>> result = data1 - data2
                 >>> record_event.end()
         """
-        if not _is_profiler_used:
+        if not in_profiler_mode():
             return
         if self.event_type not in _AllowedEventTypeList:
             warn(
@@ -188,7 +190,60 @@ def load_profiler_result(filename: str) -> _ProfilerResult:
 
 
 def in_profiler_mode():
-    return _is_profiler_used
+    return _is_profiler_used or _is_external_ranges_used
+
+
+def enable_external_ranges(backends: Sequence[str] = ('nvtx',)) -> None:
+    r"""
+    Push the ranges of the operators, the interpreter instructions, the
+    collectives and the data loading to external profilers, without the Paddle
+    profiler: NVTX for Nsight Systems, ITT for VTune. This maps the kernels in
+    the timeline of these profilers back to the operators of Paddle.
+
+    Args:
+        backends (Sequence[str], optional): The profilers, ``'nvtx'`` which
+            needs Paddle compiled with CUDA, and ``'itt'`` which needs Paddle
+            compiled with ``-DWITH_ITT=ON``. Default is ``('nvtx',)``.
+
+    Examples:
+        .. code-block:: python
+
+            >>> # doctest: +REQUIRES(env:GPU)
+            >>> import paddle
+            >>> import paddle.profiler as profiler
+            >>> # Run under: nsys profile python train.py
+            >>> profiler.enable_external_ranges(['nvtx'])
+            >>> x = paddle.randn([4, 4])
+            >>> y = paddle.matmul(x, x)
+            >>> profiler.disable_external_ranges()
+    """
+    global _is_external_ranges_used
+    for backend in backends:
+        if backend not in ('nvtx', 'itt'):
+            raise ValueError(
+                f"The backend of the external ranges should be 'nvtx' or "
+                f"'itt', but got {backend!r}."
+            )
+    for backend in backends:
+        if backend == 'itt':
+            core.itt_enable_record_event()
+        elif hasattr(core, 'nvprof_enable_record_event'):
+            core.nvprof_enable_record_event()
+        else:
+            raise RuntimeError('The NVTX ranges need Paddle with CUDA.')
+    _is_external_ranges_used = True
+
+
+def disable_external_ranges() -> None:
+    r"""
+    Stop pushing the ranges to the external profilers, enabled by
+    ``enable_external_ranges``.
+    """
+    global _is_external_ranges_used
+    if hasattr(core, 'nvprof_disable_record_event'):
+        core.nvprof_disable_record_event()
+    core.itt_disable_record_event()
+    _is_external_ranges_used = False
 
 
 def wrap_optimizers():
@@ -0,0 +1,65 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+
+import paddle
+import paddle.distributed as dist
+from paddle.distributed.checkpoint.peer_memory_checkpoint import (
+    PeerMemoryCheckpoint,
+)
+
+
+class TestPeerMemoryCheckpoint:
+    def test_restore_from_buddy(self):
+        mesh = dist.ProcessMesh([0, 1])
+        w1 = paddle.arange(32, dtype="float32").reshape([4, 8])
+        w2 = paddle.arange(32, 36, dtype="float32").reshape([2, 2])
+        state_dict = {
+            "w1": dist.shard_tensor(w1, mesh, [dist.Shard(0)]),
+            "opt": {"w2": dist.shard_tensor(w2, mesh, [dist.Replicate()])},
+        }
+        expected = {
+            "w1": state_dict["w1"]._local_value().numpy(),
+            "w2": state_dict["opt"]["w2"]._local_value().numpy(),
+        }
+        ckpt = PeerMemoryCheckpoint(buddy_offset=1)
+        ckpt.save(state_dict, step=10)
+        ckpt.wait()
+
+        for value in (state_dict["w1"], state_dict["opt"]["w2"]):
+            paddle.assign(
+                paddle.zeros_like(value._local_value()), value._local_value()
+            )
+        # The rank 1 replaces a failed one, which keeps no checkpoint.
+        if dist.get_rank() == 1:
+            ckpt = PeerMemoryCheckpoint(buddy_offset=1)
+        assert ckpt.restore(state_dict) == 10
+        np.testing.assert_equal(
+            state_dict["w1"]._local_value().numpy(), expected["w1"]
+        )
+        np.testing.assert_equal(
+            state_dict["opt"]["w2"]._local_value().numpy(), expected["w2"]
+        )
+
+        # No rank keeps a checkpoint.
+        ckpt = PeerMemoryCheckpoint(buddy_offset=1)
+        assert ckpt.restore(state_dict) is None
+
+    def run_test_case(self):
+        self.test_restore_from_buddy()
+
+
+if __name__ == '__main__':
+    TestPeerMemoryCheckpoint().run_test_case()
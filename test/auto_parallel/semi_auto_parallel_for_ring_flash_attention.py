@@ -0,0 +1,88 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+from semi_auto_parallel_util import SemiAutoParallelTestBase
+
+import paddle
+import paddle.distributed as dist
+from paddle.distributed.auto_parallel.ring_attention import (
+    ring_flash_attention,
+)
+from paddle.nn.functional.flash_attention import flash_attention
+
+
+class TestRingFlashAttentionSemiAutoParallel(SemiAutoParallelTestBase):
+    def __init__(self):
+        super().__init__()
+
+    def check_close(self, actual, expected):
+        np.testing.assert_allclose(
+            actual.astype('float32').numpy(),
+            expected.astype('float32').numpy(),
+            rtol=2e-2,
+            atol=2e-2,
+        )
+
+    def test_ring_flash_att(self, causal, is_gqa=False):
+        paddle.seed(self._seed)
+        shapes = [[2, 512, 8, 64], [2, 512, 8, 64], [2, 512, 8, 64]]
+        if is_gqa:
+            shapes[1][2] = shapes[2][2] = 2
+        inputs = [paddle.randn(shape).astype(self._dtype) for shape in shapes]
+        for tensor in inputs:
+            tensor.stop_gradient = False
+
+        # the reference on the whole sequence
+        out, _ = flash_attention(*inputs, causal=causal)
+        out.backward()
+
+        dist_inputs = []
+        for tensor in inputs:
+            dist_tensor = dist.shard_tensor(
+                tensor.detach(), self._mesh, [dist.Shard(1)]
+            )
+            dist_tensor.stop_gradient = False
+            dist_inputs.append(dist_tensor)
+        dist_out = ring_flash_attention(*dist_inputs, causal=causal)
+        assert dist_out.placements == [dist.Shard(1)]
+        dist_out.backward()
+
+        self.check_close(dist.unshard_dtensor(dist_out), out)
+        for tensor, dist_tensor in zip(inputs, dist_inputs):
+            assert dist_tensor.grad.placements == [dist.Shard(1)]
+            self.check_close(
+                dist.unshard_dtensor(dist_tensor.grad), tensor.grad
+            )
+
+    def run_test_case(self):
+        if self._backend == "cpu":
+            paddle.set_device("cpu")
+        elif self._backend == "gpu":
+            paddle.set_device("gpu:" + str(dist.get_rank()))
+        else:
+            raise ValueError("Only support cpu or gpu backend.")
+
+        # flash attention is not supported yet for cpu
+        if self._backend == "gpu":
+            cuda_version_main = int(paddle.version.cuda().split(".")[0])
+            device_prop_main = paddle.device.cuda.get_device_capability()[0]
+            if cuda_version_main >= 11 and device_prop_main >= 8:
+                self.test_ring_flash_att(causal=False)
+                self.test_ring_flash_att(causal=True)
+                self.test_ring_flash_att(causal=True, is_gqa=True)
+
+
+if __name__ == '__main__':
+    TestRingFlashAttentionSemiAutoParallel().run_test_case()
@@ -22,6 +22,9 @@ import numpy as np
 import paddle
 import paddle.distributed as dist
 from paddle.distributed.checkpoint.load_state_dict import get_checkpoint_files
+from paddle.distributed.checkpoint.save_state_dict import (
+    clear_async_save_task_queue,
+)
 from paddle.distributed.checkpoint.utils import (
     flatten_state_dict,
     unflatten_state_dict,
@@ -64,6 +67,16 @@ class TestDistCheckpointUtils(test_base.CommunicationTestDistBase):
             )
             ckpt_path_tmp.cleanup()
 
+    def test_peer_memory_checkpoint(self):
+        envs_list = test_base.gen_product_envs_list(
+            self._default_envs, self._changeable_envs
+        )
+        for envs in envs_list:
+            self.run_test_case(
+                "semi_auto_parallel_checkpoint_peer_memory.py",
+                user_defined_envs=envs,
+            )
+
     def test_flatten_state_dict(self):
         state_dict = {
             "model": {
@@ -182,6 +195,43 @@ class TestDistCheckpointUtils(test_base.CommunicationTestDistBase):
 
         ckpt_dir_tmp.cleanup()
 
+    def test_async_save(self):
+        ckpt_dir_tmp = tempfile.TemporaryDirectory()
+        ckpt_dir = ckpt_dir_tmp.name
+        state_dict = {"w1": paddle.to_tensor([1.0, 2.0])}
+        dist.save_state_dict(state_dict, ckpt_dir, async_save=True)
+        # The snapshot is taken before the update in place.
+        state_dict["w1"].add_(paddle.to_tensor([1.0, 1.0]))
+        clear_async_save_task_queue()
+        self.assertFalse(
+            any(file.endswith(".tmp") for file in os.listdir(ckpt_dir))
+        )
+
+        new_state_dict = {"w1": paddle.zeros([2])}
+        dist.load_state_dict(new_state_dict, ckpt_dir)
+        np.testing.assert_equal(new_state_dict["w1"].numpy(), [1.0, 2.0])
+        ckpt_dir_tmp.cleanup()
+
+    def test_direct_read(self):
+        ckpt_dir_tmp = tempfile.TemporaryDirectory()
+        ckpt_dir = ckpt_dir_tmp.name
+        state_dict = {
+            "w1": paddle.arange(32, dtype="float32").reshape([4, 8]),
+            "w2": paddle.to_tensor([3, 4]),
+        }
+        dist.save_state_dict(state_dict, ckpt_dir)
+
+        new_state_dict = {
+            "w1": paddle.zeros([4, 8]),
+            "w2": paddle.zeros([2], dtype="int64"),
+        }
+        dist.load_state_dict(new_state_dict, ckpt_dir, direct_read=True)
+        for key, value in state_dict.items():
+            np.testing.assert_equal(
+                new_state_dict[key].numpy(), value.numpy()
+            )
+        ckpt_dir_tmp.cleanup()
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -148,6 +148,16 @@ class TestSemiAutoParallelBasic(test_base.CommunicationTestDistBase):
                 user_defined_envs=envs,
             )
 
+    def test_ring_flash_attention_api(self):
+        envs_list = test_base.gen_product_envs_list(
+            {"dtype": "float16", "seed": "2023"}, self._changeable_envs
+        )
+        for envs in envs_list:
+            self.run_test_case(
+                "semi_auto_parallel_for_ring_flash_attention.py",
+                user_defined_envs=envs,
+            )
+
     def test_embedding_api(self):
         envs_list = test_base.gen_product_envs_list(
             self._default_envs, self._changeable_envs
@@ -0,0 +1,137 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+
+import paddle
+import paddle.distributed as dist
+
+IN_FEATURES = 32
+OUT_FEATURES = 16
+STEPS = 50
+
+
+def relative_error(x, ref):
+    return np.linalg.norm(x - ref) / np.linalg.norm(ref)
+
+
+class GradientCompressionTestCase:
+    def __init__(self):
+        dist.init_parallel_env()
+        self._rank = dist.get_rank()
+        self._nranks = dist.get_world_size()
+        rng = np.random.RandomState(2026 + self._rank)
+        self._x = paddle.to_tensor(rng.randn(8, IN_FEATURES).astype("float32"))
+        self._w = paddle.to_tensor(rng.randn(8, OUT_FEATURES).astype("float32"))
+
+    def _build_layer(self):
+        paddle.seed(2026)
+        return paddle.nn.Linear(IN_FEATURES, OUT_FEATURES)
+
+    def _flat_grads(self, layer):
+        return np.concatenate(
+            [p.grad.numpy().reshape(-1) for p in layer.parameters()]
+        )
+
+    # The mean of the gradients over the ranks, by a plain allreduce.
+    def _reference(self):
+        layer = self._build_layer()
+        (layer(self._x) * self._w).sum().backward()
+        for p in layer.parameters():
+            dist.all_reduce(p.grad)
+            p.grad.scale_(1.0 / self._nranks)
+        return self._flat_grads(layer)
+
+    # The gradients of STEPS steps with the same data and parameters, and
+    # the stats of the compressor.
+    def _compressed(self, compression, **kwargs):
+        model = paddle.DataParallel(self._build_layer())
+        model._reducer.set_gradient_compression(compression, **kwargs)
+        grads = []
+        for _ in range(STEPS):
+            (model(self._x) * self._w).sum().backward()
+            grads.append(self._flat_grads(model))
+            model.clear_gradients()
+        return grads, model._reducer.gradient_compression_stats()
+
+    def check(
+        self, compression, step_rtol, mean_rtol, min_mean_error=0.0, **kwargs
+    ):
+        ref = self._reference()
+        grads, stats = self._compressed(compression, **kwargs)
+        # The ranks hold the same reduced gradients.
+        gathered = []
+        dist.all_gather(gathered, paddle.to_tensor(grads[-1]))
+        np.testing.assert_array_equal(gathered[0].numpy(), gathered[1].numpy())
+
+        step_error = relative_error(grads[0], ref)
+        mean_error = relative_error(np.mean(grads, axis=0), ref)
+        print(
+            f"rank {self._rank} {compression} {kwargs}: the error of a step "
+            f"is {step_error}, of the mean of {STEPS} steps {mean_error}"
+        )
+        assert (
+            step_error <= step_rtol
+        ), f"{compression}: {step_error} > {step_rtol}"
+        assert (
+            mean_error <= mean_rtol
+        ), f"{compression}: {mean_error} > {mean_rtol}"
+        assert (
+            mean_error >= min_mean_error
+        ), f"{compression}: {mean_error} < {min_mean_error}"
+
+        assert len(stats) > 0 or compression == "none"
+        for group in stats:
+            assert group["compressed_bytes"] > 0
+            assert group["original_bytes"] > 0
+            assert 0.0 <= group["relative_error"] <= 1.0
+        return stats
+
+    def run_test_case(self):
+        # Quantized twice, to the scale of a chunk and of its sum.
+        stats = self.check("int8", step_rtol=0.03, mean_rtol=0.03)
+        assert stats[0]["compression_ratio"] > 3.0
+        # e4m3 keeps 3 bits of mantissa.
+        stats = self.check("fp8", step_rtol=0.1, mean_rtol=0.1)
+        assert stats[0]["compression_ratio"] > 3.0
+
+        # The output is the projection of the sum of the buckets on P.
+        self.check("powersgd", step_rtol=1.0, mean_rtol=0.25, powersgd_rank=8)
+
+        # The output is the sum of the values the ranks keep, so that with
+        # the error fed back, what a step loses is sent by the next ones and
+        # the mean over the steps converges to the allreduce.
+        self.check(
+            "topk",
+            step_rtol=0.8,
+            mean_rtol=0.15,
+            topk_ratio=0.25,
+            error_feedback=True,
+        )
+        # Without it, every step loses the same values.
+        self.check(
+            "topk",
+            step_rtol=0.8,
+            mean_rtol=0.8,
+            min_mean_error=0.3,
+            topk_ratio=0.25,
+            error_feedback=False,
+        )
+
+        # "none" restores the plain allreduce.
+        self.check("none", step_rtol=1e-5, mean_rtol=1e-5)
+
+
+if __name__ == "__main__":
+    GradientCompressionTestCase().run_test_case()
@@ -0,0 +1,94 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+
+import paddle
+import paddle.distributed as dist
+from paddle import nn
+from paddle.incubate.distributed.models.moe import GroupedExperts, MoELayer
+
+NUM_EXPERT = 2
+D_MODEL = 16
+D_HIDDEN = 32
+# The Linear layers of the expert list may run their GEMMs in TF32.
+RTOL = 5e-3
+ATOL = 5e-3
+
+
+class MoEGroupedExpertsTestCase:
+    def __init__(self):
+        dist.init_parallel_env()
+        self._rank = dist.get_rank()
+        self._nranks = dist.get_world_size()
+        self._group = dist.new_group(list(range(self._nranks)))
+        rng = np.random.RandomState(2026 + self._rank)
+        # A different number of tokens on each rank.
+        self._x = rng.randn(2, 5 + 3 * self._rank, D_MODEL).astype("float32")
+
+    def _build_layers(self, gate):
+        # The experts differ from rank to rank.
+        paddle.seed(2026 + self._rank)
+        grouped = GroupedExperts(NUM_EXPERT, D_MODEL, D_HIDDEN)
+        experts = nn.LayerList()
+        for e in range(NUM_EXPERT):
+            expert = nn.Sequential(
+                nn.Linear(D_MODEL, D_HIDDEN, bias_attr=False),
+                nn.GELU(),
+                nn.Linear(D_HIDDEN, D_MODEL, bias_attr=False),
+            )
+            expert[0].weight.set_value(grouped.w1[e])
+            expert[2].weight.set_value(grouped.w2[e])
+            experts.append(expert)
+        grouped_moe = MoELayer(
+            D_MODEL, grouped, gate=gate, moe_group=self._group
+        )
+        list_moe = MoELayer(D_MODEL, experts, gate=gate, moe_group=self._group)
+        list_moe.gate.set_state_dict(grouped_moe.gate.state_dict())
+        return grouped_moe, list_moe
+
+    def _run(self, moe):
+        x = paddle.to_tensor(self._x, stop_gradient=False)
+        # MoELayer reshapes its input in place, which a leaf can not be.
+        out = moe(x * 1.0)
+        (out * out).sum().backward()
+        return out, x.grad
+
+    def check(self, gate):
+        grouped_moe, list_moe = self._build_layers(gate)
+        out_grouped, x_grad_grouped = self._run(grouped_moe)
+        out_list, x_grad_list = self._run(list_moe)
+
+        def assert_close(actual, expected):
+            np.testing.assert_allclose(
+                actual.numpy(), expected.numpy(), rtol=RTOL, atol=ATOL
+            )
+
+        assert_close(out_grouped, out_list)
+        assert_close(x_grad_grouped, x_grad_list)
+        grouped = grouped_moe.experts
+        for e, expert in enumerate(list_moe.experts):
+            assert_close(grouped.w1.grad[e], expert[0].weight.grad)
+            assert_close(grouped.w2.grad[e], expert[2].weight.grad)
+        assert_close(
+            grouped_moe.gate.gate.weight.grad, list_moe.gate.gate.weight.grad
+        )
+
+    def run_test_case(self):
+        self.check({"type": "naive", "top_k": 2})
+        self.check({"type": "naive", "top_k": 1})
+
+
+if __name__ == "__main__":
+    MoEGroupedExpertsTestCase().run_test_case()
@@ -0,0 +1,39 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import test_communication_api_base as test_base
+
+import paddle
+
+
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda()
+    or paddle.device.cuda.get_device_capability()[0] < 8,
+    "the grouped GEMM of GroupedExperts requires CUDA_ARCH >= 8",
+)
+class TestMoEGroupedExperts(test_base.CommunicationTestDistBase):
+    def setUp(self):
+        super().setUp(num_of_devices=2, timeout=120)
+
+    def test_grouped_experts_across_ranks(self):
+        self.run_test_case("moe_grouped_experts_dygraph.py")
+
+    def tearDown(self):
+        super().tearDown()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,89 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/phi/core/distributed/auto_parallel/inferspmd_cache.h"
+#include "test/cpp/auto_parallel/spmd_rule_test_util.h"
+
+namespace paddle {
+namespace distributed {
+namespace auto_parallel {
+
+TEST(InferSpmdCache, Ctor) {
+  ProcessMesh process_mesh({2, 2}, {0, 1, 2, 3}, {"x", "y"});
+
+  TensorDistAttr t_dist_attr = TensorDistAttr();
+  t_dist_attr.set_process_mesh(process_mesh);
+  t_dist_attr.set_dims_mapping({0, -1, 1});
+  t_dist_attr.set_dynamic_dims({false, false, false});
+  phi::distributed::DistMetaTensor x = phi::distributed::DistMetaTensor(
+      common::make_ddim({6, 8, 10}), t_dist_attr);
+  std::vector<int64_t> repeat_times = {2, 2, 1, 1};
+
+  int calls = 0;
+  auto tile_infer_spmd = [&](const phi::distributed::DistMetaTensor& input,
+                             const std::vector<int64_t>& repeats) {
+    return phi::distributed::CachedInferSpmd(
+        "TileInferSpmd",
+        [&]() {
+          ++calls;
+          return phi::distributed::TileInferSpmd(input, repeats);
+        },
+        input,
+        repeats);
+  };
+
+  // the same arguments hit the cache
+  for (int i = 0; i < 2; ++i) {
+    phi::distributed::SpmdInfo spmd_info = tile_infer_spmd(x, repeat_times);
+    EXPECT_EQ(calls, 1);
+    check_dim_mapping(spmd_info.first[0], {-1, -1, 1});
+    check_dim_mapping(spmd_info.second[0], {-1, -1, -1, 1});
+  }
+
+  // another dims mapping, shape or attribute misses it
+  t_dist_attr.set_dims_mapping({-1, 0, 1});
+  phi::distributed::DistMetaTensor y = phi::distributed::DistMetaTensor(
+      common::make_ddim({6, 8, 10}), t_dist_attr);
+  phi::distributed::SpmdInfo spmd_info = tile_infer_spmd(y, repeat_times);
+  EXPECT_EQ(calls, 2);
+  check_dim_mapping(spmd_info.second[0], {-1, -1, 0, 1});
+
+  phi::distributed::DistMetaTensor z = phi::distributed::DistMetaTensor(
+      common::make_ddim({6, 8, 12}), t_dist_attr);
+  tile_infer_spmd(z, repeat_times);
+  EXPECT_EQ(calls, 3);
+
+  tile_infer_spmd(y, {2, 1, 1});
+  EXPECT_EQ(calls, 4);
+
+  tile_infer_spmd(y, repeat_times);
+  EXPECT_EQ(calls, 4);
+
+  // the partial status is a part of the key
+  t_dist_attr.set_dims_mapping({-1, -1, 1});
+  phi::distributed::DistMetaTensor r = phi::distributed::DistMetaTensor(
+      common::make_ddim({6, 8, 10}), t_dist_attr);
+  tile_infer_spmd(r, repeat_times);
+  EXPECT_EQ(calls, 5);
+
+  t_dist_attr.set_partial_status(std::vector<int64_t>{0});
+  phi::distributed::DistMetaTensor p = phi::distributed::DistMetaTensor(
+      common::make_ddim({6, 8, 10}), t_dist_attr);
+  tile_infer_spmd(p, repeat_times);
+  EXPECT_EQ(calls, 6);
+}
+
+}  // namespace auto_parallel
+}  // namespace distributed
+}  // namespace paddle
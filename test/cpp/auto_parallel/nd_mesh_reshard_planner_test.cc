@@ -0,0 +1,118 @@
+/* Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/phi/core/distributed/auto_parallel/reshard/nd_mesh_reshard_planner.h"
+
+#include "gtest/gtest.h"
+
+namespace phi {
+namespace distributed {
+namespace tests {
+
+using StepType = NdMeshReshardStep::Type;
+
+ProcessMesh Mesh2x4() {
+  return ProcessMesh({2, 4}, {0, 1, 2, 3, 4, 5, 6, 7}, {"x", "y"});
+}
+
+TensorDistAttr MakeDistAttr(const std::vector<int64_t>& dims_mapping) {
+  TensorDistAttr dist_attr(std::vector<int64_t>{1024, 1024});
+  dist_attr.set_process_mesh(Mesh2x4());
+  dist_attr.set_dims_mapping(dims_mapping);
+  return dist_attr;
+}
+
+NdMeshReshardPlan Plan(const TensorDistAttr& in, const TensorDistAttr& out) {
+  NdMeshReshardCostModel cost_model(Mesh2x4(), 8);
+  return PlanNdMeshReshard(
+      {1024, 1024}, DataType::FLOAT32, in, out, cost_model);
+}
+
+TEST(NdMeshReshardCostModel, InterNode) {
+  NdMeshReshardCostModel cost_model(Mesh2x4(), 4);
+  EXPECT_TRUE(cost_model.IsInterNode(0));
+  EXPECT_FALSE(cost_model.IsInterNode(1));
+
+  NdMeshReshardCostModel single_node(Mesh2x4(), 8);
+  EXPECT_FALSE(single_node.IsInterNode(0));
+  EXPECT_FALSE(single_node.IsInterNode(1));
+}
+
+TEST(NdMeshReshardPlanner, MoveShardAcrossMeshDims) {
+  auto plan = Plan(MakeDistAttr({0, -1}), MakeDistAttr({1, -1}));
+  ASSERT_EQ(plan.steps.size(), 2UL);
+  EXPECT_EQ(plan.steps[0].type, StepType::kSToR);
+  EXPECT_EQ(plan.steps[0].mesh_axis, 0);
+  EXPECT_EQ(plan.steps[1].type, StepType::kRToS);
+  EXPECT_EQ(plan.steps[1].mesh_axis, 1);
+}
+
+TEST(NdMeshReshardPlanner, ShardToShardByAllToAll) {
+  auto in = MakeDistAttr({0, -1});
+  auto out = MakeDistAttr({-1, 0});
+  auto plan = Plan(in, out);
+  ASSERT_EQ(plan.steps.size(), 1UL);
+  EXPECT_EQ(plan.steps[0].type, StepType::kSToS);
+  EXPECT_EQ(plan.steps[0].in_tensor_axis, 0);
+  EXPECT_EQ(plan.steps[0].out_tensor_axis, 1);
+
+  NdMeshReshardCostModel cost_model(Mesh2x4(), 8);
+  auto by_status = PlanNdMeshReshardByStatus(
+      {1024, 1024}, DataType::FLOAT32, in, out, cost_model);
+  EXPECT_EQ(by_status.steps.size(), 2UL);
+  EXPECT_LT(plan.cost, by_status.cost);
+}
+
+TEST(NdMeshReshardPlanner, SliceBeforeGather) {
+  // Slicing along the second mesh dim first leaves less to gather along the
+  // first one.
+  auto plan = Plan(MakeDistAttr({0, -1}), MakeDistAttr({-1, 1}));
+  ASSERT_EQ(plan.steps.size(), 2UL);
+  EXPECT_EQ(plan.steps[0].type, StepType::kRToS);
+  EXPECT_EQ(plan.steps[0].mesh_axis, 1);
+  EXPECT_EQ(plan.steps[1].type, StepType::kSToR);
+  EXPECT_EQ(plan.steps[1].mesh_axis, 0);
+}
+
+TEST(NdMeshReshardPlanner, PartialToShard) {
+  auto in = MakeDistAttr({-1, -1});
+  in.set_partial_status(std::vector<int64_t>{0});
+  auto plan = Plan(in, MakeDistAttr({0, -1}));
+  ASSERT_EQ(plan.steps.size(), 1UL);
+  EXPECT_EQ(plan.steps[0].type, StepType::kPToS);
+
+  // The reduce-scatter only sums.
+  auto avg_in = MakeDistAttr({-1, -1});
+  avg_in.set_partial_status(std::vector<int64_t>{0}, ReduceType::kRedAvg);
+  plan = Plan(avg_in, MakeDistAttr({0, -1}));
+  ASSERT_EQ(plan.steps.size(), 2UL);
+  EXPECT_EQ(plan.steps[0].type, StepType::kPToR);
+  EXPECT_EQ(plan.steps[0].reduce_type, ReduceType::kRedAvg);
+  EXPECT_EQ(plan.steps[1].type, StepType::kRToS);
+}
+
+TEST(NdMeshReshardPlanner, KeepPartial) {
+  auto in = MakeDistAttr({-1, -1});
+  in.set_partial_status(std::vector<int64_t>{1});
+  auto out = MakeDistAttr({0, -1});
+  out.set_partial_status(std::vector<int64_t>{1});
+  auto plan = Plan(in, out);
+  ASSERT_EQ(plan.steps.size(), 1UL);
+  EXPECT_EQ(plan.steps[0].type, StepType::kRToS);
+  EXPECT_EQ(plan.steps[0].mesh_axis, 0);
+}
+
+}  // namespace tests
+}  // namespace distributed
+}  // namespace phi
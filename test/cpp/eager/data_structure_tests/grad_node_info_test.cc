@@ -77,11 +77,11 @@ void TestGradNodeBase(bool is_remove_gradient_hook) {
       1UL,
       common::errors::InvalidArgument("Size of input mismatch. Expected 1."));
   PADDLE_ENFORCE_EQ(
-      grad_test_node0->InputMeta()[0][0].GetTensorMeta().dtype,
+      grad_test_node0->InputMeta()[0][0].GetTensorMeta().dtype(),
       meta.dtype,
       common::errors::InvalidArgument("Dtype of input tensor mismatch."));
   PADDLE_ENFORCE_EQ(
-      grad_test_node0->InputMeta()[1][0].GetTensorMeta().dtype,
+      grad_test_node0->InputMeta()[1][0].GetTensorMeta().dtype(),
       meta.dtype,
       common::errors::InvalidArgument("Dtype of input tensor mismatch."));
   PADDLE_ENFORCE_EQ(grad_test_node0->OutputMeta()[0][0].IsStopGradient(),
@@ -95,11 +95,11 @@ void TestGradNodeBase(bool is_remove_gradient_hook) {
                         "`grad_test_node0->OutputMeta()[1][0].IsStopGradient()"
                         "` should be true, please related function"));
   PADDLE_ENFORCE_EQ(
-      grad_test_node0->OutputMeta()[0][0].GetTensorMeta().dtype,
+      grad_test_node0->OutputMeta()[0][0].GetTensorMeta().dtype(),
       meta.dtype,
       common::errors::InvalidArgument("Dtype of output tensor mismatch."));
   PADDLE_ENFORCE_EQ(
-      grad_test_node0->OutputMeta()[1][0].GetTensorMeta().dtype,
+      grad_test_node0->OutputMeta()[1][0].GetTensorMeta().dtype(),
       meta.dtype,
       common::errors::InvalidArgument("Dtype of output tensor mismatch."));
 
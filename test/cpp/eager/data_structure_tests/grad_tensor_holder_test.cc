@@ -26,6 +26,7 @@
 
 PD_DECLARE_KERNEL(full_like, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(add, CPU, ALL_LAYOUT);
+PD_DECLARE_KERNEL(add_n, CPU, ALL_LAYOUT);
 
 // TODO(jiabin): remove nolint here!!!
 using namespace egr;  // NOLINT
@@ -205,3 +206,32 @@ TEST(GradTensorHolder, SelectedRowsMergeAdd) {
     }
   }
 }
+
+TEST(GradTensorHolder, SumPendingGrads) {
+  phi::DenseTensorMeta meta =
+      phi::DenseTensorMeta(phi::DataType::FLOAT32, common::make_ddim({2}));
+  std::vector<GradSlotMeta> slot_meta(1);
+  GradTensorHolder grad_tensor_holder = GradTensorHolder({slot_meta});
+
+  std::vector<paddle::Tensor> grads;
+  for (int i = 1; i <= 10; ++i) {
+    auto dt = std::make_shared<phi::DenseTensor>(
+        std::make_unique<paddle::experimental::DefaultAllocator>(
+            phi::CPUPlace())
+            .get(),
+        meta);
+    float* data = dt->mutable_data<float>(phi::CPUPlace());
+    data[0] = static_cast<float>(i);
+    data[1] = static_cast<float>(2 * i);
+    grads.emplace_back(dt);
+    grad_tensor_holder.add(0, 0, grads.back());
+  }
+
+  // summed in place into the first grad once the buffer is read
+  const auto& sum = grad_tensor_holder[0][0];
+  EXPECT_EQ(sum.impl(), grads[0].impl());
+  auto* sum_ptr =
+      std::dynamic_pointer_cast<phi::DenseTensor>(sum.impl())->data<float>();
+  EXPECT_EQ(sum_ptr[0], 55.0f);
+  EXPECT_EQ(sum_ptr[1], 110.0f);
+}
@@ -16,6 +16,8 @@
 
 #include <sstream>
 
+#include "paddle/common/flags.h"
+
 #include "glog/logging.h"
 #include "gtest/gtest.h"
 #include "paddle/fluid/eager/accumulation/accumulation_node.h"
@@ -31,6 +33,9 @@
 PD_DECLARE_KERNEL(full, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(add, CPU, ALL_LAYOUT);
 
+COMMON_DECLARE_int32(eager_backward_thread_num);
+COMMON_DECLARE_bool(eager_backward_deterministic);
+
 namespace egr {
 
 TEST(Backward, SingleNodeEmptyGrad) {
@@ -342,4 +347,65 @@ TEST(Backward, WithAccumulation) {
   eager_test::CompareGradTensorWithValue<float>(leaf_tensor, 2500.0);
 }
 
+TEST(Backward, ParallelBranches) {
+  // Prepare Device Contexts
+  eager_test::InitEnv(phi::CPUPlace());
+  FLAGS_eager_backward_thread_num = 4;
+
+  phi::DDim ddim = common::make_ddim({4, 16, 16, 32});
+  for (bool deterministic : {true, false}) {
+    FLAGS_eager_backward_deterministic = deterministic;
+
+    // Four targets, each scaled by its own node, all summed into Node4
+    std::vector<paddle::Tensor> target_tensors;
+    paddle::Tensor leaf_tensor;
+    auto node4_ptr = std::make_shared<GradNodeScale>(1, 1);
+    node4_ptr->SetAttributes_scale(2.0 /*scale*/);
+    node4_ptr->SetDefaultGradInOutMeta();
+    for (int i = 0; i < 4; ++i) {
+      target_tensors.emplace_back(
+          eager_test::CreateTensorWithValue(ddim,
+                                            phi::CPUPlace(),
+                                            phi::DataType::FLOAT32,
+                                            phi::DataLayout::NCHW,
+                                            1.0 /*value*/,
+                                            false /*is_leaf*/));
+      auto node_ptr = std::make_shared<GradNodeScale>(1, 1);
+      node_ptr->SetAttributes_scale(i + 1.0 /*scale*/);
+      node_ptr->SetDefaultGradInOutMeta();
+      AutogradMeta* auto_grad_meta =
+          EagerUtils::autograd_meta(&(target_tensors[i]));
+      auto_grad_meta->SetGradNode(
+          std::dynamic_pointer_cast<GradNodeBase>(node_ptr));
+      auto_grad_meta->SetSingleOutRankWithSlot(0, 0);
+      auto_grad_meta->SetStopGradient(false);
+
+      // Connect Node_i -> Node4 via Edge
+      auto tmp_tensor = paddle::Tensor();
+      auto* meta = EagerUtils::autograd_meta(&tmp_tensor);
+      meta->SetStopGradient(false);
+      meta->SetSingleOutRankWithSlot(0, 0);
+      meta->SetGradNode(node4_ptr);
+      node_ptr->SetGradOutMeta(tmp_tensor, 0);
+    }
+
+    AutogradMeta* auto_grad_meta4 = EagerUtils::autograd_meta(&leaf_tensor);
+    // Connect Tensor and AccumulationNode via AutoGradMeta
+    auto acc_node_ptr =
+        std::make_shared<egr::GradNodeAccumulation>(auto_grad_meta4);
+    auto_grad_meta4->SetGradNode(
+        std::dynamic_pointer_cast<GradNodeBase>(acc_node_ptr));
+    auto_grad_meta4->SetSingleOutRankWithSlot(0, 0);
+    auto_grad_meta4->SetStopGradient(false);
+    node4_ptr->SetGradOutMeta(leaf_tensor, 0);
+
+    Backward(target_tensors, {});
+
+    // (1 + 2 + 3 + 4) * 2
+    eager_test::CompareGradTensorWithValue<float>(leaf_tensor, 20.0);
+  }
+  FLAGS_eager_backward_thread_num = 0;
+  FLAGS_eager_backward_deterministic = true;
+}
+
 }  // namespace egr
@@ -0,0 +1,127 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/io/bgzf_reader.h"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+static void PutLE(std::string* out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out->push_back(static_cast<char>(value >> (8 * i) & 0xff));
+  }
+}
+
+// Writes data as bgzip does, in blocks of 60000 bytes and an empty block
+// that marks the end.
+static void WriteBgzf(const std::string& path, const std::string& data) {
+  std::string file;
+  size_t pos = 0;
+  do {
+    size_t len = std::min<size_t>(60000, data.size() - pos);
+    std::string deflated(compressBound(len) + 16, '\0');
+    z_stream stream = {};
+    deflateInit2(
+        &stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    stream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(data.data() + pos));
+    stream.avail_in = len;
+    stream.next_out = reinterpret_cast<Bytef*>(&deflated[0]);
+    stream.avail_out = deflated.size();
+    ASSERT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+    deflated.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    file += std::string("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+    PutLE(&file, deflated.size() + 25, 2);
+    file += deflated;
+    PutLE(&file,
+          crc32(0, reinterpret_cast<const Bytef*>(data.data() + pos), len),
+          4);
+    PutLE(&file, len, 4);
+    pos += len;
+  } while (pos < data.size());
+  std::ofstream out(path, std::ios::binary);
+  out.write(file.data(), static_cast<std::streamsize>(file.size()));
+}
+
+static std::string MakeLines(size_t size) {
+  std::string data(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = i % 100 == 99 ? '\n' : static_cast<char>('0' + i * 13 % 10);
+  }
+  return data;
+}
+
+TEST(BgzfReader, Read) {
+  for (size_t size : {0UL, 10UL, 60000UL, (3UL << 20) + 17}) {
+    std::string data = MakeLines(size);
+    WriteBgzf("bgzf_reader.gz", data);
+    EXPECT_TRUE(paddle::framework::BgzfReader::IsBgzf("bgzf_reader.gz"));
+    for (int thread_num : {1, 4}) {
+      paddle::framework::BgzfReader reader("bgzf_reader.gz", thread_num);
+      std::string read(size + 16, 0);
+      size_t n = 0;
+      while (size_t k = reader.Read(&read[n], std::min<size_t>(
+                                                  7777, read.size() - n))) {
+        n += k;
+      }
+      read.resize(n);
+      EXPECT_EQ(read, data);
+    }
+  }
+  std::remove("bgzf_reader.gz");
+}
+
+TEST(BgzfReader, File) {
+  std::string data = MakeLines(1 << 20);
+  WriteBgzf("bgzf_reader.gz", data);
+  auto fp = paddle::framework::BgzfReader::OpenFile("bgzf_reader.gz", 3);
+  std::string lines;
+  char line[128];
+  while (fgets(line, sizeof(line), &*fp)) {
+    lines += line;
+  }
+  EXPECT_EQ(lines, data);
+  std::remove("bgzf_reader.gz");
+}
+
+TEST(BgzfReader, NotBgzf) {
+  gzFile gz = gzopen("bgzf_reader.gz", "wb");
+  gzputs(gz, "plain gzip\n");
+  gzclose(gz);
+  EXPECT_FALSE(paddle::framework::BgzfReader::IsBgzf("bgzf_reader.gz"));
+  std::remove("bgzf_reader.gz");
+}
+
+TEST(BgzfReader, Corrupted) {
+  WriteBgzf("bgzf_reader.gz", MakeLines(100000));
+  {
+    std::fstream file("bgzf_reader.gz",
+                      std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(40);
+    file.put('\x5a');
+  }
+  paddle::framework::BgzfReader reader("bgzf_reader.gz", 2);
+  std::string read(200000, 0);
+  EXPECT_ANY_THROW(reader.Read(&read[0], read.size()));
+  std::remove("bgzf_reader.gz");
+}
+#endif
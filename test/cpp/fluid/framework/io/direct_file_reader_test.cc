@@ -0,0 +1,80 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/io/direct_file_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+static std::string WriteTestFile(const std::string& path, size_t size) {
+  std::string data(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = i % 80 == 79 ? '\n' : static_cast<char>('a' + i * 7 % 26);
+  }
+  std::ofstream out(path, std::ios::binary);
+  out.write(data.data(), static_cast<std::streamsize>(size));
+  return data;
+}
+
+TEST(DirectFileReader, Read) {
+  for (size_t size : {0UL, 1UL, 4096UL, (1UL << 20) + 123}) {
+    std::string data = WriteTestFile("direct_file_reader.txt", size);
+    for (int depth : {1, 4}) {
+      paddle::framework::DirectFileReader reader(
+          "direct_file_reader.txt", 64 << 10, depth);
+      EXPECT_EQ(reader.file_size(), static_cast<int64_t>(size));
+      std::string read(size + 16, 0);
+      size_t n = 0;
+      size_t step = 1000;
+      while (n < read.size()) {
+        size_t k = reader.Read(&read[n], std::min(step, read.size() - n));
+        n += k;
+        if (k < step) {
+          break;
+        }
+      }
+      EXPECT_EQ(n, size);
+      read.resize(n);
+      EXPECT_EQ(read, data);
+    }
+  }
+  std::remove("direct_file_reader.txt");
+}
+
+TEST(DirectFileReader, FileAndStream) {
+  std::string data = WriteTestFile("direct_file_reader.txt", (3 << 20) + 7);
+
+  auto fp = paddle::framework::DirectFileReader::OpenFile(
+      "direct_file_reader.txt");
+  std::string lines;
+  char line[128];
+  while (fgets(line, sizeof(line), &*fp)) {
+    lines += line;
+  }
+  EXPECT_EQ(lines, data);
+
+  paddle::framework::DirectFileStreamBuf buf("direct_file_reader.txt");
+  std::istream in(&buf);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  EXPECT_EQ(ss.str(), data);
+  std::remove("direct_file_reader.txt");
+}
+#endif
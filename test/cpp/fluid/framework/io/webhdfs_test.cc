@@ -0,0 +1,574 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/io/webhdfs.h"
+
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/io/fs.h"
+
+COMMON_DECLARE_string(webhdfs_endpoint);
+COMMON_DECLARE_int32(webhdfs_read_chunk_mb);
+COMMON_DECLARE_int32(webhdfs_read_parallelism);
+
+namespace {
+
+// A namenode and datanode in one http server: the namenode answers
+// GETFILESTATUS and redirects OPEN and CREATE to the datanode, which serves
+// and stores the files in memory.
+class FakeWebHdfs {
+ public:
+  FakeWebHdfs() {
+    _listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    bind(_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    listen(_listen_fd, 64);
+    getsockname(_listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    _port = ntohs(addr.sin_port);
+    _accept_thread = std::thread([this] { AcceptLoop(); });
+  }
+
+  ~FakeWebHdfs() {
+    shutdown(_listen_fd, SHUT_RDWR);
+    _accept_thread.join();
+    close(_listen_fd);
+    std::vector<std::thread> threads;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (int fd : _conn_fds) {
+        shutdown(fd, SHUT_RDWR);
+      }
+      threads.swap(_conn_threads);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  std::string endpoint() const {
+    return "127.0.0.1:" + std::to_string(_port);
+  }
+
+  void Reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _files.clear();
+    _namenode_errors.clear();
+    _chunked = false;
+    _failing_opens = 0;
+    _datanode_put_status = 201;
+    _redirects = 0;
+    _opens = 0;
+  }
+
+  void PutFile(const std::string& path, const std::string& data) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _files[path] = data;
+  }
+
+  bool GetFile(const std::string& path, std::string* data) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _files.find(path);
+    if (it == _files.end()) {
+      return false;
+    }
+    *data = it->second;
+    return true;
+  }
+
+  // The namenode answers the op with the status.
+  void SetNamenodeError(const std::string& op, int status) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _namenode_errors[op] = status;
+  }
+
+  // The datanode sends the files in chunks of a chunked body.
+  void SetChunked(bool chunked) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _chunked = chunked;
+  }
+
+  // The next count reads of the datanode fail with 500.
+  void FailOpens(int count) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _failing_opens = count;
+  }
+
+  void SetDatanodePutStatus(int status) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _datanode_put_status = status;
+  }
+
+  int redirects() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _redirects;
+  }
+
+  int opens() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _opens;
+  }
+
+ private:
+  struct Response {
+    int status = 200;
+    std::string location;
+    std::string body;
+    bool chunked = false;
+  };
+
+  class Reader {
+   public:
+    explicit Reader(int fd) : _fd(fd) {}
+
+    bool ReadLine(std::string* line) {
+      size_t end = 0;
+      while ((end = _buffer.find("\r\n")) == std::string::npos) {
+        if (!Fill()) {
+          return false;
+        }
+      }
+      line->assign(_buffer, 0, end);
+      _buffer.erase(0, end + 2);
+      return true;
+    }
+
+    bool Read(size_t size, std::string* out) {
+      while (_buffer.size() < size) {
+        if (!Fill()) {
+          return false;
+        }
+      }
+      out->append(_buffer, 0, size);
+      _buffer.erase(0, size);
+      return true;
+    }
+
+   private:
+    bool Fill() {
+      char data[1 << 16];
+      ssize_t n = recv(_fd, data, sizeof(data), 0);
+      if (n <= 0) {
+        return false;
+      }
+      _buffer.append(data, n);
+      return true;
+    }
+
+    int _fd;
+    std::string _buffer;
+  };
+
+  void AcceptLoop() {
+    while (true) {
+      int fd = accept(_listen_fd, nullptr, nullptr);
+      if (fd < 0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      _conn_fds.push_back(fd);
+      _conn_threads.emplace_back([this, fd] {
+        Serve(fd);
+        close(fd);
+      });
+    }
+  }
+
+  // Serves the requests of a keep-alive connection until it is closed.
+  void Serve(int fd) {
+    Reader reader(fd);
+    std::string line;
+    while (reader.ReadLine(&line)) {
+      size_t space = line.find(' ');
+      std::string method = line.substr(0, space);
+      std::string target =
+          line.substr(space + 1, line.find(' ', space + 1) - space - 1);
+      std::map<std::string, std::string> headers;
+      while (reader.ReadLine(&line) && !line.empty()) {
+        size_t colon = line.find(':');
+        headers[line.substr(0, colon)] = line.substr(colon + 2);
+      }
+      std::string body;
+      if (headers["Transfer-Encoding"] == "chunked") {
+        while (reader.ReadLine(&line)) {
+          size_t size = strtoull(line.c_str(), nullptr, 16);
+          if (size == 0) {
+            break;
+          }
+          if (!reader.Read(size, &body) || !reader.ReadLine(&line)) {
+            return;
+          }
+        }
+        if (!reader.ReadLine(&line)) {
+          return;
+        }
+      } else {
+        size_t length =
+            strtoull(headers["Content-Length"].c_str(), nullptr, 10);
+        if (!reader.Read(length, &body)) {
+          return;
+        }
+      }
+      if (!Send(fd, Handle(method, target, body))) {
+        return;
+      }
+    }
+  }
+
+  Response Handle(const std::string& method,
+                  const std::string& target,
+                  const std::string& body) {
+    const std::string namenode = "/webhdfs/v1";
+    const std::string datanode = "/datanode/v1";
+    size_t question = target.find('?');
+    std::string path = target.substr(0, question);
+    std::string query = target.substr(question + 1);
+    std::map<std::string, std::string> params;
+    for (size_t begin = 0; begin < query.size();) {
+      size_t end = query.find('&', begin);
+      end = end == std::string::npos ? query.size() : end;
+      std::string param = query.substr(begin, end - begin);
+      size_t eq = param.find('=');
+      params[param.substr(0, eq)] = param.substr(eq + 1);
+      begin = end + 1;
+    }
+    const std::string& op = params["op"];
+
+    Response response;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (path.compare(0, namenode.size(), namenode) == 0) {
+      std::string file = path.substr(namenode.size());
+      if (_namenode_errors.count(op)) {
+        response.status = _namenode_errors[op];
+        response.body = "{\"RemoteException\":{}}";
+      } else if (op == "GETFILESTATUS" || op == "OPEN") {
+        if (_files.count(file) == 0) {
+          response.status = 404;
+          response.body = "{\"RemoteException\":{}}";
+        } else if (op == "GETFILESTATUS") {
+          response.body = "{\"FileStatus\":{\"length\":" +
+                          std::to_string(_files[file].size()) +
+                          ",\"type\":\"FILE\"}}";
+        } else {
+          response.status = 307;
+        }
+      } else if (op == "CREATE" && method == "PUT") {
+        response.status = 307;
+      } else {
+        response.status = 400;
+      }
+      if (response.status == 307) {
+        ++_redirects;
+        response.location =
+            "http://" + endpoint() + datanode + file + "?" + query;
+      }
+    } else if (path.compare(0, datanode.size(), datanode) == 0) {
+      std::string file = path.substr(datanode.size());
+      if (op == "OPEN") {
+        ++_opens;
+        if (_failing_opens > 0) {
+          --_failing_opens;
+          response.status = 500;
+        } else {
+          response.body = _files[file].substr(
+              std::stoll(params["offset"]), std::stoll(params["length"]));
+          response.chunked = _chunked;
+        }
+      } else if (op == "CREATE" && method == "PUT") {
+        response.status = _datanode_put_status;
+        if (response.status == 201) {
+          _files[file] = body;
+        }
+      } else {
+        response.status = 400;
+      }
+    } else {
+      response.status = 404;
+    }
+    return response;
+  }
+
+  static bool Send(int fd, const Response& response) {
+    std::string data =
+        "HTTP/1.1 " + std::to_string(response.status) + " Fake\r\n";
+    if (!response.location.empty()) {
+      data += "Location: " + response.location + "\r\n";
+    }
+    if (response.chunked) {
+      data += "Transfer-Encoding: chunked\r\n\r\n";
+      const size_t chunk_size = 1000;
+      for (size_t pos = 0; pos < response.body.size(); pos += chunk_size) {
+        std::string chunk = response.body.substr(pos, chunk_size);
+        char size[32];
+        snprintf(size, sizeof(size), "%zx\r\n", chunk.size());
+        data += size + chunk + "\r\n";
+      }
+      data += "0\r\n\r\n";
+    } else {
+      data += "Content-Length: " + std::to_string(response.body.size()) +
+              "\r\n\r\n" + response.body;
+    }
+    for (size_t pos = 0; pos < data.size();) {
+      ssize_t n = send(fd, data.data() + pos, data.size() - pos, MSG_NOSIGNAL);
+      if (n <= 0) {
+        return false;
+      }
+      pos += n;
+    }
+    return true;
+  }
+
+  int _listen_fd;
+  int _port;
+  std::thread _accept_thread;
+
+  std::mutex _mutex;
+  std::vector<int> _conn_fds;
+  std::vector<std::thread> _conn_threads;
+  std::map<std::string, std::string> _files;
+  std::map<std::string, int> _namenode_errors;
+  bool _chunked = false;
+  int _failing_opens = 0;
+  int _datanode_put_status = 201;
+  int _redirects = 0;
+  int _opens = 0;
+};
+
+std::string TestData(size_t size) {
+  std::string data(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = i % 80 == 79 ? '\n' : static_cast<char>('a' + i * 7 % 26);
+  }
+  return data;
+}
+
+std::string ReadAll(FILE* fp) {
+  std::string data;
+  char buffer[4096];
+  size_t n = 0;
+  while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+    data.append(buffer, n);
+  }
+  return data;
+}
+
+void WriteAll(FILE* fp, const std::string& data) {
+  // In pieces, the way the writers of the datasets and the models flush.
+  const size_t piece = 100 << 10;
+  for (size_t pos = 0; pos < data.size(); pos += piece) {
+    size_t size = std::min(piece, data.size() - pos);
+    ASSERT_EQ(fwrite(data.data() + pos, 1, size, fp), size);
+  }
+}
+
+}  // namespace
+
+class WebHdfsTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { server_ = new FakeWebHdfs(); }
+
+  static void TearDownTestSuite() {
+    delete server_;
+    server_ = nullptr;
+  }
+
+  void SetUp() override {
+    server_->Reset();
+    FLAGS_webhdfs_endpoint = server_->endpoint();
+    FLAGS_webhdfs_read_chunk_mb = 1;
+    FLAGS_webhdfs_read_parallelism = 2;
+  }
+
+  void TearDown() override { FLAGS_webhdfs_endpoint = ""; }
+
+  static FakeWebHdfs* server_;
+};
+
+FakeWebHdfs* WebHdfsTest::server_ = nullptr;
+
+TEST_F(WebHdfsTest, read_by_ranges_through_redirects) {
+  using paddle::framework::fs_file_size;
+  using paddle::framework::fs_open_read;
+  ASSERT_TRUE(paddle::framework::webhdfs_enabled());
+  const std::string data = TestData((3 << 20) + 123);
+  server_->PutFile("/data/part-0", data);
+  server_->PutFile("/data/empty", "");
+
+  EXPECT_EQ(fs_file_size("hdfs:/data/part-0"),
+            static_cast<int64_t>(data.size()));
+  int err_no = 0;
+  {
+    auto fp = fs_open_read("hdfs://namenode:9000/data/part-0", &err_no, "");
+    ASSERT_NE(fp, nullptr);
+    EXPECT_EQ(ReadAll(fp.get()), data);
+  }
+  EXPECT_EQ(err_no, 0);
+  // 4 ranges of 1MB, each redirected to the datanode.
+  EXPECT_EQ(server_->opens(), 4);
+  EXPECT_EQ(server_->redirects(), 4);
+
+  {
+    auto fp = fs_open_read("afs:/data/empty", &err_no, "");
+    ASSERT_NE(fp, nullptr);
+    EXPECT_EQ(ReadAll(fp.get()), "");
+  }
+  EXPECT_EQ(err_no, 0);
+}
+
+TEST_F(WebHdfsTest, read_chunked_body) {
+  server_->SetChunked(true);
+  const std::string data = TestData((1 << 20) + 4567);
+  server_->PutFile("/data/chunked", data);
+  int err_no = 0;
+  {
+    auto fp =
+        paddle::framework::fs_open_read("hdfs:/data/chunked", &err_no, "");
+    ASSERT_NE(fp, nullptr);
+    EXPECT_EQ(ReadAll(fp.get()), data);
+  }
+  EXPECT_EQ(err_no, 0);
+  EXPECT_EQ(server_->opens(), 2);
+}
+
+TEST_F(WebHdfsTest, write_and_append_write) {
+  const std::string data = TestData((2 << 20) + 789);
+  int err_no = 0;
+  {
+    auto fp = paddle::framework::fs_open_write("hdfs:/out/part-0", &err_no, "");
+    ASSERT_NE(fp, nullptr);
+    WriteAll(fp.get(), data);
+  }
+  EXPECT_EQ(err_no, 0);
+  std::string written;
+  ASSERT_TRUE(server_->GetFile("/out/part-0", &written));
+  EXPECT_EQ(written, data);
+
+  // A hdfs file is written anew by an append write, as by hadoop fs -put.
+  const std::string other = TestData(1000);
+  {
+    auto fp = paddle::framework::fs_open_append_write(
+        "hdfs:/out/part-0", &err_no, "");
+    ASSERT_NE(fp, nullptr);
+    WriteAll(fp.get(), other);
+  }
+  EXPECT_EQ(err_no, 0);
+  ASSERT_TRUE(server_->GetFile("/out/part-0", &written));
+  EXPECT_EQ(written, other);
+}
+
+TEST_F(WebHdfsTest, gzip_round_trip) {
+  const std::string data = TestData((1 << 20) + 321);
+  int err_no = 0;
+  {
+    auto fp =
+        paddle::framework::fs_open_write("hdfs:/out/part.gz", &err_no, "");
+    ASSERT_NE(fp, nullptr);
+    WriteAll(fp.get(), data);
+  }
+  EXPECT_EQ(err_no, 0);
+  std::string written;
+  ASSERT_TRUE(server_->GetFile("/out/part.gz", &written));
+  ASSERT_GE(written.size(), 2UL);
+  EXPECT_EQ(static_cast<unsigned char>(written[0]), 0x1f);
+  EXPECT_EQ(static_cast<unsigned char>(written[1]), 0x8b);
+  EXPECT_LT(written.size(), data.size());
+
+  {
+    auto fp =
+        paddle::framework::fs_open_read("hdfs:/out/part.gz", &err_no, "");
+    ASSERT_NE(fp, nullptr);
+    EXPECT_EQ(ReadAll(fp.get()), data);
+  }
+  EXPECT_EQ(err_no, 0);
+}
+
+TEST_F(WebHdfsTest, retry_failed_range) {
+  const std::string data = TestData(12345);
+  server_->PutFile("/data/flaky", data);
+  // Fewer failures than the retries of a range.
+  server_->FailOpens(2);
+  int err_no = 0;
+  {
+    auto fp = paddle::framework::webhdfs_open_read("hdfs:/data/flaky", &err_no);
+    ASSERT_NE(fp, nullptr);
+    EXPECT_EQ(ReadAll(fp.get()), data);
+  }
+  EXPECT_EQ(err_no, 0);
+  EXPECT_EQ(server_->opens(), 3);
+}
+
+TEST_F(WebHdfsTest, http_errors) {
+  using paddle::framework::webhdfs_file_size;
+  using paddle::framework::webhdfs_open_read;
+  using paddle::framework::webhdfs_open_write;
+  int err_no = 0;
+  // A missing file.
+  EXPECT_EQ(webhdfs_file_size("hdfs:/data/missing"), -1);
+  EXPECT_EQ(webhdfs_open_read("hdfs:/data/missing", &err_no), nullptr);
+
+  // A range which keeps failing fails the read, reported once closed.
+  const std::string data = TestData(12345);
+  server_->PutFile("/data/broken", data);
+  server_->FailOpens(100);
+  {
+    auto fp = webhdfs_open_read("hdfs:/data/broken", &err_no);
+    ASSERT_NE(fp, nullptr);
+    EXPECT_EQ(ReadAll(fp.get()), "");
+    EXPECT_TRUE(ferror(fp.get()));
+  }
+  EXPECT_EQ(err_no, -1);
+
+  // The namenode refuses the creation.
+  err_no = 0;
+  server_->SetNamenodeError("CREATE", 403);
+  EXPECT_EQ(webhdfs_open_write("hdfs:/out/refused", &err_no), nullptr);
+
+  // The datanode fails the write, reported once closed.
+  server_->Reset();
+  server_->SetDatanodePutStatus(500);
+  {
+    auto fp = webhdfs_open_write("hdfs:/out/failed", &err_no);
+    ASSERT_NE(fp, nullptr);
+    WriteAll(fp.get(), data);
+  }
+  EXPECT_EQ(err_no, -1);
+  std::string written;
+  EXPECT_FALSE(server_->GetFile("/out/failed", &written));
+
+  // An unexpected status of GETFILESTATUS.
+  server_->SetNamenodeError("GETFILESTATUS", 500);
+  EXPECT_EQ(webhdfs_file_size("hdfs:/out/failed"), -1);
+}
+#endif
@@ -17,7 +17,12 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/core/lod_utils.h"
+#include "paddle/phi/core/memory/allocation/allocator_facade.h"
 
 namespace paddle {
 namespace framework {
@@ -304,5 +309,49 @@ TEST(LoD, ConvertToOffsetBasedLoD) {
   EXPECT_EQ(offset_lod, expected);
 }
 
+#ifndef _WIN32
+TEST(LoDTensor, MappedTensorFile) {
+  phi::CPUContext ctx;
+  ctx.SetAllocator(paddle::memory::allocation::AllocatorFacade::Instance()
+                       .GetAllocator(phi::CPUPlace())
+                       .get());
+  phi::DenseTensor first, second;
+  first.Resize({2, 3});
+  float* first_data = first.mutable_data<float>(phi::CPUPlace());
+  for (int i = 0; i < 6; ++i) first_data[i] = static_cast<float>(i);
+  first.set_lod({{0, 1, 2}});
+  second.Resize({4});
+  int64_t* second_data = second.mutable_data<int64_t>(phi::CPUPlace());
+  for (int i = 0; i < 4; ++i) second_data[i] = i * 10;
+
+  const std::string path = "mapped_tensor_file_test.pdiparams";
+  {
+    std::ofstream fout(path, std::ios::binary);
+    SerializeToStream(fout, first, ctx);
+    SerializeToStream(fout, second, ctx);
+  }
+
+  for (bool zero_copy : {false, true}) {
+    MappedTensorFile file(path, zero_copy);
+    phi::DenseTensor first_out, second_out;
+    ASSERT_FALSE(file.AtEnd());
+    file.Next(&first_out, ctx);
+    file.Next(&second_out, ctx);
+    EXPECT_TRUE(file.AtEnd());
+
+    EXPECT_EQ(first_out.dims(), first.dims());
+    EXPECT_EQ(first_out.lod(), first.lod());
+    for (int i = 0; i < 6; ++i) {
+      EXPECT_EQ(first_out.data<float>()[i], first_data[i]);
+    }
+    EXPECT_EQ(second_out.dtype(), phi::DataType::INT64);
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_EQ(second_out.data<int64_t>()[i], second_data[i]);
+    }
+  }
+  std::remove(path.c_str());
+}
+#endif
+
 }  // namespace framework
 }  // namespace paddle
@@ -67,6 +67,53 @@ TEST(NaiveExecutor, Basic) {
   }
 }
 
+TEST(NaiveExecutor, GarbageCollectPlan) {
+  ProgramDesc program;
+  auto* main_block = program.MutableBlock(0);
+  for (auto* name : {"a", "b", "c", "d"}) {
+    main_block->Var(name)->SetType(proto::VarType::LOD_TENSOR);
+  }
+
+  auto* add = main_block->AppendOp();
+  add->SetType("elementwise_add");
+  add->SetInput("X", {"a"});
+  add->SetInput("Y", {"b"});
+  add->SetOutput("Out", {"c"});
+  auto* add2 = main_block->AppendOp();
+  add2->SetType("elementwise_add");
+  add2->SetInput("X", {"c"});
+  add2->SetInput("Y", {"b"});
+  add2->SetOutput("Out", {"d"});
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  Scope* sub_scope = &scope.NewScope();
+  NaiveExecutor exe(place);
+  exe.CreateVariables(program, 0, false, sub_scope);
+  exe.Prepare(sub_scope, program, 0);
+  exe.MakeGarbageCollectPlan(*main_block, {"a", "b", "d"});
+
+  auto* a_tensor = exe.FindTensor("a");
+  auto* b_tensor = exe.FindTensor("b");
+  a_tensor->Resize({1, 4});
+  b_tensor->Resize({1, 4});
+  float a_arr[] = {0, 1, 2, 3};
+  float b_arr[] = {0.0, .1, .2, .3};
+  std::copy_n(a_arr, 4, a_tensor->mutable_data<float>(place));
+  std::copy_n(b_arr, 4, b_tensor->mutable_data<float>(place));
+
+  for (int run = 0; run < 2; ++run) {
+    exe.Run();
+    // c is released after its last use, the skipped vars are kept.
+    EXPECT_FALSE(exe.FindTensor("c")->IsInitialized());
+    EXPECT_TRUE(a_tensor->IsInitialized());
+    const float* d_data = exe.FindTensor("d")->data<float>();
+    for (int i = 0; i < 4; i++) {
+      EXPECT_NEAR(d_data[i], 1.2 * i, 1e-3);
+    }
+  }
+}
+
 }  // namespace framework
 }  // namespace paddle
 
@@ -15,10 +15,13 @@
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 
 #include <atomic>
+#include <functional>
 #include <thread>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "paddle/fluid/framework/new_executor/workqueue/run_queue.h"
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
 
 TEST(WorkQueueUtils, TestEventsWaiter) {
@@ -203,3 +206,98 @@ TEST(WorkQueue, TestWorkQueueGroup) {
   queue_group.reset();
   waiter_thread.join();
 }
+
+TEST(WorkQueue, TestRunQueue) {
+  struct Task {
+    std::function<void()> f;
+  };
+  paddle::framework::RunQueue<Task, 64> queue;
+  std::atomic<unsigned> counter{0};
+  std::atomic<bool> stop{false};
+  constexpr unsigned kTaskNum = 20000;
+  auto make_task = [&counter]() { return Task{[&counter]() { ++counter; }}; };
+  // The owner pushes and pops at the front, remote threads push at the back
+  // and steal concurrently.
+  std::vector<std::thread> pushers;
+  for (int i = 0; i < 2; ++i) {
+    pushers.emplace_back([&]() {
+      for (unsigned k = 0; k < kTaskNum; ++k) {
+        Task t = make_task();
+        while ((t = queue.PushBack(std::move(t))).f) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < 2; ++i) {
+    thieves.emplace_back([&]() {
+      while (!stop) {
+        Task t = queue.PopBack();
+        if (t.f) {
+          t.f();
+        }
+      }
+    });
+  }
+  for (unsigned k = 0; k < kTaskNum; ++k) {
+    Task t = queue.PushFront(make_task());
+    if (t.f) {
+      t.f();
+    }
+    if (k % 3 == 0) {
+      t = queue.PopFront();
+      if (t.f) {
+        t.f();
+      }
+    }
+  }
+  for (auto& thread : pushers) {
+    thread.join();
+  }
+  while (!queue.Empty()) {
+    Task t = queue.PopFront();
+    if (t.f) {
+      t.f();
+    }
+  }
+  stop = true;
+  for (auto& thread : thieves) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.load(), 3 * kTaskNum);
+  EXPECT_EQ(queue.Size(), 0u);
+}
+
+TEST(WorkQueue, TestWorkQueueThreadStats) {
+  using paddle::framework::CreateMultiThreadedWorkQueue;
+  using paddle::framework::EventsWaiter;
+  using paddle::framework::WorkQueueOptions;
+  using paddle::framework::WorkQueueThreadStats;
+  EventsWaiter events_waiter;
+  WorkQueueOptions options(/*name*/ "MultiThreadedWorkQueueForTesting",
+                           /*num_threads*/ 4,
+                           /*allow_spinning*/ true,
+                           /*always_spinning*/ false,
+                           /*track_task*/ true,
+                           /*detached*/ true,
+                           &events_waiter);
+  auto work_queue = CreateMultiThreadedWorkQueue(options);
+  constexpr unsigned kTaskNum = 1000;
+  std::atomic<unsigned> counter{0};
+  for (unsigned i = 0; i < kTaskNum; ++i) {
+    work_queue->AddTask([&counter]() { ++counter; });
+  }
+  events_waiter.WaitEvent();
+  EXPECT_EQ(counter.load(), kTaskNum);
+  std::vector<WorkQueueThreadStats> stats = work_queue->ThreadStats();
+  ASSERT_EQ(stats.size(), 4u);
+  uint64_t executed = 0;
+  for (auto& thread_stats : stats) {
+    executed += thread_stats.executed_tasks;
+    EXPECT_LE(thread_stats.local_stolen_tasks, thread_stats.stolen_tasks);
+  }
+  // The tracked tasks are wrapped, so all of them ran on the workers.
+  EXPECT_EQ(executed, kTaskNum);
+  work_queue.reset();
+}
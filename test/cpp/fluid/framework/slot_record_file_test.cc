@@ -0,0 +1,139 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/slot_record_file.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace framework {
+
+namespace {
+
+// Writes num instances whose slot 0 holds i uint64 values and slot 1 holds
+// one float value, the float slot of every third instance left empty.
+std::string WriteFile(size_t num, uint32_t flags) {
+  std::string file;
+  SlotRecordFileWriter writer(
+      {{"click", 'u'}, {"price", 'f'}},
+      flags,
+      [&file](const char* data, size_t size) {
+        file.append(data, size);
+        return 0;
+      });
+  EXPECT_EQ(writer.WriteHeader(), 0);
+  for (size_t i = 0; i < num; ++i) {
+    std::vector<uint64_t> keys(i % 7);
+    for (size_t j = 0; j < keys.size(); ++j) {
+      keys[j] = i * 100 + j;
+    }
+    float price = i * 0.5f;
+    writer.BeginInstance("ins" + std::to_string(i), i, i % 3, i % 5);
+    writer.AddValues(0, keys.data(), keys.size());
+    if (i % 3 != 0) {
+      writer.AddValues(1, &price, 1);
+    }
+    EXPECT_EQ(writer.EndInstance(), 0);
+  }
+  EXPECT_EQ(writer.Flush(), 0);
+  return file;
+}
+
+void CheckFile(SlotRecordFileReader* reader, size_t num, uint32_t flags) {
+  ASSERT_EQ(reader->ReadHeader(), 0);
+  EXPECT_EQ(reader->flags(), flags);
+  ASSERT_EQ(reader->slots().size(), 2u);
+  EXPECT_EQ(reader->slots()[0].name, "click");
+  EXPECT_EQ(reader->slots()[1].type, 'f');
+  SlotRecordFileBlock block;
+  size_t i = 0;
+  int ret = 0;
+  while ((ret = reader->ReadBlock(&block)) == 1) {
+    for (size_t k = 0; k < block.num_ins; ++k, ++i) {
+      if (flags & kSlotRecordFileInsId) {
+        EXPECT_EQ(std::string(block.ins_ids + block.ins_id_offsets[k],
+                              block.ins_id_offsets[k + 1] -
+                                  block.ins_id_offsets[k]),
+                  "ins" + std::to_string(i));
+      }
+      if (flags & kSlotRecordFileLogKey) {
+        EXPECT_EQ(block.search_ids[k], i);
+        EXPECT_EQ(block.cmatches[k], i % 3);
+        EXPECT_EQ(block.ranks[k], i % 5);
+      }
+      const uint32_t* offsets = block.offsets[0];
+      const uint64_t* keys = static_cast<const uint64_t*>(block.values[0]);
+      ASSERT_EQ(offsets[k + 1] - offsets[k], i % 7);
+      for (size_t j = 0; j < i % 7; ++j) {
+        EXPECT_EQ(keys[offsets[k] + j], i * 100 + j);
+      }
+      offsets = block.offsets[1];
+      const float* prices = static_cast<const float*>(block.values[1]);
+      ASSERT_EQ(offsets[k + 1] - offsets[k], i % 3 != 0 ? 1u : 0u);
+      if (i % 3 != 0) {
+        EXPECT_EQ(prices[offsets[k]], i * 0.5f);
+      }
+    }
+  }
+  EXPECT_EQ(ret, 0);
+  EXPECT_EQ(i, num);
+}
+
+}  // namespace
+
+TEST(SlotRecordFile, MappedRoundTrip) {
+  size_t num = kSlotRecordFileBlockIns * 2 + 17;
+  uint32_t flags = kSlotRecordFileInsId | kSlotRecordFileLogKey;
+  std::string file = WriteFile(num, flags);
+  SlotRecordFileReader reader(file.data(), file.size());
+  CheckFile(&reader, num, flags);
+}
+
+TEST(SlotRecordFile, StreamedCompressedRoundTrip) {
+  size_t num = kSlotRecordFileBlockIns + 1;
+  uint32_t flags = kSlotRecordFileCompress;
+  std::string file = WriteFile(num, flags);
+  size_t pos = 0;
+  SlotRecordFileReader reader([&file, &pos](char* buf, size_t len) {
+    size_t n = std::min(len, file.size() - pos);
+    memcpy(buf, file.data() + pos, n);
+    pos += n;
+    return n;
+  });
+  CheckFile(&reader, num, flags);
+}
+
+TEST(SlotRecordFile, Truncated) {
+  std::string file = WriteFile(100, kSlotRecordFileCompress);
+  file.resize(file.size() - 10);
+  SlotRecordFileReader reader(file.data(), file.size());
+  ASSERT_EQ(reader.ReadHeader(), 0);
+  SlotRecordFileBlock block;
+  EXPECT_EQ(reader.ReadBlock(&block), -1);
+
+  std::string text = "1 2 3\n";
+  SlotRecordFileReader text_reader(text.data(), text.size());
+  EXPECT_EQ(text_reader.ReadHeader(), -1);
+}
+
+TEST(SlotRecordFile, Suffix) {
+  EXPECT_TRUE(IsSlotRecordFile("hdfs:/data/part-00001.slotbin"));
+  EXPECT_FALSE(IsSlotRecordFile("part-00001.txt"));
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -14,6 +14,8 @@ limitations under the License. */
 
 #include "paddle/phi/kernels/funcs/selected_rows_functor.h"
 
+#include <map>
+
 #include "gtest/gtest.h"
 #include "paddle/phi/core/memory/allocation/allocator_facade.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
@@ -431,6 +433,63 @@ TEST(selected_rows_functor, cpu_merge_add_multi_noduplicated) {
   }
 }
 
+TEST(selected_rows_functor, cpu_merge_add_many_rows) {
+  phi::CPUPlace cpu_place;
+  phi::CPUContext ctx(cpu_place);
+  ctx.SetAllocator(paddle::memory::allocation::AllocatorFacade::Instance()
+                       .GetAllocator(cpu_place)
+                       .get());
+  phi::funcs::SetConstant<phi::CPUContext, float> set_const;
+
+  // Enough rows for MergeAdd to sort them by radix.
+  int64_t height = 70000;
+  int64_t row_numel = 4;
+  std::vector<int64_t> rows1;
+  std::vector<int64_t> rows2;
+  std::map<int64_t, float> counts;
+  for (int64_t i = 0; i < 20000; ++i) {
+    rows1.push_back(i * 7919 % height);
+    rows2.push_back(i * 104729 % 3000);
+    counts[rows1.back()] += 1;
+    counts[rows2.back()] += 1;
+  }
+
+  std::unique_ptr<phi::SelectedRows> selected_rows1{
+      new phi::SelectedRows(rows1, height)};
+  auto* in1_value = selected_rows1->mutable_value();
+  in1_value->mutable_data<float>(
+      common::make_ddim({static_cast<int64_t>(rows1.size()), row_numel}),
+      cpu_place);
+  set_const(ctx, in1_value, 1.0);
+
+  std::unique_ptr<phi::SelectedRows> selected_rows2{
+      new phi::SelectedRows(rows2, height)};
+  auto* in2_value = selected_rows2->mutable_value();
+  in2_value->mutable_data<float>(
+      common::make_ddim({static_cast<int64_t>(rows2.size()), row_numel}),
+      cpu_place);
+  set_const(ctx, in2_value, 1.0);
+
+  std::unique_ptr<phi::SelectedRows> output{new phi::SelectedRows()};
+  phi::funcs::scatter::MergeAdd<phi::CPUContext, float> merge_add_functor;
+  std::vector<const phi::SelectedRows*> inputs;
+  inputs.push_back(selected_rows1.get());
+  inputs.push_back(selected_rows2.get());
+  merge_add_functor(ctx, inputs, output.get());
+
+  EXPECT_EQ(output->height(), height);
+  ASSERT_EQ(output->rows().size(), counts.size());
+  auto* out_data = output->value().data<float>();
+  size_t i = 0;
+  for (auto& count : counts) {
+    EXPECT_EQ(output->rows()[i], count.first);
+    for (int64_t j = 0; j < row_numel; ++j) {
+      EXPECT_EQ(out_data[i * row_numel + j], count.second);
+    }
+    ++i;
+  }
+}
+
 TEST(selected_rows_functor, cpu_sum_to) {
   phi::CPUPlace cpu_place;
   phi::CPUContext ctx(cpu_place);
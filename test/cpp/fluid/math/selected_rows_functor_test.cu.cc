@@ -14,6 +14,8 @@ limitations under the License. */
 
 #include "paddle/phi/kernels/funcs/selected_rows_functor.h"
 
+#include <map>
+
 #include "gtest/gtest.h"
 #include "paddle/common/errors.h"
 #include "paddle/phi/backends/context_pool.h"
@@ -283,3 +285,61 @@ TEST(selected_rows_functor, gpu_merge_add) {
     }
   }
 }
+
+TEST(selected_rows_functor, gpu_merge_add_many_rows) {
+  phi::GPUPlace gpu_place(0);
+  phi::CPUPlace cpu_place;
+  phi::GPUContext& ctx = *reinterpret_cast<phi::GPUContext*>(
+      phi::DeviceContextPool::Instance().Get(gpu_place));
+  phi::funcs::SetConstant<phi::GPUContext, float> set_const;
+
+  // Enough rows for MergeAdd to sort them by radix.
+  int64_t height = 70000;
+  int64_t row_numel = 4;
+  std::vector<int64_t> rows1;
+  std::vector<int64_t> rows2;
+  std::map<int64_t, float> counts;
+  for (int64_t i = 0; i < 20000; ++i) {
+    rows1.push_back(i * 7919 % height);
+    rows2.push_back(i * 104729 % 3000);
+    counts[rows1.back()] += 1;
+    counts[rows2.back()] += 1;
+  }
+
+  std::unique_ptr<phi::SelectedRows> selected_rows1{
+      new phi::SelectedRows(rows1, height)};
+  auto* in1_value = selected_rows1->mutable_value();
+  in1_value->mutable_data<float>(
+      common::make_ddim({static_cast<int64_t>(rows1.size()), row_numel}),
+      gpu_place);
+  set_const(ctx, in1_value, 1.0);
+
+  std::unique_ptr<phi::SelectedRows> selected_rows2{
+      new phi::SelectedRows(rows2, height)};
+  auto* in2_value = selected_rows2->mutable_value();
+  in2_value->mutable_data<float>(
+      common::make_ddim({static_cast<int64_t>(rows2.size()), row_numel}),
+      gpu_place);
+  set_const(ctx, in2_value, 1.0);
+
+  std::unique_ptr<phi::SelectedRows> output{new phi::SelectedRows()};
+  phi::funcs::scatter::MergeAdd<phi::GPUContext, float> merge_add_functor;
+  std::vector<const phi::SelectedRows*> inputs;
+  inputs.push_back(selected_rows1.get());
+  inputs.push_back(selected_rows2.get());
+  merge_add_functor(ctx, inputs, output.get());
+
+  EXPECT_EQ(output->height(), height);
+  ASSERT_EQ(output->rows().size(), counts.size());
+  phi::DenseTensor output_cpu;
+  phi::Copy(ctx, output->value(), cpu_place, true, &output_cpu);
+  auto* out_data = output_cpu.data<float>();
+  size_t i = 0;
+  for (auto& count : counts) {
+    EXPECT_EQ(output->rows()[i], count.first);
+    for (int64_t j = 0; j < row_numel; ++j) {
+      EXPECT_EQ(out_data[i * row_numel + j], count.second);
+    }
+    ++i;
+  }
+}
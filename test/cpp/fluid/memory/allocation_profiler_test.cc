@@ -0,0 +1,83 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/allocation_profiler.h"
+
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/malloc.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+TEST(AllocationProfiler, RecordPeakBlocks) {
+  auto& profiler = AllocationProfiler::Instance();
+  phi::CPUPlace place;
+  // Not recorded before Start.
+  profiler.RecordAlloc(place, 64);
+
+  profiler.Start();
+  profiler.RecordAlloc(place, 256);
+  profiler.RecordAlloc(place, 256);
+  profiler.RecordAlloc(place, 1024);
+  profiler.RecordFree(place, 256);
+  profiler.RecordFree(place, 1024);
+  // The allocation before Start is ignored.
+  profiler.RecordFree(place, 64);
+  profiler.RecordAlloc(place, 512);
+  profiler.Stop();
+  profiler.RecordAlloc(place, 4096);
+
+  auto profiles = profiler.GetProfiles();
+  ASSERT_EQ(profiles.size(), 1UL);
+  EXPECT_EQ(profiles[0].place, place);
+  EXPECT_EQ(profiles[0].peak_bytes, 1536);
+  std::vector<std::pair<size_t, size_t>> blocks = {{256, 2}, {1024, 1}};
+  EXPECT_EQ(profiles[0].blocks, blocks);
+}
+
+TEST(AllocationProfiler, SaveLoadAndReplay) {
+  AllocationProfile cpu_profile;
+  cpu_profile.place = phi::CPUPlace();
+  cpu_profile.peak_bytes = 3 << 20;
+  cpu_profile.blocks = {{1 << 20, 1}, {1 << 19, 4}};
+  AllocationProfile custom_profile;
+  custom_profile.place = phi::CustomPlace("fake_device", 1);
+  custom_profile.peak_bytes = 128;
+  custom_profile.blocks = {{128, 1}};
+
+  std::string path = "allocation_profiler_test.txt";
+  SaveAllocationProfiles(path, {cpu_profile, custom_profile});
+  auto profiles = LoadAllocationProfiles(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(profiles.size(), 2UL);
+  EXPECT_EQ(profiles[0].place, cpu_profile.place);
+  EXPECT_EQ(profiles[0].peak_bytes, cpu_profile.peak_bytes);
+  EXPECT_EQ(profiles[0].blocks, cpu_profile.blocks);
+  EXPECT_EQ(profiles[1].place, custom_profile.place);
+  EXPECT_EQ(profiles[1].blocks, custom_profile.blocks);
+
+  EXPECT_EQ(ReplayAllocationProfile(profiles[0]), 3UL << 20);
+}
+
+TEST(AllocationProfiler, LoadInvalidProfile) {
+  EXPECT_ANY_THROW(LoadAllocationProfiles("not_exist_allocation_profile"));
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
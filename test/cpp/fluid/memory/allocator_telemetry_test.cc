@@ -0,0 +1,81 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/allocation/auto_growth_best_fit_allocator.h"
+#include "paddle/phi/core/memory/allocation/cpu_allocator.h"
+#include "paddle/phi/core/memory/allocation/stat_allocator.h"
+
+PD_DECLARE_bool(free_idle_chunk);
+PD_DECLARE_int32(allocator_lifetime_sample_rate);
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+TEST(AllocatorTelemetry, auto_growth_with_stat) {
+  FLAGS_free_idle_chunk = false;
+  FLAGS_allocator_lifetime_sample_rate = 1;
+  size_t alignment = 256;
+  size_t chunk_size = 1 << 20;
+  // CPUAllocator is 4096 aligned, so each chunk is exactly chunk_size.
+  auto allocator = std::make_shared<StatAllocator>(
+      std::make_shared<AutoGrowthBestFitAllocator>(
+          std::make_shared<CPUAllocator>(), alignment, chunk_size));
+
+  std::vector<AllocationPtr> allocations;
+  for (size_t i = 0; i < 8; ++i) {
+    allocations.emplace_back(allocator->Allocate(4096));
+  }
+  // Free every other allocation to leave holes in the chunk.
+  for (size_t i = 0; i < allocations.size(); i += 2) {
+    allocations[i].reset();
+  }
+
+  std::vector<AllocatorTelemetry> telemetry;
+  allocator->CollectTelemetry(&telemetry);
+  ASSERT_EQ(telemetry.size(), 2UL);
+
+  ASSERT_EQ(telemetry[0].allocator, "StatAllocator");
+  ASSERT_EQ(telemetry[0].live_bytes, 4 * 4096);
+  int64_t sampled_num = 0;
+  for (auto num : telemetry[0].lifetime_histogram) {
+    sampled_num += num;
+  }
+  ASSERT_EQ(sampled_num, 4);
+
+  auto &ag_telemetry = telemetry[1];
+  ASSERT_EQ(ag_telemetry.allocator, "AutoGrowthBestFitAllocator");
+  ASSERT_EQ(ag_telemetry.reserved_bytes, static_cast<int64_t>(chunk_size));
+  ASSERT_EQ(ag_telemetry.live_bytes, 4 * 4096);
+  // Blocks are carved from the end of the chunk, so the free blocks are the
+  // head of the chunk and the 4 holes.
+  ASSERT_EQ(ag_telemetry.largest_free_block,
+            static_cast<int64_t>(chunk_size - 8 * 4096));
+  int64_t free_block_num = 0;
+  for (auto num : ag_telemetry.free_block_histogram) {
+    free_block_num += num;
+  }
+  ASSERT_EQ(free_block_num, 5);
+  ASSERT_EQ(ag_telemetry.free_block_histogram[Log2Bucket(4096)], 4);
+
+  allocations.clear();
+  FLAGS_allocator_lifetime_sample_rate = 64;
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -18,9 +18,11 @@
 
 #include "gtest/gtest.h"
 #include "paddle/phi/core/memory/allocation/aligned_allocator.h"
+#include "paddle/phi/core/memory/stats.h"
 
 PD_DECLARE_bool(free_idle_chunk);
 PD_DECLARE_bool(free_when_no_cache_hit);
+PD_DECLARE_uint64(auto_growth_size_class_threshold);
 
 namespace paddle {
 namespace memory {
@@ -171,6 +173,60 @@ TEST(test_auto_growth_allocator, test_free_when_no_cache_hit) {
   TestFreeWhenNoCacheHit(true);
 }
 
+TEST(test_auto_growth_allocator, test_size_class) {
+  FLAGS_free_idle_chunk = false;
+  FLAGS_free_when_no_cache_hit = false;
+  FLAGS_auto_growth_size_class_threshold = 64 << 10;
+  auto recorded_allocator = std::make_shared<RecordedAllocator>();
+
+  size_t alignment = 256;
+  size_t chunk_size = 1 << 20;
+  auto underlying_allocator =
+      std::make_shared<AlignedAllocator>(recorded_allocator, alignment);
+  auto ag_allocator = std::make_shared<AutoGrowthBestFitAllocator>(
+      underlying_allocator, alignment, chunk_size);
+  FLAGS_auto_growth_size_class_threshold = 0;
+  ASSERT_TRUE(ag_allocator->IsSizeClassEnabled());
+
+  // 300 bytes falls into the 512 bytes class, and the first miss refills the
+  // class with a batch of blocks carved from the first chunk.
+  auto allocation = ag_allocator->Allocate(300);
+  ASSERT_EQ(allocation->size(), 512UL);
+  void *ptr = allocation->ptr();
+  int64_t cached = HostMemoryStatCurrentValue("SizeClassCached", 0);
+  ASSERT_GT(cached, 0);
+  allocation.reset();
+  ASSERT_EQ(HostMemoryStatCurrentValue("SizeClassCached", 0), cached + 512);
+
+  // The freed block is served again from the size class.
+  allocation = ag_allocator->Allocate(400);
+  ASSERT_EQ(allocation->ptr(), ptr);
+  allocation.reset();
+
+  // Large requests bypass the size classes.
+  auto large_allocation = ag_allocator->Allocate(128 << 10);
+  ASSERT_EQ(large_allocation->size(), static_cast<size_t>(128 << 10));
+  large_allocation.reset();
+
+  for (auto &info : ag_allocator->GetSizeClassStats()) {
+    if (info.block_size == 512) {
+      ASSERT_EQ(info.alloc_times, 2UL);
+      ASSERT_EQ(info.hit_times, 1UL);
+      ASSERT_GT(info.cached_blocks, 0UL);
+    } else {
+      ASSERT_EQ(info.alloc_times, 0UL);
+    }
+  }
+
+  // Release flushes the cached blocks so that the idle chunk can be freed.
+  ag_allocator->Release(phi::CPUPlace());
+  ASSERT_EQ(recorded_allocator->AllocatedSize(), 0UL);
+  ASSERT_EQ(HostMemoryStatCurrentValue("SizeClassCached", 0), 0);
+  for (auto &info : ag_allocator->GetSizeClassStats()) {
+    ASSERT_EQ(info.cached_blocks, 0UL);
+  }
+}
+
 }  // namespace allocation
 }  // namespace memory
 }  // namespace paddle
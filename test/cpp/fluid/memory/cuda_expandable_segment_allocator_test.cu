@@ -0,0 +1,108 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/backends/dynload/cuda_driver.h"
+#include "paddle/phi/core/memory/allocation/cuda_expandable_segment_allocator.h"
+
+#if CUDA_VERSION >= 10020
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+static bool IsVirtualMemorySupported(int device_id) {
+  CUdevice device;
+  int val = 0;
+  if (phi::dynload::cuDeviceGet(&device, device_id) != CUDA_SUCCESS ||
+      phi::dynload::cuDeviceGetAttribute(
+          &val,
+          CU_DEVICE_ATTRIBUTE_VIRTUAL_ADDRESS_MANAGEMENT_SUPPORTED,
+          device) != CUDA_SUCCESS) {
+    return false;
+  }
+  return val > 0;
+}
+
+TEST(CUDAExpandableSegmentAllocator, GrowAndUnmapIdlePages) {
+  phi::GPUPlace place(0);
+  if (!IsVirtualMemorySupported(place.device)) {
+    return;
+  }
+  auto allocator = std::make_shared<CUDAExpandableSegmentAllocator>(place, 256);
+  size_t page = allocator->Granularity();
+  EXPECT_EQ(allocator->MappedSize(), 0UL);
+
+  auto a = allocator->Allocate(page);
+  auto b = allocator->Allocate(3 * page);
+  auto c = allocator->Allocate(page);
+  // Blocks are laid out back to back in the range.
+  EXPECT_EQ(static_cast<char*>(a->ptr()) + page, b->ptr());
+  EXPECT_EQ(static_cast<char*>(b->ptr()) + 3 * page, c->ptr());
+  EXPECT_EQ(allocator->MappedSize(), 5 * page);
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaMemset(b->ptr(), 0, b->size()));
+
+  // The hole left by b is reused without mapping new pages.
+  void* b_ptr = b->ptr();
+  b.reset();
+  auto d = allocator->Allocate(2 * page);
+  EXPECT_EQ(d->ptr(), b_ptr);
+  EXPECT_EQ(allocator->MappedSize(), 5 * page);
+
+  // The idle page between d and c is unmapped, the others are still in use.
+  EXPECT_EQ(allocator->Release(place), page);
+  EXPECT_EQ(allocator->MappedSize(), 4 * page);
+
+  // A block larger than the hole goes to the tail and is still contiguous.
+  auto e = allocator->Allocate(4 * page);
+  EXPECT_EQ(static_cast<char*>(c->ptr()) + page, e->ptr());
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaMemset(e->ptr(), 0, e->size()));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaDeviceSynchronize());
+
+  a.reset();
+  c.reset();
+  d.reset();
+  e.reset();
+  EXPECT_EQ(allocator->Release(place), 8 * page);
+  EXPECT_EQ(allocator->MappedSize(), 0UL);
+}
+
+TEST(CUDAExpandableSegmentAllocator, SharePageBetweenSmallBlocks) {
+  phi::GPUPlace place(0);
+  if (!IsVirtualMemorySupported(place.device)) {
+    return;
+  }
+  auto allocator = std::make_shared<CUDAExpandableSegmentAllocator>(place, 256);
+  size_t page = allocator->Granularity();
+
+  auto a = allocator->Allocate(1000);
+  auto b = allocator->Allocate(1000);
+  EXPECT_EQ(a->size(), 1024UL);
+  EXPECT_EQ(allocator->MappedSize(), page);
+
+  // The page is still used by b.
+  a.reset();
+  EXPECT_EQ(allocator->Release(place), 0UL);
+  b.reset();
+  EXPECT_EQ(allocator->Release(place), page);
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
+
+#endif
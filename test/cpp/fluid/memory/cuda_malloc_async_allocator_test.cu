@@ -16,6 +16,8 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/core/memory/allocation/cuda_malloc_async_allocator.h"
 #include "paddle/phi/core/memory/allocation/allocator_facade.h"
 #include "paddle/phi/core/memory/memory.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
@@ -29,6 +31,8 @@
 #include "paddle/phi/core/platform/cuda_graph_with_memory_pool.h"
 #endif
 
+COMMON_DECLARE_bool(cuda_malloc_async_per_stream_pool);
+
 namespace paddle {
 namespace memory {
 
@@ -375,6 +379,43 @@ TEST_F(CUDAMallocAsyncTest, CUDAGraphTest) {
   CUDAGraphRun();
   CheckResult();
 }
+
+TEST(CUDAMallocAsyncPerStreamPoolTest, ReuseAndReleaseTest) {
+  FLAGS_cuda_malloc_async_per_stream_pool = true;
+  phi::GPUPlace place = phi::GPUPlace();
+  gpuStream_t stream, other_stream;
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamCreate(&stream));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamCreate(&other_stream));
+  auto allocator = std::make_shared<allocation::CUDAMallocAsyncAllocator>(
+      nullptr, place, stream);
+  FLAGS_cuda_malloc_async_per_stream_pool = false;
+
+  size_t alloc_size = 1 << 20;
+  void *address = nullptr;
+  {
+    auto allocation = allocator->Allocate(alloc_size);
+    address = allocation->ptr();
+  }
+  {
+    // Freed on the owning stream, the next allocation takes the same block.
+    auto allocation = allocator->Allocate(alloc_size);
+    EXPECT_EQ(allocation->ptr(), address);
+  }
+  {
+    std::shared_ptr<phi::Allocation> allocation =
+        allocator->Allocate(alloc_size);
+    RecordStream(allocation, other_stream);
+  }
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(other_stream));
+
+  EXPECT_GE(allocator->Release(place), alloc_size);
+  CheckMemLeak(place);
+
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamDestroy(stream));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamDestroy(other_stream));
+}
+
 #endif
 
 }  // namespace memory
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/numa_aware_cpu_allocator.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/allocation/cpu_allocator.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+static bool IsAligned(const void* ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(NumaAwareCPUAllocator, SmallAndLargeBlocks) {
+  NumaAwareCPUAllocator allocator(
+      CPUNumaPolicy::kLocal, CPUHugePagePolicy::kNone, 2UL << 20);
+  EXPECT_GE(NumaAwareCPUAllocator::NumaNodeCount(), 1);
+  EXPECT_GE(NumaAwareCPUAllocator::CurrentNumaNode(), 0);
+
+  auto small = allocator.Allocate(1000);
+  EXPECT_EQ(small->size(), 1000UL);
+  EXPECT_TRUE(IsAligned(small->ptr(), CPUAllocator::kAlignment));
+  std::memset(small->ptr(), 1, small->size());
+
+  size_t large_size = NumaAwareCPUAllocator::kMmapThreshold + 100;
+  auto large = allocator.Allocate(large_size);
+  EXPECT_EQ(large->size(), large_size);
+  EXPECT_TRUE(IsAligned(large->ptr(), CPUAllocator::kAlignment));
+  std::memset(large->ptr(), 1, large->size());
+}
+
+#ifdef __linux__
+TEST(NumaAwareCPUAllocator, HugePageAlignment) {
+  for (auto policy :
+       {CPUHugePagePolicy::kTransparent, CPUHugePagePolicy::kExplicit}) {
+    NumaAwareCPUAllocator allocator(CPUNumaPolicy::kInterleave, policy, 0);
+    // kExplicit falls back to transparent huge pages without hugetlbfs.
+    auto block = allocator.Allocate(NumaAwareCPUAllocator::kHugePageSize + 1);
+    EXPECT_TRUE(IsAligned(block->ptr(), NumaAwareCPUAllocator::kHugePageSize));
+    std::memset(block->ptr(), 1, block->size());
+  }
+}
+#endif
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
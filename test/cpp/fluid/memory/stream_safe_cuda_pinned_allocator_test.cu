@@ -0,0 +1,68 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/stream_safe_cuda_pinned_allocator.h"
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/allocation/pinned_allocator.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// Keeps the stream busy so that the copy queued after it is still pending.
+__global__ void spin_kernel(int64_t cycles) {
+  int64_t start = clock64();
+  while (clock64() - start < cycles) {
+  }
+}
+
+TEST(StreamSafeCUDAPinnedAllocator, DelayReuseUntilCopyDone) {
+  auto allocator = std::make_shared<StreamSafeCUDAPinnedAllocator>(
+      std::make_shared<CPUPinnedAllocator>());
+  size_t size = 1 << 20;
+  gpuStream_t stream;
+  void* device_ptr;
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamCreate(&stream));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaMalloc(&device_ptr, size));
+
+  {
+    std::shared_ptr<phi::Allocation> pinned = allocator->Allocate(size);
+    EXPECT_GE(pinned->size(), size);
+    spin_kernel<<<1, 1, 0, stream>>>(1LL << 30);
+    PADDLE_ENFORCE_GPU_SUCCESS(cudaMemcpyAsync(
+        device_ptr, pinned->ptr(), size, cudaMemcpyHostToDevice, stream));
+    std::dynamic_pointer_cast<StreamSafeCUDAPinnedAllocation>(pinned)
+        ->RecordStream(stream);
+  }
+  // The copy is queued behind the spinning kernel.
+  EXPECT_EQ(allocator->PendingBytes(), size);
+
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamSynchronize(stream));
+  auto another = allocator->Allocate(size);
+  EXPECT_EQ(allocator->PendingBytes(), 0UL);
+
+  {
+    // No stream is recorded, the block is freed at once.
+    auto pinned = allocator->Allocate(size);
+  }
+  EXPECT_EQ(allocator->PendingBytes(), 0UL);
+
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaFree(device_ptr));
+  PADDLE_ENFORCE_GPU_SUCCESS(cudaStreamDestroy(stream));
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
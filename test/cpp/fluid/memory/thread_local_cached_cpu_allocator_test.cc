@@ -0,0 +1,108 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/thread_local_cached_cpu_allocator.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/allocation/cpu_allocator.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+class CountedCPUAllocator : public CPUAllocator {
+ public:
+  size_t AllocTimes() const { return alloc_times_; }
+
+ protected:
+  phi::Allocation *AllocateImpl(size_t size) override {
+    ++alloc_times_;
+    return CPUAllocator::AllocateImpl(size);
+  }
+
+ private:
+  std::atomic<size_t> alloc_times_{0};
+};
+
+TEST(ThreadLocalCachedCPUAllocator, reuse_in_thread) {
+  auto underlying_allocator = std::make_shared<CountedCPUAllocator>();
+  auto allocator = std::make_shared<ThreadLocalCachedCPUAllocator>(
+      underlying_allocator, 1 << 20);
+
+  auto allocation = allocator->Allocate(1000);
+  ASSERT_GE(allocation->size(), 1000UL);
+  void *ptr = allocation->ptr();
+  allocation.reset();
+  ASSERT_EQ(allocator->ThreadCachedBytes(), 1024UL);
+
+  // A freed block is reused by the same thread without touching the
+  // underlying allocator.
+  allocation = allocator->Allocate(1000);
+  ASSERT_EQ(allocation->ptr(), ptr);
+  ASSERT_EQ(underlying_allocator->AllocTimes(), 1UL);
+  allocation.reset();
+
+  // Large requests are not cached.
+  auto large_allocation = allocator->Allocate(4 << 20);
+  large_allocation.reset();
+  ASSERT_EQ(allocator->ThreadCachedBytes(), 1024UL);
+
+  ASSERT_EQ(allocator->Release(phi::CPUPlace()), 1024UL);
+  ASSERT_EQ(allocator->ThreadCachedBytes(), 0UL);
+  ASSERT_EQ(allocator->CentralCachedBytes(), 0UL);
+}
+
+TEST(ThreadLocalCachedCPUAllocator, max_cached_bytes_per_thread) {
+  size_t max_cached_bytes = 64 << 10;
+  auto allocator = std::make_shared<ThreadLocalCachedCPUAllocator>(
+      std::make_shared<CPUAllocator>(), max_cached_bytes);
+
+  std::vector<AllocationPtr> allocations;
+  for (size_t i = 0; i < 64; ++i) {
+    allocations.emplace_back(allocator->Allocate(4096));
+  }
+  allocations.clear();
+  ASSERT_LE(allocator->ThreadCachedBytes(), max_cached_bytes);
+  ASSERT_EQ(allocator->ThreadCachedBytes() + allocator->CentralCachedBytes(),
+            64UL * 4096);
+}
+
+TEST(ThreadLocalCachedCPUAllocator, return_to_central_on_thread_exit) {
+  auto underlying_allocator = std::make_shared<CountedCPUAllocator>();
+  auto allocator = std::make_shared<ThreadLocalCachedCPUAllocator>(
+      underlying_allocator, 1 << 20);
+
+  std::thread t([&]() {
+    std::vector<AllocationPtr> allocations;
+    for (size_t i = 0; i < 8; ++i) {
+      allocations.emplace_back(allocator->Allocate(256));
+    }
+  });
+  t.join();
+  ASSERT_EQ(allocator->CentralCachedBytes(), 8UL * 256);
+
+  // Blocks returned by the exited thread are fetched by this thread.
+  auto allocation = allocator->Allocate(256);
+  ASSERT_EQ(underlying_allocator->AllocTimes(), 8UL);
+  allocation.reset();
+  ASSERT_EQ(allocator->Release(phi::CPUPlace()), 8UL * 256);
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdio>
+#include <fstream>
 #include <set>
 #include <string>
 
@@ -25,6 +27,8 @@
 #endif
 #include "paddle/fluid/platform/profiler/event_python.h"
 #include "paddle/fluid/platform/profiler/profiler.h"
+#include "paddle/phi/api/profiler/event_name_registry.h"
+#include "paddle/phi/api/profiler/host_event_dump.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/platform/profiler.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
@@ -141,3 +145,33 @@ TEST(ProfilerTest, TestHostTracerForMem) {
   auto profiler_result = profiler->Stop();
   auto nodetree = profiler_result->GetNodeTrees();
 }
+
+TEST(ProfilerTest, TestHostEventDump) {
+  using paddle::platform::StartHostEventDump;
+  using paddle::platform::StopHostEventDump;
+  using phi::RecordEvent;
+  using phi::TracerEventType;
+  std::string name = "TestHostEventDump_interned";
+  const char* interned = phi::EventNameRegistry::Instance().Intern(name);
+  EXPECT_STREQ(interned, name.c_str());
+  EXPECT_EQ(phi::EventNameRegistry::Instance().Intern(std::string(name)),
+            interned);
+
+  StartHostEventDump(1);
+  for (int i = 0; i < 3; ++i) {
+    RecordEvent event(name, TracerEventType::UserDefined, 1);
+  }
+  {
+    RecordEvent event(
+        "TestHostEventDump_level2", TracerEventType::Operator, 2);
+  }
+  std::string path = "test_host_event_dump.bin";
+  EXPECT_EQ(StopHostEventDump(path), 3u);
+
+  std::ifstream in(path, std::ios::binary);
+  char magic[sizeof(phi::kHostEventDumpMagic) - 1];
+  in.read(magic, sizeof(magic));
+  EXPECT_EQ(std::string(magic, sizeof(magic)), phi::kHostEventDumpMagic);
+  in.close();
+  std::remove(path.c_str());
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/common/enforce.h"
+#include "paddle/fluid/imperative/data_pipeline.h"
+
+namespace paddle {
+namespace imperative {
+
+// two fields per sample: [3] float filled with the index and a scalar int64
+static DataPipeline::Sample MakeSample(int64_t index) {
+  DataPipeline::Sample sample(2);
+  sample[0].Resize(common::make_ddim({3}));
+  float* image = sample[0].mutable_data<float>(phi::CPUPlace());
+  for (int i = 0; i < 3; ++i) {
+    image[i] = static_cast<float>(index);
+  }
+  sample[1].Resize(common::make_ddim({}));
+  *sample[1].mutable_data<int64_t>(phi::CPUPlace()) = index;
+  return sample;
+}
+
+static std::vector<std::vector<int64_t>> MakeBatches(int64_t num,
+                                                     int64_t batch_size) {
+  std::vector<std::vector<int64_t>> batches;
+  for (int64_t i = 0; i < num; i += batch_size) {
+    batches.emplace_back();
+    for (int64_t k = i; k < std::min(num, i + batch_size); ++k) {
+      batches.back().push_back(k);
+    }
+  }
+  return batches;
+}
+
+TEST(DataPipeline, StacksBatchesInOrder) {
+  DataPipeline pipeline(
+      [](int64_t index) {
+        // later samples come first
+        std::this_thread::sleep_for(std::chrono::microseconds(100 - index));
+        return MakeSample(index);
+      },
+      4,
+      3,
+      false);
+  for (int epoch = 0; epoch < 2; ++epoch) {
+    pipeline.Reset(MakeBatches(50, 8));
+    int64_t expected = 0;
+    std::vector<phi::DenseTensor> batch;
+    while (pipeline.Next(&batch)) {
+      ASSERT_EQ(batch.size(), 2UL);
+      int64_t num = batch[1].numel();
+      EXPECT_EQ(batch[0].dims(), common::make_ddim({num, 3}));
+      EXPECT_EQ(batch[1].dims(), common::make_ddim({num}));
+      for (int64_t k = 0; k < num; ++k) {
+        EXPECT_EQ(batch[1].data<int64_t>()[k], expected + k);
+        EXPECT_EQ(batch[0].data<float>()[k * 3 + 2],
+                  static_cast<float>(expected + k));
+      }
+      expected += num;
+    }
+    EXPECT_EQ(expected, 50);
+  }
+}
+
+TEST(DataPipeline, PrefetchesAtMostPrefetchNum) {
+  std::atomic<int> fetched(0);
+  DataPipeline pipeline(
+      [&fetched](int64_t index) {
+        ++fetched;
+        return MakeSample(index);
+      },
+      4,
+      2,
+      false);
+  pipeline.Reset(MakeBatches(100, 1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(fetched.load(), 2);
+
+  std::vector<phi::DenseTensor> batch;
+  ASSERT_TRUE(pipeline.Next(&batch));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(fetched.load(), 3);
+}
+
+TEST(DataPipeline, RethrowsFetchError) {
+  DataPipeline pipeline(
+      [](int64_t index) {
+        PADDLE_ENFORCE_NE(
+            index, 5, common::errors::InvalidArgument("Bad sample."));
+        return MakeSample(index);
+      },
+      2,
+      2,
+      false);
+  pipeline.Reset(MakeBatches(12, 4));
+  std::vector<phi::DenseTensor> batch;
+  EXPECT_TRUE(pipeline.Next(&batch));
+  EXPECT_THROW(pipeline.Next(&batch), common::enforce::EnforceNotMet);
+  EXPECT_TRUE(pipeline.Next(&batch));
+  EXPECT_FALSE(pipeline.Next(&batch));
+}
+
+TEST(DataPipeline, RejectsSamplesOfDifferentShapes) {
+  DataPipeline pipeline(
+      [](int64_t index) {
+        DataPipeline::Sample sample(1);
+        sample[0].Resize(common::make_ddim({index + 1}));
+        sample[0].mutable_data<float>(phi::CPUPlace());
+        return sample;
+      },
+      1,
+      1,
+      false);
+  pipeline.Reset(MakeBatches(2, 2));
+  std::vector<phi::DenseTensor> batch;
+  EXPECT_THROW(pipeline.Next(&batch), common::enforce::EnforceNotMet);
+}
+
+TEST(DataPipeline, ShutdownStopsNext) {
+  DataPipeline pipeline(MakeSample, 2, 2, false);
+  pipeline.Reset(MakeBatches(10, 2));
+  pipeline.Shutdown();
+  std::vector<phi::DenseTensor> batch;
+  EXPECT_FALSE(pipeline.Next(&batch));
+}
+
+}  // namespace imperative
+}  // namespace paddle
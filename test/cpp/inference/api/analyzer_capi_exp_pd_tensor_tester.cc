@@ -206,6 +206,77 @@ TEST(PD_Tensor, from_buffer) {
   PD_ConfigDestroy(config);
 }
 
+TEST(PD_Tensor, binding) {
+  auto model_dir = FLAGS_infer_model;
+  PD_Config* config = PD_ConfigCreate();
+  PD_ConfigSetModel(config,
+                    (model_dir + "/__model__").c_str(),
+                    (model_dir + "/__params__").c_str());
+  PD_Predictor* predictor = PD_PredictorCreate(config);
+  PD_OneDimArrayCstr* input_names = PD_PredictorGetInputNames(predictor);
+  PD_OneDimArrayCstr* output_names = PD_PredictorGetOutputNames(predictor);
+
+  // the expected output of the run by the tensor handles
+  std::array<int32_t, 4> shapes = {1, 3, 224, 224};
+  std::vector<float> input(1 * 3 * 224 * 224, 1);
+  PD_Tensor* tensor =
+      PD_PredictorGetInputHandle(predictor, input_names->data[0]);
+  PD_TensorReshape(tensor, 4, shapes.data());
+  PD_TensorCopyFromCpuFloat(tensor, input.data());
+  PD_PredictorRun(predictor);
+  PD_Tensor* output_tensor =
+      PD_PredictorGetOutputHandle(predictor, output_names->data[0]);
+  PD_OneDimArrayInt32* output_shape = PD_TensorGetShape(output_tensor);
+  std::vector<int64_t> max_output_shape(
+      output_shape->data, output_shape->data + output_shape->size);
+  int32_t out_num = std::accumulate(output_shape->data,
+                                    output_shape->data + output_shape->size,
+                                    1,
+                                    std::multiplies<>());
+  std::vector<float> expected(out_num);
+  PD_TensorCopyToCpuFloat(output_tensor, expected.data());
+
+  PD_Binding* binding = PD_BindingCreate(predictor);
+  std::array<int64_t, 4> max_input_shape = {1, 3, 224, 224};
+  EXPECT_EQ(PD_BindingAddInput(binding,
+                               input_names->data[0],
+                               PD_DATA_FLOAT32,
+                               4,
+                               max_input_shape.data(),
+                               PD_PLACE_CPU,
+                               input.data()),
+            0);
+  std::vector<float> output(out_num);
+  EXPECT_EQ(PD_BindingAddOutput(binding,
+                                output_names->data[0],
+                                PD_DATA_FLOAT32,
+                                max_output_shape.size(),
+                                max_output_shape.data(),
+                                PD_PLACE_CPU,
+                                output.data()),
+            0);
+  std::vector<int64_t> run_output_shape(max_output_shape.size());
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(PD_BindingRun(binding,
+                              nullptr,
+                              max_input_shape.data(),
+                              nullptr,
+                              run_output_shape.data()));
+    EXPECT_EQ(run_output_shape, max_output_shape);
+    for (int32_t j = 0; j < out_num; ++j) {
+      EXPECT_NEAR(output[j], expected[j], 1e-5);
+    }
+  }
+
+  PD_BindingDestroy(binding);
+  PD_OneDimArrayInt32Destroy(output_shape);
+  PD_TensorDestroy(output_tensor);
+  PD_TensorDestroy(tensor);
+  PD_OneDimArrayCstrDestroy(output_names);
+  PD_OneDimArrayCstrDestroy(input_names);
+  PD_PredictorDestroy(predictor);
+}
+
 }  // namespace analysis
 }  // namespace inference
 }  // namespace paddle
@@ -0,0 +1,80 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/inference/api/int8_calibration.h"
+
+namespace paddle {
+namespace inference {
+
+TEST(ActivationHistogram, Thresholds) {
+  // Gaussian values with a few large outliers, in batches of growing range.
+  std::mt19937 random(0);
+  std::normal_distribution<float> normal(0.f, 1.f);
+  ActivationHistogram histogram;
+  for (int batch = 0; batch < 4; ++batch) {
+    std::vector<float> data(10000);
+    for (auto &x : data) x = normal(random) * (batch + 1);
+    data[batch] = 50.f * (batch + 1);
+    histogram.Collect(data.data(), data.size());
+  }
+
+  EXPECT_FLOAT_EQ(histogram.AbsMaxThreshold(), 200.f);
+  // The outliers are clipped by the other algorithms.
+  float kl = histogram.KLThreshold();
+  EXPECT_GT(kl, 4.f);
+  EXPECT_LT(kl, 100.f);
+  float percentile = histogram.PercentileThreshold(99.f);
+  EXPECT_GT(percentile, 4.f);
+  EXPECT_LT(percentile, 20.f);
+  EXPECT_LE(histogram.PercentileThreshold(99.f),
+            histogram.PercentileThreshold(99.99f));
+  EXPECT_FLOAT_EQ(histogram.PercentileThreshold(100.f), 200.f);
+}
+
+TEST(ActivationHistogram, Zeros) {
+  ActivationHistogram histogram;
+  std::vector<float> zeros(16, 0.f);
+  histogram.Collect(zeros.data(), zeros.size());
+  EXPECT_EQ(histogram.AbsMaxThreshold(), 0.f);
+  EXPECT_EQ(histogram.KLThreshold(), 0.f);
+
+  std::vector<float> data{0.5f, -1.f};
+  histogram.Collect(data.data(), data.size());
+  EXPECT_EQ(histogram.AbsMaxThreshold(), 1.f);
+  EXPECT_EQ(histogram.PercentileThreshold(100.f), 1.f);
+}
+
+TEST(Int8CalibrationTable, SerializeAndDeserialize) {
+  const std::string path = "int8_calibration_table.txt";
+  std::vector<Int8CalibrationEntry> table{{0, "pd_op.conv2d", 0, 1.25f},
+                                          {3, "pd_op.matmul", 1, 0.1f}};
+  SerializeInt8CalibrationTable(path, table);
+  auto loaded = DeserializeInt8CalibrationTable(path);
+  ASSERT_EQ(loaded.size(), table.size());
+  for (size_t i = 0; i < table.size(); ++i) {
+    EXPECT_EQ(loaded[i].op_id, table[i].op_id);
+    EXPECT_EQ(loaded[i].op_name, table[i].op_name);
+    EXPECT_EQ(loaded[i].operand, table[i].operand);
+    EXPECT_EQ(loaded[i].threshold, table[i].threshold);
+  }
+  std::remove(path.c_str());
+}
+
+}  // namespace inference
+}  // namespace paddle
@@ -0,0 +1,132 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <future>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/inference/api/paddle_infer_contrib.h"
+
+namespace paddle_infer {
+namespace contrib {
+
+namespace {
+
+// The greedy next token of the fake target model.
+int64_t NextToken(int64_t token) { return (token * 3 + 1) % 50; }
+
+// The draft agrees with the target but on the multiples of 4.
+int64_t DraftToken(int64_t token) {
+  return token % 4 == 0 ? NextToken(token) + 1 : NextToken(token);
+}
+
+GenerationEngine::StepRunner FakeRunner(int64_t (*next)(int64_t)) {
+  return [next](const GenerationEngine::StepInputs& inputs,
+                PagedKVCacheManager* cache) {
+    std::vector<int64_t> outputs;
+    size_t offset = 0;
+    for (size_t i = 0; i < inputs.seq_ids.size(); ++i) {
+      const int len = inputs.seq_lens_this_time[i];
+      // The new tokens are in the cache after the cached ones.
+      EXPECT_EQ(cache->SequenceLength(inputs.seq_ids[i]),
+                inputs.seq_lens_decoder[i] + len);
+      for (int pos = len - inputs.output_lens[i]; pos < len; ++pos) {
+        outputs.push_back(next(inputs.token_ids[offset + pos]));
+      }
+      offset += len;
+    }
+    return outputs;
+  };
+}
+
+std::vector<int64_t> Expected(int64_t last,
+                              int max_new_tokens,
+                              int64_t eos_token_id) {
+  std::vector<int64_t> tokens;
+  while (static_cast<int>(tokens.size()) < max_new_tokens) {
+    last = NextToken(last);
+    tokens.push_back(last);
+    if (last == eos_token_id) break;
+  }
+  return tokens;
+}
+
+}  // namespace
+
+TEST(GenerationEngine, ContinuousBatching) {
+  PagedKVCacheManager cache(32, 4, 8);
+  GenerationEngine::Options options;
+  options.max_batch_size = 2;
+  options.max_prefill_tokens = 4;
+  options.eos_token_id = 30;
+  std::vector<std::future<std::vector<int64_t>>> futures;
+  {
+    GenerationEngine engine(FakeRunner(NextToken), &cache, options);
+    futures.push_back(engine.Submit({7, 8, 1}, 16));
+    futures.push_back(engine.Submit({2}, 5));
+    futures.push_back(engine.Submit({5, 6}, 9));
+    EXPECT_EQ(futures[0].get(), Expected(1, 16, 30));
+    EXPECT_EQ(futures[1].get(), Expected(2, 5, 30));
+    EXPECT_EQ(futures[2].get(), Expected(6, 9, 30));
+    auto stats = engine.GetStats();
+    EXPECT_GE(stats.num_prefill_steps, 2);
+    EXPECT_EQ(stats.num_draft_tokens, 0);
+  }
+  EXPECT_EQ(cache.NumAvailableBlocks(), 32);
+}
+
+TEST(GenerationEngine, SpeculativeDecoding) {
+  PagedKVCacheManager target_cache(32, 4, 8);
+  PagedKVCacheManager draft_cache(32, 4, 8);
+  GenerationEngine::Options options;
+  options.num_speculative_tokens = 3;
+  GenerationEngine engine(FakeRunner(NextToken),
+                          &target_cache,
+                          options,
+                          FakeRunner(DraftToken),
+                          &draft_cache);
+  auto first = engine.Submit({1}, 20);
+  auto second = engine.Submit({9, 2}, 12);
+  // The output is the greedy decoding of the target.
+  EXPECT_EQ(first.get(), Expected(1, 20, -1));
+  EXPECT_EQ(second.get(), Expected(2, 12, -1));
+  auto stats = engine.GetStats();
+  EXPECT_EQ(stats.num_generated_tokens, 32);
+  EXPECT_GT(stats.num_accepted_draft_tokens, 0);
+  EXPECT_LT(stats.num_accepted_draft_tokens, stats.num_draft_tokens);
+  EXPECT_LT(stats.num_decode_steps, 30);
+  EXPECT_EQ(target_cache.NumAvailableBlocks(), 32);
+  EXPECT_EQ(draft_cache.NumAvailableBlocks(), 32);
+}
+
+TEST(GenerationEngine, Preemption) {
+  // The two sequences take 10 blocks at their ends.
+  PagedKVCacheManager cache(6, 2, 8);
+  GenerationEngine::Options options;
+  GenerationEngine engine(FakeRunner(NextToken), &cache, options);
+  auto first = engine.Submit({3, 4, 1}, 8);
+  auto second = engine.Submit({5, 6, 2}, 8);
+  EXPECT_EQ(first.get(), Expected(1, 8, -1));
+  EXPECT_EQ(second.get(), Expected(2, 8, -1));
+  EXPECT_GT(engine.GetStats().num_preemptions, 0);
+
+  // A sequence longer than the cache fails alone.
+  PagedKVCacheManager small_cache(2, 2, 8);
+  GenerationEngine small_engine(FakeRunner(NextToken), &small_cache, options);
+  auto failed = small_engine.Submit({1, 2, 3}, 8);
+  EXPECT_THROW(failed.get(), std::exception);
+}
+
+}  // namespace contrib
+}  // namespace paddle_infer
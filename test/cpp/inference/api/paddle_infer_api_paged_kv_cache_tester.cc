@@ -0,0 +1,110 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/inference/api/paddle_infer_contrib.h"
+
+namespace paddle_infer {
+namespace contrib {
+
+TEST(PagedKVCacheManager, AppendAndFree) {
+  PagedKVCacheManager manager(4, 2, 8);
+  EXPECT_EQ(manager.AddSequence(0, {1, 2, 3}), 0);
+  EXPECT_EQ(manager.BlockTable(0).size(), 2UL);
+  EXPECT_EQ(manager.NumAvailableBlocks(), 2);
+
+  EXPECT_TRUE(manager.AppendTokens(0, {4}));
+  EXPECT_EQ(manager.BlockTable(0).size(), 2UL);
+  EXPECT_TRUE(manager.AppendTokens(0, {5, 6, 7}));
+  EXPECT_EQ(manager.SequenceLength(0), 7);
+  EXPECT_EQ(manager.NumAvailableBlocks(), 0);
+  // Out of blocks, nothing changes.
+  EXPECT_FALSE(manager.AppendTokens(0, {8, 9}));
+  EXPECT_EQ(manager.SequenceLength(0), 7);
+
+  manager.FreeSequence(0);
+  EXPECT_EQ(manager.NumAvailableBlocks(), 4);
+}
+
+TEST(PagedKVCacheManager, ForkCopiesSharedLastBlock) {
+  PagedKVCacheManager manager(8, 4, 4);
+  ASSERT_EQ(manager.AddSequence(0, {1, 2, 3, 4, 5}), 0);
+  manager.ForkSequence(0, 1);
+  EXPECT_EQ(manager.BlockTable(0), manager.BlockTable(1));
+  EXPECT_EQ(manager.NumAvailableBlocks(), 6);
+
+  // The full first block stays shared, the partial last one is copied.
+  ASSERT_TRUE(manager.AppendTokens(1, {6}));
+  auto parent = manager.BlockTable(0);
+  auto child = manager.BlockTable(1);
+  EXPECT_EQ(parent[0], child[0]);
+  EXPECT_NE(parent[1], child[1]);
+  auto copies = manager.TakeBlockCopies();
+  ASSERT_EQ(copies.size(), 1UL);
+  EXPECT_EQ(copies[0], std::make_pair(parent[1], child[1]));
+  EXPECT_TRUE(manager.TakeBlockCopies().empty());
+
+  // The parent now owns its last block alone and writes it in place.
+  ASSERT_TRUE(manager.AppendTokens(0, {7}));
+  EXPECT_EQ(manager.BlockTable(0), parent);
+  EXPECT_TRUE(manager.TakeBlockCopies().empty());
+}
+
+TEST(PagedKVCacheManager, PrefixCache) {
+  PagedKVCacheManager manager(6, 2, 4);
+  ASSERT_EQ(manager.AddSequence(0, {1, 2, 3, 4, 5}), 0);
+  auto first = manager.BlockTable(0);
+
+  // Both full blocks are shared, the partial one is not.
+  EXPECT_EQ(manager.AddSequence(1, {1, 2, 3, 4, 6}), 4);
+  auto second = manager.BlockTable(1);
+  EXPECT_EQ(first[0], second[0]);
+  EXPECT_EQ(first[1], second[1]);
+  EXPECT_NE(first[2], second[2]);
+
+  // A different first block breaks the chain even if the second matches.
+  manager.FreeSequence(1);
+  EXPECT_EQ(manager.AddSequence(2, {9, 2, 3, 4}), 0);
+  manager.FreeSequence(2);
+
+  // Freed cached blocks stay reusable until evicted.
+  manager.FreeSequence(0);
+  EXPECT_EQ(manager.NumAvailableBlocks(), 6);
+  EXPECT_EQ(manager.AddSequence(3, {1, 2, 3, 4}), 4);
+  EXPECT_EQ(manager.BlockTable(3),
+            std::vector<int>(first.begin(), first.begin() + 2));
+}
+
+TEST(PagedKVCacheManager, Truncate) {
+  PagedKVCacheManager manager(8, 2, 4);
+  ASSERT_EQ(manager.AddSequence(0, {1, 2, 3, 4, 5}), 0);
+  auto blocks = manager.BlockTable(0);
+  manager.TruncateSequence(0, 3);
+  EXPECT_EQ(manager.SequenceLength(0), 3);
+  EXPECT_EQ(manager.BlockTable(0),
+            std::vector<int>(blocks.begin(), blocks.begin() + 2));
+  EXPECT_EQ(manager.NumAvailableBlocks(), 6);
+
+  // The truncated block left the prefix cache and is written in place.
+  ASSERT_TRUE(manager.AppendTokens(0, {9}));
+  EXPECT_EQ(manager.BlockTable(0)[1], blocks[1]);
+  EXPECT_EQ(manager.AddSequence(1, {1, 2, 3, 9}), 4);
+  EXPECT_EQ(manager.AddSequence(2, {1, 2, 3, 4}), 2);
+}
+
+}  // namespace contrib
+}  // namespace paddle_infer
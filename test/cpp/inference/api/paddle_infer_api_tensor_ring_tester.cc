@@ -0,0 +1,112 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/inference/api/paddle_infer_contrib.h"
+
+namespace paddle_infer {
+namespace contrib {
+
+TEST(SharedMemoryTensorRing, WriteAndRead) {
+  auto producer = SharedMemoryTensorRing::Create(2, 1024);
+  auto consumer = SharedMemoryTensorRing::Open(producer.name(), 2, 1024);
+  EXPECT_EQ(consumer.AcquireReadSlot(), -1);
+
+  for (int i = 0; i < 2; ++i) {
+    int slot = producer.AcquireWriteSlot();
+    ASSERT_GE(slot, 0);
+    auto* data = static_cast<float*>(producer.SlotData(slot));
+    for (int j = 0; j < 6; ++j) {
+      data[j] = i * 10 + j;
+    }
+    producer.CommitWriteSlot(slot, {2, 3}, DataType::FLOAT32);
+  }
+  // All the slots are in use.
+  EXPECT_EQ(producer.AcquireWriteSlot(), -1);
+
+  for (int i = 0; i < 2; ++i) {
+    int slot = consumer.AcquireReadSlot();
+    ASSERT_GE(slot, 0);
+    EXPECT_EQ(consumer.SlotShape(slot), std::vector<int>({2, 3}));
+    EXPECT_EQ(consumer.SlotType(slot), DataType::FLOAT32);
+    // Slots are read in the order they are committed.
+    auto* data = static_cast<const float*>(consumer.SlotData(slot));
+    EXPECT_EQ(data[5], i * 10 + 5);
+    consumer.ReleaseReadSlot(slot);
+  }
+  EXPECT_GE(producer.AcquireWriteSlot(), 0);
+}
+
+TEST(SharedMemoryTensorRing, InvalidUse) {
+  auto ring = SharedMemoryTensorRing::Create(1, 16);
+  EXPECT_ANY_THROW(ring.CommitWriteSlot(0, {4}, DataType::FLOAT32));
+  int slot = ring.AcquireWriteSlot();
+  EXPECT_ANY_THROW(ring.CommitWriteSlot(slot, {5}, DataType::FLOAT32));
+  EXPECT_ANY_THROW(ring.ReleaseReadSlot(slot));
+  EXPECT_ANY_THROW(ring.SlotData(1));
+  EXPECT_ANY_THROW(SharedMemoryTensorRing::Open(ring.name(), 2, 16));
+}
+
+TEST(SharedMemoryTensorRing, CrossProcess) {
+  auto requests = SharedMemoryTensorRing::Create(1, 64);
+  auto responses = SharedMemoryTensorRing::Create(1, 64);
+  pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    // The worker doubles the request.
+    auto in = SharedMemoryTensorRing::Open(requests.name(), 1, 64);
+    auto out = SharedMemoryTensorRing::Open(responses.name(), 1, 64);
+    int in_slot = -1, out_slot = -1;
+    while ((in_slot = in.AcquireReadSlot()) < 0) {
+      usleep(1000);
+    }
+    while ((out_slot = out.AcquireWriteSlot()) < 0) {
+      usleep(1000);
+    }
+    auto* x = static_cast<const int64_t*>(in.SlotData(in_slot));
+    auto* y = static_cast<int64_t*>(out.SlotData(out_slot));
+    for (int i = 0; i < 4; ++i) {
+      y[i] = x[i] * 2;
+    }
+    out.CommitWriteSlot(out_slot, in.SlotShape(in_slot), DataType::INT64);
+    in.ReleaseReadSlot(in_slot);
+    _exit(0);
+  }
+
+  int slot = requests.AcquireWriteSlot();
+  auto* x = static_cast<int64_t*>(requests.SlotData(slot));
+  for (int i = 0; i < 4; ++i) {
+    x[i] = i;
+  }
+  requests.CommitWriteSlot(slot, {4}, DataType::INT64);
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+  slot = responses.AcquireReadSlot();
+  ASSERT_GE(slot, 0);
+  EXPECT_EQ(responses.SlotShape(slot), std::vector<int>({4}));
+  auto* y = static_cast<const int64_t*>(responses.SlotData(slot));
+  EXPECT_EQ(y[3], 6);
+  responses.ReleaseReadSlot(slot);
+}
+
+}  // namespace contrib
+}  // namespace paddle_infer
@@ -12,10 +12,14 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <future>
+
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
 #include "paddle/common/flags.h"
+#include "paddle/fluid/inference/api/paddle_infer_contrib.h"
+#include "paddle/fluid/inference/api/shared_parameter_store.h"
 #include "test/cpp/inference/api/tester_helper.h"
 
 namespace paddle_infer {
@@ -93,4 +97,211 @@ TEST(PredictorPool, basic) {
   }
 }
 
+TEST(DynamicBatcher, basic) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.EnableUseGpu(100, 0);
+
+  services::PredictorPool pred_pool(config, 2);
+  std::string input_name = pred_pool.Retrieve(0)->GetInputNames()[0];
+  contrib::DynamicBatcher::Options options;
+  options.max_batch_size = 4;
+  options.max_delay_us = 10000;
+  contrib::DynamicBatcher batcher(&pred_pool, 2, options);
+
+  std::vector<int> in_shape = {1, 3, 318, 318};
+  std::vector<std::future<std::vector<paddle::PaddleTensor>>> futures;
+  for (int i = 0; i < 6; ++i) {
+    paddle::PaddleTensor input;
+    input.name = input_name;
+    input.shape = in_shape;
+    input.dtype = DataType::FLOAT32;
+    input.data.Resize(3 * 318 * 318 * sizeof(float));
+    std::fill_n(static_cast<float *>(input.data.data()), 3 * 318 * 318, 0.f);
+    futures.push_back(batcher.Submit({std::move(input)}));
+  }
+  for (auto &future : futures) {
+    auto outputs = future.get();
+    ASSERT_FALSE(outputs.empty());
+    EXPECT_EQ(outputs[0].shape[0], 1);
+  }
+
+  auto stats = batcher.GetStats();
+  EXPECT_EQ(stats.num_requests, 6);
+  EXPECT_LT(stats.num_batches, 6);
+  EXPECT_EQ(stats.batch_size_histogram.size(), 5UL);
+}
+
+TEST(Predictor, shared_parameters) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.EnableUseGpu(100, 0);
+  config.EnableSharedParameters();
+  ASSERT_TRUE(config.shared_parameters_enabled());
+
+  auto &store = paddle::SharedParameterStore::Instance();
+  auto pred = CreatePredictor(config);
+  const size_t shared_bytes = store.SharedBytes();
+  // The second predictor of the same model takes all the parameters of the
+  // first one.
+  auto pred2 = CreatePredictor(config);
+  EXPECT_GT(store.SharedBytes(), shared_bytes);
+}
+
+TEST(Predictor, run_async) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.EnableUseGpu(100, 0);
+  auto predictor = CreatePredictor(config);
+
+  std::vector<int> in_shape = {1, 3, 318, 318};
+  std::vector<float> input(1 * 3 * 318 * 318, 1.f);
+  auto input_t = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  auto output_t = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  auto read_output = [&output_t]() {
+    std::vector<int> output_shape = output_t->shape();
+    std::vector<float> out_data(std::accumulate(output_shape.begin(),
+                                                output_shape.end(),
+                                                1,
+                                                std::multiplies<int>()));
+    output_t->CopyToCpu(out_data.data());
+    return out_data;
+  };
+
+  input_t->Reshape(in_shape);
+  input_t->CopyFromCpu(input.data());
+  ASSERT_TRUE(predictor->Run());
+  std::vector<float> expected = read_output();
+
+  std::promise<std::vector<float>> result;
+  input_t->CopyFromCpu(input.data());
+  ASSERT_TRUE(predictor->RunAsync([&](bool success) {
+    EXPECT_TRUE(success);
+    result.set_value(read_output());
+  }));
+  std::vector<float> out_data = result.get_future().get();
+  ASSERT_EQ(out_data.size(), expected.size());
+  for (size_t i = 0; i < out_data.size(); ++i) {
+    EXPECT_NEAR(out_data[i], expected[i], 1e-5);
+  }
+}
+
+TEST(Predictor, run_in_async_callback) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.EnableUseGpu(100, 0);
+  auto predictor = CreatePredictor(config);
+
+  std::vector<int> in_shape = {1, 3, 318, 318};
+  std::vector<float> input(1 * 3 * 318 * 318, 1.f);
+  auto input_t = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  input_t->Reshape(in_shape);
+  input_t->CopyFromCpu(input.data());
+
+  // A run in the callback would wait for the callback itself.
+  std::promise<bool> thrown;
+  ASSERT_TRUE(predictor->RunAsync([&](bool success) {
+    EXPECT_TRUE(success);
+    try {
+      predictor->Run();
+      thrown.set_value(false);
+    } catch (const std::exception &) {
+      thrown.set_value(true);
+    }
+  }));
+  EXPECT_TRUE(thrown.get_future().get());
+  // The predictor runs again once the callback returns.
+  ASSERT_TRUE(predictor->Run());
+}
+
+TEST(Predictor, output_buffer) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.EnableUseGpu(100, 0);
+  auto predictor = CreatePredictor(config);
+
+  std::vector<int> in_shape = {1, 3, 318, 318};
+  std::vector<float> input(1 * 3 * 318 * 318, 1.f);
+  auto input_t = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  auto output_t = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  input_t->Reshape(in_shape);
+  input_t->CopyFromCpu(input.data());
+  ASSERT_TRUE(predictor->Run());
+  std::vector<int> output_shape = output_t->shape();
+  std::vector<float> expected(std::accumulate(
+      output_shape.begin(), output_shape.end(), 1, std::multiplies<int>()));
+  output_t->CopyToCpu(expected.data());
+
+  // The next runs write the output into the pinned host buffer.
+  auto *buffer = static_cast<float *>(
+      contrib::TensorUtils::CudaMallocPinnedMemory(expected.size() *
+                                                   sizeof(float)));
+  output_t->ShareExternalData(buffer, output_shape, PlaceType::kCPU);
+  for (int i = 0; i < 2; ++i) {
+    std::fill_n(buffer, expected.size(), 0.f);
+    input_t->CopyFromCpu(input.data());
+    ASSERT_TRUE(predictor->Run());
+    PlaceType place;
+    int size = 0;
+    EXPECT_EQ(output_t->data<float>(&place, &size), buffer);
+    for (size_t j = 0; j < expected.size(); ++j) {
+      EXPECT_NEAR(buffer[j], expected[j], 1e-5);
+    }
+  }
+  contrib::TensorUtils::CudaFreePinnedMemory(buffer);
+}
+
+TEST(Predictor, run_trace) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.EnableUseGpu(100, 0);
+  config.EnableRunTrace();
+  auto predictor = CreatePredictor(config);
+  EXPECT_TRUE(predictor->GetLastRunTrace().empty());
+
+  std::vector<int> in_shape = {1, 3, 318, 318};
+  std::vector<float> input(1 * 3 * 318 * 318, 1.f);
+  auto input_t = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  input_t->Reshape(in_shape);
+  input_t->CopyFromCpu(input.data());
+  const std::string trace_id(32, 'a');
+  const std::string parent_span_id(16, 'b');
+  predictor->SetTraceParent(trace_id, parent_span_id);
+  ASSERT_TRUE(predictor->Run());
+
+  auto spans = predictor->GetLastRunTrace();
+  ASSERT_GT(spans.size(), 3UL);
+  EXPECT_EQ(spans[0].name, "paddle_inference.run");
+  EXPECT_EQ(spans[0].trace_id, trace_id);
+  EXPECT_EQ(spans[0].parent_span_id, parent_span_id);
+  EXPECT_EQ(spans[1].name, "paddle_inference.execute");
+  EXPECT_EQ(spans[1].parent_span_id, spans[0].span_id);
+  int num_ops = 0;
+  for (const auto &span : spans) {
+    EXPECT_EQ(span.trace_id, trace_id);
+    EXPECT_LE(span.start_time_unix_nano, span.end_time_unix_nano);
+    EXPECT_GE(span.start_time_unix_nano, spans[0].start_time_unix_nano);
+    if (span.attributes.count("paddle.op.kind")) {
+      EXPECT_EQ(span.parent_span_id, spans[1].span_id);
+      ++num_ops;
+    }
+  }
+  EXPECT_GT(num_ops, 0);
+  std::string json = TraceSpansToOtlpJson(spans);
+  EXPECT_NE(json.find("\"traceId\":\"" + trace_id + "\""), std::string::npos);
+
+  // The parent is the one of a single run.
+  input_t->CopyFromCpu(input.data());
+  ASSERT_TRUE(predictor->Run());
+  spans = predictor->GetLastRunTrace();
+  EXPECT_NE(spans[0].trace_id, trace_id);
+  EXPECT_TRUE(spans[0].parent_span_id.empty());
+}
+
 }  // namespace paddle_infer
@@ -30,6 +30,7 @@
 #include "paddle/fluid/jit/function.h"
 #include "paddle/fluid/jit/function_utils.h"
 #include "paddle/fluid/jit/layer.h"
+#include "paddle/fluid/jit/param_store.h"
 #include "paddle/fluid/jit/serializer.h"
 
 USE_OP_ITSELF(elementwise_add);
@@ -167,6 +168,30 @@ TEST(CpuLayerTest, Clone) {
   EXPECT_NEAR(out_data[0], pow(1.41562390, 2.0), 1e-6);
 }
 
+TEST(CpuLayerTest, ShareParams) {
+  auto place = phi::CPUPlace();
+  auto make_param = [&](float value) {
+    DenseTensor t;
+    t.Resize(common::make_ddim({2, 4}));
+    float* data = t.mutable_data<float>(place);
+    for (int i = 0; i < 8; ++i) {
+      data[i] = value;
+    }
+    return t;
+  };
+  auto& store = ParamStore::Instance();
+  size_t size = store.Size();
+  {
+    auto a = store.Share(make_param(1.f), place);
+    auto b = store.Share(make_param(1.f), place);
+    auto c = store.Share(make_param(2.f), place);
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_NE(a.get(), c.get());
+    EXPECT_EQ(store.Size(), size + 2);
+  }
+  EXPECT_EQ(store.Size(), size);
+}
+
 #if defined(PADDLE_WITH_CUDA)
 TEST(GpuLayerTest, Construct) {
   if (FLAGS_enable_pir_api) {
@@ -0,0 +1,89 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "paddle/fluid/framework/new_executor/instruction/infer_meta_cache.h"
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace paddle {
+namespace framework {
+
+static void SetMeta(phi::DenseTensor* tensor, const phi::DDim& dims) {
+  phi::MetaTensor meta(tensor);
+  meta.set_dims(dims);
+  meta.set_dtype(phi::DataType::FLOAT32);
+  meta.set_layout(phi::DataLayout::NCHW);
+}
+
+TEST(InferMetaCache, lookup_and_insert) {
+  phi::DenseTensor x, out;
+  SetMeta(&x, common::make_ddim({2, 3}));
+  phi::InferMetaContext ctx;
+  ctx.EmplaceBackInput(phi::MetaTensor(&x));
+  ctx.EmplaceBackOutput(phi::MetaTensor(&out));
+  ctx.EmplaceBackAttr(phi::Attribute(1.0f));
+  ASSERT_TRUE(InferMetaCache::IsCacheable(ctx));
+
+  InferMetaCache cache(/*capacity*/ 1);
+  EXPECT_FALSE(cache.Lookup(&ctx));
+  // What InferMeta would set.
+  SetMeta(&out, common::make_ddim({3, 2}));
+  cache.Insert(&ctx);
+
+  SetMeta(&out, common::make_ddim({1}));
+  EXPECT_TRUE(cache.Lookup(&ctx));
+  EXPECT_EQ(out.dims(), common::make_ddim({3, 2}));
+  EXPECT_EQ(out.dtype(), phi::DataType::FLOAT32);
+
+  // Another shape misses and evicts the first one.
+  SetMeta(&x, common::make_ddim({4, 3}));
+  EXPECT_FALSE(cache.Lookup(&ctx));
+  SetMeta(&out, common::make_ddim({3, 4}));
+  cache.Insert(&ctx);
+  SetMeta(&x, common::make_ddim({2, 3}));
+  EXPECT_FALSE(cache.Lookup(&ctx));
+
+  EXPECT_EQ(cache.Stats().hits, 1u);
+  EXPECT_EQ(cache.Stats().misses, 3u);
+  EXPECT_GE(InferMetaCache::GlobalStats().hits, 1u);
+}
+
+TEST(InferMetaCache, input_with_lod_bypasses) {
+  phi::DenseTensor x, out;
+  SetMeta(&x, common::make_ddim({4, 3}));
+  x.set_lod(phi::LoD({{0, 1, 4}}));
+  phi::InferMetaContext ctx;
+  ctx.EmplaceBackInput(phi::MetaTensor(&x));
+  ctx.EmplaceBackOutput(phi::MetaTensor(&out));
+
+  InferMetaCache cache(/*capacity*/ 1);
+  EXPECT_FALSE(cache.Lookup(&ctx));
+  SetMeta(&out, common::make_ddim({4, 3}));
+  cache.Insert(&ctx);
+  EXPECT_FALSE(cache.Lookup(&ctx));
+  EXPECT_EQ(cache.Stats().hits, 0u);
+  EXPECT_EQ(cache.Stats().misses, 0u);
+}
+
+TEST(InferMetaCache, tensor_attribute_is_not_cacheable) {
+  phi::DenseTensor x, shape, out;
+  phi::InferMetaContext ctx;
+  ctx.EmplaceBackInput(phi::MetaTensor(&x));
+  ctx.EmplaceBackOutput(phi::MetaTensor(&out));
+  ctx.EmplaceBackAttr(phi::Attribute(phi::TensorRef(&shape)));
+  EXPECT_FALSE(InferMetaCache::IsCacheable(ctx));
+}
+
+}  // namespace framework
+}  // namespace paddle
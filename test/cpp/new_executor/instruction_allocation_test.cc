@@ -0,0 +1,103 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/framework/new_executor/instruction/phi_kernel_instruction.h"
+#include "paddle/fluid/framework/new_executor/pir_adaptor/pir_adaptor_util.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/transforms/pd_op_to_kernel_pass.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/pir/include/core/builder.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+
+PD_DECLARE_KERNEL(full, CPU, ALL_LAYOUT);
+PD_DECLARE_KERNEL(add, CPU, ALL_LAYOUT);
+
+// Counts the heap allocations of this thread while counting is on.
+static thread_local bool counting = false;
+static thread_local size_t num_allocations = 0;
+
+void* operator new(std::size_t size) {
+  if (counting) {
+    ++num_allocations;
+  }
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace paddle {
+namespace framework {
+
+TEST(PhiKernelInstruction, run_without_allocation) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+  auto x = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{4, 4}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  auto y = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{4, 4}, 2.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  builder.Build<paddle::dialect::AddOp>(x->result(0), y->result(0));
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  phi::CPUPlace place;
+  Scope scope;
+  ValueExecutionInfo value_exe_info(&scope);
+  BuildScope(*kernel_program->block(),
+             "instruction_allocation_test",
+             ExecutionConfig(),
+             &value_exe_info);
+
+  std::vector<std::unique_ptr<PhiKernelInstruction>> instructions;
+  for (auto& op : *kernel_program->block()) {
+    instructions.push_back(std::make_unique<PhiKernelInstruction>(
+        instructions.size(), place, &op, &value_exe_info));
+  }
+  ASSERT_EQ(instructions.size(), 3u);
+  for (auto& instruction : instructions) {
+    instruction->Run();
+  }
+
+  // The contexts are built once, and the output is allocated by the first
+  // run, so running the add again allocates nothing.
+  auto& add = instructions.back();
+  counting = true;
+  for (int i = 0; i < 10; ++i) {
+    add->Run();
+  }
+  counting = false;
+  EXPECT_EQ(num_allocations, 0u);
+
+  auto* out = static_cast<phi::DenseTensor*>(
+      add->MutableKernelContext()->MutableOutputAt(0));
+  EXPECT_FLOAT_EQ(out->data<float>()[0], 3.0f);
+}
+
+}  // namespace framework
+}  // namespace paddle
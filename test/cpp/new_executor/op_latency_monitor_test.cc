@@ -0,0 +1,73 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/op_latency_monitor.h"
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace framework {
+
+TEST(LatencyHistogram, bucket) {
+  for (uint64_t ns : {0, 1, 3, 4, 7, 8, 100, 1000, 123456, 1000000007}) {
+    size_t index = LatencyHistogram::BucketIndex(ns);
+    EXPECT_LE(LatencyHistogram::BucketLowerBound(index), ns);
+    EXPECT_GT(LatencyHistogram::BucketLowerBound(index + 1), ns);
+  }
+  EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX),
+            LatencyHistogram::kBucketNum - 1);
+}
+
+TEST(LatencyHistogram, percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.Percentile(0.5), 0);
+
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 1000);
+  }
+  EXPECT_EQ(histogram.Count(), 1000u);
+  EXPECT_NEAR(histogram.Percentile(0.5), 500000, 500000 * 0.13);
+  EXPECT_NEAR(histogram.Percentile(0.99), 990000, 990000 * 0.13);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0u);
+}
+
+TEST(OpLatencyMonitor, slow_ops) {
+  auto& monitor = OpLatencyMonitor::Instance();
+  monitor.Reset();
+  OpLatencyHistograms* fast = monitor.GetHistograms("test.fast");
+  OpLatencyHistograms* slow = monitor.GetHistograms("test.slow");
+  EXPECT_EQ(monitor.GetHistograms("test.fast"), fast);
+  for (int i = 0; i < 10; ++i) {
+    fast->host.Record(1000);
+    slow->host.Record(100000);
+  }
+  slow->device.Record(50000);
+
+  auto host_ops = monitor.GetSlowOps(/*top_n*/ 1, /*by_device*/ false);
+  ASSERT_EQ(host_ops.size(), 1u);
+  EXPECT_EQ(host_ops[0].op_name, "test.slow");
+  EXPECT_EQ(host_ops[0].host_count, 10u);
+  EXPECT_NEAR(host_ops[0].host_p99_us, 100, 100 * 0.13);
+
+  auto device_ops = monitor.GetSlowOps(/*top_n*/ 10, /*by_device*/ true);
+  ASSERT_EQ(device_ops.size(), 1u);
+  EXPECT_EQ(device_ops[0].device_count, 1u);
+  monitor.Reset();
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -17,12 +17,19 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
 
 #include "paddle/phi/core/kernel_registry.h"
 
+#include "paddle/fluid/framework/new_executor/instruction/infer_meta_cache.h"
+#include "paddle/fluid/framework/new_executor/op_latency_monitor.h"
 #include "paddle/fluid/framework/new_executor/pir_interpreter.h"
+#include "paddle/fluid/framework/tensor_util.h"
+#include "paddle/phi/core/memory/allocation/memory_pressure.h"
 #include "paddle/fluid/pir/dialect/operator/ir/control_flow_op.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
 #include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
@@ -39,12 +46,29 @@
 
 DECLARE_FILE_SYMBOLS(kernel_dialect);
 
+COMMON_DECLARE_bool(enable_pir_in_executor_trace_run);
+COMMON_DECLARE_bool(pir_interpreter_compiled_trace);
+COMMON_DECLARE_bool(pir_interpreter_auto_cuda_graph);
+COMMON_DECLARE_int32(pir_interpreter_auto_cuda_graph_min_ops);
+COMMON_DECLARE_bool(pir_interpreter_fuse_elementwise_chain);
+COMMON_DECLARE_string(pir_interpreter_scheduling_policy);
+COMMON_DECLARE_string(pir_interpreter_build_cache_dir);
+COMMON_DECLARE_double(new_executor_async_gc_batch_mb);
+COMMON_DECLARE_int32(pir_interpreter_op_latency_sample_interval);
+COMMON_DECLARE_int32(pir_interpreter_infer_meta_cache_size);
+
 PD_DECLARE_KERNEL(full, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(full_int_array, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(uniform, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(add, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(sqrt, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(less_than, CPU, ALL_LAYOUT);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+PD_DECLARE_KERNEL(full, GPU, ALL_LAYOUT);
+PD_DECLARE_KERNEL(add, KPS, ALL_LAYOUT);
+PD_DECLARE_KERNEL(multiply, KPS, ALL_LAYOUT);
+PD_DECLARE_KERNEL(sqrt, GPU, ALL_LAYOUT);
+#endif
 
 bool simple_cmp(float a, float b) { return std::abs((a - b) / a) < 1e-5; }
 
@@ -260,6 +284,458 @@ TEST(StandaloneExecutor, run_inplace_sqrt) {
   EXPECT_EQ(res3, true);
 }
 
+TEST(StandaloneExecutor, run_compiled_trace) {
+  FLAGS_enable_pir_in_executor_trace_run = true;
+  FLAGS_pir_interpreter_compiled_trace = true;
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  paddle::dialect::FullOp op1 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  paddle::dialect::FullOp op2 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 3.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  auto add_op =
+      builder.Build<paddle::dialect::AddOp>(op1->result(0), op2->result(0));
+  auto sqrt_op = builder.Build<paddle::dialect::SqrtOp>(add_op->result(0));
+  // The inplace op runs through the normal instruction path.
+  builder.Build<paddle::dialect::Sqrt_Op>(sqrt_op->result(0));
+
+  std::string out_name = "sqrt_out";
+  builder.Build<pir::ShadowOutputOp>(sqrt_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+
+  test_core.SetSkipGcVars({out_name});
+
+  // The first run builds the compiled trace, the second one replays it.
+  for (int i = 0; i < 2; ++i) {
+    test_core.Run({});
+
+    auto out_tensor = test_core.local_scope() == nullptr
+                          ? scope.FindVar(out_name)->Get<phi::DenseTensor>()
+                          : test_core.local_scope()
+                                ->FindVar(out_name)
+                                ->Get<phi::DenseTensor>();
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_TRUE(simple_cmp(out_tensor.data<float>()[j], std::sqrt(2.0)));
+    }
+  }
+
+  FLAGS_enable_pir_in_executor_trace_run = false;
+  FLAGS_pir_interpreter_compiled_trace = false;
+}
+
+TEST(StandaloneExecutor, run_compiled_trace_with_infer_meta_cache) {
+  FLAGS_enable_pir_in_executor_trace_run = true;
+  FLAGS_pir_interpreter_compiled_trace = true;
+  FLAGS_pir_interpreter_infer_meta_cache_size = 4;
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  paddle::dialect::FullOp op1 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  paddle::dialect::FullOp op2 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 3.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  auto add_op =
+      builder.Build<paddle::dialect::AddOp>(op1->result(0), op2->result(0));
+  auto sqrt_op = builder.Build<paddle::dialect::SqrtOp>(add_op->result(0));
+
+  std::string out_name = "sqrt_out";
+  builder.Build<pir::ShadowOutputOp>(sqrt_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+
+  test_core.SetSkipGcVars({out_name});
+
+  // The replays of the compiled trace hit the InferMeta cache of the
+  // instructions like the normal path does.
+  uint64_t hits = 0;
+  for (int i = 0; i < 3; ++i) {
+    if (i == 1) {
+      hits = InferMetaCache::GlobalStats().hits;
+    }
+    test_core.Run({});
+
+    auto out_tensor = test_core.local_scope() == nullptr
+                          ? scope.FindVar(out_name)->Get<phi::DenseTensor>()
+                          : test_core.local_scope()
+                                ->FindVar(out_name)
+                                ->Get<phi::DenseTensor>();
+    EXPECT_EQ(out_tensor.dims(), common::make_ddim({2, 2}));
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_TRUE(simple_cmp(out_tensor.data<float>()[j], 2.0));
+    }
+  }
+  EXPECT_GT(InferMetaCache::GlobalStats().hits, hits);
+
+  FLAGS_enable_pir_in_executor_trace_run = false;
+  FLAGS_pir_interpreter_compiled_trace = false;
+  FLAGS_pir_interpreter_infer_meta_cache_size = 0;
+}
+
+TEST(StandaloneExecutor, run_async_gc) {
+  FLAGS_new_executor_async_gc_batch_mb = 64;
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  paddle::dialect::FullOp op1 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  paddle::dialect::FullOp op2 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 3.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  auto add_op =
+      builder.Build<paddle::dialect::AddOp>(op1->result(0), op2->result(0));
+  auto sqrt_op = builder.Build<paddle::dialect::SqrtOp>(add_op->result(0));
+
+  std::string out_name = "sqrt_out";
+  builder.Build<pir::ShadowOutputOp>(sqrt_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+
+  test_core.SetSkipGcVars({out_name});
+
+  for (int i = 0; i < 2; ++i) {
+    test_core.Run({});
+    // The garbages are far below the batch size, the memory pressure frees
+    // them synchronously.
+    memory::allocation::MemoryPressureNotifier::Instance().Notify();
+
+    auto out_tensor = test_core.local_scope() == nullptr
+                          ? scope.FindVar(out_name)->Get<phi::DenseTensor>()
+                          : test_core.local_scope()
+                                ->FindVar(out_name)
+                                ->Get<phi::DenseTensor>();
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_TRUE(simple_cmp(out_tensor.data<float>()[j], 2.0));
+    }
+  }
+
+  FLAGS_new_executor_async_gc_batch_mb = 0;
+}
+
+TEST(StandaloneExecutor, run_op_latency_monitor) {
+  FLAGS_pir_interpreter_op_latency_sample_interval = 1;
+  OpLatencyMonitor::Instance().Reset();
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  paddle::dialect::FullOp op1 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  paddle::dialect::FullOp op2 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  auto add_op =
+      builder.Build<paddle::dialect::AddOp>(op1->result(0), op2->result(0));
+
+  std::string out_name = "add_out";
+  builder.Build<pir::ShadowOutputOp>(add_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+  test_core.SetSkipGcVars({out_name});
+
+  for (int i = 0; i < 3; ++i) {
+    test_core.Run({});
+  }
+
+  bool found_add = false;
+  for (auto& summary : OpLatencyMonitor::Instance().GetSlowOps(
+           /*top_n*/ 10, /*by_device*/ false)) {
+    if (summary.op_name.find("add") != std::string::npos) {
+      found_add = true;
+      EXPECT_EQ(summary.host_count, 3u);
+      EXPECT_GT(summary.host_p99_us, 0);
+    }
+  }
+  EXPECT_TRUE(found_add);
+
+  OpLatencyMonitor::Instance().Reset();
+  FLAGS_pir_interpreter_op_latency_sample_interval = 0;
+}
+
+TEST(StandaloneExecutor, run_compiled_trace_with_op_latency_monitor) {
+  FLAGS_enable_pir_in_executor_trace_run = true;
+  FLAGS_pir_interpreter_compiled_trace = true;
+  FLAGS_pir_interpreter_op_latency_sample_interval = 1;
+  OpLatencyMonitor::Instance().Reset();
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  paddle::dialect::FullOp op1 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  paddle::dialect::FullOp op2 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  auto add_op =
+      builder.Build<paddle::dialect::AddOp>(op1->result(0), op2->result(0));
+
+  std::string out_name = "add_out";
+  builder.Build<pir::ShadowOutputOp>(add_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+  test_core.SetSkipGcVars({out_name});
+
+  // The first run builds the compiled trace, the others replay it and must
+  // still feed the monitor.
+  for (int i = 0; i < 3; ++i) {
+    test_core.Run({});
+  }
+
+  bool found_add = false;
+  for (auto& summary : OpLatencyMonitor::Instance().GetSlowOps(
+           /*top_n*/ 10, /*by_device*/ false)) {
+    if (summary.op_name.find("add") != std::string::npos) {
+      found_add = true;
+      EXPECT_EQ(summary.host_count, 3u);
+    }
+  }
+  EXPECT_TRUE(found_add);
+
+  OpLatencyMonitor::Instance().Reset();
+  FLAGS_pir_interpreter_op_latency_sample_interval = 0;
+  FLAGS_enable_pir_in_executor_trace_run = false;
+  FLAGS_pir_interpreter_compiled_trace = false;
+}
+
+TEST(StandaloneExecutor, run_critical_path_scheduling) {
+  FLAGS_pir_interpreter_scheduling_policy = "critical_path";
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  // A long branch and a short branch joined by the last add.
+  paddle::dialect::FullOp op1 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  paddle::dialect::FullOp op2 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 4.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  pir::Value long_branch = op1->result(0);
+  for (int i = 0; i < 3; ++i) {
+    long_branch =
+        builder.Build<paddle::dialect::AddOp>(long_branch, op1->result(0))
+            ->result(0);
+  }
+  auto short_branch = builder.Build<paddle::dialect::SqrtOp>(op2->result(0));
+  auto add_op = builder.Build<paddle::dialect::AddOp>(long_branch,
+                                                      short_branch->result(0));
+
+  std::string out_name = "add_out";
+  builder.Build<pir::ShadowOutputOp>(add_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+
+  test_core.SetSkipGcVars({out_name});
+
+  test_core.Run({});
+
+  auto out_tensor =
+      test_core.local_scope() == nullptr
+          ? scope.FindVar(out_name)->Get<phi::DenseTensor>()
+          : test_core.local_scope()->FindVar(out_name)->Get<phi::DenseTensor>();
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(simple_cmp(out_tensor.data<float>()[i], 6.0));
+  }
+
+  FLAGS_pir_interpreter_scheduling_policy = "fifo";
+}
+
+TEST(StandaloneExecutor, run_with_build_cache) {
+  namespace fs = std::filesystem;
+  fs::path cache_dir = fs::temp_directory_path() / "pir_build_cache_test";
+  fs::remove_all(cache_dir);
+  fs::create_directories(cache_dir);
+  FLAGS_pir_interpreter_build_cache_dir = cache_dir.string();
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  paddle::dialect::FullOp op1 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  paddle::dialect::FullOp op2 = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 4.0, phi::DataType::FLOAT32, phi::CPUPlace());
+  auto sqrt_op = builder.Build<paddle::dialect::SqrtOp>(op2->result(0));
+  auto add_op =
+      builder.Build<paddle::dialect::AddOp>(op1->result(0), sqrt_op->result(0));
+
+  std::string out_name = "add_out";
+  builder.Build<pir::ShadowOutputOp>(add_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto run = [&]() {
+    Scope scope;
+    InterpreterCore test_core(
+        phi::CPUPlace(), {}, kernel_program->block(), &scope);
+    test_core.SetSkipGcVars({out_name});
+    test_core.Run({});
+    auto out_tensor = test_core.local_scope() == nullptr
+                          ? scope.FindVar(out_name)->Get<phi::DenseTensor>()
+                          : test_core.local_scope()
+                                ->FindVar(out_name)
+                                ->Get<phi::DenseTensor>();
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_TRUE(simple_cmp(out_tensor.data<float>()[i], 3.0));
+    }
+  };
+
+  // The first run saves the build result, the second one loads it.
+  run();
+  std::vector<fs::path> cache_files;
+  for (auto& entry : fs::directory_iterator(cache_dir)) {
+    cache_files.push_back(entry.path());
+  }
+  ASSERT_EQ(cache_files.size(), 1UL);
+  auto cache_size = fs::file_size(cache_files[0]);
+  run();
+  EXPECT_EQ(fs::file_size(cache_files[0]), cache_size);
+
+  // A corrupted result is ignored and saved again.
+  fs::resize_file(cache_files[0], cache_size / 2);
+  run();
+  EXPECT_EQ(fs::file_size(cache_files[0]), cache_size);
+
+  FLAGS_pir_interpreter_build_cache_dir = "";
+  fs::remove_all(cache_dir);
+}
+
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+TEST(StandaloneExecutor, run_auto_cuda_graph) {
+  FLAGS_enable_pir_in_executor_trace_run = true;
+  FLAGS_pir_interpreter_auto_cuda_graph = true;
+  FLAGS_pir_interpreter_auto_cuda_graph_min_ops = 2;
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  auto place = phi::GPUPlace(0);
+  paddle::dialect::FullOp full = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 1.0, phi::DataType::FLOAT32, place);
+  pir::Value out = full->result(0);
+  for (int i = 0; i < 4; ++i) {
+    out = builder.Build<paddle::dialect::AddOp>(out, full->result(0))
+              ->result(0);
+  }
+
+  std::string out_name = "add_out";
+  builder.Build<pir::ShadowOutputOp>(out, out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+
+  test_core.SetSkipGcVars({out_name});
+
+  // The first two runs warm up and capture the graph, the last one replays.
+  for (int i = 0; i < 3; ++i) {
+    test_core.Run({});
+
+    auto* out_var = test_core.local_scope() == nullptr
+                        ? scope.FindVar(out_name)
+                        : test_core.local_scope()->FindVar(out_name);
+    phi::DenseTensor out_tensor;
+    framework::TensorCopySync(
+        out_var->Get<phi::DenseTensor>(), phi::CPUPlace(), &out_tensor);
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_TRUE(simple_cmp(out_tensor.data<float>()[j], 5.0));
+    }
+  }
+
+  FLAGS_enable_pir_in_executor_trace_run = false;
+  FLAGS_pir_interpreter_auto_cuda_graph = false;
+  FLAGS_pir_interpreter_auto_cuda_graph_min_ops = 8;
+}
+
+TEST(StandaloneExecutor, run_elementwise_chain) {
+  FLAGS_enable_pir_in_executor_trace_run = true;
+  FLAGS_pir_interpreter_fuse_elementwise_chain = true;
+
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program((ctx));
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  auto place = phi::GPUPlace(0);
+  paddle::dialect::FullOp x = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 4.0, phi::DataType::FLOAT32, place);
+  paddle::dialect::FullOp y = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{2, 2}, 5.0, phi::DataType::FLOAT32, place);
+  // sqrt(x + y) * x, the sum and the root only live in the chain.
+  auto add_op =
+      builder.Build<paddle::dialect::AddOp>(x->result(0), y->result(0));
+  auto sqrt_op = builder.Build<paddle::dialect::SqrtOp>(add_op->result(0));
+  auto multiply_op = builder.Build<paddle::dialect::MultiplyOp>(
+      sqrt_op->result(0), x->result(0));
+
+  std::string out_name = "multiply_out";
+  builder.Build<pir::ShadowOutputOp>(multiply_op->result(0), out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  Scope scope;
+  InterpreterCore test_core(place, {}, kernel_program->block(), &scope);
+
+  test_core.SetSkipGcVars({out_name});
+
+  for (int i = 0; i < 2; ++i) {
+    test_core.Run({});
+
+    auto* out_var = test_core.local_scope() == nullptr
+                        ? scope.FindVar(out_name)
+                        : test_core.local_scope()->FindVar(out_name);
+    phi::DenseTensor out_tensor;
+    framework::TensorCopySync(
+        out_var->Get<phi::DenseTensor>(), phi::CPUPlace(), &out_tensor);
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_TRUE(simple_cmp(out_tensor.data<float>()[j], 12.0));
+    }
+  }
+
+  FLAGS_enable_pir_in_executor_trace_run = false;
+  FLAGS_pir_interpreter_fuse_elementwise_chain = false;
+}
+#endif
+
 TEST(StandaloneExecutor, if_op) {
   pir::IrContext* ctx = pir::IrContext::Instance();
   ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
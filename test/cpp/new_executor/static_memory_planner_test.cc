@@ -0,0 +1,80 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/static_memory_planner.h"
+
+#include <gtest/gtest.h>
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+static bool Overlap(const StaticMemoryPlanner& planner, int a, int b) {
+  size_t a_begin = planner.Offset(a), a_end = a_begin + planner.Size(a);
+  size_t b_begin = planner.Offset(b), b_end = b_begin + planner.Size(b);
+  return a_begin < b_end && b_begin < a_end;
+}
+
+TEST(StaticMemoryPlanner, ReuseDisjointLifetime) {
+  StaticMemoryPlanner planner(256);
+  // a = op0(); b = op1(a); c = op2(b); d = op3(c)
+  planner.AddBuffer(0, 1000, 0, 1);
+  planner.AddBuffer(1, 1000, 1, 2);
+  planner.AddBuffer(2, 1000, 2, 3);
+  planner.AddBuffer(3, 1000, 3, 3);
+
+  EXPECT_EQ(planner.Size(0), 1024UL);
+  EXPECT_EQ(planner.TotalBufferSize(), 4096UL);
+  // A chain only needs two buffers alive at any time.
+  EXPECT_EQ(planner.Plan(), 2048UL);
+  EXPECT_FALSE(Overlap(planner, 0, 1));
+  EXPECT_FALSE(Overlap(planner, 1, 2));
+  EXPECT_FALSE(Overlap(planner, 2, 3));
+}
+
+TEST(StaticMemoryPlanner, FillGap) {
+  StaticMemoryPlanner planner(256);
+  planner.AddBuffer(0, 4096, 0, 4);
+  planner.AddBuffer(1, 2048, 0, 1);
+  planner.AddBuffer(2, 4096, 2, 4);
+  planner.AddBuffer(3, 1024, 2, 3);
+  planner.AddBuffer(4, 1024, 3, 4);
+
+  // Four buffers are alive at position 3.
+  EXPECT_EQ(planner.Plan(), 4096UL + 4096UL + 1024UL + 1024UL);
+  // Buffer 1 dies before buffer 2 is produced.
+  EXPECT_EQ(planner.Offset(1), planner.Offset(2));
+  for (int a = 0; a < 5; ++a) {
+    EXPECT_LE(planner.Offset(a) + planner.Size(a), planner.ArenaSize());
+  }
+  EXPECT_FALSE(Overlap(planner, 0, 1));
+  EXPECT_FALSE(Overlap(planner, 0, 2));
+  EXPECT_FALSE(Overlap(planner, 0, 3));
+  EXPECT_FALSE(Overlap(planner, 0, 4));
+  EXPECT_FALSE(Overlap(planner, 2, 3));
+  EXPECT_FALSE(Overlap(planner, 2, 4));
+  EXPECT_FALSE(Overlap(planner, 3, 4));
+}
+
+TEST(StaticMemoryPlanner, InvalidBuffer) {
+  StaticMemoryPlanner planner(256);
+  planner.AddBuffer(0, 256, 0, 1);
+  EXPECT_ANY_THROW(planner.AddBuffer(0, 256, 0, 1));
+  EXPECT_ANY_THROW(planner.AddBuffer(1, 256, 2, 1));
+  EXPECT_ANY_THROW(planner.Offset(2));
+}
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
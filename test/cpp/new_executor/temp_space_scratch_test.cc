@@ -0,0 +1,55 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "paddle/fluid/framework/new_executor/instruction/temp_space_scratch.h"
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace framework {
+
+TEST(TempSpaceScratch, shared_per_stream_while_held) {
+  int stream_a = 0, stream_b = 0;
+  auto scratch = TempSpaceScratch::Get(phi::CPUPlace(), &stream_a);
+  EXPECT_EQ(TempSpaceScratch::Get(phi::CPUPlace(), &stream_a), scratch);
+  EXPECT_NE(TempSpaceScratch::Get(phi::CPUPlace(), &stream_b), scratch);
+
+  scratch->Reserve(64);
+  std::weak_ptr<TempSpaceScratch> weak = scratch;
+  scratch.reset();
+  // Freed with its last owner, the stream then starts from an empty one.
+  EXPECT_TRUE(weak.expired());
+  scratch = TempSpaceScratch::Get(phi::CPUPlace(), &stream_a);
+  EXPECT_EQ(scratch->capacity(), 0UL);
+}
+
+TEST(TempSpaceScratch, reserve_grows_only) {
+  int stream = 0;
+  auto scratch = TempSpaceScratch::Get(phi::CPUPlace(), &stream);
+  uint8_t* buffer = scratch->Reserve(256);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_GE(scratch->capacity(), 256UL);
+  EXPECT_EQ(scratch->Reserve(128), buffer);
+  EXPECT_EQ(scratch->Reserve(256), buffer);
+
+  scratch->Reserve(4096);
+  EXPECT_GE(scratch->capacity(), 4096UL);
+  // The whole buffer is usable.
+  uint8_t* grown = scratch->Reserve(4096);
+  grown[0] = 1;
+  grown[4095] = 2;
+  EXPECT_EQ(scratch->Reserve(1), grown);
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -195,6 +195,56 @@ TEST(dense_tensor, meta) {
                                       meta_5.valid()));
 }
 
+TEST(dense_tensor, compact_meta) {
+  CompactDenseTensorMeta meta_0;
+  PADDLE_ENFORCE_EQ(meta_0.rank(),
+                    -1,
+                    common::errors::InvalidArgument(
+                        "Fail in default CompactDenseTensorMeta. Expected "
+                        "rank: -1, but got: %s",
+                        meta_0.rank()));
+
+  // The dims of rank <= 4 are inline, the others are allocated.
+  const std::vector<DDim> all_dims = {
+      make_ddim(std::vector<int64_t>{}), {3, 4}, {1, 2, 3, 4, 5, 6}};
+  for (const DDim& dims : all_dims) {
+    DenseTensorMeta meta(DataType::BFLOAT16, dims, DataLayout::NHWC);
+    CompactDenseTensorMeta compact(meta);
+    CompactDenseTensorMeta copy = compact;
+    PADDLE_ENFORCE_EQ(copy.rank(),
+                      dims.size(),
+                      common::errors::InvalidArgument(
+                          "Fail in CompactDenseTensorMeta. Expected rank: "
+                          "%s, but got: %s",
+                          dims.size(),
+                          copy.rank()));
+    PADDLE_ENFORCE_EQ(
+        copy.dims(),
+        dims,
+        common::errors::InvalidArgument("Fail in CompactDenseTensorMeta. "
+                                        "Expected dims: %s, but got: %s",
+                                        dims,
+                                        copy.dims()));
+    PADDLE_ENFORCE_EQ(
+        copy.dtype(),
+        DataType::BFLOAT16,
+        common::errors::InvalidArgument("Fail in CompactDenseTensorMeta. "
+                                        "Expected dtype: bfloat16, but got: %s",
+                                        copy.dtype()));
+    PADDLE_ENFORCE_EQ(
+        copy.layout(),
+        DataLayout::NHWC,
+        common::errors::InvalidArgument("Fail in CompactDenseTensorMeta. "
+                                        "Expected layout: NHWC, but got: %s",
+                                        copy.layout()));
+  }
+  PADDLE_ENFORCE_LT(sizeof(CompactDenseTensorMeta),
+                    sizeof(DenseTensorMeta) / 3,
+                    common::errors::InvalidArgument(
+                        "Expected CompactDenseTensorMeta to be less than a "
+                        "third of the size of DenseTensorMeta."));
+}
+
 TEST(dense_tensor, def_ctor) {
   DenseTensor tensor_0;
   PADDLE_ENFORCE_EQ(
@@ -0,0 +1,171 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/core/distributed/gloo_utils.h"
+
+namespace phi {
+namespace distributed {
+
+// GlooSum goes through AVX-512 when the CPU supports it, 16 elements at a
+// time, and leaves the tail to gloo::sum. The lengths cover no vector, a
+// tail alone, whole vectors, and vectors followed by a tail.
+const std::vector<size_t> kLengths = {0, 1, 15, 16, 17, 31, 32, 33, 47, 100};
+
+uint16_t Bits(gloo::float16 x) { return x.x; }
+
+uint16_t Bits(phi::dtype::bfloat16 x) { return x.x; }
+
+uint32_t Bits(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+gloo::float16 ToFloat16(float x) { return gloo::cpu_float2half_rn(x); }
+
+phi::dtype::bfloat16 ToBFloat16(float x) { return phi::dtype::bfloat16(x); }
+
+bool IsNan(gloo::float16 x) { return std::isnan(gloo::cpu_half2float(x)); }
+
+bool IsNan(phi::dtype::bfloat16 x) {
+  return std::isnan(static_cast<float>(x));
+}
+
+bool IsNan(float x) { return std::isnan(x); }
+
+template <typename T, typename Convert>
+std::vector<T> RandomValues(size_t n, uint32_t seed, Convert convert) {
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+  std::vector<T> values;
+  for (size_t i = 0; i < n; ++i) {
+    values.push_back(convert(dist(engine)));
+  }
+  return values;
+}
+
+// Compares the sum of GlooSum with the scalar one of gloo::sum bit by bit,
+// except for the NaNs, whose payload may differ for float and float16.
+template <typename T, typename Convert>
+void CheckSameAsScalar(Convert convert) {
+  for (size_t n : kLengths) {
+    auto a = RandomValues<T>(n, 2026 + n, convert);
+    auto b = RandomValues<T>(n, 2027 + n, convert);
+    std::vector<T> expected(n), out(n);
+    gloo::sum<T>(expected.data(), a.data(), b.data(), n);
+    GlooSum<T>(out.data(), a.data(), b.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      if (IsNan(expected[i])) {
+        EXPECT_TRUE(IsNan(out[i])) << "n = " << n << ", i = " << i;
+      } else {
+        EXPECT_EQ(Bits(out[i]), Bits(expected[i]))
+            << "n = " << n << ", i = " << i;
+      }
+    }
+  }
+}
+
+TEST(GlooSum, same_as_scalar) {
+  LOG(INFO) << "AVX-512 is "
+            << (phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f)
+                    ? "used"
+                    : "not supported, the scalar path is compared to itself");
+  CheckSameAsScalar<float>([](float x) { return x; });
+  CheckSameAsScalar<gloo::float16>(ToFloat16);
+  CheckSameAsScalar<phi::dtype::bfloat16>(ToBFloat16);
+}
+
+// 1 + 2^-8 and 1 + 3 * 2^-8 are halfway between two bfloat16, and round to
+// the one whose last bit of mantissa is 0.
+TEST(GlooSum, bfloat16_rounds_to_nearest_even) {
+  const uint16_t one = 0x3F80;
+  const uint16_t ties[] = {0x3B80, 0x3C40};
+  const uint16_t rounded[] = {0x3F80, 0x3F82};
+  for (size_t n : kLengths) {
+    std::vector<phi::dtype::bfloat16> a(n), b(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = phi::dtype::raw_uint16_to_bfloat16(one);
+      b[i] = phi::dtype::raw_uint16_to_bfloat16(ties[i % 2]);
+    }
+    GlooSum<phi::dtype::bfloat16>(out.data(), a.data(), b.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(out[i].x, rounded[i % 2]) << "n = " << n << ", i = " << i;
+    }
+  }
+}
+
+// A NaN in the vectors or in the tail gives a NaN at its place only, and
+// the bfloat16 one is 0x7FFF as cpu_float_to_bfloat16 stores it.
+TEST(GlooSum, nan) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const size_t n = 37;
+  const std::vector<size_t> nan_indices = {0, 15, 16, 33, 36};
+
+  std::vector<float> a(n, 1.0f), b(n, 2.0f), out(n);
+  std::vector<gloo::float16> a16(n, ToFloat16(1.0f)), b16(n, ToFloat16(2.0f)),
+      out16(n);
+  std::vector<phi::dtype::bfloat16> abf(n, ToBFloat16(1.0f)),
+      bbf(n, ToBFloat16(2.0f)), outbf(n);
+  for (size_t i : nan_indices) {
+    a[i] = nan;
+    a16[i] = ToFloat16(nan);
+    abf[i] = ToBFloat16(nan);
+  }
+  GlooSum<float>(out.data(), a.data(), b.data(), n);
+  GlooSum<gloo::float16>(out16.data(), a16.data(), b16.data(), n);
+  GlooSum<phi::dtype::bfloat16>(outbf.data(), abf.data(), bbf.data(), n);
+
+  for (size_t i = 0; i < n; ++i) {
+    bool is_nan = std::find(nan_indices.begin(), nan_indices.end(), i) !=
+                  nan_indices.end();
+    EXPECT_EQ(IsNan(out[i]), is_nan) << "i = " << i;
+    EXPECT_EQ(IsNan(out16[i]), is_nan) << "i = " << i;
+    if (is_nan) {
+      EXPECT_EQ(outbf[i].x, 0x7FFF) << "i = " << i;
+    } else {
+      EXPECT_EQ(out[i], 3.0f);
+      EXPECT_EQ(gloo::cpu_half2float(out16[i]), 3.0f);
+      EXPECT_EQ(static_cast<float>(outbf[i]), 3.0f);
+    }
+  }
+}
+
+// The sums out of the range of float16 and bfloat16 are infinite.
+TEST(GlooSum, overflow) {
+  const size_t n = 33;
+  std::vector<gloo::float16> a16(n, ToFloat16(65504.0f)), out16(n);
+  GlooSum<gloo::float16>(out16.data(), a16.data(), a16.data(), n);
+  // 0x7F7F is the largest finite bfloat16.
+  std::vector<phi::dtype::bfloat16> abf(
+      n, phi::dtype::raw_uint16_to_bfloat16(0x7F7F));
+  std::vector<phi::dtype::bfloat16> outbf(n);
+  GlooSum<phi::dtype::bfloat16>(outbf.data(), abf.data(), abf.data(), n);
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(out16[i].x, 0x7C00) << "i = " << i;
+    EXPECT_EQ(outbf[i].x, 0x7F80) << "i = " << i;
+  }
+}
+
+}  // namespace distributed
+}  // namespace phi
@@ -0,0 +1,94 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/intra_op_parallel.h"
+
+namespace phi {
+namespace tests {
+
+// The cores may repeat, so that the tests run on a single core.
+std::vector<int> TestCores() { return {0, 0, 0, 0}; }
+
+TEST(IntraOpThreadPool, shared_by_cores) {
+  auto pool = IntraOpThreadPool::GetOrCreate(TestCores());
+  EXPECT_EQ(pool, IntraOpThreadPool::GetOrCreate(TestCores()));
+  EXPECT_EQ(pool->NumThreads(), 4);
+}
+
+TEST(IntraOpThreadPool, parallel_for_covers_range) {
+  auto pool = IntraOpThreadPool::GetOrCreate(TestCores());
+  std::vector<int> counts(10007, 0);
+  auto add_one = [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      ++counts[i];
+    }
+  };
+  // Without a pool, then with one.
+  ParallelFor(0, counts.size(), 16, add_one);
+  {
+    IntraOpThreadPoolGuard guard(pool.get());
+    EXPECT_EQ(IntraOpThreadPool::Current(), pool.get());
+    ParallelFor(0, counts.size(), 16, add_one);
+  }
+  EXPECT_EQ(IntraOpThreadPool::Current(), nullptr);
+  for (int count : counts) {
+    EXPECT_EQ(count, 2);
+  }
+}
+
+TEST(IntraOpThreadPool, concurrent_and_nested_loops) {
+  auto pool = IntraOpThreadPool::GetOrCreate(TestCores());
+  std::atomic<int64_t> total{0};
+  std::vector<std::thread> callers;
+  for (int t = 0; t < 4; ++t) {
+    callers.emplace_back([&] {
+      IntraOpThreadPoolGuard guard(pool.get());
+      for (int r = 0; r < 50; ++r) {
+        ParallelFor(0, 1000, 7, [&](int64_t begin, int64_t end) {
+          // Runs serially within the chunk.
+          ParallelFor(begin, end, 1, [&](int64_t b, int64_t e) {
+            total += e - b;
+          });
+        });
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(total.load(), 4 * 50 * 1000);
+}
+
+TEST(IntraOpThreadPool, rethrows) {
+  auto pool = IntraOpThreadPool::GetOrCreate(TestCores());
+  IntraOpThreadPoolGuard guard(pool.get());
+  EXPECT_THROW(ParallelFor(0,
+                           100,
+                           1,
+                           [](int64_t begin, int64_t end) {
+                             if (begin <= 50 && 50 < end) {
+                               throw std::runtime_error("chunk failed");
+                             }
+                           }),
+               std::runtime_error);
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -48,6 +48,26 @@ TEST(KernelFactory, SelectedKernelMap) {
   }
 }
 
+TEST(KernelHandle, SameAsFactory) {
+  auto& factory = phi::KernelFactory::Instance();
+  phi::KernelHandle handle("scale");
+  EXPECT_EQ(handle.name_id(), factory.InternKernelName("scale"));
+  phi::KernelKey kernel_key(
+      phi::Backend::CPU, phi::DataLayout::ALL_LAYOUT, phi::DataType::FLOAT32);
+  auto expected = factory.SelectKernelOrThrowError("scale", kernel_key);
+  EXPECT_EQ(handle.Find(kernel_key), &expected.kernel);
+  EXPECT_EQ(&handle.Select(kernel_key).kernel, &expected.kernel);
+  // the row is built again after the kernels change
+  factory.mutable_kernels();
+  EXPECT_EQ(&handle.Select(kernel_key, true).kernel, &expected.kernel);
+
+  phi::KernelKey unregistered_key(phi::Backend::CPU,
+                                  phi::DataLayout::ALL_LAYOUT,
+                                  phi::DataType::PSTRING);
+  EXPECT_EQ(handle.Find(unregistered_key), nullptr);
+  EXPECT_ANY_THROW(handle.Select(unregistered_key));
+}
+
 template <typename T, typename Context>
 void TestKernel(const Context& dev_ctx,
                 const DenseTensor& x,
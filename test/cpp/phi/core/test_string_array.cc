@@ -0,0 +1,76 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/vocab/string_array.h"
+
+namespace phi {
+namespace tests {
+
+TEST(string_array, convert_str_to_wstr) {
+  std::wstring res;
+  EXPECT_TRUE(ConvertStrToWstr("hello, world", &res));
+  EXPECT_EQ(res, L"hello, world");
+
+  // Two, three and four byte sequences among the ASCII.
+  EXPECT_TRUE(ConvertStrToWstr("caf\xc3\xa9 \xe4\xb8\xad\xe6\x96\x87!", &res));
+  EXPECT_EQ(res, std::wstring({L'c', L'a', L'f', 0xe9, L' ', 0x4e2d, 0x6587,
+                               L'!'}));
+  if (sizeof(wchar_t) == 4) {
+    EXPECT_TRUE(ConvertStrToWstr("\xf0\x9f\x98\x80", &res));
+    EXPECT_EQ(res, std::wstring(1, static_cast<wchar_t>(0x1f600)));
+  }
+
+  // A sequence cut by the end is dropped.
+  EXPECT_TRUE(ConvertStrToWstr("ab\xe4\xb8", &res));
+  EXPECT_EQ(res, L"ab");
+
+  // Invalid leading and continuation bytes, and an overlong form.
+  EXPECT_FALSE(ConvertStrToWstr("a\x80" "b", &res));
+  EXPECT_FALSE(ConvertStrToWstr("\xe4\x41\x41", &res));
+  EXPECT_FALSE(ConvertStrToWstr("\xc0\xaf", &res));
+  EXPECT_FALSE(ConvertStrToWstr("\xe0\x80\xaf", &res));
+}
+
+TEST(string_array, convert_str_to_wstr_in_threads) {
+  const std::string text = "the quick brown fox \xe4\xb8\xad\xe6\x96\x87";
+  std::wstring expected;
+  ASSERT_TRUE(ConvertStrToWstr(text, &expected));
+
+  std::vector<int> failures(8, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < failures.size(); ++t) {
+    threads.emplace_back([&, t] {
+      std::wstring res;
+      for (int i = 0; i < 1000; ++i) {
+        if (!ConvertStrToWstr(text, &res) || res != expected) {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int failure : failures) {
+    EXPECT_EQ(failure, 0);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "paddle/phi/core/distributed/store/tcp_store.h"
 #include "paddle/phi/core/distributed/store/tcp_utils.h"
@@ -37,6 +39,44 @@ TEST(MasterDaemon, init) {
   d.reset();
 }
 
+#ifndef _WIN32
+TEST(TCPStore, ShardedMultiGetAndBarrier) {
+  constexpr int kWorldSize = 4;
+  std::vector<std::thread> threads;
+  for (int rank = 0; rank < kWorldSize; ++rank) {
+    threads.emplace_back([rank]() {
+      TCPStore store("127.0.0.1", 6270, rank == 0, kWorldSize, 100, 2);
+      std::string value = std::to_string(rank);
+      store.multi_set({"key/" + value, "other/" + value},
+                      {std::vector<uint8_t>(value.begin(), value.end()),
+                       std::vector<uint8_t>(value.begin(), value.end())});
+      store.barrier("test", rank, kWorldSize);
+
+      std::vector<std::string> keys;
+      for (int i = 0; i < kWorldSize; ++i) {
+        keys.push_back("key/" + std::to_string(i));
+        keys.push_back("other/" + std::to_string(i));
+      }
+      auto values = store.multi_get(keys);
+      ASSERT_EQ(values.size(), keys.size());
+      for (int i = 0; i < kWorldSize; ++i) {
+        std::string expected = std::to_string(i);
+        EXPECT_EQ(std::string(values[2 * i].begin(), values[2 * i].end()),
+                  expected);
+        EXPECT_EQ(
+            std::string(values[2 * i + 1].begin(), values[2 * i + 1].end()),
+            expected);
+      }
+      // The master serves the others until they are done.
+      store.barrier("test", rank, kWorldSize);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+#endif
+
 /* now for only c compile test
 TEST(TCPStore, init) {
   TCPStore store("127.0.0.1", 6170, true, 1);
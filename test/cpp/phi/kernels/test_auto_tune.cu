@@ -135,3 +135,73 @@ TEST(AutoTune, sum) {
   }
 #endif
 }
+
+template <typename T>
+__global__ void FillTest(T* y, T value, int N) {
+  for (int i = blockDim.x * blockIdx.x + threadIdx.x; i < N;
+       i += blockDim.x * gridDim.x) {
+    y[i] = value;
+  }
+}
+
+TEST(AutoTune, launch_config) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  int N = 1 << 16;
+  const auto alloc_cuda =
+      std::make_unique<paddle::experimental::DefaultAllocator>(phi::GPUPlace());
+  phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
+  auto* dev_ctx =
+      static_cast<const phi::GPUContext*>(pool.GetByPlace(phi::GPUPlace()));
+  auto d_out = std::make_shared<phi::DenseTensor>(
+      alloc_cuda.get(),
+      phi::DenseTensorMeta(phi::DataType::FLOAT32,
+                           common::make_ddim({N}),
+                           phi::DataLayout::NCHW));
+  float* d_out_data = d_out->data<float>();
+
+  std::vector<int> launched;
+  auto run_tuner = [&] {
+    tune::LaunchConfigAutoTuner<float> tuner;
+    for (int threads : {256, 128, 512}) {
+      tuner.AddCandidate([&, threads] {
+        launched.push_back(threads);
+        FillTest<float><<<(N + threads - 1) / threads,
+                          threads,
+                          0,
+                          dev_ctx->stream()>>>(d_out_data, 3.0f, N);
+      });
+    }
+    EXPECT_EQ(tuner.CandidateNum(), 3UL);
+    tuner.Run(*dev_ctx, tune::AlgorithmType::kGather, N);
+  };
+
+  // The heuristic runs when autotune is off.
+  auto& cache =
+      tune::AutoTuneCache::Instance().Get(tune::AlgorithmType::kGather);
+  cache.Clean();
+  run_tuner();
+  EXPECT_EQ(launched, std::vector<int>({256}));
+  EXPECT_EQ(cache.Size(), 0);
+
+  // All the candidates are timed once autotune is on, then the best one is
+  // cached for the shape.
+  tune::AutoTuneStatus::Instance().EnableAutoTune();
+  tune::AutoTuneStatus::Instance().Update();
+  ASSERT_TRUE(tune::AutoTuneStatus::Instance().UseAutoTune());
+  launched.clear();
+  run_tuner();
+  EXPECT_EQ(cache.Size(), 1);
+  EXPECT_GT(launched.size(), 3UL);
+
+  launched.clear();
+  run_tuner();
+  EXPECT_EQ(launched.size(), 1UL);
+  tune::AutoTuneStatus::Instance().DisableAutoTune();
+
+  phi::DenseTensor out;
+  phi::Copy(*dev_ctx, *d_out, phi::CPUPlace(), true, &out);
+  for (int i = 0; i < N; ++i) {
+    EXPECT_EQ(out.data<float>()[i], 3.0f);
+  }
+#endif
+}
@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include <functional>
+#include <string>
 
 #include "paddle/phi/kernels/autotune/cache.h"
 
@@ -66,3 +67,57 @@ TEST(AlgosCache, AlgosCache) {
   EXPECT_EQ(autotune_cache.CacheMisses(), 2);
   EXPECT_LT(std::abs(cache_hit_rate - autotune_cache.CacheHitRate()), 1e-5);
 }
+
+TEST(AlgosCache, SaveLoadMerge) {
+  auto& autotune_cache = phi::autotune::AutoTuneCache::Instance();
+  autotune_cache.Clean();
+  auto& conv_cache =
+      autotune_cache.GetConv(phi::autotune::AlgorithmType::kConvForward);
+  auto& transpose_cache =
+      autotune_cache.Get(phi::autotune::AlgorithmType::kTranspose);
+
+  phi::DataType dtype = phi::CppTypeToDataType<float>::Type();
+  phi::autotune::ConvCacheKey key(
+      {4, 3, 64, 64}, {16, 3, 3, 3}, {1, 1}, {1, 1}, {1, 1}, dtype, 1, 0);
+  conv_cache.Set(key,
+                 phi::autotune::ConvAutoTuneResult(
+                     static_cast<int64_t>(ConvAlgos::CuDNNKernel_1), 0, false));
+  transpose_cache.Set(7, 2);
+
+  std::string first_path = "autotune_cache_first.txt";
+  autotune_cache.Save(first_path);
+
+  // A result of an exhaustive search wins when merged.
+  autotune_cache.Clean();
+  conv_cache.Set(key,
+                 phi::autotune::ConvAutoTuneResult(
+                     static_cast<int64_t>(ConvAlgos::CuDNNKernel_2), 64, true));
+  std::string second_path = "autotune_cache_second.txt";
+  autotune_cache.Save(second_path);
+
+  autotune_cache.Clean();
+  EXPECT_TRUE(autotune_cache.Load(first_path));
+  EXPECT_EQ(conv_cache.Size(), 1);
+  EXPECT_EQ(conv_cache.Get(key).algo, ConvAlgos::CuDNNKernel_1);
+  EXPECT_EQ(transpose_cache.Get(7), 2);
+
+  std::string merged_path = "autotune_cache_merged.txt";
+  phi::autotune::MergeAutoTuneCacheFiles({first_path, second_path},
+                                         merged_path);
+  autotune_cache.Clean();
+  EXPECT_TRUE(autotune_cache.Load(merged_path));
+  auto result = conv_cache.Get(key);
+  EXPECT_EQ(result.algo, ConvAlgos::CuDNNKernel_2);
+  EXPECT_EQ(result.workspace_size, 64UL);
+  EXPECT_TRUE(result.exhaustive_search);
+  EXPECT_EQ(transpose_cache.Get(7), 2);
+
+  // The results tuned by this process are not overwritten.
+  autotune_cache.Clean();
+  transpose_cache.Set(7, 3);
+  EXPECT_TRUE(autotune_cache.Load(merged_path));
+  EXPECT_EQ(transpose_cache.Get(7), 3);
+
+  EXPECT_FALSE(autotune_cache.Load("autotune_cache_missing.txt"));
+  autotune_cache.Clean();
+}
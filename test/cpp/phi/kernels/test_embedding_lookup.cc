@@ -0,0 +1,120 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "paddle/phi/kernels/funcs/embedding_lookup.h"
+
+namespace phi {
+namespace tests {
+
+TEST(EmbeddingLookup, LookupRows) {
+  const int64_t width = 20;
+  std::vector<float> table(5 * width);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i);
+  }
+  std::vector<int64_t> ids = {3, 0, 2, 3, 4, 2, 1, 0, 3, 4, 1};
+  std::vector<float> out(ids.size() * width);
+  funcs::EmbeddingLookupRows(table.data(), width, ids, 2, out.data());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    for (int64_t j = 0; j < width; ++j) {
+      float expected = ids[i] == 2 ? 0.f : table[ids[i] * width + j];
+      EXPECT_EQ(out[i * width + j], expected);
+    }
+  }
+}
+
+TEST(EmbeddingLookup, MergeRows) {
+  std::vector<int64_t> ids = {5, 1, 5, 0, 1, 5, 3};
+  auto groups = funcs::GroupEmbeddingIds(ids, 3);
+  EXPECT_EQ(groups.rows, std::vector<int64_t>({5, 1, 0}));
+  EXPECT_EQ(groups.offsets, std::vector<int64_t>({0, 3, 5, 6}));
+  EXPECT_EQ(groups.positions, std::vector<int64_t>({0, 2, 5, 1, 4, 3}));
+
+  const int64_t width = 3;
+  std::vector<double> grad(ids.size() * width);
+  for (size_t i = 0; i < grad.size(); ++i) {
+    grad[i] = static_cast<double>(i);
+  }
+  std::vector<double> merged(groups.rows.size() * width);
+  funcs::MergeEmbeddingRows(grad.data(), width, groups, false, merged.data());
+  std::vector<double> table(6 * width, 0.);
+  funcs::MergeEmbeddingRows(grad.data(), width, groups, true, table.data());
+  for (size_t u = 0; u < groups.rows.size(); ++u) {
+    for (int64_t j = 0; j < width; ++j) {
+      double expected = 0.;
+      for (size_t i = 0; i < ids.size(); ++i) {
+        if (ids[i] == groups.rows[u]) {
+          expected += grad[i * width + j];
+        }
+      }
+      EXPECT_EQ(merged[u * width + j], expected);
+      EXPECT_EQ(table[groups.rows[u] * width + j], expected);
+    }
+  }
+  // the skipped id and the absent rows are untouched
+  for (int64_t j = 0; j < width; ++j) {
+    EXPECT_EQ(table[3 * width + j], 0.);
+    EXPECT_EQ(table[4 * width + j], 0.);
+  }
+}
+
+template <typename T>
+void TestPooledLookup(int64_t width) {
+  const int64_t height = 7;
+  std::vector<T> table(height * width);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<T>(i % 13) - static_cast<T>(6);
+  }
+  std::vector<int64_t> ids = {1, 6, 6, 0, 2, 5, 3, 3, 4};
+  std::vector<int64_t> offsets = {0, 3, 3, 4, 9};
+  const int64_t bag_num = static_cast<int64_t>(offsets.size()) - 1;
+  for (auto pool_type :
+       {funcs::EmbeddingPoolType::kSum, funcs::EmbeddingPoolType::kMean}) {
+    std::vector<T> out(bag_num * width);
+    funcs::EmbeddingPooledLookup(table.data(),
+                                 height,
+                                 width,
+                                 ids.data(),
+                                 offsets,
+                                 pool_type,
+                                 out.data());
+    for (int64_t b = 0; b < bag_num; ++b) {
+      int64_t len = offsets[b + 1] - offsets[b];
+      for (int64_t j = 0; j < width; ++j) {
+        T expected = static_cast<T>(0);
+        for (int64_t i = offsets[b]; i < offsets[b + 1]; ++i) {
+          expected += table[ids[i] * width + j];
+        }
+        if (pool_type == funcs::EmbeddingPoolType::kMean && len > 0) {
+          expected /= static_cast<T>(len);
+        }
+        EXPECT_NEAR(out[b * width + j], expected, 1e-5);
+      }
+    }
+  }
+}
+
+TEST(EmbeddingLookup, PooledLookup) {
+  // the widths of multiples of 8 run the jit kernel for float
+  TestPooledLookup<float>(16);
+  TestPooledLookup<float>(5);
+  TestPooledLookup<double>(16);
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "paddle/phi/kernels/funcs/philox_engine.h"
+
+TEST(Philox4x32, KnownAnswer) {
+  // The known answer of Philox4x32-10 for the zero counter and key.
+  phi::funcs::Philox4x32 engine(0);
+  auto result = engine(0);
+  EXPECT_EQ(result[0], 0x6627e8d5u);
+  EXPECT_EQ(result[1], 0xe169c58du);
+  EXPECT_EQ(result[2], 0xbc57ac4cu);
+  EXPECT_EQ(result[3], 0x9b00dbd8u);
+}
+
+TEST(Philox4x32, UniformByCounter) {
+  const int64_t size = 1001;
+  std::vector<float> all(size);
+  phi::funcs::PhiloxUniformDistribution<float>(
+      all.data(), size, -1.0f, 1.0f, 2026, 10);
+  for (float value : all) {
+    EXPECT_GE(value, -1.0f);
+    EXPECT_LE(value, 1.0f);
+  }
+  // The elements from counter 20 on are the same when generated alone.
+  std::vector<float> tail(size - 40);
+  phi::funcs::PhiloxUniformDistribution<float>(
+      tail.data(), size - 40, -1.0f, 1.0f, 2026, 20);
+  for (int64_t i = 0; i < size - 40; ++i) {
+    EXPECT_EQ(tail[i], all[i + 40]);
+  }
+}
+
+TEST(Philox4x32, NormalDouble) {
+  const int64_t size = 100000;
+  std::vector<double> data(size);
+  phi::funcs::PhiloxNormalDistribution<double>(
+      data.data(), size, 1.0f, 2.0f, 7, 0);
+  double sum = 0;
+  double sq_sum = 0;
+  for (double value : data) {
+    sum += value;
+    sq_sum += value * value;
+  }
+  double mean = sum / size;
+  double var = sq_sum / size - mean * mean;
+  EXPECT_NEAR(mean, 1.0, 0.05);
+  EXPECT_NEAR(var, 4.0, 0.1);
+}
@@ -219,3 +219,80 @@ TEST(Broadcast, add) {
   } while (0);
 #endif
 }
+
+template <typename T>
+struct SubBinary {
+  inline HOSTDEVICE T operator()(T a, T b) const { return a - b; }
+};
+
+template <typename T>
+void CheckBinaryCase(const phi::GPUContext& dev_ctx,
+                     const phi::DDim& dim_x,
+                     const phi::DDim& dim_y) {
+  phi::DataType dtype = phi::CppTypeToDataType<T>::Type();
+  const auto alloc_cpu =
+      std::make_unique<paddle::experimental::DefaultAllocator>(phi::CPUPlace());
+  const auto alloc_gpu =
+      std::make_unique<paddle::experimental::DefaultAllocator>(phi::GPUPlace());
+  const auto& dim_out = dim_x;
+
+  auto x = std::make_shared<phi::DenseTensor>(
+      alloc_cpu.get(),
+      phi::DenseTensorMeta(dtype, dim_x, phi::DataLayout::NCHW));
+  auto y = std::make_shared<phi::DenseTensor>(
+      alloc_cpu.get(),
+      phi::DenseTensorMeta(dtype, dim_y, phi::DataLayout::NCHW));
+  for (int64_t i = 0; i < x->numel(); ++i) {
+    x->data<T>()[i] = static_cast<T>(i % 97);
+  }
+  for (int64_t i = 0; i < y->numel(); ++i) {
+    y->data<T>()[i] = static_cast<T>(i % 13);
+  }
+
+  auto d_x = std::make_shared<phi::DenseTensor>(
+      alloc_gpu.get(),
+      phi::DenseTensorMeta(dtype, dim_x, phi::DataLayout::NCHW));
+  auto d_y = std::make_shared<phi::DenseTensor>(
+      alloc_gpu.get(),
+      phi::DenseTensorMeta(dtype, dim_y, phi::DataLayout::NCHW));
+  auto d_out = std::make_shared<phi::DenseTensor>(
+      alloc_gpu.get(),
+      phi::DenseTensorMeta(dtype, dim_out, phi::DataLayout::NCHW));
+  phi::Copy(dev_ctx, *x.get(), phi::GPUPlace(), false, d_x.get());
+  phi::Copy(dev_ctx, *y.get(), phi::GPUPlace(), false, d_y.get());
+
+  std::vector<const phi::DenseTensor*> inputs{d_x.get(), d_y.get()};
+  std::vector<phi::DenseTensor*> outputs{d_out.get()};
+  phi::funcs::BroadcastKernel<T>(dev_ctx, inputs, &outputs, SubBinary<T>());
+
+  phi::DenseTensor out;
+  phi::Copy(dev_ctx, *d_out.get(), phi::CPUPlace(), true, &out);
+  int64_t cols = dim_x[dim_x.size() - 1];
+  bool is_last_dim = y->numel() == cols;
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    int64_t y_idx = is_last_dim ? i % cols : i / cols;
+    T expected = x->data<T>()[i] - y->data<T>()[y_idx];
+    ASSERT_EQ(out.data<T>()[i], expected);
+  }
+}
+
+TEST(Broadcast, row_col) {
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  auto place = phi::GPUPlace();
+  phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
+  auto* dev_ctx = static_cast<const phi::GPUContext*>(pool.GetByPlace(place));
+
+  // [B, S, H] op [H]
+  CheckBinaryCase<float>(*dev_ctx,
+                         common::make_ddim({2, 129, 1024}),
+                         common::make_ddim({1024}));
+  // [B, S, H] op [B, S, 1]
+  CheckBinaryCase<float>(*dev_ctx,
+                         common::make_ddim({2, 129, 1024}),
+                         common::make_ddim({2, 129, 1}));
+  // H is not a multiple of the vectorized size.
+  CheckBinaryCase<float>(*dev_ctx,
+                         common::make_ddim({3, 7, 33}),
+                         common::make_ddim({3, 7, 1}));
+#endif
+}
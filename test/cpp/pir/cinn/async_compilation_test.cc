@@ -0,0 +1,149 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "paddle/cinn/hlir/dialect/operator/ir/op_dialect.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/add_broadcast_to_elementwise_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/add_store_in_group_op_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/cinn_group_cluster_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/lowering_pass/lower_cinn_fusion_op_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/pd_to_cinn_pass.h"
+#include "paddle/cinn/hlir/dialect/runtime/ir/jit_kernel_op.h"
+#include "paddle/cinn/hlir/framework/async_compilation.h"
+#include "paddle/cinn/hlir/framework/pir/utils.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/new_executor/interpretercore.h"
+#include "paddle/fluid/framework/tensor_util.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/transforms/build_cinn_pass.h"
+#include "paddle/fluid/pir/transforms/general/dead_code_elimination_pass.h"
+#include "paddle/fluid/pir/transforms/pd_op_to_kernel_pass.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass_manager.h"
+
+PD_DECLARE_bool(cinn_async_compile);
+
+using cinn::hlir::framework::AsyncCompilationService;
+using cinn::hlir::framework::pir::AsyncCompiledKernel;
+
+// (x + x) * x, which CINN fuses into one group.
+static std::shared_ptr<::pir::Program> BuildElementwiseProgram() {
+  ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  auto program = std::make_shared<::pir::Program>(ctx);
+  ::pir::Builder builder = ::pir::Builder(ctx, program->block());
+
+  auto x = builder
+               .Build<paddle::dialect::FullOp>(std::vector<int64_t>{64, 128},
+                                               2.0,
+                                               phi::DataType::FLOAT32,
+                                               phi::GPUPlace())
+               .result(0);
+  auto add = builder.Build<paddle::dialect::AddOp>(x, x).result(0);
+  auto out = builder.Build<paddle::dialect::MultiplyOp>(add, x).result(0);
+  builder.Build<paddle::dialect::FetchOp>(out, "out", 0);
+  return program;
+}
+
+static void LowerToJitKernel(::pir::Program* program) {
+  ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<cinn::dialect::OperatorDialect>();
+
+  pir::PassManager stage_1_pm(ctx);
+  stage_1_pm.AddPass(cinn::dialect::ir::CreatePdOpToCinnOpPass());
+  stage_1_pm.AddPass(pir::CreateDeadCodeEliminationPass());
+  stage_1_pm.AddPass(pir::CreateBuildCinnPass());
+  stage_1_pm.AddPass(cinn::dialect::ir::CreateAddBroadcastToElementwisePass());
+  ASSERT_TRUE(stage_1_pm.Run(program));
+
+  pir::PassManager stage_2_pm(ctx);
+  stage_2_pm.AddPass(cinn::dialect::ir::CreateAddStoreInGroupOpPass());
+  stage_2_pm.AddPass(cinn::dialect::ir::CreateCinnGroupClusterPass());
+  stage_2_pm.AddPass(pir::CreateDeadCodeEliminationPass());
+  stage_2_pm.AddPass(cinn::dialect::ir::CreateLowerCinnFusionOpPass());
+  ASSERT_TRUE(stage_2_pm.Run(program));
+}
+
+static std::vector<std::shared_ptr<AsyncCompiledKernel>> AsyncKernels(
+    ::pir::Program* program) {
+  std::vector<std::shared_ptr<AsyncCompiledKernel>> kernels;
+  for (auto& op : *program->block()) {
+    if (op.isa<cinn::dialect::JitKernelOp>()) {
+      kernels.push_back(op.dyn_cast<cinn::dialect::JitKernelOp>()
+                            .cinn_kernel_info()
+                            .async_kernel);
+    }
+  }
+  return kernels;
+}
+
+static void ExpectOutput(paddle::framework::InterpreterCore* executor,
+                         float expected) {
+  const auto& out =
+      executor->local_scope()->FindVar("out@fetch")->Get<phi::DenseTensor>();
+  phi::DenseTensor cpu_out;
+  paddle::framework::TensorCopySync(out, phi::CPUPlace(), &cpu_out);
+  ASSERT_EQ(cpu_out.numel(), 64 * 128);
+  for (int64_t i = 0; i < cpu_out.numel(); ++i) {
+    ASSERT_FLOAT_EQ(cpu_out.data<float>()[i], expected);
+  }
+}
+
+TEST(AsyncCompilation, fallback_then_swap_in_kernel) {
+  FLAGS_cinn_async_compile = true;
+  AsyncCompilationService& service = AsyncCompilationService::Instance();
+  // Holds the compilation so that the first run takes the fallback.
+  service.Pause();
+
+  std::shared_ptr<::pir::Program> program = BuildElementwiseProgram();
+  LowerToJitKernel(program.get());
+  auto kernels = AsyncKernels(program.get());
+  ASSERT_FALSE(kernels.empty());
+  for (const auto& kernel : kernels) {
+    ASSERT_NE(kernel, nullptr);
+    EXPECT_FALSE(kernel->IsReady());
+  }
+
+  phi::Place place = phi::GPUPlace(0);
+  auto kernel_program =
+      paddle::dialect::PdOpLowerToKernelPass(program.get(), place);
+  paddle::framework::Scope scope;
+  paddle::framework::InterpreterCore executor(
+      place, {"out@fetch"}, kernel_program->block(), &scope);
+
+  executor.Run({}, true);
+  ExpectOutput(&executor, 8.0f);
+  for (const auto& kernel : kernels) {
+    EXPECT_FALSE(kernel->IsReady());
+  }
+
+  service.Resume();
+  service.Wait();
+  for (const auto& kernel : kernels) {
+    ASSERT_TRUE(kernel->IsReady());
+  }
+  // The same instructions swap in the compiled kernels.
+  executor.Run({}, true);
+  ExpectOutput(&executor, 8.0f);
+  executor.Run({}, true);
+  ExpectOutput(&executor, 8.0f);
+
+  FLAGS_cinn_async_compile = false;
+}
@@ -18,6 +18,7 @@ limitations under the License. */
 #include <sstream>
 
 #include "paddle/cinn/hlir/dialect/operator/ir/manual_op.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
 #include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
 #include "paddle/fluid/pir/transforms/build_cinn_pass.h"
@@ -29,6 +30,8 @@ limitations under the License. */
 #include "paddle/pir/include/pass/pass.h"
 #include "paddle/pir/include/pass/pass_manager.h"
 
+COMMON_DECLARE_bool(cinn_horizontal_merge_subgraph);
+
 std::shared_ptr<::pir::Program> BuildAllOpSupportCinnGraph() {
   ::pir::IrContext* ctx = ::pir::IrContext::Instance();
   ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
@@ -306,3 +309,67 @@ TEST(BuildCinnPassTest, MultiCinnSubgraph) {
         common::errors::InvalidArgument("Op name mismatch. Please check!"));
   }
 }
+
+std::shared_ptr<::pir::Program> BuildIndependentCinnSubgraph() {
+  ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+
+  auto program = std::make_shared<::pir::Program>(ctx);
+  ::pir::Builder builder = ::pir::Builder(ctx, program->block());
+
+  // ones -> hardswish -> tan -> sin -> square
+  // ones -> square -> cos -> sin -> hardswish
+  const std::vector<int64_t> shape = {64, 128};
+  auto ones_op_x = builder.Build<paddle::dialect::OnesOp>(
+      shape, phi::DataType::FLOAT32, phi::GPUPlace());
+  auto hardswish_op_x =
+      builder.Build<paddle::dialect::HardswishOp>(ones_op_x->result(0));
+  auto tan_op_x =
+      builder.Build<paddle::dialect::TanOp>(hardswish_op_x->result(0));
+  auto sin_op_x = builder.Build<paddle::dialect::SinOp>(tan_op_x->result(0));
+  builder.Build<paddle::dialect::SquareOp>(sin_op_x->result(0));
+
+  auto ones_op_y = builder.Build<paddle::dialect::OnesOp>(
+      shape, phi::DataType::FLOAT32, phi::GPUPlace());
+  auto square_op_y =
+      builder.Build<paddle::dialect::SquareOp>(ones_op_y->result(0));
+  auto cos_op_y = builder.Build<paddle::dialect::CosOp>(square_op_y->result(0));
+  auto sin_op_y = builder.Build<paddle::dialect::SinOp>(cos_op_y->result(0));
+  builder.Build<paddle::dialect::HardswishOp>(sin_op_y->result(0));
+  return program;
+}
+
+std::vector<cinn::dialect::GroupOp> GetGroupOps(const ::pir::Program& program) {
+  std::vector<cinn::dialect::GroupOp> group_ops;
+  for (auto& op : *program.block()) {
+    if (op.isa<cinn::dialect::GroupOp>()) {
+      group_ops.push_back(op.dyn_cast<cinn::dialect::GroupOp>());
+    }
+  }
+  return group_ops;
+}
+
+TEST(BuildCinnPassTest, HorizontalMergeSubgraph) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  {
+    auto origin_program = BuildIndependentCinnSubgraph();
+    pir::PassManager pm(ctx);
+    pm.AddPass(pir::CreateBuildCinnPass());
+    ASSERT_TRUE(pm.Run(origin_program.get()));
+    EXPECT_EQ(GetGroupOps(*origin_program).size(), 2u);
+  }
+
+  FLAGS_cinn_horizontal_merge_subgraph = true;
+  auto origin_program = BuildIndependentCinnSubgraph();
+  pir::PassManager pm(ctx);
+  pm.AddPass(pir::CreateBuildCinnPass());
+  ASSERT_TRUE(pm.Run(origin_program.get()));
+  FLAGS_cinn_horizontal_merge_subgraph = false;
+  LOG(INFO) << "after pass: " << *origin_program;
+
+  auto group_ops = GetGroupOps(*origin_program);
+  ASSERT_EQ(group_ops.size(), 1u);
+  // tan, sin, cos, sin and yield
+  EXPECT_EQ(group_ops[0].block()->size(), 5u);
+  EXPECT_EQ(group_ops[0]->num_results(), 2u);
+}
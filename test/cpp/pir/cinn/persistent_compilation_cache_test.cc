@@ -0,0 +1,290 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle/cinn/common/target.h"
+#include "paddle/cinn/hlir/dialect/operator/ir/op_dialect.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/add_broadcast_to_elementwise_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/add_store_in_group_op_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/cinn_group_cluster_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/lowering_pass/lower_cinn_fusion_op_pass.h"
+#include "paddle/cinn/hlir/dialect/operator/transforms/pd_to_cinn_pass.h"
+#include "paddle/cinn/hlir/framework/pir/compilation_cache.h"
+#include "paddle/cinn/hlir/framework/pir/persistent_compilation_cache.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/framework/new_executor/interpretercore.h"
+#include "paddle/fluid/framework/tensor_util.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/transforms/build_cinn_pass.h"
+#include "paddle/fluid/pir/transforms/general/dead_code_elimination_pass.h"
+#include "paddle/fluid/pir/transforms/pd_op_to_kernel_pass.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass_manager.h"
+
+PD_DECLARE_bool(enable_cinn_compile_cache);
+PD_DECLARE_string(cinn_compilation_cache_dir);
+PD_DECLARE_int64(cinn_compilation_cache_max_mb);
+
+namespace fs = std::filesystem;
+
+using cinn::hlir::framework::CompilationCache;
+using cinn::hlir::framework::pir::BackendResource;
+using cinn::hlir::framework::pir::PersistentCompilationCache;
+
+// (x + x) * x, which CINN fuses into one group.
+static std::shared_ptr<::pir::Program> BuildElementwiseProgram() {
+  ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  auto program = std::make_shared<::pir::Program>(ctx);
+  ::pir::Builder builder = ::pir::Builder(ctx, program->block());
+
+  auto x = builder
+               .Build<paddle::dialect::FullOp>(std::vector<int64_t>{64, 128},
+                                               2.0,
+                                               phi::DataType::FLOAT32,
+                                               phi::GPUPlace())
+               .result(0);
+  auto add = builder.Build<paddle::dialect::AddOp>(x, x).result(0);
+  auto out = builder.Build<paddle::dialect::MultiplyOp>(add, x).result(0);
+  builder.Build<paddle::dialect::FetchOp>(out, "out", 0);
+  return program;
+}
+
+static void LowerToJitKernel(::pir::Program* program) {
+  ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<cinn::dialect::OperatorDialect>();
+
+  pir::PassManager stage_1_pm(ctx);
+  stage_1_pm.AddPass(cinn::dialect::ir::CreatePdOpToCinnOpPass());
+  stage_1_pm.AddPass(pir::CreateDeadCodeEliminationPass());
+  stage_1_pm.AddPass(pir::CreateBuildCinnPass());
+  stage_1_pm.AddPass(cinn::dialect::ir::CreateAddBroadcastToElementwisePass());
+  ASSERT_TRUE(stage_1_pm.Run(program));
+
+  pir::PassManager stage_2_pm(ctx);
+  stage_2_pm.AddPass(cinn::dialect::ir::CreateAddStoreInGroupOpPass());
+  stage_2_pm.AddPass(cinn::dialect::ir::CreateCinnGroupClusterPass());
+  stage_2_pm.AddPass(pir::CreateDeadCodeEliminationPass());
+  stage_2_pm.AddPass(cinn::dialect::ir::CreateLowerCinnFusionOpPass());
+  ASSERT_TRUE(stage_2_pm.Run(program));
+}
+
+// Compiles (x + x) * x, which saves or loads its group, and checks the
+// result.
+static void CompileAndRun() {
+  std::shared_ptr<::pir::Program> program = BuildElementwiseProgram();
+  LowerToJitKernel(program.get());
+
+  phi::Place place = phi::GPUPlace(0);
+  auto kernel_program =
+      paddle::dialect::PdOpLowerToKernelPass(program.get(), place);
+  paddle::framework::Scope scope;
+  paddle::framework::InterpreterCore executor(
+      place, {"out@fetch"}, kernel_program->block(), &scope);
+  executor.Run({}, true);
+
+  const auto& out =
+      executor.local_scope()->FindVar("out@fetch")->Get<phi::DenseTensor>();
+  phi::DenseTensor cpu_out;
+  paddle::framework::TensorCopySync(out, phi::CPUPlace(), &cpu_out);
+  ASSERT_EQ(cpu_out.numel(), 64 * 128);
+  for (int64_t i = 0; i < cpu_out.numel(); ++i) {
+    ASSERT_FLOAT_EQ(cpu_out.data<float>()[i], 8.0f);
+  }
+}
+
+static std::vector<fs::path> ListEntries(const fs::path& dir) {
+  std::vector<fs::path> entries;
+  for (const auto& it : fs::directory_iterator(dir)) {
+    if (it.path().extension() == ".cinn") {
+      entries.push_back(it.path());
+    }
+  }
+  return entries;
+}
+
+static std::string ReadFile(const fs::path& path) {
+  std::ifstream fin(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(fin),
+                     std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const fs::path& path, const std::string& content) {
+  std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+  fout.write(content.data(), content.size());
+}
+
+// An entry starts with its magic, its version and its key.
+static constexpr size_t kKeyOffset = 3 * sizeof(uint64_t);
+
+static std::string EntryKey(const std::string& entry) {
+  uint64_t key_size = 0;
+  std::memcpy(
+      &key_size, entry.data() + 2 * sizeof(uint64_t), sizeof(key_size));
+  return entry.substr(kKeyOffset, key_size);
+}
+
+class PersistentCompilationCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* test_info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    cache_dir_ = fs::temp_directory_path() /
+                 (std::string("cinn_compilation_cache_") + test_info->name());
+    fs::remove_all(cache_dir_);
+    fs::create_directories(cache_dir_);
+    FLAGS_enable_cinn_compile_cache = true;
+    FLAGS_cinn_compilation_cache_dir = cache_dir_.string();
+    FLAGS_cinn_compilation_cache_max_mb = 4096;
+    CompilationCache::Instance().Clear();
+  }
+
+  void TearDown() override {
+    FLAGS_cinn_compilation_cache_dir = "";
+    FLAGS_cinn_compilation_cache_max_mb = 4096;
+    CompilationCache::Instance().Clear();
+    fs::remove_all(cache_dir_);
+  }
+
+  fs::path cache_dir_;
+};
+
+TEST_F(PersistentCompilationCacheTest, save_then_load) {
+  CompileAndRun();
+  std::vector<fs::path> entries = ListEntries(cache_dir_);
+  ASSERT_FALSE(entries.empty());
+
+  auto& cache = PersistentCompilationCache::Instance();
+  const auto& target = cinn::common::DefaultNVGPUTarget();
+  for (const auto& path : entries) {
+    const std::string key = EntryKey(ReadFile(path));
+    EXPECT_EQ(cache.EntryPath(key), path.string());
+    auto result = cache.Load(key, target);
+    ASSERT_NE(result, nullptr);
+    EXPECT_NE(result->GetBackendResource()->GetHostFuncPtr(), nullptr);
+    EXPECT_NE(result->GetKernelInfo().fn_ptr, nullptr);
+  }
+
+  // Without the in-memory results, the groups are loaded through
+  // Compiler::Load. The entries are only touched: the trailing bytes, which
+  // a load ignores, are kept and the entries are not saved again.
+  const std::string trailing = "trailing";
+  const auto old_time =
+      fs::file_time_type::clock::now() - std::chrono::hours(1);
+  std::vector<uintmax_t> sizes;
+  for (const auto& path : entries) {
+    WriteFile(path, ReadFile(path) + trailing);
+    fs::last_write_time(path, old_time);
+    sizes.push_back(fs::file_size(path));
+  }
+  CompilationCache::Instance().Clear();
+  CompileAndRun();
+  EXPECT_EQ(ListEntries(cache_dir_).size(), entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    EXPECT_EQ(fs::file_size(entries[i]), sizes[i]);
+    EXPECT_GT(fs::last_write_time(entries[i]), old_time);
+  }
+}
+
+TEST_F(PersistentCompilationCacheTest, reject_mismatched_or_corrupted_entry) {
+  CompileAndRun();
+  std::vector<fs::path> entries = ListEntries(cache_dir_);
+  ASSERT_FALSE(entries.empty());
+
+  auto& cache = PersistentCompilationCache::Instance();
+  const auto& target = cinn::common::DefaultNVGPUTarget();
+  const fs::path path = entries.front();
+  const std::string entry = ReadFile(path);
+  const std::string key = EntryKey(entry);
+  ASSERT_NE(cache.Load(key, target), nullptr);
+
+  // An entry found under another key, e.g. on a hash collision, is a miss.
+  const std::string other_key = key + "\nanother group";
+  WriteFile(cache.EntryPath(other_key), entry);
+  EXPECT_EQ(cache.Load(other_key, target), nullptr);
+  EXPECT_EQ(cache.Load(key + "x", target), nullptr);
+
+  WriteFile(path, entry.substr(0, kKeyOffset / 2));
+  EXPECT_EQ(cache.Load(key, target), nullptr);
+  WriteFile(path, entry.substr(0, entry.size() / 2));
+  EXPECT_EQ(cache.Load(key, target), nullptr);
+  WriteFile(path, entry.substr(0, entry.size() - 1));
+  EXPECT_EQ(cache.Load(key, target), nullptr);
+
+  // A corrupted length of the host function name.
+  std::string corrupted = entry;
+  const uint64_t huge_size = ~0ULL;
+  std::memcpy(corrupted.data() + kKeyOffset + key.size(),
+              &huge_size,
+              sizeof(huge_size));
+  WriteFile(path, corrupted);
+  EXPECT_EQ(cache.Load(key, target), nullptr);
+
+  // A corrupted host module, whose bitcode starts with 'BC' 0xC0DE.
+  corrupted = entry;
+  const size_t bitcode_pos = corrupted.find("BC\xC0\xDE");
+  ASSERT_NE(bitcode_pos, std::string::npos);
+  corrupted.replace(bitcode_pos, 4, "XXXX");
+  WriteFile(path, corrupted);
+  EXPECT_EQ(cache.Load(key, target), nullptr);
+
+  WriteFile(path, entry);
+  EXPECT_NE(cache.Load(key, target), nullptr);
+}
+
+TEST_F(PersistentCompilationCacheTest, evict_least_recently_used) {
+  FLAGS_cinn_compilation_cache_max_mb = 1;
+  const std::string content(400 << 10, 'x');
+  const auto now = fs::file_time_type::clock::now();
+  const std::vector<std::string> names = {"a.cinn", "b.cinn", "c.cinn"};
+  for (size_t i = 0; i < names.size(); ++i) {
+    WriteFile(cache_dir_ / names[i], content);
+    fs::last_write_time(cache_dir_ / names[i],
+                        now - std::chrono::hours(names.size() - i));
+  }
+  // Only the entries count in the budget.
+  WriteFile(cache_dir_ / "other.txt", std::string(1 << 20, 'x'));
+
+  const auto& target = cinn::common::DefaultNVGPUTarget();
+  BackendResource resource(target, "fn_evict", "infer_fn_evict", {}, {});
+  cinn::backends::CompiledArtifacts artifacts;
+  artifacts.host_bitcode = std::string(100 << 10, 'x');
+  auto& cache = PersistentCompilationCache::Instance();
+  const std::string key = "evict";
+  cache.Save(key, resource, artifacts);
+
+  // 3 * 400KB and the new entry exceed 1MB, the oldest entry is evicted.
+  EXPECT_TRUE(fs::exists(cache.EntryPath(key)));
+  EXPECT_FALSE(fs::exists(cache_dir_ / "a.cinn"));
+  EXPECT_TRUE(fs::exists(cache_dir_ / "b.cinn"));
+  EXPECT_TRUE(fs::exists(cache_dir_ / "c.cinn"));
+  EXPECT_TRUE(fs::exists(cache_dir_ / "other.txt"));
+  uintmax_t total_bytes = 0;
+  for (const auto& path : ListEntries(cache_dir_)) {
+    total_bytes += fs::file_size(path);
+  }
+  EXPECT_LE(total_bytes, uintmax_t{1} << 20);
+}
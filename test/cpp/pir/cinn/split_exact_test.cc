@@ -0,0 +1,78 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "paddle/cinn/common/integer_set.h"
+#include "paddle/cinn/ir/ir.h"
+#include "paddle/cinn/ir/op/ir_operators.h"
+#include "paddle/cinn/ir/schedule/ir_schedule.h"
+#include "paddle/cinn/ir/schedule/ir_schedule_util.h"
+#include "paddle/cinn/ir/utils/ir_nodes_collector.h"
+
+namespace cinn {
+namespace ir {
+
+namespace {
+
+size_t CountIfThenElse(const ir::Expr& expr) {
+  return ir::ir_utils::CollectIRNodesWithoutTensor(
+             expr,
+             [](const ir::Expr* x) {
+               return x->As<ir::IfThenElse>() != nullptr;
+             })
+      .size();
+}
+
+}  // namespace
+
+TEST(MakeSplitExact, DynamicExtent) {
+  ir::Var n("n");
+  ir::Expr extent(n);
+  ir::Expr block = ir::ScheduleBlock::Make(std::vector<Var>(),
+                                           std::vector<Expr>(),
+                                           std::vector<Expr>(),
+                                           "block",
+                                           ir::Expr(0));
+  ir::Expr loop = ir::For::Make(ir::Var("i"),
+                                ir::Expr(0),
+                                extent,
+                                ir::ForType::Serial,
+                                ir::DeviceAPI::Host,
+                                ir::Block::Make({block}),
+                                ir::VectorizeInfo(),
+                                ir::BindInfo());
+  ir::ModuleExpr mod_expr({loop});
+  ir::IRSchedule sch(mod_expr,
+                     -1,
+                     false,
+                     utils::ErrorMessageLevel::kGeneral,
+                     /* is_dynamic_shape = */ true);
+
+  std::vector<ir::Expr> loops = sch.Split(loop, {-1, 8});
+  ASSERT_EQ(loops.size(), 2UL);
+  // The last tile of an unknown extent is checked against the extent.
+  EXPECT_EQ(CountIfThenElse(sch.GetModule().GetExprs()[0]), 1UL);
+
+  MakeSplitExact(loops, extent, 8);
+  EXPECT_EQ(CountIfThenElse(sch.GetModule().GetExprs()[0]), 0UL);
+  cinn::common::cas_intervals_t var_intervals = {};
+  cinn::common::SymbolicExprAnalyzer analyzer(var_intervals);
+  EXPECT_TRUE(analyzer.ProveEQ(loops[0].As<ir::For>()->extent, extent / 8)
+                  .value_or(false));
+  EXPECT_EQ(loops[1].As<ir::For>()->extent.as_int64(), 8);
+}
+
+}  // namespace ir
+}  // namespace cinn
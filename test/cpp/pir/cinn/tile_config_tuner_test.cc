@@ -0,0 +1,155 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "paddle/cinn/hlir/dialect/operator/ir/op_dialect.h"
+#include "paddle/cinn/ir/group_schedule/config/file_database.h"
+#include "paddle/cinn/ir/group_schedule/config/group_tile_config.h"
+#include "paddle/cinn/ir/group_schedule/search/tile_config_tuner.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/pir/include/core/builtin_type.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+
+PD_DECLARE_string(cinn_tile_config_filename_label);
+
+// sum(x * x, axis=-1)
+std::shared_ptr<::pir::Program> BuildReduceProgram(int spatial_size,
+                                                   int reduce_size) {
+  ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+
+  auto program = std::make_shared<::pir::Program>(ctx);
+  ::pir::Builder builder = ::pir::Builder(ctx, program->block());
+
+  const std::vector<int64_t> shape = {spatial_size, reduce_size};
+  auto x = builder
+               .Build<paddle::dialect::DataOp>(
+                   "x", shape, phi::DataType::FLOAT32, phi::GPUPlace())
+               .result(0);
+  auto square = builder.Build<paddle::dialect::MultiplyOp>(x, x).result(0);
+  auto out =
+      builder
+          .Build<paddle::dialect::SumOp>(
+              square, std::vector<int64_t>{-1}, phi::DataType::FLOAT32, true)
+          .result(0);
+  builder.Build<paddle::dialect::FetchOp>(out, "out", 0);
+  return program;
+}
+
+/**
+ * @brief Produces the tile config database of a program offline.
+ *
+ * The program is read from the file in the CINN_TUNE_PROGRAM environment
+ * variable when it is set, which is saved by paddle.jit.save and has a single
+ * input named "x" of rank 2, otherwise a dynamic shape reduce program is
+ * built. Each bucket is tuned on the device, and the fastest config is
+ * recorded in FLAGS_cinn_tile_config_filename_label, so that running the
+ * program with FLAGS_tile_config_policy=optimal compiles it with the tuned
+ * configs.
+ */
+TEST(TileConfigTuner, TuneBuckets) {
+  std::string root_path = FLAGS_cinn_tile_config_filename_label;
+  if (root_path == "") {
+    const std::string kTestFileDir = "./tile_file_test/";
+    FLAGS_cinn_tile_config_filename_label = kTestFileDir;
+  }
+
+  std::shared_ptr<::pir::Program> program;
+  const char* program_path = std::getenv("CINN_TUNE_PROGRAM");
+  if (program_path != nullptr) {
+    ::pir::IrContext* ctx = ::pir::IrContext::Instance();
+    ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+    ctx->GetOrRegisterDialect<cinn::dialect::OperatorDialect>();
+    program = std::make_shared<::pir::Program>(ctx);
+    pir::ReadModule(program_path, program.get());
+  } else {
+    program = BuildReduceProgram(-1, -1);
+  }
+
+  // Small windows keep the test short, widen them to tune a real program.
+  std::vector<cinn::ir::BucketInfo> buckets;
+  for (int reduce_lower : {128, 1024}) {
+    cinn::ir::BucketInfo bucket_info;
+    bucket_info.space.push_back(cinn::ir::BucketInfo::Dimension{
+        64, 65, "S", /* is_dynamic = */ true});
+    bucket_info.space.push_back(cinn::ir::BucketInfo::Dimension{
+        reduce_lower, reduce_lower + 1, "R", /* is_dynamic = */ true});
+    // The configs read from the file database have the best priority.
+    bucket_info.bucket_priority = 0;
+    buckets.push_back(bucket_info);
+  }
+
+  cinn::ir::search::TileConfigTuneOptions options;
+  options.max_sampling_times = 4;
+  options.repeats = 2;
+  options.candidate_range = {{1, 8}, {1, 256}, {1, 2}, {0, 2}};
+  cinn::ir::search::TileConfigTuner tuner(program.get(), options);
+
+  cinn::ir::FileTileConfigDatabase file_database;
+  tuner.TuneAndSave(buckets, &file_database);
+
+  cinn::ir::IterSpaceType iter_space_type = {{"S", "dynamic"},
+                                             {"R", "dynamic"}};
+  cinn::ir::TileConfigMap tile_config_map = file_database.GetConfigs(
+      cinn::common::DefaultTarget(), iter_space_type);
+  for (const auto& bucket_info : buckets) {
+    ASSERT_EQ(tile_config_map.count(bucket_info), 1UL);
+    const auto& tile_config = tile_config_map.at(bucket_info);
+    // The reduce buckets never choose a config without reduce.
+    EXPECT_FALSE(std::holds_alternative<cinn::ir::NoneReduceMethod>(
+                     tile_config.reduce_method) &&
+                 tile_config.tree_reduce_num > 1);
+    EXPECT_LE(tile_config.warp_num * 32, 1024);
+  }
+}
+
+TEST(TileConfigTuner, DefaultConstraints) {
+  cinn::ir::BucketInfo spatial_bucket;
+  spatial_bucket.space.push_back(
+      cinn::ir::BucketInfo::Dimension{1, 1024, "S", true});
+  cinn::ir::BucketInfo reduce_bucket = spatial_bucket;
+  reduce_bucket.space.push_back(
+      cinn::ir::BucketInfo::Dimension{1, 1024, "R", true});
+
+  const auto IsValid = [](const cinn::ir::BucketInfo& bucket_info,
+                          const cinn::ir::search::CandidateType& candidate) {
+    for (const auto& constraint :
+         cinn::ir::search::DefaultTileConfigConstraints(bucket_info)) {
+      if (!constraint(candidate)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  // {warp_num, tree_reduce_num, spatial_inner_num, reduce_method}
+  EXPECT_TRUE(IsValid(spatial_bucket, {4, 1, 4, 0}));
+  EXPECT_FALSE(IsValid(spatial_bucket, {4, 32, 4, 1}));
+  EXPECT_TRUE(IsValid(reduce_bucket, {8, 32, 1, 1}));
+  EXPECT_TRUE(IsValid(reduce_bucket, {8, 256, 1, 2}));
+  EXPECT_FALSE(IsValid(reduce_bucket, {8, 256, 1, 1}));
+  EXPECT_FALSE(IsValid(reduce_bucket, {8, 16, 1, 2}));
+  EXPECT_FALSE(IsValid(reduce_bucket, {8, 32, 1, 0}));
+  EXPECT_FALSE(IsValid(reduce_bucket, {64, 32, 1, 1}));
+  EXPECT_FALSE(IsValid(reduce_bucket, {3, 32, 1, 1}));
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/cinn/ir/group_schedule/tactic/x86_vectorize_tactic.h"
+
+#include <gtest/gtest.h>
+
+#include "paddle/cinn/cinn.h"
+#include "paddle/cinn/ir/ir.h"
+#include "paddle/cinn/ir/schedule/ir_schedule.h"
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+
+PD_DECLARE_int32(cinn_x86_vector_bits);
+
+namespace cinn {
+namespace ir {
+
+namespace {
+
+void ApplyX86VectorizeTactic(ir::IRSchedule* sch,
+                             const std::string& block_id) {
+  ScheduleContext context;
+  context.target = common::DefaultHostTarget();
+  std::unique_ptr<ScheduleTactic> tactic = CreateX86VectorizeTactic();
+  tactic->Init(&context);
+  tactic->Apply(sch, block_id);
+}
+
+ir::IRSchedule MakeSchedule(const ir::LoweredFunc& func) {
+  ir::ModuleExpr mod_expr({func->body});
+  return ir::IRSchedule(mod_expr,
+                        -1,
+                        false,
+                        utils::ErrorMessageLevel::kGeneral,
+                        /* is_dynamic_shape = */ true);
+}
+
+}  // namespace
+
+TEST(X86VectorizeTactic, Elementwise) {
+  Context::Global().ResetNameId();
+  Placeholder<float> A("A", {Expr(32), Expr(64)});
+  ir::Tensor B = Compute(
+      {Expr(32), Expr(64)},
+      [&](Var i, Var j) { return A(i, j) * Expr(2.f); },
+      "B");
+  ast_gen_ius::TensorGroup tensor_group({A, B});
+  auto func = lang::LowerToAst("scale", {B}, &tensor_group);
+
+  for (int vector_bits : {256, 512}) {
+    FLAGS_cinn_x86_vector_bits = vector_bits;
+    ir::IRSchedule sch = MakeSchedule(func);
+    ApplyX86VectorizeTactic(&sch, "B");
+    std::vector<ir::Expr> loops = sch.GetLoops("B");
+    ASSERT_EQ(loops.size(), 2UL);
+    EXPECT_TRUE(loops[0].As<ir::For>()->is_parallel());
+    EXPECT_TRUE(loops[1].As<ir::For>()->is_vectorized());
+    EXPECT_EQ(loops[0].As<ir::For>()->extent.as_int64(),
+              32 * 64 * 32 / vector_bits);
+    EXPECT_EQ(loops[1].As<ir::For>()->extent.as_int64(), vector_bits / 32);
+  }
+  FLAGS_cinn_x86_vector_bits = -1;
+}
+
+TEST(X86VectorizeTactic, HostVectorBits) {
+  Context::Global().ResetNameId();
+  Placeholder<float> A("A", {Expr(32), Expr(64)});
+  ir::Tensor B = Compute(
+      {Expr(32), Expr(64)},
+      [&](Var i, Var j) { return A(i, j) * Expr(2.f); },
+      "B");
+  ast_gen_ius::TensorGroup tensor_group({A, B});
+  auto func = lang::LowerToAst("scale", {B}, &tensor_group);
+
+  using phi::backends::cpu::MayIUse;
+  int vector_bits = MayIUse(phi::backends::cpu::avx512f) ? 512
+                    : MayIUse(phi::backends::cpu::avx2)  ? 256
+                    : MayIUse(phi::backends::cpu::sse42) ? 128
+                                                         : 0;
+  if (vector_bits == 0) {
+    // The host CPU has no SIMD width to vectorize by.
+    return;
+  }
+  ir::IRSchedule sch = MakeSchedule(func);
+  ApplyX86VectorizeTactic(&sch, "B");
+  std::vector<ir::Expr> loops = sch.GetLoops("B");
+  ASSERT_EQ(loops.size(), 2UL);
+  EXPECT_TRUE(loops[1].As<ir::For>()->is_vectorized());
+  EXPECT_EQ(loops[1].As<ir::For>()->extent.as_int64(), vector_bits / 32);
+}
+
+TEST(X86VectorizeTactic, Reduce) {
+  Context::Global().ResetNameId();
+  Placeholder<float> A("A", {Expr(16), Expr(8), Expr(32)});
+  Var reduce_k(32, "reduce_k");
+  ir::Tensor B = Compute(
+      {Expr(16), Expr(8)},
+      [&](Var i, Var j) {
+        return lang::ReduceSum(A(i, j, reduce_k), {reduce_k});
+      },
+      "B");
+  ast_gen_ius::TensorGroup tensor_group({A, B});
+  auto func = lang::LowerToAst("reduce_sum", {B}, &tensor_group);
+
+  ir::IRSchedule sch = MakeSchedule(func);
+  ApplyX86VectorizeTactic(&sch, "B");
+  // The spatial loops are fused and run in parallel, the reduce loop is
+  // left serial.
+  std::vector<ir::Expr> loops = sch.GetLoops("B");
+  ASSERT_EQ(loops.size(), 2UL);
+  EXPECT_TRUE(loops[0].As<ir::For>()->is_parallel());
+  EXPECT_EQ(loops[0].As<ir::For>()->extent.as_int64(), 16 * 8);
+  EXPECT_TRUE(loops[1].As<ir::For>()->is_serial());
+}
+
+}  // namespace ir
+}  // namespace cinn
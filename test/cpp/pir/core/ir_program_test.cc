@@ -128,3 +128,35 @@ TEST(program_test, slice_combine_test) {
   // (8) Traverse Program
   EXPECT_EQ(program.block()->size() == 4, true);
 }
+
+TEST(program_test, operation_arena_test) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Type fp32_dtype = pir::Float32Type::get(ctx);
+  pir::OpInfo constant_info =
+      ctx->GetRegisteredOpInfo(std::string(pir::ConstantOp::name()));
+  pir::AttributeMap attr_map{{"value", pir::FloatAttribute::get(ctx, 2.0)}};
+
+  pir::Program other(ctx);
+  {
+    pir::Program program(ctx);
+    pir::OperationArenaGuard arena_guard(program.arena());
+    // more than one chunk of the arena
+    for (int i = 0; i < 2000; ++i) {
+      program.block()->push_back(
+          pir::Operation::Create({}, attr_map, {fp32_dtype}, constant_info));
+    }
+    // erased in the middle of a chunk
+    program.block()->erase(program.block()->front());
+    EXPECT_EQ(program.block()->size(), 1999u);
+
+    // an operation of the arena moved to another program
+    pir::Operation *op =
+        pir::Operation::Create({}, attr_map, {fp32_dtype}, constant_info);
+    other.block()->push_back(op);
+  }
+  // the operation outlives the program and its arena
+  EXPECT_EQ(other.block()->size(), 1u);
+  EXPECT_EQ(other.block()->front().num_results(), 1u);
+  EXPECT_EQ(other.block()->front().result(0).type(), fp32_dtype);
+}
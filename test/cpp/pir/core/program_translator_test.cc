@@ -24,10 +24,12 @@
 #include "paddle/fluid/framework/block_desc.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/framework/program_desc.h"
+#include "paddle/fluid/ir_adaptor/translator/attribute_translator.h"
 #include "paddle/fluid/ir_adaptor/translator/translate.h"
 #include "paddle/fluid/ir_adaptor/translator/utils.h"
 #include "paddle/fluid/pir/dialect/operator/ir/control_flow_op.h"
 #include "paddle/fluid/pir/dialect/operator/ir/manual_op.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_attribute.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
 #include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
 #include "paddle/phi/core/framework/framework.pb.h"
@@ -301,3 +303,28 @@ TEST(OperatorDialectTest, WhileOpProgram) {
     id++;
   }
 }
+
+TEST(AttributeTranslatorTest, Cache) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<OperatorDialect>();
+  auto &attribute_translator =
+      paddle::translator::AttributeTranslator::instance();
+
+  paddle::framework::Attribute shape = std::vector<int64_t>{2, 3, 4};
+  attribute_translator.Prefetch(shape);
+  pir::Attribute general_attr = attribute_translator(shape);
+  EXPECT_TRUE(general_attr.isa<pir::ArrayAttribute>());
+  EXPECT_EQ(general_attr, attribute_translator(shape));
+  // the same value translated by another visitor
+  pir::Attribute int_array_attr = attribute_translator(
+      "paddle::dialect::IntArrayAttribute", shape);
+  EXPECT_TRUE(int_array_attr.isa<paddle::dialect::IntArrayAttribute>());
+  EXPECT_EQ(int_array_attr,
+            attribute_translator("paddle::dialect::IntArrayAttribute", shape));
+
+  // the values of different types of the same bytes
+  paddle::framework::Attribute int_value = 1;
+  paddle::framework::Attribute float_value = 1.4e-45f;
+  EXPECT_TRUE(attribute_translator(int_value).isa<pir::Int32Attribute>());
+  EXPECT_TRUE(attribute_translator(float_value).isa<pir::FloatAttribute>());
+}
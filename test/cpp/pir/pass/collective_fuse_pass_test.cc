@@ -0,0 +1,110 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/transforms/general/collective_fuse_pass.h"
+#include "paddle/fluid/pir/utils/general_functions.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_manager.h"
+
+// Builds one c_allreduce_sum and one c_allgather per input, each followed by
+// a relu of its result. The collective of the input read_input reads the
+// result of the first allreduce.
+std::unique_ptr<pir::Program> BuildCollectiveProgram(int num_inputs,
+                                                     int read_input) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+
+  auto program = std::make_unique<pir::Program>(ctx);
+  pir::Builder builder(ctx, program->block());
+  std::vector<pir::Value> inputs;
+  for (int i = 0; i < num_inputs; ++i) {
+    inputs.push_back(builder
+                         .Build<paddle::dialect::DataOp>(
+                             "x_" + std::to_string(i),
+                             std::vector<int64_t>{4, i + 1},
+                             phi::DataType::FLOAT32,
+                             phi::CPUPlace())
+                         .result(0));
+  }
+  pir::Value first_sum;
+  for (int i = 0; i < num_inputs; ++i) {
+    pir::Value x = i == read_input ? first_sum : inputs[i];
+    auto sum =
+        builder.Build<paddle::dialect::CAllreduceSumOp>(x, 0, false, false)
+            .out();
+    if (i == 0) first_sum = sum;
+  }
+  for (int i = 0; i < num_inputs; ++i) {
+    builder.Build<paddle::dialect::CAllgatherOp>(inputs[i], 0, 2, false);
+  }
+  std::vector<pir::Operation*> collectives;
+  for (auto& op : *program->block()) {
+    if (op.num_results() > 0 && op.HasAttribute("ring_id")) {
+      collectives.push_back(&op);
+    }
+  }
+  for (auto* op : collectives) {
+    builder.Build<paddle::dialect::ReluOp>(op->result(0));
+  }
+  return program;
+}
+
+size_t CountOps(const pir::Program& program, const std::string& name) {
+  size_t count = 0;
+  for (auto& op : *program.block()) {
+    if (op.name() == name) ++count;
+  }
+  return count;
+}
+
+TEST(collective_fuse_pass, fuse) {
+  auto program = BuildCollectiveProgram(3, -1);
+  pir::PassManager pm(pir::IrContext::Instance());
+  pm.AddPass(pir::CreateCollectiveFusePass());
+  pm.Run(program.get());
+
+  EXPECT_EQ(CountOps(*program, "pd_op.c_allreduce_sum"), 1u);
+  EXPECT_EQ(CountOps(*program, "pd_op.c_allgather"), 1u);
+  // The relus read the results split back to their shapes.
+  for (auto& op : *program->block()) {
+    if (op.name() != "pd_op.relu") continue;
+    auto shape = pir::GetShapeFromValue(op.operand_source(0));
+    ASSERT_EQ(shape.size(), 2u);
+    EXPECT_TRUE(shape[0] == 4 || shape[0] == 8);
+  }
+}
+
+TEST(collective_fuse_pass, dependent_collectives) {
+  auto program = BuildCollectiveProgram(3, 2);
+  pir::PassManager pm(pir::IrContext::Instance());
+  pm.AddPass(pir::CreateCollectiveFusePass());
+  pm.Run(program.get());
+
+  // The third allreduce reads the first one, so only the first two are
+  // fused.
+  EXPECT_EQ(CountOps(*program, "pd_op.c_allreduce_sum"), 2u);
+  EXPECT_EQ(CountOps(*program, "pd_op.c_allgather"), 1u);
+}
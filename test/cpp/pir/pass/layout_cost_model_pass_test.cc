@@ -0,0 +1,151 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/transforms/general/layout_cost_model_pass.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_manager.h"
+
+COMMON_DECLARE_string(layout_cost_model_file);
+
+struct PoolProgram {
+  std::unique_ptr<pir::Program> program;
+  pir::Operation* first_pool;
+  pir::Operation* second_pool;
+  pir::Operation* fetch;
+};
+
+// data -> pool2d -> silu -> pool2d -> fetch, all in NCHW.
+PoolProgram BuildPoolProgram() {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+
+  PoolProgram result;
+  result.program = std::make_unique<pir::Program>(ctx);
+  pir::Builder builder(ctx, result.program->block());
+  auto x = builder
+               .Build<paddle::dialect::DataOp>(
+                   "x",
+                   std::vector<int64_t>{1, 4, 32, 32},
+                   phi::DataType::FLOAT32,
+                   phi::CPUPlace())
+               .result(0);
+  auto build_pool = [&](pir::Value input) {
+    return builder
+        .Build<paddle::dialect::Pool2dOp>(input,
+                                          std::vector<int64_t>{2, 2},
+                                          std::vector<int>{2, 2},
+                                          std::vector<int>{0, 0},
+                                          false,
+                                          true,
+                                          "NCHW",
+                                          "max",
+                                          false,
+                                          false,
+                                          "EXPLICIT")
+        .operation();
+  };
+  result.first_pool = build_pool(x);
+  auto silu =
+      builder.Build<paddle::dialect::SiluOp>(result.first_pool->result(0));
+  result.second_pool = build_pool(silu.result(0));
+  result.fetch = builder
+                     .Build<paddle::dialect::FetchOp>(
+                         result.second_pool->result(0), "out", 0)
+                     .operation();
+  return result;
+}
+
+size_t CountTransposeOps(const pir::Program& program) {
+  size_t count = 0;
+  for (auto& op : *program.block()) {
+    if (op.isa<paddle::dialect::TransposeOp>()) ++count;
+  }
+  return count;
+}
+
+std::string DataFormat(pir::Operation* op) {
+  return op->attribute<pir::StrAttribute>("data_format").AsString();
+}
+
+TEST(layout_cost_model_pass, calibrated_region) {
+  const std::string path = "layout_cost_model_test.txt";
+  {
+    std::ofstream fout(path);
+    fout << "# pool2d runs 100x faster in NHWC\n"
+         << "pd_op.pool2d * NCHW 1.0\n"
+         << "pd_op.pool2d * NHWC 0.01\n"
+         << "pd_op.transpose float32 * 0.1\n";
+  }
+  FLAGS_layout_cost_model_file = path;
+
+  auto pool_program = BuildPoolProgram();
+  pir::PassManager pm(pir::IrContext::Instance());
+  pm.AddPass(pir::CreateLayoutCostModelPass());
+  pm.Run(pool_program.program.get());
+  FLAGS_layout_cost_model_file = "";
+  std::remove(path.c_str());
+
+  // The whole region turns NHWC, transposing only at its two ends.
+  EXPECT_EQ(DataFormat(pool_program.first_pool), "NHWC");
+  EXPECT_EQ(DataFormat(pool_program.second_pool), "NHWC");
+  EXPECT_EQ(CountTransposeOps(*pool_program.program), 2u);
+  auto pool_out_type = pool_program.second_pool->result(0)
+                           .type()
+                           .dyn_cast<paddle::dialect::DenseTensorType>();
+  EXPECT_EQ(pool_out_type.dims(), common::make_ddim({1, 8, 8, 4}));
+  auto fetched = pool_program.fetch->operand_source(0);
+  ASSERT_TRUE(fetched.defining_op()->isa<paddle::dialect::TransposeOp>());
+  EXPECT_EQ(
+      fetched.type().dyn_cast<paddle::dialect::DenseTensorType>().dims(),
+      common::make_ddim({1, 4, 8, 8}));
+}
+
+TEST(layout_cost_model_pass, transposes_outweigh_gain) {
+  const std::string path = "layout_cost_model_test.txt";
+  {
+    std::ofstream fout(path);
+    fout << "pd_op.pool2d * NCHW 1.0\n"
+         << "pd_op.pool2d * NHWC 0.9\n"
+         << "pd_op.transpose * * 2.0\n";
+  }
+  FLAGS_layout_cost_model_file = path;
+
+  auto pool_program = BuildPoolProgram();
+  pir::PassManager pm(pir::IrContext::Instance());
+  pm.AddPass(pir::CreateLayoutCostModelPass());
+  pm.Run(pool_program.program.get());
+  FLAGS_layout_cost_model_file = "";
+  std::remove(path.c_str());
+
+  EXPECT_EQ(DataFormat(pool_program.first_pool), "NCHW");
+  EXPECT_EQ(DataFormat(pool_program.second_pool), "NCHW");
+  EXPECT_EQ(CountTransposeOps(*pool_program.program), 0u);
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/transforms/general/multi_tensor_optimizer_fuse_pass.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_manager.h"
+
+// Builds one sgd_ per parameter, all sharing a learning rate. With
+// read_first_param, a relu reads the first parameter right after its update.
+std::unique_ptr<pir::Program> BuildSgdProgram(int num_params,
+                                              bool read_first_param) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+
+  auto program = std::make_unique<pir::Program>(ctx);
+  pir::Builder builder(ctx, program->block());
+  auto data = [&](const std::string& name, std::vector<int64_t> shape) {
+    return builder
+        .Build<paddle::dialect::DataOp>(
+            name, shape, phi::DataType::FLOAT32, phi::CPUPlace())
+        .result(0);
+  };
+  auto lr = data("lr", {1});
+  for (int i = 0; i < num_params; ++i) {
+    auto param = data("param_" + std::to_string(i), {4, 8});
+    auto grad = data("grad_" + std::to_string(i), {4, 8});
+    builder.Build<paddle::dialect::Sgd_Op>(
+        param, lr, grad, pir::Value(), false);
+    if (read_first_param && i == 0) {
+      builder.Build<paddle::dialect::ReluOp>(param);
+    }
+  }
+  return program;
+}
+
+size_t CountOps(const pir::Program& program, const std::string& name) {
+  size_t count = 0;
+  for (auto& op : *program.block()) {
+    if (op.name() == name) ++count;
+  }
+  return count;
+}
+
+TEST(multi_tensor_optimizer_fuse_pass, sgd) {
+  auto program = BuildSgdProgram(3, false);
+  pir::PassManager pm(pir::IrContext::Instance());
+  pm.AddPass(pir::CreateMultiTensorOptimizerFusePass());
+  pm.Run(program.get());
+
+  EXPECT_EQ(CountOps(*program, "pd_op.sgd_"), 0u);
+  EXPECT_EQ(CountOps(*program, "pd_op.merged_sgd_"), 1u);
+}
+
+TEST(multi_tensor_optimizer_fuse_pass, read_between_updates) {
+  auto program = BuildSgdProgram(3, true);
+  pir::PassManager pm(pir::IrContext::Instance());
+  pm.AddPass(pir::CreateMultiTensorOptimizerFusePass());
+  pm.Run(program.get());
+
+  // The relu must see the first update, so only the other two are fused.
+  EXPECT_EQ(CountOps(*program, "pd_op.sgd_"), 1u);
+  EXPECT_EQ(CountOps(*program, "pd_op.merged_sgd_"), 1u);
+}
@@ -13,12 +13,18 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
 #include "glog/logging.h"
 
 // NOTE(zhangbo9674): File pd_op.h is generated by op_gen.py, see details in
 // paddle/fluid/pir/dialect/CMakeLists.txt.
 #include "paddle/common/errors.h"
+#include "paddle/common/startup_trace.h"
 #include "paddle/fluid/pir/dialect/operator/interface/op_yaml_info.h"
+#include "paddle/fluid/pir/dialect/operator/ir/control_flow_op.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
 #include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
@@ -32,6 +38,8 @@
 #include "paddle/pir/include/core/ir_context.h"
 #include "paddle/pir/include/core/op_base.h"
 #include "paddle/pir/include/core/operation.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_dialect.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
 #include "paddle/pir/include/pass/pass.h"
 #include "paddle/pir/include/pass/pass_manager.h"
 #include "test/cpp/pir/tools/macros_utils.h"
@@ -223,6 +231,48 @@ class TestPass : public pir::Pass {
   }
 };
 
+struct BuildCountAnalysis {
+  explicit BuildCountAnalysis(pir::Operation *op) { ++build_num; }
+  static int build_num;
+};
+int BuildCountAnalysis::build_num = 0;
+
+IR_DECLARE_EXPLICIT_TEST_TYPE_ID(BuildCountAnalysis)
+IR_DEFINE_EXPLICIT_TYPE_ID(BuildCountAnalysis)
+
+// Depends on BuildCountAnalysis, so it is invalidated with it.
+struct DependentAnalysis {
+  DependentAnalysis(pir::Operation *op, pir::AnalysisManager &am) {  // NOLINT
+    am.GetAnalysis<BuildCountAnalysis>();
+  }
+  bool IsInvalidated(const pir::detail::PreservedAnalyses &pa) {
+    return !pa.IsPreserved<DependentAnalysis>() ||
+           !pa.IsPreserved<BuildCountAnalysis>();
+  }
+};
+
+IR_DECLARE_EXPLICIT_TEST_TYPE_ID(DependentAnalysis)
+IR_DEFINE_EXPLICIT_TYPE_ID(DependentAnalysis)
+
+class QueryAnalysisPass : public pir::Pass {
+ public:
+  QueryAnalysisPass(const std::string &name, bool preserve)
+      : pir::Pass(name, 1), preserve_(preserve) {}
+  void Run(pir::Operation *op) override {
+    analysis_manager().GetAnalysis<BuildCountAnalysis>();
+    if (preserve_) {
+      pass_state()->preserved_analyses.PreserveAll();
+    }
+  }
+
+  bool CanApplyOn(pir::Operation *op) const override {
+    return op->isa<::pir::ModuleOp>() && op->num_regions() > 0;
+  }
+
+ private:
+  bool preserve_;
+};
+
 void BuildProgram(pir::Builder &builder) {  // NOLINT
   paddle::dialect::FullOp full_input_op =
       builder.Build<paddle::dialect::FullOp>(std::vector<int64_t>{4, 3, 16, 16},
@@ -312,3 +362,160 @@ TEST(pass_manager, PassManager) {
       true,
       common::errors::InvalidArgument("Program not run. Expected run."));
 }
+
+TEST(pass_manager, AnalysisCache) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder = pir::Builder(ctx, program.block());
+  BuildProgram(builder);
+
+  // The analysis is built once and reused until a pass that does not
+  // preserve it runs.
+  BuildCountAnalysis::build_num = 0;
+  pir::PassManager pm(ctx);
+  pm.AddPass(std::make_unique<QueryAnalysisPass>("preserve_pass_1", true));
+  pm.AddPass(std::make_unique<QueryAnalysisPass>("preserve_pass_2", true));
+  pm.AddPass(std::make_unique<QueryAnalysisPass>("change_pass", false));
+  pm.AddPass(std::make_unique<QueryAnalysisPass>("preserve_pass_3", true));
+  pm.EnablePassTiming(true);
+  EXPECT_TRUE(pm.Run(&program));
+  EXPECT_EQ(BuildCountAnalysis::build_num, 2);
+
+  pir::AnalysisManagerHolder holder(program.module_op(), nullptr);
+  pir::AnalysisManager am = holder;
+  am.GetAnalysis<DependentAnalysis>();
+  EXPECT_TRUE(am.GetCachedAnalysis<BuildCountAnalysis>().has_value());
+  pir::detail::PreservedAnalyses pa;
+  pa.Preserve<DependentAnalysis>();
+  am.Invalidate(pa);
+  EXPECT_FALSE(am.GetCachedAnalysis<BuildCountAnalysis>().has_value());
+  EXPECT_FALSE(am.GetCachedAnalysis<DependentAnalysis>().has_value());
+}
+
+TEST(pass_manager, StartupTrace) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder = pir::Builder(ctx, program.block());
+  BuildProgram(builder);
+
+  pir::PassManager pm(ctx);
+  pm.AddPass(std::make_unique<QueryAnalysisPass>("traced_pass", true));
+  // No phase is recorded out of a session.
+  EXPECT_TRUE(pm.Run(&program));
+
+  auto &trace = common::StartupTrace::Instance();
+  size_t begin = trace.Begin();
+  EXPECT_TRUE(pm.Run(&program));
+  auto events = trace.End(begin);
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].category, "PirPass");
+  EXPECT_EQ(events[0].name, "traced_pass");
+  EXPECT_LE(events[0].start_ns, events[0].end_ns);
+
+  std::string json = common::StartupTrace::ToChromeTrace(events);
+  EXPECT_NE(json.find("\"name\": \"traced_pass\""), std::string::npos);
+  EXPECT_NE(json.find("\"cat\": \"PirPass\""), std::string::npos);
+  std::string summary = common::StartupTrace::Summary(events);
+  EXPECT_NE(summary.find("PirPass / traced_pass"), std::string::npos);
+  EXPECT_FALSE(common::StartupTrace::IsRecording());
+}
+
+// Counts the ops nested in the if ops, the if ops are isolated so that they
+// are visited by several threads.
+class ParallelCountPass : public pir::Pass {
+ public:
+  ParallelCountPass() : pir::Pass("ParallelCountPass", 1) {}
+  void Run(pir::Operation *op) override {
+    for (auto &region : *op) {
+      for (auto &block : region) {
+        op_num += block.size();
+      }
+    }
+    thread_ids.Insert(std::this_thread::get_id());
+    pass_state()->preserved_analyses.PreserveAll();
+  }
+
+  bool CanApplyOn(pir::Operation *op) const override {
+    return op->isa<paddle::dialect::IfOp>();
+  }
+
+  bool CanRunInParallel() const override { return true; }
+
+  struct ThreadIds {
+    void Insert(std::thread::id id) {
+      std::lock_guard<std::mutex> guard(mutex);
+      ids.insert(id);
+    }
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+  };
+
+  static std::atomic<size_t> op_num;
+  static ThreadIds thread_ids;
+};
+std::atomic<size_t> ParallelCountPass::op_num{0};
+ParallelCountPass::ThreadIds ParallelCountPass::thread_ids;
+
+TEST(pass_manager, ParallelExecution) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::ControlFlowDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  auto cond = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{1}, true, phi::DataType::BOOL);
+  constexpr size_t kIfNum = 16;
+  for (size_t i = 0; i < kIfNum; ++i) {
+    builder.SetInsertionPointToBlockEnd(program.block());
+    auto if_op = builder.Build<paddle::dialect::IfOp>(
+        cond.out(), std::vector<pir::Type>{builder.bool_type()});
+    for (auto *block : {&if_op.true_block(), &if_op.false_block()}) {
+      builder.SetInsertionPointToStart(block);
+      auto full = builder.Build<paddle::dialect::FullOp>(
+          std::vector<int64_t>{2}, true, phi::DataType::BOOL);
+      builder.Build<pir::YieldOp>(std::vector<pir::Value>{full.out()});
+    }
+  }
+
+  ParallelCountPass::op_num = 0;
+  pir::PassManager pm(ctx);
+  pm.AddPass(std::make_unique<ParallelCountPass>());
+  pm.EnableParallelExecution(4);
+  EXPECT_TRUE(pm.Run(&program));
+  // Two ops in each of the two blocks of the if ops.
+  EXPECT_EQ(ParallelCountPass::op_num, kIfNum * 4);
+  EXPECT_GE(ParallelCountPass::thread_ids.ids.size(), 1u);
+  EXPECT_LE(ParallelCountPass::thread_ids.ids.size(), 4u);
+}
+
+TEST(pass_manager, ConcurrentTypeStorage) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  // The threads create the same parametric types at the same time, each of
+  // them is stored once.
+  std::vector<std::vector<pir::Type>> types(4);
+  std::vector<std::thread> threads;
+  for (auto &thread_types : types) {
+    threads.emplace_back([&thread_types, ctx]() {
+      for (int64_t i = 1; i <= 64; ++i) {
+        phi::DDim dims = {i, 1000};
+        thread_types.push_back(
+            pir::DenseTensorType::get(ctx,
+                                      pir::Float32Type::get(ctx),
+                                      dims,
+                                      phi::DataLayout::NCHW,
+                                      phi::LoD(),
+                                      0));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &thread_types : types) {
+    EXPECT_EQ(thread_types, types[0]);
+  }
+}
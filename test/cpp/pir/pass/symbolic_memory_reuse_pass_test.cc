@@ -0,0 +1,106 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/transforms/general/symbolic_memory_reuse_pass.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/ir_context.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/dialect/shape/ir/shape_dialect.h"
+#include "paddle/pir/include/pass/pass.h"
+#include "paddle/pir/include/pass/pass_manager.h"
+
+std::vector<int64_t> GetShareIds(pir::Operation* op) {
+  auto attr = op->attribute<pir::ArrayAttribute>(kAttrBufferShareIds);
+  std::vector<int64_t> ids;
+  if (!attr) {
+    return ids;
+  }
+  for (size_t i = 0; i < attr.size(); ++i) {
+    ids.push_back(attr.at(i).dyn_cast<pir::Int64Attribute>().data());
+  }
+  return ids;
+}
+
+TEST(symbolic_memory_reuse_pass, dynamic_shape_chain) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  ctx->GetOrRegisterDialect<pir::shape::ShapeDialect>();
+
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+  auto x = builder
+               .Build<paddle::dialect::DataOp>("x",
+                                               std::vector<int64_t>{-1, 16},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  auto exp1 = builder.Build<paddle::dialect::ExpOp>(x);
+  auto relu1 = builder.Build<paddle::dialect::ReluOp>(exp1.result(0));
+  auto exp2 = builder.Build<paddle::dialect::ExpOp>(relu1.result(0));
+  auto relu2 = builder.Build<paddle::dialect::ReluOp>(exp2.result(0));
+  builder.Build<paddle::dialect::FetchOp>(relu2.result(0), "out", 0);
+
+  pir::PassManager pm(ctx);
+  pm.AddPass(pir::CreateSymbolicMemoryReusePass());
+  pm.Run(&program);
+
+  // exp1 is dead when exp2 runs and has the same [S0, 16] shape, relu1 and
+  // relu2 overlap with exp2, and relu2 is fetched.
+  auto exp1_ids = GetShareIds(exp1.operation());
+  auto exp2_ids = GetShareIds(exp2.operation());
+  ASSERT_EQ(exp1_ids.size(), 1u);
+  ASSERT_EQ(exp2_ids.size(), 1u);
+  EXPECT_GE(exp1_ids[0], 0);
+  EXPECT_EQ(exp1_ids[0], exp2_ids[0]);
+  EXPECT_TRUE(GetShareIds(relu1.operation()).empty());
+  EXPECT_TRUE(GetShareIds(relu2.operation()).empty());
+}
+
+TEST(symbolic_memory_reuse_pass, inplace_user) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  ctx->GetOrRegisterDialect<pir::shape::ShapeDialect>();
+
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+  auto x = builder
+               .Build<paddle::dialect::DataOp>("x",
+                                               std::vector<int64_t>{-1, 16},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  auto exp1 = builder.Build<paddle::dialect::ExpOp>(x);
+  // relu_ writes the buffer of exp1, which stays alive with its output.
+  auto relu1 = builder.Build<paddle::dialect::Relu_Op>(exp1.result(0));
+  auto exp2 = builder.Build<paddle::dialect::ExpOp>(relu1.result(0));
+  auto exp3 = builder.Build<paddle::dialect::ExpOp>(exp2.result(0));
+  builder.Build<paddle::dialect::FetchOp>(exp3.result(0), "out", 0);
+
+  pir::PassManager pm(ctx);
+  pm.AddPass(pir::CreateSymbolicMemoryReusePass());
+  pm.Run(&program);
+
+  EXPECT_TRUE(GetShareIds(exp1.operation()).empty());
+  EXPECT_TRUE(GetShareIds(exp3.operation()).empty());
+}
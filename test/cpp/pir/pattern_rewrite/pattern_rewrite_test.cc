@@ -431,6 +431,35 @@ TEST(pattern_rewrite, Patterns) {
   EXPECT_EQ(program.block()->size(), 17u);
 }
 
+TEST(pattern_rewrite, IncrementalWorklist) {
+  pir::IrContext *ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+
+  auto RunRewrite = [&](bool use_incremental_worklist) {
+    pir::Program program(ctx);
+    pir::Builder builder = pir::Builder(ctx, program.block());
+    BuildProgram(builder);
+    pir::RewritePatternSet ps(ctx);
+    ps.Add<RedundantTransposeFusePattern>(ctx);
+    pir::FrozenRewritePatternSet patterns(std::move(ps));
+    pir::GreedyRewriteConfig config;
+    config.use_top_down_traversal = true;
+    config.use_incremental_worklist = use_incremental_worklist;
+    auto [converged, num_rewrites] =
+        pir::ApplyPatternsGreedily(program.module_op(), patterns, config);
+    EXPECT_TRUE(converged);
+    return std::make_pair(program.block()->size(), num_rewrites);
+  };
+
+  // Only revisiting the changed ops reaches the same program as scanning the
+  // whole program until no pattern applies.
+  auto full_scan = RunRewrite(false);
+  auto incremental = RunRewrite(true);
+  EXPECT_GT(full_scan.second, 0);
+  EXPECT_EQ(incremental.first, full_scan.first);
+}
+
 void BuildConstantFoldingProgram(pir::Program *program,
                                  pir::IrContext *ctx,
                                  paddle::framework::Scope *scope) {
@@ -0,0 +1,95 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_program.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/operation.h"
+#include "paddle/pir/include/core/program.h"
+
+namespace {
+
+void BuildProgram(pir::IrContext* ctx, pir::Program* program) {
+  pir::Builder builder = pir::Builder(ctx, program->block());
+  auto x = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{4, 16}, 1.5, phi::DataType::FLOAT32);
+  auto y = builder.Build<paddle::dialect::FullOp>(
+      std::vector<int64_t>{4, 16}, 2.0, phi::DataType::FLOAT32);
+  auto w = builder.Build<pir::ParameterOp>("w", x.out().type());
+  w->set_attribute("persistable",
+                   pir::ArrayAttribute::get(
+                       ctx, {pir::BoolAttribute::get(ctx, true)}));
+  auto add = builder.Build<paddle::dialect::AddOp>(x.out(), y.out());
+  auto mul = builder.Build<paddle::dialect::MultiplyOp>(add.out(), w.result(0));
+  builder.Build<paddle::dialect::FetchOp>(mul.out(), "out", 0);
+}
+
+}  // namespace
+
+TEST(BinaryProgramTest, save_load) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  BuildProgram(ctx, &program);
+
+  pir::WriteBinaryModule(program, "./binary_program", 1, true);
+  EXPECT_TRUE(pir::IsBinaryProgramFile("./binary_program"));
+
+  pir::Program new_program(ctx);
+  EXPECT_TRUE(pir::ReadModule("./binary_program", &new_program, 1));
+  EXPECT_EQ(new_program.block()->size(), program.block()->size());
+  auto it = program.block()->begin();
+  for (auto& new_op : *new_program.block()) {
+    EXPECT_EQ(new_op.name(), it->name());
+    EXPECT_EQ(new_op.num_operands(), it->num_operands());
+    for (uint32_t i = 0; i < new_op.num_results(); ++i) {
+      EXPECT_EQ(new_op.result(i).type(), it->result(i).type());
+    }
+    for (auto& attr : new_op.attributes()) {
+      EXPECT_EQ(attr.second, it->attribute(attr.first));
+    }
+    ++it;
+  }
+  // The operands are connected to the values of the loaded program.
+  pir::Operation& fetch_op = new_program.block()->back();
+  EXPECT_EQ(fetch_op.operand_source(0).defining_op()->name(),
+            paddle::dialect::MultiplyOp::name());
+
+  // A binary program is only loaded by the version which saves it.
+  pir::Program other_version(ctx);
+  EXPECT_ANY_THROW(pir::ReadModule("./binary_program", &other_version, 2));
+}
+
+TEST(BinaryProgramTest, truncated_file) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Program program(ctx);
+  BuildProgram(ctx, &program);
+
+  pir::BinaryProgramWriter writer(1, true);
+  std::string data = writer.Write(&program);
+  for (size_t size : {size_t{16}, data.size() / 2, data.size() - 1}) {
+    pir::Program new_program(ctx);
+    EXPECT_ANY_THROW({
+      pir::BinaryProgramReader truncated(data.data(), size);
+      truncated.RecoverProgram(&new_program);
+    });
+  }
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+
+#include "paddle/fluid/framework/lod_tensor.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/flat_params.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/memory/allocation/allocator_facade.h"
+
+TEST(FlatParamsFile, SaveAndRead) {
+  phi::CPUContext ctx;
+  ctx.SetAllocator(paddle::memory::allocation::AllocatorFacade::Instance()
+                       .GetAllocator(phi::CPUPlace())
+                       .get());
+  phi::DenseTensor w, b;
+  w.Resize({2, 3});
+  float* w_data = w.mutable_data<float>(phi::CPUPlace());
+  for (int i = 0; i < 6; ++i) w_data[i] = static_cast<float>(i);
+  b.Resize({5});
+  int64_t* b_data = b.mutable_data<int64_t>(phi::CPUPlace());
+  for (int i = 0; i < 5; ++i) b_data[i] = i * 10;
+
+  const std::string path = "flat_params_test.pdiparams";
+  pir::FlatParamsFile::Save({&w, &b}, {"w", "b"}, path, true);
+  EXPECT_TRUE(pir::FlatParamsFile::Match(path));
+
+  {
+    pir::FlatParamsFile file(path);
+    ASSERT_EQ(file.names(), std::vector<std::string>({"w", "b"}));
+    phi::DenseTensor w_out, b_out;
+    file.Read("w", &w_out, ctx);
+    file.Read("b", &b_out, ctx);
+    EXPECT_EQ(w_out.dims(), w.dims());
+    EXPECT_EQ(b_out.dtype(), phi::DataType::INT64);
+    // The tensors point into the mapping, at aligned offsets.
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(w_out.data()) % 64, 0U);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b_out.data()) % 64, 0U);
+    for (int i = 0; i < 6; ++i) {
+      EXPECT_EQ(w_out.data<float>()[i], w_data[i]);
+    }
+    for (int i = 0; i < 5; ++i) {
+      EXPECT_EQ(b_out.data<int64_t>()[i], b_data[i]);
+    }
+    // The mapping is private and outlives the file.
+    w_out.data<float>()[0] = 100.0f;
+    phi::DenseTensor missing;
+    EXPECT_ANY_THROW(file.Read("missing", &missing, ctx));
+  }
+  pir::FlatParamsFile file(path);
+  phi::DenseTensor w_out;
+  file.Read("w", &w_out, ctx);
+  EXPECT_EQ(w_out.data<float>()[0], 0.0f);
+  std::remove(path.c_str());
+}
+
+TEST(FlatParamsFile, NotMatchCombinedParams) {
+  phi::CPUContext ctx;
+  ctx.SetAllocator(paddle::memory::allocation::AllocatorFacade::Instance()
+                       .GetAllocator(phi::CPUPlace())
+                       .get());
+  phi::DenseTensor w;
+  w.Resize({2});
+  w.mutable_data<float>(phi::CPUPlace())[0] = 1.0f;
+  const std::string path = "flat_params_test_combined.pdiparams";
+  {
+    std::ofstream fout(path, std::ios::binary);
+    paddle::framework::SerializeToStream(fout, w, ctx);
+  }
+  EXPECT_FALSE(pir::FlatParamsFile::Match(path));
+  std::remove(path.c_str());
+}
@@ -787,6 +787,38 @@ TEST(Tensor, RunWithExternalStream) {
   LOG(INFO) << "output size: " << size / sizeof(float);
   predictor->TryShrinkMemory();
 }
+
+TEST(Predictor, GpuTenant) {
+  int least_priority = 0;
+  int greatest_priority = 0;
+  cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority);
+
+  Config config;
+  config.SetModel(FLAGS_dirname);
+  config.EnableUseGpu(100, 0);
+  config.SetGpuTenant("latency_critical", greatest_priority - 1, 1024);
+  auto predictor = CreatePredictor(config);
+  gpuStream_t stream =
+      reinterpret_cast<gpuStream_t>(predictor->GetExecStream());
+  ASSERT_NE(stream, nullptr);
+  EXPECT_EQ(paddle::ResourceManager::Instance().RefCount(stream), 1);
+  // The priority is clamped to the range of the device.
+  int priority = 0;
+  cudaStreamGetPriority(stream, &priority);
+  EXPECT_EQ(priority, greatest_priority);
+
+  auto *tenant = paddle::ResourceManager::Instance()
+                     .GetGPUResource(stream)
+                     ->Tenant();
+  ASSERT_NE(tenant, nullptr);
+  EXPECT_EQ(tenant->Name(), "latency_critical");
+  EXPECT_EQ(tenant->MemoryLimit(), size_t(1024) << 20);
+  const size_t used = tenant->MemoryUsed(0);
+  tenant->Acquire(0, tenant->MemoryLimit() - used);
+  EXPECT_THROW(tenant->Acquire(0, 1), common::enforce::EnforceNotMet);
+  tenant->Release(0, tenant->MemoryLimit() - used);
+  EXPECT_EQ(tenant->MemoryUsed(0), used);
+}
 #endif
 
 TEST(AnalysisPredictor, OutputTensorHookFunc) {
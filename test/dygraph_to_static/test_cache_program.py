@@ -130,6 +130,33 @@ class TestCacheProgramWithOptimizer(Dy2StTestBase):
         )
 
 
+class TestCacheProgramByGuard(Dy2StTestBase):
+    @test_ast_only
+    def test_guard(self):
+        static_net = paddle.jit.to_static(Linear())
+        program_cache = static_net.forward.program_cache
+        x = paddle.to_tensor(np.random.random((4, 10)).astype('float32'))
+        out = static_net(x)
+        for _ in range(3):
+            np.testing.assert_allclose(
+                static_net(paddle.assign(x))[0].numpy(), out[0].numpy()
+            )
+        self.assertEqual(len(program_cache), 1)
+        self.assertEqual(program_cache._guard_cache.hits, 3)
+
+        # a new shape or stop_gradient is another call to trace
+        static_net(paddle.randn([2, 10]))
+        x.stop_gradient = False
+        static_net(x)
+        self.assertEqual(len(program_cache), 3)
+        self.assertEqual(len(program_cache._guard_cache), 3)
+        static_net(x)
+        self.assertEqual(program_cache._guard_cache.hits, 4)
+
+        program_cache.clear()
+        self.assertEqual(len(program_cache._guard_cache), 0)
+
+
 def simple_func(x):
     inputs = paddle.assign(x)
     mean = paddle.mean(inputs)
@@ -0,0 +1,134 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+
+
+def rand_tensor(shape, dtype):
+    x = np.random.rand(*shape)
+    if dtype.startswith('complex'):
+        x = x + 1j * np.random.rand(*shape)
+    return paddle.to_tensor(x.astype(dtype), place=paddle.CUDAPlace(0))
+
+
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda(),
+    "The FFT plan cache only exists on GPUs",
+)
+class TestFFTPlanCache(unittest.TestCase):
+    def setUp(self):
+        paddle.disable_static()
+        paddle.fft.clear_plan_cache(0)
+        self.max_size = paddle.fft.plan_cache_info(0)['max_size']
+
+    def tearDown(self):
+        paddle.fft.set_plan_cache_max_size(self.max_size, 0)
+        paddle.fft.clear_plan_cache(0)
+
+    def assert_counts(self, before, hits, misses):
+        info = paddle.fft.plan_cache_info(0)
+        self.assertEqual(info['hits'] - before['hits'], hits)
+        self.assertEqual(info['misses'] - before['misses'], misses)
+
+    def test_lookup_counts(self):
+        x = rand_tensor([6, 32], 'complex64')
+        before = paddle.fft.plan_cache_info(0)
+        self.assertEqual(before['size'], 0)
+        paddle.fft.fft(x, axis=1)
+        self.assert_counts(before, hits=0, misses=1)
+        self.assertEqual(paddle.fft.plan_cache_info(0)['size'], 1)
+        paddle.fft.ifft(x, axis=1)
+        self.assert_counts(before, hits=1, misses=1)
+
+    def test_warmup_c2c(self):
+        # more than 3 axes are transformed in 2 plans
+        shape = [2, 4, 8, 16]
+        paddle.fft.warmup_plan_cache(shape, transform='c2c', dtype='complex64')
+        self.assertEqual(paddle.fft.plan_cache_info(0)['size'], 2)
+        before = paddle.fft.plan_cache_info(0)
+        paddle.fft.fftn(rand_tensor(shape, 'complex64'))
+        self.assert_counts(before, hits=2, misses=0)
+
+    def test_warmup_r2c(self):
+        shape = [3, 40]
+        paddle.fft.warmup_plan_cache(
+            shape, axes=[-1], transform='r2c', dtype='float32'
+        )
+        before = paddle.fft.plan_cache_info(0)
+        paddle.fft.rfft(rand_tensor(shape, 'float32'))
+        self.assert_counts(before, hits=1, misses=0)
+
+        # axes starting with (0, 1) are split into an r2c and a c2c plan
+        shape = [8, 16, 3]
+        paddle.fft.warmup_plan_cache(
+            shape, axes=[0, 1], transform='r2c', dtype='float64'
+        )
+        before = paddle.fft.plan_cache_info(0)
+        paddle.fft.rfft2(rand_tensor(shape, 'float64'), axes=(0, 1))
+        self.assert_counts(before, hits=2, misses=0)
+
+    def test_warmup_c2r(self):
+        shape = [5, 17]
+        paddle.fft.warmup_plan_cache(
+            shape, axes=[1], transform='c2r', dtype='complex64'
+        )
+        before = paddle.fft.plan_cache_info(0)
+        out = paddle.fft.irfft(rand_tensor(shape, 'complex64'))
+        self.assertEqual(out.shape, [5, 32])
+        self.assert_counts(before, hits=1, misses=0)
+
+        shape = [5, 16]
+        paddle.fft.warmup_plan_cache(
+            shape,
+            axes=[1],
+            transform='c2r',
+            dtype='complex128',
+            last_dim_size=30,
+        )
+        before = paddle.fft.plan_cache_info(0)
+        paddle.fft.irfft(rand_tensor(shape, 'complex128'), n=30)
+        self.assert_counts(before, hits=1, misses=0)
+
+    def test_max_size_and_clear(self):
+        paddle.fft.set_plan_cache_max_size(2, 0)
+        self.assertEqual(paddle.fft.plan_cache_info(0)['max_size'], 2)
+        for n in [8, 16, 32]:
+            paddle.fft.fft(rand_tensor([4, n], 'complex64'))
+        self.assertEqual(paddle.fft.plan_cache_info(0)['size'], 2)
+
+        # the least recently used plan, of n == 8, was evicted
+        before = paddle.fft.plan_cache_info(0)
+        paddle.fft.fft(rand_tensor([4, 8], 'complex64'))
+        self.assert_counts(before, hits=0, misses=1)
+
+        paddle.fft.clear_plan_cache(0)
+        self.assertEqual(paddle.fft.plan_cache_info(0)['size'], 0)
+
+    def test_invalid_warmup(self):
+        with self.assertRaises(ValueError):
+            paddle.fft.warmup_plan_cache([4, 8], transform='r2r')
+        with self.assertRaises(ValueError):
+            paddle.fft.warmup_plan_cache(
+                [4, 8], transform='c2c', dtype='float32'
+            )
+        with self.assertRaises(ValueError):
+            paddle.fft.warmup_plan_cache([4, 8], axes=[2])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,81 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import tempfile
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.inference import Config, create_predictor
+
+
+class TestNet(paddle.nn.Layer):
+    def __init__(self):
+        super().__init__()
+        self.fc1 = paddle.nn.Linear(32, 64)
+        self.fc2 = paddle.nn.Linear(64, 8)
+
+    def forward(self, x):
+        return self.fc2(paddle.nn.functional.relu(self.fc1(x)))
+
+
+class TestCpuThreadAffinity(unittest.TestCase):
+    def setUp(self):
+        self.temp_dir = tempfile.TemporaryDirectory()
+        self.model_prefix = os.path.join(self.temp_dir.name, 'model')
+        paddle.seed(2026)
+        with paddle.pir_utils.DygraphPirGuard():
+            model = paddle.jit.to_static(
+                TestNet(),
+                input_spec=[
+                    paddle.static.InputSpec(
+                        shape=[None, 32], dtype='float32', name='x'
+                    )
+                ],
+                full_graph=True,
+            )
+            paddle.jit.save(model, self.model_prefix)
+
+    def tearDown(self):
+        self.temp_dir.cleanup()
+
+    def create_predictor(self, cores):
+        config = Config(
+            self.model_prefix + '.json', self.model_prefix + '.pdiparams'
+        )
+        config.disable_gpu()
+        config.enable_new_ir()
+        config.enable_new_executor()
+        if cores:
+            config.set_cpu_thread_affinity(cores)
+            self.assertEqual(config.cpu_thread_affinity(), cores)
+        return create_predictor(config)
+
+    def test_output(self):
+        x = np.random.random([4, 32]).astype('float32')
+        expected = self.create_predictor([]).run([paddle.to_tensor(x)])[0]
+        cores = list(range(min(2, os.cpu_count())))
+        predictor = self.create_predictor(cores)
+        clone = predictor.clone()
+        for p in [predictor, clone]:
+            actual = p.run([paddle.to_tensor(x)])[0]
+            np.testing.assert_allclose(
+                expected.numpy(), actual.numpy(), rtol=1e-5, atol=1e-6
+            )
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,167 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import tempfile
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.inference import Config, create_predictor
+
+
+class LinearNet(paddle.nn.Layer):
+    def __init__(self, out_features=4):
+        super().__init__()
+        self.fc1 = paddle.nn.Linear(4, out_features)
+        self.fc2 = paddle.nn.Linear(out_features, 4)
+
+    def forward(self, x):
+        return self.fc2(paddle.nn.functional.relu(self.fc1(x)))
+
+
+class ConvBNNet(paddle.nn.Layer):
+    def __init__(self):
+        super().__init__()
+        self.conv = paddle.nn.Conv2D(3, 4, 3, bias_attr=False)
+        self.bn = paddle.nn.BatchNorm2D(4)
+
+    def forward(self, x):
+        return self.bn(self.conv(x))
+
+
+class TestUpdateParameters(unittest.TestCase):
+    def setUp(self):
+        self.temp_dir = tempfile.TemporaryDirectory()
+        self.x = np.random.random([2, 4]).astype('float32')
+
+    def tearDown(self):
+        self.temp_dir.cleanup()
+
+    def save(self, name, seed, net_class, shape, dtype='float32', **kwargs):
+        # The same unique names give the parameters the same names in every
+        # saved model.
+        with paddle.pir_utils.DygraphPirGuard():
+            with paddle.utils.unique_name.guard():
+                paddle.seed(seed)
+                net = net_class(**kwargs)
+            if dtype != 'float32':
+                net.to(dtype=dtype)
+            net.eval()
+            model = paddle.jit.to_static(
+                net,
+                input_spec=[
+                    paddle.static.InputSpec(shape=shape, dtype=dtype, name='x')
+                ],
+                full_graph=True,
+            )
+            prefix = os.path.join(self.temp_dir.name, name, 'inference')
+            paddle.jit.save(model, prefix)
+        return prefix
+
+    def create_predictor(self, prefix, ir_optim=False):
+        config = Config(prefix + '.json', prefix + '.pdiparams')
+        if paddle.is_compiled_with_cuda():
+            config.enable_use_gpu(256, 0)
+        else:
+            config.disable_gpu()
+        config.switch_ir_optim(ir_optim)
+        config.enable_new_executor()
+        config.enable_new_ir()
+        return create_predictor(config)
+
+    def run(self, predictor, x):
+        input_handle = predictor.get_input_handle(
+            predictor.get_input_names()[0]
+        )
+        input_handle.reshape(x.shape)
+        input_handle.copy_from_cpu(x)
+        predictor.run()
+        output_handle = predictor.get_output_handle(
+            predictor.get_output_names()[0]
+        )
+        return output_handle.copy_to_cpu()
+
+    def test_update_changes_outputs(self):
+        old = self.save('old', 1, LinearNet, [None, 4])
+        new = self.save('new', 2, LinearNet, [None, 4])
+        predictor = self.create_predictor(old)
+        old_out = self.run(predictor, self.x)
+        new_out = self.run(self.create_predictor(new), self.x)
+        self.assertFalse(np.allclose(old_out, new_out))
+
+        self.assertTrue(predictor.update_parameters(new + '.pdiparams'))
+        np.testing.assert_allclose(
+            self.run(predictor, self.x), new_out, rtol=1e-5, atol=1e-6
+        )
+        # And back.
+        self.assertTrue(predictor.update_parameters(old + '.pdiparams'))
+        np.testing.assert_allclose(
+            self.run(predictor, self.x), old_out, rtol=1e-5, atol=1e-6
+        )
+
+    def test_clones_see_new_parameters(self):
+        old = self.save('old', 1, LinearNet, [None, 4])
+        new = self.save('new', 2, LinearNet, [None, 4])
+        predictor = self.create_predictor(old)
+        clone = predictor.clone()
+        self.run(clone, self.x)
+        new_out = self.run(self.create_predictor(new), self.x)
+
+        self.assertTrue(predictor.update_parameters(new + '.pdiparams'))
+        np.testing.assert_allclose(
+            self.run(clone, self.x), new_out, rtol=1e-5, atol=1e-6
+        )
+        # A clone made after the update also runs with the new parameters.
+        np.testing.assert_allclose(
+            self.run(predictor.clone(), self.x),
+            new_out,
+            rtol=1e-5,
+            atol=1e-6,
+        )
+
+    def test_refuse_dims_mismatch(self):
+        old = self.save('old', 1, LinearNet, [None, 4])
+        wider = self.save('wider', 2, LinearNet, [None, 4], out_features=8)
+        predictor = self.create_predictor(old)
+        old_out = self.run(predictor, self.x)
+
+        self.assertFalse(predictor.update_parameters(wider + '.pdiparams'))
+        np.testing.assert_allclose(self.run(predictor, self.x), old_out)
+
+    def test_refuse_dtype_mismatch(self):
+        old = self.save('old', 1, LinearNet, [None, 4])
+        double = self.save('double', 2, LinearNet, [None, 4], dtype='float64')
+        predictor = self.create_predictor(old)
+        old_out = self.run(predictor, self.x)
+
+        self.assertFalse(predictor.update_parameters(double + '.pdiparams'))
+        np.testing.assert_allclose(self.run(predictor, self.x), old_out)
+
+    def test_refuse_fused_parameters(self):
+        # The batch norm is folded into the conv filter, whose new weights
+        # can not be derived from the updated parameters.
+        old = self.save('old', 1, ConvBNNet, [None, 3, 8, 8])
+        new = self.save('new', 2, ConvBNNet, [None, 3, 8, 8])
+        predictor = self.create_predictor(old, ir_optim=True)
+        x = np.random.random([1, 3, 8, 8]).astype('float32')
+        old_out = self.run(predictor, x)
+
+        self.assertFalse(predictor.update_parameters(new + '.pdiparams'))
+        np.testing.assert_allclose(self.run(predictor, x), old_out)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,89 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import tempfile
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.inference import Config, create_predictor
+
+
+class TestNet(paddle.nn.Layer):
+    def __init__(self):
+        super().__init__()
+        self.fc1 = paddle.nn.Linear(64, 128)
+        self.fc2 = paddle.nn.Linear(128, 32)
+
+    def forward(self, x):
+        return self.fc2(paddle.nn.functional.relu(self.fc1(x)))
+
+
+@unittest.skipIf(
+    not paddle.base.core.is_compiled_with_mkldnn(),
+    'should compile with onednn.',
+)
+class TestOneDNNWeightPrepackPass(unittest.TestCase):
+    def setUp(self):
+        self.temp_dir = tempfile.TemporaryDirectory()
+        self.model_prefix = os.path.join(self.temp_dir.name, 'model')
+        paddle.seed(2026)
+        net = TestNet()
+        with paddle.pir_utils.DygraphPirGuard():
+            model = paddle.jit.to_static(
+                net,
+                input_spec=[
+                    paddle.static.InputSpec(
+                        shape=[None, 64], dtype='float32', name='x'
+                    )
+                ],
+                full_graph=True,
+            )
+            paddle.jit.save(model, self.model_prefix)
+
+    def tearDown(self):
+        self.temp_dir.cleanup()
+
+    def run_predictor(self, prepack, inputs):
+        config = Config(
+            self.model_prefix + '.json', self.model_prefix + '.pdiparams'
+        )
+        config.disable_gpu()
+        config.enable_mkldnn()
+        config.enable_new_ir()
+        config.enable_new_executor()
+        if not prepack:
+            config.delete_pass('onednn_weight_prepack_pass')
+        predictor = create_predictor(config)
+        outputs = []
+        # The batches differ from the one the weights are prepacked for.
+        for x in inputs:
+            outputs.append(predictor.run([paddle.to_tensor(x)])[0].numpy())
+        return outputs
+
+    def test_output(self):
+        inputs = [
+            np.random.random([batch, 64]).astype('float32')
+            for batch in [1, 1, 8, 3]
+        ]
+        expected = self.run_predictor(False, inputs)
+        actual = self.run_predictor(True, inputs)
+        for e, a in zip(expected, actual):
+            np.testing.assert_allclose(e, a, rtol=1e-5, atol=1e-5)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,107 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from __future__ import annotations
+
+import unittest
+from functools import partial
+
+import numpy as np
+from program_config import ProgramConfig, TensorConfig
+from trt_layer_auto_scan_test import TrtLayerAutoScanTest
+
+import paddle
+import paddle.inference as paddle_infer
+
+
+# logit has no DynamicMetaFn, the output dims of its generic plugin are
+# derived from its InferMeta.
+class TrtConvertDerivedGenericPlugin(TrtLayerAutoScanTest):
+    def is_program_valid(self, program_config: ProgramConfig) -> bool:
+        return True
+
+    def generate_ops_config(self):
+        return [
+            {
+                "op_type": "logit",
+                "op_inputs": {"X": ["input_data"]},
+                "op_outputs": {"Out": ["output_data"]},
+                "op_attrs": {"eps": 1e-6},
+            }
+        ]
+
+    def sample_program_configs(self):
+        def generate_input():
+            return np.random.uniform(0.1, 0.9, [2, 3, 16]).astype(np.float32)
+
+        ops = self.generate_op_config(self.generate_ops_config())
+        program_config = ProgramConfig(
+            ops=ops,
+            weights={},
+            inputs={
+                "input_data": TensorConfig(data_gen=partial(generate_input)),
+            },
+            outputs=["output_data"],
+        )
+        yield program_config
+
+    def expected_op_size(self):
+        return (1, 2)
+
+    def sample_predictor_configs(
+        self, program_config
+    ) -> tuple[paddle_infer.Config, list[int], float]:
+        self.dynamic_shape.min_input_shape = {"input_data": [1, 3, 1]}
+        self.dynamic_shape.max_input_shape = {"input_data": [4, 3, 32]}
+        self.dynamic_shape.opt_input_shape = {"input_data": [2, 3, 16]}
+        self.trt_param.precision = paddle_infer.PrecisionType.Float32
+        yield self.create_inference_config(), self.expected_op_size(), 1e-5
+
+    def test(self):
+        self.run_test()
+
+
+# With the cost based partition, logit at the edge of the subgraph runs
+# outside TensorRT, and relu alone is converted.
+class TrtConvertCostBasedPartition(TrtConvertDerivedGenericPlugin):
+    def setUp(self):
+        super().setUp()
+        paddle.set_flags({"FLAGS_trt_cost_based_partition": True})
+
+    def tearDown(self):
+        paddle.set_flags({"FLAGS_trt_cost_based_partition": False})
+        super().tearDown()
+
+    def generate_ops_config(self):
+        return [
+            {
+                "op_type": "relu",
+                "op_inputs": {"X": ["input_data"]},
+                "op_outputs": {"Out": ["relu_output_data"]},
+                "op_attrs": {},
+            },
+            {
+                "op_type": "logit",
+                "op_inputs": {"X": ["relu_output_data"]},
+                "op_outputs": {"Out": ["output_data"]},
+                "op_attrs": {"eps": 1e-6},
+            },
+        ]
+
+    def expected_op_size(self):
+        return (1, 3)
+
+
+if __name__ == "__main__":
+    unittest.main()
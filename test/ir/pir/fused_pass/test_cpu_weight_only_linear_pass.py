@@ -0,0 +1,117 @@
+# Copyright (c) 2024 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+from pass_test import PassTest
+
+import paddle
+from paddle.pir.core import create_parameter
+
+np.random.seed(2013)
+
+
+class TestCpuWeightOnlyLinearPass_WithBias(PassTest):
+    def setUp(self):
+        self.places.append(paddle.CPUPlace())
+        self.algo = "weight_only_int8"
+        self.group_size = -1
+        self.x_shape = [3, 16, 512]
+        self.pass_attr_list = [
+            {
+                'cpu_weight_only_linear_pass': {
+                    'weight_only_algo': self.algo,
+                    'weight_only_group_size': self.group_size,
+                }
+            }
+        ]
+
+    def build_out(self, x, w, bias_shape):
+        bias = paddle.static.data(
+            name="bias", shape=bias_shape, dtype="float32"
+        )
+        self.feeds["bias"] = 0.01 * np.random.random(bias_shape).astype(
+            "float32"
+        )
+        self.valid_op_map = {
+            "pd_op.weight_only_linear": 1,
+            "pd_op.weight_quantize": 1,
+            "pd_op.matmul": 0,
+            "pd_op.add": 0,
+        }
+        return paddle.add(paddle.matmul(x=x, y=w), bias)
+
+    def sample_program(self):
+        for w_shape in [[512, 256], [512, 64]]:
+            rand_value = (
+                0.001 * paddle.rand(shape=w_shape, dtype="float32").numpy()
+            )
+            with paddle.pir_utils.IrGuard():
+                start_prog = paddle.static.Program()
+                main_prog = paddle.static.Program()
+                with paddle.pir.core.program_guard(main_prog, start_prog):
+                    x = paddle.static.data(
+                        name='x', shape=self.x_shape, dtype="float32"
+                    )
+                    w = create_parameter(
+                        shape=w_shape,
+                        dtype="float32",
+                        initializer=paddle.nn.initializer.Assign(rand_value),
+                    )
+                    self.feeds = {
+                        "x": 0.01
+                        * np.random.random(self.x_shape).astype("float32"),
+                    }
+                    out = self.build_out(x, w, [w_shape[1]])
+                    out = paddle.assign(out)
+                    self.fetch_list = [out]
+                    yield [main_prog, start_prog], False
+
+    def test_check_output(self):
+        self.check_pass_correct(1e-3, 1e-3)
+
+
+class TestCpuWeightOnlyLinearPass_NoBias(TestCpuWeightOnlyLinearPass_WithBias):
+    def build_out(self, x, w, bias_shape):
+        self.valid_op_map = {
+            "pd_op.weight_only_linear": 1,
+            "pd_op.weight_quantize": 1,
+            "pd_op.matmul": 0,
+        }
+        return paddle.matmul(x=x, y=w)
+
+
+class TestCpuWeightOnlyLinearPass_Int4Group(
+    TestCpuWeightOnlyLinearPass_WithBias
+):
+    def setUp(self):
+        self.places.append(paddle.CPUPlace())
+        # A single row goes through the dequantize-on-the-fly GEMV.
+        self.x_shape = [1, 1, 512]
+        self.pass_attr_list = [
+            {
+                'cpu_weight_only_linear_pass': {
+                    'weight_only_algo': "weight_only_int4",
+                    'weight_only_group_size': 64,
+                }
+            }
+        ]
+
+    def test_check_output(self):
+        self.check_pass_correct(1e-2, 1e-2)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,84 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle import pir
+
+paddle.enable_static()
+
+
+def op_names(block):
+    return [op.name() for op in block.ops]
+
+
+def while_body_block(program):
+    for op in program.global_block().ops:
+        if op.name() == "pd_op.while":
+            return op.as_while_op().body()
+    return None
+
+
+class TestWhileLoopInvariantHoistPass(unittest.TestCase):
+    def build_program(self):
+        main_program = paddle.static.Program()
+        with paddle.pir.core.program_guard(main_program):
+            x = paddle.static.data("x", [4, 4], dtype="float32")
+            y = paddle.static.data("y", [4, 4], dtype="float32")
+            i = paddle.full(shape=[1], fill_value=0, dtype="int64")
+            ten = paddle.full(shape=[1], fill_value=10, dtype="int64")
+            acc = paddle.zeros([4, 4], dtype="float32")
+
+            def cond(i, acc):
+                return i < ten
+
+            def body(i, acc):
+                # The matmul is the same in every iteration, the tanh of the
+                # loop carried acc is not.
+                w = paddle.matmul(x, y)
+                acc = paddle.tanh(acc) + w
+                return [i + 1, acc]
+
+            _, out = paddle.static.nn.while_loop(cond, body, [i, acc])
+        return main_program, out
+
+    def run_program(self, program, out, feed):
+        exe = paddle.static.Executor(paddle.CPUPlace())
+        with paddle.static.scope_guard(paddle.static.Scope()):
+            return exe.run(program, feed=feed, fetch_list=[out])[0]
+
+    def test_hoist(self):
+        x = np.random.random([4, 4]).astype("float32")
+        y = np.random.random([4, 4]).astype("float32")
+        main_program, out = self.build_program()
+        expected = self.run_program(main_program, out, {"x": x, "y": y})
+
+        pm = pir.PassManager()
+        pm.add_pass("while_loop_invariant_hoist_pass", {})
+        pm.run(main_program)
+
+        self.assertIn("pd_op.matmul", op_names(main_program.global_block()))
+        body_ops = op_names(while_body_block(main_program))
+        self.assertNotIn("pd_op.matmul", body_ops)
+        self.assertIn("pd_op.tanh", body_ops)
+
+        actual = self.run_program(main_program, out, {"x": x, "y": y})
+        np.testing.assert_allclose(actual, expected, rtol=1e-6)
+
+
+if __name__ == "__main__":
+    unittest.main()
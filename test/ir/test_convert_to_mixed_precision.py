@@ -12,10 +12,13 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import json
 import os
 import tempfile
 import unittest
 
+import numpy as np
+
 import paddle
 from paddle.inference import (
     PlaceType,
@@ -87,6 +90,35 @@ class TestConvertToMixedPrecision(unittest.TestCase):
                     black_list=black_list,
                 )
 
+    def test_search_mixed_precision(self):
+        calibration_data = [
+            {'x': np.random.random([1, 3, 224, 224]).astype('float32')}
+            for _ in range(2)
+        ]
+        model_dir = os.path.join(self.temp_dir.name, 'search')
+        convert_to_mixed_precision(
+            os.path.join(self.temp_dir.name, 'resnet50/inference.pdmodel'),
+            os.path.join(self.temp_dir.name, 'resnet50/inference.pdiparams'),
+            os.path.join(model_dir, 'inference.pdmodel'),
+            os.path.join(model_dir, 'inference.pdiparams'),
+            backend=PlaceType.GPU,
+            mixed_precision=PrecisionType.Half,
+            calibration_data=calibration_data,
+            max_error=1e-2,
+        )
+        self.assertTrue(
+            os.path.exists(os.path.join(model_dir, 'inference.pdmodel'))
+        )
+        with open(
+            os.path.join(model_dir, 'inference.mixed_precision.json')
+        ) as f:
+            assignment = json.load(f)
+        self.assertLessEqual(assignment['error'], 1e-2)
+        self.assertFalse(
+            set(assignment['low_precision_ops'])
+            & set(assignment['fp32_ops'])
+        )
+
 
 if __name__ == '__main__':
     unittest.main()
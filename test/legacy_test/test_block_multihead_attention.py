@@ -522,6 +522,23 @@ class TestBlockMultiHeadAttnEncDec(unittest.TestCase):
         )
 
 
+@unittest.skipIf(
+    not core.is_compiled_with_cuda()
+    or get_cuda_version() < 11040
+    or not is_sm_supported,
+    "core is not compiled with CUDA and cuda version need larger than or equal to 11.4"
+    "and device's compute capability must be 8.x or 90",
+)
+class TestBlockMultiHeadAttnEncDecSplitKV(TestBlockMultiHeadAttnEncDec):
+    def test_all(self):
+        # The decoder splits the 64 cached timesteps in chunks of 16.
+        paddle.set_flags({"FLAGS_blha_split_kv_len": 16})
+        try:
+            super().test_all()
+        finally:
+            paddle.set_flags({"FLAGS_blha_split_kv_len": 0})
+
+
 @unittest.skipIf(
     not core.is_compiled_with_cuda()
     or get_cuda_version() < 11040
@@ -0,0 +1,91 @@
+#   Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+import unittest
+import urllib.request
+
+import paddle
+from paddle import profiler
+
+
+def train_step():
+    with profiler.RecordEvent("train_step"):
+        x = paddle.randn([32, 32])
+        paddle.matmul(x, x).sum()
+
+
+class TestContinuousProfiler(unittest.TestCase):
+    def test_sampled_steps(self):
+        prof = profiler.ContinuousProfiler(
+            targets=[profiler.ProfilerTarget.CPU],
+            sample_interval=3,
+            max_host_events=4,
+        )
+        prof.reset()
+        prof.start()
+        for _ in range(10):
+            train_step()
+            prof.step()
+        prof.stop()
+        aggregates = prof.aggregates()
+        self.assertEqual(aggregates['steps'], 10)
+        # the steps after the 3rd, 6th and 9th ones
+        self.assertEqual(aggregates['sampled_steps'], 3)
+        self.assertEqual(aggregates['host_events']['train_step']['calls'], 3)
+        self.assertLessEqual(len(prof.recent_host_events()), 4)
+        self.assertGreater(aggregates['dropped_host_events'], 0)
+
+        # not sampled once stopped
+        train_step()
+        prof.step()
+        self.assertEqual(prof.aggregates()['steps'], 10)
+        prof.reset()
+        self.assertEqual(prof.aggregates()['steps'], 0)
+
+    def test_not_sampled_with_profiler(self):
+        prof = profiler.ContinuousProfiler(
+            targets=[profiler.ProfilerTarget.CPU], sample_interval=1
+        )
+        prof.reset()
+        with profiler.Profiler(targets=[profiler.ProfilerTarget.CPU]):
+            with prof:
+                for _ in range(3):
+                    train_step()
+                    prof.step()
+        aggregates = prof.aggregates()
+        self.assertEqual(aggregates['steps'], 3)
+        self.assertEqual(aggregates['sampled_steps'], 0)
+
+    def test_serve(self):
+        prof = profiler.ContinuousProfiler(
+            targets=[profiler.ProfilerTarget.CPU], sample_interval=1
+        )
+        prof.reset()
+        prof.serve(0)
+        try:
+            with prof:
+                for _ in range(2):
+                    train_step()
+                    prof.step()
+            url = f'http://127.0.0.1:{prof.port}/aggregates'
+            with urllib.request.urlopen(url) as response:
+                aggregates = json.loads(response.read())
+            self.assertEqual(aggregates['sampled_steps'], 2)
+        finally:
+            prof.shutdown()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,99 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.io import DataLoader, Dataset
+
+IMAGE_SIZE = 16
+
+
+class IndexDataset(Dataset):
+    def __init__(self, num_samples):
+        self.num_samples = num_samples
+
+    def __getitem__(self, idx):
+        image = np.full([IMAGE_SIZE], idx, dtype='float32')
+        return {'image': image, 'label': idx, 'pair': [idx, float(idx)]}
+
+    def __len__(self):
+        return self.num_samples
+
+
+class BadDataset(IndexDataset):
+    def __getitem__(self, idx):
+        if idx == 5:
+            raise ValueError("bad sample")
+        return super().__getitem__(idx)
+
+
+class TestDataLoaderThreadWorker(unittest.TestCase):
+    def setUp(self):
+        paddle.disable_static()
+
+    def test_batches_in_order(self):
+        loader = DataLoader(
+            IndexDataset(30),
+            batch_size=4,
+            num_workers=3,
+            worker_mode='thread',
+        )
+        for _ in range(2):
+            expected = 0
+            batch_num = 0
+            for batch in loader:
+                labels = batch['label'].numpy()
+                np.testing.assert_array_equal(
+                    labels, np.arange(expected, expected + len(labels))
+                )
+                self.assertEqual(
+                    batch['image'].shape, [len(labels), IMAGE_SIZE]
+                )
+                np.testing.assert_array_equal(
+                    batch['image'].numpy()[:, 0], labels.astype('float32')
+                )
+                np.testing.assert_array_equal(batch['pair'][0].numpy(), labels)
+                self.assertEqual(batch['pair'][1].dtype, paddle.float64)
+                expected += len(labels)
+                batch_num += 1
+            self.assertEqual(expected, 30)
+            self.assertEqual(batch_num, 8)
+
+    def test_fetch_error(self):
+        loader = DataLoader(
+            BadDataset(16),
+            batch_size=4,
+            num_workers=2,
+            worker_mode='thread',
+        )
+        with self.assertRaises(Exception):
+            for _ in loader:
+                pass
+
+    def test_fallback_to_process(self):
+        loader = DataLoader(
+            IndexDataset(8),
+            batch_size=4,
+            num_workers=1,
+            collate_fn=lambda batch: batch,
+            worker_mode='thread',
+        )
+        self.assertEqual(loader.worker_mode, 'process')
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -113,6 +113,18 @@ class TestTreeIndex(unittest.TestCase):
         children_ids = [node.id() for node in tree.get_nodes(children_codes)]
         self.assertIn(all_leaf_ids[0], children_ids)
 
+        # beam_search
+        emb_dim = 2
+        node_embs = [0.0] * (tree.emb_size() * emb_dim)
+        for i, leaf_id in enumerate(all_leaf_ids):
+            node_embs[leaf_id * emb_dim] = float(i)
+        # no layer has more nodes than the beam, so all leafs are scored
+        tree.init_beam_search(len(all_leaf_ids), node_embs, emb_dim)
+        res = tree.beam_search([[1.0, 0.0], [-1.0, 0.0]])
+        self.assertEqual(len(res), 2)
+        self.assertEqual(res[0], all_leaf_ids[::-1])
+        self.assertEqual(res[1][0], all_leaf_ids[0])
+
 
 class TestIndexSampler(unittest.TestCase):
     def setUp(self):
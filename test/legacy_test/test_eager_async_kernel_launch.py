@@ -0,0 +1,64 @@
+#   Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.base import core
+
+
+def run_model(x_np, w_np):
+    x = paddle.to_tensor(x_np, stop_gradient=False)
+    w = paddle.to_tensor(w_np, stop_gradient=False)
+    y = paddle.tanh(paddle.matmul(x, w))
+    # the shape of nonzero depends on the data, it waits for the kernels
+    index = paddle.nonzero(y > 0)
+    z = paddle.nn.functional.softmax(y * 2.0 + 1.0, axis=-1)
+    loss = paddle.mean(z * z)
+    loss.backward()
+    return [
+        z.numpy(),
+        index.numpy(),
+        loss.item(),
+        x.grad.numpy(),
+        w.grad.numpy(),
+    ]
+
+
+@unittest.skipIf(
+    not core.is_compiled_with_cuda(),
+    "core is not compiled with CUDA ",
+)
+class TestEagerAsyncKernelLaunch(unittest.TestCase):
+    def test_same_results(self):
+        paddle.disable_static()
+        paddle.set_device('gpu')
+        np.random.seed(2026)
+        x_np = np.random.randn(64, 32).astype('float32')
+        w_np = np.random.randn(32, 16).astype('float32')
+        expected = run_model(x_np, w_np)
+        paddle.set_flags({'FLAGS_eager_async_kernel_launch': True})
+        try:
+            for _ in range(3):
+                actual = run_model(x_np, w_np)
+                for e, a in zip(expected, actual):
+                    np.testing.assert_allclose(a, e, rtol=1e-6, atol=1e-6)
+        finally:
+            paddle.set_flags({'FLAGS_eager_async_kernel_launch': False})
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 import unittest
+from collections import namedtuple
 
 import paddle
 from paddle.distributed.fleet.fleet_executor_utils import FleetExecutorUtils
@@ -43,6 +44,40 @@ class TestFleetExecutorUtils(unittest.TestCase):
             program_map
         )
 
+    def test_split_weight_grad_ops(self):
+        Op = namedtuple("Op", ["type", "input_arg_names", "output_arg_names"])
+        fleet_executor_utils = FleetExecutorUtils(zero_bubble=True)
+        bwd_ops = [
+            Op("matmul_v2_grad", ["x", "w", "y@GRAD"], ["x@GRAD", "w@GRAD"]),
+            # reads h before relu_grad writes it, so it can't be deferred
+            Op("matmul_v2_grad", ["h", "z@GRAD"], ["v@GRAD"]),
+            Op("relu_grad", ["x@GRAD"], ["h"]),
+            Op("send_v2", ["h"], []),
+            Op("reduce_sum", ["x@GRAD"], ["b@GRAD"]),
+            Op("c_allreduce_sum", ["w@GRAD"], ["w@GRAD"]),
+        ]
+        input_grad_ops, weight_grad_ops = (
+            fleet_executor_utils.split_weight_grad_ops(bwd_ops)
+        )
+        self.assertEqual(input_grad_ops, bwd_ops[:4])
+        self.assertEqual(weight_grad_ops, bwd_ops[4:])
+
+    def test_construct_program_zero_bubble(self):
+        fleet_executor_utils = FleetExecutorUtils(
+            rank=0, nrank=1, max_run_times=1, zero_bubble=True
+        )
+        op_list = {"lr": [], "fwd": [], "bwd": [], "bwd_w": [], "opt": []}
+        program_map = fleet_executor_utils.convert_op_list_to_program(
+            op_list, paddle.static.Program()
+        )
+        task_node_map = fleet_executor_utils.construct_task_nodes_1f1b(
+            program_map
+        )
+        self.assertEqual(
+            list(task_node_map.keys()), ["lr", "fwd", "bwd", "bwd_w", "opt"]
+        )
+        self.assertEqual(task_node_map["bwd_w"].task_id(), 4)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,103 @@
+#   Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+from test_sparse_attention_op import get_cuda_version
+
+import paddle
+from paddle.base import core
+from paddle.incubate.nn import FP8Linear, convert_to_fp8_linear
+
+
+def check_fp8_support() -> bool:
+    if not core.is_compiled_with_cuda():
+        return False
+    gpu_arch = (
+        paddle.device.cuda.get_device_capability()[0] * 10
+        + paddle.device.cuda.get_device_capability()[1]
+    )
+    if gpu_arch >= 90:
+        return True
+    return gpu_arch >= 89 and get_cuda_version() >= 12010
+
+
+class TestFP8LinearFallback(unittest.TestCase):
+    def test_float32_input(self):
+        paddle.seed(2026)
+        linear = paddle.nn.Linear(32, 48)
+        fp8_linear = FP8Linear.from_linear(linear)
+        x = paddle.randn([16, 32])
+        np.testing.assert_allclose(
+            fp8_linear(x).numpy(), linear(x).numpy(), rtol=1e-6
+        )
+
+    def test_convert_to_fp8_linear(self):
+        model = paddle.nn.Sequential(
+            paddle.nn.Linear(32, 48), paddle.nn.ReLU(), paddle.nn.Linear(48, 16)
+        )
+        convert_to_fp8_linear(model)
+        self.assertIsInstance(model[0], FP8Linear)
+        self.assertIsInstance(model[2], FP8Linear)
+        self.assertIn('0.fp8_scale', model.state_dict())
+
+
+@unittest.skipIf(not check_fp8_support(), "fp8 needs CUDA 12.1+ and sm_89+")
+class TestFP8Linear(unittest.TestCase):
+    def setUp(self):
+        paddle.seed(2026)
+        self.x = paddle.randn([4, 16, 64]).astype('bfloat16')
+        # float32 master weights, as with amp O1
+        self.linear = FP8Linear(64, 128)
+
+    def run_linear(self, use_fp8):
+        x = self.x.detach()
+        x.stop_gradient = False
+        if use_fp8:
+            out = self.linear(x)
+        else:
+            out = paddle.nn.functional.linear(
+                x,
+                self.linear.weight.astype('bfloat16'),
+                self.linear.bias.astype('bfloat16'),
+            )
+        out.astype('float32').sum().backward()
+        grads = [x.grad, self.linear.weight.grad, self.linear.bias.grad]
+        grads = [g.astype('float32').numpy() for g in grads]
+        self.linear.clear_gradients()
+        return out.astype('float32').numpy(), grads
+
+    def test_close_to_bf16(self):
+        ref_out, ref_grads = self.run_linear(use_fp8=False)
+        # the first step scales by 1, the next ones by the amax seen
+        for _ in range(3):
+            out, grads = self.run_linear(use_fp8=True)
+        np.testing.assert_allclose(out, ref_out, rtol=0.1, atol=0.1)
+        for grad, ref_grad in zip(grads, ref_grads):
+            np.testing.assert_allclose(grad, ref_grad, rtol=0.1, atol=0.5)
+
+    def test_delayed_scaling(self):
+        self.run_linear(use_fp8=True)
+        amax = self.linear.fp8_amax_history.numpy()[:, 0]
+        np.testing.assert_allclose(
+            amax[0], np.abs(self.x.astype('float32').numpy()).max(), rtol=1e-2
+        )
+        scale = self.linear.fp8_scale.numpy()
+        np.testing.assert_array_less(scale[:2] * amax[:2], 448.0 + 1e-3)
+        np.testing.assert_array_less(224.0, scale[:2] * amax[:2])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,92 @@
+#   Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.base import core
+from paddle.incubate.nn.functional import fused_linear_cross_entropy
+
+
+def paddle_linear_cross_entropy(x, weight, label, ignore_index, reduction):
+    logits = paddle.matmul(x, weight)
+    return paddle.nn.functional.cross_entropy(
+        logits,
+        label.unsqueeze(-1),
+        ignore_index=ignore_index,
+        reduction=reduction,
+    )
+
+
+@unittest.skipIf(
+    not core.is_compiled_with_cuda(),
+    "core is not compiled with CUDA ",
+)
+class TestFusedLinearCrossEntropy(unittest.TestCase):
+    def setUp(self):
+        self.rows = [3, 7]
+        self.hidden = 16
+        self.vocab = 100
+        # does not divide the vocab, the last chunk is smaller
+        self.chunk_size = 32
+        self.reduction = 'mean'
+
+    def run_loss(self, fused):
+        paddle.seed(2026)
+        np.random.seed(2026)
+        x = paddle.randn(self.rows + [self.hidden])
+        weight = paddle.randn([self.hidden, self.vocab]) * 0.1
+        label = paddle.randint(0, self.vocab, self.rows)
+        label[0, 0] = -100
+        x.stop_gradient = False
+        weight.stop_gradient = False
+        if fused:
+            loss = fused_linear_cross_entropy(
+                x,
+                weight,
+                label,
+                reduction=self.reduction,
+                chunk_size=self.chunk_size,
+            )
+        else:
+            loss = paddle_linear_cross_entropy(
+                x, weight, label, -100, self.reduction
+            )
+        loss.sum().backward()
+        return loss.numpy().flatten(), x.grad.numpy(), weight.grad.numpy()
+
+    def test_loss_and_grads(self):
+        for expected, actual in zip(
+            self.run_loss(fused=False), self.run_loss(fused=True)
+        ):
+            np.testing.assert_allclose(actual, expected, rtol=1e-4, atol=1e-5)
+
+
+class TestFusedLinearCrossEntropySum(TestFusedLinearCrossEntropy):
+    def setUp(self):
+        super().setUp()
+        self.reduction = 'sum'
+
+
+class TestFusedLinearCrossEntropyNone(TestFusedLinearCrossEntropy):
+    def setUp(self):
+        super().setUp()
+        self.reduction = 'none'
+        self.chunk_size = 1000
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -243,6 +243,42 @@ class TestSetGradEnabledClass(unittest.TestCase):
         self.assertTrue(y.stop_gradient is True)
 
 
+class TestInferenceModeClass(unittest.TestCase):
+    def test_stop_gradient(self):
+        paddle.disable_static()
+        x = paddle.to_tensor([1.0, 2.0], stop_gradient=False)
+        with paddle.inference_mode():
+            self.assertFalse(paddle.is_grad_enabled())
+            y = x * 2
+            z, w = paddle.split(paddle.concat([y, y]), 2)
+        self.assertTrue(paddle.is_grad_enabled())
+        self.assertTrue(y.stop_gradient)
+        self.assertTrue(z.stop_gradient)
+        self.assertEqual(w.tolist(), [2.0, 4.0])
+
+        with paddle.inference_mode():
+            with paddle.enable_grad():
+                y = x * 2
+        self.assertFalse(y.stop_gradient)
+        y.sum().backward()
+        self.assertEqual(x.grad.tolist(), [2.0, 2.0])
+
+    def test_decorator(self):
+        paddle.disable_static()
+
+        @paddle.inference_mode()
+        def double(x):
+            return x * 2
+
+        x = paddle.to_tensor([1.0], stop_gradient=False)
+        with paddle.no_grad():
+            y = double(x)
+            self.assertFalse(paddle.is_grad_enabled())
+        self.assertTrue(y.stop_gradient)
+        self.assertTrue(double(x).stop_gradient)
+        self.assertTrue(paddle.is_grad_enabled())
+
+
 class TestIsGradEnabledClass(unittest.TestCase):
     def test_main(self):
         paddle.disable_static()
@@ -0,0 +1,81 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+import os
+import tempfile
+import unittest
+
+import paddle
+from paddle import profiler
+
+
+def make_activation():
+    return paddle.randn([256, 1024])
+
+
+class TestMemoryTimeline(unittest.TestCase):
+    def setUp(self):
+        paddle.disable_static()
+        paddle.set_device('cpu')
+
+    def test_peak_holders(self):
+        with profiler.MemoryTimeline(record_stack=True) as timeline:
+            x = make_activation()
+            y = paddle.matmul(x, x, transpose_y=True)
+            del x, y
+
+        events = timeline.events()
+        allocs = [e for e in events if e['type'] == 'Allocate' and e['op']]
+        self.assertTrue(allocs)
+        self.assertTrue(all(e['layer'] == 'allocated' for e in allocs))
+        self.assertIn('matmul', {e['op'] for e in allocs})
+        # the frees of the deleted tensors are recorded too
+        self.assertIn('Free', {e['type'] for e in events})
+
+        report = timeline.peak_report(top_k=2)
+        cpu = [peak for peak in report if 'cpu' in peak['place']]
+        self.assertEqual(len(cpu), 1)
+        peak = cpu[0]
+        # x is 1 MB and y 256 KB, both alive at the peak
+        self.assertGreaterEqual(peak['peak_allocated'], 256 * 1024 * 5)
+        self.assertLessEqual(len(peak['holders']), 2)
+        top = peak['holders'][0]
+        self.assertGreaterEqual(top['bytes'], 256 * 1024 * 4)
+        self.assertIn('make_activation', top['stack'])
+        self.assertIn('MB', timeline.summary())
+
+    def test_export(self):
+        timeline = profiler.MemoryTimeline(max_events=1)
+        timeline.start()
+        x = make_activation()
+        timeline.stop()
+        # not recorded once stopped
+        y = make_activation()
+        del x, y
+
+        self.assertEqual(len(timeline.events()), 1)
+        self.assertIsNone(timeline.events()[0]['stack'])
+        with tempfile.TemporaryDirectory() as path:
+            path = os.path.join(path, 'memory_timeline.json')
+            timeline.export(path)
+            with open(path) as f:
+                result = json.load(f)
+        self.assertEqual(len(result['events']), 1)
+        self.assertEqual(result['dropped_events'], timeline.dropped_events())
+        self.assertTrue(result['peaks'])
+
+
+if __name__ == '__main__':
+    unittest.main()
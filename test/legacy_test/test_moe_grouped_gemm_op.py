@@ -0,0 +1,270 @@
+#   Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+from test_sparse_attention_op import get_cuda_version
+
+import paddle
+from paddle import nn
+from paddle.incubate.distributed.models.moe import GroupedExperts, MoELayer
+from paddle.incubate.nn.functional import (
+    moe_grouped_gemm,
+    moe_permute,
+    moe_unpermute,
+)
+
+
+def skip_unless_cutlass():
+    return unittest.skipIf(
+        not paddle.is_compiled_with_cuda()
+        or get_cuda_version() < 11030
+        or paddle.device.cuda.get_device_capability()[0] < 8,
+        "moe_grouped_gemm requires CUDA >= 11.3 and CUDA_ARCH >= 8",
+    )
+
+
+def random_expert_ids(num_tokens, k, num_experts, empty_expert):
+    # Each token goes to k different experts, none to empty_expert.
+    experts = [e for e in range(num_experts) if e != empty_expert]
+    return np.stack(
+        [np.random.choice(experts, k, replace=False) for _ in range(num_tokens)]
+    ).astype("int32")
+
+
+def ref_permute(x, expert_ids, num_experts):
+    num_tokens, k = expert_ids.shape
+    order = np.argsort(expert_ids.flatten(), kind="stable")
+    permuted_x = x[order // k]
+    expert_offsets = np.cumsum(
+        np.bincount(expert_ids.flatten(), minlength=num_experts)
+    )
+    dest_rows = np.empty(num_tokens * k, dtype="int32")
+    for dest, flat in enumerate(order):
+        t, j = divmod(flat, k)
+        dest_rows[j * num_tokens + t] = dest
+    return permuted_x, expert_offsets, dest_rows
+
+
+@skip_unless_cutlass()
+class TestMoePermute(unittest.TestCase):
+    def setUp(self):
+        self.num_tokens = 37
+        self.hidden = 24
+        self.k = 2
+        self.num_experts = 5
+        self.dtype = "float32"
+
+    def test_forward_backward(self):
+        np.random.seed(2026)
+        x_np = np.random.randn(self.num_tokens, self.hidden).astype(self.dtype)
+        ids_np = random_expert_ids(
+            self.num_tokens, self.k, self.num_experts, empty_expert=3
+        )
+        ref_x, ref_offsets, ref_dest = ref_permute(
+            x_np, ids_np, self.num_experts
+        )
+
+        x = paddle.to_tensor(x_np, stop_gradient=False)
+        permuted_x, offsets, dest_rows = moe_permute(
+            x, paddle.to_tensor(ids_np), self.num_experts
+        )
+        np.testing.assert_array_equal(permuted_x.numpy(), ref_x)
+        np.testing.assert_array_equal(offsets.numpy(), ref_offsets)
+        np.testing.assert_array_equal(dest_rows.numpy(), ref_dest)
+
+        grad_np = np.random.randn(*ref_x.shape).astype(self.dtype)
+        (x_grad,) = paddle.grad(
+            permuted_x, x, grad_outputs=paddle.to_tensor(grad_np)
+        )
+        ref_grad = np.zeros_like(x_np)
+        order = np.argsort(ids_np.flatten(), kind="stable")
+        np.add.at(ref_grad, order // self.k, grad_np)
+        np.testing.assert_allclose(x_grad.numpy(), ref_grad, rtol=1e-6)
+
+
+class TestMoePermuteTop1(TestMoePermute):
+    def setUp(self):
+        super().setUp()
+        self.k = 1
+
+
+@skip_unless_cutlass()
+class TestMoeGroupedGemm(unittest.TestCase):
+    def setUp(self):
+        self.rows_per_expert = [5, 0, 17, 1]
+        self.k = 32
+        self.n = 48
+        self.dtype = "float32"
+        # The float GEMMs of the experts are exact, the cuBLAS one of the
+        # weight grad may run in TF32.
+        self.rtol = 2e-3
+        self.atol = 2e-3
+
+    def test_forward_backward(self):
+        np.random.seed(2026)
+        num_experts = len(self.rows_per_expert)
+        offsets_np = np.cumsum(self.rows_per_expert)
+        rows = int(offsets_np[-1])
+        # The reference takes the inputs rounded to dtype.
+        x_np, w_np, g_np = (
+            np.random.randn(*shape).astype(self.dtype).astype("float32")
+            for shape in [
+                [rows, self.k],
+                [num_experts, self.k, self.n],
+                [rows, self.n],
+            ]
+        )
+
+        x = paddle.to_tensor(x_np.astype(self.dtype), stop_gradient=False)
+        w = paddle.to_tensor(w_np.astype(self.dtype), stop_gradient=False)
+        out = moe_grouped_gemm(x, w, paddle.to_tensor(offsets_np))
+        x_grad, w_grad = paddle.grad(
+            out, [x, w], grad_outputs=paddle.to_tensor(g_np.astype(self.dtype))
+        )
+
+        ref_out = np.zeros([rows, self.n], dtype="float32")
+        ref_x_grad = np.zeros_like(x_np)
+        ref_w_grad = np.zeros_like(w_np)
+        begin = 0
+        for e, end in enumerate(offsets_np):
+            ref_out[begin:end] = x_np[begin:end] @ w_np[e]
+            ref_x_grad[begin:end] = g_np[begin:end] @ w_np[e].T
+            ref_w_grad[e] = x_np[begin:end].T @ g_np[begin:end]
+            begin = end
+        for actual, expected in [
+            (out, ref_out),
+            (x_grad, ref_x_grad),
+            (w_grad, ref_w_grad),
+        ]:
+            np.testing.assert_allclose(
+                actual.astype("float32").numpy(),
+                expected,
+                rtol=self.rtol,
+                atol=self.atol,
+            )
+
+
+class TestMoeGroupedGemmFP16(TestMoeGroupedGemm):
+    def setUp(self):
+        super().setUp()
+        self.dtype = "float16"
+        self.rtol = 1e-2
+        self.atol = 5e-2
+
+
+@skip_unless_cutlass()
+class TestMoeUnpermute(unittest.TestCase):
+    def test_forward_backward(self):
+        np.random.seed(2026)
+        num_tokens, k, hidden, num_experts = 29, 2, 16, 4
+        ids_np = random_expert_ids(num_tokens, k, num_experts, empty_expert=0)
+        _, offsets_np, dest_np = ref_permute(
+            np.zeros([num_tokens, 1]), ids_np, num_experts
+        )
+        y_np = np.random.randn(num_tokens * k, hidden).astype("float32")
+        w_np = np.random.rand(num_tokens, k).astype("float32")
+        g_np = np.random.randn(num_tokens, hidden).astype("float32")
+
+        y = paddle.to_tensor(y_np, stop_gradient=False)
+        w = paddle.to_tensor(w_np, stop_gradient=False)
+        out = moe_unpermute(y, paddle.to_tensor(dest_np), w)
+        y_grad, w_grad = paddle.grad(
+            out, [y, w], grad_outputs=paddle.to_tensor(g_np)
+        )
+
+        rows = dest_np.reshape([k, num_tokens]).T
+        ref_out = np.einsum("tj,tjh->th", w_np, y_np[rows])
+        ref_y_grad = np.zeros_like(y_np)
+        ref_y_grad[rows] = w_np[:, :, None] * g_np[:, None, :]
+        ref_w_grad = np.einsum("th,tjh->tj", g_np, y_np[rows])
+        np.testing.assert_allclose(out.numpy(), ref_out, rtol=1e-5, atol=1e-5)
+        np.testing.assert_allclose(y_grad.numpy(), ref_y_grad, rtol=1e-6)
+        np.testing.assert_allclose(
+            w_grad.numpy(), ref_w_grad, rtol=1e-5, atol=1e-5
+        )
+
+    def test_permute_then_unpermute(self):
+        # Unpermuting the permuted tokens with weights summing to 1 gives
+        # the tokens back.
+        x = paddle.randn([11, 8])
+        ids = paddle.to_tensor(
+            random_expert_ids(11, 2, 3, empty_expert=-1), dtype="int32"
+        )
+        permuted_x, _, dest_rows = moe_permute(x, ids, 3)
+        out = moe_unpermute(permuted_x, dest_rows, paddle.full([11, 2], 0.5))
+        np.testing.assert_allclose(out.numpy(), x.numpy(), rtol=1e-6)
+
+
+@skip_unless_cutlass()
+class TestMoELayerGroupedExperts(unittest.TestCase):
+    # The Linear layers may run their GEMMs in TF32.
+    rtol = 5e-3
+    atol = 5e-3
+
+    def test_same_as_expert_list(self):
+        paddle.seed(2026)
+        num_expert, d_model, d_hidden = 4, 16, 32
+        grouped = GroupedExperts(num_expert, d_model, d_hidden)
+        experts = nn.LayerList()
+        for e in range(num_expert):
+            expert = nn.Sequential(
+                nn.Linear(d_model, d_hidden, bias_attr=False),
+                nn.GELU(),
+                nn.Linear(d_hidden, d_model, bias_attr=False),
+            )
+            expert[0].weight.set_value(grouped.w1[e])
+            expert[2].weight.set_value(grouped.w2[e])
+            experts.append(expert)
+        gate = {"type": "naive", "top_k": 2}
+        grouped_moe = MoELayer(d_model, grouped, gate=gate)
+        list_moe = MoELayer(d_model, experts, gate=gate)
+        list_moe.gate.set_state_dict(grouped_moe.gate.state_dict())
+
+        x = paddle.randn([2, 9, d_model])
+        out_grouped = grouped_moe(x.clone())
+        out_list = list_moe(x.clone())
+        np.testing.assert_allclose(
+            out_grouped.numpy(),
+            out_list.numpy(),
+            rtol=self.rtol,
+            atol=self.atol,
+        )
+
+        out_grouped.sum().backward()
+        out_list.sum().backward()
+        for e in range(num_expert):
+            np.testing.assert_allclose(
+                grouped.w1.grad[e].numpy(),
+                experts[e][0].weight.grad.numpy(),
+                rtol=self.rtol,
+                atol=self.atol,
+            )
+            np.testing.assert_allclose(
+                grouped.w2.grad[e].numpy(),
+                experts[e][2].weight.grad.numpy(),
+                rtol=self.rtol,
+                atol=self.atol,
+            )
+        np.testing.assert_allclose(
+            grouped_moe.gate.gate.weight.grad.numpy(),
+            list_moe.gate.gate.weight.grad.numpy(),
+            rtol=self.rtol,
+            atol=self.atol,
+        )
+
+
+if __name__ == "__main__":
+    unittest.main()
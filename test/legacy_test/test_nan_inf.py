@@ -277,6 +277,40 @@ class TestNanInfCheckResult(TestNanInfBase):
             )
 
 
+class TestAsyncNanInfCheck(TestNanInfBase):
+    def get_device_list(self):
+        device_list = ["cpu"]
+        if paddle.base.core.is_compiled_with_cuda():
+            device_list.append("gpu:0")
+        return device_list
+
+    def test_get_nan_inf_count(self):
+        for device in self.get_device_list():
+            paddle.device.set_device(device)
+            x = paddle.to_tensor([1.0, 0.0, -1.0, 2.0])
+            paddle.amp.debugging.get_nan_inf_count()
+            paddle.set_flags(
+                {"FLAGS_check_nan_inf": 1, "FLAGS_check_nan_inf_async": 1}
+            )
+            # [0, -inf, nan, log(2)]
+            out = paddle.log(x)
+            paddle.set_flags(
+                {"FLAGS_check_nan_inf": 0, "FLAGS_check_nan_inf_async": 0}
+            )
+            self.assertEqual(paddle.amp.debugging.get_nan_inf_count(), 2)
+            self.assertEqual(paddle.amp.debugging.get_nan_inf_count(), 0)
+
+    def test_replay(self):
+        paddle.device.set_device("cpu")
+        checker = paddle.amp.debugging.AsyncNanInfChecker()
+        out = checker.run(paddle.log, paddle.to_tensor([1.0, 2.0]))
+        np.testing.assert_allclose(out.numpy(), np.log([1.0, 2.0]))
+        # The replay aborts at the log.
+        with self.assertRaises(Exception):
+            checker.run(paddle.log, paddle.to_tensor([0.0, -1.0]))
+        self.assertEqual(paddle.amp.debugging.get_nan_inf_count(), 0)
+
+
 class TestCheckNumericsAPI(TestNanInfBase):
     def test_eager(self):
         shape = [8, 8]
@@ -0,0 +1,85 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import tempfile
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.base import core
+from paddle.static import InputSpec
+
+
+class TestSaveLoadFlatFormat(unittest.TestCase):
+    def setUp(self):
+        paddle.disable_static()
+        self.temp_dir = tempfile.TemporaryDirectory()
+
+    def tearDown(self):
+        self.temp_dir.cleanup()
+
+    def test_save_load(self):
+        state_dict = {
+            "w": paddle.rand([3, 5]),
+            "b": paddle.arange(7, dtype="int64"),
+            "h": paddle.rand([4]).astype("float16"),
+        }
+        path = os.path.join(self.temp_dir.name, "model.pdparams")
+        paddle.save(state_dict, path, use_flat_format=True)
+        self.assertTrue(core.is_flat_params_file(path))
+
+        loaded = paddle.load(path)
+        self.assertEqual(list(loaded.keys()), ["w", "b", "h"])
+        for key, value in state_dict.items():
+            self.assertTrue(loaded[key].place.is_cpu_place())
+            self.assertEqual(loaded[key].dtype, value.dtype)
+            np.testing.assert_array_equal(loaded[key].numpy(), value.numpy())
+
+        loaded = paddle.load(path, return_numpy=True)
+        np.testing.assert_array_equal(loaded["w"], state_dict["w"].numpy())
+
+    def test_pickle_not_flat(self):
+        path = os.path.join(self.temp_dir.name, "model.pdparams")
+        paddle.save({"w": paddle.rand([2, 2])}, path)
+        self.assertFalse(core.is_flat_params_file(path))
+
+    def test_save_error(self):
+        path = os.path.join(self.temp_dir.name, "model.pdparams")
+        with self.assertRaises(TypeError):
+            paddle.save([paddle.rand([2])], path, use_flat_format=True)
+        with self.assertRaises(TypeError):
+            paddle.save({"w": 1}, path, use_flat_format=True)
+
+    def test_jit_load(self):
+        layer = paddle.nn.Linear(4, 2)
+        prefix = os.path.join(self.temp_dir.name, "linear", "inference")
+        paddle.jit.save(
+            layer, prefix, input_spec=[InputSpec([None, 4], "float32")]
+        )
+        # Replace the combined parameters by the flat ones, named as in the
+        # program.
+        params = {param.name: param for param in layer.parameters()}
+        paddle.save(params, prefix + ".pdiparams", use_flat_format=True)
+
+        loaded = paddle.jit.load(prefix)
+        x = paddle.rand([3, 4])
+        np.testing.assert_allclose(
+            loaded(x).numpy(), layer(x).numpy(), rtol=1e-6
+        )
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,48 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import paddle
+import paddle.profiler as profiler
+from paddle.base import core
+from paddle.profiler.utils import in_profiler_mode
+
+
+class TestExternalRanges(unittest.TestCase):
+    def test_invalid_backend(self):
+        with self.assertRaises(ValueError):
+            profiler.enable_external_ranges(['tracy'])
+        self.assertFalse(in_profiler_mode())
+
+    @unittest.skipIf(
+        not core.is_compiled_with_cuda() or core.is_compiled_with_rocm(),
+        'NVTX needs CUDA',
+    )
+    def test_nvtx(self):
+        profiler.enable_external_ranges(['nvtx'])
+        try:
+            self.assertTrue(in_profiler_mode())
+            x = paddle.randn([4, 4])
+            linear = paddle.nn.Linear(4, 4)
+            with profiler.RecordEvent('external_range'):
+                y = linear(paddle.matmul(x, x))
+            y.sum().backward()
+        finally:
+            profiler.disable_external_ranges()
+        self.assertFalse(in_profiler_mode())
+
+
+if __name__ == '__main__':
+    unittest.main()
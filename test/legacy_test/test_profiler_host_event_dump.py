@@ -0,0 +1,101 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+import os
+import struct
+import tempfile
+import unittest
+
+import paddle
+from paddle.profiler import host_event_dump
+
+
+def write_dump(path):
+    strings = [b'Operator', b'Dataloader', b'matmul', b'read', b'main']
+    data = b'PDHEDMP1' + struct.pack('<Q', 42)
+    data += struct.pack('<I', len(strings))
+    for string in strings:
+        data += struct.pack('<I', len(string)) + string
+    # The types Operator and Dataloader.
+    data += struct.pack('<III', 2, 0, 1)
+    data += struct.pack('<I', 1)
+    data += struct.pack('<QIQ', 7, 4, 2)
+    data += struct.pack('<QQIIBB6x', 1000000, 1500000, 2, 0xFFFFFFFF, 0, 0)
+    data += struct.pack('<QQIIBB6x', 2000000, 5000000, 3, 2, 1, 0)
+    with open(path, 'wb') as f:
+        f.write(data)
+
+
+class TestHostEventDump(unittest.TestCase):
+    def test_convert(self):
+        with tempfile.TemporaryDirectory() as dir_name:
+            path = os.path.join(dir_name, 'host.dump')
+            write_dump(path)
+            dump = host_event_dump.load_host_event_dump(path)
+            self.assertEqual(dump['process_id'], 42)
+            thread = dump['threads'][0]
+            self.assertEqual(thread['thread_id'], 7)
+            self.assertEqual(thread['thread_name'], 'main')
+            self.assertEqual(
+                thread['events'][0],
+                {
+                    'name': 'matmul',
+                    'type': 'Operator',
+                    'start_ns': 1000000,
+                    'end_ns': 1500000,
+                    'attr': None,
+                },
+            )
+            self.assertEqual(thread['events'][1]['attr'], 'matmul')
+
+            output = os.path.join(dir_name, 'host.json')
+            num_events = host_event_dump.convert_host_event_dump(path, output)
+            self.assertEqual(num_events, 2)
+            with open(output) as f:
+                events = json.load(f)['traceEvents']
+            events = [event for event in events if event['ph'] == 'X']
+            self.assertEqual(events[0]['name'], 'matmul[500.000 us]')
+            self.assertEqual(events[0]['tid'], '7(C++)')
+            self.assertEqual(events[0]['ts'], 1000)
+            self.assertEqual(events[1]['name'], 'read[3.000 ms]')
+            self.assertEqual(events[1]['tid'], '7(Python)')
+            self.assertEqual(events[1]['dur'], 3000.0)
+
+    def test_invalid_dump(self):
+        with tempfile.TemporaryDirectory() as dir_name:
+            path = os.path.join(dir_name, 'host.dump')
+            with open(path, 'wb') as f:
+                f.write(b'not a dump')
+            with self.assertRaises(ValueError):
+                host_event_dump.load_host_event_dump(path)
+
+    def test_record(self):
+        paddle.disable_static()
+        with tempfile.TemporaryDirectory() as dir_name:
+            path = os.path.join(dir_name, 'host.dump')
+            host_event_dump.start_host_event_dump()
+            x = paddle.randn([4, 4])
+            paddle.matmul(x, x)
+            num_events = host_event_dump.stop_host_event_dump(path)
+            dump = host_event_dump.load_host_event_dump(path)
+            self.assertEqual(
+                num_events,
+                sum(len(thread['events']) for thread in dump['threads']),
+            )
+            self.assertGreater(num_events, 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,171 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+import os
+import tempfile
+import threading
+import unittest
+
+from paddle.profiler import multi_rank
+
+
+class FakeStore:
+    def __init__(self):
+        self.values = {}
+        self.cond = threading.Condition()
+
+    def set(self, key, value):
+        with self.cond:
+            self.values[key] = value
+            self.cond.notify_all()
+
+    def get(self, key):
+        with self.cond:
+            self.cond.wait_for(lambda: key in self.values)
+            return self.values[key].encode()
+
+
+def host_event(name, ts, dur, cat, tid='1(C++)'):
+    return {
+        'name': f'{name}[{dur / 1000.0:.3f} ms]',
+        'pid': 10,
+        'tid': tid,
+        'ts': ts,
+        'dur': dur,
+        'ph': 'X',
+        'cat': cat,
+    }
+
+
+def kernel_event(name, ts, dur, correlation):
+    return {
+        'name': f'{name}[{dur / 1000.0:.3f} ms]',
+        'pid': 0,
+        'tid': 7,
+        'ts': ts,
+        'dur': dur,
+        'ph': 'X',
+        'cat': 'Kernel',
+        'args': {'correlation id': correlation},
+    }
+
+
+def rank_trace(compute_us, clock_shift):
+    # One step: a matmul of compute_us, then an allreduce, all in the local
+    # clock, which is clock_shift behind the clock of rank 0.
+    base = 1000000 - clock_shift
+    allreduce = 'ProcessGroupNCCL::AllReduce#gid=0#seq=1'
+    comm_start = base + 100 + compute_us
+    # The allreduce ends 50us after the slowest rank, of 600us compute.
+    comm_end = base + 100 + 600 + 50
+    events = [
+        host_event('ProfileStep#3', base, 1000, 'ProfileStep'),
+        kernel_event('matmul', base + 100, compute_us, 1),
+        host_event(allreduce, comm_start - 10, 20, 'Communication'),
+        host_event('cudaLaunchKernel', comm_start - 5, 5, 'CudaRuntime'),
+        kernel_event(
+            'ncclKernel_AllReduce', comm_start, comm_end - comm_start, 2
+        ),
+    ]
+    events[3]['args'] = {'correlation id': 2}
+    return {'displayTimeUnit': 'ms', 'traceEvents': events}
+
+
+class TestProfilerMultiRank(unittest.TestCase):
+    def test_measure_clock_offset(self):
+        store = FakeStore()
+        results = {}
+
+        def run(rank):
+            results[rank] = multi_rank.measure_clock_offset(store, rank, 3, 4)
+
+        threads = [threading.Thread(target=run, args=(r,)) for r in range(3)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        self.assertEqual(results[0]['offset_ns'], 0)
+        for rank in (1, 2):
+            # The same clock, so the offset is within the round trip.
+            self.assertLessEqual(
+                abs(results[rank]['offset_ns']), results[rank]['rtt_ns']
+            )
+
+    def test_straggler(self):
+        with tempfile.TemporaryDirectory() as dir_name:
+            # Rank 1 computes 600us against 200us on rank 0, and its clock
+            # is 5ms behind.
+            for rank, compute_us, shift in ((0, 200, 0), (1, 600, 5000)):
+                path = os.path.join(
+                    dir_name, f'rank{rank}_time_1.paddle_trace.json'
+                )
+                with open(path, 'w') as f:
+                    json.dump(rank_trace(compute_us, shift), f)
+                with open(
+                    os.path.join(dir_name, f'rank{rank}.clock.json'), 'w'
+                ) as f:
+                    json.dump({'offset_ns': shift * 1000, 'rtt_ns': 0}, f)
+
+            traces = multi_rank.load_rank_traces(dir_name)
+            self.assertEqual(sorted(traces), [0, 1])
+            self.assertEqual(traces[1][0]['name'], 'ProfileStep#3')
+            self.assertEqual(traces[1][0]['ts'], 1000000)
+
+            report = multi_rank.analyze_stragglers(traces)
+            self.assertEqual(len(report['steps']), 1)
+            step = report['steps'][0]
+            self.assertEqual(step['step'], 3)
+            self.assertEqual(step['straggler'], 1)
+            ranks = step['ranks']
+            self.assertAlmostEqual(ranks[0]['wait_ms'], 0.4)
+            self.assertAlmostEqual(ranks[1]['wait_ms'], 0.0)
+            self.assertAlmostEqual(ranks[0]['compute_ms'], 0.2)
+            self.assertAlmostEqual(ranks[1]['compute_ms'], 0.6)
+            self.assertAlmostEqual(ranks[0]['comm_ms'], 0.45)
+            self.assertEqual(ranks[1]['late_count'], 1)
+            self.assertEqual(
+                step['critical_path'],
+                [
+                    {
+                        'collective': 'AllReduce gid=0 seq=1',
+                        'rank': 1,
+                        'lateness_ms': 0.7,
+                    }
+                ],
+            )
+            self.assertIn('straggler rank 1', multi_rank.format_report(report))
+
+            merged = os.path.join(dir_name, 'merged.json')
+            multi_rank.merge_rank_traces(traces, merged)
+            with open(merged) as f:
+                events = json.load(f)['traceEvents']
+            names = {
+                event['args']['name']
+                for event in events
+                if event['name'] == 'process_name'
+            }
+            self.assertEqual(
+                names,
+                {
+                    'rank 0 CPU 10',
+                    'rank 0 Device 0',
+                    'rank 1 CPU 10',
+                    'rank 1 Device 0',
+                },
+            )
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1044,6 +1044,79 @@ class TestProfilerStatistic(unittest.TestCase):
                 )
             )
 
+    def test_statistic_roofline(self):
+        root_node = HostPythonNode(
+            'Root Node',
+            profiler.TracerEventType.UserDefined,
+            0,
+            float('inf'),
+            1000,
+            1001,
+        )
+        profilerstep_node = HostPythonNode(
+            'ProfileStep#1',
+            profiler.TracerEventType.ProfileStep,
+            0,
+            2000000,
+            1000,
+            1001,
+        )
+        matmul_node = HostPythonNode(
+            'matmul', profiler.TracerEventType.Operator, 10, 1000000, 1000, 1001
+        )
+        matmul_node.input_shapes = {'X': [[1024, 1024]], 'Y': [[1024, 1024]]}
+        matmul_node.dtypes = {'X': ['BF16'], 'Y': ['BF16']}
+        matmul_node.attributes = {}
+        matmul_launch = HostPythonNode(
+            'matmul kernel launch',
+            profiler.TracerEventType.DygraphKernelLaunch,
+            20,
+            100,
+            1000,
+            1001,
+        )
+        matmul_launchkernel = HostPythonNode(
+            'cudalaunchkernel',
+            profiler.TracerEventType.CudaRuntime,
+            30,
+            90,
+            1000,
+            1001,
+        )
+        matmul_kernel = DevicePythonNode(
+            'gemm_kernel', profiler.TracerEventType.Kernel, 100, 1000100, 0, 0, 0
+        )
+        matmul_kernel.occupancy = 0.5
+        matmul_kernel.blocks_per_sm = 0.25
+        root_node.children_node.append(profilerstep_node)
+        profilerstep_node.children_node.append(matmul_node)
+        matmul_node.children_node.append(matmul_launch)
+        matmul_launch.runtime_node.append(matmul_launchkernel)
+        matmul_launchkernel.device_node.append(matmul_kernel)
+        statistic_data = profiler.profiler_statistic.StatisticData(
+            {'thread1001': root_node}, {}
+        )
+        event_summary = statistic_data.event_summary
+
+        matmul_item = event_summary.items['matmul']
+        self.assertEqual(matmul_item.flops, 2 * 1024**3)
+        self.assertEqual(matmul_item.bytes, 2 * 1024 * 1024 * 2)
+        self.assertAlmostEqual(matmul_item.occupancy, 0.5)
+        kernel_item = event_summary.kernel_items['gemm_kernel']
+        self.assertAlmostEqual(kernel_item.occupancy, 0.5)
+        self.assertAlmostEqual(kernel_item.sm_coverage, 0.25)
+
+        table = profiler.profiler_statistic._build_table(
+            statistic_data,
+            views=[profiler.SummaryView.RooflineView],
+            peak_tflops=100,
+            peak_gbps=1000,
+        )
+        self.assertIn('Roofline Summary', table)
+        # 512 FLOP/Byte is above the ridge of 100
+        self.assertIn('compute', table)
+        self.assertIn('46.57x', table)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,82 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle import base
+from paddle.incubate.layers import _pull_gpups_sparse_seqpool_cvm
+
+paddle.enable_static()
+
+
+class TestPullGpupsSparseSeqpoolCVM(unittest.TestCase):
+    """Test PullGpupsSparseSeqpoolCVM op."""
+
+    def test_static_graph(self):
+        with paddle.pir_utils.OldIrGuard():
+            startup_program = base.Program()
+            train_program = base.Program()
+            slots = []
+            with base.program_guard(train_program, startup_program):
+                for i in range(2):
+                    l = paddle.static.data(
+                        name=f'input_{i}',
+                        shape=[-1, 1],
+                        dtype="int64",
+                        lod_level=1,
+                    )
+                    slots.append(l)
+                cvm = paddle.static.data(
+                    name='cvm', shape=[-1, 2], dtype="float32"
+                )
+                outputs = _pull_gpups_sparse_seqpool_cvm(
+                    slots,
+                    cvm,
+                    size=[11, 11],
+                    use_cvm=False,
+                    is_distributed=True,
+                    is_sparse=True,
+                )
+                self.assertEqual(len(outputs), 2)
+                self.assertEqual(outputs[0].shape[-1], 9)
+                cost = paddle.mean(paddle.concat(outputs, axis=1))
+                sgd_optimizer = paddle.optimizer.SGD(learning_rate=0.001)
+                sgd_optimizer.minimize(cost, train_program)
+                ops = [op.type for op in train_program.global_block().ops]
+                self.assertIn('push_gpups_sparse_seqpool_cvm', ops)
+                place = base.CPUPlace()
+                if base.core.is_compiled_with_cuda():
+                    place = base.CUDAPlace(0)
+                exe = base.Executor(place)
+                exe.run(startup_program)
+                ids = base.create_lod_tensor(
+                    np.array([[1], [2], [3]]).astype(np.int64), [[2, 1]], place
+                )
+                res = exe.run(
+                    train_program,
+                    feed={
+                        'input_0': ids,
+                        'input_1': ids,
+                        'cvm': np.ones([2, 2]).astype(np.float32),
+                    },
+                    fetch_list=[outputs[0]],
+                )
+                self.assertEqual(res[0].shape, (2, 9))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -84,5 +84,69 @@ class TestSavedTensorsHooks(unittest.TestCase):
         self.assertTrue(paddle.equal_all(bb.grad, b.grad))
 
 
+@unittest.skipIf(
+    not paddle.is_compiled_with_cuda(), "activation offload needs CUDA"
+)
+class TestOffloadSavedTensors(unittest.TestCase):
+    def test_offload_matches(self):
+        paddle.set_device('gpu')
+        x = paddle.rand([256, 1024])
+
+        def run(offload):
+            a = x.clone()
+            a.stop_gradient = False
+            if offload:
+                with paddle.autograd.offload_saved_tensors(
+                    min_bytes=1024, prefetch_num=1
+                ):
+                    y = paddle.tanh(paddle.tanh(paddle.tanh(a)))
+            else:
+                y = paddle.tanh(paddle.tanh(paddle.tanh(a)))
+            y.sum().backward()
+            return a.grad
+
+        self.assertTrue(paddle.equal_all(run(True), run(False)))
+
+
+class TestRecomputeSavedTensors(unittest.TestCase):
+    def run_net(self, recompute, budget_bytes=0):
+        paddle.seed(2026)
+        x = paddle.rand([32, 32])
+        w = paddle.rand([32, 32])
+        a = x.clone()
+        a.stop_gradient = False
+
+        def net():
+            h = paddle.nn.functional.gelu(paddle.matmul(a, w))
+            return paddle.sin(paddle.nn.functional.silu(h))
+
+        if recompute:
+            with paddle.autograd.recompute_saved_tensors(budget_bytes):
+                y = net()
+        else:
+            y = net()
+        y.sum().backward()
+        return a.grad
+
+    def test_recompute_matches(self):
+        expected = self.run_net(False)
+        self.assertTrue(paddle.equal_all(self.run_net(True), expected))
+        # keep the first tensor saved, recompute the others
+        self.assertTrue(
+            paddle.equal_all(self.run_net(True, 32 * 32 * 4), expected)
+        )
+
+    def test_inplace_input(self):
+        a = paddle.rand([8, 8])
+        a.stop_gradient = False
+        with paddle.autograd.recompute_saved_tensors():
+            b = a * 1.0
+            h = paddle.nn.functional.gelu(b)
+            y = paddle.sin(h)
+        b.add_(paddle.ones([8, 8]))
+        with self.assertRaises(Exception):
+            y.sum().backward()
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -315,6 +315,86 @@ class TestSparseConv(unittest.TestCase):
             rtol=1e-5,
         )
 
+    @unittest.skipIf(
+        not paddle.is_compiled_with_cuda(), "the rulebook is cached on GPU"
+    )
+    def test_subm_conv3d_chain_without_key(self):
+        # The second layer reuses the rulebook of the first one, as they have
+        # the same points and kernel.
+        paddle.seed(0)
+        shape = [1, 4, 4, 4, 3]
+        mask = (paddle.rand(shape[:-1] + [1]) < 0.5).astype('float32')
+        x = paddle.randn(shape) * mask
+        conv1 = paddle.nn.Conv3D(3, 3, 3, padding=1, data_format='NDHWC')
+        conv2 = paddle.nn.Conv3D(3, 2, 3, padding=1, data_format='NDHWC')
+        sp_conv1 = paddle.sparse.nn.SubmConv3D(3, 3, 3, data_format='NDHWC')
+        sp_conv2 = paddle.sparse.nn.SubmConv3D(3, 2, 3, data_format='NDHWC')
+        for conv, sp_conv in [(conv1, sp_conv1), (conv2, sp_conv2)]:
+            sp_conv.weight.set_value(
+                paddle.to_tensor(conv.weight.numpy().transpose(2, 3, 4, 1, 0))
+            )
+            sp_conv.bias.set_value(paddle.to_tensor(conv.bias.numpy()))
+
+        out = conv2(paddle.nn.functional.relu(conv1(x) * mask)) * mask
+        out.sum().backward()
+
+        sp_x = x.to_sparse_coo(4)
+        sp_out = sp_conv2(paddle.sparse.nn.functional.relu(sp_conv1(sp_x)))
+        np.testing.assert_array_equal(
+            sp_x.indices().numpy(), sp_out.indices().numpy()
+        )
+        dense_out = sp_out.to_dense()
+        dense_out.sum().backward()
+        np.testing.assert_allclose(
+            out.numpy(), dense_out.numpy(), atol=1e-3, rtol=1e-3
+        )
+        for conv, sp_conv in [(conv1, sp_conv1), (conv2, sp_conv2)]:
+            np.testing.assert_allclose(
+                conv.weight.grad.numpy().transpose(2, 3, 4, 1, 0),
+                sp_conv.weight.grad.numpy(),
+                atol=1e-3,
+                rtol=1e-3,
+            )
+
+    @unittest.skipIf(
+        not paddle.is_compiled_with_cuda(), "the rulebook is cached on GPU"
+    )
+    def test_subm_conv3d_chain_params_without_key(self):
+        # conv_b differs from conv_a only in padding, and must not reuse its
+        # rulebook. conv_c differs from conv_a only in channels, and reuses it.
+        paddle.seed(1)
+        shape = [1, 5, 5, 5, 3]
+        mask = (paddle.rand(shape[:-1] + [1]) < 0.5).astype('float32')
+        sp_x = (paddle.randn(shape) * mask).to_sparse_coo(4)
+        conv_a = paddle.sparse.nn.SubmConv3D(
+            3, 4, 3, padding=1, data_format='NDHWC'
+        )
+        conv_b = paddle.sparse.nn.SubmConv3D(
+            4, 4, 3, padding=0, data_format='NDHWC'
+        )
+        conv_c = paddle.sparse.nn.SubmConv3D(
+            4, 2, 3, padding=1, data_format='NDHWC'
+        )
+
+        y = conv_a(sp_x)
+        outs = [conv_b(y), conv_c(y)]
+
+        # The same layers on a copy of the indices, which finds no rulebook.
+        for conv, out in zip([conv_b, conv_c], outs):
+            y_apart = paddle.sparse.sparse_coo_tensor(
+                y.indices().clone(), y.values(), y.shape
+            )
+            expected = conv(y_apart)
+            np.testing.assert_array_equal(
+                expected.indices().numpy(), out.indices().numpy()
+            )
+            np.testing.assert_allclose(
+                expected.values().numpy(),
+                out.values().numpy(),
+                atol=1e-5,
+                rtol=1e-5,
+            )
+
 
 class TestStatic(unittest.TestCase):
     @compare_legacy_with_pt
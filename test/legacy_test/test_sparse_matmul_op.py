@@ -308,6 +308,79 @@ class TestMaskedMatmul(unittest.TestCase):
         )
 
 
+class TestSparseMatmulAutoTune(unittest.TestCase):
+    # The native kernels are tuned against cuSPARSE, each of them is timed
+    # on the real output while tuning, then the cached one is used.
+    def setUp(self):
+        paddle.incubate.autotune.set_config(
+            config={"kernel": {"enable": True, "tuning_range": [1, 2]}}
+        )
+
+    def tearDown(self):
+        paddle.incubate.autotune.set_config(
+            config={"kernel": {"enable": False}}
+        )
+
+    def get_mask(self, shape):
+        # Rows of skewed lengths: the first rows are dense, the rest sparse.
+        np_mask = np.random.rand(*shape) < 0.1
+        np_mask[:2] = True
+        return np_mask
+
+    def check_spmm(self, np_x, np_y, format, index_dtype):
+        x = paddle.to_tensor(np_x)
+        if format == "coo":
+            sp_x = x.to_sparse_coo(2)
+            sp_x = paddle.sparse.sparse_coo_tensor(
+                paddle.cast(sp_x.indices(), index_dtype),
+                sp_x.values(),
+                sp_x.shape,
+            )
+        else:
+            sp_x = x.to_sparse_csr()
+            sp_x = paddle.sparse.sparse_csr_tensor(
+                paddle.cast(sp_x.crows(), index_dtype),
+                paddle.cast(sp_x.cols(), index_dtype),
+                sp_x.values(),
+                sp_x.shape,
+            )
+        out = paddle.sparse.matmul(sp_x, paddle.to_tensor(np_y))
+        np.testing.assert_allclose(out.numpy(), np_x @ np_y, rtol=1e-05)
+
+    @unittest.skipIf(
+        not paddle.is_compiled_with_cuda() or get_cuda_version() < 11000,
+        "only support cuda>=11.0",
+    )
+    def test_spmm(self):
+        np_x = np.random.rand(64, 48) * self.get_mask([64, 48])
+        for step in range(4):
+            paddle.base.core.update_autotune_status()
+            for n in [3, 40]:
+                np_y = np.random.rand(48, n)
+                for format in ["coo", "csr"]:
+                    for index_dtype in ["int32", "int64"]:
+                        self.check_spmm(np_x, np_y, format, index_dtype)
+
+    @unittest.skipIf(
+        not paddle.is_compiled_with_cuda() or get_cuda_version() < 11030,
+        "only support on cuda>=11.3",
+    )
+    def test_masked_matmul(self):
+        np_mask = self.get_mask([64, 40])
+        np_x = np.random.rand(64, 48)
+        np_y = np.random.rand(48, 40)
+        np_out = sp.csr_matrix(np.matmul(np_x, np_y) * np_mask)
+        mask = paddle.to_tensor(np_mask.astype('float64')).to_sparse_csr()
+        for step in range(4):
+            paddle.base.core.update_autotune_status()
+            out = paddle.sparse.masked_matmul(
+                paddle.to_tensor(np_x), paddle.to_tensor(np_y), mask
+            )
+            np.testing.assert_allclose(
+                np_out.data, out.values().numpy(), rtol=1e-05
+            )
+
+
 class TestMatmulSparseDenseStatic(unittest.TestCase):
     # x: sparse, y: dense, out: dense
     def check_result(self, x_shape, y_shape):
@@ -703,6 +703,44 @@ class TestStride(unittest.TestCase):
 
         self.assertTrue(np.allclose(out_c.numpy(), np_out))
 
+    def call_elementwise_on_views(self):
+        x_np = np.random.random(size=[2, 3, 4]).astype('float32')
+        y_np = np.random.random(size=[3, 4]).astype('float32') + 0.5
+        x = paddle.to_tensor(x_np)
+        y = paddle.to_tensor(y_np)
+        x_view = paddle.transpose(x, perm=[0, 2, 1])
+        y_view = paddle.transpose(y, perm=[1, 0])[:, 1:]
+        x_np_view = x_np.transpose(0, 2, 1)
+        y_np_view = y_np.transpose(1, 0)[:, 1:]
+        self.assertFalse(x_view.is_contiguous())
+        self.assertFalse(y_view.is_contiguous())
+
+        x_sliced = x_view[:, :, 1:]
+        x_np_sliced = x_np_view[:, :, 1:]
+        for op, np_op in [
+            (paddle.add, np.add),
+            (paddle.subtract, np.subtract),
+            (paddle.multiply, np.multiply),
+            (paddle.divide, np.divide),
+        ]:
+            # The same shape, and y broadcast to x.
+            out = op(x_sliced, x_sliced)
+            np.testing.assert_allclose(
+                out.numpy(), np_op(x_np_sliced, x_np_sliced), rtol=1e-6
+            )
+            self.assertTrue(out.is_contiguous())
+            out = op(x_sliced, y_view)
+            np.testing.assert_allclose(
+                out.numpy(), np_op(x_np_sliced, y_np_view), rtol=1e-6
+            )
+
+        out = paddle.cast(x_view, 'float64')
+        np.testing.assert_allclose(out.numpy(), x_np_view.astype('float64'))
+        self.assertTrue(out.is_contiguous())
+        # The views are not changed.
+        self.assertTrue(x._is_shared_buffer_with(x_view))
+        self.assertFalse(x_view.is_contiguous())
+
     def call_stride(self):
         self.call_transpose()
         self.call_diagonal()
@@ -733,6 +771,7 @@ class TestStride(unittest.TestCase):
         self.call_view7()
         self.call_view_as()
         self.call_unfold()
+        self.call_elementwise_on_views()
 
 
 class TestStrideCPU(TestStride):
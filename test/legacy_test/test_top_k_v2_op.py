@@ -507,6 +507,74 @@ class TestTopKAPI(unittest.TestCase):
                 paddle.topk(x, k=0)
 
 
+class TestTopKLargeRows(unittest.TestCase):
+    # Rows of 1024 and more take the radix select on GPU, and a heap on CPU
+    # when k is small against the row.
+    def setUp(self):
+        self.places = [core.CPUPlace()]
+        if core.is_compiled_with_cuda():
+            self.places.append(core.CUDAPlace(0))
+
+    def expected_row(self, row, k, largest):
+        nans = row[np.isnan(row)]
+        rest = np.sort(row[~np.isnan(row)])
+        if largest:
+            return np.concatenate([nans, rest[::-1]])[:k]
+        return np.concatenate([rest, nans])[:k]
+
+    def check(self, x, k, axis=-1, largest=True):
+        # NaN is the largest value, and ties may come in any order, so check
+        # the values and that the indices point at them.
+        x_last = np.moveaxis(x, axis, -1)
+        expected = np.stack(
+            [
+                self.expected_row(row, k, largest)
+                for row in x_last.reshape(-1, x_last.shape[-1])
+            ]
+        ).reshape((*x_last.shape[:-1], k))
+        for place in self.places:
+            with paddle.base.dygraph.guard(place):
+                values, indices = paddle.topk(
+                    paddle.to_tensor(x), k=k, axis=axis, largest=largest
+                )
+            values = np.moveaxis(values.numpy(), axis, -1)
+            indices = np.moveaxis(indices.numpy(), axis, -1)
+            np.testing.assert_array_equal(values, expected)
+            np.testing.assert_array_equal(
+                np.take_along_axis(x_last, indices, axis=-1), expected
+            )
+            for row in indices.reshape(-1, k):
+                self.assertEqual(len(np.unique(row)), k)
+
+    def test_batched_rows(self):
+        x = np.random.rand(3, 4096).astype("float32")
+        self.check(x, k=5)
+        self.check(x, k=5, largest=False)
+
+    def test_axis_not_last(self):
+        x = np.random.rand(2048, 3).astype("float32")
+        self.check(x, k=7, axis=0)
+
+    def test_ties(self):
+        x = np.random.randint(0, 8, (4, 2048)).astype("float32")
+        self.check(x, k=300)
+        self.check(x, k=3, largest=False)
+
+    def test_k_equals_width(self):
+        x = np.random.rand(2, 1024).astype("float32")
+        self.check(x, k=1024)
+
+    def test_large_k(self):
+        x = np.random.rand(2, 2048).astype("float32")
+        self.check(x, k=1500)
+
+    def test_nan(self):
+        x = np.random.rand(2, 2048).astype("float32")
+        x[0, [3, 1000, 2047]] = np.nan
+        x[1, 17] = np.nan
+        self.check(x, k=10)
+
+
 if __name__ == "__main__":
     paddle.enable_static()
     unittest.main()
@@ -172,5 +172,52 @@ class TestTopPAPI(unittest.TestCase):
                 self.run_static(place)
 
 
+@unittest.skipIf(
+    not core.is_compiled_with_cuda(), "core is not compiled with CUDA "
+)
+class TestTopPLargeVocab(unittest.TestCase):
+    # Vocabularies of 4096 and more find the nucleus by a radix select.
+    def sample(self, probs, top_p):
+        with paddle.base.dygraph.guard(core.CUDAPlace(0)):
+            scores, ids = paddle.tensor.top_p_sampling(
+                paddle.to_tensor(probs),
+                paddle.to_tensor(
+                    np.full((probs.shape[0], 1), top_p, probs.dtype)
+                ),
+                seed=-1,
+            )
+        return scores.numpy().flatten(), ids.numpy().flatten()
+
+    def check_in_nucleus(self, probs, top_p):
+        scores, ids = self.sample(probs, top_p)
+        for row, score, token in zip(probs, scores, ids):
+            # the nucleus ends with the token whose cumulative probability
+            # reaches top_p, give or take the rounding of the sums
+            ordered = np.sort(row)[::-1].astype("float64")
+            last = np.searchsorted(np.cumsum(ordered), top_p + 1e-4)
+            threshold = ordered[min(last, len(ordered) - 1)]
+            self.assertGreaterEqual(row[token], threshold)
+            np.testing.assert_allclose(score, row[token], rtol=1e-6)
+
+    def test_random(self):
+        logits = np.random.rand(4, 8192).astype("float32") * 8
+        probs = np.exp(logits) / np.exp(logits).sum(-1, keepdims=True)
+        for top_p in [0.1, 0.5, 0.9]:
+            self.check_in_nucleus(probs.astype("float32"), top_p)
+
+    def test_ties(self):
+        probs = np.full((2, 4096), 1.0 / 4096, "float32")
+        scores, ids = self.sample(probs, 0.5)
+        self.assertTrue(np.all((ids >= 0) & (ids < 4096)))
+        np.testing.assert_allclose(scores, 1.0 / 4096, rtol=1e-6)
+
+    def test_peak(self):
+        probs = np.full((2, 8192), 0.05 / 8191, "float32")
+        probs[0, 123] = 0.95
+        probs[1, 8191] = 0.95
+        _, ids = self.sample(probs, 0.9)
+        np.testing.assert_array_equal(ids, [123, 8191])
+
+
 if __name__ == "__main__":
     unittest.main()
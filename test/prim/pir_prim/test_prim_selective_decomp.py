@@ -0,0 +1,71 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import paddle
+from paddle.decomposition import decompose
+from paddle.framework import core
+
+paddle.enable_static()
+
+
+def get_gelu_program(consumer):
+    with paddle.pir_utils.IrGuard():
+        main_program = paddle.static.Program()
+        with paddle.static.program_guard(main_program):
+            x = paddle.static.data('x', [4, 16], 'float32')
+            w = paddle.static.data('w', [16, 16], 'float32')
+            y = paddle.nn.functional.gelu(x)
+            out = consumer(y, w)
+    return main_program, out
+
+
+class TestSelectiveDecomp(unittest.TestCase):
+    def tearDown(self):
+        paddle.set_flags({"FLAGS_prim_selective_decomp_ops": ""})
+
+    def decompose_ops(self, consumer, selective_ops):
+        paddle.set_flags({"FLAGS_prim_selective_decomp_ops": selective_ops})
+        program, out = get_gelu_program(consumer)
+        with paddle.pir_utils.IrGuard():
+            core._set_prim_forward_enabled(True)
+            decompose(program, [out])
+            core._set_prim_forward_enabled(False)
+        return [op.name() for op in program.global_block().ops]
+
+    def test_keep_without_fusible_neighbors(self):
+        # gelu is between data and matmul, neither of which fuses with it.
+        ops = self.decompose_ops(paddle.matmul, "pd_op.gelu")
+        self.assertIn('pd_op.gelu', ops)
+
+    def test_decomp_with_fusible_neighbors(self):
+        ops = self.decompose_ops(
+            lambda y, w: paddle.exp(paddle.matmul(y, w)) + y, "pd_op.gelu"
+        )
+        self.assertNotIn('pd_op.gelu', ops)
+
+    def test_keep_slow_decomposed_kernel(self):
+        ops = self.decompose_ops(
+            lambda y, w: paddle.exp(paddle.matmul(y, w)) + y, "pd_op.gelu:10"
+        )
+        self.assertIn('pd_op.gelu', ops)
+
+    def test_decomp_without_selective_ops(self):
+        ops = self.decompose_ops(paddle.matmul, "")
+        self.assertNotIn('pd_op.gelu', ops)
+
+
+if __name__ == "__main__":
+    unittest.main()
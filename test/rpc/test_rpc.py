@@ -104,6 +104,18 @@ class TestSingleProcessRpc(RpcTestBase):
         out = dist.rpc.rpc_async(worker_name(0), paddle_add, args=args).wait()
         np.testing.assert_allclose(out, res, rtol=1e-05)
 
+    def test_sync_rpc_function(self):
+        out = dist.rpc.rpc_sync(worker_name(0), "echo", args=(b"paddle",))
+        self.assertEqual(out, b"paddle")
+
+    def test_async_rpc_function(self):
+        futs = [
+            dist.rpc.rpc_async(worker_name(0), "echo", args=(bytes([i]),))
+            for i in range(100)
+        ]
+        for i, fut in enumerate(futs):
+            self.assertEqual(fut.wait(), bytes([i]))
+
     def test_get_worker_info(self):
         info = dist.rpc.get_worker_info(worker_name(0))
         self.assertEqual(info.name, worker_name(0))
@@ -121,6 +133,16 @@ class TestSingleProcessRpc(RpcTestBase):
         self.assertEqual(info.rank, 0)
 
 
+class TestSingleProcessBatchedRpc(TestSingleProcessRpc):
+    def setUp(self):
+        os.environ["PADDLE_RPC_MAX_BATCH_SIZE"] = "16"
+        super().setUp()
+
+    def tearDown(self):
+        super().tearDown()
+        del os.environ["PADDLE_RPC_MAX_BATCH_SIZE"]
+
+
 class RpcLaunchTest(RpcLaunchTestBase):
     def test_sync_rpc_paddle_add1(self):
         nnodes = 2
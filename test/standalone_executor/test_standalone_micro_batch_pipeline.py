@@ -0,0 +1,101 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import unittest
+
+import numpy as np
+
+import paddle
+from paddle.base import core
+
+paddle.enable_static()
+
+
+class TestMicroBatchPipeline(unittest.TestCase):
+    def setUp(self):
+        self.micro_batch_num = 4
+        self.steps = 3
+        self.place = (
+            paddle.CUDAPlace(0)
+            if core.is_compiled_with_cuda()
+            else paddle.CPUPlace()
+        )
+        self.flags = paddle.get_flags(
+            [
+                'FLAGS_enable_pir_in_executor',
+                'FLAGS_new_executor_micro_batch_streams',
+            ]
+        )
+        paddle.set_flags({'FLAGS_enable_pir_in_executor': True})
+
+    def tearDown(self):
+        paddle.set_flags(self.flags)
+
+    def build_program(self):
+        main_program = paddle.static.Program()
+        startup_program = paddle.static.Program()
+        with paddle.static.program_guard(main_program, startup_program):
+            x = paddle.static.data('x', [8, 16], 'float32')
+            w = paddle.full([16, 16], 0.5, 'float32')
+            out = paddle.tanh(paddle.matmul(x, w)) * 2.0 + x
+        return main_program, out
+
+    def run_plan(self, stream_num, feeds):
+        paddle.set_flags(
+            {'FLAGS_new_executor_micro_batch_streams': stream_num}
+        )
+        main_program, out = self.build_program()
+        jobs = []
+        for i in range(self.micro_batch_num):
+            job = core.Job("forward")
+            job.set_micro_batch_id(i)
+            jobs.append(job)
+        plan = core.Plan(jobs, {"forward": main_program})
+
+        exe = paddle.static.Executor(self.place)
+        exe._set_plan(plan)
+        results = []
+        with paddle.static.scope_guard(paddle.static.Scope()):
+            # The executor and its workers are reused across the steps.
+            for feed in feeds:
+                results.append(
+                    exe.run(main_program, feed={'x': feed}, fetch_list=[out])
+                )
+        return results
+
+    def test_pipeline_matches_sequential(self):
+        np.random.seed(2026)
+        feeds = [
+            np.random.random([8, 16]).astype('float32')
+            for _ in range(self.steps)
+        ]
+        sequential = self.run_plan(0, feeds)
+        for feed, expected in zip(feeds, sequential):
+            np.testing.assert_allclose(
+                expected[0],
+                np.tanh(feed @ np.full([16, 16], 0.5, 'float32')) * 2.0 + feed,
+                rtol=1e-5,
+                atol=1e-5,
+            )
+        for stream_num in [2, self.micro_batch_num]:
+            pipelined = self.run_plan(stream_num, feeds)
+            self.assertEqual(len(pipelined), len(sequential))
+            for expected, actual in zip(sequential, pipelined):
+                np.testing.assert_allclose(
+                    actual[0], expected[0], rtol=1e-6, atol=1e-6
+                )
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,377 @@
+# Copyright (c) 2026 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Benchmark the PIR pass pipeline and the CINN fusion on representative
+programs, to catch the graph optimization changes which fuse less or launch
+more kernels.
+
+For each program, the predictor is created with the startup trace on, which
+gives the time of the PIR passes and the CINN groups compiled. Then the
+kernels launched by a step are counted under the profiler, and the steps are
+timed. The programs are saved to --model_dir on the first run, so that the
+later runs, e.g. of a baseline and of a change, benchmark the same programs:
+
+    python fusion_benchmark.py --model_dir=./fusion_models \\
+        --output=base.json
+    # ...apply the change and rebuild...
+    python fusion_benchmark.py --model_dir=./fusion_models \\
+        --output=new.json --baseline=base.json
+
+The last run exits with 1 when a program has more CINN groups or kernel
+launches than in the baseline, or a step or pass pipeline time over the
+tolerance. Any saved inference program can be added with
+--model=<name>:<path prefix>:<input shapes>, e.g.
+--model=bert:./bert/inference:int64[1,128],int64[1,128].
+"""
+
+import argparse
+import json
+import os
+import re
+import statistics
+import sys
+import tempfile
+import time
+
+import numpy as np
+
+import paddle
+import paddle.inference as paddle_infer
+from paddle import nn
+from paddle.static import InputSpec
+
+# The categories of the startup trace. The CINN groups are compiled by a PIR
+# pass, so pass_pipeline_ms includes cinn_compile_ms.
+_PASS_CATEGORY = 'PirPass'
+_CINN_CATEGORY = 'CinnCompile'
+
+
+class TransformerBlock(nn.Layer):
+    def __init__(self, d_model=1024, nhead=16):
+        super().__init__()
+        self.layer = nn.TransformerEncoderLayer(
+            d_model, nhead, dim_feedforward=4 * d_model, dropout=0.0
+        )
+
+    def forward(self, x):
+        return self.layer(x)
+
+
+class DLRM(nn.Layer):
+    def __init__(self, num_dense=13, num_sparse=26, vocab=10000, dim=64):
+        super().__init__()
+        self.embeddings = nn.LayerList(
+            [nn.Embedding(vocab, dim) for _ in range(num_sparse)]
+        )
+        self.bottom = nn.Sequential(
+            nn.Linear(num_dense, 512),
+            nn.ReLU(),
+            nn.Linear(512, 256),
+            nn.ReLU(),
+            nn.Linear(256, dim),
+            nn.ReLU(),
+        )
+        num_features = num_sparse + 1
+        num_pairs = num_features * (num_features - 1) // 2
+        self.top = nn.Sequential(
+            nn.Linear(dim + num_pairs, 512),
+            nn.ReLU(),
+            nn.Linear(512, 256),
+            nn.ReLU(),
+            nn.Linear(256, 1),
+            nn.Sigmoid(),
+        )
+        rows, cols = np.triu_indices(num_features, k=1)
+        self.register_buffer(
+            'pairs', paddle.to_tensor(rows * num_features + cols)
+        )
+
+    def forward(self, dense, sparse):
+        x = self.bottom(dense)
+        features = [x] + [
+            emb(sparse[:, i]) for i, emb in enumerate(self.embeddings)
+        ]
+        stacked = paddle.stack(features, axis=1)
+        dots = paddle.bmm(stacked, stacked.transpose([0, 2, 1]))
+        dots = paddle.gather(dots.flatten(1), self.pairs, axis=1)
+        return self.top(paddle.concat([x, dots], axis=1))
+
+
+def _resnet():
+    return paddle.vision.models.resnet50()
+
+
+# name: (builder, [(dtype, shape, value range)])
+BUILTIN_MODELS = {
+    'transformer_block': (
+        TransformerBlock,
+        [('float32', [8, 512, 1024], None)],
+    ),
+    'resnet50': (_resnet, [('float32', [8, 3, 224, 224], None)]),
+    'dlrm': (
+        DLRM,
+        [('float32', [2048, 13], None), ('int64', [2048, 26], (0, 10000))],
+    ),
+}
+
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(
+        description='Benchmark the PIR passes and the CINN fusion.'
+    )
+    parser.add_argument(
+        '--model_dir',
+        default='./fusion_benchmark_models',
+        help='where the built-in programs are saved and loaded',
+    )
+    parser.add_argument(
+        '--models',
+        default=','.join(BUILTIN_MODELS),
+        help='the built-in programs to run, split by ","',
+    )
+    parser.add_argument(
+        '--model',
+        action='append',
+        default=[],
+        help='a saved program, as <name>:<path prefix>:<input shapes>',
+    )
+    parser.add_argument('--output', default='', help='the JSON results')
+    parser.add_argument(
+        '--baseline', default='', help='the JSON results to compare with'
+    )
+    parser.add_argument(
+        '--time_tolerance',
+        type=float,
+        default=0.1,
+        help='the relative increase of the times allowed over the baseline',
+    )
+    parser.add_argument('--warmup', type=int, default=10)
+    parser.add_argument('--repeat', type=int, default=50)
+    parser.add_argument(
+        '--profile_steps',
+        type=int,
+        default=3,
+        help='the steps profiled to count the kernel launches',
+    )
+    parser.add_argument('--device', default='gpu', choices=['gpu', 'cpu'])
+    parser.add_argument(
+        '--disable_cinn',
+        action='store_true',
+        help='run without CINN, as a reference of the fusion',
+    )
+    return parser.parse_args(argv)
+
+
+def parse_inputs(spec):
+    # int64[1,128]@0:32000,float32[1,3,224,224]
+    inputs = []
+    for match in re.finditer(r'(\w+)\[([\d,]*)\](?:@(-?\d+):(-?\d+))?', spec):
+        dtype, dims, low, high = match.groups()
+        shape = [int(d) for d in dims.split(',') if d]
+        value_range = (int(low), int(high)) if low is not None else None
+        inputs.append((dtype, shape, value_range))
+    return inputs
+
+
+def save_builtin(name, path_prefix):
+    builder, inputs = BUILTIN_MODELS[name]
+    paddle.seed(2026)
+    model = builder()
+    model.eval()
+    specs = [InputSpec(shape, dtype) for dtype, shape, _ in inputs]
+    static_model = paddle.jit.to_static(
+        model, input_spec=specs, full_graph=True
+    )
+    paddle.jit.save(static_model, path_prefix)
+
+
+def model_files(path_prefix):
+    for suffix in ('.json', '.pdmodel'):
+        if os.path.exists(path_prefix + suffix):
+            return path_prefix + suffix, path_prefix + '.pdiparams'
+    raise FileNotFoundError(f'No program saved at {path_prefix}.')
+
+
+def make_inputs(inputs):
+    rng = np.random.default_rng(2026)
+    arrays = []
+    for dtype, shape, value_range in inputs:
+        if value_range is not None:
+            arrays.append(rng.integers(*value_range, shape).astype(dtype))
+        else:
+            arrays.append(rng.standard_normal(shape).astype(dtype))
+    return arrays
+
+
+def create_predictor(args, path_prefix):
+    model_file, params_file = model_files(path_prefix)
+    config = paddle_infer.Config(model_file, params_file)
+    if args.device == 'gpu':
+        config.enable_use_gpu(256, 0)
+    else:
+        config.disable_gpu()
+    config.enable_new_ir(True)
+    config.enable_new_executor(True)
+    config.switch_ir_optim(True)
+    if not args.disable_cinn:
+        config.enable_cinn()
+    config.enable_startup_trace()
+    config.disable_glog_info()
+    return paddle_infer.create_predictor(config)
+
+
+def run_step(predictor, arrays):
+    for name, array in zip(predictor.get_input_names(), arrays):
+        predictor.get_input_handle(name).copy_from_cpu(array)
+    predictor.run()
+    # Copying an output waits for the step to complete on the device.
+    for name in predictor.get_output_names():
+        predictor.get_output_handle(name).copy_to_cpu()
+
+
+def summarize_startup(path):
+    with open(path) as f:
+        events = json.load(f)['traceEvents']
+    result = {
+        'pass_pipeline_ms': 0.0,
+        'passes': 0,
+        'cinn_groups': 0,
+        'cinn_compile_ms': 0.0,
+    }
+    for event in events:
+        if event['cat'] == _PASS_CATEGORY:
+            result['pass_pipeline_ms'] += event['dur'] / 1000.0
+            result['passes'] += 1
+        elif event['cat'] == _CINN_CATEGORY:
+            result['cinn_compile_ms'] += event['dur'] / 1000.0
+            result['cinn_groups'] += 1
+    return result
+
+
+def count_launches(args, predictor, arrays, work_dir):
+    targets = [paddle.profiler.ProfilerTarget.CPU]
+    if args.device == 'gpu':
+        targets.append(paddle.profiler.ProfilerTarget.GPU)
+    profiler = paddle.profiler.Profiler(targets=targets)
+    profiler.start()
+    for _ in range(args.profile_steps):
+        run_step(predictor, arrays)
+        profiler.step()
+    profiler.stop()
+    path = os.path.join(work_dir, 'launches.json')
+    profiler.export(path, format='json')
+    with open(path) as f:
+        events = json.load(f)['traceEvents']
+    # The kernels on GPU, the operators on CPU, which runs their kernels.
+    category = 'Kernel' if args.device == 'gpu' else 'Operator'
+    count = sum(1 for event in events if event.get('cat') == category)
+    return count / args.profile_steps
+
+
+def benchmark(args, name, path_prefix, inputs):
+    arrays = make_inputs(inputs)
+    with tempfile.TemporaryDirectory() as work_dir:
+        predictor = create_predictor(args, path_prefix)
+        run_step(predictor, arrays)
+        trace_path = os.path.join(work_dir, 'startup.json')
+        predictor.export_startup_trace(trace_path)
+        result = summarize_startup(trace_path)
+
+        for _ in range(args.warmup):
+            run_step(predictor, arrays)
+        times = []
+        for _ in range(args.repeat):
+            start = time.perf_counter()
+            run_step(predictor, arrays)
+            times.append((time.perf_counter() - start) * 1000.0)
+        times.sort()
+        result['step_ms'] = statistics.median(times)
+        result['step_p90_ms'] = times[int(0.9 * (len(times) - 1))]
+        result['kernel_launches'] = count_launches(
+            args, predictor, arrays, work_dir
+        )
+    result['name'] = name
+    return result
+
+
+def compare(results, baseline, time_tolerance):
+    """
+    Return the regressions of the results over the baseline, a line each.
+    """
+    regressions = []
+    base = {result['name']: result for result in baseline['models']}
+    for result in results['models']:
+        old = base.get(result['name'])
+        if old is None:
+            continue
+        for key in ('cinn_groups', 'kernel_launches'):
+            if result[key] > old[key]:
+                regressions.append(
+                    f"{result['name']}: {key} {old[key]} -> {result[key]}"
+                )
+        for key in ('step_ms', 'pass_pipeline_ms'):
+            if result[key] > old[key] * (1.0 + time_tolerance):
+                regressions.append(
+                    f"{result['name']}: {key} {old[key]:.3f} -> "
+                    f"{result[key]:.3f}"
+                )
+    return regressions
+
+
+def main(argv=None):
+    args = parse_args(argv)
+    paddle.set_device(args.device)
+    os.makedirs(args.model_dir, exist_ok=True)
+
+    programs = []
+    for name in filter(None, args.models.split(',')):
+        path_prefix = os.path.join(args.model_dir, name, 'inference')
+        if not any(
+            os.path.exists(path_prefix + suffix)
+            for suffix in ('.json', '.pdmodel')
+        ):
+            save_builtin(name, path_prefix)
+        programs.append((name, path_prefix, BUILTIN_MODELS[name][1]))
+    for model in args.model:
+        name, path_prefix, spec = model.split(':', 2)
+        programs.append((name, path_prefix, parse_inputs(spec)))
+
+    results = {
+        'paddle_version': paddle.__version__,
+        'commit': paddle.version.commit,
+        'device': args.device,
+        'cinn': not args.disable_cinn,
+        'models': [
+            benchmark(args, name, path_prefix, inputs)
+            for name, path_prefix, inputs in programs
+        ],
+    }
+    text = json.dumps(results, indent=2)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    print(text)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(results, baseline, args.time_tolerance)
+        for regression in regressions:
+            print(f'Regression: {regression}', file=sys.stderr)
+        if regressions:
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -622,6 +622,7 @@ STATIC_MODE_TESTING_LIST = [
     'test_lu_op',
     'test_margin_cross_entropy_op',
     'test_pull_gpups_sparse_op',
+    'test_pull_gpups_sparse_seqpool_cvm_op',
     'test_fused_gemm_epilogue_op',
     'test_fused_gemm_epilogue_grad_op',
 ]